@@ -38,13 +38,17 @@
 #include "mlpack/methods/dbscan.hpp"
 #include "mlpack/methods/decision_tree.hpp"
 #include "mlpack/methods/det.hpp"
+#include "mlpack/methods/elastic_net.hpp"
 #include "mlpack/methods/emst.hpp"
 #include "mlpack/methods/fastmks.hpp"
 #include "mlpack/methods/gmm.hpp"
 #include "mlpack/methods/hmm.hpp"
+#include "mlpack/methods/hnsw.hpp"
 #include "mlpack/methods/hoeffding_trees.hpp"
+#include "mlpack/methods/ivf_pq.hpp"
 #include "mlpack/methods/kde.hpp"
 #include "mlpack/methods/kernel_pca.hpp"
+#include "mlpack/methods/kernel_svm.hpp"
 #include "mlpack/methods/kmeans.hpp"
 #include "mlpack/methods/lars.hpp"
 #include "mlpack/methods/linear_regression.hpp"
@@ -75,6 +79,7 @@
 #include "mlpack/methods/sparse_autoencoder.hpp"
 #include "mlpack/methods/sparse_coding.hpp"
 #include "mlpack/methods/svdplusplus.hpp"
+#include "mlpack/methods/xgboost.hpp"
 
 // Include reverse compatibility.
 #include "mlpack/namespace_compat.hpp"
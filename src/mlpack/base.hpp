@@ -18,6 +18,7 @@
 
 // Next, standard includes.
 #include <any>
+#include <atomic>
 #include <cctype>
 #include <cfloat>
 #include <climits>
@@ -81,8 +82,13 @@
   #error "Need to enable C++17 mode in your compiler"
 #endif
 
-// Now include Armadillo and traits that we use for it.
+// Now include Armadillo and traits that we use for it.  If MLPACK_HAS_COOT is
+// defined, Bandicoot is included too, so that the parts of mlpack that support
+// it can be used with GPU matrices (coot::Mat).
 #include <armadillo>
+#ifdef MLPACK_HAS_COOT
+  #include <bandicoot>
+#endif
 #include <mlpack/core/util/arma_traits.hpp>
 
 // On Visual Studio, disable C4519 (default arguments for function templates)
@@ -0,0 +1,140 @@
+/**
+ * @file benchmarks/ann_benchmarks.cpp
+ *
+ * Benchmarks of the forward and backward passes of FFNs, one layer type at a
+ * time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+typedef FFN<MeanSquaredError> BenchmarkNetwork;
+
+//! A function that sets the input dimensions and the layers of a network.
+typedef void (*NetworkBuilder)(BenchmarkNetwork&);
+
+/**
+ * Build the given network, and create a random batch of inputs and targets for
+ * it.  The batch size is the first argument of the benchmark.
+ */
+static void SetUpNetwork(benchmark::State& state,
+                         NetworkBuilder build,
+                         BenchmarkNetwork& network,
+                         arma::mat& input,
+                         arma::mat& target)
+{
+  RandomSeed(benchmarkSeed);
+  build(network);
+  network.Reset();
+
+  size_t inputSize = 1;
+  for (const size_t d : network.InputDimensions())
+    inputSize *= d;
+
+  input.randu(inputSize, state.range(0));
+  arma::mat output;
+  network.Forward(input, output);
+  target.randu(output.n_rows, output.n_cols);
+}
+
+// Time the forward pass through the network.
+static void LayerForward(benchmark::State& state, NetworkBuilder build)
+{
+  BenchmarkNetwork network;
+  arma::mat input, target, output;
+  SetUpNetwork(state, build, network, input, target);
+
+  for (auto _ : state)
+  {
+    network.Forward(input, output);
+    benchmark::DoNotOptimize(output.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * input.n_cols);
+}
+
+// Time the backward pass through the network (each backward pass needs its
+// own forward pass, which is not timed).
+static void LayerBackward(benchmark::State& state, NetworkBuilder build)
+{
+  BenchmarkNetwork network;
+  arma::mat input, target, output, gradient;
+  SetUpNetwork(state, build, network, input, target);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    network.Forward(input, output);
+    state.ResumeTiming();
+
+    network.Backward(input, target, gradient);
+    benchmark::DoNotOptimize(gradient.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * input.n_cols);
+}
+
+static void LinearNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 256 };
+  network.Add<Linear>(256);
+}
+
+static void ConvolutionNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 28, 28, 8 };
+  network.Add<Convolution>(16, 3, 3);
+}
+
+static void MaxPoolingNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 28, 28, 8 };
+  network.Add<MaxPooling>(2, 2, 2, 2);
+}
+
+static void BatchNormNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 256 };
+  network.Add<BatchNorm>();
+}
+
+static void ReLUNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 256 };
+  network.Add<ReLU>();
+}
+
+static void SigmoidNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 256 };
+  network.Add<Sigmoid>();
+}
+
+static void LogSoftMaxNetwork(BenchmarkNetwork& network)
+{
+  network.InputDimensions() = { 256 };
+  network.Add<LogSoftMax>();
+}
+
+#define MLPACK_LAYER_BENCHMARK(Name) \
+    BENCHMARK_CAPTURE(LayerForward, Name, &Name##Network) \
+        ->Arg(32)->Arg(256)->Unit(benchmark::kMicrosecond); \
+    BENCHMARK_CAPTURE(LayerBackward, Name, &Name##Network) \
+        ->Arg(32)->Arg(256)->Unit(benchmark::kMicrosecond)
+
+MLPACK_LAYER_BENCHMARK(Linear);
+MLPACK_LAYER_BENCHMARK(Convolution);
+MLPACK_LAYER_BENCHMARK(MaxPooling);
+MLPACK_LAYER_BENCHMARK(BatchNorm);
+MLPACK_LAYER_BENCHMARK(ReLU);
+MLPACK_LAYER_BENCHMARK(Sigmoid);
+MLPACK_LAYER_BENCHMARK(LogSoftMax);
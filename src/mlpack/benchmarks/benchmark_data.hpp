@@ -0,0 +1,143 @@
+/**
+ * @file benchmarks/benchmark_data.hpp
+ *
+ * Standardized datasets for the mlpack benchmarks.  Synthetic data is always
+ * generated with a fixed seed, so that every run of a benchmark (and every
+ * version of mlpack) sees exactly the same data; real datasets are loaded from
+ * the test data directory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_DATA_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_DATA_HPP
+
+#include <mlpack/core.hpp>
+
+#include <benchmark/benchmark.h>
+
+#ifndef MLPACK_BENCHMARK_DATA_DIR
+  #define MLPACK_BENCHMARK_DATA_DIR ""
+#endif
+
+namespace mlpack {
+namespace bench {
+
+//! The seed that all synthetic data is generated with.
+static const size_t benchmarkSeed = 42;
+
+/**
+ * Generate points from a mixture of Gaussians with unit covariance, whose
+ * centers are drawn uniformly from [0, 10 * clusters]^dims.  The label of each
+ * point is the Gaussian it was drawn from.
+ *
+ * @param dims Dimensionality of the points.
+ * @param points Number of points.
+ * @param clusters Number of Gaussians.
+ * @param data Matrix to store the points in.
+ * @param labels Row to store the labels in.
+ * @param seed Seed of the random number generator.
+ */
+inline void GaussianClusters(const size_t dims,
+                             const size_t points,
+                             const size_t clusters,
+                             arma::mat& data,
+                             arma::Row<size_t>& labels,
+                             const size_t seed = benchmarkSeed)
+{
+  RandomSeed(seed);
+  const arma::mat centers = 10.0 * clusters * arma::randu<arma::mat>(dims,
+      clusters);
+
+  data.randn(dims, points);
+  labels.set_size(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % clusters;
+    data.col(i) += centers.col(labels[i]);
+  }
+}
+
+//! Generate points from a mixture of Gaussians, ignoring the labels.
+inline arma::mat GaussianClusters(const size_t dims,
+                                  const size_t points,
+                                  const size_t clusters,
+                                  const size_t seed = benchmarkSeed)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(dims, points, clusters, data, labels, seed);
+  return data;
+}
+
+/**
+ * Generate a coordinate list of ratings (user, item, rating), as used by CF,
+ * from a random low-rank model.  The ratings are integers between 1 and 5, and
+ * no (user, item) pair is rated twice.
+ *
+ * @param users Number of users.
+ * @param items Number of items.
+ * @param ratings Number of ratings; must be at most users * items.
+ * @param rank Rank of the model the ratings are drawn from.
+ * @param seed Seed of the random number generator.
+ */
+inline arma::mat SyntheticRatings(const size_t users,
+                                  const size_t items,
+                                  const size_t ratings,
+                                  const size_t rank = 5,
+                                  const size_t seed = benchmarkSeed)
+{
+  RandomSeed(seed);
+  const arma::mat w = arma::randu<arma::mat>(users, rank);
+  const arma::mat h = arma::randu<arma::mat>(rank, items);
+  const double scale = 4.0 / rank;
+
+  const arma::uvec cells = arma::randperm(users * items, ratings);
+  arma::mat data(3, ratings);
+  for (size_t i = 0; i < ratings; ++i)
+  {
+    const size_t user = cells[i] % users;
+    const size_t item = cells[i] / users;
+    data(0, i) = user;
+    data(1, i) = item;
+    data(2, i) = std::round(1.0 + scale * arma::dot(w.row(user),
+        h.col(item)));
+  }
+
+  return data;
+}
+
+//! Get the path of a file in the test data directory.
+inline std::string DataPath(const std::string& filename)
+{
+  return std::string(MLPACK_BENCHMARK_DATA_DIR) + filename;
+}
+
+/**
+ * Load a dataset from the test data directory.  If it can't be loaded, the
+ * benchmark is marked as skipped and false is returned.
+ *
+ * @param state State of the running benchmark.
+ * @param filename Name of the file in the test data directory.
+ * @param data Matrix to load the dataset into.
+ */
+template<typename MatType>
+bool LoadDataset(benchmark::State& state,
+                 const std::string& filename,
+                 MatType& data)
+{
+  if (!data::Load(DataPath(filename), data))
+  {
+    state.SkipWithError(("could not load " + DataPath(filename)).c_str());
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace bench
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file benchmarks/cf_benchmarks.cpp
+ *
+ * Benchmarks of training collaborative filtering models and of computing
+ * recommendations with them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/cf.hpp>
+
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+/**
+ * Train a rank-10 CF model for 50 iterations on synthetic ratings.  The
+ * arguments are the number of users, the number of items, and the number of
+ * ratings.
+ */
+template<typename DecompositionPolicy>
+static void CFTrain(benchmark::State& state)
+{
+  const arma::mat ratings = SyntheticRatings(state.range(0), state.range(1),
+      state.range(2));
+
+  for (auto _ : state)
+  {
+    // Decompositions start from random factors.
+    RandomSeed(benchmarkSeed);
+    CFType<DecompositionPolicy> cf(ratings, DecompositionPolicy(), 5, 10, 50);
+    benchmark::DoNotOptimize(cf.CleanedData().n_nonzero);
+  }
+
+  state.SetItemsProcessed(state.iterations() * ratings.n_cols);
+}
+
+// Compute 10 recommendations for every user of a real dataset.
+static void CFRecommendReal(benchmark::State& state)
+{
+  arma::mat ratings;
+  if (!LoadDataset(state, "GroupLensSmall.csv", ratings))
+    return;
+
+  RandomSeed(benchmarkSeed);
+  CF cf(ratings, NMFPolicy(), 5, 10, 50);
+
+  arma::Mat<size_t> recommendations;
+  for (auto _ : state)
+  {
+    cf.GetRecommendations(10, recommendations);
+    benchmark::DoNotOptimize(recommendations.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * recommendations.n_cols);
+}
+
+BENCHMARK_TEMPLATE(CFTrain, NMFPolicy)->Args({ 1000, 500, 20000 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(CFTrain, RegSVDPolicy)->Args({ 1000, 500, 20000 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(CFTrain, BatchSVDPolicy)->Args({ 1000, 500, 20000 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(CFRecommendReal)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+/**
+ * @file benchmarks/decision_tree_benchmarks.cpp
+ *
+ * Benchmarks of training decision trees and random forests.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree.hpp>
+#include <mlpack/methods/random_forest.hpp>
+
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+/**
+ * Train a decision tree on a synthetic dataset.  The arguments are the number
+ * of points, the dimensionality, and the number of classes.
+ */
+static void DecisionTreeTrain(benchmark::State& state)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(state.range(1), state.range(0), state.range(2), data,
+      labels);
+
+  for (auto _ : state)
+  {
+    DecisionTree<> tree(data, labels, state.range(2));
+    benchmark::DoNotOptimize(tree.NumChildren());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+/**
+ * Train a random forest of 20 trees on a synthetic dataset.  The arguments are
+ * the number of points, the dimensionality, and the number of classes.
+ */
+static void RandomForestTrain(benchmark::State& state)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(state.range(1), state.range(0), state.range(2), data,
+      labels);
+
+  for (auto _ : state)
+  {
+    // Bootstrapping is random, so reset the seed for every forest.
+    RandomSeed(benchmarkSeed);
+    RandomForest<> forest(data, labels, state.range(2), 20);
+    benchmark::DoNotOptimize(forest.NumTrees());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+// Train a decision tree on a real dataset.
+static void DecisionTreeTrainReal(benchmark::State& state)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  if (!LoadDataset(state, "vc2.csv", data) ||
+      !LoadDataset(state, "vc2_labels.txt", labels))
+    return;
+
+  for (auto _ : state)
+  {
+    DecisionTree<> tree(data, labels, 3);
+    benchmark::DoNotOptimize(tree.NumChildren());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+BENCHMARK(DecisionTreeTrain)->Args({ 10000, 10, 5 })->Args({ 100000, 10, 5 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(RandomForestTrain)->Args({ 10000, 10, 5 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(DecisionTreeTrainReal)->Unit(benchmark::kMillisecond);
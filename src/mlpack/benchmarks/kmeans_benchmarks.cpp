@@ -0,0 +1,60 @@
+/**
+ * @file benchmarks/kmeans_benchmarks.cpp
+ *
+ * Benchmarks of the k-means Lloyd iteration strategies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans.hpp>
+
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+/**
+ * Run 10 iterations of k-means on a synthetic dataset, starting from the same
+ * initial centroids every time.  The arguments are the number of points, the
+ * dimensionality, and the number of clusters.
+ */
+template<template<class, class> class LloydStepType>
+static void KMeansCluster(benchmark::State& state)
+{
+  const size_t clusters = state.range(2);
+  const arma::mat data = GaussianClusters(state.range(1), state.range(0),
+      clusters);
+
+  // The initial centroids are random points of the dataset.
+  RandomSeed(benchmarkSeed);
+  const arma::mat initialCentroids = data.cols(arma::randperm(data.n_cols,
+      clusters));
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      LloydStepType> kmeans(10);
+  arma::mat centroids;
+  for (auto _ : state)
+  {
+    centroids = initialCentroids;
+    kmeans.Cluster(data, clusters, centroids, true);
+    benchmark::DoNotOptimize(centroids.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+#define MLPACK_KMEANS_BENCHMARK(LloydStepType) \
+    BENCHMARK_TEMPLATE(KMeansCluster, LloydStepType) \
+        ->Args({ 10000, 3, 10 })->Args({ 10000, 10, 10 }) \
+        ->Args({ 10000, 10, 100 }) \
+        ->Unit(benchmark::kMillisecond)
+
+MLPACK_KMEANS_BENCHMARK(NaiveKMeans);
+MLPACK_KMEANS_BENCHMARK(ElkanKMeans);
+MLPACK_KMEANS_BENCHMARK(HamerlyKMeans);
+MLPACK_KMEANS_BENCHMARK(PellegMooreKMeans);
+MLPACK_KMEANS_BENCHMARK(DefaultDualTreeKMeans);
+MLPACK_KMEANS_BENCHMARK(CoverTreeDualTreeKMeans);
@@ -0,0 +1,88 @@
+/**
+ * @file benchmarks/load_benchmarks.cpp
+ *
+ * Benchmarks of loading CSV and ARFF files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "benchmark_data.hpp"
+
+#include <cstdio>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+/**
+ * Load a synthetic CSV file, which is written to the working directory before
+ * the benchmark starts.  The arguments are the number of points and the
+ * dimensionality.
+ */
+static void LoadCSV(benchmark::State& state)
+{
+  const std::string filename = "mlpack_benchmark_" +
+      std::to_string(state.range(0)) + "x" + std::to_string(state.range(1)) +
+      ".csv";
+  if (!data::Save(filename, GaussianClusters(state.range(1), state.range(0),
+      10)))
+  {
+    state.SkipWithError(("could not write " + filename).c_str());
+    return;
+  }
+
+  arma::mat data;
+  for (auto _ : state)
+  {
+    data::Load(filename, data, true);
+    benchmark::DoNotOptimize(data.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+  state.SetBytesProcessed(state.iterations() * data.n_elem * sizeof(double));
+  std::remove(filename.c_str());
+}
+
+// Load a real CSV file with categorical features.
+static void LoadRealCSV(benchmark::State& state)
+{
+  arma::mat data;
+  for (auto _ : state)
+  {
+    data::DatasetInfo info;
+    if (!data::Load(DataPath("mushroom.data.csv"), data, info))
+    {
+      state.SkipWithError("could not load mushroom.data.csv");
+      return;
+    }
+    benchmark::DoNotOptimize(data.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+// Load a real ARFF file with categorical features.
+static void LoadRealARFF(benchmark::State& state)
+{
+  arma::mat data;
+  for (auto _ : state)
+  {
+    data::DatasetInfo info;
+    if (!data::Load(DataPath("braziltourism.arff"), data, info))
+    {
+      state.SkipWithError("could not load braziltourism.arff");
+      return;
+    }
+    benchmark::DoNotOptimize(data.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+BENCHMARK(LoadCSV)->Args({ 10000, 10 })->Args({ 100000, 10 })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadRealCSV)->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadRealARFF)->Unit(benchmark::kMillisecond);
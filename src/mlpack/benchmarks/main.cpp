@@ -0,0 +1,35 @@
+/**
+ * @file benchmarks/main.cpp
+ *
+ * Entry point of mlpack_benchmarks.  All the options of Google Benchmark are
+ * supported; e.g., to write the results as JSON for tracking performance
+ * between versions,
+ *
+ *   mlpack_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+ *
+ * The mlpack version and the data seed are added to the context of the
+ * results, so that results from different versions can be told apart.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include "benchmark_data.hpp"
+
+int main(int argc, char** argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::AddCustomContext("mlpack_version", mlpack::util::GetVersion());
+  benchmark::AddCustomContext("mlpack_benchmark_seed",
+      std::to_string(mlpack::bench::benchmarkSeed));
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
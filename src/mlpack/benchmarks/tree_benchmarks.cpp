@@ -0,0 +1,107 @@
+/**
+ * @file benchmarks/tree_benchmarks.cpp
+ *
+ * Benchmarks of building trees and of k-nearest-neighbor search with them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+#include "benchmark_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+/**
+ * Build a tree on a synthetic dataset.  The arguments are the number of points
+ * and the dimensionality.
+ */
+template<template<typename, typename, typename> class TreeType>
+static void TreeBuild(benchmark::State& state)
+{
+  const arma::mat data = GaussianClusters(state.range(1), state.range(0), 10);
+
+  for (auto _ : state)
+  {
+    TreeType<EuclideanDistance, EmptyStatistic, arma::mat> tree(data);
+    benchmark::DoNotOptimize(tree.NumDescendants());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+/**
+ * Find the 5 nearest neighbors of a synthetic query set in a synthetic
+ * reference set, with the tree already built.  The arguments are the number of
+ * points in each set, the dimensionality, and whether dual-tree (1) or
+ * single-tree (0) search is used.
+ */
+template<template<typename, typename, typename> class TreeType>
+static void TreeSearch(benchmark::State& state)
+{
+  const arma::mat referenceSet = GaussianClusters(state.range(1),
+      state.range(0), 10);
+  // Draw the query points from the same distribution, but not the same points.
+  const arma::mat querySet = GaussianClusters(state.range(1), state.range(0),
+      10, benchmarkSeed + 1);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      knn(referenceSet, state.range(2) ? DUAL_TREE_MODE : SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  for (auto _ : state)
+  {
+    knn.Search(querySet, 5, neighbors, distances);
+    benchmark::DoNotOptimize(distances.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * querySet.n_cols);
+}
+
+// Nearest neighbor search on a real dataset (the reference set is the query
+// set).
+static void TreeSearchReal(benchmark::State& state)
+{
+  arma::mat data;
+  if (!LoadDataset(state, "test_data_3_1000.csv", data))
+    return;
+
+  KNN knn(data);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  for (auto _ : state)
+  {
+    knn.Search(5, neighbors, distances);
+    benchmark::DoNotOptimize(distances.memptr());
+  }
+
+  state.SetItemsProcessed(state.iterations() * data.n_cols);
+}
+
+#define MLPACK_TREE_BUILD_BENCHMARK(TreeType) \
+    BENCHMARK_TEMPLATE(TreeBuild, TreeType) \
+        ->Args({ 10000, 3 })->Args({ 10000, 10 })->Args({ 100000, 3 }) \
+        ->Unit(benchmark::kMillisecond)
+
+#define MLPACK_TREE_SEARCH_BENCHMARK(TreeType) \
+    BENCHMARK_TEMPLATE(TreeSearch, TreeType) \
+        ->Args({ 10000, 3, 1 })->Args({ 10000, 3, 0 }) \
+        ->Args({ 10000, 10, 1 })->Args({ 10000, 10, 0 }) \
+        ->Unit(benchmark::kMillisecond)
+
+MLPACK_TREE_BUILD_BENCHMARK(KDTree);
+MLPACK_TREE_BUILD_BENCHMARK(BallTree);
+MLPACK_TREE_BUILD_BENCHMARK(StandardCoverTree);
+MLPACK_TREE_BUILD_BENCHMARK(RStarTree);
+
+MLPACK_TREE_SEARCH_BENCHMARK(KDTree);
+MLPACK_TREE_SEARCH_BENCHMARK(BallTree);
+MLPACK_TREE_SEARCH_BENCHMARK(StandardCoverTree);
+MLPACK_TREE_SEARCH_BENCHMARK(RStarTree);
+
+BENCHMARK(TreeSearchReal)->Unit(benchmark::kMillisecond);
@@ -35,17 +35,22 @@ std::string DefaultParamImpl(
   std::ostringstream oss;
   if (std::is_same<T, bool>::value)
   {
-    // If this is the verbose option, print the default that uses the global
-    // package option.
-    if (data.name == "verbose")
+    // If this is the verbose or copy_all_inputs option, print the default
+    // that uses the global package option.
+    if (data.name == "verbose" || data.name == "copy_all_inputs")
     {
-      oss << "getOption(\"mlpack.verbose\", FALSE)";
+      oss << "getOption(\"mlpack." << data.name << "\", FALSE)";
     }
     else
     {
       oss << "FALSE";
     }
   }
+  else if (data.name == "threads")
+  {
+    oss << "getOption(\"mlpack.threads\", " << std::any_cast<T>(data.value)
+        << ")";
+  }
   else
   {
     oss << std::any_cast<T>(data.value);
@@ -12,6 +12,7 @@
 #include <rcpp_mlpack.h>
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 
 using namespace mlpack;
 using namespace Rcpp;
@@ -108,15 +109,35 @@ void SetParamVecInt(SEXP params,
   p.SetPassed(paramName);
 }
 
-// Call params.Get<arma::mat>() to set the value of a parameter.
+// Call params.Get<arma::mat>() to set the value of a parameter.  R stores
+// matrices in column-major order, like Armadillo, so a matrix of doubles that
+// does not need to be transposed is used without a copy (unless `copy` is
+// true); the R object must then be kept alive until the binding has been run.
 // [[Rcpp::export]]
 void SetParamMat(SEXP params,
                  const std::string& paramName,
-                 const arma::mat& paramValue,
-                 bool transpose)
+                 SEXP paramValue,
+                 bool transpose,
+                 bool copy)
 {
   util::Params& p = *Rcpp::as<Rcpp::XPtr<util::Params>>(params);
-  p.Get<arma::mat>(paramName) = (transpose ? paramValue.t() : paramValue);
+  if (!transpose && !copy && TYPEOF(paramValue) == REALSXP &&
+      Rf_isMatrix(paramValue))
+  {
+    const arma::mat rMat(REAL(paramValue), Rf_nrows(paramValue),
+        Rf_ncols(paramValue), false, true);
+    MakeAlias(p.Get<arma::mat>(paramName), rMat, rMat.n_rows, rMat.n_cols, 0,
+        false);
+  }
+  else
+  {
+    // Other types (such as integer matrices) have to be converted anyway.
+    const arma::mat paramMat = Rcpp::as<arma::mat>(paramValue);
+    if (transpose)
+      p.Get<arma::mat>(paramName) = paramMat.t();
+    else
+      p.Get<arma::mat>(paramName) = std::move(paramMat);
+  }
   p.SetPassed(paramName);
 }
 
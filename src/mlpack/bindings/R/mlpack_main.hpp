@@ -93,5 +93,12 @@ using Option = mlpack::bindings::r::ROption<T>;
 // Add default parameters that are included in every program.
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
+PARAM_FLAG("copy_all_inputs", "If specified, all input matrices will be deep "
+    "copied before the method is run.  By default, R matrices of doubles are "
+    "used without a copy, so this is useful if the algorithm modifies its "
+    "input, but can slow down the code.", "");
+PARAM_INT_IN("threads", "Number of threads to use for parallel computations; "
+    "0 uses the default (the OMP_NUM_THREADS environment variable, or else "
+    "the number of cores).", "", 0);
 
 #endif
@@ -63,15 +63,21 @@ void PrintDoc(util::ParamData& d,
       }
       else if (d.cppType == "int")
       {
+        // The threads option uses the global mlpack package option if it is
+        // set.
+        if (d.name == "threads")
+          oss << "getOption(\"mlpack.threads\", ";
         oss << std::any_cast<int>(d.value);
+        if (d.name == "threads")
+          oss << ")";
       }
       else if (d.cppType == "bool")
       {
-        // If the option is `verbose`, be sure to print the use of the global
-        // mlpack package option as a default.
-        if (d.name == "verbose")
+        // If the option is `verbose` or `copy_all_inputs`, be sure to print
+        // the use of the global mlpack package option as a default.
+        if (d.name == "verbose" || d.name == "copy_all_inputs")
         {
-          oss << "getOption(\"mlpack.verbose\", FALSE)";
+          oss << "getOption(\"mlpack." << d.name << "\", FALSE)";
         }
         else
         {
@@ -31,17 +31,22 @@ void PrintInputParam(util::ParamData& d,
   MLPACK_COUT_STREAM << d.name;
   if (std::is_same<T, bool>::value)
   {
-    if (d.name == "verbose")
+    if (d.name == "verbose" || d.name == "copy_all_inputs")
     {
-      // Make sure that we use the global verbose option for the mlpack package
-      // as the default.
-      MLPACK_COUT_STREAM << "=getOption(\"mlpack.verbose\", FALSE)";
+      // Make sure that we use the global option for the mlpack package as the
+      // default.
+      MLPACK_COUT_STREAM << "=getOption(\"mlpack." << d.name << "\", FALSE)";
     }
     else
     {
       MLPACK_COUT_STREAM << "=FALSE";
     }
   }
+  else if (d.name == "threads")
+  {
+    // The global threads option of the mlpack package is used if it is set.
+    MLPACK_COUT_STREAM << "=getOption(\"mlpack.threads\", NA)";
+  }
   else if (!d.required)
   {
     MLPACK_COUT_STREAM << "=NA";
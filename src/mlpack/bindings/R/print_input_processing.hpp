@@ -74,13 +74,18 @@ void PrintInputProcessing(
     util::ParamData& d,
     const typename std::enable_if<arma::is_arma_type<T>::value>::type* = 0)
 {
+  // Dense matrices of doubles may be used by the binding without a copy, so the
+  // converted matrix is kept in a local variable until the call is done; the
+  // last argument forces a copy.
   std::string extraTransStr = "";
+  std::string convertStr = "to_matrix(" + d.name + ")";
   if (d.cppType == "arma::mat")
   {
     if (d.noTranspose)
-      extraTransStr = ", FALSE";
+      extraTransStr = ", FALSE, copy_all_inputs";
     else
-      extraTransStr = ", TRUE";
+      extraTransStr = ", TRUE, copy_all_inputs";
+    convertStr = d.name;
   }
 
   if (!d.required)
@@ -95,16 +100,23 @@ void PrintInputProcessing(
      * and if the parameter is an arma::mat, we will get code like
      *
      *     if (!identical(<param_name>, NA)) {
-     *        SetParam<type>(p, "<param_name>", to_matrix(<param_name>), TRUE)
+     *        <param_name> <- to_matrix(<param_name>)
+     *        SetParam<type>(p, "<param_name>", <param_name>, TRUE,
+     *            copy_all_inputs)
      *     }
      *
-     * where the final boolean specifies whether the matrix should be
-     * transposed.
+     * where the two booleans specify whether the matrix should be transposed
+     * and whether it should be copied.
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name << ", NA)) {"
         << std::endl;
+    if (d.cppType == "arma::mat")
+    {
+      MLPACK_COUT_STREAM << "    " << d.name << " <- to_matrix(" << d.name
+          << ")" << std::endl;
+    }
     MLPACK_COUT_STREAM << "    SetParam" << GetType<T>(d) << "(p, \""
-        << d.name << "\", to_matrix(" << d.name << ")" << extraTransStr << ")"
+        << d.name << "\", " << convertStr << extraTransStr << ")"
         << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
@@ -117,13 +129,20 @@ void PrintInputProcessing(
      *
      * and if the parameter is an arma::mat, we will get code like
      *
-     *     SetParam<type>(p, "<param_name>", to_matrix(<param_name>), TRUE)
+     *     <param_name> <- to_matrix(<param_name>)
+     *     SetParam<type>(p, "<param_name>", <param_name>, TRUE,
+     *         copy_all_inputs)
      *
-     * where the final boolean specifies whether the matrix should be
-     * transposed.
+     * where the two booleans specify whether the matrix should be transposed
+     * and whether it should be copied.
      */
+    if (d.cppType == "arma::mat")
+    {
+      MLPACK_COUT_STREAM << "  " << d.name << " <- to_matrix(" << d.name << ")"
+          << std::endl;
+    }
     MLPACK_COUT_STREAM << "  SetParam" << GetType<T>(d) << "(p, \""
-        << d.name << "\", to_matrix(" << d.name << ")" << extraTransStr << ")"
+        << d.name << "\", " << convertStr << extraTransStr << ")"
         << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
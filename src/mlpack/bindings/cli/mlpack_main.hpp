@@ -88,6 +88,7 @@ using Option = mlpack::bindings::cli::CLIOption<T>;
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/run_server.hpp>
 
 // Forward definition of the binding function.
 void BINDING_FUNCTION(mlpack::util::Params&, mlpack::util::Timers&);
@@ -98,6 +99,10 @@ int main(int argc, char** argv)
   // Parse the command-line options; put them into CLI.
   mlpack::util::Params params =
       mlpack::bindings::cli::ParseCommandLine(argc, argv);
+  // In server mode, the binding is run once for each request on stdin instead.
+  if (params.Has("server"))
+    return mlpack::bindings::cli::RunServer(argv[0], BINDING_FUNCTION);
+
   // Create a new timer object for this call.
   mlpack::util::Timers timers;
   timers.Enabled() = true;
@@ -121,6 +126,13 @@ PARAM_GLOBAL(std::string, "info", "Print help on a specific option.", "",
 PARAM_GLOBAL(bool, "verbose", "Display informational messages and the full "
     "list of parameters and timers at the end of execution.", "v", "bool",
     false, true, false, false);
+PARAM_GLOBAL(bool, "server", "Run as a server: read requests (JSON objects "
+    "mapping option names to values) from stdin, one per line, and keep models "
+    "in memory between requests.", "", "bool", false, true, false, false);
+PARAM_GLOBAL(int, "threads", "Number of threads to use for parallel "
+    "computations; 0 uses the default (the OMP_NUM_THREADS environment "
+    "variable, or else the number of cores).", "", "int", false, true, false,
+    0);
 PARAM_GLOBAL(bool, "version", "Display the version of mlpack.", "V", "bool",
     false, true, false, false);
 
@@ -131,12 +131,27 @@ mlpack::util::Params ParseCommandLine(
     Log::Info.ignoreInput = false;
   }
 
-  // Now, issue an error if we forgot any required options.
+  // Use the requested number of threads for the rest of the program.
+  if (parameters.count("threads") && params.Has("threads"))
+  {
+    if (params.Get<int>("threads") < 0)
+    {
+      Log::Fatal << "Invalid value for --threads ("
+          << params.Get<int>("threads") << "); must be 0 or greater!"
+          << std::endl;
+    }
+
+    Parallel::SetThreads(params.Get<int>("threads"));
+  }
+
+  // Now, issue an error if we forgot any required options.  In server mode,
+  // the options are given with each request instead.
+  const bool server = (parameters.count("server") && params.Has("server"));
   for (std::map<std::string, util::ParamData>::const_iterator iter =
        parameters.begin(); iter != parameters.end(); ++iter)
   {
     util::ParamData d = iter->second;
-    if (d.required)
+    if (d.required && !server)
     {
       // CLI11 expects the parameter name to have "--" prepended.
       std::string cliName;
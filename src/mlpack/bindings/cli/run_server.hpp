@@ -0,0 +1,522 @@
+/**
+ * @file bindings/cli/run_server.hpp
+ *
+ * Run a command-line program as a server that answers a stream of requests,
+ * keeping the models it loads and saves in memory between requests.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_RUN_SERVER_HPP
+#define MLPACK_BINDINGS_CLI_RUN_SERVER_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include "parse_command_line.hpp"
+
+#include <cctype>
+#include <iomanip>
+#include <set>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+namespace details {
+
+/**
+ * A model that is held in memory between requests, keyed by the type of the
+ * model and the name of the file it was loaded from or saved to.
+ */
+typedef std::map<std::pair<std::string, std::string>, util::ParamData>
+    ResidentModels;
+
+//! Skip any whitespace at the given position of a request.
+inline void SkipWhitespace(const std::string& line, size_t& pos)
+{
+  while (pos < line.size() && std::isspace((unsigned char) line[pos]))
+    ++pos;
+}
+
+//! Throw an error about a malformed request.
+inline void RequestError(const std::string& message, const size_t pos)
+{
+  std::ostringstream oss;
+  oss << "malformed request at character " << pos << ": " << message;
+  throw std::invalid_argument(oss.str());
+}
+
+//! Parse a JSON string that starts at the given position of a request.
+inline std::string ParseString(const std::string& line, size_t& pos)
+{
+  if (pos >= line.size() || line[pos] != '"')
+    RequestError("expected a string", pos);
+
+  std::string result;
+  ++pos;
+  while (pos < line.size() && line[pos] != '"')
+  {
+    if (line[pos] != '\\')
+    {
+      result += line[pos++];
+      continue;
+    }
+
+    if (++pos == line.size())
+      break;
+
+    const char c = line[pos++];
+    switch (c)
+    {
+      case '"': result += '"'; break;
+      case '\\': result += '\\'; break;
+      case '/': result += '/'; break;
+      case 'b': result += '\b'; break;
+      case 'f': result += '\f'; break;
+      case 'n': result += '\n'; break;
+      case 'r': result += '\r'; break;
+      case 't': result += '\t'; break;
+      case 'u':
+      {
+        if (pos + 4 > line.size())
+          RequestError("truncated \\u escape", pos);
+
+        unsigned long code = std::stoul(line.substr(pos, 4), NULL, 16);
+        pos += 4;
+        // Combine a surrogate pair into one code point.
+        if (code >= 0xD800 && code < 0xDC00 && pos + 6 <= line.size() &&
+            line[pos] == '\\' && line[pos + 1] == 'u')
+        {
+          const unsigned long low = std::stoul(line.substr(pos + 2, 4), NULL,
+              16);
+          pos += 6;
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+
+        // Encode the code point as UTF-8.
+        if (code < 0x80)
+        {
+          result += (char) code;
+        }
+        else if (code < 0x800)
+        {
+          result += (char) (0xC0 | (code >> 6));
+          result += (char) (0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+          result += (char) (0xE0 | (code >> 12));
+          result += (char) (0x80 | ((code >> 6) & 0x3F));
+          result += (char) (0x80 | (code & 0x3F));
+        }
+        else
+        {
+          result += (char) (0xF0 | (code >> 18));
+          result += (char) (0x80 | ((code >> 12) & 0x3F));
+          result += (char) (0x80 | ((code >> 6) & 0x3F));
+          result += (char) (0x80 | (code & 0x3F));
+        }
+        break;
+      }
+      default:
+        RequestError(std::string("unknown escape \\") + c, pos - 1);
+    }
+  }
+
+  if (pos >= line.size())
+    RequestError("unterminated string", pos);
+
+  ++pos; // Skip the closing quote.
+  return result;
+}
+
+/**
+ * Parse a JSON scalar (a string, number, true, false, or null) that starts at
+ * the given position of a request.  `isNull` is set if the value is null, and
+ * `isBool` if it is true or false; in that case the result is "true" or
+ * "false".
+ */
+inline std::string ParseScalar(const std::string& line,
+                               size_t& pos,
+                               bool& isNull,
+                               bool& isBool)
+{
+  isNull = false;
+  isBool = false;
+  if (pos < line.size() && line[pos] == '"')
+    return ParseString(line, pos);
+
+  // Anything else is a bare token: a number, true, false, or null.
+  const size_t begin = pos;
+  while (pos < line.size() && line[pos] != ',' && line[pos] != '}' &&
+      line[pos] != ']' && !std::isspace((unsigned char) line[pos]))
+  {
+    ++pos;
+  }
+
+  const std::string token = line.substr(begin, pos - begin);
+  if (token == "null")
+  {
+    isNull = true;
+  }
+  else if (token == "true" || token == "false")
+  {
+    isBool = true;
+  }
+  else if (token.empty() || !(std::isdigit((unsigned char) token[0]) ||
+      token[0] == '-'))
+  {
+    RequestError("expected a value", begin);
+  }
+
+  return token;
+}
+
+/**
+ * Convert a request into command-line arguments.  A request is one JSON object
+ * on a single line, whose keys are the names of command-line options (without
+ * the leading "--") and whose values are the option values: strings, numbers,
+ * true or false for flags, or arrays of those for vector options.  Options
+ * that are null or false are not passed.
+ *
+ * @param line The request.
+ * @param args The arguments are appended to this vector.
+ */
+inline void ParseRequest(const std::string& line,
+                         std::vector<std::string>& args)
+{
+  size_t pos = 0;
+  SkipWhitespace(line, pos);
+  if (pos >= line.size() || line[pos] != '{')
+    RequestError("expected '{'", pos);
+  ++pos;
+
+  SkipWhitespace(line, pos);
+  bool first = true;
+  while (pos < line.size() && line[pos] != '}')
+  {
+    if (!first)
+    {
+      if (line[pos] != ',')
+        RequestError("expected ',' or '}'", pos);
+      ++pos;
+      SkipWhitespace(line, pos);
+    }
+    first = false;
+
+    const std::string name = ParseString(line, pos);
+    if (name == "help" || name == "info" || name == "version" ||
+        name == "server")
+    {
+      throw std::invalid_argument("option '" + name + "' cannot be given in "
+          "a request");
+    }
+
+    SkipWhitespace(line, pos);
+    if (pos >= line.size() || line[pos] != ':')
+      RequestError("expected ':'", pos);
+    ++pos;
+    SkipWhitespace(line, pos);
+
+    bool isNull, isBool;
+    if (pos < line.size() && line[pos] == '[')
+    {
+      ++pos;
+      SkipWhitespace(line, pos);
+      while (pos < line.size() && line[pos] != ']')
+      {
+        const std::string value = ParseScalar(line, pos, isNull, isBool);
+        if (isNull)
+          RequestError("null in array", pos);
+        args.push_back("--" + name + "=" + value);
+
+        SkipWhitespace(line, pos);
+        if (pos < line.size() && line[pos] == ',')
+        {
+          ++pos;
+          SkipWhitespace(line, pos);
+        }
+        else if (pos < line.size() && line[pos] != ']')
+        {
+          RequestError("expected ',' or ']'", pos);
+        }
+      }
+
+      if (pos >= line.size())
+        RequestError("unterminated array", pos);
+      ++pos; // Skip the closing bracket.
+    }
+    else
+    {
+      // Pass the value with '=' so that CLI11 does not mistake a value that
+      // starts with '-' for an option.
+      const std::string value = ParseScalar(line, pos, isNull, isBool);
+      if (isBool && value == "true")
+        args.push_back("--" + name);
+      else if (!isNull && !isBool)
+        args.push_back("--" + name + "=" + value);
+    }
+
+    SkipWhitespace(line, pos);
+  }
+
+  if (pos >= line.size())
+    RequestError("expected '}'", pos);
+}
+
+//! Escape a string so that it can be written as a JSON string.
+inline std::string EscapeString(const std::string& str)
+{
+  std::ostringstream oss;
+  oss << '"';
+  for (const char c : str)
+  {
+    switch (c)
+    {
+      case '"': oss << "\\\""; break;
+      case '\\': oss << "\\\\"; break;
+      case '\n': oss << "\\n"; break;
+      case '\r': oss << "\\r"; break;
+      case '\t': oss << "\\t"; break;
+      default:
+        if ((unsigned char) c < 0x20)
+        {
+          oss << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+              << (int) c << std::dec;
+        }
+        else
+        {
+          oss << c;
+        }
+    }
+  }
+  oss << '"';
+  return oss.str();
+}
+
+/**
+ * Give every input model of a request that is held in memory to the request,
+ * so that the binding does not load it from its file.
+ */
+inline void UseResidentModels(util::Params& params, ResidentModels& models)
+{
+  for (auto& it : params.Parameters())
+  {
+    util::ParamData& d = it.second;
+    if (!d.input || d.wasPassed == 0)
+      continue;
+
+    // Only models of the types that are held need to be checked.
+    ResidentModels::iterator model = models.lower_bound(
+        std::make_pair(d.tname, std::string()));
+    if (model == models.end() || model->first.first != d.tname)
+      continue;
+
+    // For models, the printable value is the name of the file.
+    std::string filename;
+    params.functionMap[d.tname]["GetPrintableParam"](d, NULL,
+        (void*) &filename);
+    model = models.find(std::make_pair(d.tname, filename));
+    if (model == models.end())
+      continue;
+
+    void* memory;
+    params.functionMap[d.tname]["GetAllocatedMemory"](model->second, NULL,
+        (void*) &memory);
+    void** pointer;
+    params.functionMap[d.tname]["GetRawParam"](d, NULL, (void*) &pointer);
+    *pointer = memory;
+    d.loaded = true;
+  }
+}
+
+/**
+ * After a request, hold in memory every model that now matches its file: the
+ * output models, and the input models that were not also returned as output
+ * models (those may have been modified).  If `success` is false, no models are
+ * kept.  All other models of the request, and any models that are no longer
+ * held, are deleted.
+ */
+inline void KeepResidentModels(util::Params& params,
+                               ResidentModels& models,
+                               const bool success)
+{
+  std::map<std::string, util::ParamData>& parameters = params.Parameters();
+  std::vector<util::ParamData> released;
+
+  if (success)
+  {
+    std::set<void*> outputs;
+    for (auto& it : parameters)
+    {
+      void* memory;
+      params.functionMap[it.second.tname]["GetAllocatedMemory"](it.second,
+          NULL, (void*) &memory);
+      if (!it.second.input && memory != NULL)
+        outputs.insert(memory);
+    }
+
+    // Handle the input models first, so that an output model saved to the file
+    // an input model came from replaces it.
+    for (const bool input : { true, false })
+    {
+      for (auto& it : parameters)
+      {
+        util::ParamData& d = it.second;
+        void* memory;
+        params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+            (void*) &memory);
+        if (d.input != input || memory == NULL)
+          continue;
+
+        std::string filename;
+        params.functionMap[d.tname]["GetPrintableParam"](d, NULL,
+            (void*) &filename);
+        if (filename == "")
+          continue;
+
+        const std::pair<std::string, std::string> key(d.tname, filename);
+        ResidentModels::iterator model = models.find(key);
+        if (model != models.end())
+        {
+          released.push_back(model->second);
+          models.erase(model);
+        }
+
+        if (!input || outputs.count(memory) == 0)
+          models.insert(std::make_pair(key, d));
+      }
+    }
+  }
+
+  // Collect the memory that is still held.
+  std::set<void*> held;
+  for (auto& it : models)
+  {
+    void* memory;
+    params.functionMap[it.second.tname]["GetAllocatedMemory"](it.second, NULL,
+        (void*) &memory);
+    held.insert(memory);
+  }
+
+  // Delete everything else, being careful to delete shared pointers only once.
+  for (auto& it : parameters)
+    released.push_back(it.second);
+
+  for (util::ParamData& d : released)
+  {
+    void* memory;
+    params.functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &memory);
+    if (memory != NULL && held.count(memory) == 0)
+    {
+      params.functionMap[d.tname]["DeleteAllocatedMemory"](d, NULL, NULL);
+      held.insert(memory);
+    }
+  }
+}
+
+} // namespace details
+
+/**
+ * Run the binding as a server.  Each line read from stdin is a request: a JSON
+ * object that maps the names of command-line options to their values, for
+ * instance
+ *
+ * @code
+ * {"input_model_file": "model.bin", "test_file": "test.csv",
+ *  "predictions_file": "predictions.csv"}
+ * @endcode
+ *
+ * The binding is run with those options, and one line is written to stdout in
+ * reply: a JSON object with "status" set to "ok" and "output" holding what the
+ * binding printed, or with "status" set to "error" and "message" describing
+ * what went wrong.  Models that a request loads from or saves to a file are
+ * kept in memory, and later requests that give the same file get the model in
+ * memory instead of loading it again.  (So, model files should not be changed
+ * by anything else while the server is running.)  The server stops at the end
+ * of stdin.
+ *
+ * @param programName Name of the program, used as argv[0] of each request.
+ * @param bindingFunction The function that runs the binding.
+ */
+inline int RunServer(const std::string& programName,
+                     void (*bindingFunction)(util::Params&, util::Timers&))
+{
+  details::ResidentModels models;
+  std::streambuf* coutBuffer = std::cout.rdbuf();
+  std::streambuf* cerrBuffer = std::cerr.rdbuf();
+
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    // Capture everything the binding prints, including the errors Log::Fatal
+    // prints before it throws.
+    std::ostringstream output;
+    std::cout.rdbuf(output.rdbuf());
+    std::cerr.rdbuf(output.rdbuf());
+
+    util::Params params = IO::Parameters(STRINGIFY(BINDING_NAME));
+    std::string message;
+    bool success = true;
+    try
+    {
+      std::vector<std::string> args(1, programName);
+      details::ParseRequest(line, args);
+      std::vector<char*> argv;
+      for (std::string& arg : args)
+        argv.push_back(&arg[0]);
+
+      params = ParseCommandLine((int) argv.size(), argv.data());
+      details::UseResidentModels(params, models);
+
+      util::Timers timers;
+      timers.Enabled() = true;
+      timers.Start("total_time");
+      bindingFunction(params, timers);
+      timers.StopAllTimers();
+
+      for (auto& it : params.Parameters())
+      {
+        util::ParamData& d = it.second;
+        if (!d.input)
+          params.functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+      }
+    }
+    catch (std::exception& e)
+    {
+      success = false;
+      message = e.what();
+    }
+
+    details::KeepResidentModels(params, models, success);
+
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+    if (success)
+    {
+      std::cout << "{\"status\": \"ok\", \"output\": "
+          << details::EscapeString(output.str()) << "}" << std::endl;
+    }
+    else
+    {
+      std::cout << "{\"status\": \"error\", \"message\": "
+          << details::EscapeString(message) << ", \"output\": "
+          << details::EscapeString(output.str()) << "}" << std::endl;
+    }
+  }
+
+  // Delete the models that are still held.
+  util::Params params = IO::Parameters(STRINGIFY(BINDING_NAME));
+  details::KeepResidentModels(params, models, false);
+  return 0;
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -90,12 +90,40 @@ func (m *mlpackArma) allocArmaPtrMatWithInfo(p *params,
   runtime.KeepAlive(m)
 }
 
+// Returns the underlying data of a Gonum matrix, in row-major order.  The data
+// is only copied if the matrix is a view whose rows are not contiguous (for
+// instance, a slice of a larger matrix).  The data is kept alive by the
+// parameters, since mlpack keeps a pointer to it.
+func contiguousData(p *params, m *mat.Dense) []float64 {
+  _, c := m.Dims()
+  blas64General := m.RawMatrix()
+  if blas64General.Stride != c {
+    blas64General = mat.DenseCopyOf(m).RawMatrix()
+  }
+  p.inputData = append(p.inputData, blas64General.Data)
+  return blas64General.Data
+}
+
+// Returns the underlying data of a Gonum matrix with a single row or column,
+// which is only copied if its elements are not contiguous.  The data is kept
+// alive by the parameters, since mlpack keeps a pointer to it.
+func contiguousVectorData(p *params, m *mat.Dense) []float64 {
+  r, _ := m.Dims()
+  blas64General := m.RawMatrix()
+  if r != 1 && blas64General.Stride != 1 {
+    blas64General = mat.DenseCopyOf(m).RawMatrix()
+  }
+  p.inputData = append(p.inputData, blas64General.Data)
+  return blas64General.Data
+}
+
 // Passes a Gonum matrix to C by using the underlying data from the Gonum matrix.
+// Since Gonum matrices are row-major, a matrix whose rows are points is already
+// laid out as mlpack expects, and is used by mlpack without any copy.
 func gonumToArmaMat(p *params, identifier string, m *mat.Dense, trans bool) {
   // Get the number of elements in the Armadillo column.
   r, c := m.Dims()
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -107,8 +135,7 @@ func gonumToArmaMat(p *params, identifier string, m *mat.Dense, trans bool) {
 func gonumToArmaUmat(p *params, identifier string, m *mat.Dense) {
   // Get the number of elements in the Armadillo column.
   r, c := m.Dims()
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -124,14 +151,12 @@ func gonumToArmaRow(p *params, identifier string, m *mat.Dense) {
     panic("Given matrix must have a single column")
   }
 
-  // Transpose if Column vector is given
+  // A column vector holds the same elements as a row vector.
   if e == 1 {
-    m = mat.DenseCopyOf(m.T())
     e = err
   }
 
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousVectorData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -147,14 +172,12 @@ func gonumToArmaUrow(p *params, identifier string, m *mat.Dense) {
     panic("Given matrix must have a single column")
   }
 
-  // Transpose if Column vector is given
+  // A column vector holds the same elements as a row vector.
   if e == 1 {
-    m = mat.DenseCopyOf(m.T())
     e = err
   }
 
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousVectorData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -170,14 +193,12 @@ func gonumToArmaCol(p *params, identifier string, m *mat.Dense) {
     panic("Given matrix must have a single row")
   }
 
-  // Transpose if Row vector is given
+  // A row vector holds the same elements as a column vector.
   if e == 1 {
-    m = mat.DenseCopyOf(m.T())
     e = err
   }
 
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousVectorData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -193,14 +214,12 @@ func gonumToArmaUcol(p *params, identifier string, m *mat.Dense) {
     panic("Given matrix must have a single row")
   }
 
-  // Transpose if Row vector is given
+  // A row vector holds the same elements as a column vector.
   if e == 1 {
-    m = mat.DenseCopyOf(m.T())
     e = err
   }
 
-  blas64General := m.RawMatrix()
-  data := blas64General.Data
+  data := contiguousVectorData(p, m)
 
   // Pass pointer of the underlying matrix to mlpack.
   ptr := unsafe.Pointer(&data[0])
@@ -215,8 +234,7 @@ func gonumToArmaMatWithInfo(p *params,
                             m *matrixWithInfo) {
   // Get the number of elements in the Armadillo column.
   r, c := m.Data.Dims()
-  blas64General := m.Data.RawMatrix()
-  dataAndInfo := blas64General.Data
+  dataAndInfo := contiguousData(p, m.Data)
   boolarray := m.Categoricals
   // Pass pointer of the underlying matrix to mlpack.
   boolptr := unsafe.Pointer(&boolarray[0])
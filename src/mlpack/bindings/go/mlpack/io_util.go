@@ -14,6 +14,9 @@ import (
 
 type params struct {
   mem unsafe.Pointer
+  // The memory of the input matrices, which mlpack uses without a copy; it is
+  // referenced here so that it stays alive until the binding has run.
+  inputData [][]float64
 }
 
 type timers struct {
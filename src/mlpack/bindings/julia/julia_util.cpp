@@ -146,18 +146,24 @@ void SetParamVectorInt(void* params,
 
 /**
  * Call params.SetParam<arma::mat>().
+ *
+ * Unless `copy` is true (which Julia asks for when the memory belongs to a
+ * temporary converted array), the matrix is an alias of the Julia memory, so
+ * no memory is copied unless the matrix must be transposed.
  */
 void SetParamMat(void* params,
                  const char* paramName,
                  double* memptr,
                  const size_t rows,
                  const size_t cols,
-                 const bool pointsAsRows)
+                 const bool pointsAsRows,
+                 const bool copy)
 {
   util::Params* p = (util::Params*) params;
 
-  // Create the matrix as an alias.
-  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, false);
+  // Create the matrix as an alias (the transpose is a copy anyway).
+  arma::mat m(memptr, arma::uword(rows), arma::uword(cols),
+      copy && !pointsAsRows, false);
   p->Get<arma::mat>(paramName) = pointsAsRows ? m.t() : std::move(m);
   p->SetPassed(paramName);
 }
@@ -177,12 +183,15 @@ void SetParamUMat(void* params,
 {
   util::Params* p = (util::Params*) params;
 
-  // Create the matrix as an alias.
-  arma::Mat<long long> m(memptr, arma::uword(rows), arma::uword(cols), true,
+  // Create the matrix as an alias; the conversion is the only copy.
+  arma::Mat<long long> m(memptr, arma::uword(rows), arma::uword(cols), false,
       true);
-  arma::Mat<size_t> convM = arma::conv_to<arma::Mat<size_t>>::from(m - 1);
-  p->Get<arma::Mat<size_t>>(paramName) = pointsAsRows ? convM.t() :
-      std::move(convM);
+  arma::Mat<size_t> convM = arma::conv_to<arma::Mat<size_t>>::from(m);
+  convM -= 1;
+  if (pointsAsRows)
+    arma::inplace_trans(convM);
+
+  p->Get<arma::Mat<size_t>>(paramName) = std::move(convM);
   p->SetPassed(paramName);
 }
 
@@ -192,10 +201,11 @@ void SetParamUMat(void* params,
 void SetParamRow(void* params,
                  const char* paramName,
                  double* memptr,
-                 const size_t cols)
+                 const size_t cols,
+                 const bool copy)
 {
   util::Params* p = (util::Params*) params;
-  arma::rowvec m(memptr, arma::uword(cols), false, false);
+  arma::rowvec m(memptr, arma::uword(cols), copy, false);
   p->Get<arma::rowvec>(paramName) = std::move(m);
   p->SetPassed(paramName);
 }
@@ -221,10 +231,11 @@ void SetParamURow(void* params,
 void SetParamCol(void* params,
                  const char* paramName,
                  double* memptr,
-                 const size_t rows)
+                 const size_t rows,
+                 const bool copy)
 {
   util::Params* p = (util::Params*) params;
-  arma::vec m(memptr, arma::uword(rows), false, false);
+  arma::vec m(memptr, arma::uword(rows), copy, false);
   p->Get<arma::vec>(paramName) = std::move(m);
   p->SetPassed(paramName);
 }
@@ -266,8 +277,16 @@ void SetParamMatWithInfo(void* params,
       hasCategoricals = true;
   }
 
+  // The categorical dimensions are modified below, so the data can only be
+  // used without a copy if it has none and does not have to be transposed.
   arma::mat alias(memptr, arma::uword(rows), arma::uword(cols), false, false);
-  arma::mat m = pointsAreRows ? alias.t() : alias;
+  arma::mat m;
+  if (pointsAreRows)
+    m = alias.t();
+  else if (hasCategoricals)
+    m = alias;
+  else
+    m = std::move(alias);
 
   // Do we need to find how many categories we have?
   if (hasCategoricals)
@@ -100,7 +100,8 @@ void SetParamMat(void* params,
                  double* memptr,
                  const size_t rows,
                  const size_t cols,
-                 const bool pointsAsRows);
+                 const bool pointsAsRows,
+                 const bool copy);
 
 /**
  * Call params.SetParam<arma::Mat<size_t>>().
@@ -121,7 +122,8 @@ void SetParamUMat(void* params,
 void SetParamRow(void* params,
                  const char* paramName,
                  double* memptr,
-                 const size_t cols);
+                 const size_t cols,
+                 const bool copy);
 
 /**
  * Call params.SetParam<arma::Row<size_t>>().
@@ -140,7 +142,8 @@ void SetParamURow(void* params,
 void SetParamCol(void* params,
                  const char* paramName,
                  double* memptr,
-                 const size_t rows);
+                 const size_t rows,
+                 const bool copy);
 
 /**
  * Call params.SetParam<arma::Col<size_t>>().
@@ -7,7 +7,9 @@ and numpy objects without actually copying memory.  Note that if a numpy matrix
 is converted to an Armadillo object, then the Armadillo object will "own" the
 matrix and free the memory upon destruction (and the numpy object will no longer
 "own" the matrix).  Similarly, if an Armadillo object is converted to a numpy
-object, then the numpy object will "own" the matrix.
+object, then the numpy object will "own" the matrix (through a capsule that
+frees the memory with Armadillo's deallocator when the numpy object is
+destroyed).
 
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
@@ -25,6 +27,7 @@ numpy.import_array()
 
 from .arma cimport Mat, Row, Col
 from libcpp cimport bool
+from cpython.pycapsule cimport PyCapsule_New, PyCapsule_Destructor
 
 import platform
 isWin = (platform.system() == "Windows")
@@ -45,21 +48,44 @@ cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
   size_t* GetMemory(Mat[size_t]& m)
   size_t* GetMemory(Col[size_t]& m)
   size_t* GetMemory(Row[size_t]& m)
+  void ReleaseArmaMemory(object capsule)
+
+cdef bool must_copy(numpy.ndarray X, bool takeOwnership):
+  """
+  Return whether X has to be copied before an Armadillo object can use its
+  memory: that is the case if X is not C-contiguous, if X is read-only (bindings
+  may modify their inputs), or if the Armadillo object must take ownership of
+  memory that numpy does not own.  (On Windows, Armadillo copies memory it must
+  take ownership of itself, since it cannot free memory allocated by numpy.)
+  """
+  cdef int flags = PyArray_FLAGS(X)
+  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
+      not (flags & numpy.NPY_ARRAY_WRITEABLE):
+    return True
+
+  return takeOwnership and not isWin and not (flags & numpy.NPY_ARRAY_OWNDATA)
+
+cdef void own_arma_memory(numpy.ndarray output) except *:
+  """
+  Give the ndarray ownership of the Armadillo-allocated memory it wraps, without
+  copying it.  The array holds a capsule that frees the memory with Armadillo's
+  deallocator, which need not be the one numpy would use.
+  """
+  numpy.set_array_base(output, PyCapsule_New(PyArray_DATA(output), NULL,
+      <PyCapsule_Destructor> ReleaseArmaMemory))
 
 cdef Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                  bool takeOwnership) except +:
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
+  if must_copy(X, takeOwnership):
     # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Mat[double]* m = new Mat[double](<double*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Take ownership of the memory, if we need to and we are not on Windows.
   if takeOwnership and not isWin:
@@ -73,16 +99,13 @@ cdef Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if must_copy(X, takeOwnership):
+    # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Mat[size_t]* m = new Mat[size_t](<size_t*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[1], PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Take ownership of the memory, if we need to.
   if takeOwnership and not isWin:
@@ -102,13 +125,11 @@ cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(Mat[double]& X) \
   dims[1] = <numpy.npy_intp> X.n_rows
   cdef numpy.ndarray[numpy.double_t, ndim=2] output = \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_DOUBLE, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Mat[double]](X) == 0 and not isWin:
+  if GetMemState[Mat[double]](X) == 0:
     SetMemState[Mat[double]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
 
@@ -123,13 +144,11 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(Mat[size_t]& X) \
   dims[1] = <numpy.npy_intp> X.n_rows
   cdef numpy.ndarray[numpy.npy_intp, ndim=2] output = \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_INTP, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Mat[size_t]](X) == 0 and not isWin:
+  if GetMemState[Mat[size_t]](X) == 0:
     SetMemState[Mat[size_t]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
 
@@ -139,16 +158,13 @@ cdef Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if must_copy(X, takeOwnership):
+    # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Row[double]* m = new Row[double](<double*> PyArray_DATA(X),
-    PyArray_SHAPE(X)[0], isWin, False)
+    PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -163,16 +179,13 @@ cdef Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if must_copy(X, takeOwnership):
+    # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Row[size_t]* m = new Row[size_t](<size_t*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -190,13 +203,11 @@ cdef numpy.ndarray[numpy.double_t, ndim=1] row_to_numpy_d(Row[double]& X) \
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.double_t, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Row[double]](X) == 0 and not isWin:
+  if GetMemState[Row[double]](X) == 0:
     SetMemState[Row[double]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
 
@@ -205,18 +216,15 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=1] row_to_numpy_s(Row[size_t]& X) \
   """
   Convert an Armadillo row vector to a one-dimensional numpy ndarray.
   """
-#  print("called row_to_numpy_s()\n")
   # Extract dimensions.
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.npy_intp, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Row[size_t]](X) == 0 and not isWin:
+  if GetMemState[Row[size_t]](X) == 0:
     SetMemState[Row[size_t]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
 
@@ -226,16 +234,13 @@ cdef Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if must_copy(X, takeOwnership):
+    # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Col[double]* m = new Col[double](<double*> PyArray_DATA(X),
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -250,16 +255,13 @@ cdef Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  cdef int flags = PyArray_FLAGS(X)
-  if not (flags & numpy.NPY_ARRAY_C_CONTIGUOUS) or \
-    (not (flags & numpy.NPY_ARRAY_OWNDATA) and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if must_copy(X, takeOwnership):
+    # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
   cdef Col[size_t]* m = new Col[size_t](<size_t*> PyArray_DATA(X), 
-      PyArray_SHAPE(X)[0], isWin, False)
+      PyArray_SHAPE(X)[0], takeOwnership and isWin, False)
 
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
@@ -277,13 +279,11 @@ cdef numpy.ndarray[numpy.double_t, ndim=1] col_to_numpy_d(Col[double]& X) \
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.double_t, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Col[double]](X) == 0 and not isWin:
+  if GetMemState[Col[double]](X) == 0:
     SetMemState[Col[double]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
 
@@ -296,12 +296,10 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=1] col_to_numpy_s(Col[size_t]& X) \
   cdef numpy.npy_intp dim = <numpy.npy_intp> X.n_elem
   cdef numpy.ndarray[numpy.npy_intp, ndim=1] output = \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, GetMemory(X))
-  if isWin:
-    output = output.copy(order="C")
 
   # Transfer memory ownership, if needed.
-  if GetMemState[Col[size_t]](X) == 0 and not isWin:
+  if GetMemState[Col[size_t]](X) == 0:
     SetMemState[Col[size_t]](X, 1)
-    PyArray_ENABLEFLAGS(output, numpy.NPY_ARRAY_OWNDATA)
+    own_arma_memory(output)
 
   return output
@@ -2,7 +2,8 @@
  * @file bindings/python/mlpack/arma_util.hpp
  * @author Ryan Curtin
  *
- * Utility function for Cython to set the memory state of an Armadillo object.
+ * Utility functions for Cython to set the memory state of an Armadillo object
+ * and hand its memory over to NumPy.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -12,6 +13,8 @@
 #ifndef MLPACK_BINDINGS_PYTHON_CYTHON_ARMA_UTIL_HPP
 #define MLPACK_BINDINGS_PYTHON_CYTHON_ARMA_UTIL_HPP
 
+#include <Python.h>
+
 // Include Armadillo via mlpack.
 #include <mlpack/core.hpp>
 
@@ -65,4 +68,15 @@ inline typename T::elem_type* GetMemory(T& m)
   }
 }
 
+/**
+ * Free memory that was allocated by Armadillo and handed over to a NumPy array.
+ * This is the destructor of the capsule that such an array holds as its base
+ * object, so the memory is freed with Armadillo's deallocator (which, on
+ * Windows for instance, is not the one NumPy uses).
+ */
+inline void ReleaseArmaMemory(PyObject* capsule)
+{
+  arma::memory::release((char*) PyCapsule_GetPointer(capsule, NULL));
+}
+
 #endif
@@ -4,8 +4,8 @@ io.pyx: Cython functionality for mlpack::IO and other utilities.
 
 This file imports the Parameters() function from mlpack::IO, plus other utility
 functions: SetParam(), SetParamPtr(), SetParamWithInfo(), GetParam(),
-GetParamWithInfo(), EnableVerbose(), DisableVerbose(), DisableBacktrace(),
-EnableTimers() and ResetTimers().
+GetParamWithInfo(), EnableVerbose(), DisableVerbose(), SetCallThreads(),
+RestoreCallThreads(), DisableBacktrace(), EnableTimers() and ResetTimers().
 
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
@@ -33,5 +33,7 @@ cdef extern from "<mlpack/bindings/python/mlpack/io_util.hpp>" \
   void EnableVerbose() nogil except +
   void DisableVerbose() nogil except +
   void DisableBacktrace() nogil except +
+  size_t SetCallThreads(Params) nogil except +
+  void RestoreCallThreads(size_t) nogil except +
   void ResetTimers() nogil except +
   void EnableTimers() nogil except +
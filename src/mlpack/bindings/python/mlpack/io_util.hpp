@@ -14,8 +14,11 @@
 #define MLPACK_BINDINGS_PYTHON_CYTHON_IO_UTIL_HPP
 
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/parallel.hpp>
 #include <mlpack/core/data/dataset_mapper.hpp>
 
+#include <atomic>
+
 namespace mlpack {
 namespace util {
 
@@ -154,19 +157,65 @@ T& GetParamWithInfo(util::Params& params,
 }
 
 /**
- * Turn verbose output on.
+ * Get the number of binding calls that are running with verbose output; since
+ * Log::Info is shared by all calls, it prints while any of them is running.
+ */
+inline std::atomic<size_t>& VerboseCalls()
+{
+  static std::atomic<size_t> verboseCalls(0);
+  return verboseCalls;
+}
+
+/**
+ * Turn verbose output on for a binding call.  Every call to EnableVerbose()
+ * must be matched by a call to DisableVerbose().
  */
 inline void EnableVerbose()
 {
+  ++VerboseCalls();
   Log::Info.ignoreInput = false;
 }
 
 /**
- * Turn verbose output off.
+ * Turn verbose output off for a binding call; it stays on if other calls are
+ * still running with verbose output.
  */
 inline void DisableVerbose()
 {
-  Log::Info.ignoreInput = true;
+  if (--VerboseCalls() == 0)
+    Log::Info.ignoreInput = true;
+}
+
+/**
+ * Set the number of threads for a binding call, if the threads option was
+ * given.  The number of threads before the call is returned (or 0 if it was not
+ * changed), and must be given to RestoreCallThreads() when the call ends.
+ */
+inline size_t SetCallThreads(util::Params& params)
+{
+  if (!params.Has("threads"))
+    return 0;
+
+  if (params.Get<int>("threads") < 0)
+  {
+    std::ostringstream oss;
+    oss << "Invalid value for threads (" << params.Get<int>("threads")
+        << "); must be 0 or greater!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t previous = Parallel::Threads();
+  Parallel::SetThreads(params.Get<int>("threads"));
+  return previous;
+}
+
+/**
+ * Restore the number of threads after a binding call.
+ */
+inline void RestoreCallThreads(const size_t previous)
+{
+  if (previous != 0)
+    Parallel::SetThreads(previous);
 }
 
 /**
@@ -140,6 +140,10 @@ PARAM_GLOBAL(bool, "copy_all_inputs", "If specified, all input parameters "
     "debugging problems where the input parameters are being modified "
     "by the algorithm, but can slow down the code.", "", "bool",
     false, true, false, false);
+PARAM_GLOBAL(int, "threads", "Number of threads to use for parallel "
+    "computations; 0 uses the default (the OMP_NUM_THREADS environment "
+    "variable, or else the number of cores).", "", "int", false, true, false,
+    0);
 PARAM_GLOBAL(bool, "check_input_matrices", "If specified, the input matrix "
     "is checked for NaN and inf values; an exception is thrown if any are "
     "found.", "", "bool", false, true, false, false);
@@ -64,8 +64,11 @@ void PrintClassDefn(
    *   cdef <ModelType>* modelptr
    *   cdef public dict scrubbed_params
    *
-   *   def __cinit__(self):
-   *     self.modelptr = new <ModelType>()
+   *   def __cinit__(self, allocate=True):
+   *     if allocate:
+   *       self.modelptr = new <ModelType>()
+   *     else:
+   *       self.modelptr = <<ModelType>*> 0
    *     self.scrubbed_params = dict()
    *
    *   def __dealloc__(self):
@@ -100,8 +103,13 @@ void PrintClassDefn(
   std::cout << "  cdef " << printedType << "* modelptr" << std::endl;
   std::cout << "  cdef public dict scrubbed_params" << std::endl;
   std::cout << std::endl;
-  std::cout << "  def __cinit__(self):" << std::endl;
-  std::cout << "    self.modelptr = new " << printedType << "()" << std::endl;
+  // Models that are returned by a binding hold the pointer the binding made,
+  // so there is no need to allocate a default model for them.
+  std::cout << "  def __cinit__(self, allocate=True):" << std::endl;
+  std::cout << "    if allocate:" << std::endl;
+  std::cout << "      self.modelptr = new " << printedType << "()" << std::endl;
+  std::cout << "    else:" << std::endl;
+  std::cout << "      self.modelptr = <" << printedType << "*> 0" << std::endl;
   std::cout << "    self.scrubbed_params = dict()" << std::endl;
   std::cout << std::endl;
   std::cout << "  def __dealloc__(self):" << std::endl;
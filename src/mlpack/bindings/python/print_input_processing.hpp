@@ -92,9 +92,6 @@ void PrintInputProcessing(
     std::cout << prefix << "    p.SetPassed(<const string> '" << d.name
         << "')" << std::endl;
 
-    // If this parameter is "verbose", then enable verbose output.
-    if (d.name == "verbose")
-    std::cout << prefix << "    EnableVerbose()" << std::endl;
 
     if (GetPrintableType<T>(d) == "bool")
     {
@@ -185,10 +185,11 @@ void PrintOutputProcessing(
     /**
      * This gives us code like:
      *
-     * result = ModelType()
+     * result = ModelType(False)
      * (<ModelType?> result).modelptr = GetParamPtr[Model](p, 'name')
      */
-    std::cout << prefix << "result = " << strippedType << "Type()" << std::endl;
+    std::cout << prefix << "result = " << strippedType << "Type(False)"
+        << std::endl;
     std::cout << prefix << "(<" << strippedType << "Type?> result).modelptr = "
         << "GetParamPtr[" << strippedType << "](p, '" << d.name << "')"
         << std::endl;
@@ -207,7 +208,7 @@ void PrintOutputProcessing(
       if (data.input && data.cppType == d.cppType && data.required)
       {
         std::cout << prefix << "if (<" << strippedType
-            << "Type> result).modelptr" << d.name << " == (<" << strippedType
+            << "Type> result).modelptr == (<" << strippedType
             << "Type> " << data.name << ").modelptr:" << std::endl;
         std::cout << prefix << "  (<" << strippedType
             << "Type> result).modelptr = <" << strippedType << "*> 0"
@@ -219,7 +220,7 @@ void PrintOutputProcessing(
         std::cout << prefix << "if " << data.name << " is not None:"
             << std::endl;
         std::cout << prefix << "  if (<" << strippedType
-            << "Type> result).modelptr" << d.name << " == (<" << strippedType
+            << "Type> result).modelptr == (<" << strippedType
             << "Type> " << data.name << ").modelptr:" << std::endl;
         std::cout << prefix << "    (<" << strippedType
             << "Type> result).modelptr = <" << strippedType << "*> 0"
@@ -233,11 +234,11 @@ void PrintOutputProcessing(
     /**
      * This gives us code like:
      *
-     * result['name'] = ModelType()
+     * result['name'] = ModelType(False)
      * (<ModelType?> result['name']).modelptr = GetParamPtr[Model](p, 'name'))
      */
     std::cout << prefix << "result['" << d.name << "'] = " << strippedType
-        << "Type()" << std::endl;
+        << "Type(False)" << std::endl;
     std::cout << prefix << "(<" << strippedType << "Type?> result['" << d.name
         << "']).modelptr = GetParamPtr[" << strippedType << "](p, '" << d.name
         << "')" << std::endl;
@@ -84,7 +84,8 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "from .io cimport SetParam, SetParamPtr, SetParamWithInfo, "
       << "GetParamPtr" << endl;
   cout << "from .io cimport EnableVerbose, DisableVerbose, DisableBacktrace, "
-      << "ResetTimers, EnableTimers" << endl;
+      << "ResetTimers, EnableTimers, SetCallThreads, RestoreCallThreads"
+      << endl;
   cout << "from .matrix_utils import to_matrix, to_matrix_with_info" << endl;
   cout << "from .preprocess_json_params import process_params_out, "
       << "process_params_in" << endl;
@@ -198,11 +199,10 @@ void PrintPYX(const util::BindingDetails& doc,
       << "returned." << endl;
   cout << "  \"\"\"" << endl;
 
-  // Reset any timers and disable backtraces.
-  cout << "  ResetTimers()" << endl;
+  // Enable timers and disable backtraces.  The global timers are not reset,
+  // since other calls running at the same time may be using them.
   cout << "  EnableTimers()" << endl;
   cout << "  DisableBacktrace()" << endl;
-  cout << "  DisableVerbose()" << endl;
 
   // Get the Params object from IO.
   cout << "  cdef Params p = IO.Parameters(\"" << bindingName << "\")"
@@ -249,9 +249,24 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "  if check_input_matrices:" << endl;
   cout << "    p.CheckInputMatrices()" << endl;
 
-  // Call the method.
+  // Call the method.  The binding does not touch any Python objects, so the
+  // GIL is released while it runs; other Python threads (for instance, ones
+  // making predictions with other models) can then run at the same time.
+  // Verbose output and the number of threads are changed only while the
+  // binding runs, so that calls from other threads are not affected once this
+  // one ends.  (The number of threads only applies to the calling thread.)
   cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpack_" << bindingName << "(p, t)" << endl;
+  cout << "  cdef size_t previous_threads = SetCallThreads(p)" << endl;
+  cout << "  cdef cbool verbose_call = p.Has(<const string> 'verbose')" << endl;
+  cout << "  if verbose_call:" << endl;
+  cout << "    EnableVerbose()" << endl;
+  cout << "  try:" << endl;
+  cout << "    with nogil:" << endl;
+  cout << "      mlpack_" << bindingName << "(p, t)" << endl;
+  cout << "  finally:" << endl;
+  cout << "    RestoreCallThreads(previous_threads)" << endl;
+  cout << "    if verbose_call:" << endl;
+  cout << "      DisableVerbose()" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
@@ -13,6 +13,7 @@ import unittest
 import pandas as pd
 import numpy as np
 import copy
+import concurrent.futures
 
 from mlpack.test_python_binding import test_python_binding
 
@@ -157,6 +158,62 @@ class TestPythonBinding(unittest.TestCase):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
 
 
+  def testNumpyMatrixView(self):
+    """
+    A C-contiguous view of a matrix (which does not own its memory) should be
+    usable as input, and the output should own its memory.
+    """
+    z = np.random.rand(200, 5)
+    x = z[50:150]
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=x)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    self.assertEqual(output['matrix_out'].dtype, np.double)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(z[50 + j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * z[50 + j, 2], output['matrix_out'][j, 2])
+
+    # The output must stay valid after the input is gone.
+    del x, z
+    self.assertEqual(np.sum(np.isfinite(output['matrix_out'])), 400)
+
+  def testNumpyReadOnlyMatrix(self):
+    """
+    A read-only matrix should be usable as input, and must not be modified.
+    """
+    x = np.random.rand(100, 5)
+    z = copy.deepcopy(x)
+    z.flags.writeable = False
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+      for i in range(5):
+        self.assertEqual(x[j, i], z[j, i])
+
+
   def testNumpyFContiguousMatrix(self):
     """
     The matrix with F_CONTIGUOUS set we pass in, we should get back with the third
@@ -896,6 +953,31 @@ class TestPythonBinding(unittest.TestCase):
 
     self.assertEqual(output2['model_bw_out'], 20.0)
 
+  def testModelFromThreads(self):
+    """
+    Calls that use the same model from several threads at once should all give
+    the right result.
+    """
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 build_model=True)
+
+    def use_model():
+      return test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 model_in=output['model_out'])['model_bw_out']
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=4) as executor:
+      results = list(executor.map(lambda _: use_model(), range(16)))
+
+    self.assertEqual(results, [20.0] * 16)
+
   def testOneDimensionNumpyMatrix(self):
     """
     Test that we can pass one dimension matrix from matrix_in
@@ -1461,5 +1543,29 @@ class TestPythonBinding(unittest.TestCase):
                                                    matrix_and_info_in=x,
                                                    check_input_matrices=True))
 
+  def testThreads(self):
+    """
+    Test that the number of threads can be given, and that a negative number is
+    an error.
+    """
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 flag1=True,
+                                 threads=1)
+
+    self.assertEqual(output['string_out'], 'hello2')
+    self.assertEqual(output['int_out'], 13)
+
+    self.assertRaises(ValueError,
+                      lambda : test_python_binding(string_in='hello',
+                                                   int_in=12,
+                                                   double_in=4.0,
+                                                   mat_req_in=[[1.0]],
+                                                   col_req_in=[1.0],
+                                                   threads=-1))
+
 if __name__ == '__main__':
   unittest.main()
@@ -46,6 +46,33 @@
 #endif
 #endif
 
+//
+// mlpack can load and save Arrow IPC (Feather v2) and Parquet files via Apache
+// Arrow, if available.  Arrow is an optional dependency of mlpack.  When
+// MLPACK_HAS_ARROW is defined, the Arrow and Parquet headers are expected to be
+// found in the compiler include path, and programs must be linked with -larrow
+// and -lparquet.
+//
+#ifndef MLPACK_HAS_ARROW
+// #define MLPACK_HAS_ARROW
+#endif
+
+//
+// mlpack can transparently load and save gzip-compressed (.gz) files via zlib
+// and zstd-compressed (.zst) files via libzstd, if available.  Both are
+// optional dependencies of mlpack.  When MLPACK_HAS_ZLIB is defined, zlib.h is
+// expected to be found in the compiler include path, and programs must be
+// linked with -lz; when MLPACK_HAS_ZSTD is defined, the same holds for zstd.h
+// and -lzstd.
+//
+#ifndef MLPACK_HAS_ZLIB
+// #define MLPACK_HAS_ZLIB
+#endif
+
+#ifndef MLPACK_HAS_ZSTD
+// #define MLPACK_HAS_ZSTD
+#endif
+
 //
 // If the version of mlpack is built from a git repository and is not an
 // official release, then MLPACK_GIT_VERSION will be defined.  This causes
@@ -106,6 +133,18 @@
   #undef MLPACK_HAS_STB
 #endif
 
+#ifdef MLPACK_DISABLE_ARROW
+  #undef MLPACK_HAS_ARROW
+#endif
+
+#ifdef MLPACK_DISABLE_ZLIB
+  #undef MLPACK_HAS_ZLIB
+#endif
+
+#ifdef MLPACK_DISABLE_ZSTD
+  #undef MLPACK_HAS_ZSTD
+#endif
+
 #ifdef MLPACK_DISABLE_NO_STB_DIR
   #undef MLPACK_HAS_NO_STB_DIR
 #endif
@@ -25,6 +25,54 @@
  */
 namespace cereal {
 
+/**
+ * This is true if the contents of Armadillo objects with element type eT can
+ * be written to (or read from) the given archive as one block of memory: the
+ * bytes are the same as if each element were serialized separately, but the
+ * block is copied with one call.
+ */
+template<typename Archive, typename eT>
+struct UseArmaBinaryData
+{
+  static const bool value = std::is_arithmetic<eT>::value &&
+      (std::is_same<Archive, BinaryOutputArchive>::value ||
+       std::is_same<Archive, BinaryInputArchive>::value ||
+       std::is_same<Archive, PortableBinaryOutputArchive>::value ||
+       std::is_same<Archive, PortableBinaryInputArchive>::value);
+};
+
+/**
+ * Serialize the given elements of an Armadillo object.  For binary archives,
+ * the memory is serialized as one block.
+ */
+template<typename Archive, typename eT>
+void SerializeArmaMemory(
+    Archive& ar,
+    const char* /* name */,
+    eT* mem,
+    const size_t n,
+    const typename std::enable_if<
+        UseArmaBinaryData<Archive, eT>::value>::type* = 0)
+{
+  if (n > 0)
+    ar(cereal::binary_data(mem, n * sizeof(eT)));
+}
+
+template<typename Archive, typename eT>
+void SerializeArmaMemory(
+    Archive& ar,
+    const char* name,
+    eT* mem,
+    const size_t n,
+    const typename std::enable_if<
+        !UseArmaBinaryData<Archive, eT>::value>::type* = 0)
+{
+  for (size_t i = 0; i < n; ++i)
+    ar(cereal::make_nvp(name, mem[i]));
+}
+
+// Add an external serialization function for SpMat.
+
 template<typename Archive, typename eT>
 void serialize(Archive& ar, arma::SpMat<eT>& mat)
 {
@@ -51,12 +99,12 @@ void serialize(Archive& ar, arma::SpMat<eT>& mat)
   }
 
   // Serialize the values held in the sparse matrix.
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("value", arma::access::rw(mat.values[i])));
-  for (size_t i = 0; i < mat.n_nonzero; ++i)
-    ar(cereal::make_nvp("row_index", arma::access::rw(mat.row_indices[i])));
-  for (size_t i = 0; i < mat.n_cols + 1; ++i)
-    ar(cereal::make_nvp("col_ptr", arma::access::rw(mat.col_ptrs[i])));
+  SerializeArmaMemory(ar, "value", arma::access::rwp(mat.values),
+      mat.n_nonzero);
+  SerializeArmaMemory(ar, "row_index", arma::access::rwp(mat.row_indices),
+      mat.n_nonzero);
+  SerializeArmaMemory(ar, "col_ptr", arma::access::rwp(mat.col_ptrs),
+      mat.n_cols + 1);
 }
 
 // Add an external serialization function for Mat.
@@ -79,8 +127,7 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   }
 
   // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+  SerializeArmaMemory(ar, "elem", arma::access::rwp(mat.mem), mat.n_elem);
 }
 
 // Add a serialization function for armadillo Cube
@@ -100,8 +147,7 @@ void serialize(Archive& ar, arma::Cube<eT>& cube)
     cube.set_size(n_rows, n_cols, n_slices);
 
   // Directly serialize the contents of the cube's memory.
-  for (size_t i = 0; i < cube.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(cube.mem[i])));
+  SerializeArmaMemory(ar, "elem", arma::access::rwp(cube.mem), cube.n_elem);
 }
 
 } // end namespace cereal
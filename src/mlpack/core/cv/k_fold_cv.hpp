@@ -43,6 +43,12 @@ namespace mlpack {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * The data is copied once, at construction time, with its first k - 2 bins
+ * repeated at the end, so that the training and validation subsets of every
+ * fold are contiguous; the folds are then trained on aliases of this copy,
+ * without copying the data again.  If @c Parallel() is set, the folds are
+ * trained and evaluated in parallel.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -179,6 +185,14 @@ class KFoldCV
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get whether the folds are trained and evaluated in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds are trained and evaluated in parallel.  This is
+  //! off by default: all k models are then trained at the same time, which
+  //! needs more memory, and MLAlgorithm must not use OpenMP itself (or it is
+  //! limited to one thread per fold).
+  bool& Parallel() { return parallel; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -208,6 +222,9 @@ class KFoldCV
   //! The number of bins in the dataset.
   const size_t k;
 
+  //! Whether to train and evaluate the folds in parallel.
+  bool parallel;
+
   //! The extended (by repeating the first k - 2 bins) data points.
   MatType xs;
   //! The extended (by repeating the first k - 2 bins) predictions.
@@ -269,6 +286,17 @@ class KFoldCV
            typename = void>
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
+  /**
+   * Train a model on each fold with the given function, which takes the index
+   * of the fold, and evaluate it on the corresponding validation subset.  The
+   * folds are processed in parallel if Parallel() is set.  If
+   * `ignoreInvalidScores` is true, NaN and infinite scores are left out of the
+   * average.
+   */
+  template<typename TrainFunction>
+  double EvaluateFolds(const TrainFunction& trainFold,
+                       const bool ignoreInvalidScores);
+
   /**
    * Calculate the index of the first column of the ith validation subset.
    *
@@ -134,7 +134,8 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -165,7 +166,8 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -243,34 +245,11 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
-  {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
-    {
-      ++numInvalidScores;
-      Log::Warn << "KFoldCV::TrainAndEvaluate(): fold " << i << " returned "
-          << "a score of " << evaluations(i) << "; ignoring when computing "
-          << "the average score." << std::endl;
-    }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
-
-  if (numInvalidScores == k)
+  return EvaluateFolds([&](const size_t i)
   {
-    Log::Warn << "KFoldCV::TrainAndEvaluate(): all folds returned invalid "
-        << "scores!  Returning 0.0 as overall score." << std::endl;
-    return 0.0;
-  }
-
-  return arma::mean(evaluations.elem(arma::find_finite(evaluations)));
+    return base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+        args...);
+  }, true);
 }
 
 template<typename MLAlgorithm,
@@ -285,22 +264,87 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  return EvaluateFolds([&](const size_t i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
+    return (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             GetTrainingSubset(weights, i), args...) :
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
+  }, false);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename TrainFunction>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateFolds(const TrainFunction& trainFold,
+                                           const bool ignoreInvalidScores)
+{
+  arma::vec evaluations(k);
+
+  // Exceptions can't leave the parallel region, so they are rethrown after it.
+  std::vector<std::exception_ptr> errors(k);
+  bool failed = false;
+
+  #pragma omp parallel for schedule(dynamic) if (parallel)
+  for (size_t i = 0; i < k; ++i)
+  {
+    // Without parallelism, stop at the first error, as before.
+    if (failed)
+      continue;
+
+    try
+    {
+      MLAlgorithm&& model = trainFold(i);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+      if (!parallel)
+        failed = true;
+    }
+  }
+
+  for (size_t i = 0; i < k; ++i)
+  {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
   }
 
-  return arma::mean(evaluations);
+  if (!ignoreInvalidScores)
+    return arma::mean(evaluations);
+
+  size_t numInvalidScores = 0;
+  for (size_t i = 0; i < k; ++i)
+  {
+    if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
+    {
+      ++numInvalidScores;
+      Log::Warn << "KFoldCV::TrainAndEvaluate(): fold " << i << " returned "
+          << "a score of " << evaluations(i) << "; ignoring when computing "
+          << "the average score." << std::endl;
+    }
+  }
+
+  if (numInvalidScores == k)
+  {
+    Log::Warn << "KFoldCV::TrainAndEvaluate(): all folds returned invalid "
+        << "scores!  Returning 0.0 as overall score." << std::endl;
+    return 0.0;
+  }
+
+  return arma::mean(evaluations.elem(arma::find_finite(evaluations)));
 }
 
 template<typename MLAlgorithm,
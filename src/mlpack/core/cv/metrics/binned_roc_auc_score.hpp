@@ -0,0 +1,103 @@
+/**
+ * @file core/cv/metrics/binned_roc_auc_score.hpp
+ *
+ * An approximate area under the Receiver Operating Characteristic curve
+ * (ROC-AUC) score that is computed from histograms of the scores.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_BINNED_ROC_AUC_SCORE_HPP
+#define MLPACK_CORE_CV_METRICS_BINNED_ROC_AUC_SCORE_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * BinnedROCAUCScore approximates the area under the ROC curve (see
+ * ROCAUCScore) by counting the positive and negative points whose probability
+ * scores fall into each of a fixed number of equal-width bins of [0, 1]; the
+ * result is the exact ROC-AUC of the scores rounded down to their bins.  Unlike
+ * ROCAUCScore, no sorting is needed and memory does not depend on the number of
+ * points: scores can be added one batch at a time with Update(), and the
+ * histograms of different batches (for instance, ones filled by different
+ * threads) can be combined with Merge().
+ *
+ * @code
+ * BinnedROCAUCScore<> auc(1000);
+ * for (size_t b = 0; b < numBatches; ++b)
+ *   auc.Update(batchLabels[b], batchScores[b]);
+ * double score = auc.Evaluate();
+ * @endcode
+ *
+ * @tparam PositiveClass Positives are assumed to have labels equal to this
+ *     value. Defaults to 1.
+ */
+template<size_t PositiveClass = 1>
+class BinnedROCAUCScore
+{
+ public:
+  /**
+   * Create an empty set of histograms with the given number of bins.
+   *
+   * @param numBins Number of bins that [0, 1] is split into.
+   */
+  BinnedROCAUCScore(const size_t numBins = 1000);
+
+  /**
+   * Add the given points to the histograms.  Scores outside of [0, 1] are
+   * counted in the first or last bin.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param scores Probability scores of positive class.
+   */
+  void Update(const arma::Row<size_t>& labels,
+              const arma::Row<double>& scores);
+
+  /**
+   * Add the histograms of another set of points to these histograms.
+   *
+   * @param other Histograms to merge; they must have the same number of bins.
+   */
+  void Merge(const BinnedROCAUCScore& other);
+
+  //! Compute the approximate area under the ROC curve of the points seen so
+  //! far.
+  double Evaluate() const;
+
+  /**
+   * Compute the approximate area under the ROC curve of the given points.
+   *
+   * @param labels Ground truth (correct) labels.
+   * @param scores Probability scores of positive class.
+   * @param numBins Number of bins that [0, 1] is split into.
+   */
+  static double Evaluate(const arma::Row<size_t>& labels,
+                         const arma::Row<double>& scores,
+                         const size_t numBins = 1000);
+
+  //! Get the number of bins.
+  size_t NumBins() const { return positives.n_elem; }
+
+  /**
+   * Information for hyper-parameter tuning code. It indicates that we want
+   * to maximize the metric.
+   */
+  static const bool NeedsMinimization = false;
+
+ private:
+  //! The number of positive points in each bin.
+  arma::Col<size_t> positives;
+  //! The number of negative points in each bin.
+  arma::Col<size_t> negatives;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "binned_roc_auc_score_impl.hpp"
+
+#endif
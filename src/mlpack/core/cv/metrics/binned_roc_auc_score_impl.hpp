@@ -0,0 +1,116 @@
+/**
+ * @file core/cv/metrics/binned_roc_auc_score_impl.hpp
+ *
+ * Implementation of the approximate area under Receiver Operating
+ * Characteristic curve (ROC-AUC) score.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_BINNED_ROC_AUC_SCORE_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_BINNED_ROC_AUC_SCORE_IMPL_HPP
+
+namespace mlpack {
+
+template<size_t PositiveClass>
+BinnedROCAUCScore<PositiveClass>::BinnedROCAUCScore(const size_t numBins)
+{
+  if (numBins == 0)
+  {
+    throw std::invalid_argument("BinnedROCAUCScore::BinnedROCAUCScore(): "
+        "number of bins cannot be zero");
+  }
+
+  positives.zeros(numBins);
+  negatives.zeros(numBins);
+}
+
+template<size_t PositiveClass>
+void BinnedROCAUCScore<PositiveClass>::Update(
+    const arma::Row<size_t>& labels,
+    const arma::Row<double>& scores)
+{
+  util::CheckSameSizes(labels, scores, "BinnedROCAUCScore::Update()");
+
+  const size_t numBins = positives.n_elem;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    size_t bin = 0;
+    if (scores[i] >= 1.0)
+      bin = numBins - 1;
+    else if (scores[i] > 0.0)
+      bin = (size_t) (scores[i] * numBins);
+
+    if (labels[i] == PositiveClass)
+      ++positives[bin];
+    else
+      ++negatives[bin];
+  }
+}
+
+template<size_t PositiveClass>
+void BinnedROCAUCScore<PositiveClass>::Merge(const BinnedROCAUCScore& other)
+{
+  if (other.positives.n_elem != positives.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "BinnedROCAUCScore::Merge(): histograms have "
+        << other.positives.n_elem << " bins, but these have "
+        << positives.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  positives += other.positives;
+  negatives += other.negatives;
+}
+
+template<size_t PositiveClass>
+double BinnedROCAUCScore<PositiveClass>::Evaluate() const
+{
+  const size_t numberOfTrueLabels = arma::accu(positives);
+  const size_t numberOfFalseLabels = arma::accu(negatives);
+
+  if (numberOfTrueLabels + numberOfFalseLabels == 0)
+  {
+    throw std::invalid_argument(
+        "BinnedROCAUCScore::Evaluate(): "
+        "number of points in input data cannot be zero");
+  }
+
+  // Check if only one class is given in labels.
+  if (numberOfTrueLabels == 0 || numberOfFalseLabels == 0)
+  {
+    throw std::invalid_argument(
+        "BinnedROCAUCScore::Evaluate(): "
+        "only one class is given in labels, ROCAUCScore is undefined");
+  }
+
+  // Lowering the threshold one bin at a time from the top, each bin adds a
+  // segment of the curve; compute the area under it with the trapezoidal rule.
+  double area = 0.0;
+  size_t tp = 0;
+  for (size_t b = positives.n_elem; b > 0; --b)
+  {
+    area += negatives[b - 1] * (tp + 0.5 * positives[b - 1]);
+    tp += positives[b - 1];
+  }
+
+  return area / ((double) numberOfTrueLabels * numberOfFalseLabels);
+}
+
+template<size_t PositiveClass>
+double BinnedROCAUCScore<PositiveClass>::Evaluate(
+    const arma::Row<size_t>& labels,
+    const arma::Row<double>& scores,
+    const size_t numBins)
+{
+  BinnedROCAUCScore auc(numBins);
+  auc.Update(labels, scores);
+  return auc.Evaluate();
+}
+
+} // namespace mlpack
+
+#endif
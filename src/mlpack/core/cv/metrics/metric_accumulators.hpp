@@ -0,0 +1,196 @@
+/**
+ * @file core/cv/metrics/metric_accumulators.hpp
+ *
+ * Accumulators that compute classification and regression metrics over
+ * predictions that arrive in batches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_METRIC_ACCUMULATORS_HPP
+#define MLPACK_CORE_CV_METRICS_METRIC_ACCUMULATORS_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/cv/metrics/average_strategy.hpp>
+
+namespace mlpack {
+
+/**
+ * ClassificationAccumulator counts, for each class, the true positives, the
+ * predictions of the class, and the points labeled with the class, for
+ * predictions that are added one batch at a time with Update().  Accumulators
+ * of different batches (for instance, ones filled by different threads) can be
+ * combined with Merge().  The accuracy, precision, recall, and F1 score are
+ * then the same as the ones that Accuracy, Precision, Recall, and F1 compute
+ * for all of the predictions at once.
+ *
+ * @code
+ * ClassificationAccumulator accumulator;
+ * for (size_t b = 0; b < numBatches; ++b)
+ * {
+ *   model.Classify(batches[b], predictions);
+ *   accumulator.Update(predictions, batchLabels[b]);
+ * }
+ * double f1 = accumulator.F1<Macro>();
+ * @endcode
+ */
+class ClassificationAccumulator
+{
+ public:
+  //! Create an empty accumulator.
+  ClassificationAccumulator() : count(0), correct(0), numClasses(0) { }
+
+  /**
+   * Add a batch of predictions to the accumulator.
+   *
+   * @param predictedLabels Predicted labels.
+   * @param labels Ground truth (correct) labels.
+   */
+  void Update(const arma::Row<size_t>& predictedLabels,
+              const arma::Row<size_t>& labels);
+
+  /**
+   * Add the predictions counted by another accumulator.
+   *
+   * @param other Accumulator to merge.
+   */
+  void Merge(const ClassificationAccumulator& other);
+
+  //! Get the number of predictions seen so far.
+  size_t Count() const { return count; }
+  //! Get the number of classes in the ground truth labels seen so far (one
+  //! more than the largest label).
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the accuracy of the predictions seen so far.
+  double Accuracy() const;
+
+  /**
+   * Get the precision of the predictions seen so far (see Precision).
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double Precision() const;
+
+  /**
+   * Get the recall of the predictions seen so far (see Recall).
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double Recall() const;
+
+  /**
+   * Get the F1 score of the predictions seen so far (see F1).
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double F1() const;
+
+ private:
+  //! Make room for counts of the given number of classes.
+  void Grow(const size_t classes);
+
+  //! Get the precision of the given class.
+  double ClassPrecision(const size_t c) const;
+  //! Get the recall of the given class.
+  double ClassRecall(const size_t c) const;
+  //! Get the F1 score of the given class.
+  double ClassF1(const size_t c) const;
+
+  //! The number of predictions.
+  size_t count;
+  //! The number of correct predictions.
+  size_t correct;
+  //! One more than the largest ground truth label.
+  size_t numClasses;
+  //! The number of correct predictions of each class.
+  arma::Col<size_t> truePositives;
+  //! The number of predictions of each class.
+  arma::Col<size_t> predictedCounts;
+  //! The number of points labeled with each class.
+  arma::Col<size_t> labelCounts;
+};
+
+/**
+ * RegressionAccumulator accumulates the squared errors of predictions and the
+ * mean and spread of the responses, for predictions that are added one batch
+ * at a time with Update().  Accumulators of different batches can be combined
+ * with Merge(); the mean and spread of the responses are merged with the
+ * pairwise update of Chan et al., so that they stay accurate over many
+ * batches.  The mean squared error and the R2 score are then the same as the
+ * ones that MSE and R2Score compute for all of the predictions at once.
+ */
+class RegressionAccumulator
+{
+ public:
+  //! Create an empty accumulator.
+  RegressionAccumulator() :
+      count(0),
+      squaredError(0.0),
+      mean(0.0),
+      m2(0.0)
+  { }
+
+  /**
+   * Add a batch of predictions to the accumulator.  Every element of the
+   * responses counts as one prediction.
+   *
+   * @param predictedResponses Predicted responses.
+   * @param responses Ground truth (correct) responses.
+   */
+  template<typename ResponsesType>
+  void Update(const ResponsesType& predictedResponses,
+              const ResponsesType& responses);
+
+  /**
+   * Add the predictions accumulated by another accumulator.
+   *
+   * @param other Accumulator to merge.
+   */
+  void Merge(const RegressionAccumulator& other);
+
+  //! Get the number of predictions seen so far.
+  size_t Count() const { return count; }
+
+  //! Get the mean squared error of the predictions seen so far.
+  double MSE() const { return squaredError / count; }
+
+  //! Get the R2 score of the predictions seen so far.
+  double R2() const;
+
+  /**
+   * Get the adjusted R2 score of the predictions seen so far.
+   *
+   * @param dimensionality The number of dimensions of the data the
+   *     predictions were made for.
+   */
+  double AdjustedR2(const size_t dimensionality) const;
+
+ private:
+  //! The number of predictions.
+  size_t count;
+  //! The sum of the squared errors.
+  double squaredError;
+  //! The mean of the responses.
+  double mean;
+  //! The sum of squared deviations of the responses from their mean.
+  double m2;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "metric_accumulators_impl.hpp"
+
+#endif
@@ -0,0 +1,217 @@
+/**
+ * @file core/cv/metrics/metric_accumulators_impl.hpp
+ *
+ * The implementation of ClassificationAccumulator and RegressionAccumulator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_METRIC_ACCUMULATORS_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_METRIC_ACCUMULATORS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "metric_accumulators.hpp"
+
+namespace mlpack {
+
+inline void ClassificationAccumulator::Update(
+    const arma::Row<size_t>& predictedLabels,
+    const arma::Row<size_t>& labels)
+{
+  util::CheckSameSizes(predictedLabels, labels,
+      "ClassificationAccumulator::Update()");
+
+  if (labels.n_elem == 0)
+    return;
+
+  numClasses = std::max(numClasses, (size_t) arma::max(labels) + 1);
+  Grow(std::max(numClasses, (size_t) arma::max(predictedLabels) + 1));
+
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    ++predictedCounts[predictedLabels[i]];
+    ++labelCounts[labels[i]];
+    if (predictedLabels[i] == labels[i])
+    {
+      ++truePositives[labels[i]];
+      ++correct;
+    }
+  }
+
+  count += labels.n_elem;
+}
+
+inline void ClassificationAccumulator::Merge(
+    const ClassificationAccumulator& other)
+{
+  Grow(other.truePositives.n_elem);
+  truePositives.head(other.truePositives.n_elem) += other.truePositives;
+  predictedCounts.head(other.predictedCounts.n_elem) += other.predictedCounts;
+  labelCounts.head(other.labelCounts.n_elem) += other.labelCounts;
+
+  numClasses = std::max(numClasses, other.numClasses);
+  count += other.count;
+  correct += other.correct;
+}
+
+inline double ClassificationAccumulator::Accuracy() const
+{
+  return (double) correct / count;
+}
+
+template<AverageStrategy AS, size_t PositiveClass>
+double ClassificationAccumulator::Precision() const
+{
+  // Microaveraged precision turns out to be just accuracy.
+  if (AS == Micro)
+    return Accuracy();
+  else if (AS == Binary)
+    return ClassPrecision(PositiveClass);
+
+  double sum = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    sum += ClassPrecision(c);
+
+  return sum / numClasses;
+}
+
+template<AverageStrategy AS, size_t PositiveClass>
+double ClassificationAccumulator::Recall() const
+{
+  // Microaveraged recall turns out to be just accuracy.
+  if (AS == Micro)
+    return Accuracy();
+  else if (AS == Binary)
+    return ClassRecall(PositiveClass);
+
+  double sum = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    sum += ClassRecall(c);
+
+  return sum / numClasses;
+}
+
+template<AverageStrategy AS, size_t PositiveClass>
+double ClassificationAccumulator::F1() const
+{
+  // Microaveraged F1 is the same as microaveraged precision and recall.
+  if (AS == Micro)
+    return Accuracy();
+  else if (AS == Binary)
+    return ClassF1(PositiveClass);
+
+  double sum = 0.0;
+  for (size_t c = 0; c < numClasses; ++c)
+    sum += ClassF1(c);
+
+  return sum / numClasses;
+}
+
+inline void ClassificationAccumulator::Grow(const size_t classes)
+{
+  if (classes <= truePositives.n_elem)
+    return;
+
+  const size_t oldClasses = truePositives.n_elem;
+  truePositives.resize(classes);
+  predictedCounts.resize(classes);
+  labelCounts.resize(classes);
+  truePositives.tail(classes - oldClasses).zeros();
+  predictedCounts.tail(classes - oldClasses).zeros();
+  labelCounts.tail(classes - oldClasses).zeros();
+}
+
+inline double ClassificationAccumulator::ClassPrecision(const size_t c) const
+{
+  // Classes that have never been predicted have no precision, as in
+  // Precision::Evaluate().
+  if (c >= truePositives.n_elem)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return double(truePositives[c]) / predictedCounts[c];
+}
+
+inline double ClassificationAccumulator::ClassRecall(const size_t c) const
+{
+  if (c >= truePositives.n_elem)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return double(truePositives[c]) / labelCounts[c];
+}
+
+inline double ClassificationAccumulator::ClassF1(const size_t c) const
+{
+  const double precision = ClassPrecision(c);
+  const double recall = ClassRecall(c);
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+template<typename ResponsesType>
+void RegressionAccumulator::Update(const ResponsesType& predictedResponses,
+                                   const ResponsesType& responses)
+{
+  if (arma::size(predictedResponses) != arma::size(responses))
+  {
+    std::ostringstream oss;
+    oss << "RegressionAccumulator::Update(): predicted responses have size "
+        << predictedResponses.n_rows << " x " << predictedResponses.n_cols
+        << ", but responses have size " << responses.n_rows << " x "
+        << responses.n_cols << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (responses.n_elem == 0)
+    return;
+
+  // Compute the statistics of the batch, and merge them in.
+  RegressionAccumulator batch;
+  batch.count = responses.n_elem;
+  batch.squaredError = arma::accu(arma::square(responses -
+      predictedResponses));
+  batch.mean = arma::accu(responses) / responses.n_elem;
+  batch.m2 = arma::accu(arma::square(responses - batch.mean));
+
+  Merge(batch);
+}
+
+inline void RegressionAccumulator::Merge(const RegressionAccumulator& other)
+{
+  if (other.count == 0)
+    return;
+
+  const double n = (double) (count + other.count);
+  const double delta = other.mean - mean;
+  mean += delta * (((double) other.count) / n);
+  m2 += other.m2 + delta * delta * ((double) count) *
+      ((double) other.count) / n;
+  squaredError += other.squaredError;
+  count += other.count;
+}
+
+inline double RegressionAccumulator::R2() const
+{
+  // Handling undefined R2 Score when both denominator and numerator is 0.0, as
+  // in R2Score::Evaluate().
+  if (squaredError == 0.0)
+    return m2 ? 1.0 : DBL_MIN;
+
+  return 1.0 - squaredError / m2;
+}
+
+inline double RegressionAccumulator::AdjustedR2(
+    const size_t dimensionality) const
+{
+  if (squaredError == 0.0)
+    return m2 ? 1.0 : DBL_MIN;
+
+  const double rsq = 1.0 - squaredError / m2;
+  return 1.0 - (1.0 - rsq) * ((double) (count - 1)) /
+      ((double) count - (double) dimensionality - 1.0);
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,7 +15,9 @@
 #include "facilities.hpp"
 #include "accuracy.hpp"
 #include "average_strategy.hpp"
+#include "binned_roc_auc_score.hpp"
 #include "f1.hpp"
+#include "metric_accumulators.hpp"
 #include "mse.hpp"
 #include "precision.hpp"
 #include "r2_score.hpp"
@@ -65,7 +65,9 @@ class SilhouetteScore
 
   /**
    * Find silhouette score of all individual elements.
-   * (Distance not precomputed).
+   * (Distance not precomputed).  The distances are computed as they are
+   * needed, so no distance matrix is stored, and elements are scored in
+   * parallel with OpenMP.
    *
    * @param X Column-major data used for clustering.
    * @param labels Labels assigned to data by clustering.
@@ -77,6 +79,26 @@ class SilhouetteScore
                                    const arma::Row<size_t>& labels,
                                    const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score from the exact silhouette scores of
+   * a random sample of the elements.  This takes time proportional to the
+   * number of elements times the sample size, rather than to the square of the
+   * number of elements, so it can be used for large clusterings.  If the
+   * sample size is not less than the number of elements, the overall silhouette
+   * score is returned.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param sampleSize Number of elements to score.
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double SampledOverall(const DataType& X,
+                               const arma::Row<size_t>& labels,
+                               const Metric& metric,
+                               const size_t sampleSize);
+
   /**
    * Find mean distance of element from a given cluster.
    *
@@ -96,6 +118,23 @@ class SilhouetteScore
    * to maximize the metric.
    */
   static const bool NeedsMinimization = false;
+
+ private:
+  /**
+   * Find the silhouette scores of the given elements, computing distances as
+   * they are needed.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param indices Indices of the elements to score.
+   * @return (arma::rowvec) silhouette score of each of the given elements.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec IndexScores(const DataType& X,
+                                  const arma::Row<size_t>& labels,
+                                  const Metric& metric,
+                                  const arma::uvec& indices);
 };
 
 } // namespace mlpack
@@ -76,8 +76,87 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+  return IndexScores(X, labels, metric,
+      arma::linspace<arma::uvec>(0, X.n_cols - 1, X.n_cols));
+}
+
+template<typename DataType, typename Metric>
+double SilhouetteScore::SampledOverall(const DataType& X,
+                                       const arma::Row<size_t>& labels,
+                                       const Metric& metric,
+                                       const size_t sampleSize)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SampledOverall()");
+  if (sampleSize == 0)
+  {
+    throw std::invalid_argument("SilhouetteScore::SampledOverall(): sample "
+        "size cannot be zero");
+  }
+
+  if (sampleSize >= X.n_cols)
+    return Overall(X, labels, metric);
+
+  const arma::uvec indices = arma::randperm(X.n_cols, sampleSize);
+  return arma::mean(IndexScores(X, labels, metric, indices));
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::IndexScores(const DataType& X,
+                                          const arma::Row<size_t>& labels,
+                                          const Metric& metric,
+                                          const arma::uvec& indices)
+{
+  // Give each cluster an index, and count its elements.
+  const arma::Row<size_t> clusterLabels = arma::unique(labels);
+  arma::uvec clusters(labels.n_elem);
+  arma::vec clusterSizes(clusterLabels.n_elem, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    clusters[i] = std::lower_bound(clusterLabels.begin(), clusterLabels.end(),
+        labels[i]) - clusterLabels.begin();
+    ++clusterSizes[clusters[i]];
+  }
+
+  arma::rowvec sampleScores(indices.n_elem);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t s = 0; s < indices.n_elem; ++s)
+  {
+    const size_t i = indices[s];
+    const size_t cluster = clusters[i];
+
+    // Sum the distances from the element to the elements of each cluster.
+    arma::vec distanceSums(clusterLabels.n_elem, arma::fill::zeros);
+    for (size_t j = 0; j < X.n_cols; ++j)
+    {
+      if (j != i)
+        distanceSums[clusters[j]] += metric.Evaluate(X.col(i), X.col(j));
+    }
+
+    // s(i) = 0 if i is the only element in the cluster (or all elements of the
+    // cluster are at the same place).
+    const double intraClusterDistance = (clusterSizes[cluster] == 1) ? 0.0 :
+        distanceSums[cluster] / (clusterSizes[cluster] - 1);
+    if (intraClusterDistance == 0)
+    {
+      sampleScores[s] = 0.0;
+      continue;
+    }
+
+    double minInterClusterDistance = DBL_MAX;
+    for (size_t c = 0; c < clusterLabels.n_elem; ++c)
+    {
+      if (c != cluster)
+      {
+        minInterClusterDistance = std::min(minInterClusterDistance,
+            distanceSums[c] / clusterSizes[c]);
+      }
+    }
+
+    sampleScores[s] = (minInterClusterDistance - intraClusterDistance) /
+        std::max(intraClusterDistance, minInterClusterDistance);
+  }
+
+  return sampleScores;
 }
 
 inline double SilhouetteScore::MeanDistanceFromCluster(
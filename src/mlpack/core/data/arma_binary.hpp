@@ -0,0 +1,149 @@
+/**
+ * @file core/data/arma_binary.hpp
+ *
+ * Utilities for the header of Armadillo binary (arma_binary) files: writing
+ * files whose data is aligned, so that they can be memory-mapped and used in
+ * place (see MapMatrix()), and parsing the header of a mapped file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ARMA_BINARY_HPP
+#define MLPACK_CORE_DATA_ARMA_BINARY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+//! The data of Armadillo binary files written by SaveArmaBinary() starts at a
+//! multiple of this many bytes.
+static const size_t ArmaBinaryAlignment = 64;
+
+/**
+ * Return the header that Armadillo uses for binary files of matrices with the
+ * given element type (e.g. "ARMA_MAT_BIN_FN008" for double), or an empty string
+ * if the type is not a real arithmetic type.
+ */
+template<typename eT>
+std::string ArmaBinaryHeader()
+{
+  if (!std::is_arithmetic<eT>::value)
+    return "";
+
+  std::ostringstream oss;
+  oss << "ARMA_MAT_BIN_"
+      << (std::is_floating_point<eT>::value ? "FN" :
+          (std::is_signed<eT>::value ? "IS" : "IU"))
+      << std::setw(3) << std::setfill('0') << sizeof(eT);
+  return oss.str();
+}
+
+/**
+ * Save the given matrix in the Armadillo binary format, padding the header so
+ * that the data starts at a multiple of ArmaBinaryAlignment bytes.  Armadillo
+ * skips whitespace before the size of the matrix, so the files can be loaded by
+ * Armadillo as usual.
+ *
+ * @param stream Stream to write to; it should be opened in binary mode.
+ * @param matrix Matrix to save.
+ * @return Whether the matrix was written successfully.
+ */
+template<typename eT>
+bool SaveArmaBinary(std::ostream& stream, const arma::Mat<eT>& matrix)
+{
+  const std::string header = ArmaBinaryHeader<eT>();
+  if (header.empty())
+    return matrix.save(stream, arma::arma_binary);
+
+  std::ostringstream sizes;
+  sizes << matrix.n_rows << " " << matrix.n_cols << "\n";
+
+  const size_t length = header.size() + 1 + sizes.str().size();
+  const size_t padding = (ArmaBinaryAlignment - length % ArmaBinaryAlignment) %
+      ArmaBinaryAlignment;
+
+  stream << header << "\n" << std::string(padding, ' ') << sizes.str();
+  stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+      std::streamsize(matrix.n_elem * sizeof(eT)));
+
+  return stream.good();
+}
+
+/**
+ * Parse the header of an Armadillo binary file of a matrix with the given
+ * element type.
+ *
+ * @param data Contents of the file.
+ * @param size Size of the file, in bytes.
+ * @param rows Set to the number of rows of the matrix.
+ * @param cols Set to the number of columns of the matrix.
+ * @param offset Set to the offset of the data in the file.
+ * @param error Set to a description of the problem, if the header is invalid.
+ * @return Whether the header is valid for the element type and the file is
+ *     large enough to hold the data.
+ */
+template<typename eT>
+bool ParseArmaBinaryHeader(const char* data,
+                           const size_t size,
+                           size_t& rows,
+                           size_t& cols,
+                           size_t& offset,
+                           std::string& error)
+{
+  const std::string expected = ArmaBinaryHeader<eT>();
+  const char* end = data + size;
+  const char* newline = std::find(data, end, '\n');
+  const std::string header(data, newline);
+  if (expected.empty() || header != expected)
+  {
+    error = (header.compare(0, 12, "ARMA_MAT_BIN") == 0) ?
+        "the header '" + header + "' does not match the element type" :
+        "it is not an Armadillo binary matrix file";
+    return false;
+  }
+
+  // Read the two sizes, which may be preceded by any whitespace.
+  const char* p = newline;
+  size_t values[2];
+  for (size_t i = 0; i < 2; ++i)
+  {
+    while (p < end && std::isspace((unsigned char) *p))
+      ++p;
+
+    if (p == end || !std::isdigit((unsigned char) *p))
+    {
+      error = "the size of the matrix is invalid";
+      return false;
+    }
+
+    values[i] = 0;
+    while (p < end && std::isdigit((unsigned char) *p))
+      values[i] = 10 * values[i] + (*p++ - '0');
+  }
+
+  // A single character separates the sizes from the data.
+  if (p == end)
+  {
+    error = "the file is truncated";
+    return false;
+  }
+
+  rows = values[0];
+  cols = values[1];
+  offset = (size_t) (p + 1 - data);
+  if ((size - offset) / sizeof(eT) < rows * cols)
+  {
+    error = "the file is truncated";
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
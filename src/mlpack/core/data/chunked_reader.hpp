@@ -0,0 +1,173 @@
+/**
+ * @file core/data/chunked_reader.hpp
+ *
+ * Read a dataset from a file one block of points at a time, so that methods
+ * can process datasets that do not fit in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+#include <future>
+
+#include "arma_binary.hpp"
+#include "compressed_file.hpp"
+#include "detect_file_type.hpp"
+#include "load.hpp"
+#include "types.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ChunkedReader reads a dataset one chunk of points at a time: each call to
+ * Next() gives a matrix with (at most) ChunkSize() columns, each of which is a
+ * point.  While the caller works on one chunk, the next one is read by a
+ * background thread (unless prefetching is disabled), so that reading and
+ * computation overlap.
+ *
+ * CSV and other text files with one point per line are parsed as they are
+ * read, as are Armadillo binary files; only one chunk (plus the one being
+ * prefetched) is in memory at a time.  Any other format supported by
+ * data::Load() (HDF5, Arrow IPC, Parquet, ...) is loaded into memory when the
+ * reader is created, and given out in chunks.  Compressed files (.gz, .zst)
+ * are decompressed into memory when the reader is created, and then parsed
+ * chunk by chunk.
+ *
+ * An example, computing the mean of a dataset that does not fit in memory:
+ *
+ * @code
+ * data::ChunkedReader<double> reader("dataset.csv", 10000);
+ * arma::vec mean(reader.Dimensionality(), arma::fill::zeros);
+ * size_t points = 0;
+ * arma::mat chunk;
+ * while (reader.Next(chunk))
+ * {
+ *   mean += arma::sum(chunk, 1);
+ *   points += chunk.n_cols;
+ * }
+ * mean /= points;
+ * @endcode
+ *
+ * Errors (a file that cannot be opened or parsed) are reported by throwing a
+ * std::runtime_error, from the constructor or from Next().
+ *
+ * @tparam eT Element type of the chunks.
+ */
+template<typename eT>
+class ChunkedReader
+{
+ public:
+  /**
+   * Open the given file for reading in chunks.
+   *
+   * @param filename Name of file to read.
+   * @param chunkSize Number of points in each chunk (the last chunk may have
+   *     fewer).
+   * @param transpose If true (the default), each row of the file is a point,
+   *     as with data::Load().  Text files can only be read with transpose set
+   *     to true.
+   * @param type Type of the file, or FileType::AutoDetect to detect it as
+   *     data::Load() does.
+   * @param prefetch If true, read the next chunk in a background thread.
+   */
+  ChunkedReader(const std::string& filename,
+                const size_t chunkSize,
+                const bool transpose = true,
+                const FileType type = FileType::AutoDetect,
+                const bool prefetch = true);
+
+  //! Wait for the background read (if any) to finish.
+  ~ChunkedReader();
+
+  // The background read refers to the reader, so it cannot be copied or moved.
+  ChunkedReader(const ChunkedReader&) = delete;
+  ChunkedReader& operator=(const ChunkedReader&) = delete;
+
+  /**
+   * Get the next chunk of points.  Returns false (and leaves chunk unmodified)
+   * if all the points have been read.
+   *
+   * @param chunk Matrix to store the next chunk in; each column is a point.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  /**
+   * Start reading from the first point again (e.g. for another epoch).
+   */
+  void Reset();
+
+  //! Get the number of dimensions of the points.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the (maximum) number of points in each chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Get the type of the file.
+  FileType Type() const { return type; }
+
+ private:
+  /**
+   * Read the next chunk from the file into the given matrix; this is what the
+   * background thread runs.  Returns false if there are no points left.
+   */
+  bool ReadChunk(arma::Mat<eT>& chunk);
+
+  /**
+   * Convert the tokens of one line of a text file into the given column, or
+   * only count them if column is NULL.  Returns the number of tokens.
+   */
+  size_t ParseLine(const std::string& line, eT* column) const;
+
+  //! Start reading the next chunk in the background.
+  void Prefetch();
+
+  //! Name of the file.
+  std::string filename;
+  //! Number of points in each chunk.
+  size_t chunkSize;
+  //! Whether each row of the file is a point.
+  bool transpose;
+  //! Whether to read the next chunk in the background.
+  bool prefetch;
+  //! Type of the file.
+  FileType type;
+
+  //! The file, for formats that are read as they go.
+  InputFile file;
+  //! Position of the first point in the file.
+  std::streampos dataStart;
+  //! Delimiter of text files (or ' ' for any whitespace).
+  char delimiter;
+  //! Number of lines read from a text file (for error messages).
+  size_t line;
+  //! Whether the end of the data in a text file was reached.
+  bool finished;
+  //! The whole dataset, for formats that cannot be read in chunks.
+  arma::Mat<eT> data;
+
+  //! Number of dimensions of the points.
+  size_t dimensionality;
+  //! Number of points in the file (unknown for text files).
+  size_t points;
+  //! Index of the next point to read.
+  size_t position;
+
+  //! The chunk being read in the background.
+  arma::Mat<eT> nextChunk;
+  //! The result of the background read.
+  std::future<bool> pending;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunked_reader_impl.hpp"
+
+#endif
@@ -0,0 +1,349 @@
+/**
+ * @file core/data/chunked_reader_impl.hpp
+ *
+ * Implementation of ChunkedReader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNKED_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunked_reader.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+ChunkedReader<eT>::ChunkedReader(const std::string& filename,
+                                 const size_t chunkSize,
+                                 const bool transpose,
+                                 const FileType inputType,
+                                 const bool prefetch) :
+    filename(filename),
+    chunkSize(chunkSize),
+    transpose(transpose),
+    prefetch(prefetch),
+    type(inputType),
+    file(filename, std::fstream::in | std::fstream::binary),
+    delimiter(','),
+    line(0),
+    finished(false),
+    dimensionality(0),
+    points(0),
+    position(0)
+{
+  if (chunkSize == 0)
+  {
+    throw std::invalid_argument("ChunkedReader::ChunkedReader(): chunkSize "
+        "must be positive");
+  }
+
+  // The file is opened in binary mode, so that it can be seeked in; line
+  // endings are handled when parsing.  A compressed file is decompressed into
+  // memory.
+  if (!file.IsOpen())
+  {
+    std::ostringstream oss;
+    oss << "ChunkedReader::ChunkedReader(): cannot open file '" << filename
+        << "'";
+    if (!file.Error().empty())
+      oss << ": " << file.Error();
+    throw std::runtime_error(oss.str());
+  }
+
+  std::istream& stream = file.Stream();
+
+  // This skips the header of a CSV file, if there is one.
+  if (type == FileType::AutoDetect)
+    type = AutoDetect(stream, filename);
+
+  if (type == FileType::FileTypeUnknown)
+  {
+    std::ostringstream oss;
+    oss << "ChunkedReader::ChunkedReader(): unable to detect type of '"
+        << filename << "'; incorrect extension?";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (type == FileType::CSVASCII || type == FileType::RawASCII)
+  {
+    if (!transpose)
+    {
+      throw std::invalid_argument("ChunkedReader::ChunkedReader(): text "
+          "files can only be read with one point per line (transpose = "
+          "true)");
+    }
+
+    delimiter = (type == FileType::CSVASCII) ? ',' : ' ';
+    dataStart = stream.tellg();
+
+    // The first line gives the dimensionality.
+    std::string firstLine;
+    std::getline(stream, firstLine);
+    dimensionality = ParseLine(firstLine, NULL);
+    stream.clear();
+    stream.seekg(dataStart);
+  }
+  else if (type == FileType::ArmaBinary)
+  {
+    std::string header;
+    size_t rows = 0, cols = 0;
+    stream >> header >> rows >> cols;
+    stream.get();
+    if (!stream.good() || header != ArmaBinaryHeader<eT>())
+    {
+      std::ostringstream oss;
+      oss << "ChunkedReader::ChunkedReader(): '" << filename << "' is not an "
+          << "Armadillo binary file with header " << ArmaBinaryHeader<eT>()
+          << " (its header is '" << header << "')";
+      throw std::runtime_error(oss.str());
+    }
+
+    dataStart = stream.tellg();
+    dimensionality = transpose ? cols : rows;
+    points = transpose ? rows : cols;
+  }
+  else
+  {
+    // Other formats are loaded all at once.
+    file.Close();
+    if (!Load(filename, data, false, transpose, type))
+    {
+      std::ostringstream oss;
+      oss << "ChunkedReader::ChunkedReader(): cannot load '" << filename
+          << "'";
+      throw std::runtime_error(oss.str());
+    }
+
+    dimensionality = data.n_rows;
+    points = data.n_cols;
+  }
+
+  if (prefetch)
+    Prefetch();
+}
+
+template<typename eT>
+ChunkedReader<eT>::~ChunkedReader()
+{
+  if (pending.valid())
+    pending.wait();
+}
+
+template<typename eT>
+bool ChunkedReader<eT>::Next(arma::Mat<eT>& chunk)
+{
+  if (!prefetch)
+    return ReadChunk(chunk);
+
+  if (!pending.valid())
+    Prefetch();
+
+  // This rethrows any exception thrown by the background read.
+  if (!pending.get())
+    return false;
+
+  chunk.swap(nextChunk);
+  Prefetch();
+  return true;
+}
+
+template<typename eT>
+void ChunkedReader<eT>::Reset()
+{
+  // Discard the pending read (and any error it had).
+  if (pending.valid())
+  {
+    pending.wait();
+    pending = std::future<bool>();
+  }
+
+  position = 0;
+  line = 0;
+  finished = false;
+  if (file.IsOpen())
+  {
+    file.Stream().clear();
+    file.Stream().seekg(dataStart);
+  }
+
+  if (prefetch)
+    Prefetch();
+}
+
+template<typename eT>
+void ChunkedReader<eT>::Prefetch()
+{
+  pending = std::async(std::launch::async,
+      [this]() { return ReadChunk(nextChunk); });
+}
+
+template<typename eT>
+bool ChunkedReader<eT>::ReadChunk(arma::Mat<eT>& chunk)
+{
+  std::istream& stream = file.Stream();
+  if (type == FileType::CSVASCII || type == FileType::RawASCII)
+  {
+    if (finished)
+      return false;
+
+    chunk.set_size(dimensionality, chunkSize);
+    size_t n = 0;
+    std::string lineString;
+    while (n < chunkSize && std::getline(stream, lineString))
+    {
+      ++line;
+      if (!lineString.empty() && lineString.back() == '\r')
+        lineString.pop_back();
+
+      // Like data::Load(), stop at the first empty line.
+      if (lineString.empty())
+      {
+        finished = true;
+        break;
+      }
+
+      ParseLine(lineString, chunk.colptr(n));
+      ++n;
+    }
+
+    if (n < chunkSize)
+      finished = true;
+
+    if (n == 0)
+      return false;
+
+    if (n < chunkSize)
+      chunk.shed_cols(n, chunkSize - 1);
+
+    position += n;
+    return true;
+  }
+
+  const size_t n = std::min(chunkSize, points - position);
+  if (n == 0)
+    return false;
+
+  if (type == FileType::ArmaBinary)
+  {
+    chunk.set_size(dimensionality, n);
+    if (!transpose)
+    {
+      // The points of the chunk are contiguous in the file.
+      stream.seekg(dataStart + std::streamoff(position * dimensionality *
+          sizeof(eT)));
+      stream.read(reinterpret_cast<char*>(chunk.memptr()),
+          std::streamsize(chunk.n_elem * sizeof(eT)));
+    }
+    else
+    {
+      // Each dimension is a column of the file, so read the part of each
+      // column that belongs to the chunk.
+      arma::Col<eT> buffer(n);
+      for (size_t d = 0; d < dimensionality; ++d)
+      {
+        stream.seekg(dataStart + std::streamoff((d * points + position) *
+            sizeof(eT)));
+        stream.read(reinterpret_cast<char*>(buffer.memptr()),
+            std::streamsize(n * sizeof(eT)));
+        chunk.row(d) = buffer.t();
+      }
+    }
+
+    if (!stream.good())
+    {
+      std::ostringstream oss;
+      oss << "ChunkedReader::Next(): cannot read '" << filename << "'; the "
+          << "file is truncated";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  else
+  {
+    chunk = data.cols(position, position + n - 1);
+  }
+
+  position += n;
+  return true;
+}
+
+template<typename eT>
+size_t ChunkedReader<eT>::ParseLine(const std::string& lineString,
+                                    eT* column) const
+{
+  size_t tokens = 0;
+  auto convert = [&](const char* begin, const char* end)
+  {
+    if (column != NULL)
+    {
+      if (tokens == dimensionality)
+      {
+        std::ostringstream oss;
+        oss << "ChunkedReader::Next(): line " << line << " of '" << filename
+            << "' has more than " << dimensionality << " elements";
+        throw std::runtime_error(oss.str());
+      }
+
+      if (!LoadCSV::ConvertToken<eT>(column[tokens], begin, end))
+      {
+        std::ostringstream oss;
+        oss << "ChunkedReader::Next(): cannot convert token '"
+            << std::string(begin, end) << "' on line " << line << " of '"
+            << filename << "'";
+        throw std::runtime_error(oss.str());
+      }
+    }
+
+    ++tokens;
+  };
+
+  const char* p = lineString.data();
+  const char* end = p + lineString.size();
+  if (delimiter == ' ')
+  {
+    // Tokens are separated by any amount of whitespace.
+    while (true)
+    {
+      while (p != end && (*p == ' ' || *p == '\t'))
+        ++p;
+      if (p == end)
+        break;
+
+      const char* tokenEnd = p;
+      while (tokenEnd != end && *tokenEnd != ' ' && *tokenEnd != '\t')
+        ++tokenEnd;
+      convert(p, tokenEnd);
+      p = tokenEnd;
+    }
+  }
+  else
+  {
+    // As in data::Load(), a trailing delimiter ends an empty last token.
+    while (true)
+    {
+      const char* tokenEnd = std::find(p, end, delimiter);
+      convert(p, tokenEnd);
+      if (tokenEnd == end)
+        break;
+      p = tokenEnd + 1;
+    }
+  }
+
+  // Missing elements are filled with zeros, as by data::Load().
+  if (column != NULL)
+  {
+    for (size_t i = tokens; i < dimensionality; ++i)
+      column[i] = eT(0);
+  }
+
+  return tokens;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file core/data/compressed_file.hpp
+ *
+ * Streams for reading and writing files that may be compressed with gzip or
+ * zstd; data::Load() and data::Save() use these, so that compressed files are
+ * handled transparently.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_FILE_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+#include <memory>
+
+#include "compression.hpp"
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A read-only, seekable stream buffer over a block of memory.
+ */
+class MemoryStreamBuffer : public std::streambuf
+{
+ public:
+  //! Read from the given memory, which must outlive the buffer.
+  MemoryStreamBuffer(const char* data, const size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+ protected:
+  pos_type seekoff(off_type offset,
+                   std::ios_base::seekdir direction,
+                   std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::in))
+      return pos_type(off_type(-1));
+
+    char* base = (direction == std::ios_base::beg) ? eback() :
+        (direction == std::ios_base::cur) ? gptr() : egptr();
+    if (offset < eback() - base || offset > egptr() - base)
+      return pos_type(off_type(-1));
+
+    setg(eback(), base + offset, egptr());
+    return pos_type(gptr() - eback());
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return seekoff(off_type(position), std::ios_base::beg, which);
+  }
+};
+
+/**
+ * InputFile opens a file for reading.  An uncompressed file is read through a
+ * std::fstream; a gzip (.gz) or zstd (.zst) file is decompressed into memory
+ * (see MappedFile), and Stream() reads (and can seek in) the decompressed
+ * data.
+ */
+class InputFile
+{
+ public:
+  /**
+   * Open the given file.  Use IsOpen() to check whether this succeeded.
+   *
+   * @param filename Name of the file to open.
+   * @param mode Mode to open an uncompressed file with.
+   * @param decompress If false, a compressed file is opened as it is (for
+   *     instance, to check that it exists before it is read by something that
+   *     decompresses it itself).
+   */
+  InputFile(const std::string& filename,
+            const std::ios::openmode mode = std::ios::in,
+            const bool decompress = true) :
+      stream(&file)
+  {
+    if (!decompress || CompressionType(filename) == Compression::None)
+    {
+      file.open(filename.c_str(), mode);
+      return;
+    }
+
+    contents.reset(new MappedFile(filename));
+    if (!contents->IsOpen())
+      return;
+
+    buffer.reset(new MemoryStreamBuffer(contents->Data(), contents->Size()));
+    memoryStream.reset(new std::istream(buffer.get()));
+    stream = memoryStream.get();
+  }
+
+  //! Return whether the file was opened (and decompressed) successfully.
+  bool IsOpen() const
+  {
+    return contents ? contents->IsOpen() : file.is_open();
+  }
+
+  //! Return whether the file was decompressed into memory.
+  bool IsCompressed() const { return (bool) contents; }
+
+  //! Get the decompressed contents of a compressed file.
+  const MappedFile& Contents() const { return *contents; }
+
+  //! Get the stream to read the file with.
+  std::istream& Stream() { return *stream; }
+
+  //! Get the reason a compressed file could not be decompressed, if it
+  //! couldn't.
+  std::string Error() const { return contents ? contents->Error() : ""; }
+
+  //! Close the file.
+  void Close()
+  {
+    file.close();
+    memoryStream.reset();
+    buffer.reset();
+    contents.reset();
+    stream = &file;
+  }
+
+ private:
+  //! The file, if it is not compressed.
+  std::fstream file;
+  //! The decompressed contents of the file, if it is compressed.
+  std::unique_ptr<MappedFile> contents;
+  //! The buffer to read the decompressed contents with.
+  std::unique_ptr<MemoryStreamBuffer> buffer;
+  //! The stream to read the decompressed contents with.
+  std::unique_ptr<std::istream> memoryStream;
+  //! The stream to read the file with.
+  std::istream* stream;
+};
+
+/**
+ * OutputFile opens a file for writing.  If the name of the file ends in .gz or
+ * .zst, what is written to Stream() is compressed with gzip or zstd (see
+ * CompressionStreamBuffer).  Close() must be called to finish the file.
+ */
+class OutputFile
+{
+ public:
+  /**
+   * Open the given file.  Use IsOpen() to check whether this succeeded.
+   *
+   * @param filename Name of the file to open.
+   * @param mode Mode to open an uncompressed file with (compressed files are
+   *     always written in binary mode).
+   */
+  OutputFile(const std::string& filename,
+             const std::ios::openmode mode = std::ios::out) :
+      compression(CompressionType(filename)),
+      stream(&file)
+  {
+    if (compression == Compression::None)
+    {
+      file.open(filename.c_str(), mode);
+      return;
+    }
+
+    file.open(filename.c_str(), std::ios::out | std::ios::binary);
+    compressor.reset(new CompressionStreamBuffer(file, compression));
+    compressedStream.reset(new std::ostream(compressor.get()));
+    stream = compressedStream.get();
+  }
+
+  //! Return whether the file was opened successfully.
+  bool IsOpen() const { return file.is_open(); }
+
+  //! Return whether the file is compressed.
+  bool IsCompressed() const { return compression != Compression::None; }
+
+  //! Get the stream to write the file with.
+  std::ostream& Stream() { return *stream; }
+
+  /**
+   * Finish writing the file (compressing anything that is left) and close it.
+   * Returns false and sets `error` if anything could not be written.
+   */
+  bool Close(std::string& error)
+  {
+    if (!file.is_open())
+      return true;
+
+    bool success = stream->good();
+    if (compressor)
+    {
+      stream->flush();
+      success = compressor->Finish(error) && success;
+    }
+
+    file.close();
+    success = success && !file.fail();
+    if (!success && error.empty())
+      error = "write failed";
+
+    return success;
+  }
+
+ private:
+  //! The compression of the file.
+  Compression compression;
+  //! The file.
+  std::ofstream file;
+  //! The compressor, if the file is compressed.
+  std::unique_ptr<CompressionStreamBuffer> compressor;
+  //! The stream that writes to the compressor.
+  std::unique_ptr<std::ostream> compressedStream;
+  //! The stream to write the file with.
+  std::ostream* stream;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,577 @@
+/**
+ * @file core/data/compression.hpp
+ *
+ * Compression and decompression of gzip (.gz) and zstd (.zst) data, so that
+ * data::Load() and data::Save() can transparently handle compressed files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSION_HPP
+#define MLPACK_CORE_DATA_COMPRESSION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <climits>
+#include <cstring>
+#include <streambuf>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+#ifdef MLPACK_HAS_ZLIB
+  #include <zlib.h>
+#endif
+
+#ifdef MLPACK_HAS_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The compression formats of files; the format is given by the extension of
+ * the file.
+ */
+enum class Compression
+{
+  None,  //!< Not compressed.
+  Gzip,  //!< gzip (.gz); needs zlib.
+  Zstd   //!< Zstandard (.zst); needs libzstd.
+};
+
+/**
+ * Compressed data is written in independent blocks (gzip members or zstd
+ * frames) of this many uncompressed bytes, so that blocks can be compressed,
+ * and zstd blocks decompressed, in parallel.
+ */
+static const size_t CompressionBlockSize = 8 << 20;
+
+/**
+ * Get the compression of the given file from its extension.
+ */
+inline Compression CompressionType(const std::string& filename)
+{
+  const size_t ext = filename.rfind('.');
+  if (ext == std::string::npos)
+    return Compression::None;
+
+  std::string extension = filename.substr(ext + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+      ::tolower);
+
+  if (extension == "gz")
+    return Compression::Gzip;
+  else if (extension == "zst" || extension == "zstd")
+    return Compression::Zstd;
+  else
+    return Compression::None;
+}
+
+/**
+ * Remove the compression extension (if any) from the given filename, so that
+ * "data.csv.gz" gives "data.csv".
+ */
+inline std::string StripCompressionExtension(const std::string& filename)
+{
+  if (CompressionType(filename) == Compression::None)
+    return filename;
+
+  return filename.substr(0, filename.rfind('.'));
+}
+
+/**
+ * Get the name of the given compression, for messages.
+ */
+inline std::string CompressionName(const Compression compression)
+{
+  switch (compression)
+  {
+    case Compression::Gzip:
+      return "gzip";
+    case Compression::Zstd:
+      return "zstd";
+    default:
+      return "uncompressed";
+  }
+}
+
+namespace details {
+
+// With MLPACK_HAS_ZLIB or MLPACK_HAS_ZSTD undefined, these give an error.
+inline bool CompressionUnavailable(const Compression compression,
+                                   std::string& error)
+{
+  error = "mlpack was compiled without " + std::string(compression ==
+      Compression::Gzip ? "zlib" : "zstd") + " support, so " +
+      CompressionName(compression) + "-compressed files cannot be used";
+  return false;
+}
+
+/**
+ * Decompress a gzip file, which may be several gzip members one after
+ * another (as written by Compress()).  zlib can only inflate a stream
+ * sequentially.
+ */
+inline bool DecompressGzip(const char* data,
+                           const size_t size,
+                           std::string& out,
+                           std::string& error)
+{
+#ifdef MLPACK_HAS_ZLIB
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  // 15 + 32: the largest window, and detect the gzip (or zlib) header.
+  if (inflateInit2(&stream, 15 + 32) != Z_OK)
+  {
+    error = "cannot initialize zlib";
+    return false;
+  }
+
+  // zlib counts bytes with unsigned ints, so give it at most 1GB at a time.
+  const size_t maxStep = (size_t) 1 << 30;
+  out.resize(std::max(2 * size, (size_t) 1 << 16));
+  size_t inPos = 0, outPos = 0;
+  while (true)
+  {
+    if (stream.avail_in == 0 && inPos < size)
+    {
+      const size_t n = std::min(size - inPos, maxStep);
+      stream.next_in = (Bytef*) (data + inPos);
+      stream.avail_in = (uInt) n;
+      inPos += n;
+    }
+
+    if (outPos == out.size())
+      out.resize(2 * out.size());
+
+    const size_t available = std::min(out.size() - outPos, maxStep);
+    stream.next_out = (Bytef*) &out[outPos];
+    stream.avail_out = (uInt) available;
+    const int result = inflate(&stream, Z_NO_FLUSH);
+    outPos += available - stream.avail_out;
+
+    if (result == Z_STREAM_END)
+    {
+      // Another member may follow.
+      if (stream.avail_in == 0 && inPos == size)
+        break;
+      inflateReset(&stream);
+    }
+    else if (result == Z_BUF_ERROR)
+    {
+      // No progress was possible: either the output buffer is full (and will
+      // be grown), or the input ended in the middle of a member.
+      if (stream.avail_out != 0 && stream.avail_in == 0 && inPos == size)
+      {
+        inflateEnd(&stream);
+        error = "the gzip data is truncated";
+        return false;
+      }
+    }
+    else if (result != Z_OK)
+    {
+      error = "invalid gzip data (" + std::string(stream.msg == NULL ?
+          "unknown error" : stream.msg) + ")";
+      inflateEnd(&stream);
+      return false;
+    }
+  }
+
+  inflateEnd(&stream);
+  out.resize(outPos);
+  return true;
+#else
+  (void) data;
+  (void) size;
+  (void) out;
+  return CompressionUnavailable(Compression::Gzip, error);
+#endif
+}
+
+/**
+ * Decompress a zstd file.  If it is made of several frames that record their
+ * size (as written by Compress()), the frames are decompressed in parallel;
+ * otherwise, the file is decompressed as a stream.
+ */
+inline bool DecompressZstd(const char* data,
+                           const size_t size,
+                           std::string& out,
+                           std::string& error)
+{
+#ifdef MLPACK_HAS_ZSTD
+  // Find the frames and the size of their contents.
+  std::vector<size_t> frameBegin, outBegin;
+  size_t pos = 0, total = 0;
+  bool knownSizes = true;
+  while (pos < size)
+  {
+    const size_t frameSize = ZSTD_findFrameCompressedSize(data + pos,
+        size - pos);
+    if (ZSTD_isError(frameSize))
+    {
+      error = "invalid zstd data (" + std::string(ZSTD_getErrorName(
+          frameSize)) + ")";
+      return false;
+    }
+
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(data +
+        pos, size - pos);
+    if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+        contentSize == ZSTD_CONTENTSIZE_ERROR)
+    {
+      knownSizes = false;
+      break;
+    }
+
+    frameBegin.push_back(pos);
+    outBegin.push_back(total);
+    pos += frameSize;
+    total += (size_t) contentSize;
+  }
+  frameBegin.push_back(size);
+  outBegin.push_back(total);
+
+  if (knownSizes)
+  {
+    out.resize(total);
+    const size_t numFrames = frameBegin.size() - 1;
+    std::vector<std::string> frameError(numFrames);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+      ZSTD_DCtx* context = ZSTD_createDCtx();
+      const size_t expected = outBegin[f + 1] - outBegin[f];
+      const size_t result = ZSTD_decompressDCtx(context, &out[0] + outBegin[f],
+          expected, data + frameBegin[f], frameBegin[f + 1] - frameBegin[f]);
+      if (ZSTD_isError(result))
+        frameError[f] = ZSTD_getErrorName(result);
+      else if (result != expected)
+        frameError[f] = "frame has the wrong size";
+      ZSTD_freeDCtx(context);
+    }
+
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+      if (!frameError[f].empty())
+      {
+        error = "invalid zstd data (" + frameError[f] + ")";
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Otherwise, decompress the whole file as a stream.
+  ZSTD_DStream* stream = ZSTD_createDStream();
+  ZSTD_initDStream(stream);
+  ZSTD_inBuffer in = { data, size, 0 };
+  out.resize(std::max(4 * size, (size_t) 1 << 16));
+  size_t outPos = 0;
+  while (true)
+  {
+    if (outPos == out.size())
+      out.resize(2 * out.size());
+
+    ZSTD_outBuffer buffer = { &out[outPos], out.size() - outPos, 0 };
+    const size_t result = ZSTD_decompressStream(stream, &buffer, &in);
+    outPos += buffer.pos;
+    if (ZSTD_isError(result))
+    {
+      error = "invalid zstd data (" + std::string(ZSTD_getErrorName(result)) +
+          ")";
+      ZSTD_freeDStream(stream);
+      return false;
+    }
+
+    if (in.pos == in.size)
+    {
+      // A result of 0 means that the frame is complete; otherwise, the rest of
+      // the frame is missing (unless the output buffer was too small).
+      if (result == 0)
+        break;
+      if (buffer.pos < buffer.size)
+      {
+        error = "the zstd data is truncated";
+        ZSTD_freeDStream(stream);
+        return false;
+      }
+    }
+  }
+
+  ZSTD_freeDStream(stream);
+  out.resize(outPos);
+  return true;
+#else
+  (void) data;
+  (void) size;
+  (void) out;
+  return CompressionUnavailable(Compression::Zstd, error);
+#endif
+}
+
+/**
+ * Compress one block of data into a complete gzip member or zstd frame, which
+ * is appended to `out`.
+ */
+inline bool CompressBlock(const char* data,
+                          const size_t size,
+                          const Compression compression,
+                          std::string& out,
+                          std::string& error)
+{
+  if (compression == Compression::Gzip)
+  {
+#ifdef MLPACK_HAS_ZLIB
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // 15 + 16: the largest window, with a gzip header.
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+        Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      error = "cannot initialize zlib";
+      return false;
+    }
+
+    const size_t start = out.size();
+    const size_t bound = deflateBound(&stream, (uLong) size);
+    out.resize(start + bound);
+    stream.next_in = (Bytef*) data;
+    stream.avail_in = (uInt) size;
+    stream.next_out = (Bytef*) &out[start];
+    stream.avail_out = (uInt) bound;
+    const int result = deflate(&stream, Z_FINISH);
+    out.resize(start + bound - stream.avail_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END)
+    {
+      error = "gzip compression failed";
+      return false;
+    }
+
+    return true;
+#else
+    (void) data;
+    (void) size;
+    (void) out;
+    return CompressionUnavailable(compression, error);
+#endif
+  }
+  else
+  {
+#ifdef MLPACK_HAS_ZSTD
+    // ZSTD_compress() records the size of the contents in the frame, so that
+    // the frames can be decompressed in parallel.
+    const size_t start = out.size();
+    const size_t bound = ZSTD_compressBound(size);
+    out.resize(start + bound);
+    const size_t result = ZSTD_compress(&out[start], bound, data, size,
+        ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(result))
+    {
+      out.resize(start);
+      error = "zstd compression failed (" + std::string(ZSTD_getErrorName(
+          result)) + ")";
+      return false;
+    }
+
+    out.resize(start + result);
+    return true;
+#else
+    (void) data;
+    (void) size;
+    (void) out;
+    return CompressionUnavailable(compression, error);
+#endif
+  }
+}
+
+} // namespace details
+
+/**
+ * Decompress the given gzip or zstd data into `out`.  Returns false and sets
+ * `error` if the data is invalid or support for the compression is not
+ * available.
+ *
+ * @param data Compressed data.
+ * @param size Size of the compressed data, in bytes.
+ * @param compression Compression of the data.
+ * @param out Set to the decompressed data.
+ * @param error Set to a description of the problem, on failure.
+ */
+inline bool Decompress(const char* data,
+                       const size_t size,
+                       const Compression compression,
+                       std::string& out,
+                       std::string& error)
+{
+  if (compression == Compression::Gzip)
+    return details::DecompressGzip(data, size, out, error);
+  else if (compression == Compression::Zstd)
+    return details::DecompressZstd(data, size, out, error);
+
+  out.assign(data, size);
+  return true;
+}
+
+/**
+ * Compress the given data into `out`, as a gzip or zstd file.  The data is
+ * split into blocks of CompressionBlockSize bytes, which are compressed in
+ * parallel into independent gzip members or zstd frames; any gzip or zstd
+ * decompressor reads the result as one file.
+ *
+ * @param data Data to compress.
+ * @param size Size of the data, in bytes.
+ * @param compression Compression to use.
+ * @param out Set to the compressed data.
+ * @param error Set to a description of the problem, on failure.
+ */
+inline bool Compress(const char* data,
+                     const size_t size,
+                     const Compression compression,
+                     std::string& out,
+                     std::string& error)
+{
+  out.clear();
+  if (compression == Compression::None)
+  {
+    out.assign(data, size);
+    return true;
+  }
+
+  // Even empty data gets one block, so that the file is valid.
+  const size_t numBlocks = std::max((size_t) 1,
+      (size + CompressionBlockSize - 1) / CompressionBlockSize);
+  std::vector<std::string> blocks(numBlocks);
+  std::vector<std::string> blockError(numBlocks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * CompressionBlockSize;
+    const size_t end = std::min(size, begin + CompressionBlockSize);
+    details::CompressBlock(data + begin, end - begin, compression, blocks[b],
+        blockError[b]);
+  }
+
+  size_t total = 0;
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    if (!blockError[b].empty())
+    {
+      error = blockError[b];
+      return false;
+    }
+
+    total += blocks[b].size();
+  }
+
+  out.reserve(total);
+  for (size_t b = 0; b < numBlocks; ++b)
+    out += blocks[b];
+
+  return true;
+}
+
+/**
+ * CompressionStreamBuffer is an output stream buffer that compresses what is
+ * written to it (see Compress()) and writes the result to another stream.  It
+ * holds one block per thread; when they are full, they are compressed in
+ * parallel, so only a bounded amount of uncompressed data is in memory.
+ * Finish() must be called after the last write.
+ */
+class CompressionStreamBuffer : public std::streambuf
+{
+ public:
+  /**
+   * Create the buffer, writing compressed data to the given stream.
+   *
+   * @param out Stream to write the compressed data to.
+   * @param compression Compression to use.
+   */
+  CompressionStreamBuffer(std::ostream& out, const Compression compression) :
+      out(out),
+      compression(compression),
+      written(false)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      const size_t numThreads = omp_get_max_threads();
+    #else
+      const size_t numThreads = 1;
+    #endif
+
+    buffer.resize(numThreads * CompressionBlockSize);
+    setp(&buffer[0], &buffer[0] + buffer.size());
+  }
+
+  /**
+   * Compress and write the rest of the data.  Returns false (and sets
+   * `error`) if compressing or writing failed at any point.
+   */
+  bool Finish(std::string& error)
+  {
+    if (!written || pptr() != pbase())
+      Flush();
+
+    error = this->error;
+    return error.empty() && out.good();
+  }
+
+ protected:
+  //! Compress the full buffer, and start filling it again.
+  int_type overflow(int_type c) override
+  {
+    Flush();
+    if (!error.empty())
+      return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+
+ private:
+  //! Compress and write the data in the buffer.
+  void Flush()
+  {
+    if (error.empty())
+    {
+      std::string compressed;
+      if (Compress(pbase(), pptr() - pbase(), compression, compressed, error))
+      {
+        out.write(compressed.data(), compressed.size());
+        if (!out.good())
+          error = "write failed";
+      }
+    }
+
+    written = true;
+    setp(&buffer[0], &buffer[0] + buffer.size());
+  }
+
+  //! The stream that compressed data is written to.
+  std::ostream& out;
+  //! The compression to use.
+  Compression compression;
+  //! Whether anything has been compressed yet.
+  bool written;
+  //! The uncompressed data that has not been compressed yet.
+  std::vector<char> buffer;
+  //! The first error, if any.
+  std::string error;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
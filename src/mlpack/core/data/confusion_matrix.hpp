@@ -45,14 +45,17 @@ namespace data {
  * represents the predicted classes and column index represents the actual
  * class.
  *
+ * When there are many more points than entries of the matrix, the points are
+ * counted in parallel with OpenMP.
+ *
  * @param predictors Vector of data points.
  * @param responses The measured data for each point.
  * @param output Matrix which is represented as confusion matrix.
  * @param numClasses Number of classes.
  */
 template<typename eT>
-void ConfusionMatrix(const arma::Row<size_t> predictors,
-                     const arma::Row<size_t> responses,
+void ConfusionMatrix(const arma::Row<size_t>& predictors,
+                     const arma::Row<size_t>& responses,
                      arma::Mat<eT>& output,
                      const size_t numClasses);
 
@@ -47,17 +47,30 @@ namespace data {
  * class.
  */
 template<typename eT>
-void ConfusionMatrix(const arma::Row<size_t> predictors,
-                     const arma::Row<size_t> responses,
+void ConfusionMatrix(const arma::Row<size_t>& predictors,
+                     const arma::Row<size_t>& responses,
                      arma::Mat<eT>& output,
                      const size_t numClasses)
 {
-  // Loop over the actual labels and predicted labels and add the count.
-  output = arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
-  for (size_t i = 0; i < predictors.n_elem; ++i)
+  // Loop over the actual labels and predicted labels and add the count.  Each
+  // thread counts its points in its own matrix, so this is only worth it if
+  // there are many more points than entries of the matrix.
+  arma::Mat<size_t> counts(numClasses, numClasses, arma::fill::zeros);
+  #pragma omp parallel if (predictors.n_elem > 16 * numClasses * numClasses)
   {
-    output.at(predictors[i], responses[i])++;
+    arma::Mat<size_t> threadCounts(numClasses, numClasses, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < predictors.n_elem; ++i)
+    {
+      threadCounts.at(predictors[i], responses[i])++;
+    }
+
+    #pragma omp critical
+    counts += threadCounts;
   }
+
+  output = arma::conv_to<arma::Mat<eT>>::from(counts);
 }
 
 } // namespace data
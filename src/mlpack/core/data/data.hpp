@@ -18,6 +18,7 @@
 #include "has_serialize.hpp"
 
 #include "load.hpp"
+#include "map_matrix.hpp"
 #include "save.hpp"
 
 #include "imputation_methods/imputation_methods.hpp"
@@ -28,6 +29,8 @@
 
 #include "binarize.hpp"
 #include "check_categorical_param.hpp"
+#include "chunked_reader.hpp"
+#include "compression.hpp"
 #include "confusion_matrix.hpp"
 #include "dataset_mapper.hpp"
 #include "image_info.hpp"
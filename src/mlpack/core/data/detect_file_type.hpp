@@ -49,11 +49,15 @@ inline FileType GuessFileType(std::istream& f);
  * If the file is detected as a CSV, and the CSV is detected to have a header
  * row, `stream` will be fast-forwarded to point at the second line of the file.
  *
+ * A compressed file is detected by the extension of the file inside it (so
+ * "data.csv.gz" is a CSV); `stream` must then read the decompressed data (see
+ * InputFile).
+ *
  * @param stream Opened file stream to look into for autodetection.
  * @param filename Name of the file.
  * @return The detected file type.  arma::file_type_unknown if unknown.
  */
-inline FileType AutoDetect(std::fstream& stream,
+inline FileType AutoDetect(std::istream& stream,
                            const std::string& filename);
 
 /**
@@ -68,7 +72,7 @@ inline FileType DetectFromExtension(const std::string& filename);
  * Count the number of columns in the file.  The file must be a CSV/TSV/TXT file
  * with no header.
  */
-inline size_t CountCols(std::fstream& stream);
+inline size_t CountCols(std::istream& stream);
 
 } // namespace data
 } // namespace mlpack
@@ -36,6 +36,9 @@ inline std::string GetStringType(const FileType& type)
     case FileType::PGMBinary:   return "PGM data";
     case FileType::HDF5Binary:  return "HDF5 data";
     case FileType::CoordASCII:  return "ASCII formatted sparse coordinate data";
+    case FileType::ArrowIPC:    return "Arrow IPC data";
+    case FileType::Parquet:     return "Parquet data";
+    case FileType::LibSVM:      return "libsvm formatted sparse data";
     default:                    return "";
   }
 }
@@ -183,11 +186,15 @@ inline FileType GuessFileType(std::istream& f)
  * If the file is detected as a CSV, and the CSV is detected to have a header
  * row, `stream` will be fast-forwarded to point at the second line of the file.
  *
+ * A compressed file is detected by the extension of the file inside it (so
+ * "data.csv.gz" is a CSV); `stream` must then read the decompressed data (see
+ * InputFile).
+ *
  * @param stream Opened file stream to look into for autodetection.
  * @param filename Name of the file.
  * @return The detected file type.
  */
-inline FileType AutoDetect(std::fstream& stream, const std::string& filename)
+inline FileType AutoDetect(std::istream& stream, const std::string& filename)
 {
   // Get the extension.
   std::string extension = Extension(filename);
@@ -292,6 +299,20 @@ inline FileType AutoDetect(std::fstream& stream, const std::string& filename)
   {
     detectedLoadType = FileType::HDF5Binary;
   }
+  else if (extension == "arrow" || extension == "feather" ||
+           extension == "ipc")
+  {
+    detectedLoadType = FileType::ArrowIPC;
+  }
+  else if (extension == "parquet")
+  {
+    detectedLoadType = FileType::Parquet;
+  }
+  else if (extension == "svm" || extension == "libsvm" ||
+           extension == "svmlight")
+  {
+    detectedLoadType = FileType::LibSVM;
+  }
   else // Unknown extension...
   {
     detectedLoadType = FileType::FileTypeUnknown;
@@ -331,6 +352,20 @@ inline FileType DetectFromExtension(const std::string& filename)
   {
     return FileType::HDF5Binary;
   }
+  else if (extension == "arrow" || extension == "feather" ||
+           extension == "ipc")
+  {
+    return FileType::ArrowIPC;
+  }
+  else if (extension == "parquet")
+  {
+    return FileType::Parquet;
+  }
+  else if (extension == "svm" || extension == "libsvm" ||
+           extension == "svmlight")
+  {
+    return FileType::LibSVM;
+  }
   else
   {
     return FileType::FileTypeUnknown;
@@ -341,7 +376,7 @@ inline FileType DetectFromExtension(const std::string& filename)
  * Count the number of columns in the file.  The file must be a CSV/TSV/TXT file
  * with no header.
  */
-inline size_t CountCols(std::fstream& f)
+inline size_t CountCols(std::istream& f)
 {
   f.clear();
   const std::fstream::pos_type pos1 = f.tellg();
@@ -15,11 +15,18 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "compression.hpp"
+
 namespace mlpack {
 namespace data {
 
-inline std::string Extension(const std::string& filename)
+/**
+ * Get the lower-case extension of the given file.  The extension of a
+ * compressed file is that of the file inside it: "data.csv.gz" gives "csv".
+ */
+inline std::string Extension(const std::string& fullFilename)
 {
+  const std::string filename = StripCompressionExtension(fullFilename);
   const size_t ext = filename.rfind('.');
   std::string extension;
   if (ext == std::string::npos)
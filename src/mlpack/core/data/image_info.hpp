@@ -20,7 +20,8 @@ namespace mlpack {
 namespace data {
 
 /**
- * Checks if the given image filename is supported.
+ * Checks if the given image filename is supported.  Compressed images (.gz,
+ * .zst) are not.
  *
  * @param fileName Name of the image file.
  * @param save Set to true to check if the file format can be saved, else loaded.
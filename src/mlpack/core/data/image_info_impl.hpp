@@ -40,6 +40,10 @@ namespace data {
 
 inline bool ImageFormatSupported(const std::string& fileName, const bool save)
 {
+  // Images are read and written by STB, which can't handle compressed files.
+  if (CompressionType(fileName) != Compression::None)
+    return false;
+
   if (save)
   {
     // Iterate over all supported file types that can be saved.
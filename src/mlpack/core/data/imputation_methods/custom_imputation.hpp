@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_CUSTOM_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "imputation_traits.hpp"
 
 namespace mlpack {
 namespace data {
@@ -76,6 +77,13 @@ class CustomImputation
   T customValue;
 }; // class CustomImputation
 
+//! Each dimension is imputed independently.
+template<typename T>
+struct ImputationTraits<CustomImputation<T>>
+{
+  static const bool independentDimensions = true;
+};
+
 } // namespace data
 } // namespace mlpack
 
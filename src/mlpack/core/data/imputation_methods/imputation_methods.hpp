@@ -12,6 +12,7 @@
 #ifndef MLPACK_CORE_DATA_IMPUTATION_METHODS_IMPUTATION_METHODS_HPP
 #define MLPACK_CORE_DATA_IMPUTATION_METHODS_IMPUTATION_METHODS_HPP
 
+#include "imputation_traits.hpp"
 #include "mean_imputation.hpp"
 #include "median_imputation.hpp"
 #include "listwise_deletion.hpp"
@@ -0,0 +1,37 @@
+/**
+ * @file core/data/imputation_methods/imputation_traits.hpp
+ *
+ * This provides the ImputationTraits struct, a template struct to get
+ * information about various imputation strategies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMPUTATION_METHODS_IMPUTATION_TRAITS_HPP
+#define MLPACK_CORE_DATA_IMPUTATION_METHODS_IMPUTATION_TRAITS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * This is a template struct that provides some information about various
+ * imputation strategies.
+ */
+template<typename StrategyType>
+struct ImputationTraits
+{
+  /**
+   * Indicates if imputing one dimension only reads and modifies the elements of
+   * that dimension, so that several dimensions can be imputed in parallel.
+   */
+  static const bool independentDimensions = false;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "imputation_traits.hpp"
 
 namespace mlpack {
 namespace data {
@@ -98,6 +99,13 @@ class MeanImputation
   }
 }; // class MeanImputation
 
+//! Each dimension is imputed independently.
+template<typename T>
+struct ImputationTraits<MeanImputation<T>>
+{
+  static const bool independentDimensions = true;
+};
+
 } // namespace data
 } // namespace mlpack
 
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEDIAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "imputation_traits.hpp"
 
 namespace mlpack {
 namespace data {
@@ -45,6 +46,7 @@ class MedianImputation
     std::vector<PairType> targets;
     // good elements are kept inside this vector.
     std::vector<double> elemsToKeep;
+    elemsToKeep.reserve(columnMajor ? input.n_cols : input.n_rows);
 
     if (columnMajor)
     {
@@ -77,8 +79,23 @@ class MedianImputation
       }
     }
 
-    // calculate median
-    const double median = arma::median(arma::vec(elemsToKeep));
+    if (elemsToKeep.empty())
+      Log::Fatal << "it is impossible to calculate median; no valid elements "
+          << "in the dimension" << std::endl;
+
+    // Calculate the median by selection, instead of sorting all the elements.
+    // If there is an even number of elements, the median is the average of the
+    // two middle ones; after the selection, the lower one is the largest of the
+    // elements before the upper one.
+    const size_t middle = elemsToKeep.size() / 2;
+    std::nth_element(elemsToKeep.begin(), elemsToKeep.begin() + middle,
+        elemsToKeep.end());
+    double median = elemsToKeep[middle];
+    if (elemsToKeep.size() % 2 == 0)
+    {
+      median = (median + *std::max_element(elemsToKeep.begin(),
+          elemsToKeep.begin() + middle)) / 2.0;
+    }
 
     for (const PairType& target : targets)
     {
@@ -87,6 +104,13 @@ class MedianImputation
   }
 }; // class MedianImputation
 
+//! Each dimension is imputed independently.
+template<typename T>
+struct ImputationTraits<MedianImputation<T>>
+{
+  static const bool independentDimensions = true;
+};
+
 } // namespace data
 } // namespace mlpack
 
@@ -17,6 +17,7 @@
 #include "dataset_mapper.hpp"
 #include "map_policies/missing_policy.hpp"
 #include "map_policies/increment_policy.hpp"
+#include "imputation_methods/imputation_traits.hpp"
 
 namespace mlpack {
 namespace data {
@@ -65,6 +66,79 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of every dimension that
+  * `missingValue` is mapped in with given imputation strategy. This function
+  * does not produce output matrix, but overwrites the result into the input
+  * matrix.
+  *
+  * If the strategy imputes each dimension independently (see
+  * ImputationTraits), the dimensions are imputed in parallel.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  */
+  void Impute(arma::Mat<T>& input, const std::string& missingValue)
+  {
+    // Find the dimensions that missingValue is mapped in, and what it is mapped
+    // to.
+    std::vector<std::pair<size_t, T>> targets;
+    for (size_t dimension = 0; dimension < mapper.Dimensionality(); ++dimension)
+    {
+      if (mapper.NumMappings(dimension) == 0)
+        continue;
+
+      try
+      {
+        targets.emplace_back(dimension,
+            static_cast<T>(mapper.UnmapValue(missingValue, dimension)));
+      }
+      catch (const std::invalid_argument&)
+      {
+        // The dimension has other mappings, but not missingValue.
+      }
+    }
+
+    if (!ImputationTraits<StrategyType>::independentDimensions)
+    {
+      for (const std::pair<size_t, T>& target : targets)
+        strategy.Impute(input, target.second, target.first, columnMajor);
+
+      return;
+    }
+
+    // Exceptions can't leave the parallel region, so the first error (in order
+    // of dimension) is thrown after it.
+    std::vector<std::string> errors(targets.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+      try
+      {
+        strategy.Impute(input, targets[i].second, targets[i].first,
+            columnMajor);
+      }
+      catch (const std::exception& e)
+      {
+        errors[i] = e.what();
+        if (errors[i].empty())
+          errors[i] = "imputation failed";
+      }
+    }
+
+    for (size_t i = 0; i < errors.size(); ++i)
+    {
+      if (!errors[i].empty())
+      {
+        std::ostringstream oss;
+        oss << "Imputer::Impute(): cannot impute dimension "
+            << targets[i].first << ": " << errors[i];
+        throw std::runtime_error(oss.str());
+      }
+    }
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
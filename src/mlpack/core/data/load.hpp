@@ -17,13 +17,17 @@
 #include <mlpack/prereqs.hpp>
 #include <string>
 
+#include "compressed_file.hpp"
 #include "format.hpp"
 #include "dataset_mapper.hpp"
 #include "detect_file_type.hpp"
 #include "image_info.hpp"
 #include "load_csv.hpp"
 #include "load_arff.hpp"
+#include "load_arrow.hpp"
+#include "load_libsvm.hpp"
 #include "load_image.hpp"
+#include "model_file.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices and models. */ {
@@ -44,6 +48,9 @@ namespace data /** Functions to load and save matrices and models. */ {
  *  - Raw binary (arma::raw_binary), denoted by .bin
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf, .hdf5, .h5, or .he5
+ *  - Arrow IPC (Feather v2), denoted by .arrow, .feather, or .ipc, and
+ *    Parquet, denoted by .parquet, if mlpack was compiled with Arrow support
+ *    (see LoadArrow())
  *
  * By default, this function will try to automatically determine the type of
  * file to load based on its extension and by inspecting the file.  If you know
@@ -51,6 +58,10 @@ namespace data /** Functions to load and save matrices and models. */ {
  * `inputLoadType` parameter with the correct type above (e.g.
  * `arma::csv_ascii`.)
  *
+ * Files compressed with gzip (.gz) or zstd (.zst) are decompressed
+ * transparently, if mlpack was compiled with zlib or zstd support; the type of
+ * the data is then given by the rest of the name (e.g. "data.csv.gz").
+ *
  * If the detected file type is CSV (`arma::csv_ascii`), the first row will be
  * checked for a CSV header.  If a CSV header is not detected, the first row
  * will be treated as data; otherwise, the first row will be skipped.
@@ -89,6 +100,12 @@ bool Load(const std::string& filename,
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
  *
+ * libsvm files (denoted by .svm, .libsvm, or .svmlight) are loaded with
+ * LoadLibSVM(), and the labels become the last row of the matrix.
+ *
+ * ARFF files (denoted by .arff) of numeric features, dense or sparse, can also
+ * be loaded; they are parsed by LoadARFF() directly into the sparse matrix.
+ *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
  * filetype as raw_binary, which can have very confusing effects.
@@ -23,6 +23,10 @@ namespace data {
  * A utility function to load an ARFF dataset as numeric features (that is, as
  * an Armadillo matrix without any modification).  An exception will be thrown
  * if any features are non-numeric.
+ *
+ * The file is parsed in a single pass.  Data lines may be dense
+ * (comma-separated values) or sparse (`{index value, ...}` with zero-based
+ * indices; all other values are zero), and both can be mixed in one file.
  */
 template<typename eT>
 void LoadARFF(const std::string& filename, arma::Mat<eT>& matrix);
@@ -54,6 +58,31 @@ void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
               DatasetMapper<PolicyType>& info);
 
+/**
+ * Load an ARFF dataset of numeric features into a sparse matrix.  This is
+ * meant for sparse ARFF files (with lines like `{index value, ...}`): only the
+ * nonzero values are stored, so the dense matrix is never built.  An exception
+ * will be thrown if any features are non-numeric.
+ */
+template<typename eT>
+void LoadARFF(const std::string& filename, arma::SpMat<eT>& matrix);
+
+/**
+ * Load an ARFF dataset of numeric and categorical features into a sparse
+ * matrix, using the DatasetInfo structure for mapping, as the overload for
+ * dense matrices does.  Categorical values that are not given in a sparse row
+ * are zero, which is the first category of the dimension.
+ *
+ * @param filename Name of ARFF file to load.
+ * @param matrix Sparse matrix to load data into.
+ * @param info DatasetInfo object; can be default-constructed or pre-existing
+ *     from another call to LoadARFF().
+ */
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::SpMat<eT>& matrix,
+              DatasetMapper<PolicyType>& info);
+
 } // namespace data
 } // namespace mlpack
 
@@ -14,43 +14,105 @@
 
 // In case it hasn't been included yet.
 #include "load_arff.hpp"
+#include "compressed_file.hpp"
+#include "load_csv.hpp"
 #include "string_algorithms.hpp"
-#include "is_naninf.hpp"
+
+#include <charconv>
 
 namespace mlpack {
 namespace data {
+namespace details {
 
-template<typename eT, typename PolicyType>
-void LoadARFF(const std::string& filename,
-              arma::Mat<eT>& matrix,
-              DatasetMapper<PolicyType>& info)
+//! Return whether the given character is whitespace in an ARFF file.
+inline bool IsARFFSpace(const char c)
 {
-  // First, open the file.
-  std::ifstream ifs;
-  ifs.open(filename, std::ios::in | std::ios::binary);
+  return (c == ' ' || c == '\t' || c == '\r');
+}
 
-  // if file is not open throw an error (file not found).
-  if (!ifs.is_open())
+/**
+ * Strip whitespace from either side of the token [begin, end), and then the
+ * quotes around it, if it is quoted.
+ */
+inline void TrimARFFToken(const char*& begin, const char*& end)
+{
+  while (begin != end && IsARFFSpace(*begin))
+    ++begin;
+  while (end != begin && IsARFFSpace(*(end - 1)))
+    --end;
+
+  if (end - begin >= 2 && (*begin == '"' || *begin == '\'') &&
+      *(end - 1) == *begin)
+  {
+    ++begin;
+    --end;
+  }
+}
+
+/**
+ * Return the end of the token of a data line that starts at p: the first ','
+ * (or '}', in a sparse row) that is not quoted, or the '%' of a comment, or the
+ * end of the line.  Quotes are only recognized at the start of a value.
+ */
+inline const char* ARFFTokenEnd(const char* p,
+                                const char* end,
+                                const bool sparse)
+{
+  while (p != end && IsARFFSpace(*p))
+    ++p;
+
+  // In a sparse row, the value comes after its index.
+  if (sparse)
   {
-    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    while (p != end && !IsARFFSpace(*p) && *p != ',' && *p != '}')
+      ++p;
+    while (p != end && IsARFFSpace(*p))
+      ++p;
   }
 
+  if (p != end && (*p == '"' || *p == '\''))
+  {
+    const char quote = *p++;
+    while (p != end && *p != quote)
+    {
+      if (*p == '\\' && p + 1 != end)
+        ++p;
+      ++p;
+    }
+
+    if (p != end)
+      ++p;
+  }
+
+  while (p != end && *p != ',' && *p != '%' && !(sparse && *p == '}'))
+    ++p;
+
+  return p;
+}
+
+/**
+ * Parse the header of an ARFF file, up to and including the @data line, and
+ * set up the given DatasetMapper.  Returns the dimensionality of the data.
+ */
+template<typename eT, typename PolicyType>
+size_t LoadARFFHeader(
+    std::istream& ifs,
+    DatasetMapper<PolicyType>& info,
+    std::map<size_t, std::vector<std::string>>& categoryStrings,
+    size_t& lineNumber)
+{
   std::string line;
   size_t dimensionality = 0;
-  // We'll store a vector of strings representing categories to be mapped, if
-  // needed.
-  std::map<size_t, std::vector<std::string>> categoryStrings;
   std::vector<bool> types;
-  size_t headerLines = 0;
-  while (ifs.good())
+  bool foundData = false;
+  while (std::getline(ifs, line, '\n'))
   {
-    // Read the next line, then strip whitespace from either side.
-    std::getline(ifs, line, '\n');
+    // Strip whitespace from either side of the line.
     Trim(line);
-    ++headerLines;
+    ++lineNumber;
 
     // Is the first character a comment, or is the line empty?
-    if (line[0] == '%' || line.empty())
+    if (line.empty() || line[0] == '%')
       continue; // Ignore this line.
 
     // If the first character is @, we are looking at @relation, @attribute, or
@@ -80,7 +142,6 @@ void LoadARFF(const std::string& filename,
         std::string dimType = "";
         while (it != tok.end())
           dimType += *(it++);
-        std::string origDimType(dimType); // We may need the original cases.
         std::transform(dimType.begin(), dimType.end(), dimType.begin(),
             ::tolower);
 
@@ -96,26 +157,29 @@ void LoadARFF(const std::string& filename,
         {
           // The feature is categorical, and we have all the types right here.
           // Note that categories are case-sensitive, and so we must use the
-          // `origDimType` string here instead (which has not had ::tolower used
-          // on it).
+          // original line here (which has not had ::tolower used on it, and
+          // still has the spaces inside quoted categories).
           types.push_back(true);
-          TrimIf(origDimType,
-              [](char c)
-              {
-                return c == '{' || c == '}' || c == ' ' || c == '\t';
-              });
-
-          std::vector<std::string> dimTok = Tokenize(origDimType, ',', '"');
-          std::vector<std::string>::iterator it = dimTok.begin();
+          const size_t open = line.find('{');
+          const size_t close = line.rfind('}');
+          const char* p = line.data() + open + 1;
+          const char* end = line.data() +
+              ((close != std::string::npos && close > open) ? close :
+              line.size());
+
+          // Categories are stored without quotes, as they are in the data.
           std::vector<std::string> categories;
-
-          while (it != dimTok.end())
+          while (true)
           {
-            std::string category = (*it);
-            Trim(category);
-            categories.push_back(category);
-
-            ++it;
+            const char* categoryEnd = ARFFTokenEnd(p, end, false);
+            const char* begin = p;
+            const char* tokenEnd = categoryEnd;
+            TrimARFFToken(begin, tokenEnd);
+            categories.push_back(std::string(begin, tokenEnd));
+
+            if (categoryEnd == end || *categoryEnd != ',')
+              break;
+            p = categoryEnd + 1;
           }
 
           categoryStrings[dimensionality - 1] = std::move(categories);
@@ -124,6 +188,7 @@ void LoadARFF(const std::string& filename,
       else if (annotation == "@data")
       {
         // We are in the data section.  So we can move out of this loop.
+        foundData = true;
         break;
       }
       else
@@ -134,7 +199,7 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  if (ifs.eof())
+  if (!foundData)
     throw std::runtime_error("no @data section found");
 
   // Reset the DatasetInfo object, if needed.
@@ -160,133 +225,318 @@ void LoadARFF(const std::string& filename,
   }
 
   // Make sure all strings are mapped, if we have any.
-  typedef std::map<size_t, std::vector<std::string>>::const_iterator
-      IteratorType;
-  for (IteratorType it = categoryStrings.begin(); it != categoryStrings.end();
-      ++it)
+  for (const auto& dimCategories : categoryStrings)
   {
-    for (const std::string& str : (*it).second)
+    for (const std::string& str : dimCategories.second)
+      info.template MapString<eT>(str, dimCategories.first);
+  }
+
+  return dimensionality;
+}
+
+/**
+ * Convert the token [begin, end) of a data line to a value for dimension col:
+ * categorical values are mapped with the DatasetMapper, and numeric values are
+ * parsed.  An exception is thrown if the token does not match its type.
+ */
+template<typename eT, typename PolicyType>
+eT ConvertARFFToken(
+    const char* begin,
+    const char* end,
+    const size_t col,
+    const size_t lineNumber,
+    DatasetMapper<PolicyType>& info,
+    const std::map<size_t, std::vector<std::string>>& categoryStrings)
+{
+  TrimARFFToken(begin, end);
+
+  if (info.Type(col) == Datatype::categorical)
+  {
+    const std::string token(begin, end);
+    const size_t currentNumMappings = info.NumMappings(col);
+    const eT result = info.template MapString<eT>(token, col);
+
+    // If the set of categories was pre-specified, then we must crash if this
+    // was not one of those categories.
+    if (categoryStrings.count(col) > 0 &&
+        currentNumMappings < info.NumMappings(col))
     {
-      info.template MapString<eT>(str, (*it).first);
+      std::stringstream error;
+      error << "Parse error at line " << lineNumber << " token " << col
+          << ": category \"" << token << "\" not in the set of known "
+          << "categories for this dimension (";
+      for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
+        error << "\"" << categoryStrings.at(col)[i] << "\", ";
+      error << "\"" << categoryStrings.at(col).back() << "\").";
+      throw std::runtime_error(error.str());
     }
+
+    return result;
+  }
+
+  // The '?' representing a missing value is not allowed, so it gets its own
+  // error.
+  eT val = eT(0);
+  if (begin == end || !LoadCSV::ConvertToken<eT>(val, begin, end))
+  {
+    std::stringstream error;
+    const std::string token(begin, end);
+    if (token == "?")
+      error << "Missing values ('?') not supported, ";
+    else
+      error << "Parse error ";
+    error << "at line " << lineNumber << " token " << col << ": \"" << token
+        << "\".";
+    throw std::runtime_error(error.str());
+  }
+
+  return val;
+}
+
+/**
+ * Collects the points of an ARFF file for a dense matrix.
+ */
+template<typename eT>
+struct DenseARFFOutput
+{
+  DenseARFFOutput() : dimensionality(0), points(0) { }
+
+  //! Start a new point, with all values zero.
+  void NewPoint(const size_t dims)
+  {
+    dimensionality = dims;
+    values.resize(values.size() + dimensionality, eT(0));
+    ++points;
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
-  while (ifs.good())
+  //! Set the given dimension of the current point.
+  void Set(const size_t dim, const eT value)
   {
-    std::getline(ifs, line, '\n');
-    ++row;
+    values[(points - 1) * dimensionality + dim] = value;
   }
-  // Uncount the EOF row.
-  --row;
 
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+  size_t dimensionality;
+  size_t points;
+  std::vector<eT> values;
+};
 
-  // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
+/**
+ * Collects the nonzero values of an ARFF file for a sparse matrix.
+ */
+template<typename eT>
+struct SparseARFFOutput
+{
+  SparseARFFOutput() : points(0) { }
 
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  //! Start a new point, with all values zero.
+  void NewPoint(const size_t /* dims */) { ++points; }
+
+  //! Set the given dimension of the current point.
+  void Set(const size_t dim, const eT value)
   {
-    std::getline(ifs, line, '\n');
-    Trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    std::vector<std::string> tok = Tokenize(line, ',', '"');
-
-    size_t col = 0;
-    std::stringstream token;
-    for (std::vector<std::string>::iterator it = tok.begin(); it != tok.end(); ++it)
+    if (value == eT(0))
+      return;
+
+    locations.push_back(dim);
+    locations.push_back(points - 1);
+    values.push_back(value);
+  }
+
+  size_t points;
+  //! Locations of the nonzero values, as (row, column) pairs.
+  std::vector<arma::uword> locations;
+  std::vector<eT> values;
+};
+
+/**
+ * Load the ARFF file with the given name in a single pass, giving each point to
+ * the output as it is parsed.  Both dense rows (comma-separated values) and
+ * sparse rows ("{index value, ...}", with zero-based indices) are supported.
+ */
+template<typename eT, typename PolicyType, typename OutputType>
+void LoadARFF(const std::string& filename,
+              DatasetMapper<PolicyType>& info,
+              OutputType& output)
+{
+  // First, open the file (and decompress it, if it is compressed).
+  InputFile file(filename, std::ios::in | std::ios::binary);
+  std::istream& ifs = file.Stream();
+
+  // if file is not open throw an error (file not found).
+  if (!file.IsOpen())
+  {
+    Log::Fatal << "Cannot open file '" << filename << "'. " << file.Error()
+        << std::endl;
+  }
+
+  std::map<size_t, std::vector<std::string>> categoryStrings;
+  size_t lineNumber = 0;
+  const size_t dimensionality = LoadARFFHeader<eT>(ifs, info, categoryStrings,
+      lineNumber);
+
+  // Now we are looking at the @data section.  Each line is a point; we throw
+  // an exception if any piece of data does not match its type (categorical or
+  // numeric).
+  std::string line;
+  while (std::getline(ifs, line, '\n'))
+  {
+    ++lineNumber;
+    const char* p = line.data();
+    const char* end = p + line.size();
+    while (p != end && IsARFFSpace(*p))
+      ++p;
+
+    // Skip empty lines and comments.
+    if (p == end || *p == '%')
+      continue;
+
+    output.NewPoint(dimensionality);
+    if (*p == '{')
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
+      // This is a sparse row: a list of "index value" pairs, and all other
+      // values are zero.
+      ++p;
+      while (p != end && IsARFFSpace(*p))
+        ++p;
+
+      bool closed = (p != end && *p == '}');
+      while (!closed)
       {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
+        const char* tokenEnd = ARFFTokenEnd(p, end, true);
+
+        while (p != tokenEnd && IsARFFSpace(*p))
+          ++p;
+        size_t index = 0;
+        const std::from_chars_result result = std::from_chars(p, tokenEnd,
+            index);
+        if (result.ec != std::errc() || index >= dimensionality)
+        {
+          std::stringstream error;
+          error << "Parse error at line " << lineNumber << ": invalid index \""
+              << std::string(p, result.ptr) << "\" (the data has "
+              << dimensionality << " dimensions).";
+          throw std::runtime_error(error.str());
+        }
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
-      {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        Trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
+        output.Set(index, ConvertARFFToken<eT>(result.ptr, tokenEnd, index,
+            lineNumber, info, categoryStrings));
+
+        if (tokenEnd == end || *tokenEnd == '%')
         {
           std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
+          error << "Parse error at line " << lineNumber << ": sparse row has "
+              << "no closing '}'.";
           throw std::runtime_error(error.str());
         }
 
-        // We load transposed.
-        matrix(col, row) = result;
+        closed = (*tokenEnd == '}');
+        p = tokenEnd + 1;
       }
-      else if (info.Type(col) == Datatype::numeric)
+    }
+    else
+    {
+      size_t col = 0;
+      while (true)
       {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
-
-        eT val = eT(0);
-        token >> val;
-
-        if (token.fail())
+        // Check that we are not too many columns in.
+        if (col >= dimensionality)
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
-          {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            Trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
-          }
+          std::stringstream error;
+          error << "Too many columns in line " << lineNumber << ".";
+          throw std::runtime_error(error.str());
         }
 
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
+        const char* tokenEnd = ARFFTokenEnd(p, end, false);
+        output.Set(col, ConvertARFFToken<eT>(p, tokenEnd, col, lineNumber,
+            info, categoryStrings));
+        ++col;
+
+        if (tokenEnd == end || *tokenEnd != ',')
+          break;
+        p = tokenEnd + 1;
       }
 
-      ++col;
+      if (col < dimensionality)
+      {
+        std::stringstream error;
+        error << "Too few columns in line " << lineNumber << " (" << col
+            << " instead of " << dimensionality << ").";
+        throw std::runtime_error(error.str());
+      }
     }
-    ++row;
   }
 }
 
+} // namespace details
+
+template<typename eT>
+void LoadARFF(const std::string& filename, arma::Mat<eT>& matrix)
+{
+  DatasetInfo info;
+  LoadARFF(filename, matrix, info);
+
+  for (size_t i = 0; i < info.Dimensionality(); ++i)
+  {
+    if (info.Type(i) != Datatype::numeric)
+    {
+      std::ostringstream oss;
+      oss << "data::LoadARFF(): dimension " << i << " of '" << filename
+          << "' is not numeric; use a DatasetInfo to load categorical data";
+      throw std::runtime_error(oss.str());
+    }
+  }
+}
+
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::Mat<eT>& matrix,
+              DatasetMapper<PolicyType>& info)
+{
+  details::DenseARFFOutput<eT> output;
+  details::LoadARFF<eT>(filename, info, output);
+
+  // The data is stored point by point, so it is already transposed.
+  matrix.set_size(info.Dimensionality(), output.points);
+  if (!output.values.empty())
+    std::copy(output.values.begin(), output.values.end(), matrix.memptr());
+}
+
+template<typename eT>
+void LoadARFF(const std::string& filename, arma::SpMat<eT>& matrix)
+{
+  DatasetInfo info;
+  LoadARFF(filename, matrix, info);
+
+  for (size_t i = 0; i < info.Dimensionality(); ++i)
+  {
+    if (info.Type(i) != Datatype::numeric)
+    {
+      std::ostringstream oss;
+      oss << "data::LoadARFF(): dimension " << i << " of '" << filename
+          << "' is not numeric; use a DatasetInfo to load categorical data";
+      throw std::runtime_error(oss.str());
+    }
+  }
+}
+
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::SpMat<eT>& matrix,
+              DatasetMapper<PolicyType>& info)
+{
+  details::SparseARFFOutput<eT> output;
+  details::LoadARFF<eT>(filename, info, output);
+
+  // Build the matrix from the nonzero values all at once.  Values of a sparse
+  // row may be given in any order, so the locations have to be sorted.
+  const size_t nonzeros = output.values.size();
+  const arma::umat locations(output.locations.data(), 2, nonzeros, false,
+      true);
+  const arma::Col<eT> values(output.values.data(), nonzeros, false, true);
+  matrix = arma::SpMat<eT>(locations, values, info.Dimensionality(),
+      output.points, true, false);
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -0,0 +1,99 @@
+/**
+ * @file core/data/load_arrow.hpp
+ *
+ * Load a table in the Apache Arrow IPC (Feather v2) or Parquet format into a
+ * matrix, via the Apache Arrow library.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_ARROW_HPP
+#define MLPACK_CORE_DATA_LOAD_ARROW_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "dataset_mapper.hpp"
+#include "detect_file_type.hpp"
+#include "types.hpp"
+
+#ifdef MLPACK_HAS_ARROW
+  #include <arrow/api.h>
+  #include <arrow/io/file.h>
+  #include <arrow/ipc/reader.h>
+  #include <parquet/arrow/reader.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load an Arrow IPC (Feather v2) or Parquet file into the given matrix.  Each
+ * column of the table is a dimension and each row is a point, so with
+ * `transpose` set to true (the default) each row of the table becomes a column
+ * of the matrix, as for CSV files.
+ *
+ * Numeric and boolean columns are converted to the element type of the matrix;
+ * null values are loaded as NaN (or 0 for integer matrices).  String columns
+ * are mapped with the given DatasetMapper, like the strings of a CSV file, and
+ * dictionary-encoded string columns are categorical, with their dictionary
+ * entries mapped in order.
+ *
+ * If `columns` is not empty, only the columns with the given names are loaded,
+ * in the given order.  For Parquet files, the other columns are not even read;
+ * Arrow IPC files are memory-mapped, so the other columns are not read either
+ * unless the file is compressed.
+ *
+ * This requires mlpack to be configured with Arrow support (MLPACK_HAS_ARROW,
+ * and linking against the Arrow and Parquet libraries).
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load the table into.
+ * @param info DatasetMapper to map the string columns with.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, each row of the table is a column of the matrix.
+ * @param columns Names of the columns to load (default: all of them).
+ * @param type FileType::ArrowIPC, FileType::Parquet, or FileType::AutoDetect to
+ *     detect the type with the extension of the file.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename PolicyType>
+bool LoadArrow(const std::string& filename,
+               arma::Mat<eT>& matrix,
+               DatasetMapper<PolicyType>& info,
+               const bool fatal = false,
+               const bool transpose = true,
+               const std::vector<std::string>& columns =
+                   std::vector<std::string>(),
+               const FileType type = FileType::AutoDetect);
+
+/**
+ * Load an Arrow IPC (Feather v2) or Parquet file into the given matrix, like
+ * the overload above, but without keeping the mappings of the string columns.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load the table into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, each row of the table is a column of the matrix.
+ * @param columns Names of the columns to load (default: all of them).
+ * @param type FileType::ArrowIPC, FileType::Parquet, or FileType::AutoDetect to
+ *     detect the type with the extension of the file.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadArrow(const std::string& filename,
+               arma::Mat<eT>& matrix,
+               const bool fatal = false,
+               const bool transpose = true,
+               const std::vector<std::string>& columns =
+                   std::vector<std::string>(),
+               const FileType type = FileType::AutoDetect);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_arrow_impl.hpp"
+
+#endif
@@ -0,0 +1,473 @@
+/**
+ * @file core/data/load_arrow_impl.hpp
+ *
+ * Implementation of LoadArrow().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_ARROW_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_ARROW_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load_arrow.hpp"
+
+namespace mlpack {
+namespace data {
+
+#ifdef MLPACK_HAS_ARROW
+
+namespace details {
+
+/**
+ * Throw a std::runtime_error with the given message if the given Arrow status
+ * is not OK.
+ */
+inline void CheckArrowStatus(const arrow::Status& status,
+                             const std::string& message)
+{
+  if (!status.ok())
+    throw std::runtime_error(message + ": " + status.ToString());
+}
+
+/**
+ * Return the indices of the columns with the given names in the schema, or of
+ * all columns if no names are given.
+ */
+inline std::vector<int> ArrowColumnIndices(
+    const arrow::Schema& schema,
+    const std::vector<std::string>& columns,
+    const std::string& filename)
+{
+  std::vector<int> indices;
+  if (columns.empty())
+  {
+    for (int i = 0; i < schema.num_fields(); ++i)
+      indices.push_back(i);
+    return indices;
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i)
+  {
+    const int index = schema.GetFieldIndex(columns[i]);
+    if (index < 0)
+    {
+      std::ostringstream oss;
+      oss << "no column named '" << columns[i] << "' in '" << filename << "'";
+      throw std::invalid_argument(oss.str());
+    }
+    indices.push_back(index);
+  }
+
+  return indices;
+}
+
+/**
+ * Read the given columns of an Arrow IPC or Parquet file into a table.
+ */
+inline std::shared_ptr<arrow::Table> ReadArrowTable(
+    const std::string& filename,
+    const std::vector<std::string>& columns,
+    const FileType type)
+{
+  const std::string error = "cannot read '" + filename + "'";
+
+  // The record batches of an uncompressed IPC file point into the mapped file,
+  // so loading a few columns only touches the pages of those columns.
+  arrow::Result<std::shared_ptr<arrow::io::MemoryMappedFile>> file =
+      arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+  CheckArrowStatus(file.status(), error);
+
+  std::shared_ptr<arrow::Table> table;
+  if (type == FileType::ArrowIPC)
+  {
+    arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchFileReader>> reader =
+        arrow::ipc::RecordBatchFileReader::Open(*file);
+    CheckArrowStatus(reader.status(), error);
+
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int i = 0; i < (*reader)->num_record_batches(); ++i)
+    {
+      arrow::Result<std::shared_ptr<arrow::RecordBatch>> batch =
+          (*reader)->ReadRecordBatch(i);
+      CheckArrowStatus(batch.status(), error);
+      batches.push_back(*batch);
+    }
+
+    arrow::Result<std::shared_ptr<arrow::Table>> result =
+        arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+    CheckArrowStatus(result.status(), error);
+    table = *result;
+  }
+  else
+  {
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    CheckArrowStatus(parquet::arrow::OpenFile(*file,
+        arrow::default_memory_pool(), &reader), error);
+
+    // Only read the column chunks that are needed.
+    std::shared_ptr<arrow::Schema> schema;
+    CheckArrowStatus(reader->GetSchema(&schema), error);
+    CheckArrowStatus(reader->ReadTable(ArrowColumnIndices(*schema, columns,
+        filename), &table), error);
+  }
+
+  // Put the columns in the requested order.
+  if (!columns.empty())
+  {
+    arrow::Result<std::shared_ptr<arrow::Table>> result = table->SelectColumns(
+        ArrowColumnIndices(*table->schema(), columns, filename));
+    CheckArrowStatus(result.status(), error);
+    table = *result;
+  }
+
+  return table;
+}
+
+//! Return whether the column holds (possibly dictionary-encoded) strings.
+inline bool IsArrowStringColumn(const arrow::DataType& type)
+{
+  if (type.id() == arrow::Type::DICTIONARY)
+  {
+    return static_cast<const arrow::DictionaryType&>(type).value_type()->id()
+        == arrow::Type::STRING;
+  }
+
+  return (type.id() == arrow::Type::STRING);
+}
+
+//! Return whether the column can be converted to numbers directly.
+inline bool IsArrowNumericColumn(const arrow::DataType& type)
+{
+  switch (type.id())
+  {
+    case arrow::Type::BOOL:
+    case arrow::Type::INT8:
+    case arrow::Type::INT16:
+    case arrow::Type::INT32:
+    case arrow::Type::INT64:
+    case arrow::Type::UINT8:
+    case arrow::Type::UINT16:
+    case arrow::Type::UINT32:
+    case arrow::Type::UINT64:
+    case arrow::Type::FLOAT:
+    case arrow::Type::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Convert a chunk of a numeric column, starting at the given point.  out points
+ * at the element of the first point of the chunk; the elements of consecutive
+ * points are stride apart.
+ */
+template<typename ArrowType, typename eT>
+void CopyArrowChunk(const arrow::Array& chunk, eT* out, const size_t stride)
+{
+  const arrow::NumericArray<ArrowType>& values =
+      static_cast<const arrow::NumericArray<ArrowType>&>(chunk);
+  const typename ArrowType::c_type* data = values.raw_values();
+
+  // quiet_NaN() is 0 for integer types.
+  const bool hasNulls = (values.null_count() > 0);
+  for (int64_t i = 0; i < values.length(); ++i)
+  {
+    out[i * stride] = (hasNulls && values.IsNull(i)) ?
+        std::numeric_limits<eT>::quiet_NaN() : eT(data[i]);
+  }
+}
+
+/**
+ * Convert a numeric column into the given dimension of the matrix.
+ */
+template<typename eT>
+void CopyArrowColumn(const arrow::ChunkedArray& column,
+                     arma::Mat<eT>& matrix,
+                     const size_t dimension,
+                     const bool transpose)
+{
+  // Without transposition, each column of the table is contiguous in the
+  // matrix.
+  eT* out = transpose ? matrix.colptr(0) + dimension : matrix.colptr(dimension);
+  const size_t stride = transpose ? matrix.n_rows : 1;
+
+  for (int c = 0; c < column.num_chunks(); ++c)
+  {
+    const arrow::Array& chunk = *column.chunk(c);
+    switch (chunk.type_id())
+    {
+      case arrow::Type::BOOL:
+      {
+        const arrow::BooleanArray& values =
+            static_cast<const arrow::BooleanArray&>(chunk);
+        for (int64_t i = 0; i < values.length(); ++i)
+        {
+          out[i * stride] = values.IsNull(i) ?
+              std::numeric_limits<eT>::quiet_NaN() : eT(values.Value(i));
+        }
+        break;
+      }
+      case arrow::Type::INT8:
+        CopyArrowChunk<arrow::Int8Type>(chunk, out, stride);
+        break;
+      case arrow::Type::INT16:
+        CopyArrowChunk<arrow::Int16Type>(chunk, out, stride);
+        break;
+      case arrow::Type::INT32:
+        CopyArrowChunk<arrow::Int32Type>(chunk, out, stride);
+        break;
+      case arrow::Type::INT64:
+        CopyArrowChunk<arrow::Int64Type>(chunk, out, stride);
+        break;
+      case arrow::Type::UINT8:
+        CopyArrowChunk<arrow::UInt8Type>(chunk, out, stride);
+        break;
+      case arrow::Type::UINT16:
+        CopyArrowChunk<arrow::UInt16Type>(chunk, out, stride);
+        break;
+      case arrow::Type::UINT32:
+        CopyArrowChunk<arrow::UInt32Type>(chunk, out, stride);
+        break;
+      case arrow::Type::UINT64:
+        CopyArrowChunk<arrow::UInt64Type>(chunk, out, stride);
+        break;
+      case arrow::Type::FLOAT:
+        CopyArrowChunk<arrow::FloatType>(chunk, out, stride);
+        break;
+      case arrow::Type::DOUBLE:
+        CopyArrowChunk<arrow::DoubleType>(chunk, out, stride);
+        break;
+      default:
+        // The types of the columns are checked before conversion.
+        break;
+    }
+
+    out += chunk.length() * stride;
+  }
+}
+
+/**
+ * Map a string column into the given dimension of the matrix with the given
+ * DatasetMapper.
+ */
+template<typename eT, typename PolicyType>
+void MapArrowColumn(const arrow::ChunkedArray& column,
+                    arma::Mat<eT>& matrix,
+                    DatasetMapper<PolicyType>& info,
+                    const size_t dimension,
+                    const bool transpose)
+{
+  eT* out = transpose ? matrix.colptr(0) + dimension : matrix.colptr(dimension);
+  const size_t stride = transpose ? matrix.n_rows : 1;
+
+  if (column.type()->id() == arrow::Type::DICTIONARY)
+  {
+    // A dictionary-encoded column is categorical, and its categories are the
+    // entries of its dictionary.  Each chunk may have its own dictionary; the
+    // DatasetMapper keeps the mappings of identical strings identical.
+    info.Type(dimension) = Datatype::categorical;
+    for (int c = 0; c < column.num_chunks(); ++c)
+    {
+      const arrow::DictionaryArray& values =
+          static_cast<const arrow::DictionaryArray&>(*column.chunk(c));
+      const arrow::StringArray& dictionary =
+          static_cast<const arrow::StringArray&>(*values.dictionary());
+
+      std::vector<eT> mappings(dictionary.length());
+      for (int64_t k = 0; k < dictionary.length(); ++k)
+      {
+        mappings[k] = info.template MapString<eT>(dictionary.GetString(k),
+            dimension);
+      }
+
+      for (int64_t i = 0; i < values.length(); ++i)
+      {
+        out[i * stride] = values.IsNull(i) ?
+            std::numeric_limits<eT>::quiet_NaN() :
+            mappings[values.GetValueIndex(i)];
+      }
+
+      out += values.length() * stride;
+    }
+
+    return;
+  }
+
+  // Plain strings are mapped like the tokens of a CSV file, including the
+  // first pass of the policy.
+  if (PolicyType::NeedsFirstPass)
+  {
+    for (int c = 0; c < column.num_chunks(); ++c)
+    {
+      const arrow::StringArray& values =
+          static_cast<const arrow::StringArray&>(*column.chunk(c));
+      for (int64_t i = 0; i < values.length(); ++i)
+      {
+        if (!values.IsNull(i))
+          info.template MapFirstPass<eT>(values.GetString(i), dimension);
+      }
+    }
+  }
+
+  for (int c = 0; c < column.num_chunks(); ++c)
+  {
+    const arrow::StringArray& values =
+        static_cast<const arrow::StringArray&>(*column.chunk(c));
+    for (int64_t i = 0; i < values.length(); ++i)
+    {
+      out[i * stride] = values.IsNull(i) ?
+          std::numeric_limits<eT>::quiet_NaN() :
+          info.template MapString<eT>(values.GetString(i), dimension);
+    }
+
+    out += values.length() * stride;
+  }
+}
+
+/**
+ * Load the table, throwing an exception on any error.
+ */
+template<typename eT, typename PolicyType>
+void LoadArrowTable(const std::string& filename,
+                    arma::Mat<eT>& matrix,
+                    DatasetMapper<PolicyType>& info,
+                    const bool transpose,
+                    const std::vector<std::string>& columns,
+                    const FileType inputType)
+{
+  const FileType type = (inputType == FileType::AutoDetect) ?
+      DetectFromExtension(filename) : inputType;
+  if (type != FileType::ArrowIPC && type != FileType::Parquet)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is not an Arrow IPC or Parquet file";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const std::shared_ptr<arrow::Table> table = ReadArrowTable(filename, columns,
+      type);
+  const size_t dimensions = table->num_columns();
+  const size_t points = table->num_rows();
+
+  if (info.Dimensionality() == 0)
+  {
+    info.SetDimensionality(dimensions);
+  }
+  else if (info.Dimensionality() != dimensions)
+  {
+    std::ostringstream oss;
+    oss << "given DatasetInfo has dimensionality " << info.Dimensionality()
+        << ", but data has dimensionality " << dimensions;
+    throw std::invalid_argument(oss.str());
+  }
+
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    const arrow::DataType& columnType = *table->column(d)->type();
+    if (!IsArrowNumericColumn(columnType) && !IsArrowStringColumn(columnType))
+    {
+      std::ostringstream oss;
+      oss << "column '" << table->schema()->field(d)->name() << "' of '"
+          << filename << "' has unsupported type " << columnType.ToString();
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  if (transpose)
+    matrix.set_size(dimensions, points);
+  else
+    matrix.set_size(points, dimensions);
+
+  // The DatasetMapper can't be used by several threads at once, so string
+  // columns are mapped first; then all numeric columns are converted in
+  // parallel.
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    if (IsArrowStringColumn(*table->column(d)->type()))
+      MapArrowColumn(*table->column(d), matrix, info, d, transpose);
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    if (IsArrowNumericColumn(*table->column(d)->type()))
+      CopyArrowColumn(*table->column(d), matrix, d, transpose);
+  }
+}
+
+} // namespace details
+
+template<typename eT, typename PolicyType>
+bool LoadArrow(const std::string& filename,
+               arma::Mat<eT>& matrix,
+               DatasetMapper<PolicyType>& info,
+               const bool fatal,
+               const bool transpose,
+               const std::vector<std::string>& columns,
+               const FileType type)
+{
+  try
+  {
+    details::LoadArrowTable(filename, matrix, info, transpose, columns, type);
+  }
+  catch (std::exception& e)
+  {
+    if (fatal)
+      Log::Fatal << "LoadArrow(): " << e.what() << "." << std::endl;
+    else
+      Log::Warn << "LoadArrow(): " << e.what() << "; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+#else // MLPACK_HAS_ARROW
+
+template<typename eT, typename PolicyType>
+bool LoadArrow(const std::string& /* filename */,
+               arma::Mat<eT>& /* matrix */,
+               DatasetMapper<PolicyType>& /* info */,
+               const bool fatal,
+               const bool /* transpose */,
+               const std::vector<std::string>& /* columns */,
+               const FileType /* type */)
+{
+  if (fatal)
+  {
+    Log::Fatal << "LoadArrow(): mlpack was not compiled with Arrow support, so "
+        << "Arrow IPC and Parquet files cannot be loaded!" << std::endl;
+  }
+  else
+  {
+    Log::Warn << "LoadArrow(): mlpack was not compiled with Arrow support, so "
+        << "Arrow IPC and Parquet files cannot be loaded!" << std::endl;
+  }
+
+  return false;
+}
+
+#endif // MLPACK_HAS_ARROW
+
+template<typename eT>
+bool LoadArrow(const std::string& filename,
+               arma::Mat<eT>& matrix,
+               const bool fatal,
+               const bool transpose,
+               const std::vector<std::string>& columns,
+               const FileType type)
+{
+  DatasetInfo info;
+  return LoadArrow(filename, matrix, info, fatal, transpose, columns, type);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
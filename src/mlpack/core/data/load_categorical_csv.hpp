@@ -24,10 +24,7 @@ void LoadCSV::LoadCategoricalCSV(arma::Mat<eT> &inout,
 {
   CheckOpen();
 
-  if (transpose)
-    TransposeParse(inout, infoSet);
-  else
-    NonTransposeParse(inout, infoSet);
+  CategoricalParse(inout, infoSet, transpose);
 }
 
 inline void LoadCSV::CategoricalMatSize(
@@ -216,131 +213,265 @@ void LoadCSV::InitializeMapper(size_t& rows, size_t& cols, DatasetMapper<MapPoli
   } 
 }
 
-template<typename T, typename PolicyType>
-void LoadCSV::TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet)
+inline void LoadCSV::SplitLine(const char* begin,
+                               const char* end,
+                               const char delim,
+                               std::vector<std::string_view>& tokens)
 {
-  // Get matrix size.  This also initializes infoSet correctly.
-  size_t rows, cols;
-  InitializeTransposeMapper<T>(rows, cols, infoSet);
-
-  // Set the matrix size.
-  inout.set_size(rows, cols);
+  tokens.clear();
 
-  // Initialize auxiliary variables.
-  size_t row = 0;
-  size_t col = 0;
-  std::string line;
-  inFile.clear();
-  inFile.seekg(0, std::ios::beg);
+  // Remove whitespace from either side of the line.
+  while ((begin != end) && std::isspace((unsigned char) *begin))
+    ++begin;
+  while ((end != begin) && std::isspace((unsigned char) *(end - 1)))
+    --end;
 
-  while (std::getline(inFile, line))
+  const char* p = begin;
+  while (true)
   {
-    // Remove whitespaces from either side.
-    Trim(line);
-    // Reset the row we are looking at.  (Remember this is transposed.)
-    row = 0;
-    std::stringstream lineStream;
-    std::string token;
-    lineStream.clear();
-    lineStream.str(line);
-
-    while (lineStream.good())
-    {
-      std::getline(lineStream, token, delim);
-      // Remove whitespaces from either side.
-      Trim(token);
+    const char* tokenEnd = std::find(p, end, delim);
 
-      if (token[0] == '"' && token[token.size() - 1] != '"')
+    // Remove whitespace from either side of the token.
+    const char* tokenBegin = p;
+    const char* last = tokenEnd;
+    while ((tokenBegin != last) && std::isspace((unsigned char) *tokenBegin))
+      ++tokenBegin;
+    while ((last != tokenBegin) && std::isspace((unsigned char) *(last - 1)))
+      --last;
+
+    if ((tokenBegin != last) && (*tokenBegin == '"') && (*(last - 1) != '"'))
+    {
+      // The token is quoted and contains the delimiter, so extend it up to the
+      // next part that ends with a quote.
+      bool closed = false;
+      while (!closed && (tokenEnd != end))
       {
-        // First part of the string.
-        std::string tok = token;
-        while (token[token.size() - 1] != '"')
-        {
-          tok += delim;
-          std::getline(lineStream, token, delim);
-          tok += token;
-        }
-        token = tok;
+        p = tokenEnd + 1;
+        tokenEnd = std::find(p, end, delim);
+        closed = (tokenEnd != p) && (*(tokenEnd - 1) == '"');
       }
-      inout(row, col) = infoSet.template MapString<T>(std::move(token), row);
-      row++;
+      last = tokenEnd;
     }
 
-    // Make sure we got the right number of rows.
-    if (row != rows)
-    {
-      std::ostringstream oss;
-      oss << "LoadCSV::TransposeParse(): wrong number of dimensions (" << row
-          << ") on line " << col << "; should be " << rows << " dimensions.";
-      throw std::runtime_error(oss.str());
-    }
-    // Increment the column index.
-    ++col;
+    tokens.emplace_back(tokenBegin, last - tokenBegin);
+
+    if (tokenEnd == end)
+      break;
+    p = tokenEnd + 1;
   }
 }
 
 template<typename T, typename PolicyType>
-void LoadCSV::NonTransposeParse(arma::Mat<T>& inout,
-                                DatasetMapper<PolicyType>& infoSet)
+void LoadCSV::CategoricalParse(arma::Mat<T>& inout,
+                               DatasetMapper<PolicyType>& infoSet,
+                               const bool transpose)
 {
-  // Get the size of the matrix.
-  size_t rows, cols;
-  InitializeMapper<T>(rows, cols, infoSet);
+  MappedFile file(filename);
+  if (!file.IsOpen())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << file.Error()
+        << std::endl;
+    throw std::runtime_error(oss.str());
+  }
 
-  // Set up output matrix.
-  inout.set_size(rows, cols);
-  size_t row = 0;
-  size_t col = 0;
+  const char* data = file.Data();
+  const char* dataEnd = data + file.Size();
+  const std::vector<const char*> chunkBegin = LineChunks(data, file.Size());
+  const size_t numChunks = chunkBegin.size() - 1;
 
-  // Reset file position.
-  std::string line;
-  inFile.clear();
-  inFile.seekg(0, std::ios::beg);
+  // Count the lines of each chunk; lines with only whitespace are skipped.
+  std::vector<size_t> chunkLines(numChunks, 0);
 
-  while (std::getline(inFile, line))
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
   {
-    // Remove whitespaces from either side.
-    Trim(line);
-
-    std::stringstream lineStream;
-    std::string token;
+    const char* p = chunkBegin[c];
+    const char* end = chunkBegin[c + 1];
+    while (p < end)
+    {
+      const char* newline = (const char*) std::memchr(p, '\n', end - p);
+      const char* lineEnd = (newline == NULL) ? end : newline;
+      if (std::find_if(p, lineEnd, [](const char x)
+          { return !std::isspace((unsigned char) x); }) != lineEnd)
+        ++chunkLines[c];
+      p = (newline == NULL) ? end : newline + 1;
+    }
+  }
 
-    lineStream.clear();
-    lineStream.str(line);
+  std::vector<size_t> chunkRow(numChunks, 0);
+  size_t lines = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkRow[c] = lines;
+    lines += chunkLines[c];
+  }
 
-    while (lineStream.good())
+  // The first line gives the number of tokens that every line must have.
+  std::vector<std::string_view> tokens;
+  size_t lineTokens = 0;
+  for (const char* p = data; (lines > 0) && (p < dataEnd); )
+  {
+    const char* newline = (const char*) std::memchr(p, '\n', dataEnd - p);
+    const char* lineEnd = (newline == NULL) ? dataEnd : newline;
+    if (std::find_if(p, lineEnd, [](const char x)
+        { return !std::isspace((unsigned char) x); }) != lineEnd)
     {
-      if (token == "\t")
-        token.clear();
+      SplitLine(p, lineEnd, delim, tokens);
+      lineTokens = tokens.size();
+      break;
+    }
+    p = (newline == NULL) ? dataEnd : newline + 1;
+  }
 
-      std::getline(lineStream, token, delim);
-      // Remove whitespace from either side.
-      Trim(token);
+  // Each token of a line is a dimension if the matrix is transposed;
+  // otherwise, each line is a dimension.
+  const size_t dimensions = transpose ? lineTokens : lines;
+  const size_t points = transpose ? lines : lineTokens;
+  if (infoSet.Dimensionality() == 0)
+  {
+    infoSet.SetDimensionality(dimensions);
+  }
+  else if (infoSet.Dimensionality() != dimensions)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+        << infoSet.Dimensionality() << ", but data has dimensionality "
+        << dimensions;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Tokenize each chunk.  For each dimension of the chunk, we keep the
+  // distinct tokens in the order they first appear, and for each token, its
+  // index in that list.
+  std::vector<std::vector<std::vector<std::string_view>>> chunkDistinct(
+      numChunks);
+  std::vector<std::vector<size_t>> chunkIndices(numChunks);
+  std::vector<size_t> badLine(numChunks, lines);
+  std::vector<size_t> badTokens(numChunks, 0);
+
+  #pragma omp parallel
+  {
+    std::vector<std::string_view> threadTokens;
 
-      if (token[0] == '"' && token[token.size() - 1] != '"')
+    #pragma omp for schedule(dynamic)
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      // In the non-transposed case, each line has its own dictionary, so only
+      // one is needed at a time.
+      std::vector<std::unordered_map<std::string_view, size_t>> dictionaries(
+          transpose ? dimensions : 1);
+      chunkDistinct[c].resize(transpose ? dimensions : chunkLines[c]);
+      chunkIndices[c].reserve(chunkLines[c] * lineTokens);
+
+      const char* p = chunkBegin[c];
+      const char* end = chunkBegin[c + 1];
+      size_t line = 0;
+      while (p < end)
       {
-        std::string tok = token;
-        while (token[token.size() - 1] != '"')
+        const char* newline = (const char*) std::memchr(p, '\n', end - p);
+        const char* lineEnd = (newline == NULL) ? end : newline;
+        const char* next = (newline == NULL) ? end : newline + 1;
+        if (std::find_if(p, lineEnd, [](const char x)
+            { return !std::isspace((unsigned char) x); }) == lineEnd)
+        {
+          p = next;
+          continue;
+        }
+
+        SplitLine(p, lineEnd, delim, threadTokens);
+        if (threadTokens.size() != lineTokens)
         {
-          tok += delim;
-          std::getline(lineStream, token, delim);
-          tok += token;
+          badLine[c] = chunkRow[c] + line;
+          badTokens[c] = threadTokens.size();
+          break;
         }
-        token = tok;
+
+        if (!transpose)
+          dictionaries[0].clear();
+        for (size_t i = 0; i < threadTokens.size(); ++i)
+        {
+          const size_t d = transpose ? i : 0;
+          std::vector<std::string_view>& distinct =
+              chunkDistinct[c][transpose ? i : line];
+          const auto result = dictionaries[d].emplace(threadTokens[i],
+              distinct.size());
+          if (result.second)
+            distinct.push_back(threadTokens[i]);
+          chunkIndices[c].push_back(result.first->second);
+        }
+
+        ++line;
+        p = next;
       }
-      inout(row, col++) = infoSet.template MapString<T>(std::move(token), row);
     }
+  }
 
-    // Make sure we got the right number of rows.
-    if (col != cols)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (badLine[c] != lines)
     {
       std::ostringstream oss;
-      oss << "LoadCSV::NonTransposeParse(): wrong number of dimensions ("
-          << col << ") on line " << row << "; should be " << cols
-          << " dimensions.";
+      oss << "LoadCSV::LoadCategoricalCSV(): wrong number of dimensions ("
+          << badTokens[c] << ") on line " << badLine[c] << "; should be "
+          << lineTokens << " dimensions.";
       throw std::runtime_error(oss.str());
     }
-    ++row; col = 0;
+  }
+
+  // Pass the distinct tokens to the DatasetMapper in the order of the chunks.
+  // Only these need to be copied into strings.
+  if (PolicyType::NeedsFirstPass)
+  {
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+      for (size_t k = 0; k < chunkDistinct[c].size(); ++k)
+      {
+        const size_t dimension = transpose ? k : chunkRow[c] + k;
+        for (size_t j = 0; j < chunkDistinct[c][k].size(); ++j)
+        {
+          infoSet.template MapFirstPass<T>(
+              std::string(chunkDistinct[c][k][j]), dimension);
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<std::vector<T>>> chunkValues(numChunks);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkValues[c].resize(chunkDistinct[c].size());
+    for (size_t k = 0; k < chunkDistinct[c].size(); ++k)
+    {
+      const size_t dimension = transpose ? k : chunkRow[c] + k;
+      chunkValues[c][k].resize(chunkDistinct[c][k].size());
+      for (size_t j = 0; j < chunkDistinct[c][k].size(); ++j)
+      {
+        chunkValues[c][k][j] = infoSet.template MapString<T>(
+            std::string(chunkDistinct[c][k][j]), dimension);
+      }
+    }
+  }
+
+  // Finally, write the mapped values into the matrix.
+  inout.set_size(dimensions, points);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    size_t index = 0;
+    for (size_t line = 0; line < chunkLines[c]; ++line)
+    {
+      for (size_t i = 0; i < lineTokens; ++i)
+      {
+        const std::vector<T>& values = chunkValues[c][transpose ? i : line];
+        const T value = values[chunkIndices[c][index++]];
+        if (transpose)
+          inout(i, chunkRow[c] + line) = value;
+        else
+          inout(chunkRow[c] + line, i) = value;
+      }
+    }
   }
 }
 
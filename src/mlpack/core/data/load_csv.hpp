@@ -43,14 +43,18 @@
 #define MLPACK_CORE_DATA_LOAD_CSV_HPP
 
 #include <mlpack/core/util/log.hpp>
+#include <charconv>
+#include <cstring>
 #include <set>
 #include <string>
+#include <string_view>
 
 #include "string_algorithms.hpp"
 #include "extension.hpp"
 #include "format.hpp"
 #include "dataset_mapper.hpp"
 #include "types.hpp"
+#include "mapped_file.hpp"
 
 namespace mlpack {
 namespace data {
@@ -114,6 +118,45 @@ class LoadCSV
   template<typename eT>
   bool LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f);
 
+  /**
+  * Returns a bool value showing whether data was loaded successfully or not.
+  *
+  * Parses a csv file and loads the data into the given matrix, like the
+  * overload above, but the file is memory-mapped and split into chunks of
+  * whole lines that are parsed in parallel.  In the first pass, each chunk
+  * counts its lines and columns; the matrix is then allocated, and in the
+  * second pass each chunk converts its tokens directly into its own rows (or
+  * columns, if transpose is true) of the matrix.
+  *
+  * @param x Matrix in which data will be loaded.
+  * @param filename Name of the file to load.
+  * @param offset Position in the file of the first line to load (this is
+  *     used to skip a header).
+  * @param transpose If true, each line of the file is loaded as a column of
+  *     the matrix.
+  */
+  template<typename eT>
+  bool LoadNumericCSV(arma::Mat<eT>& x,
+                      const std::string& filename,
+                      const size_t offset,
+                      const bool transpose);
+
+  /**
+  * Parses the contents of an already opened file (for instance, a compressed
+  * file that was decompressed into memory), like the overload above.
+  *
+  * @param x Matrix in which data will be loaded.
+  * @param file Contents of the file to load.
+  * @param offset Position in the file of the first line to load.
+  * @param transpose If true, each line of the file is loaded as a column of
+  *     the matrix.
+  */
+  template<typename eT>
+  bool LoadNumericCSV(arma::Mat<eT>& x,
+                      const MappedFile& file,
+                      const size_t offset,
+                      const bool transpose);
+
   /**
   * Converts the given string token to assigned datatype and assigns
   * this value to the given address. The address here will be a
@@ -128,6 +171,18 @@ class LoadCSV
   template<typename eT>
   bool ConvertToken(eT& val, const std::string& token);
 
+  /**
+  * Converts the token in the range [begin, end) to the assigned datatype, in
+  * the same way as the overload above, but without copying the token into a
+  * string.
+  *
+  * @param val Token's value will be assigned to this address.
+  * @param begin Pointer to the first character of the token.
+  * @param end Pointer past the last character of the token.
+  */
+  template<typename eT>
+  static bool ConvertToken(eT& val, const char* begin, const char* end);
+
   /**
    * Calculate the number of columns in each row
    * and assign the value to the col. This function
@@ -254,6 +309,18 @@ class LoadCSV
     return mat_size;
   }
 
+  /**
+  * Split the given contents of a file into chunks of whole lines, so that they
+  * can be parsed in parallel.  There are a few chunks for each thread (so that
+  * the work is balanced even if lines have different lengths), but no chunk is
+  * smaller than 1MB.  The returned vector holds the start of each chunk,
+  * followed by the end of the data.
+  *
+  * @param data Contents of the file.
+  * @param size Size of the contents, in bytes.
+  */
+  inline static std::vector<const char*> LineChunks(const char* data,
+                                                    const size_t size);
 
  private:
 
@@ -279,23 +346,39 @@ class LoadCSV
   // Functions for Categorical Parse.
 
   /**
-  * Parse a non-transposed matrix.
+  * Split a line into its (trimmed) tokens, joining quoted tokens that contain
+  * the delimiter, in the same way as CategoricalMatSize().  The tokens point
+  * into the line, so nothing is copied.
   *
-  * @param input Matrix to load into.
-  * @param infoSet DatasetMapper object to load with.
+  * @param begin Start of the line.
+  * @param end End of the line (excluding the newline).
+  * @param delim Delimiter character.
+  * @param tokens Vector to store the tokens in.
   */
-  template<typename T, typename PolicyType>
-  void NonTransposeParse(arma::Mat<T>& inout,
-                         DatasetMapper<PolicyType>& infoSet);
+  inline static void SplitLine(const char* begin,
+                               const char* end,
+                               const char delim,
+                               std::vector<std::string_view>& tokens);
 
   /**
-  * Parse a transposed matrix.
+  * Parse the file into the given matrix, in parallel.  Each chunk of lines is
+  * tokenized by one thread, which also collects the distinct tokens of each
+  * dimension in the order they first appear; then the distinct tokens of each
+  * chunk are given to the DatasetMapper, in the order of the chunks, so the
+  * mappings are the same as if the file were read sequentially; finally, the
+  * mapped values are written into the matrix in parallel.
   *
-  * @param input Matrix to load into.
-  * @param infoSet DatasetMapper to load with.
+  * This assumes that the mapping policy always maps a given input in a given
+  * dimension to the same value, which is true for all mlpack policies.
+  *
+  * @param inout Matrix to load into.
+  * @param infoSet DatasetMapper object to load with.
+  * @param transpose If true, each line of the file is a column of the matrix.
   */
   template<typename T, typename PolicyType>
-  void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet);
+  void CategoricalParse(arma::Mat<T>& inout,
+                        DatasetMapper<PolicyType>& infoSet,
+                        const bool transpose);
 
   //! Extension (type) of file.
   std::string extension;
@@ -13,6 +13,7 @@
 #ifndef MLPACK_CORE_DATA_LOAD_IMAGE_HPP
 #define MLPACK_CORE_DATA_LOAD_IMAGE_HPP
 
+#include "arma_binary.hpp"
 #include "image_info.hpp"
 
 #ifdef MLPACK_HAS_STB
@@ -64,19 +65,33 @@ bool Load(const std::string& filename,
           const bool fatal = false);
 
 /**
- * Load the image file into the given matrix.
+ * Load the given image files into the given matrix, one image per column.  The
+ * images are decoded in parallel.
+ *
+ * All the columns have the same size: if the width and height of `info` are
+ * set, each image is scaled (preserving its aspect ratio) to cover that size
+ * and cropped to it around its center; otherwise, the size of the first image
+ * is used.  The images are loaded in grayscale if `info.Channels()` is 1, and
+ * in RGB otherwise.
+ *
+ * If `cacheFile` is given, the decoded images are saved there (as an Armadillo
+ * binary matrix of bytes, with a `.info` file listing the images), and later
+ * calls with the same files and sizes load that cache instead of decoding the
+ * images again.  Delete the cache if the images are changed.
  *
  * @param files A vector consisting of filenames.
  * @param matrix Matrix to save the image from.
  * @param info An object of ImageInfo class.
  * @param fatal If an error should be reported as fatal (default false).
+ * @param cacheFile File to cache the decoded images in (default: none).
  * @return Boolean value indicating success or failure of load.
  */
 template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
-          const bool fatal = false);
+          const bool fatal = false,
+          const std::string& cacheFile = "");
 
 // Implementation found in load_image.hpp.
 inline bool LoadImage(const std::string& filename,
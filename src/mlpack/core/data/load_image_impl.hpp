@@ -19,6 +19,213 @@
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+/**
+ * Scale the given interleaved image (preserving its aspect ratio) so that it
+ * covers the target size, and crop it to that size around its center, with
+ * bilinear interpolation.  The result is written to `out`.
+ */
+inline void ResizeCropImage(const unsigned char* in,
+                            const size_t width,
+                            const size_t height,
+                            const size_t channels,
+                            unsigned char* out,
+                            const size_t targetWidth,
+                            const size_t targetHeight)
+{
+  if (width == targetWidth && height == targetHeight)
+  {
+    std::memcpy(out, in, width * height * channels);
+    return;
+  }
+
+  // Number of source pixels for each target pixel, and the corner of the
+  // cropped region.
+  const double scale = std::min(double(width) / targetWidth,
+      double(height) / targetHeight);
+  const double left = (width - targetWidth * scale) / 2.0;
+  const double top = (height - targetHeight * scale) / 2.0;
+
+  for (size_t y = 0; y < targetHeight; ++y)
+  {
+    const double sy = std::min(std::max(top + (y + 0.5) * scale - 0.5, 0.0),
+        double(height - 1));
+    const size_t y0 = (size_t) sy;
+    const size_t y1 = std::min(y0 + 1, height - 1);
+    const double fy = sy - y0;
+
+    for (size_t x = 0; x < targetWidth; ++x)
+    {
+      const double sx = std::min(std::max(left + (x + 0.5) * scale - 0.5,
+          0.0), double(width - 1));
+      const size_t x0 = (size_t) sx;
+      const size_t x1 = std::min(x0 + 1, width - 1);
+      const double fx = sx - x0;
+
+      for (size_t c = 0; c < channels; ++c)
+      {
+        const double upper = (1.0 - fx) *
+            in[(y0 * width + x0) * channels + c] +
+            fx * in[(y0 * width + x1) * channels + c];
+        const double lower = (1.0 - fx) *
+            in[(y1 * width + x0) * channels + c] +
+            fx * in[(y1 * width + x1) * channels + c];
+        out[(y * targetWidth + x) * channels + c] =
+            (unsigned char) std::lround((1.0 - fy) * upper + fy * lower);
+      }
+    }
+  }
+}
+
+#ifdef MLPACK_HAS_STB
+
+/**
+ * Get the size of the given image without decoding it.  This does not print
+ * anything, so that it can be used by several threads; on failure, `error` is
+ * set.
+ */
+inline bool ImageSize(const std::string& filename,
+                      size_t& width,
+                      size_t& height,
+                      std::string& error)
+{
+  int tempWidth, tempHeight, tempChannels;
+  if (!stbi_info(filename.c_str(), &tempWidth, &tempHeight, &tempChannels))
+  {
+    error = "failed to load image '" + filename + "': " +
+        stbi_failure_reason();
+    return false;
+  }
+
+  width = tempWidth;
+  height = tempHeight;
+  return true;
+}
+
+/**
+ * Decode the given image with the given number of channels (1 or 3), resized
+ * and cropped to the given size, into `out`.  This does not print anything,
+ * so that it can be used by several threads; on failure, `error` is set.
+ */
+inline bool DecodeImage(const std::string& filename,
+                        const size_t width,
+                        const size_t height,
+                        const size_t channels,
+                        unsigned char* out,
+                        std::string& error)
+{
+  if (!ImageFormatSupported(filename))
+  {
+    error = "file type " + Extension(filename) + " not supported";
+    return false;
+  }
+
+  int tempWidth, tempHeight, tempChannels;
+  unsigned char* image = stbi_load(filename.c_str(), &tempWidth, &tempHeight,
+      &tempChannels, (channels == 1) ? STBI_grey : STBI_rgb);
+  if (!image)
+  {
+    error = "failed to load image '" + filename + "': " +
+        stbi_failure_reason();
+    return false;
+  }
+
+  ResizeCropImage(image, tempWidth, tempHeight, channels, out, width,
+      height);
+  stbi_image_free(image);
+  return true;
+}
+
+#else // MLPACK_HAS_STB
+
+inline bool ImageSize(const std::string& /* filename */,
+                      size_t& /* width */,
+                      size_t& /* height */,
+                      std::string& error)
+{
+  error = "mlpack was not compiled with STB support, so images cannot be "
+      "loaded!";
+  return false;
+}
+
+inline bool DecodeImage(const std::string& /* filename */,
+                        const size_t /* width */,
+                        const size_t /* height */,
+                        const size_t /* channels */,
+                        unsigned char* /* out */,
+                        std::string& error)
+{
+  error = "mlpack was not compiled with STB support, so images cannot be "
+      "loaded!";
+  return false;
+}
+
+#endif // MLPACK_HAS_STB
+
+/**
+ * Load the cache of the given images, if it exists and was made for the same
+ * images and size; `info` is then set to the size of the cached images.
+ */
+inline bool LoadImageCache(const std::string& cacheFile,
+                           const std::vector<std::string>& files,
+                           ImageInfo& info,
+                           arma::Mat<unsigned char>& matrix)
+{
+  std::ifstream metadata((cacheFile + ".info").c_str());
+  std::string header;
+  size_t width = 0, height = 0, channels = 0, count = 0;
+  if (!(metadata >> header >> width >> height >> channels >> count) ||
+      header != "MLPACK_IMAGE_CACHE" || count != files.size())
+    return false;
+
+  // The size must match the requested size, if there is one.
+  if ((info.Width() != 0 && info.Height() != 0 &&
+      (width != info.Width() || height != info.Height())) ||
+      ((info.Channels() == 1) != (channels == 1)))
+    return false;
+
+  std::string name;
+  std::getline(metadata, name);
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    if (!std::getline(metadata, name) || name != files[i])
+      return false;
+  }
+
+  if (!matrix.load(cacheFile, arma::arma_binary) ||
+      matrix.n_rows != width * height * channels || matrix.n_cols != count)
+    return false;
+
+  info.Width() = width;
+  info.Height() = height;
+  info.Channels() = channels;
+  return true;
+}
+
+/**
+ * Save the cache of the given decoded images.
+ */
+inline bool SaveImageCache(const std::string& cacheFile,
+                           const std::vector<std::string>& files,
+                           const ImageInfo& info,
+                           const arma::Mat<unsigned char>& matrix)
+{
+  std::ofstream data(cacheFile.c_str(), std::ios::out | std::ios::binary);
+  if (!data.is_open() || !SaveArmaBinary(data, matrix))
+    return false;
+
+  std::ofstream metadata((cacheFile + ".info").c_str());
+  metadata << "MLPACK_IMAGE_CACHE\n" << info.Width() << " " << info.Height()
+      << " " << info.Channels() << " " << files.size() << "\n";
+  for (size_t i = 0; i < files.size(); ++i)
+    metadata << files[i] << "\n";
+
+  return metadata.good();
+}
+
+} // namespace details
+
 // Image loading API.
 template<typename eT>
 bool Load(const std::string& filename,
@@ -50,7 +257,8 @@ template<typename eT>
 bool Load(const std::vector<std::string>& files,
           arma::Mat<eT>& matrix,
           ImageInfo& info,
-          const bool fatal)
+          const bool fatal,
+          const std::string& cacheFile)
 {
   if (files.size() == 0)
   {
@@ -65,28 +273,75 @@ bool Load(const std::vector<std::string>& files,
     return false;
   }
 
-  arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
+  Timer::Start("loading_image");
+
+  arma::Mat<unsigned char> tmpMatrix;
+  if (!cacheFile.empty() &&
+      details::LoadImageCache(cacheFile, files, info, tmpMatrix))
+  {
+    Log::Info << "Loaded " << files.size() << " decoded images from cache '"
+        << cacheFile << "'." << std::endl;
+    matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
+    Timer::Stop("loading_image");
+    return true;
+  }
+
+  // Without a requested size, all images get the size of the first.
+  size_t width = info.Width();
+  size_t height = info.Height();
+  const size_t channels = (info.Channels() == 1) ? 1 : 3;
+  std::string error;
+  if ((width == 0 || height == 0) &&
+      !details::ImageSize(files[0], width, height, error))
+  {
+    Timer::Stop("loading_image");
+    if (fatal)
+      Log::Fatal << "Load(): " << error << std::endl;
+    else
+      Log::Warn << "Load(): " << error << std::endl;
 
-  if (!status)
     return false;
+  }
 
-  // Decide matrix dimension using the image height and width.
-  arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
+  // Each image is decoded directly into its column.  Errors can't be reported
+  // from inside the parallel region, so each image keeps its own.
+  tmpMatrix.set_size(width * height * channels, files.size());
+  std::vector<std::string> errors(files.size());
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < files.size(); ++i)
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
+    details::DecodeImage(files[i], width, height, channels,
+        tmpMatrix.colptr(i), errors[i]);
+  }
+
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    if (!errors[i].empty())
+    {
+      Timer::Stop("loading_image");
+      if (fatal)
+        Log::Fatal << "Load(): " << errors[i] << std::endl;
+      else
+        Log::Warn << "Load(): " << errors[i] << std::endl;
 
-    if (!status)
       return false;
+    }
+  }
+
+  info.Width() = width;
+  info.Height() = height;
+  info.Channels() = channels;
+
+  if (!cacheFile.empty() &&
+      !details::SaveImageCache(cacheFile, files, info, tmpMatrix))
+  {
+    Log::Warn << "Load(): could not save decoded images to cache '"
+        << cacheFile << "'." << std::endl;
   }
 
   matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
+  Timer::Stop("loading_image");
   return true;
 }
 
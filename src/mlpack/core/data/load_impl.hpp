@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <exception>
 
+#include "compressed_file.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
 #include "string_algorithms.hpp"
@@ -56,6 +57,17 @@ void TransposeTokens(std::vector<std::vector<std::string>> const &input,
   }
 }
 
+/**
+ * Return whether files of the given type are read by name (by a library, or
+ * by a parser that decompresses them itself), instead of from a stream.  Such
+ * files do not need to be decompressed by Load().
+ */
+inline bool ReadByName(const FileType type)
+{
+  return (type == FileType::HDF5Binary || type == FileType::ArrowIPC ||
+      type == FileType::Parquet || type == FileType::LibSVM);
+}
+
 } // namespace details
 
 template <typename MatType>
@@ -88,22 +100,27 @@ bool Load(const std::string& filename,
 {
   Timer::Start("loading_data");
 
-  // Catch nonexistent files by opening the stream ourselves.
-  std::fstream stream;
-
+  // Catch nonexistent files by opening the stream ourselves.  Compressed files
+  // are decompressed into memory here, unless they are read by name.
+  const bool decompress = !details::ReadByName(
+      (inputLoadType == FileType::AutoDetect) ?
+      DetectFromExtension(filename) : inputLoadType);
 #ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  InputFile file(filename, std::fstream::in | std::fstream::binary,
+      decompress);
 #else
-  stream.open(filename.c_str(), std::fstream::in);
+  InputFile file(filename, std::fstream::in, decompress);
 #endif
-  if (!stream.is_open())
+  std::istream& stream = file.Stream();
+  if (!file.IsOpen())
   {
     Timer::Stop("loading_data");
     if (fatal)
-      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
-    else
-      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+      Log::Fatal << "Cannot open file '" << filename << "'. " << file.Error()
           << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed. "
+          << file.Error() << std::endl;
 
     return false;
   }
@@ -149,6 +166,54 @@ bool Load(const std::string& filename,
   }
 #endif
 
+  // Arrow, Parquet and HDF5 files are read by their libraries, which need the
+  // file itself.
+  if (CompressionType(filename) != Compression::None &&
+      (loadType == FileType::ArrowIPC || loadType == FileType::Parquet ||
+       loadType == FileType::HDF5Binary))
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot load '" << filename << "': compressed "
+          << stringType << " files are not supported." << std::endl;
+    else
+      Log::Warn << "Cannot load '" << filename << "': compressed "
+          << stringType << " files are not supported; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // Arrow IPC and Parquet files are read by Arrow.
+  if (loadType == FileType::ArrowIPC || loadType == FileType::Parquet)
+  {
+    Log::Info << "Loading '" << filename << "' as " << stringType << ".  "
+        << std::flush;
+    const bool success = LoadArrow(filename, matrix, fatal, transpose,
+        std::vector<std::string>(), loadType);
+    if (success)
+    {
+      Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+          << ".\n";
+    }
+
+    Timer::Stop("loading_data");
+    return success;
+  }
+
+  // libsvm files hold sparse data, so they are loaded as a sparse matrix.
+  if (loadType == FileType::LibSVM)
+  {
+    file.Close();
+    Timer::Stop("loading_data");
+    arma::SpMat<eT> sparse;
+    if (!Load(filename, sparse, fatal, transpose, loadType))
+      return false;
+
+    matrix = arma::Mat<eT>(sparse);
+    return true;
+  }
+
   // Try to load the file; but if it's raw_binary, it could be a problem.
   if (loadType == FileType::RawBinary)
     Log::Warn << "Loading '" << filename << "' as " << stringType << "; "
@@ -161,13 +226,22 @@ bool Load(const std::string& filename,
   bool success;
   LoadCSV loader;
 
-  if (loadType != FileType::HDF5Binary)
+  if (loadType == FileType::CSVASCII)
   {
-    if (loadType == FileType::CSVASCII)
-      success = loader.LoadNumericCSV(matrix, stream);
+    // The file is parsed in parallel, directly into the (transposed, if
+    // necessary) matrix; it starts where the stream is, since AutoDetect()
+    // skips any header row.  If that consumed the whole file, the stream
+    // position is not valid.
+    const std::streamoff start = stream.tellg();
+    if (file.IsCompressed())
+      success = (start >= 0) && loader.LoadNumericCSV(matrix, file.Contents(),
+          (size_t) start, transpose);
     else
-      success = matrix.load(stream, ToArmaFileType(loadType));
+      success = (start >= 0) && loader.LoadNumericCSV(matrix, filename,
+          (size_t) start, transpose);
   }
+  else if (loadType != FileType::HDF5Binary)
+    success = matrix.load(stream, ToArmaFileType(loadType));
   else
     success = matrix.load(filename, ToArmaFileType(loadType));
 
@@ -182,12 +256,16 @@ bool Load(const std::string& filename,
 
     return false;
   }
+  else if (loadType == FileType::CSVASCII)
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
   else
     Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
         << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
 
-  // Now transpose the matrix, if necessary.
-  if (transpose)
+  // Now transpose the matrix, if necessary.  (CSV files are already loaded in
+  // the right orientation.)
+  if (transpose && loadType != FileType::CSVASCII)
   {
     success = inplace_transpose(matrix, fatal);
   }
@@ -272,6 +350,34 @@ bool Load(const std::string& filename,
       return false;
     }
   }
+  else if ((extension == "arrow" || extension == "feather" ||
+            extension == "ipc" || extension == "parquet") &&
+           CompressionType(filename) != Compression::None)
+  {
+    // Arrow needs the file itself.
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot load '" << filename << "': compressed "
+          << GetStringType(DetectFromExtension(filename)) << " files are not "
+          << "supported." << std::endl;
+    else
+      Log::Warn << "Cannot load '" << filename << "': compressed "
+          << GetStringType(DetectFromExtension(filename)) << " files are not "
+          << "supported; load failed." << std::endl;
+
+    return false;
+  }
+  else if (extension == "arrow" || extension == "feather" ||
+           extension == "ipc" || extension == "parquet")
+  {
+    Log::Info << "Loading '" << filename << "' as "
+        << GetStringType(DetectFromExtension(filename)) << ".  " << std::flush;
+    if (!LoadArrow(filename, matrix, info, fatal, transpose))
+    {
+      Timer::Stop("loading_data");
+      return false;
+    }
+  }
   else
   {
     // The type is unknown.
@@ -307,25 +413,66 @@ bool Load(const std::string& filename,
   // Get the extension.
   std::string extension = Extension(filename);
 
-  // Catch nonexistent files by opening the stream ourselves.
-  std::fstream stream;
+  // Catch nonexistent files by opening the stream ourselves.  Compressed files
+  // are decompressed into memory here, unless they are ARFF or libsvm files
+  // (which are parsed by name).
+  const bool decompress = !(inputLoadType == FileType::AutoDetect ?
+      (extension == "arff" ||
+       DetectFromExtension(filename) == FileType::LibSVM) :
+      (inputLoadType == FileType::LibSVM));
 #ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+  InputFile file(filename, std::fstream::in | std::fstream::binary,
+      decompress);
 #else
-  stream.open(filename.c_str(), std::fstream::in);
+  InputFile file(filename, std::fstream::in, decompress);
 #endif
-  if (!stream.is_open())
+  std::istream& stream = file.Stream();
+  if (!file.IsOpen())
   {
     Timer::Stop("loading_data");
     if (fatal)
-      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
-    else
-      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+      Log::Fatal << "Cannot open file '" << filename << "'. " << file.Error()
           << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed. "
+          << file.Error() << std::endl;
 
     return false;
   }
 
+  // Sparse ARFF files are parsed directly into the sparse matrix.
+  if (inputLoadType == FileType::AutoDetect && extension == "arff")
+  {
+    file.Close();
+    Log::Info << "Loading '" << filename << "' as ARFF dataset.  "
+        << std::flush;
+    try
+    {
+      LoadARFF(filename, matrix);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_cols << " x " << matrix.n_rows
+        << ".\n";
+
+    // LoadARFF() gives one point per column, so un-transpose if necessary.
+    bool success = true;
+    if (!transpose)
+      success = inplace_transpose(matrix, fatal);
+
+    Timer::Stop("loading_data");
+    return success;
+  }
+
   FileType loadType = inputLoadType;
   std::string stringType;
   if (inputLoadType == FileType::AutoDetect)
@@ -363,6 +510,61 @@ bool Load(const std::string& filename,
     }
   }
 
+  // libsvm files are parsed in parallel; the labels become the last row of the
+  // matrix.
+  if (loadType == FileType::LibSVM)
+  {
+    file.Close();
+    Log::Info << "Loading '" << filename << "' as "
+        << GetStringType(loadType) << ".  " << std::flush;
+
+    arma::umat locations;
+    arma::Col<eT> values;
+    std::vector<double> labels;
+    size_t maxIndex = 0;
+    std::string error;
+    details::ParseLibSVM(filename, 0, locations, values, labels, maxIndex,
+        error);
+    if (!error.empty())
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << error << "." << std::endl;
+      else
+        Log::Warn << error << "; load failed." << std::endl;
+
+      return false;
+    }
+
+    const size_t nonzeroLabels = labels.size() - std::count(labels.begin(),
+        labels.end(), 0.0);
+    const size_t nonzeros = values.n_elem;
+    locations.resize(2, nonzeros + nonzeroLabels);
+    values.resize(nonzeros + nonzeroLabels);
+    for (size_t i = 0, n = nonzeros; i < labels.size(); ++i)
+    {
+      if (labels[i] != 0.0)
+      {
+        locations(0, n) = maxIndex;
+        locations(1, n) = i;
+        values[n++] = (eT) labels[i];
+      }
+    }
+
+    matrix = arma::SpMat<eT>(true, locations, values, maxIndex + 1,
+        labels.size());
+    Log::Info << "Size is " << matrix.n_cols << " x " << matrix.n_rows
+        << ".\n";
+
+    // Each line is a point, so un-transpose if necessary.
+    bool success = true;
+    if (!transpose)
+      success = inplace_transpose(matrix, fatal);
+
+    Timer::Stop("loading_data");
+    return success;
+  }
+
   // Filter out invalid types.
   if ((loadType == FileType::PGMBinary) ||
       (loadType == FileType::PPMBinary) ||
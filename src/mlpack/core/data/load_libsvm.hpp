@@ -0,0 +1,70 @@
+/**
+ * @file core/data/load_libsvm.hpp
+ *
+ * Load a dataset in the libsvm (SVMLight) format into a sparse matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <charconv>
+#include <string_view>
+
+#include "load_csv.hpp"
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a dataset in the libsvm (SVMLight) format into a sparse matrix and a
+ * row of labels.  Each line of the file holds one point, as a label followed by
+ * `index:value` pairs for the nonzero features, where the indices start at 1:
+ *
+ * @code
+ * 1 3:0.5 17:1.2 1048576:1
+ * -1 2:0.7 3:0.1
+ * @endcode
+ *
+ * As usual in mlpack, each point is a column of the loaded matrix, and feature
+ * `i` of the file is row `i - 1`.  Nothing is densified, so this is suitable
+ * for high-dimensional data such as hashed text features.  Comments (starting
+ * with `#`) and `qid:` entries are ignored.  The file is parsed in parallel
+ * when OpenMP is available.
+ *
+ * The labels are read as floating-point numbers and converted to the element
+ * type of `labels`; classification labels such as -1 and +1 can be loaded into
+ * an `arma::rowvec`, then mapped to 0 and 1 with `data::NormalizeLabels()`.
+ *
+ * By default, the number of rows of the matrix is the largest index in the
+ * file.  When loading a test set, pass the dimensionality of the training set
+ * as `dimensionality`, so that both matrices have the same number of rows.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row vector to load the labels into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param dimensionality Number of rows of the matrix, or 0 to use the largest
+ *     index in the file.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename LabelType>
+bool LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const bool fatal = false,
+                const size_t dimensionality = 0);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_libsvm_impl.hpp"
+
+#endif
@@ -0,0 +1,305 @@
+/**
+ * @file core/data/load_libsvm_impl.hpp
+ *
+ * Implementation of LoadLibSVM().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load_libsvm.hpp"
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+/**
+ * Convert the whole token [begin, end) to a number; returns false if the token
+ * is empty or has anything after the number.
+ */
+inline bool ParseLibSVMNumber(const char* begin,
+                              const char* end,
+                              double& value)
+{
+  // std::from_chars() does not accept a leading '+'.
+  if ((end - begin > 1) && (*begin == '+'))
+    ++begin;
+
+  if (begin == end)
+    return false;
+
+#if defined(__cpp_lib_to_chars)
+  const std::from_chars_result result = std::from_chars(begin, end, value);
+  if (result.ec == std::errc())
+    return (result.ptr == end);
+  else if (result.ec == std::errc::invalid_argument)
+    return false;
+#endif
+
+  // std::strtod() needs a null-terminated string (and saturates values that
+  // are out of range).
+  const std::string token(begin, end);
+  char* tokenEnd = nullptr;
+  value = std::strtod(token.c_str(), &tokenEnd);
+  return (tokenEnd == token.c_str() + token.size());
+}
+
+/**
+ * Parse the lines of a libsvm file in the range [p, end).  The nonzero values
+ * are appended to `locations` (as (row, column) pairs, where the column is the
+ * index of the point in the range) and `values`, and the labels to `labels`.
+ * On failure, `error` is set and `errorLine` is set to the index of the failed
+ * line in the range; otherwise `lines` is set to the number of lines.
+ */
+template<typename eT>
+void ParseLibSVMLines(const char* p,
+                      const char* end,
+                      const size_t dimensionality,
+                      std::vector<arma::uword>& locations,
+                      std::vector<eT>& values,
+                      std::vector<double>& labels,
+                      size_t& maxIndex,
+                      size_t& lines,
+                      size_t& errorLine,
+                      std::string& error)
+{
+  auto isSpace = [](const char c)
+  {
+    return (c == ' ' || c == '\t' || c == '\r');
+  };
+
+  lines = 0;
+  while (p < end)
+  {
+    const char* newline = (const char*) std::memchr(p, '\n', end - p);
+    const char* lineEnd = (newline == NULL) ? end : newline;
+    const char* next = (newline == NULL) ? end : newline + 1;
+
+    // Strip comments.
+    const char* comment = (const char*) std::memchr(p, '#', lineEnd - p);
+    if (comment != NULL)
+      lineEnd = comment;
+
+    // Split the line into tokens at whitespace; the first is the label.
+    bool first = true;
+    while (true)
+    {
+      while (p != lineEnd && isSpace(*p))
+        ++p;
+      if (p == lineEnd)
+        break;
+
+      const char* tokenEnd = p;
+      while (tokenEnd != lineEnd && !isSpace(*tokenEnd))
+        ++tokenEnd;
+
+      if (first)
+      {
+        double label;
+        if (!ParseLibSVMNumber(p, tokenEnd, label))
+        {
+          error = "invalid label";
+          break;
+        }
+
+        labels.push_back(label);
+        first = false;
+        p = tokenEnd;
+        continue;
+      }
+
+      const char* colon = (const char*) std::memchr(p, ':', tokenEnd - p);
+      if (colon == NULL)
+      {
+        error = "expected index:value, got '" + std::string(p, tokenEnd) + "'";
+        break;
+      }
+
+      if (std::string_view(p, colon - p) == "qid")
+      {
+        p = tokenEnd;
+        continue;
+      }
+
+      size_t index = 0;
+      double value;
+      const std::from_chars_result result = std::from_chars(p, colon, index);
+      if (result.ec != std::errc() || result.ptr != colon ||
+          !ParseLibSVMNumber(colon + 1, tokenEnd, value))
+      {
+        error = "invalid entry '" + std::string(p, tokenEnd) + "'";
+        break;
+      }
+
+      if (index == 0)
+      {
+        error = "feature indices must start at 1";
+        break;
+      }
+
+      if (dimensionality != 0 && index > dimensionality)
+      {
+        std::ostringstream oss;
+        oss << "feature index " << index << " is larger than the given "
+            << "dimensionality (" << dimensionality << ")";
+        error = oss.str();
+        break;
+      }
+
+      locations.push_back(index - 1);
+      locations.push_back(labels.size() - 1);
+      values.push_back((eT) value);
+      maxIndex = std::max(maxIndex, index);
+      p = tokenEnd;
+    }
+
+    if (!error.empty())
+    {
+      errorLine = lines;
+      return;
+    }
+
+    ++lines;
+    p = next;
+  }
+}
+
+/**
+ * Parse the libsvm file with the given name, in parallel.  The file is split
+ * into chunks of whole lines, which are parsed by different threads, and the
+ * results of the chunks are then concatenated.  On failure, `error` is set to a
+ * description of the first problem in the file (with its line number).
+ *
+ * @param filename Name of file to parse.
+ * @param dimensionality Largest allowed index, or 0 for no limit.
+ * @param locations Set to the (row, column) pairs of the nonzero values.
+ * @param values Set to the nonzero values.
+ * @param labels Set to the labels of the points.
+ * @param maxIndex Set to the largest index in the file.
+ * @param error Set to the error, if the file cannot be parsed.
+ */
+template<typename eT>
+void ParseLibSVM(const std::string& filename,
+                 const size_t dimensionality,
+                 arma::umat& locations,
+                 arma::Col<eT>& values,
+                 std::vector<double>& labels,
+                 size_t& maxIndex,
+                 std::string& error)
+{
+  MappedFile file(filename);
+  if (!file.IsOpen())
+  {
+    error = "Cannot open file '" + filename + "'";
+    return;
+  }
+
+  const std::vector<const char*> chunkBegin = LoadCSV::LineChunks(file.Data(),
+      file.Size());
+  const size_t numChunks = chunkBegin.size() - 1;
+
+  std::vector<std::vector<arma::uword>> chunkLocations(numChunks);
+  std::vector<std::vector<eT>> chunkValues(numChunks);
+  std::vector<std::vector<double>> chunkLabels(numChunks);
+  std::vector<size_t> chunkMaxIndex(numChunks, 0);
+  std::vector<size_t> chunkLines(numChunks, 0);
+  std::vector<size_t> chunkErrorLine(numChunks, 0);
+  std::vector<std::string> chunkError(numChunks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    ParseLibSVMLines(chunkBegin[c], chunkBegin[c + 1], dimensionality,
+        chunkLocations[c], chunkValues[c], chunkLabels[c], chunkMaxIndex[c],
+        chunkLines[c], chunkErrorLine[c], chunkError[c]);
+  }
+
+  // Report the first error in the file, and find where the points and the
+  // nonzero values of each chunk go.
+  std::vector<size_t> chunkPoint(numChunks, 0);
+  std::vector<size_t> chunkNonzero(numChunks, 0);
+  size_t lines = 0, points = 0, nonzeros = 0;
+  maxIndex = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (!chunkError[c].empty())
+    {
+      std::ostringstream oss;
+      oss << "Error parsing line " << (lines + chunkErrorLine[c] + 1) << " of '"
+          << filename << "': " << chunkError[c];
+      error = oss.str();
+      return;
+    }
+
+    chunkPoint[c] = points;
+    chunkNonzero[c] = nonzeros;
+    lines += chunkLines[c];
+    points += chunkLabels[c].size();
+    nonzeros += chunkValues[c].size();
+    maxIndex = std::max(maxIndex, chunkMaxIndex[c]);
+  }
+
+  locations.set_size(2, nonzeros);
+  values.set_size(nonzeros);
+  labels.resize(points);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (size_t i = 0; i < chunkValues[c].size(); ++i)
+    {
+      locations(0, chunkNonzero[c] + i) = chunkLocations[c][2 * i];
+      locations(1, chunkNonzero[c] + i) = chunkPoint[c] +
+          chunkLocations[c][2 * i + 1];
+      values[chunkNonzero[c] + i] = chunkValues[c][i];
+    }
+
+    std::copy(chunkLabels[c].begin(), chunkLabels[c].end(),
+        labels.begin() + chunkPoint[c]);
+  }
+}
+
+} // namespace details
+
+template<typename eT, typename LabelType>
+bool LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const bool fatal,
+                const size_t dimensionality)
+{
+  arma::umat locations;
+  arma::Col<eT> values;
+  std::vector<double> labelValues;
+  size_t maxIndex = 0;
+  std::string error;
+  details::ParseLibSVM(filename, dimensionality, locations, values,
+      labelValues, maxIndex, error);
+
+  if (!error.empty())
+  {
+    if (fatal)
+      Log::Fatal << error << "." << std::endl;
+    else
+      Log::Warn << error << "; load failed." << std::endl;
+
+    return false;
+  }
+
+  // Duplicate indices in a line are summed.
+  matrix = arma::SpMat<eT>(true, locations, values,
+      (dimensionality == 0) ? maxIndex : dimensionality, labelValues.size());
+  labels = arma::conv_to<arma::Row<LabelType>>::from(labelValues);
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -55,25 +55,71 @@ bool Load(const std::string& filename,
     }
   }
 
-  // Now load the given format.
-  std::ifstream ifs;
-#ifdef _WIN32 // Open non-text in binary mode on Windows.
+  // A binary model is read from memory: the file is mapped (or decompressed,
+  // if it is compressed), its checksum is checked, and the archive is read
+  // from the mapped pages, so matrices are copied straight out of them.
   if (f == format::binary)
-    ifs.open(filename, std::ifstream::in | std::ifstream::binary);
-  else
-    ifs.open(filename, std::ifstream::in);
-#else
-  ifs.open(filename, std::ifstream::in);
-#endif
+  {
+    MappedFile file(filename);
+    if (!file.IsOpen())
+    {
+      if (fatal)
+        Log::Fatal << "Unable to open file '" << filename << "' to load "
+            << "object '" << name << "'. " << file.Error() << std::endl;
+      else
+        Log::Warn << "Unable to open file '" << filename << "' to load "
+            << "object '" << name << "'. " << file.Error() << std::endl;
+
+      return false;
+    }
+
+    const char* archive = NULL;
+    size_t archiveSize = 0;
+    std::string error;
+    if (!ReadModelFile(file.Data(), file.Size(), archive, archiveSize, error))
+    {
+      if (fatal)
+        Log::Fatal << "Unable to load object '" << name << "' from '"
+            << filename << "': " << error << "." << std::endl;
+      else
+        Log::Warn << "Unable to load object '" << name << "' from '"
+            << filename << "': " << error << "." << std::endl;
+
+      return false;
+    }
+
+    try
+    {
+      MemoryStreamBuffer buffer(archive, archiveSize);
+      std::istream ifs(&buffer);
+      cereal::BinaryInputArchive ar(ifs);
+      ar(cereal::make_nvp(name.c_str(), t));
+      return true;
+    }
+    catch (cereal::Exception& e)
+    {
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
+
+  // Now load the given format.  A compressed file (.gz or .zst) is
+  // decompressed into memory first.
+  InputFile file(filename, std::ifstream::in);
+  std::istream& ifs = file.Stream();
 
-  if (!ifs.is_open())
+  if (!file.IsOpen())
   {
     if (fatal)
       Log::Fatal << "Unable to open file '" << filename << "' to load object '"
-          << name << "'." << std::endl;
+          << name << "'. " << file.Error() << std::endl;
     else
       Log::Warn << "Unable to open file '" << filename << "' to load object '"
-          << name << "'." << std::endl;
+          << name << "'. " << file.Error() << std::endl;
 
     return false;
   }
@@ -89,11 +135,6 @@ bool Load(const std::string& filename,
      cereal::JSONInputArchive ar(ifs);
      ar(cereal::make_nvp(name.c_str(), t));
     }
-    else if (f == format::binary)
-    {
-      cereal::BinaryInputArchive ar(ifs);
-      ar(cereal::make_nvp(name.c_str(), t));
-    }
 
     return true;
   }
@@ -175,6 +175,318 @@ bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x, std::fstream& f)
   return loadOkay;
 }
 
+template<typename eT>
+bool LoadCSV::ConvertToken(eT& val, const char* begin, const char* end)
+{
+  // Skip leading whitespace, as std::strtod() does.
+  while ((begin != end) && ((*begin == ' ') || (*begin == '\t')))
+    ++begin;
+
+  // Fill empty data points with 0.
+  if (begin == end)
+  {
+    val = eT(0);
+    return true;
+  }
+
+  // Checks for +/-INF and NAN.
+  const size_t N = size_t(end - begin);
+  if ((N == 3) || (N == 4))
+  {
+    const bool neg = (begin[0] == '-');
+    const bool pos = (begin[0] == '+');
+
+    const size_t offset = ((neg || pos) && (N == 4)) ? 1 : 0;
+
+    const char sigA = begin[offset];
+    const char sigB = begin[offset + 1];
+    const char sigC = begin[offset + 2];
+
+    if (((sigA == 'i') || (sigA == 'I')) &&
+        ((sigB == 'n') || (sigB == 'N')) &&
+        ((sigC == 'f') || (sigC == 'F')))
+    {
+      val = SafeNegInf<eT>(neg);
+      return true;
+    }
+    else if (((sigA == 'n') || (sigA == 'N')) &&
+             ((sigB == 'a') || (sigB == 'A')) &&
+             ((sigC == 'n') || (sigC == 'N')))
+    {
+      val = std::numeric_limits<eT>::quiet_NaN();
+      return true;
+    }
+  }
+
+  // std::from_chars() does not accept a leading '+'.
+  if ((*begin == '+') && (N > 1))
+    ++begin;
+
+  // Like std::strtod(), trailing characters after the number are ignored.  If
+  // std::from_chars() finds the number out of range, std::strtod() (or
+  // std::strtoll()) is used instead, since they saturate.
+  if (std::is_floating_point<eT>::value)
+  {
+#if defined(__cpp_lib_to_chars)
+    double d;
+    const std::from_chars_result result = std::from_chars(begin, end, d);
+    if (result.ec == std::errc())
+    {
+      val = eT(d);
+      return true;
+    }
+    else if (result.ec == std::errc::invalid_argument)
+    {
+      return false;
+    }
+#endif
+
+    // std::strtod() needs a null-terminated string.
+    const std::string token(begin, end);
+    char* endptr = nullptr;
+    val = eT(std::strtod(token.c_str(), &endptr));
+    return (endptr != token.c_str());
+  }
+  else if (std::is_integral<eT>::value)
+  {
+    if (std::is_signed<eT>::value)
+    {
+      long long i;
+      const std::from_chars_result result = std::from_chars(begin, end, i);
+      if (result.ec == std::errc())
+      {
+        val = eT(i);
+        return true;
+      }
+      else if (result.ec == std::errc::invalid_argument)
+      {
+        return false;
+      }
+
+      const std::string token(begin, end);
+      char* endptr = nullptr;
+      val = eT(std::strtoll(token.c_str(), &endptr, 10));
+      return (endptr != token.c_str());
+    }
+    else
+    {
+      // Negative numbers are converted to 0.
+      if (*begin == '-')
+      {
+        val = eT(0);
+        return true;
+      }
+
+      unsigned long long i;
+      const std::from_chars_result result = std::from_chars(begin, end, i);
+      if (result.ec == std::errc())
+      {
+        val = eT(i);
+        return true;
+      }
+      else if (result.ec == std::errc::invalid_argument)
+      {
+        return false;
+      }
+
+      const std::string token(begin, end);
+      char* endptr = nullptr;
+      val = eT(std::strtoull(token.c_str(), &endptr, 10));
+      return (endptr != token.c_str());
+    }
+  }
+
+  // If none of the above conditions was executed, then the conversion will
+  // fail.
+  return false;
+}
+
+template<typename eT>
+bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x,
+                             const std::string& filename,
+                             const size_t offset,
+                             const bool transpose)
+{
+  MappedFile file(filename);
+  if (!file.IsOpen())
+    return false;
+
+  return LoadNumericCSV(x, file, offset, transpose);
+}
+
+template<typename eT>
+bool LoadCSV::LoadNumericCSV(arma::Mat<eT>& x,
+                             const MappedFile& file,
+                             const size_t offset,
+                             const bool transpose)
+{
+  const size_t start = std::min(offset, file.Size());
+  const char* data = file.Data() + start;
+  const size_t size = file.Size() - start;
+
+  const std::vector<const char*> chunkBegin = LineChunks(data, size);
+  const size_t numChunks = chunkBegin.size() - 1;
+
+  // First pass: count the lines and the columns in each chunk.  As with the
+  // other overload, an empty line ends the data, and lines with fewer columns
+  // are filled with zeros.
+  std::vector<size_t> chunkLines(numChunks, 0);
+  std::vector<size_t> chunkCols(numChunks, 0);
+  std::vector<char> chunkEnded(numChunks, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const char* p = chunkBegin[c];
+    const char* end = chunkBegin[c + 1];
+    while (p < end)
+    {
+      const char* newline = (const char*) std::memchr(p, '\n', end - p);
+      const char* lineEnd = (newline == NULL) ? end : newline;
+      if ((lineEnd != p) && (*(lineEnd - 1) == '\r'))
+        --lineEnd;
+
+      if (lineEnd == p)
+      {
+        chunkEnded[c] = 1;
+        break;
+      }
+
+      const size_t lineCols = std::count(p, lineEnd, ',') + 1;
+      chunkCols[c] = std::max(chunkCols[c], lineCols);
+      ++chunkLines[c];
+      p = (newline == NULL) ? end : newline + 1;
+    }
+  }
+
+  // Compute the first row of each chunk, stopping at the first empty line.
+  std::vector<size_t> chunkRow(numChunks, 0);
+  size_t usedChunks = 0;
+  size_t rows = 0;
+  size_t cols = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkRow[c] = rows;
+    rows += chunkLines[c];
+    cols = std::max(cols, chunkCols[c]);
+    ++usedChunks;
+    if (chunkEnded[c])
+      break;
+  }
+
+  if (transpose)
+    x.set_size(cols, rows);
+  else
+    x.set_size(rows, cols);
+
+  // Second pass: convert the tokens of each chunk into its part of the matrix.
+  // Each chunk remembers its first failure, so that the first one in the file
+  // can be reported.
+  std::vector<size_t> failedRow(numChunks, rows);
+  std::vector<size_t> failedCol(numChunks, 0);
+  std::vector<std::string> failedToken(numChunks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < usedChunks; ++c)
+  {
+    const char* p = chunkBegin[c];
+    const char* end = chunkBegin[c + 1];
+    for (size_t line = 0; line < chunkLines[c]; ++line)
+    {
+      const char* newline = (const char*) std::memchr(p, '\n', end - p);
+      const char* lineEnd = (newline == NULL) ? end : newline;
+      if ((lineEnd != p) && (*(lineEnd - 1) == '\r'))
+        --lineEnd;
+
+      const size_t row = chunkRow[c] + line;
+      size_t col = 0;
+      const char* token = p;
+      while (true)
+      {
+        const char* comma = (const char*) std::memchr(token, ',',
+            lineEnd - token);
+        const char* tokenEnd = (comma == NULL) ? lineEnd : comma;
+
+        eT val = eT(0);
+        if (!ConvertToken<eT>(val, token, tokenEnd))
+        {
+          failedRow[c] = row;
+          failedCol[c] = col;
+          failedToken[c] = std::string(token, tokenEnd);
+          break;
+        }
+
+        if (transpose)
+          x.at(col, row) = val;
+        else
+          x.at(row, col) = val;
+        ++col;
+
+        if (comma == NULL)
+          break;
+        token = comma + 1;
+      }
+
+      if (failedRow[c] != rows)
+        break;
+
+      // Missing elements are filled with zeros.
+      for (; col < cols; ++col)
+      {
+        if (transpose)
+          x.at(col, row) = eT(0);
+        else
+          x.at(row, col) = eT(0);
+      }
+
+      p = (newline == NULL) ? end : newline + 1;
+    }
+  }
+
+  for (size_t c = 0; c < usedChunks; ++c)
+  {
+    if (failedRow[c] != rows)
+    {
+      // Printing failed token and it's location.
+      Log::Warn << "Failed to convert token " << failedToken[c] << ", at row "
+          << failedRow[c] << ", column " << failedCol[c] << " of matrix!"
+          << std::endl;
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline std::vector<const char*> LoadCSV::LineChunks(const char* data,
+                                                   const size_t size)
+{
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(4 * numThreads, size / (1 << 20)));
+
+  // Each chunk starts at the beginning of a line.
+  std::vector<const char*> chunkBegin(numChunks + 1);
+  chunkBegin[0] = data;
+  chunkBegin[numChunks] = data + size;
+  for (size_t c = 1; c < numChunks; ++c)
+  {
+    const char* guess = std::max(chunkBegin[c - 1],
+        data + c * (size / numChunks));
+    const char* newline = (const char*) std::memchr(guess, '\n',
+        (data + size) - guess);
+    chunkBegin[c] = (newline == NULL) ? data + size : newline + 1;
+  }
+
+  return chunkBegin;
+}
+
 inline void LoadCSV::NumericMatSize(std::stringstream& lineStream,
                                     size_t& col,
                                     const char delim)
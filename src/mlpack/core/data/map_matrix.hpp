@@ -0,0 +1,122 @@
+/**
+ * @file core/data/map_matrix.hpp
+ *
+ * Memory-map a matrix stored in the Armadillo binary or raw binary format, so
+ * that it can be used in place, without reading it into memory first.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_MATRIX_HPP
+#define MLPACK_CORE_DATA_MAP_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "arma_binary.hpp"
+#include "detect_file_type.hpp"
+#include "mapped_file.hpp"
+#include "types.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+class MappedMatrix;
+
+/**
+ * Memory-map a matrix stored in the Armadillo binary (arma_binary) or raw
+ * binary format into the given MappedMatrix.  The file is not read until the
+ * matrix is used, so this returns instantly even for very large files.
+ *
+ * The matrix is used in place as it is stored in the file, so it is not
+ * transposed; save the matrix with `transpose` set to false in data::Save() to
+ * map it.  The data must be aligned for the element type; Armadillo binary
+ * files written by data::Save() always are.  If it is not, or if the file
+ * cannot be mapped, the matrix is read into memory instead.
+ *
+ * @param filename Name of file to map.
+ * @param matrix MappedMatrix to map the file into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param copyOnWrite If true, the matrix may be modified; modified pages are
+ *     copied, and the file is not changed.
+ * @param type FileType::ArmaBinary, FileType::RawBinary, or
+ *     FileType::AutoDetect to detect the type from the header of the file.
+ * @param rows Number of rows of a raw binary matrix (which has no size
+ *     information); if 0, the matrix is a single column.
+ * @return Boolean value indicating success or failure of the mapping.
+ */
+template<typename eT>
+bool MapMatrix(const std::string& filename,
+               MappedMatrix<eT>& matrix,
+               const bool fatal = false,
+               const bool copyOnWrite = false,
+               const FileType type = FileType::AutoDetect,
+               const size_t rows = 0);
+
+/**
+ * A MappedMatrix holds a matrix whose memory is a memory-mapped file (see
+ * MapMatrix()).  Matrix() can be passed to any method that takes a matrix;
+ * its pages are read from the file when they are first accessed, and are
+ * shared with the page cache, so several processes mapping the same file use
+ * the memory only once.
+ *
+ * The matrix cannot be resized.  Unless the file was mapped with copy-on-write
+ * enabled, the matrix must not be modified either, so only a const reference
+ * is given by Matrix(); if copy-on-write is enabled, MutableMatrix() can be
+ * used, and modified pages are copied into private memory (the file is never
+ * modified).
+ *
+ * @tparam eT Element type of the matrix.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  //! Create an empty MappedMatrix; use MapMatrix() to map a file.
+  MappedMatrix() : matrix(new arma::Mat<eT>()), copyOnWrite(false) { }
+
+  //! Get the matrix.
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+
+  /**
+   * Get the matrix, to modify it.  This throws a std::logic_error if the file
+   * was not mapped with copy-on-write enabled.
+   */
+  arma::Mat<eT>& MutableMatrix()
+  {
+    if (file && file->IsMapped() && !copyOnWrite)
+    {
+      throw std::logic_error("MappedMatrix::MutableMatrix(): the file was "
+          "mapped read-only; map it with copyOnWrite = true to modify it");
+    }
+
+    return *matrix;
+  }
+
+  //! Return whether the matrix uses the mapped file directly (instead of a
+  //! copy of its data, which is made if the data is not aligned, or if the file
+  //! cannot be mapped).
+  bool IsMapped() const { return file && file->IsMapped(); }
+
+ private:
+  //! The mapped file, if its data is used in place.
+  std::unique_ptr<MappedFile> file;
+  //! The matrix (which uses the memory of the file, if it is mapped).
+  std::unique_ptr<arma::Mat<eT>> matrix;
+  //! Whether the file was mapped with copy-on-write.
+  bool copyOnWrite;
+
+  template<typename MatEType>
+  friend bool MapMatrix(const std::string&, MappedMatrix<MatEType>&,
+                        const bool, const bool, const FileType, const size_t);
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "map_matrix_impl.hpp"
+
+#endif
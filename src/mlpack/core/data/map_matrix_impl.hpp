@@ -0,0 +1,132 @@
+/**
+ * @file core/data/map_matrix_impl.hpp
+ *
+ * Implementation of MapMatrix().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_MAP_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "map_matrix.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+bool MapMatrix(const std::string& filename,
+               MappedMatrix<eT>& matrix,
+               const bool fatal,
+               const bool copyOnWrite,
+               const FileType inputType,
+               const size_t rows)
+{
+  Timer::Start("loading_data");
+
+  // The matrix is accessed in whatever order the method using it needs, so
+  // don't ask for sequential read-ahead.
+  std::unique_ptr<MappedFile> file(new MappedFile(filename, copyOnWrite,
+      false));
+  std::string error;
+  size_t nRows = 0, nCols = 0, offset = 0;
+  if (!file->IsOpen())
+  {
+    // A compressed file may fail to decompress.
+    error = file->Error().empty() ? "cannot open file" : file->Error();
+  }
+  else
+  {
+    FileType type = inputType;
+    if (type == FileType::AutoDetect)
+    {
+      // Raw binary files have no header to detect.
+      type = (file->Size() >= 12 &&
+          std::string(file->Data(), 12) == "ARMA_MAT_BIN") ?
+          FileType::ArmaBinary : FileType::RawBinary;
+    }
+
+    if (type == FileType::ArmaBinary)
+    {
+      ParseArmaBinaryHeader<eT>(file->Data(), file->Size(), nRows, nCols,
+          offset, error);
+    }
+    else if (type == FileType::RawBinary)
+    {
+      const size_t elements = file->Size() / sizeof(eT);
+      if (file->Size() % sizeof(eT) != 0)
+      {
+        error = "its size is not a multiple of the size of the element type";
+      }
+      else if (rows > 0 && elements % rows != 0)
+      {
+        std::ostringstream oss;
+        oss << "it holds " << elements << " elements, which is not a multiple "
+            << "of " << rows << " rows";
+        error = oss.str();
+      }
+      else
+      {
+        nRows = (rows > 0) ? rows : elements;
+        nCols = (rows > 0) ? elements / rows : 1;
+      }
+    }
+    else
+    {
+      error = "only Armadillo binary and raw binary files can be mapped";
+    }
+  }
+
+  if (!error.empty())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot map '" << filename << "': " << error << "."
+          << std::endl;
+    else
+      Log::Warn << "Cannot map '" << filename << "': " << error << "; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  char* data = file->Data() + offset;
+  if (file->IsMapped() && ((uintptr_t) data) % alignof(eT) == 0)
+  {
+    // Use the mapped memory in place; the matrix can't be resized.  The old
+    // matrix (if any) must be released before its file is.
+    matrix.matrix.reset(new arma::Mat<eT>(reinterpret_cast<eT*>(data), nRows,
+        nCols, false, true));
+    matrix.file = std::move(file);
+    Log::Info << "Mapped '" << filename << "'; size is " << nRows << " x "
+        << nCols << "." << std::endl;
+  }
+  else
+  {
+    if (file->IsMapped())
+    {
+      Log::Warn << "MapMatrix(): the data of '" << filename << "' is not "
+          << "aligned, so it will be read into memory; save it again with "
+          << "data::Save() to map it." << std::endl;
+    }
+
+    matrix.matrix.reset(new arma::Mat<eT>(nRows, nCols));
+    if (nRows * nCols > 0)
+      std::memcpy(matrix.matrix->memptr(), data, nRows * nCols * sizeof(eT));
+    matrix.file.reset();
+    Log::Info << "Loaded '" << filename << "'; size is " << nRows << " x "
+        << nCols << "." << std::endl;
+  }
+
+  matrix.copyOnWrite = copyOnWrite;
+  Timer::Stop("loading_data");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file core/data/mapped_file.hpp
+ *
+ * A read-only view of the contents of a file, which is memory-mapped when
+ * possible (or decompressed, if it is compressed).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MAPPED_FILE_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "compression.hpp"
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * MappedFile gives read-only access to the contents of a file.  On systems
+ * with mmap(), the file is mapped into memory, so pages are only read when
+ * they are accessed (and can be read by several threads at once); otherwise,
+ * or if the file cannot be mapped (for instance, if it is a pipe), the file is
+ * read into a buffer.
+ *
+ * Files compressed with gzip (.gz) or zstd (.zst) are decompressed into a
+ * buffer; Error() describes the problem if that fails.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Open the given file.  Use IsOpen() to check whether this succeeded.
+   *
+   * @param filename Name of the file to open.
+   * @param copyOnWrite If true, the mapped pages may be written to; written
+   *     pages are copied, so the file itself is never modified.
+   * @param sequential If true, the file will be read sequentially, so the
+   *     kernel may read ahead aggressively.
+   */
+  MappedFile(const std::string& filename,
+             const bool copyOnWrite = false,
+             const bool sequential = true) :
+      data(NULL),
+      size(0),
+      mapped(false),
+      open(false)
+  {
+    Open(filename, copyOnWrite, sequential);
+
+    const Compression compression = CompressionType(filename);
+    if (!open || compression == Compression::None)
+      return;
+
+    std::string contents;
+    const bool success = Decompress(data, size, compression, contents, error);
+    Release();
+    if (!success)
+    {
+      open = false;
+      return;
+    }
+
+    buffer = std::move(contents);
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  //! Release the file.
+  ~MappedFile() { Release(); }
+
+  // A MappedFile owns its mapping, so it cannot be copied.
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! Return whether the file was opened successfully.
+  bool IsOpen() const { return open; }
+  //! Return whether the file is memory-mapped (instead of read into memory).
+  bool IsMapped() const { return mapped; }
+  //! Get the contents of the file (not null-terminated).
+  const char* Data() const { return data; }
+  //! Get the contents of the file; only write to them if the file was opened
+  //! with copyOnWrite set to true.
+  char* Data() { return const_cast<char*>(data); }
+  //! Get the size of the file, in bytes.
+  size_t Size() const { return size; }
+  //! Get the reason a compressed file could not be decompressed (if it
+  //! couldn't).
+  const std::string& Error() const { return error; }
+
+ private:
+  //! Map or read the file, without decompressing it.
+  void Open(const std::string& filename,
+            const bool copyOnWrite,
+            const bool sequential)
+  {
+#if !defined(_WIN32)
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode))
+    {
+      size = (size_t) fileStat.st_size;
+      if (size == 0)
+      {
+        // An empty file cannot be mapped, but it is open.
+        ::close(fd);
+        open = true;
+        return;
+      }
+
+      // Pages that are never written are shared with the page cache (and so
+      // with other processes mapping the same file).
+      const int protection = copyOnWrite ? (PROT_READ | PROT_WRITE) :
+          PROT_READ;
+      void* address = mmap(NULL, size, protection, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED)
+      {
+        if (sequential)
+          posix_madvise(address, size, POSIX_MADV_SEQUENTIAL);
+        data = (const char*) address;
+        mapped = true;
+        open = true;
+      }
+    }
+    ::close(fd);
+
+    if (open)
+      return;
+#endif
+
+    // Read the whole file instead.
+    std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!stream.is_open())
+      return;
+
+    buffer.assign(std::istreambuf_iterator<char>(stream),
+        std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+    open = true;
+  }
+
+  //! Unmap the file or free its buffer.
+  void Release()
+  {
+#if !defined(_WIN32)
+    if (mapped)
+      munmap((void*) data, size);
+#endif
+    mapped = false;
+    buffer = std::string();
+    data = NULL;
+    size = 0;
+  }
+
+  //! The contents of the file.
+  const char* data;
+  //! The size of the file.
+  size_t size;
+  //! Whether the file is memory-mapped.
+  bool mapped;
+  //! Whether the file was opened successfully.
+  bool open;
+  //! The contents of the file, if it is not memory-mapped.
+  std::string buffer;
+  //! The reason decompression failed, if it did.
+  std::string error;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file core/data/model_file.hpp
+ *
+ * The container that binary models are saved in by data::Save(): a header, the
+ * cereal binary archive, and a trailer with the size and checksum of the
+ * archive, so that truncated or corrupted model files are detected when they
+ * are loaded.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MODEL_FILE_HPP
+#define MLPACK_CORE_DATA_MODEL_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <streambuf>
+
+namespace mlpack {
+namespace data {
+
+//! The first bytes of a binary model file.
+static const char ModelFileMagic[8] = { 'M', 'L', 'P', 'K', 'M', 'O', 'D',
+    'L' };
+//! The version of the binary model file container.
+static const uint64_t ModelFileVersion = 1;
+//! The size of the header: the magic bytes and the version.
+static const size_t ModelFileHeaderSize = 16;
+//! The size of the trailer: the size and the checksum of the archive.
+static const size_t ModelFileTrailerSize = 16;
+//! The archive is checksummed in blocks of this size, so that the checksum of
+//! a file can be computed in parallel.
+static const size_t ModelChecksumBlockSize = 1 << 20;
+
+namespace details {
+
+//! Mix the given value into the given hash.
+inline uint64_t MixChecksum(uint64_t hash, const uint64_t value)
+{
+  hash = (hash ^ value) * 0xff51afd7ed558ccdULL;
+  return hash ^ (hash >> 32);
+}
+
+//! Compute the checksum of one block of the archive.
+inline uint64_t ChecksumBlock(const char* data, const size_t size)
+{
+  uint64_t hash = MixChecksum(0x9e3779b97f4a7c15ULL, size);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8)
+  {
+    uint64_t word;
+    std::memcpy(&word, data + i, 8);
+    hash = MixChecksum(hash, word);
+  }
+
+  if (i < size)
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, data + i, size - i);
+    hash = MixChecksum(hash, word);
+  }
+
+  return hash;
+}
+
+} // namespace details
+
+/**
+ * Compute the checksum of a model archive.  The archive is split into blocks of
+ * ModelChecksumBlockSize bytes, whose checksums are computed in parallel and
+ * then combined in order; the result does not depend on the number of threads.
+ */
+inline uint64_t ModelChecksum(const char* data, const size_t size)
+{
+  const size_t numBlocks = (size + ModelChecksumBlockSize - 1) /
+      ModelChecksumBlockSize;
+  std::vector<uint64_t> blockChecksums(numBlocks);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * ModelChecksumBlockSize;
+    const size_t end = std::min(size, begin + ModelChecksumBlockSize);
+    blockChecksums[b] = details::ChecksumBlock(data + begin, end - begin);
+  }
+
+  uint64_t checksum = 0;
+  for (size_t b = 0; b < numBlocks; ++b)
+    checksum = details::MixChecksum(checksum, blockChecksums[b]);
+
+  return checksum;
+}
+
+/**
+ * Find the archive in the contents of a binary model file.  Files written by
+ * older versions of mlpack hold only the archive; otherwise the header is
+ * checked, and the checksum of the archive is compared to the one in the
+ * trailer.  Returns false and sets `error` if the file is invalid.
+ *
+ * @param data Contents of the file.
+ * @param size Size of the file, in bytes.
+ * @param archive Set to the start of the archive.
+ * @param archiveSize Set to the size of the archive.
+ * @param error Set to a description of the problem, on failure.
+ */
+inline bool ReadModelFile(const char* data,
+                          const size_t size,
+                          const char*& archive,
+                          size_t& archiveSize,
+                          std::string& error)
+{
+  if (size < sizeof(ModelFileMagic) ||
+      std::memcmp(data, ModelFileMagic, sizeof(ModelFileMagic)) != 0)
+  {
+    archive = data;
+    archiveSize = size;
+    return true;
+  }
+
+  if (size < ModelFileHeaderSize + ModelFileTrailerSize)
+  {
+    error = "the file is truncated";
+    return false;
+  }
+
+  uint64_t version, storedSize, storedChecksum;
+  std::memcpy(&version, data + 8, 8);
+  std::memcpy(&storedSize, data + size - 16, 8);
+  std::memcpy(&storedChecksum, data + size - 8, 8);
+  if (version > ModelFileVersion)
+  {
+    std::ostringstream oss;
+    oss << "the file has version " << version << ", but this version of "
+        << "mlpack can only read files up to version " << ModelFileVersion;
+    error = oss.str();
+    return false;
+  }
+
+  archive = data + ModelFileHeaderSize;
+  archiveSize = size - ModelFileHeaderSize - ModelFileTrailerSize;
+  if (storedSize != archiveSize)
+  {
+    error = "the file is truncated or has extra data";
+    return false;
+  }
+
+  if (ModelChecksum(archive, archiveSize) != storedChecksum)
+  {
+    error = "the checksum does not match; the file is corrupted";
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * ModelFileWriter is an output stream buffer that writes a binary model file
+ * to another stream: the header when it is created, then everything written
+ * to it (the archive), and the trailer when Finish() is called.  The checksum
+ * is computed as the archive is written.
+ */
+class ModelFileWriter : public std::streambuf
+{
+ public:
+  //! Write the header to the given stream.
+  ModelFileWriter(std::ostream& out) :
+      out(out),
+      size(0),
+      checksum(0),
+      buffer(ModelChecksumBlockSize)
+  {
+    out.write(ModelFileMagic, sizeof(ModelFileMagic));
+    out.write((const char*) &ModelFileVersion, sizeof(ModelFileVersion));
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  //! Write the rest of the archive and the trailer.  Returns false if any
+  //! write failed.
+  bool Finish()
+  {
+    WriteBlock();
+    const uint64_t archiveSize = size;
+    out.write((const char*) &archiveSize, sizeof(archiveSize));
+    out.write((const char*) &checksum, sizeof(checksum));
+    return out.good();
+  }
+
+ protected:
+  //! Write the full block, and start the next one.
+  int_type overflow(int_type c) override
+  {
+    WriteBlock();
+    if (!out.good())
+      return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+
+ private:
+  //! Add the block in the buffer to the checksum and write it.  Only the last
+  //! block may be smaller than ModelChecksumBlockSize, as ModelChecksum()
+  //! expects.
+  void WriteBlock()
+  {
+    const size_t blockSize = pptr() - pbase();
+    if (blockSize > 0)
+    {
+      checksum = details::MixChecksum(checksum,
+          details::ChecksumBlock(pbase(), blockSize));
+      out.write(pbase(), blockSize);
+      size += blockSize;
+    }
+
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  //! The stream the file is written to.
+  std::ostream& out;
+  //! The size of the archive written so far.
+  uint64_t size;
+  //! The checksum of the archive written so far.
+  uint64_t checksum;
+  //! The current block of the archive.
+  std::vector<char> buffer;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -38,14 +38,22 @@ void OneHotEncoding(const RowType& labelsIn,
  * and also a vector of indices to encode and outputs a matrix.
  * Indices represent the IDs of the dimensions to be one-hot encoded.
  *
+ * The output may be dense (arma::Mat<eT>) or sparse (arma::SpMat<eT>); a
+ * sparse output only holds the nonzero values, so it is much smaller when the
+ * encoded dimensions have many categories.
+ *
  * @param input Input dataset to be encoded.
  * @param indices Index of rows to be encoded.
- * @param output Encoded matrix.
+ * @param output Encoded matrix (dense or sparse).
  */
-template<typename eT>
+template<typename eT, typename OutputMatType>
 void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
-                    arma::Mat<eT>& output);
+                    OutputMatType& output,
+                    const typename std::enable_if_t<
+                        std::is_same<OutputMatType, arma::Mat<eT>>::value ||
+                        std::is_same<OutputMatType, arma::SpMat<eT>>::value
+                    >* = 0);
 
 /**
  * Overloaded function for the above function, which takes a matrix as input
@@ -53,14 +61,25 @@ void OneHotEncoding(const arma::Mat<eT>& input,
  * This function encodes all the dimensions marked `Datatype::categorical`
  * in the data::DatasetInfo.
  *
+ * Each categorical dimension is encoded with the mappings of the DatasetInfo
+ * (so it takes `datasetInfo.NumMappings()` dimensions of the output), and not
+ * with the values that appear in the input.  This means that separate batches
+ * of a dataset (such as a training and a test set, or the chunks of a dataset
+ * that does not fit in memory) that are mapped with the same DatasetInfo are
+ * all encoded the same way.
+ *
  * @param input Input dataset to be encoded.
- * @param output Encoded matrix.
+ * @param output Encoded matrix (dense or sparse).
  * @param datasetInfo DatasetInfo object that has information about data.
  */
-template<typename eT>
+template<typename eT, typename OutputMatType>
 void OneHotEncoding(const arma::Mat<eT>& input,
-                    arma::Mat<eT>& output,
-                    const data::DatasetInfo& datasetInfo);
+                    OutputMatType& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const typename std::enable_if_t<
+                        std::is_same<OutputMatType, arma::Mat<eT>>::value ||
+                        std::is_same<OutputMatType, arma::SpMat<eT>>::value
+                    >* = 0);
 
 } // namespace data
 } // namespace mlpack
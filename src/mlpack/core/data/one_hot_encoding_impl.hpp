@@ -65,82 +65,268 @@ void OneHotEncoding(const RowType& labelsIn,
   labelMap.clear();
 }
 
+namespace details {
+
 /**
- * Overloaded function for the above function, which takes a matrix as input
- * and also a vector of indices to encode and outputs a matrix.
- * Indices represent the IDs of the dimensions to be one-hot encoded.
- *
- * @param input Input dataset to be encoded.
- * @param indices Index of rows to be encoded.
- * @param output Encoded matrix.
+ * The encoding of one dimension of the input: either it is copied as it is, or
+ * each of its values is mapped to one of `size` consecutive dimensions of the
+ * output, starting at `offset`.  The values are mapped with `mapping`, in the
+ * order they first appear in the input, unless `direct` is set, in which case
+ * the values are already categories in [0, size) (as set by a DatasetInfo).
  */
 template<typename eT>
-void OneHotEncoding(const arma::Mat<eT>& input,
-                    const arma::Col<size_t>& indices,
-                    arma::Mat<eT>& output)
+struct OneHotDimension
 {
-  // Handle the edge case where there is nothing to encode.
-  if (indices.n_elem == 0)
+  OneHotDimension() : encoded(false), direct(false), size(1), offset(0) { }
+
+  //! Return the dimension of the output that the given value maps to.
+  size_t Index(const eT value) const
   {
-    output = input;
-    return;
+    if (!encoded)
+      return offset;
+    else if (direct)
+      return offset + (size_t) value;
+    else
+      return offset + mapping.find(value)->second;
   }
 
-  // First, we need to compute the size of the output matrix.
+  //! Whether the dimension is one-hot encoded.
+  bool encoded;
+  //! Whether the values are already categories.
+  bool direct;
+  //! The mapping from values to categories.
+  std::unordered_map<eT, size_t> mapping;
+  //! The number of dimensions of the output.
+  size_t size;
+  //! The first dimension of the output.
+  size_t offset;
+};
 
-  // This vector will eventually hold the offsets for each dimension in the
-  // one-hot encoded matrix, but first it will just hold the counts of
-  // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
-  // This will hold the mappings from a value that should be one-hot encoded to
-  // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+/**
+ * Compute the mappings of the encoded dimensions that are not direct, in
+ * parallel, and check the values of the direct ones; then compute the offsets
+ * of all dimensions.  Returns the number of dimensions of the output.
+ */
+template<typename eT>
+size_t PrepareOneHotDimensions(const arma::Mat<eT>& input,
+                               std::vector<OneHotDimension<eT>>& dimensions)
+{
+  std::vector<char> invalid(dimensions.size(), 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t row = 0; row < dimensions.size(); ++row)
+  {
+    OneHotDimension<eT>& dimension = dimensions[row];
+    if (!dimension.encoded)
+      continue;
+
+    for (size_t col = 0; col < input.n_cols; ++col)
+    {
+      const eT value = input(row, col);
+      const double category = (double) value;
+      if (std::isnan(category) || (dimension.direct && (category < 0.0 ||
+          category >= (double) dimension.size ||
+          std::floor(category) != category)))
+      {
+        invalid[row] = 1;
+        break;
+      }
+      else if (!dimension.direct && dimension.mapping.count(value) == 0)
+      {
+        const size_t category = dimension.mapping.size();
+        dimension.mapping[value] = category;
+      }
+    }
+
+    if (!dimension.direct)
+      dimension.size = dimension.mapping.size();
+  }
+
+  size_t offset = 0;
+  for (size_t row = 0; row < dimensions.size(); ++row)
+  {
+    if (invalid[row])
+    {
+      std::ostringstream oss;
+      oss << "OneHotEncoding(): dimension " << row << " has a value that is "
+          << "not a valid category";
+      if (dimensions[row].direct)
+        oss << " (it has " << dimensions[row].size << " categories)";
+      oss << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    dimensions[row].offset = offset;
+    offset += dimensions[row].size;
+  }
+
+  return offset;
+}
+
+//! Mark the given dimensions to be encoded by the order their values appear.
+template<typename eT>
+void SetOneHotIndices(const arma::Mat<eT>& input,
+                      const arma::Col<size_t>& indices,
+                      std::vector<OneHotDimension<eT>>& dimensions)
+{
+  dimensions.resize(input.n_rows);
   for (size_t i = 0; i < indices.n_elem; ++i)
   {
-    dimensionOffsets[indices[i]] = 0;
-    mappings.insert(
-        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+    if (indices[i] >= input.n_rows)
+    {
+      std::ostringstream oss;
+      oss << "OneHotEncoding(): cannot encode dimension " << indices[i]
+          << "; the input has only " << input.n_rows << " dimensions!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    dimensions[indices[i]].encoded = true;
+  }
+}
+
+//! Mark the categorical dimensions of the given DatasetInfo to be encoded with
+//! its mappings.
+template<typename eT>
+void SetOneHotIndices(const arma::Mat<eT>& input,
+                      const data::DatasetInfo& datasetInfo,
+                      std::vector<OneHotDimension<eT>>& dimensions)
+{
+  if (datasetInfo.Dimensionality() != input.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoding(): the DatasetInfo has "
+        << datasetInfo.Dimensionality() << " dimensions, but the input has "
+        << input.n_rows << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  dimensions.resize(input.n_rows);
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    if (datasetInfo.Type(i) != data::Datatype::categorical)
+      continue;
+
+    dimensions[i].encoded = true;
+    // A dimension that was marked categorical by hand has no mappings; its
+    // values are mapped in the order they appear instead.
+    if (datasetInfo.NumMappings(i) > 0)
+    {
+      dimensions[i].direct = true;
+      dimensions[i].size = datasetInfo.NumMappings(i);
+    }
+  }
+}
+
+//! Encode the input into a dense matrix, one column at a time in parallel.
+template<typename eT>
+void OneHotEncodeDimensions(const arma::Mat<eT>& input,
+                            const std::vector<OneHotDimension<eT>>& dimensions,
+                            const size_t outputDimensions,
+                            arma::Mat<eT>& output)
+{
+  output.zeros(outputDimensions, input.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const OneHotDimension<eT>& dimension = dimensions[row];
+      const eT value = input(row, col);
+      output(dimension.Index(value), col) = (dimension.encoded) ? eT(1) :
+          value;
+    }
   }
+}
 
+//! Encode the input into a sparse matrix.  The number of nonzero elements of
+//! each column is counted first, so that the columns can be filled in
+//! parallel.
+template<typename eT>
+void OneHotEncodeDimensions(const arma::Mat<eT>& input,
+                            const std::vector<OneHotDimension<eT>>& dimensions,
+                            const size_t outputDimensions,
+                            arma::SpMat<eT>& output)
+{
+  arma::uvec colPtrs(input.n_cols + 1);
+  colPtrs[0] = 0;
+
+  #pragma omp parallel for schedule(static)
   for (size_t col = 0; col < input.n_cols; ++col)
   {
+    size_t nonzeros = 0;
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      if (mappings.count(row) != 0)
-      {
-        // We have to one-hot encode this point.
-        if (mappings[row].count(input(row, col)) == 0)
-          mappings[row][input(row, col)] = dimensionOffsets[row]++;
-      }
+      if (dimensions[row].encoded || input(row, col) != eT(0))
+        ++nonzeros;
     }
+    colPtrs[col + 1] = nonzeros;
   }
 
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
-  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
-    dimensionOffsets[i] += dimensionOffsets[i - 1];
+  for (size_t col = 0; col < input.n_cols; ++col)
+    colPtrs[col + 1] += colPtrs[col];
 
-  // Now, initialize the output matrix to the right size.
-  output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+  arma::uvec rowIndices(colPtrs[input.n_cols]);
+  arma::Col<eT> values(colPtrs[input.n_cols]);
 
-  // Finally, one-hot encode the matrix.
+  // The dimensions are in increasing order of offset, so the row indices of
+  // each column are sorted.
+  #pragma omp parallel for schedule(static)
   for (size_t col = 0; col < input.n_cols; ++col)
   {
+    size_t k = colPtrs[col];
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
-      if (mappings.count(row) != 0)
-      {
-        output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
-      }
-      else
-      {
-        // No need for one-hot encoding.
-        output(dimOffset, col) = input(row, col);
-      }
+      const OneHotDimension<eT>& dimension = dimensions[row];
+      const eT value = input(row, col);
+      if (!dimension.encoded && value == eT(0))
+        continue;
+
+      rowIndices[k] = dimension.Index(value);
+      values[k] = (dimension.encoded) ? eT(1) : value;
+      ++k;
     }
   }
+
+  output = arma::SpMat<eT>(rowIndices, colPtrs, values, outputDimensions,
+      input.n_cols);
+}
+
+} // namespace details
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a matrix.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.
+ *
+ * The mapping of each dimension is computed in parallel, and then the columns
+ * of the output are filled in parallel.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded matrix (dense or sparse).
+ */
+template<typename eT, typename OutputMatType>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    OutputMatType& output,
+                    const typename std::enable_if_t<
+                        std::is_same<OutputMatType, arma::Mat<eT>>::value ||
+                        std::is_same<OutputMatType, arma::SpMat<eT>>::value
+                    >*)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = OutputMatType(input);
+    return;
+  }
+
+  std::vector<details::OneHotDimension<eT>> dimensions;
+  details::SetOneHotIndices(input, indices, dimensions);
+  const size_t outputDimensions = details::PrepareOneHotDimensions(input,
+      dimensions);
+  details::OneHotEncodeDimensions(input, dimensions, outputDimensions, output);
 }
 
 /**
@@ -149,24 +335,28 @@ void OneHotEncoding(const arma::Mat<eT>& input,
  * This function encodes all the dimensions marked `Datatype::categorical`
  * in the data::DatasetInfo.
  *
+ * Each categorical dimension is encoded with the mappings of the DatasetInfo,
+ * not the values that appear in the input, so batches of a dataset that are
+ * mapped with the same DatasetInfo are all encoded the same way.
+ *
  * @param input Input dataset to be encoded.
- * @param output Encoded matrix.
+ * @param output Encoded matrix (dense or sparse).
  * @param datasetInfo DatasetInfo object that has information about data.
  */
-template<typename eT>
+template<typename eT, typename OutputMatType>
 void OneHotEncoding(const arma::Mat<eT>& input,
-                    arma::Mat<eT>& output,
-                    const data::DatasetInfo& datasetInfo)
+                    OutputMatType& output,
+                    const data::DatasetInfo& datasetInfo,
+                    const typename std::enable_if_t<
+                        std::is_same<OutputMatType, arma::Mat<eT>>::value ||
+                        std::is_same<OutputMatType, arma::SpMat<eT>>::value
+                    >*)
 {
-  std::vector<size_t> indices;
-  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
-  {
-    if (datasetInfo.Type(i) == data::Datatype::categorical)
-    {
-      indices.push_back(i);
-    }
-  }
-  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+  std::vector<details::OneHotDimension<eT>> dimensions;
+  details::SetOneHotIndices(input, datasetInfo, dimensions);
+  const size_t outputDimensions = details::PrepareOneHotDimensions(input,
+      dimensions);
+  details::OneHotEncodeDimensions(input, dimensions, outputDimensions, output);
 }
 
 } // namespace data
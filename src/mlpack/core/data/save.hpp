@@ -18,10 +18,15 @@
 #include <mlpack/core/util/log.hpp>
 #include <string>
 
+#include "arma_binary.hpp"
+#include "compressed_file.hpp"
 #include "format.hpp"
 #include "image_info.hpp"
+#include "model_file.hpp"
 #include "detect_file_type.hpp"
+#include "save_arrow.hpp"
 #include "save_image.hpp"
+#include "save_libsvm.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices. */ {
@@ -42,6 +47,10 @@ namespace data /** Functions to load and save matrices. */ {
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf5, .hdf, .h5, or .he5
  *
+ * If the filename ends in .gz or .zst, the file is compressed with gzip or
+ * zstd (if mlpack was compiled with zlib or zstd support); the format is then
+ * given by the rest of the name (e.g. "data.csv.gz").
+ *
  * By default, this function will try to automatically determine the format to
  * save with based only on the filename's extension.  If you would prefer to
  * specify a file type manually, override the default
@@ -79,6 +88,8 @@ bool Save(const std::string& filename,
  *  - TXT (coord_ascii), denoted by .txt
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - libsvm, denoted by .svm, .libsvm, or .svmlight; the last row of the
+ *    (transposed, if 'transpose' is false) matrix is saved as the labels
  *
  * If the file extension is not one of those types, an error will be given.  If
  * the 'fatal' parameter is set to true, a std::runtime_error exception will be
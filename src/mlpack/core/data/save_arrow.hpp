@@ -0,0 +1,64 @@
+/**
+ * @file core/data/save_arrow.hpp
+ *
+ * Save a matrix as a table in the Apache Arrow IPC (Feather v2) or Parquet
+ * format, via the Apache Arrow library.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_ARROW_HPP
+#define MLPACK_CORE_DATA_SAVE_ARROW_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "detect_file_type.hpp"
+#include "load_arrow.hpp" // For details::CheckArrowStatus().
+#include "types.hpp"
+
+#ifdef MLPACK_HAS_ARROW
+  #include <arrow/api.h>
+  #include <arrow/io/file.h>
+  #include <arrow/ipc/writer.h>
+  #include <parquet/arrow/writer.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Save the given matrix as an Arrow IPC (Feather v2) or Parquet file.  With
+ * `transpose` set to true (the default), each column of the matrix is a row of
+ * the table, as for CSV files.  Each column of the table has the element type
+ * of the matrix.
+ *
+ * This requires mlpack to be configured with Arrow support (MLPACK_HAS_ARROW,
+ * and linking against the Arrow and Parquet libraries).
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, each column of the matrix is a row of the table.
+ * @param columns Names of the columns of the table (default: "0", "1", ...).
+ * @param type FileType::ArrowIPC, FileType::Parquet, or FileType::AutoDetect to
+ *     detect the type with the extension of the file.
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool SaveArrow(const std::string& filename,
+               const arma::Mat<eT>& matrix,
+               const bool fatal = false,
+               const bool transpose = true,
+               const std::vector<std::string>& columns =
+                   std::vector<std::string>(),
+               const FileType type = FileType::AutoDetect);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "save_arrow_impl.hpp"
+
+#endif
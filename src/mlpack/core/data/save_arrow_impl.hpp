@@ -0,0 +1,203 @@
+/**
+ * @file core/data/save_arrow_impl.hpp
+ *
+ * Implementation of SaveArrow().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_ARROW_IMPL_HPP
+#define MLPACK_CORE_DATA_SAVE_ARROW_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "save_arrow.hpp"
+
+namespace mlpack {
+namespace data {
+
+#ifdef MLPACK_HAS_ARROW
+
+namespace details {
+
+/**
+ * The Arrow type of integers of the given size and signedness.  (This does not
+ * use arrow::CTypeTraits, since e.g. `long long` and `int64_t` may be
+ * different types of the same size.)
+ */
+template<size_t Bytes, bool Signed>
+struct ArrowIntegerType { };
+
+template<> struct ArrowIntegerType<1, true> { typedef arrow::Int8Type type; };
+template<> struct ArrowIntegerType<2, true> { typedef arrow::Int16Type type; };
+template<> struct ArrowIntegerType<4, true> { typedef arrow::Int32Type type; };
+template<> struct ArrowIntegerType<8, true> { typedef arrow::Int64Type type; };
+template<> struct ArrowIntegerType<1, false> { typedef arrow::UInt8Type type; };
+template<> struct ArrowIntegerType<2, false>
+{ typedef arrow::UInt16Type type; };
+template<> struct ArrowIntegerType<4, false>
+{ typedef arrow::UInt32Type type; };
+template<> struct ArrowIntegerType<8, false>
+{ typedef arrow::UInt64Type type; };
+
+//! The Arrow type of the given element type.
+template<typename eT, bool IsFloat = std::is_floating_point<eT>::value>
+struct ArrowTypeOf
+{
+  typedef typename ArrowIntegerType<sizeof(eT),
+      std::is_signed<eT>::value>::type type;
+};
+
+template<typename eT>
+struct ArrowTypeOf<eT, true>
+{
+  typedef typename std::conditional<sizeof(eT) == sizeof(float),
+      arrow::FloatType, arrow::DoubleType>::type type;
+};
+
+/**
+ * Save the matrix, throwing an exception on any error.
+ */
+template<typename eT>
+void SaveArrowTable(const std::string& filename,
+                    const arma::Mat<eT>& matrix,
+                    const bool transpose,
+                    const std::vector<std::string>& columns,
+                    const FileType inputType)
+{
+  typedef typename ArrowTypeOf<eT>::type ArrowType;
+  typedef typename ArrowType::c_type CType;
+  static_assert(sizeof(CType) == sizeof(eT),
+      "SaveArrow(): no Arrow type matches the element type of the matrix");
+
+  const FileType type = (inputType == FileType::AutoDetect) ?
+      DetectFromExtension(filename) : inputType;
+  if (type != FileType::ArrowIPC && type != FileType::Parquet)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is not an Arrow IPC or Parquet file";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t dimensions = transpose ? matrix.n_rows : matrix.n_cols;
+  const size_t points = transpose ? matrix.n_cols : matrix.n_rows;
+  if (!columns.empty() && columns.size() != dimensions)
+  {
+    std::ostringstream oss;
+    oss << columns.size() << " column names given, but the data has "
+        << dimensions << " dimensions";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const std::string error = "cannot save '" + filename + "'";
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    arrow::NumericBuilder<ArrowType> builder;
+    if (transpose)
+    {
+      // Each dimension is a row of the matrix, so it must be gathered first.
+      const arma::Row<eT> row = matrix.row(d);
+      CheckArrowStatus(builder.AppendValues(
+          reinterpret_cast<const CType*>(row.memptr()), points), error);
+    }
+    else
+    {
+      CheckArrowStatus(builder.AppendValues(
+          reinterpret_cast<const CType*>(matrix.colptr(d)), points), error);
+    }
+
+    std::shared_ptr<arrow::Array> array;
+    CheckArrowStatus(builder.Finish(&array), error);
+    arrays.push_back(array);
+    fields.push_back(arrow::field(columns.empty() ? std::to_string(d) :
+        columns[d], array->type()));
+  }
+
+  const std::shared_ptr<arrow::Schema> schema = arrow::schema(fields);
+  const std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema,
+      arrays, points);
+
+  arrow::Result<std::shared_ptr<arrow::io::FileOutputStream>> output =
+      arrow::io::FileOutputStream::Open(filename);
+  CheckArrowStatus(output.status(), error);
+
+  if (type == FileType::ArrowIPC)
+  {
+    arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchWriter>> writer =
+        arrow::ipc::MakeFileWriter(*output, schema);
+    CheckArrowStatus(writer.status(), error);
+    CheckArrowStatus((*writer)->WriteTable(*table), error);
+    CheckArrowStatus((*writer)->Close(), error);
+  }
+  else
+  {
+    // Row groups of a million points keep the column chunks large enough to
+    // be read efficiently.
+    CheckArrowStatus(parquet::arrow::WriteTable(*table,
+        arrow::default_memory_pool(), *output, 1 << 20), error);
+  }
+
+  CheckArrowStatus((*output)->Close(), error);
+}
+
+} // namespace details
+
+template<typename eT>
+bool SaveArrow(const std::string& filename,
+               const arma::Mat<eT>& matrix,
+               const bool fatal,
+               const bool transpose,
+               const std::vector<std::string>& columns,
+               const FileType type)
+{
+  try
+  {
+    details::SaveArrowTable(filename, matrix, transpose, columns, type);
+  }
+  catch (std::exception& e)
+  {
+    if (fatal)
+      Log::Fatal << "SaveArrow(): " << e.what() << "." << std::endl;
+    else
+      Log::Warn << "SaveArrow(): " << e.what() << "; save failed."
+          << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+#else // MLPACK_HAS_ARROW
+
+template<typename eT>
+bool SaveArrow(const std::string& /* filename */,
+               const arma::Mat<eT>& /* matrix */,
+               const bool fatal,
+               const bool /* transpose */,
+               const std::vector<std::string>& /* columns */,
+               const FileType /* type */)
+{
+  if (fatal)
+  {
+    Log::Fatal << "SaveArrow(): mlpack was not compiled with Arrow support, so "
+        << "Arrow IPC and Parquet files cannot be saved!" << std::endl;
+  }
+  else
+  {
+    Log::Warn << "SaveArrow(): mlpack was not compiled with Arrow support, so "
+        << "Arrow IPC and Parquet files cannot be saved!" << std::endl;
+  }
+
+  return false;
+}
+
+#endif // MLPACK_HAS_ARROW
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -69,14 +69,44 @@ bool Save(const std::string& filename,
 
   stringType = GetStringType(saveType);
 
-  // Catch errors opening the file.
-  std::fstream stream;
+  // Arrow, Parquet and HDF5 files are written by their libraries, which need
+  // the file itself.
+  if (CompressionType(filename) != Compression::None &&
+      (saveType == FileType::ArrowIPC || saveType == FileType::Parquet ||
+       saveType == FileType::HDF5Binary))
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Cannot save to '" << filename << "': compressed "
+          << stringType << " files are not supported." << std::endl;
+    else
+      Log::Warn << "Cannot save to '" << filename << "': compressed "
+          << stringType << " files are not supported; save failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // Arrow IPC and Parquet files are written by Arrow.
+  if (saveType == FileType::ArrowIPC || saveType == FileType::Parquet)
+  {
+    Log::Info << "Saving " << stringType << " to '" << filename << "'."
+        << std::endl;
+    const bool success = SaveArrow(filename, matrix, fatal, transpose,
+        std::vector<std::string>(), saveType);
+    Timer::Stop("saving_data");
+    return success;
+  }
+
+  // Catch errors opening the file.  The file is compressed if its name ends in
+  // .gz or .zst.
 #ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::out | std::fstream::binary);
+  OutputFile file(filename, std::fstream::out | std::fstream::binary);
 #else
-  stream.open(filename.c_str(), std::fstream::out);
+  OutputFile file(filename, std::fstream::out);
 #endif
-  if (!stream.is_open())
+  std::ostream& stream = file.Stream();
+  if (!file.IsOpen())
   {
     Timer::Stop("saving_data");
     if (fatal)
@@ -102,9 +132,12 @@ bool Save(const std::string& filename,
     // We can't save with streams for HDF5.
     const bool success = (saveType == FileType::HDF5Binary) ?
         tmp.save(filename, ToArmaFileType(saveType)) :
+        (saveType == FileType::ArmaBinary) ? SaveArmaBinary(stream, tmp) :
         tmp.save(stream, ToArmaFileType(saveType));
 #else
-    const bool success = tmp.save(stream, ToArmaFileType(saveType));
+    const bool success = (saveType == FileType::ArmaBinary) ?
+        SaveArmaBinary(stream, tmp) :
+        tmp.save(stream, ToArmaFileType(saveType));
 #endif
     if (!success)
     {
@@ -123,9 +156,14 @@ bool Save(const std::string& filename,
     // We can't save with streams for HDF5.
     const bool success = (saveType == FileType::HDF5Binary) ?
         matrix.save(filename, ToArmaFileType(saveType)) :
+        (saveType == FileType::ArmaBinary) ? SaveArmaBinary(stream, matrix) :
         matrix.save(stream, ToArmaFileType(saveType));
 #else
-    const bool success = matrix.save(stream, ToArmaFileType(saveType));
+    // Armadillo binary files are written with aligned data, so that they can
+    // be mapped with MapMatrix().
+    const bool success = (saveType == FileType::ArmaBinary) ?
+        SaveArmaBinary(stream, matrix) :
+        matrix.save(stream, ToArmaFileType(saveType));
 #endif
     if (!success)
     {
@@ -139,6 +177,21 @@ bool Save(const std::string& filename,
     }
   }
 
+  // Finish the file (compressing the rest, if it is compressed).
+  std::string error;
+  if (!file.Close(error))
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+
+    return false;
+  }
+
   Timer::Stop("saving_data");
 
   // Finally return success.
@@ -169,14 +222,46 @@ bool Save(const std::string& filename,
     return false;
   }
 
-  // Catch errors opening the file.
-  std::fstream stream;
+  // libsvm files are written by SaveLibSVM(); the last row (or column, if not
+  // transposing) of the matrix holds the labels.
+  if (DetectFromExtension(filename) == FileType::LibSVM)
+  {
+    Log::Info << "Saving " << GetStringType(FileType::LibSVM) << " to '"
+        << filename << "'." << std::endl;
+
+    const arma::SpMat<eT> points = transpose ? arma::SpMat<eT>(matrix) :
+        arma::SpMat<eT>(matrix.t());
+    if (points.n_rows == 0)
+    {
+      Timer::Stop("saving_data");
+      if (fatal)
+        Log::Fatal << "Cannot save a matrix with no labels to '" << filename
+            << "'.  Save failed." << std::endl;
+      else
+        Log::Warn << "Cannot save a matrix with no labels to '" << filename
+            << "'.  Save failed." << std::endl;
+
+      return false;
+    }
+
+    const arma::Row<eT> labels(points.row(points.n_rows - 1));
+    const arma::SpMat<eT> features = (points.n_rows == 1) ?
+        arma::SpMat<eT>(0, points.n_cols) :
+        arma::SpMat<eT>(points.rows(0, points.n_rows - 2));
+    const bool success = SaveLibSVM(filename, features, labels, fatal);
+    Timer::Stop("saving_data");
+    return success;
+  }
+
+  // Catch errors opening the file.  The file is compressed if its name ends in
+  // .gz or .zst.
 #ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::out | std::fstream::binary);
+  OutputFile file(filename, std::fstream::out | std::fstream::binary);
 #else
-  stream.open(filename.c_str(), std::fstream::out);
+  OutputFile file(filename, std::fstream::out);
 #endif
-  if (!stream.is_open())
+  std::ostream& stream = file.Stream();
+  if (!file.IsOpen())
   {
     Timer::Stop("saving_data");
     if (fatal)
@@ -248,6 +333,21 @@ bool Save(const std::string& filename,
     return false;
   }
 
+  // Finish the file (compressing the rest, if it is compressed).
+  std::string error;
+  if (!file.Close(error))
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+
+    return false;
+  }
+
   Timer::Stop("saving_data");
 
   // Finally return success.
@@ -286,18 +386,18 @@ bool Save(const std::string& filename,
     }
   }
 
-  // Open the file to save to.
-  std::ofstream ofs;
+  // Open the file to save to; it is compressed if its name ends in .gz or
+  // .zst.
 #ifdef _WIN32
-  if (f == format::binary) // Open non-text types in binary mode on Windows.
-    ofs.open(filename, std::ofstream::out | std::ofstream::binary);
-  else
-    ofs.open(filename, std::ofstream::out);
+  // Open non-text types in binary mode on Windows.
+  OutputFile file(filename, (f == format::binary) ?
+      (std::ofstream::out | std::ofstream::binary) : std::ofstream::out);
 #else
-  ofs.open(filename, std::ofstream::out);
+  OutputFile file(filename, std::ofstream::out);
 #endif
+  std::ostream& ofs = file.Stream();
 
-  if (!ofs.is_open())
+  if (!file.IsOpen())
   {
     if (fatal)
       Log::Fatal << "Unable to open file '" << filename << "' to save object '"
@@ -323,11 +423,16 @@ bool Save(const std::string& filename,
     }
     else if (f == format::binary)
     {
-      cereal::BinaryOutputArchive ar(ofs);
-      ar(cereal::make_nvp(name.c_str(), t));
+      // Binary models are written with a header and a checksum (see
+      // model_file.hpp).  Any failed write is reported by Close() below.
+      ModelFileWriter writer(ofs);
+      std::ostream modelStream(&writer);
+      {
+        cereal::BinaryOutputArchive ar(modelStream);
+        ar(cereal::make_nvp(name.c_str(), t));
+      }
+      writer.Finish();
     }
-
-    return true;
   }
   catch (cereal::Exception& e)
   {
@@ -338,6 +443,23 @@ bool Save(const std::string& filename,
 
     return false;
   }
+
+  // The archives are finished when they are destroyed, so only now can the
+  // file be finished.
+  std::string error;
+  if (!file.Close(error))
+  {
+    if (fatal)
+      Log::Fatal << "Unable to save object '" << name << "' to '" << filename
+          << "': " << error << "." << std::endl;
+    else
+      Log::Warn << "Unable to save object '" << name << "' to '" << filename
+          << "': " << error << "." << std::endl;
+
+    return false;
+  }
+
+  return true;
 }
 
 } // namespace data
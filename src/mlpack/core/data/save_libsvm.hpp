@@ -0,0 +1,49 @@
+/**
+ * @file core/data/save_libsvm.hpp
+ *
+ * Save a sparse matrix in the libsvm (SVMLight) format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_LIBSVM_HPP
+#define MLPACK_CORE_DATA_SAVE_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <charconv>
+
+#include "compressed_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Save a sparse matrix and a row of labels in the libsvm (SVMLight) format, as
+ * read by LoadLibSVM(): each column of the matrix is written as a line holding
+ * its label followed by `index:value` pairs for its nonzero elements, where
+ * row `i` of the matrix is feature `i + 1`.  Values are written with the
+ * shortest representation that reads back to the same value.  The lines are
+ * formatted in parallel when OpenMP is available.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Sparse matrix to save; each column is a point.
+ * @param labels Labels of the points.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT, typename LabelType>
+bool SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels,
+                const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "save_libsvm_impl.hpp"
+
+#endif
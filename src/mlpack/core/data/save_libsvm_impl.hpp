@@ -0,0 +1,135 @@
+/**
+ * @file core/data/save_libsvm_impl.hpp
+ *
+ * Implementation of SaveLibSVM().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SAVE_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_SAVE_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "save_libsvm.hpp"
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+/**
+ * Append the given number to the string, with the shortest representation that
+ * reads back to the same value (or with enough digits for that, if
+ * std::to_chars() is not available for floating-point types).
+ */
+template<typename T>
+void AppendLibSVMNumber(std::string& out, const T value)
+{
+#if defined(__cpp_lib_to_chars)
+  char buffer[64];
+  const std::to_chars_result result = std::to_chars(buffer, buffer + 64,
+      value);
+  out.append(buffer, result.ptr);
+#else
+  std::ostringstream oss;
+  oss << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+  out += oss.str();
+#endif
+}
+
+} // namespace details
+
+template<typename eT, typename LabelType>
+bool SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels,
+                const bool fatal)
+{
+  if (labels.n_elem != matrix.n_cols)
+  {
+    if (fatal)
+      Log::Fatal << "SaveLibSVM(): " << labels.n_elem << " labels given for "
+          << matrix.n_cols << " points; save to '" << filename << "' failed."
+          << std::endl;
+    else
+      Log::Warn << "SaveLibSVM(): " << labels.n_elem << " labels given for "
+          << matrix.n_cols << " points; save to '" << filename << "' failed."
+          << std::endl;
+
+    return false;
+  }
+
+  // The file is compressed if its name ends in .gz or .zst.
+  OutputFile file(filename, std::ios::out | std::ios::binary);
+  std::ostream& stream = file.Stream();
+  if (!file.IsOpen())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << "Save failed." << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing; save "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  // Each chunk of points is formatted into its own buffer by one thread, and
+  // the buffers are written in order.  The matrix is synced first, so that the
+  // threads only read it.
+  matrix.sync();
+  const size_t numChunks = std::max((size_t) 1, std::min(4 * numThreads,
+      (size_t) matrix.n_cols / 1024));
+  std::vector<std::string> buffers(numChunks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    const size_t begin = c * matrix.n_cols / numChunks;
+    const size_t end = (c + 1) * matrix.n_cols / numChunks;
+    std::string& out = buffers[c];
+    for (size_t i = begin; i < end; ++i)
+    {
+      details::AppendLibSVMNumber(out, labels[i]);
+      for (typename arma::SpMat<eT>::const_iterator it = matrix.begin_col(i);
+           it != matrix.end_col(i); ++it)
+      {
+        out += ' ';
+        details::AppendLibSVMNumber(out, (size_t) it.row() + 1);
+        out += ':';
+        details::AppendLibSVMNumber(out, (eT) *it);
+      }
+      out += '\n';
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+    stream.write(buffers[c].data(), std::streamsize(buffers[c].size()));
+
+  std::string error;
+  if (!file.Close(error))
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed: " << error << "."
+          << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "scaler_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -54,9 +56,23 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the fit with another batch of points, so that the scaler is fit to
+   * all the points given to PartialFit() since the last call to Fit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMean = statistics.Mean();
+    itemMin = statistics.Min();
+    itemMax = statistics.Max();
     scale = itemMax - itemMin;
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -71,14 +87,26 @@ class MeanNormalization
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
   {
     if (itemMean.is_empty() || scale.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / scale;
+    input.each_col() -= itemMean;
+    input.each_col() /= scale;
   }
 
   /**
@@ -90,8 +118,20 @@ class MeanNormalization
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + itemMean;
+    output = input;
+    InverseTransform(output);
+  }
+
+  /**
+   * Function to retrieve original dataset in place.
+   *
+   * @param input Scaled dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& input)
+  {
+    input.each_col() %= scale;
+    input.each_col() += itemMean;
   }
 
   //! Get the Mean row vector.
@@ -102,14 +142,22 @@ class MeanNormalization
   const arma::vec& ItemMax() const { return itemMax; }
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
+  //! Get the statistics of the points fit so far.
+  const ScalerStatistics& Statistics() const { return statistics; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
     ar(CEREAL_NVP(itemMean));
+    // Older versions did not store the statistics, so PartialFit() on a scaler
+    // loaded from them starts over.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
+    else if (cereal::is_loading<Archive>())
+      statistics.Reset();
   }
 
  private:
@@ -121,9 +169,15 @@ class MeanNormalization
   arma::vec itemMax;
   // Vector which is used to scale up each feature.
   arma::vec scale;
+  // Statistics of the points fit so far.
+  ScalerStatistics statistics;
 }; // class MeanNormalization
 
 } // namespace data
 } // namespace mlpack
 
+//! Set the serialization version of the MeanNormalization class.  Version 0 did
+//! not store the statistics used by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::MeanNormalization, 1);
+
 #endif
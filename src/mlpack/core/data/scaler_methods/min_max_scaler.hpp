@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "scaler_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -73,8 +75,22 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = min(input, 1);
-    itemMax = arma::max(input, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the fit with another batch of points, so that the scaler is fit to
+   * all the points given to PartialFit() since the last call to Fit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMin = statistics.Min();
+    itemMax = statistics.Max();
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -93,14 +109,26 @@ class MinMaxScaler
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
   {
     if (scalerowmin.is_empty() || scale.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    input.each_col() %= scale;
+    input.each_col() += scalerowmin;
   }
 
   /**
@@ -112,8 +140,20 @@ class MinMaxScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    output = input;
+    InverseTransform(output);
+  }
+
+  /**
+   * Function to retrieve original dataset in place.
+   *
+   * @param input Scaled dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& input)
+  {
+    input.each_col() -= scalerowmin;
+    input.each_col() /= scale;
   }
 
   //! Get the Min row vector.
@@ -126,9 +166,11 @@ class MinMaxScaler
   double ScaleMax() const { return scaleMax; }
   //! Get the lower range parameter.
   double ScaleMin() const { return scaleMin; }
+  //! Get the statistics of the points fit so far.
+  const ScalerStatistics& Statistics() const { return statistics; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
@@ -136,6 +178,12 @@ class MinMaxScaler
     ar(CEREAL_NVP(scaleMin));
     ar(CEREAL_NVP(scaleMax));
     ar(CEREAL_NVP(scalerowmin));
+    // Older versions did not store the statistics, so PartialFit() on a scaler
+    // loaded from them starts over.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
+    else if (cereal::is_loading<Archive>())
+      statistics.Reset();
   }
 
  private:
@@ -151,9 +199,15 @@ class MinMaxScaler
   double scaleMax;
   // Column vector of scalemin
   arma::vec scalerowmin;
+  // Statistics of the points fit so far.
+  ScalerStatistics statistics;
 }; // class MinMaxScaler
 
 } // namespace data
 } // namespace mlpack
 
+//! Set the serialization version of the MinMaxScaler class.  Version 0 did not
+//! store the statistics used by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::MinMaxScaler, 1);
+
 #endif
@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/ccov.hpp>
 
+#include "scaler_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -51,7 +53,7 @@ class PCAWhitening
    *
    * @param eps Regularization parameter.
    */
-  PCAWhitening(double eps = 0.00005)
+  PCAWhitening(double eps = 0.00005) : statistics(true)
   {
     epsilon = eps;
     // Ensure scaleMin is smaller than scaleMax.
@@ -69,10 +71,23 @@ class PCAWhitening
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, ColumnCovariance(
-        input.each_col() - itemMean));
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the fit with another batch of points, so that the scaler is fit to
+   * all the points given to PartialFit() since the last call to Fit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMean = statistics.Mean();
+    // Get eigenvectors and eigenvalues of covariance of the points.
+    eig_sym(eigenValues, eigenVectors, statistics.Covariance());
     eigenValues += epsilon;
   }
 
@@ -84,16 +99,36 @@ class PCAWhitening
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function for PCA whitening in place.  The points are whitened in blocks,
+   * so only a block of points is held in temporary memory.
+   *
+   * @param input Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
   {
     if (eigenValues.is_empty() || eigenVectors.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean);
-    output = arma::diagmat(1.0 / (sqrt(eigenValues))) * eigenVectors.t()
-        * output;
+
+    const arma::mat whitening = arma::diagmat(1.0 / (sqrt(eigenValues))) *
+        eigenVectors.t();
+    for (size_t begin = 0; begin < input.n_cols;
+         begin += ScalerStatistics::BlockSize)
+    {
+      const size_t end = std::min((size_t) input.n_cols,
+          begin + ScalerStatistics::BlockSize) - 1;
+      input.cols(begin, end) = whitening *
+          (input.cols(begin, end).each_col() - itemMean);
+    }
   }
 
   /**
@@ -118,14 +153,22 @@ class PCAWhitening
   const arma::mat& EigenVectors() const { return eigenVectors; }
   //! Get the regularization parameter.
   const double& Epsilon() const { return epsilon; }
+  //! Get the statistics of the points fit so far.
+  const ScalerStatistics& Statistics() const { return statistics; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(eigenValues));
     ar(CEREAL_NVP(eigenVectors));
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(epsilon));
+    // Older versions did not store the statistics, so PartialFit() on a scaler
+    // loaded from them starts over.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
+    else if (cereal::is_loading<Archive>())
+      statistics = ScalerStatistics(true);
   }
 
  private:
@@ -137,9 +180,15 @@ class PCAWhitening
   double epsilon;
   // Vector which hold the eigenvalues.
   arma::vec eigenValues;
+  // Statistics (with the covariance) of the points fit so far.
+  ScalerStatistics statistics;
 }; // class PCAWhitening
 
 } // namespace data
 } // namespace mlpack
 
+//! Set the serialization version of the PCAWhitening class.  Version 0 did not
+//! store the statistics used by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::PCAWhitening, 1);
+
 #endif
@@ -16,6 +16,7 @@
 #include "mean_normalization.hpp"
 #include "min_max_scaler.hpp"
 #include "pca_whitening.hpp"
+#include "scaler_statistics.hpp"
 #include "standard_scaler.hpp"
 #include "zca_whitening.hpp"
 
@@ -0,0 +1,214 @@
+/**
+ * @file core/data/scaler_methods/scaler_statistics.hpp
+ *
+ * ScalerStatistics accumulates the per-feature statistics that the scalers are
+ * fit with, one batch of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SCALER_METHODS_SCALER_STATISTICS_HPP
+#define MLPACK_CORE_DATA_SCALER_METHODS_SCALER_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ScalerStatistics holds the number of points seen so far and, for each
+ * feature, their mean, minimum, maximum, and sum of squared deviations from the
+ * mean (and, optionally, the sum of the outer products of the deviations, for
+ * the covariance).  Batches of points are added with Update(), and the
+ * statistics of two sets of points can be combined with Merge(); the mean and
+ * deviations are merged with the pairwise update of Chan et al., so that they
+ * stay accurate over many batches.
+ *
+ * Update() splits a batch into blocks of columns, whose statistics are computed
+ * in parallel with OpenMP and then merged in order.
+ */
+class ScalerStatistics
+{
+ public:
+  //! The number of points in each block of a batch that is processed by one
+  //! thread.
+  static const size_t BlockSize = 4096;
+
+  /**
+   * Create an empty set of statistics.
+   *
+   * @param covariance Whether to accumulate the covariance of the features.
+   */
+  ScalerStatistics(const bool covariance = false) :
+      covariance(covariance),
+      count(0)
+  { }
+
+  //! Forget all points seen so far.
+  void Reset()
+  {
+    count = 0;
+    mean.clear();
+    m2.clear();
+    minimum.clear();
+    maximum.clear();
+    comoment.clear();
+  }
+
+  /**
+   * Add the given points (one per column) to the statistics.  All batches must
+   * have the same number of rows.
+   *
+   * @param input Batch of points.
+   */
+  template<typename MatType>
+  void Update(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (count > 0 && input.n_rows != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "ScalerStatistics::Update(): batch has " << input.n_rows
+          << " dimensions, but previous batches had " << mean.n_elem << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    const size_t numBlocks = (input.n_cols + BlockSize - 1) / BlockSize;
+    std::vector<ScalerStatistics> blocks(numBlocks,
+        ScalerStatistics(covariance));
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * BlockSize;
+      const size_t end = std::min((size_t) input.n_cols, begin + BlockSize);
+      blocks[b].Compute(arma::conv_to<arma::mat>::from(
+          input.cols(begin, end - 1)));
+    }
+
+    for (size_t b = 0; b < numBlocks; ++b)
+      Merge(blocks[b]);
+  }
+
+  /**
+   * Add the statistics of another set of points to these statistics.
+   *
+   * @param other Statistics to merge.
+   */
+  void Merge(const ScalerStatistics& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      count = other.count;
+      mean = other.mean;
+      m2 = other.m2;
+      minimum = other.minimum;
+      maximum = other.maximum;
+      if (covariance)
+        comoment = other.comoment;
+      return;
+    }
+
+    if (other.mean.n_elem != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "ScalerStatistics::Merge(): statistics have " << other.mean.n_elem
+          << " dimensions, but these have " << mean.n_elem << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    if (covariance && other.comoment.n_elem != comoment.n_elem)
+    {
+      throw std::invalid_argument("ScalerStatistics::Merge(): statistics to "
+          "merge do not hold the covariance!");
+    }
+
+    const double n = (double) (count + other.count);
+    const double weight = ((double) count) * ((double) other.count) / n;
+    const arma::vec delta = other.mean - mean;
+
+    mean += delta * (((double) other.count) / n);
+    m2 += other.m2 + arma::square(delta) * weight;
+    if (covariance)
+      comoment += other.comoment + (delta * delta.t()) * weight;
+    minimum = arma::min(minimum, other.minimum);
+    maximum = arma::max(maximum, other.maximum);
+    count += other.count;
+  }
+
+  //! Get the number of points seen so far.
+  size_t Count() const { return count; }
+  //! Get the mean of each feature.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the minimum of each feature.
+  const arma::vec& Min() const { return minimum; }
+  //! Get the maximum of each feature.
+  const arma::vec& Max() const { return maximum; }
+  //! Get whether the covariance is accumulated.
+  bool HasCovariance() const { return covariance; }
+
+  //! Get the (population) variance of each feature.
+  arma::vec Variance() const { return m2 / (double) count; }
+
+  //! Get the (sample) covariance of the features; this is only available if
+  //! the covariance is accumulated.
+  arma::mat Covariance() const
+  {
+    return comoment / (double) ((count > 1) ? (count - 1) : 1);
+  }
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(covariance));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(mean));
+    ar(CEREAL_NVP(m2));
+    ar(CEREAL_NVP(minimum));
+    ar(CEREAL_NVP(maximum));
+    ar(CEREAL_NVP(comoment));
+  }
+
+ private:
+  //! Set the statistics to those of the given block of points.
+  void Compute(const arma::mat& block)
+  {
+    count = block.n_cols;
+    mean = arma::mean(block, 1);
+    minimum = arma::min(block, 1);
+    maximum = arma::max(block, 1);
+
+    const arma::mat centered = block.each_col() - mean;
+    m2 = arma::sum(arma::square(centered), 1);
+    if (covariance)
+      comoment = centered * centered.t();
+  }
+
+  //! Whether to accumulate the covariance.
+  bool covariance;
+  //! The number of points seen so far.
+  size_t count;
+  //! The mean of each feature.
+  arma::vec mean;
+  //! The sum of squared deviations from the mean of each feature.
+  arma::vec m2;
+  //! The minimum of each feature.
+  arma::vec minimum;
+  //! The maximum of each feature.
+  arma::vec maximum;
+  //! The sum of the outer products of the deviations from the mean.
+  arma::mat comoment;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
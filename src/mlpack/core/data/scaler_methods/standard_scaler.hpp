@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "scaler_statistics.hpp"
+
 namespace mlpack {
 namespace data {
 
@@ -43,6 +45,18 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset that does not fit in memory can be fit in batches with
+ * PartialFit(), and each batch can then be scaled in place:
+ *
+ * @code
+ * StandardScaler scale;
+ * for (arma::mat& batch : batches)
+ *   scale.PartialFit(batch);
+ *
+ * for (arma::mat& batch : batches)
+ *   scale.Transform(batch);
+ * @endcode
  */
 class StandardScaler
 {
@@ -55,8 +69,22 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the fit with another batch of points, so that the scaler is fit to
+   * all the points given to PartialFit() since the last call to Fit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMean = statistics.Mean();
+    itemStdDev = arma::sqrt(statistics.Variance());
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -70,14 +98,26 @@ class StandardScaler
    */
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
+  {
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function to scale features in place.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
   {
     if (itemMean.is_empty() || itemStdDev.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    input.each_col() -= itemMean;
+    input.each_col() /= itemStdDev;
   }
 
   /**
@@ -89,20 +129,40 @@ class StandardScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    output = input;
+    InverseTransform(output);
+  }
+
+  /**
+   * Function to retrieve original dataset in place.
+   *
+   * @param input Scaled dataset.
+   */
+  template<typename MatType>
+  void InverseTransform(MatType& input)
+  {
+    input.each_col() %= itemStdDev;
+    input.each_col() += itemMean;
   }
 
   //! Get the mean row vector.
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the statistics of the points fit so far.
+  const ScalerStatistics& Statistics() const { return statistics; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+    // Older versions did not store the statistics, so PartialFit() on a scaler
+    // loaded from them starts over.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
+    else if (cereal::is_loading<Archive>())
+      statistics.Reset();
   }
 
  private:
@@ -110,9 +170,15 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Statistics of the points fit so far.
+  ScalerStatistics statistics;
 }; // class StandardScaler
 
 } // namespace data
 } // namespace mlpack
 
+//! Set the serialization version of the StandardScaler class.  Version 0 did
+//! not store the statistics used by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::StandardScaler, 1);
+
 #endif
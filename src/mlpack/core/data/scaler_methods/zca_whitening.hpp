@@ -64,6 +64,18 @@ class ZCAWhitening
     pca.Fit(input);
   }
 
+  /**
+   * Update the fit with another batch of points, so that the scaler is fit to
+   * all the points given to PartialFit() since the last call to Fit().
+   *
+   * @param input Batch of points to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    pca.PartialFit(input);
+  }
+
   /**
    * Function for ZCA whitening.
    *
@@ -73,8 +85,27 @@ class ZCAWhitening
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
   {
-    pca.Transform(input, output);
-    output = pca.EigenVectors() * output;
+    output = input;
+    Transform(output);
+  }
+
+  /**
+   * Function for ZCA whitening in place.  The points are whitened in blocks,
+   * so only a block of points is held in temporary memory.
+   *
+   * @param input Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    pca.Transform(input);
+    for (size_t begin = 0; begin < input.n_cols;
+         begin += ScalerStatistics::BlockSize)
+    {
+      const size_t end = std::min((size_t) input.n_cols,
+          begin + ScalerStatistics::BlockSize) - 1;
+      input.cols(begin, end) = pca.EigenVectors() * input.cols(begin, end);
+    }
   }
 
   /**
@@ -99,6 +130,8 @@ class ZCAWhitening
   const arma::mat& EigenVectors() const { return pca.EigenVectors(); }
   //! Get the regularization parameter.
   double Epsilon() const { return pca.Epsilon(); }
+  //! Get the statistics of the points fit so far.
+  const ScalerStatistics& Statistics() const { return pca.Statistics(); }
 
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -18,10 +18,52 @@
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+/**
+ * Copy the columns of a dense matrix with the given indices into `output`, in
+ * parallel.
+ */
+template<typename MatType>
+void GatherColumns(const MatType& input,
+                   const arma::uvec& indices,
+                   MatType& output,
+                   const typename std::enable_if_t<
+                       arma::is_Mat<MatType>::value>* = 0)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    std::copy(input.colptr(indices[i]), input.colptr(indices[i]) + input.n_rows,
+        output.colptr(i));
+  }
+}
+
+/**
+ * Copy the columns of any other type (sparse matrices, fields) with the given
+ * indices into `output`, one at a time.
+ */
+template<typename InputType>
+void GatherColumns(const InputType& input,
+                   const arma::uvec& indices,
+                   InputType& output,
+                   const typename std::enable_if_t<
+                       !arma::is_Mat<InputType>::value>* = 0)
+{
+  output.set_size(input.n_rows, indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    output.col(i) = input.col(indices[i]);
+}
+
+} // namespace details
+
 /**
  * This helper function splits any `input` data into training and testing parts.
  * In order to shuffle the input data before spliting, an array of shuffled
- * indices of the input data is passed in the form of argument `order`.
+ * indices of the input data is passed in the form of argument `order`.  The
+ * columns of dense matrices are then copied in parallel.
  */
 template<typename InputType>
 void SplitHelper(const InputType& input,
@@ -33,27 +75,19 @@ void SplitHelper(const InputType& input,
   const size_t testSize = static_cast<size_t>(input.n_cols * testRatio);
   const size_t trainSize = input.n_cols - testSize;
 
-  // Initialising the sizes of outputs if not already initialized.
-  train.set_size(input.n_rows, trainSize);
-  test.set_size(input.n_rows, testSize);
-
   // Shuffling and spliting simultaneously.
   if (!order.is_empty())
   {
-    if (trainSize > 0)
-    {
-      for (size_t i = 0; i < trainSize; ++i)
-        train.col(i) = input.col(order(i));
-    }
-    if (trainSize < input.n_cols)
-    {
-      for (size_t i = trainSize; i < input.n_cols; ++i)
-        test.col(i - trainSize) = input.col(order(i));
-    }
+    details::GatherColumns(input, order.head(trainSize), train);
+    details::GatherColumns(input, order.tail(testSize), test);
   }
   // Spliting only.
   else
   {
+    // Initialising the sizes of outputs if not already initialized.
+    train.set_size(input.n_rows, trainSize);
+    test.set_size(input.n_rows, testSize);
+
     if (trainSize > 0)
       train = input.cols(0, trainSize - 1);
 
@@ -63,52 +97,78 @@ void SplitHelper(const InputType& input,
 }
 
 /**
- * Given an input dataset and labels, stratify into a training set and test set.
- * It is recommended to have the input labels between the range [0, n) where n
- * is the number of different labels. The NormalizeLabels() function in
- * mlpack::data can be used for this.
- * Expects labels to be of type arma::Row<> or arma::Col<>.
- * Throws a runtime error if this is not the case.
- * Example usage below. This overload places the stratified dataset into the
- * four output parameters given (trainData, testData, trainLabel,
- * and testLabel).
+ * Split the indices of a dataset with the given number of points into the
+ * indices of a training set and a test set, without copying any data.  The
+ * indices can be used to view the sets (for instance, with
+ * `input.cols(trainIndices)`), or to split a dataset that is too large to
+ * copy.  Example usage below.
  *
  * @code
  * arma::mat input = loadData();
- * arma::Row<size_t> label = loadLabel();
- * arma::mat trainData;
- * arma::mat testData;
- * arma::Row<size_t> trainLabel;
- * arma::Row<size_t> testLabel;
+ * arma::uvec trainIndices, testIndices;
  * RandomSeed(100); // Set the seed if you like.
  *
- * // Stratify the dataset into a training and test set, with 30% of the data
- * // being held out for the test set.
- * StratifiedSplit(input, label, trainData,
- *                 testData, trainLabel, testLabel, 0.3);
+ * // Hold out 30% of the points for the test set.
+ * SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+ * arma::mat testData = input.cols(testIndices);
  * @endcode
  *
- * @param input Input dataset to stratify.
- * @param inputLabel Input labels to stratify.
- * @param trainData Matrix to store training data into.
- * @param testData Matrix to store test data into.
- * @param trainLabel Vector to store training labels into.
- * @param testLabel Vector to store test labels into.
+ * The points are shuffled with the same random numbers as Split() would use,
+ * so for the same seed the indices are the columns that Split() would put in
+ * each set.
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param trainIndices Vector to store the indices of the training set into.
+ * @param testIndices Vector to store the indices of the test set into.
  * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
  * @param shuffleData If true, the sample order is shuffled; otherwise, each
  *     sample is visited in linear order. (Default true.)
  */
-template<typename T, typename LabelsType,
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
+/**
+ * Given labels, stratify the indices of the points into the indices of a
+ * training set and a test set, without copying any data (see SplitIndices() for
+ * how to use the indices).  The same fraction of the points of each class is
+ * held out for the test set.  Expects labels to be of type arma::Row<> or
+ * arma::Col<>; throws a runtime error if this is not the case.
+ *
+ * @param labels Labels of the points to stratify.
+ * @param trainIndices Vector to store the indices of the training set into.
+ * @param testIndices Vector to store the indices of the test set into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename LabelsType,
          typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
-void StratifiedSplit(const arma::Mat<T>& input,
-                     const LabelsType& inputLabel,
-                     arma::Mat<T>& trainData,
-                     arma::Mat<T>& testData,
-                     LabelsType& trainLabel,
-                     LabelsType& testLabel,
-                     const double testRatio,
-                     const bool shuffleData = true)
+void StratifiedSplitIndices(const LabelsType& labels,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
 {
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::Split(): when stratified sampling is done, "
+        "labels must have type `arma::Row<>`!");
+
   /**
    * Basic idea:
    * Let us say we have to stratify a dataset based on labels:
@@ -142,24 +202,18 @@ void StratifiedSplit(const arma::Mat<T>& input,
    * 0
    * 1 1
    */
-  const bool typeCheck = (arma::is_Row<LabelsType>::value)
-      || (arma::is_Col<LabelsType>::value);
-  if (!typeCheck)
-    throw std::runtime_error("data::Split(): when stratified sampling is done, "
-        "labels must have type `arma::Row<>`!");
-  util::CheckSameSizes(input, inputLabel, "data::Split()");
   size_t trainIdx = 0;
   size_t testIdx = 0;
   size_t trainSize = 0;
   size_t testSize = 0;
   arma::uvec labelCounts;
   arma::uvec testLabelCounts;
-  typename LabelsType::elem_type maxLabel = inputLabel.max();
+  typename LabelsType::elem_type maxLabel = labels.max();
 
   labelCounts.zeros(maxLabel+1);
   testLabelCounts.zeros(maxLabel+1);
 
-  for (typename LabelsType::elem_type label : inputLabel)
+  for (typename LabelsType::elem_type label : labels)
     ++labelCounts[label];
 
   for (arma::uword labelCount : labelCounts)
@@ -168,56 +222,96 @@ void StratifiedSplit(const arma::Mat<T>& input,
     trainSize += labelCount - floor(labelCount * testRatio);
   }
 
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-  trainLabel.set_size(inputLabel.n_rows, trainSize);
-  testLabel.set_size(inputLabel.n_rows, testSize);
+  trainIndices.set_size(trainSize);
+  testIndices.set_size(testSize);
 
+  arma::uvec order = arma::linspace<arma::uvec>(0, labels.n_elem - 1,
+      labels.n_elem);
   if (shuffleData)
-  {
-    arma::uvec order = arma::shuffle(
-        arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
+    order = arma::shuffle(order);
 
-    for (arma::uword i : order)
+  for (arma::uword i : order)
+  {
+    typename LabelsType::elem_type label = labels[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
     {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
+      testLabelCounts[label] += 1;
+      testIndices[testIdx] = i;
+      testIdx += 1;
     }
-  }
-  else
-  {
-    for (arma::uword i = 0; i < input.n_cols; i++)
+    else
     {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
+      trainIndices[trainIdx] = i;
+      trainIdx += 1;
     }
   }
 }
 
+/**
+ * Given an input dataset and labels, stratify into a training set and test set.
+ * It is recommended to have the input labels between the range [0, n) where n
+ * is the number of different labels. The NormalizeLabels() function in
+ * mlpack::data can be used for this.
+ * Expects labels to be of type arma::Row<> or arma::Col<>.
+ * Throws a runtime error if this is not the case.
+ * Example usage below. This overload places the stratified dataset into the
+ * four output parameters given (trainData, testData, trainLabel,
+ * and testLabel).
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::Row<size_t> label = loadLabel();
+ * arma::mat trainData;
+ * arma::mat testData;
+ * arma::Row<size_t> trainLabel;
+ * arma::Row<size_t> testLabel;
+ * RandomSeed(100); // Set the seed if you like.
+ *
+ * // Stratify the dataset into a training and test set, with 30% of the data
+ * // being held out for the test set.
+ * StratifiedSplit(input, label, trainData,
+ *                 testData, trainLabel, testLabel, 0.3);
+ * @endcode
+ *
+ * @param input Input dataset to stratify.
+ * @param inputLabel Input labels to stratify.
+ * @param trainData Matrix to store training data into.
+ * @param testData Matrix to store test data into.
+ * @param trainLabel Vector to store training labels into.
+ * @param testLabel Vector to store test labels into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename T, typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+void StratifiedSplit(const arma::Mat<T>& input,
+                     const LabelsType& inputLabel,
+                     arma::Mat<T>& trainData,
+                     arma::Mat<T>& testData,
+                     LabelsType& trainLabel,
+                     LabelsType& testLabel,
+                     const double testRatio,
+                     const bool shuffleData = true)
+{
+  util::CheckSameSizes(input, inputLabel, "data::Split()");
+
+  arma::uvec trainIndices, testIndices;
+  StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+      shuffleData);
+
+  details::GatherColumns(input, trainIndices, trainData);
+  details::GatherColumns(input, testIndices, testData);
+
+  trainLabel.set_size(trainIndices.n_elem);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    trainLabel[i] = inputLabel[trainIndices[i]];
+
+  testLabel.set_size(testIndices.n_elem);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    testLabel[i] = inputLabel[testIndices[i]];
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload places the split dataset into the four
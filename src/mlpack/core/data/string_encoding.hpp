@@ -98,6 +98,14 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * For policies that encode the number of times each token occurs in each
+   * string (BagOfWordsEncodingPolicy and TfIdfEncodingPolicy), Armadillo
+   * output is computed in parallel: each thread tokenizes a part of the input
+   * with its own dictionary, and the dictionaries are then merged (so that the
+   * labels are the same as without threads).  An arma::sp_mat output is built
+   * directly, without a dense matrix.  In this case, the tokenizer must be
+   * safe to call from several threads.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -201,6 +209,78 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * A helper function to encode the given text into a sparse matrix, in
+   * parallel, for policies that encode the number of times each token occurs
+   * in each string.  The encoder writes data in the column-major order.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::countEncoding>::type* = 0);
+
+  /**
+   * A helper function to encode the given text into a dense matrix, in
+   * parallel, for policies that encode the number of times each token occurs
+   * in each string.  The encoder writes data in the column-major order.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output matrix to store the result.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::Mat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::countEncoding>::type* = 0);
+
+  /**
+   * Tokenize the given text in parallel, add the tokens to the dictionary, and
+   * encode each string with the policy's EncodeCount(), in compressed sparse
+   * column format: the values of string i are in
+   * values[colPtrs[i], colPtrs[i + 1]), and their rows (the labels of the
+   * tokens minus one) are in rowIndices, in increasing order.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param tokenizer The tokenizer object.
+   * @param policy The policy object.
+   * @param rowIndices Set to the row of each value.
+   * @param colPtrs Set to the index of the first value of each string.
+   * @param values Set to the encoded values.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeCounts(const std::vector<std::string>& input,
+                    const TokenizerType& tokenizer,
+                    const PolicyType& policy,
+                    arma::uvec& rowIndices,
+                    arma::uvec& colPtrs,
+                    arma::Col<ElemType>& values);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -16,8 +16,9 @@
 #include <mlpack/prereqs.hpp>
 
 #include <array>
-#include <deque>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 namespace mlpack {
@@ -107,6 +108,9 @@ class StringEncodingDictionary
 
 /*
  * Specialization of the StringEncodingDictionary class for std::string_view.
+ * The characters of the tokens are copied into large blocks of memory owned by
+ * the dictionary (an arena), so that adding a token does not allocate a string
+ * of its own; the keys of the mapping and Tokens() are views of the arena.
  */
 template<>
 class StringEncodingDictionary<std::string_view>
@@ -121,28 +125,36 @@ class StringEncodingDictionary<std::string_view>
   //! The type of the token that the dictionary stores.
   using TokenType = std::string_view;
 
+  //! The size of each block of memory that the tokens are stored in.  Tokens
+  //! longer than this get a block of their own.
+  static const size_t BlockSize = 1 << 16;
+
   //! Construct the default class.
-  StringEncodingDictionary() = default;
+  StringEncodingDictionary() : blockUsed(0), blockCapacity(0) { }
 
   //! Copy the class from the given object.
   StringEncodingDictionary(const StringEncodingDictionary& other) :
-      tokens(other.tokens)
+      blockUsed(0),
+      blockCapacity(0)
   {
-    for (const std::string& token : tokens)
-      mapping[token] = other.mapping.at(token);
+    tokens.reserve(other.tokens.size());
+    mapping.reserve(other.mapping.size());
+    for (const std::string_view token : other.tokens)
+    {
+      tokens.push_back(Store(token));
+      mapping[tokens.back()] = other.mapping.at(token);
+    }
   }
 
-  //! Standard move constructor.
+  //! Standard move constructor.  The blocks are moved along with the views of
+  //! them, so the views stay valid.
   StringEncodingDictionary(StringEncodingDictionary&& other) = default;
 
   //! Copy the class from the given object.
   StringEncodingDictionary& operator=(const StringEncodingDictionary& other)
   {
-    tokens = other.tokens;
-    mapping.clear();
-
-    for (const std::string& token : tokens)
-      mapping[token] = other.mapping.at(token);
+    if (this != &other)
+      *this = StringEncodingDictionary(other);
 
     return *this;
   }
@@ -170,7 +182,7 @@ class StringEncodingDictionary<std::string_view>
    */
   size_t AddToken(const std::string_view token)
   {
-    tokens.emplace_back(token);
+    tokens.push_back(Store(token));
 
     size_t size = mapping.size();
 
@@ -198,12 +210,14 @@ class StringEncodingDictionary<std::string_view>
   {
     mapping.clear();
     tokens.clear();
+    blocks.clear();
+    blockUsed = 0;
+    blockCapacity = 0;
   }
 
-  //! Get the tokens.
-  const std::deque<std::string>& Tokens() const { return tokens; }
-  //! Modify the tokens.
-  std::deque<std::string>& Tokens() { return tokens; }
+  //! Get the tokens, in the order they were added.  The views are valid as
+  //! long as the dictionary is not cleared or destroyed.
+  const std::vector<std::string_view>& Tokens() const { return tokens; }
 
   //! Get the mapping.
   const MapType& Mapping() const { return mapping; }
@@ -222,32 +236,69 @@ class StringEncodingDictionary<std::string_view>
 
     if (cereal::is_loading<Archive>())
     {
-      tokens.resize(numTokens);
+      Clear();
+      tokens.reserve(numTokens);
+      mapping.reserve(numTokens);
 
-      for (std::string& token : tokens)
+      for (size_t i = 0; i < numTokens; ++i)
       {
+        std::string token;
         ar(CEREAL_NVP(token));
 
         size_t tokenValue = 0;
         ar(CEREAL_NVP(tokenValue));
-        mapping[token] = tokenValue;
+
+        tokens.push_back(Store(token));
+        mapping[tokens.back()] = tokenValue;
       }
     }
     if (cereal::is_saving<Archive>())
     {
-      for (std::string& token : tokens)
+      for (const std::string_view view : tokens)
       {
+        std::string token(view);
         ar(CEREAL_NVP(token));
 
-        size_t tokenValue = mapping.at(token);
+        size_t tokenValue = mapping.at(view);
         ar(CEREAL_NVP(tokenValue));
       }
     }
   }
 
  private:
-  //! The tokens that the dictionary stores.
-  std::deque<std::string> tokens;
+  /**
+   * Copy the given token into the arena and return a view of the copy.
+   *
+   * @param token The given token.
+   */
+  std::string_view Store(const std::string_view token)
+  {
+    if (token.empty())
+      return std::string_view();
+
+    if (token.size() > blockCapacity - blockUsed)
+    {
+      blockCapacity = std::max(token.size(), BlockSize);
+      blocks.emplace_back(new char[blockCapacity]);
+      blockUsed = 0;
+    }
+
+    char* copy = blocks.back().get() + blockUsed;
+    std::memcpy(copy, token.data(), token.size());
+    blockUsed += token.size();
+
+    return std::string_view(copy, token.size());
+  }
+
+  //! The blocks of memory that the tokens are stored in.
+  std::vector<std::unique_ptr<char[]>> blocks;
+  //! The number of bytes used in the last block.
+  size_t blockUsed;
+  //! The size of the last block.
+  size_t blockCapacity;
+
+  //! The tokens that the dictionary stores, in the order they were added.
+  std::vector<std::string_view> tokens;
 
   //! The mapping itself.
   MapType mapping;
@@ -343,6 +394,131 @@ class StringEncodingDictionary<int>
   size_t size;
 };
 
+/**
+ * FeatureHashingDictionary can be used instead of StringEncodingDictionary to
+ * encode strings without a dictionary (the "hashing trick"): the label of each
+ * token is its hash modulo the number of features, plus one.  Nothing is
+ * stored, and tokens that were never seen before can be encoded, but different
+ * tokens may get the same label.  The hash of string and integer tokens
+ * (64-bit FNV-1a) does not depend on the platform, so neither do their labels.
+ *
+ * @tparam Token Type of the tokens.
+ */
+template<typename Token>
+class FeatureHashingDictionary
+{
+ public:
+  //! The type of the token that the dictionary labels.
+  using TokenType = Token;
+
+  /**
+   * Construct the dictionary with the given number of features.
+   *
+   * @param numFeatures The number of distinct labels.
+   */
+  FeatureHashingDictionary(const size_t numFeatures = (1 << 20)) :
+      numFeatures(numFeatures)
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("FeatureHashingDictionary: the number of "
+          "features must be positive!");
+    }
+  }
+
+  /**
+   * The function returns true, since every token has a label.
+   *
+   * @param * (token) The given token.
+   */
+  bool HasToken(const Token& /* token */) const { return true; }
+
+  /**
+   * The function returns the label of the given token; nothing is stored.
+   *
+   * @param token The given token.
+   */
+  template<typename T>
+  size_t AddToken(T&& token) { return Value(token); }
+
+  /**
+   * The function returns the label of the given token, which is in
+   * [1, NumFeatures()].
+   *
+   * @param token The given token.
+   */
+  size_t Value(const Token& token) const
+  {
+    return (Hash(token) % numFeatures) + 1;
+  }
+
+  //! Get the size of the dictionary (the number of features).
+  size_t Size() const { return numFeatures; }
+
+  //! Clear the dictionary (there is nothing to clear).
+  void Clear() { }
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of features.
+  size_t& NumFeatures() { return numFeatures; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numFeatures));
+  }
+
+ private:
+  //! Compute the FNV-1a hash of the given bytes.
+  static uint64_t HashBytes(const unsigned char* bytes, const size_t size)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+
+    return hash;
+  }
+
+  //! Hash a string token.
+  static uint64_t Hash(const std::string_view token)
+  {
+    return HashBytes((const unsigned char*) token.data(), token.size());
+  }
+
+  //! Hash an integer token (such as a character from CharExtract), as its
+  //! eight little-endian bytes.
+  template<typename T>
+  static uint64_t Hash(const T& token,
+      const typename std::enable_if<std::is_integral<T>::value>::type* = 0)
+  {
+    const uint64_t value = (uint64_t) token;
+    unsigned char bytes[8];
+    for (size_t i = 0; i < 8; ++i)
+      bytes[i] = (unsigned char) (value >> (8 * i));
+
+    return HashBytes(bytes, 8);
+  }
+
+  //! Hash any other token with std::hash.
+  template<typename T>
+  static uint64_t Hash(const T& token,
+      const typename std::enable_if<!std::is_integral<T>::value &&
+          !std::is_convertible<T, std::string_view>::value>::type* = 0)
+  {
+    return std::hash<T>()(token);
+  }
+
+  //! The number of features.
+  size_t numFeatures;
+};
+
 } // namespace data
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 // In case it hasn't been included yet.
 #include "string_encoding.hpp"
 #include <type_traits>
+#include <unordered_map>
 
 namespace mlpack {
 namespace data {
@@ -196,6 +197,232 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::countEncoding>::type*)
+{
+  policy.Reset();
+
+  arma::uvec rowIndices, colPtrs;
+  arma::Col<ElemType> values;
+  EncodeCounts(input, tokenizer, policy, rowIndices, colPtrs, values);
+
+  output = arma::SpMat<ElemType>(rowIndices, colPtrs, values,
+      dictionary.Size(), input.size());
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::Mat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::countEncoding>::type*)
+{
+  policy.Reset();
+
+  arma::uvec rowIndices, colPtrs;
+  arma::Col<ElemType> values;
+  EncodeCounts(input, tokenizer, policy, rowIndices, colPtrs, values);
+
+  output.zeros(dictionary.Size(), input.size());
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    for (size_t j = colPtrs[i]; j < colPtrs[i + 1]; ++j)
+      output(rowIndices[j], i) = values[j];
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::EncodeCounts(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    const PolicyType& policy,
+    arma::uvec& rowIndices,
+    arma::uvec& colPtrs,
+    arma::Col<ElemType>& values)
+{
+  using TokenType = typename std::remove_reference<
+      typename DictionaryType::TokenType>::type;
+
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  // Each thread tokenizes a chunk of consecutive strings, and labels the
+  // tokens with its own dictionary (in the order they first occur).  For each
+  // string, the local labels of the distinct tokens in it and the number of
+  // times each one occurs are stored; colPtrs[i + 1] temporarily holds the
+  // number of distinct tokens in string i.
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(numThreads, input.size()));
+  std::vector<size_t> chunkBegin(numChunks + 1);
+  for (size_t c = 0; c <= numChunks; ++c)
+    chunkBegin[c] = c * input.size() / numChunks;
+
+  std::vector<std::vector<TokenType>> chunkTokens(numChunks);
+  std::vector<std::vector<size_t>> chunkLabels(numChunks);
+  std::vector<std::vector<size_t>> chunkCounts(numChunks);
+  arma::uvec lineSizes(input.size());
+  colPtrs.zeros(input.size() + 1);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::unordered_map<TokenType, size_t> localDictionary;
+    std::vector<size_t> lineCounts, lineLabels;
+    for (size_t i = chunkBegin[c]; i < chunkBegin[c + 1]; ++i)
+    {
+      std::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       TokenType>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      size_t numTokens = 0;
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        auto it = localDictionary.find(token);
+        size_t label;
+        if (it == localDictionary.end())
+        {
+          label = chunkTokens[c].size();
+          localDictionary.emplace(token, label);
+          chunkTokens[c].push_back(token);
+          lineCounts.push_back(0);
+        }
+        else
+        {
+          label = it->second;
+        }
+
+        if (lineCounts[label]++ == 0)
+          lineLabels.push_back(label);
+
+        token = tokenizer(strView);
+        numTokens++;
+      }
+
+      for (const size_t label : lineLabels)
+      {
+        chunkLabels[c].push_back(label);
+        chunkCounts[c].push_back(lineCounts[label]);
+        lineCounts[label] = 0;
+      }
+
+      colPtrs[i + 1] = lineLabels.size();
+      lineSizes[i] = numTokens;
+      lineLabels.clear();
+    }
+  }
+
+  // Add the tokens of each chunk to the dictionary in order, so that they get
+  // the same labels as if the strings were tokenized one after another.
+  std::vector<std::vector<size_t>> chunkRows(numChunks);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    chunkRows[c].resize(chunkTokens[c].size());
+    for (size_t t = 0; t < chunkTokens[c].size(); ++t)
+    {
+      const TokenType& token = chunkTokens[c][t];
+      if (!dictionary.HasToken(token))
+        dictionary.AddToken(token);
+
+      // The labels are assigned sequentially starting from one.
+      chunkRows[c][t] = dictionary.Value(token) - 1;
+    }
+
+    chunkTokens[c].clear();
+    chunkTokens[c].shrink_to_fit();
+  }
+
+  // Map the local labels to rows, and sort the rows of each string.  With a
+  // dictionary like FeatureHashingDictionary, different tokens may map to the
+  // same row; their counts are added.
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    std::vector<std::pair<size_t, size_t>> entries;
+    size_t in = 0, out = 0;
+    for (size_t i = chunkBegin[c]; i < chunkBegin[c + 1]; ++i)
+    {
+      entries.clear();
+      for (size_t j = in; j < in + colPtrs[i + 1]; ++j)
+      {
+        entries.emplace_back(chunkRows[c][chunkLabels[c][j]],
+            chunkCounts[c][j]);
+      }
+      in += colPtrs[i + 1];
+
+      std::sort(entries.begin(), entries.end());
+      const size_t lineBegin = out;
+      for (size_t j = 0; j < entries.size(); ++j)
+      {
+        if (out > lineBegin && chunkLabels[c][out - 1] == entries[j].first)
+        {
+          chunkCounts[c][out - 1] += entries[j].second;
+        }
+        else
+        {
+          chunkLabels[c][out] = entries[j].first;
+          chunkCounts[c][out] = entries[j].second;
+          ++out;
+        }
+      }
+
+      colPtrs[i + 1] = out - lineBegin;
+    }
+
+    chunkLabels[c].resize(out);
+    chunkCounts[c].resize(out);
+  }
+
+  for (size_t i = 0; i < input.size(); ++i)
+    colPtrs[i + 1] += colPtrs[i];
+
+  // Count the number of strings that contain each token.
+  std::vector<size_t> numContainingLines(dictionary.Size(), 0);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (const size_t row : chunkLabels[c])
+      ++numContainingLines[row];
+  }
+
+  rowIndices.set_size(colPtrs[input.size()]);
+  values.set_size(colPtrs[input.size()]);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    size_t j = 0;
+    for (size_t i = chunkBegin[c]; i < chunkBegin[c + 1]; ++i)
+    {
+      for (size_t k = colPtrs[i]; k < colPtrs[i + 1]; ++k, ++j)
+      {
+        rowIndices[k] = chunkLabels[c][j];
+        values[k] = policy.template EncodeCount<ElemType>(chunkCounts[c][j],
+            lineSizes[i], numContainingLines[rowIndices[k]], input.size());
+      }
+    }
+  }
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
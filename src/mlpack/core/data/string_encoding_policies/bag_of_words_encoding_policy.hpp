@@ -134,6 +134,28 @@ class BagOfWordsEncodingPolicy
     output[line][value - 1] += 1;
   }
 
+  /**
+   * The function returns the encoded value of a token that occurs `count`
+   * times in a line, i.e. `count`.  It is used to encode lines in parallel
+   * (see StringEncodingPolicyTraits::countEncoding).
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param count The number of times the token occurs in the line.
+   * @param * (lineSize) The number of tokens in the line (not used).
+   * @param * (numContainingLines) The number of lines which contain the token
+   *                               (not used).
+   * @param * (numLines) The total number of lines (not used).
+   */
+  template<typename ElemType>
+  static ElemType EncodeCount(const size_t count,
+                              const size_t /* lineSize */,
+                              const size_t /* numContainingLines */,
+                              const size_t /* numLines */)
+  {
+    return count;
+  }
+
   /**
    * The function is not used by the bag of words encoding policy.
    *
@@ -156,6 +178,26 @@ class BagOfWordsEncodingPolicy
   }
 };
 
+/**
+ * The specialization provides some information about the bag of words encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<BagOfWordsEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each string by the number of times that
+   * each token occurs in it.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
  * and the default dictionary for the given token type.
@@ -165,6 +207,16 @@ class BagOfWordsEncodingPolicy
 template<typename TokenType>
 using BagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
                                           StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
+ * and feature hashing instead of a dictionary (see FeatureHashingDictionary).
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingBagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
+    FeatureHashingDictionary<TokenType>>;
 } // namespace data
 } // namespace mlpack
 
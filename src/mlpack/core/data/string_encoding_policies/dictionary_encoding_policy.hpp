@@ -133,6 +133,12 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy encodes each string by the number of times that
+   * each token occurs in it.
+   */
+  static const bool countEncoding = false;
 };
 
 /**
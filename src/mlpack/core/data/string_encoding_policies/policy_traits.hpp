@@ -31,6 +31,15 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each string by the number of times that
+   * each token occurs in it (given the number of tokens in the string and the
+   * number of strings that contain the token), through a function
+   * EncodeCount().  Such strings can be encoded in parallel, and directly into
+   * a sparse matrix.
+   */
+  static const bool countEncoding = false;
 };
 
 } // namespace data
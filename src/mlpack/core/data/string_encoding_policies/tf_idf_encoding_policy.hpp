@@ -191,6 +191,28 @@ class TfIdfEncodingPolicy
     output[line][value - 1] =  tf * idf;
   }
 
+  /**
+   * The function returns the tf-idf value of a token that occurs `count`
+   * times in a line.  It is used to encode lines in parallel (see
+   * StringEncodingPolicyTraits::countEncoding).
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param count The number of times the token occurs in the line.
+   * @param lineSize The number of tokens in the line.
+   * @param numContainingLines The number of lines which contain the token.
+   * @param numLines The total number of lines.
+   */
+  template<typename ElemType>
+  ElemType EncodeCount(const size_t count,
+                       const size_t lineSize,
+                       const size_t numContainingLines,
+                       const size_t numLines) const
+  {
+    return TermFrequency<ElemType>(count, lineSize) *
+        InverseDocumentFrequency<ElemType>(numLines, numContainingLines);
+  }
+
   /*
    * The function calculates the necessary statistics for the purpose
    * of the tf-idf algorithm during the first pass through the dataset.
@@ -275,7 +297,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType TermFrequency(const size_t numOccurrences,
-                          const size_t numTokens)
+                          const size_t numTokens) const
   {
     switch (tfType)
     {
@@ -304,7 +326,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType InverseDocumentFrequency(const size_t totalNumLines,
-                                     const size_t numOccurrences)
+                                     const size_t numOccurrences) const
   {
     if (smoothIdf)
     {
@@ -334,6 +356,26 @@ class TfIdfEncodingPolicy
   bool smoothIdf;
 };
 
+/**
+ * The specialization provides some information about the tf-idf encoding
+ * policy.
+ */
+template<>
+struct StringEncodingPolicyTraits<TfIdfEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy encodes each string by the number of times that
+   * each token occurs in it.
+   */
+  static const bool countEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
  * and the default dictionary for the given token type.
@@ -343,6 +385,16 @@ class TfIdfEncodingPolicy
 template<typename TokenType>
 using TfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
                                      StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy and
+ * feature hashing instead of a dictionary (see FeatureHashingDictionary).
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingTfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
+    FeatureHashingDictionary<TokenType>>;
 } // namespace data
 } // namespace mlpack
 
@@ -16,12 +16,19 @@
 #include <mlpack/prereqs.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
 
 namespace mlpack {
 namespace data {
 
 /**
- * The SplitByAnyOf class tokenizes a string using a set of delimiters.
+ * The SplitByAnyOf class tokenizes a string using a set of delimiters.  The
+ * tokens are views of the string, so tokenizing does not allocate.
+ *
+ * If there are only a few delimiters, the string is scanned for them eight
+ * bytes at a time (with memchr() if there is only one delimiter); otherwise,
+ * each character is looked up in the mask of delimiters.
  */
 class SplitByAnyOf
 {
@@ -32,17 +39,37 @@ class SplitByAnyOf
   //! A convenient alias for the mask type.
   using MaskType = std::array<bool, 1 << CHAR_BIT>;
 
+  //! The largest number of delimiters for which the string is scanned eight
+  //! bytes at a time.
+  static const size_t MaxFastDelimiters = 4;
+
   /**
    * Construct the object from the given delimiters.
    *
    * @param delimiters The given delimiters.
    */
-  SplitByAnyOf(const std::string_view delimiters)
+  SplitByAnyOf(const std::string_view delimiters) :
+      numDelimiters(0)
   {
     mask.fill(false);
+    delimiterList.fill(0);
 
     for (char symbol : delimiters)
       mask[static_cast<unsigned char>(symbol)] = true;
+
+    for (size_t i = 0; i < mask.size(); ++i)
+    {
+      if (!mask[i])
+        continue;
+
+      if (numDelimiters == MaxFastDelimiters)
+      {
+        numDelimiters = mask.size();
+        break;
+      }
+
+      delimiterList[numDelimiters++] = static_cast<unsigned char>(i);
+    }
   }
 
   /**
@@ -86,8 +113,13 @@ class SplitByAnyOf
 
   //! Return the mask.
   const MaskType& Mask() const { return mask; }
-  //! Modify the mask.
-  MaskType& Mask() { return mask; }
+  //! Modify the mask.  After this, the string is always scanned one character
+  //! at a time.
+  MaskType& Mask()
+  {
+    numDelimiters = mask.size();
+    return mask;
+  }
 
  private:
   /**
@@ -99,7 +131,44 @@ class SplitByAnyOf
    */
   size_t FindFirstDelimiter(const std::string_view str) const
   {
-    for (size_t pos = 0; pos < str.size(); pos++)
+    size_t pos = 0;
+    if (numDelimiters == 0)
+    {
+      return str.npos;
+    }
+    else if (numDelimiters == 1)
+    {
+      const void* found = std::memchr(str.data(), delimiterList[0],
+          str.size());
+      return (found == NULL) ? str.npos :
+          (size_t) (static_cast<const char*>(found) - str.data());
+    }
+    else if (numDelimiters <= MaxFastDelimiters)
+    {
+      // A byte of x is zero if and only if the corresponding byte of
+      // (x - 0x01...01) & ~x & 0x80...80 is nonzero, or a lower byte is zero;
+      // so the word holds a delimiter if the test is nonzero for the word
+      // xor'ed with any delimiter, and the delimiter is then found below.
+      const uint64_t ones = 0x0101010101010101ULL;
+      const uint64_t highs = 0x8080808080808080ULL;
+      for (; pos + 8 <= str.size(); pos += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, str.data() + pos, 8);
+
+        uint64_t found = 0;
+        for (size_t i = 0; i < numDelimiters; ++i)
+        {
+          const uint64_t x = word ^ (ones * delimiterList[i]);
+          found |= (x - ones) & ~x & highs;
+        }
+
+        if (found != 0)
+          break;
+      }
+    }
+
+    for (; pos < str.size(); pos++)
     {
       if (mask[static_cast<unsigned char>(str[pos])])
         return pos;
@@ -110,6 +179,11 @@ class SplitByAnyOf
  private:
   //! The mask that corresponds to the delimiters.
   MaskType mask;
+  //! The number of delimiters, if it is at most MaxFastDelimiters; otherwise,
+  //! the size of the mask.
+  size_t numDelimiters;
+  //! The delimiters, if there are at most MaxFastDelimiters of them.
+  std::array<unsigned char, MaxFastDelimiters> delimiterList;
 };
 
 } // namespace data
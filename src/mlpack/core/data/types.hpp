@@ -37,7 +37,10 @@ enum struct FileType
   PGMBinary,         //!< Portable Grey Map (greyscale image)
   PPMBinary,         //!< Portable Pixel Map (colour image), used by the field and cube classes
   HDF5Binary,        //!< HDF5: open binary format, not specific to Armadillo, which can store arbitrary data
-  CoordASCII         //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  CoordASCII,        //!< simple co-ordinate format for sparse matrices (indices start at zero)
+  ArrowIPC,          //!< Apache Arrow IPC file format (also known as Feather v2); requires Arrow
+  Parquet,           //!< Apache Parquet columnar format; requires Arrow
+  LibSVM             //!< libsvm (SVMLight) format for sparse data, with labels
 };
 
 /**
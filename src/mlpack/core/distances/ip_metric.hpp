@@ -24,6 +24,14 @@ namespace mlpack {
  * d(x, y) = \sqrt{ K(x, x) + K(y, y) - 2K(x, y) }.
  * @f]
  *
+ * The self-kernels K(x, x) of the points of a dataset can be cached with
+ * CacheSelfKernels(); afterwards, whenever Evaluate() or SelfKernel() is given
+ * a column of that dataset (as a subview or an alias of its memory), the cached
+ * value is used instead of evaluating the kernel again.  The cache refers to
+ * the memory of the dataset, so the dataset must not be modified, moved or
+ * destroyed while the cache is in use (call ClearSelfKernels() first).  The
+ * cache is neither copied nor serialized.
+ *
  * @tparam KernelType Type of Kernel to use.  This must be a Mercer kernel
  *     (positive definite), otherwise the metric may not be valid.
  */
@@ -58,6 +66,31 @@ class IPMetric
   template<typename VecTypeA, typename VecTypeB>
   typename VecTypeA::elem_type Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Return the self-kernel K(a, a) of the given vector, from the cache if the
+   * vector is a column of the cached dataset.
+   */
+  template<typename VecType>
+  typename VecType::elem_type SelfKernel(const VecType& a);
+
+  /**
+   * Compute and cache the self-kernel of every point in the given dataset
+   * (with OpenMP, if available).  Any previous cache is discarded.  Only dense
+   * matrices can be cached; for other matrix types, nothing is cached.
+   */
+  template<typename MatType>
+  void CacheSelfKernels(const MatType& dataset);
+
+  //! Discard the cached self-kernels.
+  void ClearSelfKernels();
+
+  //! Return whether the self-kernels of the given dataset are cached.
+  template<typename MatType>
+  bool SelfKernelsCached(const MatType& dataset) const;
+
+  //! Get the cached self-kernels (empty if there is no cache).
+  const arma::vec& SelfKernels() const { return selfKernels; }
+
   //! Get the kernel.
   const KernelType& Kernel() const { return *kernel; }
   //! Modify the kernel.
@@ -72,8 +105,48 @@ class IPMetric
   KernelType* kernel;
   //! If true, we are responsible for deleting the kernel.
   bool kernelOwner;
+
+  //! The cached self-kernels, one per column of the cached dataset.
+  arma::vec selfKernels;
+  //! The memory of the cached dataset.
+  const void* cacheMemory;
+  //! The number of rows of the cached dataset.
+  size_t cacheRows;
+  //! The size of an element of the cached dataset.
+  size_t cacheElemSize;
+
+  //! Return the index of the column of the cached dataset that the given
+  //! vector is, or SIZE_MAX if it is not one.
+  template<typename VecType>
+  size_t CachedIndex(const VecType& a) const;
 };
 
+namespace details {
+
+//! Get the memory of a dense column vector.
+template<typename eT>
+const void* VectorMemory(const arma::Col<eT>& a) { return a.memptr(); }
+
+//! Get the memory of a column of a dense matrix.
+template<typename eT>
+const void* VectorMemory(const arma::subview_col<eT>& a) { return a.colmem; }
+
+//! Other vector types (such as expressions and sparse vectors) are never
+//! columns of the cached dataset.
+template<typename VecType>
+const void* VectorMemory(const VecType& /* a */) { return NULL; }
+
+//! Get the memory of a dense matrix.
+template<typename eT>
+const void* MatrixMemory(const arma::Mat<eT>& m) { return m.memptr(); }
+
+//! The columns of other matrix types (such as sparse matrices) cannot be
+//! found from their memory.
+template<typename MatType>
+const void* MatrixMemory(const MatType& /* m */) { return NULL; }
+
+} // namespace details
+
 } // namespace mlpack
 
 // Include implementation.
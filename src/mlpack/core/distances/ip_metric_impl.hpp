@@ -24,7 +24,10 @@ namespace mlpack {
 template<typename KernelType>
 IPMetric<KernelType>::IPMetric() :
     kernel(new KernelType()),
-    kernelOwner(true)
+    kernelOwner(true),
+    cacheMemory(NULL),
+    cacheRows(0),
+    cacheElemSize(0)
 {
   // Nothing to do.
 }
@@ -33,7 +36,10 @@ IPMetric<KernelType>::IPMetric() :
 template<typename KernelType>
 IPMetric<KernelType>::IPMetric(KernelType& kernel) :
     kernel(&kernel),
-    kernelOwner(false)
+    kernelOwner(false),
+    cacheMemory(NULL),
+    cacheRows(0),
+    cacheElemSize(0)
 {
   // Nothing to do.
 }
@@ -49,9 +55,13 @@ IPMetric<KernelType>::~IPMetric()
 template<typename KernelType>
 IPMetric<KernelType>::IPMetric(const IPMetric& other) :
   kernel(new KernelType(*other.kernel)),
-  kernelOwner(true)
+  kernelOwner(true),
+  cacheMemory(NULL),
+  cacheRows(0),
+  cacheElemSize(0)
 {
-  // Nothing to do.
+  // The cache is not copied: it refers to the memory of the dataset, which may
+  // not outlive the other metric.
 }
 
 template<typename KernelType>
@@ -65,6 +75,7 @@ IPMetric<KernelType>& IPMetric<KernelType>::operator=(const IPMetric& other)
 
   kernel = new KernelType(*other.kernel);
   kernelOwner = true;
+  ClearSelfKernels();
   return *this;
 }
 
@@ -75,9 +86,89 @@ inline typename Vec1Type::elem_type IPMetric<KernelType>::Evaluate(
     const Vec2Type& b)
 {
   // This is the metric induced by the kernel function.
-  // Maybe we can do better by caching some of this?
-  return std::sqrt(kernel->Evaluate(a, a) + kernel->Evaluate(b, b) -
-      2 * kernel->Evaluate(a, b));
+  return std::sqrt(SelfKernel(a) + SelfKernel(b) - 2 * kernel->Evaluate(a, b));
+}
+
+template<typename KernelType>
+template<typename VecType>
+inline typename VecType::elem_type IPMetric<KernelType>::SelfKernel(
+    const VecType& a)
+{
+  const size_t index = CachedIndex(a);
+  if (index != SIZE_MAX)
+    return selfKernels[index];
+
+  return kernel->Evaluate(a, a);
+}
+
+template<typename KernelType>
+template<typename MatType>
+void IPMetric<KernelType>::CacheSelfKernels(const MatType& dataset)
+{
+  ClearSelfKernels();
+  const void* memory = details::MatrixMemory(dataset);
+  if (memory == NULL)
+    return;
+
+  selfKernels.set_size(dataset.n_cols);
+
+  #pragma omp parallel num_threads(Parallel::Threads())
+  {
+    // The kernel may not be safe to call from several threads at once.
+    KernelType threadKernel(*kernel);
+
+    #pragma omp for
+    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
+      selfKernels[i] = threadKernel.Evaluate(dataset.col(i), dataset.col(i));
+  }
+
+  cacheMemory = memory;
+  cacheRows = dataset.n_rows;
+  cacheElemSize = sizeof(typename MatType::elem_type);
+}
+
+template<typename KernelType>
+void IPMetric<KernelType>::ClearSelfKernels()
+{
+  selfKernels.reset();
+  cacheMemory = NULL;
+  cacheRows = 0;
+  cacheElemSize = 0;
+}
+
+template<typename KernelType>
+template<typename MatType>
+bool IPMetric<KernelType>::SelfKernelsCached(const MatType& dataset) const
+{
+  return (cacheMemory != NULL &&
+      cacheMemory == details::MatrixMemory(dataset) &&
+      selfKernels.n_elem == dataset.n_cols && cacheRows == dataset.n_rows &&
+      cacheElemSize == sizeof(typename MatType::elem_type));
+}
+
+template<typename KernelType>
+template<typename VecType>
+inline size_t IPMetric<KernelType>::CachedIndex(const VecType& a) const
+{
+  if (cacheMemory == NULL || a.n_elem != cacheRows ||
+      sizeof(typename VecType::elem_type) != cacheElemSize)
+    return SIZE_MAX;
+
+  const void* memory = details::VectorMemory(a);
+  if (memory == NULL)
+    return SIZE_MAX;
+
+  // The vector is a column of the dataset if its memory starts at the beginning
+  // of one of the columns.
+  const uintptr_t begin = (uintptr_t) cacheMemory;
+  const uintptr_t address = (uintptr_t) memory;
+  const uintptr_t columnSize = cacheRows * cacheElemSize;
+  if (address < begin || columnSize == 0 ||
+      address >= begin + selfKernels.n_elem * columnSize ||
+      (address - begin) % columnSize != 0)
+    return SIZE_MAX;
+
+  return (address - begin) / columnSize;
 }
 
 // Serialize the kernel.
@@ -93,6 +184,7 @@ void IPMetric<KernelType>::serialize(Archive& ar,
     if (kernelOwner)
       delete kernel;
     kernelOwner = true;
+    ClearSelfKernels();
   }
 
   ar(CEREAL_POINTER(kernel));
@@ -16,6 +16,7 @@
 #define MLPACK_CORE_DISTANCES_LMETRIC_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/fixed_dimension.hpp>
 
 namespace mlpack {
 
@@ -17,6 +17,67 @@
 
 namespace mlpack {
 
+namespace details {
+
+/**
+ * If the given vectors have at most maxFixedDimension elements, compute the
+ * sum of the Power-th powers of the absolute differences of their elements (or
+ * the largest absolute difference, if Power is INT_MAX) with a loop of fixed
+ * length, and return true.  This avoids the overhead of Armadillo expressions,
+ * which dominates the cost for low-dimensional points.  Otherwise, return
+ * false.
+ */
+template<int Power, typename VecTypeA, typename VecTypeB>
+bool LowDimensionalPowerSum(
+    const VecTypeA& a,
+    const VecTypeB& b,
+    typename VecTypeA::elem_type& sum,
+    const typename std::enable_if_t<IsVector<VecTypeA>::value &&
+                                    IsVector<VecTypeB>::value>* = 0)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+  return DispatchFixedDimension(a.n_elem, [&](auto fixedDim)
+  {
+    constexpr size_t D = decltype(fixedDim)::value;
+    if (D == 0)
+      return false;
+
+    // The compiler should resolve all of the branches on Power.
+    sum = 0;
+    for (size_t d = 0; d < D; ++d)
+    {
+      // This also works for unsigned elements.
+      const ElemType ad = a[d];
+      const ElemType bd = b[d];
+      const ElemType diff = (ad > bd) ? (ad - bd) : (bd - ad);
+      if (Power == INT_MAX)
+        sum = std::max(sum, diff);
+      else if (Power == 1)
+        sum += diff;
+      else if (Power == 2)
+        sum += diff * diff;
+      else
+        sum += std::pow(diff, Power);
+    }
+
+    return true;
+  });
+}
+
+//! Matrix expressions other than vectors are always evaluated by Armadillo.
+template<int Power, typename VecTypeA, typename VecTypeB>
+bool LowDimensionalPowerSum(
+    const VecTypeA& /* a */,
+    const VecTypeB& /* b */,
+    typename VecTypeA::elem_type& /* sum */,
+    const typename std::enable_if_t<!IsVector<VecTypeA>::value ||
+                                    !IsVector<VecTypeB>::value>* = 0)
+{
+  return false;
+}
+
+} // namespace details
+
 // Unspecialized implementation.  This should almost never be used...
 template<int Power, bool TakeRoot>
 template<typename VecTypeA, typename VecTypeB>
@@ -41,6 +102,10 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typename VecTypeA::elem_type sum;
+  if (details::LowDimensionalPowerSum<1>(a, b, sum))
+    return sum;
+
   return accu(abs(a - b));
 }
 
@@ -50,6 +115,10 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typename VecTypeA::elem_type sum;
+  if (details::LowDimensionalPowerSum<1>(a, b, sum))
+    return sum;
+
   return accu(abs(a - b));
 }
 
@@ -60,6 +129,10 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typename VecTypeA::elem_type sum;
+  if (details::LowDimensionalPowerSum<2>(a, b, sum))
+    return std::sqrt(sum);
+
   return arma::norm(a - b, 2);
 }
 
@@ -69,6 +142,10 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typename VecTypeA::elem_type sum;
+  if (details::LowDimensionalPowerSum<2>(a, b, sum))
+    return sum;
+
   return accu(arma::square(a - b));
 }
 
@@ -102,6 +179,10 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  typename VecTypeA::elem_type sum;
+  if (details::LowDimensionalPowerSum<INT_MAX>(a, b, sum))
+    return sum;
+
   return arma::as_scalar(arma::max(arma::abs(a - b)));
 }
 
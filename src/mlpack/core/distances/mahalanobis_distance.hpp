@@ -96,6 +96,19 @@ class MahalanobisDistance
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Compute a whitening transformation L of the Q matrix, such that
+   * Q = L^T L.  The Mahalanobis distance between x and y is then the
+   * Euclidean distance between L x and L y, so the data can be transformed
+   * once and searched with an LMetric (see MahalanobisNeighborSearch).  A
+   * Cholesky decomposition is used if Q is positive definite; otherwise, if Q
+   * is positive semidefinite, an eigendecomposition is used.  An exception is
+   * thrown if Q is not symmetric positive semidefinite.
+   *
+   * @param l Matrix to store the transformation in.
+   */
+  void Whitening(MatType& l) const;
+
   // Access the Q matrix.
   [[deprecated("Will be removed in mlpack 5.0.0.  Use Q() instead")]]
   const MatType& Covariance() const { return q; }
@@ -41,6 +41,48 @@ double MahalanobisDistance<TakeRoot, MatType>::Evaluate(
     return as_scalar(m.t() * q * m); // 1x1
 }
 
+template<bool TakeRoot, typename MatType>
+void MahalanobisDistance<TakeRoot, MatType>::Whitening(MatType& l) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  if (q.n_rows == 0 || q.n_rows != q.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisDistance::Whitening(): Q must be a non-empty square "
+        << "matrix, but it has size " << q.n_rows << "x" << q.n_cols << "!";
+    throw std::runtime_error(oss.str());
+  }
+
+  // The tolerance is relative to the size of the entries of Q.
+  const ElemType scale = std::max(arma::abs(q).max(), ElemType(1e-30));
+  const ElemType tol = 100 * q.n_rows *
+      std::numeric_limits<ElemType>::epsilon() * scale;
+  if (!q.is_symmetric(tol))
+  {
+    throw std::runtime_error("MahalanobisDistance::Whitening(): Q must be "
+        "symmetric!");
+  }
+
+  // chol() gives an upper triangular R with Q = R^T R.
+  if (arma::chol(l, q))
+    return;
+
+  // Q is singular (or not positive semidefinite); Q = V diag(lambda) V^T gives
+  // L = diag(sqrt(lambda)) V^T.
+  arma::Col<ElemType> eigval;
+  MatType eigvec;
+  if (!arma::eig_sym(eigval, eigvec, MatType(0.5 * (q + q.t()))) ||
+      arma::any(eigval < -tol))
+  {
+    throw std::runtime_error("MahalanobisDistance::Whitening(): Q must be "
+        "positive semidefinite!");
+  }
+
+  eigval.clamp(0, std::numeric_limits<ElemType>::max());
+  l = arma::diagmat(arma::sqrt(eigval)) * eigvec.t();
+}
+
 // Serialize the Mahalanobis distance.
 template<bool TakeRoot, typename MatType>
 template<typename Archive>
@@ -53,16 +53,27 @@ inline void DiagonalGaussianDistribution::LogProbability(
     arma::vec& logProbabilities) const
 {
   const size_t k = observations.n_rows;
-
-  // Column i of 'diffs' is the difference between observations.col(i) and
-  // the mean.
-  arma::mat diffs = observations.each_col() - mean;
+  const double logNorm = -0.5 * k * log2pi - 0.5 * logDetCov;
 
   // Calculates log of exponent equation in multivariate Gaussian
-  // distribution. We use only diagonal part for faster computation.
-  arma::vec logExponents = -0.5 * trans(diffs % diffs) * invCov;
-
-  logProbabilities = -0.5 * k * log2pi - 0.5 * logDetCov + logExponents;
+  // distribution. We use only diagonal part for faster computation.  This is
+  // done one column at a time, so that no temporary matrices are needed (and
+  // logProbabilities is not reallocated if it already has the right size).
+  logProbabilities.set_size(observations.n_cols);
+  const double* meanPtr = mean.memptr();
+  const double* invCovPtr = invCov.memptr();
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    const double* x = observations.colptr(i);
+    double logExponent = 0.0;
+    for (size_t j = 0; j < k; ++j)
+    {
+      const double diff = x[j] - meanPtr[j];
+      logExponent += diff * diff * invCovPtr[j];
+    }
+
+    logProbabilities[i] = logNorm - 0.5 * logExponent;
+  }
 }
 
 inline arma::vec DiagonalGaussianDistribution::Random() const
@@ -107,13 +107,25 @@ class GaussianDistribution
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
     // Column i of 'diffs' is the difference between x.col(i) and the mean.
-    arma::mat diffs = x;
-    diffs.each_col() -= mean;
-
-    // Now, we only want to calculate the diagonal elements of (diffs' * cov^-1
-    // * diffs).  We just don't need any of the other elements.
-    logProbabilities = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov +
-        sum(diffs % (-0.5 * invCov * diffs), 0).t();
+    arma::mat diffs = x.each_col() - mean;
+
+    // We only want the diagonal elements of (diffs' * cov^-1 * diffs).  Since
+    // cov^-1 = L^-T L^-1, these are the squared norms of the columns of
+    // L^-1 * diffs, which one triangular solve on the whole block gives us;
+    // this takes half the work of multiplying by invCov.
+    diffs = arma::solve(arma::trimatl(covLower), diffs,
+        arma::solve_opts::fast);
+
+    const double logNorm = -0.5 * x.n_rows * log2pi - 0.5 * logDetCov;
+    logProbabilities.set_size(x.n_cols);
+    for (size_t i = 0; i < x.n_cols; ++i)
+    {
+      const double* z = diffs.colptr(i);
+      double sumSq = 0.0;
+      for (size_t j = 0; j < diffs.n_rows; ++j)
+        sumSq += z[j] * z[j];
+      logProbabilities[i] = logNorm - 0.5 * sumSq;
+    }
   }
 
   /**
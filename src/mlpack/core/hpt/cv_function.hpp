@@ -14,12 +14,20 @@
 
 #include <mlpack/core.hpp>
 
+#include <map>
+
 namespace mlpack {
 
 /**
  * This wrapper serves for adapting the interface of the cross-validation
  * classes to the one that can be utilized by the mlpack optimizers.
  *
+ * The objective of every set of parameters that has been evaluated is
+ * memoized, so points that the optimizer visits again (for instance, the point
+ * at which Gradient() is evaluated after Evaluate() was called for it) do not
+ * rerun cross-validation.  Categorical parameters are keyed by the index of the
+ * category they map to.
+ *
  * This class is not supposed to be used directly by users. To tune
  * hyper-parameters see HyperParameterTuner.
  *
@@ -65,7 +73,8 @@ class CVFunction
              const BoundArgs&... args);
 
   /**
-   * Run cross-validation with the bound and passed parameters.
+   * Run cross-validation with the bound and passed parameters, or return the
+   * memoized objective if these parameters have been evaluated before.
    *
    * @param parameters Arguments (rather than the bound arguments) that should
    *     be passed into the Evaluate method of the CVType object.
@@ -85,6 +94,10 @@ class CVFunction
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
+  //! Get the number of times cross-validation has been run (memoized
+  //! evaluations are not counted).
+  size_t Evaluations() const { return objectives.size(); }
+
  private:
   //! The type of tuples of BoundArgs.
   using BoundArgsTupleType = std::tuple<BoundArgs...>;
@@ -124,6 +137,14 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! The objectives of the parameters evaluated so far.
+  std::map<std::vector<double>, double> objectives;
+
+  /**
+   * Get the key that the objective of the given parameters is memoized with.
+   */
+  std::vector<double> ObjectiveKey(const arma::mat& parameters) const;
+
   /**
    * Collect all arguments and run cross-validation.
    */
@@ -64,7 +64,15 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  const std::vector<double> key = ObjectiveKey(parameters);
+  typename std::map<std::vector<double>, double>::const_iterator it =
+      objectives.find(key);
+  if (it != objectives.end())
+    return it->second;
+
+  const double objective = Evaluate<0, 0>(parameters);
+  objectives[key] = objective;
+  return objective;
 }
 
 template<typename CVType,
@@ -88,6 +96,27 @@ void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Gradient(
   }
 }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+std::vector<double>
+CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::ObjectiveKey(
+    const arma::mat& parameters) const
+{
+  // Categorical parameters are passed as category indices, which are truncated
+  // when they are unmapped, so all values that unmap to the same category get
+  // the same key.
+  std::vector<double> key(parameters.n_elem);
+  for (size_t i = 0; i < parameters.n_elem; ++i)
+  {
+    key[i] = (datasetInfo.Type(i) == data::Datatype::categorical) ?
+        (double) size_t(parameters(i)) : parameters(i);
+  }
+
+  return key;
+}
+
 template<typename CVType,
          typename MLAlgorithm,
          size_t TotalArgs,
@@ -108,6 +108,18 @@ class HyperParameterTuner
   //! Access and modify the optimizer.
   OptimizerType& Optimizer() { return optimizer; }
 
+  /**
+   * Access and modify the cross-validation object that sets of hyper-parameters
+   * are assessed with.  For instance, with KFoldCV the folds of each assessment
+   * can be trained and evaluated in parallel:
+   *
+   * @code
+   * HyperParameterTuner<LARS<>, MSE, KFoldCV> hpt(k, data, responses);
+   * hpt.CrossValidation().Parallel() = true;
+   * @endcode
+   */
+  auto& CrossValidation() { return cv; }
+
   /**
    * Get relative increase of arguments for calculation of partial
    * derivatives (by the definition) in gradient-based optimization. The exact
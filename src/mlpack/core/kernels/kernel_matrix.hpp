@@ -0,0 +1,148 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Evaluation of the kernel matrix between two sets of points.  Kernels that
+ * only depend on inner products (and norms) are evaluated with one matrix
+ * multiplication (a sparse one for the p-spectrum string kernel); all other
+ * kernels are evaluated in parallel, one tile of points at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "gaussian_kernel.hpp"
+#include "linear_kernel.hpp"
+#include "polynomial_kernel.hpp"
+#include "pspectrum_string_kernel.hpp"
+
+namespace mlpack {
+
+/**
+ * KernelMatrixEvaluator computes the kernel matrix K(a_i, b_j) for the columns
+ * of two matrices.  The generic version calls KernelType::Evaluate() for each
+ * pair of points, in parallel over tiles of TileSize x TileSize points, with a
+ * copy of the kernel for each thread (since Evaluate() is not const for every
+ * kernel).  Specializations for kernels that can be written in terms of
+ * A^T B compute that product with BLAS instead.
+ *
+ * @tparam KernelType Type of kernel to evaluate.
+ */
+template<typename KernelType>
+class KernelMatrixEvaluator
+{
+ public:
+  //! Number of points along each side of the tiles.
+  static const size_t TileSize = 64;
+
+  /**
+   * Compute the kernel matrix between the columns of a and b.
+   *
+   * @param kernel Kernel to evaluate.
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param output Matrix to store the a.n_cols x b.n_cols kernel matrix in.
+   * @param symmetric If true, a and b are the same points, and only the upper
+   *     triangle is evaluated.
+   */
+  static void Evaluate(const KernelType& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& output,
+                       const bool symmetric);
+};
+
+//! The Gaussian kernel uses ||a - b||^2 = ||a||^2 + ||b||^2 - 2 a^T b.
+template<>
+class KernelMatrixEvaluator<GaussianKernel>
+{
+ public:
+  static void Evaluate(const GaussianKernel& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& output,
+                       const bool symmetric);
+};
+
+//! The polynomial kernel is (a^T b + offset)^degree.
+template<>
+class KernelMatrixEvaluator<PolynomialKernel>
+{
+ public:
+  static void Evaluate(const PolynomialKernel& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& output,
+                       const bool symmetric);
+};
+
+//! The linear kernel is a^T b.
+template<>
+class KernelMatrixEvaluator<LinearKernel>
+{
+ public:
+  static void Evaluate(const LinearKernel& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& output,
+                       const bool symmetric);
+};
+
+//! The p-spectrum string kernel is the dot product of sparse spectra.
+template<>
+class KernelMatrixEvaluator<PSpectrumStringKernel>
+{
+ public:
+  static void Evaluate(const PSpectrumStringKernel& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& output,
+                       const bool symmetric);
+};
+
+/**
+ * Compute the kernel matrix between the columns of a and b, so that
+ * output(i, j) = K(a.col(i), b.col(j)).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points.
+ * @param b Second set of points.
+ * @param output Matrix to store the a.n_cols x b.n_cols kernel matrix in.
+ */
+template<typename KernelType>
+void KernelMatrix(const KernelType& kernel,
+                  const arma::mat& a,
+                  const arma::mat& b,
+                  arma::mat& output)
+{
+  KernelMatrixEvaluator<KernelType>::Evaluate(kernel, a, b, output, false);
+}
+
+/**
+ * Compute the symmetric kernel matrix between the columns of data, so that
+ * output(i, j) = K(data.col(i), data.col(j)).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param data Set of points.
+ * @param output Matrix to store the data.n_cols x data.n_cols kernel matrix in.
+ */
+template<typename KernelType>
+void KernelMatrix(const KernelType& kernel,
+                  const arma::mat& data,
+                  arma::mat& output)
+{
+  KernelMatrixEvaluator<KernelType>::Evaluate(kernel, data, data, output,
+      true);
+}
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of the kernel matrix evaluation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+
+template<typename KernelType>
+void KernelMatrixEvaluator<KernelType>::Evaluate(const KernelType& kernel,
+                                                 const arma::mat& a,
+                                                 const arma::mat& b,
+                                                 arma::mat& output,
+                                                 const bool symmetric)
+{
+  output.set_size(a.n_cols, b.n_cols);
+
+  const size_t rowTiles = (a.n_cols + TileSize - 1) / TileSize;
+  const size_t colTiles = (b.n_cols + TileSize - 1) / TileSize;
+
+  #pragma omp parallel
+  {
+    KernelType threadKernel(kernel);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t t = 0; t < rowTiles * colTiles; ++t)
+    {
+      const size_t rowTile = t % rowTiles;
+      const size_t colTile = t / rowTiles;
+
+      // The lower triangle of a symmetric matrix is copied afterwards.
+      if (symmetric && rowTile > colTile)
+        continue;
+
+      const size_t rowEnd = std::min((rowTile + 1) * TileSize,
+          (size_t) a.n_cols);
+      const size_t colEnd = std::min((colTile + 1) * TileSize,
+          (size_t) b.n_cols);
+      for (size_t j = colTile * TileSize; j < colEnd; ++j)
+      {
+        const size_t iEnd = symmetric ? std::min(rowEnd, j + 1) : rowEnd;
+        for (size_t i = rowTile * TileSize; i < iEnd; ++i)
+        {
+          output(i, j) = threadKernel.Evaluate(a.unsafe_col(i),
+                                               b.unsafe_col(j));
+        }
+      }
+    }
+  }
+
+  if (symmetric)
+    output = arma::symmatu(output);
+}
+
+inline void KernelMatrixEvaluator<GaussianKernel>::Evaluate(
+    const GaussianKernel& kernel,
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& output,
+    const bool symmetric)
+{
+  output = a.t() * b;
+
+  const arma::vec aNorms = arma::sum(arma::square(a), 0).t();
+  const arma::rowvec bNorms = symmetric ? arma::rowvec(aNorms.t()) :
+      arma::rowvec(arma::sum(arma::square(b), 0));
+  const double gamma = kernel.Gamma();
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < (size_t) output.n_cols; ++j)
+  {
+    for (size_t i = 0; i < (size_t) output.n_rows; ++i)
+    {
+      // Rounding can make the squared distance of close points negative.
+      const double distance = aNorms[i] + bNorms[j] - 2.0 * output(i, j);
+      output(i, j) = std::exp(gamma * std::max(distance, 0.0));
+    }
+  }
+}
+
+inline void KernelMatrixEvaluator<PolynomialKernel>::Evaluate(
+    const PolynomialKernel& kernel,
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& output,
+    const bool /* symmetric */)
+{
+  output = arma::pow(a.t() * b + kernel.Offset(), kernel.Degree());
+}
+
+inline void KernelMatrixEvaluator<LinearKernel>::Evaluate(
+    const LinearKernel& /* kernel */,
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& output,
+    const bool /* symmetric */)
+{
+  output = a.t() * b;
+}
+
+inline void KernelMatrixEvaluator<PSpectrumStringKernel>::Evaluate(
+    const PSpectrumStringKernel& kernel,
+    const arma::mat& a,
+    const arma::mat& b,
+    arma::mat& output,
+    const bool symmetric)
+{
+  arma::sp_mat aSpectra;
+  kernel.Spectra(a, aSpectra);
+  if (symmetric)
+  {
+    output = arma::mat(aSpectra.t() * aSpectra);
+  }
+  else
+  {
+    arma::sp_mat bSpectra;
+    kernel.Spectra(b, bSpectra);
+    output = arma::mat(aSpectra.t() * bSpectra);
+  }
+}
+
+} // namespace mlpack
+
+#endif
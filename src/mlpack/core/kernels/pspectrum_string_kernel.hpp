@@ -60,6 +60,14 @@ namespace mlpack {
  * the data according to the fake data matrix -- resulting in a meaningless
  * tree.  This kernel was originally written for the FastMKS method; so, at the
  * very least, it will work with that.
+ *
+ * When the kernel is created, every distinct substring of length p in the
+ * datasets is given an index, and each string is represented by the sparse
+ * vector of the counts of its substrings (its spectrum; see Spectra()).  The
+ * kernel between two strings is the dot product of their spectra, which is
+ * computed by walking the two sorted lists of indices.  Kernel matrices (see
+ * KernelMatrix()) are computed with one sparse matrix product, which is what
+ * KernelPCA and the naive mode of FastMKS use.
  */
 class PSpectrumStringKernel
 {
@@ -100,11 +108,36 @@ class PSpectrumStringKernel
   //! Modify the value of p.
   size_t& P() { return p; }
 
+  /**
+   * Get the spectra of the strings of each dataset: column i of Spectra()[d]
+   * holds the counts of the substrings of string i of dataset d, indexed by
+   * substring.
+   */
+  const std::vector<arma::sp_mat>& Spectra() const { return spectra; }
+
+  /**
+   * Store the spectra of the strings given by the columns of an index matrix
+   * (as for Evaluate()) in the columns of a sparse matrix.
+   *
+   * @param indices Matrix with the dataset and string index of each string.
+   * @param output Sparse matrix to store the spectra in.
+   */
+  inline void Spectra(const arma::mat& indices, arma::sp_mat& output) const;
+
+  /**
+   * Compute the spectra from Counts().  This is done by the constructor, and
+   * only needs to be called again if Counts() is modified.
+   */
+  inline void BuildSpectra();
+
  private:
   //! Mappings of the datasets to counts of substrings.  Such a huge structure
   //! is not wonderful...
   std::vector<std::vector<std::map<std::string, int> > > counts;
 
+  //! The spectrum of each string of each dataset.
+  std::vector<arma::sp_mat> spectra;
+
   //! The value of p to use in calculation.
   size_t p;
 };
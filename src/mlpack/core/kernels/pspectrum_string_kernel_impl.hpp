@@ -83,6 +83,84 @@ inline PSpectrumStringKernel::PSpectrumStringKernel(
     }
   }
   Log::Info << "Substring extraction complete." << std::endl;
+
+  BuildSpectra();
+}
+
+inline void PSpectrumStringKernel::BuildSpectra()
+{
+  // Index the substrings in sorted order, so that the sorted keys of each map
+  // give increasing indices.
+  std::map<std::string, size_t> substrings;
+  for (size_t dataset = 0; dataset < counts.size(); ++dataset)
+    for (size_t index = 0; index < counts[dataset].size(); ++index)
+      for (const std::pair<const std::string, int>& c : counts[dataset][index])
+        substrings.emplace(c.first, 0);
+
+  size_t id = 0;
+  for (std::pair<const std::string, size_t>& s : substrings)
+    s.second = id++;
+
+  // The spectra are assembled directly in compressed sparse column format.
+  spectra.resize(counts.size());
+  for (size_t dataset = 0; dataset < counts.size(); ++dataset)
+  {
+    const std::vector<std::map<std::string, int> >& set = counts[dataset];
+
+    arma::uvec colPtrs(set.size() + 1);
+    colPtrs[0] = 0;
+    for (size_t index = 0; index < set.size(); ++index)
+      colPtrs[index + 1] = colPtrs[index] + set[index].size();
+
+    arma::uvec rowIndices(colPtrs[set.size()]);
+    arma::vec values(colPtrs[set.size()]);
+    size_t nnz = 0;
+    for (size_t index = 0; index < set.size(); ++index)
+    {
+      for (const std::pair<const std::string, int>& c : set[index])
+      {
+        rowIndices[nnz] = substrings[c.first];
+        values[nnz] = c.second;
+        ++nnz;
+      }
+    }
+
+    spectra[dataset] = arma::sp_mat(rowIndices, colPtrs, values,
+        substrings.size(), set.size());
+  }
+}
+
+inline void PSpectrumStringKernel::Spectra(const arma::mat& indices,
+                                           arma::sp_mat& output) const
+{
+  const size_t numSubstrings = spectra.empty() ? 0 : spectra[0].n_rows;
+
+  arma::uvec colPtrs(indices.n_cols + 1);
+  colPtrs[0] = 0;
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    const arma::sp_mat& set = spectra[(size_t) indices(0, i)];
+    const size_t index = (size_t) indices(1, i);
+    colPtrs[i + 1] = colPtrs[i] + (set.col_ptrs[index + 1] -
+        set.col_ptrs[index]);
+  }
+
+  arma::uvec rowIndices(colPtrs[indices.n_cols]);
+  arma::vec values(colPtrs[indices.n_cols]);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    const arma::sp_mat& set = spectra[(size_t) indices(0, i)];
+    const size_t index = (size_t) indices(1, i);
+    const size_t begin = set.col_ptrs[index];
+    const size_t nnz = set.col_ptrs[index + 1] - begin;
+    std::copy(set.row_indices + begin, set.row_indices + begin + nnz,
+        rowIndices.memptr() + colPtrs[i]);
+    std::copy(set.values + begin, set.values + begin + nnz,
+        values.memptr() + colPtrs[i]);
+  }
+
+  output = arma::sp_mat(rowIndices, colPtrs, values, numSubstrings,
+      indices.n_cols);
 }
 
 /**
@@ -99,39 +177,32 @@ template<typename VecType>
 double PSpectrumStringKernel::Evaluate(const VecType& a,
                                        const VecType& b) const
 {
-  // Get the map of substrings for the two strings we are interested in.
-  const std::map<std::string, int>& aMap = counts[a[0]][a[1]];
-  const std::map<std::string, int>& bMap = counts[b[0]][b[1]];
+  // Walk the two sorted lists of substring indices.
+  const arma::sp_mat& aSet = spectra[(size_t) a[0]];
+  const arma::sp_mat& bSet = spectra[(size_t) b[0]];
+  size_t aPos = aSet.col_ptrs[(size_t) a[1]];
+  size_t bPos = bSet.col_ptrs[(size_t) b[1]];
+  const size_t aEnd = aSet.col_ptrs[(size_t) a[1] + 1];
+  const size_t bEnd = bSet.col_ptrs[(size_t) b[1] + 1];
 
   double eval = 0;
-
-  // Loop through the two maps (which, when iterated through, are sorted
-  // alphabetically).
-  std::map<std::string, int>::const_iterator aIt = aMap.begin();
-  std::map<std::string, int>::const_iterator bIt = bMap.begin();
-
-  while ((aIt != aMap.end()) && (bIt != bMap.end()))
+  while (aPos < aEnd && bPos < bEnd)
   {
-    // Compare alphabetically (this is how std::map is ordered).
-    int result = (*aIt).first.compare((*bIt).first);
-
-    if (result == 0) // The same substring.
+    const arma::uword aIndex = aSet.row_indices[aPos];
+    const arma::uword bIndex = bSet.row_indices[bPos];
+    if (aIndex == bIndex)
     {
-      eval += ((*aIt).second * (*bIt).second);
-
-      // Now increment both.
-      ++aIt;
-      ++bIt;
+      eval += aSet.values[aPos] * bSet.values[bPos];
+      ++aPos;
+      ++bPos;
     }
-    else if (result > 0)
+    else if (aIndex < bIndex)
     {
-      // aIt is "ahead" of bIt (alphabetically); so increment bIt to "catch up".
-      ++bIt;
+      ++aPos;
     }
     else
     {
-      // bIt is "ahead" of aIt (alphabetically); so increment aIt to "catch up".
-      ++aIt;
+      ++bPos;
     }
   }
 
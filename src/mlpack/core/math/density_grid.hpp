@@ -0,0 +1,194 @@
+/**
+ * @file core/math/density_grid.hpp
+ *
+ * Definition of the DensityGrid class, a lookup table of the values of a
+ * density on a rectilinear grid, which can be used in place of a density
+ * estimator in low dimensions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_DENSITY_GRID_HPP
+#define MLPACK_CORE_MATH_DENSITY_GRID_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A DensityGrid holds the values of a density on a rectilinear grid: the grid
+ * is given by a sorted vector of coordinates for each dimension, and a point
+ * can be evaluated with a binary search in each dimension and no further
+ * traversal.  This is only useful in low dimensions, since the number of
+ * values grows exponentially with the dimensionality.
+ *
+ * The values can be used in two ways:
+ *
+ *  - If the grid is piecewise constant, there is one value per cell of the
+ *    grid.  A point that lies on the boundary between two cells takes the
+ *    value of the lower cell.  This represents the density of a DTree exactly
+ *    (see DTree::ComputeGrid()).
+ *
+ *  - If the grid is interpolated, there is one value per node of the grid, and
+ *    the value of a point is the multilinear interpolation of the values of
+ *    the corners of its cell.  This approximates a smooth density, such as
+ *    that of a KDE model (see KDE::ComputeGrid()).
+ *
+ * In both cases, the values are stored with the first dimension changing the
+ * fastest, in the same order as the points given by Nodes() or CellCenters().
+ * The density of any point outside of the grid is 0.
+ *
+ * @code
+ * DTree<> det(data);
+ * det.Grow(data, oldFromNew);
+ *
+ * DensityGrid grid;
+ * det.ComputeGrid(grid);
+ *
+ * arma::vec densities;
+ * grid.Evaluate(queries, densities);
+ * @endcode
+ */
+class DensityGrid
+{
+ public:
+  /**
+   * Create an empty grid.  It must be assigned or loaded before it is used.
+   */
+  inline DensityGrid();
+
+  /**
+   * Create a grid with the given coordinates, and with all values set to 0;
+   * the values can then be set with Values().  Each dimension must have at
+   * least two coordinates, in strictly increasing order.
+   *
+   * @param coordinates Coordinates of the grid in each dimension.
+   * @param interpolate If true, the grid holds the values of its nodes and is
+   *     interpolated; otherwise, it holds the values of its cells.
+   */
+  inline DensityGrid(std::vector<arma::vec> coordinates,
+                     const bool interpolate);
+
+  /**
+   * Create a grid with the given coordinates and values.  Each dimension must
+   * have at least two coordinates, in strictly increasing order, and there
+   * must be one value for each node (if interpolate is true) or cell of the
+   * grid.
+   *
+   * @param coordinates Coordinates of the grid in each dimension.
+   * @param values Values of the nodes or cells of the grid.
+   * @param interpolate If true, the grid holds the values of its nodes and is
+   *     interpolated; otherwise, it holds the values of its cells.
+   */
+  inline DensityGrid(std::vector<arma::vec> coordinates,
+                     arma::vec values,
+                     const bool interpolate);
+
+  /**
+   * Evaluate the density of the given point.
+   *
+   * @param point Point to evaluate.
+   * @return The density of the point, or 0 if it is outside of the grid.
+   */
+  template<typename VecType>
+  double Evaluate(const VecType& point) const;
+
+  /**
+   * Evaluate the density of each point (column) of the given matrix.  With
+   * OpenMP, the points are evaluated in parallel.
+   *
+   * @param points Points to evaluate.
+   * @param densities Vector to store the density of each point in.
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& points, arma::vec& densities) const;
+
+  /**
+   * Store the coordinates of every node of the grid, in the order of the
+   * values of an interpolated grid.
+   *
+   * @param nodes Matrix to store the nodes in (one per column).
+   */
+  inline void Nodes(arma::mat& nodes) const;
+
+  /**
+   * Store the center of every cell of the grid, in the order of the values of
+   * a piecewise constant grid.
+   *
+   * @param centers Matrix to store the centers in (one per column).
+   */
+  inline void CellCenters(arma::mat& centers) const;
+
+  //! Get the dimensionality of the grid.
+  size_t Dimensionality() const { return coordinates.size(); }
+
+  //! Get the coordinates of the grid in each dimension.
+  const std::vector<arma::vec>& Coordinates() const { return coordinates; }
+
+  //! Get the values of the nodes or cells of the grid.
+  const arma::vec& Values() const { return values; }
+  //! Modify the values of the nodes or cells of the grid.  The number of
+  //! values must not be changed.
+  arma::vec& Values() { return values; }
+
+  //! Get whether the grid is interpolated.
+  bool Interpolate() const { return interpolate; }
+
+  //! Get the largest error of the grid that was measured when it was built
+  //! (0 if it is exact).
+  double MaxError() const { return maxError; }
+  //! Modify the largest error of the grid that was measured when it was built.
+  double& MaxError() { return maxError; }
+
+  /**
+   * Serialize the grid.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Check the coordinates and compute the strides.  Returns the number of
+   * values that the grid must hold.
+   */
+  inline size_t Initialize();
+
+  /**
+   * Find the cell that holds the given point, and the position of the point
+   * in that cell (between 0 and 1 in each dimension; only computed if the
+   * grid is interpolated).  Returns false if the point is outside of the
+   * grid.
+   */
+  template<typename VecType>
+  bool Locate(const VecType& point, size_t* cell, double* position) const;
+
+  /**
+   * Compute the value of the point with the given cell and position.
+   */
+  inline double Value(const size_t* cell, const double* position) const;
+
+  //! Store the coordinates of every point of the grid, where the number of
+  //! points in each dimension is the number of coordinates minus the given
+  //! offset; if offset is 1, the cell centers are used.
+  inline void Points(arma::mat& points, const size_t offset) const;
+
+  //! The coordinates of the grid in each dimension.
+  std::vector<arma::vec> coordinates;
+  //! The values of the nodes or cells of the grid.
+  arma::vec values;
+  //! Whether the grid is interpolated.
+  bool interpolate;
+  //! The largest error measured when the grid was built.
+  double maxError;
+  //! The stride of each dimension in the values.
+  std::vector<size_t> strides;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "density_grid_impl.hpp"
+
+#endif
@@ -0,0 +1,260 @@
+/**
+ * @file core/math/density_grid_impl.hpp
+ *
+ * Implementation of the DensityGrid class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_DENSITY_GRID_IMPL_HPP
+#define MLPACK_CORE_MATH_DENSITY_GRID_IMPL_HPP
+
+#include "density_grid.hpp"
+
+namespace mlpack {
+
+inline DensityGrid::DensityGrid() :
+    interpolate(false),
+    maxError(0.0)
+{
+  // Nothing to do.
+}
+
+inline DensityGrid::DensityGrid(std::vector<arma::vec> coordinates,
+                                const bool interpolate) :
+    coordinates(std::move(coordinates)),
+    interpolate(interpolate),
+    maxError(0.0)
+{
+  values.zeros(Initialize());
+}
+
+inline DensityGrid::DensityGrid(std::vector<arma::vec> coordinates,
+                                arma::vec values,
+                                const bool interpolate) :
+    coordinates(std::move(coordinates)),
+    values(std::move(values)),
+    interpolate(interpolate),
+    maxError(0.0)
+{
+  const size_t numValues = Initialize();
+  if (this->values.n_elem != numValues)
+  {
+    std::ostringstream oss;
+    oss << "DensityGrid::DensityGrid(): expected " << numValues << " values "
+        << "for the " << (interpolate ? "nodes" : "cells") << " of the grid, "
+        << "but " << this->values.n_elem << " were given!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename VecType>
+double DensityGrid::Evaluate(const VecType& point) const
+{
+  if (point.n_elem != coordinates.size())
+  {
+    std::ostringstream oss;
+    oss << "DensityGrid::Evaluate(): point has dimensionality "
+        << point.n_elem << ", but the grid has dimensionality "
+        << coordinates.size() << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::vector<size_t> cell(coordinates.size());
+  std::vector<double> position(coordinates.size());
+  if (!Locate(point, cell.data(), position.data()))
+    return 0.0;
+
+  return Value(cell.data(), position.data());
+}
+
+template<typename MatType>
+void DensityGrid::Evaluate(const MatType& points, arma::vec& densities) const
+{
+  if (points.n_rows != coordinates.size())
+  {
+    std::ostringstream oss;
+    oss << "DensityGrid::Evaluate(): points have dimensionality "
+        << points.n_rows << ", but the grid has dimensionality "
+        << coordinates.size() << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  densities.set_size(points.n_cols);
+
+  #pragma omp parallel num_threads(Parallel::Threads())
+  {
+    // Each thread has its own buffers, so they are only allocated once.
+    std::vector<size_t> cell(coordinates.size());
+    std::vector<double> position(coordinates.size());
+
+    #pragma omp for
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      densities[i] = Locate(points.col(i), cell.data(), position.data()) ?
+          Value(cell.data(), position.data()) : 0.0;
+    }
+  }
+}
+
+inline void DensityGrid::Nodes(arma::mat& nodes) const
+{
+  Points(nodes, 0);
+}
+
+inline void DensityGrid::CellCenters(arma::mat& centers) const
+{
+  Points(centers, 1);
+}
+
+template<typename Archive>
+void DensityGrid::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(coordinates));
+  ar(CEREAL_NVP(values));
+  ar(CEREAL_NVP(interpolate));
+  ar(CEREAL_NVP(maxError));
+
+  if (cereal::is_loading<Archive>())
+  {
+    if (values.n_elem != Initialize())
+    {
+      throw std::runtime_error("DensityGrid::serialize(): the number of "
+          "values does not match the coordinates of the grid!");
+    }
+  }
+}
+
+inline size_t DensityGrid::Initialize()
+{
+  strides.resize(coordinates.size());
+
+  const size_t offset = (interpolate ? 0 : 1);
+  size_t numValues = 1;
+  for (size_t d = 0; d < coordinates.size(); ++d)
+  {
+    const arma::vec& c = coordinates[d];
+    if (c.n_elem < 2)
+    {
+      std::ostringstream oss;
+      oss << "DensityGrid: dimension " << d << " must have at least two "
+          << "coordinates, but it has " << c.n_elem << "!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    for (size_t i = 1; i < c.n_elem; ++i)
+    {
+      if (!(c[i] > c[i - 1]))
+      {
+        std::ostringstream oss;
+        oss << "DensityGrid: the coordinates of dimension " << d << " must "
+            << "be strictly increasing!";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+
+    strides[d] = numValues;
+    numValues *= (c.n_elem - offset);
+  }
+
+  return (coordinates.empty() ? 0 : numValues);
+}
+
+template<typename VecType>
+bool DensityGrid::Locate(const VecType& point,
+                         size_t* cell,
+                         double* position) const
+{
+  for (size_t d = 0; d < coordinates.size(); ++d)
+  {
+    const arma::vec& c = coordinates[d];
+    const double x = point[d];
+    // This also rejects NaN.
+    if (!(x >= c[0] && x <= c[c.n_elem - 1]))
+      return false;
+
+    if (interpolate)
+    {
+      const size_t i = std::upper_bound(c.begin(), c.end(), x) - c.begin();
+      // The last node belongs to the last cell.
+      cell[d] = std::min(i - 1, (size_t) c.n_elem - 2);
+      position[d] = (x - c[cell[d]]) / (c[cell[d] + 1] - c[cell[d]]);
+    }
+    else
+    {
+      // A point on a boundary belongs to the lower cell, like the points on a
+      // split value of a DTree.
+      const size_t i = std::lower_bound(c.begin(), c.end(), x) - c.begin();
+      cell[d] = (i == 0) ? 0 : i - 1;
+    }
+  }
+
+  return true;
+}
+
+inline double DensityGrid::Value(const size_t* cell,
+                                 const double* position) const
+{
+  if (!interpolate)
+  {
+    size_t index = 0;
+    for (size_t d = 0; d < coordinates.size(); ++d)
+      index += cell[d] * strides[d];
+
+    return values[index];
+  }
+
+  // Sum the values of the 2^d corners of the cell, each weighted by the volume
+  // of the opposite part of the cell.
+  double value = 0.0;
+  const size_t corners = ((size_t) 1 << coordinates.size());
+  for (size_t corner = 0; corner < corners; ++corner)
+  {
+    double weight = 1.0;
+    size_t index = 0;
+    for (size_t d = 0; d < coordinates.size(); ++d)
+    {
+      if ((corner >> d) & 1)
+      {
+        weight *= position[d];
+        index += (cell[d] + 1) * strides[d];
+      }
+      else
+      {
+        weight *= (1.0 - position[d]);
+        index += cell[d] * strides[d];
+      }
+    }
+
+    if (weight != 0.0)
+      value += weight * values[index];
+  }
+
+  return value;
+}
+
+inline void DensityGrid::Points(arma::mat& points, const size_t offset) const
+{
+  size_t numPoints = 1;
+  for (size_t d = 0; d < coordinates.size(); ++d)
+    numPoints *= (coordinates[d].n_elem - offset);
+
+  points.set_size(coordinates.size(), coordinates.empty() ? 0 : numPoints);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    size_t remainder = i;
+    for (size_t d = 0; d < coordinates.size(); ++d)
+    {
+      const arma::vec& c = coordinates[d];
+      const size_t k = remainder % (c.n_elem - offset);
+      remainder /= (c.n_elem - offset);
+      points(d, i) = (offset == 0) ? c[k] : (c[k] + c[k + 1]) / 2.0;
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
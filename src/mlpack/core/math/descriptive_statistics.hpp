@@ -0,0 +1,181 @@
+/**
+ * @file core/math/descriptive_statistics.hpp
+ *
+ * Definition of the DescriptiveStatistics class, which computes the moments,
+ * extremes and quantiles of each dimension of a dataset in one pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_HPP
+#define MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+
+/**
+ * DescriptiveStatistics summarizes each dimension of a dataset: the number of
+ * points, the mean, the central moments of order 2 to 4 (from which the
+ * variance, skewness and kurtosis follow), the minimum and maximum, and a
+ * QuantileSketch for the median and other quantiles.  The points are given in
+ * one pass, one chunk at a time, so a dataset that does not fit in memory can
+ * be summarized with a data::ChunkedReader:
+ *
+ * @code
+ * data::ChunkedReader<double> reader("dataset.csv", 100000);
+ * DescriptiveStatistics stats;
+ * arma::mat chunk;
+ * while (reader.Next(chunk))
+ *   stats.Update(chunk);
+ *
+ * const arma::vec mean = stats.Mean();
+ * const arma::vec median = stats.Median();
+ * @endcode
+ *
+ * The summaries can be merged (the moments with the pairwise formulas of
+ * Pebay, "Formulas for robust, one-pass parallel computation of covariances
+ * and arbitrary-order statistical moments", 2008), so Update() splits each
+ * chunk into blocks, which are summarized in parallel with OpenMP and merged
+ * in order; the results do not depend on the number of threads.  The
+ * moments of each block are computed with two passes over the block, which is
+ * as accurate as two passes over the whole dataset in practice.
+ */
+class DescriptiveStatistics
+{
+ public:
+  /**
+   * Create an empty summary.  If the dimensionality is 0, it is set by the
+   * first call to Update().
+   *
+   * @param dimensionality Number of dimensions of the points.
+   * @param sketchSize Accuracy parameter of the quantile sketches (see
+   *     QuantileSketch).
+   */
+  inline DescriptiveStatistics(const size_t dimensionality = 0,
+                               const size_t sketchSize = 200);
+
+  /**
+   * Add the given points (one per column) to the summary.
+   *
+   * @param data Points to add.
+   */
+  template<typename MatType>
+  void Update(const MatType& data);
+
+  /**
+   * Merge the given summary into this one; afterwards, this summary describes
+   * the points of both.
+   *
+   * @param other Summary to merge.
+   */
+  inline void Merge(const DescriptiveStatistics& other);
+
+  //! Get the number of dimensions of the points.
+  size_t Dimensionality() const { return mean.n_elem; }
+  //! Get the number of points that were added.
+  size_t Count() const { return count; }
+
+  //! Get the mean of each dimension.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the minimum of each dimension.
+  const arma::vec& Min() const { return min; }
+  //! Get the maximum of each dimension.
+  const arma::vec& Max() const { return max; }
+
+  /**
+   * Get the variance of each dimension.
+   *
+   * @param population If true, the points are the population; otherwise, they
+   *     are a sample, and the unbiased estimate is returned.
+   */
+  inline arma::vec Variance(const bool population = false) const;
+
+  /**
+   * Get the standard deviation of each dimension.
+   *
+   * @param population If true, the points are the population; otherwise, they
+   *     are a sample.
+   */
+  inline arma::vec Stddev(const bool population = false) const;
+
+  /**
+   * Get the skewness of each dimension.
+   *
+   * @param population If true, the points are the population; otherwise, they
+   *     are a sample, and the adjusted Fisher-Pearson coefficient is returned.
+   */
+  inline arma::vec Skewness(const bool population = false) const;
+
+  /**
+   * Get the excess kurtosis of each dimension.
+   *
+   * @param population If true, the points are the population; otherwise, they
+   *     are a sample, and the adjusted estimate is returned.
+   */
+  inline arma::vec Kurtosis(const bool population = false) const;
+
+  /**
+   * Get the approximate q-quantile of each dimension (see
+   * QuantileSketch::Quantile()).
+   *
+   * @param q Quantile to get, between 0 and 1.
+   */
+  inline arma::vec Quantile(const double q) const;
+
+  //! Get the approximate median of each dimension.
+  arma::vec Median() const { return Quantile(0.5); }
+
+  //! Get the quantile sketch of a dimension.
+  const QuantileSketch& Sketch(const size_t dimension) const
+  {
+    return sketches[dimension];
+  }
+
+  /**
+   * Serialize the summary.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Set the dimensionality and reset the summary.
+  inline void Reset(const size_t dimensionality);
+
+  //! Summarize the given block of points (which must not be empty) into this
+  //! (empty) summary.
+  inline void Summarize(const arma::mat& block);
+
+  //! The number of points in each block summarized by Update().
+  static constexpr size_t BlockSize = 4096;
+
+  //! The accuracy parameter of the quantile sketches.
+  size_t sketchSize;
+  //! The number of points.
+  size_t count;
+  //! The mean of each dimension.
+  arma::vec mean;
+  //! The sum of squared deviations from the mean of each dimension.
+  arma::vec m2;
+  //! The sum of cubed deviations from the mean of each dimension.
+  arma::vec m3;
+  //! The sum of fourth powers of deviations from the mean of each dimension.
+  arma::vec m4;
+  //! The minimum of each dimension.
+  arma::vec min;
+  //! The maximum of each dimension.
+  arma::vec max;
+  //! The quantile sketch of each dimension.
+  std::vector<QuantileSketch> sketches;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "descriptive_statistics_impl.hpp"
+
+#endif
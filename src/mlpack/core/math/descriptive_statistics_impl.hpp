@@ -0,0 +1,200 @@
+/**
+ * @file core/math/descriptive_statistics_impl.hpp
+ *
+ * Implementation of the DescriptiveStatistics class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_IMPL_HPP
+#define MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_IMPL_HPP
+
+#include "descriptive_statistics.hpp"
+
+namespace mlpack {
+
+inline DescriptiveStatistics::DescriptiveStatistics(
+    const size_t dimensionality,
+    const size_t sketchSize) :
+    sketchSize(sketchSize),
+    count(0)
+{
+  Reset(dimensionality);
+}
+
+template<typename MatType>
+void DescriptiveStatistics::Update(const MatType& data)
+{
+  if (data.n_cols == 0)
+    return;
+
+  if (count == 0 && mean.n_elem == 0)
+  {
+    Reset(data.n_rows);
+  }
+  else if (data.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DescriptiveStatistics::Update(): the points have dimensionality "
+        << data.n_rows << ", but the summary has dimensionality "
+        << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each block is summarized by one thread, and the summaries are merged in
+  // the order of the blocks.
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for ordered schedule(static, 1) \
+      num_threads(Parallel::Threads())
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize, (size_t) data.n_cols) - 1;
+
+    DescriptiveStatistics partial(mean.n_elem, sketchSize);
+    partial.Summarize(arma::conv_to<arma::mat>::from(data.cols(begin, end)));
+
+    #pragma omp ordered
+    Merge(partial);
+  }
+}
+
+inline void DescriptiveStatistics::Merge(const DescriptiveStatistics& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (count == 0)
+  {
+    *this = other;
+    return;
+  }
+
+  if (other.mean.n_elem != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "DescriptiveStatistics::Merge(): cannot merge a summary with "
+        << "dimensionality " << other.mean.n_elem << " into a summary with "
+        << "dimensionality " << mean.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The higher moments use the lower moments of both summaries, so they are
+  // updated first.
+  const double na = count;
+  const double nb = other.count;
+  const double n = na + nb;
+  const arma::vec delta = other.mean - mean;
+  const arma::vec delta2 = arma::square(delta);
+
+  m4 += other.m4 +
+      arma::square(delta2) * (na * nb * (na * na - na * nb + nb * nb) /
+          (n * n * n)) +
+      6 * delta2 % (na * na * other.m2 + nb * nb * m2) / (n * n) +
+      4 * delta % (na * other.m3 - nb * m3) / n;
+  m3 += other.m3 + delta2 % delta * (na * nb * (na - nb) / (n * n)) +
+      3 * delta % (na * other.m2 - nb * m2) / n;
+  m2 += other.m2 + delta2 * (na * nb / n);
+  mean += delta * (nb / n);
+
+  min = arma::min(min, other.min);
+  max = arma::max(max, other.max);
+  for (size_t d = 0; d < sketches.size(); ++d)
+    sketches[d].Merge(other.sketches[d]);
+
+  count += other.count;
+}
+
+inline arma::vec DescriptiveStatistics::Variance(const bool population) const
+{
+  return m2 / (population ? double(count) : double(count) - 1);
+}
+
+inline arma::vec DescriptiveStatistics::Stddev(const bool population) const
+{
+  return arma::sqrt(Variance(population));
+}
+
+inline arma::vec DescriptiveStatistics::Skewness(const bool population) const
+{
+  const double n = count;
+  if (population)
+    return (m3 / n) / arma::pow(m2 / n, 1.5);
+
+  const arma::vec s3 = arma::pow(Stddev(false), 3);
+  return n * m3 / ((n - 1) * (n - 2) * s3);
+}
+
+inline arma::vec DescriptiveStatistics::Kurtosis(const bool population) const
+{
+  const double n = count;
+  if (population)
+    return n * m4 / arma::square(m2) - 3;
+
+  const arma::vec s4 = arma::square(Variance(false));
+  const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
+  const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
+  return normC * m4 / s4 - norm3;
+}
+
+inline arma::vec DescriptiveStatistics::Quantile(const double q) const
+{
+  arma::vec quantiles(sketches.size());
+  for (size_t d = 0; d < sketches.size(); ++d)
+    quantiles[d] = sketches[d].Quantile(q);
+
+  return quantiles;
+}
+
+template<typename Archive>
+void DescriptiveStatistics::serialize(Archive& ar,
+                                      const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(sketchSize));
+  ar(CEREAL_NVP(count));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(m2));
+  ar(CEREAL_NVP(m3));
+  ar(CEREAL_NVP(m4));
+  ar(CEREAL_NVP(min));
+  ar(CEREAL_NVP(max));
+  ar(CEREAL_NVP(sketches));
+}
+
+inline void DescriptiveStatistics::Reset(const size_t dimensionality)
+{
+  count = 0;
+  mean.zeros(dimensionality);
+  m2.zeros(dimensionality);
+  m3.zeros(dimensionality);
+  m4.zeros(dimensionality);
+  min.set_size(dimensionality);
+  min.fill(DBL_MAX);
+  max.set_size(dimensionality);
+  max.fill(-DBL_MAX);
+  sketches.assign(dimensionality, QuantileSketch(sketchSize));
+}
+
+inline void DescriptiveStatistics::Summarize(const arma::mat& block)
+{
+  count = block.n_cols;
+  mean = arma::mean(block, 1);
+
+  const arma::mat centered = block.each_col() - mean;
+  const arma::mat squared = arma::square(centered);
+  m2 = arma::sum(squared, 1);
+  m3 = arma::sum(squared % centered, 1);
+  m4 = arma::sum(arma::square(squared), 1);
+
+  min = arma::min(block, 1);
+  max = arma::max(block, 1);
+  for (size_t i = 0; i < block.n_cols; ++i)
+    for (size_t d = 0; d < block.n_rows; ++d)
+      sketches[d].Insert(block(d, i));
+}
+
+} // namespace mlpack
+
+#endif
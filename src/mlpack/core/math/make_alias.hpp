@@ -81,6 +81,63 @@ void MakeAlias(OutCubeType& c,
   new (&c) OutCubeType(newMem, numRows, numCols, numSlices, false, strict);
 }
 
+#ifdef MLPACK_HAS_COOT
+
+/**
+ * Reconstruct the Bandicoot vector `v` as an alias around the device memory of
+ * `oldVec`, starting at element `offset`, with `numElems` elements.  Bandicoot
+ * aliases are always strict, so `strict` is ignored.
+ */
+template<typename InVecType, typename eT>
+void MakeAlias(coot::Col<eT>& v,
+               const InVecType& oldVec,
+               const size_t numElems,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> newMem = oldVec.get_dev_mem(false) + offset;
+  typedef coot::Col<eT> AliasType;
+  v.~AliasType();
+  new (&v) AliasType(newMem, numElems);
+}
+
+/**
+ * Reconstruct the Bandicoot row vector `v` as an alias around the device memory
+ * of `oldVec`, starting at element `offset`, with `numElems` elements.
+ */
+template<typename InVecType, typename eT>
+void MakeAlias(coot::Row<eT>& v,
+               const InVecType& oldVec,
+               const size_t numElems,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> newMem = oldVec.get_dev_mem(false) + offset;
+  typedef coot::Row<eT> AliasType;
+  v.~AliasType();
+  new (&v) AliasType(newMem, numElems);
+}
+
+/**
+ * Reconstruct the Bandicoot matrix `m` as an alias around the device memory of
+ * `oldMat`, starting at element `offset`, with size `numRows` x `numCols`.
+ */
+template<typename InMatType, typename eT>
+void MakeAlias(coot::Mat<eT>& m,
+               const InMatType& oldMat,
+               const size_t numRows,
+               const size_t numCols,
+               const size_t offset = 0,
+               const bool /* strict */ = true)
+{
+  coot::dev_mem_t<eT> newMem = oldMat.get_dev_mem(false) + offset;
+  typedef coot::Mat<eT> AliasType;
+  m.~AliasType();
+  new (&m) AliasType(newMem, numRows, numCols);
+}
+
+#endif
+
 /**
  * Make `m` an alias of `in`, using the given size.
  */
@@ -96,6 +153,35 @@ void MakeAlias(arma::SpMat<eT>& m,
   m = in;
 }
 
+/**
+ * Make `m` an alias of the `numCols` columns of `in` starting at column
+ * `begin`.  The columns of a dense matrix are contiguous, so no memory is
+ * copied.
+ */
+template<typename eT>
+void MakeColsAlias(arma::Mat<eT>& m,
+                   const arma::Mat<eT>& in,
+                   const size_t begin,
+                   const size_t numCols,
+                   const bool strict = true)
+{
+  MakeAlias(m, in, in.n_rows, numCols, begin * in.n_rows, strict);
+}
+
+/**
+ * Make `m` hold the `numCols` columns of `in` starting at column `begin`.
+ */
+template<typename eT>
+void MakeColsAlias(arma::SpMat<eT>& m,
+                   const arma::SpMat<eT>& in,
+                   const size_t begin,
+                   const size_t numCols,
+                   const bool /* strict */ = true)
+{
+  // We can't make aliases of sparse objects, so just copy the columns.
+  m = in.cols(begin, begin + numCols - 1);
+}
+
 /**
  * Clear an alias so that no data is overwritten.  This resets the matrix if it
  * is an alias (and does nothing otherwise).
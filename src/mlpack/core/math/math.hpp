@@ -14,13 +14,17 @@
 
 #include "ccov.hpp"
 #include "columns_to_blocks.hpp"
+#include "density_grid.hpp"
+#include "descriptive_statistics.hpp"
 #include "digamma.hpp"
 #include "log_add.hpp"
 #include "make_alias.hpp"
 #include "multiply_slices.hpp"
 #include "quantile.hpp"
+#include "quantile_sketch.hpp"
 #include "random_basis.hpp"
 #include "random.hpp"
+#include "random_stream.hpp"
 #include "rand_vector.hpp"
 #include "range.hpp"
 #include "shuffle_data.hpp"
@@ -0,0 +1,129 @@
+/**
+ * @file core/math/quantile_sketch.hpp
+ *
+ * Definition of the QuantileSketch class, a mergeable KLL sketch that
+ * approximates the quantiles of a stream of values in a small amount of
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A QuantileSketch approximates the quantiles (such as the median) of a stream
+ * of values without storing all of them, using the KLL sketch of the following
+ * paper:
+ *
+ * @code
+ * @inproceedings{karnin2016optimal,
+ *   title={Optimal quantile approximation in streams},
+ *   author={Karnin, Z. and Lang, K. and Liberty, E.},
+ *   booktitle={2016 IEEE 57th Annual Symposium on Foundations of Computer
+ *       Science (FOCS)},
+ *   pages={71--78},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The sketch holds the values in levels; a value at level h stands for 2^h
+ * values of the stream.  When a level is full, it is sorted, and every other
+ * value is moved to the next level.  The capacity of the levels shrinks
+ * geometrically from the top, so the sketch holds about 3k values, and the
+ * error in the rank of a returned quantile is about n / k for n values.  While
+ * fewer than k values have been inserted, the quantiles are exact.
+ *
+ * Two sketches can be merged, so a stream can be split among threads (or
+ * machines) and each part summarized separately.  The compactions alternate
+ * between keeping the even and the odd values of a level, so the results do
+ * not depend on a random number generator.
+ *
+ * @code
+ * QuantileSketch sketch;
+ * for (size_t i = 0; i < values.n_elem; ++i)
+ *   sketch.Insert(values[i]);
+ * const double median = sketch.Quantile(0.5);
+ * @endcode
+ */
+class QuantileSketch
+{
+ public:
+  /**
+   * Create an empty sketch.
+   *
+   * @param k Accuracy parameter: the capacity of the top level of the sketch.
+   */
+  inline QuantileSketch(const size_t k = 200);
+
+  /**
+   * Insert a value into the sketch.
+   *
+   * @param value Value to insert.
+   */
+  inline void Insert(const double value);
+
+  /**
+   * Merge the given sketch into this one; afterwards, this sketch summarizes
+   * the values of both.
+   *
+   * @param other Sketch to merge.
+   */
+  inline void Merge(const QuantileSketch& other);
+
+  /**
+   * Get the approximate q-quantile of the inserted values: the value with rank
+   * q * (n - 1) in sorted order, so the 0-quantile is the smallest value, the
+   * 1-quantile is the largest value, and the 0.5-quantile is the (lower)
+   * median.  An exception is thrown if the sketch is empty.
+   *
+   * @param q Quantile to get, between 0 and 1.
+   */
+  inline double Quantile(const double q) const;
+
+  //! Get the number of values that were inserted.
+  size_t Count() const { return count; }
+  //! Get the number of values held by the sketch.
+  size_t Size() const { return size; }
+  //! Get the accuracy parameter of the sketch.
+  size_t K() const { return k; }
+
+  /**
+   * Serialize the sketch.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Get the capacity of the given level.
+  inline size_t Capacity(const size_t level) const;
+
+  //! Compact levels until the sketch holds no more values than its capacity.
+  inline void Compress();
+
+  //! The accuracy parameter.
+  size_t k;
+  //! The number of values that were inserted.
+  size_t count;
+  //! The number of values held in the levels.
+  size_t size;
+  //! The sum of the capacities of the levels.
+  size_t capacity;
+  //! The values of each level.
+  std::vector<std::vector<double>> levels;
+  //! Whether the next compaction of each level keeps its odd values.
+  std::vector<char> offsets;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantile_sketch_impl.hpp"
+
+#endif
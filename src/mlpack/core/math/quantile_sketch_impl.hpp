@@ -0,0 +1,171 @@
+/**
+ * @file core/math/quantile_sketch_impl.hpp
+ *
+ * Implementation of the QuantileSketch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_IMPL_HPP
+
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+
+inline QuantileSketch::QuantileSketch(const size_t k) :
+    k(k),
+    count(0),
+    size(0),
+    capacity(0)
+{
+  if (k < 2)
+  {
+    throw std::invalid_argument("QuantileSketch::QuantileSketch(): k must be "
+        "at least 2!");
+  }
+}
+
+inline void QuantileSketch::Insert(const double value)
+{
+  if (levels.empty())
+  {
+    levels.resize(1);
+    offsets.resize(1, 0);
+    capacity = Capacity(0);
+  }
+
+  levels[0].push_back(value);
+  ++size;
+  ++count;
+
+  if (size > capacity)
+    Compress();
+}
+
+inline void QuantileSketch::Merge(const QuantileSketch& other)
+{
+  if (other.count == 0)
+    return;
+
+  if (levels.size() < other.levels.size())
+  {
+    levels.resize(other.levels.size());
+    offsets.resize(other.levels.size(), 0);
+  }
+
+  for (size_t h = 0; h < other.levels.size(); ++h)
+  {
+    levels[h].insert(levels[h].end(), other.levels[h].begin(),
+        other.levels[h].end());
+  }
+
+  count += other.count;
+  size += other.size;
+
+  capacity = 0;
+  for (size_t h = 0; h < levels.size(); ++h)
+    capacity += Capacity(h);
+
+  if (size > capacity)
+    Compress();
+}
+
+inline double QuantileSketch::Quantile(const double q) const
+{
+  if (count == 0)
+  {
+    throw std::logic_error("QuantileSketch::Quantile(): no values have been "
+        "inserted!");
+  }
+
+  if (!(q >= 0.0 && q <= 1.0))
+  {
+    std::ostringstream oss;
+    oss << "QuantileSketch::Quantile(): the quantile must be between 0 and 1, "
+        << "but " << q << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each value stands for 2^h values of the stream; the weights sum to the
+  // number of inserted values.
+  std::vector<std::pair<double, size_t>> values;
+  values.reserve(size);
+  for (size_t h = 0; h < levels.size(); ++h)
+    for (size_t i = 0; i < levels[h].size(); ++i)
+      values.push_back(std::make_pair(levels[h][i], ((size_t) 1) << h));
+
+  std::sort(values.begin(), values.end());
+
+  const double rank = q * (count - 1);
+  size_t weight = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    weight += values[i].second;
+    if (weight > rank)
+      return values[i].first;
+  }
+
+  return values.back().first;
+}
+
+template<typename Archive>
+void QuantileSketch::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(k));
+  ar(CEREAL_NVP(count));
+  ar(CEREAL_NVP(size));
+  ar(CEREAL_NVP(capacity));
+  ar(CEREAL_NVP(levels));
+  ar(CEREAL_NVP(offsets));
+}
+
+inline size_t QuantileSketch::Capacity(const size_t level) const
+{
+  // The top level has capacity k, and each lower level has 2/3 of the capacity
+  // of the one above it.
+  const double depth = double(levels.size() - 1 - level);
+  return std::max((size_t) 2,
+      (size_t) std::ceil(k * std::pow(2.0 / 3.0, depth)));
+}
+
+inline void QuantileSketch::Compress()
+{
+  while (size > capacity)
+  {
+    // Compact the lowest level that is full.  Since the sketch holds more
+    // values than the sum of the capacities, there is one.
+    size_t h = 0;
+    while (levels[h].size() < Capacity(h))
+      ++h;
+
+    if (h + 1 == levels.size())
+    {
+      levels.emplace_back();
+      offsets.push_back(0);
+    }
+
+    std::vector<double>& level = levels[h];
+    std::vector<double>& next = levels[h + 1];
+    std::sort(level.begin(), level.end());
+
+    // With an odd number of values, the largest one stays in the level.
+    const size_t compacted = level.size() - (level.size() % 2);
+    for (size_t i = offsets[h]; i < compacted; i += 2)
+      next.push_back(level[i]);
+    offsets[h] = !offsets[h];
+
+    level.erase(level.begin(), level.begin() + compacted);
+    size -= compacted / 2;
+
+    capacity = 0;
+    for (size_t l = 0; l < levels.size(); ++l)
+      capacity += Capacity(l);
+  }
+}
+
+} // namespace mlpack
+
+#endif
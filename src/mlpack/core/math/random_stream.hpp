@@ -0,0 +1,264 @@
+/**
+ * @file core/math/random_stream.hpp
+ *
+ * Counter-based random number streams (Philox4x32-10), for parallel code whose
+ * results must not depend on the number of threads or on the order in which
+ * tasks are scheduled.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+#define MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "random.hpp"
+
+namespace mlpack {
+
+/**
+ * A RandomStream is a counter-based random number generator: the n'th number
+ * of the stream is a pure function of the seed, the index of the stream, and
+ * n.  The Philox4x32-10 function of Salmon et al. (2011) is used, which maps
+ * each 128-bit counter to four 32-bit random numbers, so that streams are
+ * cheap to create, statistically independent of each other, and can be filled
+ * in bulk without any dependency between consecutive numbers.
+ *
+ * The usual way to use streams is to draw one seed with RandomStreamSeed() in
+ * serial code, and then give each task of a parallel loop its own stream with
+ * the task's index:
+ *
+ * @code
+ * const uint64_t seed = RandomStreamSeed();
+ * #pragma omp parallel for
+ * for (size_t i = 0; i < numTasks; ++i)
+ * {
+ *   RandomStream stream(seed, i);
+ *   arma::vec x(1000);
+ *   stream.Fill(x); // Always the same for task i.
+ * }
+ * @endcode
+ *
+ * Since the seed comes from RandGen(), the results are reproducible with
+ * RandomSeed(), no matter how many threads the loop is run with.
+ *
+ * RandomStream is also a UniformRandomBitGenerator, so it can be used with the
+ * distributions of <random>.
+ */
+class RandomStream
+{
+ public:
+  //! The type of the numbers the stream generates.
+  typedef uint32_t result_type;
+
+  /**
+   * Create the stream with the given seed and index.
+   *
+   * @param seed Seed of the stream.
+   * @param stream Index of the stream; streams with the same seed and
+   *     different indices are independent.
+   */
+  RandomStream(const uint64_t seed, const uint64_t stream = 0) :
+      key{ (uint32_t) seed, (uint32_t) (seed >> 32) },
+      stream(stream),
+      counter(0),
+      position(4)
+  { }
+
+  //! Get the smallest number the stream can generate.
+  static constexpr result_type min() { return 0; }
+  //! Get the largest number the stream can generate.
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+  //! Get the next 32-bit random number.
+  result_type operator()()
+  {
+    if (position == 4)
+    {
+      Blocks(counter++, 1, buffer);
+      position = 0;
+    }
+
+    return buffer[position++];
+  }
+
+  //! Get a uniform random number in [0, 1), with 53 random bits.
+  double Random()
+  {
+    const uint64_t high = (*this)();
+    return ToDouble(high, (*this)());
+  }
+
+  /**
+   * Get a uniform random integer in [0, hiExclusive).  For hiExclusive below
+   * 2^32, the bias of this is below hiExclusive / 2^32.
+   */
+  size_t RandInt(const size_t hiExclusive)
+  {
+    if (hiExclusive <= max())
+      return ToInt((*this)(), hiExclusive);
+
+    return (size_t) std::floor(Random() * (double) hiExclusive);
+  }
+
+  /**
+   * Fill a dense matrix with uniform random numbers in [0, 1).  This generates
+   * many blocks at once, and starts at a new block of the stream (so any
+   * numbers left from the last block used by operator() are skipped).
+   *
+   * @param m Matrix to fill; it must already have its size.
+   */
+  template<typename MatType>
+  void Fill(MatType& m)
+  {
+    typedef typename MatType::elem_type eT;
+    // Floats only need one 32-bit number each.
+    constexpr size_t wordsPerElem = std::is_same<eT, float>::value ? 1 : 2;
+
+    eT* out = m.memptr();
+    uint32_t words[4 * ChunkBlocks];
+    size_t i = 0;
+    while (i < m.n_elem)
+    {
+      const size_t elems = std::min((size_t) m.n_elem - i,
+          4 * ChunkBlocks / wordsPerElem);
+      const size_t blocks = (elems * wordsPerElem + 3) / 4;
+      Blocks(counter, blocks, words);
+      counter += blocks;
+
+      for (size_t j = 0; j < elems; ++j)
+      {
+        if (wordsPerElem == 1)
+          out[i + j] = (eT) ((words[j] >> 8) * (1.0f / 16777216.0f));
+        else
+          out[i + j] = (eT) ToDouble(words[2 * j], words[2 * j + 1]);
+      }
+
+      i += elems;
+    }
+
+    position = 4;
+  }
+
+  /**
+   * Fill a vector with uniform random integers in [0, hiExclusive), which must
+   * be at most 2^32.  Like Fill(), this starts at a new block of the stream.
+   *
+   * @param v Vector to fill; it must already have its size.
+   * @param hiExclusive Upper bound of the integers.
+   */
+  template<typename VecType>
+  void FillInt(VecType& v, const size_t hiExclusive)
+  {
+    typedef typename VecType::elem_type eT;
+
+    eT* out = v.memptr();
+    uint32_t words[4 * ChunkBlocks];
+    size_t i = 0;
+    while (i < v.n_elem)
+    {
+      const size_t elems = std::min((size_t) v.n_elem - i, 4 * ChunkBlocks);
+      const size_t blocks = (elems + 3) / 4;
+      Blocks(counter, blocks, words);
+      counter += blocks;
+
+      for (size_t j = 0; j < elems; ++j)
+        out[i + j] = (eT) ToInt(words[j], hiExclusive);
+
+      i += elems;
+    }
+
+    position = 4;
+  }
+
+  /**
+   * Compute the Philox4x32-10 blocks for the given number of consecutive
+   * counters of this stream, writing four numbers per block.  The blocks are
+   * computed in groups, so that the compiler can vectorize the rounds.
+   *
+   * @param first Counter of the first block.
+   * @param blocks Number of blocks; at most ChunkBlocks.
+   * @param out Array of at least 4 * blocks numbers.
+   */
+  void Blocks(const uint64_t first, const size_t blocks, uint32_t* out) const
+  {
+    uint32_t c0[ChunkBlocks], c1[ChunkBlocks], c2[ChunkBlocks],
+        c3[ChunkBlocks];
+    for (size_t j = 0; j < ChunkBlocks; ++j)
+    {
+      c0[j] = (uint32_t) (first + j);
+      c1[j] = (uint32_t) ((first + j) >> 32);
+      c2[j] = (uint32_t) stream;
+      c3[j] = (uint32_t) (stream >> 32);
+    }
+
+    uint32_t k0 = key[0], k1 = key[1];
+    for (size_t round = 0; round < 10; ++round)
+    {
+      for (size_t j = 0; j < ChunkBlocks; ++j)
+      {
+        const uint64_t p0 = (uint64_t) 0xD2511F53 * c0[j];
+        const uint64_t p1 = (uint64_t) 0xCD9E8D57 * c2[j];
+        c0[j] = ((uint32_t) (p1 >> 32)) ^ c1[j] ^ k0;
+        c1[j] = (uint32_t) p1;
+        c2[j] = ((uint32_t) (p0 >> 32)) ^ c3[j] ^ k1;
+        c3[j] = (uint32_t) p0;
+      }
+
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+
+    for (size_t j = 0; j < blocks; ++j)
+    {
+      out[4 * j] = c0[j];
+      out[4 * j + 1] = c1[j];
+      out[4 * j + 2] = c2[j];
+      out[4 * j + 3] = c3[j];
+    }
+  }
+
+  //! The number of blocks that are computed at once.
+  static constexpr size_t ChunkBlocks = 16;
+
+ private:
+  //! Convert two 32-bit numbers to a double in [0, 1).
+  static double ToDouble(const uint64_t high, const uint64_t low)
+  {
+    return (double) (((high << 32) | low) >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  //! Convert a 32-bit number to an integer in [0, hiExclusive).
+  static size_t ToInt(const uint32_t word, const size_t hiExclusive)
+  {
+    return (size_t) (((uint64_t) word * hiExclusive) >> 32);
+  }
+
+  //! The key, which is the seed.
+  uint32_t key[2];
+  //! The index of the stream, which is the high half of every counter.
+  uint64_t stream;
+  //! The counter of the next block.
+  uint64_t counter;
+  //! The numbers of the last block, for operator().
+  uint32_t buffer[4];
+  //! The position of the next number in the buffer.
+  size_t position;
+};
+
+/**
+ * Draw a 64-bit seed for RandomStreams from RandGen().  This should be done in
+ * serial code, before the streams are given to parallel tasks.
+ */
+inline uint64_t RandomStreamSeed()
+{
+  const uint64_t high = RandGen()();
+  return (high << 32) | (uint64_t) RandGen()();
+}
+
+} // namespace mlpack
+
+#endif
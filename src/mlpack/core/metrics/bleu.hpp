@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include <unordered_map>
+
 namespace mlpack {
 
 /**
@@ -40,6 +42,10 @@ namespace mlpack {
  *
  * The value of BLEU Score lies in between 0 and 1.
  *
+ * The n-grams of each paragraph are counted in hash tables of word indices,
+ * so words must be hashable with std::hash (as std::string is), and the
+ * paragraphs of the corpus are processed in parallel with OpenMP.
+ *
  * @tparam ElemType Type of the quantities in BLEU, e.g. (long double,
  *         double, float).
  * @tparam PrecisionType Container type for precision for corresponding order.
@@ -128,13 +134,20 @@ class BLEU
 
  private:
   /**
-   * Extracts all the n-grams.
+   * Count the n-grams of the translation that also appear in the references.
+   * The count of each n-gram is clipped to the largest number of times it
+   * appears in any one reference.
    *
-   * @tparam WordVector Type of the tokenized vector.
-   * @param segment Tokenized sequence represented in form of vector.
+   * @tparam ReferenceType Type of the references (an array of paragraphs).
+   * @tparam WordVector Type of the tokenized paragraph.
+   * @param references References of the translated paragraph.
+   * @param translation Translated paragraph.
+   * @param matchesByOrder The matches of each order are added to this.
    */
-  template <typename WordVector>
-  std::map<WordVector, size_t> GetNGrams(const WordVector& segment);
+  template <typename ReferenceType, typename WordVector>
+  void CountMatches(const ReferenceType& references,
+                    const WordVector& translation,
+                    std::vector<size_t>& matchesByOrder) const;
 
   //! Locally-stored value of maximum length of tokens in n-grams.
   size_t maxOrder;
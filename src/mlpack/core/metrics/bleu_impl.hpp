@@ -26,22 +26,127 @@ BLEU<ElemType, PrecisionType>::BLEU(const size_t maxOrder) :
   // Nothing to do here.
 }
 
+namespace details {
+
+//! An n-gram, stored as a pointer to the indices of its words in the
+//! paragraph it is taken from.
+struct BLEUNGram
+{
+  const size_t* words;
+  size_t order;
+};
+
+//! Hash an n-gram of word indices.
+struct BLEUNGramHash
+{
+  size_t operator()(const BLEUNGram& ngram) const
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL ^ ngram.order;
+    for (size_t i = 0; i < ngram.order; ++i)
+      hash = (hash ^ ngram.words[i]) * 0x100000001b3ULL;
+    return (size_t) (hash ^ (hash >> 32));
+  }
+};
+
+//! Compare two n-grams of word indices.
+struct BLEUNGramEqual
+{
+  bool operator()(const BLEUNGram& a, const BLEUNGram& b) const
+  {
+    return a.order == b.order && std::equal(a.words, a.words + a.order,
+        b.words);
+  }
+};
+
+} // namespace details
+
 template <typename ElemType, typename PrecisionType>
-template <typename WordVector>
-std::map<WordVector, size_t> BLEU<ElemType, PrecisionType>::GetNGrams(
-    const WordVector& segment)
+template <typename ReferenceType, typename WordVector>
+void BLEU<ElemType, PrecisionType>::CountMatches(
+    const ReferenceType& references,
+    const WordVector& translation,
+    std::vector<size_t>& matchesByOrder) const
 {
-  std::map<WordVector, size_t> ngramsCount;
+  typedef typename WordVector::value_type Word;
+  typedef std::unordered_map<details::BLEUNGram, size_t,
+      details::BLEUNGramHash, details::BLEUNGramEqual> NGramIndex;
+
+  // Give each distinct word of the translation an index; n-grams are compared
+  // as sequences of these indices.
+  std::unordered_map<Word, size_t> vocabulary;
+  std::vector<size_t> translationWords;
+  translationWords.reserve(translation.size());
+  for (const auto& word : translation)
+  {
+    translationWords.push_back(
+        vocabulary.emplace(word, vocabulary.size()).first->second);
+  }
+
+  // Give each distinct n-gram of the translation an index, and count how many
+  // times it appears.
+  NGramIndex ngramIndex;
+  std::vector<size_t> translationCounts, ngramOrders;
   for (size_t order = 1; order < maxOrder + 1; ++order)
   {
-    for (size_t i = 0; i + order < segment.size() + 1; ++i)
+    for (size_t i = 0; i + order < translationWords.size() + 1; ++i)
+    {
+      const size_t index = ngramIndex.emplace(details::BLEUNGram {
+          translationWords.data() + i, order }, translationCounts.size())
+          .first->second;
+      if (index == translationCounts.size())
+      {
+        translationCounts.push_back(0);
+        ngramOrders.push_back(order);
+      }
+
+      ++translationCounts[index];
+    }
+  }
+
+  // maxReferenceCounts: the largest number of times each n-gram of the
+  // translation appears in any one reference.  Words of a reference that are
+  // not in the translation can't be part of a matching n-gram; they get an
+  // index that no word of the translation has.
+  const size_t unknownWord = std::numeric_limits<size_t>::max();
+  std::vector<size_t> maxReferenceCounts(translationCounts.size(), 0);
+  std::vector<size_t> referenceCounts(translationCounts.size());
+  std::vector<size_t> referenceWords;
+  for (const auto& reference : references)
+  {
+    referenceWords.clear();
+    for (const auto& word : reference)
+    {
+      const auto it = vocabulary.find(word);
+      referenceWords.push_back((it == vocabulary.end()) ? unknownWord :
+          it->second);
+    }
+
+    std::fill(referenceCounts.begin(), referenceCounts.end(), 0);
+    for (size_t order = 1; order < maxOrder + 1; ++order)
+    {
+      for (size_t i = 0; i + order < referenceWords.size() + 1; ++i)
+      {
+        const auto it = ngramIndex.find(details::BLEUNGram {
+            referenceWords.data() + i, order });
+        if (it != ngramIndex.end())
+          ++referenceCounts[it->second];
+      }
+    }
+
+    for (size_t k = 0; k < referenceCounts.size(); ++k)
     {
-      WordVector seq = WordVector(segment.cbegin() + i,
-                                  segment.cbegin() + i + order);
-      ngramsCount[seq]++;
+      maxReferenceCounts[k] = std::max(maxReferenceCounts[k],
+          referenceCounts[k]);
     }
   }
-  return ngramsCount;
+
+  // If an n-gram is present in both the translation and the references, then
+  // the minimum number of times it has occurred in either is considered.
+  for (size_t k = 0; k < translationCounts.size(); ++k)
+  {
+    matchesByOrder[ngramOrders[k] - 1] += std::min(translationCounts[k],
+        maxReferenceCounts[k]);
+  }
 }
 
 template <typename ElemType, typename PrecisionType>
@@ -54,6 +159,20 @@ ElemType BLEU<ElemType, PrecisionType>::Evaluate(
   // WordVector is a string container type.
   // Also, TranslationCorpusType is an array of such containers.
   typedef typename TranslationCorpusType::value_type WordVector;
+  typedef typename ReferenceCorpusType::value_type ReferenceType;
+
+  // Collect the paragraphs and their references, so that they can be
+  // processed in parallel.
+  std::vector<const ReferenceType*> references;
+  std::vector<const WordVector*> translations;
+  auto refIt = referenceCorpus.cbegin();
+  auto trIt = translationCorpus.cbegin();
+  for (; refIt != referenceCorpus.cend() && trIt != translationCorpus.cend();
+      ++refIt, ++trIt)
+  {
+    references.push_back(&(*refIt));
+    translations.push_back(&(*trIt));
+  }
 
   // matchesByOrder: It catches how many times sequence of a particular order
   // is encountered in both reference corpus and translation corpus.
@@ -63,79 +182,63 @@ ElemType BLEU<ElemType, PrecisionType>::Evaluate(
   // translation corpus.
   std::vector<size_t> possibleMatchesByOrder(maxOrder, 0);
 
-  // referenceLength: It is the sum of minimum length of the paragraph from
-  // various documents.
-  // translationLength: It is the sum of length of each paragraphs.
-  referenceLength = 0, translationLength = 0;
+  // totalReferenceLength: It is the sum of minimum length of the paragraph
+  // from various documents.
+  // totalTranslationLength: It is the sum of length of each paragraphs.
+  size_t totalReferenceLength = 0, totalTranslationLength = 0;
 
-  auto refIt = referenceCorpus.cbegin();
-  auto trIt = translationCorpus.cbegin();
-  for (; refIt != referenceCorpus.cend() && trIt != translationCorpus.cend();
-      ++refIt, ++trIt)
+  #pragma omp parallel
   {
-    size_t min = std::numeric_limits<size_t>::max();
-    for (const auto& t : *refIt)
+    std::vector<size_t> localMatchesByOrder(maxOrder, 0);
+    std::vector<size_t> localPossibleMatchesByOrder(maxOrder, 0);
+    size_t localReferenceLength = 0, localTranslationLength = 0;
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t p = 0; p < translations.size(); ++p)
     {
-      if (min > t.size())
+      const WordVector& translation = *translations[p];
+
+      size_t min = std::numeric_limits<size_t>::max();
+      for (const auto& t : *references[p])
       {
-        min = t.size();
+        if (min > t.size())
+        {
+          min = t.size();
+        }
       }
-    }
 
-    if (min == std::numeric_limits<size_t>::max())
-      min = 0;
+      if (min == std::numeric_limits<size_t>::max())
+        min = 0;
 
-    referenceLength += min;
-    translationLength += trIt->size();
+      localReferenceLength += min;
+      localTranslationLength += translation.size();
 
-    // mergedRefNGramCounts: It accumulates all the similar n-grams from
-    // various references or documents, so that there is no repetition of
-    // any key (sequence of order n).
-    std::map<WordVector, size_t> mergedRefNGramCounts;
-    for (const auto& t : *refIt)
-    {
-      // ngram: It holds the n-grams of each document/reference.
-      const std::map<WordVector, size_t> ngrams = GetNGrams(t);
-      for (auto it = ngrams.cbegin(); it != ngrams.cend(); ++it)
+      CountMatches(*references[p], translation, localMatchesByOrder);
+
+      for (size_t order = 1; order < maxOrder + 1; ++order)
       {
-        mergedRefNGramCounts[it->first] = std::max(it->second,
-            mergedRefNGramCounts[it->first]);
+        if (order < translation.size() + 1)
+          localPossibleMatchesByOrder[order - 1] += translation.size() - order
+              + 1;
       }
     }
-    // translationNGramCounts: It extracts the n-grams of the generated text
-    // sequence.
-    const std::map<WordVector, size_t> translationNGramCounts
-        = GetNGrams(*trIt);
-
-    // overlap: It holds those keys (sequence of order n) which are common to
-    // reference corpus and translation corpus.
-    std::map<WordVector, size_t> overlap;
-    for (auto it = translationNGramCounts.cbegin();
-         it != translationNGramCounts.cend();
-         ++it)
+
+    #pragma omp critical
     {
-      auto mergedIt = mergedRefNGramCounts.find(it->first);
-      if (mergedIt != mergedRefNGramCounts.end())
+      for (size_t i = 0; i < maxOrder; ++i)
       {
-        // If the key (sequence of order n) is present in both translation
-        // corpus as well as reference corpus, then the minimum number of
-        // counts it has occurred in any is considered.
-        overlap[it->first] = std::min(mergedIt->second, it->second);
+        matchesByOrder[i] += localMatchesByOrder[i];
+        possibleMatchesByOrder[i] += localPossibleMatchesByOrder[i];
       }
-    }
 
-    for (auto it = overlap.cbegin(); it != overlap.cend(); ++it)
-    {
-      matchesByOrder[it->first.size() - 1] += it->second;
-    }
-
-    for (size_t order = 1; order < maxOrder + 1; ++order)
-    {
-      if (order < trIt->size() + 1)
-        possibleMatchesByOrder[order - 1] += trIt->size() - order + 1;
+      totalReferenceLength += localReferenceLength;
+      totalTranslationLength += localTranslationLength;
     }
   }
 
+  referenceLength = totalReferenceLength;
+  translationLength = totalTranslationLength;
+
   precisions = PrecisionType(maxOrder, 0.0);
 
   if (smooth)
@@ -39,88 +39,72 @@ void NMS<UseCoordinates>::Evaluate(
       Found " + std::to_string(confidenceScores.n_cols) + " confidence \
       scores for " + std::to_string(boundingBoxes.n_cols) + " bounding boxes.");
 
-  // Clear selected bounding boxes.
-  selectedIndices.clear();
-
   // Obtain Sorted indices for bounding boxes according to
-  // their confidence scores.
-  arma::ucolvec sortedIndices = arma::sort_index(confidenceScores);
-
-  // Pre-Compute area of each bounding box.
-  arma::mat area;
-  if (UseCoordinates)
-  {
-    area = (boundingBoxes.row(2) - boundingBoxes.row(0)) %
-        (boundingBoxes.row(3) - boundingBoxes.row(1));
-  }
-  else
+  // their confidence scores, highest first.
+  const arma::uvec sortedIndices =
+      arma::flipud(arma::sort_index(confidenceScores));
+  const size_t n = sortedIndices.n_elem;
+
+  // Store the coordinates and the area of each bounding box contiguously in
+  // that order, so that the overlaps of each selected box with the remaining
+  // boxes are computed by a single loop over plain arrays.
+  arma::vec x1(n), y1(n), x2(n), y2(n), area(n);
+  for (size_t k = 0; k < n; ++k)
   {
-    area = boundingBoxes.row(2) % boundingBoxes.row(3);
-  }
-
-  while (sortedIndices.n_elem > 0)
-  {
-    size_t selectedIndex = sortedIndices(sortedIndices.n_elem - 1);
-
-    // Choose the box with the largest probability.
-    selectedIndices.insert_rows(0, arma::uvec(1).fill(selectedIndex));
-
-    // Check if there are other bounding boxes to compare with.
-    if (sortedIndices.n_elem == 1)
+    const size_t i = sortedIndices[k];
+    x1[k] = boundingBoxes(0, i);
+    y1[k] = boundingBoxes(1, i);
+    x2[k] = boundingBoxes(2, i);
+    y2[k] = boundingBoxes(3, i);
+    if (!UseCoordinates)
     {
-      break;
+      // Change height - width representation to coordinate represention.
+      x2[k] += x1[k];
+      y2[k] += y1[k];
     }
 
-    // Remove the last index.
-    sortedIndices = sortedIndices(arma::span(0, sortedIndices.n_rows - 2),
-        arma::span());
-
-    // Get x and y coordinates for remaining bounding boxes.
-    BoundingBoxesType x2 = boundingBoxes.submat(arma::uvec(1).fill(2),
-        sortedIndices);
-
-    BoundingBoxesType x1 = boundingBoxes.submat(arma::uvec(1).fill(0),
-        sortedIndices);;
+    area[k] = (x2[k] - x1[k]) * (y2[k] - y1[k]);
+  }
 
-    BoundingBoxesType y2 = boundingBoxes.submat(arma::uvec(1).fill(3),
-        sortedIndices);
+  // Boxes are processed in descending order of confidence; each box that has
+  // not been suppressed yet is selected, and suppresses all remaining boxes
+  // whose IoU with it is greater than the threshold.  The loop over the
+  // remaining boxes is run in parallel when there are many of them.
+  const size_t minParallelBoxes = 16384;
+  std::vector<char> suppressed(n, 0);
+  arma::uvec selected(n);
+  size_t numSelected = 0;
+  for (size_t k = 0; k < n; ++k)
+  {
+    if (suppressed[k])
+      continue;
 
-    BoundingBoxesType y1 = boundingBoxes.submat(arma::uvec(1).fill(1),
-        sortedIndices);
+    selected[numSelected++] = sortedIndices[k];
 
-    size_t selectedX2 = boundingBoxes(2, selectedIndex);
-    size_t selectedY2 = boundingBoxes(3, selectedIndex);
-    size_t selectedX1 = boundingBoxes(0, selectedIndex);
-    size_t selectedY1 = boundingBoxes(1, selectedIndex);
+    const double selectedX1 = x1[k];
+    const double selectedY1 = y1[k];
+    const double selectedX2 = x2[k];
+    const double selectedY2 = y2[k];
+    const double selectedArea = area[k];
 
-    if (!UseCoordinates)
+    #pragma omp parallel for schedule(static) \
+        if (n - k > minParallelBoxes)
+    for (size_t j = k + 1; j < n; ++j)
     {
-      // Change height - width representation to coordinate represention.
-      x2 = x2 + x1;
-      y2 = y2 + y1;
-      selectedX2 = selectedX2 + selectedX1;
-      selectedY2 = selectedY2 + selectedY1;
+      // Calculate the intersection between the bounding box with highest
+      // confidence score and the remaining bounding box.
+      const double intersectionArea =
+          std::max(std::min(x2[j], selectedX2) - std::max(x1[j], selectedX1),
+              0.0) *
+          std::max(std::min(y2[j], selectedY2) - std::max(y1[j], selectedY1),
+              0.0);
+      const double iou = intersectionArea /
+          (area[j] - intersectionArea + selectedArea);
+      suppressed[j] |= !(iou <= threshold);
     }
-
-    // Calculate points of intersection between the bounding box with
-    // highest confidence score and remaining bounding boxes.
-    x2 = arma::clamp(x2, DBL_MIN, selectedX2);
-    y2 = arma::clamp(y2, DBL_MIN, selectedY2);
-    x1 = arma::clamp(x1, selectedX1, DBL_MAX);
-    y1 = arma::clamp(y1, selectedY1, DBL_MAX);
-
-    BoundingBoxesType intersectionArea = arma::clamp(x2 - x1, 0.0, DBL_MAX) %
-          arma::clamp(y2 - y1, 0.0, DBL_MAX);
-
-    // Calculate IoU of remaining boxes with the last bounding box with
-    // the highest confidence score.
-    BoundingBoxesType calculateIoU = intersectionArea /
-        (area(sortedIndices).t() - intersectionArea + area(selectedIndex));
-
-    sortedIndices = sortedIndices(arma::find(calculateIoU <= threshold));
   }
 
-  selectedIndices = arma::flipud(selectedIndices);
+  selectedIndices = selected.head(numSelected);
 }
 
 template<bool UseCoordinates>
@@ -259,6 +259,49 @@ bool ContainsAddress(const AddressType1& address,
           (CompareAddresses(hiBound, address) >= 0));
 }
 
+/**
+ * Compute an ordering of the points (columns) in the given matrix by their
+ * addresses.  The addresses define the Z-order (Lebesgue) space-filling curve,
+ * so points that are consecutive in the resulting order tend to be close to
+ * each other.  This can be used to improve the locality of a sequence of
+ * independent single-tree traversals: consecutive queries then tend to visit
+ * the same tree nodes, which are likely to still be in cache.
+ *
+ * @param points Matrix of points to order.
+ * @param order Vector that will be filled with the indices of the points,
+ *     sorted by address.
+ */
+template<typename MatType>
+void AddressOrder(const MatType& points, std::vector<size_t>& order)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename std::conditional<sizeof(ElemType) * CHAR_BIT <= 32,
+                                    uint32_t,
+                                    uint64_t>::type AddressElemType;
+
+  std::vector<std::pair<arma::Col<AddressElemType>, size_t>> addresses(
+      points.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) points.n_cols; ++i)
+  {
+    addresses[i].first.zeros(points.n_rows);
+    PointToAddress(addresses[i].first, points.col(i));
+    addresses[i].second = i;
+  }
+
+  std::sort(addresses.begin(), addresses.end(),
+      [](const std::pair<arma::Col<AddressElemType>, size_t>& p1,
+         const std::pair<arma::Col<AddressElemType>, size_t>& p2)
+      {
+        return CompareAddresses(p1.first, p2.first) < 0;
+      });
+
+  order.resize(points.n_cols);
+  for (size_t i = 0; i < addresses.size(); ++i)
+    order[i] = addresses[i].second;
+}
+
 } // namespace mlpack
 
 #endif // MLPACK_CORE_TREE_ADDRESS_HPP
@@ -0,0 +1,117 @@
+/**
+ * @file core/tree/beam_single_tree_traverser.hpp
+ *
+ * A best-first single-tree traverser that only keeps the best few candidate
+ * nodes, and stops after a given number of leaves.  This gives approximate
+ * results with a bounded cost, for any type of tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEAM_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BEAM_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "tree_traits.hpp"
+
+namespace mlpack {
+
+/**
+ * The BeamSingleTreeTraverser visits the nodes of the reference tree in order
+ * of their Score(), like a priority search, but only the BeamWidth() best
+ * candidate nodes are kept at any time; the others are pruned.  The traversal
+ * of a query point also stops once MaxLeaves() leaves have been visited.  With
+ * a beam width of 1, this is like the GreedySingleTreeTraverser, except that
+ * the rules may still prune nodes; with an unbounded beam and no limit on the
+ * number of leaves, the results are exact.
+ *
+ * The RuleType class must implement BaseCase(), Score() and Rescore(), like
+ * for any other single-tree traverser.  Base cases are never computed twice for
+ * the same pair of points, even for trees in which a point can be held by more
+ * than one node (like the cover tree and the spill tree).
+ */
+template<typename TreeType, typename RuleType>
+class BeamSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the beam single-tree traverser with the given rule set.
+   *
+   * @param rule Rules to traverse with.
+   * @param beamWidth Number of candidate nodes to keep.
+   * @param maxLeaves Maximum number of leaves to visit for each query point (0
+   *     means no limit).
+   */
+  BeamSingleTreeTraverser(RuleType& rule,
+                          const size_t beamWidth = 8,
+                          const size_t maxLeaves = 0);
+
+  /**
+   * Traverse the tree with the given point.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited leaves.
+  size_t NumVisitedLeaves() const { return numVisitedLeaves; }
+  //! Modify the number of visited leaves.
+  size_t& NumVisitedLeaves() { return numVisitedLeaves; }
+
+  //! Get the number of candidate nodes to keep.
+  size_t BeamWidth() const { return beamWidth; }
+  //! Modify the number of candidate nodes to keep.
+  size_t& BeamWidth() { return beamWidth; }
+
+  //! Get the maximum number of leaves to visit for each query point.
+  size_t MaxLeaves() const { return maxLeaves; }
+  //! Modify the maximum number of leaves to visit for each query point.
+  size_t& MaxLeaves() { return maxLeaves; }
+
+ private:
+  //! Compute the base cases of the given node's points for the given query
+  //! point, skipping points that were already evaluated for it.
+  void BaseCases(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The number of candidate nodes to keep.
+  size_t beamWidth;
+
+  //! The maximum number of leaves to visit for each query point.
+  size_t maxLeaves;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The number of leaves which have been visited during traversal.
+  size_t numVisitedLeaves;
+
+  //! The candidate nodes, with their scores, sorted by decreasing score (so
+  //! the best candidate is last).  This is kept to avoid allocations.
+  std::vector<std::pair<double, TreeType*>> beam;
+
+  //! For trees that may hold a point in several nodes, the last traversal in
+  //! which each reference point was evaluated.
+  std::vector<size_t> lastVisit;
+
+  //! The number of traversals so far.
+  size_t visit;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "beam_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file core/tree/beam_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the BeamSingleTreeTraverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEAM_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BEAM_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "beam_single_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename TreeType, typename RuleType>
+BeamSingleTreeTraverser<TreeType, RuleType>::BeamSingleTreeTraverser(
+    RuleType& rule,
+    const size_t beamWidth,
+    const size_t maxLeaves) :
+    rule(rule),
+    beamWidth(beamWidth),
+    maxLeaves(maxLeaves),
+    numPrunes(0),
+    numVisitedLeaves(0),
+    visit(0)
+{
+  if (beamWidth == 0)
+  {
+    throw std::invalid_argument("BeamSingleTreeTraverser: beam width must be "
+        "greater than 0");
+  }
+}
+
+template<typename TreeType, typename RuleType>
+void BeamSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  typedef std::pair<double, TreeType*> Candidate;
+
+  ++visit;
+  beam.clear();
+
+  const double rootScore = rule.Score(queryIndex, referenceNode);
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+
+  beam.push_back(Candidate(rootScore, &referenceNode));
+  size_t leaves = 0;
+  while (!beam.empty())
+  {
+    // Take the best candidate; its score may have improved since it was
+    // scored.
+    TreeType* node = beam.back().second;
+    const double score = rule.Rescore(queryIndex, *node, beam.back().first);
+    beam.pop_back();
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    BaseCases(queryIndex, *node);
+
+    if (node->IsLeaf())
+    {
+      ++numVisitedLeaves;
+      if (maxLeaves > 0 && ++leaves == maxLeaves)
+      {
+        // The budget is spent, so every remaining candidate is pruned.
+        numPrunes += beam.size();
+        break;
+      }
+
+      continue;
+    }
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      const double childScore = rule.Score(queryIndex, node->Child(i));
+      if (childScore == DBL_MAX)
+      {
+        ++numPrunes;
+        continue;
+      }
+
+      // Candidates with the same score are taken in the order they were found.
+      typename std::vector<Candidate>::iterator position = std::lower_bound(
+          beam.begin(), beam.end(), childScore,
+          [](const Candidate& c, const double s) { return c.first > s; });
+      beam.insert(position, Candidate(childScore, &node->Child(i)));
+    }
+
+    // Only keep the best candidates.
+    if (beam.size() > beamWidth)
+    {
+      numPrunes += beam.size() - beamWidth;
+      beam.erase(beam.begin(), beam.begin() + (beam.size() - beamWidth));
+    }
+  }
+}
+
+template<typename TreeType, typename RuleType>
+void BeamSingleTreeTraverser<TreeType, RuleType>::BaseCases(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  // Unless a point can be held by more than one node, each point is only seen
+  // once anyway.
+  if (!TreeTraits<TreeType>::HasSelfChildren &&
+      TreeTraits<TreeType>::UniqueNumDescendants)
+  {
+    for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+      rule.BaseCase(queryIndex, referenceNode.Point(i));
+    return;
+  }
+
+  if (lastVisit.size() != referenceNode.Dataset().n_cols)
+    lastVisit.assign(referenceNode.Dataset().n_cols, 0);
+
+  for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
+  {
+    const size_t point = referenceNode.Point(i);
+    if (lastVisit[point] == visit)
+      continue;
+
+    lastVisit[point] = visit;
+    rule.BaseCase(queryIndex, point);
+  }
+}
+
+} // namespace mlpack
+
+#endif
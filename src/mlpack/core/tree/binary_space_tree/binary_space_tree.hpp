@@ -14,10 +14,17 @@
 #include <mlpack/prereqs.hpp>
 
 #include "../statistic.hpp"
+#include "../split_traits.hpp"
+#include "../node_pool.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 #include "midpoint_split.hpp"
 
 namespace mlpack {
 
+// Forward declaration for the friend declaration below.
+template<typename TreeType>
+class MappedTree;
+
 /**
  * A binary space partitioning tree, such as a KD-tree or a ball tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -88,6 +95,14 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! If this is the root node of a tree that was built by one of the dataset
+  //! constructors (and has children), or if PackNodes() has been called on it,
+  //! this is the pool that holds all of the descendant nodes; otherwise, it is
+  //! NULL and every node owns its children.
+  NodePool<BinarySpaceTree>* nodeArena;
+  //! If true, PackNodes() has been called on this (root) node, so nodeArena
+  //! holds the descendants in one contiguous block.
+  bool packed;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -99,8 +114,22 @@ class BinarySpaceTree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser; see
+  //! frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<BinarySpaceTree, RuleType>;
+
+  //! A breadth-first dual-tree traverser that processes the levels of the
+  //! query tree in parallel; see frontier_dual_tree_traverser.hpp.
   template<typename RuleType>
-  class BreadthFirstDualTreeTraverser;
+  using ParallelBreadthFirstDualTreeTraverser =
+      ParallelFrontierDualTreeTraverser<BinarySpaceTree, RuleType>;
+
+  //! A dual-tree traverser that uses OpenMP tasks to traverse independent
+  //! query subtrees in parallel; see parallel_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -514,7 +543,70 @@ class BinarySpaceTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::Col<ElemType>& center) const { bound.Center(center); }
 
+  /**
+   * Recompute the bound of this node and of all of its descendants from the
+   * points they hold, after the points of the dataset have been modified in
+   * place (e.g. moved slightly).  The structure of the tree and the points held
+   * by each node do not change, so the tree stays valid for any modification,
+   * but it may split the points less well than a newly built tree would.  This
+   * also updates the furthest descendant distances and the parent distances;
+   * the statistics are not changed.
+   */
+  void RefitBounds();
+
+  /**
+   * Move all of the descendant nodes of this (root) node into one contiguous
+   * block of memory, ordered so that nodes that are visited together during a
+   * traversal are close in memory.  This reduces cache misses when traversing
+   * deep trees, and does not change the structure of the tree, so the tree can
+   * still be used in the same way as any other BinarySpaceTree (e.g. it can be
+   * passed to NeighborSearch, RangeSearch, or KDE).
+   *
+   * The default layout is the van Emde Boas layout, which recursively stores
+   * the top half of the levels of each subtree before each of the subtrees
+   * below it; this has good locality for any cache size.  If breadthFirst is
+   * true, the nodes are instead stored level by level.
+   *
+   * Any pointers to the descendant nodes are invalidated by this call.  The
+   * root node itself is not moved.  Copies of a packed tree are not packed.
+   *
+   * @param breadthFirst If true, use breadth-first order instead of the van
+   *     Emde Boas layout.
+   */
+  void PackNodes(const bool breadthFirst = false);
+
+  //! Return whether or not the descendants of this node are held in a
+  //! contiguous block of memory (see PackNodes()).
+  bool IsPacked() const { return packed; }
+
+  /**
+   * Return whether or not the descendants of this node are held in a node pool
+   * owned by this node.  This is the case for the root of a tree with more than
+   * one node that was built by any of the constructors that take a dataset,
+   * and for a packed root.  The nodes of a pool are freed all at once when the
+   * root is destroyed.  Copies and deserialized trees allocate every node
+   * separately.
+   */
+  bool HasNodePool() const { return nodeArena != NULL; }
+
  private:
+  //! If true, the two children of a node can be built in parallel.  This is
+  //! only the case when the split is parallel-safe (see SplitTraits), when the
+  //! dataset is dense (swapping the columns of a sparse matrix is not a local
+  //! operation), and when the bound of a node does not depend on its sibling
+  //! (as is the case for HollowBallBound).  Since the split of a node then
+  //! only depends on the points it holds, the tree is exactly the same as one
+  //! built with a single thread.
+  static constexpr bool ParallelBuild =
+      SplitTraits<Split>::IsParallelSafe &&
+      !arma::is_SpMat<MatType>::value &&
+      !std::is_same<BoundType<DistanceType, ElemType>,
+                    HollowBallBound<DistanceType, ElemType>>::value;
+
+  //! The minimum number of points a node must hold for its children to be
+  //! built in separate OpenMP tasks.
+  static constexpr size_t ParallelBuildMinSize = 20000;
+
   /**
    * Splits the current node, assigning its left and right children recursively.
    *
@@ -538,6 +630,66 @@ class BinarySpaceTree
       const size_t maxLeafSize,
       SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
 
+  /**
+   * Create the left and right children of the current node, which will split
+   * themselves recursively.  If ParallelBuild is true and the node is large
+   * enough, the left child is built in a separate OpenMP task.
+   *
+   * @param splitCol The first column that belongs to the right child.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void CreateChildren(
+      const size_t splitCol,
+      const size_t maxLeafSize,
+      SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
+
+  /**
+   * Create the left and right children of the current node, which will split
+   * themselves recursively, and fill the changed indices.  If ParallelBuild is
+   * true and the node is large enough, the left child is built in a separate
+   * OpenMP task.
+   *
+   * @param splitCol The first column that belongs to the right child.
+   * @param oldFromNew Vector holding permuted indices.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void CreateChildren(
+      const size_t splitCol,
+      std::vector<size_t>& oldFromNew,
+      const size_t maxLeafSize,
+      SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter);
+
+  /**
+   * Delete the children of this node, and set the child pointers to NULL.  If
+   * the descendants are held in a node pool, the destructors of all of them are
+   * called and the pool is deleted instead.
+   */
+  void DeleteChildren();
+
+  /**
+   * Create a new child node of this node with the given constructor arguments.
+   * If the root of the tree has a node pool, the child is allocated from it.
+   */
+  template<typename... Args>
+  BinarySpaceTree* NewChild(Args&&... args);
+
+  //! Return the number of levels of the subtree rooted at the given node.
+  static size_t SubtreeHeight(const BinarySpaceTree* node);
+
+  /**
+   * Append the nodes of the subtree rooted at the given node, down to the
+   * given number of levels, to the given vector in van Emde Boas order.
+   *
+   * @param node Root of subtree to order.
+   * @param levels Number of levels of the subtree to order.
+   * @param order Vector to append the nodes to.
+   */
+  static void VanEmdeBoasOrder(BinarySpaceTree* node,
+                               const size_t levels,
+                               std::vector<BinarySpaceTree*>& order);
+
   /**
    * Update the bound of the current node. This method does not take into
    * account bound-specific properties.
@@ -567,6 +719,10 @@ class BinarySpaceTree
   //! Friend access is given for the default constructor.
   friend class cereal::access;
 
+  //! MappedTree creates the nodes of a tree directly from a mapped file.
+  template<typename TreeType>
+  friend class MappedTree;
+
  public:
   /**
    * Serialize the tree.
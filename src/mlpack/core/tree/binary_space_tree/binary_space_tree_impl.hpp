@@ -16,6 +16,8 @@
 
 #include <mlpack/core/util/log.hpp>
 #include <queue>
+#include <stack>
+#include <unordered_map>
 
 namespace mlpack {
 
@@ -40,8 +42,12 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
   SplitNode(maxLeafSize, splitter);
@@ -70,8 +76,12 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
@@ -106,8 +116,12 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
   for (size_t i = 0; i < data.n_cols; ++i)
@@ -143,8 +157,12 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Do the actual splitting of this node.
   SplitType<BoundType<DistanceType, ElemType>, MatType> splitter;
   SplitNode(maxLeafSize, splitter);
@@ -173,8 +191,12 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
   for (size_t i = 0; i < dataset->n_cols; ++i)
@@ -209,8 +231,12 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    nodeArena(NULL),
+    packed(false)
 {
+  MLPACK_PROFILE_SCOPE("tree_building");
+
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
   for (size_t i = 0; i < dataset->n_cols; ++i)
@@ -250,7 +276,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    nodeArena(NULL),
+    packed(false)
 {
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
@@ -281,7 +309,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    nodeArena(NULL),
+    packed(false)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -317,7 +347,9 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    nodeArena(NULL),
+    packed(false)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -361,7 +393,9 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    nodeArena(NULL),
+    packed(false)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -419,11 +453,8 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
-  left = NULL;
-  right = NULL;
   parent = other.Parent();
   begin = other.Begin();
   count = other.Count();
@@ -493,8 +524,7 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
   parent = other.Parent();
   left = other.Left();
@@ -507,6 +537,8 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  nodeArena = other.nodeArena;
+  packed = other.packed;
 
   other.left = NULL;
   other.right = NULL;
@@ -517,6 +549,8 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.nodeArena = NULL;
+  other.packed = false;
 
   return *this;
 }
@@ -545,7 +579,9 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    nodeArena(other.nodeArena),
+    packed(other.packed)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -558,6 +594,8 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.nodeArena = NULL;
+  other.packed = false;
 
   // Set new parent.
   if (left)
@@ -605,8 +643,7 @@ template<typename DistanceType,
 BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  DeleteChildren();
 
   // If we're the root, delete the matrix.
   if (!parent)
@@ -963,11 +1000,23 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
   assert(splitCol < begin + count);
 
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  // by calling their constructors (which perform this splitting process).  If
+  // this is the root and the children will be built in parallel, we first have
+  // to open the parallel region that the tasks of all descendants will run in.
+  if (ParallelBuild && parent == NULL && count >= ParallelBuildMinSize)
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      {
+        CreateChildren(splitCol, maxLeafSize, splitter);
+      }
+    }
+  }
+  else
+  {
+    CreateChildren(splitCol, maxLeafSize, splitter);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1034,11 +1083,23 @@ SplitNode(std::vector<size_t>& oldFromNew,
   assert(splitCol < begin + count);
 
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // by calling their constructors (which perform this splitting process).  If
+  // this is the root and the children will be built in parallel, we first have
+  // to open the parallel region that the tasks of all descendants will run in.
+  if (ParallelBuild && parent == NULL && count >= ParallelBuildMinSize)
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      {
+        CreateChildren(splitCol, oldFromNew, maxLeafSize, splitter);
+      }
+    }
+  }
+  else
+  {
+    CreateChildren(splitCol, oldFromNew, maxLeafSize, splitter);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::Col<ElemType> center, leftCenter, rightCenter;
@@ -1055,6 +1116,100 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+CreateChildren(const size_t splitCol,
+               const size_t maxLeafSize,
+               SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter)
+{
+  // The root of a new tree makes the pool that all of the other nodes are
+  // allocated from, before any task can need it.
+  if (parent == NULL && nodeArena == NULL)
+    nodeArena = new NodePool<BinarySpaceTree>();
+
+  // The children hold disjoint ranges of the dataset, so the left child can be
+  // built in a separate task if the split allows it.
+  #pragma omp task if (ParallelBuild && count >= ParallelBuildMinSize) \
+      shared(splitter)
+  {
+    left = NewChild(this, begin, splitCol - begin, splitter, maxLeafSize);
+  }
+
+  right = NewChild(this, splitCol, begin + count - splitCol, splitter,
+      maxLeafSize);
+
+  #pragma omp taskwait
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+CreateChildren(const size_t splitCol,
+               std::vector<size_t>& oldFromNew,
+               const size_t maxLeafSize,
+               SplitType<BoundType<DistanceType, ElemType>, MatType>& splitter)
+{
+  // The root of a new tree makes the pool that all of the other nodes are
+  // allocated from, before any task can need it.
+  if (parent == NULL && nodeArena == NULL)
+    nodeArena = new NodePool<BinarySpaceTree>();
+
+  // The children hold disjoint ranges of the dataset and of oldFromNew, so the
+  // left child can be built in a separate task if the split allows it.
+  #pragma omp task if (ParallelBuild && count >= ParallelBuildMinSize) \
+      shared(oldFromNew, splitter)
+  {
+    left = NewChild(this, begin, splitCol - begin, oldFromNew, splitter,
+        maxLeafSize);
+  }
+
+  right = NewChild(this, splitCol, begin + count - splitCol, oldFromNew,
+      splitter, maxLeafSize);
+
+  #pragma omp taskwait
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename... Args>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+NewChild(Args&&... args)
+{
+  // Only the root holds the pool.  Trees are shallow, so walking up to it is
+  // cheap compared to building the child.
+  const BinarySpaceTree* root = this;
+  while (root->parent != NULL)
+    root = root->parent;
+
+  if (root->nodeArena == NULL)
+    return new BinarySpaceTree(std::forward<Args>(args)...);
+
+  return new (root->nodeArena->Allocate()) BinarySpaceTree(
+      std::forward<Args>(args)...);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -1101,6 +1256,254 @@ UpdateBound(HollowBallBound<DistanceType, ElemType>& boundToUpdate)
     boundToUpdate |= dataset->cols(begin, begin + count - 1);
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+RefitBounds()
+{
+  // The left child is refit first, since the bound of the right child may
+  // depend on it (see UpdateBound()).
+  if (left != NULL)
+    left->RefitBounds();
+  if (right != NULL)
+    right->RefitBounds();
+
+  bound = BoundType<DistanceType, ElemType>(dataset->n_rows);
+  UpdateBound(bound);
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  if (left != NULL)
+  {
+    arma::Col<ElemType> center, leftCenter, rightCenter;
+    Center(center);
+    left->Center(leftCenter);
+    right->Center(rightCenter);
+
+    left->ParentDistance() = bound.Distance().Evaluate(center, leftCenter);
+    right->ParentDistance() = bound.Distance().Evaluate(center, rightCenter);
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+PackNodes(const bool breadthFirst)
+{
+  if (parent != NULL)
+  {
+    throw std::invalid_argument("BinarySpaceTree::PackNodes(): can only be "
+        "called on the root node of a tree!");
+  }
+
+  if (IsLeaf())
+    return;
+
+  // Collect the descendants in the order they will be stored.  The root itself
+  // is not moved, and in both orders every parent comes before its children.
+  std::vector<BinarySpaceTree*> order;
+  if (breadthFirst)
+  {
+    std::queue<BinarySpaceTree*> queue;
+    queue.push(left);
+    queue.push(right);
+    while (!queue.empty())
+    {
+      BinarySpaceTree* node = queue.front();
+      queue.pop();
+
+      order.push_back(node);
+      if (node->left)
+      {
+        queue.push(node->left);
+        queue.push(node->right);
+      }
+    }
+  }
+  else
+  {
+    VanEmdeBoasOrder(this, SubtreeHeight(this), order);
+    order.erase(order.begin()); // The root is always first.
+  }
+
+  // Move every node into the new arena.  The move constructor is used (instead
+  // of default construction and move assignment) so that no statistic is ever
+  // built for an empty node.
+  NodePool<BinarySpaceTree>* pool = new NodePool<BinarySpaceTree>();
+  BinarySpaceTree* arena = pool->AllocateBlock(order.size());
+  std::unordered_map<const BinarySpaceTree*, BinarySpaceTree*> newLocations;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    new (arena + i) BinarySpaceTree(std::move(*order[i]));
+    newLocations[order[i]] = arena + i;
+  }
+
+  // Now point every node at the new locations of its children.  The parent
+  // pointers set by the move constructor may point at old nodes, so they are
+  // all reset here too.  The child pointers held by each node still refer to
+  // the old locations.
+  left = newLocations[left];
+  right = newLocations[right];
+  left->parent = this;
+  right->parent = this;
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    BinarySpaceTree* node = arena + i;
+    if (node->left)
+    {
+      node->left = newLocations[node->left];
+      node->right = newLocations[node->right];
+      node->left->parent = node;
+      node->right->parent = node;
+    }
+  }
+
+  // The old nodes are now empty, so they can be freed without touching the new
+  // tree.
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    if (nodeArena)
+      order[i]->~BinarySpaceTree();
+    else
+      delete order[i];
+  }
+
+  delete nodeArena;
+  nodeArena = pool;
+  packed = true;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+DeleteChildren()
+{
+  if (nodeArena)
+  {
+    // The descendants do not own their children, so collect all of them first
+    // and make sure they don't try to delete anything.
+    std::vector<BinarySpaceTree*> nodes;
+    std::stack<BinarySpaceTree*> stack;
+    if (left)
+    {
+      stack.push(left);
+      stack.push(right);
+    }
+    while (!stack.empty())
+    {
+      BinarySpaceTree* node = stack.top();
+      stack.pop();
+
+      nodes.push_back(node);
+      if (node->left)
+      {
+        stack.push(node->left);
+        stack.push(node->right);
+      }
+
+      node->left = NULL;
+      node->right = NULL;
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+      nodes[i]->~BinarySpaceTree();
+    delete nodeArena;
+    nodeArena = NULL;
+    packed = false;
+  }
+  else
+  {
+    delete left;
+    delete right;
+  }
+
+  left = NULL;
+  right = NULL;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+size_t BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+SubtreeHeight(const BinarySpaceTree* node)
+{
+  if (node->IsLeaf())
+    return 1;
+
+  return 1 + std::max(SubtreeHeight(node->left), SubtreeHeight(node->right));
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+void BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+VanEmdeBoasOrder(BinarySpaceTree* node,
+                 const size_t levels,
+                 std::vector<BinarySpaceTree*>& order)
+{
+  if (levels == 1 || node->IsLeaf())
+  {
+    order.push_back(node);
+    return;
+  }
+
+  // Lay out the top half of the levels first...
+  const size_t topLevels = levels / 2;
+  VanEmdeBoasOrder(node, topLevels, order);
+
+  // ...and then each of the subtrees hanging below the top half, in order.
+  std::vector<BinarySpaceTree*> bottomRoots;
+  std::stack<std::pair<BinarySpaceTree*, size_t>> stack;
+  stack.push(std::make_pair(node, 0));
+  while (!stack.empty())
+  {
+    BinarySpaceTree* current = stack.top().first;
+    const size_t depth = stack.top().second;
+    stack.pop();
+
+    if (depth == topLevels)
+    {
+      bottomRoots.push_back(current);
+    }
+    else if (!current->IsLeaf())
+    {
+      // Push the right child first so that the left child is handled first.
+      stack.push(std::make_pair(current->right, depth + 1));
+      stack.push(std::make_pair(current->left, depth + 1));
+    }
+  }
+
+  for (size_t i = 0; i < bottomRoots.size(); ++i)
+    VanEmdeBoasOrder(bottomRoots[i], levels - topLevels, order);
+}
+
 // Default constructor (private), for cereal.
 template<typename DistanceType,
          typename StatisticType,
@@ -1120,7 +1523,9 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    nodeArena(NULL),
+    packed(false)
 {
   // Nothing to do.
 }
@@ -1144,16 +1549,11 @@ BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    DeleteChildren();
     if (!parent)
       delete dataset;
 
     parent = NULL;
-    left = NULL;
-    right = NULL;
   }
 
   ar(CEREAL_NVP(begin));
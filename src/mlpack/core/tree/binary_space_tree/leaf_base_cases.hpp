@@ -0,0 +1,119 @@
+/**
+ * @file core/tree/binary_space_tree/leaf_base_cases.hpp
+ *
+ * Helper for the dual-tree traversers of the BinarySpaceTree that evaluates
+ * all of the base cases between a query leaf and a reference leaf.  If the
+ * RuleType provides a BaseCases() method, the base cases are handed to the
+ * rules as one block, so that they can be computed together.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_LEAF_BASE_CASES_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_LEAF_BASE_CASES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+
+HAS_MEM_FUNC(BaseCases, HasBaseCasesCheck);
+
+/**
+ * Utility struct to determine whether a RuleType has a method
+ * BaseCases(const std::vector<size_t>& queryIndices, const size_t
+ * referenceBegin, const size_t referenceCount) that computes the base cases
+ * between a set of query points and a contiguous range of reference points.
+ */
+template<typename RuleType>
+struct HasBaseCases
+{
+  static const bool value = HasBaseCasesCheck<RuleType,
+      void(RuleType::*)(const std::vector<size_t>&,
+                        const size_t,
+                        const size_t)>::value;
+};
+
+/**
+ * Evaluate the base cases between every point of the query leaf that can't be
+ * pruned and every point of the reference leaf, and return the number of base
+ * cases.  Each query point is first scored against the reference node, after
+ * restoring the given traversal info.  This overload hands all of the query
+ * points that were not pruned to RuleType::BaseCases() at once.
+ *
+ * @param rule Rules to evaluate base cases with.
+ * @param queryNode Query leaf.
+ * @param referenceNode Reference leaf.
+ * @param traversalInfo Traversal info to restore before each Score() call.
+ * @param queries Storage for the indices of the query points to evaluate.
+ */
+template<typename RuleType, typename TreeType>
+size_t LeafBaseCases(
+    RuleType& rule,
+    TreeType& queryNode,
+    TreeType& referenceNode,
+    const typename RuleType::TraversalInfoType& traversalInfo,
+    std::vector<size_t>& queries,
+    const typename std::enable_if_t<HasBaseCases<RuleType>::value>* = 0)
+{
+  queries.clear();
+  const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+  for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+  {
+    // See if we need to investigate this point.  Restore the traversal
+    // information first.
+    rule.TraversalInfo() = traversalInfo;
+    const double childScore = rule.Score(query, referenceNode);
+
+    if (childScore != DBL_MAX)
+      queries.push_back(query);
+  }
+
+  rule.BaseCases(queries, referenceNode.Begin(), referenceNode.Count());
+  return queries.size() * referenceNode.Count();
+}
+
+/**
+ * Evaluate the base cases between every point of the query leaf that can't be
+ * pruned and every point of the reference leaf, and return the number of base
+ * cases.  This overload calls RuleType::BaseCase() for each pair.
+ */
+template<typename RuleType, typename TreeType>
+size_t LeafBaseCases(
+    RuleType& rule,
+    TreeType& queryNode,
+    TreeType& referenceNode,
+    const typename RuleType::TraversalInfoType& traversalInfo,
+    std::vector<size_t>& /* queries */,
+    const typename std::enable_if_t<!HasBaseCases<RuleType>::value>* = 0)
+{
+  size_t numBaseCases = 0;
+
+  // Loop through each of the points in each node.
+  const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+  const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+  for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+  {
+    // See if we need to investigate this point (this function should be
+    // implemented for the single-tree recursion too).  Restore the traversal
+    // information first.
+    rule.TraversalInfo() = traversalInfo;
+    const double childScore = rule.Score(query, referenceNode);
+
+    if (childScore == DBL_MAX)
+      continue; // We can't improve this particular point.
+
+    for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+      rule.BaseCase(query, ref);
+
+    numBaseCases += referenceNode.Count();
+  }
+
+  return numBaseCases;
+}
+
+} // namespace mlpack
+
+#endif
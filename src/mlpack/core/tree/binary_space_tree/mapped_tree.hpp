@@ -0,0 +1,269 @@
+/**
+ * @file core/tree/binary_space_tree/mapped_tree.hpp
+ *
+ * Definition of the MappedTree class, which stores a BinarySpaceTree and its
+ * dataset in a flat file that can be memory-mapped and used without any
+ * deserialization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_MAPPED_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_MAPPED_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "../hrectbound.hpp"
+#include "../ballbound.hpp"
+
+namespace mlpack {
+
+/**
+ * FlatBoundTraits describes how a bound is stored in the flat file written by
+ * MappedTree.  Bounds that are not specialized here cannot be stored.
+ *
+ * @tparam BoundType Type of bound.
+ */
+template<typename BoundType>
+struct FlatBoundTraits
+{
+  //! The identifier of the bound in the file; zero if it is not supported.
+  static const uint32_t Id = 0;
+};
+
+//! HRectBound is stored as the lower and upper bound of each dimension,
+//! followed by the minimum width.
+template<typename DistanceType, typename ElemType>
+struct FlatBoundTraits<HRectBound<DistanceType, ElemType>>
+{
+  static const uint32_t Id = 1;
+
+  //! Return the number of elements used to store a bound.
+  static size_t Size(const size_t dim) { return 2 * dim + 1; }
+
+  //! Store the bound in the given memory.
+  static void Write(const HRectBound<DistanceType, ElemType>& bound,
+                    ElemType* out)
+  {
+    for (size_t i = 0; i < bound.Dim(); ++i)
+    {
+      out[2 * i] = bound[i].Lo();
+      out[2 * i + 1] = bound[i].Hi();
+    }
+    out[2 * bound.Dim()] = bound.MinWidth();
+  }
+
+  //! Read the bound from the given memory.
+  static void Read(HRectBound<DistanceType, ElemType>& bound,
+                   const size_t dim,
+                   const ElemType* in)
+  {
+    bound = HRectBound<DistanceType, ElemType>(dim);
+    for (size_t i = 0; i < dim; ++i)
+      bound[i] = RangeType<ElemType>(in[2 * i], in[2 * i + 1]);
+    bound.MinWidth() = in[2 * dim];
+  }
+};
+
+//! BallBound is stored as the center of the ball, followed by the radius.
+template<typename DistanceType, typename ElemType>
+struct FlatBoundTraits<BallBound<DistanceType, ElemType>>
+{
+  static const uint32_t Id = 2;
+
+  //! Return the number of elements used to store a bound.
+  static size_t Size(const size_t dim) { return dim + 1; }
+
+  //! Store the bound in the given memory.
+  static void Write(const BallBound<DistanceType, ElemType>& bound,
+                    ElemType* out)
+  {
+    for (size_t i = 0; i < bound.Dim(); ++i)
+      out[i] = bound.Center()[i];
+    out[bound.Dim()] = bound.Radius();
+  }
+
+  //! Read the bound from the given memory.
+  static void Read(BallBound<DistanceType, ElemType>& bound,
+                   const size_t dim,
+                   const ElemType* in)
+  {
+    bound = BallBound<DistanceType, ElemType>(dim);
+    bound.Center() = arma::Col<ElemType>(in, dim);
+    bound.Radius() = in[dim];
+  }
+};
+
+/**
+ * MappedTree stores a BinarySpaceTree (such as a KDTree or a BallTree) and its
+ * dataset in a flat binary file, where the nodes refer to each other by index
+ * instead of by pointer.  When the file is opened, it is memory-mapped and the
+ * dataset of the tree is used in place, without being read or copied; only the
+ * small node objects are created, and no distances are computed.  This means
+ * that opening a large index is much faster than deserializing a tree or
+ * building it, and that the pages of the dataset are shared by all processes
+ * that map the same file.
+ *
+ * The mapping is private (copy-on-write), so modifying the dataset never
+ * changes the file.  Datasets that are too large to fit in memory can be
+ * indexed with Build(), which builds the tree file directly from a raw dataset
+ * file.  The MappedTree object must outlive any use of the tree
+ * (including trees that were moved out of Tree(), e.g. into NeighborSearch).
+ * The file format uses the native byte order and element size, and is not
+ * meant to be portable between architectures.  On systems without mmap(), the
+ * file is read into memory instead.
+ *
+ * @code
+ * // Build an index once...
+ * std::vector<size_t> oldFromNew;
+ * KNN::Tree tree(dataset, oldFromNew);
+ * MappedTree<KNN::Tree>::Save("index.bin", tree, oldFromNew);
+ *
+ * // ...and then open it quickly in every process that needs it.
+ * MappedTree<KNN::Tree> index("index.bin");
+ * KNN knn(std::move(index.Tree()));
+ *
+ * // An index on a dataset that does not fit in memory can be built from the
+ * // dataset file directly.
+ * MappedTree<KNN::Tree>::Build("huge.bin", 10, "huge_index.bin");
+ * @endcode
+ *
+ * @tparam TreeType Type of BinarySpaceTree; the dataset must be a dense
+ *     Armadillo matrix, and the bound must be an HRectBound or BallBound.
+ */
+template<typename TreeType>
+class MappedTree
+{
+ public:
+  //! The type of the dataset.
+  typedef typename TreeType::Mat MatType;
+  //! The type of element held in the dataset.
+  typedef typename TreeType::ElemType ElemType;
+  //! The type of bound of each node.
+  typedef std::decay_t<decltype(std::declval<TreeType&>().Bound())> BoundType;
+
+  static_assert(arma::is_Mat<MatType>::value, "MappedTree can only be used "
+      "with trees built on dense Armadillo matrices!");
+  static_assert(FlatBoundTraits<BoundType>::Id != 0, "MappedTree can only be "
+      "used with trees that have an HRectBound or a BallBound!");
+
+  /**
+   * Save the given tree and its dataset to the given file.  This should be
+   * called on the root of the tree.  If the tree was built with a mapping from
+   * new indices to old indices, it can be stored too.
+   *
+   * @param filename File to write to.
+   * @param tree Tree to save.
+   * @param oldFromNew Mapping from indices in the tree's dataset to the
+   *     original indices (may be empty).
+   */
+  static void Save(const std::string& filename,
+                   const TreeType& tree,
+                   const std::vector<size_t>& oldFromNew =
+                       std::vector<size_t>());
+
+  /**
+   * Build a tree on the dataset stored in the given file and store it in the
+   * format written by Save(), without ever holding the dataset or the tree in
+   * memory.  The dataset file must hold the raw column-major elements of the
+   * matrix, with no header (this is what arma::raw_binary writes), so its
+   * number of points is determined by its size.  The dataset is copied into
+   * the memory-mapped output file and partitioned there, and each node is
+   * written to the file as soon as it is built, so the memory used does not
+   * depend on the number of points; the operating system pages the dataset in
+   * and out as needed.  The tree is the same as the one that TreeType's
+   * constructor builds, and the oldFromNew mapping is always stored.
+   *
+   * This requires mmap(); on other systems, a std::runtime_error is thrown.
+   *
+   * @param datasetFile File holding the raw column-major dataset.
+   * @param dimensionality Number of rows of the dataset.
+   * @param filename File to write the tree to.
+   * @param maxLeafSize Maximum number of points in each leaf.
+   */
+  static void Build(const std::string& datasetFile,
+                    const size_t dimensionality,
+                    const std::string& filename,
+                    const size_t maxLeafSize = 20);
+
+  /**
+   * Map the given file and create the tree stored in it.  A
+   * std::runtime_error is thrown if the file cannot be opened or is not a
+   * valid tree of this type.
+   *
+   * @param filename File saved with Save().
+   */
+  MappedTree(const std::string& filename);
+
+  //! Copying a MappedTree is not allowed.
+  MappedTree(const MappedTree& other) = delete;
+  //! Copying a MappedTree is not allowed.
+  MappedTree& operator=(const MappedTree& other) = delete;
+
+  /**
+   * Delete the tree and unmap the file.
+   */
+  ~MappedTree();
+
+  //! Get the tree.
+  const TreeType& Tree() const { return *tree; }
+  //! Modify the tree.
+  TreeType& Tree() { return *tree; }
+
+  //! Get the mapping from new indices to old indices (empty if none was
+  //! saved).
+  const std::vector<size_t>& OldFromNew() const { return oldFromNew; }
+
+ private:
+  //! Map (or read) the given file into memory.
+  void Map(const std::string& filename);
+
+  //! Unmap (or free) the file.
+  void Unmap();
+
+  /**
+   * Build the node holding the given points of the dataset and all of its
+   * descendants for Build(), and write their records to the given file
+   * descriptor.  The index of the node is the current number of nodes.
+   *
+   * @param data Dataset (in the mapped output file).
+   * @param oldFromNew Mapping of the points (in the mapped output file).
+   * @param begin Index of the first point of the node.
+   * @param count Number of points in the node.
+   * @param parentCenter Center of the parent's bound (empty for the root).
+   * @param maxLeafSize Maximum number of points in each leaf.
+   * @param splitter Splitter used to partition the points.
+   * @param fd File descriptor of the output file.
+   * @param nodesOffset Offset of the first node record in the output file.
+   * @param record Storage for one node record.
+   * @param numNodes Number of nodes written so far; incremented.
+   */
+  static void BuildNode(MatType& data,
+                        uint64_t* oldFromNew,
+                        const size_t begin,
+                        const size_t count,
+                        const arma::Col<ElemType>& parentCenter,
+                        const size_t maxLeafSize,
+                        typename TreeType::Split& splitter,
+                        const int fd,
+                        const uint64_t nodesOffset,
+                        std::vector<char>& record,
+                        uint64_t& numNodes);
+
+  //! The mapped file.
+  char* data;
+  //! The size of the mapped file.
+  size_t size;
+  //! The tree that uses the mapped file.
+  TreeType* tree;
+  //! The mapping from new indices to old indices.
+  std::vector<size_t> oldFromNew;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mapped_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,622 @@
+/**
+ * @file core/tree/binary_space_tree/mapped_tree_impl.hpp
+ *
+ * Implementation of the MappedTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_MAPPED_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_MAPPED_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mapped_tree.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stack>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+
+namespace mapped_tree {
+
+//! The header at the start of every file written by MappedTree.
+struct Header
+{
+  //! Always "MLPKTREE".
+  char magic[8];
+  //! Version of the format.
+  uint32_t version;
+  //! Size of each element of the dataset and the bounds, in bytes.
+  uint32_t elemSize;
+  //! FlatBoundTraits<>::Id of the bound.
+  uint32_t boundId;
+  //! Unused; keeps the following fields aligned.
+  uint32_t padding;
+  //! Dimensionality of the dataset.
+  uint64_t dimensionality;
+  //! Number of points in the dataset.
+  uint64_t numPoints;
+  //! Number of nodes in the tree.
+  uint64_t numNodes;
+  //! Size in bytes of each node record, including the bound.
+  uint64_t nodeSize;
+  //! Number of elements in the stored oldFromNew mapping (zero or numPoints).
+  uint64_t mappingSize;
+  //! Offset of the dataset in the file.
+  uint64_t datasetOffset;
+  //! Offset of the first node record in the file.
+  uint64_t nodesOffset;
+  //! Offset of the oldFromNew mapping in the file.
+  uint64_t mappingOffset;
+};
+
+//! A node of the tree in the file; the bound follows it directly.  The nodes
+//! are stored in depth-first order, so the first node is the root.
+struct Node
+{
+  uint64_t begin;
+  uint64_t count;
+  //! Index of the left child, or NoChild if the node is a leaf.
+  uint64_t left;
+  //! Index of the right child, or NoChild if the node is a leaf.
+  uint64_t right;
+  double parentDistance;
+  double furthestDescendantDistance;
+  double minimumBoundDistance;
+};
+
+static const char Magic[8] = { 'M', 'L', 'P', 'K', 'T', 'R', 'E', 'E' };
+static const uint32_t Version = 1;
+static const uint64_t NoChild = uint64_t(-1);
+
+//! Round the given offset up to a multiple of 64 bytes (a cache line).
+inline uint64_t Align(const uint64_t offset)
+{
+  return (offset + 63) & ~uint64_t(63);
+}
+
+} // namespace mapped_tree
+
+template<typename TreeType>
+void MappedTree<TreeType>::Save(const std::string& filename,
+                                const TreeType& tree,
+                                const std::vector<size_t>& oldFromNew)
+{
+  if (tree.Parent() != NULL)
+  {
+    throw std::invalid_argument("MappedTree::Save(): the given tree must be "
+        "the root of a tree!");
+  }
+
+  const MatType& dataset = tree.Dataset();
+  if (!oldFromNew.empty() && oldFromNew.size() != dataset.n_cols)
+  {
+    throw std::invalid_argument("MappedTree::Save(): size of oldFromNew ("
+        + std::to_string(oldFromNew.size()) + ") does not match number of "
+        "points (" + std::to_string(dataset.n_cols) + ")!");
+  }
+
+  // Collect the nodes in depth-first order.
+  std::vector<const TreeType*> nodes;
+  std::unordered_map<const TreeType*, uint64_t> indices;
+  std::stack<const TreeType*> stack;
+  stack.push(&tree);
+  while (!stack.empty())
+  {
+    const TreeType* node = stack.top();
+    stack.pop();
+
+    indices[node] = nodes.size();
+    nodes.push_back(node);
+    if (!node->IsLeaf())
+    {
+      stack.push(node->Right());
+      stack.push(node->Left());
+    }
+  }
+
+  const size_t boundSize = FlatBoundTraits<BoundType>::Size(dataset.n_rows);
+
+  mapped_tree::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, mapped_tree::Magic, sizeof(header.magic));
+  header.version = mapped_tree::Version;
+  header.elemSize = sizeof(ElemType);
+  header.boundId = FlatBoundTraits<BoundType>::Id;
+  header.dimensionality = dataset.n_rows;
+  header.numPoints = dataset.n_cols;
+  header.numNodes = nodes.size();
+  header.nodeSize = (sizeof(mapped_tree::Node) + boundSize * sizeof(ElemType)
+      + 7) & ~uint64_t(7);
+  header.mappingSize = oldFromNew.size();
+  header.datasetOffset = mapped_tree::Align(sizeof(header));
+  header.nodesOffset = mapped_tree::Align(header.datasetOffset +
+      dataset.n_elem * sizeof(ElemType));
+  header.mappingOffset = mapped_tree::Align(header.nodesOffset +
+      header.numNodes * header.nodeSize);
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out.is_open())
+  {
+    throw std::runtime_error("MappedTree::Save(): cannot open file '" +
+        filename + "' for writing!");
+  }
+
+  // Write padding up to the given offset.
+  const auto pad = [&out](const uint64_t offset)
+  {
+    const uint64_t current = (uint64_t) out.tellp();
+    const std::vector<char> zeros(offset - current, 0);
+    out.write(zeros.data(), zeros.size());
+  };
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  pad(header.datasetOffset);
+  out.write(reinterpret_cast<const char*>(dataset.memptr()),
+      dataset.n_elem * sizeof(ElemType));
+  pad(header.nodesOffset);
+
+  std::vector<char> record(header.nodeSize, 0);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const TreeType* node = nodes[i];
+
+    mapped_tree::Node flatNode;
+    flatNode.begin = node->Begin();
+    flatNode.count = node->Count();
+    flatNode.left = node->IsLeaf() ? mapped_tree::NoChild :
+        indices[node->Left()];
+    flatNode.right = node->IsLeaf() ? mapped_tree::NoChild :
+        indices[node->Right()];
+    flatNode.parentDistance = node->ParentDistance();
+    flatNode.furthestDescendantDistance = node->FurthestDescendantDistance();
+    flatNode.minimumBoundDistance = node->MinimumBoundDistance();
+
+    std::memcpy(record.data(), &flatNode, sizeof(flatNode));
+    FlatBoundTraits<BoundType>::Write(node->Bound(),
+        reinterpret_cast<ElemType*>(record.data() + sizeof(flatNode)));
+    out.write(record.data(), record.size());
+  }
+
+  if (!oldFromNew.empty())
+  {
+    pad(header.mappingOffset);
+    std::vector<uint64_t> mapping(oldFromNew.begin(), oldFromNew.end());
+    out.write(reinterpret_cast<const char*>(mapping.data()),
+        mapping.size() * sizeof(uint64_t));
+  }
+
+  if (!out.good())
+  {
+    throw std::runtime_error("MappedTree::Save(): error while writing to file '"
+        + filename + "'!");
+  }
+}
+
+template<typename TreeType>
+void MappedTree<TreeType>::Build(const std::string& datasetFile,
+                                 const size_t dimensionality,
+                                 const std::string& filename,
+                                 const size_t maxLeafSize)
+{
+#if !defined(_WIN32)
+  if (dimensionality == 0)
+  {
+    throw std::invalid_argument("MappedTree::Build(): dimensionality must be "
+        "greater than 0!");
+  }
+
+  const int inFd = open(datasetFile.c_str(), O_RDONLY);
+  if (inFd < 0)
+  {
+    throw std::runtime_error("MappedTree::Build(): cannot open file '" +
+        datasetFile + "'!");
+  }
+
+  struct stat fileStat;
+  if (fstat(inFd, &fileStat) != 0)
+  {
+    close(inFd);
+    throw std::runtime_error("MappedTree::Build(): cannot read file '" +
+        datasetFile + "'!");
+  }
+
+  const uint64_t inSize = fileStat.st_size;
+  const uint64_t pointSize = dimensionality * sizeof(ElemType);
+  if (inSize == 0 || inSize % pointSize != 0)
+  {
+    close(inFd);
+    throw std::invalid_argument("MappedTree::Build(): size of file '" +
+        datasetFile + "' (" + std::to_string(inSize) + " bytes) is not a "
+        "multiple of the size of a point (" + std::to_string(pointSize) +
+        " bytes)!");
+  }
+
+  void* in = mmap(NULL, inSize, PROT_READ, MAP_PRIVATE, inFd, 0);
+  close(inFd);
+  if (in == MAP_FAILED)
+  {
+    throw std::runtime_error("MappedTree::Build(): cannot map file '" +
+        datasetFile + "'!");
+  }
+
+  const size_t boundSize = FlatBoundTraits<BoundType>::Size(dimensionality);
+
+  // The dataset and the mapping are stored before the nodes, because the
+  // number of nodes is only known once the tree is built.
+  mapped_tree::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, mapped_tree::Magic, sizeof(header.magic));
+  header.version = mapped_tree::Version;
+  header.elemSize = sizeof(ElemType);
+  header.boundId = FlatBoundTraits<BoundType>::Id;
+  header.dimensionality = dimensionality;
+  header.numPoints = inSize / pointSize;
+  header.nodeSize = (sizeof(mapped_tree::Node) + boundSize * sizeof(ElemType)
+      + 7) & ~uint64_t(7);
+  header.mappingSize = header.numPoints;
+  header.datasetOffset = mapped_tree::Align(sizeof(header));
+  header.mappingOffset = mapped_tree::Align(header.datasetOffset + inSize);
+  header.nodesOffset = mapped_tree::Align(header.mappingOffset +
+      header.mappingSize * sizeof(uint64_t));
+
+  const int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    munmap(in, inSize);
+    throw std::runtime_error("MappedTree::Build(): cannot open file '" +
+        filename + "' for writing!");
+  }
+
+  // Only the part of the file before the nodes is mapped; the node records are
+  // written with pwrite().
+  void* out = MAP_FAILED;
+  if (ftruncate(fd, header.nodesOffset) == 0)
+  {
+    out = mmap(NULL, header.nodesOffset, PROT_READ | PROT_WRITE, MAP_SHARED,
+        fd, 0);
+  }
+
+  if (out == MAP_FAILED)
+  {
+    munmap(in, inSize);
+    close(fd);
+    throw std::runtime_error("MappedTree::Build(): cannot map file '" +
+        filename + "' for writing!");
+  }
+
+  char* outData = static_cast<char*>(out);
+  std::memcpy(outData + header.datasetOffset, in, inSize);
+  munmap(in, inSize);
+
+  uint64_t* oldFromNew =
+      reinterpret_cast<uint64_t*>(outData + header.mappingOffset);
+  for (uint64_t i = 0; i < header.numPoints; ++i)
+    oldFromNew[i] = i;
+
+  try
+  {
+    MatType data(reinterpret_cast<ElemType*>(outData + header.datasetOffset),
+        header.dimensionality, header.numPoints, false, true);
+    typename TreeType::Split splitter;
+    std::vector<char> record(header.nodeSize, 0);
+    BuildNode(data, oldFromNew, 0, header.numPoints, arma::Col<ElemType>(),
+        maxLeafSize, splitter, fd, header.nodesOffset, record,
+        header.numNodes);
+  }
+  catch (...)
+  {
+    munmap(out, header.nodesOffset);
+    close(fd);
+    throw;
+  }
+
+  // The header is written last, so that an incomplete file is never valid.
+  std::memcpy(outData, &header, sizeof(header));
+  const bool synced = (msync(out, header.nodesOffset, MS_SYNC) == 0);
+  munmap(out, header.nodesOffset);
+  if (close(fd) != 0 || !synced)
+  {
+    throw std::runtime_error("MappedTree::Build(): error while writing to "
+        "file '" + filename + "'!");
+  }
+#else
+  (void) dimensionality;
+  (void) maxLeafSize;
+  throw std::runtime_error("MappedTree::Build(): cannot build '" + filename +
+      "' from '" + datasetFile + "': memory mapping is not available on this "
+      "system!");
+#endif
+}
+
+template<typename TreeType>
+void MappedTree<TreeType>::BuildNode(MatType& data,
+                                     uint64_t* oldFromNew,
+                                     const size_t begin,
+                                     const size_t count,
+                                     const arma::Col<ElemType>& parentCenter,
+                                     const size_t maxLeafSize,
+                                     typename TreeType::Split& splitter,
+                                     const int fd,
+                                     const uint64_t nodesOffset,
+                                     std::vector<char>& record,
+                                     uint64_t& numNodes)
+{
+  const uint64_t index = numNodes++;
+
+  // This is the same as what BinarySpaceTree::SplitNode() does, except that
+  // the nodes are not kept.  The subview is not copied, so only the pages of
+  // this node's points are touched.
+  BoundType bound(data.n_rows);
+  bound |= data.cols(begin, begin + count - 1);
+
+  arma::Col<ElemType> center;
+  bound.Center(center);
+
+  mapped_tree::Node flatNode;
+  flatNode.begin = begin;
+  flatNode.count = count;
+  flatNode.left = mapped_tree::NoChild;
+  flatNode.right = mapped_tree::NoChild;
+  // The distances are rounded to ElemType, like they are in the tree.
+  flatNode.parentDistance = (parentCenter.n_elem == 0) ? 0.0 :
+      (ElemType) bound.Distance().Evaluate(parentCenter, center);
+  flatNode.furthestDescendantDistance = (ElemType) (0.5 * bound.Diameter());
+  flatNode.minimumBoundDistance = (ElemType) (bound.MinWidth() / 2.0);
+
+  typename TreeType::Split::SplitInfo splitInfo;
+  if (count > maxLeafSize &&
+      splitter.SplitNode(bound, data, begin, count, splitInfo))
+  {
+    // Partition the points exactly like PerformSplit() does, but update the
+    // mapped oldFromNew array.
+    typedef typename TreeType::Split Split;
+    size_t left = begin;
+    size_t right = begin + count - 1;
+    while ((left <= right) &&
+           (Split::AssignToLeftNode(data.col(left), splitInfo)))
+      left++;
+    while ((!Split::AssignToLeftNode(data.col(right), splitInfo)) &&
+           (left <= right) && (right > 0))
+      right--;
+
+    if (!(left == right && right == 0))
+    {
+      while (left <= right)
+      {
+        data.swap_cols(left, right);
+        std::swap(oldFromNew[left], oldFromNew[right]);
+
+        while (Split::AssignToLeftNode(data.col(left), splitInfo) &&
+            (left <= right))
+          left++;
+        while ((!Split::AssignToLeftNode(data.col(right), splitInfo)) &&
+            (left <= right))
+          right--;
+      }
+    }
+    const size_t splitCol = left;
+
+    flatNode.left = numNodes;
+    BuildNode(data, oldFromNew, begin, splitCol - begin, center, maxLeafSize,
+        splitter, fd, nodesOffset, record, numNodes);
+    flatNode.right = numNodes;
+    BuildNode(data, oldFromNew, splitCol, begin + count - splitCol, center,
+        maxLeafSize, splitter, fd, nodesOffset, record, numNodes);
+  }
+
+  // The record of this node is written after its descendants, because the
+  // index of the right child is only known now.
+  std::memset(record.data(), 0, record.size());
+  std::memcpy(record.data(), &flatNode, sizeof(flatNode));
+  FlatBoundTraits<BoundType>::Write(bound,
+      reinterpret_cast<ElemType*>(record.data() + sizeof(flatNode)));
+
+#if !defined(_WIN32)
+  const off_t offset = nodesOffset + index * record.size();
+  if (pwrite(fd, record.data(), record.size(), offset) !=
+      (ssize_t) record.size())
+  {
+    throw std::runtime_error("MappedTree::Build(): error while writing node "
+        + std::to_string(index) + "!");
+  }
+#else
+  (void) fd;
+  (void) nodesOffset;
+  (void) index;
+#endif
+}
+
+template<typename TreeType>
+MappedTree<TreeType>::MappedTree(const std::string& filename) :
+    data(NULL),
+    size(0),
+    tree(NULL)
+{
+  Map(filename);
+
+  // Check that the file is valid before touching anything else.
+  mapped_tree::Header header;
+  bool valid = (size >= sizeof(header));
+  if (valid)
+  {
+    std::memcpy(&header, data, sizeof(header));
+    const size_t boundSize =
+        FlatBoundTraits<BoundType>::Size(header.dimensionality);
+    valid =
+        (std::memcmp(header.magic, mapped_tree::Magic, sizeof(header.magic))
+            == 0) &&
+        (header.version == mapped_tree::Version) &&
+        (header.elemSize == sizeof(ElemType)) &&
+        (header.boundId == FlatBoundTraits<BoundType>::Id) &&
+        (header.numNodes > 0) &&
+        (header.nodeSize >= sizeof(mapped_tree::Node) +
+            boundSize * sizeof(ElemType)) &&
+        (header.datasetOffset % 64 == 0) &&
+        (header.datasetOffset + header.dimensionality * header.numPoints *
+            sizeof(ElemType) <= size) &&
+        (header.nodesOffset + header.numNodes * header.nodeSize <= size) &&
+        (header.mappingSize == 0 || header.mappingSize == header.numPoints) &&
+        (header.mappingSize == 0 || header.mappingOffset +
+            header.mappingSize * sizeof(uint64_t) <= size);
+  }
+
+  if (!valid)
+  {
+    Unmap();
+    throw std::runtime_error("MappedTree::MappedTree(): file '" + filename +
+        "' is not a valid tree of the given type!");
+  }
+
+  // The root owns the dataset object, but the dataset object just uses the
+  // mapped memory.
+  tree = new TreeType();
+  tree->dataset = new MatType(
+      reinterpret_cast<ElemType*>(data + header.datasetOffset),
+      header.dimensionality, header.numPoints, false, true);
+
+  // All other nodes go into a node arena held by the root, just like after
+  // TreeType::PackNodes().
+  std::vector<TreeType*> nodes(header.numNodes);
+  nodes[0] = tree;
+  if (header.numNodes > 1)
+  {
+    tree->nodeArena = new NodePool<TreeType>();
+    TreeType* arena = tree->nodeArena->AllocateBlock(header.numNodes - 1);
+    for (size_t i = 1; i < header.numNodes; ++i)
+    {
+      nodes[i] = arena + (i - 1);
+      new (nodes[i]) TreeType();
+      nodes[i]->dataset = tree->dataset;
+    }
+    tree->packed = true;
+  }
+
+  for (size_t i = 0; i < header.numNodes; ++i)
+  {
+    const char* record = data + header.nodesOffset + i * header.nodeSize;
+    mapped_tree::Node flatNode;
+    std::memcpy(&flatNode, record, sizeof(flatNode));
+
+    TreeType* node = nodes[i];
+    node->begin = flatNode.begin;
+    node->count = flatNode.count;
+    node->parentDistance = flatNode.parentDistance;
+    node->furthestDescendantDistance = flatNode.furthestDescendantDistance;
+    node->minimumBoundDistance = flatNode.minimumBoundDistance;
+    FlatBoundTraits<BoundType>::Read(node->bound, header.dimensionality,
+        reinterpret_cast<const ElemType*>(record + sizeof(flatNode)));
+
+    if (flatNode.left != mapped_tree::NoChild)
+    {
+      node->left = nodes[flatNode.left];
+      node->right = nodes[flatNode.right];
+      node->left->parent = node;
+      node->right->parent = node;
+    }
+  }
+
+  // Statistics are built bottom-up, just like during tree construction.  In
+  // depth-first order every child comes after its parent.
+  typedef std::decay_t<decltype(tree->Stat())> StatisticType;
+  for (size_t i = header.numNodes; i > 0; --i)
+    nodes[i - 1]->stat = StatisticType(*nodes[i - 1]);
+
+  if (header.mappingSize > 0)
+  {
+    const uint64_t* mapping =
+        reinterpret_cast<const uint64_t*>(data + header.mappingOffset);
+    oldFromNew.assign(mapping, mapping + header.mappingSize);
+  }
+}
+
+template<typename TreeType>
+MappedTree<TreeType>::~MappedTree()
+{
+  delete tree;
+  Unmap();
+}
+
+template<typename TreeType>
+void MappedTree<TreeType>::Map(const std::string& filename)
+{
+#if !defined(_WIN32)
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("MappedTree::MappedTree(): cannot open file '" +
+        filename + "'!");
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+  {
+    close(fd);
+    throw std::runtime_error("MappedTree::MappedTree(): cannot read file '" +
+        filename + "'!");
+  }
+
+  size = fileStat.st_size;
+  // The mapping is private, so that writes to the dataset never reach the
+  // file, but the pages are shared until they are written to.
+  void* mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    size = 0;
+    throw std::runtime_error("MappedTree::MappedTree(): cannot map file '" +
+        filename + "'!");
+  }
+
+  data = static_cast<char*>(mapped);
+#else
+  std::ifstream in(filename, std::ios::binary | std::ios::ate);
+  if (!in.is_open())
+  {
+    throw std::runtime_error("MappedTree::MappedTree(): cannot open file '" +
+        filename + "'!");
+  }
+
+  size = (size_t) in.tellg();
+  in.seekg(0);
+  data = static_cast<char*>(::operator new(size, std::align_val_t(64)));
+  in.read(data, size);
+  if (!in.good())
+  {
+    Unmap();
+    throw std::runtime_error("MappedTree::MappedTree(): cannot read file '" +
+        filename + "'!");
+  }
+#endif
+}
+
+template<typename TreeType>
+void MappedTree<TreeType>::Unmap()
+{
+  if (data == NULL)
+    return;
+
+#if !defined(_WIN32)
+  munmap(data, size);
+#else
+  ::operator delete(data, std::align_val_t(64));
+#endif
+
+  data = NULL;
+  size = 0;
+}
+
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include <mlpack/core/tree/split_traits.hpp>
 
 namespace mlpack {
 
@@ -116,6 +117,13 @@ class MeanSplit
   }
 };
 
+//! The MeanSplit only depends on the points in the node it splits.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MeanSplit<BoundType, MatType>>
+{
+  static const bool IsParallelSafe = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
@@ -17,6 +17,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include <mlpack/core/tree/split_traits.hpp>
 
 namespace mlpack {
 
@@ -116,6 +117,13 @@ class MidpointSplit
   }
 };
 
+//! The MidpointSplit only depends on the points in the node it splits.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MidpointSplit<BoundType, MatType>>
+{
+  static const bool IsParallelSafe = true;
+};
+
 } // namespace mlpack
 
 // Include implementation.
@@ -0,0 +1,176 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser.hpp
+ *
+ * Defines the ParallelDualTreeTraverser for the BinarySpaceTree tree type.
+ * This is a nested class of BinarySpaceTree which traverses two trees in a
+ * depth-first manner, like the DualTreeTraverser, but which hands the
+ * recursions into the two children of large query nodes to OpenMP tasks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "binary_space_tree.hpp"
+#include "leaf_base_cases.hpp"
+#include <mlpack/core/tree/traversal_counters.hpp>
+
+namespace mlpack {
+
+/**
+ * A task-parallel dual-tree traverser for binary space trees.  The traversal
+ * order for a single (query, reference) combination is the same as for the
+ * DualTreeTraverser; but, whenever the traversal must recurse into both
+ * children of a query node holding at least MinTaskSize() descendant points,
+ * the recursion into the left query child is performed in a separate OpenMP
+ * task.
+ *
+ * Because the points held by two sibling query nodes are disjoint, tasks never
+ * touch the same query points.  However, the RuleType object itself also holds
+ * per-traversal scratch state (traversal info, cached base cases, counters), so
+ * each task receives its own copy of the rules.  This places the following
+ * requirements on RuleType:
+ *
+ *  - Copies of a RuleType object must share the storage for per-query-point
+ *    results (e.g. candidate neighbor lists), but each copy must have its own
+ *    traversal state.  NeighborSearchRules satisfies this.
+ *  - Score(), Rescore() and BaseCase() must only modify the statistics of
+ *    query nodes and the results of query points.  The reference tree is only
+ *    read.
+ *  - RuleType must provide BaseCases() and Scores() accessors that return
+ *    modifiable references, so that the counts from each task can be summed
+ *    into the original rules object when the traversal finishes.
+ *
+ * If mlpack is compiled without OpenMP, this traverser behaves exactly like the
+ * DualTreeTraverser.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+class BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType,
+                      SplitType>::ParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Minimum number of descendant points a query node must
+   *     have for its children to be traversed in separate tasks.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t minTaskSize = 1000);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.  If
+   * this is called outside of a parallel region, a parallel region is opened
+   * with the default number of OpenMP threads.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(BinarySpaceTree& queryNode,
+                BinarySpaceTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum query node size for which tasks are created.
+  size_t MinTaskSize() const { return minTaskSize; }
+  //! Modify the minimum query node size for which tasks are created.
+  size_t& MinTaskSize() { return minTaskSize; }
+
+ private:
+  //! Recursive traversal routine; this is called from inside a parallel
+  //! region.
+  void TraverseNodes(BinarySpaceTree& queryNode,
+                     BinarySpaceTree& referenceNode);
+
+  /**
+   * Score the given query child against the two children of the reference
+   * node, and recurse in the best order.  The given traversal info is restored
+   * before each call to Score().
+   */
+  void TraverseReferenceChildren(
+      BinarySpaceTree& queryChild,
+      BinarySpaceTree& referenceNode,
+      const typename RuleType::TraversalInfoType& traversalInfo);
+
+  /**
+   * Score the given query child against the reference node, and recurse if it
+   * cannot be pruned.  The given traversal info is restored before calling
+   * Score().
+   */
+  void TraverseReference(
+      BinarySpaceTree& queryChild,
+      BinarySpaceTree& referenceNode,
+      const typename RuleType::TraversalInfoType& traversalInfo);
+
+  /**
+   * Traverse the left query child in a new task and the right query child in
+   * the current task, then wait for both and merge the counters of the task.
+   * If bothReferenceChildren is true, TraverseReferenceChildren() is used for
+   * each query child; otherwise, TraverseReference() is used.
+   */
+  void ForkQueryChildren(
+      BinarySpaceTree& queryNode,
+      BinarySpaceTree& referenceNode,
+      const typename RuleType::TraversalInfoType& traversalInfo,
+      const bool bothReferenceChildren);
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum number of descendants of a query node to fork tasks.
+  size_t minTaskSize;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  //! Storage for the query points of a leaf that are not pruned; held in the
+  //! class so that it isn't continually being reallocated.
+  std::vector<size_t> leafQueries;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_HPP
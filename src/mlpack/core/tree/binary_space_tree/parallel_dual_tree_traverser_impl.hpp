@@ -0,0 +1,307 @@
+/**
+ * @file core/tree/binary_space_tree/parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the ParallelDualTreeTraverser for BinarySpaceTree.  This is
+ * a way to perform a dual-tree traversal of two trees with OpenMP tasks.  The
+ * trees must be the same type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ParallelDualTreeTraverser(
+    RuleType& rule,
+    const size_t minTaskSize) :
+    rule(rule),
+    minTaskSize(minTaskSize),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::Traverse(
+    BinarySpaceTree& queryNode,
+    BinarySpaceTree& referenceNode)
+{
+  // Only one thread starts the traversal; the others pick up the tasks that
+  // are created.
+  #pragma omp parallel
+  {
+    #pragma omp single
+    {
+      TraverseNodes(queryNode, referenceNode);
+    }
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::TraverseNodes(
+    BinarySpaceTree& queryNode,
+    BinarySpaceTree& referenceNode)
+{
+  // Increment the visit counter.
+  ++numVisited;
+
+  // Store the current traversal info.  This is a local (and not a member like
+  // in the DualTreeTraverser) because the traverser may be used by a task
+  // while another task's recursion is in progress.
+  const typename RuleType::TraversalInfoType traversalInfo =
+      rule.TraversalInfo();
+
+  // If both nodes are root nodes, just score them.
+  if (queryNode.Parent() == NULL && referenceNode.Parent() == NULL)
+  {
+    const double rootScore = rule.Score(queryNode, referenceNode);
+    // If root score is DBL_MAX, don't recurse.
+    if (rootScore == DBL_MAX)
+    {
+      ++numPrunes;
+      return;
+    }
+  }
+
+  // If both are leaves, we must evaluate the base case.
+  if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+  {
+    numBaseCases += LeafBaseCases(rule, queryNode, referenceNode,
+        traversalInfo, leafQueries);
+  }
+  else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
+           (queryNode.NumDescendants() > 3 * referenceNode.NumDescendants() &&
+            !queryNode.IsLeaf() && !referenceNode.IsLeaf()))
+  {
+    // We have to recurse down the query node.  In this case the recursion order
+    // does not matter, and the two recursions are independent.
+    if (queryNode.NumDescendants() >= minTaskSize)
+    {
+      ForkQueryChildren(queryNode, referenceNode, traversalInfo, false);
+    }
+    else
+    {
+      TraverseReference(*queryNode.Left(), referenceNode, traversalInfo);
+      TraverseReference(*queryNode.Right(), referenceNode, traversalInfo);
+    }
+  }
+  else if (queryNode.IsLeaf() && (!referenceNode.IsLeaf()))
+  {
+    // We have to recurse down the reference node.  In this case the recursion
+    // order does matter, so this is never done in parallel.
+    TraverseReferenceChildren(queryNode, referenceNode, traversalInfo);
+  }
+  else
+  {
+    // We have to recurse down both query and reference nodes.  The recursions
+    // for each query child are independent.
+    if (queryNode.NumDescendants() >= minTaskSize)
+    {
+      ForkQueryChildren(queryNode, referenceNode, traversalInfo, true);
+    }
+    else
+    {
+      TraverseReferenceChildren(*queryNode.Left(), referenceNode,
+          traversalInfo);
+      TraverseReferenceChildren(*queryNode.Right(), referenceNode,
+          traversalInfo);
+    }
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::TraverseReference(
+    BinarySpaceTree& queryChild,
+    BinarySpaceTree& referenceNode,
+    const typename RuleType::TraversalInfoType& traversalInfo)
+{
+  rule.TraversalInfo() = traversalInfo;
+  const double score = rule.Score(queryChild, referenceNode);
+  ++numScores;
+
+  if (score != DBL_MAX)
+    TraverseNodes(queryChild, referenceNode);
+  else
+    ++numPrunes;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::TraverseReferenceChildren(
+    BinarySpaceTree& queryChild,
+    BinarySpaceTree& referenceNode,
+    const typename RuleType::TraversalInfoType& traversalInfo)
+{
+  // Score both reference children, saving the traversal info that each score
+  // produces.
+  rule.TraversalInfo() = traversalInfo;
+  double leftScore = rule.Score(queryChild, *referenceNode.Left());
+  const typename RuleType::TraversalInfoType leftInfo = rule.TraversalInfo();
+  rule.TraversalInfo() = traversalInfo;
+  double rightScore = rule.Score(queryChild, *referenceNode.Right());
+  const typename RuleType::TraversalInfoType rightInfo = rule.TraversalInfo();
+  numScores += 2;
+
+  if (leftScore == DBL_MAX && rightScore == DBL_MAX)
+  {
+    numPrunes += 2;
+  }
+  else if (rightScore < leftScore)
+  {
+    // Recurse to the right first.
+    rule.TraversalInfo() = rightInfo;
+    TraverseNodes(queryChild, *referenceNode.Right());
+
+    // Is it still valid to recurse to the left?
+    leftScore = rule.Rescore(queryChild, *referenceNode.Left(), leftScore);
+
+    if (leftScore != DBL_MAX)
+    {
+      rule.TraversalInfo() = leftInfo;
+      TraverseNodes(queryChild, *referenceNode.Left());
+    }
+    else
+      ++numPrunes;
+  }
+  else
+  {
+    // Recurse to the left first (this is also the choice when the scores are
+    // equal).
+    rule.TraversalInfo() = leftInfo;
+    TraverseNodes(queryChild, *referenceNode.Left());
+
+    // Is it still valid to recurse to the right?
+    rightScore = rule.Rescore(queryChild, *referenceNode.Right(), rightScore);
+
+    if (rightScore != DBL_MAX)
+    {
+      rule.TraversalInfo() = rightInfo;
+      TraverseNodes(queryChild, *referenceNode.Right());
+    }
+    else
+      ++numPrunes;
+  }
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundDistanceType,
+                  typename BoundElemType,
+                  typename...> class BoundType,
+         template<typename SplitBoundType,
+                  typename SplitMatType> class SplitType>
+template<typename RuleType>
+void
+BinarySpaceTree<DistanceType, StatisticType, MatType, BoundType, SplitType>::
+ParallelDualTreeTraverser<RuleType>::ForkQueryChildren(
+    BinarySpaceTree& queryNode,
+    BinarySpaceTree& referenceNode,
+    const typename RuleType::TraversalInfoType& traversalInfo,
+    const bool bothReferenceChildren)
+{
+  // The copy of the rules must be made here, by the thread that owns the
+  // current rules, and not inside of the task.  The copy shares the results
+  // with the original rules, but its counters start from zero so that they can
+  // be summed afterwards.
+  RuleType leftRule(rule);
+  leftRule.BaseCases() = 0;
+  leftRule.Scores() = 0;
+  ResetTraversalCounters(leftRule);
+  ParallelDualTreeTraverser leftTraverser(leftRule, minTaskSize);
+
+  BinarySpaceTree* leftChild = queryNode.Left();
+  BinarySpaceTree* referencePtr = &referenceNode;
+  const typename RuleType::TraversalInfoType leftTaskInfo = traversalInfo;
+
+  #pragma omp task shared(leftTraverser, leftTaskInfo)
+  {
+    if (bothReferenceChildren)
+    {
+      leftTraverser.TraverseReferenceChildren(*leftChild, *referencePtr,
+          leftTaskInfo);
+    }
+    else
+    {
+      leftTraverser.TraverseReference(*leftChild, *referencePtr,
+          leftTaskInfo);
+    }
+  }
+
+  if (bothReferenceChildren)
+    TraverseReferenceChildren(*queryNode.Right(), referenceNode, traversalInfo);
+  else
+    TraverseReference(*queryNode.Right(), referenceNode, traversalInfo);
+
+  #pragma omp taskwait
+
+  // Now collect the counts from the task.
+  rule.BaseCases() += leftRule.BaseCases();
+  rule.Scores() += leftRule.Scores();
+  MergeTraversalCounters(rule, leftRule);
+  numPrunes += leftTraverser.numPrunes;
+  numVisited += leftTraverser.numVisited;
+  numScores += leftTraverser.numScores;
+  numBaseCases += leftTraverser.numBaseCases;
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_BINARY_SPACE_TREE_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
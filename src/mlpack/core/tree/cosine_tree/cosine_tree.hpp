@@ -17,6 +17,13 @@
 #include <mlpack/core/math/quantile.hpp>
 
 namespace mlpack {
+namespace details {
+
+//! Loops whose total work (in multiply-adds) is below this are never run in
+//! parallel.
+constexpr size_t cosineTreeParallelMinWork = 100000;
+
+} // namespace details
 
 // Predeclare classes for CosineNodeQueue typedef.
 class CompareCosineNode;
@@ -65,6 +72,10 @@ class CosineTree
    * input matrix's projection on the obtained subspace is less than a fraction
    * of the norm of the input matrix.
    *
+   * The tree and the order in which its nodes were split are kept, so Refine()
+   * can later compute the basis for another value of epsilon without starting
+   * over.  The dataset must stay valid as long as Refine() may be called.
+   *
    * @param dataset Matrix for which the CosineTree is constructed.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
@@ -145,6 +156,20 @@ class CosineTree
    */
   void ConstructBasis(CosineNodeQueue<MatType>& treeQueue);
 
+  /**
+   * Compute the basis for the given error tolerance fraction, reusing the tree
+   * built by the constructor that takes 'epsilon' and 'delta'.  If an earlier
+   * refinement already reached the given tolerance, the basis is that of the
+   * first refinement step that did, so a larger epsilon costs no new
+   * splits; otherwise the tree is split further, starting from the last step.
+   * Since the same refinement steps are used, the basis for each epsilon is the
+   * same as if the tree had been built for it from scratch with the same random
+   * samples.
+   *
+   * @param epsilon Error tolerance fraction for calculated subspace.
+   */
+  void Refine(const double epsilon);
+
   /**
    * This function splits the cosine node into two children based on the cosines
    * of the columns contained in the node, with respect to the sampled splitting
@@ -249,7 +274,27 @@ class CosineTree
   //! Get the column index of split point of the node.
   size_t SplitPointIndex() const { return indices[splitPointIndex]; }
 
+  //! Get the number of nodes split so far by Refine() (or by the constructor
+  //! that takes 'epsilon' and 'delta').
+  size_t NumSplits() const { return splits.size(); }
+
  private:
+  /**
+   * Construct the basis from the nodes that were leaves after the given number
+   * of refinement steps.
+   *
+   * @param numSplits Number of refinement steps to take into account.
+   */
+  void ReplayBasis(const size_t numSplits);
+
+  /**
+   * Point the refinement state of this object at the nodes of its own copy of
+   * the tree of the given object.  The tree must have been copied already.
+   *
+   * @param other Object whose refinement state is copied.
+   */
+  void CopyRefinement(const CosineTree& other);
+
   //! Matrix for which cosine tree is constructed.
   const MatType* dataset;
   //! Cumulative probability for Monte Carlo error lower bound.
@@ -280,6 +325,18 @@ class CosineTree
   double frobNormSquared;
   //! If true, we own the dataset and need to destroy it in the destructor.
   bool localDataset;
+  //! Root of the tree that is refined, if this object was built with 'epsilon'
+  //! and 'delta'.
+  CosineTree* treeRoot;
+  //! Leaves of the refined tree after the last refinement step.
+  CosineNodeQueue<MatType> frontier;
+  //! Nodes split by each refinement step, in order.
+  std::vector<CosineTree*> splits;
+  //! Monte Carlo error estimate of the root after each number of refinement
+  //! steps (starting with zero steps).
+  std::vector<double> errors;
+  //! Whether the tree cannot be refined any further.
+  bool exhausted;
 };
 
 class CompareCosineNode
@@ -23,13 +23,17 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset) :
     left(NULL),
     right(NULL),
     numColumns(dataset.n_cols),
-    localDataset(false)
+    localDataset(false),
+    treeRoot(NULL),
+    exhausted(false)
 {
   // Initialize sizes of column indices and l2 norms.
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (numColumns * dataset.n_rows >= details::cosineTreeParallelMinWork)
   for (size_t i = 0; i < numColumns; ++i)
   {
     indices[i] = i;
@@ -54,7 +58,9 @@ inline CosineTree<MatType>::CosineTree(CosineTree& parentNode,
     left(NULL),
     right(NULL),
     numColumns(subIndices.size()),
-    localDataset(false)
+    localDataset(false),
+    treeRoot(NULL),
+    exhausted(false)
 {
   // Initialize sizes of column indices and l2 norms.
   indices.resize(numColumns);
@@ -82,90 +88,39 @@ inline CosineTree<MatType>::CosineTree(const MatType& dataset,
                                        const double delta) :
     dataset(&dataset),
     delta(delta),
+    parent(NULL),
     left(NULL),
     right(NULL),
-    localDataset(false)
+    splitPointIndex(0),
+    numColumns(0),
+    l2Error(-1.0),
+    frobNormSquared(0.0),
+    localDataset(false),
+    treeRoot(new CosineTree(dataset)),
+    exhausted(false)
 {
-  // Declare the cosine tree priority queue.
-  CosineNodeQueue<MatType> treeQueue;
-  CompareCosineNode comp;
-
-  // Define root node of the tree and add it to the queue.
-  CosineTree root(dataset);
+  // The root node is the only leaf of the tree before it is refined.
   VecType tempVector = arma::zeros<VecType>(dataset.n_rows);
-  root.L2Error(-1.0); // We don't know what the error is.
-  root.BasisVector(tempVector);
-  treeQueue.push_back(&root);
-  // treeQueue is empty now, so we don't need to call std::push_heap here.
+  treeRoot->L2Error(-1.0); // We don't know what the error is.
+  treeRoot->BasisVector(tempVector);
+  frontier.push_back(treeRoot);
+  // frontier was empty, so we don't need to call std::push_heap here.
 
   // Initialize Monte Carlo error estimate for comparison.
-  double monteCarloError = root.FrobNormSquared();
-
-  while (treeQueue.size() > 0 &&
-         (monteCarloError > epsilon * root.FrobNormSquared()))
-  {
-    // Pop node from queue with highest projection error.
-    CosineTree* currentNode;
-    currentNode = treeQueue.front();
-    std::pop_heap(treeQueue.begin(), treeQueue.end(), comp);
-    treeQueue.pop_back();
-
-    // If the priority is 0, we can't improve anything, and we can assume that
-    // we've done the best we can.
-    if (currentNode->L2Error() == 0.0)
-    {
-      Log::Warn << "CosineTree::CosineTree(): could not build tree to "
-          << "desired relative error " << epsilon << "; failing with estimated "
-          << "relative error " << (monteCarloError / root.FrobNormSquared())
-          << "." << std::endl;
-      break;
-    }
-
-    // Split the node into left and right children.  We assume that this cannot
-    // fail; it might fail if L2Error() is 0, but we have already avoided that
-    // case.
-    currentNode->CosineNodeSplit();
+  errors.push_back(treeRoot->FrobNormSquared());
 
-    // Obtain pointers to the left and right children of the current node.
-    CosineTree *currentLeft, *currentRight;
-    currentLeft = currentNode->Left();
-    currentRight = currentNode->Right();
-
-    // Calculate basis vectors of left and right children.
-    VecType lBasisVector, rBasisVector;
-
-    ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
-    ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector,
-                        &lBasisVector);
-
-    // Add basis vectors to their respective nodes.
-    currentLeft->BasisVector(lBasisVector);
-    currentRight->BasisVector(rBasisVector);
-
-    // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
-
-    // Push child nodes into the priority queue.
-    treeQueue.push_back(currentLeft);
-    std::push_heap(treeQueue.begin(), treeQueue.end(), comp);
-    treeQueue.push_back(currentRight);
-    std::push_heap(treeQueue.begin(), treeQueue.end(), comp);
-
-    // Calculate Monte Carlo error estimate for the root node.
-    monteCarloError = MonteCarloError(&root, treeQueue);
-  }
-
-  // Construct the subspace basis from the current priority queue.
-  ConstructBasis(treeQueue);
+  Refine(epsilon);
 }
 
 //! Copy the given tree.
 template<typename MatType>
 inline CosineTree<MatType>::CosineTree(const CosineTree& other) :
-    // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    // Copy matrix, but only if we are the root.  If there is a refined tree,
+    // its copy holds the copy of the matrix.
+    dataset((other.parent == NULL && other.treeRoot == NULL) ?
+        new MatType(*other.dataset) : NULL),
     delta(other.delta),
+    basis(other.basis),
     parent(NULL),
     left(NULL),
     right(NULL),
@@ -173,12 +128,22 @@ inline CosineTree<MatType>::CosineTree(const CosineTree& other) :
     l2NormsSquared(other.l2NormsSquared),
     centroid(other.centroid),
     basisVector(other.basisVector),
-    splitPointIndex(other.SplitPointIndex()),
+    splitPointIndex(other.splitPointIndex),
     numColumns(other.NumColumns()),
     l2Error(other.L2Error()),
     frobNormSquared(other.FrobNormSquared()),
-    localDataset(other.parent == NULL)
+    localDataset(other.parent == NULL && other.treeRoot == NULL),
+    treeRoot(NULL),
+    exhausted(other.exhausted)
 {
+  // Copy the refined tree (if any).
+  if (other.treeRoot)
+  {
+    treeRoot = new CosineTree(*other.treeRoot);
+    dataset = &treeRoot->GetDataset();
+    CopyRefinement(other);
+  }
+
   // Create left and right children (if any).
   if (other.Left())
   {
@@ -229,11 +194,15 @@ inline CosineTree<MatType>& CosineTree<MatType>::operator=(
 
   delete left;
   delete right;
+  delete treeRoot;
 
-  // Performing a deep copy of the dataset.
-  dataset = (other.parent == NULL) ? new MatType(*other.dataset) : NULL;
+  // Performing a deep copy of the dataset.  If there is a refined tree, its
+  // copy holds the copy of the matrix.
+  dataset = (other.parent == NULL && other.treeRoot == NULL) ?
+      new MatType(*other.dataset) : NULL;
 
   delta = other.delta;
+  basis = other.basis;
   parent = other.Parent();
   left = other.Left();
   right = other.Right();
@@ -241,11 +210,24 @@ inline CosineTree<MatType>& CosineTree<MatType>::operator=(
   l2NormsSquared = other.l2NormsSquared;
   centroid = other.centroid;
   basisVector = other.basisVector;
-  splitPointIndex = other.SplitPointIndex();
+  splitPointIndex = other.splitPointIndex;
   numColumns = other.NumColumns();
   l2Error = other.L2Error();
-  localDataset = (other.parent == NULL) ? true : false;
+  localDataset = (other.parent == NULL && other.treeRoot == NULL);
   frobNormSquared = other.FrobNormSquared();
+  treeRoot = NULL;
+  frontier.clear();
+  splits.clear();
+  errors.clear();
+  exhausted = other.exhausted;
+
+  // Copy the refined tree (if any).
+  if (other.treeRoot)
+  {
+    treeRoot = new CosineTree(*other.treeRoot);
+    dataset = &treeRoot->GetDataset();
+    CopyRefinement(other);
+  }
 
   // Create left and right children (if any).
   if (other.Left())
@@ -289,6 +271,7 @@ template<typename MatType>
 inline CosineTree<MatType>::CosineTree(CosineTree&& other) :
     dataset(other.dataset),
     delta(std::move(other.delta)),
+    basis(std::move(other.basis)),
     parent(other.parent),
     left(other.left),
     right(other.right),
@@ -300,7 +283,12 @@ inline CosineTree<MatType>::CosineTree(CosineTree&& other) :
     numColumns(other.numColumns),
     l2Error(other.l2Error),
     frobNormSquared(other.frobNormSquared),
-    localDataset(other.localDataset)
+    localDataset(other.localDataset),
+    treeRoot(other.treeRoot),
+    frontier(std::move(other.frontier)),
+    splits(std::move(other.splits)),
+    errors(std::move(other.errors)),
+    exhausted(other.exhausted)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -313,6 +301,8 @@ inline CosineTree<MatType>::CosineTree(CosineTree&& other) :
   other.l2Error = -1;
   other.localDataset = false;
   other.frobNormSquared = 0;
+  other.treeRoot = NULL;
+  other.exhausted = false;
   // Set new parent.
   if (left)
     left->parent = this;
@@ -333,9 +323,11 @@ inline CosineTree<MatType>& CosineTree<MatType>::operator=(CosineTree&& other)
     delete dataset;
   delete left;
   delete right;
+  delete treeRoot;
 
   dataset = other.dataset;
   delta = std::move(other.delta);
+  basis = std::move(other.basis);
   parent = other.Parent();
   left = other.Left();
   right = other.Right();
@@ -343,11 +335,16 @@ inline CosineTree<MatType>& CosineTree<MatType>::operator=(CosineTree&& other)
   l2NormsSquared = std::move(other.l2NormsSquared);
   centroid = std::move(other.centroid);
   basisVector = std::move(other.basisVector);
-  splitPointIndex = other.SplitPointIndex();
+  splitPointIndex = other.splitPointIndex;
   numColumns = other.NumColumns();
   l2Error = other.L2Error();
   localDataset = other.localDataset;
   frobNormSquared = other.FrobNormSquared();
+  treeRoot = other.treeRoot;
+  frontier = std::move(other.frontier);
+  splits = std::move(other.splits);
+  errors = std::move(other.errors);
+  exhausted = other.exhausted;
 
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -360,6 +357,8 @@ inline CosineTree<MatType>& CosineTree<MatType>::operator=(CosineTree&& other)
   other.l2Error = -1;
   other.localDataset = false;
   other.frobNormSquared = 0;
+  other.treeRoot = NULL;
+  other.exhausted = false;
   // Set new parent.
   if (left)
     left->parent = this;
@@ -378,6 +377,7 @@ inline CosineTree<MatType>::~CosineTree()
     delete left;
   if (right)
     delete right;
+  delete treeRoot;
 }
 
 template<typename MatType>
@@ -390,18 +390,32 @@ inline void CosineTree<MatType>::ModifiedGramSchmidt(
   // Set new basis vector to centroid.
   newBasisVector = centroid;
 
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  typename CosineNodeQueue<MatType>::const_iterator i = treeQueue.cbegin();
-
-  // For every vector in the current basis, remove its projection from the
-  // centroid.
-  for ( ; i != treeQueue.cend(); ++i)
+  // Compute the projection of the centroid on every vector in the current
+  // basis.
+  const size_t basisSize = treeQueue.size();
+  const bool useThreads = (basisSize * centroid.n_elem >=
+      details::cosineTreeParallelMinWork);
+  arma::vec projections(basisSize);
+  #pragma omp parallel for num_threads(Parallel::Threads()) if (useThreads)
+  for (size_t i = 0; i < basisSize; ++i)
+    projections[i] = (double) dot(treeQueue[i]->BasisVector(), centroid);
+
+  // Now remove all of the projections from the centroid.  Each thread takes
+  // care of a different block of rows.
+  const size_t numBlocks = useThreads ? Parallel::Threads() : 1;
+  #pragma omp parallel for num_threads(Parallel::Threads()) if (useThreads)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    currentNode = *i;
+    const size_t begin = centroid.n_elem * b / numBlocks;
+    const size_t end = centroid.n_elem * (b + 1) / numBlocks;
+    if (begin == end)
+      continue;
 
-    double projection = (double) dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
+    for (size_t i = 0; i < basisSize; ++i)
+    {
+      newBasisVector.subvec(begin, end - 1) -= projections[i] *
+          treeQueue[i]->BasisVector().subvec(begin, end - 1);
+    }
   }
 
   // If additional basis vector is passed, take it into account.
@@ -446,40 +460,30 @@ inline double CosineTree<MatType>::MonteCarloError(
   else
     projectionSize = treeQueue.size();
 
-  // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
+  // Compute the projection of each sampled vector onto the existing subspace;
+  // the projections on all basis vectors are computed in parallel.  If two
+  // additional vectors are passed, take their projections too.
+  arma::mat projections(projectionSize, numSamples);
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (projectionSize * numSamples * dataset.n_rows >= \
+          details::cosineTreeParallelMinWork)
+  for (size_t p = 0; p < projectionSize * numSamples; ++p)
   {
-    // Initialize projection as a vector of zeros.
-    VecType projection;
-    projection.zeros(projectionSize);
-
-    CosineTree *currentNode;
-    typename CosineNodeQueue<MatType>::const_iterator j = treeQueue.cbegin();
+    const size_t i = p / projectionSize;
+    const size_t k = p % projectionSize;
+    const VecType& basisVector = (k < treeQueue.size()) ?
+        treeQueue[k]->BasisVector() :
+        ((k == treeQueue.size()) ? *addBasisVector1 : *addBasisVector2);
 
-    size_t k = 0;
-    // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.cend(); ++j, ++k)
-    {
-      currentNode = *j;
-
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
-    }
-    // If two additional vectors are passed, take their projections.
-    if (addBasisVector1 && addBasisVector2)
-    {
-      projection(k++) = dot(dataset.col(sampledIndices[i]),
-                                  *addBasisVector1);
-      projection(k) = dot(dataset.col(sampledIndices[i]),
-                                *addBasisVector2);
-    }
-
-    // Calculate the Frobenius norm squared of the projected vector.
-    double frobProjection = arma::norm(projection, "frob");
-    double frobProjectionSquared = frobProjection * frobProjection;
+    projections(k, i) = dot(dataset.col(sampledIndices[i]), basisVector);
+  }
 
-    // Calculate the weighted projection magnitude.
-    weightedMagnitudes(i) = frobProjectionSquared / probabilities(i);
+  // For each sample, calculate the weighted projection magnitude from the
+  // Frobenius norm squared of the projected vector.
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    weightedMagnitudes(i) = arma::dot(projections.col(i), projections.col(i)) /
+        probabilities(i);
   }
 
   // Compute mean and standard deviation of the weighted samples.
@@ -522,6 +526,142 @@ inline void CosineTree<MatType>::ConstructBasis(
   }
 }
 
+template<typename MatType>
+inline void CosineTree<MatType>::Refine(const double epsilon)
+{
+  if (treeRoot == NULL)
+  {
+    throw std::runtime_error("CosineTree::Refine(): only trees built with "
+        "'epsilon' and 'delta' can be refined");
+  }
+
+  // If an earlier refinement step already reached the tolerance, there is no
+  // need to split anything.
+  const double maxError = epsilon * treeRoot->FrobNormSquared();
+  for (size_t i = 0; i < errors.size(); ++i)
+  {
+    if (errors[i] <= maxError)
+    {
+      ReplayBasis(i);
+      return;
+    }
+  }
+
+  CompareCosineNode comp;
+  double monteCarloError = errors.back();
+  while (!exhausted && monteCarloError > maxError)
+  {
+    // Pop node from queue with highest projection error.
+    CosineTree* currentNode;
+    currentNode = frontier.front();
+
+    // If the priority is 0, we can't improve anything, and we can assume that
+    // we've done the best we can.  The node stays a leaf.
+    if (currentNode->L2Error() == 0.0)
+    {
+      exhausted = true;
+      break;
+    }
+
+    std::pop_heap(frontier.begin(), frontier.end(), comp);
+    frontier.pop_back();
+
+    // Split the node into left and right children.  We assume that this cannot
+    // fail; it might fail if L2Error() is 0, but we have already avoided that
+    // case.
+    currentNode->CosineNodeSplit();
+
+    // Obtain pointers to the left and right children of the current node.
+    CosineTree *currentLeft, *currentRight;
+    currentLeft = currentNode->Left();
+    currentRight = currentNode->Right();
+
+    // Calculate basis vectors of left and right children.
+    VecType lBasisVector, rBasisVector;
+
+    ModifiedGramSchmidt(frontier, currentLeft->Centroid(), lBasisVector);
+    ModifiedGramSchmidt(frontier, currentRight->Centroid(), rBasisVector,
+                        &lBasisVector);
+
+    // Add basis vectors to their respective nodes.
+    currentLeft->BasisVector(lBasisVector);
+    currentRight->BasisVector(rBasisVector);
+
+    // Calculate Monte Carlo error estimates for child nodes.
+    MonteCarloError(currentLeft, frontier, &lBasisVector, &rBasisVector);
+    MonteCarloError(currentRight, frontier, &lBasisVector, &rBasisVector);
+
+    // Push child nodes into the priority queue.
+    frontier.push_back(currentLeft);
+    std::push_heap(frontier.begin(), frontier.end(), comp);
+    frontier.push_back(currentRight);
+    std::push_heap(frontier.begin(), frontier.end(), comp);
+
+    // Calculate Monte Carlo error estimate for the root node.
+    monteCarloError = MonteCarloError(treeRoot, frontier);
+
+    splits.push_back(currentNode);
+    errors.push_back(monteCarloError);
+  }
+
+  if (monteCarloError > maxError)
+  {
+    Log::Warn << "CosineTree::Refine(): could not build tree to "
+        << "desired relative error " << epsilon << "; failing with estimated "
+        << "relative error " << (monteCarloError / treeRoot->FrobNormSquared())
+        << "." << std::endl;
+  }
+
+  // Construct the subspace basis from the current priority queue.
+  ConstructBasis(frontier);
+}
+
+template<typename MatType>
+inline void CosineTree<MatType>::ReplayBasis(const size_t numSplits)
+{
+  // Each refinement step replaces the node it split with its two children.
+  CosineNodeQueue<MatType> leaves(1, treeRoot);
+  for (size_t i = 0; i < numSplits; ++i)
+  {
+    leaves.erase(std::find(leaves.begin(), leaves.end(), splits[i]));
+    leaves.push_back(splits[i]->Left());
+    leaves.push_back(splits[i]->Right());
+  }
+
+  ConstructBasis(leaves);
+}
+
+template<typename MatType>
+inline void CosineTree<MatType>::CopyRefinement(const CosineTree& other)
+{
+  // Both trees have the same shape, so walk them together.
+  std::unordered_map<const CosineTree*, CosineTree*> nodeMap;
+  std::vector<std::pair<const CosineTree*, CosineTree*>> stack;
+  stack.push_back(std::make_pair(other.treeRoot, treeRoot));
+  while (!stack.empty())
+  {
+    const CosineTree* otherNode = stack.back().first;
+    CosineTree* node = stack.back().second;
+    stack.pop_back();
+
+    nodeMap[otherNode] = node;
+    if (otherNode->Left())
+      stack.push_back(std::make_pair(otherNode->Left(), node->Left()));
+    if (otherNode->Right())
+      stack.push_back(std::make_pair(otherNode->Right(), node->Right()));
+  }
+
+  frontier.resize(other.frontier.size());
+  for (size_t i = 0; i < frontier.size(); ++i)
+    frontier[i] = nodeMap[other.frontier[i]];
+
+  splits.resize(other.splits.size());
+  for (size_t i = 0; i < splits.size(); ++i)
+    splits[i] = nodeMap[other.splits[i]];
+
+  errors = other.errors;
+}
+
 template<typename MatType>
 inline void CosineTree<MatType>::CosineNodeSplit()
 {
@@ -659,6 +799,8 @@ inline void CosineTree<MatType>::CalculateCosines(
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (numColumns * dataset->n_rows >= details::cosineTreeParallelMinWork)
   for (size_t i = 0; i < numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
@@ -682,10 +824,20 @@ inline void CosineTree<MatType>::CalculateCentroid()
   // Initialize centroid as vector of zeros.
   centroid.zeros(dataset->n_rows);
 
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Calculate centroid of columns in the node.  Each thread sums a part of the
+  // columns.
+  #pragma omp parallel num_threads(Parallel::Threads()) \
+      if (numColumns * dataset->n_rows >= details::cosineTreeParallelMinWork)
   {
-    centroid += dataset->col(indices[i]);
+    VecType threadSum;
+    threadSum.zeros(dataset->n_rows);
+
+    #pragma omp for schedule(static)
+    for (size_t i = 0; i < numColumns; ++i)
+      threadSum += dataset->col(indices[i]);
+
+    #pragma omp critical
+    centroid += threadSum;
   }
   centroid /= numColumns;
 }
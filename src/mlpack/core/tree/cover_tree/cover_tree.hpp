@@ -17,6 +17,7 @@
 
 #include "../statistic.hpp"
 #include "first_point_is_root.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 
 namespace mlpack {
 
@@ -276,8 +277,22 @@ class CoverTree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser; see
+  //! frontier_dual_tree_traverser.hpp.
   template<typename RuleType>
-  using BreadthFirstDualTreeTraverser = DualTreeTraverser<RuleType>;
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<CoverTree, RuleType>;
+
+  //! A breadth-first dual-tree traverser that processes the levels of the
+  //! query tree in parallel; see frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using ParallelBreadthFirstDualTreeTraverser =
+      ParallelFrontierDualTreeTraverser<CoverTree, RuleType>;
+
+  //! A dual-tree cover tree traverser that traverses independent query
+  //! subtrees in OpenMP tasks; see dual_tree_traverser.hpp.
+  template<typename RuleType>
+  class ParallelDualTreeTraverser;
 
   //! Get a reference to the dataset.
   const MatType& Dataset() const { return *dataset; }
@@ -425,9 +440,9 @@ class CoverTree
   ElemType MinimumBoundDistance() const { return furthestDescendantDistance; }
 
   //! Get the center of the node and store it in the given vector.
-  void Center(arma::vec& center) const
+  void Center(arma::Col<ElemType>& center) const
   {
-    center = arma::vec(dataset->col(point));
+    center = arma::Col<ElemType>(dataset->col(point));
   }
 
   //! Get the instantiated distance metric.
@@ -484,6 +499,8 @@ class CoverTree
    * @param indices List of indices to compute distances for.
    * @param distances Vector to store calculated distances in.
    * @param pointSetSize Number of points in arrays to calculate distances for.
+   *     If this is at least ParallelDistancesMinSize, the distances are
+   *     computed with OpenMP.
    */
   void ComputeDistances(const size_t pointIndex,
                         const arma::Col<size_t>& indices,
@@ -577,6 +594,11 @@ class CoverTree
 
  private:
   size_t distanceComps;
+
+  //! The minimum number of distances that ComputeDistances() computes in
+  //! parallel.  The distances computed for each new child of the nodes near
+  //! the root make up most of the work of building a cover tree.
+  static constexpr size_t ParallelDistancesMinSize = 5000;
 };
 
 } // namespace mlpack
@@ -1396,8 +1396,11 @@ void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
                      const size_t pointSetSize)
 {
   // For each point, rebuild the distances.  The indices do not need to be
-  // modified.
+  // modified.  Each distance is independent, so large sets of points are
+  // handled by multiple threads.
   distanceComps += pointSetSize;
+  #pragma omp parallel for schedule(static) \
+      if (pointSetSize >= ParallelDistancesMinSize)
   for (size_t i = 0; i < pointSetSize; ++i)
   {
     distances[i] = distance->Evaluate(dataset->col(pointIndex),
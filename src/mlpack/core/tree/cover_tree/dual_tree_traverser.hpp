@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_COVER_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 #include <queue>
 
 namespace mlpack {
@@ -30,11 +31,27 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
  public:
   /**
    * Initialize the dual tree traverser with the given rule type.
+   *
+   * If minTaskSize is nonzero, the traversal is done in parallel: the
+   * recursions into the children of any query node with at least minTaskSize
+   * descendants are run in separate OpenMP tasks, so that batches of query
+   * points are handled by different threads.  The subtrees of the children of
+   * a cover tree node hold distinct points, so the results are the same as
+   * for a serial traversal.  Each task uses a copy of the rules, so this
+   * places the same requirements on RuleType as the ParallelDualTreeTraverser
+   * of the BinarySpaceTree: copies must share the per-query-point results, and
+   * BaseCases() and Scores() must return modifiable references.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Minimum number of descendants of a query node for its
+   *     children to be traversed in separate tasks (0 disables parallelism).
    */
-  DualTreeTraverser(RuleType& rule);
+  DualTreeTraverser(RuleType& rule, const size_t minTaskSize = 0);
 
   /**
-   * Traverse the two specified trees.
+   * Traverse the two specified trees.  If the traversal is parallel and this
+   * is called outside of a parallel region, a parallel region is opened with
+   * the default number of OpenMP threads.
    *
    * @param queryNode Root of query tree.
    * @param referenceNode Root of reference tree.
@@ -46,6 +63,12 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
   //! Modify the number of pruned nodes.
   size_t& NumPrunes() { return numPrunes; }
 
+  //! Get the minimum query node size for which tasks are created.
+  size_t MinTaskSize() const { return minTaskSize; }
+  //! Modify the minimum query node size for which tasks are created (0
+  //! disables parallelism).
+  size_t& MinTaskSize() { return minTaskSize; }
+
   ///// These are all fake because this is a patch for kd-trees only and I still
   ///// want it to compile!
   size_t NumVisited() const { return 0; }
@@ -59,6 +82,9 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
   //! The number of pruned nodes.
   size_t numPrunes;
 
+  //! The minimum number of descendants of a query node to fork tasks.
+  size_t minTaskSize;
+
   //! Struct used for traversal.
   struct DualCoverTreeMapEntry
   {
@@ -102,6 +128,40 @@ class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
       CoverTree& queryNode,
     std::map<int, std::vector<DualCoverTreeMapEntry>,
         std::greater<int>>& referenceMap);
+
+  //! Traverse the non-self-children of the query node in separate tasks, and
+  //! the self-child in the current task.  The entries of the reference map
+  //! must already be sorted.
+  void ForkQueryChildren(
+      CoverTree& queryNode,
+      std::map<int, std::vector<DualCoverTreeMapEntry>,
+          std::greater<int>>& referenceMap);
+};
+
+/**
+ * A DualTreeTraverser for the cover tree that is parallel by default, for use
+ * as the DualTreeTraversalType of NeighborSearch (see ParallelKNN).
+ */
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+class CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+    ParallelDualTreeTraverser : public DualTreeTraverser<RuleType>
+{
+ public:
+  /**
+   * Initialize the parallel dual tree traverser with the given rule type.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Minimum number of descendants of a query node for its
+   *     children to be traversed in separate tasks.
+   */
+  ParallelDualTreeTraverser(RuleType& rule, const size_t minTaskSize = 1000) :
+      DualTreeTraverser<RuleType>(rule, minTaskSize) { }
 };
 
 } // namespace mlpack
@@ -25,9 +25,11 @@ template<
 >
 template<typename RuleType>
 CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
-DualTreeTraverser<RuleType>::DualTreeTraverser(RuleType& rule) :
+DualTreeTraverser<RuleType>::DualTreeTraverser(RuleType& rule,
+                                               const size_t minTaskSize) :
     rule(rule),
-    numPrunes(0)
+    numPrunes(0),
+    minTaskSize(minTaskSize)
 { /* Nothing to do. */ }
 
 template<
@@ -56,7 +58,21 @@ DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
 
   refMap[referenceNode.Scale()].push_back(rootRefEntry);
 
-  Traverse(queryNode, refMap);
+  if (minTaskSize == 0)
+  {
+    Traverse(queryNode, refMap);
+    return;
+  }
+
+  // Only one thread starts the traversal; the others pick up the tasks that
+  // are created.
+  #pragma omp parallel
+  {
+    #pragma omp single
+    {
+      Traverse(queryNode, refMap);
+    }
+  }
 }
 
 template<
@@ -87,6 +103,19 @@ DualTreeTraverser<RuleType>::Traverse(
   if ((queryNode.Scale() != INT_MIN) &&
       (queryNode.Scale() >= (*referenceMap.begin()).first))
   {
+    // Before the entries at each scale are pruned for each child, sort them by
+    // score, so that the most promising reference nodes are visited first.
+    typename std::map<int, std::vector<DualCoverTreeMapEntry>,
+        std::greater<int>>::iterator it;
+    for (it = referenceMap.begin(); it != referenceMap.end(); ++it)
+      std::sort((*it).second.begin(), (*it).second.end());
+
+    if (minTaskSize > 0 && queryNode.NumDescendants() >= minTaskSize)
+    {
+      ForkQueryChildren(queryNode, referenceMap);
+      return;
+    }
+
     // Recurse into the non-self-children first.  The recursion order cannot
     // affect the runtime of the algorithm, because each query child recursion's
     // results are separate and independent.  I don't think this is true in
@@ -171,10 +200,10 @@ DualTreeTraverser<RuleType>::PruneMap(
   if (referenceMap.count(INT_MIN) == 1)
   {
     // Get a reference to the vector representing the entries at this scale.
-    std::vector<DualCoverTreeMapEntry>& scaleVector = referenceMap[INT_MIN];
-
-    // Before traversing all the points in this scale, sort by score.
-    std::sort(scaleVector.begin(), scaleVector.end());
+    // (It has already been sorted by score.)  This does not use operator[],
+    // so that the map is only read; it may be shared by multiple tasks.
+    std::vector<DualCoverTreeMapEntry>& scaleVector =
+        (*referenceMap.find(INT_MIN)).second;
 
     childMap[INT_MIN].reserve(scaleVector.size());
     std::vector<DualCoverTreeMapEntry>& newScaleVector = childMap[INT_MIN];
@@ -224,11 +253,9 @@ DualTreeTraverser<RuleType>::PruneMap(
       break;
 
     // Get a reference to the vector representing the entries at this scale.
+    // (It has already been sorted by score.)
     std::vector<DualCoverTreeMapEntry>& scaleVector = (*it).second;
 
-    // Before traversing all the points in this scale, sort by score.
-    std::sort(scaleVector.begin(), scaleVector.end());
-
     childMap[thisScale].reserve(scaleVector.size());
     std::vector<DualCoverTreeMapEntry>& newScaleVector = childMap[thisScale];
 
@@ -353,6 +380,70 @@ DualTreeTraverser<RuleType>::ReferenceRecursion(
   }
 }
 
+template<
+    typename DistanceType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+template<typename RuleType>
+void CoverTree<DistanceType, StatisticType, MatType, RootPointPolicy>::
+DualTreeTraverser<RuleType>::ForkQueryChildren(
+    CoverTree& queryNode,
+    std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>&
+        referenceMap)
+{
+  // The copies of the rules must be made here, by the thread that owns the
+  // current rules, and not inside of the tasks.  The copies share the results
+  // with the original rules, but their counters start from zero so that they
+  // can be summed afterwards.
+  const size_t numTasks = queryNode.NumChildren() - 1;
+  std::vector<RuleType> childRules(numTasks, rule);
+  std::vector<size_t> childPrunes(numTasks, 0);
+  for (size_t i = 0; i < numTasks; ++i)
+  {
+    childRules[i].BaseCases() = 0;
+    childRules[i].Scores() = 0;
+    ResetTraversalCounters(childRules[i]);
+  }
+
+  CoverTree* queryPtr = &queryNode;
+  std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>* mapPtr =
+      &referenceMap;
+
+  for (size_t i = 1; i < queryNode.NumChildren(); ++i)
+  {
+    #pragma omp task firstprivate(i) shared(childRules, childPrunes)
+    {
+      DualTreeTraverser childTraverser(childRules[i - 1], minTaskSize);
+
+      std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>
+          childMap;
+      childTraverser.PruneMap(queryPtr->Child(i), *mapPtr, childMap);
+      childTraverser.Traverse(queryPtr->Child(i), childMap);
+
+      childPrunes[i - 1] = childTraverser.numPrunes;
+    }
+  }
+
+  // The self-child is handled by the current task, with the original rules.
+  std::map<int, std::vector<DualCoverTreeMapEntry>, std::greater<int>>
+      selfChildMap;
+  PruneMap(queryNode.Child(0), referenceMap, selfChildMap);
+  Traverse(queryNode.Child(0), selfChildMap);
+
+  #pragma omp taskwait
+
+  // Now collect the counts from the tasks.
+  for (size_t i = 0; i < numTasks; ++i)
+  {
+    rule.BaseCases() += childRules[i].BaseCases();
+    rule.Scores() += childRules[i].Scores();
+    MergeTraversalCounters(rule, childRules[i]);
+    numPrunes += childPrunes[i];
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,197 @@
+/**
+ * @file core/tree/frontier_dual_tree_traverser.hpp
+ *
+ * Defines the FrontierDualTreeTraverser, a breadth-first dual-tree traverser
+ * that works with any tree type, and that can process the nodes of each level
+ * of the query tree in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "traversal_counters.hpp"
+
+namespace mlpack {
+
+/**
+ * The FrontierDualTreeTraverser traverses the query tree one level at a time.
+ * The frontier holds the query nodes of the current level, each with the list
+ * of reference nodes that it must still be compared with.  For each query node
+ * of the frontier, the reference nodes are visited best first (in order of the
+ * score of their parent combination); reference nodes are descended until
+ * either a pair of leaves is reached (and the base cases are computed) or the
+ * query node can be descended too, in which case the combinations for its
+ * children are added to the next frontier.  Scores are only computed when a
+ * combination is visited, so pruning always uses the latest bounds.
+ *
+ * This works with any tree type that provides NumChildren(), Child(),
+ * NumPoints(), Point() and NumDescendants(), and in which base cases only need
+ * to be computed between leaves: BinarySpaceTree, CoverTree, RectangleTree and
+ * Octree (but not SpillTree, whose leaves may share points).  Each tree type
+ * exposes it as its BreadthFirstDualTreeTraverser.
+ *
+ * If minTaskSize is not 0, every level whose query nodes hold at least
+ * minTaskSize descendant points is processed with OpenMP, one query node at a
+ * time per thread; this needs no task recursion, since the frontier of a large
+ * tree is wide.  The query nodes of a level hold disjoint sets of points, and
+ * are the only nodes that the rules change, so the results are the same as for
+ * a serial traversal.  Each thread uses a copy of the rules, which places the
+ * same requirements on RuleType as the ParallelDualTreeTraverser of the
+ * BinarySpaceTree:
+ *
+ *  - Copies of a RuleType object must share the storage for per-query-point
+ *    results, but each copy must have its own traversal state.
+ *  - Score() and BaseCase() may read the statistics of the parent and of the
+ *    children of a query node, but may only modify the statistics of the query
+ *    node itself and the results of its points.
+ *  - RuleType must provide BaseCases() and Scores() accessors that return
+ *    modifiable references.
+ *
+ * ParallelFrontierDualTreeTraverser is the same traverser with parallelism
+ * enabled by default.
+ */
+template<typename TreeType, typename RuleType>
+class FrontierDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the breadth-first dual-tree traverser with the given rule set.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Minimum number of descendant points that the query
+   *     nodes of a level must hold for the level to be processed in parallel
+   *     (0 disables parallelism).
+   */
+  FrontierDualTreeTraverser(RuleType& rule, const size_t minTaskSize = 0);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum size of a level for it to be processed in parallel.
+  size_t MinTaskSize() const { return minTaskSize; }
+  //! Modify the minimum size of a level for it to be processed in parallel (0
+  //! disables parallelism).
+  size_t& MinTaskSize() { return minTaskSize; }
+
+ private:
+  //! A reference node that a query node must be compared with.
+  struct Candidate
+  {
+    //! The reference node.
+    TreeType* referenceNode;
+    //! The score of the parent combination.
+    double score;
+    //! The traversal info after the parent combination was scored.
+    typename RuleType::TraversalInfoType traversalInfo;
+
+    //! Order candidates so that the best (lowest) score is at the top of a
+    //! priority queue.
+    bool operator<(const Candidate& other) const
+    {
+      return score > other.score;
+    }
+  };
+
+  //! A query node of the frontier, with its candidates.
+  struct QueryTask
+  {
+    //! The query node.
+    TreeType* queryNode;
+    //! The reference nodes it must be compared with.
+    std::vector<Candidate> candidates;
+  };
+
+  /**
+   * Visit all the candidates of the given task (and the reference descendants
+   * of the candidates), and add the tasks for the children of its query node
+   * to the given list.  The counts of the traversal are added to the given
+   * variables, so that this can be called from several threads.
+   */
+  void TraverseTask(RuleType& taskRule,
+                    QueryTask& task,
+                    std::vector<QueryTask>& children,
+                    size_t& prunes,
+                    size_t& visited,
+                    size_t& scores,
+                    size_t& baseCases) const;
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum size of a level for it to be processed in parallel.
+  size_t minTaskSize;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+/**
+ * A FrontierDualTreeTraverser that processes large levels in parallel by
+ * default.  Each tree type exposes it as its
+ * ParallelBreadthFirstDualTreeTraverser.
+ */
+template<typename TreeType, typename RuleType>
+class ParallelFrontierDualTreeTraverser :
+    public FrontierDualTreeTraverser<TreeType, RuleType>
+{
+ public:
+  /**
+   * Instantiate the parallel breadth-first dual-tree traverser with the given
+   * rule set.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Minimum number of descendant points that the query
+   *     nodes of a level must hold for the level to be processed in parallel.
+   */
+  ParallelFrontierDualTreeTraverser(RuleType& rule,
+                                    const size_t minTaskSize = 1000) :
+      FrontierDualTreeTraverser<TreeType, RuleType>(rule, minTaskSize) { }
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "frontier_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
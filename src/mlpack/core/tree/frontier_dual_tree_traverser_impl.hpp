@@ -0,0 +1,203 @@
+/**
+ * @file core/tree/frontier_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the FrontierDualTreeTraverser, a breadth-first dual-tree
+ * traverser for any tree type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "frontier_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename TreeType, typename RuleType>
+FrontierDualTreeTraverser<TreeType, RuleType>::FrontierDualTreeTraverser(
+    RuleType& rule,
+    const size_t minTaskSize) :
+    rule(rule),
+    minTaskSize(minTaskSize),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void FrontierDualTreeTraverser<TreeType, RuleType>::Traverse(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  // Must score the root combination.
+  const double rootScore = rule.Score(queryNode, referenceNode);
+  ++numScores;
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+
+  std::vector<QueryTask> frontier(1);
+  frontier[0].queryNode = &queryNode;
+  frontier[0].candidates.push_back(Candidate { &referenceNode, rootScore,
+      rule.TraversalInfo() });
+
+  while (!frontier.empty())
+  {
+    size_t queryPoints = 0;
+    for (size_t i = 0; i < frontier.size(); ++i)
+      queryPoints += frontier[i].queryNode->NumDescendants();
+
+    // The children of each task are kept apart, so that the order of the next
+    // frontier does not depend on the order in which threads finish.
+    std::vector<std::vector<QueryTask>> children(frontier.size());
+    const bool useThreads = (minTaskSize > 0 && frontier.size() > 1 &&
+        queryPoints >= minTaskSize);
+
+    if (useThreads)
+    {
+      size_t prunes = 0, visited = 0, scores = 0, baseCases = 0;
+      size_t ruleScores = 0, ruleBaseCases = 0;
+      #pragma omp parallel num_threads(Parallel::Threads()) \
+          reduction(+:prunes, visited, scores, baseCases, ruleScores, \
+          ruleBaseCases)
+      {
+        // The copies share the results with the original rules, but their
+        // counters start from zero so that they can be summed afterwards.
+        RuleType threadRule(rule);
+        threadRule.BaseCases() = 0;
+        threadRule.Scores() = 0;
+        ResetTraversalCounters(threadRule);
+
+        #pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < frontier.size(); ++i)
+        {
+          TraverseTask(threadRule, frontier[i], children[i], prunes, visited,
+              scores, baseCases);
+        }
+
+        ruleScores += threadRule.Scores();
+        ruleBaseCases += threadRule.BaseCases();
+
+        #pragma omp critical
+        MergeTraversalCounters(rule, threadRule);
+      }
+
+      rule.Scores() += ruleScores;
+      rule.BaseCases() += ruleBaseCases;
+      numPrunes += prunes;
+      numVisited += visited;
+      numScores += scores;
+      numBaseCases += baseCases;
+    }
+    else
+    {
+      for (size_t i = 0; i < frontier.size(); ++i)
+      {
+        TraverseTask(rule, frontier[i], children[i], numPrunes, numVisited,
+            numScores, numBaseCases);
+      }
+    }
+
+    frontier.clear();
+    for (size_t i = 0; i < children.size(); ++i)
+      for (size_t j = 0; j < children[i].size(); ++j)
+        frontier.push_back(std::move(children[i][j]));
+  }
+}
+
+template<typename TreeType, typename RuleType>
+void FrontierDualTreeTraverser<TreeType, RuleType>::TraverseTask(
+    RuleType& taskRule,
+    QueryTask& task,
+    std::vector<QueryTask>& children,
+    size_t& prunes,
+    size_t& visited,
+    size_t& scores,
+    size_t& baseCases) const
+{
+  TreeType& queryNode = *task.queryNode;
+  std::priority_queue<Candidate> queue(std::less<Candidate>(),
+      std::move(task.candidates));
+
+  // The candidates of each child of the query node.
+  std::vector<std::vector<Candidate>> childCandidates(
+      queryNode.NumChildren());
+
+  while (!queue.empty())
+  {
+    const Candidate candidate = queue.top();
+    queue.pop();
+
+    TreeType& referenceNode = *candidate.referenceNode;
+    taskRule.TraversalInfo() = candidate.traversalInfo;
+    const double score = taskRule.Score(queryNode, referenceNode);
+    ++scores;
+
+    if (score == DBL_MAX)
+    {
+      ++prunes;
+      continue;
+    }
+
+    ++visited;
+    if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+    {
+      // Loop through each of the points in each node.
+      for (size_t i = 0; i < queryNode.NumPoints(); ++i)
+        for (size_t j = 0; j < referenceNode.NumPoints(); ++j)
+          taskRule.BaseCase(queryNode.Point(i), referenceNode.Point(j));
+
+      baseCases += queryNode.NumPoints() * referenceNode.NumPoints();
+    }
+    else if (queryNode.IsLeaf())
+    {
+      // Only the reference node can be descended; its children are visited
+      // with the same query node, best first.
+      for (size_t i = 0; i < referenceNode.NumChildren(); ++i)
+      {
+        queue.push(Candidate { &referenceNode.Child(i), score,
+            taskRule.TraversalInfo() });
+      }
+    }
+    else if (referenceNode.IsLeaf())
+    {
+      for (size_t i = 0; i < queryNode.NumChildren(); ++i)
+      {
+        childCandidates[i].push_back(Candidate { &referenceNode, score,
+            taskRule.TraversalInfo() });
+      }
+    }
+    else
+    {
+      // Descend both nodes; the query children are handled at the next level.
+      for (size_t i = 0; i < queryNode.NumChildren(); ++i)
+      {
+        for (size_t j = 0; j < referenceNode.NumChildren(); ++j)
+        {
+          childCandidates[i].push_back(Candidate { &referenceNode.Child(j),
+              score, taskRule.TraversalInfo() });
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < childCandidates.size(); ++i)
+  {
+    if (childCandidates[i].empty())
+      continue;
+
+    children.push_back(QueryTask { &queryNode.Child(i),
+        std::move(childCandidates[i]) });
+  }
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
+#include <mlpack/core/util/fixed_dimension.hpp>
 #include "bound_traits.hpp"
 
 namespace mlpack {
@@ -41,6 +42,12 @@ struct IsLMetric<LMetric<Power, TakeRoot>>
  * with the LMetric class.  Be sure to use the same template parameters for
  * LMetric as you do for HRectBound -- otherwise odd results may occur.
  *
+ * For low-dimensional data (up to maxFixedDimension dimensions, such as 2-D or
+ * 3-D geospatial data), the ranges are stored inside the bound instead of on
+ * the heap, and the distance functions loop over a number of dimensions that
+ * is known at compile time (see DispatchFixedDimension()), so that they are
+ * fully unrolled.
+ *
  * @tparam DistanceType Type of distance metric to use; must be of type LMetric.
  * @tparam ElemType Element type (double/float/int/etc.).
  */
@@ -145,6 +152,32 @@ class HRectBound
    */
   ElemType MinDistance(const HRectBound& other) const;
 
+  /**
+   * Calculates minimum bound-to-point distance, but stop as soon as it is known
+   * to be at least the given bound.  In that case, the returned value is no
+   * less than bound, but it may be less than the actual minimum distance.  This
+   * is useful when the distance is only needed if it is less than a pruning
+   * bound, as in the Score() function of many rules.
+   *
+   * @param point Point to which the minimum distance is requested.
+   * @param bound Distance above which the exact minimum distance is not needed.
+   */
+  template<typename VecType>
+  ElemType MinDistance(const VecType& point,
+                       const ElemType bound,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Calculates minimum bound-to-bound distance, but stop as soon as it is known
+   * to be at least the given bound.  In that case, the returned value is no
+   * less than bound, but it may be less than the actual minimum distance.
+   *
+   * @param other Bound to which the minimum distance is requested.
+   * @param bound Distance above which the exact minimum distance is not needed.
+   */
+  ElemType MinDistance(const HRectBound& other, const ElemType bound) const;
+
   /**
    * Calculates maximum bound-to-point squared distance.
    *
@@ -240,12 +273,41 @@ class HRectBound
  private:
   //! The dimensionality of the bound.
   size_t dim;
-  //! The bounds for each dimension.
+  //! The bounds for each dimension.  This points to localBounds if the
+  //! dimensionality is at most maxFixedDimension, and to heap memory
+  //! otherwise.
   RangeType<ElemType>* bounds;
+  //! Storage for the bounds of low-dimensional bounds, so that they are next
+  //! to the rest of the bound (and the tree node holding it) in memory.
+  RangeType<ElemType> localBounds[maxFixedDimension];
   //! Cached minimum width of bound.
   ElemType minWidth;
   //! Instantiated distance metric (likely has size 0).
   DistanceType distance;
+
+  //! The type that distances are accumulated in across dimensions.  Sums of
+  //! float elements are accumulated in double precision, so that rounding
+  //! error in high dimensions does not loosen (or invalidate) the bounds.
+  typedef typename std::conditional<std::is_same<ElemType, float>::value,
+      double, ElemType>::type AccumType;
+
+  //! Return the term that one dimension with the given non-negative extent adds
+  //! to a sum of powers of distances.  The loops over dimensions that use this
+  //! have no branches, so that the compiler can vectorize them.
+  static AccumType PowerTerm(const ElemType v);
+
+  //! Turn the given sum of PowerTerm() values into a distance.
+  static ElemType PowerSumToDistance(const AccumType sum);
+
+  //! Turn the given distance into the sum of PowerTerm() values it comes from.
+  static AccumType DistanceToPowerSum(const ElemType distance);
+
+  //! Set the dimensionality, and point `bounds` at storage for it.  Any
+  //! previous storage must already have been released with Deallocate().
+  void Allocate(const size_t dimension);
+
+  //! Release the storage of the bounds, if it is on the heap.
+  void Deallocate();
 };
 
 // A specialization of BoundTraits for this class.
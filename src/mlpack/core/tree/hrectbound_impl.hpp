@@ -34,10 +34,10 @@ inline HRectBound<DistanceType, ElemType>::HRectBound() :
  */
 template<typename DistanceType, typename ElemType>
 inline HRectBound<DistanceType, ElemType>::HRectBound(const size_t dimension) :
-    dim(dimension),
-    bounds(new RangeType<ElemType>[dim]),
     minWidth(0)
-{ /* Nothing to do. */ }
+{
+  Allocate(dimension);
+}
 
 /**
  * Copy constructor necessary to prevent memory leaks.
@@ -45,10 +45,10 @@ inline HRectBound<DistanceType, ElemType>::HRectBound(const size_t dimension) :
 template<typename DistanceType, typename ElemType>
 inline HRectBound<DistanceType, ElemType>::HRectBound(
     const HRectBound<DistanceType, ElemType>& other) :
-    dim(other.Dim()),
-    bounds(new RangeType<ElemType>[dim]),
     minWidth(other.MinWidth())
 {
+  Allocate(other.Dim());
+
   // Copy other bounds over.
   for (size_t i = 0; i < dim; ++i)
     bounds[i] = other[i];
@@ -69,11 +69,8 @@ inline HRectBound<
   if (dim != other.Dim())
   {
     // Reallocation is necessary.
-    if (bounds)
-      delete[] bounds;
-
-    dim = other.Dim();
-    bounds = new RangeType<ElemType>[dim];
+    Deallocate();
+    Allocate(other.Dim());
   }
 
   // Now copy each of the bound values.
@@ -91,14 +88,11 @@ inline HRectBound<
 template<typename DistanceType, typename ElemType>
 inline HRectBound<DistanceType, ElemType>::HRectBound(
     HRectBound<DistanceType, ElemType>&& other) :
-    dim(other.dim),
-    bounds(other.bounds),
-    minWidth(other.minWidth)
+    dim(0),
+    bounds(NULL),
+    minWidth(0)
 {
-  // Fix the other bound.
-  other.dim = 0;
-  other.bounds = NULL;
-  other.minWidth = 0.0;
+  *this = std::move(other);
 }
 
 /**
@@ -111,9 +105,21 @@ HRectBound<DistanceType, ElemType>::operator=(
 {
   if (this != &other)
   {
-    bounds = other.bounds;
+    Deallocate();
+    if (other.bounds == other.localBounds)
+    {
+      // Bounds stored locally have to be copied.
+      Allocate(other.dim);
+      for (size_t i = 0; i < dim; ++i)
+        bounds[i] = other.bounds[i];
+    }
+    else
+    {
+      bounds = other.bounds;
+      dim = other.dim;
+    }
+
     minWidth = other.minWidth;
-    dim = other.dim;
     other.dim = 0;
     other.bounds = nullptr;
     other.minWidth = 0.0;
@@ -127,8 +133,7 @@ HRectBound<DistanceType, ElemType>::operator=(
 template<typename DistanceType, typename ElemType>
 inline HRectBound<DistanceType, ElemType>::~HRectBound()
 {
-  if (bounds)
-    delete[] bounds;
+  Deallocate();
 }
 
 /**
@@ -179,6 +184,14 @@ inline ElemType HRectBound<DistanceType, ElemType>::Volume() const
   return volume;
 }
 
+namespace details {
+
+//! The number of dimensions between two checks of the pruning bound in the
+//! bounded MinDistance() functions of HRectBound.
+constexpr size_t hrectBoundBlockSize = 8;
+
+} // namespace details
+
 /**
  * Calculates minimum bound-to-point squared distance.
  */
@@ -190,52 +203,25 @@ inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
 {
   Log::Assert(point.n_elem == dim);
 
-  ElemType sum = 0;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    lower = bounds[d].Lo() - point[d];
-    higher = point[d] - bounds[d].Hi();
+    // The number of dimensions is a compile-time constant for low-dimensional
+    // bounds, so the loop can be unrolled.
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // Since only one of 'lower' or 'higher' is negative, if we add each's
-    // absolute value to itself and then sum those two, our result is the
-    // nonnegative half of the equation times two; then we raise to power Power.
-    if (DistanceType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (DistanceType::Power == 2)
-    {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
-    }
-    else
+    AccumType sum = 0;
+    for (size_t d = 0; d < n; d++)
     {
-      sum += std::pow((lower + std::fabs(lower)) + (higher + std::fabs(higher)),
-          (ElemType) DistanceType::Power);
+      // At most one of 'lower' and 'higher' is positive; if the point is
+      // inside the bound in this dimension, neither is.
+      const ElemType lower = bounds[d].Lo() - point[d];
+      const ElemType higher = point[d] - bounds[d].Hi();
+      sum += PowerTerm(std::max(std::max(lower, higher), (ElemType) 0));
     }
-  }
 
-  // Now take the Power'th root (but make sure our result is squared if it needs
-  // to be); then cancel out the constant of 2 (which may have been squared now)
-  // that was introduced earlier.  The compiler should optimize out the if
-  // statement entirely.
-  if (DistanceType::Power == 1)
-    return sum * 0.5;
-  else if (DistanceType::Power == 2)
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::pow((double) sum,
-          1.0 / (double) DistanceType::Power) / 2.0;
-    else
-      return sum / std::pow(2.0, DistanceType::Power);
-  }
+    return PowerSumToDistance(sum);
+  });
 }
 
 /**
@@ -247,56 +233,97 @@ ElemType HRectBound<DistanceType, ElemType>::MinDistance(const HRectBound& other
 {
   Log::Assert(dim == other.dim);
 
-  ElemType sum = 0;
-  const RangeType<ElemType>* mbound = bounds;
-  const RangeType<ElemType>* obound = other.bounds;
-
-  ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    lower = obound->Lo() - mbound->Hi();
-    higher = mbound->Lo() - obound->Hi();
-    // We invoke the following:
-    //   x + fabs(x) = max(x * 2, 0)
-    //   (x * 2)^2 / 4 = x^2
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-    else if (DistanceType::Power == 2)
+    AccumType sum = 0;
+    for (size_t d = 0; d < n; d++)
     {
-      ElemType dist = (lower + std::fabs(lower)) + (higher + std::fabs(higher));
-      sum += dist * dist;
+      // At most one of 'lower' and 'higher' is positive; if the bounds overlap
+      // in this dimension, neither is.
+      const ElemType lower = other.bounds[d].Lo() - bounds[d].Hi();
+      const ElemType higher = bounds[d].Lo() - other.bounds[d].Hi();
+      sum += PowerTerm(std::max(std::max(lower, higher), (ElemType) 0));
     }
-    else
+
+    return PowerSumToDistance(sum);
+  });
+}
+
+/**
+ * Calculates minimum bound-to-point distance, stopping early if it exceeds the
+ * given bound.
+ */
+template<typename DistanceType, typename ElemType>
+template<typename VecType>
+inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
+    const VecType& point,
+    const ElemType bound,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  // Low-dimensional bounds fit in one block, so the bound is never checked.
+  if (dim <= maxFixedDimension)
+    return MinDistance(point);
+
+  const AccumType limit = DistanceToPowerSum(bound);
+  AccumType sum = 0;
+  for (size_t start = 0; start < dim; start += details::hrectBoundBlockSize)
+  {
+    // The bound is only checked between blocks, so that the loop over each
+    // block can still be vectorized.
+    const size_t end = std::min(start + details::hrectBoundBlockSize, dim);
+    for (size_t d = start; d < end; d++)
     {
-      sum += std::pow((lower + std::fabs(lower)) + (higher + std::fabs(higher)),
-          (ElemType) DistanceType::Power);
+      const ElemType lower = bounds[d].Lo() - point[d];
+      const ElemType higher = point[d] - bounds[d].Hi();
+      sum += PowerTerm(std::max(std::max(lower, higher), (ElemType) 0));
     }
 
-    // Move bound pointers.
-    mbound++;
-    obound++;
+    if (sum >= limit)
+      break;
   }
 
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::Power == 1)
-    return sum * 0.5;
-  else if (DistanceType::Power == 2)
-  {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
+  return PowerSumToDistance(sum);
+}
+
+/**
+ * Calculates minimum bound-to-bound distance, stopping early if it exceeds the
+ * given bound.
+ */
+template<typename DistanceType, typename ElemType>
+inline ElemType HRectBound<DistanceType, ElemType>::MinDistance(
+    const HRectBound& other,
+    const ElemType bound) const
+{
+  Log::Assert(dim == other.dim);
+
+  // Low-dimensional bounds fit in one block, so the bound is never checked.
+  if (dim <= maxFixedDimension)
+    return MinDistance(other);
+
+  const AccumType limit = DistanceToPowerSum(bound);
+  AccumType sum = 0;
+  for (size_t start = 0; start < dim; start += details::hrectBoundBlockSize)
   {
-    if (DistanceType::TakeRoot)
-      return (ElemType) std::pow((double) sum,
-          1.0 / (double) DistanceType::Power) / 2.0;
-    else
-      return sum / std::pow(2.0, DistanceType::Power);
+    // The bound is only checked between blocks, so that the loop over each
+    // block can still be vectorized.
+    const size_t end = std::min(start + details::hrectBoundBlockSize, dim);
+    for (size_t d = start; d < end; d++)
+    {
+      const ElemType lower = other.bounds[d].Lo() - bounds[d].Hi();
+      const ElemType higher = bounds[d].Lo() - other.bounds[d].Hi();
+      sum += PowerTerm(std::max(std::max(lower, higher), (ElemType) 0));
+    }
+
+    if (sum >= limit)
+      break;
   }
+
+  return PowerSumToDistance(sum);
 }
 
 /**
@@ -308,37 +335,23 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType sum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (DistanceType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) DistanceType::Power);
-  }
+    AccumType sum = 0;
+    for (size_t d = 0; d < n; d++)
+    {
+      const ElemType v = std::max(std::abs(point[d] - bounds[d].Lo()),
+          std::abs(bounds[d].Hi() - point[d]));
+      sum += PowerTerm(v);
+    }
 
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return sum;
-    else if (DistanceType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) std::pow((double) sum, 1.0 /
-          (double) DistanceType::Power);
-  }
-  else
-    return sum;
+    return PowerSumToDistance(sum);
+  });
 }
 
 /**
@@ -349,38 +362,24 @@ inline ElemType HRectBound<DistanceType, ElemType>::MaxDistance(
     const HRectBound& other)
     const
 {
-  ElemType sum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v;
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (DistanceType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) DistanceType::Power);
-  }
+    AccumType sum = 0;
+    for (size_t d = 0; d < n; d++)
+    {
+      const ElemType v = std::max(
+          std::abs(other.bounds[d].Hi() - bounds[d].Lo()),
+          std::abs(bounds[d].Hi() - other.bounds[d].Lo()));
+      sum += PowerTerm(v);
+    }
 
-  // The compiler should optimize out this if statement entirely.
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return sum;
-    else if (DistanceType::Power == 2)
-      return (ElemType) std::sqrt(sum);
-    else
-      return (ElemType) std::pow((double) sum, 1.0 /
-          (double) DistanceType::Power);
-  }
-  else
-    return sum;
+    return PowerSumToDistance(sum);
+  });
 }
 
 /**
@@ -391,63 +390,29 @@ inline RangeType<ElemType>
 HRectBound<DistanceType, ElemType>::RangeDistance(
     const HRectBound& other) const
 {
-  ElemType loSum = 0;
-  ElemType hiSum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    v1 = other.bounds[d].Lo() - bounds[d].Hi();
-    v2 = bounds[d].Lo() - other.bounds[d].Hi();
-    // One of v1 or v2 is negative.
-    if (v1 >= v2)
-    {
-      vHi = -v2; // Make it nonnegative.
-      vLo = (v1 > 0) ? v1 : 0; // Force to be 0 if negative.
-    }
-    else
-    {
-      vHi = -v1; // Make it nonnegative.
-      vLo = (v2 > 0) ? v2 : 0; // Force to be 0 if negative.
-    }
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
+    AccumType loSum = 0;
+    AccumType hiSum = 0;
+    for (size_t d = 0; d < n; d++)
     {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
+      // One of v1 or v2 is negative; the gap between the bounds is the larger
+      // one (if it is positive), and the largest extent is the negation of the
+      // smaller one.
+      const ElemType v1 = other.bounds[d].Lo() - bounds[d].Hi();
+      const ElemType v2 = bounds[d].Lo() - other.bounds[d].Hi();
+      loSum += PowerTerm(std::max(std::max(v1, v2), (ElemType) 0));
+      hiSum += PowerTerm(-std::min(v1, v2));
     }
-    else if (DistanceType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
-    {
-      loSum += std::pow(vLo, (ElemType) DistanceType::Power);
-      hiSum += std::pow(vHi, (ElemType) DistanceType::Power);
-    }
-  }
 
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return RangeType<ElemType>(loSum, hiSum);
-    else if (DistanceType::Power == 2)
-      return RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                       (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return RangeType<ElemType>(
-          (ElemType) std::pow((double) loSum, 1.0 / (double) DistanceType::Power),
-          (ElemType) std::pow((double) hiSum,
-              1.0 / (double) DistanceType::Power));
-    }
-  }
-  else
-    return RangeType<ElemType>(loSum, hiSum);
+    return RangeType<ElemType>(PowerSumToDistance(loSum),
+                               PowerSumToDistance(hiSum));
+  });
 }
 
 /**
@@ -460,71 +425,30 @@ HRectBound<DistanceType, ElemType>::RangeDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType loSum = 0;
-  ElemType hiSum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  ElemType v1, v2, vLo, vHi;
-  for (size_t d = 0; d < dim; d++)
+  return DispatchFixedDimension(dim, [&](auto fixedDim)
   {
-    v1 = bounds[d].Lo() - point[d]; // Negative if point[d] > lo.
-    v2 = point[d] - bounds[d].Hi(); // Negative if point[d] < hi.
-    // One of v1 or v2 (or both) is negative.
-    if (v1 >= 0) // point[d] <= bounds_[d].Lo().
-    {
-      vHi = -v2; // v2 will be larger but must be negated.
-      vLo = v1;
-    }
-    else // point[d] is between lo and hi, or greater than hi.
-    {
-      if (v2 >= 0)
-      {
-        vHi = -v1; // v1 will be larger, but must be negated.
-        vLo = v2;
-      }
-      else
-      {
-        vHi = -std::min(v1, v2); // Both are negative, but we need the larger.
-        vLo = 0;
-      }
-    }
+    constexpr size_t D = decltype(fixedDim)::value;
+    const size_t n = (D == 0) ? dim : D;
 
-    // The compiler should optimize out this if statement entirely.
-    if (DistanceType::Power == 1)
-    {
-      loSum += vLo; // vLo is non-negative.
-      hiSum += vHi; // vHi is non-negative.
-    }
-    else if (DistanceType::Power == 2)
-    {
-      loSum += vLo * vLo;
-      hiSum += vHi * vHi;
-    }
-    else
+    AccumType loSum = 0;
+    AccumType hiSum = 0;
+    for (size_t d = 0; d < n; d++)
     {
-      loSum += std::pow(vLo, (ElemType) DistanceType::Power);
-      hiSum += std::pow(vHi, (ElemType) DistanceType::Power);
+      // v1 is negative if point[d] > lo, and v2 is negative if point[d] < hi;
+      // at most one of them is positive.  The distance to the bound in this
+      // dimension is the larger one (if it is positive), and the distance to
+      // the furthest side is the negation of the smaller one.
+      const ElemType v1 = bounds[d].Lo() - point[d];
+      const ElemType v2 = point[d] - bounds[d].Hi();
+      loSum += PowerTerm(std::max(std::max(v1, v2), (ElemType) 0));
+      hiSum += PowerTerm(-std::min(v1, v2));
     }
-  }
 
-  if (DistanceType::TakeRoot)
-  {
-    if (DistanceType::Power == 1)
-      return RangeType<ElemType>(loSum, hiSum);
-    else if (DistanceType::Power == 2)
-      return RangeType<ElemType>((ElemType) std::sqrt(loSum),
-                                 (ElemType) std::sqrt(hiSum));
-    else
-    {
-      return RangeType<ElemType>(
-          (ElemType) std::pow((double) loSum, 1.0 / (double) DistanceType::Power),
-          (ElemType) std::pow((double) hiSum,
-              1.0 / (double) DistanceType::Power));
-    }
-  }
-  else
-    return RangeType<ElemType>(loSum, hiSum);
+    return RangeType<ElemType>(PowerSumToDistance(loSum),
+                               PowerSumToDistance(hiSum));
+  });
 }
 
 /**
@@ -681,6 +605,50 @@ inline ElemType HRectBound<DistanceType, ElemType>::Diameter() const
     return d;
 }
 
+template<typename DistanceType, typename ElemType>
+inline typename HRectBound<DistanceType, ElemType>::AccumType
+HRectBound<DistanceType, ElemType>::PowerTerm(const ElemType v)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (DistanceType::Power == 1)
+    return v;
+  else if (DistanceType::Power == 2)
+    return (AccumType) v * v;
+  else
+    return std::pow((AccumType) v, (AccumType) DistanceType::Power);
+}
+
+template<typename DistanceType, typename ElemType>
+inline ElemType HRectBound<DistanceType, ElemType>::PowerSumToDistance(
+    const AccumType sum)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (DistanceType::TakeRoot)
+  {
+    if (DistanceType::Power == 1)
+      return (ElemType) sum;
+    else if (DistanceType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) std::pow((double) sum, 1.0 /
+          (double) DistanceType::Power);
+  }
+  else
+    return (ElemType) sum;
+}
+
+template<typename DistanceType, typename ElemType>
+inline typename HRectBound<DistanceType, ElemType>::AccumType
+HRectBound<DistanceType, ElemType>::DistanceToPowerSum(
+    const ElemType distance)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (DistanceType::TakeRoot)
+    return PowerTerm(distance);
+  else
+    return (AccumType) distance;
+}
+
 //! Serialize the bound object.
 template<typename DistanceType, typename ElemType>
 template<typename Archive>
@@ -688,12 +656,59 @@ void HRectBound<DistanceType, ElemType>::serialize(
     Archive& ar,
     const uint32_t /* version */)
 {
+  // The array wrapper deletes the array before loading a new one, so local
+  // storage must not be handed to it.
+  if (cereal::is_loading<Archive>())
+  {
+    Deallocate();
+    bounds = NULL;
+  }
+
   // We can't serialize a raw array directly, so wrap it.
   ar(CEREAL_POINTER_ARRAY(bounds, dim));
+
+  // Move the loaded bounds to local storage, if they fit.
+  if (cereal::is_loading<Archive>() && dim > 0 && dim <= maxFixedDimension)
+  {
+    for (size_t i = 0; i < dim; ++i)
+      localBounds[i] = bounds[i];
+    delete[] bounds;
+    bounds = localBounds;
+  }
   ar(CEREAL_NVP(minWidth));
   ar(CEREAL_NVP(distance));
 }
 
+
+template<typename DistanceType, typename ElemType>
+inline void HRectBound<DistanceType, ElemType>::Allocate(
+    const size_t dimension)
+{
+  dim = dimension;
+  if (dim == 0)
+  {
+    bounds = NULL;
+  }
+  else if (dim <= maxFixedDimension)
+  {
+    // Local storage may hold old bounds.
+    bounds = localBounds;
+    for (size_t i = 0; i < dim; ++i)
+      localBounds[i] = RangeType<ElemType>();
+  }
+  else
+  {
+    bounds = new RangeType<ElemType>[dim];
+  }
+}
+
+template<typename DistanceType, typename ElemType>
+inline void HRectBound<DistanceType, ElemType>::Deallocate()
+{
+  if (bounds && bounds != localBounds)
+    delete[] bounds;
+}
+
 } // namespace mlpack
 
 #endif // MLPACK_CORE_TREE_HRECTBOUND_IMPL_HPP
@@ -0,0 +1,130 @@
+/**
+ * @file core/tree/node_pool.hpp
+ *
+ * A simple pool that tree nodes can be allocated from, so that all of the nodes
+ * of a tree are held in a few large blocks of memory that are freed at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_POOL_HPP
+#define MLPACK_CORE_TREE_NODE_POOL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mutex>
+#include <new>
+
+namespace mlpack {
+
+/**
+ * A NodePool hands out uninitialized memory for nodes of type NodeType from
+ * large blocks (chunks), by bumping a pointer into the current chunk; when the
+ * chunk is full, a new chunk twice the size of the last one is allocated (up to
+ * a maximum).  This makes building a tree with millions of nodes much cheaper
+ * than allocating each node separately, and keeps nodes that are built one
+ * after another close to each other in memory.
+ *
+ * The nodes are never freed individually: all chunks are freed at once when the
+ * pool is destroyed.  The pool does not call the destructors of the nodes; the
+ * owner of the pool (in general the root of a tree) is responsible for that.
+ *
+ * Allocate() may be called concurrently (e.g. when the children of a node are
+ * built in parallel tasks).
+ */
+template<typename NodeType>
+class NodePool
+{
+ public:
+  /**
+   * Create an empty pool.  No memory is allocated until the first node is.
+   *
+   * @param firstChunkNodes Number of nodes that the first chunk holds.
+   * @param maxNodes Maximum number of nodes that any chunk holds.
+   */
+  NodePool(const size_t firstChunkNodes = 64, const size_t maxNodes = 4096) :
+      nextChunkNodes(std::max(firstChunkNodes, (size_t) 1)),
+      maxChunkNodes(std::max(maxNodes, nextChunkNodes)),
+      current(NULL),
+      remaining(0),
+      nodes(0)
+  { }
+
+  //! Free all of the chunks.  The destructors of the nodes are not called.
+  ~NodePool()
+  {
+    for (size_t i = 0; i < chunks.size(); ++i)
+      ::operator delete(chunks[i], std::align_val_t(alignof(NodeType)));
+  }
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  /**
+   * Get memory for one node; the node must be constructed in it with placement
+   * new.  This is thread-safe.
+   */
+  NodeType* Allocate()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (remaining == 0)
+    {
+      current = NewChunk(nextChunkNodes);
+      remaining = nextChunkNodes;
+      nextChunkNodes = std::min(2 * nextChunkNodes, maxChunkNodes);
+    }
+
+    --remaining;
+    ++nodes;
+    return current++;
+  }
+
+  /**
+   * Get memory for the given number of consecutive nodes, in a chunk of its
+   * own; the nodes must be constructed in it with placement new.  This is not
+   * thread-safe.
+   *
+   * @param n Number of nodes.
+   */
+  NodeType* AllocateBlock(const size_t n)
+  {
+    nodes += n;
+    return NewChunk(n);
+  }
+
+  //! Get the number of nodes that memory has been given out for.
+  size_t Nodes() const { return nodes; }
+  //! Get the number of chunks that have been allocated.
+  size_t Chunks() const { return chunks.size(); }
+
+ private:
+  //! Allocate a new chunk for the given number of nodes.
+  NodeType* NewChunk(const size_t n)
+  {
+    NodeType* chunk = static_cast<NodeType*>(::operator new(
+        n * sizeof(NodeType), std::align_val_t(alignof(NodeType))));
+    chunks.push_back(chunk);
+    return chunk;
+  }
+
+  //! The number of nodes of the next chunk Allocate() makes.
+  size_t nextChunkNodes;
+  //! The maximum number of nodes of a chunk made by Allocate().
+  size_t maxChunkNodes;
+  //! The next free node of the current chunk.
+  NodeType* current;
+  //! The number of free nodes left in the current chunk.
+  size_t remaining;
+  //! The number of nodes that memory has been given out for.
+  size_t nodes;
+  //! All of the chunks.
+  std::vector<NodeType*> chunks;
+  //! Lock for Allocate().
+  std::mutex mutex;
+};
+
+} // namespace mlpack
+
+#endif
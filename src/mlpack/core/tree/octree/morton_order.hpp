@@ -0,0 +1,158 @@
+/**
+ * @file core/tree/octree/morton_order.hpp
+ *
+ * Utilities to compute the Morton codes of a set of points and to sort points
+ * by their codes; these are used to build an Octree in linear time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_MORTON_ORDER_HPP
+#define MLPACK_CORE_TREE_OCTREE_MORTON_ORDER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace details {
+
+//! The largest dimensionality for which an Octree is built from Morton codes;
+//! above it, a node has too many children for codes of 64 bits to hold enough
+//! levels.
+constexpr size_t octreeMortonMaxDims = 8;
+
+//! Ranges of points smaller than this are never processed in a separate task.
+constexpr size_t octreeTaskMinSize = 20000;
+
+//! Return the number of levels of the octree that a 64-bit Morton code holds
+//! for points of the given dimensionality.
+inline size_t MortonLevels(const size_t dims)
+{
+  return std::min((size_t) 32, (size_t) 64 / dims);
+}
+
+/**
+ * Compute the Morton code of every point, in parallel.  The cube of the given
+ * width starting at lo is cut into 2^levels cells along every dimension, and
+ * the bits of the cell coordinates of a point are interleaved, most significant
+ * first; so, level l of the code (counting from 0 at the top) is the index of
+ * the child of the octree node at level l that holds the point, where bit d of
+ * the index is set if the point is on the upper side of dimension d.
+ *
+ * @param data Points to compute the codes of.
+ * @param lo Lowest corner of the cube.
+ * @param width Width of the cube.
+ * @param levels Number of levels of the codes; see MortonLevels().
+ * @param codes Vector to store the codes in.
+ */
+template<typename MatType>
+void MortonCodes(const MatType& data,
+                 const arma::vec& lo,
+                 const double width,
+                 const size_t levels,
+                 std::vector<uint64_t>& codes)
+{
+  const size_t dims = data.n_rows;
+  const double maxCell = (double) (((uint64_t) 1 << levels) - 1);
+  const double scale = (width > 0.0) ?
+      std::ldexp(1.0, (int) levels) / width : 0.0;
+
+  codes.resize(data.n_cols);
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (data.n_cols >= octreeTaskMinSize)
+  for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+  {
+    uint64_t cells[octreeMortonMaxDims];
+    for (size_t d = 0; d < dims; ++d)
+    {
+      const double x = (data(d, i) - lo[d]) * scale;
+      cells[d] = (x <= 0.0) ? 0 : (uint64_t) std::min(x, maxCell);
+    }
+
+    uint64_t code = 0;
+    for (size_t l = levels; l-- > 0; )
+      for (size_t d = dims; d-- > 0; )
+        code = (code << 1) | ((cells[d] >> l) & 1);
+
+    codes[i] = code;
+  }
+}
+
+/**
+ * Sort the given codes, and permute the given indices in the same way, with a
+ * stable least-significant-digit radix sort on bytes.  The input is cut into
+ * blocks: the digits of every block are counted in parallel, and then the
+ * blocks are scattered in parallel, so the result does not depend on the
+ * number of threads.
+ *
+ * @param codes Codes to sort.
+ * @param indices Indices to permute along with the codes.
+ * @param bits Number of low bits of the codes that may be set.
+ */
+inline void RadixSortCodes(std::vector<uint64_t>& codes,
+                           std::vector<size_t>& indices,
+                           const size_t bits)
+{
+  const size_t n = codes.size();
+  const size_t blocks = std::max((size_t) 1, std::min((size_t) 256,
+      n / octreeTaskMinSize));
+
+  std::vector<uint64_t> codesTmp(n);
+  std::vector<size_t> indicesTmp(n);
+  std::vector<size_t> offsets(256 * blocks);
+  for (size_t shift = 0; shift < bits; shift += 8)
+  {
+    std::fill(offsets.begin(), offsets.end(), 0);
+    #pragma omp parallel for num_threads(Parallel::Threads()) if (blocks > 1)
+    for (size_t b = 0; b < blocks; ++b)
+    {
+      size_t* blockCounts = offsets.data() + 256 * b;
+      for (size_t i = n * b / blocks; i < n * (b + 1) / blocks; ++i)
+        ++blockCounts[(codes[i] >> shift) & 255];
+    }
+
+    // Turn the counts into the first position of every digit of every block,
+    // ordered by digit and then by block.  If every code has the same digit,
+    // this pass would not change anything.
+    size_t total = 0;
+    bool skip = false;
+    for (size_t digit = 0; digit < 256; ++digit)
+    {
+      size_t digitCount = 0;
+      for (size_t b = 0; b < blocks; ++b)
+      {
+        const size_t count = offsets[256 * b + digit];
+        offsets[256 * b + digit] = total;
+        total += count;
+        digitCount += count;
+      }
+
+      if (digitCount == n)
+        skip = true;
+    }
+
+    if (skip)
+      continue;
+
+    #pragma omp parallel for num_threads(Parallel::Threads()) if (blocks > 1)
+    for (size_t b = 0; b < blocks; ++b)
+    {
+      size_t* blockOffsets = offsets.data() + 256 * b;
+      for (size_t i = n * b / blocks; i < n * (b + 1) / blocks; ++i)
+      {
+        const size_t position = blockOffsets[(codes[i] >> shift) & 255]++;
+        codesTmp[position] = codes[i];
+        indicesTmp[position] = indices[i];
+      }
+    }
+
+    codes.swap(codesTmp);
+    indices.swap(indicesTmp);
+  }
+}
+
+} // namespace details
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 
 namespace mlpack {
 
@@ -37,6 +38,24 @@ class Octree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser; see
+  //! frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<Octree, RuleType>;
+
+  //! A breadth-first dual-tree traverser that processes the levels of the
+  //! query tree in parallel; see frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using ParallelBreadthFirstDualTreeTraverser =
+      ParallelFrontierDualTreeTraverser<Octree, RuleType>;
+
+  //! The parallel dual-tree traverser of the octree is the parallel
+  //! breadth-first traverser.
+  template<typename RuleType>
+  using ParallelDualTreeTraverser = ParallelBreadthFirstDualTreeTraverser<
+      RuleType>;
+
  private:
   //! The children held by this node.
   std::vector<Octree*> children;
@@ -416,6 +435,66 @@ class Octree
   friend class cereal::access;
 
  private:
+  /**
+   * Construct this node as a child of the given parent, holding the given
+   * points, and build its descendants from the Morton codes of the points (see
+   * BuildRoot()).
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point of the node.
+   * @param count Number of points of the node.
+   * @param codes Morton codes of the points of the dataset, which is sorted by
+   *     them.
+   * @param level Level of this node in the codes (the root is level 0).
+   * @param levels Number of levels of the codes.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  Octree(Octree* parent,
+         const size_t begin,
+         const size_t count,
+         const std::vector<uint64_t>& codes,
+         const size_t level,
+         const size_t levels,
+         const size_t maxLeafSize);
+
+  /**
+   * Build the descendants of the root.  For datasets of few dimensions, the
+   * Morton code of every point is computed (the interleaved bits of its cell
+   * in the root's cube, so that each level of the code is the index of the
+   * child that holds the point), the points are sorted by their codes with a
+   * parallel radix sort and reordered with a single copy, and then each node is
+   * simply the range of points whose codes share a prefix.  This takes linear
+   * time, and the descendants of large nodes are built in parallel OpenMP
+   * tasks.  Every node is split at the center of its cell, and the cells of
+   * the children are the halves of the cell of the node along every dimension.
+   * The depth of the tree is limited by the length of the codes, and duplicate
+   * points always end up in the same leaf.  For more dimensions, SplitNode() is
+   * used.
+   *
+   * @param center Center of the root.
+   * @param width Width of the root.
+   * @param oldFromNew If not NULL, mappings from old to new to update.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void BuildRoot(const arma::vec& center,
+                 const double width,
+                 std::vector<size_t>* oldFromNew,
+                 const size_t maxLeafSize);
+
+  /**
+   * Split the node into the ranges of points whose Morton codes differ at the
+   * given level, once the dataset is sorted by the codes (see BuildRoot()).
+   *
+   * @param codes Morton codes of the points of the dataset.
+   * @param level Level of this node in the codes.
+   * @param levels Number of levels of the codes.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void SplitNode(const std::vector<uint64_t>& codes,
+                 const size_t level,
+                 const size_t levels,
+                 const size_t maxLeafSize);
+
   /**
    * Split the node, using the given center and the given maximum width of this
    * node.
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_OCTREE_OCTREE_IMPL_HPP
 
 #include "octree.hpp"
+#include "morton_order.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
 #include <stack>
 
@@ -41,7 +42,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(const MatType& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    BuildRoot(center, maxWidth, NULL, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -83,7 +84,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BuildRoot(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -126,7 +127,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BuildRoot(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -167,7 +168,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(MatType&& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    BuildRoot(center, maxWidth, NULL, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -209,7 +210,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BuildRoot(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -252,7 +253,7 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BuildRoot(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -339,6 +340,41 @@ Octree<DistanceType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct a child node from the Morton codes.
+template<typename DistanceType, typename StatisticType, typename MatType>
+Octree<DistanceType, StatisticType, MatType>::Octree(
+    Octree* parent,
+    const size_t begin,
+    const size_t count,
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t levels,
+    const size_t maxLeafSize) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent)
+{
+  // Calculate empirical center of data.
+  bound |= dataset->cols(begin, begin + count - 1);
+
+  // Now split the node.
+  SplitNode(codes, level, levels, maxLeafSize);
+
+  // Calculate the distance from the empirical center of this node to the
+  // empirical center of the parent.
+  arma::vec trueCenter, parentCenter;
+  bound.Center(trueCenter);
+  parent->Bound().Center(parentCenter);
+  parentDistance = distance.Evaluate(trueCenter, parentCenter);
+
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+
+  // Initialize the statistic.
+  stat = StatisticType(*this);
+}
+
 //! Copy the given tree.
 template<typename DistanceType, typename StatisticType, typename MatType>
 Octree<DistanceType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -769,6 +805,127 @@ void Octree<DistanceType, StatisticType, MatType>::serialize(
   }
 }
 
+//! Build the descendants of the root.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::BuildRoot(
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  if (count <= maxLeafSize)
+    return;
+
+  const size_t dims = dataset->n_rows;
+  if (dims > details::octreeMortonMaxDims)
+  {
+    if (oldFromNew)
+      SplitNode(center, width, *oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, width, maxLeafSize);
+    return;
+  }
+
+  // Sort the points by their Morton codes.
+  const size_t levels = details::MortonLevels(dims);
+  const arma::vec lo = center - width / 2.0;
+  std::vector<uint64_t> codes;
+  details::MortonCodes(*dataset, lo, width, levels, codes);
+
+  std::vector<size_t> order(count);
+  for (size_t i = 0; i < count; ++i)
+    order[i] = i;
+  details::RadixSortCodes(codes, order, levels * dims);
+
+  // Reorder the dataset with a single copy.
+  MatType sorted(dims, count);
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (count >= details::octreeTaskMinSize)
+  for (size_t i = 0; i < count; ++i)
+    sorted.col(i) = dataset->col(order[i]);
+  *dataset = std::move(sorted);
+
+  if (oldFromNew)
+  {
+    const std::vector<size_t> oldMappings(*oldFromNew);
+    for (size_t i = 0; i < count; ++i)
+      (*oldFromNew)[i] = oldMappings[order[i]];
+  }
+
+  // Now every node is a range of the sorted points.  The tasks of all of the
+  // descendants run in one parallel region.
+  if (count >= details::octreeTaskMinSize)
+  {
+    #pragma omp parallel num_threads(Parallel::Threads())
+    {
+      #pragma omp single
+      {
+        SplitNode(codes, 0, levels, maxLeafSize);
+      }
+    }
+  }
+  else
+  {
+    SplitNode(codes, 0, levels, maxLeafSize);
+  }
+}
+
+//! Split the node along the Morton codes.
+template<typename DistanceType, typename StatisticType, typename MatType>
+void Octree<DistanceType, StatisticType, MatType>::SplitNode(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t levels,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in this
+  // node, or if all of the points are in the same cell.
+  if (count <= maxLeafSize || level == levels ||
+      codes[begin] == codes[begin + count - 1])
+    return;
+
+  // The codes of the node share their first level digits, so the codes are
+  // sorted by the digit of this level.
+  const size_t dims = dataset->n_rows;
+  const size_t shift = (levels - 1 - level) * dims;
+  const size_t numChildren = (size_t) 1 << dims;
+  std::vector<size_t> childBegins(numChildren + 1);
+  childBegins[0] = begin;
+  childBegins[numChildren] = begin + count;
+  for (size_t c = 1; c < numChildren; ++c)
+  {
+    childBegins[c] = std::partition_point(codes.begin() + childBegins[c - 1],
+        codes.begin() + begin + count, [shift, numChildren, c](uint64_t code)
+        {
+          return ((code >> shift) & (numChildren - 1)) < c;
+        }) - codes.begin();
+  }
+
+  // The children hold disjoint ranges of points, so large children are built
+  // in separate tasks.
+  std::vector<Octree*> newChildren(numChildren, NULL);
+  for (size_t c = 0; c < numChildren; ++c)
+  {
+    // If the child has no points, don't create it.
+    const size_t childCount = childBegins[c + 1] - childBegins[c];
+    if (childCount == 0)
+      continue;
+
+    #pragma omp task if (childCount >= details::octreeTaskMinSize) \
+        shared(codes, childBegins, newChildren)
+    {
+      newChildren[c] = new Octree(this, childBegins[c], childCount, codes,
+          level + 1, levels, maxLeafSize);
+    }
+  }
+
+  #pragma omp taskwait
+
+  for (size_t c = 0; c < numChildren; ++c)
+    if (newChildren[c] != NULL)
+      children.push_back(newChildren[c]);
+}
+
 //! Split the node.
 template<typename DistanceType, typename StatisticType, typename MatType>
 void Octree<DistanceType, StatisticType, MatType>::SplitNode(
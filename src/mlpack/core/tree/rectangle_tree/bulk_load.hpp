@@ -0,0 +1,99 @@
+/**
+ * @file core/tree/rectangle_tree/bulk_load.hpp
+ *
+ * Definitions of the STRBulkLoad and HilbertBulkLoad policies, which order the
+ * points (and nodes) of a RectangleTree when it is built all at once instead of
+ * one point at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A bulk loading policy groups a set of items (points, or the centers of
+ * nodes) into a given number of nodes.  The items are given as the columns of a
+ * matrix; Order() permutes the list of column indices so that, out of n items
+ * and G groups, group j is formed by the items at positions
+ * [n * j / G, n * (j + 1) / G) of the list.  These ranges are as close to equal
+ * as possible, so every group has floor(n / G) or ceil(n / G) items.
+ *
+ * RectangleTree calls Order() once for the points, to build packed leaves, and
+ * then once for each level above, on the centers of the nodes of the level
+ * below, until only one node is left.
+ *
+ * STRBulkLoad is the Sort-Tile-Recursive algorithm of Leutenegger, Lopez and
+ * Edgington (1997): the items are cut into S = ceil(G^(1 / d)) slabs along the
+ * first dimension, each slab is cut into slabs along the second dimension, and
+ * so on, so that the groups are tiles of about the same extent in every
+ * dimension.  The cuts are made with selection instead of sorting, and the
+ * slabs are tiled in parallel with OpenMP tasks.
+ */
+class STRBulkLoad
+{
+ public:
+  /**
+   * Permute the given indices of columns of the given matrix, so that they can
+   * be cut into the given number of groups as described above.
+   *
+   * @param points Matrix whose columns are the items to group.
+   * @param indices Indices of the columns to group; this is permuted.
+   * @param numGroups Number of groups that the items will be cut into.
+   */
+  template<typename MatType>
+  static void Order(const MatType& points,
+                    std::vector<size_t>& indices,
+                    const size_t numGroups);
+
+ private:
+  /**
+   * Tile the groups [firstGroup, lastGroup) of the items, starting at the given
+   * dimension.
+   */
+  template<typename MatType>
+  static void Tile(const MatType& points,
+                   std::vector<size_t>& indices,
+                   const size_t numGroups,
+                   const size_t firstGroup,
+                   const size_t lastGroup,
+                   const size_t dim);
+};
+
+/**
+ * HilbertBulkLoad orders the items along the Hilbert curve, as computed by
+ * DiscreteHilbertValue (the curve used by the Hilbert R tree), and then cuts
+ * the curve into groups; this is the packing algorithm of Kamel and Faloutsos
+ * (1993).  Computing the Hilbert values is more expensive than tiling, but the
+ * groups follow the data more closely when it is clustered.  The Hilbert values
+ * are computed in parallel, and the curve is cut with selection in parallel.
+ */
+class HilbertBulkLoad
+{
+ public:
+  /**
+   * Permute the given indices of columns of the given matrix, so that they can
+   * be cut into the given number of groups as described above.
+   *
+   * @param points Matrix whose columns are the items to group.
+   * @param indices Indices of the columns to group; this is permuted.
+   * @param numGroups Number of groups that the items will be cut into.
+   */
+  template<typename MatType>
+  static void Order(const MatType& points,
+                    std::vector<size_t>& indices,
+                    const size_t numGroups);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "bulk_load_impl.hpp"
+
+#endif
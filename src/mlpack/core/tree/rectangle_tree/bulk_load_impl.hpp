@@ -0,0 +1,166 @@
+/**
+ * @file core/tree/rectangle_tree/bulk_load_impl.hpp
+ *
+ * Implementation of the STRBulkLoad and HilbertBulkLoad policies.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_IMPL_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_BULK_LOAD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "bulk_load.hpp"
+#include "discrete_hilbert_value.hpp"
+
+namespace mlpack {
+
+namespace details {
+
+//! Ranges of items smaller than this are never partitioned in a separate task.
+constexpr size_t bulkLoadTaskMinSize = 20000;
+
+/**
+ * Partition indices[boundaries[lo], boundaries[hi]) so that, for every k in
+ * (lo, hi), no item before position boundaries[k] compares greater than any
+ * item after it.  This is a sort that stops as soon as the boundaries are
+ * right; the two halves of every range are partitioned in separate tasks.
+ */
+template<typename CompareType>
+void PartitionAtBoundaries(std::vector<size_t>& indices,
+                           const std::vector<size_t>& boundaries,
+                           const size_t lo,
+                           const size_t hi,
+                           const CompareType& compare)
+{
+  if (hi - lo < 2)
+    return;
+
+  const size_t mid = (lo + hi) / 2;
+  std::nth_element(indices.begin() + boundaries[lo],
+      indices.begin() + boundaries[mid], indices.begin() + boundaries[hi],
+      compare);
+
+  #pragma omp task if (boundaries[hi] - boundaries[lo] >= \
+      bulkLoadTaskMinSize) shared(indices, boundaries, compare)
+  {
+    PartitionAtBoundaries(indices, boundaries, lo, mid, compare);
+  }
+
+  PartitionAtBoundaries(indices, boundaries, mid, hi, compare);
+
+  #pragma omp taskwait
+}
+
+} // namespace details
+
+template<typename MatType>
+void STRBulkLoad::Order(const MatType& points,
+                        std::vector<size_t>& indices,
+                        const size_t numGroups)
+{
+  // The tasks of all of the tiles run in this region.
+  #pragma omp parallel num_threads(Parallel::Threads()) \
+      if (indices.size() >= details::bulkLoadTaskMinSize)
+  {
+    #pragma omp single
+    {
+      Tile(points, indices, numGroups, 0, numGroups, 0);
+    }
+  }
+}
+
+template<typename MatType>
+void STRBulkLoad::Tile(const MatType& points,
+                       std::vector<size_t>& indices,
+                       const size_t numGroups,
+                       const size_t firstGroup,
+                       const size_t lastGroup,
+                       const size_t dim)
+{
+  const size_t groups = lastGroup - firstGroup;
+  if (groups < 2)
+    return;
+
+  // In the last dimension, every group is its own slab.
+  const size_t remainingDims = points.n_rows - dim;
+  const size_t slabs = (remainingDims == 1) ? groups : std::min(groups,
+      (size_t) std::ceil(std::pow((double) groups, 1.0 / remainingDims)));
+
+  // Each slab holds a whole number of groups, so its boundaries are group
+  // boundaries.
+  const size_t n = indices.size();
+  std::vector<size_t> boundaries(slabs + 1);
+  for (size_t s = 0; s <= slabs; ++s)
+    boundaries[s] = n * (firstGroup + groups * s / slabs) / numGroups;
+
+  auto compare = [&points, dim](const size_t a, const size_t b)
+  {
+    return points(dim, a) < points(dim, b);
+  };
+  details::PartitionAtBoundaries(indices, boundaries, 0, slabs, compare);
+
+  if (remainingDims == 1)
+    return;
+
+  for (size_t s = 0; s < slabs; ++s)
+  {
+    #pragma omp task if (boundaries[s + 1] - boundaries[s] >= \
+        details::bulkLoadTaskMinSize) shared(points, indices)
+    {
+      Tile(points, indices, numGroups, firstGroup + groups * s / slabs,
+          firstGroup + groups * (s + 1) / slabs, dim + 1);
+    }
+  }
+
+  #pragma omp taskwait
+}
+
+template<typename MatType>
+void HilbertBulkLoad::Order(const MatType& points,
+                            std::vector<size_t>& indices,
+                            const size_t numGroups)
+{
+  typedef DiscreteHilbertValue<typename MatType::elem_type> HilbertValue;
+  typedef typename HilbertValue::HilbertElemType HilbertElemType;
+
+  // Compute the Hilbert value of every item.
+  const size_t n = indices.size();
+  arma::Mat<HilbertElemType> values(points.n_rows, points.n_cols);
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      if (n >= details::bulkLoadTaskMinSize)
+  for (size_t i = 0; i < n; ++i)
+  {
+    values.col(indices[i]) =
+        HilbertValue::CalculateValue(points.col(indices[i]));
+  }
+
+  // Hilbert values are compared lexicographically, just like
+  // DiscreteHilbertValue::CompareValues() does.
+  const size_t dim = values.n_rows;
+  auto compare = [&values, dim](const size_t a, const size_t b)
+  {
+    return std::lexicographical_compare(values.colptr(a),
+        values.colptr(a) + dim, values.colptr(b), values.colptr(b) + dim);
+  };
+
+  std::vector<size_t> boundaries(numGroups + 1);
+  for (size_t j = 0; j <= numGroups; ++j)
+    boundaries[j] = n * j / numGroups;
+
+  #pragma omp parallel num_threads(Parallel::Threads()) \
+      if (n >= details::bulkLoadTaskMinSize)
+  {
+    #pragma omp single
+    {
+      details::PartitionAtBoundaries(indices, boundaries, 0, numGroups,
+          compare);
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -17,9 +17,13 @@
 
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include "../tree_traits.hpp"
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
+#include "x_tree_auxiliary_information.hpp"
+#include "bulk_load.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 
 namespace mlpack {
 
@@ -113,6 +117,24 @@ class RectangleTree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser; see
+  //! frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<RectangleTree, RuleType>;
+
+  //! A breadth-first dual-tree traverser that processes the levels of the
+  //! query tree in parallel; see frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using ParallelBreadthFirstDualTreeTraverser =
+      ParallelFrontierDualTreeTraverser<RectangleTree, RuleType>;
+
+  //! The parallel dual-tree traverser of rectangle type trees is the parallel
+  //! breadth-first traverser.
+  template<typename RuleType>
+  using ParallelDualTreeTraverser = ParallelBreadthFirstDualTreeTraverser<
+      RuleType>;
+
   /**
    * Construct this as the root node of a rectangle type tree using the given
    * dataset.  This will modify the ordering of the points in the dataset!
@@ -155,6 +177,62 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, by bulk loading it with the given policy (STRBulkLoad or
+   * HilbertBulkLoad) instead of inserting the points one at a time.  All of
+   * the leaves are packed with as close to maxLeafSize points as possible, and
+   * all of the other nodes with as close to maxNumChildren children as
+   * possible, so the tree is built much faster and is usually shallower, with
+   * less overlap between nodes.  The tree can still be modified afterwards with
+   * InsertPoint() and DeletePoint().
+   *
+   * Bulk loading is possible for R trees, R* trees and X trees.  The order of
+   * the points in the dataset is not modified.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading policy (only its type is used).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename BulkLoadType>
+  RectangleTree(const MatType& data,
+                const BulkLoadType& bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const typename std::enable_if_t<
+                    !std::is_arithmetic<BulkLoadType>::value>* = 0);
+
+  /**
+   * Construct this as the root node of a rectangle type tree using the given
+   * dataset, taking ownership of it, by bulk loading it with the given policy
+   * (STRBulkLoad or HilbertBulkLoad); see the constructor above.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading policy (only its type is used).
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  template<typename BulkLoadType>
+  RectangleTree(MatType&& data,
+                const BulkLoadType& bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2,
+                const typename std::enable_if_t<
+                    !std::is_arithmetic<BulkLoadType>::value>* = 0);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -567,6 +645,14 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Build the tree below this (empty) root node from all of the points of the
+   * dataset at once, grouping points and nodes with the given bulk loading
+   * policy, one level at a time from the leaves up.
+   */
+  template<typename BulkLoadType>
+  void BulkLoad();
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
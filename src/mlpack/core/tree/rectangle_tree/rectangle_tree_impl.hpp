@@ -38,6 +38,112 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+// Build the tree from all of the points at once.
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+void RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad()
+{
+  // Nodes of R+ and R++ trees must not overlap, and the nodes of Hilbert R
+  // trees hold Hilbert values that are only maintained by insertion.
+  static_assert(TreeTraits<RectangleTree>::HasOverlappingChildren,
+      "RectangleTree: bulk loading is not possible for R+ and R++ trees.");
+  static_assert(std::is_same<AuxiliaryInformation,
+      NoAuxiliaryInformation<RectangleTree>>::value ||
+      std::is_same<AuxiliaryInformation,
+      XTreeAuxiliaryInformation<RectangleTree>>::value,
+      "RectangleTree: bulk loading is not possible for Hilbert R trees.");
+
+  // Make the given node the next child of the given parent.
+  auto adopt = [](RectangleTree* node, RectangleTree* child)
+  {
+    node->children[node->numChildren++] = child;
+    child->parent = node;
+    node->bound |= child->bound;
+    node->numDescendants += child->numDescendants;
+  };
+
+  const size_t n = dataset->n_cols;
+  std::vector<size_t> indices(n);
+  for (size_t i = 0; i < n; ++i)
+    indices[i] = i;
+
+  // If all of the points fit in one leaf, the root is that leaf.
+  if (n <= maxLeafSize)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      points[count++] = i;
+      bound |= dataset->col(i);
+    }
+    numDescendants = n;
+
+    BuildStatistics(this);
+    return;
+  }
+
+  // Pack the points into as few leaves as possible.  The new nodes are
+  // created as children of the root, so that they get its parameters, and are
+  // moved to their real parents later.
+  size_t numNodes = (n + maxLeafSize - 1) / maxLeafSize;
+  BulkLoadType::Order(*dataset, indices, numNodes);
+  std::vector<RectangleTree*> level(numNodes);
+  for (size_t j = 0; j < numNodes; ++j)
+  {
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t i = n * j / numNodes; i < n * (j + 1) / numNodes; ++i)
+    {
+      leaf->points[leaf->count++] = indices[i];
+      leaf->bound |= dataset->col(indices[i]);
+    }
+    leaf->numDescendants = leaf->count;
+    level[j] = leaf;
+  }
+
+  // Now pack each level into the level above it, grouping the nodes by their
+  // centers, until the nodes of the level fit into the root.
+  arma::Col<ElemType> center;
+  while (level.size() > maxNumChildren)
+  {
+    const size_t levelSize = level.size();
+    arma::Mat<ElemType> centers(dataset->n_rows, levelSize);
+    for (size_t i = 0; i < levelSize; ++i)
+    {
+      level[i]->bound.Center(center);
+      centers.col(i) = center;
+    }
+
+    numNodes = (levelSize + maxNumChildren - 1) / maxNumChildren;
+    indices.resize(levelSize);
+    for (size_t i = 0; i < levelSize; ++i)
+      indices[i] = i;
+    BulkLoadType::Order(centers, indices, numNodes);
+
+    std::vector<RectangleTree*> nextLevel(numNodes);
+    for (size_t j = 0; j < numNodes; ++j)
+    {
+      nextLevel[j] = new RectangleTree(this);
+      for (size_t i = levelSize * j / numNodes;
+           i < levelSize * (j + 1) / numNodes; ++i)
+        adopt(nextLevel[j], level[indices[i]]);
+    }
+
+    level.swap(nextLevel);
+  }
+
+  for (size_t i = 0; i < level.size(); ++i)
+    adopt(this, level[i]);
+
+  // Initialize statistics recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
@@ -120,6 +226,80 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const BulkLoadType& /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const typename std::enable_if_t<
+                  !std::is_arithmetic<BulkLoadType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<BulkLoadType>();
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+template<typename BulkLoadType>
+RectangleTree<DistanceType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const BulkLoadType& /* bulkLoad */,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren,
+              const typename std::enable_if_t<
+                  !std::is_arithmetic<BulkLoadType>::value>*) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  BulkLoad<BulkLoadType>();
+}
+
 template<typename DistanceType,
          typename StatisticType,
          typename MatType,
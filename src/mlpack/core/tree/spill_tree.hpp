@@ -20,6 +20,8 @@
 #include "spill_tree/spill_single_tree_traverser_impl.hpp"
 #include "spill_tree/spill_dual_tree_traverser.hpp"
 #include "spill_tree/spill_dual_tree_traverser_impl.hpp"
+#include "spill_tree/spill_parallel_dual_tree_traverser.hpp"
+#include "spill_tree/spill_parallel_dual_tree_traverser_impl.hpp"
 #include "spill_tree/traits.hpp"
 #include "spill_tree/typedef.hpp"
 
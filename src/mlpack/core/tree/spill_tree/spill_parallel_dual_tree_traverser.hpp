@@ -0,0 +1,130 @@
+/**
+ * @file core/tree/spill_tree/spill_parallel_dual_tree_traverser.hpp
+ *
+ * Defines the SpillParallelDualTreeTraverser for the SpillTree tree type.  This
+ * is a nested class of SpillTree which cuts the query tree into disjoint
+ * subtrees, and traverses each of them against the reference tree with a
+ * SpillDualTreeTraverser in a separate OpenMP thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "spill_tree.hpp"
+#include "spill_dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_counters.hpp>
+
+namespace mlpack {
+
+/**
+ * A parallel dual-tree traverser for hybrid spill trees.  The query tree is cut
+ * into subtrees that hold fewer than MinTaskSize() descendant points each, and
+ * every subtree is traversed against the whole reference tree by a
+ * SpillDualTreeTraverser (with the same Defeatist setting) in a separate
+ * thread.  The query tree is never cut below a node whose children share
+ * points; NeighborSearch always builds its query trees with tau = 0, so this
+ * only matters for query trees built by the user.
+ *
+ * Each traversal starts at the reference root, so the pruning that the upper
+ * levels of the query tree would allow is repeated once per subtree; with
+ * query subtrees of at least a few hundred points, this cost is small.  The
+ * results of a non-defeatist traversal are the same as those of the
+ * DualTreeTraverser.
+ *
+ * Each thread uses its own copy of the rules, so this places the same
+ * requirements on RuleType as the ParallelDualTreeTraverser of the
+ * BinarySpaceTree: copies must share the per-query-point results but not the
+ * traversal state, the rules may only modify the query nodes, and BaseCases()
+ * and Scores() must return modifiable references.  If mlpack is compiled
+ * without OpenMP, the subtrees are traversed one after the other.
+ */
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType, bool Defeatist>
+class SpillTree<DistanceType, StatisticType, MatType, HyperplaneType,
+                SplitType>::SpillParallelDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the parallel dual-tree traverser with the given rule set.
+   *
+   * @param rule Rules to traverse with.
+   * @param minTaskSize Query nodes with at least this many descendant points
+   *     are cut into their children, if the children share no points.
+   */
+  SpillParallelDualTreeTraverser(RuleType& rule,
+                                 const size_t minTaskSize = 1000);
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(SpillTree& queryNode, SpillTree& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+  //! Get the minimum query node size at which the query tree is cut.
+  size_t MinTaskSize() const { return minTaskSize; }
+  //! Modify the minimum query node size at which the query tree is cut.
+  size_t& MinTaskSize() { return minTaskSize; }
+
+ private:
+  //! Add the roots of the disjoint query subtrees below the given node to the
+  //! given list.
+  void CutQueryTree(SpillTree& queryNode, std::vector<SpillTree*>& subtrees);
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The minimum query node size at which the query tree is cut.
+  size_t minTaskSize;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "spill_parallel_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,136 @@
+/**
+ * @file core/tree/spill_tree/spill_parallel_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the SpillParallelDualTreeTraverser for SpillTree.  This is
+ * a way to perform a dual-tree traversal of two trees with OpenMP.  The trees
+ * must be the same type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spill_parallel_dual_tree_traverser.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType, bool Defeatist>
+SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillParallelDualTreeTraverser<RuleType, Defeatist>::
+SpillParallelDualTreeTraverser(RuleType& rule, const size_t minTaskSize) :
+    rule(rule),
+    minTaskSize(minTaskSize),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType, bool Defeatist>
+void
+SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillParallelDualTreeTraverser<RuleType, Defeatist>::Traverse(
+    SpillTree& queryNode,
+    SpillTree& referenceNode)
+{
+  std::vector<SpillTree*> subtrees;
+  CutQueryTree(queryNode, subtrees);
+
+  if (subtrees.size() == 1)
+  {
+    // There is nothing to do in parallel.
+    SpillDualTreeTraverser<RuleType, Defeatist> traverser(rule);
+    traverser.Traverse(queryNode, referenceNode);
+
+    numPrunes += traverser.NumPrunes();
+    numVisited += traverser.NumVisited();
+    numScores += traverser.NumScores();
+    numBaseCases += traverser.NumBaseCases();
+    return;
+  }
+
+  // The copies share the results with the original rules, but their counters
+  // start from zero so that they can be summed afterwards.
+  std::vector<RuleType> rules(subtrees.size(), rule);
+  for (size_t i = 0; i < rules.size(); ++i)
+  {
+    rules[i].BaseCases() = 0;
+    rules[i].Scores() = 0;
+    ResetTraversalCounters(rules[i]);
+  }
+
+  size_t prunes = 0, visited = 0, scores = 0, baseCases = 0;
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      schedule(dynamic) reduction(+:prunes, visited, scores, baseCases)
+  for (size_t i = 0; i < subtrees.size(); ++i)
+  {
+    SpillDualTreeTraverser<RuleType, Defeatist> traverser(rules[i]);
+    traverser.Traverse(*subtrees[i], referenceNode);
+
+    prunes += traverser.NumPrunes();
+    visited += traverser.NumVisited();
+    scores += traverser.NumScores();
+    baseCases += traverser.NumBaseCases();
+  }
+
+  // Now collect the counts from each thread.
+  for (size_t i = 0; i < rules.size(); ++i)
+  {
+    rule.BaseCases() += rules[i].BaseCases();
+    rule.Scores() += rules[i].Scores();
+    MergeTraversalCounters(rule, rules[i]);
+  }
+
+  numPrunes += prunes;
+  numVisited += visited;
+  numScores += scores;
+  numBaseCases += baseCases;
+}
+
+template<typename DistanceType,
+         typename StatisticType,
+         typename MatType,
+         template<typename HyperplaneDistanceType> class HyperplaneType,
+         template<typename SplitDistanceType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType, bool Defeatist>
+void
+SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>::
+SpillParallelDualTreeTraverser<RuleType, Defeatist>::CutQueryTree(
+    SpillTree& queryNode,
+    std::vector<SpillTree*>& subtrees)
+{
+  // The children can only be traversed at the same time if they hold disjoint
+  // sets of points.  (Overlap() cannot tell: nodes split with tau = 0 are
+  // marked as overlapping too, even though no point was put in both children.)
+  if (queryNode.IsLeaf() || queryNode.NumDescendants() < minTaskSize ||
+      queryNode.Left()->NumDescendants() +
+      queryNode.Right()->NumDescendants() != queryNode.NumDescendants())
+  {
+    subtrees.push_back(&queryNode);
+    return;
+  }
+
+  CutQueryTree(*queryNode.Left(), subtrees);
+  CutQueryTree(*queryNode.Right(), subtrees);
+}
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_SPILL_TREE_SPILL_PARALLEL_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -127,6 +127,12 @@ class SpillTree
   template<typename RuleType, bool Defeatist = false>
   class SpillDualTreeTraverser;
 
+  //! A dual-tree traverser for hybrid spill trees which traverses disjoint
+  //! query subtrees in parallel; see spill_parallel_dual_tree_traverser.hpp
+  //! for implementation.
+  template<typename RuleType, bool Defeatist = false>
+  class SpillParallelDualTreeTraverser;
+
  public:
   //! A single-tree traverser for hybrid spill trees.
   template<typename RuleType>
@@ -144,6 +150,16 @@ class SpillTree
   template<typename RuleType>
   using DefeatistDualTreeTraverser = SpillDualTreeTraverser<RuleType, true>;
 
+  //! A parallel dual-tree traverser for hybrid spill trees.
+  template<typename RuleType>
+  using ParallelDualTreeTraverser =
+      SpillParallelDualTreeTraverser<RuleType, false>;
+
+  //! A parallel defeatist dual-tree traverser for hybrid spill trees.
+  template<typename RuleType>
+  using DefeatistParallelDualTreeTraverser =
+      SpillParallelDualTreeTraverser<RuleType, true>;
+
   /**
    * Construct this as the root node of a hybrid spill tree using the given
    * dataset.  The dataset will not be modified during the building procedure
@@ -153,11 +169,14 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param tauDecay Factor the overlapping size is multiplied by at each level
+   *     below this node; see SplitNode().
    */
   SpillTree(const MatType& data,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double tauDecay = 1.0);
 
   /**
    * Construct this as the root node of a hybrid spill tree using the given
@@ -169,11 +188,14 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param tauDecay Factor the overlapping size is multiplied by at each level
+   *     below this node; see SplitNode().
    */
   SpillTree(MatType&& data,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double tauDecay = 1.0);
 
   /**
    * Construct this node as a child of the given parent, including the given
@@ -185,12 +207,15 @@ class SpillTree
    * @param tau Overlapping size.
    * @param maxLeafSize Size of each leaf in the tree.
    * @param rho Balance threshold.
+   * @param tauDecay Factor the overlapping size is multiplied by at each level
+   *     below this node; see SplitNode().
    */
   SpillTree(SpillTree* parent,
             arma::Col<size_t>& points,
             const double tau = 0,
             const size_t maxLeafSize = 20,
-            const double rho = 0.7);
+            const double rho = 0.7,
+            const double tauDecay = 1.0);
 
   /**
    * Create a hybrid spill tree by copying the other tree.  Be careful!  This
@@ -443,16 +468,23 @@ class SpillTree
  private:
   /**
    * Splits the current node, assigning its left and right children recursively.
+   * The children are split with an overlapping size of tau * tauDecay, so the
+   * nodes at depth l below the root use tau * tauDecay^l.  With tauDecay = 1,
+   * every level uses the same overlapping size; with tauDecay < 1, the deeper
+   * levels (which hold most of the nodes) duplicate fewer points, trading
+   * accuracy of defeatist search for memory.
    *
    * @param points Vector of indexes of points to be included in this node.
    * @param maxLeafSize Maximum number of points held in a leaf.
    * @param tau Overlapping size.
    * @param rho Balance threshold.
+   * @param tauDecay Factor the overlapping size is multiplied by at each level.
    */
   void SplitNode(arma::Col<size_t>& points,
                  const size_t maxLeafSize,
                  const double tau,
-                 const double rho);
+                 const double rho,
+                 const double tauDecay);
 
   /**
    * Split the list of points.
@@ -29,7 +29,8 @@ SpillTree(
     const MatType& data,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double tauDecay) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -49,7 +50,7 @@ SpillTree(
         dataset->n_cols);
 
   // Do the actual splitting of this node.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, tauDecay);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -66,7 +67,8 @@ SpillTree(
     MatType&& data,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double tauDecay) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -86,7 +88,7 @@ SpillTree(
         dataset->n_cols);
 
   // Do the actual splitting of this node.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, tauDecay);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -104,7 +106,8 @@ SpillTree(
     arma::Col<size_t>& points,
     const double tau,
     const size_t maxLeafSize,
-    const double rho) :
+    const double rho,
+    const double tauDecay) :
     left(NULL),
     right(NULL),
     parent(parent),
@@ -117,7 +120,7 @@ SpillTree(
     localDataset(false)
 {
   // Perform the actual splitting.
-  SplitNode(points, maxLeafSize, tau, rho);
+  SplitNode(points, maxLeafSize, tau, rho, tauDecay);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -719,7 +722,8 @@ void SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>:
     SplitNode(arma::Col<size_t>& points,
               const size_t maxLeafSize,
               const double tau,
-              const double rho)
+              const double rho,
+              const double tauDecay)
 {
   // We need to expand the bounds of this node properly.
   for (size_t i = 0; i < points.n_elem; ++i)
@@ -766,8 +770,11 @@ void SpillTree<DistanceType, StatisticType, MatType, HyperplaneType, SplitType>:
 
   // Now we will recursively split the children by calling their constructors
   // (which perform this splitting process).
-  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
-  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  const double childTau = tau * tauDecay;
+  left = new SpillTree(this, leftPoints, childTau, maxLeafSize, rho,
+      tauDecay);
+  right = new SpillTree(this, rightPoints, childTau, maxLeafSize, rho,
+      tauDecay);
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -0,0 +1,37 @@
+/**
+ * @file core/tree/split_traits.hpp
+ *
+ * A class for template metaprogramming traits for the split types used by
+ * BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+
+/**
+ * A class to obtain compile-time traits about SplitType classes.  If you are
+ * writing your own SplitType class, you should make a template specialization
+ * in order to set the values correctly.
+ *
+ * @see TreeTraits, BoundTraits
+ */
+template<typename SplitType>
+struct SplitTraits
+{
+  //! If true, then the split of a node depends only on the points held in that
+  //! node: the split is deterministic, and it holds no state that is shared
+  //! between nodes.  This means that sibling subtrees can be split in parallel,
+  //! and the resulting tree is exactly the same as the one built serially.
+  //! This defaults to false.
+  static const bool IsParallelSafe = false;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * @file core/tree/traversal_counters.hpp
+ *
+ * Policies that collect statistics about tree traversals: the default
+ * NullTraversalCounters records nothing, and TraversalCounters records how
+ * many nodes are visited and pruned at each depth of the reference tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_COUNTERS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_COUNTERS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <numeric>
+#include <type_traits>
+
+namespace mlpack {
+
+/**
+ * A traversal counters policy is given to the rules of a tree-based algorithm
+ * (and to the algorithm itself, e.g. NeighborSearch), and the rules tell it
+ * about every score they compute.  NullTraversalCounters is the default policy:
+ * it records nothing, and since every method is an empty inline function, the
+ * rules compile to exactly the same code as without any counters.
+ */
+class NullTraversalCounters
+{
+ public:
+  //! Record the score of a query point and a reference node; the score is
+  //! returned.
+  template<typename TreeType>
+  double Score(const TreeType& /* referenceNode */, const double score)
+  {
+    return score;
+  }
+
+  //! Record the score of a query node and a reference node; the score is
+  //! returned.
+  template<typename TreeType>
+  double Score(const TreeType& /* queryNode */,
+               const TreeType& /* referenceNode */,
+               const double score)
+  {
+    return score;
+  }
+
+  //! Record a rescore of a reference node; the new score is returned.
+  template<typename TreeType>
+  double Rescore(const TreeType& /* referenceNode */,
+                 const double /* oldScore */,
+                 const double newScore)
+  {
+    return newScore;
+  }
+
+  //! Record that the bound of a query point was tightened.
+  void BoundUpdate() { }
+
+  //! Record that the given number of query points are searched for.
+  void AddQueries(const size_t /* queries */) { }
+
+  //! Add the counts of another set of counters.
+  void Merge(const NullTraversalCounters& /* other */) { }
+
+  //! Forget all counts.
+  void Reset() { }
+};
+
+/**
+ * TraversalCounters records statistics that are useful to tune the leaf size,
+ * tree type, and approximation level of a tree-based algorithm:
+ *
+ *  - the number of reference nodes that were visited (scored) and the number
+ *    that were pruned, at each depth of the reference tree; a node that is
+ *    first scored and later pruned by a rescore counts as both;
+ *  - the number of leaf pairs (or, for single-tree scores, query point and
+ *    reference leaf pairs) that were not pruned, and so had their base cases
+ *    computed;
+ *  - the number of times the bound of a query point was tightened (e.g., a
+ *    new nearest neighbor candidate was found);
+ *  - the number of nodes visited per query point, a rough proxy for the cache
+ *    misses of the traversal.
+ *
+ * The depth of a node is found by following its parents, so recording is not
+ * free; use the counters for tuning, not in production searches.
+ *
+ * @code
+ * RangeSearch<EuclideanDistance, arma::mat, KDTree, TraversalCounters>
+ *     rs(referenceSet);
+ * rs.Search(querySet, range, neighbors, distances);
+ * for (size_t d = 0; d < rs.Counters().Visits().size(); ++d)
+ *   std::cout << "depth " << d << ": " << rs.Counters().PruneRate(d) << "\n";
+ * @endcode
+ */
+class TraversalCounters
+{
+ public:
+  //! Create the counters with every count set to zero.
+  TraversalCounters() : leafPairs(0), boundUpdates(0), queries(0) { }
+
+  //! Record the score of a query point and a reference node; the score is
+  //! returned.
+  template<typename TreeType>
+  double Score(const TreeType& referenceNode, const double score)
+  {
+    const size_t depth = Visit(referenceNode);
+    if (score == DBL_MAX)
+      ++prunes[depth];
+    else if (referenceNode.IsLeaf())
+      ++leafPairs;
+
+    return score;
+  }
+
+  //! Record the score of a query node and a reference node; the score is
+  //! returned.
+  template<typename TreeType>
+  double Score(const TreeType& queryNode,
+               const TreeType& referenceNode,
+               const double score)
+  {
+    const size_t depth = Visit(referenceNode);
+    if (score == DBL_MAX)
+      ++prunes[depth];
+    else if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+      ++leafPairs;
+
+    return score;
+  }
+
+  //! Record a rescore of a reference node; the new score is returned.
+  template<typename TreeType>
+  double Rescore(const TreeType& referenceNode,
+                 const double oldScore,
+                 const double newScore)
+  {
+    if (newScore == DBL_MAX && oldScore != DBL_MAX)
+    {
+      const size_t depth = Depth(referenceNode);
+      if (depth >= prunes.size())
+      {
+        visits.resize(depth + 1, 0);
+        prunes.resize(depth + 1, 0);
+      }
+      ++prunes[depth];
+    }
+
+    return newScore;
+  }
+
+  //! Record that the bound of a query point was tightened.
+  void BoundUpdate() { ++boundUpdates; }
+
+  //! Record that the given number of query points are searched for.
+  void AddQueries(const size_t queries) { this->queries += queries; }
+
+  //! Add the counts of another set of counters.
+  void Merge(const TraversalCounters& other)
+  {
+    if (other.visits.size() > visits.size())
+    {
+      visits.resize(other.visits.size(), 0);
+      prunes.resize(other.prunes.size(), 0);
+    }
+
+    for (size_t d = 0; d < other.visits.size(); ++d)
+    {
+      visits[d] += other.visits[d];
+      prunes[d] += other.prunes[d];
+    }
+
+    leafPairs += other.leafPairs;
+    boundUpdates += other.boundUpdates;
+    queries += other.queries;
+  }
+
+  //! Forget all counts.
+  void Reset()
+  {
+    visits.clear();
+    prunes.clear();
+    leafPairs = 0;
+    boundUpdates = 0;
+    queries = 0;
+  }
+
+  //! Get the number of nodes visited at each depth (the root has depth 0).
+  const std::vector<size_t>& Visits() const { return visits; }
+  //! Get the number of nodes pruned at each depth (the root has depth 0).
+  const std::vector<size_t>& Prunes() const { return prunes; }
+
+  //! Get the fraction of visited nodes at the given depth that were pruned.
+  double PruneRate(const size_t depth) const
+  {
+    if (depth >= visits.size() || visits[depth] == 0)
+      return 0.0;
+    return double(prunes[depth]) / double(visits[depth]);
+  }
+
+  //! Get the number of leaf pairs whose base cases were computed.
+  size_t LeafPairs() const { return leafPairs; }
+  //! Get the number of times the bound of a query point was tightened.
+  size_t BoundUpdates() const { return boundUpdates; }
+  //! Get the number of query points that were searched for.
+  size_t Queries() const { return queries; }
+
+  //! Get the total number of nodes visited, over all depths.
+  size_t TotalVisits() const
+  {
+    return std::accumulate(visits.begin(), visits.end(), size_t(0));
+  }
+
+  //! Get the average number of nodes visited per query point.
+  double NodesPerQuery() const
+  {
+    return (queries == 0) ? 0.0 : double(TotalVisits()) / double(queries);
+  }
+
+ private:
+  //! Count a visit of the given node and return its depth.
+  template<typename TreeType>
+  size_t Visit(const TreeType& node)
+  {
+    const size_t depth = Depth(node);
+    if (depth >= visits.size())
+    {
+      visits.resize(depth + 1, 0);
+      prunes.resize(depth + 1, 0);
+    }
+
+    ++visits[depth];
+    return depth;
+  }
+
+  //! Get the depth of a node in its tree.
+  template<typename TreeType>
+  static size_t Depth(const TreeType& node)
+  {
+    size_t depth = 0;
+    for (const TreeType* n = node.Parent(); n != NULL; n = n->Parent())
+      ++depth;
+    return depth;
+  }
+
+  //! The number of nodes visited at each depth.
+  std::vector<size_t> visits;
+  //! The number of nodes pruned at each depth.
+  std::vector<size_t> prunes;
+  //! The number of leaf pairs whose base cases were computed.
+  size_t leafPairs;
+  //! The number of times the bound of a query point was tightened.
+  size_t boundUpdates;
+  //! The number of query points that were searched for.
+  size_t queries;
+};
+
+/**
+ * Utility struct to determine whether a RuleType has a Counters() method that
+ * returns its traversal counters.
+ */
+template<typename RuleType, typename = void>
+struct HasTraversalCounters : std::false_type { };
+
+template<typename RuleType>
+struct HasTraversalCounters<RuleType,
+    std::void_t<decltype(std::declval<RuleType&>().Counters())>> :
+    std::true_type { };
+
+/**
+ * Reset the traversal counters of a copy of the rules, so that its counts can
+ * be merged into the original rules with MergeTraversalCounters() later.  This
+ * does nothing if the rules have no counters.
+ */
+template<typename RuleType>
+void ResetTraversalCounters(
+    RuleType& rule,
+    const typename std::enable_if_t<HasTraversalCounters<RuleType>::value>* = 0)
+{
+  rule.Counters().Reset();
+}
+
+template<typename RuleType>
+void ResetTraversalCounters(
+    RuleType& /* rule */,
+    const typename std::enable_if_t<!HasTraversalCounters<RuleType>::value>* =
+        0)
+{
+  // Nothing to do.
+}
+
+/**
+ * Add the traversal counters of one set of rules to those of another.  This
+ * does nothing if the rules have no counters.
+ */
+template<typename RuleType>
+void MergeTraversalCounters(
+    RuleType& rule,
+    const RuleType& other,
+    const typename std::enable_if_t<HasTraversalCounters<RuleType>::value>* = 0)
+{
+  rule.Counters().Merge(other.Counters());
+}
+
+template<typename RuleType>
+void MergeTraversalCounters(
+    RuleType& /* rule */,
+    const RuleType& /* other */,
+    const typename std::enable_if_t<!HasTraversalCounters<RuleType>::value>* =
+        0)
+{
+  // Nothing to do.
+}
+
+} // namespace mlpack
+
+#endif
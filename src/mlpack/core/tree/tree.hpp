@@ -28,5 +28,7 @@
 #include "statistic.hpp"
 #include "traversal_info.hpp"
 #include "greedy_single_tree_traverser.hpp"
+#include "beam_single_tree_traverser.hpp"
+#include "frontier_dual_tree_traverser.hpp"
 
 #endif
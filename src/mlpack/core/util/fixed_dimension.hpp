@@ -0,0 +1,67 @@
+/**
+ * @file core/util/fixed_dimension.hpp
+ *
+ * Utility to run a loop over the dimensions of low-dimensional data with a
+ * dimensionality that is known at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_FIXED_DIMENSION_HPP
+#define MLPACK_CORE_UTIL_FIXED_DIMENSION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace mlpack {
+
+//! The largest dimensionality that DispatchFixedDimension() specializes for.
+constexpr size_t maxFixedDimension = 3;
+
+/**
+ * Call `f` with a `std::integral_constant<size_t, D>`, where D is the given
+ * dimensionality if it is between 1 and maxFixedDimension, and 0 otherwise.
+ * `f` is usually a generic lambda that loops over `D` dimensions when D is not
+ * 0, and over `dim` dimensions otherwise; since the length of the loop is then
+ * a compile-time constant for low-dimensional data (such as 2-D or 3-D
+ * geospatial data), the compiler can fully unroll it.
+ *
+ * @code
+ * return DispatchFixedDimension(dim, [&](auto fixedDim)
+ * {
+ *   constexpr size_t D = decltype(fixedDim)::value;
+ *   const size_t n = (D == 0) ? dim : D;
+ *
+ *   double sum = 0.0;
+ *   for (size_t d = 0; d < n; ++d)
+ *     sum += a[d] * b[d];
+ *   return sum;
+ * });
+ * @endcode
+ *
+ * @param dim Dimensionality of the data.
+ * @param f Function to call.
+ * @return The result of `f`.
+ */
+template<typename FunctionType>
+inline auto DispatchFixedDimension(const size_t dim, FunctionType&& f)
+    -> decltype(f(std::integral_constant<size_t, 0>()))
+{
+  switch (dim)
+  {
+    case 1:
+      return f(std::integral_constant<size_t, 1>());
+    case 2:
+      return f(std::integral_constant<size_t, 2>());
+    case 3:
+      return f(std::integral_constant<size_t, 3>());
+    default:
+      return f(std::integral_constant<size_t, 0>());
+  }
+}
+
+} // namespace mlpack
+
+#endif
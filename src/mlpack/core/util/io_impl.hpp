@@ -192,23 +192,36 @@ inline util::Timers& IO::GetTimers()
  */
 inline util::Params IO::Parameters(const std::string& bindingName)
 {
-  // We don't need a mutex here, because we are only randomly accessing elements
-  // of the maps.
-  std::map<char, std::string> resultAliases =
-      GetSingleton().aliases[bindingName];
-  // Merge in any persistent parameters (e.g. parameters in the "" binding map).
-  std::map<char, std::string> persistentAliases = GetSingleton().aliases[""];
-  resultAliases.insert(persistentAliases.begin(), persistentAliases.end());
+  // We don't need a mutex here, because we only read from the maps; find() is
+  // used instead of operator[], which would insert missing bindings, so that
+  // this can be called from several threads at once.
+  const IO& io = GetSingleton();
+  std::map<char, std::string> resultAliases;
+  std::map<std::string, util::ParamData> resultParams;
+
+  // Merge in any persistent parameters (e.g. parameters in the "" binding map)
+  // after the binding's own; insert() does not overwrite them.
+  for (const std::string& name : { bindingName, std::string("") })
+  {
+    const auto aliases = io.aliases.find(name);
+    if (aliases != io.aliases.end())
+      resultAliases.insert(aliases->second.begin(), aliases->second.end());
+
+    const auto parameters = io.parameters.find(name);
+    if (parameters != io.parameters.end())
+    {
+      resultParams.insert(parameters->second.begin(),
+          parameters->second.end());
+    }
+  }
 
-  std::map<std::string, util::ParamData> resultParams =
-      GetSingleton().parameters[bindingName];
-  // Merge in any persistent parameters (e.g. parameters in the "" binding map).
-  std::map<std::string, util::ParamData> persistentParams =
-      GetSingleton().parameters[""];
-  resultParams.insert(persistentParams.begin(), persistentParams.end());
+  const auto doc = io.docs.find(bindingName);
+  const util::BindingDetails emptyDoc;
 
-  return util::Params(resultAliases, resultParams, GetSingleton().functionMap,
-      bindingName, GetSingleton().docs[bindingName]);
+  // The maps we just built can be moved into the Params object.
+  return util::Params(std::move(resultAliases), std::move(resultParams),
+      GetSingleton().functionMap, bindingName,
+      (doc == io.docs.end()) ? emptyDoc : doc->second);
 }
 
 } // namespace mlpack
@@ -0,0 +1,106 @@
+/**
+ * @file core/util/parallel.hpp
+ *
+ * Control of the number of threads that mlpack's parallel regions use.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARALLEL_HPP
+#define MLPACK_CORE_UTIL_PARALLEL_HPP
+
+#include <mlpack/base.hpp>
+
+#ifdef MLPACK_USE_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * Parallel controls how many threads mlpack's parallel regions use.  mlpack
+ * parallelizes with OpenMP, so every thread count set here is the OpenMP
+ * thread count of the calling thread: it is used by every parallel region
+ * started from that thread, and by every buffer sized for one (i.e., with
+ * omp_get_max_threads()), but does not affect other threads.
+ *
+ * Parallel regions are nesting-aware: inside a parallel region, Threads() is 1,
+ * so that e.g. a RandomForest trained inside a parallel loop over
+ * cross-validation folds runs serially instead of oversubscribing the cores.
+ * mlpack's own parallel regions pass Threads() as their `num_threads` clause.
+ *
+ * To use a different number of threads for one call only, use a ParallelScope:
+ *
+ * @code
+ * Parallel::SetThreads(8); // Use 8 threads from now on.
+ * {
+ *   ParallelScope scope(2); // Use only 2 threads for this forest.
+ *   RandomForest<> rf(data, labels, numClasses);
+ * }
+ * @endcode
+ *
+ * Note that the thread count does not control the threads of the BLAS library
+ * that Armadillo uses; OpenMP builds of OpenBLAS and MKL run serially inside
+ * mlpack's parallel regions, but other builds must be configured separately.
+ * When mlpack is compiled without OpenMP, everything runs on one thread.
+ */
+class Parallel
+{
+ public:
+  /**
+   * Get the number of threads that a parallel region started here would use.
+   * This is 1 inside a parallel region.
+   */
+  static size_t Threads();
+
+  /**
+   * Get the number of threads that are used if no number has been set; this
+   * is given by the OMP_NUM_THREADS environment variable, or else is the
+   * number of cores.
+   */
+  static size_t DefaultThreads();
+
+  /**
+   * Set the number of threads that parallel regions started from the calling
+   * thread use.  Giving 0 restores the default.
+   *
+   * @param threads Number of threads.
+   */
+  static void SetThreads(const size_t threads);
+};
+
+/**
+ * ParallelScope sets the number of threads of the calling thread while it
+ * exists, and restores the previous number when it is destroyed.
+ */
+class ParallelScope
+{
+ public:
+  /**
+   * Set the number of threads until the scope is destroyed.  Giving 0 keeps
+   * the current number.
+   *
+   * @param threads Number of threads.
+   */
+  ParallelScope(const size_t threads);
+
+  //! Restore the previous number of threads.
+  ~ParallelScope();
+
+  ParallelScope(const ParallelScope&) = delete;
+  ParallelScope& operator=(const ParallelScope&) = delete;
+
+ private:
+  //! The number of threads before the scope was created, or 0 if it was not
+  //! changed.
+  size_t previous;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_impl.hpp"
+
+#endif
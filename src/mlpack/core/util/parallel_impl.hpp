@@ -0,0 +1,75 @@
+/**
+ * @file core/util/parallel_impl.hpp
+ *
+ * Implementation of Parallel and ParallelScope.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARALLEL_IMPL_HPP
+#define MLPACK_CORE_UTIL_PARALLEL_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel.hpp"
+
+namespace mlpack {
+
+inline size_t Parallel::Threads()
+{
+  #ifdef MLPACK_USE_OPENMP
+    if (omp_in_parallel())
+      return 1;
+
+    // Make sure the default is known before anything can change it.
+    DefaultThreads();
+    return (size_t) omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+}
+
+inline size_t Parallel::DefaultThreads()
+{
+  #ifdef MLPACK_USE_OPENMP
+    // This is read the first time any thread count is needed, which is before
+    // SetThreads() can have been called.
+    static const size_t defaultThreads = (size_t) omp_get_max_threads();
+    return defaultThreads;
+  #else
+    return 1;
+  #endif
+}
+
+inline void Parallel::SetThreads(const size_t threads)
+{
+  #ifdef MLPACK_USE_OPENMP
+    omp_set_num_threads((int) (threads == 0 ? DefaultThreads() : threads));
+  #else
+    (void) threads;
+  #endif
+}
+
+inline ParallelScope::ParallelScope(const size_t threads) :
+    previous(0)
+{
+  if (threads == 0)
+    return;
+
+  #ifdef MLPACK_USE_OPENMP
+    Parallel::DefaultThreads();
+    previous = (size_t) omp_get_max_threads();
+  #endif
+  Parallel::SetThreads(threads);
+}
+
+inline ParallelScope::~ParallelScope()
+{
+  if (previous != 0)
+    Parallel::SetThreads(previous);
+}
+
+} // namespace mlpack
+
+#endif
@@ -33,10 +33,11 @@ class Params
 
   /**
    * Create a new Params class.  In general this should only be called via
-   * `IO::Parameters()`.
+   * `IO::Parameters()`.  The aliases and parameters are taken by value, so
+   * that callers can move them in.
    */
-  Params(const std::map<char, std::string>& aliases,
-         const std::map<std::string, ParamData>& parameters,
+  Params(std::map<char, std::string> aliases,
+         std::map<std::string, ParamData> parameters,
          FunctionMapType& functionMap,
          const std::string& bindingName,
          const BindingDetails& doc);
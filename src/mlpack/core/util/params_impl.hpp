@@ -22,14 +22,14 @@
 namespace mlpack {
 namespace util {
 
-inline Params::Params(const std::map<char, std::string>& aliases,
-                      const std::map<std::string, ParamData>& parameters,
+inline Params::Params(std::map<char, std::string> aliases,
+                      std::map<std::string, ParamData> parameters,
                       Params::FunctionMapType& functionMap,
                       const std::string& bindingName,
                       const BindingDetails& doc) :
     // Copy all the given inputs.
-    aliases(aliases),
-    parameters(parameters),
+    aliases(std::move(aliases)),
+    parameters(std::move(parameters)),
     functionMap(functionMap),
     bindingName(bindingName),
     doc(doc)
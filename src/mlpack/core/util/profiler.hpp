@@ -0,0 +1,271 @@
+/**
+ * @file core/util/profiler.hpp
+ *
+ * A low-overhead profiler for instrumenting hot code: timers are registered
+ * once and then referred to by integer IDs, nested scopes form a call tree, and
+ * every thread accumulates its own timings without locking.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_HPP
+#define MLPACK_CORE_UTIL_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The Profiler records how long instrumented scopes of code take.  Unlike
+ * Timers, which look timers up by name (and lock) on every start and stop, the
+ * Profiler is meant for code that runs many times, like the construction of a
+ * tree or the iterations of a training loop:
+ *
+ *  - each timer is registered once with Register(), and afterwards referred to
+ *    by the integer ID that Register() returns;
+ *  - scopes that are entered while another scope is open become its children,
+ *    so the timings form a call tree;
+ *  - every thread records into its own call tree, so entering and leaving a
+ *    scope never locks, and only allocates the first time a scope is entered
+ *    from a given parent.
+ *
+ * The call trees of all threads are merged by WriteJSON(), and with
+ * RecordEvents() set, every scope is also recorded individually so that
+ * WriteChromeTrace() can write a timeline for chrome://tracing or Perfetto.
+ *
+ * Most code should use the MLPACK_PROFILE_SCOPE() macro, which records to the
+ * global profiler:
+ *
+ * @code
+ * util::Profiler::Global().Enabled() = true;
+ * {
+ *   MLPACK_PROFILE_SCOPE("my_loop");
+ *   for (size_t i = 0; i < n; ++i)
+ *   {
+ *     MLPACK_PROFILE_SCOPE("my_loop_iteration");
+ *     ...
+ *   }
+ * }
+ * util::Profiler::Global().WriteJSON(std::cout);
+ * @endcode
+ *
+ * Profiling is disabled by default; while it is disabled, a scope costs one
+ * atomic load.  Reset(), WriteJSON(), and WriteChromeTrace() read the timings
+ * of every thread, so they must not be called while any scope is open.
+ */
+class Profiler
+{
+ public:
+  //! The clock that scopes are timed with.
+  typedef std::chrono::steady_clock Clock;
+
+  //! Create an empty, disabled profiler.
+  Profiler();
+
+  //! Get the profiler that MLPACK_PROFILE_SCOPE() records to.
+  static Profiler& Global();
+
+  /**
+   * Register a timer and return its ID.  Registering a name that is already
+   * registered returns the same ID.  This locks, so it should be done once and
+   * not in the code that is being timed.
+   *
+   * @param name Name of the timer.
+   */
+  size_t Register(const std::string& name);
+
+  //! Get the name of the timer with the given ID.
+  std::string Name(const size_t id) const;
+
+  //! Get whether scopes are recorded.
+  bool Enabled() const { return enabled; }
+  //! Modify whether scopes are recorded.
+  std::atomic<bool>& Enabled() { return enabled; }
+
+  //! Get whether every scope is recorded individually for WriteChromeTrace().
+  bool RecordEvents() const { return recordEvents; }
+  //! Modify whether every scope is recorded individually for
+  //! WriteChromeTrace().  (This takes memory for every scope that is run.)
+  std::atomic<bool>& RecordEvents() { return recordEvents; }
+
+  /**
+   * Enter a scope of the given timer on the calling thread; it becomes a child
+   * of the scope the thread is in.  Every call must be matched by a call to
+   * Leave() on the same thread.  This is done whether or not the profiler is
+   * enabled; ProfileScope checks that.
+   *
+   * @param id ID of the timer, as returned by Register().
+   */
+  void Enter(const size_t id);
+
+  //! Leave the innermost scope of the calling thread, adding the time since it
+  //! was entered to its timer.
+  void Leave();
+
+  //! Forget all timings (but not the registered timers).
+  void Reset();
+
+  /**
+   * Write the call tree of all timings, merged over all threads, as JSON.  For
+   * every scope the number of times it was run, the number of threads it was
+   * run on, and the total time it took (in microseconds) are given.
+   */
+  void WriteJSON(std::ostream& stream) const;
+
+  /**
+   * Write every scope that was recorded while RecordEvents() was set in the
+   * Chrome trace event format, with one track for each thread.
+   */
+  void WriteChromeTrace(std::ostream& stream) const;
+
+ private:
+  //! A scope in the call tree of one thread.
+  struct Node
+  {
+    //! ID of the timer.
+    size_t id;
+    //! Indices of the children of the node.
+    std::vector<size_t> children;
+    //! Total time spent in the scope.
+    Clock::duration total;
+    //! Number of times the scope was run.
+    size_t count;
+  };
+
+  //! One run of a scope, for the Chrome trace.
+  struct Event
+  {
+    //! ID of the timer.
+    size_t id;
+    //! Time the scope was entered.
+    Clock::time_point start;
+    //! Time the scope took.
+    Clock::duration duration;
+  };
+
+  //! Everything one thread records.
+  struct ThreadData
+  {
+    //! Index of the thread, in the order threads first recorded something.
+    size_t index;
+    //! The call tree; the first node is the root, which is not a timer.
+    std::vector<Node> nodes;
+    //! Indices of the nodes of the open scopes.
+    std::vector<size_t> stack;
+    //! The times the open scopes were entered.
+    std::vector<Clock::time_point> starts;
+    //! The recorded runs of scopes.
+    std::vector<Event> events;
+  };
+
+  //! A node of the call tree merged over all threads.
+  struct MergedNode
+  {
+    size_t id;
+    Clock::duration total;
+    size_t count;
+    size_t threads;
+    std::vector<MergedNode> children;
+  };
+
+  //! Get the data of the calling thread, creating it if needed.
+  ThreadData& LocalData();
+
+  //! Merge the subtree of the given node of one thread into a merged node.
+  static void Merge(const ThreadData& thread,
+                    const size_t node,
+                    MergedNode& merged);
+
+  //! Write the children of a merged node as a JSON array.
+  void WriteChildren(std::ostream& stream,
+                     const MergedNode& merged,
+                     const size_t indent) const;
+
+  //! Write a string as a JSON string.
+  static void WriteString(std::ostream& stream, const std::string& str);
+
+  //! A unique number for this profiler, used to cache each thread's data.
+  size_t uid;
+  //! Whether scopes are recorded.
+  std::atomic<bool> enabled;
+  //! Whether every scope is recorded individually.
+  std::atomic<bool> recordEvents;
+  //! The time the profiler was created; times in the trace are relative to it.
+  Clock::time_point epoch;
+
+  //! Protects the registered timers and the list of threads.
+  mutable std::mutex mutex;
+  //! Names of the registered timers.
+  std::vector<std::string> names;
+  //! IDs of the registered timers.
+  std::unordered_map<std::string, size_t> ids;
+  //! The data of each thread that has recorded something.
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadData>> threads;
+};
+
+/**
+ * ProfileScope enters a scope of a Profiler timer when it is created and leaves
+ * it when it is destroyed, if the profiler was enabled when it was created.
+ */
+class ProfileScope
+{
+ public:
+  /**
+   * Enter a scope of the given timer.
+   *
+   * @param id ID of the timer, as returned by Profiler::Register().
+   * @param profiler Profiler to record to.
+   */
+  ProfileScope(const size_t id, Profiler& profiler = Profiler::Global()) :
+      profiler(profiler.Enabled() ? &profiler : NULL)
+  {
+    if (this->profiler)
+      this->profiler->Enter(id);
+  }
+
+  //! Leave the scope.
+  ~ProfileScope()
+  {
+    if (profiler)
+      profiler->Leave();
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  //! The profiler to leave the scope of, or NULL if nothing was entered.
+  Profiler* profiler;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#define MLPACK_PROFILE_CONCAT_INNER(a, b) a ## b
+#define MLPACK_PROFILE_CONCAT(a, b) MLPACK_PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Time the rest of the enclosing scope with the global profiler's timer of the
+ * given name.  The timer is registered the first time this is run.
+ */
+#define MLPACK_PROFILE_SCOPE(name) \
+    static const size_t MLPACK_PROFILE_CONCAT(mlpackProfileId, __LINE__) = \
+        mlpack::util::Profiler::Global().Register(name); \
+    mlpack::util::ProfileScope MLPACK_PROFILE_CONCAT(mlpackProfileScope, \
+        __LINE__)(MLPACK_PROFILE_CONCAT(mlpackProfileId, __LINE__))
+
+// Include implementation.
+#include "profiler_impl.hpp"
+
+#endif
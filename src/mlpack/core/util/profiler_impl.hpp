@@ -0,0 +1,265 @@
+/**
+ * @file core/util/profiler_impl.hpp
+ *
+ * Implementation of the Profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PROFILER_IMPL_HPP
+#define MLPACK_CORE_UTIL_PROFILER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "profiler.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace mlpack {
+namespace util {
+
+inline Profiler::Profiler() :
+    enabled(false),
+    recordEvents(false),
+    epoch(Clock::now())
+{
+  // Profilers are never given the same number, so the thread-local cache in
+  // LocalData() can't mistake a new profiler for a destroyed one.
+  static std::atomic<size_t> profilers(0);
+  uid = ++profilers;
+}
+
+inline Profiler& Profiler::Global()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+inline size_t Profiler::Register(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unordered_map<std::string, size_t>::const_iterator it = ids.find(name);
+  if (it != ids.end())
+    return it->second;
+
+  ids[name] = names.size();
+  names.push_back(name);
+  return names.size() - 1;
+}
+
+inline std::string Profiler::Name(const size_t id) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (id >= names.size())
+  {
+    std::ostringstream oss;
+    oss << "Profiler::Name(): no timer with ID " << id << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  return names[id];
+}
+
+inline void Profiler::Enter(const size_t id)
+{
+  ThreadData& thread = LocalData();
+  const size_t current = thread.stack.empty() ? 0 : thread.stack.back();
+
+  // Find the node of the timer among the children of the current scope.
+  size_t child = thread.nodes.size();
+  for (const size_t c : thread.nodes[current].children)
+  {
+    if (thread.nodes[c].id == id)
+    {
+      child = c;
+      break;
+    }
+  }
+
+  if (child == thread.nodes.size())
+  {
+    thread.nodes.push_back(Node{ id, std::vector<size_t>(),
+        Clock::duration::zero(), 0 });
+    thread.nodes[current].children.push_back(child);
+  }
+
+  thread.stack.push_back(child);
+  thread.starts.push_back(Clock::now());
+}
+
+inline void Profiler::Leave()
+{
+  const Clock::time_point end = Clock::now();
+  ThreadData& thread = LocalData();
+  // This can only happen if Reset() was called while the scope was open.
+  if (thread.stack.empty())
+    return;
+
+  Node& node = thread.nodes[thread.stack.back()];
+  const Clock::duration duration = end - thread.starts.back();
+  node.total += duration;
+  ++node.count;
+  if (recordEvents.load(std::memory_order_relaxed))
+    thread.events.push_back(Event{ node.id, thread.starts.back(), duration });
+
+  thread.stack.pop_back();
+  thread.starts.pop_back();
+}
+
+inline void Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto& it : threads)
+  {
+    ThreadData& thread = *it.second;
+    thread.nodes.resize(1);
+    thread.nodes[0].children.clear();
+    thread.stack.clear();
+    thread.starts.clear();
+    thread.events.clear();
+  }
+}
+
+inline void Profiler::WriteJSON(std::ostream& stream) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  MergedNode root{ 0, Clock::duration::zero(), 0, 0,
+      std::vector<MergedNode>() };
+  // Merge the threads in the order they started recording, so the output does
+  // not depend on the order of the hash map.
+  std::vector<const ThreadData*> ordered(threads.size());
+  for (const auto& it : threads)
+    ordered[it.second->index] = it.second.get();
+  for (const ThreadData* thread : ordered)
+    Merge(*thread, 0, root);
+
+  stream << "{" << std::endl << "  \"timers\": ";
+  WriteChildren(stream, root, 2);
+  stream << std::endl << "}" << std::endl;
+}
+
+inline void Profiler::WriteChromeTrace(std::ostream& stream) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  stream << "{\"traceEvents\": [";
+  bool first = true;
+  for (const auto& it : threads)
+  {
+    const ThreadData& thread = *it.second;
+    for (const Event& event : thread.events)
+    {
+      const double start = std::chrono::duration<double, std::micro>(
+          event.start - epoch).count();
+      const double duration = std::chrono::duration<double, std::micro>(
+          event.duration).count();
+
+      stream << (first ? "" : ",") << std::endl << "  {\"name\": ";
+      WriteString(stream, names[event.id]);
+      stream << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << thread.index
+          << ", \"ts\": " << std::fixed << std::setprecision(3) << start
+          << ", \"dur\": " << duration << std::defaultfloat << "}";
+      first = false;
+    }
+  }
+  stream << std::endl << "]}" << std::endl;
+}
+
+inline Profiler::ThreadData& Profiler::LocalData()
+{
+  // Cache the data of the profiler this thread used last, so that only the
+  // first use of a profiler on each thread locks.
+  thread_local size_t cachedUid = 0;
+  thread_local ThreadData* cachedData = NULL;
+  if (cachedUid == uid)
+    return *cachedData;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<ThreadData>& data = threads[std::this_thread::get_id()];
+  if (!data)
+  {
+    data.reset(new ThreadData());
+    data->index = threads.size() - 1;
+    data->nodes.push_back(Node{ size_t(-1), std::vector<size_t>(),
+        Clock::duration::zero(), 0 });
+  }
+
+  cachedUid = uid;
+  cachedData = data.get();
+  return *data;
+}
+
+inline void Profiler::Merge(const ThreadData& thread,
+                            const size_t node,
+                            MergedNode& merged)
+{
+  for (const size_t c : thread.nodes[node].children)
+  {
+    const Node& child = thread.nodes[c];
+    size_t m = 0;
+    while (m < merged.children.size() && merged.children[m].id != child.id)
+      ++m;
+    if (m == merged.children.size())
+    {
+      merged.children.push_back(MergedNode{ child.id, Clock::duration::zero(),
+          0, 0, std::vector<MergedNode>() });
+    }
+
+    MergedNode& mergedChild = merged.children[m];
+    mergedChild.total += child.total;
+    mergedChild.count += child.count;
+    ++mergedChild.threads;
+    Merge(thread, c, mergedChild);
+  }
+}
+
+inline void Profiler::WriteChildren(std::ostream& stream,
+                                    const MergedNode& merged,
+                                    const size_t indent) const
+{
+  if (merged.children.empty())
+  {
+    stream << "[]";
+    return;
+  }
+
+  const std::string prefix(indent, ' ');
+  stream << "[";
+  for (size_t i = 0; i < merged.children.size(); ++i)
+  {
+    const MergedNode& child = merged.children[i];
+    stream << (i == 0 ? "" : ",") << std::endl << prefix << "  {"
+        << std::endl << prefix << "    \"name\": ";
+    WriteString(stream, names[child.id]);
+    stream << "," << std::endl << prefix << "    \"count\": " << child.count
+        << "," << std::endl << prefix << "    \"threads\": " << child.threads
+        << "," << std::endl << prefix << "    \"total_us\": " << std::fixed
+        << std::setprecision(3) << std::chrono::duration<double, std::micro>(
+        child.total).count() << std::defaultfloat << "," << std::endl
+        << prefix << "    \"children\": ";
+    WriteChildren(stream, child, indent + 4);
+    stream << std::endl << prefix << "  }";
+  }
+  stream << std::endl << prefix << "]";
+}
+
+inline void Profiler::WriteString(std::ostream& stream, const std::string& str)
+{
+  stream << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      stream << '\\';
+    stream << c;
+  }
+  stream << '"';
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -40,6 +40,7 @@ namespace mlpack {
   using arma::sqrt;
   using arma::square;
   using arma::sum;
+  using arma::tanh;
   using arma::trans;
   using arma::vectorise;
   using arma::zeros;
@@ -69,6 +70,7 @@ namespace mlpack {
   using coot::sqrt;
   using coot::square;
   using coot::sum;
+  using coot::tanh;
   using coot::trans;
   using coot::vectorise;
   using coot::zeros;
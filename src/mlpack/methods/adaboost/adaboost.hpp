@@ -268,6 +268,10 @@ class AdaBoost
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  //! The number of points that are classified by all weak learners together
+  //! in the batch Classify() functions.
+  static constexpr size_t ClassifyBlockSize = 1024;
+
   /**
    * Internal utility training function.  `wl` is not used if
    * `UseExistingWeakLearner` is false.  `weakLearnerArgs` are not used if
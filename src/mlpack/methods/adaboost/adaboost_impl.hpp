@@ -191,22 +191,30 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  // Classify the points in blocks: each block is classified by every weak
+  // learner while it is still in cache, and blocks are handled in parallel.
+  const size_t numBlocks = (test.n_cols + ClassifyBlockSize - 1) /
+      ClassifyBlockSize;
+  #pragma omp parallel for
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    wl[i].Classify(test, predictedLabels);
+    const size_t begin = b * ClassifyBlockSize;
+    const size_t end = std::min(begin + ClassifyBlockSize,
+        (size_t) test.n_cols);
+    const MatType block = test.cols(begin, end - 1);
 
-    for (size_t j = 0; j < predictedLabels.n_cols; ++j)
-      probabilities(predictedLabels(j), j) += alpha[i];
+    arma::Row<size_t> blockLabels;
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      wl[i].Classify(block, blockLabels);
+      for (size_t j = 0; j < blockLabels.n_elem; ++j)
+        probabilities(blockLabels[j], begin + j) += alpha[i];
+    }
   }
 
-  arma::uword maxIndex = 0;
-
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= accu(probabilities.col(i));
-    probabilities.col(i).max(maxIndex);
-    predictedLabels(i) = maxIndex;
-  }
+  probabilities.each_row() /= sum(probabilities, 0);
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      index_max(probabilities, 0));
 }
 
 /**
@@ -347,13 +355,6 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
   // To be used for prediction by the weak learner.
   arma::Row<size_t> predictedLabels(labels.n_cols);
 
-  // Use tempData to modify input data for incorporating weights.
-  MatType tempData(data);
-
-  // This matrix is a helper matrix used to calculate the final hypothesis.
-  MatType sumFinalH(numClasses, predictedLabels.n_cols);
-  sumFinalH.zeros();
-
   // Load the initial weights into a 2-D matrix.
   const ElemType initWeight = 1.0 / ElemType(data.n_cols * numClasses);
   MatType D(numClasses, data.n_cols);
@@ -362,9 +363,6 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
   // Weights are stored in this row vector.
   arma::Row<ElemType> weights(predictedLabels.n_cols);
 
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
-
   // Now, start the boosting rounds.
   for (size_t i = 0; i < maxIterations; ++i)
   {
@@ -386,18 +384,15 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     WeakLearnerType w = WeakLearnerTrainer<
         UseExistingWeakLearner, MatType, arma::Row<ElemType>, WeakLearnerType,
         WeakLearnerArgs...
-    >::Train(tempData, labels, numClasses, weights, other, weakLearnerArgs...);
+    >::Train(data, labels, numClasses, weights, other, weakLearnerArgs...);
 
-    w.Classify(tempData, predictedLabels);
+    w.Classify(data, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
-    {
-      if (predictedLabels(j) == labels(j))
-        rt += accu(D.col(j));
-      else
-        rt -= accu(D.col(j));
-    }
+    // Now, calculate alpha(t) using ht.  The weight of each point is the sum
+    // of its column of D.
+    #pragma omp parallel for reduction(+:rt)
+    for (size_t j = 0; j < D.n_cols; ++j)
+      rt += (predictedLabels(j) == labels(j)) ? weights(j) : -weights(j);
 
     if ((i > 0) && (std::abs(rt - crt) < tolerance))
       break;
@@ -420,41 +415,18 @@ typename MatType::elem_type AdaBoost<WeakLearnerType, MatType>::TrainInternal(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
+    // Now start modifying the weights, and calculate zt, the normalization
+    // constant.
+    const ElemType expo = std::exp(alphat);
+    #pragma omp parallel for reduction(+:zt)
     for (size_t j = 0; j < D.n_cols; ++j)
     {
-      const ElemType expo = std::exp(alphat);
       if (predictedLabels(j) == labels(j))
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) /= expo;
-          zt += D(k, j); // * exp(-1 * alphat * yt(j,k) * ht(j,k));
-
-          // Add to the final hypothesis matrix.
-          // sumFinalH(k, j) += (alphat * ht(k, j));
-          if (k == labels(j))
-            sumFinalH(k, j) += (alphat); // * ht(k, j));
-          else
-            sumFinalH(k, j) -= (alphat);
-        }
-      }
+        D.col(j) /= expo;
       else
-      {
-        for (size_t k = 0; k < D.n_rows; ++k)
-        {
-          // We calculate zt, the normalization constant.
-          D(k, j) *= expo;
-          zt += D(k, j);
-
-          // Add to the final hypothesis matrix.
-          if (k == labels(j))
-            sumFinalH(k, j) += alphat; // * ht(k, j));
-          else
-            sumFinalH(k, j) -= alphat;
-        }
-      }
+        D.col(j) *= expo;
+
+      zt += accu(D.col(j));
     }
 
     // Normalize D.
@@ -0,0 +1,247 @@
+/**
+ * @file methods/amf/termination_policies/sampled_residue_termination.hpp
+ *
+ * Termination policy used in AMF (Alternating Matrix Factorization) that
+ * estimates the residue from a fixed random sample of the entries of V.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_TERMINATION_POLICIES_SAMPLED_RESIDUE_TERMINATION_HPP
+#define MLPACK_METHODS_AMF_TERMINATION_POLICIES_SAMPLED_RESIDUE_TERMINATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/math/quantile.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements a termination policy that estimates the residue of the
+ * factorization from a random sample of the entries of V, instead of computing
+ * W * H over the whole matrix.  The sample is drawn once, in Initialize(), and
+ * the same entries are used in every iteration; for dense V every entry can be
+ * sampled, and for sparse V only the nonzero entries are sampled.  Each check
+ * then costs O(sampleSize * r) instead of a full matrix multiplication.
+ *
+ * The residue is the RMSE of W * H at the sampled entries.  Since the same
+ * entries are used in each iteration, the decrease of the squared error can be
+ * estimated with a paired confidence interval: the factorization is considered
+ * converged when, with the given confidence, the relative decrease of the mean
+ * squared error over the whole matrix is below the tolerance.  The
+ * factorization is also stopped after the given number of iterations.
+ *
+ * @code
+ * // Estimate the residue from 5000 entries of V.
+ * SampledResidueTermination<arma::sp_mat> srt(1e-5, 10000, 5000);
+ * AMF<SampledResidueTermination<arma::sp_mat>> amf(srt);
+ * amf.Apply(V, r, W, H);
+ * @endcode
+ *
+ * @see AMF
+ *
+ * @tparam MatType Type of the matrix being factorized (dense or sparse).
+ * @tparam WHMatType Type of the W and H matrices.
+ */
+template<typename MatType, typename WHMatType = arma::mat>
+class SampledResidueTermination
+{
+ public:
+  /**
+   * Construct the SampledResidueTermination object.  0 indicates no iteration
+   * limit.
+   *
+   * @param tolerance Relative decrease of the residue below which the
+   *     factorization is considered converged.
+   * @param maxIterations Maximum number of iterations.
+   * @param sampleSize Number of entries of V to estimate the residue with.
+   * @param confidence Confidence (in (0, 1)) with which the decrease of the
+   *     residue must be below the tolerance.
+   */
+  SampledResidueTermination(const double tolerance = 1e-5,
+                            const size_t maxIterations = 10000,
+                            const size_t sampleSize = 10000,
+                            const double confidence = 0.95) :
+      tolerance(tolerance),
+      maxIterations(maxIterations),
+      sampleSize(sampleSize),
+      confidence(confidence),
+      residue(DBL_MAX),
+      iteration(0)
+  {
+    if (sampleSize == 0)
+    {
+      throw std::invalid_argument("SampledResidueTermination: sampleSize "
+          "must be positive!");
+    }
+
+    if (confidence <= 0.0 || confidence >= 1.0)
+    {
+      std::ostringstream oss;
+      oss << "SampledResidueTermination: confidence must be in (0, 1), but "
+          << "it is " << confidence << "!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  /**
+   * Initializes the termination policy before starting the factorization, and
+   * draws the sample of entries (with replacement).
+   *
+   * @param V Input matrix to be factorized.
+   */
+  void Initialize(const MatType& V)
+  {
+    residue = DBL_MAX;
+    iteration = 0;
+    squaredErrors.reset();
+
+    rows.set_size(sampleSize);
+    cols.set_size(sampleSize);
+    values.set_size(sampleSize);
+    Sample(V);
+  }
+
+  /**
+   * Check if termination criterion is met.
+   *
+   * @param W Basis matrix of output.
+   * @param H Encoding matrix of output.
+   */
+  bool IsConverged(WHMatType& W, WHMatType& H)
+  {
+    arma::vec newSquaredErrors(rows.n_elem);
+    #pragma omp parallel for num_threads(Parallel::Threads())
+    for (size_t i = 0; i < rows.n_elem; ++i)
+    {
+      const double error = values[i] - arma::dot(W.row(rows[i]),
+          H.col(cols[i]));
+      newSquaredErrors[i] = error * error;
+    }
+
+    bool converged = false;
+    const double meanSquaredError = arma::mean(newSquaredErrors);
+    if (squaredErrors.n_elem > 0)
+    {
+      // Compute an upper confidence bound on the decrease of the mean squared
+      // error.
+      const arma::vec decrease = squaredErrors - newSquaredErrors;
+      const double oldMeanSquaredError = arma::mean(squaredErrors);
+      const double bound = arma::mean(decrease) + Quantile(confidence) *
+          arma::stddev(decrease) / std::sqrt((double) decrease.n_elem);
+
+      converged = (oldMeanSquaredError == 0.0) ||
+          (bound < tolerance * oldMeanSquaredError);
+    }
+
+    squaredErrors = std::move(newSquaredErrors);
+    residue = std::sqrt(meanSquaredError);
+
+    // Increment iteration count.
+    iteration++;
+    Log::Info << "Iteration " << iteration << "; sampled residue " << residue
+        << ".\n";
+
+    // If maxIterations == 0, there is no iteration limit.
+    return (converged || iteration == maxIterations);
+  }
+
+  //! Get the current estimate of the residue (RMSE at the sampled entries).
+  const double& Index() const { return residue; }
+
+  //! Get current iteration count.
+  const size_t& Iteration() const { return iteration; }
+
+  //! Access upper limit of iteration count.
+  const size_t& MaxIterations() const { return maxIterations; }
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Access tolerance value.
+  const double& Tolerance() const { return tolerance; }
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of sampled entries.  To change it, create a new object.
+  size_t SampleSize() const { return sampleSize; }
+
+  //! Get the confidence of the stopping decision.
+  double Confidence() const { return confidence; }
+
+ private:
+  /**
+   * Draw the sample from every entry of a dense matrix.
+   */
+  template<typename VMatType = MatType>
+  void Sample(const VMatType& V,
+              const typename std::enable_if_t<
+                  !arma::is_arma_sparse_type<VMatType>::value>* = 0)
+  {
+    if (V.n_elem == 0)
+    {
+      throw std::invalid_argument("SampledResidueTermination::Initialize(): "
+          "matrix is empty!");
+    }
+
+    for (size_t i = 0; i < sampleSize; ++i)
+    {
+      const size_t index = RandInt(V.n_elem);
+      rows[i] = index % V.n_rows;
+      cols[i] = index / V.n_rows;
+      values[i] = V[index];
+    }
+  }
+
+  /**
+   * Draw the sample from the nonzero entries of a sparse matrix.
+   */
+  template<typename VMatType = MatType>
+  void Sample(const VMatType& V,
+              const typename std::enable_if_t<
+                  arma::is_arma_sparse_type<VMatType>::value>* = 0)
+  {
+    V.sync();
+    if (V.n_nonzero == 0)
+    {
+      throw std::invalid_argument("SampledResidueTermination::Initialize(): "
+          "matrix has no nonzero entries!");
+    }
+
+    for (size_t i = 0; i < sampleSize; ++i)
+    {
+      // Find the column of the nonzero entry with a binary search.
+      const size_t index = RandInt(V.n_nonzero);
+      rows[i] = V.row_indices[index];
+      cols[i] = std::upper_bound(V.col_ptrs, V.col_ptrs + V.n_cols + 1,
+          index) - V.col_ptrs - 1;
+      values[i] = V.values[index];
+    }
+  }
+
+  //! Locally-stored tolerance.
+  double tolerance;
+  //! Locally-stored iteration threshold.
+  size_t maxIterations;
+  //! Number of sampled entries.
+  size_t sampleSize;
+  //! Confidence of the stopping decision.
+  double confidence;
+
+  //! Rows of the sampled entries.
+  arma::Col<size_t> rows;
+  //! Columns of the sampled entries.
+  arma::Col<size_t> cols;
+  //! Values of the sampled entries.
+  arma::vec values;
+
+  //! Squared errors at the sampled entries in the last iteration.
+  arma::vec squaredErrors;
+  //! Current estimate of the residue.
+  double residue;
+  //! Current iteration count.
+  size_t iteration;
+}; // class SampledResidueTermination
+
+} // namespace mlpack
+
+#endif
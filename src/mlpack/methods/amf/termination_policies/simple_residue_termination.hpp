@@ -78,6 +78,7 @@ class SimpleResidueTermination
     // Calculate the norm and compute the residue, but do it by hand, so as to
     // avoid calculating (W*H), which may be very large.
     double norm = 0.0;
+    #pragma omp parallel for reduction(+:norm)
     for (size_t j = 0; j < H.n_cols; ++j)
       norm += arma::norm(W * H.col(j), "fro");
     residue = fabs(normOld - norm) / normOld;
@@ -15,6 +15,7 @@
 #include "complete_incremental_termination.hpp"
 #include "incomplete_incremental_termination.hpp"
 #include "max_iteration_termination.hpp"
+#include "sampled_residue_termination.hpp"
 #include "simple_residue_termination.hpp"
 #include "simple_tolerance_termination.hpp"
 #include "validation_rmse_termination.hpp"
@@ -113,9 +113,7 @@ class ValidationRMSETermination
    */
   bool IsConverged(WHMatType& W, WHMatType& H)
   {
-    WHMatType WH = W * H;
-
-    // compute validation RMSE
+    // compute validation RMSE; W * H is only needed at the validation points
     if (iteration != 0)
     {
       rmseOld = rmse;
@@ -125,7 +123,7 @@ class ValidationRMSETermination
         size_t t_row = testPoints(i, 0);
         size_t t_col = testPoints(i, 1);
         double t_val = testPoints(i, 2);
-        double temp = (t_val - WH(t_row, t_col));
+        double temp = (t_val - arma::dot(W.row(t_row), H.col(t_col)));
         temp *= temp;
         rmse += temp;
       }
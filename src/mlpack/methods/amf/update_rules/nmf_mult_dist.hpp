@@ -70,8 +70,8 @@ class NMFMultiplicativeDistanceUpdate
                              WHMatType& W,
                              const WHMatType& H)
   {
-    WHMatType zz = W * H * H.t();
-    W = (W % (V * H.t())) / (W * H * H.t() + 1e-15);
+    // W H is never formed, so this is efficient for sparse V too.
+    W = (W % (V * H.t())) / (W * (H * H.t()) + 1e-15);
   }
 
   /**
@@ -93,8 +93,7 @@ class NMFMultiplicativeDistanceUpdate
                              const WHMatType& W,
                              WHMatType& H)
   {
-    WHMatType zz = W.t() * W * H;
-    H = (H % (W.t() * V)) / (W.t() * W * H + 1e-15);
+    H = (H % (W.t() * V)) / ((W.t() * W) * H + 1e-15);
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
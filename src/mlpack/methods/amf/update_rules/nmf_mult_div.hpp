@@ -40,9 +40,10 @@ namespace mlpack {
  * is non-increasing between subsequent iterations. Both of the update rules
  * for W and H are defined in this file.
  *
- * This set of update rules is not meant to work with sparse matrices.  Using
- * sparse matrices often causes NaNs in the output, so other choices of update
- * rules are better in that situation.
+ * When V is sparse, the quotient V / (W H) is only computed at the nonzero
+ * elements of V (where the other elements are zero), so W H is never formed;
+ * each update then takes O(nnz(V) r + (m + n) r) time and memory, and is
+ * parallelized over the rows of W and the columns of H with OpenMP.
  */
 class NMFMultiplicativeDivergenceUpdate
 {
@@ -85,6 +86,37 @@ class NMFMultiplicativeDivergenceUpdate
         (repmat(sum(H, 1).t(), W.n_rows, 1) + 1e-15);
   }
 
+  /**
+   * The update rule for the basis matrix W, for sparse V (see the other
+   * overload).
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename eT, typename WHMatType>
+  inline static void WUpdate(const arma::SpMat<eT>& V,
+                             WHMatType& W,
+                             const WHMatType& H)
+  {
+    typedef typename WHMatType::elem_type ElemType;
+
+    // The transpose of the quotient holds the quotients of each row of V in a
+    // column, so that each row of W can be updated independently.
+    const arma::SpMat<eT> quotient = SparseQuotient(V, W, H).t();
+    const arma::Col<ElemType> hSums = sum(H, 1) + 1e-15;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t i = 0; i < quotient.n_cols; ++i)
+    {
+      arma::Col<ElemType> numerator(H.n_rows, arma::fill::zeros);
+      for (size_t k = quotient.col_ptrs[i]; k < quotient.col_ptrs[i + 1]; ++k)
+        numerator += quotient.values[k] * H.col(quotient.row_indices[k]);
+
+      W.row(i) %= (numerator / hSums).t();
+    }
+  }
+
   /**
    * The update rule for the encoding matrix H. The formula used is
    *
@@ -110,9 +142,71 @@ class NMFMultiplicativeDivergenceUpdate
         (repmat(sum(W, 0).t(), 1, H.n_cols) + 1e-15);
   }
 
+  /**
+   * The update rule for the encoding matrix H, for sparse V (see the other
+   * overload).
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to updated.
+   */
+  template<typename eT, typename WHMatType>
+  inline static void HUpdate(const arma::SpMat<eT>& V,
+                             const WHMatType& W,
+                             WHMatType& H)
+  {
+    typedef typename WHMatType::elem_type ElemType;
+
+    const arma::SpMat<eT> quotient = SparseQuotient(V, W, H);
+    const WHMatType wt = W.t();
+    const arma::Col<ElemType> wSums = sum(W, 0).t() + 1e-15;
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t j = 0; j < quotient.n_cols; ++j)
+    {
+      arma::Col<ElemType> numerator(W.n_cols, arma::fill::zeros);
+      for (size_t k = quotient.col_ptrs[j]; k < quotient.col_ptrs[j + 1]; ++k)
+        numerator += quotient.values[k] * wt.col(quotient.row_indices[k]);
+
+      H.col(j) %= numerator / wSums;
+    }
+  }
+
   //! Serialize the object (in this case, there is nothing to serialize).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
+
+ private:
+  /**
+   * Compute V / (W H) at the nonzero elements of V only.  The result has the
+   * same sparsity pattern as V.
+   *
+   * @param V Sparse input matrix.
+   * @param W Basis matrix.
+   * @param H Encoding matrix.
+   */
+  template<typename eT, typename WHMatType>
+  static arma::SpMat<eT> SparseQuotient(const arma::SpMat<eT>& V,
+                                        const WHMatType& W,
+                                        const WHMatType& H)
+  {
+    V.sync();
+    const WHMatType wt = W.t();
+    arma::Col<eT> values(V.n_nonzero);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t j = 0; j < V.n_cols; ++j)
+    {
+      for (size_t k = V.col_ptrs[j]; k < V.col_ptrs[j + 1]; ++k)
+      {
+        values[k] = V.values[k] /
+            (arma::dot(wt.col(V.row_indices[k]), H.col(j)) + 1e-15);
+      }
+    }
+
+    return arma::SpMat<eT>(arma::uvec(V.row_indices, V.n_nonzero),
+        arma::uvec(V.col_ptrs, V.n_cols + 1), values, V.n_rows, V.n_cols);
+  }
 };
 
 } // namespace mlpack
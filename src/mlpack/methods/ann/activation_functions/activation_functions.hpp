@@ -33,6 +33,12 @@
 
 #include "elish_function.hpp"
 #include "elliot_function.hpp"
+#include "fast_gelu_function.hpp"
+#include "fast_logistic_function.hpp"
+#include "fast_math.hpp"
+#include "fast_mish_function.hpp"
+#include "fast_swish_function.hpp"
+#include "fast_tanh_function.hpp"
 #include "gaussian_function.hpp"
 #include "gelu_function.hpp"
 #include "hard_sigmoid_function.hpp"
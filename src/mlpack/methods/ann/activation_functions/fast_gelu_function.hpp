@@ -0,0 +1,104 @@
+/**
+ * @file methods/ann/activation_functions/fast_gelu_function.hpp
+ *
+ * Definition and implementation of a fast approximation of the Gaussian Error
+ * Linear Unit (GELU) function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_GELU_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_GELU_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_math.hpp"
+
+namespace mlpack {
+
+/**
+ * A fast approximation of the GELU function (see `GELUFunction`), computed
+ * with `FastTanh()`:
+ *
+ * @f{eqnarray*}{
+ * u(x) &=& (2/pi)^(1/2) * (x + 0.044715 * x^3) \\
+ * f(x) &=& 0.5 * x * (1 + tanh(u(x))) \\
+ * f'(x) &=& 0.5 * (1 + tanh(u(x))) +
+ *           0.5 * x * (1 - tanh^2(u(x))) * u'(x)
+ * @f}
+ *
+ * The error of f(x) is below 1e-6 * |x|.  The matrix overloads only accept
+ * dense matrices.
+ */
+class FastGELUFunction
+{
+ public:
+  /**
+   * Computes the GELU function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  template<typename eT>
+  static eT Fn(const eT x)
+  {
+    return eT(0.5) * x * (1 + FastTanh(U(x)));
+  }
+
+  /**
+   * Computes the GELU function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, y, [](const eT v) { return Fn(v); });
+  }
+
+  /**
+   * Computes the first derivative of the GELU function.
+   *
+   * @param x Input data.
+   * @return f'(x).
+   */
+  template<typename eT>
+  static eT Deriv(const eT x, const eT /* y */)
+  {
+    const eT t = FastTanh(U(x));
+    return eT(0.5) * (1 + t) + eT(0.5) * x * (1 - t * t) *
+        (eT(0.7978845608) + eT(0.1070322243) * x * x);
+  }
+
+  /**
+   * Computes the first derivatives of the GELU function.
+   *
+   * @param x Input activations.
+   * @param * (y) The resulting activations.
+   * @param dy The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType, typename DerivVecType>
+  static void Deriv(const InputVecType& x,
+                    const OutputVecType& /* y */,
+                    DerivVecType& dy)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, dy, [](const eT v) { return Deriv(v, v); });
+  }
+
+ private:
+  //! Compute the argument of the tanh.
+  template<typename eT>
+  static eT U(const eT x)
+  {
+    return eT(0.7978845608) * (x + eT(0.044715) * x * x * x);
+  }
+}; // class FastGELUFunction
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file methods/ann/activation_functions/fast_logistic_function.hpp
+ *
+ * Definition and implementation of a fast approximation of the logistic
+ * function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_LOGISTIC_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_LOGISTIC_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_math.hpp"
+#include "logistic_function.hpp"
+
+namespace mlpack {
+
+/**
+ * A fast approximation of the logistic function (see `LogisticFunction`),
+ * computed with `FastExp()`:
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& \frac{1}{1 + e^{-x}} \\
+ * f'(x) &=& f(x) * (1 - f(x))
+ * @f}
+ *
+ * The relative error of f(x) is below 3e-7.  The matrix overloads only accept
+ * dense matrices.
+ */
+class FastLogisticFunction
+{
+ public:
+  /**
+   * Computes the logistic function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  template<typename eT>
+  static eT Fn(const eT x)
+  {
+    return 1 / (1 + FastExp(-x));
+  }
+
+  /**
+   * Computes the logistic function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, y, [](const eT v) { return Fn(v); });
+  }
+
+  /**
+   * Computes the first derivative of the logistic function.
+   *
+   * @param x Input activation.
+   * @param y Result of Fn(x).
+   * @return f'(x)
+   */
+  static double Deriv(const double x, const double y)
+  {
+    return LogisticFunction::Deriv(x, y);
+  }
+
+  /**
+   * Computes the first derivatives of the logistic function.
+   *
+   * @param x Input activation.
+   * @param y Result of Fn(x).
+   * @param dy The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType, typename DerivVecType>
+  static void Deriv(const InputVecType& x,
+                    const OutputVecType& y,
+                    DerivVecType& dy)
+  {
+    LogisticFunction::Deriv(x, y, dy);
+  }
+
+  /**
+   * Computes the inverse of the logistic function.
+   *
+   * @param y Input data.
+   * @return f^{-1}(y)
+   */
+  static double Inv(const double y) { return LogisticFunction::Inv(y); }
+
+  /**
+   * Computes the inverse of the logistic function.
+   *
+   * @param y Input data.
+   * @param x The resulting inverse of the input data.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Inv(const InputVecType& y, OutputVecType& x)
+  {
+    LogisticFunction::Inv(y, x);
+  }
+}; // class FastLogisticFunction
+
+} // namespace mlpack
+
+#endif
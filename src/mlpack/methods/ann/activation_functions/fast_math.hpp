@@ -0,0 +1,105 @@
+/**
+ * @file methods/ann/activation_functions/fast_math.hpp
+ *
+ * Fast approximations of the exponential, used by the fast activation
+ * functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MATH_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MATH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute an approximation of exp(x).  The argument is reduced to
+ * x = n * ln(2) + r with |r| <= ln(2) / 2, e^r is given by a polynomial of
+ * degree 6, and 2^n is built directly in the exponent bits of the result.
+ * The relative error is below 2e-7 for all x.  The argument is clamped to
+ * [-(log_max - 2), log_max - 1], so the result never overflows to infinity or
+ * underflows to a denormal.
+ *
+ * The function has no branches and no calls, so loops over it are
+ * vectorized by the compiler.
+ */
+inline double FastExp(const double x)
+{
+  const double logMax = arma::Datum<double>::log_max;
+  const double xc = std::min(std::max(x, -(logMax - 2.0)), logMax - 1.0);
+
+  // Cody-Waite reduction: ln(2) is split so that n * ln2Hi is exact.
+  const double n = std::floor(1.4426950408889634 * xc + 0.5);
+  const double r = (xc - n * 6.93145751953125e-1) - n * 1.42860682030941723e-6;
+
+  // Taylor polynomial of e^r, in Horner form.
+  const double p = 1.0 + r * (1.0 + r * (1.0 / 2.0 + r * (1.0 / 6.0 +
+      r * (1.0 / 24.0 + r * (1.0 / 120.0 + r * (1.0 / 720.0))))));
+
+  const uint64_t bits = uint64_t(int64_t(n) + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &bits, sizeof(double));
+  return p * scale;
+}
+
+/**
+ * Compute an approximation of exp(x) in single precision, as with the double
+ * precision overload.  The relative error is below 3e-7 (a few units in the
+ * last place of a float).
+ */
+inline float FastExp(const float x)
+{
+  const float logMax = arma::Datum<float>::log_max;
+  const float xc = std::min(std::max(x, -(logMax - 2.0f)), logMax - 1.0f);
+
+  const float n = std::floor(1.44269504f * xc + 0.5f);
+  const float r = (xc - n * 6.93359375e-1f) + n * 2.12194440e-4f;
+
+  const float p = 1.0f + r * (1.0f + r * (1.0f / 2.0f + r * (1.0f / 6.0f +
+      r * (1.0f / 24.0f + r * (1.0f / 120.0f + r * (1.0f / 720.0f))))));
+
+  const uint32_t bits = uint32_t(int32_t(n) + 127) << 23;
+  float scale;
+  std::memcpy(&scale, &bits, sizeof(float));
+  return p * scale;
+}
+
+/**
+ * Compute an approximation of tanh(x) with `FastExp()`, as
+ * 1 - 2 / (1 + e^{2x}).  Near zero, where that form loses digits, an odd
+ * polynomial is used instead.  The absolute error is below 1e-6.
+ */
+template<typename eT>
+inline eT FastTanh(const eT x)
+{
+  const eT x2 = x * x;
+  const eT small = x * (1 + x2 * (eT(-1.0 / 3.0) + x2 * (eT(2.0 / 15.0) +
+      x2 * eT(-17.0 / 315.0))));
+  const eT large = 1 - 2 / (1 + FastExp(2 * x));
+  return (std::abs(x) < eT(0.1)) ? small : large;
+}
+
+/**
+ * Apply the given scalar function to each element of `x` and store the
+ * results in `y`.  `x` and `y` must be dense matrices; they may be the same
+ * matrix.
+ */
+template<typename InputVecType, typename OutputVecType, typename FunctionType>
+inline void FastTransform(const InputVecType& x,
+                          OutputVecType& y,
+                          const FunctionType& f)
+{
+  y.set_size(arma::size(x));
+  const typename InputVecType::elem_type* in = x.memptr();
+  typename OutputVecType::elem_type* out = y.memptr();
+  for (size_t i = 0; i < x.n_elem; ++i)
+    out[i] = f(in[i]);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file methods/ann/activation_functions/fast_mish_function.hpp
+ *
+ * Definition and implementation of a fast approximation of the Mish function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MISH_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_MISH_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_math.hpp"
+
+namespace mlpack {
+
+/**
+ * A fast approximation of the Mish function (see `MishFunction`), computed
+ * with one call to `FastExp()`.  Since tanh(ln(1 + e)) is a rational function
+ * of e = e^x,
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& x * tanh(ln(1 + e^x)) = x * \frac{e^2 + 2e}{e^2 + 2e + 2} \\
+ * f'(x) &=& \frac{e * (4(x + 1) + 4e^2 + e^3 + e * (4x + 6))}
+ *           {(e^2 + 2e + 2)^2}
+ * @f}
+ *
+ * The argument of the exponential is capped at 20, beyond which both
+ * fractions are 1 to working precision.  The relative error of f(x) is below
+ * 1e-6.  The matrix overloads only accept dense matrices.
+ */
+class FastMishFunction
+{
+ public:
+  /**
+   * Computes the Mish function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  template<typename eT>
+  static eT Fn(const eT x)
+  {
+    const eT e = FastExp(std::min(x, eT(20)));
+    const eT n = e * (e + 2);
+    return x * n / (n + 2);
+  }
+
+  /**
+   * Computes the Mish function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, y, [](const eT v) { return Fn(v); });
+  }
+
+  /**
+   * Computes the first derivative of the Mish function.
+   *
+   * @param x Input data.
+   * @return f'(x).
+   */
+  template<typename eT>
+  static eT Deriv(const eT x, const eT /* y */)
+  {
+    const eT e = FastExp(std::min(x, eT(20)));
+    const eT omega = 4 * (x + 1) + e * (4 * e + e * e + 4 * x + 6);
+    const eT delta = e * (e + 2) + 2;
+    return e * omega / (delta * delta);
+  }
+
+  /**
+   * Computes the first derivatives of the Mish function.
+   *
+   * @param x Input activations.
+   * @param * (y) The resulting activations.
+   * @param dy The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType, typename DerivVecType>
+  static void Deriv(const InputVecType& x,
+                    const OutputVecType& /* y */,
+                    DerivVecType& dy)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, dy, [](const eT v) { return Deriv(v, v); });
+  }
+}; // class FastMishFunction
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file methods/ann/activation_functions/fast_swish_function.hpp
+ *
+ * Definition and implementation of a fast approximation of the Swish
+ * function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_SWISH_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_FAST_SWISH_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "fast_math.hpp"
+
+namespace mlpack {
+
+/**
+ * A fast approximation of the Swish (or SiLU) function (see `SwishFunction`),
+ * computed with `FastExp()`:
+ *
+ * @f{eqnarray*}{
+ * f(x) &=& x * sigmoid(x) \\
+ * f'(x) &=& f(x) + sigmoid(x) * (1 - f(x))
+ * @f}
+ *
+ * The relative error of f(x) is below 3e-7.  The matrix overloads only accept
+ * dense matrices.
+ */
+class FastSwishFunction
+{
+ public:
+  /**
+   * Computes the Swish function.
+   *
+   * @param x Input data.
+   * @return f(x).
+   */
+  template<typename eT>
+  static eT Fn(const eT x)
+  {
+    return x / (1 + FastExp(-x));
+  }
+
+  /**
+   * Computes the Swish function.
+   *
+   * @param x Input data.
+   * @param y The resulting output activation.
+   */
+  template<typename InputVecType, typename OutputVecType>
+  static void Fn(const InputVecType& x, OutputVecType& y)
+  {
+    typedef typename InputVecType::elem_type eT;
+    FastTransform(x, y, [](const eT v) { return Fn(v); });
+  }
+
+  /**
+   * Computes the first derivative of the Swish function.
+   *
+   * @param x Input data.
+   * @param y Result of Fn(x).
+   * @return f'(x)
+   */
+  template<typename eT>
+  static eT Deriv(const eT x, const eT y)
+  {
+    // The sigmoid is recomputed, since y / x is indeterminate at 0.
+    const eT sigmoid = 1 / (1 + FastExp(-x));
+    return y + sigmoid * (1 - y);
+  }
+
+  /**
+   * Computes the first derivatives of the Swish function.
+   *
+   * @param x Input data.
+   * @param y Result of Fn(x).
+   * @param dy The resulting derivatives.
+   */
+  template<typename InputVecType, typename OutputVecType, typename DerivVecType>
+  static void Deriv(const InputVecType& x,
+                    const OutputVecType& y,
+                    DerivVecType& dy)
+  {
+    typedef typename InputVecType::elem_type eT;
+    dy.set_size(arma::size(x));
+    for (size_t i = 0; i < x.n_elem; ++i)
+      dy[i] = Deriv(eT(x[i]), eT(y[i]));
+  }
+}; // class FastSwishFunction
+
+} // namespace mlpack
+
+#endif
@@ -26,8 +26,10 @@
 #include "layer/layer.hpp"
 #include "loss_functions/loss_functions.hpp"
 #include "regularizer/regularizer.hpp"
+#include "sparse_update/sparse_update.hpp"
 
 #include "ffn.hpp"
+#include "inference_server.hpp"
 #include "rnn.hpp"
 
 #endif
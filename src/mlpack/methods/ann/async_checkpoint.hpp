@@ -0,0 +1,139 @@
+/**
+ * @file methods/ann/async_checkpoint.hpp
+ *
+ * Definition of the AsyncCheckpoint callback, which saves the parameters of a
+ * network during training without stalling the optimizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_HPP
+#define MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <deque>
+#include <future>
+
+namespace mlpack {
+
+/**
+ * AsyncCheckpoint is an ensmallen callback that saves the coordinates being
+ * optimized (for an FFN or RNN, the flat `Parameters()` matrix) every `period`
+ * epochs.  The coordinates are copied into a snapshot, which is a single copy
+ * of contiguous memory, and the snapshot is written by a background thread
+ * while the optimizer continues; saving the whole network with `data::Save()`
+ * instead serializes every layer before training can resume.  Only one write
+ * is in flight at a time: if the previous write has not finished when the next
+ * checkpoint is due, the optimizer waits for it.
+ *
+ * Each checkpoint is written in Armadillo's binary format to
+ * `<prefix>_<n>.bin`, where n counts the checkpoints from 1; the file is first
+ * written under a temporary name and then renamed, so a checkpoint file is
+ * never partially written.  Only the last `keep` checkpoints are kept.  To
+ * restore a network, load the last file into the `Parameters()` of a network
+ * with the same layers (e.g. with `model.Parameters().load(filename)`).
+ *
+ * Only the coordinates are saved: the internal state of an ensmallen optimizer
+ * (e.g. the moment estimates of Adam) cannot be accessed generically, so it
+ * is reinitialized when training is resumed.
+ *
+ * @code
+ * AsyncCheckpoint<> checkpoint("model", 1, 3);
+ * model.Train(data, labels, optimizer, checkpoint);
+ * checkpoint.Wait();
+ * @endcode
+ *
+ * @tparam MatType Type of the coordinates.
+ */
+template<typename MatType = arma::mat>
+class AsyncCheckpoint
+{
+ public:
+  /**
+   * Create the callback.
+   *
+   * @param prefix Prefix of the checkpoint filenames.
+   * @param period Number of epochs between two checkpoints.
+   * @param keep Number of checkpoints to keep (0 keeps all of them).
+   */
+  AsyncCheckpoint(const std::string& prefix,
+                  const size_t period = 1,
+                  const size_t keep = 3);
+
+  //! Wait for the last write to finish.
+  ~AsyncCheckpoint();
+
+  /**
+   * Callback function called at the end of a pass over the data; this saves a
+   * checkpoint every `period` epochs.
+   *
+   * @param optimizer The optimizer used to update the function.
+   * @param function Function to optimize.
+   * @param coordinates Starting point.
+   * @param epoch The index of the current epoch.
+   * @param objective Objective value of the current point.
+   */
+  template<typename OptimizerType, typename FunctionType, typename InMatType>
+  bool EndEpoch(OptimizerType& optimizer,
+                FunctionType& function,
+                const InMatType& coordinates,
+                const size_t epoch,
+                const double objective);
+
+  /**
+   * Snapshot the given coordinates and write them in the background as the
+   * next checkpoint.  This can be called directly, e.g. from another callback.
+   *
+   * @param coordinates Coordinates to save.
+   */
+  template<typename InMatType>
+  void Save(const InMatType& coordinates);
+
+  /**
+   * Wait for the last write to finish, and update the list of checkpoints.
+   * Returns false if any write has failed.
+   */
+  bool Wait();
+
+  //! Get the filenames of the checkpoints that are kept, oldest first.  This
+  //! is up to date after Wait().
+  const std::deque<std::string>& Checkpoints() const { return checkpoints; }
+
+  //! Get the number of checkpoints that were started.
+  size_t Count() const { return count; }
+
+ private:
+  //! Write the snapshot to the given file.
+  static bool Write(const MatType& snapshot, const std::string& filename);
+
+  //! The prefix of the checkpoint filenames.
+  std::string prefix;
+  //! The number of epochs between two checkpoints.
+  size_t period;
+  //! The number of checkpoints to keep.
+  size_t keep;
+  //! The number of epochs seen.
+  size_t epochs;
+  //! The number of checkpoints that were started.
+  size_t count;
+  //! Whether any write has failed.
+  bool failed;
+
+  //! The coordinates being written.
+  MatType snapshot;
+  //! The filename of the checkpoint being written.
+  std::string pendingFilename;
+  //! The write in flight, if any.
+  std::future<bool> pending;
+  //! The checkpoints that are kept, oldest first.
+  std::deque<std::string> checkpoints;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "async_checkpoint_impl.hpp"
+
+#endif
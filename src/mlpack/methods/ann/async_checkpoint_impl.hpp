@@ -0,0 +1,109 @@
+/**
+ * @file methods/ann/async_checkpoint_impl.hpp
+ *
+ * Implementation of the AsyncCheckpoint callback.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_IMPL_HPP
+#define MLPACK_METHODS_ANN_ASYNC_CHECKPOINT_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "async_checkpoint.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+AsyncCheckpoint<MatType>::AsyncCheckpoint(const std::string& prefix,
+                                          const size_t period,
+                                          const size_t keep) :
+    prefix(prefix),
+    period(period),
+    keep(keep),
+    epochs(0),
+    count(0),
+    failed(false)
+{
+  if (period == 0)
+  {
+    throw std::invalid_argument("AsyncCheckpoint::AsyncCheckpoint(): period "
+        "must be positive!");
+  }
+}
+
+template<typename MatType>
+AsyncCheckpoint<MatType>::~AsyncCheckpoint()
+{
+  Wait();
+}
+
+template<typename MatType>
+template<typename OptimizerType, typename FunctionType, typename InMatType>
+bool AsyncCheckpoint<MatType>::EndEpoch(OptimizerType& /* optimizer */,
+                                        FunctionType& /* function */,
+                                        const InMatType& coordinates,
+                                        const size_t /* epoch */,
+                                        const double /* objective */)
+{
+  if (++epochs % period == 0)
+    Save(coordinates);
+
+  // Never terminate the optimization.
+  return false;
+}
+
+template<typename MatType>
+template<typename InMatType>
+void AsyncCheckpoint<MatType>::Save(const InMatType& coordinates)
+{
+  // The snapshot can only be overwritten once the previous write is done.
+  Wait();
+
+  snapshot = coordinates;
+  pendingFilename = prefix + "_" + std::to_string(++count) + ".bin";
+  pending = std::async(std::launch::async, &AsyncCheckpoint::Write,
+      std::cref(snapshot), pendingFilename);
+}
+
+template<typename MatType>
+bool AsyncCheckpoint<MatType>::Wait()
+{
+  if (!pending.valid())
+    return !failed;
+
+  if (!pending.get())
+  {
+    Log::Warning << "AsyncCheckpoint: could not write checkpoint '"
+        << pendingFilename << "'!" << std::endl;
+    failed = true;
+    return false;
+  }
+
+  // Remove the oldest checkpoints, now that a newer one exists.
+  checkpoints.push_back(pendingFilename);
+  while (keep > 0 && checkpoints.size() > keep)
+  {
+    std::remove(checkpoints.front().c_str());
+    checkpoints.pop_front();
+  }
+
+  return !failed;
+}
+
+template<typename MatType>
+bool AsyncCheckpoint<MatType>::Write(const MatType& snapshot,
+                                     const std::string& filename)
+{
+  const std::string tmpFilename = filename + ".tmp";
+  if (!snapshot.save(tmpFilename, arma::arma_binary))
+    return false;
+
+  return (std::rename(tmpFilename.c_str(), filename.c_str()) == 0);
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file methods/ann/batch_source.hpp
+ *
+ * Definition of the BatchSource interface, which provides a data set in
+ * chunks so that a network can be trained on data that does not fit in memory,
+ * and of FileBatchSource, which reads each chunk from its own files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_BATCH_SOURCE_HPP
+#define MLPACK_METHODS_ANN_BATCH_SOURCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A BatchSource provides a data set as a number of chunks, each of which holds
+ * some of the points (one per column) and their responses.  Only one or two
+ * chunks are held in memory at a time during training (see
+ * `FFN::Train(BatchSource&, ...)`), so the whole data set does not need to
+ * fit in memory.
+ *
+ * `Load()` is called from a background thread while the network trains on
+ * the previous chunk, so it must not touch any state that is shared with the
+ * training thread; it is never called from two threads at once.  To read other
+ * kinds of data (e.g. images, with `data::Load()`), derive from this class.
+ *
+ * @tparam MatType Matrix type of the data.
+ */
+template<typename MatType = arma::mat>
+class BatchSource
+{
+ public:
+  //! Destroy the source.
+  virtual ~BatchSource() { }
+
+  //! Get the number of chunks.
+  virtual size_t NumChunks() const = 0;
+
+  //! Get the number of points in the given chunk.  This is called before
+  //! training, from the training thread.
+  virtual size_t ChunkSize(const size_t chunk) = 0;
+
+  /**
+   * Load the given chunk.
+   *
+   * @param chunk Index of the chunk to load.
+   * @param predictors Will be set to the points of the chunk.
+   * @param responses Will be set to the responses of the points of the chunk.
+   */
+  virtual void Load(const size_t chunk,
+                    MatType& predictors,
+                    MatType& responses) = 0;
+};
+
+/**
+ * A FileBatchSource reads each chunk from a file of predictors and a file of
+ * responses, with `data::Load()`; so any format that `data::Load()` supports
+ * can be used (e.g. CSV or Armadillo binary files), and, as usual, each row of
+ * a CSV file is one point.
+ *
+ * The size of each chunk is needed before training; if it is not given, it is
+ * found by loading the predictors file of each chunk once.
+ *
+ * @tparam MatType Matrix type of the data.
+ */
+template<typename MatType = arma::mat>
+class FileBatchSource : public BatchSource<MatType>
+{
+ public:
+  /**
+   * Create the source from the given files; chunk i is read from
+   * predictorFiles[i] and responseFiles[i].
+   *
+   * @param predictorFiles Files of the points of each chunk.
+   * @param responseFiles Files of the responses of each chunk.
+   * @param chunkSizes Number of points in each chunk, if known.
+   */
+  FileBatchSource(const std::vector<std::string>& predictorFiles,
+                  const std::vector<std::string>& responseFiles,
+                  const std::vector<size_t>& chunkSizes =
+                      std::vector<size_t>());
+
+  //! Get the number of chunks.
+  size_t NumChunks() const { return predictorFiles.size(); }
+
+  //! Get the number of points in the given chunk.
+  size_t ChunkSize(const size_t chunk);
+
+  //! Load the given chunk.
+  void Load(const size_t chunk, MatType& predictors, MatType& responses);
+
+ private:
+  //! The files of the points of each chunk.
+  std::vector<std::string> predictorFiles;
+  //! The files of the responses of each chunk.
+  std::vector<std::string> responseFiles;
+  //! The number of points in each chunk, if known.
+  std::vector<size_t> chunkSizes;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_source_impl.hpp"
+
+#endif
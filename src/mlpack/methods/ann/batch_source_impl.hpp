@@ -0,0 +1,78 @@
+/**
+ * @file methods/ann/batch_source_impl.hpp
+ *
+ * Implementation of the FileBatchSource class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_BATCH_SOURCE_IMPL_HPP
+#define MLPACK_METHODS_ANN_BATCH_SOURCE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_source.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+FileBatchSource<MatType>::FileBatchSource(
+    const std::vector<std::string>& predictorFiles,
+    const std::vector<std::string>& responseFiles,
+    const std::vector<size_t>& chunkSizes) :
+    predictorFiles(predictorFiles),
+    responseFiles(responseFiles),
+    chunkSizes(chunkSizes)
+{
+  if (predictorFiles.size() != responseFiles.size())
+  {
+    throw std::invalid_argument("FileBatchSource::FileBatchSource(): number "
+        "of predictor files does not match number of response files!");
+  }
+
+  if (!chunkSizes.empty() && chunkSizes.size() != predictorFiles.size())
+  {
+    throw std::invalid_argument("FileBatchSource::FileBatchSource(): number "
+        "of chunk sizes does not match number of files!");
+  }
+
+  // A size of 0 means that the size is not known yet.
+  this->chunkSizes.resize(predictorFiles.size(), 0);
+}
+
+template<typename MatType>
+size_t FileBatchSource<MatType>::ChunkSize(const size_t chunk)
+{
+  if (chunkSizes[chunk] == 0)
+  {
+    MatType predictors;
+    data::Load(predictorFiles[chunk], predictors, true);
+    chunkSizes[chunk] = predictors.n_cols;
+  }
+
+  return chunkSizes[chunk];
+}
+
+template<typename MatType>
+void FileBatchSource<MatType>::Load(const size_t chunk,
+                                    MatType& predictors,
+                                    MatType& responses)
+{
+  data::Load(predictorFiles[chunk], predictors, true);
+  data::Load(responseFiles[chunk], responses, true);
+
+  if (predictors.n_cols != responses.n_cols ||
+      predictors.n_cols != chunkSizes[chunk])
+  {
+    std::ostringstream oss;
+    oss << "FileBatchSource::Load(): chunk " << chunk << " has "
+        << predictors.n_cols << " points and " << responses.n_cols
+        << " responses, but " << chunkSizes[chunk] << " were expected!";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+} // namespace mlpack
+
+#endif
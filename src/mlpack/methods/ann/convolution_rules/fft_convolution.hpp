@@ -55,21 +55,9 @@ class FFTConvolution
               MatType& output,
               const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0)
   {
-    MatType inputPadded = input;
-    MatType filterPadded = filter;
-
-    if (padLastDim)
-      inputPadded.resize(inputPadded.n_rows, inputPadded.n_cols + 1);
-
-    // Pad filter and input to the output shape.
-    filterPadded.resize(inputPadded.n_rows, inputPadded.n_cols);
-
-    MatType temp = real(ifft2(fft2(inputPadded) % fft2(filterPadded)));
-
-    // Extract the region of interest. We don't need to handle the padLastDim in
-    // a special way we just cut it out from the output matrix.
-    output = temp.submat(filter.n_rows - 1, filter.n_cols - 1,
-        input.n_rows - 1, input.n_cols - 1);
+    Extract(InputTransform(input, filter.n_rows, filter.n_cols) %
+        FilterTransform(filter, input.n_rows, input.n_cols), input.n_rows,
+        input.n_cols, filter.n_rows, filter.n_cols, output);
   }
 
   /**
@@ -90,32 +78,9 @@ class FFTConvolution
               MatType& output,
               const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0)
   {
-    // In case of the full convolution outputRows and outputCols doesn't
-    // represent the true output size when the padLastDim parameter is set,
-    // instead it's the working size.
-    const size_t outputRows = input.n_rows + 2 * (filter.n_rows - 1);
-    size_t outputCols = input.n_cols + 2 * (filter.n_cols - 1);
-
-    if (padLastDim)
-        outputCols++;
-
-    // Pad filter and input to the working output shape.
-    MatType inputPadded = zeros<MatType>(outputRows, outputCols);
-    inputPadded.submat(filter.n_rows - 1, filter.n_cols - 1,
-          filter.n_rows - 1 + input.n_rows - 1,
-          filter.n_cols - 1 + input.n_cols - 1) = input;
-
-    MatType filterPadded = filter;
-    filterPadded.resize(outputRows, outputCols);
-
-    // Perform FFT and IFFT
-    MatType temp = real(ifft2(fft2(inputPadded) % fft2(filterPadded)));
-
-    // Extract the region of interest. We don't need to handle the padLastDim
-    // parameter in a special way we just cut it out from the output matrix.
-    output = temp.submat(filter.n_rows - 1, filter.n_cols - 1,
-        2 * (filter.n_rows - 1) + input.n_rows - 1,
-        2 * (filter.n_cols - 1) + input.n_cols - 1);
+    Extract(InputTransform(input, filter.n_rows, filter.n_cols) %
+        FilterTransform(filter, input.n_rows, input.n_cols), input.n_rows,
+        input.n_cols, filter.n_rows, filter.n_cols, output);
   }
 
   /**
@@ -166,17 +131,21 @@ class FFTConvolution
                           const CubeType& filter,
                           CubeType& output)
   {
-    MatType convOutput;
-    FFTConvolution<BorderMode>::Convolution(input, filter.slice(0),
-        convOutput);
-
-    output = CubeType(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
-    output.slice(0) = convOutput;
+    // The transform of the input is the same for every filter, so it is only
+    // computed once.
+    const arma::Mat<std::complex<typename MatType::elem_type>> inputTransform =
+        InputTransform(input, filter.n_rows, filter.n_cols);
 
-    for (size_t i = 1; i < filter.n_slices; ++i)
+    MatType convOutput;
+    for (size_t i = 0; i < filter.n_slices; ++i)
     {
-      FFTConvolution<BorderMode>::Convolution(input, filter.slice(i),
-          output.slice(i));
+      Extract(inputTransform % FilterTransform(filter.slice(i), input.n_rows,
+          input.n_cols), input.n_rows, input.n_cols, filter.n_rows,
+          filter.n_cols, convOutput);
+
+      if (i == 0)
+        output.set_size(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
+      output.slice(i) = convOutput;
     }
   }
 
@@ -193,18 +162,113 @@ class FFTConvolution
                           const MatType& filter,
                           CubeType& output)
   {
+    // The transform of the filter is the same for every slice, so it is only
+    // computed once.
+    const arma::Mat<std::complex<typename MatType::elem_type>>
+        filterTransform = FilterTransform(filter, input.n_rows, input.n_cols);
+
     MatType convOutput;
-    FFTConvolution<BorderMode>::Convolution(input.slice(0), filter,
-        convOutput);
+    for (size_t i = 0; i < input.n_slices; ++i)
+    {
+      Extract(InputTransform(input.slice(i), filter.n_rows, filter.n_cols) %
+          filterTransform, input.n_rows, input.n_cols, filter.n_rows,
+          filter.n_cols, convOutput);
 
-    output = CubeType(convOutput.n_rows, convOutput.n_cols,
-        input.n_slices);
-    output.slice(0) = convOutput;
+      if (i == 0)
+        output.set_size(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+      output.slice(i) = convOutput;
+    }
+  }
 
-    for (size_t i = 1; i < input.n_slices; ++i)
+ private:
+  /**
+   * Compute the size that the input and the filter are zero-padded to before
+   * they are transformed.
+   */
+  static void WorkingSize(const size_t inputRows,
+                          const size_t inputCols,
+                          const size_t filterRows,
+                          const size_t filterCols,
+                          size_t& rows,
+                          size_t& cols)
+  {
+    rows = inputRows;
+    cols = inputCols;
+    if (std::is_same<BorderMode, FullConvolution>::value)
     {
-      FFTConvolution<BorderMode>::Convolution(input.slice(i), filter,
-          output.slice(i));
+      rows += 2 * (filterRows - 1);
+      cols += 2 * (filterCols - 1);
+    }
+
+    if (padLastDim)
+      ++cols;
+  }
+
+  /**
+   * Zero-pad the input to the working size and compute its transform.  For
+   * the full convolution the input is placed in the middle of the padding.
+   */
+  template<typename MatType>
+  static arma::Mat<std::complex<typename MatType::elem_type>> InputTransform(
+      const MatType& input,
+      const size_t filterRows,
+      const size_t filterCols)
+  {
+    size_t rows, cols;
+    WorkingSize(input.n_rows, input.n_cols, filterRows, filterCols, rows,
+        cols);
+    const bool full = std::is_same<BorderMode, FullConvolution>::value;
+    const size_t rowOffset = full ? filterRows - 1 : 0;
+    const size_t colOffset = full ? filterCols - 1 : 0;
+
+    MatType inputPadded(rows, cols, arma::fill::zeros);
+    inputPadded.submat(rowOffset, colOffset, rowOffset + input.n_rows - 1,
+        colOffset + input.n_cols - 1) = input;
+    return fft2(inputPadded);
+  }
+
+  /**
+   * Zero-pad the filter to the working size and compute its transform.
+   */
+  template<typename MatType>
+  static arma::Mat<std::complex<typename MatType::elem_type>> FilterTransform(
+      const MatType& filter,
+      const size_t inputRows,
+      const size_t inputCols)
+  {
+    size_t rows, cols;
+    WorkingSize(inputRows, inputCols, filter.n_rows, filter.n_cols, rows,
+        cols);
+
+    MatType filterPadded = filter;
+    filterPadded.resize(rows, cols);
+    return fft2(filterPadded);
+  }
+
+  /**
+   * Invert the product of the transforms of the input and the filter, and
+   * extract the region of interest.  We don't need to handle the padLastDim
+   * parameter in a special way; we just cut it out from the output matrix.
+   */
+  template<typename ComplexMatType, typename MatType>
+  static void Extract(const ComplexMatType& product,
+                      const size_t inputRows,
+                      const size_t inputCols,
+                      const size_t filterRows,
+                      const size_t filterCols,
+                      MatType& output)
+  {
+    MatType temp = real(ifft2(product));
+    if (std::is_same<BorderMode, FullConvolution>::value)
+    {
+      output = temp.submat(filterRows - 1, filterCols - 1,
+          2 * (filterRows - 1) + inputRows - 1,
+          2 * (filterCols - 1) + inputCols - 1);
+    }
+    else
+    {
+      output = temp.submat(filterRows - 1, filterCols - 1, inputRows - 1,
+          inputCols - 1);
     }
   }
 };  // class FFTConvolution
@@ -0,0 +1,413 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ *
+ * Implementation of the convolution through matrix multiplication, by
+ * unfolding the patches of the input into the columns of a matrix (im2col).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution by unfolding every patch of the
+ * input that the filter is applied to into a column of a matrix, so that the
+ * convolution is a single matrix multiplication that can be handed to BLAS.
+ * This needs memory for a copy of the input for every element of the filter,
+ * but is typically much faster than NaiveConvolution.
+ *
+ * The Im2Col() and Col2Im() functions work on whole batches of multi-map
+ * images; when all three convolution rules of a ConvolutionType layer are
+ * Im2ColConvolution, the layer uses them to compute the forward pass, the
+ * backward pass and the gradient of the whole batch with one matrix
+ * multiplication each, instead of one convolution per point and pair of maps:
+ *
+ * @code
+ * typedef ConvolutionType<Im2ColConvolution<ValidConvolution>,
+ *                         Im2ColConvolution<FullConvolution>,
+ *                         Im2ColConvolution<ValidConvolution>,
+ *                         arma::mat> GEMMConvolution;
+ * @endcode
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<InMatType>::type MatType;
+    typedef typename GetCubeType<MatType>::type CubeType;
+
+    // See NaiveConvolution for the computation of the output size.
+    const size_t filterRows = filter.n_rows * dilationH - (dilationH - 1);
+    const size_t filterCols = filter.n_cols * dilationW - (dilationW - 1);
+    const size_t outputRows = (input.n_rows - filterRows + dH) / dH;
+    const size_t outputCols = (input.n_cols - filterCols + dW) / dW;
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    CubeType inputCube;
+    MakeAlias(inputCube, input, input.n_rows, input.n_cols, 1);
+    MatType columns;
+    Im2Col(inputCube, 1, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dH, dW, dilationH, dilationW, columns);
+
+    output += arma::reshape(columns.t() * arma::vectorise(filter), outputRows,
+        outputCols);
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<InMatType>::type MatType;
+
+    // Pad the input so that the full convolution is the valid convolution of
+    // the padded input.
+    const size_t paddingRows = filter.n_rows * dilationH - dilationH;
+    const size_t paddingCols = filter.n_cols * dilationW - dilationW;
+
+    MatType inputPadded(input.n_rows + 2 * paddingRows,
+        input.n_cols + 2 * paddingCols, arma::fill::zeros);
+    inputPadded.submat(paddingRows, paddingCols, paddingRows + input.n_rows - 1,
+        paddingCols + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, dW, dH, dilationW, dilationH, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename CubeType>
+  static void Convolution(const CubeType& input,
+                          const CubeType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(const MatType& input,
+                          const CubeType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(const CubeType& input,
+                          const MatType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Unfold the patches of a batch of images into the columns of a matrix.  The
+   * slices of `input` hold `input.n_slices / maps` images of `maps` maps each,
+   * and `columns` will hold one column for each output position of each image:
+   * column (n * outputCols + j) * outputRows + i holds the patch of image n
+   * that gives output (i, j), with the patches of all the maps stacked.  The
+   * elements of the patch of each map are in the same column-major order as
+   * the elements of a filter, so multiplying a filter (or `maps` filters
+   * stored next to each other) by the transpose of `columns` gives the
+   * convolution of every image.
+   *
+   * @param input Images to unfold.
+   * @param maps Number of maps of each image.
+   * @param kernelRows Number of rows of the filter.
+   * @param kernelCols Number of columns of the filter.
+   * @param outputRows Number of rows of the output of the convolution.
+   * @param outputCols Number of columns of the output of the convolution.
+   * @param strideRows Stride of filter application along the rows.
+   * @param strideCols Stride of filter application along the columns.
+   * @param dilationRows Dilation of the filter along the rows.
+   * @param dilationCols Dilation of the filter along the columns.
+   * @param columns Matrix to store the patches in.
+   */
+  template<typename CubeType, typename MatType>
+  static void Im2Col(const CubeType& input,
+                     const size_t maps,
+                     const size_t kernelRows,
+                     const size_t kernelCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t strideRows,
+                     const size_t strideCols,
+                     const size_t dilationRows,
+                     const size_t dilationCols,
+                     MatType& columns)
+  {
+    typedef typename MatType::elem_type eT;
+
+    const size_t numImages = input.n_slices / maps;
+    columns.set_size(kernelRows * kernelCols * maps,
+        outputRows * outputCols * numImages);
+
+    #pragma omp parallel for num_threads(Parallel::Threads())
+    for (size_t n = 0; n < numImages; ++n)
+    {
+      eT* columnPtr = columns.colptr(n * outputRows * outputCols);
+      for (size_t j = 0; j < outputCols; ++j)
+      {
+        for (size_t i = 0; i < outputRows; ++i)
+        {
+          for (size_t m = 0; m < maps; ++m)
+          {
+            for (size_t kj = 0; kj < kernelCols; ++kj)
+            {
+              const eT* inputPtr = input.slice_colptr(n * maps + m,
+                  j * strideCols + kj * dilationCols) + i * strideRows;
+              for (size_t ki = 0; ki < kernelRows; ++ki,
+                  inputPtr += dilationRows)
+                *(columnPtr++) = *inputPtr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Fold a matrix of patches, as given by Im2Col(), back into a batch of
+   * images, adding up the elements of overlapping patches.  This is the
+   * transpose of Im2Col(); `input` must already have the right size, and the
+   * patches are added to it.
+   *
+   * @param columns Patches to fold.
+   * @param maps Number of maps of each image.
+   * @param kernelRows Number of rows of the filter.
+   * @param kernelCols Number of columns of the filter.
+   * @param outputRows Number of rows of the output of the convolution.
+   * @param outputCols Number of columns of the output of the convolution.
+   * @param strideRows Stride of filter application along the rows.
+   * @param strideCols Stride of filter application along the columns.
+   * @param dilationRows Dilation of the filter along the rows.
+   * @param dilationCols Dilation of the filter along the columns.
+   * @param input Images to add the patches to.
+   */
+  template<typename MatType, typename CubeType>
+  static void Col2Im(const MatType& columns,
+                     const size_t maps,
+                     const size_t kernelRows,
+                     const size_t kernelCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t strideRows,
+                     const size_t strideCols,
+                     const size_t dilationRows,
+                     const size_t dilationCols,
+                     CubeType& input)
+  {
+    typedef typename MatType::elem_type eT;
+
+    // Each image only receives its own patches, so the images can be handled
+    // in parallel.
+    const size_t numImages = input.n_slices / maps;
+    #pragma omp parallel for num_threads(Parallel::Threads())
+    for (size_t n = 0; n < numImages; ++n)
+    {
+      const eT* columnPtr = columns.colptr(n * outputRows * outputCols);
+      for (size_t j = 0; j < outputCols; ++j)
+      {
+        for (size_t i = 0; i < outputRows; ++i)
+        {
+          for (size_t m = 0; m < maps; ++m)
+          {
+            for (size_t kj = 0; kj < kernelCols; ++kj)
+            {
+              eT* inputPtr = input.slice_colptr(n * maps + m,
+                  j * strideCols + kj * dilationCols) + i * strideRows;
+              for (size_t ki = 0; ki < kernelRows; ++ki,
+                  inputPtr += dilationRows)
+                *inputPtr += *(columnPtr++);
+            }
+          }
+        }
+      }
+    }
+  }
+};  // class Im2ColConvolution
+
+/**
+ * Whether the given convolution rule is Im2ColConvolution, in which case the
+ * ConvolutionType layer lowers the whole batch to a matrix multiplication.
+ */
+template<typename ConvolutionRule>
+struct IsIm2ColConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsIm2ColConvolution<Im2ColConvolution<BorderMode>>
+{
+  static const bool value = true;
+};
+
+} // namespace mlpack
+
+#endif
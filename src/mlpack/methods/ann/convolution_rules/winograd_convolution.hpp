@@ -0,0 +1,403 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the convolution with Winograd's minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+
+/**
+ * Computes the two-dimensional convolution of an input with a 3x3 filter using
+ * Winograd's minimal filtering algorithm F(2x2, 3x3) (Lavin and Gray, "Fast
+ * Algorithms for Convolutional Neural Networks", 2016).  The output is computed
+ * in 2x2 tiles; each tile takes 16 multiplications instead of the 36 of the
+ * direct computation.  The transform of the filter is computed once per call.
+ *
+ * The algorithm only applies to 3x3 filters with a stride and dilation of 1,
+ * which is the common case for the forward and backward passes of
+ * convolutional layers; for any other filter, stride or dilation the
+ * computation is done by NaiveConvolution instead, so this rule can be used for
+ * every pass of a ConvolutionType layer:
+ *
+ * @code
+ * typedef ConvolutionType<WinogradConvolution<ValidConvolution>,
+ *                         WinogradConvolution<FullConvolution>,
+ *                         NaiveConvolution<ValidConvolution>,
+ *                         arma::mat> WinogradConv;
+ * @endcode
+ *
+ * FullConvolution: returns the full two-dimensional convolution.
+ * ValidConvolution: returns only those parts of the convolution that are
+ * computed without the zero-padded edges.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /**
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    typedef typename InMatType::elem_type eT;
+
+    if (!Applies(input, filter, dW, dH, dilationW, dilationH))
+    {
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    const size_t outputRows = input.n_rows - 2;
+    const size_t outputCols = input.n_cols - 2;
+    if (!appending)
+      output.zeros(outputRows, outputCols);
+
+    // All 4x4 matrices are stored in column-major order.
+    eT u[16];
+    FilterTransform(filter, u);
+
+    eT d[16], m[16], y[4];
+    for (size_t j = 0; j < outputCols; j += 2)
+    {
+      for (size_t i = 0; i < outputRows; i += 2)
+      {
+        // The last row or column of tiles may stick out of the input when the
+        // output size is odd; use zeros there.
+        for (size_t c = 0; c < 4; ++c)
+        {
+          for (size_t r = 0; r < 4; ++r)
+          {
+            d[4 * c + r] = (i + r < input.n_rows && j + c < input.n_cols) ?
+                input(i + r, j + c) : eT(0);
+          }
+        }
+
+        InputTransform(d, m);
+        for (size_t k = 0; k < 16; ++k)
+          m[k] *= u[k];
+        OutputTransform(m, y);
+
+        const bool lastRow = (i + 1 == outputRows);
+        const bool lastCol = (j + 1 == outputCols);
+        output(i, j) += y[0];
+        if (!lastRow)
+          output(i + 1, j) += y[1];
+        if (!lastCol)
+          output(i, j + 1) += y[2];
+        if (!lastRow && !lastCol)
+          output(i + 1, j + 1) += y[3];
+      }
+    }
+  }
+
+  /**
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename InMatType, typename FilMatType, typename OutMatType,
+      typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const InMatType& input,
+              const FilMatType& filter,
+              OutMatType& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1,
+              const bool appending = false,
+              const typename std::enable_if_t<IsMatrix<InMatType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<InMatType>::type MatType;
+
+    if (filter.n_rows != 3 || filter.n_cols != 3 || dW != 1 || dH != 1 ||
+        dilationW != 1 || dilationH != 1)
+    {
+      NaiveConvolution<FullConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH, appending);
+      return;
+    }
+
+    // The full convolution is the valid convolution of the input padded with
+    // two zeros on each side.
+    MatType inputPadded(input.n_rows + 4, input.n_cols + 4, arma::fill::zeros);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, 1, 1, appending);
+  }
+
+  /**
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename CubeType>
+  static void Convolution(const CubeType& input,
+                          const CubeType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    typedef typename GetDenseMatType<CubeType>::type MatType;
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH,
+          appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(const MatType& input,
+                          const CubeType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, filter.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+  /**
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   * @param appending If true, it will not initialize the output. Instead,
+   *                  it will append the results to the output.
+   */
+  template<typename MatType, typename CubeType>
+  static void Convolution(const CubeType& input,
+                          const MatType& filter,
+                          CubeType& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1,
+                          const bool appending = false,
+                          const typename std::enable_if_t<IsMatrix<MatType>::value>* = 0,
+                          const typename std::enable_if_t<IsCube<CubeType>::value>* = 0)
+  {
+    MatType convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH, appending);
+
+    if (!appending)
+      output = CubeType(convOutput.n_rows, convOutput.n_cols, input.n_slices);
+
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH, appending);
+    }
+  }
+
+ private:
+  //! Return whether the valid convolution can be computed with F(2x2, 3x3).
+  template<typename InMatType, typename FilMatType>
+  static bool Applies(const InMatType& input,
+                      const FilMatType& filter,
+                      const size_t dW,
+                      const size_t dH,
+                      const size_t dilationW,
+                      const size_t dilationH)
+  {
+    return (filter.n_rows == 3 && filter.n_cols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1 && input.n_rows >= 3 &&
+        input.n_cols >= 3);
+  }
+
+  /**
+   * Compute the transform G g G^T of the 3x3 filter g, where
+   * G = [1 0 0; 1/2 1/2 1/2; 1/2 -1/2 1/2; 0 0 1].
+   */
+  template<typename FilMatType, typename eT>
+  static void FilterTransform(const FilMatType& filter, eT* u)
+  {
+    // First compute the 4x3 matrix G g.
+    eT t[12];
+    for (size_t c = 0; c < 3; ++c)
+    {
+      const eT g0 = filter(0, c);
+      const eT g1 = filter(1, c);
+      const eT g2 = filter(2, c);
+      t[4 * c] = g0;
+      t[4 * c + 1] = (g0 + g1 + g2) / 2;
+      t[4 * c + 2] = (g0 - g1 + g2) / 2;
+      t[4 * c + 3] = g2;
+    }
+
+    for (size_t r = 0; r < 4; ++r)
+    {
+      const eT a = t[r];
+      const eT b = t[4 + r];
+      const eT c = t[8 + r];
+      u[r] = a;
+      u[4 + r] = (a + b + c) / 2;
+      u[8 + r] = (a - b + c) / 2;
+      u[12 + r] = c;
+    }
+  }
+
+  /**
+   * Compute the transform B^T d B of the 4x4 input tile d, where
+   * B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1].
+   */
+  template<typename eT>
+  static void InputTransform(const eT* d, eT* v)
+  {
+    // First compute B^T d.
+    eT t[16];
+    for (size_t c = 0; c < 4; ++c)
+    {
+      const eT* x = d + 4 * c;
+      t[4 * c] = x[0] - x[2];
+      t[4 * c + 1] = x[1] + x[2];
+      t[4 * c + 2] = x[2] - x[1];
+      t[4 * c + 3] = x[1] - x[3];
+    }
+
+    for (size_t r = 0; r < 4; ++r)
+    {
+      v[r] = t[r] - t[8 + r];
+      v[4 + r] = t[4 + r] + t[8 + r];
+      v[8 + r] = t[8 + r] - t[4 + r];
+      v[12 + r] = t[4 + r] - t[12 + r];
+    }
+  }
+
+  /**
+   * Compute the 2x2 output tile A^T m A of the 4x4 product m, where
+   * A^T = [1 1 1 0; 0 1 -1 -1].
+   */
+  template<typename eT>
+  static void OutputTransform(const eT* m, eT* y)
+  {
+    // First compute the 2x4 matrix A^T m.
+    eT t[8];
+    for (size_t c = 0; c < 4; ++c)
+    {
+      const eT* x = m + 4 * c;
+      t[2 * c] = x[0] + x[1] + x[2];
+      t[2 * c + 1] = x[1] - x[2] - x[3];
+    }
+
+    for (size_t r = 0; r < 2; ++r)
+    {
+      y[r] = t[r] + t[2 + r] + t[4 + r];
+      y[2 + r] = t[2 + r] - t[4 + r] - t[6 + r];
+    }
+  }
+};  // class WinogradConvolution
+
+} // namespace mlpack
+
+#endif
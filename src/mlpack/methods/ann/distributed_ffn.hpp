@@ -0,0 +1,212 @@
+/**
+ * @file methods/ann/distributed_ffn.hpp
+ *
+ * Definition of the DistributedFFN class, which trains a feedforward network
+ * with synchronous data parallelism across MPI processes.
+ *
+ * This file is not included by mlpack.hpp or ann.hpp, since it requires MPI;
+ * include it directly, and compile and link the program with MPI (e.g. with
+ * `mpicxx`).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DISTRIBUTED_FFN_HPP
+#define MLPACK_METHODS_ANN_DISTRIBUTED_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mpi.h>
+
+#include "ffn.hpp"
+
+namespace mlpack {
+
+/**
+ * DistributedFFN trains an FFN on data that is spread across the processes of
+ * an MPI communicator, with synchronous data parallelism.  Each process holds
+ * a copy of the network and its own shard of the training data (see
+ * `Shard()`).  All processes start from the parameters of the first process;
+ * then, for each batch, each process computes the gradient on its own shard,
+ * and the gradients of all the processes are summed with a ring all-reduce of
+ * the (contiguous) parameter gradient, so every process takes the same step
+ * and the copies of the network stay identical.  Training on P processes with
+ * a batch size of B is therefore equivalent to training on one process with a
+ * batch size of P * B.
+ *
+ * `Train()` must be called on every process of the communicator at the same
+ * time, with the same optimizer settings.  For example:
+ *
+ * @code
+ * MPI_Init(&argc, &argv);
+ *
+ * arma::mat data, labels;
+ * // ... load the data set on every process ...
+ * arma::mat localData, localLabels;
+ * DistributedFFN<NegativeLogLikelihood>::Shard(data, localData);
+ * DistributedFFN<NegativeLogLikelihood>::Shard(labels, localLabels);
+ *
+ * FFN<NegativeLogLikelihood> model;
+ * // ... add layers ...
+ * DistributedFFN<NegativeLogLikelihood> trainer(model);
+ * trainer.Train(localData, localLabels, optimizer);
+ * trainer.SaveCheckpoint("model.bin");
+ *
+ * MPI_Finalize();
+ * @endcode
+ *
+ * The `Replicas()` of the network can still be used to split the batches of
+ * each process across its threads.
+ *
+ * @tparam OutputLayerType The output layer type of the network.
+ * @tparam InitializationRuleType Rule used to initialize the weights.
+ * @tparam MatType Matrix type used by the network; its element type must be
+ *     `float` or `double`.
+ */
+template<typename OutputLayerType = NegativeLogLikelihood,
+         typename InitializationRuleType = RandomInitialization,
+         typename MatType = arma::mat>
+class DistributedFFN
+{
+ public:
+  //! The type of the network that is trained.
+  typedef FFN<OutputLayerType, InitializationRuleType, MatType> NetworkType;
+
+  /**
+   * Create the trainer for the given network.  The network is not copied, so
+   * it must outlive the trainer.
+   *
+   * @param network Network to train; it may already contain parameters.
+   * @param communicator Communicator of the processes that train the network.
+   */
+  DistributedFFN(NetworkType& network,
+                 MPI_Comm communicator = MPI_COMM_WORLD);
+
+  /**
+   * Train the network on the data of all the processes.  Each process passes
+   * its own shard of the data; every process only uses as many points as the
+   * process with the smallest shard, so that all the processes take the same
+   * number of steps.
+   *
+   * @param predictors Input training variables of this process.
+   * @param responses Output results of this process.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model, summed over all the
+   *      processes.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(MatType predictors,
+                                    MatType responses,
+                                    OptimizerType& optimizer,
+                                    CallbackTypes&&... callbacks);
+
+  /**
+   * Save the network to the given file (with `data::Save()`), from the first
+   * process only; since the copies of the network are identical after
+   * training, this is a checkpoint of the model.  This must be called on every
+   * process, and returns once the file has been written.
+   *
+   * @param filename File to save the network to.
+   * @param name Name of the network in the file.
+   * @return Whether the file was written successfully (on every process).
+   */
+  bool SaveCheckpoint(const std::string& filename,
+                      const std::string& name = "network") const;
+
+  /**
+   * Take the contiguous part of the given data set (one point per column) that
+   * belongs to this process; the points are split as evenly as possible
+   * across the processes.
+   *
+   * @param data Full data set, which must be the same on every process.
+   * @param localData Will be set to the part of the data for this process.
+   * @param communicator Communicator of the processes.
+   */
+  static void Shard(const MatType& data,
+                    MatType& localData,
+                    MPI_Comm communicator = MPI_COMM_WORLD);
+
+  /**
+   * Sum the given matrix over all the processes, in place, with a ring
+   * all-reduce: the matrix is split into one chunk per process, the chunks are
+   * summed while they are passed around the ring, and the summed chunks are
+   * then passed around the ring again.  Each process sends and receives about
+   * twice the size of the matrix, however many processes there are, and every
+   * process gets exactly the same result.
+   *
+   * @param m Matrix to sum; it must have the same size on every process.
+   */
+  void AllReduce(MatType& m);
+
+  //! Get the rank of this process.
+  int Rank() const { return rank; }
+  //! Get the number of processes.
+  int Size() const { return size; }
+
+  /**
+   * Note: the functions below are implemented so that the trainer can be used
+   * by ensmallen's optimizers.  They are not generally meant to be used
+   * otherwise.  Each one evaluates the network on the data of this process,
+   * and sums the result over all the processes.
+   */
+
+  //! Evaluate the objective over all the data.
+  typename MatType::elem_type Evaluate(const MatType& parameters);
+
+  //! Evaluate the objective on the given batch.
+  typename MatType::elem_type Evaluate(const MatType& parameters,
+                                       const size_t begin,
+                                       const size_t batchSize);
+
+  //! Evaluate the objective and the gradient over all the data.
+  typename MatType::elem_type EvaluateWithGradient(const MatType& parameters,
+                                                   MatType& gradient);
+
+  //! Evaluate the objective and the gradient on the given batch.
+  typename MatType::elem_type EvaluateWithGradient(const MatType& parameters,
+                                                   const size_t begin,
+                                                   MatType& gradient,
+                                                   const size_t batchSize);
+
+  //! Evaluate the gradient on the given batch.
+  void Gradient(const MatType& parameters,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize);
+
+  //! Return the number of separable functions (the number of points of this
+  //! process, which is the same on every process).
+  size_t NumFunctions() const { return network.NumFunctions(); }
+
+  //! Shuffle the data of this process.
+  void Shuffle() { network.Shuffle(); }
+
+ private:
+  //! Sum the given objective over all the processes.
+  typename MatType::elem_type SumObjective(
+      const typename MatType::elem_type objective);
+
+  //! The MPI type of the elements of MatType.
+  static MPI_Datatype ElemType();
+
+  //! The network to train.
+  NetworkType& network;
+  //! The processes that train the network.
+  MPI_Comm communicator;
+  //! The rank of this process.
+  int rank;
+  //! The number of processes.
+  int size;
+  //! Memory for the chunk received in each step of the all-reduce.
+  MatType buffer;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "distributed_ffn_impl.hpp"
+
+#endif
@@ -0,0 +1,298 @@
+/**
+ * @file methods/ann/distributed_ffn_impl.hpp
+ *
+ * Implementation of the DistributedFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DISTRIBUTED_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_DISTRIBUTED_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "distributed_ffn.hpp"
+
+namespace mlpack {
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::DistributedFFN(NetworkType& network, MPI_Comm communicator) :
+    network(network),
+    communicator(communicator)
+{
+  MPI_Comm_rank(communicator, &rank);
+  MPI_Comm_size(communicator, &size);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(MatType predictors,
+         MatType responses,
+         OptimizerType& optimizer,
+         CallbackTypes&&... callbacks)
+{
+  if (predictors.n_cols != responses.n_cols)
+  {
+    throw std::invalid_argument("DistributedFFN::Train(): number of "
+        "predictors does not match number of responses!");
+  }
+
+  // Every process must take the same number of steps, or the all-reduce of
+  // the gradients would deadlock.
+  unsigned long localPoints = predictors.n_cols;
+  unsigned long points = 0;
+  MPI_Allreduce(&localPoints, &points, 1, MPI_UNSIGNED_LONG, MPI_MIN,
+      communicator);
+  if (points == 0)
+  {
+    throw std::invalid_argument("DistributedFFN::Train(): every process must "
+        "have at least one training point!");
+  }
+
+  if (points < localPoints)
+  {
+    Log::Warn << "DistributedFFN::Train(): only using " << points << " of the "
+        << localPoints << " points of process " << rank << ", so that every "
+        << "process uses the same number of points." << std::endl;
+    predictors.shed_cols(points, predictors.n_cols - 1);
+    responses.shed_cols(points, responses.n_cols - 1);
+  }
+
+  network.ResetData(std::move(predictors), std::move(responses));
+  network.Unfreeze();
+  network.template WarnMessageMaxIterations<OptimizerType>(optimizer, points);
+  network.CheckNetwork("DistributedFFN::Train()",
+      network.predictors.n_rows, true, true);
+
+  // All the processes start from the parameters of the first process.
+  MatType& parameters = network.parameters;
+  MPI_Bcast(parameters.memptr(), (int) parameters.n_elem, ElemType(), 0,
+      communicator);
+
+  const typename MatType::elem_type out = network.Optimize(*this, optimizer,
+      callbacks...);
+
+  Log::Info << "DistributedFFN::Train(): final objective of trained model is "
+      << out << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+bool DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SaveCheckpoint(const std::string& filename, const std::string& name) const
+{
+  int success = 1;
+  if (rank == 0)
+    success = data::Save(filename, name, network) ? 1 : 0;
+
+  // Make sure that every process knows whether the checkpoint was written.
+  MPI_Bcast(&success, 1, MPI_INT, 0, communicator);
+  return (success == 1);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Shard(const MatType& data, MatType& localData, MPI_Comm communicator)
+{
+  int rank, size;
+  MPI_Comm_rank(communicator, &rank);
+  MPI_Comm_size(communicator, &size);
+
+  const size_t begin = rank * data.n_cols / size;
+  const size_t end = (rank + 1) * data.n_cols / size;
+  if (begin == end)
+    localData.set_size(data.n_rows, 0);
+  else
+    localData = data.cols(begin, end - 1);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::AllReduce(MatType& m)
+{
+  if (size == 1)
+    return;
+
+  // Chunk c of the matrix is [c * n / size, (c + 1) * n / size).
+  const size_t n = m.n_elem;
+  typename MatType::elem_type* data = m.memptr();
+  const size_t next = (rank + 1) % size;
+  const size_t prev = (rank + size - 1) % size;
+  buffer.set_size(n / size + 1, 1);
+
+  // First, pass the chunks around the ring, each process adding its own
+  // values to the chunk it receives.  After size - 1 steps, chunk
+  // (rank + 1) % size holds the sum over all the processes.
+  for (size_t step = 0; step < (size_t) size - 1; ++step)
+  {
+    const size_t sendChunk = (rank + size - step) % size;
+    const size_t recvChunk = (rank + 2 * size - step - 1) % size;
+    const size_t sendBegin = sendChunk * n / size;
+    const size_t sendEnd = (sendChunk + 1) * n / size;
+    const size_t recvBegin = recvChunk * n / size;
+    const size_t recvEnd = (recvChunk + 1) * n / size;
+
+    MPI_Sendrecv(data + sendBegin, (int) (sendEnd - sendBegin), ElemType(),
+        (int) next, 0, buffer.memptr(), (int) (recvEnd - recvBegin),
+        ElemType(), (int) prev, 0, communicator, MPI_STATUS_IGNORE);
+
+    for (size_t i = recvBegin; i < recvEnd; ++i)
+      data[i] += buffer[i - recvBegin];
+  }
+
+  // Then pass the summed chunks around the ring, so that each process gets
+  // all of them.
+  for (size_t step = 0; step < (size_t) size - 1; ++step)
+  {
+    const size_t sendChunk = (rank + size + 1 - step) % size;
+    const size_t recvChunk = (rank + size - step) % size;
+    const size_t sendBegin = sendChunk * n / size;
+    const size_t sendEnd = (sendChunk + 1) * n / size;
+    const size_t recvBegin = recvChunk * n / size;
+    const size_t recvEnd = (recvChunk + 1) * n / size;
+
+    MPI_Sendrecv(data + sendBegin, (int) (sendEnd - sendBegin), ElemType(),
+        (int) next, 0, data + recvBegin, (int) (recvEnd - recvBegin),
+        ElemType(), (int) prev, 0, communicator, MPI_STATUS_IGNORE);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Evaluate(const MatType& parameters)
+{
+  return SumObjective(network.Evaluate(parameters));
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Evaluate(const MatType& parameters,
+            const size_t begin,
+            const size_t batchSize)
+{
+  return SumObjective(network.Evaluate(parameters, begin, batchSize));
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::EvaluateWithGradient(const MatType& parameters, MatType& gradient)
+{
+  const typename MatType::elem_type objective =
+      network.EvaluateWithGradient(parameters, gradient);
+  AllReduce(gradient);
+  return SumObjective(objective);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::EvaluateWithGradient(const MatType& parameters,
+                        const size_t begin,
+                        MatType& gradient,
+                        const size_t batchSize)
+{
+  const typename MatType::elem_type objective =
+      network.EvaluateWithGradient(parameters, begin, gradient, batchSize);
+  AllReduce(gradient);
+  return SumObjective(objective);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Gradient(const MatType& parameters,
+            const size_t begin,
+            MatType& gradient,
+            const size_t batchSize)
+{
+  network.Gradient(parameters, begin, gradient, batchSize);
+  AllReduce(gradient);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+typename MatType::elem_type DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SumObjective(const typename MatType::elem_type objective)
+{
+  double localObjective = objective;
+  double totalObjective = 0.0;
+  MPI_Allreduce(&localObjective, &totalObjective, 1, MPI_DOUBLE, MPI_SUM,
+      communicator);
+  return typename MatType::elem_type(totalObjective);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+MPI_Datatype DistributedFFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ElemType()
+{
+  static_assert(std::is_same<typename MatType::elem_type, float>::value ||
+      std::is_same<typename MatType::elem_type, double>::value,
+      "DistributedFFN: the element type must be float or double.");
+
+  return std::is_same<typename MatType::elem_type, float>::value ? MPI_FLOAT :
+      MPI_DOUBLE;
+}
+
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,11 @@
 #include "forward_decls.hpp"
 #include "init_rules/init_rules.hpp"
 #include "loss_functions/loss_functions.hpp"
+#include "inference_plan.hpp"
+#include "mixed_precision.hpp"
+#include "network_profiler.hpp"
+#include "async_checkpoint.hpp"
+#include "streaming_function.hpp"
 
 #include <ensmallen.hpp>
 
@@ -89,6 +94,7 @@ class FFN
   {
     network.template Add<LayerType>(args...);
     inputDimensionsAreSet = false;
+    Unfreeze();
   }
 
   /**
@@ -101,6 +107,7 @@ class FFN
   {
     network.Add(layer);
     inputDimensionsAreSet = false;
+    Unfreeze();
   }
 
   //! Get the layers of the network.
@@ -121,6 +128,7 @@ class FFN
     // We can no longer make any assumptions... the user may change anything.
     inputDimensionsAreSet = false;
     layerMemoryIsSet = false;
+    Unfreeze();
 
     return network.Network();
   }
@@ -190,6 +198,31 @@ class FFN
                                     MatType responses,
                                     CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on a data set that is read chunk by chunk
+   * from the given source, so that the whole data set never needs to be in
+   * memory.  While the network trains on one chunk, the next chunk is loaded
+   * by a background thread; when the optimizer shuffles the data, the order of
+   * the chunks is shuffled, and each chunk is shuffled when it is loaded (see
+   * `StreamingFunction`).  Optimizers that visit the points in order, such as
+   * the SGD-type optimizers, never wait for a chunk to load, as long as
+   * loading a chunk is faster than training on one.
+   *
+   * The network is initialized as in the other overloads of `Train()`.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param source Source of the training data.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(BatchSource<MatType>& source,
+                                    OptimizerType& optimizer,
+                                    CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will be
    * the output of the output layer when `predictors` is passed through the
@@ -203,6 +236,80 @@ class FFN
                MatType& results,
                const size_t batchSize = 128);
 
+  /**
+   * Predict the responses to a given set of predictors with a frozen network
+   * (see `Freeze()`), without modifying the network: all intermediate state is
+   * kept in the given workspace.  This can be called by several threads at
+   * once, each with its own workspace, and all of them read the same copy of
+   * the parameters.
+   *
+   * A `std::logic_error` is thrown if the network is not frozen.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param workspace Workspace of the calling thread.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(const MatType& predictors,
+               MatType& results,
+               InferenceWorkspace<MatType>& workspace,
+               const size_t batchSize = 128) const;
+
+  /**
+   * Prepare the network for faster prediction.  This builds an inference plan
+   * (see `InferencePlan`) holding a copy of the layers and parameters, in which
+   * `BatchNorm` layers are folded into the weights of a preceding `Linear` or
+   * `Convolution` layer, activation layers run in place on the output of the
+   * layer before them, and intermediate outputs are stored in two reused
+   * buffers.  `Predict()` uses the plan until `Unfreeze()` is called.
+   *
+   * The network must have been trained or initialized.  Anything that may
+   * change the network or its parameters (`Train()`, `Reset()`, `Add()`, or
+   * the non-const `Parameters()`, `Network()` and `InputDimensions()`
+   * accessors) discards the plan.
+   */
+  void Freeze();
+
+  //! Discard the inference plan built by `Freeze()`, if any.
+  void Unfreeze()
+  {
+    if (Frozen())
+      inferencePlan = InferencePlan<MatType>();
+  }
+
+  //! Get whether the network is frozen for prediction with `Freeze()`.
+  bool Frozen() const { return !inferencePlan.Empty(); }
+
+  /**
+   * Quantize the trained network for faster, smaller inference: each `Linear`
+   * and `Convolution` layer is replaced with a `QuantizedLinear` or
+   * `QuantizedConvolution` layer, which stores its weights as int8 values with
+   * one scale per output unit or map, and quantizes its input to int8 with a
+   * scale computed from the largest absolute input seen on
+   * `calibrationData`.  The weights of the replaced layers are removed from
+   * `Parameters()`; quantized layers cannot be trained.  (Convolution layers
+   * are only replaced if they use the naive or im2col convolution rules.)
+   *
+   * @param calibrationData Representative input points, used to choose the
+   *     quantization scales of the inputs of the quantized layers.
+   */
+  void Quantize(const MatType& calibrationData);
+
+  /**
+   * Prune the trained network for smaller, sparse inference: each `Linear`
+   * layer is replaced with a `SparseLinear` layer, which keeps only a part of
+   * its weights in sparse form.  With magnitude pruning, the given fraction of
+   * each layer's weights with the smallest absolute values is removed; with
+   * structured pruning, the given fraction of each layer's output units with
+   * the smallest weight norms is removed.  The weights of the replaced layers
+   * are removed from `Parameters()`; pruned layers cannot be trained.
+   *
+   * @param sparsity Fraction of the weights (or output units) of each `Linear`
+   *     layer to remove, in [0, 1].
+   * @param structured If true, whole output units are removed.
+   */
+  void Prune(const double sparsity, const bool structured = false);
+
   // Return the number of weights in the model.
   size_t WeightSize();
 
@@ -225,6 +332,7 @@ class FFN
     // The user may change the input dimensions, so we will have to propagate
     // these changes to the network.
     inputDimensionsAreSet = false;
+    Unfreeze();
     return inputDimensions;
   }
   //! Get the logical dimensions of the input.
@@ -237,7 +345,55 @@ class FFN
   //! the weights of every layer.  Be careful!  If you change the shape of
   //! `parameters` to something incorrect, it may be re-initialized the next
   //! time a forward pass is done.
-  MatType& Parameters() { return parameters; }
+  MatType& Parameters()
+  {
+    Unfreeze();
+    return parameters;
+  }
+
+  //! Get the mixed-precision training policy (disabled by default).
+  const MixedPrecision& Precision() const { return precision; }
+  //! Modify the mixed-precision training policy.  When it is enabled,
+  //! `Train()` keeps `Parameters()` as full-precision master weights, but
+  //! computes the forward and backward passes with 16-bit weights and a scaled
+  //! loss; see `MixedPrecision` for more information.
+  MixedPrecision& Precision() { return precision; }
+
+  //! Get the number of replicas of the network used by `Train()`.
+  size_t Replicas() const { return numReplicas; }
+  /**
+   * Modify the number of replicas of the network used by `Train()` (1 by
+   * default).  With more than one replica, each batch is split into one shard
+   * per replica; the replicas run their forward and backward passes on their
+   * shards in parallel (with OpenMP), each with its own intermediate outputs
+   * but all sharing the parameters, and their gradients are summed.  The loss
+   * is still computed on the whole batch.
+   *
+   * This helps networks with small layers, where BLAS cannot use many threads
+   * for a single batch.  The result is the same as with one replica, except
+   * for layers whose training behavior depends on the whole batch: e.g.
+   * `BatchNorm` normalizes each shard on its own (and only the statistics of
+   * the first shard are kept), and layer regularizers are applied once per
+   * shard.
+   */
+  size_t& Replicas() { return numReplicas; }
+
+  /**
+   * Record the wall time, the memory written and the estimated floating-point
+   * operations of each pass of each layer in the given profiler, until
+   * `DisableProfiling()` is called; see `NetworkProfiler`.  The profiler is
+   * not reset, and it must outlive the profiling.
+   *
+   * @param profiler Profiler to record in.
+   */
+  void EnableProfiling(NetworkProfiler& profiler)
+  {
+    network.Profiler() = &profiler;
+  }
+
+  //! Stop recording the passes of each layer in the profiler given to
+  //! `EnableProfiling()`.
+  void DisableProfiling() { network.Profiler() = NULL; }
 
   /**
    * Reset the stored data of the network entirely.  This resets all weights of
@@ -443,6 +599,25 @@ class FFN
  private:
   // Helper functions.
 
+  /**
+   * Optimize the parameters of the network on the data set with
+   * `ResetData()`, by passing the given function to the optimizer.  The
+   * function is usually the network itself, but may wrap it instead (see
+   * `DistributedFFN`).  The network must already have been checked with
+   * `CheckNetwork()`.
+   *
+   * @param function Function to optimize.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   * @return The final objective of the trained model.
+   */
+  template<typename FunctionType,
+           typename OptimizerType,
+           typename... CallbackTypes>
+  typename MatType::elem_type Optimize(FunctionType& function,
+                                       OptimizerType& optimizer,
+                                       CallbackTypes&&... callbacks);
+
   //! Use the InitializationPolicy to initialize all the weights in the network.
   void InitializeWeights();
 
@@ -450,6 +625,25 @@ class FFN
   //! SetWeightPtr() on each layer.
   void SetLayerMemory();
 
+  //! Make the memory of each layer point to a copy of the given parameters
+  //! that is rounded to the 16-bit type of the mixed-precision policy.
+  void SetWorkingWeights(const MatType& parameters);
+
+  //! Get the replica of the network that processes the given shard of a
+  //! batch; the first shard is processed by the network itself.
+  MultiLayer<MatType>& Replica(const size_t shard)
+  {
+    return (shard == 0) ? network : replicas[shard - 1];
+  }
+
+  //! Compute networkOutput for the given batch, with each replica of the
+  //! network processing one shard of the batch.
+  void ParallelForward(const MatType& predictorsBatch);
+
+  //! Compute networkDelta and the gradient for the given batch from error,
+  //! with each replica of the network processing one shard of the batch.
+  void ParallelBackward(const MatType& predictorsBatch, MatType& gradient);
+
   /**
    * Ensure that all the locally-cached information about the network is valid,
    * all parameter memory is initialized, and we can make forward and backward
@@ -547,6 +741,22 @@ class FFN
   //! Locally-stored error of the backward pass; used by the gradient pass.
   MatType error;
 
+  //! The plan used by Predict() when the network is frozen; empty otherwise.
+  InferencePlan<MatType> inferencePlan;
+
+  //! The mixed-precision training policy.
+  MixedPrecision precision;
+  //! The 16-bit copy of the parameters used during mixed-precision training.
+  MatType workingParameters;
+
+  //! The number of replicas of the network used by Train().
+  size_t numReplicas;
+  //! The replicas of the network, other than the network itself; these only
+  //! exist during Train().
+  std::vector<MultiLayer<MatType>> replicas;
+  //! The gradient computed by each replica in `replicas`.
+  std::vector<MatType> replicaGradients;
+
   //! If true, each layer has its memory properly set for a forward/backward
   //! pass.
   bool layerMemoryIsSet;
@@ -557,6 +767,9 @@ class FFN
 
   // RNN will call `CheckNetwork()`, which is private.
   friend class RNN<OutputLayerType, InitializationRuleType, MatType>;
+  // DistributedFFN will call `CheckNetwork()` and `Optimize()`.
+  template<typename, typename, typename>
+  friend class DistributedFFN;
 }; // class FFN
 
 } // namespace mlpack
@@ -27,6 +27,7 @@ FFN<
 >::FFN(OutputLayerType outputLayer, InitializationRuleType initializeRule) :
     outputLayer(std::move(outputLayer)),
     initializeRule(std::move(initializeRule)),
+    numReplicas(1),
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
 {
@@ -48,6 +49,9 @@ FFN<
     inputDimensions(network.inputDimensions),
     predictors(network.predictors),
     responses(network.responses),
+    inferencePlan(network.inferencePlan),
+    precision(network.precision),
+    numReplicas(network.numReplicas),
     // These will be set correctly in the first Forward() call.
     layerMemoryIsSet(false),
     inputDimensionsAreSet(false)
@@ -70,6 +74,9 @@ FFN<
     inputDimensions(std::move(network.inputDimensions)),
     predictors(std::move(network.predictors)),
     responses(std::move(network.responses)),
+    inferencePlan(std::move(network.inferencePlan)),
+    precision(std::move(network.precision)),
+    numReplicas(network.numReplicas),
     // Aliases will not be correct after a std::move(), so we will manually
     // reset them.
     layerMemoryIsSet(false),
@@ -96,6 +103,9 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     inputDimensions = other.inputDimensions;
     predictors = other.predictors;
     responses = other.responses;
+    inferencePlan = other.inferencePlan;
+    precision = other.precision;
+    numReplicas = other.numReplicas;
     networkOutput = other.networkOutput;
     networkDelta = other.networkDelta;
     error = other.error;
@@ -127,6 +137,9 @@ FFN<OutputLayerType, InitializationRuleType, MatType>& FFN<
     inputDimensions = std::move(other.inputDimensions);
     predictors = std::move(other.predictors);
     responses = std::move(other.responses);
+    inferencePlan = std::move(other.inferencePlan);
+    precision = std::move(other.precision);
+    numReplicas = other.numReplicas;
     networkOutput = std::move(other.networkOutput);
     networkDelta = std::move(other.networkDelta);
     error = std::move(other.error);
@@ -151,6 +164,7 @@ typename MatType::elem_type FFN<
          CallbackTypes&&... callbacks)
 {
   ResetData(std::move(predictors), std::move(responses));
+  Unfreeze();
 
   WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
 
@@ -158,13 +172,79 @@ typename MatType::elem_type FFN<
   CheckNetwork("FFN::Train()", this->predictors.n_rows, true, true);
 
   // Train the model.
+  const typename MatType::elem_type out = Optimize(*this, optimizer,
+      callbacks...);
+
+  Log::Info << "FFN::Train(): final objective of trained model is " << out
+      << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(BatchSource<MatType>& source,
+         OptimizerType& optimizer,
+         CallbackTypes&&... callbacks)
+{
+  Unfreeze();
+
+  // This gives the first chunk of the data to the network.
+  StreamingFunction<FFN, MatType> function(*this, source);
+
+  WarnMessageMaxIterations<OptimizerType>(optimizer, function.NumFunctions());
+
+  // Ensure that the network can be used.
+  CheckNetwork("FFN::Train()", this->predictors.n_rows, true, true);
+
+  const typename MatType::elem_type out = Optimize(function, optimizer,
+      callbacks...);
+
+  Log::Info << "FFN::Train(): final objective of trained model is " << out
+      << "; " << function.ChunksLoaded() << " chunks were loaded." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+template<typename FunctionType,
+         typename OptimizerType,
+         typename... CallbackTypes>
+typename MatType::elem_type FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Optimize(FunctionType& function,
+            OptimizerType& optimizer,
+            CallbackTypes&&... callbacks)
+{
+  // The replicas are copies of the network with their own intermediate
+  // outputs; their weights are pointed at the parameters for each batch.
+  replicas.assign((numReplicas > 1) ? numReplicas - 1 : 0, network);
+
+  MLPACK_PROFILE_SCOPE("ffn_optimization");
   Timer::Start("ffn_optimization");
   const typename MatType::elem_type out =
-      optimizer.Optimize(*this, parameters, callbacks...);
+      optimizer.Optimize(function, parameters, callbacks...);
   Timer::Stop("ffn_optimization");
 
-  Log::Info << "FFN::Train(): final objective of trained model is " << out
-      << "." << std::endl;
+  replicas.clear();
+  replicaGradients.clear();
+
+  // With mixed precision, the layers still point at the 16-bit copy of the
+  // parameters, so point them back at the master weights.
+  if (precision.Enabled())
+  {
+    layerMemoryIsSet = false;
+    workingParameters.clear();
+  }
+
   return out;
 }
 
@@ -194,8 +274,24 @@ void FFN<
     MatType
 >::Predict(const MatType& predictors, MatType& results, const size_t batchSize)
 {
-  // Ensure that the network is configured correctly.
-  CheckNetwork("FFN::Predict()", predictors.n_rows, true, false);
+  // Ensure that the network is configured correctly.  A frozen network was
+  // checked when the plan was built, so we only need to check the input size.
+  if (Frozen())
+  {
+    size_t inputSize = 1;
+    for (size_t i = 0; i < inputDimensions.size(); ++i)
+      inputSize *= inputDimensions[i];
+
+    if (predictors.n_rows != inputSize)
+    {
+      throw std::logic_error("FFN::Predict(): input size does not match "
+          "expected size set with InputDimensions()!");
+    }
+  }
+  else
+  {
+    CheckNetwork("FFN::Predict()", predictors.n_rows, true, false);
+  }
 
   results.set_size(network.OutputSize(), predictors.n_cols);
 
@@ -211,8 +307,212 @@ void FFN<
     MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
         i * results.n_rows);
 
-    network.Forward(predictorAlias, resultAlias);
+    if (Frozen())
+      inferencePlan.Forward(predictorAlias, resultAlias);
+    else
+      network.Forward(predictorAlias, resultAlias);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(const MatType& predictors,
+           MatType& results,
+           InferenceWorkspace<MatType>& workspace,
+           const size_t batchSize) const
+{
+  if (!Frozen())
+  {
+    throw std::logic_error("FFN::Predict(): the network must be frozen with "
+        "Freeze() to predict with a workspace!");
+  }
+
+  size_t inputSize = 1;
+  for (size_t i = 0; i < inputDimensions.size(); ++i)
+    inputSize *= inputDimensions[i];
+
+  if (predictors.n_rows != inputSize)
+  {
+    throw std::logic_error("FFN::Predict(): input size does not match "
+        "expected size set with InputDimensions()!");
+  }
+
+  results.set_size(inferencePlan.OutputSize(), predictors.n_cols);
+
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+
+    MatType predictorAlias, resultAlias;
+
+    MakeAlias(predictorAlias, predictors, predictors.n_rows,
+        effectiveBatchSize, i * predictors.n_rows);
+    MakeAlias(resultAlias, results, results.n_rows, effectiveBatchSize,
+        i * results.n_rows);
+
+    inferencePlan.Forward(predictorAlias, resultAlias, workspace);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Freeze()
+{
+  if (parameters.is_empty())
+  {
+    throw std::invalid_argument("FFN::Freeze(): the network must be trained or "
+        "initialized before it can be frozen!");
+  }
+
+  // Make sure the layers point at the parameters and are in testing mode; the
+  // plan copies them in that state.
+  CheckNetwork("FFN::Freeze()", 0, true, false);
+  inferencePlan = InferencePlan<MatType>(network.Network(), parameters);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Quantize(const MatType& calibrationData)
+{
+  typedef ConvolutionType<
+      NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      MatType
+  > NaiveConvolutionType;
+  typedef ConvolutionType<
+      Im2ColConvolution<ValidConvolution>,
+      Im2ColConvolution<FullConvolution>,
+      Im2ColConvolution<ValidConvolution>,
+      MatType
+  > Im2ColConvolutionType;
+
+  CheckNetwork("FFN::Quantize()", calibrationData.n_rows, true, false);
+  Unfreeze();
+
+  // Pass the calibration data through the network one layer at a time, so that
+  // we see the input of each layer we replace.  The weights of the layers we
+  // keep are moved to the front of the parameters.
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  MatType input, output;
+  const MatType* current = &calibrationData;
+  size_t offset = 0, quantizedOffset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    Layer<MatType>* layer = layers[i];
+    const size_t weightSize = layer->WeightSize();
+
+    output.set_size(layer->OutputSize(), calibrationData.n_cols);
+    layer->Forward(*current, output);
+
+    const double inputScale = QuantizationScale(abs(*current).max());
+    Layer<MatType>* quantized = NULL;
+    if (LinearType<MatType>* linear = dynamic_cast<LinearType<MatType>*>(layer))
+    {
+      quantized = new QuantizedLinearType<MatType>(*linear, inputScale);
+    }
+    else if (NaiveConvolutionType* conv =
+        dynamic_cast<NaiveConvolutionType*>(layer))
+    {
+      quantized = new QuantizedConvolutionType<MatType>(*conv, inputScale);
+    }
+    else if (Im2ColConvolutionType* conv =
+        dynamic_cast<Im2ColConvolutionType*>(layer))
+    {
+      quantized = new QuantizedConvolutionType<MatType>(*conv, inputScale);
+    }
+
+    if (quantized != NULL)
+    {
+      delete layer;
+      layers[i] = quantized;
+    }
+    else if (weightSize > 0)
+    {
+      parameters.rows(quantizedOffset, quantizedOffset + weightSize - 1) =
+          parameters.rows(offset, offset + weightSize - 1);
+      quantizedOffset += weightSize;
+    }
+
+    offset += weightSize;
+    input = std::move(output);
+    current = &input;
   }
+
+  parameters.resize(quantizedOffset, 1);
+
+  // The layers and the parameters have changed, so everything will be set up
+  // again the next time the network is used.
+  layerMemoryIsSet = false;
+  inputDimensionsAreSet = false;
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Prune(const double sparsity, const bool structured)
+{
+  if (sparsity < 0.0 || sparsity > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "FFN::Prune(): sparsity must be in [0, 1], but " << sparsity
+        << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  CheckNetwork("FFN::Prune()", 0, true, false);
+  Unfreeze();
+
+  // The weights of the layers we keep are moved to the front of the
+  // parameters.
+  std::vector<Layer<MatType>*>& layers = network.Network();
+  size_t offset = 0, prunedOffset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    Layer<MatType>* layer = layers[i];
+    const size_t weightSize = layer->WeightSize();
+
+    if (LinearType<MatType>* linear = dynamic_cast<LinearType<MatType>*>(layer))
+    {
+      layers[i] = new SparseLinearType<MatType>(*linear, sparsity, structured);
+      delete layer;
+    }
+    else if (weightSize > 0)
+    {
+      parameters.rows(prunedOffset, prunedOffset + weightSize - 1) =
+          parameters.rows(offset, offset + weightSize - 1);
+      prunedOffset += weightSize;
+    }
+
+    offset += weightSize;
+  }
+
+  parameters.resize(prunedOffset, 1);
+
+  // The layers and the parameters have changed, so everything will be set up
+  // again the next time the network is used.
+  layerMemoryIsSet = false;
+  inputDimensionsAreSet = false;
 }
 
 template<typename OutputLayerType,
@@ -240,6 +540,7 @@ void FFN<
 >::Reset(const size_t inputDimensionality)
 {
   parameters.clear();
+  Unfreeze();
 
   // If the user provided an input dimensionality, then we will take that as the
   // new input size.  Otherwise, if anything is currently specified in
@@ -410,6 +711,7 @@ void FFN<
 
       layerMemoryIsSet = false;
       inputDimensionsAreSet = false;
+      Unfreeze();
 
       // The weights in `parameters` will be correctly set for each layer in the
       // first call to Forward().
@@ -440,11 +742,13 @@ typename MatType::elem_type FFN<
     OutputLayerType,
     InitializationRuleType,
     MatType
->::Evaluate(const MatType& /* parameters */,
+>::Evaluate(const MatType& parameters,
             const size_t begin,
             const size_t batchSize)
 {
   CheckNetwork("FFN::Evaluate()", predictors.n_rows);
+  if (precision.Enabled())
+    SetWorkingWeights(parameters);
 
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
@@ -493,6 +797,8 @@ typename MatType::elem_type FFN<
                         const size_t batchSize)
 {
   CheckNetwork("FFN::EvaluateWithGradient()", predictors.n_rows);
+  if (precision.Enabled())
+    SetWorkingWeights(parameters);
 
   // Set networkOutput to the right size if needed, then perform the forward
   // pass.
@@ -505,7 +811,12 @@ typename MatType::elem_type FFN<
   MakeAlias(responsesBatch, responses, responses.n_rows,
       batchSize, begin * responses.n_rows);
 
-  network.Forward(predictorsBatch, networkOutput);
+  // Only split the batch if every replica gets at least one point.
+  const bool parallel = !replicas.empty() && batchSize > replicas.size();
+  if (parallel)
+    ParallelForward(predictorsBatch);
+  else
+    network.Forward(predictorsBatch, networkOutput);
 
   const typename MatType::elem_type obj = outputLayer.Forward(networkOutput,
       responsesBatch) + network.Loss();
@@ -513,14 +824,31 @@ typename MatType::elem_type FFN<
   // Now perform the backward pass.
   outputLayer.Backward(networkOutput, responsesBatch, error);
 
+  // With mixed precision, the loss is scaled so that small gradients stay
+  // representable in 16 bits; UnscaleGradient() undoes that below.
+  if (precision.Enabled())
+    error *= precision.LossScale();
+
   // The delta should have the same size as the input.
   networkDelta.set_size(predictors.n_rows, batchSize);
-  network.Backward(predictorsBatch, networkOutput, error, networkDelta);
 
   // Now compute the gradients.
   // The gradient should have the same size as the parameters.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  network.Gradient(predictorsBatch, error, gradient);
+  if (parallel)
+  {
+    ParallelBackward(predictorsBatch, gradient);
+  }
+  else
+  {
+    network.Backward(predictorsBatch, networkOutput, error, networkDelta);
+    network.Gradient(predictorsBatch, error, gradient);
+  }
+
+  // If the scaled gradient overflowed, it is set to zero, so the step is
+  // skipped.
+  if (precision.Enabled())
+    precision.UnscaleGradient(gradient);
 
   return obj;
 }
@@ -603,6 +931,106 @@ void FFN<
   layerMemoryIsSet = true;
 }
 
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::SetWorkingWeights(const MatType& parameters)
+{
+  // The optimizer only updates the master weights, so the working copy is
+  // rounded again for every batch.  Assigning to a working copy of the same
+  // size reuses its memory.
+  workingParameters = parameters;
+  precision.Round(workingParameters);
+  network.SetWeights(workingParameters);
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ParallelForward(const MatType& predictorsBatch)
+{
+  // The layers of the network itself already point at the right weights.
+  const MatType& weights = precision.Enabled() ? workingParameters :
+      parameters;
+  for (size_t i = 0; i < replicas.size(); ++i)
+  {
+    replicas[i].Training() = network.Training();
+    replicas[i].SetWeights(weights);
+  }
+
+  const size_t shards = replicas.size() + 1;
+  const size_t batchSize = predictorsBatch.n_cols;
+
+  #pragma omp parallel for
+  for (size_t shard = 0; shard < shards; ++shard)
+  {
+    const size_t begin = shard * batchSize / shards;
+    const size_t end = (shard + 1) * batchSize / shards;
+
+    MatType input, output;
+    MakeAlias(input, predictorsBatch, predictorsBatch.n_rows, end - begin,
+        begin * predictorsBatch.n_rows);
+    MakeAlias(output, networkOutput, networkOutput.n_rows, end - begin,
+        begin * networkOutput.n_rows);
+    Replica(shard).Forward(input, output);
+  }
+}
+
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename MatType>
+void FFN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ParallelBackward(const MatType& predictorsBatch, MatType& gradient)
+{
+  const size_t shards = replicas.size() + 1;
+  const size_t batchSize = predictorsBatch.n_cols;
+  replicaGradients.resize(replicas.size());
+
+  #pragma omp parallel for
+  for (size_t shard = 0; shard < shards; ++shard)
+  {
+    const size_t begin = shard * batchSize / shards;
+    const size_t end = (shard + 1) * batchSize / shards;
+
+    MatType input, output, shardError, delta;
+    MakeAlias(input, predictorsBatch, predictorsBatch.n_rows, end - begin,
+        begin * predictorsBatch.n_rows);
+    MakeAlias(output, networkOutput, networkOutput.n_rows, end - begin,
+        begin * networkOutput.n_rows);
+    MakeAlias(shardError, error, error.n_rows, end - begin,
+        begin * error.n_rows);
+    MakeAlias(delta, networkDelta, networkDelta.n_rows, end - begin,
+        begin * networkDelta.n_rows);
+
+    MatType& shardGradient = (shard == 0) ? gradient :
+        replicaGradients[shard - 1];
+    shardGradient.set_size(gradient.n_rows, gradient.n_cols);
+
+    Replica(shard).Backward(input, output, shardError, delta);
+    Replica(shard).Gradient(input, shardError, shardGradient);
+  }
+
+  // Sum the gradients of the replicas into the gradient.
+  typename MatType::elem_type* g = gradient.memptr();
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) gradient.n_elem; ++i)
+  {
+    for (size_t r = 0; r < replicaGradients.size(); ++r)
+      g[i] += replicaGradients[r][i];
+  }
+}
+
 template<typename OutputLayerType,
          typename InitializationRuleType,
          typename MatType>
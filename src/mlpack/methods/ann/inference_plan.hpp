@@ -0,0 +1,248 @@
+/**
+ * @file methods/ann/inference_plan.hpp
+ *
+ * Definition of the InferencePlan class, which holds a copy of the layers of a
+ * trained network that is prepared for prediction only.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INFERENCE_PLAN_HPP
+#define MLPACK_METHODS_ANN_INFERENCE_PLAN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer.hpp"
+
+namespace mlpack {
+
+// Forward declaration.
+template<typename MatType>
+class InferencePlan;
+
+/**
+ * An InferenceWorkspace holds the state that one thread needs to run an
+ * `InferencePlan` (or predict with a frozen `FFN`) without modifying it: the
+ * buffer of intermediate outputs, and a copy of each layer object, since layers
+ * keep temporaries between calls.  The copies of the layers point at the
+ * parameters of the plan, so a workspace only costs the memory of the
+ * activations (and of any weights that a layer holds outside of its
+ * parameters, such as the int8 weights of the quantized layers).
+ *
+ * A workspace is prepared for a plan the first time it is used with it, and
+ * again whenever it is used with a different plan (e.g. after the network was
+ * frozen again).  A workspace must only be used by one thread at a time.
+ *
+ * @code
+ * model.Freeze();
+ *
+ * #pragma omp parallel
+ * {
+ *   InferenceWorkspace<> workspace;
+ *   arma::mat predictions;
+ *
+ *   #pragma omp for
+ *   for (size_t i = 0; i < requests.size(); ++i)
+ *     model.Predict(requests[i], predictions, workspace);
+ * }
+ * @endcode
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class InferenceWorkspace
+{
+ public:
+  //! Create an empty workspace, not prepared for any plan.
+  InferenceWorkspace() : planId(0) { }
+
+  //! A workspace cannot be copied; each thread should create its own.
+  InferenceWorkspace(const InferenceWorkspace&) = delete;
+  InferenceWorkspace& operator=(const InferenceWorkspace&) = delete;
+
+  //! Take ownership of the given workspace.
+  InferenceWorkspace(InferenceWorkspace&& other) :
+      layers(std::move(other.layers)),
+      buffer(std::move(other.buffer)),
+      planId(other.planId)
+  {
+    other.layers.clear();
+    other.planId = 0;
+  }
+
+  //! Destroy the workspace and the layers it holds.
+  ~InferenceWorkspace() { Clear(); }
+
+  //! Delete the layers of the workspace; it will be prepared again on its next
+  //! use.
+  void Clear()
+  {
+    for (size_t i = 0; i < layers.size(); ++i)
+      delete layers[i];
+    layers.clear();
+    planId = 0;
+  }
+
+ private:
+  //! The copies of the layers of the plan (owned by the workspace).
+  std::vector<Layer<MatType>*> layers;
+  //! The memory that intermediate outputs are stored in.
+  MatType buffer;
+  //! The identifier of the plan the layers were copied from (0 if none).
+  size_t planId;
+
+  // The plan prepares and uses the workspace.
+  friend class InferencePlan<MatType>;
+};
+
+/**
+ * An InferencePlan holds a copy of the layers of a trained network, with their
+ * own copy of the parameters, arranged to make the forward pass as cheap as
+ * possible.  It is built by `FFN::Freeze()`, and used by `FFN::Predict()`.
+ *
+ * When the plan is built:
+ *
+ *  - each `BatchNorm` layer that directly follows a layer that can absorb an
+ *    elementwise scale and shift (see `Layer::FoldAffine()`, implemented by
+ *    `Linear` and `Convolution`) is folded into the weights of that layer, and
+ *    removed from the plan;
+ *
+ *  - each layer whose forward pass can run in place (see
+ *    `Layer::ElementwiseForward()`, e.g. activation layers, `Dropout` and
+ *    `LayerNorm`) is run in place on the output of the layer before it,
+ *    instead of writing to a new matrix.
+ *
+ * During the forward pass, the layers that produce a new output alternate
+ * between the two halves of a single buffer, which is only reallocated when
+ * the batch size grows; the last such layer writes directly to the output.
+ * Nothing is kept for a backward pass, so a plan cannot be trained.
+ *
+ * The plan can also be run by several threads at once, with the overload of
+ * `Forward()` that takes an `InferenceWorkspace`: that overload does not modify
+ * the plan, and all the threads read the same parameters, while each thread
+ * uses the intermediate outputs and the layer objects of its own workspace.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class InferencePlan
+{
+ public:
+  //! Create an empty plan.
+  InferencePlan();
+
+  /**
+   * Build a plan from the given layers, which use the given parameters.  The
+   * layers should already be in testing mode.
+   *
+   * @param network Layers of the network, in order.
+   * @param parameters Parameters of all the layers.
+   */
+  InferencePlan(const std::vector<Layer<MatType>*>& network,
+                const MatType& parameters);
+
+  //! Copy the given plan.
+  InferencePlan(const InferencePlan& other);
+  //! Take ownership of the given plan.
+  InferencePlan(InferencePlan&& other);
+  //! Copy the given plan.
+  InferencePlan& operator=(const InferencePlan& other);
+  //! Take ownership of the given plan.
+  InferencePlan& operator=(InferencePlan&& other);
+
+  //! Destroy the plan and the layers it holds.
+  ~InferencePlan();
+
+  /**
+   * Compute the output of the network for the given input.
+   *
+   * @param input Input data, with one point per column.
+   * @param output Matrix to store the output in; it must already have the
+   *     right size.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Compute the output of the network for the given input, using the given
+   * workspace for all intermediate state.  The plan is not modified, so this
+   * can be called by several threads at once, each with its own workspace.
+   *
+   * @param input Input data, with one point per column.
+   * @param output Matrix to store the output in; it must already have the
+   *     right size.
+   * @param workspace Workspace of the calling thread.
+   */
+  void Forward(const MatType& input,
+               MatType& output,
+               InferenceWorkspace<MatType>& workspace) const;
+
+  //! Get whether the plan is empty.
+  bool Empty() const { return layers.empty(); }
+  //! Get the number of output elements of the network, for one point.
+  size_t OutputSize() const
+  {
+    return outputSizes.empty() ? 0 : outputSizes.back();
+  }
+  //! Get the number of layers the plan runs.
+  size_t NumLayers() const { return layers.size(); }
+  //! Get the number of layers that were folded into the layer before them.
+  size_t NumFolded() const { return numFolded; }
+  //! Get the number of layers that are run in place.
+  size_t NumInPlace() const
+  {
+    return std::count(inPlace.begin(), inPlace.end(), true);
+  }
+
+ private:
+  //! Clone the layers of the given plan and point them at our parameters.
+  void CopyLayers(const InferencePlan& other);
+
+  //! Run the given copies of the layers of the plan, storing the intermediate
+  //! outputs in the given buffer.
+  void Run(const std::vector<Layer<MatType>*>& runLayers,
+           MatType& runBuffer,
+           const MatType& input,
+           MatType& output) const;
+
+  //! Get a new identifier for a plan; identifiers are never reused, so that a
+  //! workspace can tell whether it was prepared for a plan.
+  static size_t NextId()
+  {
+    static std::atomic<size_t> nextId(1);
+    return nextId++;
+  }
+  //! Delete the layers of the plan.
+  void Clear();
+
+  //! The layers of the plan (owned by the plan).
+  std::vector<Layer<MatType>*> layers;
+  //! The offset of the weights of each layer in parameters.
+  std::vector<size_t> offsets;
+  //! Whether each layer is run in place on the output of the layer before it.
+  std::vector<bool> inPlace;
+  //! The number of output elements of each layer, for one point.
+  std::vector<size_t> outputSizes;
+  //! The largest number of output elements of a layer that uses the buffer.
+  size_t maxOutputSize;
+  //! The index of the last layer that is not run in place.
+  size_t lastProducer;
+  //! The number of layers that were folded into the layer before them.
+  size_t numFolded;
+  //! The parameters of the layers (with folded layers already applied).
+  MatType parameters;
+  //! The memory that intermediate outputs are stored in.
+  MatType buffer;
+  //! The identifier of the plan (0 for an empty plan).
+  size_t id;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "inference_plan_impl.hpp"
+
+#endif
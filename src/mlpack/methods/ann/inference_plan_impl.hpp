@@ -0,0 +1,278 @@
+/**
+ * @file methods/ann/inference_plan_impl.hpp
+ *
+ * Implementation of the InferencePlan class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INFERENCE_PLAN_IMPL_HPP
+#define MLPACK_METHODS_ANN_INFERENCE_PLAN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "inference_plan.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+InferencePlan<MatType>::InferencePlan() :
+    maxOutputSize(0),
+    lastProducer(0),
+    numFolded(0),
+    id(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+InferencePlan<MatType>::InferencePlan(
+    const std::vector<Layer<MatType>*>& network,
+    const MatType& parameters) :
+    maxOutputSize(0),
+    lastProducer(0),
+    numFolded(0),
+    parameters(parameters),
+    id(NextId())
+{
+  size_t offset = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    const size_t weightSize = network[i]->WeightSize();
+
+    // A BatchNorm layer is only an elementwise scale and shift in testing
+    // mode, so it can be folded into the layer that produced its input, if
+    // that layer can represent it.
+    const BatchNormType<MatType>* batchNorm =
+        dynamic_cast<const BatchNormType<MatType>*>(network[i]);
+    if (batchNorm != NULL && !layers.empty() && !inPlace.back())
+    {
+      MatType scale, shift;
+      batchNorm->InferenceAffine(scale, shift);
+      if (layers.back()->FoldAffine(scale, shift))
+      {
+        offset += weightSize;
+        ++numFolded;
+        continue;
+      }
+    }
+
+    Layer<MatType>* layer = network[i]->Clone();
+    MatType weights;
+    MakeAlias(weights, this->parameters, weightSize, 1, offset);
+    layer->SetWeights(weights);
+
+    // The first layer cannot run in place, since that would overwrite the
+    // input.
+    const bool layerInPlace = !layers.empty() && layer->ElementwiseForward();
+    const size_t outputSize = layerInPlace ? outputSizes.back() :
+        layer->OutputSize();
+    if (!layerInPlace)
+      lastProducer = layers.size();
+
+    layers.push_back(layer);
+    offsets.push_back(offset);
+    inPlace.push_back(layerInPlace);
+    outputSizes.push_back(outputSize);
+    offset += weightSize;
+  }
+
+  // The last producer writes directly to the output, so it does not need space
+  // in the buffer.
+  maxOutputSize = 0;
+  for (size_t i = 0; i < lastProducer; ++i)
+    maxOutputSize = std::max(maxOutputSize, outputSizes[i]);
+}
+
+template<typename MatType>
+InferencePlan<MatType>::InferencePlan(const InferencePlan& other) :
+    inPlace(other.inPlace),
+    outputSizes(other.outputSizes),
+    maxOutputSize(other.maxOutputSize),
+    lastProducer(other.lastProducer),
+    numFolded(other.numFolded),
+    parameters(other.parameters),
+    id(other.Empty() ? 0 : NextId())
+{
+  CopyLayers(other);
+}
+
+template<typename MatType>
+InferencePlan<MatType>::InferencePlan(InferencePlan&& other) :
+    layers(std::move(other.layers)),
+    offsets(std::move(other.offsets)),
+    inPlace(std::move(other.inPlace)),
+    outputSizes(std::move(other.outputSizes)),
+    maxOutputSize(other.maxOutputSize),
+    lastProducer(other.lastProducer),
+    numFolded(other.numFolded),
+    parameters(std::move(other.parameters)),
+    buffer(std::move(other.buffer)),
+    // The parameters may not have kept their memory, so the workspaces that
+    // were prepared for the other plan are not valid for this one.
+    id(layers.empty() ? 0 : NextId())
+{
+  // The layers now belong to us.
+  other.layers.clear();
+  other.offsets.clear();
+  other.inPlace.clear();
+  other.outputSizes.clear();
+  other.id = 0;
+}
+
+template<typename MatType>
+InferencePlan<MatType>& InferencePlan<MatType>::operator=(
+    const InferencePlan& other)
+{
+  if (this != &other)
+  {
+    Clear();
+    inPlace = other.inPlace;
+    outputSizes = other.outputSizes;
+    maxOutputSize = other.maxOutputSize;
+    lastProducer = other.lastProducer;
+    numFolded = other.numFolded;
+    parameters = other.parameters;
+    buffer.clear();
+    CopyLayers(other);
+    id = other.Empty() ? 0 : NextId();
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+InferencePlan<MatType>& InferencePlan<MatType>::operator=(
+    InferencePlan&& other)
+{
+  if (this != &other)
+  {
+    Clear();
+    layers = std::move(other.layers);
+    offsets = std::move(other.offsets);
+    inPlace = std::move(other.inPlace);
+    outputSizes = std::move(other.outputSizes);
+    maxOutputSize = other.maxOutputSize;
+    lastProducer = other.lastProducer;
+    numFolded = other.numFolded;
+    parameters = std::move(other.parameters);
+    buffer = std::move(other.buffer);
+    id = layers.empty() ? 0 : NextId();
+
+    other.layers.clear();
+    other.offsets.clear();
+    other.inPlace.clear();
+    other.outputSizes.clear();
+    other.id = 0;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+InferencePlan<MatType>::~InferencePlan()
+{
+  Clear();
+}
+
+template<typename MatType>
+void InferencePlan<MatType>::Forward(const MatType& input, MatType& output)
+{
+  Run(layers, buffer, input, output);
+}
+
+template<typename MatType>
+void InferencePlan<MatType>::Forward(
+    const MatType& input,
+    MatType& output,
+    InferenceWorkspace<MatType>& workspace) const
+{
+  if (workspace.planId != id)
+  {
+    // Copy the layers, and point them at our parameters (which are only ever
+    // read).
+    workspace.Clear();
+    workspace.layers.resize(layers.size());
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+      workspace.layers[i] = layers[i]->Clone();
+      MatType weights;
+      MakeAlias(weights, parameters, layers[i]->WeightSize(), 1, offsets[i]);
+      workspace.layers[i]->SetWeights(weights);
+    }
+
+    workspace.planId = id;
+  }
+
+  Run(workspace.layers, workspace.buffer, input, output);
+}
+
+template<typename MatType>
+void InferencePlan<MatType>::Run(
+    const std::vector<Layer<MatType>*>& runLayers,
+    MatType& runBuffer,
+    const MatType& input,
+    MatType& output) const
+{
+  const size_t batchSize = input.n_cols;
+  const size_t halfSize = maxOutputSize * batchSize;
+  if (runBuffer.n_elem < 2 * halfSize)
+    runBuffer.set_size(2 * halfSize, 1);
+
+  // Each layer that produces a new output writes it to the half of the buffer
+  // that holds neither its input nor anything that is still needed.
+  MatType halves[2];
+  size_t half = 0;
+  const MatType* current = &input;
+  for (size_t i = 0; i < runLayers.size(); ++i)
+  {
+    if (inPlace[i])
+    {
+      // The input of this layer is never the user's input, since the first
+      // layer cannot run in place.
+      MatType& data = const_cast<MatType&>(*current);
+      runLayers[i]->Forward(data, data);
+    }
+    else if (i == lastProducer)
+    {
+      runLayers[i]->Forward(*current, output);
+      current = &output;
+    }
+    else
+    {
+      MakeAlias(halves[half], runBuffer, outputSizes[i], batchSize,
+          half * halfSize);
+      runLayers[i]->Forward(*current, halves[half]);
+      current = &halves[half];
+      half = 1 - half;
+    }
+  }
+}
+
+template<typename MatType>
+void InferencePlan<MatType>::CopyLayers(const InferencePlan& other)
+{
+  offsets = other.offsets;
+  layers.resize(other.layers.size());
+  for (size_t i = 0; i < other.layers.size(); ++i)
+  {
+    layers[i] = other.layers[i]->Clone();
+    MatType weights;
+    MakeAlias(weights, parameters, layers[i]->WeightSize(), 1, offsets[i]);
+    layers[i]->SetWeights(weights);
+  }
+}
+
+template<typename MatType>
+void InferencePlan<MatType>::Clear()
+{
+  for (size_t i = 0; i < layers.size(); ++i)
+    delete layers[i];
+  layers.clear();
+  offsets.clear();
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file methods/ann/inference_server.hpp
+ *
+ * Definition of the InferenceServer class, which groups concurrent prediction
+ * requests for a frozen network into micro-batches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INFERENCE_SERVER_HPP
+#define MLPACK_METHODS_ANN_INFERENCE_SERVER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "inference_plan.hpp"
+
+namespace mlpack {
+
+/**
+ * An InferenceServer answers prediction requests for a frozen network (see
+ * `FFN::Freeze()`) that arrive one at a time from many threads, by grouping
+ * them into micro-batches: predicting a batch of points costs much less than
+ * predicting each point on its own, since each layer then works on a matrix
+ * instead of a vector.
+ *
+ * Each call to `Predict()` queues a request and returns a `std::future` of its
+ * result.  Worker threads take the queued requests from the front of the
+ * queue, as soon as either `maxBatchSize` points are queued or the oldest
+ * request has waited `maxDelay` seconds, so no request waits longer than
+ * `maxDelay` for its batch to start.  The points of the batch are gathered into
+ * a buffer of the worker, passed through the network with one call to
+ * `FFN::Predict()` with the worker's `InferenceWorkspace`, and the results are
+ * scattered back to the requests.  The buffers and workspaces of the workers
+ * are kept between batches, so no memory is allocated for the batches once
+ * the server is warm (other than the results returned to the requests).
+ *
+ * The network is not copied: it must stay frozen, and must not be modified or
+ * destroyed, while the server is running.  The destructor (or `Stop()`) waits
+ * until every queued request is answered.
+ *
+ * @code
+ * model.Freeze();
+ * InferenceServer<FFN<>> server(model, 64, 0.002);
+ *
+ * // From any thread:
+ * std::future<arma::mat> result = server.Predict(point);
+ * arma::mat prediction = result.get();
+ * @endcode
+ *
+ * @tparam NetworkType Type of the network; it must provide `Frozen()`,
+ *     `InputDimensions()` and the `Predict()` overload that takes an
+ *     `InferenceWorkspace`, like `FFN`.
+ * @tparam MatType Matrix representation of the inputs and results.
+ */
+template<typename NetworkType, typename MatType = arma::mat>
+class InferenceServer
+{
+ public:
+  /**
+   * Start the server for the given frozen network.  A `std::logic_error` is
+   * thrown if the network is not frozen.
+   *
+   * @param network Frozen network to predict with.
+   * @param maxBatchSize Maximum number of points in a micro-batch.
+   * @param maxDelay Maximum time (in seconds) that a request waits for its
+   *     micro-batch to be filled.
+   * @param numWorkers Number of threads that run micro-batches.
+   */
+  InferenceServer(const NetworkType& network,
+                  const size_t maxBatchSize = 64,
+                  const double maxDelay = 0.002,
+                  const size_t numWorkers = 1);
+
+  //! The server cannot be copied or moved, since its threads refer to it.
+  InferenceServer(const InferenceServer&) = delete;
+  InferenceServer& operator=(const InferenceServer&) = delete;
+
+  //! Stop the server, once every queued request has been answered.
+  ~InferenceServer();
+
+  /**
+   * Queue a request to predict the responses of the given points (one per
+   * column), and return a future of the results.  If the prediction fails,
+   * the future holds the exception.  A request with more than `maxBatchSize`
+   * points is run as a batch of its own.
+   *
+   * @param predictors Points to predict the responses of.
+   * @return Future of the results, with one column per point.
+   */
+  std::future<MatType> Predict(MatType predictors);
+
+  /**
+   * Stop accepting requests, answer the queued requests, and stop the worker
+   * threads.  After this, `Predict()` throws a `std::logic_error`.
+   */
+  void Stop();
+
+  //! Get the maximum number of points in a micro-batch.
+  size_t MaxBatchSize() const { return maxBatchSize; }
+  //! Get the maximum time (in seconds) a request waits for its micro-batch.
+  double MaxDelay() const { return maxDelay; }
+  //! Get the number of worker threads.
+  size_t NumWorkers() const { return workers.size(); }
+
+  //! Get the number of requests that have been answered.
+  size_t Requests() const;
+  //! Get the number of micro-batches that have been run.
+  size_t Batches() const;
+
+ private:
+  //! The clock used for the deadlines.
+  typedef std::chrono::steady_clock Clock;
+
+  //! A queued request.
+  struct Request
+  {
+    MatType predictors;
+    std::promise<MatType> result;
+    Clock::time_point deadline;
+  };
+
+  //! Run micro-batches until the server is stopped.
+  void Worker();
+
+  //! Predict the given batch of requests with the given buffers.
+  void RunBatch(std::vector<Request>& batch,
+                const size_t points,
+                MatType& inputs,
+                MatType& outputs,
+                InferenceWorkspace<MatType>& workspace) const;
+
+  //! The frozen network.
+  const NetworkType& network;
+  //! The number of rows of each point.
+  size_t inputSize;
+  //! The maximum number of points in a micro-batch.
+  size_t maxBatchSize;
+  //! The maximum delay (in seconds) of a request.
+  double maxDelay;
+
+  //! The queued requests, oldest first.
+  std::deque<Request> queue;
+  //! The number of points in the queued requests.
+  size_t queuedPoints;
+  //! Whether the server is stopping.
+  bool stopping;
+  //! The number of answered requests.
+  size_t requests;
+  //! The number of micro-batches that were run.
+  size_t batches;
+
+  //! The mutex protecting the queue and the counters.
+  mutable std::mutex mutex;
+  //! Signalled when a request is queued or the server stops.
+  std::condition_variable condition;
+  //! The worker threads.
+  std::vector<std::thread> workers;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "inference_server_impl.hpp"
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file methods/ann/inference_server_impl.hpp
+ *
+ * Implementation of the InferenceServer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_INFERENCE_SERVER_IMPL_HPP
+#define MLPACK_METHODS_ANN_INFERENCE_SERVER_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "inference_server.hpp"
+
+namespace mlpack {
+
+template<typename NetworkType, typename MatType>
+InferenceServer<NetworkType, MatType>::InferenceServer(
+    const NetworkType& network,
+    const size_t maxBatchSize,
+    const double maxDelay,
+    const size_t numWorkers) :
+    network(network),
+    inputSize(1),
+    maxBatchSize(maxBatchSize),
+    maxDelay(maxDelay),
+    queuedPoints(0),
+    stopping(false),
+    requests(0),
+    batches(0)
+{
+  if (!network.Frozen())
+  {
+    throw std::logic_error("InferenceServer::InferenceServer(): the network "
+        "must be frozen with Freeze()!");
+  }
+
+  if (maxBatchSize == 0 || numWorkers == 0)
+  {
+    throw std::invalid_argument("InferenceServer::InferenceServer(): "
+        "maxBatchSize and numWorkers must be positive!");
+  }
+
+  if (maxDelay < 0.0)
+  {
+    throw std::invalid_argument("InferenceServer::InferenceServer(): "
+        "maxDelay must be non-negative!");
+  }
+
+  for (size_t i = 0; i < network.InputDimensions().size(); ++i)
+    inputSize *= network.InputDimensions()[i];
+
+  for (size_t i = 0; i < numWorkers; ++i)
+    workers.emplace_back(&InferenceServer::Worker, this);
+}
+
+template<typename NetworkType, typename MatType>
+InferenceServer<NetworkType, MatType>::~InferenceServer()
+{
+  Stop();
+}
+
+template<typename NetworkType, typename MatType>
+std::future<MatType> InferenceServer<NetworkType, MatType>::Predict(
+    MatType predictors)
+{
+  if (predictors.n_rows != inputSize || predictors.n_cols == 0)
+  {
+    std::ostringstream oss;
+    oss << "InferenceServer::Predict(): expected points with " << inputSize
+        << " rows, but got a " << predictors.n_rows << " x "
+        << predictors.n_cols << " matrix!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Request request;
+  request.predictors = std::move(predictors);
+  request.deadline = Clock::now() +
+      std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(maxDelay));
+  std::future<MatType> result = request.result.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopping)
+    {
+      throw std::logic_error("InferenceServer::Predict(): the server has been "
+          "stopped!");
+    }
+
+    queuedPoints += request.predictors.n_cols;
+    queue.push_back(std::move(request));
+  }
+
+  condition.notify_all();
+  return result;
+}
+
+template<typename NetworkType, typename MatType>
+void InferenceServer<NetworkType, MatType>::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+
+  condition.notify_all();
+  for (size_t i = 0; i < workers.size(); ++i)
+    if (workers[i].joinable())
+      workers[i].join();
+}
+
+template<typename NetworkType, typename MatType>
+size_t InferenceServer<NetworkType, MatType>::Requests() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return requests;
+}
+
+template<typename NetworkType, typename MatType>
+size_t InferenceServer<NetworkType, MatType>::Batches() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return batches;
+}
+
+template<typename NetworkType, typename MatType>
+void InferenceServer<NetworkType, MatType>::Worker()
+{
+  // The buffers of the worker are kept between batches.
+  InferenceWorkspace<MatType> workspace;
+  MatType inputs(inputSize, maxBatchSize);
+  MatType outputs;
+
+  // Predicting no points gives the number of rows of the results.
+  network.Predict(MatType(inputSize, 0), outputs, workspace);
+  outputs.set_size(outputs.n_rows, maxBatchSize);
+  std::vector<Request> batch;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    condition.wait(lock, [this] { return stopping || !queue.empty(); });
+    if (queue.empty())
+      return; // The server is stopping and all requests are answered.
+
+    // Wait until the batch is full, or the oldest request must be run.
+    condition.wait_until(lock, queue.front().deadline, [this]
+        { return stopping || queue.empty() || queuedPoints >= maxBatchSize; });
+
+    // Another worker may have taken the requests.
+    if (queue.empty())
+      continue;
+
+    // Take the oldest requests, as long as they fit in the batch.  The first
+    // request is always taken, even if it is bigger than the batch.
+    size_t points = 0;
+    batch.clear();
+    do
+    {
+      points += queue.front().predictors.n_cols;
+      batch.push_back(std::move(queue.front()));
+      queue.pop_front();
+    } while (!queue.empty() &&
+        points + queue.front().predictors.n_cols <= maxBatchSize);
+    queuedPoints -= points;
+
+    lock.unlock();
+    RunBatch(batch, points, inputs, outputs, workspace);
+    lock.lock();
+
+    requests += batch.size();
+    ++batches;
+  }
+}
+
+template<typename NetworkType, typename MatType>
+void InferenceServer<NetworkType, MatType>::RunBatch(
+    std::vector<Request>& batch,
+    const size_t points,
+    MatType& inputs,
+    MatType& outputs,
+    InferenceWorkspace<MatType>& workspace) const
+{
+  try
+  {
+    // Gather the points into the first columns of the input buffer.
+    if (points > inputs.n_cols)
+      inputs.set_size(inputSize, points);
+
+    size_t col = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      const MatType& predictors = batch[i].predictors;
+      inputs.cols(col, col + predictors.n_cols - 1) = predictors;
+      col += predictors.n_cols;
+    }
+
+    if (points > outputs.n_cols)
+      outputs.set_size(outputs.n_rows, points);
+
+    MatType inputAlias, outputAlias;
+    MakeAlias(inputAlias, inputs, inputSize, points);
+    MakeAlias(outputAlias, outputs, outputs.n_rows, points);
+    network.Predict(inputAlias, outputAlias, workspace, points);
+
+    // Scatter the results back to the requests.
+    col = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      const size_t n = batch[i].predictors.n_cols;
+      batch[i].result.set_value(MatType(outputAlias.cols(col, col + n - 1)));
+      col += n;
+    }
+  }
+  catch (...)
+  {
+    // Requests that were already answered keep their results.
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+      try
+      {
+        batch[i].result.set_exception(std::current_exception());
+      }
+      catch (const std::future_error&)
+      {
+        // The result has already been set.
+      }
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
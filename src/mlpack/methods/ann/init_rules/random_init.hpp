@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_INIT_RULES_RANDOM_INIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random_stream.hpp>
 
 namespace mlpack {
 
@@ -57,7 +58,8 @@ class RandomInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.randu();
+    RandomStream stream(RandomStreamSeed());
+    stream.Fill(W);
     W *= (upperBound - lowerBound);
     W += lowerBound;
   }
@@ -74,7 +76,8 @@ class RandomInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.randu();
+    RandomStream stream(RandomStreamSeed());
+    stream.Fill(W);
     W *= (upperBound - lowerBound);
     W += lowerBound;
   }
@@ -32,6 +32,11 @@
 #include <mlpack/methods/ann/activation_functions/silu_function.hpp>
 #include <mlpack/methods/ann/activation_functions/hyper_sinh_function.hpp>
 #include <mlpack/methods/ann/activation_functions/bipolar_sigmoid_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_tanh_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_swish_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_gelu_function.hpp>
+#include <mlpack/methods/ann/activation_functions/fast_mish_function.hpp>
 #include "layer.hpp"
 
 namespace mlpack {
@@ -58,6 +63,12 @@ namespace mlpack {
  *  - TanhExp
  *  - SILU
  *
+ * The FastSigmoid, FastTanH, FastSwish, FastGELU and FastMish layers compute
+ * their activations with polynomial approximations of the exponential (see
+ * `FastExp()`), which are much faster than `std::exp()` and accurate to about
+ * 1e-6; they are drop-in replacements for the exact layers when that accuracy
+ * is enough.
+ *
  * @tparam ActivationFunction Activation function used for the embedding layer.
  */
 template <
@@ -96,6 +107,9 @@ class BaseLayer : public Layer<MatType>
     ActivationFunction::Fn(input, output);
   }
 
+  //! The activation is applied to each element separately.
+  bool ElementwiseForward() const { return true; }
+
   /**
    * Backward pass: compute the function f(x) by propagating x backwards through
    * f, using the results from the forward pass.
@@ -264,6 +278,46 @@ typedef BaseLayer<BipolarSigmoidFunction, arma::mat> BipolarSigmoid;
 template<typename MatType = arma::mat>
 using BipolarSigmoidType = BaseLayer<BipolarSigmoidFunction, MatType>;
 
+/**
+ * Sigmoid layer using a fast approximation of the logistic function.
+ */
+typedef BaseLayer<FastLogisticFunction, arma::mat> FastSigmoid;
+
+template<typename MatType = arma::mat>
+using FastSigmoidType = BaseLayer<FastLogisticFunction, MatType>;
+
+/**
+ * TanH layer using a fast approximation of the tanh function.
+ */
+typedef BaseLayer<FastTanhFunction, arma::mat> FastTanH;
+
+template<typename MatType = arma::mat>
+using FastTanHType = BaseLayer<FastTanhFunction, MatType>;
+
+/**
+ * Swish layer using a fast approximation of the Swish function.
+ */
+typedef BaseLayer<FastSwishFunction, arma::mat> FastSwish;
+
+template<typename MatType = arma::mat>
+using FastSwishType = BaseLayer<FastSwishFunction, MatType>;
+
+/**
+ * GELU layer using a fast approximation of the GELU function.
+ */
+typedef BaseLayer<FastGELUFunction, arma::mat> FastGELU;
+
+template<typename MatType = arma::mat>
+using FastGELUType = BaseLayer<FastGELUFunction, MatType>;
+
+/**
+ * Mish layer using a fast approximation of the Mish function.
+ */
+typedef BaseLayer<FastMishFunction, arma::mat> FastMish;
+
+template<typename MatType = arma::mat>
+using FastMishType = BaseLayer<FastMishFunction, MatType>;
+
 } // namespace mlpack
 
 #endif
@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "layer.hpp"
+#include "normalization_kernels.hpp"
 
 namespace mlpack {
 
@@ -30,6 +31,13 @@ namespace mlpack {
  * calculated and the data is normalized. If it is set to true (testing) then
  * the mean and variance accrued over the training set is used.
  *
+ * Each pass reads every channel once: in training, the moments of a channel
+ * are accumulated with Welford's update (merged over the contiguous runs of
+ * the channel), and the input is normalized, scaled and shifted in the same
+ * loop; the backward pass only needs two sums per channel.  In testing mode,
+ * each element is scaled and shifted, so `Forward()` may be called in place
+ * (with `input` and `output` holding the same memory).
+ *
  * For more information, refer to the following paper,
  *
  * @code
@@ -185,6 +193,16 @@ class BatchNormType : public Layer<MatType>
   //! Modify the variance over the training data.
   MatType& TrainingVariance() { return runningVariance; }
 
+  /**
+   * Compute the transformation the layer applies in testing mode, as a factor
+   * and an offset for each element of the input: the output is
+   * `scale % input + shift`.
+   *
+   * @param scale Will be set to the factor applied to each input element.
+   * @param shift Will be set to the offset added to each input element.
+   */
+  void InferenceAffine(MatType& scale, MatType& shift) const;
+
   //! Get the number of input units / channels.
   size_t InputSize() const { return size; }
 
@@ -202,6 +220,10 @@ class BatchNormType : public Layer<MatType>
   //! Get size of weights.
   size_t WeightSize() const { return 2 * size; }
 
+  //! The statistics of a channel are read completely before the channel is
+  //! written, so `Forward()` can run in place.
+  bool ElementwiseForward() const { return true; }
+
   //! Compute the output dimensions of the layer given `InputDimensions()`.
   void ComputeOutputDimensions();
 
@@ -234,9 +256,13 @@ class BatchNormType : public Layer<MatType>
   //! Locally-stored shift parameter.
   MatType beta;
 
-  //! Locally-stored variance object.
+  //! Locally-stored variance of each channel over the last batch.
   MatType variance;
 
+  //! Locally-stored inverse standard deviation of each channel over the last
+  //! batch.
+  MatType stdInv;
+
   //! Locally-stored parameters.
   MatType weights;
 
@@ -264,10 +290,7 @@ class BatchNormType : public Layer<MatType>
   MatType runningVariance;
 
   //! Locally-stored normalized input.
-  arma::Cube<typename MatType::elem_type> normalized;
-
-  //! Locally-stored zero mean input.
-  arma::Cube<typename MatType::elem_type> inputMean;
+  MatType normalized;
 }; // class BatchNorm
 
 // Convenience typedefs.
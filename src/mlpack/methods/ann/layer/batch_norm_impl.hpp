@@ -185,9 +185,18 @@ void BatchNormType<MatType>::Forward(
     const MatType& input,
     MatType& output)
 {
+  typedef typename MatType::elem_type ElemType;
+
   const size_t batchSize = input.n_cols;
   const size_t inputSize = inputDimension;
-  const size_t m = inputSize * batchSize * higherDimension;
+  const size_t slices = batchSize * higherDimension;
+  const size_t m = inputSize * slices;
+
+  // The elements of channel c of slice s are inputSize contiguous elements,
+  // starting at (s * size + c) * inputSize.
+  output.set_size(arma::size(input));
+  const ElemType* in = input.memptr();
+  ElemType* out = output.memptr();
 
   // We will calculate minibatch norm on each channel / feature map.
   if (this->training)
@@ -200,38 +209,36 @@ void BatchNormType<MatType>::Forward(
           " greater than 1 to fix the warning." << std::endl;
     }
 
-    // Input corresponds to output from previous layer.
-    // Used a cube for simplicity.
-    arma::Cube<typename MatType::elem_type> inputTemp(
-        const_cast<MatType&>(input).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-
-    // Initialize output to same size and values for convenience.
-    arma::Cube<typename MatType::elem_type> outputTemp(
-        const_cast<MatType&>(output).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-    outputTemp = inputTemp;
-
-    // Calculate mean and variance over all channels.
-    MatType mean = sum(sum(inputTemp, 2), 0) / m;
-    variance = sum(sum(pow(
-        inputTemp.each_slice() - repmat(mean, inputSize, 1), 2), 2), 0) / m;
-
-    outputTemp.each_slice() -= repmat(mean, inputSize, 1);
-
-    // Used in backward propagation.
-    inputMean.set_size(arma::size(inputTemp));
-    inputMean = outputTemp;
-
-    // Normalize output.
-    outputTemp.each_slice() /= sqrt(repmat(variance, inputSize, 1) + eps);
+    MatType mean(size, 1);
+    variance.set_size(size, 1);
+    stdInv.set_size(size, 1);
+    normalized.set_size(input.n_rows, input.n_cols);
+    ElemType* xhat = normalized.memptr();
 
-    // Re-used in backward propagation.
-    normalized.set_size(arma::size(inputTemp));
-    normalized = outputTemp;
-
-    outputTemp.each_slice() %= repmat(gamma.t(), inputSize, 1);
-    outputTemp.each_slice() += repmat(beta.t(), inputSize, 1);
+    #pragma omp parallel for
+    for (size_t c = 0; c < size; ++c)
+    {
+      size_t seen = 0;
+      ElemType channelMean = 0, m2 = 0;
+      for (size_t s = 0; s < slices; ++s)
+      {
+        AccumulateMoments(in + (s * size + c) * inputSize, inputSize, seen,
+            channelMean, m2);
+      }
+
+      mean[c] = channelMean;
+      variance[c] = m2 / m;
+      stdInv[c] = 1 / std::sqrt(variance[c] + ElemType(eps));
+
+      // Normalize, scale and shift the channel while it is still in cache;
+      // the normalized input is re-used in the backward pass.
+      for (size_t s = 0; s < slices; ++s)
+      {
+        const size_t offset = (s * size + c) * inputSize;
+        NormalizeBlock(in + offset, inputSize, channelMean, stdInv[c],
+            gamma[c], beta[c], xhat + offset, out + offset);
+      }
+    }
 
     count += 1;
     // Value for average factor which used to update running parameters.
@@ -242,24 +249,26 @@ void BatchNormType<MatType>::Forward(
       nElements = m * (1.0 / (m - 1));
 
     // Update running mean and running variance.
-    runningMean = (1 - averageFactor) * runningMean + averageFactor *
-        mean.t();
+    runningMean = (1 - averageFactor) * runningMean + averageFactor * mean;
     runningVariance = (1 - averageFactor) * runningVariance +
-        nElements * averageFactor * variance.t();
+        nElements * averageFactor * variance;
   }
   else
   {
-    // Normalize the input and scale and shift the output.
-    output = input;
-    arma::Cube<typename MatType::elem_type> outputTemp(
-        const_cast<MatType&>(output).memptr(), inputSize, size,
-        batchSize * higherDimension, false, false);
-
-    outputTemp.each_slice() -= repmat(runningMean.t(), inputSize, 1);
-    outputTemp.each_slice() /= sqrt(repmat(runningVariance.t(),
-        inputSize, 1) + eps);
-    outputTemp.each_slice() %= repmat(gamma.t(), inputSize, 1);
-    outputTemp.each_slice() += repmat(beta.t(), inputSize, 1);
+    // Normalize the input and scale and shift the output; this is a single
+    // multiply-add per element, so it may be done in place.
+    #pragma omp parallel for
+    for (size_t c = 0; c < size; ++c)
+    {
+      const ElemType channelStdInv = 1 / std::sqrt(runningVariance[c] +
+          ElemType(eps));
+      for (size_t s = 0; s < slices; ++s)
+      {
+        const size_t offset = (s * size + c) * inputSize;
+        NormalizeBlock(in + offset, inputSize, ElemType(runningMean[c]),
+            channelStdInv, gamma[c], beta[c], (ElemType*) NULL, out + offset);
+      }
+    }
   }
 }
 
@@ -270,39 +279,41 @@ void BatchNormType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  const MatType stdInv = 1.0 / sqrt(variance + eps);
+  typedef typename MatType::elem_type ElemType;
 
-  const size_t batchSize = gy.n_cols;
   const size_t inputSize = inputDimension;
-  const size_t m = inputSize * batchSize * higherDimension;
-
-  arma::Cube<typename MatType::elem_type> gyTemp(
-      const_cast<MatType&>(gy).memptr(), inputSize, size,
-      batchSize * higherDimension, false, false);
-  arma::Cube<typename MatType::elem_type> gTemp(
-      const_cast<MatType&>(g).memptr(), inputSize, size,
-      batchSize * higherDimension, false, false);
-
-  // Step 1: dl / dxhat.
-  arma::Cube<typename MatType::elem_type> norm =
-      gyTemp.each_slice() % repmat(gamma.t(), inputSize, 1);
-
-  // Step 2: sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  MatType temp = sum(sum(norm % inputMean, 2), 0);
-  MatType vars = temp % pow(stdInv, 3) * (-0.5);
-
-  // Step 3: dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  gTemp = (norm.each_slice() % repmat(stdInv, inputSize, 1)) +
-      ((inputMean.each_slice() % repmat(vars, inputSize, 1) * 2.0) / m);
-
-  // Step 4: sum (dl / dxhat * -1 / stdInv) + variance *
-  // sum (-2 * (x - mu)) / m.
-  MatType normTemp = sum(sum((norm.each_slice() %
-      repmat(-stdInv, inputSize, 1)) + 
-      (inputMean.each_slice() % repmat(vars, inputSize, 1) * (-2.0) / m),
-      2), 0) / m;
-  gTemp.each_slice() += repmat(normTemp, inputSize, 1);
+  const size_t slices = gy.n_cols * higherDimension;
+  const size_t m = inputSize * slices;
+
+  // With xhat the normalized input and dy the error of the output, the error
+  // of the input of each channel is
+  //
+  //   g = gamma * stdInv * (dy - mean(dy) - xhat * mean(dy * xhat)),
+  //
+  // so only two sums per channel are needed.
+  const ElemType* dy = gy.memptr();
+  const ElemType* xhat = normalized.memptr();
+  ElemType* gPtr = g.memptr();
+
+  #pragma omp parallel for
+  for (size_t c = 0; c < size; ++c)
+  {
+    ElemType sumDy = 0, sumDyXhat = 0;
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = (s * size + c) * inputSize;
+      AccumulateErrorSums(dy + offset, xhat + offset, inputSize, sumDy,
+          sumDyXhat);
+    }
+
+    const ElemType factor = gamma[c] * stdInv[c];
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = (s * size + c) * inputSize;
+      NormalizationError(dy + offset, xhat + offset, inputSize, sumDy / m,
+          sumDyXhat / m, factor, gPtr + offset);
+    }
+  }
 }
 
 template<typename MatType>
@@ -311,19 +322,43 @@ void BatchNormType<MatType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
+  typedef typename MatType::elem_type ElemType;
+
   const size_t inputSize = inputDimension;
+  const size_t slices = error.n_cols * higherDimension;
+  const ElemType* dy = error.memptr();
+  const ElemType* xhat = normalized.memptr();
 
-  arma::Cube<typename MatType::elem_type> errorTemp(
-      const_cast<MatType&>(error).memptr(), inputSize, size,
-      error.n_cols * higherDimension, false, false);
+  // Step 5: dl / dy * xhat (for gamma), and step 6: dl / dy (for beta).
+  #pragma omp parallel for
+  for (size_t c = 0; c < size; ++c)
+  {
+    ElemType sumDy = 0, sumDyXhat = 0;
+    for (size_t s = 0; s < slices; ++s)
+    {
+      const size_t offset = (s * size + c) * inputSize;
+      AccumulateErrorSums(dy + offset, xhat + offset, inputSize, sumDy,
+          sumDyXhat);
+    }
 
-  // Step 5: dl / dy * xhat.
-  MatType temp = sum(sum(normalized % errorTemp, 0), 2);
-  gradient.submat(0, 0, gamma.n_elem - 1, 0) = temp.t();
+    gradient[c] = sumDyXhat;
+    gradient[size + c] = sumDy;
+  }
+}
 
-  // Step 6: dl / dy.
-  temp = sum(sum(errorTemp, 0), 2);
-  gradient.submat(gamma.n_elem, 0, gradient.n_elem - 1, 0) = temp.t();
+template<typename MatType>
+void BatchNormType<MatType>::InferenceAffine(MatType& scale,
+                                             MatType& shift) const
+{
+  // Compute the transformation of each channel, then expand it to every element
+  // of the input; elements of the same channel are inputDimension apart.
+  const MatType channelScale = gamma / sqrt(runningVariance + eps);
+  const MatType channelShift = beta - runningMean % channelScale;
+
+  scale = repmat(vectorise(repmat(channelScale.t(), inputDimension, 1)),
+      higherDimension, 1);
+  shift = repmat(vectorise(repmat(channelShift.t(), inputDimension, 1)),
+      higherDimension, 1);
 }
 
 template<typename MatType>
@@ -379,7 +414,6 @@ void BatchNormType<MatType>::serialize(
   ar(CEREAL_NVP(average));
   ar(CEREAL_NVP(runningMean));
   ar(CEREAL_NVP(runningVariance));
-  ar(CEREAL_NVP(inputMean));
   ar(CEREAL_NVP(inputDimension));
   ar(CEREAL_NVP(size));
   ar(CEREAL_NVP(higherDimension));
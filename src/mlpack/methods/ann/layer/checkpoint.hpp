@@ -0,0 +1,146 @@
+/**
+ * @file methods/ann/layer/checkpoint.hpp
+ *
+ * Definition of the Checkpoint class, a container of layers that does not keep
+ * the outputs of its layers between the forward and the backward pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_CHECKPOINT_HPP
+#define MLPACK_METHODS_ANN_LAYER_CHECKPOINT_HPP
+
+#include "multi_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The Checkpoint class holds a sequence of layers, just like MultiLayer, but
+ * in training mode it frees the outputs of its layers as soon as `Forward()`
+ * is done, and computes them again from the input of the segment in
+ * `Backward()` (this is known as gradient checkpointing).  Only the input and
+ * the output of the segment are kept by the network during the forward pass.
+ * Splitting a network of L layers into about sqrt(L) Checkpoint segments of
+ * about sqrt(L) layers each holds the memory needed for the layer outputs to
+ * O(sqrt(L)) batches of activations, at the cost of one more forward pass
+ * through each segment.  For example:
+ *
+ * @code
+ * FFN<> model;
+ * for (size_t i = 0; i < 4; ++i)
+ * {
+ *   Checkpoint* segment = new Checkpoint();
+ *   for (size_t j = 0; j < 4; ++j)
+ *   {
+ *     segment->Add<Linear>(100);
+ *     segment->Add<ReLU>();
+ *   }
+ *   model.Add(segment);
+ * }
+ * @endcode
+ *
+ * The segment holds its gradient from the call to `Backward()` until the call
+ * to `Gradient()`, since the layer outputs it needs are already freed then.
+ *
+ * The layers of the segment, except the last, are run forward again, so
+ * Dropout-type layers draw a new mask and BatchNorm layers update their
+ * running statistics twice; such layers should be the last layer of a segment,
+ * or be kept outside of any segment.  The memory that a layer of the segment
+ * keeps for itself (e.g., an AddMerge that holds a residual block) is not
+ * freed; so, for deep residual stacks, each segment should hold several
+ * blocks.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType>
+class CheckpointType : public MultiLayer<MatType>
+{
+ public:
+  /**
+   * Create an empty Checkpoint that holds no layers of its own.  Be sure to add
+   * layers with Add() before using!
+   */
+  CheckpointType();
+
+  //! Copy the given CheckpointType.
+  CheckpointType(const CheckpointType& other);
+  //! Take ownership of the layers of the given CheckpointType.
+  CheckpointType(CheckpointType&& other);
+  //! Copy the given CheckpointType.
+  CheckpointType& operator=(const CheckpointType& other);
+  //! Take ownership of the given CheckpointType.
+  CheckpointType& operator=(CheckpointType&& other);
+
+  //! Virtual destructor: delete all held layers.
+  virtual ~CheckpointType()
+  {
+    // Nothing to do here.
+  }
+
+  //! Create a copy of the CheckpointType (this is safe for polymorphic use).
+  CheckpointType* Clone() const { return new CheckpointType(*this); }
+
+  /**
+   * Forward pass through each layer of the segment.  In training mode, the
+   * outputs of the layers are freed afterwards.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Compute the outputs of the layers of the segment again (in training mode),
+   * and then pass the error backwards through each layer.  The gradient of the
+   * segment is computed here too, and the memory for the outputs and the
+   * deltas of the layers is freed afterwards.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& input,
+                const MatType& output,
+                const MatType& gy,
+                MatType& g);
+
+  /**
+   * Give the gradient of the segment that was computed by `Backward()` (in
+   * training mode).
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Serialize the CheckpointType.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Whether the layer outputs and deltas are freed between passes; this is
+  //! only the case in training mode, for a segment of more than one layer.
+  bool Checkpointing() const
+  {
+    return this->training && this->network.size() > 1;
+  }
+
+  //! The gradient of the segment, computed during Backward().
+  MatType segmentGradient;
+};
+
+typedef CheckpointType<arma::mat> Checkpoint;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "checkpoint_impl.hpp"
+
+#endif
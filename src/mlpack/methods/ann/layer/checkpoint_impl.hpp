@@ -0,0 +1,130 @@
+/**
+ * @file methods/ann/layer/checkpoint_impl.hpp
+ *
+ * Implementation of the Checkpoint class, a container of layers that does not
+ * keep the outputs of its layers between the forward and the backward pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_CHECKPOINT_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_CHECKPOINT_IMPL_HPP
+
+#include "checkpoint.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+CheckpointType<MatType>::CheckpointType() :
+    MultiLayer<MatType>()
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+CheckpointType<MatType>::CheckpointType(const CheckpointType& other) :
+    MultiLayer<MatType>(other)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+CheckpointType<MatType>::CheckpointType(CheckpointType&& other) :
+    MultiLayer<MatType>(std::move(other))
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+CheckpointType<MatType>& CheckpointType<MatType>::operator=(
+    const CheckpointType& other)
+{
+  if (this != &other)
+  {
+    MultiLayer<MatType>::operator=(other);
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+CheckpointType<MatType>& CheckpointType<MatType>::operator=(
+    CheckpointType&& other)
+{
+  if (this != &other)
+  {
+    MultiLayer<MatType>::operator=(std::move(other));
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void CheckpointType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  MultiLayer<MatType>::Forward(input, output);
+
+  // The outputs of the layers will be computed again by Backward().
+  if (Checkpointing())
+    this->layerOutputMatrix.reset();
+}
+
+template<typename MatType>
+void CheckpointType<MatType>::Backward(
+    const MatType& input,
+    const MatType& output,
+    const MatType& gy,
+    MatType& g)
+{
+  if (!Checkpointing())
+  {
+    MultiLayer<MatType>::Backward(input, output, gy, g);
+    return;
+  }
+
+  // Compute the outputs of every layer but the last again; the output of the
+  // last layer is given.
+  const size_t n = this->network.size();
+  this->InitializeForwardPassMemory(input.n_cols);
+  this->network[0]->Forward(input, this->layerOutputs[0]);
+  for (size_t i = 1; i < n - 1; ++i)
+    this->network[i]->Forward(this->layerOutputs[i - 1], this->layerOutputs[i]);
+
+  MultiLayer<MatType>::Backward(input, output, gy, g);
+
+  // The network calls Backward() on every layer before it calls Gradient() on
+  // any of them, so the gradient is computed now, while the outputs and the
+  // deltas of the layers are still held.
+  segmentGradient.set_size(this->WeightSize(), 1);
+  MultiLayer<MatType>::Gradient(input, gy, segmentGradient);
+
+  this->layerOutputMatrix.reset();
+  this->layerDeltaMatrix.reset();
+}
+
+template<typename MatType>
+void CheckpointType<MatType>::Gradient(
+    const MatType& input, const MatType& error, MatType& gradient)
+{
+  if (Checkpointing())
+    gradient = segmentGradient;
+  else
+    MultiLayer<MatType>::Gradient(input, error, gradient);
+}
+
+template<typename MatType>
+template<typename Archive>
+void CheckpointType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<MultiLayer<MatType>>(this));
+
+  if (Archive::is_loading::value)
+    segmentGradient.clear();
+}
+
+} // namespace mlpack
+
+#endif
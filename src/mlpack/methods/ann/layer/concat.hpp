@@ -24,6 +24,13 @@ namespace mlpack {
  * feed-forward fully connected network container which plugs various layers
  * together.
  *
+ * When the output of each held layer is a contiguous block of the concatenated
+ * output (this happens when concatenating along the last axis with a batch
+ * size of 1), the held layers write their output directly into the output of
+ * the Concat layer, and read their part of the error directly from it, so no
+ * copies are made.  Otherwise, the parts are copied through buffers that are
+ * reused between passes.
+ *
  * NOTE: this class is not intended to exist for long!  It will be replaced with
  * a more flexible DAG network type.
  *
@@ -85,7 +92,7 @@ class ConcatType : public MultiLayer<MatType>
    * @param g The calculated gradient.
    */
   void Backward(const MatType& input,
-                const MatType& /* output */,
+                const MatType& output,
                 const MatType& gy,
                 MatType& g);
 
@@ -100,7 +107,7 @@ class ConcatType : public MultiLayer<MatType>
    * @param index The index of the layer to run.
    */
   void Backward(const MatType& input,
-                const MatType& /* output */,
+                const MatType& output,
                 const MatType& gy,
                 MatType& g,
                 const size_t index);
@@ -220,11 +227,47 @@ class ConcatType : public MultiLayer<MatType>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Compute the number of 'flattened rows' (the product of the axes before the
+   * axis of concatenation) and 'flattened slices' (the product of the axes
+   * after it, times the batch size) of the output.  When there is only one
+   * slice, the output of each held layer is a contiguous block of the output.
+   */
+  void AxisShape(const size_t batchSize, size_t& rows, size_t& slices) const;
+
+  /**
+   * Make `layerOutput` an alias of the output of the held layer `index`, whose
+   * part of the axis of concatenation starts at `startCol`.  If the output of
+   * the layer is a contiguous block of `output`, the alias points into
+   * `output`; otherwise, it points to the memory of the layer held by
+   * MultiLayer.
+   */
+  void LayerOutput(const MatType& output,
+                   const size_t index,
+                   const size_t startCol,
+                   MatType& layerOutput);
+
+  /**
+   * Make `layerError` an alias of the part of `error` that corresponds to the
+   * held layer `index`, whose part of the axis of concatenation starts at
+   * `startCol`.  If that part is a contiguous block of `error`, the alias
+   * points into `error`; otherwise, the part is copied into a buffer that is
+   * reused between passes.
+   */
+  void LayerError(const MatType& error,
+                  const size_t index,
+                  const size_t startCol,
+                  MatType& layerError);
+
   //! Parameter which indicates the axis of concatenation.
   size_t axis;
 
   //! Parameter which indicates whether to use the axis of concatenation.
   bool useAxis;
+
+  //! Buffers for the part of the error of each held layer, when it is not
+  //! contiguous.  These are not serialized.
+  std::vector<MatType> layerErrors;
 }; // class ConcatType.
 
 // Standard Concat layer.
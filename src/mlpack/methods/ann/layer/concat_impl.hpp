@@ -94,12 +94,6 @@ void ConcatType<MatType>::Forward(const MatType& input, MatType& output)
   // is able to hold each child layer's output.
   this->InitializeForwardPassMemory(input.n_cols);
 
-  // Pass the input through all the layers in the network.
-  for (size_t i = 0; i < this->network.size(); ++i)
-  {
-    this->network[i]->Forward(input, this->layerOutputs[i]);
-  }
-
   // Now concatenate the outputs along the correct axis.
   // We can actually use Armadillo to do this for us---we will treat the axis of
   // interest as "columns", any axes that come before the axis of interest as
@@ -110,32 +104,31 @@ void ConcatType<MatType>::Forward(const MatType& input, MatType& output)
   // Note that we will have one "extra" axis in addition to
   // this->outputDimensions.size(); that is the batch size (represented as the
   // number of columns in `input`).
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = input.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  std::vector<arma::Cube<typename MatType::elem_type>> layerOutputAliases(
-      this->layerOutputs.size());
-  for (size_t i = 0; i < this->layerOutputs.size(); ++i)
-  {
-    MakeAlias(layerOutputAliases[i], this->layerOutputs[i], rows, 
-        this->network[i]->OutputDimensions()[axis], slices);
-  }
+  size_t rows, slices;
+  AxisShape(input.n_cols, rows, slices);
 
   arma::Cube<typename MatType::elem_type> outputAlias;
   MakeAlias(outputAlias, output, rows, this->outputDimensions[axis], slices);
 
-  // Now get the columns from each output.
+  // Pass the input through all the layers in the network.  If there is only one
+  // slice, each layer writes directly into its block of the output; otherwise,
+  // we copy the columns from each output.
   size_t startCol = 0;
-  for (size_t i = 0; i < layerOutputAliases.size(); ++i)
+  for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = layerOutputAliases[i].n_cols;
-    outputAlias.cols(startCol, startCol + cols - 1) = layerOutputAliases[i];
+    const size_t cols = this->network[i]->OutputDimensions()[axis];
+
+    MatType layerOutput;
+    LayerOutput(output, i, startCol, layerOutput);
+    this->network[i]->Forward(input, layerOutput);
+
+    if (slices > 1)
+    {
+      arma::Cube<typename MatType::elem_type> layerOutputAlias;
+      MakeAlias(layerOutputAlias, layerOutput, rows, cols, slices);
+      outputAlias.cols(startCol, startCol + cols - 1) = layerOutputAlias;
+    }
+
     startCol += cols;
   }
 }
@@ -143,7 +136,7 @@ void ConcatType<MatType>::Forward(const MatType& input, MatType& output)
 template<typename MatType>
 void ConcatType<MatType>::Backward(
     const MatType& input,
-    const MatType& /* output */,
+    const MatType& output,
     const MatType& gy,
     MatType& g)
 {
@@ -154,32 +147,16 @@ void ConcatType<MatType>::Backward(
 
   // Just like the forward pass, we can treat our inputs as a cube, but here we
   // have to distribute the correct parts of `gy` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
   for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
-    MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-    // Reshape so that the batch size is the number of columns.
-    delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-    this->network[i]->Backward(
-        input,
-        this->layerOutputs[i],
-        delta,
+    MatType layerOutput, delta;
+    LayerOutput(output, i, startCol, layerOutput);
+    LayerError(gy, i, startCol, delta);
+    this->network[i]->Backward(input, layerOutput, delta,
         this->layerDeltas[i]);
 
-    startCol += cols;
+    startCol += this->network[i]->OutputDimensions()[axis];
   }
 
   g = this->layerDeltas[0];
@@ -192,7 +169,7 @@ void ConcatType<MatType>::Backward(
 template<typename MatType>
 void ConcatType<MatType>::Backward(
     const MatType& input,
-    const MatType& /* output */,
+    const MatType& output,
     const MatType& gy,
     MatType& g,
     const size_t index)
@@ -200,30 +177,16 @@ void ConcatType<MatType>::Backward(
   // We only intend to perform a backward pass on one layer.
   // Thus, we need to extract the parts of gy that correspond to the desired
   // layer (specified by `index`).
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = gy.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> gyTmp;
-  MakeAlias(gyTmp, gy, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
   for (size_t i = 0; i < index; ++i)
   {
     startCol += this->network[i]->OutputDimensions()[axis];
   }
 
-  const size_t cols = this->network[index]->OutputDimensions()[axis];
-  MatType delta = gyTmp.cols(startCol, startCol + cols - 1);
-  // Reshape so that the batch size is the number of columns.
-  delta.reshape(delta.n_elem / gy.n_cols, gy.n_cols);
-
-  this->network[index]->Backward(input, this->layerOutputs[index], delta, g);
+  MatType layerOutput, delta;
+  LayerOutput(output, index, startCol, layerOutput);
+  LayerError(gy, index, startCol, delta);
+  this->network[index]->Backward(input, layerOutput, delta, g);
 }
 
 template<typename MatType>
@@ -234,32 +197,19 @@ void ConcatType<MatType>::Gradient(
 {
   // Just like the forward pass, we can treat our inputs as a cube, but here we
   // have to distribute the correct parts of `error` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = input.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
   size_t startParam = 0;
   for (size_t i = 0; i < this->network.size(); ++i)
   {
-    const size_t cols = this->network[i]->OutputDimensions()[axis];
     const size_t params = this->network[i]->WeightSize();
 
-    MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-    err.reshape(err.n_elem / input.n_cols, input.n_cols);
+    MatType err;
+    LayerError(error, i, startCol, err);
     MatType gradientAlias;
     MakeAlias(gradientAlias, gradient, params, 1, startParam);
     this->network[i]->Gradient(input, err, gradientAlias);
 
-    startCol += cols;
+    startCol += this->network[i]->OutputDimensions()[axis];
     startParam += params;
   }
 }
@@ -273,18 +223,6 @@ void ConcatType<MatType>::Gradient(
 {
   // Just like the forward pass, we can treat our inputs as a cube, but here we
   // have to distribute the correct parts of `error` to the layers.
-
-  size_t rows = 1;
-  for (size_t i = 0; i < axis; ++i)
-    rows *= this->outputDimensions[i];
-
-  size_t slices = input.n_cols;
-  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
-    slices *= this->outputDimensions[i];
-
-  arma::Cube<typename MatType::elem_type> errorTmp;
-  MakeAlias(errorTmp, error, rows, this->outputDimensions[axis], slices);
-
   size_t startCol = 0;
   size_t startParam = 0;
   for (size_t i = 0; i < index; ++i)
@@ -293,11 +231,10 @@ void ConcatType<MatType>::Gradient(
     startParam += this->network[i]->WeightSize();
   }
 
-  const size_t cols = this->network[index]->OutputDimensions()[axis];
   const size_t params = this->network[index]->WeightSize();
 
-  MatType err = errorTmp.cols(startCol, startCol + cols - 1);
-  err.reshape(err.n_elem / input.n_cols, input.n_cols);
+  MatType err;
+  LayerError(error, index, startCol, err);
   MatType gradientAlias;
   MakeAlias(gradientAlias, gradient, params, 1, startParam);
   this->network[index]->Gradient(input, err, gradientAlias);
@@ -314,6 +251,74 @@ void ConcatType<MatType>::serialize(
   ar(CEREAL_NVP(useAxis));
 }
 
+
+template<typename MatType>
+void ConcatType<MatType>::AxisShape(const size_t batchSize,
+                                    size_t& rows,
+                                    size_t& slices) const
+{
+  rows = 1;
+  for (size_t i = 0; i < axis; ++i)
+    rows *= this->outputDimensions[i];
+
+  slices = batchSize;
+  for (size_t i = axis + 1; i < this->outputDimensions.size(); ++i)
+    slices *= this->outputDimensions[i];
+}
+
+template<typename MatType>
+void ConcatType<MatType>::LayerOutput(const MatType& output,
+                                      const size_t index,
+                                      const size_t startCol,
+                                      MatType& layerOutput)
+{
+  size_t rows, slices;
+  AxisShape(output.n_cols, rows, slices);
+
+  if (slices == 1)
+  {
+    const size_t cols = this->network[index]->OutputDimensions()[axis];
+    MakeAlias(layerOutput, output, rows * cols, 1, rows * startCol);
+  }
+  else
+  {
+    MakeAlias(layerOutput, this->layerOutputs[index],
+        this->layerOutputs[index].n_rows, this->layerOutputs[index].n_cols);
+  }
+}
+
+template<typename MatType>
+void ConcatType<MatType>::LayerError(const MatType& error,
+                                     const size_t index,
+                                     const size_t startCol,
+                                     MatType& layerError)
+{
+  size_t rows, slices;
+  AxisShape(error.n_cols, rows, slices);
+
+  const size_t cols = this->network[index]->OutputDimensions()[axis];
+  if (slices == 1)
+  {
+    MakeAlias(layerError, error, rows * cols, 1, rows * startCol);
+    return;
+  }
+
+  // The buffers are not serialized or copied, so they may not exist yet.
+  if (layerErrors.size() != this->network.size())
+    layerErrors.resize(this->network.size());
+
+  // Reshape so that the batch size is the number of columns.
+  MatType& buffer = layerErrors[index];
+  buffer.set_size(rows * cols * slices / error.n_cols, error.n_cols);
+
+  arma::Cube<typename MatType::elem_type> errorAlias, bufferAlias;
+  MakeAlias(errorAlias, error, rows, this->outputDimensions[axis], slices);
+  MakeAlias(bufferAlias, buffer, rows, cols, slices);
+  bufferAlias = errorAlias.cols(startCol, startCol + cols - 1);
+
+  MakeAlias(layerError, buffer, buffer.n_rows, buffer.n_cols);
+}
+
 } // namespace mlpack
 
 #endif
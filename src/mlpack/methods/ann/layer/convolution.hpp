@@ -18,6 +18,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
 #include "layer.hpp"
@@ -58,6 +60,12 @@ namespace mlpack {
  * a 2-D image (or object) of the original 196x14 size, using this as the input
  * for the 14 filters of this example.
  *
+ * If a convolution rule is Im2ColConvolution, the corresponding pass (forward,
+ * backward or gradient) is computed for the whole batch with a single matrix
+ * multiplication instead of one convolution per point and pair of maps.  This
+ * is usually much faster, at the cost of memory for the unfolded patches of
+ * the whole batch.
+ *
  * @tparam ForwardConvolutionRule Convolution to perform forward process.
  * @tparam BackwardConvolutionRule Convolution to perform backward process.
  * @tparam GradientConvolutionRule Convolution to calculate gradient.
@@ -192,6 +200,17 @@ class ConvolutionType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Scale and shift the output of the layer by modifying the weights and the
+   * bias.  This is only possible when `scale` and `shift` are the same for all
+   * the elements of each output map, and `shift` is zero if the layer has no
+   * bias.
+   *
+   * @param scale Factor applied to each output element.
+   * @param shift Offset added to each output element.
+   */
+  bool FoldAffine(const MatType& scale, const MatType& shift);
+
   //! Get the parameters.
   MatType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -260,6 +279,15 @@ class ConvolutionType : public Layer<MatType>
         (useBias ? maps : 0);
   }
 
+  //! Get the estimated number of floating-point operations of Forward(): one
+  //! multiply-add per element of each filter and element of the output.
+  double ForwardFlops(const size_t batchSize) const
+  {
+    return 2.0 * inMaps * kernelWidth * kernelHeight * maps *
+        this->outputDimensions[0] * this->outputDimensions[1] *
+        higherInDimensions * batchSize;
+  }
+
   //! Compute the output dimensions of the layer based on `InputDimensions()`.
   void ComputeOutputDimensions();
 
@@ -294,6 +322,45 @@ class ConvolutionType : public Layer<MatType>
    */
   void InitializeSamePadding();
 
+  /**
+   * Compute the forward pass of the whole batch with one matrix multiplication
+   * (used when ForwardConvolutionRule is Im2ColConvolution).
+   *
+   * @param input The (padded) input, with one slice per map of each point.
+   * @param output Resulting output activation.
+   */
+  void Im2ColForward(const CubeType& input, MatType& output);
+
+  /**
+   * Compute the backward pass of the whole batch with one matrix
+   * multiplication (used when BackwardConvolutionRule is Im2ColConvolution).
+   * The result is stored in gTemp.
+   *
+   * @param gy The backpropagated error.
+   */
+  void Im2ColBackward(const MatType& gy);
+
+  /**
+   * Compute the gradient of the whole batch with one matrix multiplication
+   * (used when GradientConvolutionRule is Im2ColConvolution).
+   *
+   * @param input The (padded) input, with one slice per map of each point.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Im2ColGradient(const CubeType& input,
+                      const MatType& error,
+                      MatType& gradient);
+
+  /**
+   * Rearrange the error of the output so that row n * outputSize + p holds
+   * the error of every output map at position p of point n.
+   *
+   * @param error The error of the output.
+   * @param errorRows The rearranged error.
+   */
+  void ErrorRows(const MatType& error, MatType& errorRows) const;
+
   /**
    * Rotates a 3rd-order tensor counterclockwise by 180 degrees.
    *
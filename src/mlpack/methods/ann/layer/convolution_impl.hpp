@@ -321,6 +321,12 @@ void ConvolutionType<
       this->outputDimensions[1], maps * higherInDimensions * batchSize);
   outputTemp.zeros();
 
+  if (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    Im2ColForward(inputTemp, output);
+    return;
+  }
+
   // We "ignore" dimensions higher than the third---that means that we just pass
   // them through and treat them like different input points.
   //
@@ -332,7 +338,7 @@ void ConvolutionType<
     const size_t fullOutputOffset = offset * maps;
 
     // Iterate over output maps.
-    #pragma omp parallel for
+    #pragma omp parallel for num_threads(Parallel::Threads())
     for (size_t outMap = 0; outMap < (size_t) maps; ++outMap)
     {
       MatType& convOutput = outputTemp.slice(outMap + fullOutputOffset);
@@ -382,6 +388,12 @@ void ConvolutionType<
       inMaps * higherInDimensions * batchSize);
   gTemp.zeros();
 
+  if (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    Im2ColBackward(gy);
+    return;
+  }
+
   const bool usingPadding =
       (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
 
@@ -401,7 +413,8 @@ void ConvolutionType<
     dilatedMappedError.zeros(mappedError.n_rows * strideWidth -
         (strideWidth - 1), mappedError.n_cols * strideHeight -
         (strideHeight - 1), mappedError.n_slices);
-    #pragma omp parallel for collapse(3) schedule(static)
+    #pragma omp parallel for collapse(3) schedule(static) \
+        num_threads(Parallel::Threads())
     for (size_t i = 0; i < mappedError.n_slices; ++i)
     {
       for (size_t j = 0; j < mappedError.n_cols; ++j)
@@ -415,7 +428,7 @@ void ConvolutionType<
     }
   }
 
-  #pragma omp parallel for schedule(static)
+  #pragma omp parallel for schedule(static) num_threads(Parallel::Threads())
   for (size_t map = 0; map < (size_t) (maps * inMaps); ++map)
   {
     Rotate180(weight.slice(map), rotatedFilters.slice(map));
@@ -428,7 +441,8 @@ void ConvolutionType<
       inMaps * higherInDimensions * batchSize);
 
   // See Forward() for the overall iteration strategy.
-  #pragma omp parallel for schedule(dynamic)
+  #pragma omp parallel for schedule(dynamic) \
+      num_threads(Parallel::Threads())
   for (size_t offset = 0; offset < (higherInDimensions * batchSize); ++offset)
   {
     const size_t fullInputOffset = offset * inMaps;
@@ -500,6 +514,15 @@ void ConvolutionType<
   const size_t paddedRows = this->inputDimensions[0] + padWLeft + padWRight;
   const size_t paddedCols = this->inputDimensions[1] + padHTop + padHBottom;
 
+  if (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    CubeType inputCube;
+    MakeAlias(inputCube, (usingPadding ? inputPadded : input), paddedRows,
+        paddedCols, inMaps * higherInDimensions * batchSize);
+    Im2ColGradient(inputCube, error, gradient);
+    return;
+  }
+
   CubeType inputTemp(
       const_cast<MatType&>(usingPadding ? inputPadded : input).memptr(),
       paddedRows, paddedCols, inMaps * batchSize, false, false);
@@ -523,7 +546,7 @@ void ConvolutionType<
     const size_t fullInputOffset = offset * inMaps;
     const size_t fullOutputOffset = offset * maps;
 
-    #pragma omp parallel for
+    #pragma omp parallel for num_threads(Parallel::Threads())
     for (size_t outMap = 0; outMap < (size_t) maps; ++outMap)
     {
       MatType& curError = mappedError.slice(outMap + fullOutputOffset);
@@ -546,6 +569,192 @@ void ConvolutionType<
   }
 }
 
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+void ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::Im2ColForward(const CubeType& input, MatType& output)
+{
+  const size_t numImages = higherInDimensions * batchSize;
+  const size_t outputSize = this->outputDimensions[0] *
+      this->outputDimensions[1];
+
+  MatType columns;
+  Im2ColConvolution<ValidConvolution>::Im2Col(input, inMaps, kernelWidth,
+      kernelHeight, this->outputDimensions[0], this->outputDimensions[1],
+      strideWidth, strideHeight, 1, 1, columns);
+
+  // Column m of weightMat holds the filters of output map m for all the input
+  // maps, in the same order as the rows of the columns matrix.
+  MatType weightMat;
+  MakeAlias(weightMat, weight, kernelWidth * kernelHeight * inMaps, maps);
+  MatType result = columns.t() * weightMat;
+  if (useBias)
+    result.each_row() += bias.t();
+
+  // Row n * outputSize + p of the result holds the output of every map at
+  // position p of point n; move the maps of each point next to each other.
+  MatType outputMat;
+  MakeAlias(outputMat, output, outputSize, maps * numImages);
+  #pragma omp parallel for num_threads(Parallel::Threads())
+  for (size_t n = 0; n < numImages; ++n)
+  {
+    outputMat.cols(n * maps, (n + 1) * maps - 1) =
+        result.rows(n * outputSize, (n + 1) * outputSize - 1);
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+void ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::Im2ColBackward(const MatType& gy)
+{
+  MatType errorRows;
+  ErrorRows(gy, errorRows);
+
+  // The error of each patch of the padded input is the weighted sum of the
+  // errors of the outputs it was used for; fold the patches back into the
+  // padded input, and then drop the padding.
+  MatType weightMat;
+  MakeAlias(weightMat, weight, kernelWidth * kernelHeight * inMaps, maps);
+  const MatType columns = weightMat * errorRows.t();
+
+  CubeType paddedError(this->inputDimensions[0] + padWLeft + padWRight,
+      this->inputDimensions[1] + padHTop + padHBottom,
+      inMaps * higherInDimensions * batchSize, arma::fill::zeros);
+  Im2ColConvolution<ValidConvolution>::Col2Im(columns, inMaps, kernelWidth,
+      kernelHeight, this->outputDimensions[0], this->outputDimensions[1],
+      strideWidth, strideHeight, 1, 1, paddedError);
+
+  gTemp = paddedError.tube(padWLeft, padHTop, padWLeft + gTemp.n_rows - 1,
+      padHTop + gTemp.n_cols - 1);
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+void ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::Im2ColGradient(
+    const CubeType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  MatType columns;
+  Im2ColConvolution<ValidConvolution>::Im2Col(input, inMaps, kernelWidth,
+      kernelHeight, this->outputDimensions[0], this->outputDimensions[1],
+      strideWidth, strideHeight, 1, 1, columns);
+
+  MatType errorRows;
+  ErrorRows(error, errorRows);
+
+  // The weights are stored in the same layout as Im2ColForward() uses them.
+  MatType weightGradient;
+  MakeAlias(weightGradient, gradient, kernelWidth * kernelHeight * inMaps,
+      maps);
+  weightGradient = columns * errorRows;
+
+  if (useBias)
+  {
+    gradient.submat(weight.n_elem, 0, weight.n_elem + maps - 1, 0) =
+        sum(errorRows, 0).t();
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+void ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::ErrorRows(const MatType& error, MatType& errorRows) const
+{
+  const size_t numImages = higherInDimensions * batchSize;
+  const size_t outputSize = this->outputDimensions[0] *
+      this->outputDimensions[1];
+
+  MatType errorMat;
+  MakeAlias(errorMat, error, outputSize, maps * numImages);
+  errorRows.set_size(outputSize * numImages, maps);
+  #pragma omp parallel for num_threads(Parallel::Threads())
+  for (size_t n = 0; n < numImages; ++n)
+  {
+    errorRows.rows(n * outputSize, (n + 1) * outputSize - 1) =
+        errorMat.cols(n * maps, (n + 1) * maps - 1);
+  }
+}
+
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename MatType
+>
+bool ConvolutionType<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    MatType
+>::FoldAffine(const MatType& scale, const MatType& shift)
+{
+  // The output holds higherInDimensions groups of maps, each map having
+  // outputSize elements; the transformation has to be the same for all the
+  // elements of a map.
+  const size_t outputSize = this->outputDimensions[0] *
+      this->outputDimensions[1];
+  if (scale.n_elem != outputSize * maps * higherInDimensions ||
+      shift.n_elem != scale.n_elem)
+    return false;
+
+  for (size_t i = 0; i < scale.n_elem; ++i)
+  {
+    const size_t first = ((i / outputSize) % maps) * outputSize;
+    if (scale[i] != scale[first] || shift[i] != shift[first])
+      return false;
+    if (!useBias && shift[i] != 0)
+      return false;
+  }
+
+  for (size_t outMap = 0; outMap < maps; ++outMap)
+  {
+    const typename MatType::elem_type mapScale = scale[outMap * outputSize];
+    weight.slices(outMap * inMaps, (outMap + 1) * inMaps - 1) *= mapScale;
+    if (useBias)
+    {
+      bias[outMap] = bias[outMap] * mapScale +
+          shift[outMap * outputSize];
+    }
+  }
+
+  return true;
+}
+
 template<
     typename ForwardConvolutionRule,
     typename BackwardConvolutionRule,
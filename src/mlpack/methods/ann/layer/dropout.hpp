@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_DROPOUT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random_stream.hpp>
 
 #include "layer.hpp"
 
@@ -77,6 +78,9 @@ class DropoutType : public Layer<MatType>
    */
   void Forward(const MatType& input, MatType& output);
 
+  //! The mask is applied to each element separately.
+  bool ElementwiseForward() const { return true; }
+
   /**
    * Ordinary feed backward pass of the dropout layer.
    *
@@ -86,7 +86,9 @@ void DropoutType<MatType>::Forward(const MatType& input, MatType& output)
   {
     // Scale with input / (1 - ratio) and set values to zero with probability
     // 'ratio'.
-    mask.randu(input.n_rows, input.n_cols);
+    mask.set_size(input.n_rows, input.n_cols);
+    RandomStream stream(RandomStreamSeed());
+    stream.Fill(mask);
     #pragma omp parallel for collapse(2)
     for (size_t i = 0; i < input.n_rows; ++i)
     {
@@ -0,0 +1,225 @@
+/**
+ * @file methods/ann/layer/fast_lstm.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the Fast LSTM class, which implements a Fast LSTM network
+ * layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FAST_LSTM_HPP
+#define MLPACK_METHODS_ANN_LAYER_FAST_LSTM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "recurrent_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * An implementation of a faster version of the LSTM network layer, which
+ * combines the calculation of the input, forget and output gates and the cell
+ * candidate in a single step. The implementation corresponds to the following
+ * algorithm:
+ *
+ * @f{eqnarray}{
+ * i &=& sigmoid(W \cdot x + W \cdot h + b) \\
+ * f &=& sigmoid(W  \cdot x + W \cdot h + b) \\
+ * z &=& tanh(W \cdot x + W \cdot h + b) \\
+ * c &=& f \cdot c + i \cdot z \\
+ * o &=& sigmoid(W \cdot x + W \cdot h + b) \\
+ * h &=& o \cdot tanh(c)
+ * @f}
+ *
+ * Note that FastLSTM network layer does not use peephole connections between
+ * the cell and gates.  The parameters are laid out as the input weights of all
+ * gates (4 * outSize x inSize), their biases, and the recurrent weights
+ * (4 * outSize x outSize); within each block the gates are in the order input
+ * gate, output gate, forget gate, cell candidate.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Hochreiter1997,
+ *   author  = {Hochreiter, Sepp and Schmidhuber, J\"{u}rgen},
+ *   title   = {Long Short-term Memory},
+ *   journal = {Neural Comput.},
+ *   year    = {1997},
+ *   url     = {https://www.bioinf.jku.at/publications/older/2604.pdf}
+ * }
+ * @endcode
+ *
+ * \see LSTM for a standard implementation of the LSTM layer.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class FastLSTMType : public RecurrentLayer<MatType>
+{
+ public:
+  //! Create the FastLSTM object.
+  FastLSTMType();
+
+  /**
+   * Create the FastLSTM layer object using the specified parameters.
+   *
+   * @param outSize The number of output units.
+   */
+  FastLSTMType(const size_t outSize);
+
+  //! Clone the FastLSTMType object. This handles polymorphism correctly.
+  FastLSTMType* Clone() const { return new FastLSTMType(*this); }
+
+  //! Copy the given FastLSTMType object.
+  FastLSTMType(const FastLSTMType& other);
+  //! Take ownership of the given FastLSTMType object's data.
+  FastLSTMType(FastLSTMType&& other);
+  //! Copy the given FastLSTMType object.
+  FastLSTMType& operator=(const FastLSTMType& other);
+  //! Take ownership of the given FastLSTMType object's data.
+  FastLSTMType& operator=(FastLSTMType&& other);
+
+  virtual ~FastLSTMType() { }
+
+  /**
+   * Reset the layer parameter. The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed-forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g);
+
+  /*
+   * Calculate the gradient using the output delta and the input activation.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& /* error */,
+                MatType& gradient);
+
+  /**
+   * Reset the recurrent state of the FastLSTM layer, and allocate enough space
+   * to hold `bpttSteps` of previous passes with a batch size of `batchSize`.
+   *
+   * @param bpttSteps Number of steps of history to allocate space for.
+   * @param batchSize Batch size to prepare for.
+   */
+  void ClearRecurrentState(const size_t bpttSteps, const size_t batchSize);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the number of output units.
+  size_t OutSize() const { return outSize; }
+
+  //! Get the total number of trainable parameters.
+  size_t WeightSize() const
+  {
+    return (4 * outSize * inSize + 4 * outSize + 4 * outSize * outSize);
+  }
+
+  //! Given a properly set InputDimensions(), compute the output dimensions.
+  void ComputeOutputDimensions()
+  {
+    inSize = std::accumulate(this->inputDimensions.begin(),
+        this->inputDimensions.end(), 1, std::multiplies<size_t>());
+    this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+        1);
+
+    // The FastLSTM layer flattens its input.
+    this->outputDimensions[0] = outSize;
+  }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored weight object.
+  MatType weights;
+
+  //! Weights between the input and the four gates (input gate, output gate,
+  //! forget gate and cell candidate, stacked in that order).
+  MatType input2GateWeight;
+
+  //! Bias of the four gates.
+  MatType input2GateBias;
+
+  //! Weights between the output of the previous step and the four gates.
+  MatType output2GateWeight;
+
+  //! Locally-stored pre-activations of the four gates.
+  MatType gates;
+
+  // These members store recurrent state.
+
+  //! Locally-stored activations of the four gates.
+  arma::Cube<typename MatType::elem_type> gateActivation;
+
+  //! Locally-stored cell parameter.
+  arma::Cube<typename MatType::elem_type> cell;
+
+  //! Locally-stored cell activation.
+  arma::Cube<typename MatType::elem_type> cellActivation;
+
+  //! Locally-stored output parameters.
+  arma::Cube<typename MatType::elem_type> outParameter;
+
+  //! Locally-stored error of the four gates, stacked in the same order as the
+  //! weights.
+  MatType gateError;
+
+  //! Locally-stored error of the cell of the previous step.
+  MatType cellError;
+}; // class FastLSTMType
+
+// Convenience typedefs.
+
+// Standard FastLSTM layer.
+typedef FastLSTMType<arma::mat> FastLSTM;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "fast_lstm_impl.hpp"
+
+#endif
@@ -0,0 +1,283 @@
+/**
+ * @file methods/ann/layer/fast_lstm_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the Fast LSTM class, which implements a Fast LSTM network
+ * layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FAST_LSTM_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_FAST_LSTM_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "fast_lstm.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType() :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(const size_t outSize) :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(const FastLSTMType& layer) :
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>::FastLSTMType(FastLSTMType&& layer) :
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+FastLSTMType<MatType>& FastLSTMType<MatType>::operator=(
+    const FastLSTMType& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+FastLSTMType<MatType>& FastLSTMType<MatType>::operator=(
+    FastLSTMType&& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::ClearRecurrentState(
+    const size_t bpttSteps, const size_t batchSize)
+{
+  gates.set_size(4 * outSize, batchSize);
+
+  gateActivation.set_size(4 * outSize, batchSize, bpttSteps);
+  cellActivation.set_size(outSize, batchSize, bpttSteps);
+
+  // Now reset recurrent values to 0.
+  cell.zeros(outSize, batchSize, bpttSteps);
+  outParameter.zeros(outSize, batchSize, bpttSteps);
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
+
+  // Set the weight parameters between the input and the gates.
+  MakeAlias(input2GateWeight, weightsIn, 4 * outSize, inSize);
+  size_t offset = input2GateWeight.n_elem;
+  MakeAlias(input2GateBias, weightsIn, 4 * outSize, 1, offset);
+  offset += input2GateBias.n_elem;
+
+  // Set the weight parameters between the previous output and the gates.
+  MakeAlias(output2GateWeight, weightsIn, 4 * outSize, outSize, offset);
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.
+  const size_t batchSize = input.n_cols;
+  const bool hasPrevious = this->HasPreviousStep();
+  const size_t current = this->CurrentStep();
+  const size_t previous = hasPrevious ? this->PreviousStep() : current;
+
+  // Compute the pre-activations of all the gates at once.
+  gates = input2GateWeight * input;
+  if (hasPrevious)
+    gates += output2GateWeight * outParameter.slice(previous);
+  gates.each_col() += input2GateBias;
+
+  // Now apply the nonlinearities, update the cell and compute the output in a
+  // single pass.  When `current` and `previous` are the same slice, each
+  // element of the previous cell is read before it is overwritten.
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* gate = gates.colptr(j);
+    ElemType* activation = gateActivation.slice_colptr(current, j);
+    const ElemType* previousCell = cell.slice_colptr(previous, j);
+    ElemType* currentCell = cell.slice_colptr(current, j);
+    ElemType* cellAct = cellActivation.slice_colptr(current, j);
+    ElemType* out = outParameter.slice_colptr(current, j);
+
+    for (size_t k = 0; k < 3 * outSize; ++k)
+      activation[k] = 1 / (1 + std::exp(-gate[k]));
+    for (size_t k = 3 * outSize; k < 4 * outSize; ++k)
+      activation[k] = std::tanh(gate[k]);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      ElemType c = activation[k] * activation[3 * outSize + k];
+      if (hasPrevious)
+        c += activation[2 * outSize + k] * previousCell[k];
+
+      currentCell[k] = c;
+      cellAct[k] = std::tanh(c);
+      out[k] = activation[outSize + k] * cellAct[k];
+    }
+  }
+
+  output = outParameter.slice(current);
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.  During the backward pass, the state of the previous
+  // time step is held in the slice before the current one, and
+  // HasPreviousStep() means that the next time step was already processed.
+  const size_t batchSize = gy.n_cols;
+  const bool hasNext = this->HasPreviousStep();
+  const size_t current = this->CurrentStep();
+  const bool hasEarlier = (current > 0);
+  const size_t earlier = hasEarlier ? current - 1 : current;
+
+  // The error of the gates of the next step holds the error that flows back
+  // through the recurrent connection.
+  MatType error;
+  if (hasNext)
+  {
+    error = gy + output2GateWeight.t() * gateError;
+  }
+  else
+  {
+    // Make an alias.
+    MakeAlias(error, gy, gy.n_rows, gy.n_cols);
+    cellError.zeros(outSize, batchSize);
+  }
+
+  gateError.set_size(4 * outSize, batchSize);
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* err = error.colptr(j);
+    const ElemType* activation = gateActivation.slice_colptr(current, j);
+    const ElemType* previousCell = cell.slice_colptr(earlier, j);
+    const ElemType* cellAct = cellActivation.slice_colptr(current, j);
+    ElemType* gateErr = gateError.colptr(j);
+    ElemType* cellErr = cellError.colptr(j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType i = activation[k];
+      const ElemType o = activation[outSize + k];
+      const ElemType f = activation[2 * outSize + k];
+      const ElemType z = activation[3 * outSize + k];
+
+      const ElemType c = err[k] * o * (1 - cellAct[k] * cellAct[k]) +
+          cellErr[k];
+
+      gateErr[k] = c * z * i * (1 - i);
+      gateErr[outSize + k] = err[k] * cellAct[k] * o * (1 - o);
+      gateErr[2 * outSize + k] = hasEarlier ?
+          c * previousCell[k] * f * (1 - f) : 0;
+      gateErr[3 * outSize + k] = c * i * (1 - z * z);
+
+      cellErr[k] = c * f;
+    }
+  }
+
+  g = input2GateWeight.t() * gateError;
+}
+
+template<typename MatType>
+void FastLSTMType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& /* error */,
+    MatType& gradient)
+{
+  // This implementation depends on Gradient() being called just after
+  // Backward(), which is something we can safely assume.
+  const size_t current = this->CurrentStep();
+
+  // input2GateWeight and input2GateBias gradients.
+  MatType weightGradient;
+  MakeAlias(weightGradient, gradient, 4 * outSize, inSize);
+  weightGradient = gateError * input.t();
+  size_t offset = input2GateWeight.n_elem;
+  gradient.submat(offset, 0, offset + input2GateBias.n_elem - 1, 0) =
+      sum(gateError, 1);
+  offset += input2GateBias.n_elem;
+
+  // output2GateWeight gradients; these are only nonzero if there was a
+  // previous output.
+  MakeAlias(weightGradient, gradient, 4 * outSize, outSize, offset);
+  if (current == 0)
+    weightGradient.zeros();
+  else
+    weightGradient = gateError * outParameter.slice(current - 1).t();
+}
+
+template<typename MatType>
+template<typename Archive>
+void FastLSTMType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<RecurrentLayer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+
+  // Clear recurrent state if we are loading.
+  if (Archive::is_loading::value)
+  {
+    gateActivation.clear();
+    cell.clear();
+    cellActivation.clear();
+    outParameter.clear();
+    gateError.clear();
+    cellError.clear();
+  }
+}
+
+} // namespace mlpack
+
+#endif
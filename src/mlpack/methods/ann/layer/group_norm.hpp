@@ -0,0 +1,181 @@
+/**
+ * @file methods/ann/layer/group_norm.hpp
+ * @author Abhinav Anand
+ *
+ * Definition of the Group Normalization class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GROUPNORM_HPP
+#define MLPACK_METHODS_ANN_LAYER_GROUPNORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * Declaration of the Group Normalization class. The layer transforms the input
+ * data into zero mean and unit variance and then scales and shifts the data by
+ * parameters, gamma and beta respectively, over a single training point.
+ * These parameters are learnt by the network.  Group Normalization is
+ * different from Layer Normalization in the way that the channels of the input
+ * are divided into groups, and the mean and standard deviation are computed
+ * over each group of each point.  Gamma and beta hold one value per channel.
+ *
+ * For an input with at least three dimensions (as given by a convolution), the
+ * channels are the third and higher dimensions, each holding a map of the
+ * first two.  Otherwise, the channels are the last dimension.  The number of
+ * channels must be divisible by the number of groups.  With one group, this is
+ * Layer Normalization with per-channel parameters, and with one group per
+ * channel, this is Instance Normalization.
+ *
+ * For more information, refer to the following papers,
+ *
+ * @code
+ * @article{wu2018group,
+ *   author    = {Wu, Yuxin and He, Kaiming},
+ *   title     = {Group normalization},
+ *   year      = {2018},
+ *   url       = {https://arxiv.org/abs/1803.08494}
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+  typename MatType = arma::mat
+>
+class GroupNormType : public Layer<MatType>
+{
+ public:
+  /**
+   * Create the GroupNorm object for a specified number of groups.
+   *
+   * @param groupCount The number of groups the channels are divided into.
+   * @param eps The epsilon added to variance to ensure numerical stability.
+   */
+  GroupNormType(const size_t groupCount = 1, const double eps = 1e-8);
+
+  //! Clone the GroupNormType object. This handles polymorphism correctly.
+  GroupNormType* Clone() const override { return new GroupNormType(*this); }
+
+  /**
+   * Forward pass of Group Normalization. Transforms the input data
+   * into zero mean and unit variance, scales the data by a factor gamma and
+   * shifts it by beta.
+   *
+   * @param input Input data for the layer.
+   * @param output Resulting output activations.
+   */
+  void Forward(const MatType& input, MatType& output) override;
+
+  /**
+   * Backward pass through the layer.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g) override;
+
+  /**
+   * Calculate the gradient using the output delta and the input activations.
+   *
+   * @param input The input activations.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient) override;
+
+  //! Get the parameters.
+  MatType const& Parameters() const override { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() override { return weights; }
+
+  //! Get the mean of each group of each point.
+  MatType Mean() { return mean; }
+
+  //! Get the variance of each group of each point.
+  MatType Variance() { return variance; }
+
+  //! Get the number of channels.
+  size_t Channels() const { return channels; }
+
+  //! Get the group count.
+  size_t GroupCount() const { return groupCount; }
+
+  //! Get the value of epsilon.
+  double Epsilon() const { return eps; }
+
+  size_t WeightSize() const override { return 2 * channels; }
+
+  void ComputeOutputDimensions() override;
+
+  void SetWeights(const MatType& weightsIn) override;
+
+  void CustomInitialize(
+      MatType& /* W */,
+      const size_t /* elements */) override;
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored group count.
+  size_t groupCount;
+
+  //! Locally-stored epsilon value.
+  double eps;
+
+  //! Cached number of channels.
+  size_t channels;
+
+  //! Cached number of elements of each channel.
+  size_t channelSize;
+
+  //! Locally-stored scale parameter.
+  MatType gamma;
+
+  //! Locally-stored shift parameter.
+  MatType beta;
+
+  //! Locally-stored parameters.
+  MatType weights;
+
+  //! Locally-stored mean object.
+  MatType mean;
+
+  //! Locally-stored variance object.
+  MatType variance;
+
+  //! Locally-stored inverse of the standard deviation of each group.
+  MatType stdInv;
+
+  //! Locally-stored normalized input, with one column per group of each point.
+  MatType normalized;
+}; // class GroupNormType
+
+// Standard GroupNorm type.
+typedef GroupNormType<arma::mat> GroupNorm;
+
+} // namespace mlpack
+
+// Include the implementation.
+#include "group_norm_impl.hpp"
+
+#endif
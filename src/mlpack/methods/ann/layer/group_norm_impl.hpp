@@ -0,0 +1,189 @@
+/**
+ * @file methods/ann/layer/group_norm_impl.hpp
+ * @author Abhinav Anand
+ *
+ * Implementation of the Group Normalization class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GROUPNORM_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_GROUPNORM_IMPL_HPP
+
+// In case it is not included.
+#include "group_norm.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+GroupNormType<MatType>::GroupNormType(
+    const size_t groupCount, const double eps) :
+    groupCount(groupCount),
+    eps(eps),
+    channels(0),
+    channelSize(0)
+{
+  if (groupCount == 0)
+  {
+    throw std::invalid_argument("GroupNormType::GroupNormType(): groupCount "
+        "must be positive!");
+  }
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::ComputeOutputDimensions()
+{
+  this->outputDimensions = this->inputDimensions;
+
+  // The channels are the third and higher dimensions of image-like input, and
+  // the last dimension otherwise.
+  const size_t firstChannelDim = (this->inputDimensions.size() >= 3) ? 2 :
+      this->inputDimensions.size() - 1;
+  channelSize = 1;
+  channels = 1;
+  for (size_t i = 0; i < this->inputDimensions.size(); ++i)
+  {
+    if (i < firstChannelDim)
+      channelSize *= this->inputDimensions[i];
+    else
+      channels *= this->inputDimensions[i];
+  }
+
+  if (channels % groupCount != 0)
+  {
+    throw std::invalid_argument("GroupNormType::ComputeOutputDimensions(): "
+        "number of channels (" + std::to_string(channels) + ") must be "
+        "divisible by groupCount (" + std::to_string(groupCount) + ")!");
+  }
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, 2 * channels, 1);
+  MakeAlias(gamma, weightsIn, channels, 1);
+  MakeAlias(beta, weightsIn, channels, 1, gamma.n_elem);
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::CustomInitialize(
+      MatType& W,
+      const size_t elements)
+{
+  if (elements != 2 * channels)
+  {
+    throw std::invalid_argument("GroupNormType::CustomInitialize(): wrong "
+                                "elements size!");
+  }
+  MatType gammaTemp;
+  MatType betaTemp;
+  // Gamma acts as the scaling parameters for the normalized output.
+  MakeAlias(gammaTemp, W, channels, 1);
+  // Beta acts as the shifting parameters for the normalized output.
+  MakeAlias(betaTemp, W, channels, 1, gammaTemp.n_elem);
+
+  gammaTemp.fill(1.0);
+  betaTemp.fill(0.0);
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  // The channels of a group are next to each other, so each group of each
+  // point is a column of an alias of the input.
+  const size_t groupSize = channelSize * (channels / groupCount);
+  MatType inputGroups;
+  MakeAlias(inputGroups, input, groupSize, groupCount * input.n_cols);
+
+  mean = arma::mean(inputGroups, 0);
+  variance = arma::var(inputGroups, 1, 0);
+  stdInv = 1.0 / sqrt(variance + eps);
+
+  // Normalize the input; this is reused in the backward and gradient step.
+  normalized = inputGroups.each_row() - mean;
+  normalized.each_row() %= stdInv;
+
+  // Scale and shift each channel.
+  MatType normalizedChannels, outputChannels;
+  MakeAlias(normalizedChannels, normalized, channelSize,
+      channels * input.n_cols);
+  MakeAlias(outputChannels, output, channelSize, channels * input.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < outputChannels.n_cols; ++i)
+  {
+    outputChannels.col(i) = normalizedChannels.col(i) * gamma[i % channels] +
+        beta[i % channels];
+  }
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  const size_t groupSize = channelSize * (channels / groupCount);
+
+  // dl / dxhat.
+  MatType norm(gy.n_rows, gy.n_cols);
+  MatType gyChannels, normChannels;
+  MakeAlias(gyChannels, gy, channelSize, channels * gy.n_cols);
+  MakeAlias(normChannels, norm, channelSize, channels * gy.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < normChannels.n_cols; ++i)
+    normChannels.col(i) = gyChannels.col(i) * gamma[i % channels];
+
+  // (dl / dxhat - mean(dl / dxhat) - xhat * mean(dl / dxhat * xhat)) / std,
+  // for each group.
+  MatType normGroups, gGroups;
+  MakeAlias(normGroups, norm, groupSize, groupCount * gy.n_cols);
+  MakeAlias(gGroups, g, groupSize, groupCount * gy.n_cols);
+  gGroups = normGroups.each_row() - arma::mean(normGroups, 0);
+  gGroups -= normalized.each_row() % arma::mean(normGroups % normalized, 0);
+  gGroups.each_row() %= stdInv;
+}
+
+template<typename MatType>
+void GroupNormType<MatType>::Gradient(
+    const MatType& /* input */,
+    const MatType& error,
+    MatType& gradient)
+{
+  const size_t batchSize = error.n_cols;
+  MatType errorChannels, normalizedChannels;
+  MakeAlias(errorChannels, error, channelSize, channels * batchSize);
+  MakeAlias(normalizedChannels, normalized, channelSize, channels * batchSize);
+
+  // Step 5: dl / dy * xhat, summed over the elements of each channel and then
+  // over the points.
+  MatType channelSums = sum(normalizedChannels % errorChannels, 0);
+  MatType pointSums;
+  MakeAlias(pointSums, channelSums, channels, batchSize);
+  gradient.submat(0, 0, channels - 1, 0) = sum(pointSums, 1);
+
+  // Step 6: dl / dy.
+  channelSums = sum(errorChannels, 0);
+  MakeAlias(pointSums, channelSums, channels, batchSize);
+  gradient.submat(channels, 0, 2 * channels - 1, 0) = sum(pointSums, 1);
+}
+
+template<typename MatType>
+template<typename Archive>
+void GroupNormType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(groupCount));
+  ar(CEREAL_NVP(eps));
+  ar(CEREAL_NVP(channels));
+  ar(CEREAL_NVP(channelSize));
+}
+
+} // namespace mlpack
+
+#endif
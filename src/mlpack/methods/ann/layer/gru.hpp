@@ -0,0 +1,224 @@
+/**
+ * @file methods/ann/layer/gru.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Definition of the GRU layer.
+ *
+ * For more information, read the following paper:
+ *
+ * @code
+ * @inproceedings{chung2015gated,
+ *    title     = {Gated Feedback Recurrent Neural Networks.},
+ *    author    = {Chung, Junyoung and G{\"u}l{\c{c}}ehre, Caglar and Cho,
+ *                 Kyunghyun and Bengio, Yoshua},
+ *    booktitle = {ICML},
+ *    pages     = {2067--2075},
+ *    year      = {2015},
+ *    url       = {https://arxiv.org/abs/1502.02367}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GRU_HPP
+#define MLPACK_METHODS_ANN_LAYER_GRU_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "recurrent_layer.hpp"
+
+namespace mlpack {
+
+/**
+ * An implementation of a GRU network layer.  The implementation corresponds to
+ * the following algorithm:
+ *
+ * @f{eqnarray}{
+ * z &=& sigmoid(W_z \cdot x + U_z \cdot h + b_z) \\
+ * r &=& sigmoid(W_r \cdot x + U_r \cdot h + b_r) \\
+ * \hat{h} &=& tanh(W_h \cdot x + U_h \cdot (r \odot h) + b_h) \\
+ * h &=& z \odot h + (1 - z) \odot \hat{h}
+ * @f}
+ *
+ * The weights of the update gate, the reset gate and the candidate are stacked,
+ * so that each step computes the input contribution of all three with one
+ * matrix product.  The parameters are laid out as the input weights
+ * (3 * outSize x inSize), their biases, the recurrent weights of the update and
+ * reset gates (2 * outSize x outSize), and the recurrent weights of the
+ * candidate (outSize x outSize); within each block the order is update gate,
+ * reset gate, candidate.
+ *
+ * This layer can be used in RNN networks.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class GRUType : public RecurrentLayer<MatType>
+{
+ public:
+  //! Create the GRU object.
+  GRUType();
+
+  /**
+   * Create the GRU layer object using the specified parameters.
+   *
+   * @param outSize The number of output units.
+   */
+  GRUType(const size_t outSize);
+
+  //! Clone the GRUType object. This handles polymorphism correctly.
+  GRUType* Clone() const { return new GRUType(*this); }
+
+  //! Copy the given GRUType object.
+  GRUType(const GRUType& other);
+  //! Take ownership of the given GRUType object's data.
+  GRUType(GRUType&& other);
+  //! Copy the given GRUType object.
+  GRUType& operator=(const GRUType& other);
+  //! Take ownership of the given GRUType object's data.
+  GRUType& operator=(GRUType&& other);
+
+  virtual ~GRUType() { }
+
+  /**
+   * Reset the layer parameter. The method is called to
+   * assign the allocated memory to the internal learnable parameters.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed-forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g);
+
+  /*
+   * Calculate the gradient using the output delta and the input activation.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& /* error */,
+                MatType& gradient);
+
+  /**
+   * Reset the recurrent state of the GRU layer, and allocate enough space to
+   * hold `bpttSteps` of previous passes with a batch size of `batchSize`.
+   *
+   * @param bpttSteps Number of steps of history to allocate space for.
+   * @param batchSize Batch size to prepare for.
+   */
+  void ClearRecurrentState(const size_t bpttSteps, const size_t batchSize);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the number of output units.
+  size_t OutSize() const { return outSize; }
+
+  //! Get the total number of trainable parameters.
+  size_t WeightSize() const
+  {
+    return (3 * outSize * inSize + 3 * outSize + 3 * outSize * outSize);
+  }
+
+  //! Given a properly set InputDimensions(), compute the output dimensions.
+  void ComputeOutputDimensions()
+  {
+    inSize = std::accumulate(this->inputDimensions.begin(),
+        this->inputDimensions.end(), 1, std::multiplies<size_t>());
+    this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+        1);
+
+    // The GRU layer flattens its input.
+    this->outputDimensions[0] = outSize;
+  }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored weight object.
+  MatType weights;
+
+  //! Weights between the input and the update gate, reset gate and candidate.
+  MatType input2GateWeight;
+
+  //! Bias of the update gate, reset gate and candidate.
+  MatType input2GateBias;
+
+  //! Weights between the output of the previous step and the update and reset
+  //! gates.
+  MatType output2GateWeight;
+
+  //! Weights between the reset output of the previous step and the candidate.
+  MatType output2HiddenWeight;
+
+  //! Locally-stored pre-activations of the gates and the candidate.
+  MatType gates;
+
+  //! Locally-stored previous output, scaled by the reset gate.
+  MatType resetOutput;
+
+  // These members store recurrent state.
+
+  //! Locally-stored activations of the update gate, reset gate and candidate.
+  arma::Cube<typename MatType::elem_type> gateActivation;
+
+  //! Locally-stored output parameters.
+  arma::Cube<typename MatType::elem_type> outParameter;
+
+  //! Locally-stored error of the gates, stacked in the same order as the
+  //! weights.
+  MatType gateError;
+
+  //! Locally-stored error of the output of the previous step.
+  MatType recurrentError;
+}; // class GRUType
+
+// Convenience typedefs.
+
+// Standard GRU layer.
+typedef GRUType<arma::mat> GRU;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "gru_impl.hpp"
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * @file methods/ann/layer/gru_impl.hpp
+ * @author Sumedh Ghaisas
+ *
+ * Implementation of the GRU class, which implements a GRU network layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_GRU_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_GRU_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "gru.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+GRUType<MatType>::GRUType() :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(const size_t outSize) :
+    RecurrentLayer<MatType>(),
+    inSize(0),
+    outSize(outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(const GRUType& layer) :
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>::GRUType(GRUType&& layer) :
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(layer.inSize),
+    outSize(layer.outSize)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+GRUType<MatType>& GRUType<MatType>::operator=(const GRUType& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+GRUType<MatType>& GRUType<MatType>::operator=(GRUType&& layer)
+{
+  if (this != &layer)
+  {
+    RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+void GRUType<MatType>::ClearRecurrentState(
+    const size_t bpttSteps, const size_t batchSize)
+{
+  gates.set_size(3 * outSize, batchSize);
+  resetOutput.set_size(outSize, batchSize);
+
+  gateActivation.set_size(3 * outSize, batchSize, bpttSteps);
+
+  // Now reset recurrent values to 0.
+  outParameter.zeros(outSize, batchSize, bpttSteps);
+}
+
+template<typename MatType>
+void GRUType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
+
+  // Set the weight parameters between the input and the gates.
+  MakeAlias(input2GateWeight, weightsIn, 3 * outSize, inSize);
+  size_t offset = input2GateWeight.n_elem;
+  MakeAlias(input2GateBias, weightsIn, 3 * outSize, 1, offset);
+  offset += input2GateBias.n_elem;
+
+  // Set the weight parameters between the previous output and the gates.
+  MakeAlias(output2GateWeight, weightsIn, 2 * outSize, outSize, offset);
+  offset += output2GateWeight.n_elem;
+  MakeAlias(output2HiddenWeight, weightsIn, outSize, outSize, offset);
+}
+
+template<typename MatType>
+void GRUType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.
+  const size_t batchSize = input.n_cols;
+  const bool hasPrevious = this->HasPreviousStep();
+  const size_t current = this->CurrentStep();
+  const size_t previous = hasPrevious ? this->PreviousStep() : current;
+
+  // Compute the input contribution of the gates and the candidate at once.
+  gates = input2GateWeight * input;
+  gates.each_col() += input2GateBias;
+  if (hasPrevious)
+  {
+    gates.rows(0, 2 * outSize - 1) += output2GateWeight *
+        outParameter.slice(previous);
+  }
+
+  // The candidate depends on the reset gate, so the gates are applied first.
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* gate = gates.colptr(j);
+    const ElemType* previousOut = outParameter.slice_colptr(previous, j);
+    ElemType* activation = gateActivation.slice_colptr(current, j);
+    ElemType* reset = resetOutput.colptr(j);
+
+    for (size_t k = 0; k < 2 * outSize; ++k)
+      activation[k] = 1 / (1 + std::exp(-gate[k]));
+
+    for (size_t k = 0; k < outSize; ++k)
+      reset[k] = hasPrevious ? activation[outSize + k] * previousOut[k] : 0;
+  }
+
+  if (hasPrevious)
+  {
+    gates.rows(2 * outSize, 3 * outSize - 1) += output2HiddenWeight *
+        resetOutput;
+  }
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* gate = gates.colptr(j) + 2 * outSize;
+    ElemType* activation = gateActivation.slice_colptr(current, j);
+    ElemType* out = outParameter.slice_colptr(current, j);
+    const ElemType* previousOut = outParameter.slice_colptr(previous, j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType z = activation[k];
+      const ElemType hidden = std::tanh(gate[k]);
+      activation[2 * outSize + k] = hidden;
+
+      // When `current` and `previous` are the same slice, the previous output
+      // is read before it is overwritten.
+      out[k] = (1 - z) * hidden + (hasPrevious ? z * previousOut[k] : 0);
+    }
+  }
+
+  output = outParameter.slice(current);
+}
+
+template<typename MatType>
+void GRUType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.  During the backward pass, the output of the previous
+  // time step is held in the slice before the current one, and
+  // HasPreviousStep() means that the next time step was already processed.
+  const size_t batchSize = gy.n_cols;
+  const size_t current = this->CurrentStep();
+  const bool hasEarlier = (current > 0);
+  const size_t earlier = hasEarlier ? current - 1 : current;
+
+  MatType error;
+  if (this->HasPreviousStep())
+  {
+    error = gy + recurrentError;
+  }
+  else
+  {
+    // Make an alias.
+    MakeAlias(error, gy, gy.n_rows, gy.n_cols);
+  }
+
+  gateError.set_size(3 * outSize, batchSize);
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* err = error.colptr(j);
+    const ElemType* activation = gateActivation.slice_colptr(current, j);
+    const ElemType* previousOut = outParameter.slice_colptr(earlier, j);
+    ElemType* gateErr = gateError.colptr(j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType z = activation[k];
+      const ElemType hidden = activation[2 * outSize + k];
+      const ElemType h = hasEarlier ? previousOut[k] : 0;
+
+      gateErr[k] = err[k] * (h - hidden) * z * (1 - z);
+      gateErr[2 * outSize + k] = err[k] * (1 - z) * (1 - hidden * hidden);
+    }
+  }
+
+  // The error of the reset output of the previous step.
+  const MatType resetError = output2HiddenWeight.t() *
+      gateError.rows(2 * outSize, 3 * outSize - 1);
+
+  recurrentError.set_size(outSize, batchSize);
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* err = error.colptr(j);
+    const ElemType* activation = gateActivation.slice_colptr(current, j);
+    const ElemType* previousOut = outParameter.slice_colptr(earlier, j);
+    const ElemType* resetErr = resetError.colptr(j);
+    ElemType* gateErr = gateError.colptr(j);
+    ElemType* recurrentErr = recurrentError.colptr(j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType r = activation[outSize + k];
+      const ElemType h = hasEarlier ? previousOut[k] : 0;
+
+      gateErr[outSize + k] = resetErr[k] * h * r * (1 - r);
+      recurrentErr[k] = resetErr[k] * r + err[k] * activation[k];
+    }
+  }
+
+  recurrentError += output2GateWeight.t() * gateError.rows(0, 2 * outSize - 1);
+  g = input2GateWeight.t() * gateError;
+}
+
+template<typename MatType>
+void GRUType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& /* error */,
+    MatType& gradient)
+{
+  // This implementation depends on Gradient() being called just after
+  // Backward(), which is something we can safely assume.
+  const size_t current = this->CurrentStep();
+
+  // input2GateWeight and input2GateBias gradients.
+  MatType weightGradient;
+  MakeAlias(weightGradient, gradient, 3 * outSize, inSize);
+  weightGradient = gateError * input.t();
+  size_t offset = input2GateWeight.n_elem;
+  gradient.submat(offset, 0, offset + input2GateBias.n_elem - 1, 0) =
+      sum(gateError, 1);
+  offset += input2GateBias.n_elem;
+
+  // The recurrent weights only receive a gradient if there was a previous
+  // output.
+  if (current == 0)
+  {
+    gradient.submat(offset, 0, gradient.n_elem - 1, 0).zeros();
+    return;
+  }
+
+  const MatType& previousOut = outParameter.slice(current - 1);
+  MakeAlias(weightGradient, gradient, 2 * outSize, outSize, offset);
+  weightGradient = gateError.rows(0, 2 * outSize - 1) * previousOut.t();
+  offset += output2GateWeight.n_elem;
+
+  const MatType reset = gateActivation.slice(current).rows(outSize,
+      2 * outSize - 1) % previousOut;
+  MakeAlias(weightGradient, gradient, outSize, outSize, offset);
+  weightGradient = gateError.rows(2 * outSize, 3 * outSize - 1) * reset.t();
+}
+
+template<typename MatType>
+template<typename Archive>
+void GRUType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<RecurrentLayer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+
+  // Clear recurrent state if we are loading.
+  if (Archive::is_loading::value)
+  {
+    gateActivation.clear();
+    outParameter.clear();
+    gateError.clear();
+    recurrentError.clear();
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -271,6 +271,54 @@ class Layer
       const size_t /* elements */)
   { /* Nothing to do here */ }
 
+  /**
+   * Return whether Forward() can be called with `input` and `output` holding
+   * the same memory: that is the case when each element of the output only
+   * depends on the corresponding element of the input, or (as for the
+   * normalization layers) when the part of the input that an output element
+   * depends on is read completely before it is written.  This is used to run
+   * activation and normalization layers in place when a network is frozen for
+   * inference.
+   */
+  virtual bool ElementwiseForward() const { return false; }
+
+  /**
+   * Modify the weights of the layer so that the output of Forward() becomes
+   * `scale % output + shift`, where `scale` and `shift` are column vectors with
+   * one element per element of the output.  This is used to fold a BatchNorm
+   * layer into the layer before it when a network is frozen for inference.
+   * Return false, without modifying anything, if the layer cannot represent the
+   * transformation.
+   *
+   * @param * (scale) Factor applied to each output element.
+   * @param * (shift) Offset added to each output element.
+   */
+  virtual bool FoldAffine(const MatType& /* scale */,
+                          const MatType& /* shift */)
+  {
+    return false;
+  }
+
+  /**
+   * Return an estimate of the number of floating-point operations of a call to
+   * Forward() with a batch of the given size.  This is only used for profiling
+   * (see `NetworkProfiler`).  By default, a layer with weights is assumed to
+   * do one multiply-add per weight and point (as `Linear` does), and a layer
+   * without weights one operation per element of its output.
+   *
+   * @param batchSize Number of points of the batch.
+   */
+  virtual double ForwardFlops(const size_t batchSize) const
+  {
+    if (WeightSize() > 0)
+      return 2.0 * WeightSize() * batchSize;
+
+    double outputElements = 1.0;
+    for (size_t i = 0; i < outputDimensions.size(); ++i)
+      outputElements *= outputDimensions[i];
+    return outputElements * batchSize;
+  }
+
   //! Compute the output dimensions.  This should be overloaded if the layer is
   //! meant to work on higher-dimensional objects.  When this is called, it is a
   //! safe assumption that InputDimensions() is correct.
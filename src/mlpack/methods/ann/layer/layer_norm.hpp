@@ -14,6 +14,9 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "layer.hpp"
+#include "normalization_kernels.hpp"
+
 namespace mlpack {
 
 /**
@@ -25,6 +28,12 @@ namespace mlpack {
  * for individual training cases, and the mean and standard deviations are
  * computed across the layer dimensions, as opposed to across the batch.
  *
+ * Each column is normalized in a single pass: its moments are computed while
+ * it is in cache, and it is then normalized, scaled and shifted.  The inverse
+ * standard deviation is cached for the backward pass, which itself only needs
+ * two sums per column.  The normalized input is only kept in training mode,
+ * and `Forward()` may be called in place.
+ *
  * For more information, refer to the following papers,
  *
  * @code
@@ -105,6 +114,10 @@ class LayerNormType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient) override;
 
+  //! Forward() may be called with the input and output holding the same
+  //! memory.
+  bool ElementwiseForward() const override { return true; }
+
   //! Get the parameters.
   MatType const& Parameters() const override { return weights; }
   //! Modify the parameters.
@@ -168,11 +181,11 @@ class LayerNormType : public Layer<MatType>
   //! Locally-stored variance object.
   MatType variance;
 
+  //! Locally-stored inverse standard deviation of each column.
+  MatType stdInv;
+
   //! Locally-stored normalized input.
   MatType normalized;
-
-  //! Locally-stored zero mean input.
-  MatType inputMean;
 }; // class LayerNormType
 
 // Standard LayerNorm type
@@ -59,20 +59,44 @@ template<typename MatType>
 void LayerNormType<MatType>::Forward(
     const MatType& input, MatType& output)
 {
-  mean = arma::mean(input, 0);
-  variance = arma::var(input, 1, 0);
-
-  // Normalize the input.
-  output = input.each_row() - mean;
-  inputMean = output;
-  output.each_row() /= sqrt(variance + eps);
-
-  // Reused in the backward and gradient step.
-  normalized = output;
-
-  // Scale and shift the output.
-  output.each_col() %= gamma;
-  output.each_col() += beta;
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t n = input.n_rows;
+  mean.set_size(1, input.n_cols);
+  variance.set_size(1, input.n_cols);
+  stdInv.set_size(1, input.n_cols);
+  output.set_size(arma::size(input));
+
+  // The normalized input is only reused in the backward and gradient step.
+  if (this->training)
+    normalized.set_size(arma::size(input));
+
+  // Each column is read completely before it is written, so the output may be
+  // the same memory as the input.
+  #pragma omp parallel for
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    const ElemType* in = input.colptr(j);
+    ElemType* out = output.colptr(j);
+    ElemType* xhat = this->training ? normalized.colptr(j) : NULL;
+
+    size_t count = 0;
+    ElemType columnMean = 0, m2 = 0;
+    AccumulateMoments(in, n, count, columnMean, m2);
+
+    mean[j] = columnMean;
+    variance[j] = m2 / n;
+    stdInv[j] = 1 / std::sqrt(variance[j] + ElemType(eps));
+
+    // Normalize the input, then scale and shift the output.
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType v = (in[i] - columnMean) * stdInv[j];
+      if (xhat != NULL)
+        xhat[i] = v;
+      out[i] = gamma[i] * v + beta[i];
+    }
+  }
 }
 
 template<typename MatType>
@@ -82,22 +106,36 @@ void LayerNormType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
-  const MatType stdInv = 1.0 / sqrt(variance + eps);
-
-  // dl / dxhat.
-  const MatType norm = gy.each_col() % gamma;
-
-  // sum dl / dxhat * (x - mu) * -0.5 * stdInv^3.
-  const MatType var = sum(norm % inputMean, 0) % pow(stdInv, 3.0) * -0.5;
-
-  // dl / dxhat * 1 / stdInv + variance * 2 * (x - mu) / m +
-  // dl / dmu * 1 / m.
-  g = (norm.each_row() % stdInv) + (inputMean.each_row() %
-      var * 2 / gy.n_rows);
-
-  // sum (dl / dxhat * -1 / stdInv) + variance *
-  // (sum -2 * (x - mu)) / m.
-  g.each_row() += sum(norm.each_row() % -stdInv, 0) / gy.n_rows;
+  typedef typename MatType::elem_type ElemType;
+
+  // With dxhat = gy % gamma the error of the normalized input, the error of
+  // the input of each column is
+  //
+  //   g = stdInv * (dxhat - mean(dxhat) - xhat * mean(dxhat * xhat)).
+  const size_t n = gy.n_rows;
+  #pragma omp parallel for
+  for (size_t j = 0; j < gy.n_cols; ++j)
+  {
+    const ElemType* dy = gy.colptr(j);
+    const ElemType* xhat = normalized.colptr(j);
+    ElemType* gCol = g.colptr(j);
+
+    ElemType sumDxhat = 0, sumDxhatXhat = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType dxhat = dy[i] * gamma[i];
+      sumDxhat += dxhat;
+      sumDxhatXhat += dxhat * xhat[i];
+    }
+
+    const ElemType meanDxhat = sumDxhat / n;
+    const ElemType meanDxhatXhat = sumDxhatXhat / n;
+    for (size_t i = 0; i < n; ++i)
+    {
+      gCol[i] = stdInv[j] * (dy[i] * gamma[i] - meanDxhat -
+          xhat[i] * meanDxhatXhat);
+    }
+  }
 }
 
 template<typename MatType>
@@ -106,13 +144,26 @@ void LayerNormType<MatType>::Gradient(
     const MatType& error,
     MatType& gradient)
 {
-  gradient.set_size(size + size, 1);
+  typedef typename MatType::elem_type ElemType;
 
-  // Step 5: dl / dy * xhat.
-  gradient.submat(0, 0, gamma.n_elem - 1, 0) = sum(normalized % error, 1);
+  gradient.set_size(size + size, 1);
 
-  // Step 6: dl / dy.
-  gradient.submat(gamma.n_elem, 0, gradient.n_elem - 1, 0) = sum(error, 1);
+  // Step 5: dl / dy * xhat (for gamma), and step 6: dl / dy (for beta).  The
+  // sums are over the columns, so each element is accumulated across the
+  // batch.
+  #pragma omp parallel for
+  for (size_t i = 0; i < size; ++i)
+  {
+    ElemType sumDy = 0, sumDyXhat = 0;
+    for (size_t j = 0; j < error.n_cols; ++j)
+    {
+      sumDy += error(i, j);
+      sumDyXhat += error(i, j) * normalized(i, j);
+    }
+
+    gradient[i] = sumDyXhat;
+    gradient[size + i] = sumDy;
+  }
 }
 
 template<typename MatType>
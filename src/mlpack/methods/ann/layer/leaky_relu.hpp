@@ -73,6 +73,9 @@ class LeakyReLUType : public Layer<MatType>
    */
   void Forward(const MatType& input, MatType& output);
 
+  //! The activation is applied to each element separately.
+  bool ElementwiseForward() const { return true; }
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards through f. Using the results from the feed
@@ -118,6 +118,15 @@ class LinearType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient);
 
+  /**
+   * Scale and shift the output of the layer by modifying the weight and the
+   * bias.  This always succeeds.
+   *
+   * @param scale Factor applied to each output element.
+   * @param shift Offset added to each output element.
+   */
+  bool FoldAffine(const MatType& scale, const MatType& shift);
+
   //! Get the parameters.
   const MatType& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -105,10 +105,7 @@ void LinearType<MatType, RegularizerType>::Forward(
     const MatType& input, MatType& output)
 {
   output = weight * input;
-
-  #pragma omp for
-  for (size_t c = 0; c < (size_t) output.n_cols; ++c)
-    output.col(c) += bias;
+  output.each_col() += bias;
 }
 
 template<typename MatType, typename RegularizerType>
@@ -132,6 +129,15 @@ void LinearType<MatType, RegularizerType>::Gradient(
   regularizer.Evaluate(weights, gradient);
 }
 
+template<typename MatType, typename RegularizerType>
+bool LinearType<MatType, RegularizerType>::FoldAffine(const MatType& scale,
+                                                      const MatType& shift)
+{
+  weight.each_col() %= scale;
+  bias = bias % scale + shift;
+  return true;
+}
+
 template<typename MatType, typename RegularizerType>
 void LinearType<MatType, RegularizerType>::ComputeOutputDimensions()
 {
@@ -0,0 +1,219 @@
+/**
+ * @file methods/ann/layer/lookup.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the Lookup (embedding) layer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_LOOKUP_HPP
+#define MLPACK_METHODS_ANN_LAYER_LOOKUP_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/sparse_update/sparse_update.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * The Lookup class stores word embeddings and retrieves them using tokens.
+ * The input of the layer holds, in each column, a sequence of token indices
+ * (from 0 to `vocabSize - 1`), and the output of the layer holds the embeddings
+ * of all the tokens of the sequence, one after the other, so that the output
+ * dimensions are `(embeddingSize, sequenceLength)`.  For example, for a
+ * sequence of 10 tokens, `embeddingSize` is the number of rows of the output
+ * that belong to each token:
+ *
+ * @code
+ * FFN<> model;
+ * model.InputDimensions() = { 10 };
+ * model.Add<Lookup>(vocabSize, 32);
+ * @endcode
+ *
+ * Since the tokens are discrete, this layer does not pass any error backwards,
+ * and it should be the first layer of the network.
+ *
+ * By default, the embedding table is a part of the parameters of the network,
+ * and the gradient of a batch is a dense matrix of the size of the table;
+ * only the columns of the tokens of the batch are nonzero, but the whole
+ * gradient is still cleared and given to the optimizer.  For a large
+ * vocabulary, a positive `sparseStepSize` can be given instead: then the table
+ * is held by the layer (so `WeightSize()` is 0), and every call to `Gradient()`
+ * only updates the columns of the tokens in the batch, with a step of the
+ * given size of `UpdateRuleType` (vanilla SGD by default, or lazy Adam with
+ * `LazyAdamUpdate`).  For a batch of B sequences of T tokens, a step then costs
+ * O(B * T * embeddingSize) instead of O(vocabSize * embeddingSize).  The table
+ * is not seen by the optimizer, so the optimizer of the network should take
+ * one gradient per step; the sparse mode cannot be used with optimizers that
+ * evaluate the gradient more than once per step, with replicas of the network,
+ * or with loss scaling.
+ *
+ * @code
+ * // Embeddings for 10 million items, updated with lazy Adam.
+ * FFN<> model;
+ * model.InputDimensions() = { 10 };
+ * model.Add<LazyAdamEmbedding>(10000000, 32, 0.001);
+ * @endcode
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ * @tparam UpdateRuleType Rule used to update the columns of the table that a
+ *    batch touched, when the table is held by the layer.
+ */
+template<
+    typename MatType = arma::mat,
+    typename UpdateRuleType = SparseSGDUpdate
+>
+class LookupType : public Layer<MatType>
+{
+ public:
+  /**
+   * Create the Lookup object using the specified vocabulary and embedding
+   * size.
+   *
+   * @param vocabSize The size of the vocabulary.
+   * @param embeddingSize The length of each embedding vector.
+   * @param sparseStepSize If positive, the layer holds the embedding table
+   *     itself and updates only the embeddings of the tokens of each batch
+   *     with this step size.
+   * @param updateRule Instantiated rule used for the sparse updates.
+   */
+  LookupType(const size_t vocabSize = 0,
+             const size_t embeddingSize = 0,
+             const double sparseStepSize = 0.0,
+             const UpdateRuleType& updateRule = UpdateRuleType());
+
+  //! Clone the LookupType object. This handles polymorphism correctly.
+  LookupType* Clone() const { return new LookupType(*this); }
+
+  // Virtual destructor.
+  virtual ~LookupType() { }
+
+  /**
+   * Set the embedding table to the given memory (or, when the table is held by
+   * the layer, initialize it if it was never set).
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The tokens are discrete, so no error is passed backwards; `g` is set to
+   * zero.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& g);
+
+  /**
+   * Calculate the gradient of the embeddings of the tokens of the batch.  If
+   * the layer holds the embedding table, the embeddings are updated directly
+   * and `gradient` is empty.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  const MatType& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the size of the vocabulary.
+  size_t VocabSize() const { return vocabSize; }
+
+  //! Get the length of each embedding vector.
+  size_t EmbeddingSize() const { return embeddingSize; }
+
+  //! Get the step size of the sparse update (0 if the table is a part of the
+  //! parameters of the network).
+  double SparseStepSize() const { return sparseStepSize; }
+  //! Modify the step size of the sparse update.
+  double& SparseStepSize() { return sparseStepSize; }
+
+  //! Get the rule used for the sparse updates.
+  const UpdateRuleType& UpdateRule() const { return updateRule; }
+  //! Modify the rule used for the sparse updates.
+  UpdateRuleType& UpdateRule() { return updateRule; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const
+  {
+    return (sparseStepSize > 0.0) ? 0 : embeddingSize * vocabSize;
+  }
+
+  //! Compute the output dimensions of the layer using `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Compute the sorted unique tokens of the batch, and the sum of the errors
+  //! of each (one column per token).
+  void TokenGradients(const MatType& input, const MatType& error);
+
+  //! Locally-stored size of the vocabulary.
+  size_t vocabSize;
+
+  //! Locally-stored length of each embedding vector.
+  size_t embeddingSize;
+
+  //! Locally-stored step size of the sparse update.
+  double sparseStepSize;
+
+  //! Locally-stored rule used for the sparse updates.
+  UpdateRuleType updateRule;
+
+  //! Locally-stored number of tokens in each input sequence.
+  size_t sequenceLength;
+
+  //! Locally-stored embedding table (embeddingSize x vocabSize).
+  MatType weights;
+
+  //! The unique tokens of the last batch given to Gradient().
+  arma::uvec tokens;
+
+  //! The summed errors of each of the unique tokens.
+  MatType tokenGradients;
+}; // class LookupType
+
+// Standard Lookup layer.
+typedef LookupType<arma::mat> Lookup;
+
+// Alias for using as embedding layer.
+typedef LookupType<arma::mat> Embedding;
+
+// Embedding layer that holds its table and updates it with lazy Adam.
+typedef LookupType<arma::mat, LazyAdamUpdate> LazyAdamEmbedding;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "lookup_impl.hpp"
+
+#endif
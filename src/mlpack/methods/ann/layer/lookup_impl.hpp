@@ -0,0 +1,167 @@
+/**
+ * @file methods/ann/layer/lookup_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the Lookup class, which transforms tokens into
+ * embeddings.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_LOOKUP_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_LOOKUP_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "lookup.hpp"
+
+namespace mlpack {
+
+template<typename MatType, typename UpdateRuleType>
+LookupType<MatType, UpdateRuleType>::LookupType(
+    const size_t vocabSize,
+    const size_t embeddingSize,
+    const double sparseStepSize,
+    const UpdateRuleType& updateRule) :
+    Layer<MatType>(),
+    vocabSize(vocabSize),
+    embeddingSize(embeddingSize),
+    sparseStepSize(sparseStepSize),
+    updateRule(updateRule),
+    sequenceLength(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::SetWeights(const MatType& weightsIn)
+{
+  if (sparseStepSize > 0.0)
+  {
+    // The table is held by the layer; as with torch.nn.Embedding, it is drawn
+    // from a standard normal distribution.
+    if (weights.n_rows != embeddingSize || weights.n_cols != vocabSize)
+      weights.randn(embeddingSize, vocabSize);
+  }
+  else
+  {
+    MakeAlias(weights, weightsIn, embeddingSize, vocabSize);
+  }
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::ComputeOutputDimensions()
+{
+  sequenceLength = std::accumulate(this->inputDimensions.begin(),
+      this->inputDimensions.end(), 1, std::multiplies<size_t>());
+
+  // Each token of the input is replaced by its embedding.
+  this->outputDimensions = std::vector<size_t>(1, embeddingSize);
+  this->outputDimensions.insert(this->outputDimensions.end(),
+      this->inputDimensions.begin(), this->inputDimensions.end());
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::Forward(
+    const MatType& input, MatType& output)
+{
+  if (input.n_elem > 0 && (input.min() < 0 || input.max() >= vocabSize))
+  {
+    throw std::invalid_argument("LookupType::Forward(): tokens must be in the "
+        "range [0, " + std::to_string(vocabSize) + ")!");
+  }
+
+  // Copy the embedding of each token straight into the output.
+  #pragma omp parallel for
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t t = 0; t < sequenceLength; ++t)
+    {
+      const size_t token = (size_t) input(t, j);
+      std::copy(weights.colptr(token), weights.colptr(token) + embeddingSize,
+          output.colptr(j) + t * embeddingSize);
+    }
+  }
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& g)
+{
+  // There is no error with respect to the tokens.
+  g.zeros();
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  TokenGradients(input, error);
+
+  if (sparseStepSize > 0.0)
+  {
+    // Only the embeddings of the tokens of the batch are touched.
+    updateRule.Update(weights, sparseStepSize, tokens, tokenGradients);
+  }
+  else
+  {
+    MatType gradientTable;
+    MakeAlias(gradientTable, gradient, embeddingSize, vocabSize);
+    gradientTable.zeros();
+    for (size_t i = 0; i < tokens.n_elem; ++i)
+      gradientTable.col(tokens[i]) = tokenGradients.col(i);
+  }
+}
+
+template<typename MatType, typename UpdateRuleType>
+void LookupType<MatType, UpdateRuleType>::TokenGradients(
+    const MatType& input,
+    const MatType& error)
+{
+  tokens = arma::unique(arma::conv_to<arma::uvec>::from(vectorise(input)));
+
+  // The errors of repeated tokens are summed.
+  tokenGradients.zeros(embeddingSize, tokens.n_elem);
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t t = 0; t < sequenceLength; ++t)
+    {
+      const size_t token = (size_t) input(t, j);
+      const size_t index = std::lower_bound(tokens.begin(), tokens.end(),
+          token) - tokens.begin();
+      tokenGradients.col(index) += error.submat(t * embeddingSize, j,
+          (t + 1) * embeddingSize - 1, j);
+    }
+  }
+}
+
+template<typename MatType, typename UpdateRuleType>
+template<typename Archive>
+void LookupType<MatType, UpdateRuleType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(vocabSize));
+  ar(CEREAL_NVP(embeddingSize));
+  ar(CEREAL_NVP(sparseStepSize));
+  ar(CEREAL_NVP(sequenceLength));
+
+  // A table that is held by the layer is not a part of the parameters of the
+  // network, so it is saved with the layer.
+  if (sparseStepSize > 0.0)
+  {
+    ar(CEREAL_NVP(weights));
+    ar(CEREAL_NVP(updateRule));
+  }
+}
+
+} // namespace mlpack
+
+#endif
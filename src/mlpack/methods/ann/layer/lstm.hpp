@@ -32,6 +32,15 @@ namespace mlpack {
  * h &=& o \odot tanh(c)
  * @f}
  *
+ * The weights of the four gates are stacked, so that each step computes the
+ * pre-activations of all gates with one matrix product for the input and one
+ * for the recurrent connection, and then applies all the nonlinearities and the
+ * cell update in a single pass over the batch.  The parameters are laid out as
+ * the input weights of all gates (4 * outSize x inSize), their biases, the
+ * recurrent weights (4 * outSize x outSize), and the peephole weights of the
+ * input, forget and output gates; within each block the gates are in the order
+ * input gate, forget gate, cell candidate, output gate.
+ *
  * Note that if an LSTM layer is desired as the first layer of a neural network,
  * an IdentityLayer should be added to the network as the first layer, and then
  * the LSTM layer should be added.
@@ -160,76 +169,46 @@ class LSTMType : public RecurrentLayer<MatType>
    * Serialize the layer.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
+  //! Convert the weights from the layout used before the gates were stacked
+  //! (separate blocks of input weights and bias for the output, forget, input
+  //! and hidden gates, then the recurrent weights in the same order, then the
+  //! output, forget and input peephole weights).
+  void ConvertLegacyWeights();
+
   //! Locally-stored number of input units.
   size_t inSize;
 
   //! Locally-stored number of output units.
   size_t outSize;
 
+  //! Whether the weights given to SetWeights() are in the layout used before
+  //! the gates were stacked, and have to be converted.
+  bool legacyWeights;
+
   //! Locally-stored weight object.
   MatType weights;
 
-  //! Weights between the output and input gate.
-  MatType output2GateInputWeight;
-
-  //! Weights between the input and gate.
-  MatType input2GateInputWeight;
-
-  //! Bias between the input and input gate.
-  MatType input2GateInputBias;
-
-  //! Weights between the cell and input gate.
-  MatType cell2GateInputWeight;
-
-  //! Weights between the output and forget gate.
-  MatType output2GateForgetWeight;
-
-  //! Weights between the input and gate.
-  MatType input2GateForgetWeight;
-
-  //! Bias between the input and gate.
-  MatType input2GateForgetBias;
-
-  //! Bias between the input and gate.
-  MatType cell2GateForgetWeight;
-
-  //! Weights between the output and gate.
-  MatType output2GateOutputWeight;
+  //! Weights between the input and the four gates (input gate, forget gate,
+  //! cell candidate and output gate, stacked in that order).
+  MatType input2GateWeight;
 
-  //! Weights between the input and gate.
-  MatType input2GateOutputWeight;
+  //! Bias of the four gates.
+  MatType input2GateBias;
 
-  //! Bias between the input and gate.
-  MatType input2GateOutputBias;
+  //! Weights between the output of the previous step and the four gates.
+  MatType output2GateWeight;
 
-  //! Weights between cell and output gate.
-  MatType cell2GateOutputWeight;
+  //! Weights between the cell and the input gate, forget gate and output gate
+  //! (one column each).
+  MatType cell2GateWeight;
 
   // Below here are recurrent state matrices.
 
-  //! Locally-stored input gate parameter.
-  MatType inputGate;
-
-  //! Locally-stored forget gate parameter.
-  MatType forgetGate;
-
-  //! Locally-stored hidden layer parameter.
-  MatType hiddenLayer;
-
-  //! Locally-stored output gate parameter.
-  MatType outputGate;
-
-  //! Locally-stored input to hidden weight.
-  MatType input2HiddenWeight;
-
-  //! Locally-stored input to hidden bias.
-  MatType input2HiddenBias;
-
-  //! Locally-stored output to hidden weight.
-  MatType output2HiddenWeight;
+  //! Locally-stored pre-activations of the four gates.
+  MatType gates;
 
   //! Locally-stored cell parameter.
   arma::Cube<typename MatType::elem_type> cell;
@@ -251,23 +230,15 @@ class LSTMType : public RecurrentLayer<MatType>
   //! Locally-stored cell activation error.
   arma::Cube<typename MatType::elem_type> cellActivation;
 
-  //! Locally-stored forget gate error.
-  MatType forgetGateError;
-
-  //! Locally-stored output gate error.
-  MatType outputGateError;
-
   //! Locally-stored output parameters.
   arma::Cube<typename MatType::elem_type> outParameter;
 
   //! Locally-stored input cell error parameter.
   MatType inputCellError;
 
-  //! Locally-stored input gate error.
-  MatType inputGateError;
-
-  //! Locally-stored hidden layer error.
-  MatType hiddenError;
+  //! Locally-stored error of the four gates, stacked in the same order as the
+  //! weights.
+  MatType gateError;
 }; // class LSTMType
 
 // Convenience typedefs.
@@ -277,6 +248,11 @@ typedef LSTMType<arma::mat> LSTM;
 
 } // namespace mlpack
 
+//! Set the serialization version of the LSTMType class.  Version 1 stacks the
+//! weights of the gates.
+CEREAL_TEMPLATE_CLASS_VERSION((typename MatType), (mlpack::LSTMType<MatType>),
+    (1));
+
 // Include implementation.
 #include "lstm_impl.hpp"
 
@@ -20,7 +20,9 @@ namespace mlpack {
 template<typename MatType>
 LSTMType<MatType>::LSTMType() :
     RecurrentLayer<MatType>(),
-    outSize(0)
+    inSize(0),
+    outSize(0),
+    legacyWeights(false)
 {
   // Nothing to do here.
 }
@@ -28,21 +30,29 @@ LSTMType<MatType>::LSTMType() :
 template<typename MatType>
 LSTMType<MatType>::LSTMType(const size_t outSize) :
     RecurrentLayer<MatType>(),
-    outSize(outSize)
+    inSize(0),
+    outSize(outSize),
+    legacyWeights(false)
 {
   // Nothing to do here.
 }
 
 template<typename MatType>
 LSTMType<MatType>::LSTMType(const LSTMType& layer) :
-    RecurrentLayer<MatType>(layer)
+    RecurrentLayer<MatType>(layer),
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    legacyWeights(layer.legacyWeights)
 {
   // Nothing to do here.
 }
 
 template<typename MatType>
 LSTMType<MatType>::LSTMType(LSTMType&& layer) :
-    RecurrentLayer<MatType>(std::move(layer))
+    RecurrentLayer<MatType>(std::move(layer)),
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    legacyWeights(layer.legacyWeights)
 {
   // Nothing to do here.
 }
@@ -53,6 +63,9 @@ LSTMType<MatType>& LSTMType<MatType>::operator=(const LSTMType& layer)
   if (this != &layer)
   {
     RecurrentLayer<MatType>::operator=(layer);
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    legacyWeights = layer.legacyWeights;
   }
 
   return *this;
@@ -64,6 +77,9 @@ LSTMType<MatType>& LSTMType<MatType>::operator=(LSTMType&& layer)
   if (this != &layer)
   {
     RecurrentLayer<MatType>::operator=(std::move(layer));
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    legacyWeights = layer.legacyWeights;
   }
 
   return *this;
@@ -75,10 +91,7 @@ void LSTMType<MatType>::ClearRecurrentState(
 {
   // Make sure all of the different matrices we will use to hold parameters are
   // at least as large as we need.
-  inputGate.set_size(outSize, batchSize);
-  forgetGate.set_size(outSize, batchSize);
-  hiddenLayer.set_size(outSize, batchSize);
-  outputGate.set_size(outSize, batchSize);
+  gates.set_size(4 * outSize, batchSize);
 
   inputGateActivation.set_size(outSize, batchSize, bpttSteps);
   forgetGateActivation.set_size(outSize, batchSize, bpttSteps);
@@ -93,146 +106,151 @@ void LSTMType<MatType>::ClearRecurrentState(
 }
 
 template<typename MatType>
-void LSTMType<MatType>::SetWeights(const MatType& weights)
+void LSTMType<MatType>::SetWeights(const MatType& weightsIn)
 {
-  // Set the weight parameter for the output gate.
-  MakeAlias(input2GateOutputWeight, weights, outSize, inSize);
-  size_t offset = input2GateOutputWeight.n_elem;
-  MakeAlias(input2GateOutputBias, weights, outSize, 1, offset);
-  offset += input2GateOutputBias.n_elem;
-
-  // Set the weight parameter for the forget gate.
-  MakeAlias(input2GateForgetWeight, weights, outSize, inSize, offset);
-  offset += input2GateForgetWeight.n_elem;
-  MakeAlias(input2GateForgetBias, weights, outSize, 1, offset);
-  offset += input2GateForgetBias.n_elem;
-
-  // Set the weight parameter for the input gate.
-  MakeAlias(input2GateInputWeight, weights, outSize, inSize, offset);
-  offset += input2GateInputWeight.n_elem;
-  MakeAlias(input2GateInputBias, weights, outSize, 1, offset);
-  offset += input2GateInputBias.n_elem;
-
-  // Set the weight parameter for the hidden gate.
-  MakeAlias(input2HiddenWeight, weights, outSize, inSize, offset);
-  offset += input2HiddenWeight.n_elem;
-  MakeAlias(input2HiddenBias, weights, outSize, 1, offset);
-  offset += input2HiddenBias.n_elem;
-
-  // Set the weight parameter for the output multiplication.
-  MakeAlias(output2GateOutputWeight, weights, outSize, outSize, offset);
-  offset += output2GateOutputWeight.n_elem;
-
-  // Set the weight parameter for the output multiplication.
-  MakeAlias(output2GateForgetWeight, weights, outSize, outSize, offset);
-  offset += output2GateForgetWeight.n_elem;
-
-  // Set the weight parameter for the input multiplication.
-  MakeAlias(output2GateInputWeight, weights, outSize, outSize, offset);
-  offset += output2GateInputWeight.n_elem;
-
-  // Set the weight parameter for the hidden multiplication.
-  MakeAlias(output2HiddenWeight, weights, outSize, outSize, offset);
-  offset += output2HiddenWeight.n_elem;
-
-  // Set the weight parameter for the cell multiplication.
-  MakeAlias(cell2GateOutputWeight, weights, outSize, 1, offset);
-  offset += cell2GateOutputWeight.n_elem;
-
-  // Set the weight parameter for the cell - forget gate multiplication.
-  MakeAlias(cell2GateForgetWeight, weights, outSize, 1, offset);
-  offset += cell2GateOutputWeight.n_elem;
-
-  // Set the weight parameter for the cell - input gate multiplication.
-  MakeAlias(cell2GateInputWeight, weights, outSize, 1, offset);
-}
-
-// Forward when cellState is not needed.
-template<typename MatType>
-void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
-{
-  // Convenience alias.
-  const size_t batchSize = input.n_cols;
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
 
-  inputGate = input2GateInputWeight * input;
-  if (this->HasPreviousStep())
+  // Weights that were saved before the gates were stacked have to be moved
+  // into the new layout first.
+  if (legacyWeights)
   {
-    inputGate +=
-        output2GateInputWeight * outParameter.slice(this->PreviousStep());
+    ConvertLegacyWeights();
+    legacyWeights = false;
   }
-  inputGate.each_col() += input2GateInputBias;
 
-  forgetGate = input2GateForgetWeight * input;
-  if (this->HasPreviousStep())
-  {
-    forgetGate += output2GateForgetWeight * outParameter.slice(
-        this->PreviousStep());
-  }
-  forgetGate.each_col() += input2GateForgetBias;
+  // Set the weight parameters between the input and the gates.
+  MakeAlias(input2GateWeight, weightsIn, 4 * outSize, inSize);
+  size_t offset = input2GateWeight.n_elem;
+  MakeAlias(input2GateBias, weightsIn, 4 * outSize, 1, offset);
+  offset += input2GateBias.n_elem;
 
-  if (this->HasPreviousStep())
-  {
-    inputGate += repmat(cell2GateInputWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
+  // Set the weight parameters between the previous output and the gates.
+  MakeAlias(output2GateWeight, weightsIn, 4 * outSize, outSize, offset);
+  offset += output2GateWeight.n_elem;
 
-    forgetGate += repmat(cell2GateForgetWeight, 1, batchSize) %
-        cell.slice(this->PreviousStep());
-  }
-
-  inputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-inputGate));
-  forgetGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-forgetGate));
+  // Set the peephole weights of the input, forget and output gates.
+  MakeAlias(cell2GateWeight, weightsIn, outSize, 3, offset);
+}
 
-  hiddenLayer = input2HiddenWeight * input;
-  if (this->HasPreviousStep())
+template<typename MatType>
+void LSTMType<MatType>::ConvertLegacyWeights()
+{
+  const MatType legacy(weights);
+  const size_t inputElem = outSize * inSize;
+  const size_t outputElem = outSize * outSize;
+
+  // The legacy layout stores the input weights and bias of each gate (output
+  // gate, forget gate, input gate, hidden layer) one after the other.
+  std::vector<MatType> inputWeight(4), inputBias(4), outputWeight(4);
+  size_t offset = 0;
+  for (size_t i = 0; i < 4; ++i)
   {
-    hiddenLayer += output2HiddenWeight *
-        outParameter.slice(this->PreviousStep());
+    MakeAlias(inputWeight[i], legacy, outSize, inSize, offset);
+    offset += inputElem;
+    MakeAlias(inputBias[i], legacy, outSize, 1, offset);
+    offset += outSize;
   }
-  hiddenLayer.each_col() += input2HiddenBias;
-
-  hiddenLayerActivation.slice(this->CurrentStep()) = arma::tanh(hiddenLayer);
 
-  if (!this->HasPreviousStep())
+  for (size_t i = 0; i < 4; ++i)
   {
-    cell.slice(this->CurrentStep()) =
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
-  }
-  else
-  {
-    cell.slice(this->CurrentStep()) =
-        forgetGateActivation.slice(this->CurrentStep()) %
-        cell.slice(this->PreviousStep()) +
-        inputGateActivation.slice(this->CurrentStep()) %
-        hiddenLayerActivation.slice(this->CurrentStep());
+    MakeAlias(outputWeight[i], legacy, outSize, outSize, offset);
+    offset += outputElem;
   }
 
-  outputGate = input2GateOutputWeight * input +
-      cell.slice(this->CurrentStep()).each_col() % cell2GateOutputWeight;
-  if (this->HasPreviousStep())
+  MatType cellWeight;
+  MakeAlias(cellWeight, legacy, outSize, 3, offset);
+
+  // The stacked layout orders the gates as input gate, forget gate, hidden
+  // layer (cell candidate), output gate.
+  const size_t order[4] = { 2, 1, 3, 0 };
+  MatType stackedWeight, stackedBias, stackedOutputWeight;
+  MakeAlias(stackedWeight, weights, 4 * outSize, inSize);
+  offset = stackedWeight.n_elem;
+  MakeAlias(stackedBias, weights, 4 * outSize, 1, offset);
+  offset += stackedBias.n_elem;
+  MakeAlias(stackedOutputWeight, weights, 4 * outSize, outSize, offset);
+  offset += stackedOutputWeight.n_elem;
+  for (size_t i = 0; i < 4; ++i)
   {
-    outputGate +=
-        output2GateOutputWeight * outParameter.slice(this->PreviousStep());
+    stackedWeight.rows(i * outSize, (i + 1) * outSize - 1) =
+        inputWeight[order[i]];
+    stackedBias.rows(i * outSize, (i + 1) * outSize - 1) = inputBias[order[i]];
+    stackedOutputWeight.rows(i * outSize, (i + 1) * outSize - 1) =
+        outputWeight[order[i]];
   }
-  outputGate.each_col() += input2GateOutputBias;
 
-  outputGateActivation.slice(this->CurrentStep()) =
-      1.0 / (1.0 + exp(-outputGate));
+  // The legacy peephole weights are ordered output, forget, input.
+  MatType stackedCellWeight;
+  MakeAlias(stackedCellWeight, weights, outSize, 3, offset);
+  stackedCellWeight.col(0) = cellWeight.col(2);
+  stackedCellWeight.col(1) = cellWeight.col(1);
+  stackedCellWeight.col(2) = cellWeight.col(0);
+}
 
-  cellActivation.slice(this->CurrentStep()) =
-      arma::tanh(cell.slice(this->CurrentStep()));
+// Forward when cellState is not needed.
+template<typename MatType>
+void LSTMType<MatType>::Forward(const MatType& input, MatType& output)
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.
+  const size_t batchSize = input.n_cols;
+  const bool hasPrevious = this->HasPreviousStep();
+  const size_t current = this->CurrentStep();
+  const size_t previous = hasPrevious ? this->PreviousStep() : current;
+
+  // Compute the pre-activations of all the gates at once.
+  gates = input2GateWeight * input;
+  if (hasPrevious)
+    gates += output2GateWeight * outParameter.slice(previous);
+  gates.each_col() += input2GateBias;
+
+  // Now apply the nonlinearities, update the cell and compute the output in a
+  // single pass.
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
+  {
+    const ElemType* gate = gates.colptr(j);
+    const ElemType* previousCell = cell.slice_colptr(previous, j);
+    ElemType* inputGate = inputGateActivation.slice_colptr(current, j);
+    ElemType* forgetGate = forgetGateActivation.slice_colptr(current, j);
+    ElemType* hidden = hiddenLayerActivation.slice_colptr(current, j);
+    ElemType* outputGate = outputGateActivation.slice_colptr(current, j);
+    ElemType* currentCell = cell.slice_colptr(current, j);
+    ElemType* cellAct = cellActivation.slice_colptr(current, j);
+    ElemType* out = outParameter.slice_colptr(current, j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      ElemType i = gate[k];
+      ElemType f = gate[outSize + k];
+      if (hasPrevious)
+      {
+        i += cell2GateWeight(k, 0) * previousCell[k];
+        f += cell2GateWeight(k, 1) * previousCell[k];
+      }
+
+      inputGate[k] = 1 / (1 + std::exp(-i));
+      forgetGate[k] = 1 / (1 + std::exp(-f));
+      hidden[k] = std::tanh(gate[2 * outSize + k]);
+
+      currentCell[k] = inputGate[k] * hidden[k];
+      if (hasPrevious)
+        currentCell[k] += forgetGate[k] * previousCell[k];
+
+      const ElemType o = gate[3 * outSize + k] +
+          cell2GateWeight(k, 2) * currentCell[k];
+      outputGate[k] = 1 / (1 + std::exp(-o));
+      cellAct[k] = std::tanh(currentCell[k]);
+      out[k] = cellAct[k] * outputGate[k];
+    }
+  }
 
   // There's a bit of an issue here: we need to preserve the output for the next
   // time step, but we also need to set `output` to that.  Unfortunately for now
   // we make a copy, but it's possible that we could instead use an alias here,
   // or have `outParameter` hold a collection of aliases.
-  outParameter.slice(this->CurrentStep()) =
-      cellActivation.slice(this->CurrentStep()) %
-      outputGateActivation.slice(this->CurrentStep());
-
-  output = outParameter.slice(this->CurrentStep());
+  output = outParameter.slice(current);
 }
 
 template<typename MatType>
@@ -242,62 +260,73 @@ void LSTMType<MatType>::Backward(
     const MatType& gy,
     MatType& g)
 {
+  using ElemType = typename MatType::elem_type;
+
+  // Convenience aliases.
+  const size_t batchSize = gy.n_cols;
+  const bool hasPrevious = this->HasPreviousStep();
+  const size_t current = this->CurrentStep();
+  const size_t previous = hasPrevious ? this->PreviousStep() : current;
+
+  // The error of the gates of the previous step (t + 1) holds the error that
+  // flows back through the recurrent connection.
   MatType gyLocal;
-  if (this->HasPreviousStep())
+  if (hasPrevious)
   {
-    gyLocal = gy + output2GateOutputWeight.t() * outputGateError +
-      output2GateForgetWeight.t() * forgetGateError +
-      output2GateInputWeight.t() * inputGateError +
-      output2HiddenWeight.t() * hiddenError;
+    gyLocal = gy + output2GateWeight.t() * gateError;
   }
   else
   {
     // Make an alias.
     gyLocal = MatType(((MatType&) gy).memptr(), gy.n_rows, gy.n_cols,
         false, false);
+    inputCellError.set_size(outSize, batchSize);
   }
 
-  outputGateError = gyLocal % cellActivation.slice(this->CurrentStep()) %
-      (outputGateActivation.slice(this->CurrentStep()) %
-      (1.0 - outputGateActivation.slice(this->CurrentStep())));
-
-  MatType cellError = gyLocal %
-      outputGateActivation.slice(this->CurrentStep()) %
-      (1 - pow(cellActivation.slice(this->CurrentStep()), 2)) +
-      outputGateError.each_col() % cell2GateOutputWeight;
-
-  if (this->HasPreviousStep())
-  {
-    cellError += inputCellError;
-  }
+  gateError.set_size(4 * outSize, batchSize);
 
-  if (this->HasPreviousStep())
+  #pragma omp parallel for
+  for (size_t j = 0; j < batchSize; ++j)
   {
-    forgetGateError = cell.slice(this->PreviousStep()) % cellError %
-        (forgetGateActivation.slice(this->CurrentStep()) %
-        (1.0 - forgetGateActivation.slice(this->CurrentStep())));
+    const ElemType* error = gyLocal.colptr(j);
+    const ElemType* previousCell = cell.slice_colptr(previous, j);
+    const ElemType* inputGate = inputGateActivation.slice_colptr(current, j);
+    const ElemType* forgetGate = forgetGateActivation.slice_colptr(current, j);
+    const ElemType* hidden = hiddenLayerActivation.slice_colptr(current, j);
+    const ElemType* outputGate = outputGateActivation.slice_colptr(current, j);
+    const ElemType* cellAct = cellActivation.slice_colptr(current, j);
+    ElemType* gateErr = gateError.colptr(j);
+    ElemType* cellInputErr = inputCellError.colptr(j);
+
+    for (size_t k = 0; k < outSize; ++k)
+    {
+      const ElemType outputGateErr = error[k] * cellAct[k] * outputGate[k] *
+          (1 - outputGate[k]);
+
+      ElemType cellErr = error[k] * outputGate[k] *
+          (1 - cellAct[k] * cellAct[k]) + outputGateErr * cell2GateWeight(k, 2);
+      if (hasPrevious)
+        cellErr += cellInputErr[k];
+
+      const ElemType forgetGateErr = hasPrevious ? previousCell[k] * cellErr *
+          forgetGate[k] * (1 - forgetGate[k]) : 0;
+      const ElemType inputGateErr = hidden[k] * cellErr * inputGate[k] *
+          (1 - inputGate[k]);
+      const ElemType hiddenErr = inputGate[k] * cellErr *
+          (1 - hidden[k] * hidden[k]);
+
+      cellInputErr[k] = forgetGate[k] * cellErr +
+          forgetGateErr * cell2GateWeight(k, 1) +
+          inputGateErr * cell2GateWeight(k, 0);
+
+      gateErr[k] = inputGateErr;
+      gateErr[outSize + k] = forgetGateErr;
+      gateErr[2 * outSize + k] = hiddenErr;
+      gateErr[3 * outSize + k] = outputGateErr;
+    }
   }
-  else
-  {
-    forgetGateError.zeros(forgetGateActivation.n_rows,
-        forgetGateActivation.n_cols);
-  }
-
-  inputGateError = hiddenLayerActivation.slice(this->CurrentStep()) %
-      cellError % (inputGateActivation.slice(this->CurrentStep()) %
-      (1.0 - inputGateActivation.slice(this->CurrentStep())));
 
-  hiddenError = inputGateActivation.slice(this->CurrentStep()) % cellError %
-      (1 - pow(hiddenLayerActivation.slice(this->CurrentStep()), 2));
-
-  inputCellError = forgetGateActivation.slice(this->CurrentStep()) % cellError +
-      forgetGateError.each_col() % cell2GateForgetWeight +
-      inputGateError.each_col() % cell2GateInputWeight;
-
-  g = input2GateInputWeight.t() * inputGateError +
-      input2HiddenWeight.t() * hiddenError +
-      input2GateForgetWeight.t() * forgetGateError +
-      input2GateOutputWeight.t() * outputGateError;
+  g = input2GateWeight.t() * gateError;
 }
 
 template<typename MatType>
@@ -309,85 +338,44 @@ void LSTMType<MatType>::Gradient(
   // This implementation depends on Gradient() being called just after
   // Backward(), which is something we can safely assume.
 
-  // Input2GateOutputWeight and input2GateOutputBias gradients.
-  gradient.submat(0, 0, input2GateOutputWeight.n_elem - 1, 0) =
-      vectorise(outputGateError * input.t());
-  gradient.submat(input2GateOutputWeight.n_elem, 0,
-      input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem - 1, 0) =
-      sum(outputGateError, 1);
-  size_t offset = input2GateOutputWeight.n_elem + input2GateOutputBias.n_elem;
-
-  // input2GateForgetWeight and input2GateForgetBias gradients.
-  gradient.submat(offset, 0, offset + input2GateForgetWeight.n_elem - 1, 0) =
-      vectorise(forgetGateError * input.t());
-  gradient.submat(offset + input2GateForgetWeight.n_elem, 0,
-      offset + input2GateForgetWeight.n_elem +
-      input2GateForgetBias.n_elem - 1, 0) = sum(forgetGateError, 1);
-  offset += input2GateForgetWeight.n_elem + input2GateForgetBias.n_elem;
-
-  // input2GateInputWeight and input2GateInputBias gradients.
-  gradient.submat(offset, 0, offset + input2GateInputWeight.n_elem - 1, 0) =
-      vectorise(inputGateError * input.t());
-  gradient.submat(offset + input2GateInputWeight.n_elem, 0,
-      offset + input2GateInputWeight.n_elem +
-      input2GateInputBias.n_elem - 1, 0) = sum(inputGateError, 1);
-  offset += input2GateInputWeight.n_elem + input2GateInputBias.n_elem;
-
-  // input2HiddenWeight and input2HiddenBias gradients.
-  gradient.submat(offset, 0, offset + input2HiddenWeight.n_elem - 1, 0) =
-      vectorise(hiddenError * input.t());
-  gradient.submat(offset + input2HiddenWeight.n_elem, 0,
-      offset + input2HiddenWeight.n_elem + input2HiddenBias.n_elem - 1, 0) =
-      sum(hiddenError, 1);
-  offset += input2HiddenWeight.n_elem + input2HiddenBias.n_elem;
-
-  // output2GateOutputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateOutputWeight.n_elem - 1, 0) =
-      vectorise(outputGateError * outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateOutputWeight.n_elem;
-
-  // output2GateForgetWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateForgetWeight.n_elem - 1, 0) =
-      vectorise(forgetGateError * outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateForgetWeight.n_elem;
-
-  // output2GateInputWeight gradients.
-  gradient.submat(offset, 0, offset + output2GateInputWeight.n_elem - 1, 0) =
-      vectorise(inputGateError * outParameter.slice(this->CurrentStep()).t());
-  offset += output2GateInputWeight.n_elem;
-
-  // output2HiddenWeight gradients.
-  gradient.submat(offset, 0, offset + output2HiddenWeight.n_elem - 1, 0) =
-      vectorise(hiddenError * outParameter.slice(this->CurrentStep()).t());
-  offset += output2HiddenWeight.n_elem;
-
-  // cell2GateOutputWeight gradients.
-  gradient.submat(offset, 0, offset + cell2GateOutputWeight.n_elem - 1, 0) =
-      sum(outputGateError % cell.slice(this->CurrentStep()), 1);
-  offset += cell2GateOutputWeight.n_elem;
-
-  // cell2GateForgetWeight and cell2GateInputWeight gradients.
+  // input2GateWeight and input2GateBias gradients.
+  gradient.submat(0, 0, input2GateWeight.n_elem - 1, 0) =
+      vectorise(gateError * input.t());
+  size_t offset = input2GateWeight.n_elem;
+  gradient.submat(offset, 0, offset + input2GateBias.n_elem - 1, 0) =
+      sum(gateError, 1);
+  offset += input2GateBias.n_elem;
+
+  // output2GateWeight gradients.
+  gradient.submat(offset, 0, offset + output2GateWeight.n_elem - 1, 0) =
+      vectorise(gateError * outParameter.slice(this->CurrentStep()).t());
+  offset += output2GateWeight.n_elem;
+
+  // cell2GateWeight gradients of the input and forget gates.
   if (this->HasPreviousStep())
   {
-    gradient.submat(offset, 0, offset + cell2GateForgetWeight.n_elem - 1, 0) =
-        sum(forgetGateError % cell.slice(this->PreviousStep()), 1);
-    gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
-        cell2GateForgetWeight.n_elem + cell2GateInputWeight.n_elem - 1, 0) =
-        sum(inputGateError % cell.slice(this->PreviousStep()), 1);
+    gradient.submat(offset, 0, offset + outSize - 1, 0) =
+        sum(gateError.rows(0, outSize - 1) %
+        cell.slice(this->PreviousStep()), 1);
+    gradient.submat(offset + outSize, 0, offset + 2 * outSize - 1, 0) =
+        sum(gateError.rows(outSize, 2 * outSize - 1) %
+        cell.slice(this->PreviousStep()), 1);
   }
   else
   {
-    gradient.submat(offset, 0, offset +
-        cell2GateForgetWeight.n_elem - 1, 0).zeros();
-    gradient.submat(offset + cell2GateForgetWeight.n_elem, 0, offset +
-        cell2GateForgetWeight.n_elem +
-        cell2GateInputWeight.n_elem - 1, 0).zeros();
+    gradient.submat(offset, 0, offset + 2 * outSize - 1, 0).zeros();
   }
+  offset += 2 * outSize;
+
+  // cell2GateWeight gradients of the output gate.
+  gradient.submat(offset, 0, offset + outSize - 1, 0) =
+      sum(gateError.rows(3 * outSize, 4 * outSize - 1) %
+      cell.slice(this->CurrentStep()), 1);
 }
 
 template<typename MatType>
 template<typename Archive>
-void LSTMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
+void LSTMType<MatType>::serialize(Archive& ar, const uint32_t version)
 {
   ar(cereal::base_class<RecurrentLayer<MatType>>(this));
 
@@ -397,17 +385,18 @@ void LSTMType<MatType>::serialize(Archive& ar, const uint32_t /* version */)
   // Clear recurrent state if we are loading.
   if (Archive::is_loading::value)
   {
+    // Models saved before the gates were stacked store their weights in a
+    // different order; they are converted when the weights are set.
+    legacyWeights = (version == 0);
+
     inputGateActivation.clear();
     forgetGateActivation.clear();
     outputGateActivation.clear();
     hiddenLayerActivation.clear();
     cellActivation.clear();
-    forgetGateError.clear();
-    outputGateError.clear();
     outParameter.clear();
     inputCellError.clear();
-    inputGateError.clear();
-    hiddenError.clear();
+    gateError.clear();
   }
 }
 
@@ -50,7 +50,11 @@ class MaxPoolingRule
 };
 
 /**
- * Implementation of the MaxPooling layer.
+ * Implementation of the MaxPooling layer.  All channels of all points of a
+ * batch are pooled in one pass.  During training, the position of the maximum
+ * of each window is kept as an 8-bit offset in the window (for windows of at
+ * most 256 elements), so that the backward pass does not need to search the
+ * windows again.
  *
  * @tparam MatType Matrix representation to accept as input and use for
  *    computation.
@@ -113,7 +117,7 @@ class MaxPoolingType : public Layer<MatType>
    * @param g The calculated gradient.
    */
   void Backward(const MatType& input,
-                const MatType& /* output */,
+                const MatType& output,
                 const MatType& gy,
                 MatType& g);
 
@@ -153,135 +157,48 @@ class MaxPoolingType : public Layer<MatType>
 
  private:
   /**
-   * Apply pooling to the input and store the results.
-   *
-   * @param input The input to be apply the pooling rule.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
-   */
-  void PoolingOperation(
-      const arma::Cube<typename MatType::elem_type>& input,
-      arma::Cube<typename MatType::elem_type>& output,
-      arma::Cube<size_t>& poolingIndices)
-  {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-          const std::tuple<size_t, typename MatType::elem_type> poolResult =
-              pooling.PoolingWithIndex(input.slice(s).submat(
-                  rowidx,
-                  colidx,
-                  rowEnd,
-                  colEnd));
-
-          // Now map the returned pooling index, which corresponds to the
-          // submatrix we gave, back to its position in the (linearized) input.
-          const size_t poolIndex = std::get<0>(poolResult);
-          const size_t poolingCol = poolIndex / (kernelWidth);
-          const size_t poolingRow = poolIndex % (kernelWidth);
-          const size_t unmappedPoolingIndex = (rowidx + poolingRow) +
-              input.n_rows * (colidx + poolingCol);
-
-          poolingIndices(i, j, s) = unmappedPoolingIndex;
-          output(i, j, s) = std::get<1>(poolResult);
-        }
-      }
-    }
-  }
-
-  /**
-   * Apply pooling to all slices of the input and store the results, but not the
-   * indices used.
+   * Apply pooling to every image (channel of every point) of the input.  Each
+   * output column is computed one kernel position at a time, with one
+   * contiguous pass over the rows of the input, so there are no per-window
+   * temporaries.  If `StoreIndices` is true, the position of each maximum in
+   * its window is stored in `poolingIndices`.
    *
    * @param input The input to apply the pooling rule to.
    * @param output The pooled result.
    */
-  void PoolingOperation(
-      const arma::Cube<typename MatType::elem_type>& input,
-      arma::Cube<typename MatType::elem_type>& output)
-  {
-    // Iterate over all slices individually.
-    #pragma omp parallel for
-    for (size_t s = 0; s < (size_t) input.n_slices; ++s)
-    {
-      for (size_t j = 0, colidx = 0; j < output.n_cols;
-          ++j, colidx += strideHeight)
-      {
-        size_t colEnd = colidx + kernelHeight - 1;
-        // Check if the kernel along column is out of bounds.
-        if (colEnd > input.n_cols - 1)
-        {
-          // If so, we need to reduce the kernel height or terminate.
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-        for (size_t i = 0, rowidx = 0; i < output.n_rows;
-            ++i, rowidx += strideWidth)
-        {
-          size_t rowEnd = rowidx + kernelWidth - 1;
-          // Check if the kernel along row is out of bounds.
-          if (rowEnd > input.n_rows - 1)
-          {
-            // If so, we need to reduce the kernel width or terminate.
-            if (floor)
-              continue;
-            rowEnd = input.n_rows - 1;
-          }
-
-          output(i, j, s) = pooling.Pooling(input.slice(s).submat(
-              rowidx,
-              colidx,
-              rowEnd,
-              colEnd));
-        }
-      }
-    }
-  }
+  template<bool StoreIndices>
+  void PoolingOperation(const MatType& input, MatType& output);
 
   /**
-   * Apply unpooling to all slices of the input and store the results.
+   * Pass the error of every output element back to the maximum of its window.
+   * If the window offsets were not stored (because the window is larger than
+   * 256 elements), the maximum is found again from the input and the output.
    *
+   * @param input The input given to the forward pass.
+   * @param output The output of the forward pass.
    * @param error The backward error.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices (from `PoolingOperation()`).
+   * @param g The error of the input.
    */
-  void UnpoolingOperation(
-      const MatType& error,
-      MatType& output,
-      const arma::Mat<size_t>& poolingIndices)
+  void UnpoolingOperation(const MatType& input,
+                          const MatType& output,
+                          const MatType& error,
+                          MatType& g);
+
+  //! Return the number of output rows whose window holds the given kernel row
+  //! (all of them, unless `floor` is false).
+  size_t WindowRows(const size_t kernelRow) const
   {
-    for (size_t i = 0; i < poolingIndices.n_elem; ++i)
-    {
-      output(poolingIndices(i)) += error(i);
-    }
+    const size_t inRows = this->inputDimensions[0];
+    if (kernelRow >= inRows)
+      return 0;
+
+    return std::min(this->outputDimensions[0],
+        (inRows - kernelRow - 1) / strideWidth + 1);
   }
 
+  //! Return whether the offset of the maximum in each window fits in 8 bits.
+  bool CompactIndices() const { return kernelWidth * kernelHeight <= 256; }
+
   //! Locally-stored width of the pooling window.
   size_t kernelWidth;
 
@@ -300,11 +217,10 @@ class MaxPoolingType : public Layer<MatType>
   //! Locally-stored number of channels.
   size_t channels;
 
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
-
-  //! Locally-stored pooling indices.
-  arma::Cube<size_t> poolingIndices;
+  //! Locally-stored offset of the maximum in each window (column-major in the
+  //! window), with one column per image.  These are only stored during
+  //! training, and only if `CompactIndices()` is true.
+  arma::Mat<unsigned char> poolingIndices;
 }; // class MaxPoolingType
 
 // Standard MaxPooling layer.
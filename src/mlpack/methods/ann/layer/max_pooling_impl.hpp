@@ -52,8 +52,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(other.strideWidth),
     strideHeight(other.strideHeight),
     floor(other.floor),
-    channels(other.channels),
-    pooling(other.pooling)
+    channels(other.channels)
 {
   // Nothing to do here.
 }
@@ -67,8 +66,7 @@ MaxPoolingType<MatType>::MaxPoolingType(
     strideWidth(std::move(other.strideWidth)),
     strideHeight(std::move(other.strideHeight)),
     floor(std::move(other.floor)),
-    channels(std::move(other.channels)),
-    pooling(std::move(other.pooling))
+    channels(std::move(other.channels))
 {
   // Nothing to do here.
 }
@@ -86,7 +84,6 @@ MaxPoolingType<MatType>::operator=(const MaxPoolingType& other)
     strideHeight = other.strideHeight;
     floor = other.floor;
     channels = other.channels;
-    pooling = other.pooling;
   }
 
   return *this;
@@ -105,7 +102,6 @@ MaxPoolingType<MatType>::operator=(MaxPoolingType&& other)
     strideHeight = std::move(other.strideHeight);
     floor = std::move(other.floor);
     channels = std::move(other.channels);
-    pooling = std::move(other.pooling);
   }
 
   return *this;
@@ -114,53 +110,164 @@ MaxPoolingType<MatType>::operator=(MaxPoolingType&& other)
 template<typename MatType>
 void MaxPoolingType<MatType>::Forward(const MatType& input, MatType& output)
 {
-  arma::Cube<typename MatType::elem_type> inputTemp(
-      const_cast<MatType&>(input).memptr(), this->inputDimensions[0],
-      this->inputDimensions[1], input.n_cols * channels, false, false);
-
-  arma::Cube<typename MatType::elem_type> outputTemp(output.memptr(),
-      this->outputDimensions[0], this->outputDimensions[1],
-      input.n_cols * channels, false, true);
-
-  if (this->training)
+  if (this->training && CompactIndices())
   {
     // If we are training, we'll do a backwards pass, so we need to ensure that
     // we know what indices we used.
-    poolingIndices.set_size(this->outputDimensions[0],
+    poolingIndices.set_size(this->outputDimensions[0] *
         this->outputDimensions[1], input.n_cols * channels);
 
-    PoolingOperation(inputTemp, outputTemp, poolingIndices);
+    PoolingOperation<true>(input, output);
   }
   else
   {
-    PoolingOperation(inputTemp, outputTemp);
+    PoolingOperation<false>(input, output);
   }
 }
 
 template<typename MatType>
 void MaxPoolingType<MatType>::Backward(
     const MatType& input,
-    const MatType& /* output */,
+    const MatType& output,
     const MatType& gy,
     MatType& g)
 {
-  arma::Cube<typename MatType::elem_type> mappedError =
-      arma::Cube<typename MatType::elem_type>(((MatType&) gy).memptr(),
-      this->outputDimensions[0], this->outputDimensions[1],
-      channels * input.n_cols, false, false);
+  // There's no version of UnpoolingOperation without the forward pass, because
+  // if we call `Backward()`, we know for sure we are training.
+  g.zeros();
+  UnpoolingOperation(input, output, gy, g);
+}
+
+template<typename MatType>
+template<bool StoreIndices>
+void MaxPoolingType<MatType>::PoolingOperation(
+    const MatType& input, MatType& output)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t inRows = this->inputDimensions[0];
+  const size_t inCols = this->inputDimensions[1];
+  const size_t outRows = this->outputDimensions[0];
+  const size_t outCols = this->outputDimensions[1];
+  const size_t numImages = input.n_cols * channels;
+
+  #pragma omp parallel for
+  for (size_t s = 0; s < numImages; ++s)
+  {
+    const ElemType* in = input.memptr() + s * inRows * inCols;
+    ElemType* out = output.memptr() + s * outRows * outCols;
 
-  arma::Cube<typename MatType::elem_type> gTemp(g.memptr(),
-      this->inputDimensions[0], this->inputDimensions[1],
-      channels * input.n_cols, false, true);
+    for (size_t j = 0; j < outCols; ++j)
+    {
+      // The last windows are cut short if `floor` is false.
+      const size_t colStart = j * strideHeight;
+      const size_t windowCols = std::min(kernelHeight, inCols - colStart);
+      ElemType* outCol = out + j * outRows;
+      unsigned char* indexCol = StoreIndices ?
+          poolingIndices.colptr(s) + j * outRows : NULL;
 
-  gTemp.zeros();
+      // The first element of each window is always in bounds.
+      const ElemType* inCol = in + colStart * inRows;
+      const size_t firstRows = WindowRows(0);
+      for (size_t i = 0; i < firstRows; ++i)
+        outCol[i] = inCol[i * strideWidth];
+      if (StoreIndices)
+        std::fill(indexCol, indexCol + firstRows, 0);
+
+      // Now visit the rest of the kernel in the same (column-major) order as
+      // the window, so that the first maximum is kept.
+      for (size_t kc = 0; kc < windowCols; ++kc)
+      {
+        inCol = in + (colStart + kc) * inRows;
+        for (size_t kr = (kc == 0) ? 1 : 0; kr < kernelWidth; ++kr)
+        {
+          const ElemType* inRow = inCol + kr;
+          const size_t rows = WindowRows(kr);
+          const unsigned char offset = (unsigned char) (kc * kernelWidth + kr);
+          for (size_t i = 0; i < rows; ++i)
+          {
+            const ElemType value = inRow[i * strideWidth];
+            if (value > outCol[i])
+            {
+              outCol[i] = value;
+              if (StoreIndices)
+                indexCol[i] = offset;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename MatType>
+void MaxPoolingType<MatType>::UnpoolingOperation(
+    const MatType& input,
+    const MatType& output,
+    const MatType& error,
+    MatType& g)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  const size_t inRows = this->inputDimensions[0];
+  const size_t inCols = this->inputDimensions[1];
+  const size_t outRows = this->outputDimensions[0];
+  const size_t outCols = this->outputDimensions[1];
+  const size_t numImages = error.n_cols * channels;
+  const bool compact = CompactIndices();
 
-  // There's no version of UnpoolingOperation without pooling indices, because
-  // if we call `Backward()`, we know for sure we are training.
   #pragma omp parallel for
-  for (size_t s = 0; s < (size_t) mappedError.n_slices; s++)
+  for (size_t s = 0; s < numImages; ++s)
   {
-    UnpoolingOperation(mappedError.slice(s), gTemp.slice(s), poolingIndices.slice(s));
+    const ElemType* err = error.memptr() + s * outRows * outCols;
+    ElemType* gImage = g.memptr() + s * inRows * inCols;
+
+    if (compact)
+    {
+      const unsigned char* indices = poolingIndices.colptr(s);
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t offset = indices[j * outRows + i];
+          const size_t r = i * strideWidth + offset % kernelWidth;
+          const size_t c = j * strideHeight + offset / kernelWidth;
+          gImage[c * inRows + r] += err[j * outRows + i];
+        }
+      }
+    }
+    else
+    {
+      // Find the first element of each window that is equal to the maximum.
+      const ElemType* in = input.memptr() + s * inRows * inCols;
+      const ElemType* out = output.memptr() + s * outRows * outCols;
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        const size_t colStart = j * strideHeight;
+        const size_t colEnd = std::min(colStart + kernelHeight, inCols);
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const size_t rowStart = i * strideWidth;
+          const size_t rowEnd = std::min(rowStart + kernelWidth, inRows);
+          const ElemType maxValue = out[j * outRows + i];
+          size_t index = colStart * inRows + rowStart;
+          for (size_t c = colStart; c < colEnd; ++c)
+          {
+            size_t r = rowStart;
+            while (r < rowEnd && in[c * inRows + r] != maxValue)
+              ++r;
+
+            if (r < rowEnd)
+            {
+              index = c * inRows + r;
+              break;
+            }
+          }
+
+          gImage[index] += err[j * outRows + i];
+        }
+      }
+    }
   }
 }
 
@@ -20,7 +20,9 @@
 namespace mlpack {
 
 /**
- * Implementation of the MeanPooling.
+ * Implementation of the MeanPooling.  All channels of all points of a batch
+ * are pooled in one pass, one kernel position at a time, so that the inner
+ * loops run over contiguous rows of the input.
  *
  * @tparam MatType Matrix representation to accept as input and use for
  *         computation.
@@ -123,32 +125,47 @@ class MeanPoolingType : public Layer<MatType>
 
  private:
   /**
-   * Apply pooling to all slices of the input and store the results.
+   * Apply pooling to every image (channel of every point) of the input.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The input to apply the pooling rule to.
    * @param output The pooled result.
    */
-  void PoolingOperation(
-      const arma::Cube<typename MatType::elem_type>& input,
-      arma::Cube<typename MatType::elem_type>& output);
+  void PoolingOperation(const MatType& input, MatType& output);
 
   /**
-   * Apply unpooling to the input and store the results.
+   * Spread the error of every output element evenly over its window.
    *
-   * @param input The input to be apply the unpooling rule.
-   * @param output The pooled result.
+   * @param error The backward error.
+   * @param g The error of the input.
    */
-  void Unpooling(const MatType& error, MatType& output);
+  void Unpooling(const MatType& error, MatType& g);
+
+  //! Return the number of output rows whose window holds the given kernel row
+  //! (all of them, unless `floor` is false).
+  size_t WindowRows(const size_t kernelRow) const
+  {
+    const size_t inRows = this->inputDimensions[0];
+    if (kernelRow >= inRows)
+      return 0;
+
+    return std::min(this->outputDimensions[0],
+        (inRows - kernelRow - 1) / strideWidth + 1);
+  }
 
   /**
-   * Return the average value of the receptive block.
+   * Compute one over the number of rows of the window of each output row
+   * (which is smaller at the border if `floor` is false).
    *
-   * @param input Input used to perform the pooling operation.  Could be an
-   *     Armadillo subview.
+   * @param rowScale Vector to store the factors in.
    */
-  typename MatType::elem_type Pooling(const MatType& input)
+  void RowScale(arma::Col<typename MatType::elem_type>& rowScale) const
   {
-    return arma::mean(vectorise(input));
+    rowScale.set_size(this->outputDimensions[0]);
+    for (size_t i = 0; i < rowScale.n_elem; ++i)
+    {
+      rowScale[i] = 1.0 / std::min(kernelWidth,
+          this->inputDimensions[0] - i * strideWidth);
+    }
   }
 
   //! Locally-stored width of the pooling window.
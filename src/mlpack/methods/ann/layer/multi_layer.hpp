@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_ANN_LAYER_MULTI_LAYER_HPP
 
 #include "layer.hpp"
+#include "../network_profiler.hpp"
 
 namespace mlpack {
 
@@ -146,6 +147,12 @@ class MultiLayer : public Layer<MatType>
    */
   virtual size_t WeightSize() const;
 
+  /**
+   * Return the estimated number of floating-point operations of a forward
+   * pass; this is the sum of the estimates of each layer.
+   */
+  virtual double ForwardFlops(const size_t batchSize) const;
+
   /**
    * Compute the output dimensions of the MultiLayer using `InputDimensions()`.
    * This computes the dimensions of each layer held by the MultiLayer, and the
@@ -194,6 +201,14 @@ class MultiLayer : public Layer<MatType>
   //! careful!
   std::vector<Layer<MatType>*>& Network() { return network; }
 
+  //! Get the profiler that records the passes of each layer (`NULL` if the
+  //! MultiLayer is not profiled).
+  NetworkProfiler* Profiler() const { return profiler; }
+  //! Modify the profiler that records the passes of each layer; set it to
+  //! `NULL` to stop profiling.  The profiler is not owned by the MultiLayer,
+  //! and it is not copied with it.
+  NetworkProfiler*& Profiler() { return profiler; }
+
   //! Serialize the MultiLayer.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -225,6 +240,25 @@ class MultiLayer : public Layer<MatType>
    */
   void InitializeGradientPassMemory(MatType& gradient);
 
+  //! Call Forward() on the layer with the given index, recording the call in
+  //! the profiler if there is one.
+  void LayerForward(const size_t i, const MatType& input, MatType& output);
+
+  //! Call Backward() on the layer with the given index, recording the call in
+  //! the profiler if there is one.
+  void LayerBackward(const size_t i,
+                     const MatType& input,
+                     const MatType& output,
+                     const MatType& gy,
+                     MatType& g);
+
+  //! Call Gradient() on the layer with the given index, recording the call in
+  //! the profiler if there is one.
+  void LayerGradient(const size_t i,
+                     const MatType& input,
+                     const MatType& error,
+                     MatType& gradient);
+
   //! The internally-held network.
   std::vector<Layer<MatType>*> network;
 
@@ -251,6 +285,9 @@ class MultiLayer : public Layer<MatType>
   //! context of `Gradient()`!  We have it as a class member to avoid
   //! reallocating the `MatType`s each call to `Gradient()`.
   std::vector<MatType> layerGradients;
+
+  //! The profiler that records the passes of each layer, if any.
+  NetworkProfiler* profiler;
 };
 
 } // namespace mlpack
@@ -22,7 +22,8 @@ MultiLayer<MatType>::MultiLayer() :
     Layer<MatType>(),
     inSize(0),
     totalInputSize(0),
-    totalOutputSize(0)
+    totalOutputSize(0),
+    profiler(NULL)
 {
   // Nothing to do.
 }
@@ -34,7 +35,9 @@ MultiLayer<MatType>::MultiLayer(const MultiLayer& other) :
     totalInputSize(other.totalInputSize),
     totalOutputSize(other.totalOutputSize),
     layerOutputMatrix(other.layerOutputMatrix),
-    layerDeltaMatrix(other.layerDeltaMatrix)
+    layerDeltaMatrix(other.layerDeltaMatrix),
+    // A copy is not profiled (this is the case of the replicas of a network).
+    profiler(NULL)
 {
   // Copy each layer.
   for (size_t i = 0; i < other.network.size(); ++i)
@@ -57,7 +60,8 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
     totalInputSize(std::move(other.totalInputSize)),
     totalOutputSize(std::move(other.totalOutputSize)),
     layerOutputMatrix(std::move(other.layerOutputMatrix)),
-    layerDeltaMatrix(std::move(other.layerDeltaMatrix))
+    layerDeltaMatrix(std::move(other.layerDeltaMatrix)),
+    profiler(other.profiler)
 {
   // Ensure that the aliases for layers during passes have the right size.
   layerOutputs.resize(network.size(), MatType());
@@ -70,6 +74,7 @@ MultiLayer<MatType>::MultiLayer(MultiLayer&& other) :
   other.layerOutputs.clear();
   other.layerDeltas.clear();
   other.layerGradients.clear();
+  other.profiler = NULL;
 }
 
 template<typename MatType>
@@ -157,14 +162,14 @@ void MultiLayer<MatType>::Forward(
     // Initialize memory for the forward pass (if needed).
     InitializeForwardPassMemory(input.n_cols);
 
-    network[start]->Forward(input, layerOutputs[start]);
+    LayerForward(start, input, layerOutputs[start]);
     for (size_t i = start + 1; i < end; ++i)
-      network[i]->Forward(layerOutputs[i - 1], layerOutputs[i]);
-    network[end]->Forward(layerOutputs[end - 1], output);
+      LayerForward(i, layerOutputs[i - 1], layerOutputs[i]);
+    LayerForward(end, layerOutputs[end - 1], output);
   }
   else if ((end - start) == 0 && network.size() > 0)
   {
-    network[start]->Forward(input, output);
+    LayerForward(start, input, output);
   }
   else
   {
@@ -185,16 +190,16 @@ void MultiLayer<MatType>::Backward(
     // Initialize memory for the backward pass (if needed).
     InitializeBackwardPassMemory(input.n_cols);
 
-    network.back()->Backward(layerOutputs[network.size() - 2], output, gy,
-        layerDeltas.back());
+    LayerBackward(network.size() - 1, layerOutputs[network.size() - 2],
+        output, gy, layerDeltas.back());
     for (size_t i = network.size() - 2; i > 0; --i)
-      network[i]->Backward(layerOutputs[i - 1], layerOutputs[i],
+      LayerBackward(i, layerOutputs[i - 1], layerOutputs[i],
           layerDeltas[i + 1], layerDeltas[i]);
-    network[0]->Backward(input, layerOutputs[0], layerDeltas[1], g);
+    LayerBackward(0, input, layerOutputs[0], layerDeltas[1], g);
   }
   else if (network.size() == 1)
   {
-    network[0]->Backward(input, output, gy, g);
+    LayerBackward(0, input, output, gy, g);
   }
   else
   {
@@ -215,18 +220,18 @@ void MultiLayer<MatType>::Gradient(
     // Initialize memory for the gradient pass (if needed).
     InitializeGradientPassMemory(gradient);
 
-    network.front()->Gradient(input, layerDeltas[1], layerGradients.front());
+    LayerGradient(0, input, layerDeltas[1], layerGradients.front());
     for (size_t i = 1; i < network.size() - 1; ++i)
     {
-      network[i]->Gradient(layerOutputs[i - 1], layerDeltas[i + 1],
+      LayerGradient(i, layerOutputs[i - 1], layerDeltas[i + 1],
           layerGradients[i]);
     }
-    network.back()->Gradient(layerOutputs[network.size() - 2], error,
+    LayerGradient(network.size() - 1, layerOutputs[network.size() - 2], error,
         layerGradients.back());
   }
   else if (network.size() == 1)
   {
-    network[0]->Gradient(input, error, gradient);
+    LayerGradient(0, input, error, gradient);
   }
   else
   {
@@ -234,6 +239,15 @@ void MultiLayer<MatType>::Gradient(
   }
 }
 
+template<typename MatType>
+double MultiLayer<MatType>::ForwardFlops(const size_t batchSize) const
+{
+  double flops = 0.0;
+  for (size_t i = 0; i < network.size(); ++i)
+    flops += network[i]->ForwardFlops(batchSize);
+  return flops;
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::SetWeights(const MatType& weightsIn)
 {
@@ -368,6 +382,64 @@ void MultiLayer<MatType>::serialize(
   }
 }
 
+template<typename MatType>
+void MultiLayer<MatType>::LayerForward(const size_t i,
+                                       const MatType& input,
+                                       MatType& output)
+{
+  if (profiler == NULL)
+  {
+    network[i]->Forward(input, output);
+    return;
+  }
+
+  profiler->StartForward(i);
+  network[i]->Forward(input, output);
+  profiler->StopForward(i, output.n_elem * sizeof(typename MatType::elem_type),
+      network[i]->ForwardFlops(input.n_cols));
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::LayerBackward(const size_t i,
+                                        const MatType& input,
+                                        const MatType& output,
+                                        const MatType& gy,
+                                        MatType& g)
+{
+  if (profiler == NULL)
+  {
+    network[i]->Backward(input, output, gy, g);
+    return;
+  }
+
+  // The backward pass is assumed to cost as much as the forward pass.
+  profiler->StartBackward(i);
+  network[i]->Backward(input, output, gy, g);
+  profiler->StopBackward(i, g.n_elem * sizeof(typename MatType::elem_type),
+      network[i]->ForwardFlops(input.n_cols));
+}
+
+template<typename MatType>
+void MultiLayer<MatType>::LayerGradient(const size_t i,
+                                        const MatType& input,
+                                        const MatType& error,
+                                        MatType& gradient)
+{
+  if (profiler == NULL)
+  {
+    network[i]->Gradient(input, error, gradient);
+    return;
+  }
+
+  // So is the gradient pass, for layers with weights.
+  profiler->StartGradient(i);
+  network[i]->Gradient(input, error, gradient);
+  profiler->StopGradient(i,
+      gradient.n_elem * sizeof(typename MatType::elem_type),
+      (network[i]->WeightSize() > 0) ?
+          network[i]->ForwardFlops(input.n_cols) : 0.0);
+}
+
 template<typename MatType>
 void MultiLayer<MatType>::InitializeForwardPassMemory(const size_t batchSize)
 {
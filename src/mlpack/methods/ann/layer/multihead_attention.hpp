@@ -58,6 +58,19 @@ namespace mlpack {
  * [embedDim * (2 * srcSeqLen + tgtSeqLen), batchSize].  The
  * output data will always be of size (embedDim * tgtSeqLen, batchSize)
  *
+ * The softmax of the scores of each query is taken over the keys.  The
+ * attention is computed in tiles of `tileSize` queries by `tileSize` keys
+ * with an online softmax, so the full (tgtSeqLen x srcSeqLen) attention matrix
+ * of each head is never held in memory; only the log-sum-exp of each row of it
+ * is kept for the backward pass, which computes the attention of each tile
+ * again.  This uses O(tileSize^2) extra memory per head instead of
+ * O(tgtSeqLen * srcSeqLen).
+ *
+ * For autoregressive inference with self-attention, `Decode()` computes the
+ * output for one or more new positions of the sequence, and caches their
+ * projected keys and values, so that the earlier positions are not projected
+ * again at each step.
+ *
  * @tparam MatType Type of the input/output data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
  * @tparam RegularizerType Type of the regularizer to be used.
@@ -85,12 +98,15 @@ class MultiheadAttentionType : public Layer<MatType>
    * @param keyPaddingMask Key Padding Mask.  Takes the values [-Inf, 0]
    * @param selfAttention Use self-attention; source key, query, and value all
    *     come from the same inputs
+   * @param tileSize Number of queries and keys in each tile of the attention
+   *     computation; 0 computes the attention of each head as a single tile.
    */
   MultiheadAttentionType(const size_t tgtSeqLen,
                          const size_t numHeads,
                          const MatType& attnMask = MatType(),
                          const MatType& keyPaddingMask = MatType(),
-                         const bool selfAttention = false);
+                         const bool selfAttention = false,
+                         const size_t tileSize = 64);
 
   //! Clone the MultiheadAttentionType object. This handles polymorphism
   //! correctly.
@@ -139,6 +155,24 @@ class MultiheadAttentionType : public Layer<MatType>
                 const MatType& error,
                 MatType& gradient) override;
 
+  /**
+   * Compute the output for the next positions of the sequence during
+   * autoregressive inference; this is only available with self-attention.  The
+   * keys and values of the given positions are added to the cache, and each
+   * position attends to every cached position up to (and including) itself.
+   * The attention and key padding masks are not used.  Call `ResetCache()`
+   * before decoding a new sequence.
+   *
+   * @param input Embeddings of the new positions, of shape
+   *     (embedDim * numPositions, batchSize).
+   * @param output Output for the new positions, of shape
+   *     (embedDim * numPositions, batchSize).
+   */
+  void Decode(const MatType& input, MatType& output);
+
+  //! Clear the key/value cache used by `Decode()`.
+  void ResetCache();
+
   //! Get the size of the weights.
   size_t WeightSize() const override { return 4 * (embedDim + 1) * embedDim; }
 
@@ -183,6 +217,14 @@ class MultiheadAttentionType : public Layer<MatType>
   //! Modify the Key Padding Mask.  Should take values 0 or 1.
   MatType& KeyPaddingMask() { return keyPaddingMask; }
 
+  //! Get the number of queries and keys in each tile of the attention.
+  size_t TileSize() const { return tileSize; }
+  //! Modify the number of queries and keys in each tile of the attention.
+  size_t& TileSize() { return tileSize; }
+
+  //! Get the number of positions in the key/value cache used by `Decode()`.
+  size_t CacheLength() const { return cacheLength; }
+
   //! Get whether or not self-attention is used (source key, value, and query all
   //! come from the same input).
   bool SelfAttention() const { return selfAttention; }
@@ -266,6 +308,73 @@ class MultiheadAttentionType : public Layer<MatType>
  private:
   //! Element Type of the output.
   typedef typename MatType::elem_type ElemType;
+  //! Type of a cube of the input/output data.
+  typedef arma::Cube<ElemType> CubeType;
+  //! Type of a column vector of the input/output data.
+  typedef arma::Col<ElemType> ColType;
+
+  /**
+   * Compute the attention output of one head, tile by tile, with an online
+   * softmax over the keys.
+   *
+   * @param q Projected (and scaled) queries, of shape (numQueries, headDim).
+   * @param k Projected keys, of shape (numKeys, headDim).
+   * @param v Projected values, of shape (numKeys, headDim).
+   * @param mask Attention mask of shape (numQueries, numKeys), or empty.
+   * @param padding Key padding mask of shape (1, numKeys), or empty.
+   * @param out Attention output, of shape (numQueries, headDim).
+   * @param logSumExp If not NULL, set to the log-sum-exp of the scores of each
+   *     query.
+   */
+  void AttentionForward(const arma::Mat<ElemType>& q,
+                        const arma::Mat<ElemType>& k,
+                        const arma::Mat<ElemType>& v,
+                        const MatType& mask,
+                        const MatType& padding,
+                        arma::Mat<ElemType>& out,
+                        ElemType* logSumExp) const;
+
+  /**
+   * Backpropagate the error of the attention output of one head, computing the
+   * attention of each tile again from the log-sum-exp of the forward pass.
+   *
+   * @param q Projected (and scaled) queries, of shape (numQueries, headDim).
+   * @param k Projected keys, of shape (numKeys, headDim).
+   * @param v Projected values, of shape (numKeys, headDim).
+   * @param out Attention output of the forward pass.
+   * @param logSumExp Log-sum-exp of the scores of each query.
+   * @param dOut Error of the attention output.
+   * @param dQ Set to the error of the (scaled) queries.
+   * @param dK Set to the error of the keys.
+   * @param dV Set to the error of the values.
+   */
+  void AttentionBackward(const arma::Mat<ElemType>& q,
+                         const arma::Mat<ElemType>& k,
+                         const arma::Mat<ElemType>& v,
+                         const arma::Mat<ElemType>& out,
+                         const ElemType* logSumExp,
+                         const arma::Mat<ElemType>& dOut,
+                         arma::Mat<ElemType>& dQ,
+                         arma::Mat<ElemType>& dK,
+                         arma::Mat<ElemType>& dV) const;
+
+  /**
+   * Backpropagate the error of the attention output of every head, given as a
+   * cube of shape (tgtSeqLen, headDim, numHeads * batchSize).  dQ is the error
+   * of the scaled queries.
+   */
+  void BackwardHeads(const CubeType& dOut,
+                     CubeType& dQ,
+                     CubeType& dK,
+                     CubeType& dV) const;
+
+  //! Add the masks to the given tile of scores, whose first element is at the
+  //! given query and key.
+  static void MaskTile(arma::Mat<ElemType>& scores,
+                       const MatType& mask,
+                       const MatType& padding,
+                       const size_t queryBegin,
+                       const size_t keyBegin);
 
   //! Target sequence length.
   size_t tgtSeqLen;
@@ -293,6 +402,9 @@ class MultiheadAttentionType : public Layer<MatType>
   //! come from the same input).
   bool selfAttention;
 
+  //! Number of queries and keys in each tile of the attention.
+  size_t tileSize;
+
   //! Locally-stored weight matrix associated with query.
   MatType queryWt;
 
@@ -329,14 +441,22 @@ class MultiheadAttentionType : public Layer<MatType>
   //! Locally-stored projected value matrix over linear layer.
   arma::Cube<ElemType> vProj;
 
-  //! Locally-stored result of output of dropout layer.
-  arma::Cube<ElemType> scores;
+  //! Locally-stored log-sum-exp of the scores of each query, for each head;
+  //! the shape is (tgtSeqLen, numHeads * batchSize).
+  arma::Mat<ElemType> logSumExp;
 
   //! Locally-stored attention output weight to be fed to last linear layer.
   arma::Cube<ElemType> attnOut;
 
-  //! Softmax layer to represent the probabilities of next sequence.
-  SoftmaxType<MatType> softmax;
+  //! Cached projected keys for Decode(), of shape
+  //! (capacity, headDim, numHeads * batchSize).
+  arma::Cube<ElemType> keyCache;
+
+  //! Cached projected values for Decode(), of the same shape as keyCache.
+  arma::Cube<ElemType> valueCache;
+
+  //! Number of positions held in the cache.
+  size_t cacheLength;
 
   //! Locally-stored regularizer object.
   RegularizerType regularizer;
@@ -347,6 +467,9 @@ typedef MultiheadAttentionType<arma::mat, NoRegularizer> MultiheadAttention;
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename MatType, typename RegularizerType),
+    (mlpack::MultiheadAttentionType<MatType, RegularizerType>), (1));
+
 // Include implementation.
 #include "multihead_attention_impl.hpp"
 
@@ -29,7 +29,9 @@ MultiheadAttentionType() :
     embedDim(0),
     numHeads(0),
     headDim(0),
-    selfAttention(false)
+    selfAttention(false),
+    tileSize(64),
+    cacheLength(0)
 {
   // Nothing to do here.
 }
@@ -41,14 +43,17 @@ MultiheadAttentionType(
     const size_t numHeads,
     const MatType& attnmask,
     const MatType& keypaddingmask,
-    const bool selfAttention) :
+    const bool selfAttention,
+    const size_t tileSize) :
     tgtSeqLen(tgtSeqLen),
     srcSeqLen(0),
     embedDim(0),
     numHeads(numHeads),
     attnMask(attnmask),
     keyPaddingMask(keypaddingmask),
-    selfAttention(selfAttention)
+    selfAttention(selfAttention),
+    tileSize(tileSize),
+    cacheLength(0)
 {
 }
 
@@ -73,8 +78,6 @@ template <typename MatType, typename RegularizerType>
 void MultiheadAttentionType<MatType, RegularizerType>::
 Forward(const MatType& input, MatType& output)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   if (input.n_rows != embedDim *
       (selfAttention ? srcSeqLen : (tgtSeqLen + 2 * srcSeqLen)))
   {
@@ -132,42 +135,38 @@ Forward(const MatType& input, MatType& output)
   kProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
   vProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
 
-  // Calculate the scores i.e. perform the matrix multiplication operation
-  // on qProj and kProj. Here score = qProj . kProj'
-  scores = MultiplyCube2Cube(qProj, kProj, false, true);
-
-  // Apply the attention mask if provided. The attention mask is used to black-
-  // out future sequences and generally used in Encoder-Decoder attention.
-  // The attention mask has elements -inf or 0.
-  // The shape of the attention mask : (tgtSeqLen, srcSeqLen).
-  if (!attnMask.is_empty())
+  // The attention mask is used to black-out future sequences and generally
+  // used in Encoder-Decoder attention.  The attention mask has elements -inf
+  // or 0.  The shape of the attention mask : (tgtSeqLen, srcSeqLen).
+  if (!attnMask.is_empty() &&
+      (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen))
   {
-    if (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen)
-      Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
-    scores.each_slice() += attnMask;
+    Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
   }
 
-  // Apply the key padding mask when provided. It blacks-out any particular
-  // word in the sequence.
-  // The key padding mask has elements -inf or 0
+  // The key padding mask blacks-out any particular word in the sequence.
+  // The key padding mask has elements -inf or 0.
   // The shape of keyPaddingMask : (1, srcSeqLen).
-  if (!keyPaddingMask.is_empty())
+  if (!keyPaddingMask.is_empty() &&
+      (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen))
   {
-    if (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen)
-        Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
-    scores.each_slice() += repmat(keyPaddingMask, tgtSeqLen, 1);
+    Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
   }
 
+  // Calculate the attention output of each head, i.e. the product of the
+  // softmax of qProj . kProj' (with the masks added) and vProj, without
+  // holding all of the scores at once.
+  // The shape of attnOut : (tgtSeqLen, headDim, numHeads * batchSize).
+  attnOut.set_size(tgtSeqLen, headDim, numHeads * batchSize);
+  logSumExp.set_size(tgtSeqLen, numHeads * batchSize);
+
+  #pragma omp parallel for
   for (size_t i = 0; i < numHeads * batchSize; ++i)
   {
-    softmax.Forward(scores.slice(i), scores.slice(i));
+    AttentionForward(qProj.slice(i), kProj.slice(i), vProj.slice(i), attnMask,
+        keyPaddingMask, attnOut.slice(i), logSumExp.colptr(i));
   }
 
-  // Calculate the attention output i.e. matrix multiplication of softmax
-  // output and vProj.
-  // The shape of attnOutput : (tgtSeqLen, headDim, numHeads * batchSize).
-  attnOut = MultiplyCube2Cube(scores, vProj, false, false);
-
   // Now we will concatenate output of all the heads i.e. we will reshape
   // attnOut to (tgtSeqLen, embedDim, batchSize).
   attnOut.reshape(tgtSeqLen, embedDim, batchSize);
@@ -187,8 +186,6 @@ Backward(const MatType& /* input */,
          const MatType& gy,
          MatType& g)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   if (gy.n_rows != tgtSeqLen * embedDim)
   {
     Log::Fatal << "Backpropagated error has incorrect dimensions!" << std::endl;
@@ -215,48 +212,31 @@ Backward(const MatType& /* input */,
   // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
   gyTemp.reshape(tgtSeqLen, headDim, numHeads * batchSize);
 
-  // Obtain backpropagted error of value.
-  // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  CubeType tmp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  // Obtain the backpropagated errors of the projected query, key, and value.
+  // The shape of dQ : (tgtSeqLen, headDim, numHeads * batchSize).
+  // The shape of dK and dV : (srcSeqLen, headDim, numHeads * batchSize).
+  CubeType dQ, dK, dV;
+  BackwardHeads(gyTemp, dQ, dK, dV);
 
   // Concatenate results of all the attention heads.
-  tmp.reshape(srcSeqLen, embedDim, batchSize);
+  dV.reshape(srcSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
     if (selfAttention)
     {
       g.submat(0, i, g.n_rows - 1, i) =
-          vectorise(trans(tmp.slice(i) * valueWt));
+          vectorise(trans(dV.slice(i) * valueWt));
     }
     else
     {
       g.submat((tgtSeqLen + srcSeqLen) * embedDim, i, g.n_rows - 1, i) =
-          vectorise(trans(tmp.slice(i) * valueWt));
+          vectorise(trans(dV.slice(i) * valueWt));
     }
   }
 
-  // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // So the new shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    // We will perform backpropagation of softmax over each slice of gyTemp.
-    softmax.Backward({} /* unused */, scores.slice(i), gyTemp.slice(i), gyTemp.slice(i));
-  }
-
-  // Obtain backpropagated error of key.
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of tmp : (srcSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, qProj, true, false);
-
   // Concatenate results of all the attention heads.
-  tmp.reshape(srcSeqLen, embedDim, batchSize);
+  dK.reshape(srcSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -264,24 +244,21 @@ Backward(const MatType& /* input */,
     {
       // Sum the query, key, and value deltas.
       g.submat(0, i, g.n_rows - 1, i) +=
-          vectorise(trans(tmp.slice(i) * keyWt));
+          vectorise(trans(dK.slice(i) * keyWt));
     }
     else
     {
       g.submat(tgtSeqLen * embedDim, i,
                (tgtSeqLen + srcSeqLen) * embedDim - 1, i) =
-          vectorise(trans(tmp.slice(i) * keyWt));
+          vectorise(trans(dK.slice(i) * keyWt));
     }
   }
 
-  // Obtain backpropagated error of the query.
-  // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of tmp : (tgtSeqLen, headDim, numHeads * batchSize).
-  tmp = MultiplyCube2Cube(gyTemp, kProj) / std::sqrt(headDim);
+  // The query was scaled by 1 / sqrt(headDim) in the forward pass.
+  dQ /= std::sqrt(headDim);
 
   // Concatenate results of all the attention heads.
-  tmp.reshape(tgtSeqLen, embedDim, batchSize);
+  dQ.reshape(tgtSeqLen, embedDim, batchSize);
 
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -289,12 +266,12 @@ Backward(const MatType& /* input */,
     {
       // Sum the query, key, and value deltas.
       g.submat(0, i, g.n_rows - 1, i) +=
-          vectorise(trans(tmp.slice(i) * queryWt));
+          vectorise(trans(dQ.slice(i) * queryWt));
     }
     else
     {
       g.submat(0, i, tgtSeqLen * embedDim - 1, i) =
-          vectorise(trans(tmp.slice(i) * queryWt));
+          vectorise(trans(dQ.slice(i) * queryWt));
     }
   }
 }
@@ -305,8 +282,6 @@ Gradient(const MatType& input,
          const MatType& error,
          MatType& gradient)
 {
-  typedef typename arma::Cube<typename MatType::elem_type> CubeType;
-
   if (input.n_rows != embedDim * (selfAttention ? srcSeqLen :
       (tgtSeqLen + 2 * srcSeqLen)))
   {
@@ -368,84 +343,60 @@ Gradient(const MatType& input,
   // (tgtSeqLen, headDim, numHeads * batchSize).
   gyTemp.reshape(tgtSeqLen, headDim, numHeads * batchSize);
 
-  // Shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // Shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The new shape of errorTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(scores, gyTemp, true, false);
+  // Obtain the propagated errors of the projected query, key, and value.
+  CubeType dQ, dK, dV;
+  BackwardHeads(gyTemp, dQ, dK, dV);
 
   // Now we will concatenate the propagated errors from all heads i.e. we
-  // will reshape errorTemp to (srcSeqLen, embedDim, batchSize).
-  errorTemp.reshape(srcSeqLen, embedDim, batchSize);
+  // will reshape dV to (srcSeqLen, embedDim, batchSize).
+  dV.reshape(srcSeqLen, embedDim, batchSize);
 
-  // Gradient wrt. vBias, i.e. dL/d(vBias). We will take summation of errorTemp
-  // over all the batches and over all the sequences.
+  // Gradient wrt. vBias, i.e. dL/d(vBias). We will take summation of dV over
+  // all the batches and over all the sequences.
   gradient.rows(4 * wtSize + 2 * embedDim, 4 * wtSize + 3 * embedDim - 1)
-      = vectorise(sum(sum(errorTemp, 2), 0));
+      = vectorise(sum(sum(dV, 2), 0));
 
-  // Shape of v : (srcSeqLen, embedDim, batchSize).
-  // Shape of errorTemp : (srcSeqLen, embedDim, bathSize).
-  // The new shape of errorTemp : (embedDim, embedDim, batchSize).
-  errorTemp = MultiplyCube2Cube(errorTemp, v, true, true);
+  // Shape of v : (embedDim, srcSeqLen, batchSize).
+  // Shape of dV : (srcSeqLen, embedDim, bathSize).
+  // The shape of gyTemp : (embedDim, embedDim, batchSize).
+  gyTemp = MultiplyCube2Cube(dV, v, true, true);
 
   // Gradient wrt. valueWt, i.e. dL/d(valueWt). We will take summation over all
-  // batches of errorTemp.
-  gradient.rows(2 * wtSize, 3 * wtSize - 1) = vectorise(sum(errorTemp, 2));
-
-  // Now, the shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of vProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The new shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  errorTemp = MultiplyCube2Cube(gyTemp, vProj, false, true);
-
-  for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-    // The new shape of errorTemp remain same.
-    softmax.Backward({} /* unused */, scores.slice(i), errorTemp.slice(i),
-        errorTemp.slice(i));
-  }
-
-  // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
-  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of gyTemp : (srcSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, qProj, true, false);
+  // batches of gyTemp.
+  gradient.rows(2 * wtSize, 3 * wtSize - 1) = vectorise(sum(gyTemp, 2));
 
   // We will now conctenate the propagated errors from all heads.
-  // The new shape of gyTemp : (srcSeqLen, embedDim, batchSize).
-  gyTemp.reshape(srcSeqLen, embedDim, batchSize);
+  // The new shape of dK : (srcSeqLen, embedDim, batchSize).
+  dK.reshape(srcSeqLen, embedDim, batchSize);
 
   // Gradient wrt. kBias, i.e. dL/d(kBias). We will take summation over all the
-  // batches of gyTemp and then over all the sequences.
+  // batches of dK and then over all the sequences.
   gradient.rows(4 * wtSize + embedDim, 4 * wtSize + 2 * embedDim - 1)
-      = vectorise(sum(sum(gyTemp, 2), 0));
+      = vectorise(sum(sum(dK, 2), 0));
 
   // The shape of k : (embedDim, srcSeqLen, batchSize).
-  // The shape of gyTemp : (srcSeqLen, embedDim, batchSize).
+  // The shape of dK : (srcSeqLen, embedDim, batchSize).
   // The shape of dkeyWt : (embedDim, embedDim, batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, k, true, true);
+  gyTemp = MultiplyCube2Cube(dK, k, true, true);
 
   // Gradient wrt. keyWt, i.e. dL/d(keyWt). We will take summation over all the
   // batches of dkeyWt.
   gradient.rows(wtSize, 2 * wtSize - 1) = vectorise(sum(gyTemp, 2));
 
-  // The shape of kProj : (srcSeqLen, headDim, numHeads * batchSize).
-  // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
-  // The shape of gyTemp : (tgtSeqLen, headDim, numHeads * batchSize).
-  gyTemp = MultiplyCube2Cube(errorTemp, kProj, false, false);
-
-  // Now, we will concatenate propagated error of all heads.
-  gyTemp.reshape(tgtSeqLen, embedDim, batchSize);
-  gyTemp /= std::sqrt(headDim);
+  // Now, we will concatenate propagated error of all heads.  The query was
+  // scaled by 1 / sqrt(headDim) in the forward pass.
+  dQ.reshape(tgtSeqLen, embedDim, batchSize);
+  dQ /= std::sqrt(headDim);
 
   // Gradient wrt. qBias, i.e. dL/d(qBias). We will take summation over all the
-  // batches of gyTemp and over all the sequences.
+  // batches of dQ and over all the sequences.
   gradient.rows(4 * wtSize, 4 * wtSize + embedDim - 1)
-      = vectorise(sum(sum(gyTemp, 2), 0));
+      = vectorise(sum(sum(dQ, 2), 0));
 
-  // The shape of gyTemp : (tgtSeqLen, embedDim, batchSize).
+  // The shape of dQ : (tgtSeqLen, embedDim, batchSize).
   // The shape of q : (embedDim, tgtSeqLen, batchSize).
   // The shape of gyTemp : (embedDim, embedDim, batchSize).
-  gyTemp = MultiplyCube2Cube(gyTemp, q, true, true);
+  gyTemp = MultiplyCube2Cube(dQ, q, true, true);
 
   // Gradient wrt. queryWt, i.e. dL/d(queryBias). We will take summation over
   // all the batches of gyTemp.
@@ -455,10 +406,268 @@ Gradient(const MatType& input,
   regularizer.Evaluate(weights, gradient);
 }
 
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::
+Decode(const MatType& input, MatType& output)
+{
+  if (!selfAttention)
+  {
+    throw std::logic_error("MultiheadAttention::Decode(): decoding with a "
+        "key/value cache requires self-attention!");
+  }
+
+  if (input.n_rows == 0 || input.n_rows % embedDim != 0)
+  {
+    throw std::invalid_argument("MultiheadAttention::Decode(): the number of "
+        "rows of the input must be a multiple of the embedding dimension!");
+  }
+
+  const size_t numPositions = input.n_rows / embedDim;
+  const size_t batchSize = input.n_cols;
+  if (cacheLength > 0 && keyCache.n_slices != numHeads * batchSize)
+  {
+    throw std::invalid_argument("MultiheadAttention::Decode(): the batch size "
+        "does not match the cached sequences; call ResetCache() first!");
+  }
+
+  // Project the new positions, just like Forward().
+  const CubeType x(const_cast<MatType&>(input).memptr(), embedDim,
+      numPositions, batchSize, false, false);
+  CubeType qNew(numPositions, embedDim, batchSize);
+  CubeType kNew(numPositions, embedDim, batchSize);
+  CubeType vNew(numPositions, embedDim, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    qNew.slice(i) = trans(queryWt * x.slice(i) +
+        repmat(qBias, 1, numPositions));
+    kNew.slice(i) = trans(keyWt * x.slice(i) + repmat(kBias, 1, numPositions));
+    vNew.slice(i) = trans(valueWt * x.slice(i) +
+        repmat(vBias, 1, numPositions));
+  }
+
+  qNew /= std::sqrt(headDim);
+  qNew.reshape(numPositions, headDim, numHeads * batchSize);
+  kNew.reshape(numPositions, headDim, numHeads * batchSize);
+  vNew.reshape(numPositions, headDim, numHeads * batchSize);
+
+  // Grow the cache if needed; its capacity is doubled, so that the cached
+  // positions are copied O(log(length)) times in total.
+  const size_t length = cacheLength + numPositions;
+  if (cacheLength == 0 || keyCache.n_rows < length)
+  {
+    const size_t capacity = std::max(length, (cacheLength == 0) ?
+        tgtSeqLen : 2 * (size_t) keyCache.n_rows);
+    CubeType newKeys(capacity, headDim, numHeads * batchSize);
+    CubeType newValues(capacity, headDim, numHeads * batchSize);
+    if (cacheLength > 0)
+    {
+      newKeys.rows(0, cacheLength - 1) = keyCache.rows(0, cacheLength - 1);
+      newValues.rows(0, cacheLength - 1) = valueCache.rows(0, cacheLength - 1);
+    }
+
+    keyCache = std::move(newKeys);
+    valueCache = std::move(newValues);
+  }
+
+  keyCache.rows(cacheLength, length - 1) = kNew;
+  valueCache.rows(cacheLength, length - 1) = vNew;
+
+  // Each new position may only attend to itself and the positions before it.
+  MatType causalMask;
+  if (numPositions > 1)
+  {
+    causalMask.zeros(numPositions, length);
+    for (size_t i = 0; i < numPositions; ++i)
+    {
+      for (size_t j = cacheLength + i + 1; j < length; ++j)
+        causalMask(i, j) = -std::numeric_limits<ElemType>::infinity();
+    }
+  }
+
+  CubeType heads(numPositions, headDim, numHeads * batchSize);
+  #pragma omp parallel for
+  for (size_t i = 0; i < numHeads * batchSize; ++i)
+  {
+    const arma::Mat<ElemType> k = keyCache.slice(i).rows(0, length - 1);
+    const arma::Mat<ElemType> v = valueCache.slice(i).rows(0, length - 1);
+    AttentionForward(qNew.slice(i), k, v, causalMask, MatType(),
+        heads.slice(i), NULL);
+  }
+
+  cacheLength = length;
+
+  // Concatenate the heads, and apply the output projection.
+  heads.reshape(numPositions, embedDim, batchSize);
+  output.set_size(embedDim * numPositions, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    output.col(i) = vectorise(trans(heads.slice(i) * outWt
+        + repmat(outBias, numPositions, 1)));
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::ResetCache()
+{
+  keyCache.clear();
+  valueCache.clear();
+  cacheLength = 0;
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::AttentionForward(
+    const arma::Mat<ElemType>& q,
+    const arma::Mat<ElemType>& k,
+    const arma::Mat<ElemType>& v,
+    const MatType& mask,
+    const MatType& padding,
+    arma::Mat<ElemType>& out,
+    ElemType* logSumExp) const
+{
+  const ElemType inf = std::numeric_limits<ElemType>::infinity();
+  const size_t tile = (tileSize == 0) ? std::max(q.n_rows, k.n_rows) :
+      tileSize;
+
+  out.zeros();
+  for (size_t r = 0; r < q.n_rows; r += tile)
+  {
+    const size_t rEnd = std::min(r + tile, (size_t) q.n_rows) - 1;
+
+    // The running maximum and sum of the exponentiated scores of each query.
+    ColType rowMax(rEnd - r + 1);
+    rowMax.fill(-inf);
+    ColType rowSum(rEnd - r + 1, arma::fill::zeros);
+    ColType shift(rEnd - r + 1, arma::fill::zeros);
+    for (size_t c = 0; c < k.n_rows; c += tile)
+    {
+      const size_t cEnd = std::min(c + tile, (size_t) k.n_rows) - 1;
+      arma::Mat<ElemType> scores = q.rows(r, rEnd) * trans(k.rows(c, cEnd));
+      MaskTile(scores, mask, padding, r, c);
+
+      // A query that has only seen masked keys so far has a maximum of -inf;
+      // its scores are shifted by 0 instead, to avoid NaNs.
+      const ColType newMax = arma::max(rowMax, arma::max(scores, 1));
+      shift = newMax;
+      shift.replace(-inf, 0);
+
+      scores.each_col() -= shift;
+      scores = exp(scores);
+
+      // Rescale what was accumulated with the previous maximum.
+      const ColType scale = exp(rowMax - shift);
+      rowSum = rowSum % scale + sum(scores, 1);
+      out.rows(r, rEnd).each_col() %= scale;
+      out.rows(r, rEnd) += scores * v.rows(c, cEnd);
+      rowMax = newMax;
+    }
+
+    out.rows(r, rEnd).each_col() /= rowSum;
+    if (logSumExp != NULL)
+    {
+      const ColType rowLogSumExp = shift + log(rowSum);
+      std::copy(rowLogSumExp.begin(), rowLogSumExp.end(), logSumExp + r);
+    }
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::AttentionBackward(
+    const arma::Mat<ElemType>& q,
+    const arma::Mat<ElemType>& k,
+    const arma::Mat<ElemType>& v,
+    const arma::Mat<ElemType>& out,
+    const ElemType* logSumExp,
+    const arma::Mat<ElemType>& dOut,
+    arma::Mat<ElemType>& dQ,
+    arma::Mat<ElemType>& dK,
+    arma::Mat<ElemType>& dV) const
+{
+  const size_t tile = (tileSize == 0) ? std::max(q.n_rows, k.n_rows) :
+      tileSize;
+  const ColType lse(const_cast<ElemType*>(logSumExp), q.n_rows, false, true);
+
+  // The backward pass of the softmax of each query needs the dot product of
+  // its output and the error of its output.
+  const ColType outDot = sum(dOut % out, 1);
+
+  dQ.zeros();
+  dK.zeros();
+  dV.zeros();
+  for (size_t r = 0; r < q.n_rows; r += tile)
+  {
+    const size_t rEnd = std::min(r + tile, (size_t) q.n_rows) - 1;
+    for (size_t c = 0; c < k.n_rows; c += tile)
+    {
+      const size_t cEnd = std::min(c + tile, (size_t) k.n_rows) - 1;
+
+      // Compute the attention of the tile again.
+      arma::Mat<ElemType> attention = q.rows(r, rEnd) *
+          trans(k.rows(c, cEnd));
+      MaskTile(attention, attnMask, keyPaddingMask, r, c);
+      attention.each_col() -= lse.subvec(r, rEnd);
+      attention = exp(attention);
+
+      dV.rows(c, cEnd) += trans(attention) * dOut.rows(r, rEnd);
+
+      // Backpropagate through the softmax.
+      arma::Mat<ElemType> dScores = dOut.rows(r, rEnd) * trans(v.rows(c, cEnd));
+      dScores.each_col() -= outDot.subvec(r, rEnd);
+      dScores %= attention;
+
+      dQ.rows(r, rEnd) += dScores * k.rows(c, cEnd);
+      dK.rows(c, cEnd) += trans(dScores) * q.rows(r, rEnd);
+    }
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::BackwardHeads(
+    const CubeType& dOut,
+    CubeType& dQ,
+    CubeType& dK,
+    CubeType& dV) const
+{
+  const size_t numSlices = dOut.n_slices;
+  dQ.set_size(tgtSeqLen, headDim, numSlices);
+  dK.set_size(srcSeqLen, headDim, numSlices);
+  dV.set_size(srcSeqLen, headDim, numSlices);
+
+  // The attention output of each head, of shape
+  // (tgtSeqLen, headDim, numHeads * batchSize).
+  const CubeType out(const_cast<ElemType*>(attnOut.memptr()), tgtSeqLen,
+      headDim, numSlices, false, true);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < numSlices; ++i)
+  {
+    AttentionBackward(qProj.slice(i), kProj.slice(i), vProj.slice(i),
+        out.slice(i), logSumExp.colptr(i), dOut.slice(i), dQ.slice(i),
+        dK.slice(i), dV.slice(i));
+  }
+}
+
+template <typename MatType, typename RegularizerType>
+void MultiheadAttentionType<MatType, RegularizerType>::MaskTile(
+    arma::Mat<ElemType>& scores,
+    const MatType& mask,
+    const MatType& padding,
+    const size_t queryBegin,
+    const size_t keyBegin)
+{
+  if (!mask.is_empty())
+  {
+    scores += mask.submat(queryBegin, keyBegin,
+        queryBegin + scores.n_rows - 1, keyBegin + scores.n_cols - 1);
+  }
+
+  if (!padding.is_empty())
+    scores.each_row() += padding.cols(keyBegin, keyBegin + scores.n_cols - 1);
+}
+
 template <typename MatType, typename RegularizerType>
 template <typename Archive>
 void MultiheadAttentionType<MatType, RegularizerType>::
-serialize(Archive& ar, const uint32_t /* version */)
+serialize(Archive& ar, const uint32_t version)
 {
   ar(cereal::base_class<Layer<MatType>>(this));
 
@@ -468,7 +677,19 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(numHeads));
   ar(CEREAL_NVP(headDim));
   ar(CEREAL_NVP(selfAttention));
-  ar(CEREAL_NVP(softmax));
+
+  // Older versions held a softmax layer instead of the tile size.
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    SoftmaxType<MatType> softmax;
+    ar(CEREAL_NVP(softmax));
+    tileSize = 64;
+  }
+  else
+  {
+    ar(CEREAL_NVP(tileSize));
+  }
+
   ar(CEREAL_NVP(regularizer));
   ar(CEREAL_NVP(attnMask));
   ar(CEREAL_NVP(keyPaddingMask));
@@ -487,8 +708,9 @@ serialize(Archive& ar, const uint32_t /* version */)
     qProj.clear();
     kProj.clear();
     vProj.clear();
-    scores.clear();
+    logSumExp.clear();
     attnOut.clear();
+    ResetCache();
   }
 }
 
@@ -0,0 +1,166 @@
+/**
+ * @file methods/ann/layer/normalization_kernels.hpp
+ *
+ * Helper functions for the normalization layers: accumulation of the mean and
+ * the variance of a stream of contiguous blocks, and the normalization of a
+ * block with the cached moments.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_NORMALIZATION_KERNELS_HPP
+#define MLPACK_METHODS_ANN_LAYER_NORMALIZATION_KERNELS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Merge a block of `n` contiguous elements into the running moments of a
+ * stream, with the update of Welford generalized to blocks by Chan et al.
+ * The mean and the sum of squared deviations of the block are computed while
+ * the block is in cache, so the stream is only read once, and the result does
+ * not suffer from the cancellation of the sum of squares formula.
+ *
+ * @param x Pointer to the block.
+ * @param n Number of elements of the block.
+ * @param count Number of elements seen so far; `n` is added to it.
+ * @param mean Running mean.
+ * @param m2 Running sum of squared deviations from the mean.
+ */
+template<typename ElemType>
+inline void AccumulateMoments(const ElemType* x,
+                              const size_t n,
+                              size_t& count,
+                              ElemType& mean,
+                              ElemType& m2)
+{
+  if (n == 0)
+    return;
+
+  ElemType blockMean = 0;
+  for (size_t i = 0; i < n; ++i)
+    blockMean += x[i];
+  blockMean /= n;
+
+  ElemType blockM2 = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const ElemType d = x[i] - blockMean;
+    blockM2 += d * d;
+  }
+
+  const size_t total = count + n;
+  const ElemType delta = blockMean - mean;
+  mean += delta * ElemType(n) / ElemType(total);
+  m2 += blockM2 + delta * delta * (ElemType(count) * ElemType(n) /
+      ElemType(total));
+  count = total;
+}
+
+/**
+ * Normalize a block of `n` contiguous elements with the given mean and inverse
+ * standard deviation, then scale and shift it: `y = scale * xhat + shift`.  If
+ * `xhat` is not NULL, the normalized elements are stored in it too.  `y` may be
+ * the same memory as `x`.
+ *
+ * @param x Pointer to the block.
+ * @param n Number of elements of the block.
+ * @param mean Mean to subtract.
+ * @param stdInv Inverse standard deviation to multiply by.
+ * @param scale Factor applied to the normalized elements.
+ * @param shift Offset added to the normalized elements.
+ * @param xhat Pointer to store the normalized elements in (or NULL).
+ * @param y Pointer to store the output in.
+ */
+template<typename ElemType>
+inline void NormalizeBlock(const ElemType* x,
+                           const size_t n,
+                           const ElemType mean,
+                           const ElemType stdInv,
+                           const ElemType scale,
+                           const ElemType shift,
+                           ElemType* xhat,
+                           ElemType* y)
+{
+  if (xhat != NULL)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      const ElemType v = (x[i] - mean) * stdInv;
+      xhat[i] = v;
+      y[i] = scale * v + shift;
+    }
+  }
+  else
+  {
+    // Without the normalized elements, the whole transformation is one fused
+    // multiply-add.
+    const ElemType a = scale * stdInv;
+    const ElemType b = shift - a * mean;
+    for (size_t i = 0; i < n; ++i)
+      y[i] = a * x[i] + b;
+  }
+}
+
+/**
+ * Accumulate the two sums needed by the backward pass of a normalization
+ * layer over a block of `n` contiguous elements: the sum of the errors `dy`,
+ * and the sum of the errors times the normalized input `xhat`.
+ *
+ * @param dy Pointer to the errors of the block.
+ * @param xhat Pointer to the normalized input of the block.
+ * @param n Number of elements of the block.
+ * @param sumDy Sum of the errors.
+ * @param sumDyXhat Sum of the errors times the normalized input.
+ */
+template<typename ElemType>
+inline void AccumulateErrorSums(const ElemType* dy,
+                                const ElemType* xhat,
+                                const size_t n,
+                                ElemType& sumDy,
+                                ElemType& sumDyXhat)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    sumDy += dy[i];
+    sumDyXhat += dy[i] * xhat[i];
+  }
+}
+
+/**
+ * Compute the error of the input of a normalization layer over a block of `n`
+ * contiguous elements, given the means of the two sums of
+ * `AccumulateErrorSums()` (for the errors of the normalized input):
+ *
+ *   g = factor * (dy - meanDy - xhat * meanDyXhat),
+ *
+ * where `factor` is the scale of the normalized input divided by the standard
+ * deviation.
+ *
+ * @param dy Pointer to the errors of the block.
+ * @param xhat Pointer to the normalized input of the block.
+ * @param n Number of elements of the block.
+ * @param meanDy Mean of the errors, over the normalized group.
+ * @param meanDyXhat Mean of the errors times the normalized input.
+ * @param factor Scale divided by the standard deviation.
+ * @param g Pointer to store the error of the input in.
+ */
+template<typename ElemType>
+inline void NormalizationError(const ElemType* dy,
+                               const ElemType* xhat,
+                               const size_t n,
+                               const ElemType meanDy,
+                               const ElemType meanDyXhat,
+                               const ElemType factor,
+                               ElemType* g)
+{
+  for (size_t i = 0; i < n; ++i)
+    g[i] = factor * (dy[i] - meanDy - xhat[i] * meanDyXhat);
+}
+
+} // namespace mlpack
+
+#endif
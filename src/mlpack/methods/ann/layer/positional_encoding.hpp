@@ -1,4 +1,3 @@
-// Temporarily drop.
 /**
  * @file methods/ann/layer/positional_encoding.hpp
  * @author Mrityunjay Tripathi
@@ -15,44 +14,42 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "layer.hpp"
+
 namespace mlpack {
 
 /**
  * Positional Encoding injects some information about the relative or absolute
  * position of the tokens in the sequence.
- *
  * The input and the output have the same shape:
  * `(embedDim * maxSequenceLength, batchSize)`. The embeddings are stored
- * consequently.
+ * consequently, as given by the Lookup layer.
  *
- * @tparam InputType Type of the input data (arma::colvec, arma::mat,
- *         arma::sp_mat or arma::cube).
- * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
- *         arma::sp_mat or arma::cube).
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
  */
-template <
-    typename InputType = arma::mat,
-    typename OutputType = arma::mat
->
-class PositionalEncodingType : public Layer<InputType, OutputType>
+template<typename MatType = arma::mat>
+class PositionalEncodingType : public Layer<MatType>
 {
  public:
-  /**
-   * Create PositionalEncodingType object.
-   */
-  PositionalEncodingType();
-
   /**
    * Create the PositionalEncoding layer object using the specified parameters.
    *
    * @param embedDim The length of the embedding vector.
    * @param maxSequenceLength Number of tokens in each sequence.
    */
-  PositionalEncodingType(const size_t embedDim,
-                         const size_t maxSequenceLength);
+  PositionalEncodingType(const size_t embedDim = 0,
+                         const size_t maxSequenceLength = 0);
+
+  //! Clone the PositionalEncodingType object. This handles polymorphism
+  //! correctly.
+  PositionalEncodingType* Clone() const
+  {
+    return new PositionalEncodingType(*this);
+  }
 
-  //! Clone the PositionalEncodingType object. This handles polymorphism correctly.
-  PositionalEncodingType* Clone() const { return new PositionalEncodingType(*this); }
+  // Virtual destructor.
+  virtual ~PositionalEncodingType() { }
 
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
@@ -61,31 +58,37 @@ class PositionalEncodingType : public Layer<InputType, OutputType>
    * @param input Input data used for evaluating the specified function.
    * @param output Resulting output activation.
    */
-  void Forward(const InputType& input, OutputType& output);
+  void Forward(const MatType& input, MatType& output);
 
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
    * forward pass.
    *
-   * @param * (input) The propagated input activation.
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
    * @param gy The backpropagated error.
    * @param g The calculated gradient.
    */
-  void Backward(const InputType& /* input */,
-                const OutputType& gy,
-                OutputType& g);
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g);
 
   //! Get the positional encoding vector.
-  InputType const& Encoding() const { return positionalEncoding; }
+  const MatType& Encoding() const { return positionalEncoding; }
 
-  size_t InputShape() const
-  {
-    return embedDim * maxSequenceLength;
-  }
+  //! Get the length of the embedding vector.
+  size_t EmbedDim() const { return embedDim; }
+
+  //! Get the number of tokens in each sequence.
+  size_t MaxSequenceLength() const { return maxSequenceLength; }
+
+  //! Compute the output dimensions of the layer using `InputDimensions()`.
+  void ComputeOutputDimensions();
 
   /**
-   * Serialize the layer
+   * Serialize the layer.
    */
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -99,15 +102,15 @@ class PositionalEncodingType : public Layer<InputType, OutputType>
   //! Locally-stored embedding dimension.
   size_t embedDim;
 
-  //! Locally-stored maximum sequence length that has to be encoded.
+  //! Locally-stored number of tokens in each sequence.
   size_t maxSequenceLength;
 
   //! Locally-stored positional encodings.
-  InputType positionalEncoding;
-}; // class PositionalEncodingTest
+  MatType positionalEncoding;
+}; // class PositionalEncodingType
 
 // Standard PositionalEncoding layer.
-typedef PositionalEncodingType<arma::mat, arma::mat> PositionalEncoding;
+typedef PositionalEncodingType<arma::mat> PositionalEncoding;
 
 } // namespace mlpack
 
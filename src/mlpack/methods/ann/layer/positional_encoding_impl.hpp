@@ -0,0 +1,102 @@
+/**
+ * @file methods/ann/layer/positional_encoding_impl.hpp
+ * @author Mrityunjay Tripathi
+ *
+ * Implementation of the Positional Encoding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_POSITIONAL_ENCODING_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_POSITIONAL_ENCODING_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "positional_encoding.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+PositionalEncodingType<MatType>::PositionalEncodingType(
+    const size_t embedDim,
+    const size_t maxSequenceLength) :
+    Layer<MatType>(),
+    embedDim(embedDim),
+    maxSequenceLength(maxSequenceLength)
+{
+  InitPositionalEncoding();
+}
+
+template<typename MatType>
+void PositionalEncodingType<MatType>::InitPositionalEncoding()
+{
+  using ElemType = typename MatType::elem_type;
+
+  // Row i of each position holds sin(pos / 10000^(i / embedDim)) for even i,
+  // and cos(pos / 10000^((i - 1) / embedDim)) for odd i.
+  MatType encoding(embedDim, maxSequenceLength);
+  for (size_t pos = 0; pos < maxSequenceLength; ++pos)
+  {
+    for (size_t i = 0; i < embedDim; ++i)
+    {
+      const size_t even = i - (i % 2);
+      const ElemType theta = ElemType(pos) * std::exp(ElemType(even) *
+          (-std::log(ElemType(10000)) / ElemType(embedDim)));
+      encoding(i, pos) = (i % 2 == 0) ? std::sin(theta) : std::cos(theta);
+    }
+  }
+
+  positionalEncoding = vectorise(encoding);
+}
+
+template<typename MatType>
+void PositionalEncodingType<MatType>::ComputeOutputDimensions()
+{
+  const size_t inSize = std::accumulate(this->inputDimensions.begin(),
+      this->inputDimensions.end(), 1, std::multiplies<size_t>());
+  if (inSize != embedDim * maxSequenceLength)
+  {
+    throw std::invalid_argument("PositionalEncodingType::"
+        "ComputeOutputDimensions(): input size (" + std::to_string(inSize) +
+        ") must be embedDim * maxSequenceLength (" +
+        std::to_string(embedDim * maxSequenceLength) + ")!");
+  }
+
+  this->outputDimensions = this->inputDimensions;
+}
+
+template<typename MatType>
+void PositionalEncodingType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  output = input.each_col() + positionalEncoding;
+}
+
+template<typename MatType>
+void PositionalEncodingType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  g = gy;
+}
+
+template<typename MatType>
+template<typename Archive>
+void PositionalEncodingType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(embedDim));
+  ar(CEREAL_NVP(maxSequenceLength));
+
+  if (cereal::is_loading<Archive>())
+    InitPositionalEncoding();
+}
+
+} // namespace mlpack
+
+#endif
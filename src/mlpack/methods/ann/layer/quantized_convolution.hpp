@@ -0,0 +1,172 @@
+/**
+ * @file methods/ann/layer/quantized_convolution.hpp
+ *
+ * Definition of the QuantizedConvolution layer class, an inference-only
+ * convolution layer that uses int8 weights and activations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+
+#include "layer.hpp"
+#include "convolution.hpp"
+#include "padding.hpp"
+#include "quantized_gemm.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantizedConvolution layer computes the same transformation as a trained
+ * Convolution layer, but with the filters stored as int8 values with one scale
+ * per output map, and the input quantized to int8 with a single scale found on
+ * calibration data.  The input patches are gathered with
+ * `Im2ColConvolution::Im2Col()`, and the convolution of all the patches of the
+ * batch with all the filters is computed as one int8 matrix product with int32
+ * accumulation, which is then scaled back; the bias stays in floating point.
+ *
+ * The layer has no trainable parameters and cannot be trained; it is meant to
+ * be created by `Quantize()` from a trained network.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedConvolutionType : public Layer<MatType>
+{
+ public:
+  //! Create an empty QuantizedConvolution object (for serialization).
+  QuantizedConvolutionType();
+
+  /**
+   * Quantize the given trained Convolution layer.  The output dimensions of
+   * the layer must already be computed.
+   *
+   * @param layer Trained Convolution layer.
+   * @param inputScale Scale used to quantize the input of the layer, usually
+   *     found with QuantizationScale() on calibration data.
+   */
+  template<typename ForwardConvolutionRule,
+           typename BackwardConvolutionRule,
+           typename GradientConvolutionRule>
+  QuantizedConvolutionType(const ConvolutionType<ForwardConvolutionRule,
+                                                 BackwardConvolutionRule,
+                                                 GradientConvolutionRule,
+                                                 MatType>& layer,
+                           const double inputScale);
+
+  virtual ~QuantizedConvolutionType() { }
+
+  //! Clone the QuantizedConvolutionType object. This handles polymorphism
+  //! correctly.
+  QuantizedConvolutionType* Clone() const
+  {
+    return new QuantizedConvolutionType(*this);
+  }
+
+  /**
+   * Forward pass: quantize the input patches, multiply them with the quantized
+   * filters, and add the bias.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The backward pass is not available, since the layer cannot be trained;
+   * this throws an exception.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the quantized filters (one column per output map).
+  const arma::Mat<arma::s8>& Weight() const { return weight; }
+  //! Get the scale of the filters of each output map.
+  const MatType& WeightScales() const { return weightScales; }
+  //! Get the bias (empty if the layer has no bias).
+  const MatType& Bias() const { return bias; }
+  //! Get the scale used to quantize the input.
+  double InputScale() const { return inputScale; }
+
+  //! Get the number of output maps.
+  size_t Maps() const { return maps; }
+  //! Get the kernel width.
+  size_t KernelWidth() const { return kernelWidth; }
+  //! Get the kernel height.
+  size_t KernelHeight() const { return kernelHeight; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of output maps.
+  size_t maps;
+  //! Locally-stored filter width.
+  size_t kernelWidth;
+  //! Locally-stored filter height.
+  size_t kernelHeight;
+  //! Locally-stored stride of the filter in x-direction.
+  size_t strideWidth;
+  //! Locally-stored stride of the filter in y-direction.
+  size_t strideHeight;
+  //! Locally-stored left-side padding width.
+  size_t padWLeft;
+  //! Locally-stored right-side padding width.
+  size_t padWRight;
+  //! Locally-stored top-side padding height.
+  size_t padHTop;
+  //! Locally-stored bottom-side padding height.
+  size_t padHBottom;
+
+  //! The quantized filters; column m holds the filters of output map m for all
+  //! the input maps, in the order of the rows of the Im2Col() matrix.
+  arma::Mat<arma::s8> weight;
+
+  //! The combined scale (weight scale times input scale) of each output map.
+  MatType outputScales;
+
+  //! The scale of the filters of each output map.
+  MatType weightScales;
+
+  //! The bias of each output map (empty if the layer has no bias).
+  MatType bias;
+
+  //! The scale used to quantize the input.
+  double inputScale;
+
+  //! Locally-stored padding layer.
+  PaddingType<MatType> padding;
+
+  //! Locally-cached number of input maps.
+  size_t inMaps;
+  //! Locally-cached higher-order input dimensions.
+  size_t higherInDimensions;
+
+  //! Locally-stored padded input.
+  MatType inputPadded;
+  //! Locally-stored quantized input patches.
+  arma::Mat<arma::s8> quantizedColumns;
+}; // class QuantizedConvolutionType
+
+// Standard QuantizedConvolution layer.
+typedef QuantizedConvolutionType<arma::mat> QuantizedConvolution;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_convolution_impl.hpp"
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file methods/ann/layer/quantized_convolution_impl.hpp
+ *
+ * Implementation of the QuantizedConvolution layer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_CONVOLUTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_convolution.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedConvolutionType<MatType>::QuantizedConvolutionType() :
+    Layer<MatType>(),
+    maps(0),
+    kernelWidth(0),
+    kernelHeight(0),
+    strideWidth(1),
+    strideHeight(1),
+    padWLeft(0),
+    padWRight(0),
+    padHTop(0),
+    padHBottom(0),
+    inputScale(1.0),
+    inMaps(0),
+    higherInDimensions(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename ForwardConvolutionRule,
+         typename BackwardConvolutionRule,
+         typename GradientConvolutionRule>
+QuantizedConvolutionType<MatType>::QuantizedConvolutionType(
+    const ConvolutionType<ForwardConvolutionRule,
+                          BackwardConvolutionRule,
+                          GradientConvolutionRule,
+                          MatType>& layer,
+    const double inputScale) :
+    Layer<MatType>(layer),
+    maps(layer.Maps()),
+    kernelWidth(layer.KernelWidth()),
+    kernelHeight(layer.KernelHeight()),
+    strideWidth(layer.StrideWidth()),
+    strideHeight(layer.StrideHeight()),
+    padWLeft(layer.PadWLeft()),
+    padWRight(layer.PadWRight()),
+    padHTop(layer.PadHTop()),
+    padHBottom(layer.PadHBottom()),
+    bias(layer.Bias()),
+    inputScale(inputScale),
+    inMaps(0),
+    higherInDimensions(0)
+{
+  // The filters of each output map are stored next to each other in the weight
+  // cube, in the same order as the rows of the Im2Col() matrix.
+  const size_t patchSize = layer.Weight().n_elem / maps;
+  MatType weightMat(layer.Weight().memptr(), patchSize, maps);
+
+  weightScales.set_size(maps, 1);
+  for (size_t i = 0; i < maps; ++i)
+    weightScales[i] = QuantizationScale(max(abs(weightMat.col(i))));
+
+  weightMat.each_row() /= weightScales.t();
+  QuantizeSymmetric(weightMat, 1.0, weight);
+
+  outputScales = weightScales * inputScale;
+
+  // Set up the padding and the cached sizes, if the dimensions are known.
+  if (!this->inputDimensions.empty())
+    ComputeOutputDimensions();
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  using CubeType = arma::Cube<typename MatType::elem_type>;
+
+  const size_t batchSize = input.n_cols;
+  const size_t numImages = higherInDimensions * batchSize;
+  const size_t outputSize = this->outputDimensions[0] *
+      this->outputDimensions[1];
+
+  // First, perform any padding if necessary.
+  const bool usingPadding =
+      (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
+  const size_t paddedRows = this->inputDimensions[0] + padWLeft + padWRight;
+  const size_t paddedCols = this->inputDimensions[1] + padHTop + padHBottom;
+  if (usingPadding)
+  {
+    inputPadded.set_size(paddedRows * paddedCols * inMaps * higherInDimensions,
+        batchSize);
+    padding.Forward(input, inputPadded);
+  }
+
+  CubeType inputTemp;
+  MakeAlias(inputTemp, (usingPadding ? inputPadded : input), paddedRows,
+      paddedCols, inMaps * numImages);
+
+  // Gather and quantize the patches, and apply all the filters to all of them.
+  MatType columns;
+  Im2ColConvolution<ValidConvolution>::Im2Col(inputTemp, inMaps, kernelWidth,
+      kernelHeight, this->outputDimensions[0], this->outputDimensions[1],
+      strideWidth, strideHeight, 1, 1, columns);
+  QuantizeSymmetric(columns, inputScale, quantizedColumns);
+  columns.clear();
+
+  MatType result;
+  QuantizedGemm(weight, quantizedColumns, outputScales, bias, result);
+
+  // Column n * outputSize + p of the result holds the output of every map at
+  // position p of point n; move the outputs of each map next to each other.
+  MatType outputMat;
+  MakeAlias(outputMat, output, outputSize, maps * numImages);
+  #pragma omp parallel for
+  for (size_t n = 0; n < numImages; ++n)
+  {
+    outputMat.cols(n * maps, (n + 1) * maps - 1) =
+        result.cols(n * outputSize, (n + 1) * outputSize - 1).t();
+  }
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("QuantizedConvolution::Backward(): quantized layers "
+      "cannot be trained!");
+}
+
+template<typename MatType>
+void QuantizedConvolutionType<MatType>::ComputeOutputDimensions()
+{
+  padding = PaddingType<MatType>(padWLeft, padWRight, padHTop, padHBottom);
+  padding.InputDimensions() = this->inputDimensions;
+  padding.ComputeOutputDimensions();
+
+  inMaps = (this->inputDimensions.size() >= 3) ? this->inputDimensions[2] : 1;
+  if (inMaps * kernelWidth * kernelHeight != weight.n_rows)
+  {
+    throw std::invalid_argument("QuantizedConvolution::"
+        "ComputeOutputDimensions(): number of input maps does not match the "
+        "size of the quantized filters!");
+  }
+
+  // The output has at least 3 dimensions, since we will be adding some number
+  // of maps to the output.
+  this->outputDimensions = std::vector<size_t>(
+      std::max(this->inputDimensions.size(), size_t(3)), 1);
+  this->outputDimensions[0] = (this->inputDimensions[0] + padWLeft +
+      padWRight - kernelWidth) / strideWidth + 1;
+  this->outputDimensions[1] = (this->inputDimensions[1] + padHTop +
+      padHBottom - kernelHeight) / strideHeight + 1;
+
+  higherInDimensions = 1;
+  for (size_t i = 3; i < this->inputDimensions.size(); ++i)
+  {
+    higherInDimensions *= this->inputDimensions[i];
+    this->outputDimensions[i] = this->inputDimensions[i];
+  }
+
+  this->outputDimensions[2] = maps;
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedConvolutionType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(maps));
+  ar(CEREAL_NVP(kernelWidth));
+  ar(CEREAL_NVP(kernelHeight));
+  ar(CEREAL_NVP(strideWidth));
+  ar(CEREAL_NVP(strideHeight));
+  ar(CEREAL_NVP(padWLeft));
+  ar(CEREAL_NVP(padWRight));
+  ar(CEREAL_NVP(padHTop));
+  ar(CEREAL_NVP(padHBottom));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(weightScales));
+  ar(CEREAL_NVP(bias));
+  ar(CEREAL_NVP(inputScale));
+
+  if (cereal::is_loading<Archive>())
+    outputScales = weightScales * inputScale;
+}
+
+} // namespace mlpack
+
+#endif
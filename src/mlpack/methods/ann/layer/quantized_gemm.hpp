@@ -0,0 +1,100 @@
+/**
+ * @file methods/ann/layer/quantized_gemm.hpp
+ *
+ * Helper functions for the int8 quantized layers: symmetric quantization of a
+ * matrix, and a matrix product of int8 matrices with int32 accumulation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_GEMM_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_GEMM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Compute the scale to use to quantize values whose largest absolute value is
+ * `maxAbs` to the symmetric int8 range [-127, 127].
+ *
+ * @param maxAbs Largest absolute value to represent.
+ */
+inline double QuantizationScale(const double maxAbs)
+{
+  // A range of all zeros can be represented with any scale.
+  return (maxAbs > 0.0) ? maxAbs / 127.0 : 1.0;
+}
+
+/**
+ * Quantize each element of the given matrix to int8 with the given scale:
+ * `output = round(input / scale)`, clamped to [-127, 127].
+ *
+ * @param input Matrix to quantize.
+ * @param scale Quantization scale.
+ * @param output Will be set to the quantized matrix.
+ */
+template<typename MatType>
+void QuantizeSymmetric(const MatType& input,
+                       const double scale,
+                       arma::Mat<arma::s8>& output)
+{
+  output.set_size(input.n_rows, input.n_cols);
+  const typename MatType::elem_type invScale = 1.0 / scale;
+  const typename MatType::elem_type* in = input.memptr();
+  arma::s8* out = output.memptr();
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) input.n_elem; ++i)
+  {
+    const typename MatType::elem_type value = std::round(in[i] * invScale);
+    out[i] = (arma::s8) std::min(std::max(value,
+        (typename MatType::elem_type) -127), (typename MatType::elem_type) 127);
+  }
+}
+
+/**
+ * Compute `output(i, j) = scales[i] * dot(a.col(i), b.col(j)) + bias[i]`, where
+ * the dot product of the int8 columns is accumulated in int32.  Both operands
+ * store one vector per column, so that each dot product reads contiguous
+ * memory; the inner loop is simple enough for the compiler to vectorize it
+ * with the int8 dot product instructions of the target (e.g. AVX-512 VNNI)
+ * when they are enabled.
+ *
+ * @param a First operand, with one vector of length k per output row.
+ * @param b Second operand, with one vector of length k per output column.
+ * @param scales Scale of each output row.
+ * @param bias Offset of each output row; if empty, no offset is added.
+ * @param output Will be set to the result (a.n_cols x b.n_cols).
+ */
+template<typename MatType>
+void QuantizedGemm(const arma::Mat<arma::s8>& a,
+                   const arma::Mat<arma::s8>& b,
+                   const MatType& scales,
+                   const MatType& bias,
+                   MatType& output)
+{
+  const size_t k = a.n_rows;
+  output.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < (size_t) b.n_cols; ++j)
+  {
+    const arma::s8* bCol = b.colptr(j);
+    for (size_t i = 0; i < (size_t) a.n_cols; ++i)
+    {
+      const arma::s8* aCol = a.colptr(i);
+      int32_t sum = 0;
+      for (size_t l = 0; l < k; ++l)
+        sum += (int32_t) aCol[l] * (int32_t) bCol[l];
+
+      output(i, j) = scales[i] * sum + (bias.is_empty() ? 0 : bias[i]);
+    }
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file methods/ann/layer/quantized_linear.hpp
+ *
+ * Definition of the QuantizedLinear layer class, an inference-only linear layer
+ * that uses int8 weights and activations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+#include "linear.hpp"
+#include "quantized_gemm.hpp"
+
+namespace mlpack {
+
+/**
+ * The QuantizedLinear layer computes the same transformation as a trained
+ * Linear layer, y = Ax + b, but with the weights A stored as int8 values with
+ * one scale per output unit, and the input quantized to int8 with a single
+ * scale found on calibration data.  The product is accumulated in int32 and
+ * then scaled back; the bias stays in floating point.  Compared to the Linear
+ * layer, the weights take 8 times less memory (for `arma::mat`).
+ *
+ * The layer has no trainable parameters and cannot be trained; it is meant to
+ * be created by `Quantize()` from a trained network.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class QuantizedLinearType : public Layer<MatType>
+{
+ public:
+  //! Create an empty QuantizedLinear object (for serialization).
+  QuantizedLinearType();
+
+  /**
+   * Quantize the given trained Linear layer.
+   *
+   * @param layer Trained Linear layer.
+   * @param inputScale Scale used to quantize the input of the layer, usually
+   *     found with QuantizationScale() on calibration data.
+   */
+  template<typename RegularizerType>
+  QuantizedLinearType(const LinearType<MatType, RegularizerType>& layer,
+                      const double inputScale);
+
+  virtual ~QuantizedLinearType() { }
+
+  //! Clone the QuantizedLinearType object. This handles polymorphism correctly.
+  QuantizedLinearType* Clone() const { return new QuantizedLinearType(*this); }
+
+  /**
+   * Forward pass: quantize the input, multiply it with the quantized weights,
+   * and add the bias.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The backward pass is not available, since the layer cannot be trained;
+   * this throws an exception.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the quantized weights (one column per output unit).
+  const arma::Mat<arma::s8>& Weight() const { return weight; }
+  //! Get the scale of the weights of each output unit.
+  const MatType& WeightScales() const { return weightScales; }
+  //! Get the bias.
+  const MatType& Bias() const { return bias; }
+  //! Get the scale used to quantize the input.
+  double InputScale() const { return inputScale; }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The quantized weights, with one column per output unit.
+  arma::Mat<arma::s8> weight;
+
+  //! The combined scale (weight scale times input scale) of each output unit.
+  MatType outputScales;
+
+  //! The scale of the weights of each output unit.
+  MatType weightScales;
+
+  //! The bias of each output unit.
+  MatType bias;
+
+  //! The scale used to quantize the input.
+  double inputScale;
+
+  //! Locally-stored quantized input.
+  arma::Mat<arma::s8> quantizedInput;
+}; // class QuantizedLinearType
+
+// Standard QuantizedLinear layer.
+typedef QuantizedLinearType<arma::mat> QuantizedLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_linear_impl.hpp"
+
+#endif
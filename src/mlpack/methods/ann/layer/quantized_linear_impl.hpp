@@ -0,0 +1,112 @@
+/**
+ * @file methods/ann/layer/quantized_linear_impl.hpp
+ *
+ * Implementation of the QuantizedLinear layer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_QUANTIZED_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "quantized_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+QuantizedLinearType<MatType>::QuantizedLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0),
+    inputScale(1.0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename RegularizerType>
+QuantizedLinearType<MatType>::QuantizedLinearType(
+    const LinearType<MatType, RegularizerType>& layer,
+    const double inputScale) :
+    Layer<MatType>(layer),
+    inSize(layer.Weight().n_cols),
+    outSize(layer.Weight().n_rows),
+    bias(layer.Bias()),
+    inputScale(inputScale)
+{
+  // Quantize each output unit's weights with its own scale, and store them as
+  // columns so that the product reads contiguous memory.
+  MatType weightT = layer.Weight().t();
+  weightScales.set_size(outSize, 1);
+  for (size_t i = 0; i < outSize; ++i)
+    weightScales[i] = QuantizationScale(max(abs(weightT.col(i))));
+
+  weightT.each_row() /= weightScales.t();
+  QuantizeSymmetric(weightT, 1.0, weight);
+
+  outputScales = weightScales * inputScale;
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  QuantizeSymmetric(input, inputScale, quantizedInput);
+  QuantizedGemm(weight, quantizedInput, outputScales, bias, output);
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("QuantizedLinear::Backward(): quantized layers "
+      "cannot be trained!");
+}
+
+template<typename MatType>
+void QuantizedLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t totalInSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInSize *= this->inputDimensions[i];
+
+  if (totalInSize != inSize)
+  {
+    throw std::invalid_argument("QuantizedLinear::ComputeOutputDimensions(): "
+        "input size does not match the size of the quantized layer!");
+  }
+
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+
+  // The QuantizedLinear layer flattens its input.
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void QuantizedLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(weightScales));
+  ar(CEREAL_NVP(bias));
+  ar(CEREAL_NVP(inputScale));
+
+  if (cereal::is_loading<Archive>())
+    outputScales = weightScales * inputScale;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file methods/ann/layer/sparse_linear.hpp
+ *
+ * Definition of the SparseLinear layer class, an inference-only linear layer
+ * that stores the weights of a pruned Linear layer in sparse form.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer.hpp"
+#include "linear.hpp"
+
+namespace mlpack {
+
+/**
+ * The SparseLinear layer computes the same transformation as a Linear layer,
+ * y = Ax + b, after the weights A of a trained Linear layer have been pruned.
+ * Two pruning methods are available:
+ *
+ *  - magnitude pruning removes the given fraction of the weights with the
+ *    smallest absolute values;
+ *
+ *  - structured pruning removes the given fraction of the output units whose
+ *    weights have the smallest L2 norm; the output of a removed unit is its
+ *    bias.
+ *
+ * The remaining weights are stored in compressed sparse column form
+ * (`arma::SpMat`), so that the memory and the work of the forward pass only
+ * grow with the number of remaining weights.  The forward pass computes each
+ * column of the batch independently (in parallel with OpenMP): every nonzero
+ * input element adds its column of A to the output, so inputs that are zero
+ * (e.g. after a ReLU) cost nothing either.
+ *
+ * The layer has no trainable parameters and cannot be trained; it is meant to
+ * be created by `FFN::Prune()` from a trained network.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class SparseLinearType : public Layer<MatType>
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Create an empty SparseLinear object (for serialization).
+  SparseLinearType();
+
+  /**
+   * Prune the given trained Linear layer.
+   *
+   * @param layer Trained Linear layer.
+   * @param sparsity Fraction of the weights (or of the output units, if
+   *     structured is true) to remove, in [0, 1].
+   * @param structured If true, whole output units are removed; otherwise,
+   *     individual weights are removed.
+   */
+  template<typename RegularizerType>
+  SparseLinearType(const LinearType<MatType, RegularizerType>& layer,
+                   const double sparsity,
+                   const bool structured = false);
+
+  virtual ~SparseLinearType() { }
+
+  //! Clone the SparseLinearType object. This handles polymorphism correctly.
+  SparseLinearType* Clone() const { return new SparseLinearType(*this); }
+
+  /**
+   * Forward pass: multiply the input with the sparse weights, and add the
+   * bias.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * The backward pass is not available, since the layer cannot be trained;
+   * this throws an exception.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& /* gy */,
+                MatType& /* g */);
+
+  //! Get the sparse weights (outSize x inSize).
+  const arma::SpMat<ElemType>& Weight() const { return weight; }
+  //! Get the bias.
+  const MatType& Bias() const { return bias; }
+
+  //! Get the fraction of the weights that are zero.
+  double Sparsity() const
+  {
+    return (weight.n_elem == 0) ? 0.0 :
+        1.0 - ((double) weight.n_nonzero / (double) weight.n_elem);
+  }
+
+  //! Compute the output dimensions of the layer given `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  //! Serialize the layer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! The remaining weights, in compressed sparse column form.
+  arma::SpMat<ElemType> weight;
+
+  //! The bias of each output unit.
+  MatType bias;
+}; // class SparseLinearType
+
+// Standard SparseLinear layer.
+typedef SparseLinearType<arma::mat> SparseLinear;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_linear_impl.hpp"
+
+#endif
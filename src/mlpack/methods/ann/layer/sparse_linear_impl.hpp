@@ -0,0 +1,150 @@
+/**
+ * @file methods/ann/layer/sparse_linear_impl.hpp
+ *
+ * Implementation of the SparseLinear layer class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sparse_linear.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+SparseLinearType<MatType>::SparseLinearType() :
+    Layer<MatType>(),
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+template<typename RegularizerType>
+SparseLinearType<MatType>::SparseLinearType(
+    const LinearType<MatType, RegularizerType>& layer,
+    const double sparsity,
+    const bool structured) :
+    Layer<MatType>(layer),
+    inSize(layer.Weight().n_cols),
+    outSize(layer.Weight().n_rows),
+    bias(layer.Bias())
+{
+  if (sparsity < 0.0 || sparsity > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "SparseLinear::SparseLinear(): sparsity must be in [0, 1], but "
+        << sparsity << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Mat<ElemType> pruned(layer.Weight());
+  if (structured)
+  {
+    // Remove the output units with the smallest weight norms.
+    const size_t numPruned = (size_t) std::round(sparsity * outSize);
+    const arma::Col<ElemType> norms = sqrt(sum(square(pruned), 1));
+    const arma::uvec order = sort_index(norms);
+    for (size_t i = 0; i < numPruned; ++i)
+      pruned.row(order[i]).zeros();
+  }
+  else
+  {
+    // Remove the weights with the smallest magnitudes.
+    const size_t numPruned = (size_t) std::round(sparsity * pruned.n_elem);
+    const arma::uvec order = sort_index(vectorise(abs(pruned)));
+    for (size_t i = 0; i < numPruned; ++i)
+      pruned[order[i]] = 0;
+  }
+
+  weight = arma::SpMat<ElemType>(pruned);
+  weight.sync();
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  output.set_size(outSize, input.n_cols);
+
+  const arma::uword* colPtrs = weight.col_ptrs;
+  const arma::uword* rowIndices = weight.row_indices;
+  const ElemType* values = weight.values;
+
+  #pragma omp parallel for
+  for (size_t j = 0; j < (size_t) input.n_cols; ++j)
+  {
+    const ElemType* in = input.colptr(j);
+    ElemType* out = output.colptr(j);
+    for (size_t i = 0; i < outSize; ++i)
+      out[i] = bias[i];
+
+    // Add the column of the weights of each nonzero input element.
+    for (size_t k = 0; k < inSize; ++k)
+    {
+      const ElemType x = in[k];
+      if (x == 0)
+        continue;
+
+      for (size_t l = colPtrs[k]; l < colPtrs[k + 1]; ++l)
+        out[rowIndices[l]] += values[l] * x;
+    }
+  }
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& /* gy */,
+    MatType& /* g */)
+{
+  throw std::logic_error("SparseLinear::Backward(): pruned layers cannot be "
+      "trained!");
+}
+
+template<typename MatType>
+void SparseLinearType<MatType>::ComputeOutputDimensions()
+{
+  size_t totalInSize = this->inputDimensions[0];
+  for (size_t i = 1; i < this->inputDimensions.size(); ++i)
+    totalInSize *= this->inputDimensions[i];
+
+  if (totalInSize != inSize)
+  {
+    throw std::invalid_argument("SparseLinear::ComputeOutputDimensions(): "
+        "input size does not match the size of the pruned layer!");
+  }
+
+  this->outputDimensions = std::vector<size_t>(this->inputDimensions.size(),
+      1);
+
+  // The SparseLinear layer flattens its input.
+  this->outputDimensions[0] = outSize;
+}
+
+template<typename MatType>
+template<typename Archive>
+void SparseLinearType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(bias));
+
+  if (cereal::is_loading<Archive>())
+    weight.sync();
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @file methods/ann/layer/transposed_convolution.hpp
+ * @author Shikhar Jaiswal
+ * @author Marcus Edel
+ *
+ * Definition of the Transposed Convolution module class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_TRANSPOSED_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_LAYER_TRANSPOSED_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/core/util/to_lower.hpp>
+
+#include "layer.hpp"
+
+namespace mlpack {
+
+/**
+ * Implementation of the Transposed Convolution class.  The Transposed
+ * Convolution class represents a single layer of a neural network, whose
+ * forward pass is the backward pass of the Convolution layer with the same
+ * kernel, stride and padding: each input element scatters its product with the
+ * filters into the output, so that for a stride of 2 (for instance), the
+ * output is about twice as large as the input.  The width of the output is
+ *
+ *   (inputWidth - 1) * strideWidth + kernelWidth - padWLeft - padWRight,
+ *
+ * and likewise for the height.  With "same" padding, the output is exactly
+ * `strideWidth` times as wide as the input.
+ *
+ * Each pass is computed for the whole batch with a single matrix
+ * multiplication, as by Im2ColConvolution: the forward pass multiplies the
+ * filters by the input and folds the result into the output with Col2Im(),
+ * and the backward and gradient passes unfold the error with Im2Col().
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class TransposedConvolutionType : public Layer<MatType>
+{
+ public:
+  typedef typename GetCubeType<MatType>::type CubeType;
+
+  //! Create the TransposedConvolutionType object.
+  TransposedConvolutionType();
+
+  /**
+   * Create the TransposedConvolutionType object using the specified number of
+   * output maps, filter size, stride and padding parameter.  The stride and
+   * the padding are those of the associated convolution: the stride is the
+   * upsampling factor, and the padding is removed from the border of the
+   * output.
+   *
+   * @param maps The number of output maps.
+   * @param kernelWidth Width of the filter/kernel.
+   * @param kernelHeight Height of the filter/kernel.
+   * @param strideWidth Stride of filter application in the x direction.
+   * @param strideHeight Stride of filter application in the y direction.
+   * @param padW Padding width of the output.
+   * @param padH Padding height of the output.
+   * @param paddingType The type of padding ("valid" or "same"). Defaults to
+   *    "none".  If not specified or "none", the values for `padW` and `padH`
+   *    will be used.
+   * @param useBias Whether or not to use a bias with the convolution.
+   */
+  TransposedConvolutionType(const size_t maps,
+                            const size_t kernelWidth,
+                            const size_t kernelHeight,
+                            const size_t strideWidth = 1,
+                            const size_t strideHeight = 1,
+                            const size_t padW = 0,
+                            const size_t padH = 0,
+                            const std::string& paddingType = "none",
+                            const bool useBias = true);
+
+  /**
+   * Create the TransposedConvolutionType object using the specified number of
+   * output maps, filter size, stride and padding parameter.
+   *
+   * @param maps The number of output maps.
+   * @param kernelWidth Width of the filter/kernel.
+   * @param kernelHeight Height of the filter/kernel.
+   * @param strideWidth Stride of filter application in the x direction.
+   * @param strideHeight Stride of filter application in the y direction.
+   * @param padW A two-value tuple indicating padding widths of the output.  The
+   *      first value is the padding for the left side; the second value is the
+   *      padding on the right side.
+   * @param padH A two-value tuple indicating padding heights of the output.
+   *      The first value is the padding for the top; the second value is the
+   *      padding on the bottom.
+   * @param paddingType The type of padding ("valid" or "same"). Defaults to
+   *      "none".  If not specified or "none", the values for `padW` and `padH`
+   *      will be used.
+   * @param useBias Whether or not to use a bias with the convolution.
+   */
+  TransposedConvolutionType(const size_t maps,
+                            const size_t kernelWidth,
+                            const size_t kernelHeight,
+                            const size_t strideWidth,
+                            const size_t strideHeight,
+                            const std::tuple<size_t, size_t>& padW,
+                            const std::tuple<size_t, size_t>& padH,
+                            const std::string& paddingType = "none",
+                            const bool useBias = true);
+
+  //! Clone the TransposedConvolutionType object. This handles polymorphism
+  //! correctly.
+  TransposedConvolutionType* Clone() const
+  {
+    return new TransposedConvolutionType(*this);
+  }
+
+  // Virtual destructor.
+  virtual ~TransposedConvolutionType() { }
+
+  /*
+   * Set the weight and bias term.
+   */
+  void SetWeights(const MatType& weightsIn);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  void Forward(const MatType& input, MatType& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards through f. Using the results from the feed
+   * forward pass.
+   *
+   * @param input The input data (x) given to the forward pass.
+   * @param output The propagated data (f(x)) resulting from Forward()
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  void Backward(const MatType& /* input */,
+                const MatType& /* output */,
+                const MatType& gy,
+                MatType& g);
+
+  /**
+   * Calculate the gradient using the output delta and the input activation.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  void Gradient(const MatType& input,
+                const MatType& error,
+                MatType& gradient);
+
+  //! Get the parameters.
+  MatType const& Parameters() const { return weights; }
+  //! Modify the parameters.
+  MatType& Parameters() { return weights; }
+
+  //! Get the weight of the layer as a cube.
+  CubeType const& Weight() const { return weight; }
+  //! Modify the weight of the layer as a cube.
+  CubeType& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  MatType const& Bias() const { return bias; }
+  //! Modify the bias of the layer.
+  MatType& Bias() { return bias; }
+
+  //! Get the number of output maps.
+  size_t const& Maps() const { return maps; }
+
+  //! Get the kernel width.
+  size_t const& KernelWidth() const { return kernelWidth; }
+  //! Get the kernel height.
+  size_t const& KernelHeight() const { return kernelHeight; }
+
+  //! Get the stride width.
+  size_t const& StrideWidth() const { return strideWidth; }
+  //! Get the stride height.
+  size_t const& StrideHeight() const { return strideHeight; }
+
+  //! Get the top padding height.
+  size_t const& PadHTop() const { return padHTop; }
+  //! Get the bottom padding height.
+  size_t const& PadHBottom() const { return padHBottom; }
+  //! Get the left padding width.
+  size_t const& PadWLeft() const { return padWLeft; }
+  //! Get the right padding width.
+  size_t const& PadWRight() const { return padWRight; }
+
+  //! Get size of weights for the layer.
+  size_t WeightSize() const
+  {
+    return (maps * inMaps * kernelWidth * kernelHeight) +
+        (useBias ? maps : 0);
+  }
+
+  //! Compute the output dimensions of the layer based on `InputDimensions()`.
+  void ComputeOutputDimensions();
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Rearrange the input so that row n * inputSize + p holds every input map at
+   * position p of point n.
+   *
+   * @param input The input of the layer.
+   * @param inputRows The rearranged input.
+   */
+  void InputRows(const MatType& input, MatType& inputRows) const;
+
+  /**
+   * Unfold the patches of the error of the output (with the padding added
+   * back) that each input position contributed to.
+   *
+   * @param error The error of the output.
+   * @param columns Matrix to store the patches in.
+   */
+  void ErrorColumns(const MatType& error, MatType& columns) const;
+
+  //! Locally-stored number of output channels.
+  size_t maps;
+
+  //! Locally-stored filter/kernel width.
+  size_t kernelWidth;
+
+  //! Locally-stored filter/kernel height.
+  size_t kernelHeight;
+
+  //! Locally-stored stride of the filter in x-direction.
+  size_t strideWidth;
+
+  //! Locally-stored stride of the filter in y-direction.
+  size_t strideHeight;
+
+  //! Locally-stored left-side padding width.
+  size_t padWLeft;
+
+  //! Locally-stored right-side padding width.
+  size_t padWRight;
+
+  //! Locally-stored bottom padding height.
+  size_t padHBottom;
+
+  //! Locally-stored top padding height.
+  size_t padHTop;
+
+  //! Number of columns added to the right of the output, for "same" padding
+  //! with a kernel smaller than the stride.
+  size_t extraWidth;
+
+  //! Number of rows added to the bottom of the output, for "same" padding
+  //! with a kernel smaller than the stride.
+  size_t extraHeight;
+
+  //! Type of padding.
+  std::string paddingType;
+
+  //! Locally-stored useBias.
+  bool useBias;
+
+  //! Locally-cached number of input maps.
+  size_t inMaps;
+
+  //! Locally-cached higher-order input dimensions.
+  size_t higherInDimensions;
+
+  //! Locally-stored weight object.
+  MatType weights;
+
+  //! Locally-stored filters; slice i * maps + m holds the filter between input
+  //! map i and output map m.
+  CubeType weight;
+
+  //! Locally-stored bias term object.
+  MatType bias;
+}; // class TransposedConvolutionType
+
+// Standard TransposedConvolution layer.
+typedef TransposedConvolutionType<arma::mat> TransposedConvolution;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "transposed_convolution_impl.hpp"
+
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file methods/ann/layer/transposed_convolution_impl.hpp
+ * @author Shikhar Jaiswal
+ * @author Marcus Edel
+ *
+ * Implementation of the Transposed Convolution module class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_TRANSPOSED_CONVOLUTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_TRANSPOSED_CONVOLUTION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "transposed_convolution.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+TransposedConvolutionType<MatType>::TransposedConvolutionType() :
+    maps(0),
+    kernelWidth(0),
+    kernelHeight(0),
+    strideWidth(1),
+    strideHeight(1),
+    padWLeft(0),
+    padWRight(0),
+    padHBottom(0),
+    padHTop(0),
+    extraWidth(0),
+    extraHeight(0),
+    paddingType("none"),
+    useBias(true),
+    inMaps(0),
+    higherInDimensions(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+TransposedConvolutionType<MatType>::TransposedConvolutionType(
+    const size_t maps,
+    const size_t kernelWidth,
+    const size_t kernelHeight,
+    const size_t strideWidth,
+    const size_t strideHeight,
+    const size_t padW,
+    const size_t padH,
+    const std::string& paddingType,
+    const bool useBias) :
+    TransposedConvolutionType(
+      maps,
+      kernelWidth,
+      kernelHeight,
+      strideWidth,
+      strideHeight,
+      std::tuple<size_t, size_t>(padW, padW),
+      std::tuple<size_t, size_t>(padH, padH),
+      paddingType,
+      useBias)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+TransposedConvolutionType<MatType>::TransposedConvolutionType(
+    const size_t maps,
+    const size_t kernelWidth,
+    const size_t kernelHeight,
+    const size_t strideWidth,
+    const size_t strideHeight,
+    const std::tuple<size_t, size_t>& padW,
+    const std::tuple<size_t, size_t>& padH,
+    const std::string& paddingTypeIn,
+    const bool useBias) :
+    maps(maps),
+    kernelWidth(kernelWidth),
+    kernelHeight(kernelHeight),
+    strideWidth(strideWidth),
+    strideHeight(strideHeight),
+    padWLeft(std::get<0>(padW)),
+    padWRight(std::get<1>(padW)),
+    padHBottom(std::get<1>(padH)),
+    padHTop(std::get<0>(padH)),
+    extraWidth(0),
+    extraHeight(0),
+    useBias(useBias),
+    inMaps(0),
+    higherInDimensions(0)
+{
+  // Transform paddingType to lowercase.
+  paddingType = util::ToLower(paddingTypeIn);
+  if (paddingType != "none" && paddingType != "valid" && paddingType != "same")
+  {
+    throw std::invalid_argument("TransposedConvolutionType::"
+        "TransposedConvolutionType(): unknown padding type '" + paddingTypeIn +
+        "'!");
+  }
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::SetWeights(const MatType& weightsIn)
+{
+  MakeAlias(weights, weightsIn, WeightSize(), 1);
+  MakeAlias(weight, weightsIn, kernelWidth, kernelHeight, maps * inMaps);
+  if (useBias)
+    MakeAlias(bias, weightsIn, maps, 1, weight.n_elem);
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::ComputeOutputDimensions()
+{
+  // "same" padding removes just enough of the border (or adds just enough to
+  // it, if the kernel is smaller than the stride) that the output is `stride`
+  // times the size of the input.
+  extraWidth = 0;
+  extraHeight = 0;
+  if (paddingType == "valid")
+  {
+    padWLeft = 0;
+    padWRight = 0;
+    padHTop = 0;
+    padHBottom = 0;
+  }
+  else if (paddingType == "same")
+  {
+    const size_t totalPadWidth = (kernelWidth > strideWidth) ?
+        kernelWidth - strideWidth : 0;
+    const size_t totalPadHeight = (kernelHeight > strideHeight) ?
+        kernelHeight - strideHeight : 0;
+    padWLeft = totalPadWidth / 2;
+    padWRight = totalPadWidth - padWLeft;
+    padHTop = totalPadHeight / 2;
+    padHBottom = totalPadHeight - padHTop;
+    extraWidth = (strideWidth > kernelWidth) ? strideWidth - kernelWidth : 0;
+    extraHeight = (strideHeight > kernelHeight) ?
+        strideHeight - kernelHeight : 0;
+  }
+
+  const size_t fullWidth = (this->inputDimensions[0] - 1) * strideWidth +
+      kernelWidth + extraWidth;
+  const size_t fullHeight = (this->inputDimensions[1] - 1) * strideHeight +
+      kernelHeight + extraHeight;
+  if (padWLeft + padWRight >= fullWidth || padHTop + padHBottom >= fullHeight)
+  {
+    throw std::invalid_argument("TransposedConvolutionType::"
+        "ComputeOutputDimensions(): padding is larger than the output!");
+  }
+
+  // We must ensure that the output has at least 3 dimensions, since we will
+  // be adding some number of maps to the output.
+  this->outputDimensions = std::vector<size_t>(
+      std::max(this->inputDimensions.size(), size_t(3)), 1);
+  this->outputDimensions[0] = fullWidth - padWLeft - padWRight;
+  this->outputDimensions[1] = fullHeight - padHTop - padHBottom;
+
+  inMaps = (this->inputDimensions.size() >= 3) ? this->inputDimensions[2] : 1;
+
+  // Compute and cache the total number of input maps.
+  higherInDimensions = 1;
+  for (size_t i = 3; i < this->inputDimensions.size(); ++i)
+  {
+    higherInDimensions *= this->inputDimensions[i];
+    this->outputDimensions[i] = this->inputDimensions[i];
+  }
+
+  this->outputDimensions[2] = maps;
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::Forward(
+    const MatType& input, MatType& output)
+{
+  const size_t numImages = higherInDimensions * input.n_cols;
+  const size_t outWidth = this->outputDimensions[0];
+  const size_t outHeight = this->outputDimensions[1];
+
+  MatType inputRows;
+  InputRows(input, inputRows);
+
+  // Column p of the product holds the contribution of input position p to the
+  // patch of the output it is scattered to; fold the patches into the (full)
+  // output, and then drop the padding.
+  MatType weightMat;
+  MakeAlias(weightMat, weight, kernelWidth * kernelHeight * maps, inMaps);
+  const MatType columns = weightMat * inputRows.t();
+
+  CubeType fullOutput(outWidth + padWLeft + padWRight,
+      outHeight + padHTop + padHBottom, maps * numImages, arma::fill::zeros);
+  Im2ColConvolution<ValidConvolution>::Col2Im(columns, maps, kernelWidth,
+      kernelHeight, this->inputDimensions[0], this->inputDimensions[1],
+      strideWidth, strideHeight, 1, 1, fullOutput);
+
+  CubeType outputCube;
+  MakeAlias(outputCube, output, outWidth, outHeight, maps * numImages);
+  outputCube = fullOutput.tube(padWLeft, padHTop, padWLeft + outWidth - 1,
+      padHTop + outHeight - 1);
+
+  if (useBias)
+  {
+    #pragma omp parallel for
+    for (size_t s = 0; s < outputCube.n_slices; ++s)
+      outputCube.slice(s) += bias[s % maps];
+  }
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::Backward(
+    const MatType& /* input */,
+    const MatType& /* output */,
+    const MatType& gy,
+    MatType& g)
+{
+  const size_t numImages = higherInDimensions * gy.n_cols;
+  const size_t inputSize = this->inputDimensions[0] * this->inputDimensions[1];
+
+  // The error of each input position is the product of the filters with the
+  // error of the patch of the output it was scattered to.
+  MatType columns;
+  ErrorColumns(gy, columns);
+  MatType weightMat;
+  MakeAlias(weightMat, weight, kernelWidth * kernelHeight * maps, inMaps);
+  const MatType gRows = columns.t() * weightMat;
+
+  // Row n * inputSize + p of gRows holds the error of every input map at
+  // position p of point n; move the maps of each point next to each other.
+  MatType gMat;
+  MakeAlias(gMat, g, inputSize, inMaps * numImages);
+  #pragma omp parallel for
+  for (size_t n = 0; n < numImages; ++n)
+  {
+    gMat.cols(n * inMaps, (n + 1) * inMaps - 1) =
+        gRows.rows(n * inputSize, (n + 1) * inputSize - 1);
+  }
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::Gradient(
+    const MatType& input,
+    const MatType& error,
+    MatType& gradient)
+{
+  MatType columns, inputRows;
+  ErrorColumns(error, columns);
+  InputRows(input, inputRows);
+
+  // The weights are stored in the same layout as Forward() uses them.
+  MatType weightGradient;
+  MakeAlias(weightGradient, gradient, kernelWidth * kernelHeight * maps,
+      inMaps);
+  weightGradient = columns * inputRows;
+
+  if (useBias)
+  {
+    const size_t numImages = higherInDimensions * error.n_cols;
+    const size_t outputSize = this->outputDimensions[0] *
+        this->outputDimensions[1];
+    MatType errorMat;
+    MakeAlias(errorMat, error, outputSize, maps * numImages);
+    MatType mapSums = sum(errorMat, 0);
+    MatType imageSums;
+    MakeAlias(imageSums, mapSums, maps, numImages);
+    gradient.submat(weight.n_elem, 0, weight.n_elem + maps - 1, 0) =
+        sum(imageSums, 1);
+  }
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::InputRows(
+    const MatType& input, MatType& inputRows) const
+{
+  const size_t numImages = higherInDimensions * input.n_cols;
+  const size_t inputSize = this->inputDimensions[0] * this->inputDimensions[1];
+
+  MatType inputMat;
+  MakeAlias(inputMat, input, inputSize, inMaps * numImages);
+  inputRows.set_size(inputSize * numImages, inMaps);
+  #pragma omp parallel for
+  for (size_t n = 0; n < numImages; ++n)
+  {
+    inputRows.rows(n * inputSize, (n + 1) * inputSize - 1) =
+        inputMat.cols(n * inMaps, (n + 1) * inMaps - 1);
+  }
+}
+
+template<typename MatType>
+void TransposedConvolutionType<MatType>::ErrorColumns(
+    const MatType& error, MatType& columns) const
+{
+  const size_t numImages = higherInDimensions * error.n_cols;
+  const size_t outWidth = this->outputDimensions[0];
+  const size_t outHeight = this->outputDimensions[1];
+
+  // Put the padding back around the error, so that every patch is complete.
+  CubeType errorCube;
+  MakeAlias(errorCube, error, outWidth, outHeight, maps * numImages);
+  CubeType fullError(outWidth + padWLeft + padWRight,
+      outHeight + padHTop + padHBottom, maps * numImages, arma::fill::zeros);
+  fullError.tube(padWLeft, padHTop, padWLeft + outWidth - 1,
+      padHTop + outHeight - 1) = errorCube;
+
+  Im2ColConvolution<ValidConvolution>::Im2Col(fullError, maps, kernelWidth,
+      kernelHeight, this->inputDimensions[0], this->inputDimensions[1],
+      strideWidth, strideHeight, 1, 1, columns);
+}
+
+template<typename MatType>
+template<typename Archive>
+void TransposedConvolutionType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(cereal::base_class<Layer<MatType>>(this));
+
+  ar(CEREAL_NVP(maps));
+  ar(CEREAL_NVP(kernelWidth));
+  ar(CEREAL_NVP(kernelHeight));
+  ar(CEREAL_NVP(strideWidth));
+  ar(CEREAL_NVP(strideHeight));
+  ar(CEREAL_NVP(padWLeft));
+  ar(CEREAL_NVP(padWRight));
+  ar(CEREAL_NVP(padHBottom));
+  ar(CEREAL_NVP(padHTop));
+  ar(CEREAL_NVP(extraWidth));
+  ar(CEREAL_NVP(extraHeight));
+  ar(CEREAL_NVP(paddingType));
+  ar(CEREAL_NVP(useBias));
+  ar(CEREAL_NVP(inMaps));
+  ar(CEREAL_NVP(higherInDimensions));
+}
+
+} // namespace mlpack
+
+#endif
@@ -35,6 +35,7 @@
 #include "reconstruction_loss.hpp"
 #include "sigmoid_cross_entropy_error.hpp"
 #include "soft_margin_loss.hpp"
+#include "softmax_cross_entropy_loss.hpp"
 #include "triplet_margin_loss.hpp"
 #include "vr_class_reward.hpp"
 
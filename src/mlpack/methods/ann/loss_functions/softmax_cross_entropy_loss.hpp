@@ -0,0 +1,148 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_loss.hpp
+ *
+ * Definition of the SoftmaxCrossEntropyLossType class, which fuses the log
+ * softmax and the negative log likelihood.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The softmax cross-entropy loss takes the unnormalized scores (logits) of
+ * each class and a class index in the range [0, numClasses - 1] as target,
+ * and computes the negative log likelihood of the softmax of the scores:
+ *
+ * @f[
+ * l(x, t) = \log \sum_j \exp(x_j) - x_t.
+ * @f]
+ *
+ * This gives the same results as a LogSoftMax layer followed by the
+ * NegativeLogLikelihood loss, but the network ends with the layer that
+ * computes the scores (e.g. Linear), so no extra activation matrix is kept,
+ * and the loss of each point is computed in a single, numerically stable pass
+ * over its scores (with the maximum score subtracted as it is found).  The
+ * gradient with respect to the scores, softmax(x) - e_t, is also computed
+ * directly.  Since the network outputs the scores, the predicted class is
+ * still the row with the largest output.
+ *
+ * For networks with a very large number of classes, sampled softmax can be
+ * used for training: if numSampled is positive and less than the number of
+ * classes, every call to Forward() draws numSampled distinct classes
+ * uniformly at random, and the softmax of each point is computed over these
+ * classes and its target class only.  Backward() uses the classes drawn by
+ * the last call to Forward(), and its gradient is zero for every other class.
+ * The sampled loss is an estimate, so it should be disabled (by setting
+ * NumSampled() to 0) to evaluate the network.
+ *
+ * @tparam MatType Matrix representation to accept as input and use for
+ *    computation.
+ */
+template<typename MatType = arma::mat>
+class SoftmaxCrossEntropyLossType
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropyLossType object.
+   *
+   * @param reduction Specifies the reduction to apply to the output. If false,
+   *                  'mean' reduction is used, where sum of the output will be
+   *                  divided by the number of elements in the output. If true,
+   *                  'sum' reduction is used and the output will be summed. It
+   *                  is set to true by default.
+   * @param numSampled Number of classes to sample for sampled softmax; 0 (the
+   *     default) uses all of the classes.
+   */
+  SoftmaxCrossEntropyLossType(const bool reduction = true,
+                              const size_t numSampled = 0);
+
+  /**
+   * Computes the softmax cross-entropy loss.
+   *
+   * @param prediction Scores of each class (one column per point).
+   * @param target The target vector, that contains the class index in the range
+   *        between 0 and the number of classes - 1.
+   */
+  double Forward(const MatType& prediction, const MatType& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network: compute the gradient of
+   * the loss with respect to the scores.
+   *
+   * @param prediction Scores of each class (one column per point).
+   * @param target The target vector, that contains the class index in the range
+   *        between 0 and the number of classes - 1.
+   * @param loss The calculated error.
+   */
+  void Backward(const MatType& prediction,
+                const MatType& target,
+                MatType& loss);
+
+  //! Get the reduction type, represented as boolean
+  //! (false 'mean' reduction, true 'sum' reduction).
+  bool Reduction() const { return reduction; }
+  //! Modify the type of reduction used.
+  bool& Reduction() { return reduction; }
+
+  //! Get the number of classes sampled for sampled softmax (0 if all classes
+  //! are used).
+  size_t NumSampled() const { return numSampled; }
+  //! Modify the number of classes sampled for sampled softmax (0 to use all
+  //! classes).
+  size_t& NumSampled() { return numSampled; }
+
+  //! Get the classes drawn by the last call to Forward() (empty if all classes
+  //! were used).
+  const arma::uvec& SampledClasses() const { return sampledClasses; }
+
+  /**
+   * Serialize the loss function.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Draw the sampled classes for the given number of classes, or clear them
+  //! if all classes are used.
+  void Sample(const size_t numClasses);
+
+  //! Call f(j) for every class j in the softmax of a point with the given
+  //! target.
+  template<typename FuncType>
+  void ForEachClass(const size_t numClasses,
+                    const size_t target,
+                    const FuncType& f) const;
+
+  //! Compute the maximum score and the sum of exp(score - maximum) over the
+  //! classes in the softmax of the given point, in a single pass.
+  void LogSumExp(const typename MatType::elem_type* scores,
+                 const size_t numClasses,
+                 const size_t target,
+                 typename MatType::elem_type& maxScore,
+                 typename MatType::elem_type& sum) const;
+
+  //! Boolean value that tells if reduction is 'sum' or 'mean'.
+  bool reduction;
+  //! The number of classes sampled for sampled softmax.
+  size_t numSampled;
+  //! The classes drawn by the last call to Forward(), sorted.
+  arma::uvec sampledClasses;
+}; // class SoftmaxCrossEntropyLossType
+
+// Default typedef for typical `arma::mat` usage.
+typedef SoftmaxCrossEntropyLossType<arma::mat> SoftmaxCrossEntropyLoss;
+
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_loss_impl.hpp"
+
+#endif
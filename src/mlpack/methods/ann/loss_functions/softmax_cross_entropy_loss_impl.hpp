@@ -0,0 +1,182 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_loss_impl.hpp
+ *
+ * Implementation of the SoftmaxCrossEntropyLossType class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_LOSS_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_LOSS_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy_loss.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+SoftmaxCrossEntropyLossType<MatType>::SoftmaxCrossEntropyLossType(
+    const bool reduction,
+    const size_t numSampled) :
+    reduction(reduction),
+    numSampled(numSampled)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+double SoftmaxCrossEntropyLossType<MatType>::Forward(
+    const MatType& prediction,
+    const MatType& target)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  Sample(prediction.n_rows);
+
+  ElemType lossSum = 0;
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+        "Target class out of range.");
+
+    const size_t t = (size_t) target(i);
+    const ElemType* scores = prediction.colptr(i);
+    ElemType maxScore, sum;
+    LogSumExp(scores, prediction.n_rows, t, maxScore, sum);
+
+    lossSum += maxScore + std::log(sum) - scores[t];
+  }
+
+  if (reduction)
+    return lossSum;
+
+  return lossSum / target.n_elem;
+}
+
+template<typename MatType>
+void SoftmaxCrossEntropyLossType<MatType>::Backward(
+    const MatType& prediction,
+    const MatType& target,
+    MatType& loss)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Use the classes of the last call to Forward(), unless they can't belong to
+  // this prediction.
+  const bool sampling = (numSampled > 0 && numSampled < prediction.n_rows);
+  if (sampling != (sampledClasses.n_elem > 0) || (sampling &&
+      (sampledClasses.n_elem != numSampled ||
+       sampledClasses[sampledClasses.n_elem - 1] >= prediction.n_rows)))
+  {
+    Sample(prediction.n_rows);
+  }
+
+  loss.zeros(prediction.n_rows, prediction.n_cols);
+  for (size_t i = 0; i < prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < prediction.n_rows,
+        "Target class out of range.");
+
+    const size_t t = (size_t) target(i);
+    const ElemType* scores = prediction.colptr(i);
+    ElemType* gradient = loss.colptr(i);
+    ElemType maxScore, sum;
+    LogSumExp(scores, prediction.n_rows, t, maxScore, sum);
+
+    // The gradient is softmax(x) - e_t.
+    ForEachClass(prediction.n_rows, t, [&](const size_t j)
+    {
+      gradient[j] = std::exp(scores[j] - maxScore) / sum;
+    });
+    gradient[t] -= 1;
+  }
+
+  if (!reduction)
+    loss /= target.n_elem;
+}
+
+template<typename MatType>
+template<typename Archive>
+void SoftmaxCrossEntropyLossType<MatType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(reduction));
+  ar(CEREAL_NVP(numSampled));
+
+  if (cereal::is_loading<Archive>())
+    sampledClasses.reset();
+}
+
+template<typename MatType>
+void SoftmaxCrossEntropyLossType<MatType>::Sample(const size_t numClasses)
+{
+  if (numSampled == 0 || numSampled >= numClasses)
+  {
+    sampledClasses.reset();
+    return;
+  }
+
+  // Sorting the classes lets ForEachClass() find the target quickly.
+  sampledClasses = arma::sort(arma::randperm<arma::uvec>(numClasses,
+      numSampled));
+}
+
+template<typename MatType>
+template<typename FuncType>
+void SoftmaxCrossEntropyLossType<MatType>::ForEachClass(
+    const size_t numClasses,
+    const size_t target,
+    const FuncType& f) const
+{
+  if (sampledClasses.n_elem == 0)
+  {
+    for (size_t j = 0; j < numClasses; ++j)
+      f(j);
+    return;
+  }
+
+  for (size_t j = 0; j < sampledClasses.n_elem; ++j)
+    f(sampledClasses[j]);
+
+  // The target class is always part of the softmax.
+  if (!std::binary_search(sampledClasses.begin(), sampledClasses.end(),
+      (arma::uword) target))
+  {
+    f(target);
+  }
+}
+
+template<typename MatType>
+void SoftmaxCrossEntropyLossType<MatType>::LogSumExp(
+    const typename MatType::elem_type* scores,
+    const size_t numClasses,
+    const size_t target,
+    typename MatType::elem_type& maxScore,
+    typename MatType::elem_type& sum) const
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Start from the target class, and rescale the sum whenever a larger score
+  // is found, so that no exponential can overflow.
+  maxScore = scores[target];
+  sum = 0;
+  ForEachClass(numClasses, target, [&](const size_t j)
+  {
+    const ElemType score = scores[j];
+    if (score > maxScore)
+    {
+      sum = sum * std::exp(maxScore - score) + 1;
+      maxScore = score;
+    }
+    else
+    {
+      sum += std::exp(score - maxScore);
+    }
+  });
+}
+
+} // namespace mlpack
+
+#endif
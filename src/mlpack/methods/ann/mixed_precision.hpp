@@ -0,0 +1,253 @@
+/**
+ * @file methods/ann/mixed_precision.hpp
+ *
+ * Conversions between single precision and the 16-bit floating point types
+ * float16 and bfloat16, and the MixedPrecision policy that FFN uses for
+ * mixed-precision training with dynamic loss scaling.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_MIXED_PRECISION_HPP
+#define MLPACK_METHODS_ANN_MIXED_PRECISION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Convert the given value to the bits of the nearest IEEE 754 half-precision
+ * (float16) value, rounding to nearest even.  Values too large for float16
+ * become infinity, and values too small become zero or a subnormal value.
+ */
+inline uint16_t FloatToHalf(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  const uint16_t sign = (bits >> 16) & 0x8000;
+  const uint32_t absBits = bits & 0x7FFFFFFF;
+
+  // Infinity and NaN.
+  if (absBits >= 0x7F800000)
+    return sign | 0x7C00 | ((absBits > 0x7F800000) ? 0x200 : 0);
+  // Anything that rounds to 65520 or more overflows.
+  if (absBits >= 0x477FF000)
+    return sign | 0x7C00;
+
+  // Values below the smallest normal float16 value (2^-14) are subnormal, in
+  // units of 2^-24; anything up to 2^-25 rounds to zero.
+  if (absBits < 0x38800000)
+  {
+    if (absBits <= 0x33000000)
+      return sign;
+
+    const uint32_t mantissa = (absBits & 0x7FFFFF) | 0x800000;
+    const uint32_t shift = 126 - (absBits >> 23);
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    uint32_t result = mantissa >> shift;
+    if (remainder > halfway || (remainder == halfway && (result & 1)))
+      ++result;
+
+    return sign | result;
+  }
+
+  // Rebias the exponent, then round away the low 13 bits of the mantissa; a
+  // carry into the exponent gives the right result.
+  uint32_t result = (absBits - 0x38000000) >> 13;
+  const uint32_t remainder = absBits & 0x1FFF;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+    ++result;
+
+  return sign | result;
+}
+
+//! Convert the bits of a float16 value to single precision (exactly).
+inline float HalfToFloat(const uint16_t half)
+{
+  const uint32_t sign = uint32_t(half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1F;
+  const uint32_t mantissa = half & 0x3FF;
+
+  if (exponent == 0)
+  {
+    // Zero or a subnormal value.
+    const float value = std::ldexp((float) mantissa, -24);
+    return sign ? -value : value;
+  }
+
+  uint32_t bits;
+  if (exponent == 0x1F)
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  else
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+/**
+ * Convert the given value to the bits of the nearest bfloat16 value (the upper
+ * half of a single precision value), rounding to nearest even.
+ */
+inline uint16_t FloatToBFloat16(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+
+  // Keep NaN quiet, instead of letting the rounding turn it into infinity.
+  if ((bits & 0x7FFFFFFF) > 0x7F800000)
+    return (bits >> 16) | 0x40;
+
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return bits >> 16;
+}
+
+//! Convert the bits of a bfloat16 value to single precision (exactly).
+inline float BFloat16ToFloat(const uint16_t bfloat)
+{
+  const uint32_t bits = uint32_t(bfloat) << 16;
+  float value;
+  std::memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+/**
+ * The MixedPrecision policy describes how an FFN is trained in mixed precision.
+ * When it is enabled, the optimizer updates a full-precision ("master") copy of
+ * the parameters, but the forward and backward passes use a copy of the
+ * parameters that is rounded to a 16-bit floating point type, and the gradient
+ * is rounded to that type too.
+ *
+ * To keep small gradients from underflowing in float16, the loss is multiplied
+ * by a loss scale before the backward pass, and the gradient is divided by it
+ * afterwards.  The loss scale is dynamic: if the scaled gradient overflows, the
+ * step is skipped (the gradient is set to zero) and the loss scale is halved;
+ * after `growthInterval` steps without overflow, the loss scale is doubled.
+ * Note that the gradients added by layer regularizers (e.g. of `Linear` layers
+ * with an L2 regularizer) are not scaled, so they are divided by the loss
+ * scale too; for regularized networks, keep the loss scale at 1 with
+ * `MixedPrecision(halfType, 1.0, 0)` (this is usually fine with bfloat16, which
+ * has the range of single precision).
+ *
+ * Armadillo has no 16-bit element type, so the 16-bit values are held in the
+ * element type of the network; use `ToHalf()` and `FromHalf()` to store
+ * matrices with 16 bits per element.
+ *
+ * For example, to train a network with bfloat16 weights and gradients:
+ *
+ * @code
+ * FFN<NegativeLogLikelihood> model;
+ * // ... add layers ...
+ * model.Precision() = MixedPrecision(MixedPrecision::BFLOAT16);
+ * model.Train(data, labels);
+ * @endcode
+ */
+class MixedPrecision
+{
+ public:
+  //! The 16-bit floating point types that can be used.
+  enum HalfTypes
+  {
+    NONE,
+    FLOAT16,
+    BFLOAT16
+  };
+
+  /**
+   * Create the policy.
+   *
+   * @param halfType The 16-bit type to use; NONE disables mixed precision.
+   * @param lossScale Initial loss scale.
+   * @param growthInterval Number of steps without overflow after which the
+   *     loss scale is doubled; 0 never increases the loss scale.
+   * @param minLossScale The loss scale is never reduced below this value.
+   */
+  MixedPrecision(const HalfTypes halfType = NONE,
+                 const double lossScale = 65536.0,
+                 const size_t growthInterval = 2000,
+                 const double minLossScale = 1.0);
+
+  //! Get whether mixed precision is enabled.
+  bool Enabled() const { return halfType != NONE; }
+
+  /**
+   * Round each element of the given matrix to the nearest value of the 16-bit
+   * type.  Nothing is done if mixed precision is disabled.
+   */
+  template<typename MatType>
+  void Round(MatType& m) const;
+
+  /**
+   * Turn the gradient of the scaled loss into the gradient of the loss: round
+   * it to the 16-bit type, check it for overflow, and divide it by the loss
+   * scale.  If it overflowed, it is set to zero instead.  The loss scale is
+   * then updated.
+   *
+   * @param gradient Gradient of the scaled loss.
+   * @return false if the gradient overflowed and the step should be skipped.
+   */
+  template<typename MatType>
+  bool UnscaleGradient(MatType& gradient);
+
+  //! Get the 16-bit type.
+  HalfTypes HalfType() const { return halfType; }
+  //! Get the current loss scale.
+  double LossScale() const { return lossScale; }
+  //! Get the number of steps without overflow after which the scale grows.
+  size_t GrowthInterval() const { return growthInterval; }
+  //! Get the smallest allowed loss scale.
+  double MinLossScale() const { return minLossScale; }
+  //! Get the number of steps that were skipped because of overflow.
+  size_t SkippedSteps() const { return skippedSteps; }
+
+ private:
+  //! The 16-bit type.
+  HalfTypes halfType;
+  //! The current loss scale.
+  double lossScale;
+  //! The number of steps without overflow after which the scale grows.
+  size_t growthInterval;
+  //! The smallest allowed loss scale.
+  double minLossScale;
+  //! The number of steps since the last overflow or growth of the scale.
+  size_t goodSteps;
+  //! The number of steps that were skipped because of overflow.
+  size_t skippedSteps;
+};
+
+/**
+ * Store the given matrix with 16 bits per element, as the bits of the nearest
+ * values of the given type.
+ *
+ * @param input Matrix to convert.
+ * @param output Will be set to the 16-bit representation of the matrix.
+ * @param halfType FLOAT16 or BFLOAT16.
+ */
+template<typename MatType>
+void ToHalf(const MatType& input,
+            arma::Mat<arma::u16>& output,
+            const MixedPrecision::HalfTypes halfType);
+
+/**
+ * Convert the given matrix with 16 bits per element (see `ToHalf()`) back to
+ * the element type of the output.
+ *
+ * @param input 16-bit representation of a matrix.
+ * @param output Will be set to the converted matrix.
+ * @param halfType FLOAT16 or BFLOAT16.
+ */
+template<typename MatType>
+void FromHalf(const arma::Mat<arma::u16>& input,
+              MatType& output,
+              const MixedPrecision::HalfTypes halfType);
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mixed_precision_impl.hpp"
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file methods/ann/mixed_precision_impl.hpp
+ *
+ * Implementation of the MixedPrecision policy and the 16-bit conversions of
+ * matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_MIXED_PRECISION_IMPL_HPP
+#define MLPACK_METHODS_ANN_MIXED_PRECISION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mixed_precision.hpp"
+
+namespace mlpack {
+
+inline MixedPrecision::MixedPrecision(const HalfTypes halfType,
+                                      const double lossScale,
+                                      const size_t growthInterval,
+                                      const double minLossScale) :
+    halfType(halfType),
+    lossScale(lossScale),
+    growthInterval(growthInterval),
+    minLossScale(minLossScale),
+    goodSteps(0),
+    skippedSteps(0)
+{
+  if (lossScale <= 0.0 || minLossScale <= 0.0)
+  {
+    throw std::invalid_argument("MixedPrecision::MixedPrecision(): the loss "
+        "scale must be positive!");
+  }
+}
+
+template<typename MatType>
+void MixedPrecision::Round(MatType& m) const
+{
+  typedef typename MatType::elem_type ElemType;
+  ElemType* values = m.memptr();
+
+  if (halfType == FLOAT16)
+  {
+    #pragma omp parallel for
+    for (size_t i = 0; i < (size_t) m.n_elem; ++i)
+      values[i] = ElemType(HalfToFloat(FloatToHalf(float(values[i]))));
+  }
+  else if (halfType == BFLOAT16)
+  {
+    #pragma omp parallel for
+    for (size_t i = 0; i < (size_t) m.n_elem; ++i)
+      values[i] = ElemType(BFloat16ToFloat(FloatToBFloat16(float(values[i]))));
+  }
+}
+
+template<typename MatType>
+bool MixedPrecision::UnscaleGradient(MatType& gradient)
+{
+  // Values that do not fit in the 16-bit type become infinite here.
+  Round(gradient);
+
+  if (!gradient.is_finite())
+  {
+    gradient.zeros();
+    lossScale = std::max(lossScale / 2.0, minLossScale);
+    goodSteps = 0;
+    ++skippedSteps;
+    return false;
+  }
+
+  gradient /= lossScale;
+  if (growthInterval > 0 && ++goodSteps >= growthInterval)
+  {
+    lossScale *= 2.0;
+    goodSteps = 0;
+  }
+
+  return true;
+}
+
+template<typename MatType>
+void ToHalf(const MatType& input,
+            arma::Mat<arma::u16>& output,
+            const MixedPrecision::HalfTypes halfType)
+{
+  if (halfType != MixedPrecision::FLOAT16 &&
+      halfType != MixedPrecision::BFLOAT16)
+  {
+    throw std::invalid_argument("ToHalf(): the type must be FLOAT16 or "
+        "BFLOAT16!");
+  }
+
+  output.set_size(input.n_rows, input.n_cols);
+  const typename MatType::elem_type* in = input.memptr();
+  arma::u16* out = output.memptr();
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) input.n_elem; ++i)
+  {
+    out[i] = (halfType == MixedPrecision::FLOAT16) ?
+        FloatToHalf(float(in[i])) : FloatToBFloat16(float(in[i]));
+  }
+}
+
+template<typename MatType>
+void FromHalf(const arma::Mat<arma::u16>& input,
+              MatType& output,
+              const MixedPrecision::HalfTypes halfType)
+{
+  if (halfType != MixedPrecision::FLOAT16 &&
+      halfType != MixedPrecision::BFLOAT16)
+  {
+    throw std::invalid_argument("FromHalf(): the type must be FLOAT16 or "
+        "BFLOAT16!");
+  }
+
+  typedef typename MatType::elem_type ElemType;
+  output.set_size(input.n_rows, input.n_cols);
+  const arma::u16* in = input.memptr();
+  ElemType* out = output.memptr();
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) input.n_elem; ++i)
+  {
+    out[i] = ElemType((halfType == MixedPrecision::FLOAT16) ?
+        HalfToFloat(in[i]) : BFloat16ToFloat(in[i]));
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file methods/ann/network_profiler.hpp
+ *
+ * Definition of the NetworkProfiler class, which records the time, memory and
+ * estimated floating-point operations of each layer of a network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_NETWORK_PROFILER_HPP
+#define MLPACK_METHODS_ANN_NETWORK_PROFILER_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * The statistics of one pass (forward, backward or gradient) of one layer,
+ * summed over all the calls of the pass.
+ */
+struct PassProfile
+{
+  PassProfile() : calls(0), time(0), bytes(0), flops(0.0) { }
+
+  //! Number of calls of the pass.
+  size_t calls;
+  //! Total wall time of the calls.
+  std::chrono::microseconds time;
+  //! Total size, in bytes, of the matrices that the calls wrote their results
+  //! to (the output, the error of the input, or the gradient).
+  size_t bytes;
+  //! Total estimated number of floating-point operations of the calls.
+  double flops;
+};
+
+//! The statistics of the three passes of one layer.
+struct LayerProfile
+{
+  PassProfile forward;
+  PassProfile backward;
+  PassProfile gradient;
+};
+
+/**
+ * The NetworkProfiler records, for each layer of an `FFN` or `RNN` and for
+ * each of the forward, backward and gradient passes, the wall time of the
+ * calls (with a `util::Timers` object, so timing is per thread, as for the
+ * timers of the bindings), the size of the matrices written by the calls, and
+ * an estimate of the floating-point operations of the calls, given by
+ * `Layer::ForwardFlops()`.  The backward pass is assumed to cost as much as
+ * the forward pass, and so is the gradient pass for layers with weights.
+ *
+ * Profiling is opt-in: the profiler is owned by the user, and given to the
+ * network, which records into it until profiling is disabled.
+ *
+ * @code
+ * NetworkProfiler profiler;
+ * model.EnableProfiling(profiler);
+ * model.Train(data, responses);
+ * model.DisableProfiling();
+ *
+ * // Print one line per layer to Log::Info, or inspect the numbers.
+ * profiler.Print();
+ * const std::vector<LayerProfile> layers = profiler.Layers();
+ * @endcode
+ *
+ * Only the layers of the network itself are profiled: the other replicas of a
+ * network trained with `Replicas()` greater than 1, and predictions made with
+ * a frozen network (see `FFN::Freeze()`), are not recorded.  The memory that
+ * a layer allocates for its own temporaries is not seen by the profiler.
+ */
+class NetworkProfiler
+{
+ public:
+  //! Create the profiler, with no recorded layers.
+  NetworkProfiler();
+
+  //! The profiler holds timers, so it cannot be copied.
+  NetworkProfiler(const NetworkProfiler&) = delete;
+  NetworkProfiler& operator=(const NetworkProfiler&) = delete;
+
+  //! Start timing the forward pass of the given layer.
+  void StartForward(const size_t layer) { Start("forward", layer); }
+  //! Stop timing the forward pass of the given layer, and record it.
+  void StopForward(const size_t layer, const size_t bytes, const double flops)
+  {
+    Stop("forward", layer, bytes, flops, &LayerProfile::forward);
+  }
+
+  //! Start timing the backward pass of the given layer.
+  void StartBackward(const size_t layer) { Start("backward", layer); }
+  //! Stop timing the backward pass of the given layer, and record it.
+  void StopBackward(const size_t layer, const size_t bytes, const double flops)
+  {
+    Stop("backward", layer, bytes, flops, &LayerProfile::backward);
+  }
+
+  //! Start timing the gradient pass of the given layer.
+  void StartGradient(const size_t layer) { Start("gradient", layer); }
+  //! Stop timing the gradient pass of the given layer, and record it.
+  void StopGradient(const size_t layer, const size_t bytes, const double flops)
+  {
+    Stop("gradient", layer, bytes, flops, &LayerProfile::gradient);
+  }
+
+  /**
+   * Get the statistics of each layer, in the order of the layers of the
+   * network.  Layers that were never called have empty statistics.
+   */
+  std::vector<LayerProfile> Layers();
+
+  /**
+   * Print the statistics of each layer (one line per layer and pass) and the
+   * totals of each pass to the given stream.
+   *
+   * @param stream Stream to print to.
+   */
+  void Print(std::ostream& stream);
+
+  //! Print the statistics of each layer to `Log::Info`.
+  void Print();
+
+  //! Forget all the recorded statistics.
+  void Reset();
+
+ private:
+  //! Get the name of the timer of the given pass and layer.
+  static std::string TimerName(const char* pass, const size_t layer);
+
+  //! Start the timer of the given pass and layer.
+  void Start(const char* pass, const size_t layer);
+
+  //! Stop the timer of the given pass and layer, and record the call.
+  void Stop(const char* pass,
+            const size_t layer,
+            const size_t bytes,
+            const double flops,
+            PassProfile LayerProfile::* profile);
+
+  //! The timers of each pass of each layer.
+  util::Timers timers;
+
+  //! The statistics of each layer (without the times, which are held by
+  //! `timers`).
+  std::vector<LayerProfile> layers;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "network_profiler_impl.hpp"
+
+#endif
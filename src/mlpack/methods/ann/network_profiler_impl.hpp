@@ -0,0 +1,120 @@
+/**
+ * @file methods/ann/network_profiler_impl.hpp
+ *
+ * Implementation of the NetworkProfiler class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_NETWORK_PROFILER_IMPL_HPP
+#define MLPACK_METHODS_ANN_NETWORK_PROFILER_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "network_profiler.hpp"
+
+namespace mlpack {
+
+inline NetworkProfiler::NetworkProfiler()
+{
+  timers.Enabled() = true;
+}
+
+inline std::vector<LayerProfile> NetworkProfiler::Layers()
+{
+  std::vector<LayerProfile> result(layers);
+  for (size_t i = 0; i < result.size(); ++i)
+  {
+    result[i].forward.time = timers.Get(TimerName("forward", i));
+    result[i].backward.time = timers.Get(TimerName("backward", i));
+    result[i].gradient.time = timers.Get(TimerName("gradient", i));
+  }
+
+  return result;
+}
+
+inline void NetworkProfiler::Print(std::ostream& stream)
+{
+  const std::vector<LayerProfile> result = Layers();
+  const char* passNames[] = { "forward", "backward", "gradient" };
+  PassProfile LayerProfile::* passes[] = { &LayerProfile::forward,
+      &LayerProfile::backward, &LayerProfile::gradient };
+
+  PassProfile totals[3];
+  for (size_t i = 0; i < result.size(); ++i)
+  {
+    for (size_t p = 0; p < 3; ++p)
+    {
+      const PassProfile& pass = result[i].*passes[p];
+      if (pass.calls == 0)
+        continue;
+
+      stream << "Layer " << i << " " << passNames[p] << ": " << pass.calls
+          << " calls, " << pass.time.count() << "us, " << pass.bytes
+          << " bytes, " << pass.flops << " FLOPs ("
+          << pass.flops / std::max(1e3 * pass.time.count(), 1.0)
+          << " GFLOP/s)." << std::endl;
+
+      totals[p].calls += pass.calls;
+      totals[p].time += pass.time;
+      totals[p].bytes += pass.bytes;
+      totals[p].flops += pass.flops;
+    }
+  }
+
+  for (size_t p = 0; p < 3; ++p)
+  {
+    if (totals[p].calls == 0)
+      continue;
+
+    stream << "Total " << passNames[p] << ": " << totals[p].time.count()
+        << "us, " << totals[p].bytes << " bytes, " << totals[p].flops
+        << " FLOPs." << std::endl;
+  }
+}
+
+inline void NetworkProfiler::Print()
+{
+  std::ostringstream stream;
+  Print(stream);
+  Log::Info << stream.str();
+}
+
+inline void NetworkProfiler::Reset()
+{
+  timers.Reset();
+  layers.clear();
+}
+
+inline std::string NetworkProfiler::TimerName(const char* pass,
+                                              const size_t layer)
+{
+  return std::string("layer_") + std::to_string(layer) + "_" + pass;
+}
+
+inline void NetworkProfiler::Start(const char* pass, const size_t layer)
+{
+  timers.Start(TimerName(pass, layer), std::this_thread::get_id());
+}
+
+inline void NetworkProfiler::Stop(const char* pass,
+                                  const size_t layer,
+                                  const size_t bytes,
+                                  const double flops,
+                                  PassProfile LayerProfile::* profile)
+{
+  timers.Stop(TimerName(pass, layer), std::this_thread::get_id());
+
+  if (layer >= layers.size())
+    layers.resize(layer + 1);
+
+  PassProfile& record = layers[layer].*profile;
+  ++record.calls;
+  record.bytes += bytes;
+  record.flops += flops;
+}
+
+} // namespace mlpack
+
+#endif
@@ -160,6 +160,62 @@ class RNN
       arma::Cube<typename MatType::elem_type> responses,
       CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent network on sequences of different lengths, using the
+   * given optimizer.  The sequences are padded to the length of the longest
+   * one (so `predictors.n_slices` is the longest length), and
+   * `sequenceLengths[i]` is the true length of the `i`th sequence; the time
+   * steps after the end of a sequence are ignored, by both the loss and the
+   * gradient, and so can hold anything.
+   *
+   * The columns are sorted by length before training, and the shuffling of
+   * the optimizer only reorders columns of the same length, so each batch
+   * holds sequences of similar lengths, and a batch only runs up to the
+   * length of its longest sequence.  For truncated BPTT (when `BPTTSteps()`
+   * is less than the length of a batch), the gradient is taken over the last
+   * `BPTTSteps()` steps of the longest sequence of the batch.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables, padded to the same length.
+   * @param sequenceLengths Length of each sequence (between 1 and
+   *      `predictors.n_slices`).
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      arma::Cube<typename MatType::elem_type> predictors,
+      const arma::urowvec& sequenceLengths,
+      arma::Cube<typename MatType::elem_type> responses,
+      OptimizerType& optimizer,
+      CallbackTypes&&... callbacks);
+
+  /**
+   * Train the recurrent network on sequences of different lengths.  By
+   * default, the RMSProp optimization algorithm is used.  See the overload
+   * above for more details.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables, padded to the same length.
+   * @param sequenceLengths Length of each sequence (between 1 and
+   *      `predictors.n_slices`).
+   * @param responses Outputs results from input training variables.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType = ens::RMSProp, typename... CallbackTypes>
+  typename MatType::elem_type Train(
+      arma::Cube<typename MatType::elem_type> predictors,
+      const arma::urowvec& sequenceLengths,
+      arma::Cube<typename MatType::elem_type> responses,
+      CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -173,6 +229,59 @@ class RNN
                arma::Cube<typename MatType::elem_type>& results,
                const size_t batchSize = 128);
 
+  /**
+   * Predict the responses to sequences of different lengths, padded to the
+   * length of the longest one.  Each batch only runs up to the length of its
+   * longest sequence, and the results of the time steps after the end of a
+   * sequence are set to zero.
+   *
+   * @param predictors Input predictors, padded to the same length.
+   * @param sequenceLengths Length of each sequence (between 1 and
+   *      `predictors.n_slices`).
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Batch size to use for prediction.
+   */
+  void Predict(const arma::Cube<typename MatType::elem_type>& predictors,
+               const arma::urowvec& sequenceLengths,
+               arma::Cube<typename MatType::elem_type>& results,
+               const size_t batchSize = 128);
+
+  /**
+   * Start new sequences for streaming prediction with `PredictStep()`: the
+   * state of the recurrent layers is cleared by the next call to
+   * `PredictStep()`.
+   */
+  void ResetState();
+
+  /**
+   * Process one new time step of the sequences started with `ResetState()`,
+   * keeping the state of the recurrent layers for the next call.  Each call
+   * costs as much as one step of `Predict()`, whatever the number of steps
+   * that came before it, and no memory is allocated once `output` has the
+   * right size.  So, for online scoring:
+   *
+   * @code
+   * model.ResetState();
+   * while (...)
+   * {
+   *   model.PredictStep(event, output); // `output` is the response to `event`.
+   * }
+   * @endcode
+   *
+   * The number of streamed sequences is `input.n_cols` on the first step, and
+   * must stay the same until `ResetState()` is called.  `Train()`, `Predict()`
+   * and `Evaluate()` also use the state of the recurrent layers, so they
+   * discard the streamed state, and the next step starts new sequences.
+   *
+   * @param input Input of the step (one column per sequence).
+   * @param output Matrix to store the output of the step into.
+   */
+  void PredictStep(const MatType& input, MatType& output);
+
+  //! Get the number of steps processed by `PredictStep()` since the state was
+  //! last reset.
+  size_t StateSteps() const { return stateSteps; }
+
   // Return the nujmber of weights in the model.
   size_t WeightSize() { return network.WeightSize(); }
 
@@ -207,6 +316,23 @@ class RNN
   //! Modify the number of steps allowed for BPTT.
   size_t& BPTTSteps() { return bpttSteps; }
 
+  /**
+   * Record the wall time, the memory written and the estimated floating-point
+   * operations of each pass of each layer in the given profiler, until
+   * `DisableProfiling()` is called; see `NetworkProfiler`.  Each time step is
+   * recorded as a separate call of each layer.
+   *
+   * @param profiler Profiler to record in.
+   */
+  void EnableProfiling(NetworkProfiler& profiler)
+  {
+    network.EnableProfiling(profiler);
+  }
+
+  //! Stop recording the passes of each layer in the profiler given to
+  //! `EnableProfiling()`.
+  void DisableProfiling() { network.DisableProfiling(); }
+
   /**
    * Reset the stored data of the network entirely.  This reset all weights of
    * each layer using `InitializationRuleType`, and prepares the network to
@@ -341,9 +467,44 @@ class RNN
   void ResetData(arma::Cube<typename MatType::elem_type> predictors,
                  arma::Cube<typename MatType::elem_type> responses);
 
+  /**
+   * Prepare the network for the given sequences of different lengths, padded
+   * to the same length.  The columns are sorted by decreasing length.
+   *
+   * @param predictors Input data variables.
+   * @param sequenceLengths Length of each sequence.
+   * @param responses Outputs results from input data variables.
+   */
+  void ResetData(arma::Cube<typename MatType::elem_type> predictors,
+                 const arma::urowvec& sequenceLengths,
+                 arma::Cube<typename MatType::elem_type> responses);
+
  private:
   // Helper functions.
 
+  //! Optimize the parameters of the network on the data given to
+  //! `ResetData()`.
+  template<typename OptimizerType, typename... CallbackTypes>
+  typename MatType::elem_type TrainModel(OptimizerType& optimizer,
+                                         CallbackTypes&&... callbacks);
+
+  //! Throw if the given sequence lengths do not fit the given predictors.
+  static void CheckSequenceLengths(
+      const std::string& functionName,
+      const arma::Cube<typename MatType::elem_type>& predictors,
+      const arma::urowvec& sequenceLengths);
+
+  //! Get the number of time steps of the batch of the training data starting
+  //! at `begin` (the length of its longest sequence).
+  size_t Steps(const size_t begin) const;
+
+  //! Get the number of sequences of the batch of the training data starting at
+  //! `begin` that are still running at step `t`.  Since the columns are sorted
+  //! by decreasing length, these are the first columns of the batch.
+  size_t ActiveColumns(const size_t begin,
+                       const size_t batchSize,
+                       const size_t t) const;
+
   /**
    * Iterate over all layers and reset the recurrent layers' states.  Prepare
    * each recurrent layer to store up to `memorySize` previous states, operating
@@ -375,6 +536,16 @@ class RNN
   //! The matrix of responses to the input data points.  This member is empty,
   //! except during training.
   arma::Cube<typename MatType::elem_type> responses;
+
+  //! The length of each sequence of `predictors`, when the sequences have
+  //! different lengths; otherwise, this member is empty.
+  arma::urowvec sequenceLengths;
+
+  //! The number of sequences streamed by `PredictStep()`.
+  size_t stateBatchSize;
+
+  //! The number of steps processed by `PredictStep()` since the last reset.
+  size_t stateSteps;
 }; // class RNNType
 
 } // namespace mlpack
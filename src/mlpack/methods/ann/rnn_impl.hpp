@@ -34,7 +34,9 @@ RNN<
     InitializationRuleType initializeRule) :
     bpttSteps(bpttSteps),
     single(single),
-    network(std::move(outputLayer), std::move(initializeRule))
+    network(std::move(outputLayer), std::move(initializeRule)),
+    stateBatchSize(0),
+    stateSteps(0)
 {
   /* Nothing to do here */
 }
@@ -52,7 +54,9 @@ RNN<
     const RNN& network) :
     bpttSteps(network.bpttSteps),
     single(network.single),
-    network(network.network)
+    network(network.network),
+    stateBatchSize(0),
+    stateSteps(0)
 {
   // Nothing else to do.
 }
@@ -70,7 +74,9 @@ RNN<
     RNN&& network) :
     bpttSteps(std::move(network.bpttSteps)),
     single(std::move(network.single)),
-    network(std::move(network.network))
+    network(std::move(network.network)),
+    stateBatchSize(network.stateBatchSize),
+    stateSteps(network.stateSteps)
 {
   // Nothing to do here.
 }
@@ -98,6 +104,9 @@ RNN<
     network = other.network;
     predictors.clear();
     responses.clear();
+    sequenceLengths.clear();
+    stateBatchSize = 0;
+    stateSteps = 0;
   }
 
   return *this;
@@ -126,6 +135,9 @@ RNN<
     network = std::move(other.network);
     predictors.clear();
     responses.clear();
+    sequenceLengths.clear();
+    stateBatchSize = 0;
+    stateSteps = 0;
   }
 
   return *this;
@@ -162,13 +174,72 @@ typename MatType::elem_type RNN<
     CallbackTypes&&... callbacks)
 {
   ResetData(std::move(predictors), std::move(responses));
+  return TrainModel(optimizer, callbacks...);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(
+    arma::Cube<typename MatType::elem_type> predictors,
+    const arma::urowvec& sequenceLengths,
+    arma::Cube<typename MatType::elem_type> responses,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  ResetData(std::move(predictors), sequenceLengths, std::move(responses));
+  return TrainModel(optimizer, callbacks...);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Train(
+    arma::Cube<typename MatType::elem_type> predictors,
+    const arma::urowvec& sequenceLengths,
+    arma::Cube<typename MatType::elem_type> responses,
+    CallbackTypes&&... callbacks)
+{
+  OptimizerType optimizer;
+  return Train(std::move(predictors), sequenceLengths, std::move(responses),
+      optimizer, callbacks...);
+}
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+template<typename OptimizerType, typename... CallbackTypes>
+typename MatType::elem_type RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::TrainModel(
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
   network.WarnMessageMaxIterations(optimizer, this->predictors.n_cols);
 
   // Ensure that the network can be used.
   network.CheckNetwork("RNN::Train()", this->predictors.n_rows, true, true);
 
   // Train the model.
+  MLPACK_PROFILE_SCOPE("rnn_optimization");
   Timer::Start("rnn_optimization");
   const typename MatType::elem_type out =
       optimizer.Optimize(*this, network.Parameters(), callbacks...);
@@ -249,6 +320,119 @@ void RNN<
   }
 }
 
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Predict(
+    const arma::Cube<typename MatType::elem_type>& predictors,
+    const arma::urowvec& sequenceLengths,
+    arma::Cube<typename MatType::elem_type>& results,
+    const size_t batchSize)
+{
+  CheckSequenceLengths("RNN::Predict()", predictors, sequenceLengths);
+
+  // Ensure that the network is configured correctly.
+  network.CheckNetwork("RNN::Predict()", predictors.n_rows, true, false);
+
+  // The steps after the end of each sequence are left at zero.
+  results.zeros(network.network.OutputSize(), predictors.n_cols,
+      predictors.n_slices);
+
+  MatType inputAlias, outputAlias;
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols) - i);
+    const size_t steps = sequenceLengths.subvec(i,
+        i + effectiveBatchSize - 1).max();
+
+    ResetMemoryState(1, effectiveBatchSize);
+    SetPreviousStep(size_t(-1));
+    SetCurrentStep(size_t(0));
+
+    MatType stepOutput(results.n_rows, effectiveBatchSize);
+    for (size_t t = 0; t < steps; ++t)
+    {
+      if (t == 1)
+        SetPreviousStep(size_t(0));
+
+      MakeAlias(inputAlias, predictors.slice(t), predictors.n_rows,
+          effectiveBatchSize, i * predictors.slice(t).n_rows);
+      network.Forward(inputAlias, stepOutput);
+
+      // Only keep the outputs of the sequences that are still running.
+      for (size_t j = 0; j < effectiveBatchSize; ++j)
+      {
+        if (t < sequenceLengths[i + j])
+          results.slice(t).col(i + j) = stepOutput.col(j);
+      }
+    }
+  }
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ResetState()
+{
+  // The recurrent layers are set up by the next call to PredictStep().
+  stateSteps = 0;
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::PredictStep(const MatType& input, MatType& output)
+{
+  if (stateSteps > 0 && input.n_cols != stateBatchSize)
+  {
+    std::ostringstream oss;
+    oss << "RNN::PredictStep(): input has " << input.n_cols << " columns, but "
+        << stateBatchSize << " sequences are being streamed; call "
+        << "ResetState() to start new sequences!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (stateSteps == 0)
+  {
+    // Start new sequences.  Only one memory cell is needed, since there is no
+    // backward pass.
+    network.CheckNetwork("RNN::PredictStep()", input.n_rows, true, false);
+    ResetMemoryState(1, input.n_cols);
+    SetPreviousStep(size_t(-1));
+    SetCurrentStep(size_t(0));
+    stateBatchSize = input.n_cols;
+  }
+  else if (stateSteps == 1)
+  {
+    // From now on, the recurrent layers read their previous state from the
+    // single memory cell, and overwrite it.
+    SetPreviousStep(size_t(0));
+  }
+
+  output.set_size(network.network.OutputSize(), input.n_cols);
+  network.network.Forward(input, output);
+  ++stateSteps;
+}
+
 template<
     typename OutputLayerType,
     typename InitializationRuleType,
@@ -310,6 +494,9 @@ void RNN<
       // middle of training and resume.
       predictors.clear();
       responses.clear();
+      sequenceLengths.clear();
+      stateBatchSize = 0;
+      stateSteps = 0;
     }
   #endif
 }
@@ -340,22 +527,27 @@ typename MatType::elem_type RNN<
   MatType output(network.network.OutputSize(), batchSize);
 
   typename MatType::elem_type loss = 0.0;
-  MatType stepData, responseData;
-  for (size_t t = 0; t < predictors.n_slices; ++t)
+  const size_t steps = Steps(begin);
+  MatType stepData, activeOutput, responseData;
+  for (size_t t = 0; t < steps; ++t)
   {
     if (t == 1)
       SetPreviousStep(0);
 
-    // Manually reset the data of the network to be an alias of the current time
-    // step.
-    MakeAlias(network.predictors, predictors.slice(t), predictors.n_rows,
-        batchSize, begin * predictors.slice(t).n_rows);
+    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
+        begin * predictors.slice(t).n_rows);
+    network.network.Forward(stepData, output);
+
+    // Only the sequences that are still running contribute to the loss.
+    const size_t active = ActiveColumns(begin, batchSize, t);
     const size_t responseStep = (single) ? 0 : t;
-    MakeAlias(network.responses, responses.slice(responseStep),
-        responses.n_rows, batchSize,
+    MakeAlias(activeOutput, output, output.n_rows, active);
+    MakeAlias(responseData, responses.slice(responseStep),
+        responses.n_rows, active,
         begin * responses.slice(responseStep).n_rows);
 
-    loss += network.Evaluate(output, begin, batchSize);
+    loss += network.outputLayer.Forward(activeOutput, responseData) +
+        network.network.Loss();
   }
 
   return loss;
@@ -399,60 +591,50 @@ typename MatType::elem_type RNN<
   typename MatType::elem_type loss = 0;
 
   // We must save anywhere between 1 and `bpttSteps` states, but we are limited
-  // by `predictors.n_slices`.
+  // by the number of steps of the batch.
+  const size_t steps = Steps(begin);
   const size_t effectiveBPTTSteps = std::max(size_t(1),
-      std::min(bpttSteps, size_t(predictors.n_slices)));
+      std::min(bpttSteps, steps));
 
   ResetMemoryState(effectiveBPTTSteps, batchSize);
   SetPreviousStep(size_t(-1));
   arma::Cube<typename MatType::elem_type> outputs(
       network.network.OutputSize(), batchSize, effectiveBPTTSteps);
 
-  // If `bpttSteps` is less than the number of time steps in the data, then for
-  // the first few steps, we won't actually need to hold onto any historical
-  // information, since BPTT will never go back that far.
-  const size_t extraSteps = (predictors.n_slices - effectiveBPTTSteps + 1);
-  MatType stepData, outputData, responseData;
-  for (size_t t = 0; t < std::min(size_t(predictors.n_slices), extraSteps); ++t)
+  // If `bpttSteps` is less than the number of time steps of the batch, then
+  // for the first few steps, we won't actually need to hold onto any
+  // historical information, since BPTT will never go back that far; these
+  // steps all use memory slot 0, and the steps used for BPTT use the
+  // following slots.
+  const size_t extraSteps = steps - effectiveBPTTSteps + 1;
+  auto slot = [extraSteps](const size_t t)
   {
-    SetCurrentStep(0);
-
-    // Make an alias of the step's data.
-    MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
-        begin * predictors.slice(t).n_rows);
-    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, outputs.n_cols);
-    network.network.Forward(stepData, outputData);
-
-    const size_t responseStep = (single) ? 0 : t;
-    MakeAlias(responseData, responses.slice(responseStep),
-        responses.n_rows, batchSize,
-        begin * responses.slice(responseStep).n_rows);
+    return (t < extraSteps) ? 0 : t - extraSteps + 1;
+  };
 
-    loss += network.outputLayer.Forward(outputData, responseData);
-
-    SetPreviousStep(0);
-  }
-
-  // Next, we reach the time steps that will be used for BPTT, for which we must
-  // preserve step data.
-  for (size_t t = extraSteps; t < predictors.n_slices; ++t)
+  MatType stepData, outputData, activeOutput, responseData;
+  for (size_t t = 0; t < steps; ++t)
   {
-    SetCurrentStep(t - extraSteps + 1);
+    SetCurrentStep(slot(t));
 
-    // Wrap a matrix around our data to avoid a copy.
+    // Make an alias of the step's data.
     MakeAlias(stepData, predictors.slice(t), predictors.n_rows, batchSize,
         begin * predictors.slice(t).n_rows);
-    MakeAlias(outputData, outputs.slice(t), outputs.n_rows, outputs.n_cols);
+    MakeAlias(outputData, outputs.slice(slot(t)), outputs.n_rows,
+        outputs.n_cols);
     network.network.Forward(stepData, outputData);
 
+    // Only the sequences that are still running contribute to the loss.
+    const size_t active = ActiveColumns(begin, batchSize, t);
     const size_t responseStep = (single) ? 0 : t;
+    MakeAlias(activeOutput, outputData, outputData.n_rows, active);
     MakeAlias(responseData, responses.slice(responseStep),
-        responses.n_rows, batchSize,
+        responses.n_rows, active,
         begin * responses.slice(responseStep).n_rows);
 
-    loss += network.outputLayer.Forward(outputData, responseData);
+    loss += network.outputLayer.Forward(activeOutput, responseData);
 
-    SetPreviousStep(t - extraSteps + 1);
+    SetPreviousStep(slot(t));
   }
 
   // Add loss (this is not dependent on time steps, and should only be added
@@ -466,45 +648,43 @@ typename MatType::elem_type RNN<
       network.Parameters().n_cols);
 
   SetPreviousStep(size_t(-1));
-  const size_t minStep = predictors.n_slices - effectiveBPTTSteps + 1;
-  for (size_t t = predictors.n_slices; t >= minStep; --t)
+  MatType error(outputs.n_rows, outputs.n_cols), activeError, networkDelta;
+  for (size_t t = steps; t >= extraSteps; --t)
   {
-    SetCurrentStep(t - 1);
+    SetCurrentStep(slot(t - 1));
 
     currentGradient.zeros();
-    MatType error(outputs.n_rows, outputs.n_cols);
 
     // Set up the response by backpropagating through the output layer.  Note
     // that if we are in 'single' mode, we don't care what the network outputs
     // until the input sequence is done, so there is no error for any timestep
-    // other than the first one.
-    if (single && (t - 1) < responses.n_slices - 1)
+    // other than the first one.  The sequences that already ended get no
+    // error either, so nothing is propagated back from their padding.
+    error.zeros();
+    if (!single || (t - 1) >= responses.n_slices - 1)
     {
-      error.zeros();
-    }
-    else
-    {
-      MakeAlias(outputData, outputs.slice(t - 1), outputs.n_rows,
-          outputs.n_cols);
+      const size_t active = ActiveColumns(begin, batchSize, t - 1);
       const size_t respStep = (single) ? 0 : t - 1;
+      MakeAlias(activeOutput, outputs.slice(slot(t - 1)), outputs.n_rows,
+          active);
+      MakeAlias(activeError, error, error.n_rows, active);
       MakeAlias(responseData, responses.slice(respStep), responses.n_rows,
-          batchSize, begin * responses.slice(respStep).n_rows);
-      network.outputLayer.Backward(outputData, responseData, error);
+          active, begin * responses.slice(respStep).n_rows);
+      network.outputLayer.Backward(activeOutput, responseData, activeError);
     }
 
     // Now pass that error backwards through the network.
     MakeAlias(stepData, predictors.slice(t - 1), predictors.n_rows, batchSize,
         begin * predictors.slice(t - 1).n_rows);
-    MakeAlias(outputData, outputs.slice(t - 1), outputs.n_rows,
+    MakeAlias(outputData, outputs.slice(slot(t - 1)), outputs.n_rows,
         outputs.n_cols);
 
-    MatType networkDelta;
     network.network.Backward(stepData, outputData, error, networkDelta);
 
     network.network.Gradient(stepData, error, currentGradient);
     gradient += currentGradient;
 
-    SetPreviousStep(t - 1);
+    SetPreviousStep(slot(t - 1));
   }
 
   return loss;
@@ -540,7 +720,32 @@ void RNN<
     MatType
 >::Shuffle()
 {
-  ShuffleData(predictors, responses, predictors, responses);
+  if (sequenceLengths.empty())
+  {
+    ShuffleData(predictors, responses, predictors, responses);
+    return;
+  }
+
+  // Only shuffle the columns of each run of sequences of the same length, so
+  // that the columns stay sorted by length.
+  arma::uvec ordering = arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+      predictors.n_cols);
+  for (size_t start = 0; start < predictors.n_cols; )
+  {
+    size_t end = start + 1;
+    while (end < predictors.n_cols &&
+        sequenceLengths[end] == sequenceLengths[start])
+      ++end;
+
+    ordering.subvec(start, end - 1) =
+        arma::shuffle(ordering.subvec(start, end - 1));
+    start = end;
+  }
+
+  for (size_t i = 0; i < predictors.n_slices; ++i)
+    predictors.slice(i) = predictors.slice(i).cols(ordering);
+  for (size_t i = 0; i < responses.n_slices; ++i)
+    responses.slice(i) = responses.slice(i).cols(ordering);
 }
 
 template<
@@ -558,6 +763,119 @@ void RNN<
 {
   this->predictors = std::move(predictors);
   this->responses = std::move(responses);
+  this->sequenceLengths.clear();
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ResetData(
+    arma::Cube<typename MatType::elem_type> predictors,
+    const arma::urowvec& sequenceLengths,
+    arma::Cube<typename MatType::elem_type> responses)
+{
+  CheckSequenceLengths("RNN::Train()", predictors, sequenceLengths);
+  if (responses.n_cols != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "RNN::Train(): number of responses (" << responses.n_cols << ") "
+        << "does not match number of sequences (" << predictors.n_cols
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Sort the sequences by decreasing length, so that the sequences of a batch
+  // have similar lengths.
+  const arma::uvec ordering = arma::stable_sort_index(sequenceLengths,
+      "descend");
+  for (size_t i = 0; i < predictors.n_slices; ++i)
+    predictors.slice(i) = predictors.slice(i).cols(ordering);
+  for (size_t i = 0; i < responses.n_slices; ++i)
+    responses.slice(i) = responses.slice(i).cols(ordering);
+
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->sequenceLengths = sequenceLengths.cols(ordering);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+void RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::CheckSequenceLengths(
+    const std::string& functionName,
+    const arma::Cube<typename MatType::elem_type>& predictors,
+    const arma::urowvec& sequenceLengths)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << functionName << ": number of sequence lengths ("
+        << sequenceLengths.n_elem << ") does not match number of sequences ("
+        << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (sequenceLengths.n_elem > 0 && (sequenceLengths.min() == 0 ||
+      sequenceLengths.max() > predictors.n_slices))
+  {
+    std::ostringstream oss;
+    oss << functionName << ": sequence lengths must be between 1 and the "
+        << "number of time steps (" << predictors.n_slices << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::Steps(const size_t begin) const
+{
+  // The columns are sorted by decreasing length, so the first column of the
+  // batch is the longest.
+  return sequenceLengths.empty() ? size_t(predictors.n_slices) :
+      size_t(sequenceLengths[begin]);
+}
+
+template<
+    typename OutputLayerType,
+    typename InitializationRuleType,
+    typename MatType
+>
+size_t RNN<
+    OutputLayerType,
+    InitializationRuleType,
+    MatType
+>::ActiveColumns(
+    const size_t begin,
+    const size_t batchSize,
+    const size_t t) const
+{
+  if (sequenceLengths.empty())
+    return batchSize;
+
+  size_t active = 0;
+  while (active < batchSize && sequenceLengths[begin + active] > t)
+    ++active;
+
+  return active;
 }
 
 template<
@@ -571,6 +889,9 @@ void RNN<
     MatType
 >::ResetMemoryState(const size_t memorySize, const size_t batchSize)
 {
+  // Any streamed state is lost.
+  stateSteps = 0;
+
   // Iterate over all layers and set the memory size.
   for (Layer<MatType>* l : network.Network())
   {
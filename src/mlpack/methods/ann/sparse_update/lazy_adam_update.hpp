@@ -0,0 +1,121 @@
+/**
+ * @file methods/ann/sparse_update/lazy_adam_update.hpp
+ *
+ * Definition of the LazyAdamUpdate class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_LAZY_ADAM_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_LAZY_ADAM_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A sparse update rule that takes a step of Adam on the given columns of a
+ * table.  The moment estimates of a column are only updated when the column
+ * is touched, so the work done per step depends on the number of columns
+ * touched and not on the size of the table ("lazy" Adam, as in TensorFlow's
+ * LazyAdamOptimizer).  The bias correction uses the number of calls to
+ * `Update()`, so a column that is rarely touched gets the same step as the
+ * others when it is.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Kingma2014,
+ *   author  = {Diederik P. Kingma and Jimmy Ba},
+ *   title   = {Adam: {A} Method for Stochastic Optimization},
+ *   journal = {CoRR},
+ *   year    = {2014},
+ *   url     = {http://arxiv.org/abs/1412.6980}
+ * }
+ * @endcode
+ */
+class LazyAdamUpdate
+{
+ public:
+  /**
+   * Create the update rule.
+   *
+   * @param beta1 Exponential decay rate for the first moment estimates.
+   * @param beta2 Exponential decay rate for the second moment estimates.
+   * @param epsilon Value used to initialise the mean squared gradient
+   *     parameter.
+   */
+  LazyAdamUpdate(const double beta1 = 0.9,
+                 const double beta2 = 0.999,
+                 const double epsilon = 1e-8);
+
+  /**
+   * Update the given columns of the table.  The moment estimates are
+   * (re)initialized to zero if they do not have the size of the table.
+   *
+   * @param table The table to update.
+   * @param stepSize Step size of the update.
+   * @param columns Indices of the columns of the table to update.
+   * @param gradients Gradient of each of the columns (one column each).
+   */
+  template<typename MatType>
+  void Update(MatType& table,
+              const double stepSize,
+              const arma::uvec& columns,
+              const MatType& gradients);
+
+  //! Get the decay rate of the first moment estimates.
+  double Beta1() const { return beta1; }
+  //! Modify the decay rate of the first moment estimates.
+  double& Beta1() { return beta1; }
+
+  //! Get the decay rate of the second moment estimates.
+  double Beta2() const { return beta2; }
+  //! Modify the decay rate of the second moment estimates.
+  double& Beta2() { return beta2; }
+
+  //! Get the value used to initialise the mean squared gradient parameter.
+  double Epsilon() const { return epsilon; }
+  //! Modify the value used to initialise the mean squared gradient parameter.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the number of updates taken so far.
+  size_t Iteration() const { return iteration; }
+
+  //! Get the first moment estimates (one column per column of the table).
+  const arma::mat& M() const { return m; }
+  //! Get the second moment estimates (one column per column of the table).
+  const arma::mat& V() const { return v; }
+
+  //! Serialize the update rule.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The decay rate of the first moment estimates.
+  double beta1;
+
+  //! The decay rate of the second moment estimates.
+  double beta2;
+
+  //! The value used to initialise the mean squared gradient parameter.
+  double epsilon;
+
+  //! The number of updates taken so far.
+  size_t iteration;
+
+  //! The first moment estimates.
+  arma::mat m;
+
+  //! The second moment estimates.
+  arma::mat v;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "lazy_adam_update_impl.hpp"
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file methods/ann/sparse_update/lazy_adam_update_impl.hpp
+ *
+ * Implementation of the LazyAdamUpdate class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_LAZY_ADAM_UPDATE_IMPL_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_LAZY_ADAM_UPDATE_IMPL_HPP
+
+// In case it hasn't been included.
+#include "lazy_adam_update.hpp"
+
+namespace mlpack {
+
+inline LazyAdamUpdate::LazyAdamUpdate(const double beta1,
+                                      const double beta2,
+                                      const double epsilon) :
+    beta1(beta1),
+    beta2(beta2),
+    epsilon(epsilon),
+    iteration(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+void LazyAdamUpdate::Update(MatType& table,
+                            const double stepSize,
+                            const arma::uvec& columns,
+                            const MatType& gradients)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  if (m.n_rows != table.n_rows || m.n_cols != table.n_cols)
+  {
+    m.zeros(table.n_rows, table.n_cols);
+    v.zeros(table.n_rows, table.n_cols);
+    iteration = 0;
+  }
+
+  ++iteration;
+  const double biasCorrection1 = 1.0 - std::pow(beta1, (double) iteration);
+  const double biasCorrection2 = 1.0 - std::pow(beta2, (double) iteration);
+  const double step = stepSize * std::sqrt(biasCorrection2) / biasCorrection1;
+
+  // Every column is touched at most once, so the columns can be updated in
+  // parallel.
+  #pragma omp parallel for
+  for (size_t i = 0; i < columns.n_elem; ++i)
+  {
+    const size_t c = columns[i];
+    for (size_t k = 0; k < table.n_rows; ++k)
+    {
+      const double g = (double) gradients(k, i);
+      m(k, c) = beta1 * m(k, c) + (1 - beta1) * g;
+      v(k, c) = beta2 * v(k, c) + (1 - beta2) * g * g;
+      table(k, c) -= ElemType(step * m(k, c) / (std::sqrt(v(k, c)) + epsilon));
+    }
+  }
+}
+
+template<typename Archive>
+void LazyAdamUpdate::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(beta1));
+  ar(CEREAL_NVP(beta2));
+  ar(CEREAL_NVP(epsilon));
+  ar(CEREAL_NVP(iteration));
+  ar(CEREAL_NVP(m));
+  ar(CEREAL_NVP(v));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file methods/ann/sparse_update/sparse_sgd_update.hpp
+ *
+ * Definition of the SparseSGDUpdate class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_SGD_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_SGD_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A sparse update rule that takes a step of vanilla SGD on the given columns of
+ * a table:
+ *
+ *   table.col(c) -= stepSize * gradient(c).
+ *
+ * Sparse update rules are used by layers that hold their own table of
+ * parameters, such as `Lookup`, so that only the columns touched by a batch
+ * are ever updated.  Any class with such an `Update()` function (and a
+ * `serialize()` function) can be used as a sparse update rule.
+ */
+class SparseSGDUpdate
+{
+ public:
+  /**
+   * Create the update rule.
+   */
+  SparseSGDUpdate()
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Update the given columns of the table.
+   *
+   * @param table The table to update.
+   * @param stepSize Step size of the update.
+   * @param columns Indices of the columns of the table to update.
+   * @param gradients Gradient of each of the columns (one column each).
+   */
+  template<typename MatType>
+  void Update(MatType& table,
+              const double stepSize,
+              const arma::uvec& columns,
+              const MatType& gradients)
+  {
+    for (size_t i = 0; i < columns.n_elem; ++i)
+      table.col(columns[i]) -= stepSize * gradients.col(i);
+  }
+
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */)
+  {
+    // Nothing to do.
+  }
+};
+
+} // namespace mlpack
+
+#endif
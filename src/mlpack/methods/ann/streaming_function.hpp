@@ -0,0 +1,145 @@
+/**
+ * @file methods/ann/streaming_function.hpp
+ *
+ * Definition of the StreamingFunction class, which lets an ensmallen optimizer
+ * train a network on a data set that is read chunk by chunk from a
+ * BatchSource.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STREAMING_FUNCTION_HPP
+#define MLPACK_METHODS_ANN_STREAMING_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <future>
+
+#include "batch_source.hpp"
+
+namespace mlpack {
+
+/**
+ * A StreamingFunction wraps a network, and presents the whole data set of a
+ * BatchSource to an ensmallen optimizer as one separable function, while only
+ * the chunk that holds the current batch is given to the network (with
+ * `ResetData()`).  The next chunk is loaded by a background thread while the
+ * network trains on the current one, so that the optimizer does not wait for
+ * I/O when it visits the points in order, as the SGD-type optimizers do.  A
+ * batch that spans two chunks is evaluated in two parts.
+ *
+ * `Shuffle()` draws a new order of the chunks, and each chunk is shuffled when
+ * it is loaded; since the whole data set is never in memory, points from
+ * different chunks are not mixed within a batch.
+ *
+ * This class is used by `FFN::Train(BatchSource&, ...)`, and is not generally
+ * meant to be used otherwise.
+ *
+ * @tparam NetworkType Type of the network to train.
+ * @tparam MatType Matrix type of the data.
+ */
+template<typename NetworkType, typename MatType = arma::mat>
+class StreamingFunction
+{
+ public:
+  /**
+   * Create the function, and give the first chunk to the network.
+   *
+   * @param network Network to train.
+   * @param source Source of the data set.
+   */
+  StreamingFunction(NetworkType& network, BatchSource<MatType>& source);
+
+  //! Wait for the background load, if there is one.
+  ~StreamingFunction();
+
+  //! Evaluate the objective over all the data.
+  typename MatType::elem_type Evaluate(const MatType& parameters);
+
+  //! Evaluate the objective on the given batch.
+  typename MatType::elem_type Evaluate(const MatType& parameters,
+                                       const size_t begin,
+                                       const size_t batchSize);
+
+  //! Evaluate the objective and the gradient over all the data.
+  typename MatType::elem_type EvaluateWithGradient(const MatType& parameters,
+                                                   MatType& gradient);
+
+  //! Evaluate the objective and the gradient on the given batch.
+  typename MatType::elem_type EvaluateWithGradient(const MatType& parameters,
+                                                   const size_t begin,
+                                                   MatType& gradient,
+                                                   const size_t batchSize);
+
+  //! Evaluate the gradient on the given batch.
+  void Gradient(const MatType& parameters,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize);
+
+  //! Return the number of separable functions (the number of points in the
+  //! whole data set).
+  size_t NumFunctions() const { return chunkBegin.back(); }
+
+  //! Shuffle the order of the chunks (and of the points in each chunk).
+  void Shuffle();
+
+  //! Get the number of chunks that were loaded.
+  size_t ChunksLoaded() const { return chunksLoaded; }
+
+ private:
+  //! A chunk of the data set, in the order its points are visited.
+  struct Chunk
+  {
+    MatType predictors;
+    MatType responses;
+  };
+
+  /**
+   * Make sure the network holds the chunk that contains the given point (of
+   * the current order of the data set), and return the index of that point in
+   * the chunk.
+   */
+  size_t Seek(const size_t point);
+
+  //! Start loading the chunk at the given position in the order.
+  void Prefetch(const size_t position);
+
+  //! Load the given chunk, and put its points in the given order.
+  static Chunk LoadChunk(BatchSource<MatType>& source,
+                         const size_t chunk,
+                         const arma::uvec& pointOrder);
+
+  //! Compute chunkBegin for the current order of the chunks.
+  void ComputeChunkBegin();
+
+  //! The network to train.
+  NetworkType& network;
+  //! The source of the data set.
+  BatchSource<MatType>& source;
+  //! The number of points in each chunk.
+  std::vector<size_t> chunkSizes;
+  //! The order in which the chunks are visited.
+  std::vector<size_t> order;
+  //! The first point of the chunk at each position of the order; the last
+  //! element is the number of points in the data set.
+  std::vector<size_t> chunkBegin;
+  //! Whether the points of each chunk are shuffled when it is loaded.
+  bool shuffle;
+  //! The position in the order of the chunk held by the network.
+  size_t current;
+  //! The chunk that is loaded in the background (or the number of chunks).
+  size_t pending;
+  //! The result of the background load.
+  std::future<Chunk> next;
+  //! The number of chunks that were loaded.
+  size_t chunksLoaded;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_function_impl.hpp"
+
+#endif
@@ -0,0 +1,260 @@
+/**
+ * @file methods/ann/streaming_function_impl.hpp
+ *
+ * Implementation of the StreamingFunction class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STREAMING_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_ANN_STREAMING_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_function.hpp"
+
+namespace mlpack {
+
+template<typename NetworkType, typename MatType>
+StreamingFunction<NetworkType, MatType>::StreamingFunction(
+    NetworkType& network,
+    BatchSource<MatType>& source) :
+    network(network),
+    source(source),
+    shuffle(false),
+    current(0),
+    pending(source.NumChunks()),
+    chunksLoaded(0)
+{
+  if (source.NumChunks() == 0)
+  {
+    throw std::invalid_argument("StreamingFunction::StreamingFunction(): the "
+        "batch source has no chunks!");
+  }
+
+  chunkSizes.resize(source.NumChunks());
+  order.resize(source.NumChunks());
+  for (size_t i = 0; i < source.NumChunks(); ++i)
+  {
+    chunkSizes[i] = source.ChunkSize(i);
+    order[i] = i;
+  }
+
+  ComputeChunkBegin();
+  if (NumFunctions() == 0)
+  {
+    throw std::invalid_argument("StreamingFunction::StreamingFunction(): the "
+        "batch source has no points!");
+  }
+
+  // The network needs data before training starts, so the first chunk is
+  // loaded right away.
+  Chunk chunk = LoadChunk(source, 0, arma::uvec());
+  network.ResetData(std::move(chunk.predictors), std::move(chunk.responses));
+  ++chunksLoaded;
+  if (order.size() > 1)
+    Prefetch(1);
+}
+
+template<typename NetworkType, typename MatType>
+StreamingFunction<NetworkType, MatType>::~StreamingFunction()
+{
+  if (next.valid())
+    next.wait();
+}
+
+template<typename NetworkType, typename MatType>
+typename MatType::elem_type StreamingFunction<NetworkType, MatType>::Evaluate(
+    const MatType& parameters)
+{
+  return Evaluate(parameters, 0, NumFunctions());
+}
+
+template<typename NetworkType, typename MatType>
+typename MatType::elem_type StreamingFunction<NetworkType, MatType>::Evaluate(
+    const MatType& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  typename MatType::elem_type objective = 0;
+  size_t done = 0;
+  while (done < batchSize)
+  {
+    const size_t localBegin = Seek(begin + done);
+    const size_t count = std::min(batchSize - done,
+        size_t(network.NumFunctions()) - localBegin);
+    objective += network.Evaluate(parameters, localBegin, count);
+    done += count;
+  }
+
+  return objective;
+}
+
+template<typename NetworkType, typename MatType>
+typename MatType::elem_type StreamingFunction<
+    NetworkType,
+    MatType
+>::EvaluateWithGradient(const MatType& parameters, MatType& gradient)
+{
+  return EvaluateWithGradient(parameters, 0, gradient, NumFunctions());
+}
+
+template<typename NetworkType, typename MatType>
+typename MatType::elem_type StreamingFunction<
+    NetworkType,
+    MatType
+>::EvaluateWithGradient(const MatType& parameters,
+                        const size_t begin,
+                        MatType& gradient,
+                        const size_t batchSize)
+{
+  typename MatType::elem_type objective = 0;
+  MatType chunkGradient;
+  size_t done = 0;
+  while (done < batchSize)
+  {
+    const size_t localBegin = Seek(begin + done);
+    const size_t count = std::min(batchSize - done,
+        size_t(network.NumFunctions()) - localBegin);
+
+    // Only a batch that spans two chunks needs a second gradient.
+    if (done == 0)
+    {
+      objective += network.EvaluateWithGradient(parameters, localBegin,
+          gradient, count);
+    }
+    else
+    {
+      objective += network.EvaluateWithGradient(parameters, localBegin,
+          chunkGradient, count);
+      gradient += chunkGradient;
+    }
+
+    done += count;
+  }
+
+  return objective;
+}
+
+template<typename NetworkType, typename MatType>
+void StreamingFunction<NetworkType, MatType>::Gradient(
+    const MatType& parameters,
+    const size_t begin,
+    MatType& gradient,
+    const size_t batchSize)
+{
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename NetworkType, typename MatType>
+void StreamingFunction<NetworkType, MatType>::Shuffle()
+{
+  shuffle = true;
+
+  const arma::uvec newOrder = arma::randperm<arma::uvec>(order.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = newOrder[i];
+  ComputeChunkBegin();
+
+  // If the network already holds the first chunk of the new order, it is
+  // shuffled in place; otherwise, the first chunk is needed next.
+  if (order[0] == current)
+  {
+    network.Shuffle();
+    if (order.size() > 1)
+      Prefetch(1);
+  }
+  else
+  {
+    Prefetch(0);
+  }
+}
+
+template<typename NetworkType, typename MatType>
+size_t StreamingFunction<NetworkType, MatType>::Seek(const size_t point)
+{
+  const size_t position = std::upper_bound(chunkBegin.begin(),
+      chunkBegin.end(), point) - chunkBegin.begin() - 1;
+  if (order[position] != current)
+  {
+    Chunk chunk;
+    if (next.valid() && pending == order[position])
+    {
+      chunk = next.get();
+    }
+    else
+    {
+      // The optimizer did not visit the chunks in order, so the background
+      // load is of no use.
+      if (next.valid())
+        next.wait();
+
+      arma::uvec pointOrder;
+      if (shuffle)
+      {
+        pointOrder = arma::randperm<arma::uvec>(chunkSizes[order[position]]);
+      }
+      chunk = LoadChunk(source, order[position], pointOrder);
+    }
+
+    pending = order.size();
+    network.ResetData(std::move(chunk.predictors),
+        std::move(chunk.responses));
+    current = order[position];
+    ++chunksLoaded;
+
+    if (order.size() > 1)
+      Prefetch((position + 1) % order.size());
+  }
+
+  return point - chunkBegin[position];
+}
+
+template<typename NetworkType, typename MatType>
+void StreamingFunction<NetworkType, MatType>::Prefetch(const size_t position)
+{
+  // Only one chunk is loaded at a time.
+  if (next.valid())
+    next.wait();
+
+  const size_t chunk = order[position];
+  arma::uvec pointOrder;
+  if (shuffle)
+    pointOrder = arma::randperm<arma::uvec>(chunkSizes[chunk]);
+
+  pending = chunk;
+  next = std::async(std::launch::async, &StreamingFunction::LoadChunk,
+      std::ref(source), chunk, std::move(pointOrder));
+}
+
+template<typename NetworkType, typename MatType>
+typename StreamingFunction<NetworkType, MatType>::Chunk
+StreamingFunction<NetworkType, MatType>::LoadChunk(
+    BatchSource<MatType>& source,
+    const size_t chunk,
+    const arma::uvec& pointOrder)
+{
+  Chunk result;
+  source.Load(chunk, result.predictors, result.responses);
+  if (!pointOrder.is_empty())
+  {
+    result.predictors = result.predictors.cols(pointOrder);
+    result.responses = result.responses.cols(pointOrder);
+  }
+
+  return result;
+}
+
+template<typename NetworkType, typename MatType>
+void StreamingFunction<NetworkType, MatType>::ComputeChunkBegin()
+{
+  chunkBegin.resize(order.size() + 1);
+  chunkBegin[0] = 0;
+  for (size_t i = 0; i < order.size(); ++i)
+    chunkBegin[i + 1] = chunkBegin[i] + chunkSizes[order[i]];
+}
+
+} // namespace mlpack
+
+#endif
@@ -82,6 +82,10 @@ class DrusillaSelect
    * the k'th row in that column will refer to the k'th candidate neighbor or
    * distance for that query point.
    *
+   * The distances to the candidates are computed with a matrix product for
+   * each block of query points, and the blocks are searched in parallel with
+   * OpenMP (if it is available).
+   *
    * @param querySet Set of query points to search.
    * @param k Number of furthest neighbors to search for.
    * @param neighbors Matrix to store resulting neighbors in.
@@ -16,9 +16,6 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -178,23 +175,76 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, EuclideanDistance,
-      KDTree<EuclideanDistance, EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  typedef typename MatType::elem_type ElemType;
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
 
-  rules.GetResults(neighbors, distances);
+  // The squared norms of the candidates, so that the squared distances to a
+  // block of query points can be found with one matrix product.
+  arma::Col<ElemType> candidateNorms(candidateSet.n_cols);
+  for (size_t r = 0; r < candidateSet.n_cols; ++r)
+    candidateNorms[r] = arma::dot(candidateSet.col(r), candidateSet.col(r));
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+  // Each block of query points is handled independently.
+  const size_t blockSize = 64;
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+
+    // Squared distances between each candidate and each query point, up to the
+    // squared norm of the query point (which does not change the order).
+    arma::Mat<ElemType> scores(candidateSet.t() * querySet.cols(begin,
+        end - 1));
+    scores *= -2;
+    scores.each_col() += candidateNorms;
+
+    std::vector<std::pair<double, size_t>> candidates;
+    std::vector<double> sortedScores(candidateSet.n_cols);
+    for (size_t q = begin; q < end; ++q)
+    {
+      // Find the k-th largest score; every candidate whose score is close
+      // enough to it (or larger) is then checked with the exact distance, so
+      // that rounding errors in the matrix product can't change the results.
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        sortedScores[r] = scores(r, q - begin);
+      std::nth_element(sortedScores.begin(), sortedScores.begin() + (k - 1),
+          sortedScores.end(), std::greater<double>());
+      const double kthScore = sortedScores[k - 1];
+      const double tolerance = 1e-8 * (std::abs(kthScore) +
+          std::abs(sortedScores[0]) + 1.0);
+
+      candidates.clear();
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+      {
+        if (scores(r, q - begin) >= kthScore - tolerance)
+        {
+          candidates.push_back(std::make_pair(EuclideanDistance::Evaluate(
+              querySet.col(q), candidateSet.col(r)), r));
+        }
+      }
+
+      // Take the k furthest candidates.
+      std::partial_sort(candidates.begin(), candidates.begin() + k,
+          candidates.end(), [](const std::pair<double, size_t>& a,
+                               const std::pair<double, size_t>& b)
+          {
+            return (a.first > b.first) ||
+                (a.first == b.first && a.second < b.second);
+          });
+
+      // Map the neighbors back to their original indices in the reference
+      // set.
+      for (size_t j = 0; j < k; ++j)
+      {
+        neighbors(j, q) = candidateIndices[candidates[j].second];
+        distances(j, q) = candidates[j].first;
+      }
+    }
+  }
 }
 
 //! Serialize the model.
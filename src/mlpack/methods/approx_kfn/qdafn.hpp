@@ -70,7 +70,9 @@ class QDAFN
    * Search for the k furthest neighbors of the given query set.  (The query set
    * can contain just one point, that is okay.)  The results will be stored in
    * the given neighbors and distances matrices, in the same format as the
-   * mlpack NeighborSearch and LSHSearch classes.
+   * mlpack NeighborSearch and LSHSearch classes.  The query points are
+   * projected onto all of the lines with one matrix product, and are then
+   * searched in parallel with OpenMP (if it is available).
    */
   void Search(const MatType& querySet,
               const size_t k,
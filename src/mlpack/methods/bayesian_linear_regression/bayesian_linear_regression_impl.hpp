@@ -103,21 +103,29 @@ BayesianLinearRegression<ModelMatType>::Train(
 
   ModelMatType phi;
   DenseRowType t;
-  DenseVecType eigVal;
-  ModelMatType eigVec;
+  ModelMatType u, v;
+  DenseVecType s;
 
   // Preprocess the data. Center and scale.
   responsesOffset = CenterScaleData(data, responses, phi, t);
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  // The thin SVD phi = U S V^T gives the eigendecomposition of phi * phi^T
+  // (eigenvectors U, eigenvalues S^2; all other eigenvalues are zero) in
+  // O(d n min(d, n)) time, which is much cheaper than the d x d
+  // eigendecomposition for wide data.  The evidence maximization is then
+  // done entirely in the eigenbasis, in O(min(d, n)) time per iteration.
+  if (!arma::svd_econ(u, s, v, phi))
   {
-    Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
-               << "of covariance failed!" << std::endl;
+    Log::Fatal << "BayesianLinearRegression::Train(): SVD of the data "
+               << "failed!" << std::endl;
   }
 
-  // Compute this quantities once and for all.
-  const ModelMatType eigVecInv = inv(eigVec);
-  const DenseVecType eigVecInvPhitT = eigVecInv * phi * t.t();
+  // Compute these quantities once and for all: the eigenvalues, the
+  // coordinates of the responses in the basis V, and the squared norm of the
+  // part of the responses that the model cannot fit.
+  const DenseVecType eigVal = square(s);
+  const DenseVecType vt = v.t() * t.t();
+  const ElemType outsideNorm = accu(square(t - vt.t() * v.t()));
 
   // Initialize the hyperparameters and begin with an infinitely broad prior.
   alpha = ((ElemType) 1e-6);
@@ -125,22 +133,27 @@ BayesianLinearRegression<ModelMatType>::Train(
 
   unsigned short i = 0;
   ElemType crit = ((ElemType) 1.0);
+  DenseVecType omegaEig(s.n_elem, arma::fill::zeros);
 
   while (((double) crit > tolerance) && (i < maxIterations))
   {
     ElemType deltaAlpha = -alpha;
     ElemType deltaBeta = -beta;
 
-    // Update the solution.
-    omega = eigVec * diagmat(1 / (eigVal + (alpha / beta))) * eigVecInvPhitT;
+    // Update the solution, omega = U * omegaEig.
+    const ElemType lambda = alpha / beta;
+    const DenseVecType shrinkage = ((ElemType) 1) / (eigVal + lambda);
+    omegaEig = s % vt % shrinkage;
 
     // Update alpha.
-    gamma = sum(eigVal / (alpha / beta + eigVal));
-    alpha = gamma / dot(omega, omega);
+    gamma = sum(eigVal % shrinkage);
+    alpha = gamma / dot(omegaEig, omegaEig);
 
-    // Update beta.
-    const DenseRowType temp = t - omega.t() * phi;
-    beta = (data.n_cols - gamma) / dot(temp, temp);
+    // Update beta.  In the basis V, the residual t - omega^T phi is
+    // lambda * vt / (eigVal + lambda).
+    const DenseVecType residualEig = lambda * vt % shrinkage;
+    beta = (data.n_cols - gamma) /
+        (outsideNorm + dot(residualEig, residualEig));
 
     // Compute the stopping criterion.
     deltaAlpha += alpha;
@@ -148,9 +161,14 @@ BayesianLinearRegression<ModelMatType>::Train(
     crit = std::abs(deltaAlpha / alpha + deltaBeta / beta);
     i++;
   }
-  // Compute the covariance matrix for the uncertainties later.
-  matCovariance = eigVec * diagmat(((ElemType) 1) / (beta * eigVal + alpha)) *
-      eigVecInv;
+  omega = u * omegaEig;
+
+  // Compute the covariance matrix for the uncertainties later.  The
+  // directions orthogonal to U have eigenvalue zero, so their variance is
+  // 1 / alpha.
+  matCovariance = u * diagmat(((ElemType) 1) / (beta * eigVal + alpha) -
+      ((ElemType) 1) / alpha) * u.t();
+  matCovariance.diag() += ((ElemType) 1) / alpha;
 
   return RMSE(data, responses);
 }
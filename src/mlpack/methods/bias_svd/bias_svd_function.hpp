@@ -17,6 +17,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <ensmallen.hpp>
+#include <mlpack/methods/regularized_svd/stratified_sgd.hpp>
 
 namespace mlpack {
 
@@ -100,6 +101,23 @@ class BiasSVDFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Take one SGD step on a single rating, updating only the parameters of the
+   * given user and item.  This is used by the parallel SGD optimizer; it does
+   * not depend on the order of the dataset.
+   *
+   * @param parameters Parameters(user/item matrices/bias) of the decomposition.
+   * @param user User of the rating.
+   * @param item Item of the rating.
+   * @param rating Value of the rating.
+   * @param stepSize Step size of the update.
+   */
+  void UpdateRating(MatType& parameters,
+                    const size_t user,
+                    const size_t item,
+                    const double rating,
+                    const double stepSize) const;
+
   //! Return the initial point for the optimization.
   const MatType& GetInitialPoint() const { return initialPoint; }
 
@@ -144,7 +162,8 @@ namespace ens {
    * Template specialization for the SGD and parallel SGD optimizer. Used
    * because the gradient affects only a small number of parameters per example,
    * and thus the normal abstraction does not work as fast as we might like it
-   * to.
+   * to.  The parallel SGD specializations use mlpack::StratifiedSGD, so the
+   * threadShareSize parameter of ParallelSGD is not used.
    */
   template <>
   template <>
@@ -158,6 +177,12 @@ namespace ens {
       mlpack::BiasSVDFunction<arma::mat>& function,
       arma::mat& parameters);
 
+  template <>
+  template <>
+  inline double ParallelSGD<ConstantStep>::Optimize(
+      mlpack::BiasSVDFunction<arma::mat>& function,
+      arma::mat& parameters);
+
 } // namespace ens
 
 #include "bias_svd_function_impl.hpp"
@@ -177,6 +177,33 @@ void BiasSVDFunction<MatType>::Gradient(const MatType& parameters,
   }
 }
 
+template <typename MatType>
+void BiasSVDFunction<MatType>::UpdateRating(MatType& parameters,
+                                            const size_t user,
+                                            const size_t item,
+                                            const double rating,
+                                            const double stepSize) const
+{
+  // The biases are stored in the last row of the parameters.
+  double* userVec = parameters.colptr(user);
+  double* itemVec = parameters.colptr(numUsers + item);
+
+  double ratingError = rating - userVec[rank] - itemVec[rank];
+  for (size_t j = 0; j < rank; ++j)
+    ratingError -= userVec[j] * itemVec[j];
+
+  for (size_t j = 0; j < rank; ++j)
+  {
+    const double userValue = userVec[j];
+    userVec[j] -= stepSize * 2 * (lambda * userValue -
+        ratingError * itemVec[j]);
+    itemVec[j] -= stepSize * 2 * (lambda * itemVec[j] -
+        ratingError * userValue);
+  }
+  userVec[rank] -= stepSize * 2 * (lambda * userVec[rank] - ratingError);
+  itemVec[rank] -= stepSize * 2 * (lambda * itemVec[rank] - ratingError);
+}
+
 } // namespace mlpack
 
 // Template specialization for the SGD optimizer.
@@ -262,117 +289,22 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     mlpack::BiasSVDFunction<arma::mat>& function,
     arma::mat& iterate)
 {
-  double overallObjective = DBL_MAX;
-  double lastObjective;
-
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
-  const size_t numUsers = function.NumUsers();
-  const double lambda = function.Lambda();
-
-  // Rank of decomposition.
-  const size_t rank = function.Rank();
-
-  // Iterate till the objective is within tolerance or the maximum number of
-  // allowed iterations is reached. If maxIterations is 0, this will iterate
-  // till convergence.
-  for (size_t i = 1; i != maxIterations; ++i)
-  {
-    // Calculate the overall objective.
-    lastObjective = overallObjective;
-    overallObjective = 0;
-
-    #pragma omp parallel for reduction(+:overallObjective)
-    for (size_t j = 0; j < (size_t) function.NumFunctions(); ++j)
-    {
-      overallObjective += function.Evaluate(iterate, j);
-    }
-
-    // Output current objective function.
-    mlpack::Log::Info << "Parallel SGD: iteration " << i << ", objective "
-        << overallObjective << "." << std::endl;
-
-    if (std::isnan(overallObjective) || std::isinf(overallObjective))
-    {
-      mlpack::Log::Warn << "Parallel SGD: converged to " << overallObjective
-          << "; terminating with failure. Try a smaller step size?"
-          << std::endl;
-      return overallObjective;
-    }
-
-    if (std::abs(lastObjective - overallObjective) < tolerance)
-    {
-      mlpack::Log::Info << "SGD: minimized within tolerance " << tolerance
-          << "; terminating optimization." << std::endl;
-      return overallObjective;
-    }
-
-    // Get the stepsize for this iteration
-    double stepSize = decayPolicy.StepSize(i);
-
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::RandGen());
-
-    #pragma omp parallel
-    {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef MLPACK_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
-      {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        double ratingError = rating - userBias - itemBias -
-            dot(iterate.col(user).subvec(0, rank - 1),
-                      iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * iterate.col(user).subvec(0, rank - 1));
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-      }
-    }
-  }
-  mlpack::Log::Info << "\n Parallel SGD terminated with objective : "
-    << overallObjective << std::endl;
+  const mlpack::StratifiedSGD sgd(function.Dataset(), function.NumUsers(),
+      function.NumItems());
+  return sgd.Optimize(function, iterate, maxIterations, tolerance, shuffle,
+      decayPolicy);
+}
 
-  return overallObjective;
+template <>
+template <>
+inline double ParallelSGD<ConstantStep>::Optimize(
+    mlpack::BiasSVDFunction<arma::mat>& function,
+    arma::mat& iterate)
+{
+  const mlpack::StratifiedSGD sgd(function.Dataset(), function.NumUsers(),
+      function.NumItems());
+  return sgd.Optimize(function, iterate, maxIterations, tolerance, shuffle,
+      decayPolicy);
 }
 
 } // namespace ens
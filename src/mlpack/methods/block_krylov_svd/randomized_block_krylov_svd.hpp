@@ -53,6 +53,26 @@ namespace mlpack {
  * // Use the Apply() method to get a factorization.
  * bSVD.Apply(data, u, s, v, rank);
  * @endcode
+ *
+ * Each block of the Krylov subspace is orthogonalized against the previous
+ * blocks as soon as it is computed.  Directions that are already spanned by the
+ * previous blocks are dropped, and the iteration stops when no new direction is
+ * left, which happens when the rank of the data is less than the size of the
+ * subspace.  If a tolerance is given, the iteration also stops as soon as the
+ * top `rank` Ritz values (the approximate singular values) change by less than
+ * the tolerance, relative to their norm, from one block to the next.
+ *
+ * The data may be sparse (e.g. `arma::sp_mat`), in which case the products with
+ * the data are computed in parallel with OpenMP.  When the rank of the
+ * decomposition must be increased, the Krylov basis of a previous call can be
+ * passed to Apply(); it is extended instead of being recomputed:
+ *
+ * @code
+ * arma::mat basis;
+ * bSVD.Apply(data, u, s, v, 10, basis);
+ * // Some time later...
+ * bSVD.Apply(data, u, s, v, 20, basis);
+ * @endcode
  */
 class RandomizedBlockKrylovSVD
 {
@@ -68,6 +88,8 @@ class RandomizedBlockKrylovSVD
    *        (Default: 2).
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param tolerance Relative change of the Ritz values below which the
+   *        iteration stops early (Default: 0, which performs all iterations).
    */
   template<typename InMatType, typename MatType, typename VecType>
   RandomizedBlockKrylovSVD(const InMatType& data,
@@ -76,7 +98,8 @@ class RandomizedBlockKrylovSVD
                            MatType& v,
                            const size_t maxIterations = 2,
                            const size_t rank = 0,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const double tolerance = 0.0);
 
   /**
    * Create object for the randomized block krylov SVD method.
@@ -84,9 +107,12 @@ class RandomizedBlockKrylovSVD
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param tolerance Relative change of the Ritz values below which the
+   *        iteration stops early (Default: 0, which performs all iterations).
    */
   RandomizedBlockKrylovSVD(const size_t maxIterations = 2,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const double tolerance = 0.0);
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
@@ -105,6 +131,28 @@ class RandomizedBlockKrylovSVD
              MatType& v,
              const size_t rank);
 
+  /**
+   * Apply the randomized block krylov SVD to the provided data set, starting
+   * from the given Krylov basis.  If `basis` is empty, a new basis is built;
+   * otherwise, it must be the basis computed by a previous call with the same
+   * data, and up to MaxIterations() + 1 more blocks are added to it.  On
+   * return, `basis` holds the orthonormal basis of the Krylov subspace.
+   *
+   * @param data Data matrix.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param basis Krylov basis to extend, and on return, the extended basis.
+   */
+  template<typename InMatType, typename MatType, typename VecType>
+  void Apply(const InMatType& data,
+             MatType& u,
+             VecType& s,
+             MatType& v,
+             const size_t rank,
+             MatType& basis);
+
   //! Get the number of iterations for the power method.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the number of iterations for the power method.
@@ -115,12 +163,27 @@ class RandomizedBlockKrylovSVD
   //! Modify the block size.
   size_t& BlockSize() { return blockSize; }
 
+  //! Get the tolerance on the relative change of the Ritz values.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the relative change of the Ritz values.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of blocks added to the Krylov basis by the last call to
+  //! Apply().
+  size_t Blocks() const { return blocks; }
+
  private:
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
   //! The block size value.
   size_t blockSize;
+
+  //! The tolerance on the relative change of the Ritz values.
+  double tolerance;
+
+  //! The number of blocks added by the last call to Apply().
+  size_t blocks;
 };
 
 } // namespace mlpack
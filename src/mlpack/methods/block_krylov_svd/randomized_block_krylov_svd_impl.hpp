@@ -16,6 +16,102 @@
 
 namespace mlpack {
 
+namespace details {
+
+/**
+ * Compute out = data * x for dense data.
+ */
+template<typename InMatType, typename MatType>
+void BlockKrylovTimes(
+    const InMatType& data,
+    const MatType& x,
+    MatType& out,
+    const std::enable_if_t<!arma::is_SpMat<InMatType>::value>* = 0)
+{
+  out = data * x;
+}
+
+/**
+ * Compute out = data * x for sparse data; each column of the output is
+ * computed by one thread.
+ */
+template<typename InMatType, typename MatType>
+void BlockKrylovTimes(
+    const InMatType& data,
+    const MatType& x,
+    MatType& out,
+    const std::enable_if_t<arma::is_SpMat<InMatType>::value>* = 0)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  data.sync();
+  out.zeros(data.n_rows, x.n_cols);
+
+  #pragma omp parallel for num_threads(Parallel::Threads())
+  for (size_t j = 0; j < (size_t) x.n_cols; ++j)
+  {
+    ElemType* outCol = out.colptr(j);
+    const ElemType* xCol = x.colptr(j);
+    for (size_t c = 0; c < (size_t) data.n_cols; ++c)
+    {
+      const ElemType xc = xCol[c];
+      if (xc == ElemType(0))
+        continue;
+
+      for (size_t k = data.col_ptrs[c]; k < data.col_ptrs[c + 1]; ++k)
+        outCol[data.row_indices[k]] += ElemType(data.values[k]) * xc;
+    }
+  }
+}
+
+/**
+ * Compute out = x.t() * data for dense data.
+ */
+template<typename InMatType, typename MatType>
+void BlockKrylovTransTimes(
+    const InMatType& data,
+    const MatType& x,
+    MatType& out,
+    const std::enable_if_t<!arma::is_SpMat<InMatType>::value>* = 0)
+{
+  out = x.t() * data;
+}
+
+/**
+ * Compute out = x.t() * data for sparse data; the columns of the output are
+ * split between the threads.
+ */
+template<typename InMatType, typename MatType>
+void BlockKrylovTransTimes(
+    const InMatType& data,
+    const MatType& x,
+    MatType& out,
+    const std::enable_if_t<arma::is_SpMat<InMatType>::value>* = 0)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  data.sync();
+  // The rows of x are the columns of xt, which are contiguous.
+  const MatType xt = x.t();
+  out.zeros(x.n_cols, data.n_cols);
+
+  #pragma omp parallel for num_threads(Parallel::Threads()) \
+      schedule(dynamic, 64)
+  for (size_t c = 0; c < (size_t) data.n_cols; ++c)
+  {
+    ElemType* outCol = out.colptr(c);
+    for (size_t k = data.col_ptrs[c]; k < data.col_ptrs[c + 1]; ++k)
+    {
+      const ElemType value = data.values[k];
+      const ElemType* xRow = xt.colptr(data.row_indices[k]);
+      for (size_t i = 0; i < (size_t) xt.n_rows; ++i)
+        outCol[i] += value * xRow[i];
+    }
+  }
+}
+
+} // namespace details
+
 template<typename InMatType, typename MatType, typename VecType>
 inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
     const InMatType& data,
@@ -24,9 +120,12 @@ inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
     MatType& v,
     const size_t maxIterations,
     const size_t rank,
-    const size_t blockSize) :
+    const size_t blockSize,
+    const double tolerance) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    tolerance(tolerance),
+    blocks(0)
 {
   if (rank == 0)
   {
@@ -40,9 +139,12 @@ inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
 
 inline RandomizedBlockKrylovSVD::RandomizedBlockKrylovSVD(
     const size_t maxIterations,
-    const size_t blockSize) :
+    const size_t blockSize,
+    const double tolerance) :
     maxIterations(maxIterations),
-    blockSize(blockSize)
+    blockSize(blockSize),
+    tolerance(tolerance),
+    blocks(0)
 {
   /* Nothing to do here */
 }
@@ -54,50 +156,122 @@ inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
                                             MatType& v,
                                             const size_t rank)
 {
-  MatType Q, R, block, blockIteration;
+  MatType basis;
+  Apply(data, u, s, v, rank, basis);
+}
+
+template<typename InMatType, typename MatType, typename VecType>
+inline void RandomizedBlockKrylovSVD::Apply(const InMatType& data,
+                                            MatType& u,
+                                            VecType& s,
+                                            MatType& v,
+                                            const size_t rank,
+                                            MatType& basis)
+{
+  typedef typename MatType::elem_type ElemType;
 
-  if (blockSize == 0)
+  if (!basis.is_empty() && basis.n_rows != data.n_rows)
   {
-    // The block size cannot be greater than the number of points in the
-    // dataset or the dimensionality of the dataset.
-    blockSize = std::min((size_t) data.n_rows, std::min((size_t) data.n_cols,
-        rank + 10));
+    std::ostringstream oss;
+    oss << "RandomizedBlockKrylovSVD::Apply(): the given basis has "
+        << basis.n_rows << " rows, but the data has " << data.n_rows
+        << " rows!";
+    throw std::invalid_argument(oss.str());
   }
 
-  // Random block initialization.
-  MatType G = arma::randn<MatType>(data.n_cols, blockSize);
+  // The block size cannot be greater than the number of points in the
+  // dataset or the dimensionality of the dataset.
+  const size_t currentBlockSize = (blockSize != 0) ? blockSize :
+      std::min((size_t) data.n_rows, std::min((size_t) data.n_cols,
+      rank + 10));
 
-  // Construct and orthonormalize Krylov subspace.
-  MatType K(data.n_rows, blockSize * (maxIterations + 1));
+  // The rows of projection are basis.t() * data; the singular values of the
+  // projection are the Ritz values.
+  MatType projection, block, blockProjection, G;
+  if (basis.is_empty())
+  {
+    // Random block initialization.
+    G = arma::randn<MatType>(data.n_cols, currentBlockSize);
+    details::BlockKrylovTimes(data, G, block);
+    basis.set_size(data.n_rows, 0);
+    projection.set_size(0, data.n_cols);
+  }
+  else
+  {
+    // Continue the iteration from the last block of the given basis, adding
+    // random directions if the block size has grown.
+    details::BlockKrylovTransTimes(data, basis, projection);
+    const size_t lastBlockSize = std::min(currentBlockSize,
+        (size_t) basis.n_cols);
+    G = projection.tail_rows(lastBlockSize).t();
+    if (lastBlockSize < currentBlockSize)
+    {
+      G = arma::join_rows(G, arma::randn<MatType>(data.n_cols,
+          currentBlockSize - lastBlockSize));
+    }
+    details::BlockKrylovTimes(data, G, block);
+  }
 
-  // Create a working matrix using data from writable auxiliary memory
-  // (K matrix). Doing so avoids an unnecessary copy in upcoming step.
-  MakeAlias(block, K, data.n_rows, blockSize, false);
-  arma::qr_econ(block, R, data * G);
+  const ElemType threshold = 10 * std::numeric_limits<ElemType>::epsilon() *
+      std::max(data.n_rows, data.n_cols);
 
-  for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
-      blockOffset += block.n_elem)
+  MatType Q, R;
+  arma::Col<ElemType> ritzValues, lastRitzValues;
+  blocks = 0;
+  while (blocks < maxIterations + 1)
   {
-    // Temporary working matrix to store the result in the correct place.
-    MakeAlias(blockIteration, K, block.n_rows, block.n_cols, blockOffset,
-        false);
+    // Orthogonalize the new block against the basis; this is done twice, for
+    // numerical stability.
+    const ElemType scale = arma::max(arma::sqrt(arma::sum(
+        arma::square(block), 0)));
+    for (size_t i = 0; i < 2 && basis.n_cols > 0; ++i)
+      block -= basis * (basis.t() * block);
 
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
+    arma::qr_econ(Q, R, block);
 
-    // Update working matrix for the next iteration.
-    MakeAlias(block, K, block.n_rows, block.n_cols, blockOffset,
-        false);
-  }
+    // Directions with a negligible residual are already in the span of the
+    // basis (or are zero), so they carry no new information.
+    const arma::uvec newDirections = arma::find(arma::abs(R.diag()) >
+        threshold * scale);
+    if (newDirections.n_elem == 0)
+      break;
+    if (newDirections.n_elem < Q.n_cols)
+      Q = Q.cols(newDirections);
+
+    details::BlockKrylovTransTimes(data, Q, blockProjection);
+    basis = arma::join_rows(basis, Q);
+    projection = arma::join_cols(projection, blockProjection);
+    ++blocks;
 
-  arma::qr_econ(Q, R, K);
+    // Stop early if the top Ritz values have converged.
+    if (tolerance > 0.0 && projection.n_rows >= rank)
+    {
+      arma::svd(ritzValues, projection);
+      ritzValues = ritzValues.head(std::min((size_t) ritzValues.n_elem,
+          rank));
+      if (lastRitzValues.n_elem == ritzValues.n_elem &&
+          arma::norm(ritzValues - lastRitzValues) <=
+          tolerance * arma::norm(ritzValues))
+        break;
+
+      lastRitzValues = ritzValues;
+    }
+
+    // The next block of the Krylov subspace is data * data.t() * Q.
+    if (blocks < maxIterations + 1)
+    {
+      G = blockProjection.t();
+      details::BlockKrylovTimes(data, G, block);
+    }
+  }
 
   // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
-  arma::svd_econ(u, s, v, Q.t() * data);
+  arma::svd_econ(u, s, v, projection);
 
   // Do economical singular value decomposition and compute only the
   // approximations of the left singular vectors by using the centered data
   // applied to Q.
-  u = Q * u;
+  u = basis * u;
 }
 
 } // namespace mlpack
@@ -19,12 +19,15 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
 #include <mlpack/methods/amf/amf.hpp>
 
 #include "normalization/normalization.hpp"
 #include "decomposition_policies/decomposition_policies.hpp"
 #include "neighbor_search_policies/neighbor_search_policies.hpp"
 #include "interpolation_policies/interpolation_policies.hpp"
+#include "max_ip_factors.hpp"
+#include "fold_in_factors.hpp"
 
 namespace mlpack {
 
@@ -140,6 +143,39 @@ class CFType
              const double minResidue = 1e-5,
              const bool mit = false);
 
+  /**
+   * Fold new users into the trained model without retraining it.  The factors
+   * of each new user are computed with one regularized least squares solve
+   * against the fixed item factors (see FoldInUserFactors()), and the ratings
+   * of the new users are added to the cleaned data.  The ratings are
+   * normalized with the statistics of the training data (for instance, the
+   * new users get their own means with UserMeanNormalization).
+   *
+   * Neighborhoods are searched for over all users, including the new ones, so
+   * the new users can also change the recommendations of other users.
+   *
+   * @param data Ratings of the new users in the form of a (user, item, rating)
+   *     coordinate list; the user IDs must not be smaller than the number of
+   *     users of the model, and the items must already be in the model.
+   * @param lambda Regularization parameter of the least squares problems,
+   *     weighted by the number of ratings of each new user.
+   */
+  void FoldInUsers(const arma::mat& data, const double lambda = 0.0);
+
+  /**
+   * Fold new items into the trained model without retraining it.  The factors
+   * of each new item are computed with one regularized least squares solve
+   * against the fixed user factors (see FoldInItemFactors()), and the ratings
+   * of the new items are added to the cleaned data.
+   *
+   * @param data Ratings of the new items in the form of a (user, item, rating)
+   *     coordinate list; the item IDs must not be smaller than the number of
+   *     items of the model, and the users must already be in the model.
+   * @param lambda Regularization parameter of the least squares problems,
+   *     weighted by the number of ratings of each new item.
+   */
+  void FoldInItems(const arma::mat& data, const double lambda = 0.0);
+
   //! Sets number of users for calculating similarity.
   void NumUsersForSimilarity(const size_t num)
   {
@@ -213,6 +249,54 @@ class CFType
                           arma::Mat<size_t>& recommendations,
                           const arma::Col<size_t>& users);
 
+  /**
+   * Generates the given number of recommendations for all users, directly from
+   * the predicted ratings of each user (see the other overload).
+   *
+   * @tparam MaxIPSearchType The max-inner-product search type used to find the
+   *     items with the highest predicted ratings.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations into.
+   * @param batchSize Number of users searched for at a time.
+   */
+  template<typename MaxIPSearchType = ParallelFastMKS<LinearKernel>>
+  void GetFactorRecommendations(const size_t numRecs,
+                                arma::Mat<size_t>& recommendations,
+                                const size_t batchSize = 65536) const;
+
+  /**
+   * Generates the given number of recommendations for the specified users,
+   * directly from the predicted ratings of each user, instead of from the
+   * ratings of its neighborhood.  The items with the highest predicted ratings
+   * are found with max-inner-product search over an index of the item factors
+   * (by default, FastMKS with the linear kernel), which is built once; the
+   * users are then searched for in batches.  This is much faster than scoring
+   * every item for every user when there are many users and items.
+   *
+   * Users with similar numbers of rated items are searched for together, so
+   * that only a few more than `numRecs` items need to be found for each user.
+   * Items are ranked by their normalized predicted rating; this is the order
+   * of the denormalized ratings, unless the normalization depends on the item
+   * (such as ItemMeanNormalization).
+   *
+   * The predicted ratings of the decomposition must be inner products of item
+   * and user vectors (see GetMaxIPItemFactors()).
+   *
+   * @tparam MaxIPSearchType The max-inner-product search type used to find the
+   *     items with the highest predicted ratings.
+   *
+   * @param numRecs Number of Recommendations.
+   * @param recommendations Matrix to save recommendations.
+   * @param users Users for which recommendations are to be generated.
+   * @param batchSize Number of users searched for at a time.
+   */
+  template<typename MaxIPSearchType = ParallelFastMKS<LinearKernel>>
+  void GetFactorRecommendations(const size_t numRecs,
+                                arma::Mat<size_t>& recommendations,
+                                const arma::Col<size_t>& users,
+                                const size_t batchSize = 65536) const;
+
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
 
@@ -149,6 +149,90 @@ Train(const arma::sp_mat& data,
       data, cleanedData, rank, maxIterations, minResidue, mit);
 }
 
+// Fold new users into the model.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+FoldInUsers(const arma::mat& data, const double lambda)
+{
+  if (data.n_rows != 3)
+  {
+    throw std::invalid_argument("CFType::FoldInUsers(): data must be a "
+        "(user, item, rating) coordinate list!");
+  }
+  if (data.n_cols == 0)
+    return;
+
+  const size_t numUsers = cleanedData.n_cols;
+  const size_t numItems = cleanedData.n_rows;
+  if ((size_t) min(data.row(0)) < numUsers ||
+      (size_t) max(data.row(1)) >= numItems)
+  {
+    std::ostringstream oss;
+    oss << "CFType::FoldInUsers(): user IDs must be at least " << numUsers
+        << ", and item IDs must be less than " << numItems << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::mat normalizedData(data);
+  normalization.FoldIn(normalizedData);
+
+  // Ratings of the new users, with one column for each new user.
+  arma::umat locations(2, data.n_cols);
+  locations.row(0) = arma::conv_to<arma::urowvec>::from(normalizedData.row(1));
+  locations.row(1) = arma::conv_to<arma::urowvec>::from(normalizedData.row(0)) -
+      numUsers;
+  const size_t numNewUsers = (size_t) max(data.row(0)) + 1 - numUsers;
+  const arma::sp_mat ratings(locations, normalizedData.row(2).t(), numItems,
+      numNewUsers);
+
+  FoldInUserFactors(decomposition, ratings, lambda);
+  cleanedData = arma::join_rows(cleanedData, ratings);
+}
+
+// Fold new items into the model.
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+FoldInItems(const arma::mat& data, const double lambda)
+{
+  if (data.n_rows != 3)
+  {
+    throw std::invalid_argument("CFType::FoldInItems(): data must be a "
+        "(user, item, rating) coordinate list!");
+  }
+  if (data.n_cols == 0)
+    return;
+
+  const size_t numUsers = cleanedData.n_cols;
+  const size_t numItems = cleanedData.n_rows;
+  if ((size_t) min(data.row(1)) < numItems ||
+      (size_t) max(data.row(0)) >= numUsers)
+  {
+    std::ostringstream oss;
+    oss << "CFType::FoldInItems(): item IDs must be at least " << numItems
+        << ", and user IDs must be less than " << numUsers << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::mat normalizedData(data);
+  normalization.FoldIn(normalizedData);
+
+  // Ratings of the new items, with one column for each new item.
+  arma::umat locations(2, data.n_cols);
+  locations.row(0) = arma::conv_to<arma::urowvec>::from(normalizedData.row(0));
+  locations.row(1) = arma::conv_to<arma::urowvec>::from(normalizedData.row(1)) -
+      numItems;
+  const size_t numNewItems = (size_t) max(data.row(1)) + 1 - numItems;
+  const arma::sp_mat ratings(locations, normalizedData.row(2).t(), numUsers,
+      numNewItems);
+
+  FoldInItemFactors(decomposition, ratings, lambda);
+  cleanedData = arma::join_cols(cleanedData, arma::sp_mat(ratings.t()));
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 template<typename NeighborSearchPolicy,
@@ -268,6 +352,111 @@ GetRecommendations(const size_t numRecs,
   }
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename MaxIPSearchType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetFactorRecommendations(const size_t numRecs,
+                         arma::Mat<size_t>& recommendations,
+                         const size_t batchSize) const
+{
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  GetFactorRecommendations<MaxIPSearchType>(numRecs, recommendations, users,
+      batchSize);
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename MaxIPSearchType>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+GetFactorRecommendations(const size_t numRecs,
+                         arma::Mat<size_t>& recommendations,
+                         const arma::Col<size_t>& users,
+                         const size_t batchSize) const
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("CFType::GetFactorRecommendations(): "
+        "batchSize must be positive!");
+  }
+
+  const size_t numItems = cleanedData.n_rows;
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(numItems);
+  if (numRecs == 0)
+    return;
+
+  // Build the index on the item vectors once.
+  arma::mat items;
+  GetMaxIPItemFactors(decomposition, items);
+  MaxIPSearchType search(std::move(items));
+
+  // The items rated by each user must be skipped, so for each user we search
+  // for numRecs items plus the number of items the user rated.  Sorting the
+  // users by that number keeps it nearly the same within each batch.
+  cleanedData.sync();
+  arma::Col<size_t> numRated(users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    numRated[i] = cleanedData.col_ptrs[users[i] + 1] -
+        cleanedData.col_ptrs[users[i]];
+  }
+  const arma::uvec order = arma::sort_index(numRated);
+
+  for (size_t begin = 0; begin < users.n_elem; begin += batchSize)
+  {
+    const size_t end = std::min(begin + batchSize, (size_t) users.n_elem);
+    arma::Col<size_t> batchUsers(end - begin);
+    for (size_t i = begin; i < end; ++i)
+      batchUsers[i - begin] = users[order[i]];
+
+    // The last user of the batch rated the most items.
+    const size_t k = std::min(numItems, numRecs + numRated[order[end - 1]]);
+
+    arma::mat queries;
+    GetMaxIPUserFactors(decomposition, batchUsers, queries);
+    arma::Mat<size_t> indices;
+    arma::mat kernels;
+    search.Search(queries, k, indices, kernels);
+
+    // Keep the best items that each user did not rate.  The row indices of
+    // each column of cleanedData are sorted.
+    #pragma omp parallel for
+    for (size_t i = 0; i < batchUsers.n_elem; ++i)
+    {
+      const arma::uword* ratedBegin = cleanedData.row_indices +
+          cleanedData.col_ptrs[batchUsers[i]];
+      const arma::uword* ratedEnd = cleanedData.row_indices +
+          cleanedData.col_ptrs[batchUsers[i] + 1];
+
+      size_t count = 0;
+      for (size_t j = 0; j < k && count < numRecs; ++j)
+      {
+        const size_t item = indices(j, i);
+        if (item >= numItems ||
+            std::binary_search(ratedBegin, ratedEnd, (arma::uword) item))
+          continue;
+
+        recommendations(count++, order[begin + i]) = item;
+      }
+    }
+  }
+
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (recommendations(numRecs - 1, i) == numItems)
+      Log::Warn << "Could not provide " << numRecs << " recommendations "
+          << "for user " << users(i) << " (not enough un-rated items)!"
+          << std::endl;
+  }
+}
+
 // Predict the rating for a single user/item combination.
 template<typename DecompositionPolicy,
          typename NormalizationType>
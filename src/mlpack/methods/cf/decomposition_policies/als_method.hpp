@@ -0,0 +1,271 @@
+/**
+ * @file methods/cf/decomposition_policies/als_method.hpp
+ *
+ * Alternating least squares (ALS) decomposition policy for use in
+ * Collaborative Filtering, for explicit ratings or implicit feedback.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Alternating least squares factorization of the rating matrix X ~= W H.  The
+ * user factors (the columns of H) and the item factors (the rows of W) are
+ * solved for in turn; each step is a set of independent regularized least
+ * squares problems, one for each user or item, which are solved in parallel
+ * when OpenMP is available.  The problems are built directly from the columns
+ * of the sparse rating matrix (and of its transpose).
+ *
+ * With explicit ratings, the objective is (with the regularization weighted by
+ * the number of ratings n_i of each item and n_u of each user, as in ALS-WR)
+ *
+ *   sum_{(i, u) observed} (x_iu - w_i^T h_u)^2 +
+ *       lambda (sum_i n_i ||w_i||^2 + sum_u n_u ||h_u||^2).
+ *
+ * With implicit feedback (Hu, Koren and Volinsky), every entry of the matrix
+ * is used: observed entries have preference 1 and confidence
+ * 1 + confidence * x_iu, and all other entries have preference 0 and
+ * confidence 1:
+ *
+ *   sum_{i, u} c_iu (p_iu - w_i^T h_u)^2 + lambda (||W||^2 + ||H||^2).
+ *
+ * The unobserved entries are accounted for with one shared Gram matrix per
+ * step, so the cost stays proportional to the number of observed entries.
+ * Negative values count as zero confidence, so implicit feedback should be
+ * used without normalization.
+ *
+ * Each least squares problem of rank r is solved exactly with a Cholesky
+ * factorization by default, in O(n r^2 + r^3) time for n observations.  When
+ * `cgIterations` is positive, a few warm-started, matrix-free conjugate
+ * gradient iterations are used instead, at O(n r) time each (plus O(r^2) with
+ * implicit feedback), which is faster for large ranks.
+ *
+ * An example of how to use ALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ALSPolicy> cf(data, ALSPolicy(0.05));
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative filtering for implicit feedback datasets},
+ *   author={Hu, Y. and Koren, Y. and Volinsky, C.},
+ *   booktitle={Proceedings of the 8th IEEE International Conference on Data
+ *       Mining (ICDM '08)},
+ *   pages={263--272},
+ *   year={2008}
+ * }
+ * @endcode
+ */
+class ALSPolicy
+{
+ public:
+  /**
+   * Create the policy with the given parameters.
+   *
+   * @param lambda Regularization parameter.
+   * @param implicit Whether the ratings are implicit feedback.
+   * @param confidence Scaling of the ratings into confidences, for implicit
+   *     feedback.
+   * @param cgIterations Number of conjugate gradient iterations for each least
+   *     squares problem (0 means that the problems are solved exactly).
+   */
+  ALSPolicy(const double lambda = 0.1,
+            const bool implicit = false,
+            const double confidence = 40.0,
+            const size_t cgIterations = 0) :
+      lambda(lambda),
+      implicit(implicit),
+      confidence(confidence),
+      cgIterations(cgIterations)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using alternating
+   * least squares.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix(cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param minResidue Relative decrease of the objective required to continue.
+   * @param mit Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double minResidue,
+             const bool mit);
+
+  /**
+   * Return predicted rating given user ID and item ID.  With implicit
+   * feedback, this is the predicted preference.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // As for the other factorizations, do the search on H, stretched so that
+    // distances match the distances between the columns of X = W * H.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get whether the ratings are implicit feedback.
+  bool Implicit() const { return implicit; }
+  //! Modify whether the ratings are implicit feedback.
+  bool& Implicit() { return implicit; }
+
+  //! Get the scaling of ratings into confidences for implicit feedback.
+  double Confidence() const { return confidence; }
+  //! Modify the scaling of ratings into confidences for implicit feedback.
+  double& Confidence() { return confidence; }
+
+  //! Get the number of conjugate gradient iterations (0 for exact solves).
+  size_t CGIterations() const { return cgIterations; }
+  //! Modify the number of conjugate gradient iterations (0 for exact solves).
+  size_t& CGIterations() { return cgIterations; }
+
+  /**
+   * Solve the least squares problems of all the columns of `factors`, with
+   * the other factors fixed.  This is one half of an iteration, and is also
+   * used to fold new users or items into a trained model.
+   *
+   * @param ratings Sparse ratings, one column for each column of `factors`;
+   *     the row indices are columns of `fixed`.
+   * @param fixed Fixed factors (one column per row of `ratings`).
+   * @param factors Factors to solve for; the current values are the starting
+   *     point of conjugate gradient.
+   */
+  void SolveFactors(const arma::sp_mat& ratings,
+                    const arma::mat& fixed,
+                    arma::mat& factors) const;
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(implicit));
+    ar(CEREAL_NVP(confidence));
+    ar(CEREAL_NVP(cgIterations));
+  }
+
+ private:
+  /**
+   * Compute the objective for the given factors.
+   *
+   * @param ratings Item user table in form of sparse matrix.
+   * @param itemFactors Item factors (one column per item).
+   * @param userFactors User factors (one column per user).
+   */
+  double Objective(const arma::sp_mat& ratings,
+                   const arma::mat& itemFactors,
+                   const arma::mat& userFactors) const;
+
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+
+  //! Regularization parameter.
+  double lambda;
+  //! Whether the ratings are implicit feedback.
+  bool implicit;
+  //! Scaling of ratings into confidences for implicit feedback.
+  double confidence;
+  //! Number of conjugate gradient iterations (0 for exact solves).
+  size_t cgIterations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "als_method_impl.hpp"
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file methods/cf/decomposition_policies/als_method_impl.hpp
+ *
+ * Implementation of the ALSPolicy class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_IMPL_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "als_method.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void ALSPolicy::Apply(const MatType& /* data */,
+                      const arma::sp_mat& cleanedData,
+                      const size_t rank,
+                      const size_t maxIterations,
+                      const double minResidue,
+                      const bool mit)
+{
+  // The item factors are kept as columns during the iterations, so that the
+  // factors of every least squares problem are contiguous.  The columns of the
+  // transposed ratings are the ratings of each item.
+  const arma::sp_mat itemRatings = cleanedData.t();
+  arma::mat itemFactors(rank, cleanedData.n_rows, arma::fill::randu);
+  itemFactors /= std::sqrt((double) rank);
+  h.zeros(rank, cleanedData.n_cols);
+
+  double objective = DBL_MAX;
+  size_t iteration = 0;
+  while (iteration < maxIterations)
+  {
+    ++iteration;
+    SolveFactors(cleanedData, itemFactors, h);
+    SolveFactors(itemRatings, h, itemFactors);
+
+    if (!mit)
+    {
+      const double newObjective = Objective(cleanedData, itemFactors, h);
+      const double decrease = (objective - newObjective) /
+          std::max(newObjective, DBL_MIN);
+      objective = newObjective;
+      if (decrease < minResidue)
+        break;
+    }
+  }
+
+  Log::Info << "ALSPolicy::Apply(): finished after " << iteration
+      << " iterations." << std::endl;
+  w = itemFactors.t();
+}
+
+inline void ALSPolicy::SolveFactors(const arma::sp_mat& ratings,
+                                    const arma::mat& fixed,
+                                    arma::mat& factors) const
+{
+  const size_t rank = fixed.n_rows;
+  ratings.sync();
+
+  // With implicit feedback, every entry is used with confidence 1 and
+  // preference 0; for each problem, the observed entries then only add
+  // (c - 1) f f^T to the shared Gram matrix, and c f to the right-hand side.
+  arma::mat gram;
+  if (implicit)
+    gram = fixed * fixed.t();
+
+  #pragma omp parallel
+  {
+    // Workspace of the thread.
+    arma::mat a(rank, rank);
+    arma::vec b(rank), x(rank), residual(rank), direction(rank),
+        product(rank);
+
+    // Compute product = A * v, where A is the matrix of the least squares
+    // problem of column j, with regularization reg.
+    auto multiply = [&](const size_t j, const double reg, const arma::vec& v)
+    {
+      if (implicit)
+        product = gram * v;
+      else
+        product.zeros();
+      product += reg * v;
+
+      for (size_t k = ratings.col_ptrs[j]; k < ratings.col_ptrs[j + 1]; ++k)
+      {
+        const double* f = fixed.colptr(ratings.row_indices[k]);
+        const double weight = implicit ? confidence *
+            std::max(ratings.values[k], 0.0) : 1.0;
+        double projection = 0.0;
+        for (size_t r = 0; r < rank; ++r)
+          projection += f[r] * v[r];
+        for (size_t r = 0; r < rank; ++r)
+          product[r] += weight * projection * f[r];
+      }
+    };
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t j = 0; j < ratings.n_cols; ++j)
+    {
+      const size_t begin = ratings.col_ptrs[j];
+      const size_t end = ratings.col_ptrs[j + 1];
+      if (begin == end)
+      {
+        // Without observations the solution is zero.
+        factors.col(j).zeros();
+        continue;
+      }
+
+      // With explicit ratings, the regularization is weighted by the number
+      // of observations.
+      const double reg = implicit ? lambda : lambda * (end - begin);
+
+      // Build the right-hand side.
+      b.zeros();
+      for (size_t k = begin; k < end; ++k)
+      {
+        const double* f = fixed.colptr(ratings.row_indices[k]);
+        const double target = implicit ? 1.0 + confidence *
+            std::max(ratings.values[k], 0.0) : ratings.values[k];
+        for (size_t r = 0; r < rank; ++r)
+          b[r] += target * f[r];
+      }
+
+      if (cgIterations == 0)
+      {
+        // Build the upper triangle of A and solve exactly.
+        if (implicit)
+          a = gram;
+        else
+          a.zeros();
+        a.diag() += reg;
+
+        for (size_t k = begin; k < end; ++k)
+        {
+          const double* f = fixed.colptr(ratings.row_indices[k]);
+          const double weight = implicit ? confidence *
+              std::max(ratings.values[k], 0.0) : 1.0;
+          for (size_t c = 0; c < rank; ++c)
+          {
+            const double scaled = weight * f[c];
+            for (size_t r = 0; r <= c; ++r)
+              a(r, c) += scaled * f[r];
+          }
+        }
+
+        a = arma::symmatu(a);
+        if (!arma::solve(x, a, b, arma::solve_opts::likely_sympd))
+          x.zeros();
+        factors.col(j) = x;
+      }
+      else
+      {
+        // Conjugate gradient, warm-started from the current factors.
+        x = factors.col(j);
+        multiply(j, reg, x);
+        residual = b - product;
+        direction = residual;
+        double residualNorm = dot(residual, residual);
+        const double threshold = 1e-20 * dot(b, b);
+        for (size_t i = 0; i < cgIterations && residualNorm > threshold; ++i)
+        {
+          multiply(j, reg, direction);
+          const double step = residualNorm / dot(direction, product);
+          x += step * direction;
+          residual -= step * product;
+
+          const double newResidualNorm = dot(residual, residual);
+          direction = residual + (newResidualNorm / residualNorm) * direction;
+          residualNorm = newResidualNorm;
+        }
+
+        factors.col(j) = x;
+      }
+    }
+  }
+}
+
+inline double ALSPolicy::Objective(const arma::sp_mat& ratings,
+                                   const arma::mat& itemFactors,
+                                   const arma::mat& userFactors) const
+{
+  double loss = 0.0;
+  ratings.sync();
+
+  // With implicit feedback, the loss of all entries as unobserved is
+  // sum_{i, u} (w_i^T h_u)^2 = trace(W^T W H H^T); the observed entries are
+  // then corrected.
+  if (implicit)
+  {
+    loss = arma::accu((itemFactors * itemFactors.t()) %
+        (userFactors * userFactors.t()));
+  }
+
+  #pragma omp parallel for reduction(+:loss) schedule(dynamic, 64)
+  for (size_t u = 0; u < ratings.n_cols; ++u)
+  {
+    for (size_t k = ratings.col_ptrs[u]; k < ratings.col_ptrs[u + 1]; ++k)
+    {
+      const double prediction = dot(itemFactors.col(ratings.row_indices[k]),
+          userFactors.col(u));
+      if (implicit)
+      {
+        const double c = 1.0 + confidence * std::max(ratings.values[k], 0.0);
+        loss += c * (1.0 - prediction) * (1.0 - prediction) -
+            prediction * prediction;
+      }
+      else
+      {
+        loss += (ratings.values[k] - prediction) *
+            (ratings.values[k] - prediction);
+
+        // Each observation adds the regularization of its factors.
+        loss += lambda * (arma::accu(arma::square(itemFactors.col(
+            ratings.row_indices[k]))) + arma::accu(arma::square(
+            userFactors.col(u))));
+      }
+    }
+  }
+
+  if (implicit)
+  {
+    loss += lambda * (arma::accu(arma::square(itemFactors)) +
+        arma::accu(arma::square(userFactors)));
+  }
+
+  return loss;
+}
+
+} // namespace mlpack
+
+#endif
@@ -147,8 +147,12 @@ class BatchSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   /**
    * Serialization.
@@ -137,12 +137,20 @@ class BiasSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
   //! Get the User Bias Vector.
   const arma::vec& Q() const { return q; }
+  //! Modify the User Bias Vector.
+  arma::vec& Q() { return q; }
   //! Get the Item Bias Vector.
   const arma::vec& P() const { return p; }
+  //! Modify the Item Bias Vector.
+  arma::vec& P() { return p; }
 
   //! Get the number of iterations.
   size_t MaxIterations() const { return maxIterations; }
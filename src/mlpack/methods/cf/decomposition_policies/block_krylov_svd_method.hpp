@@ -70,12 +70,10 @@ class BlockKrylovSVDPolicy
   {
     arma::vec sigma;
 
-    // Preprocessed data converted to mat format
-    arma::mat data(cleanedData);
-
     // Do singular value decomposition using the block krylov SVD algorithm.
+    // The sparse data is used directly.
     RandomizedBlockKrylovSVD blockkrylovsvd;
-    blockkrylovsvd.Apply(data, w, sigma, h, rank);
+    blockkrylovsvd.Apply(cleanedData, w, sigma, h, rank);
 
     // Sigma matrix is multiplied to w.
     w = w * arma::diagmat(sigma);
@@ -148,8 +146,12 @@ class BlockKrylovSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   /**
    * Serialization.
@@ -153,8 +153,12 @@ class RandomizedSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
@@ -140,8 +140,12 @@ class RegSVDPolicy
 
   //! Get the Item Matrix.
   const arma::mat& W() const { return w; }
+  //! Modify the Item Matrix.
+  arma::mat& W() { return w; }
   //! Get the User Matrix.
   const arma::mat& H() const { return h; }
+  //! Modify the User Matrix.
+  arma::mat& H() { return h; }
 
   //! Get the number of iterations.
   size_t MaxIterations() const { return maxIterations; }
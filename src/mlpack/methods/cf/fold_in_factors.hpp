@@ -0,0 +1,204 @@
+/**
+ * @file methods/cf/fold_in_factors.hpp
+ *
+ * Functions that fold new users or items into a trained decomposition, by
+ * solving a least squares problem for the factors of each new user or item with
+ * the other factors fixed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_FOLD_IN_FACTORS_HPP
+#define MLPACK_METHODS_CF_FOLD_IN_FACTORS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "decomposition_policies/decomposition_policies.hpp"
+
+namespace mlpack {
+
+/**
+ * Solve for the factors of each column of `ratings`, with the factors of the
+ * rows of `ratings` fixed, minimizing
+ *
+ *   sum_i (x_i - offset_i - f_i^T y)^2 + lambda n ||y||^2
+ *
+ * for each column, where n is the number of ratings in the column, and y has an
+ * extra bias dimension (with a feature of 1) if `bias` is true.  Columns
+ * without ratings get zero factors.
+ *
+ * @param fixed Fixed factors, one column for each row of `ratings`.
+ * @param ratings Ratings; one column for each factor to solve for.
+ * @param offsets Offset of the ratings of each row of `ratings` (or empty).
+ * @param bias Whether to solve for a bias too.
+ * @param lambda Regularization parameter.
+ * @param factors Matrix to store the factors in (one column per column of
+ *     `ratings`; the bias is the last row).
+ */
+inline void FoldInFactors(const arma::mat& fixed,
+                          const arma::sp_mat& ratings,
+                          const arma::vec& offsets,
+                          const bool bias,
+                          const double lambda,
+                          arma::mat& factors)
+{
+  const size_t rank = fixed.n_rows;
+  const size_t dim = rank + (bias ? 1 : 0);
+  factors.zeros(dim, ratings.n_cols);
+  ratings.sync();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t j = 0; j < ratings.n_cols; ++j)
+  {
+    const size_t begin = ratings.col_ptrs[j];
+    const size_t n = ratings.col_ptrs[j + 1] - begin;
+    if (n == 0)
+      continue;
+
+    // The regularization is expressed as extra rows of the problem.
+    arma::mat a(n + (lambda > 0.0 ? dim : 0), dim, arma::fill::zeros);
+    arma::vec b(a.n_rows, arma::fill::zeros);
+    for (size_t k = 0; k < n; ++k)
+    {
+      const size_t i = ratings.row_indices[begin + k];
+      for (size_t r = 0; r < rank; ++r)
+        a(k, r) = fixed(r, i);
+      if (bias)
+        a(k, rank) = 1.0;
+      b[k] = ratings.values[begin + k] -
+          (offsets.n_elem > 0 ? offsets[i] : 0.0);
+    }
+    if (lambda > 0.0)
+    {
+      for (size_t r = 0; r < dim; ++r)
+        a(n + r, r) = std::sqrt(lambda * n);
+    }
+
+    arma::vec x;
+    if (arma::solve(x, a, b))
+      factors.col(j) = x;
+  }
+}
+
+/**
+ * Fold new users into a trained decomposition: the user factors of each new
+ * user are appended to H, with the item factors fixed.
+ *
+ * This generic version is correct for every decomposition policy where
+ * GetRating(user, item) is W().row(item) * H().col(user).  Overloads must be
+ * provided for other decomposition policies.
+ *
+ * @param decomposition Trained decomposition policy.
+ * @param ratings Normalized ratings of the new users (one row per item, one
+ *     column per new user).
+ * @param lambda Regularization parameter.
+ */
+template<typename DecompositionPolicy>
+void FoldInUserFactors(DecompositionPolicy& decomposition,
+                       const arma::sp_mat& ratings,
+                       const double lambda)
+{
+  arma::mat factors;
+  FoldInFactors(decomposition.W().t(), ratings, arma::vec(), false, lambda,
+      factors);
+  decomposition.H() = arma::join_rows(decomposition.H(), factors);
+}
+
+/**
+ * Fold new items into a trained decomposition: the item factors of each new
+ * item are appended to W, with the user factors fixed (see
+ * FoldInUserFactors()).
+ *
+ * @param decomposition Trained decomposition policy.
+ * @param ratings Normalized ratings of the new items (one row per user, one
+ *     column per new item).
+ * @param lambda Regularization parameter.
+ */
+template<typename DecompositionPolicy>
+void FoldInItemFactors(DecompositionPolicy& decomposition,
+                       const arma::sp_mat& ratings,
+                       const double lambda)
+{
+  arma::mat factors;
+  FoldInFactors(decomposition.H(), ratings, arma::vec(), false, lambda,
+      factors);
+  decomposition.W() = arma::join_cols(decomposition.W(), factors.t());
+}
+
+//! The user bias of each new user is solved for together with its factors.
+inline void FoldInUserFactors(BiasSVDPolicy& decomposition,
+                              const arma::sp_mat& ratings,
+                              const double lambda)
+{
+  const size_t rank = decomposition.H().n_rows;
+  arma::mat factors;
+  FoldInFactors(decomposition.W().t(), ratings, decomposition.P(), true,
+      lambda, factors);
+  decomposition.H() = arma::join_rows(decomposition.H(),
+      factors.head_rows(rank));
+  decomposition.Q() = arma::join_cols(decomposition.Q(),
+      arma::vec(factors.row(rank).t()));
+}
+
+//! The item bias of each new item is solved for together with its factors.
+inline void FoldInItemFactors(BiasSVDPolicy& decomposition,
+                              const arma::sp_mat& ratings,
+                              const double lambda)
+{
+  const size_t rank = decomposition.H().n_rows;
+  arma::mat factors;
+  FoldInFactors(decomposition.H(), ratings, decomposition.Q(), true, lambda,
+      factors);
+  decomposition.W() = arma::join_cols(decomposition.W(),
+      arma::mat(factors.head_rows(rank).t()));
+  decomposition.P() = arma::join_cols(decomposition.P(),
+      arma::vec(factors.row(rank).t()));
+}
+
+//! ALSPolicy solves for new users with its own objective and regularization
+//! (including implicit feedback); `lambda` is not used.
+inline void FoldInUserFactors(ALSPolicy& decomposition,
+                              const arma::sp_mat& ratings,
+                              const double /* lambda */)
+{
+  arma::mat factors(decomposition.H().n_rows, ratings.n_cols,
+      arma::fill::zeros);
+  decomposition.SolveFactors(ratings, decomposition.W().t(), factors);
+  decomposition.H() = arma::join_rows(decomposition.H(), factors);
+}
+
+//! ALSPolicy solves for new items with its own objective and regularization
+//! (including implicit feedback); `lambda` is not used.
+inline void FoldInItemFactors(ALSPolicy& decomposition,
+                              const arma::sp_mat& ratings,
+                              const double /* lambda */)
+{
+  arma::mat factors(decomposition.W().n_cols, ratings.n_cols,
+      arma::fill::zeros);
+  decomposition.SolveFactors(ratings, decomposition.H(), factors);
+  decomposition.W() = arma::join_cols(decomposition.W(), factors.t());
+}
+
+//! SVD++ also learns implicit item factors, so it must be retrained.
+inline void FoldInUserFactors(SVDPlusPlusPolicy& /* decomposition */,
+                              const arma::sp_mat& /* ratings */,
+                              const double /* lambda */)
+{
+  throw std::logic_error("FoldInUserFactors(): SVDPlusPlusPolicy does not "
+      "support fold-in; retrain the model instead.");
+}
+
+//! SVD++ also learns implicit item factors, so it must be retrained.
+inline void FoldInItemFactors(SVDPlusPlusPolicy& /* decomposition */,
+                              const arma::sp_mat& /* ratings */,
+                              const double /* lambda */)
+{
+  throw std::logic_error("FoldInItemFactors(): SVDPlusPlusPolicy does not "
+      "support fold-in; retrain the model instead.");
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file methods/cf/max_ip_factors.hpp
+ *
+ * Functions that express the predicted ratings of a decomposition policy as
+ * inner products between item vectors and user vectors, so that the best items
+ * for each user can be found with max-inner-product search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_MAX_IP_FACTORS_HPP
+#define MLPACK_METHODS_CF_MAX_IP_FACTORS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "decomposition_policies/decomposition_policies.hpp"
+
+namespace mlpack {
+
+/**
+ * Compute the item vectors of the given decomposition: one column for each
+ * item, such that GetRating(user, item) is, up to a term that depends only on
+ * the user, the inner product of column `item` and the user vector computed by
+ * GetMaxIPUserFactors().
+ *
+ * This generic version is correct for every decomposition policy where
+ * GetRating(user, item) is W().row(item) * H().col(user).  Overloads of both
+ * functions must be provided for other decomposition policies.
+ *
+ * @param decomposition Trained decomposition policy.
+ * @param items Matrix to store the item vectors in.
+ */
+template<typename DecompositionPolicy>
+void GetMaxIPItemFactors(const DecompositionPolicy& decomposition,
+                         arma::mat& items)
+{
+  items = decomposition.W().t();
+}
+
+/**
+ * Compute the user vectors of the given users for the given decomposition (see
+ * GetMaxIPItemFactors()).
+ *
+ * @param decomposition Trained decomposition policy.
+ * @param users Users to compute the vectors of.
+ * @param queries Matrix to store the user vectors in (one column per user).
+ */
+template<typename DecompositionPolicy>
+void GetMaxIPUserFactors(const DecompositionPolicy& decomposition,
+                         const arma::Col<size_t>& users,
+                         arma::mat& queries)
+{
+  queries = decomposition.H().cols(arma::conv_to<arma::uvec>::from(users));
+}
+
+//! The item biases of BiasSVD are an extra dimension of the item vectors.
+inline void GetMaxIPItemFactors(const BiasSVDPolicy& decomposition,
+                                arma::mat& items)
+{
+  items = arma::join_cols(decomposition.W().t(), decomposition.P().t());
+}
+
+//! The user vectors of BiasSVD have a 1 for the item bias; the user bias does
+//! not change the order of the items.
+inline void GetMaxIPUserFactors(const BiasSVDPolicy& decomposition,
+                                const arma::Col<size_t>& users,
+                                arma::mat& queries)
+{
+  queries.set_size(decomposition.H().n_rows + 1, users.n_elem);
+  queries.head_rows(decomposition.H().n_rows) =
+      decomposition.H().cols(arma::conv_to<arma::uvec>::from(users));
+  queries.row(decomposition.H().n_rows).ones();
+}
+
+//! The item biases of SVD++ are an extra dimension of the item vectors.
+inline void GetMaxIPItemFactors(const SVDPlusPlusPolicy& decomposition,
+                                arma::mat& items)
+{
+  items = arma::join_cols(decomposition.W().t(), decomposition.P().t());
+}
+
+//! The user vectors of SVD++ include the implicit feedback of each user, and a
+//! 1 for the item bias.
+inline void GetMaxIPUserFactors(const SVDPlusPlusPolicy& decomposition,
+                                const arma::Col<size_t>& users,
+                                arma::mat& queries)
+{
+  const arma::mat& h = decomposition.H();
+  const arma::mat& y = decomposition.Y();
+  const arma::sp_mat& implicitData = decomposition.ImplicitData();
+
+  queries.set_size(h.n_rows + 1, users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::vec userVec(h.n_rows, arma::fill::zeros);
+    size_t implicitCount = 0;
+    arma::sp_mat::const_iterator it = implicitData.begin_col(users[i]);
+    for (; it != implicitData.end_col(users[i]); ++it)
+    {
+      userVec += y.col(it.row());
+      ++implicitCount;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+
+    queries.submat(0, i, h.n_rows - 1, i) = userVec + h.col(users[i]);
+    queries(h.n_rows, i) = 1.0;
+  }
+}
+
+} // namespace mlpack
+
+#endif
@@ -59,6 +59,17 @@ class CombinedNormalization
     SequenceNormalize<0>(data);
   }
 
+  /**
+   * Normalize the ratings of new users or items that are folded into the model
+   * by calling FoldIn() in each normalization object.
+   *
+   * @param data Ratings of new users or items in the form of coordinate list.
+   */
+  void FoldIn(arma::mat& data)
+  {
+    SequenceFoldIn<0>(data);
+  }
+
   /**
    * Denormalize rating by calling Denormalize() in each normalization object.
    * Note that the order of objects calling Denormalize() should be the
@@ -129,6 +140,23 @@ class CombinedNormalization
       typename = void>
   void SequenceNormalize(MatType& /* data */) { }
 
+  //! Unpack normalizations tuple to fold in new ratings.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceFoldIn(arma::mat& data)
+  {
+    std::get<I>(normalizations).FoldIn(data);
+    SequenceFoldIn<I + 1>(data);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceFoldIn(arma::mat& /* data */) { }
+
   //! Unpack normalizations tuple to denormalize.
   template<
       int I, /* Which normalization in tuple to use */
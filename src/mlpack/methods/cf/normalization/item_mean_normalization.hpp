@@ -119,6 +119,48 @@ class ItemMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users or items that are folded into the model
+   * by subtracting the item mean.  The means of new items are computed from
+   * their ratings in the given data.
+   *
+   * @param data Ratings of new users or items in the form of coordinate list.
+   */
+  void FoldIn(arma::mat& data)
+  {
+    const size_t oldNum = itemMean.n_elem;
+    const size_t itemNum = std::max(oldNum, (size_t) max(data.row(1)) + 1);
+    if (itemNum > oldNum)
+    {
+      // Compute the means of the new items only.
+      itemMean.resize(itemNum);
+      itemMean.tail(itemNum - oldNum).zeros();
+      arma::Row<size_t> ratingNum(itemNum, arma::fill::zeros);
+      data.each_col([&](arma::vec& datapoint)
+      {
+        const size_t item = (size_t) datapoint(1);
+        if (item >= oldNum)
+        {
+          itemMean(item) += datapoint(2);
+          ratingNum(item) += 1;
+        }
+      });
+
+      for (size_t i = oldNum; i < itemNum; ++i)
+      {
+        if (ratingNum(i) != 0)
+          itemMean(i) /= ratingNum(i);
+      }
+    }
+
+    data.each_col([&](arma::vec& datapoint)
+    {
+      datapoint(2) -= itemMean((size_t) datapoint(1));
+      if (datapoint(2) == 0)
+        datapoint(2) = std::numeric_limits<float>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding item mean.
    *
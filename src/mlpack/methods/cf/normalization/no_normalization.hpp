@@ -35,6 +35,13 @@ class NoNormalization
   template<typename MatType>
   inline void Normalize(const MatType& /* data */) const { }
 
+  /**
+   * Do nothing.
+   *
+   * @param * (data) Ratings of new users or items.
+   */
+  inline void FoldIn(const arma::mat& /* data */) const { }
+
   /**
    * Do nothing.
    *
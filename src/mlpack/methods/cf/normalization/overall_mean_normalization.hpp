@@ -92,6 +92,22 @@ class OverallMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users or items that are folded into the model
+   * by subtracting the mean of the training ratings.
+   *
+   * @param data Ratings of new users or items in the form of coordinate list.
+   */
+  void FoldIn(arma::mat& data) const
+  {
+    data.row(2) -= mean;
+    data.row(2).for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<double>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding mean.
    *
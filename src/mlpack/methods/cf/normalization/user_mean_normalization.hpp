@@ -119,6 +119,48 @@ class UserMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users or items that are folded into the model
+   * by subtracting the user mean.  The means of new users are computed from
+   * their ratings in the given data.
+   *
+   * @param data Ratings of new users or items in the form of coordinate list.
+   */
+  void FoldIn(arma::mat& data)
+  {
+    const size_t oldNum = userMean.n_elem;
+    const size_t userNum = std::max(oldNum, (size_t) max(data.row(0)) + 1);
+    if (userNum > oldNum)
+    {
+      // Compute the means of the new users only.
+      userMean.resize(userNum);
+      userMean.tail(userNum - oldNum).zeros();
+      arma::Row<size_t> ratingNum(userNum, arma::fill::zeros);
+      data.each_col([&](arma::vec& datapoint)
+      {
+        const size_t user = (size_t) datapoint(0);
+        if (user >= oldNum)
+        {
+          userMean(user) += datapoint(2);
+          ratingNum(user) += 1;
+        }
+      });
+
+      for (size_t i = oldNum; i < userNum; ++i)
+      {
+        if (ratingNum(i) != 0)
+          userMean(i) /= ratingNum(i);
+      }
+    }
+
+    data.each_col([&](arma::vec& datapoint)
+    {
+      datapoint(2) -= userMean((size_t) datapoint(0));
+      if (datapoint(2) == 0)
+        datapoint(2) = std::numeric_limits<double>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding user mean.
    *
@@ -104,6 +104,22 @@ class ZScoreNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of new users or items that are folded into the model
+   * with the mean and standard deviation of the training ratings.
+   *
+   * @param data Ratings of new users or items in the form of coordinate list.
+   */
+  void FoldIn(arma::mat& data) const
+  {
+    data.row(2) = (data.row(2) - mean) / stddev;
+    data.row(2).for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<float>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding mean and multiplying stddev.
    *
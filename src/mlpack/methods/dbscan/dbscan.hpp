@@ -16,6 +16,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 
@@ -42,6 +43,34 @@ namespace mlpack {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * In batch mode, the range searches for all points are performed at once by
+ * default, which may need a lot of memory for dense data; if BatchSize() is
+ * set, the points are searched in batches of that size instead, and only the
+ * results of one batch are held at a time.
+ *
+ * For low-dimensional data with the Euclidean distance, the grid-based
+ * algorithm of the following paper can be used instead of range searches, by
+ * setting GridMode():
+ *
+ * @code
+ * @inproceedings{gan2015dbscan,
+ *   title={DBSCAN revisited: mis-claim, un-fixability, and approximation},
+ *   author={Gan, J. and Tao, Y.},
+ *   booktitle={Proceedings of the 2015 ACM SIGMOD International Conference on
+ *       Management of Data},
+ *   pages={519--530},
+ *   year={2015}
+ * }
+ * @endcode
+ *
+ * The points are placed in a grid of cells whose diagonal is epsilon, so all
+ * points in one cell are neighbors of each other; only the points of nearby
+ * cells ever need to be compared.  The core points are found, the cells are
+ * connected, and the border points are assigned in parallel with OpenMP, using
+ * a ConcurrentUnionFind on the cells.  The number of nearby cells grows
+ * exponentially with the dimensionality, so this is only practical for up to
+ * about five dimensions.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -111,6 +140,35 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  MatType& centroids);
 
+  //! Get the size of range queries.
+  ElemType Epsilon() const { return epsilon; }
+  //! Modify the size of range queries.
+  ElemType& Epsilon() { return epsilon; }
+
+  //! Get the minimum number of points in the neighborhood of a core point.
+  size_t MinPoints() const { return minPoints; }
+  //! Modify the minimum number of points in the neighborhood of a core point.
+  size_t& MinPoints() { return minPoints; }
+
+  //! Get whether batch mode is used.
+  bool BatchMode() const { return batchMode; }
+  //! Modify whether batch mode is used.
+  bool& BatchMode() { return batchMode; }
+
+  //! Get the number of points searched at once in batch mode (0 means all
+  //! points).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points searched at once in batch mode (0 means all
+  //! points).
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get whether the grid-based algorithm is used.
+  bool GridMode() const { return gridMode; }
+  //! Modify whether the grid-based algorithm is used.  If true, the range
+  //! search object, batch mode, and point selection policy are ignored, and
+  //! the Euclidean distance is used.
+  bool& GridMode() { return gridMode; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   ElemType epsilon;
@@ -122,6 +180,13 @@ class DBSCAN
   //! Whether or not to perform the search in batch mode.  If false, single
   bool batchMode;
 
+  //! The number of points whose range searches are performed at once in batch
+  //! mode; if 0, all points are searched at once.
+  size_t batchSize;
+
+  //! Whether or not to use the grid-based algorithm.
+  bool gridMode;
+
   //! Instantiated range search policy.
   RangeSearchType rangeSearch;
 
@@ -150,6 +215,27 @@ class DBSCAN
    * @param uf UnionFind structure that will be modified.
    */
   void BatchCluster(const MatType& data, UnionFind& uf);
+
+  /**
+   * Performs DBSCAN clustering on the data in batch mode, but only performs
+   * the range searches of BatchSize() points at a time, so that all of the
+   * range search results never need to be held at once.  Each range search is
+   * performed twice: once to find the core points, and once to merge the
+   * clusters.
+   *
+   * @param data Dataset to cluster.
+   * @param uf UnionFind structure that will be modified.
+   */
+  void StreamingBatchCluster(const MatType& data, UnionFind& uf);
+
+  /**
+   * Performs DBSCAN clustering on the data with the grid-based algorithm,
+   * without using range searches.  The Euclidean distance is used.
+   *
+   * @param data Dataset to cluster.
+   * @param uf UnionFind structure that will be modified.
+   */
+  void GridCluster(const MatType& data, UnionFind& uf);
 };
 
 } // namespace mlpack
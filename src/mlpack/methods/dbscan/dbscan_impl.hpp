@@ -29,6 +29,8 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     epsilon(epsilon),
     minPoints(minPoints),
     batchMode(batchMode),
+    batchSize(0),
+    gridMode(false),
     rangeSearch(rangeSearch),
     pointSelector(pointSelector)
 {
@@ -98,12 +100,23 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 {
   // Initialize the UnionFind object.
   UnionFind uf(data.n_cols);
-  rangeSearch.Train(data);
 
-  if (batchMode)
-    BatchCluster(data, uf);
+  if (gridMode)
+  {
+    // The grid-based algorithm does not need the range search object.
+    GridCluster(data, uf);
+  }
   else
-    PointwiseCluster(data, uf);
+  {
+    rangeSearch.Train(data);
+
+    if (batchMode && batchSize > 0)
+      StreamingBatchCluster(data, uf);
+    else if (batchMode)
+      BatchCluster(data, uf);
+    else
+      PointwiseCluster(data, uf);
+  }
 
   // Now set assignments.
   assignments.set_size(data.n_cols);
@@ -226,12 +239,14 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     UnionFind& uf)
 {
   // For each point, find the points in epsilon-neighborhood and their distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<ElemType>> distances;
+  // The results are stored in compressed form: the neighbors of point i are
+  // neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1].
+  arma::Col<size_t> offsets, neighbors;
+  arma::Col<ElemType> distances;
   Log::Info << "Performing range search." << std::endl;
   rangeSearch.Train(data);
-  rangeSearch.Search(RangeType<ElemType>(ElemType(0.0), epsilon), neighbors,
-      distances);
+  rangeSearch.Search(RangeType<ElemType>(ElemType(0.0), epsilon), offsets,
+      neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
   // See the description of the algorithm in `PointwiseCluster()`.  The strategy
@@ -247,23 +262,365 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const size_t index = pointSelector.Select(i, data);
     // Monochromatic dual-tree range search does not return the point as its own
     // neighbor, so we are looking for `minPoints - 1` instead.
-    if (neighbors[index].size() >= minPoints - 1)
+    if (offsets[index + 1] - offsets[index] >= minPoints - 1)
     {
-      for (size_t j = 0; j < neighbors[index].size(); ++j)
+      for (size_t j = offsets[index]; j < offsets[index + 1]; ++j)
       {
-        if (uf.Find(neighbors[index][j]) == neighbors[index][j])
+        const size_t neighbor = neighbors[j];
+        if (uf.Find(neighbor) == neighbor)
         {
           // This unions unlabeled points.
-          uf.Union(index, neighbors[index][j]);
+          uf.Union(index, neighbor);
         }
-        else if (neighbors[neighbors[index][j]].size() >= (minPoints - 1))
+        else if (offsets[neighbor + 1] - offsets[neighbor] >= (minPoints - 1))
         {
           // This unions core points of other clusters.
-          uf.Union(index, neighbors[index][j]);
+          uf.Union(index, neighbor);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Performs DBSCAN clustering on the data in batch mode, but only holds the
+ * range search results of BatchSize() points at a time.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::StreamingBatchCluster(
+    const MatType& data,
+    UnionFind& uf)
+{
+  // The point selection policy may have state, so get the order of the points
+  // only once.
+  arma::uvec order(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = pointSelector.Select(i, data);
+
+  arma::Col<size_t> offsets, neighbors, counts;
+  arma::Col<ElemType> distances;
+  const RangeType<ElemType> range(ElemType(0.0), epsilon);
+
+  // First find all the core points.  The query points are also in the
+  // reference set, so each point is returned as its own neighbor (like in
+  // `PointwiseCluster()`).  Only the number of neighbors is needed here.
+  Log::Info << "Finding core points." << std::endl;
+  std::vector<bool> corePoints(data.n_cols, false);
+  for (size_t start = 0; start < data.n_cols; start += batchSize)
+  {
+    const size_t end = std::min(start + batchSize, (size_t) data.n_cols) - 1;
+    const arma::uvec batch = order.subvec(start, end);
+    const MatType querySet = data.cols(batch);
+    rangeSearch.Count(querySet, range, counts);
+
+    for (size_t i = 0; i < batch.n_elem; ++i)
+      corePoints[batch[i]] = (counts[i] >= minPoints);
+  }
+
+  // Now search again and merge the clusters, like in `BatchCluster()`.
+  Log::Info << "Merging clusters." << std::endl;
+  for (size_t start = 0; start < data.n_cols; start += batchSize)
+  {
+    const size_t end = std::min(start + batchSize, (size_t) data.n_cols) - 1;
+    const arma::uvec batch = order.subvec(start, end);
+    const MatType querySet = data.cols(batch);
+    rangeSearch.Search(querySet, range, offsets, neighbors, distances);
+
+    for (size_t i = 0; i < batch.n_elem; ++i)
+    {
+      const size_t index = batch[i];
+      if (!corePoints[index])
+        continue;
+
+      for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+      {
+        // Union to unlabeled points and to core points of other clusters.
+        if (uf.Find(neighbors[j]) == neighbors[j] || corePoints[neighbors[j]])
+          uf.Union(index, neighbors[j]);
+      }
+    }
+  }
+}
+
+/**
+ * Performs DBSCAN clustering on the data with the grid-based algorithm.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::GridCluster(
+    const MatType& data,
+    UnionFind& uf)
+{
+  const size_t dims = data.n_rows;
+  const size_t n = data.n_cols;
+  if (n == 0)
+    return;
+
+  if (epsilon <= 0)
+  {
+    throw std::invalid_argument("DBSCAN::Cluster(): epsilon must be positive "
+        "when the grid-based algorithm is used!");
+  }
+
+  // The diagonal of each cell is epsilon, so any two points in the same cell
+  // are neighbors.  Points in cells that are more than `reach` cells apart in
+  // any dimension can never be neighbors.
+  const double side = epsilon / std::sqrt((double) dims);
+  const double sqEpsilon = (double) epsilon * (double) epsilon;
+  const arma::sword reach = (arma::sword) std::ceil(std::sqrt((double) dims));
+
+  auto sqDistance = [&](const size_t a, const size_t b)
+  {
+    double sum = 0.0;
+    for (size_t k = 0; k < dims; ++k)
+    {
+      const double diff = (double) data(k, a) - (double) data(k, b);
+      sum += diff * diff;
+    }
+    return sum;
+  };
+
+  // Compute the cell of each point.
+  const arma::Col<ElemType> minima = arma::min(data, 1);
+  arma::Mat<arma::sword> coords(dims, n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t k = 0; k < dims; ++k)
+    {
+      coords(k, i) = (arma::sword) std::floor(
+          ((double) data(k, i) - (double) minima[k]) / side);
+    }
+  }
+
+  // Sort the points by their cells, and collect the points of each cell.
+  std::vector<size_t> sortedPoints(n);
+  for (size_t i = 0; i < n; ++i)
+    sortedPoints[i] = i;
+  std::sort(sortedPoints.begin(), sortedPoints.end(),
+      [&](const size_t a, const size_t b)
+      {
+        for (size_t k = 0; k < dims; ++k)
+          if (coords(k, a) != coords(k, b))
+            return coords(k, a) < coords(k, b);
+        return false;
+      });
+
+  // The points of cell c are sortedPoints[cellStart[c]] to
+  // sortedPoints[cellStart[c + 1] - 1].
+  std::vector<size_t> cellStart;
+  std::vector<size_t> pointCell(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (i == 0 || arma::any(coords.col(sortedPoints[i]) !=
+        coords.col(sortedPoints[i - 1])))
+      cellStart.push_back(i);
+    pointCell[sortedPoints[i]] = cellStart.size() - 1;
+  }
+  const size_t numCells = cellStart.size();
+  cellStart.push_back(n);
+  Log::Info << "Built grid with " << numCells << " non-empty cells."
+      << std::endl;
+
+  // Find the offsets of the cells that may contain neighbors: a cell that is o
+  // cells away in some dimension is at least (|o| - 1) * side away in that
+  // dimension.
+  std::vector<arma::Col<arma::sword>> offsets;
+  arma::Col<arma::sword> offset(dims);
+  offset.fill(-reach);
+  while (true)
+  {
+    double minSqDistance = 0.0;
+    for (size_t k = 0; k < dims; ++k)
+    {
+      const double gap = std::max((double) std::abs(offset[k]) - 1.0, 0.0) *
+          side;
+      minSqDistance += gap * gap;
+    }
+    if (minSqDistance <= sqEpsilon)
+      offsets.push_back(offset);
+
+    // Move to the next offset.
+    size_t k = 0;
+    while (k < dims && offset[k] == reach)
+      offset[k++] = -reach;
+    if (k == dims)
+      break;
+    ++offset[k];
+  }
+
+  // Find the non-empty neighboring cells of each cell (including itself).
+  std::vector<std::vector<size_t>> cellNeighbors(numCells);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    const arma::Col<arma::sword> cellCoords =
+        coords.col(sortedPoints[cellStart[c]]);
+    for (size_t o = 0; o < offsets.size(); ++o)
+    {
+      const arma::Col<arma::sword> target = cellCoords + offsets[o];
+
+      // Binary search for the cell with the target coordinates.
+      size_t low = 0, high = numCells;
+      while (low < high)
+      {
+        const size_t mid = (low + high) / 2;
+        const size_t point = sortedPoints[cellStart[mid]];
+        bool less = false;
+        for (size_t k = 0; k < dims; ++k)
+        {
+          if (coords(k, point) != target[k])
+          {
+            less = (coords(k, point) < target[k]);
+            break;
+          }
+        }
+
+        if (less)
+          low = mid + 1;
+        else
+          high = mid;
+      }
+
+      if (low < numCells &&
+          arma::all(coords.col(sortedPoints[cellStart[low]]) == target))
+        cellNeighbors[c].push_back(low);
+    }
+  }
+
+  // Find the core points.  If a cell holds at least minPoints points, all of
+  // them are core points; otherwise, we count the neighbors of each point in
+  // the neighboring cells.  (std::vector<char> is used instead of
+  // std::vector<bool> so that different threads can write different
+  // elements.)
+  std::vector<char> corePoints(n, 0);
+  std::vector<char> coreCells(numCells, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    const size_t cellSize = cellStart[c + 1] - cellStart[c];
+    for (size_t i = cellStart[c]; i < cellStart[c + 1]; ++i)
+    {
+      const size_t point = sortedPoints[i];
+      size_t count = cellSize;
+      for (size_t nc = 0; nc < cellNeighbors[c].size() && count < minPoints;
+          ++nc)
+      {
+        const size_t neighborCell = cellNeighbors[c][nc];
+        if (neighborCell == c)
+          continue;
+
+        for (size_t j = cellStart[neighborCell];
+             j < cellStart[neighborCell + 1] && count < minPoints; ++j)
+        {
+          if (sqDistance(point, sortedPoints[j]) <= sqEpsilon)
+            ++count;
+        }
+      }
+
+      if (count >= minPoints)
+      {
+        corePoints[point] = 1;
+        coreCells[c] = 1;
+      }
+    }
+  }
+
+  // Connect neighboring cells that have core points within epsilon of each
+  // other.
+  ConcurrentUnionFind cellUf(numCells);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    if (!coreCells[c])
+      continue;
+
+    for (size_t nc = 0; nc < cellNeighbors[c].size(); ++nc)
+    {
+      // Each pair of cells only needs to be checked once.
+      const size_t neighborCell = cellNeighbors[c][nc];
+      if (neighborCell <= c || !coreCells[neighborCell] ||
+          cellUf.Find(c) == cellUf.Find(neighborCell))
+        continue;
+
+      bool connected = false;
+      for (size_t i = cellStart[c]; i < cellStart[c + 1] && !connected; ++i)
+      {
+        if (!corePoints[sortedPoints[i]])
+          continue;
+
+        for (size_t j = cellStart[neighborCell];
+             j < cellStart[neighborCell + 1] && !connected; ++j)
+        {
+          connected = corePoints[sortedPoints[j]] &&
+              (sqDistance(sortedPoints[i], sortedPoints[j]) <= sqEpsilon);
         }
       }
+
+      if (connected)
+        cellUf.Union(c, neighborCell);
     }
   }
+
+  // Assign each non-core point to the first cell that has a core point within
+  // epsilon of it, if there is one.
+  std::vector<size_t> borderCells(n, SIZE_MAX);
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t c = 0; c < numCells; ++c)
+  {
+    for (size_t i = cellStart[c]; i < cellStart[c + 1]; ++i)
+    {
+      const size_t point = sortedPoints[i];
+      if (corePoints[point])
+        continue;
+
+      // Every point of the cell is within epsilon.
+      if (coreCells[c])
+      {
+        borderCells[point] = c;
+        continue;
+      }
+
+      for (size_t nc = 0; nc < cellNeighbors[c].size() &&
+          borderCells[point] == SIZE_MAX; ++nc)
+      {
+        const size_t neighborCell = cellNeighbors[c][nc];
+        if (!coreCells[neighborCell])
+          continue;
+
+        for (size_t j = cellStart[neighborCell];
+             j < cellStart[neighborCell + 1]; ++j)
+        {
+          if (corePoints[sortedPoints[j]] &&
+              sqDistance(point, sortedPoints[j]) <= sqEpsilon)
+          {
+            borderCells[point] = neighborCell;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // Now union every core point and border point with a core point of the
+  // cluster its cell belongs to.
+  std::vector<size_t> representatives(numCells, SIZE_MAX);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t point = sortedPoints[i];
+    if (corePoints[point])
+    {
+      const size_t root = cellUf.Find(pointCell[point]);
+      if (representatives[root] == SIZE_MAX)
+        representatives[root] = point;
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (corePoints[i])
+      uf.Union(i, representatives[cellUf.Find(pointCell[i])]);
+    else if (borderCells[i] != SIZE_MAX)
+      uf.Union(i, representatives[cellUf.Find(borderCells[i])]);
+  }
 }
 
 } // namespace mlpack
@@ -57,7 +57,18 @@ BINDING_LONG_DESC(
     " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball'. The " +
     PRINT_PARAM_STRING("single_mode") + " parameter will force single-tree "
     "search (as opposed to the default dual-tree search), and '" +
-    PRINT_PARAM_STRING("naive") + " will force brute-force range search.");
+    PRINT_PARAM_STRING("naive") + " will force brute-force range search.  "
+    "By default, the dual-tree search finds the neighbors of all points at "
+    "once; to reduce the memory used, the " + PRINT_PARAM_STRING("batch_size")
+    + " parameter can be set to the number of points to search at once."
+    "\n\n"
+    "For low-dimensional data (up to about five dimensions), the " +
+    PRINT_PARAM_STRING("grid") + " flag can be specified to use a grid-based "
+    "algorithm that does not perform range searches; in that case, " +
+    PRINT_PARAM_STRING("tree_type") + ", " + PRINT_PARAM_STRING("single_mode")
+    + ", " + PRINT_PARAM_STRING("naive") + ", " +
+    PRINT_PARAM_STRING("batch_size") + " and " +
+    PRINT_PARAM_STRING("selection_type") + " are ignored.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -92,6 +103,11 @@ PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_INT_IN("batch_size", "If using dual-tree search, the number of points "
+    "whose neighbors are searched at once (0 searches all points at once).",
+    "b", 0);
+PARAM_FLAG("grid", "If set, the grid-based algorithm will be used instead of "
+    "range search.", "g");
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType, typename PointSelectionPolicy>
@@ -110,6 +126,8 @@ void RunDBSCAN(util::Params& params,
 
   DBSCAN<RangeSearchType, PointSelectionPolicy> d(epsilon, minSize,
       !params.Has("single_mode"), rs, pointSelector);
+  d.BatchSize() = (size_t) params.Get<int>("batch_size");
+  d.GridMode() = params.Has("grid");
 
   // If possible, avoid the overhead of calculating centroids.
   if (params.Has("centroids"))
@@ -161,6 +179,15 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
   RequireParamValue<int>(params, "min_size", [](int y) { return y > 0; },
       true, "invalid value of min_size specified");
 
+  // Value of batch_size should not be negative.
+  RequireParamValue<int>(params, "batch_size", [](int b) { return b >= 0; },
+      true, "invalid value of batch_size specified");
+
+  ReportIgnoredParam(params, {{ "single_mode", true }}, "batch_size");
+  ReportIgnoredParam(params, {{ "grid", true }}, "batch_size");
+  ReportIgnoredParam(params, {{ "grid", true }}, "single_mode");
+  ReportIgnoredParam(params, {{ "grid", true }}, "naive");
+
   // Fire off naive search if needed.
   if (params.Has("naive"))
   {
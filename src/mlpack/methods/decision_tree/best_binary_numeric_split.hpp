@@ -183,6 +183,17 @@ class BestBinaryNumericSplit
       const ElemType& point,
       const arma::vec& splitInfo,
       const AuxiliarySplitInfo& /* aux */);
+
+ private:
+  /**
+   * Return the indices that sort the given values.  If most of the values are
+   * zero, only the nonzero values are sorted, so the cost of the sort depends
+   * on the number of nonzeros.
+   *
+   * @param data Values to sort.
+   */
+  template<typename VecType>
+  static arma::uvec SortIndex(const VecType& data);
 };
 
 } // namespace mlpack
@@ -35,7 +35,7 @@ double BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<size_t> sortedLabels(labels.n_elem);
   arma::rowvec sortedWeights;
   for (size_t i = 0; i < sortedLabels.n_elem; ++i)
@@ -231,7 +231,7 @@ BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<RType> sortedResponses(responses.n_elem);
   arma::Row<WType> sortedWeights;
   for (size_t i = 0; i < sortedResponses.n_elem; ++i)
@@ -387,7 +387,7 @@ BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
     return DBL_MAX; // It can't be outperformed.
 
   // Next, sort the data.
-  arma::uvec sortedIndices = arma::sort_index(data);
+  arma::uvec sortedIndices = SortIndex(data);
   arma::Row<RType> sortedResponses(responses.n_elem);
   arma::Row<WType> sortedWeights;
   for (size_t i = 0; i < sortedResponses.n_elem; ++i)
@@ -521,6 +521,36 @@ BestBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
   return bestFoundGain;
 }
 
+template<typename FitnessFunction>
+template<typename VecType>
+arma::uvec BestBinaryNumericSplit<FitnessFunction>::SortIndex(
+    const VecType& data)
+{
+  const arma::uvec nonzeros = arma::find(data != 0);
+  if (2 * nonzeros.n_elem >= data.n_elem)
+    return arma::sort_index(data);
+
+  // Most of the values are zero (as is the case for sparse data), so only
+  // sort the nonzero values, and put all the zeros in one block between the
+  // negative and the positive values.  The order of equal values does not
+  // matter, since a split is never made between two equal values.
+  const arma::uvec sortedNonzeros = nonzeros(arma::sort_index(
+      arma::Row<typename VecType::elem_type>(data.elem(nonzeros).t())));
+  size_t numNegative = 0;
+  while (numNegative < sortedNonzeros.n_elem &&
+         data[sortedNonzeros[numNegative]] < 0)
+    ++numNegative;
+
+  const arma::uvec zeros = arma::find(data == 0);
+  arma::uvec sortedIndices(data.n_elem);
+  sortedIndices.head(numNegative) = sortedNonzeros.head(numNegative);
+  sortedIndices.subvec(numNegative, numNegative + zeros.n_elem - 1) = zeros;
+  sortedIndices.tail(sortedNonzeros.n_elem - numNegative) =
+      sortedNonzeros.tail(sortedNonzeros.n_elem - numNegative);
+
+  return sortedIndices;
+}
+
 template<typename FitnessFunction>
 template<typename ElemType>
 size_t BestBinaryNumericSplit<FitnessFunction>::CalculateDirection(
@@ -22,6 +22,7 @@
 
 #include "best_binary_numeric_split.hpp"
 #include "random_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
 
 #include "best_binary_categorical_split.hpp"
 #include "all_categorical_split.hpp"
@@ -38,6 +39,17 @@ namespace mlpack {
  *
  * The class inherits from the auxiliary split information in order to prevent
  * an empty auxiliary split information struct from taking any extra size.
+ *
+ * When OpenMP is enabled, nodes holding at least ParallelTrainMinSize points
+ * search the dimensions for the best split in parallel, and children of at
+ * least that size are built in parallel.  The tree that is built is the same
+ * as the one built by a serial search, as long as the dimension selector does
+ * not depend on the random number generator.
+ *
+ * The data can be dense (arma::mat) or sparse (arma::sp_mat); sparse data is
+ * never converted to a dense matrix.  The values of each dimension are read
+ * for the points of one node at a time, and BestBinaryNumericSplit only sorts
+ * the nonzero values of a dimension, with all zeros in a single block.
  */
 template<typename FitnessFunction = GiniGain,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
@@ -56,13 +68,17 @@ class DecisionTree :
   //! Allow access to the dimension selection type.
   typedef DimensionSelectionType DimensionSelection;
 
+  //! The minimum number of points in a node for its split search and its
+  //! children to be handled in parallel.
+  static constexpr size_t ParallelTrainMinSize = 10000;
+
   /**
    * Construct the decision tree on the given data and labels, where the data
    * can be both numeric and categorical. Setting minimumLeafSize and
    * minimumGainSplit too small may cause the tree to overfit, but setting them
    * too large may cause it to underfit.
    *
-   * Use std::move if data or labels are no longer needed to avoid copies.
+   * Use std::move if labels are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param datasetInfo Type information for each dimension of the dataset.
@@ -74,7 +90,7 @@ class DecisionTree :
    * @param dimensionSelector Instantiated dimension selection policy.
    */
   template<typename MatType, typename LabelsType>
-  DecisionTree(MatType data,
+  DecisionTree(const MatType& data,
                const data::DatasetInfo& datasetInfo,
                LabelsType labels,
                const size_t numClasses,
@@ -90,7 +106,7 @@ class DecisionTree :
    * minimumGainSplit too small may cause the tree to overfit, but setting them
    * too large may cause it to underfit.
    *
-   * Use std::move if data or labels are no longer needed to avoid copies.
+   * Use std::move if labels are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param labels Labels for each training point.
@@ -101,7 +117,7 @@ class DecisionTree :
    * @param dimensionSelector Instantiated dimension selection policy.
    */
   template<typename MatType, typename LabelsType>
-  DecisionTree(MatType data,
+  DecisionTree(const MatType& data,
                LabelsType labels,
                const size_t numClasses,
                const size_t minimumLeafSize = 10,
@@ -116,8 +132,7 @@ class DecisionTree :
    * and minimumGainSplit too small may cause the tree to overfit, but setting
    * them too large may cause it to underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param datasetInfo Type information for each dimension of the dataset.
@@ -131,7 +146,7 @@ class DecisionTree :
    */
   template<typename MatType, typename LabelsType, typename WeightsType>
   DecisionTree(
-      MatType data,
+      const MatType& data,
       const data::DatasetInfo& datasetInfo,
       LabelsType labels,
       const size_t numClasses,
@@ -149,8 +164,7 @@ class DecisionTree :
    * and minimumGainSplit too small may cause the tree to overfit, but setting
    * them too large may cause it to underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param labels Labels for each training point.
@@ -163,7 +177,7 @@ class DecisionTree :
    */
   template<typename MatType, typename LabelsType, typename WeightsType>
   DecisionTree(
-      MatType data,
+      const MatType& data,
       LabelsType labels,
       const size_t numClasses,
       WeightsType weights,
@@ -181,8 +195,7 @@ class DecisionTree :
    * cause the tree to overfit, but setting them too large may cause it to
    * underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    *
    * @param other Tree to take ownership of.
    * @param data Dataset to train on.
@@ -196,7 +209,7 @@ class DecisionTree :
   template<typename MatType, typename LabelsType, typename WeightsType>
   DecisionTree(
       const DecisionTree& other,
-      MatType data,
+      const MatType& data,
       const data::DatasetInfo& datasetInfo,
       LabelsType labels,
       const size_t numClasses,
@@ -212,8 +225,7 @@ class DecisionTree :
    * Setting minimumLeafSize and minimumGainSplit too small may cause the tree
    * to overfit, but setting them too large may cause it to underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    * @param other Tree to take ownership of.
    * @param data Dataset to train on.
    * @param labels Labels for each training point.
@@ -227,7 +239,7 @@ class DecisionTree :
   template<typename MatType, typename LabelsType, typename WeightsType>
   DecisionTree(
       const DecisionTree& other,
-      MatType data,
+      const MatType& data,
       LabelsType labels,
       const size_t numClasses,
       WeightsType weights,
@@ -288,7 +300,7 @@ class DecisionTree :
    * minimumGainSplit too small may cause the tree to overfit, but setting them
    * too large may cause it to underfit.
    *
-   * Use std::move if data or labels are no longer needed to avoid copies.
+   * Use std::move if labels are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param datasetInfo Type information for each dimension.
@@ -301,7 +313,7 @@ class DecisionTree :
    * @return The final entropy of decision tree.
    */
   template<typename MatType, typename LabelsType>
-  double Train(MatType data,
+  double Train(const MatType& data,
                const data::DatasetInfo& datasetInfo,
                LabelsType labels,
                const size_t numClasses,
@@ -317,7 +329,7 @@ class DecisionTree :
    * minimumGainSplit too small may cause the tree to overfit, but setting them
    * too large may cause it to underfit.
    *
-   * Use std::move if data or labels are no longer needed to avoid copies.
+   * Use std::move if labels are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param labels Labels for each training point.
@@ -329,7 +341,7 @@ class DecisionTree :
    * @return The final entropy of decision tree.
    */
   template<typename MatType, typename LabelsType>
-  double Train(MatType data,
+  double Train(const MatType& data,
                LabelsType labels,
                const size_t numClasses,
                const size_t minimumLeafSize = 10,
@@ -345,8 +357,7 @@ class DecisionTree :
    * minimumGainSplit too small may cause the tree to overfit, but setting them
    * too large may cause it to underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param datasetInfo Type information for each dimension.
@@ -360,7 +371,7 @@ class DecisionTree :
    * @return The final entropy of decision tree.
    */
   template<typename MatType, typename LabelsType, typename WeightsType>
-  double Train(MatType data,
+  double Train(const MatType& data,
                const data::DatasetInfo& datasetInfo,
                LabelsType labels,
                const size_t numClasses,
@@ -379,8 +390,7 @@ class DecisionTree :
    * minimumLeafSize and minimumGainSplit too small may cause the tree to
    * overfit, but setting them too large may cause it to underfit.
    *
-   * Use std::move if data, labels or weights are no longer needed to avoid
-   * copies.
+   * Use std::move if labels or weights are no longer needed to avoid copies.
    *
    * @param data Dataset to train on.
    * @param labels Labels for each training point.
@@ -393,7 +403,7 @@ class DecisionTree :
    * @return The final entropy of decision tree.
    */
   template<typename MatType, typename LabelsType, typename WeightsType>
-  double Train(MatType data,
+  double Train(const MatType& data,
                LabelsType labels,
                const size_t numClasses,
                WeightsType weights,
@@ -471,6 +481,10 @@ class DecisionTree :
   //! Get the split dimension (only meaningful if this is a non-leaf in a
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  { return (data::Datatype) dimensionType; }
 
   //! Get the class probabilities, if this is a leaf node in the trained tree.
   //! Note that if this is not a leaf, then this may contain arbitrary
@@ -493,6 +507,12 @@ class DecisionTree :
   size_t NumClasses() const;
 
  private:
+  //! RandomForest trains its trees directly on (bootstrap) indices into the
+  //! dataset, to avoid copying the dataset for each tree.
+  template<typename, typename, template<typename> class,
+           template<typename> class, bool>
+  friend class RandomForest;
+
   //! The vector of children.
   std::vector<DecisionTree*> children;
   //! The dimension this node splits on.
@@ -531,14 +551,40 @@ class DecisionTree :
                                    const size_t numClasses,
                                    const WeightsRowType& weights);
 
+  /**
+   * Given the gain of the best split of each dimension (each found against
+   * the gain of the node, with DBL_MAX meaning no split), return the index of
+   * the dimension that a serial search over the dimensions in the same order
+   * would have chosen, or dimGains.size() if there is no split.  bestGain is
+   * set to the gain of the chosen split.
+   */
+  static size_t SelectSplitDimension(const std::vector<double>& dimGains,
+                                     double& bestGain,
+                                     const double minimumGainSplit);
+
+  /**
+   * Return the values in the given dimension of the points of a node, which
+   * are the points indices[begin] through indices[begin + count - 1].
+   */
+  template<typename MatType>
+  static arma::Row<typename MatType::elem_type> NodeValues(
+      const MatType& data,
+      const arma::uvec& indices,
+      const size_t begin,
+      const size_t count,
+      const size_t dimension);
+
   /**
    * Corresponding to the public Train() method, this method is designed for
    * avoiding unnecessary copies during training.  This function is called to
    * train children.
    *
    * @param data Dataset to train on.
-   * @param begin Index of the starting point in the dataset that belongs to
-   *      this node.
+   * @param indices Indices of the points of the dataset; the points of this
+   *      node are indices[begin] through indices[begin + count - 1], and they
+   *      are reordered so that the points of each child are contiguous.
+   * @param begin Index of the first element of indices that belongs to this
+   *      node.
    * @param count Number of points in this node.
    * @param datasetInfo Type information for each dimension.
    * @param labels Labels for each training point.
@@ -546,10 +592,14 @@ class DecisionTree :
    * @param minimumLeafSize Minimum number of points in each leaf node.
    * @param minimumGainSplit Minimum gain for the node to split.
    * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param root Whether this is the root of the tree; the root of a large tree
+   *      opens the OpenMP parallel region for the nodes below it.
    * @return The final entropy of decision tree.
    */
   template<bool UseWeights, typename MatType, typename WeightsType>
-  double Train(MatType& data,
+  double Train(const MatType& data,
+               arma::uvec& indices,
                const size_t begin,
                const size_t count,
                const data::DatasetInfo& datasetInfo,
@@ -559,7 +609,8 @@ class DecisionTree :
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               const bool root = true);
 
   /**
    * Corresponding to the public Train() method, this method is designed for
@@ -567,18 +618,25 @@ class DecisionTree :
    * training children.
    *
    * @param data Dataset to train on.
-   * @param begin Index of the starting point in the dataset that belongs to
-   *      this node.
+   * @param indices Indices of the points of the dataset; the points of this
+   *      node are indices[begin] through indices[begin + count - 1], and they
+   *      are reordered so that the points of each child are contiguous.
+   * @param begin Index of the first element of indices that belongs to this
+   *      node.
    * @param count Number of points in this node.
    * @param labels Labels for each training point.
    * @param numClasses Number of classes in the dataset.
    * @param minimumLeafSize Minimum number of points in each leaf node.
    * @param minimumGainSplit Minimum gain for the node to split.
    * @param maximumDepth Maximum depth for the tree.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @param root Whether this is the root of the tree; the root of a large tree
+   *      opens the OpenMP parallel region for the nodes below it.
    * @return The final entropy of decision tree.
    */
   template<bool UseWeights, typename MatType, typename WeightsType>
-  double Train(MatType& data,
+  double Train(const MatType& data,
+               arma::uvec& indices,
                const size_t begin,
                const size_t count,
                arma::Row<size_t>& labels,
@@ -587,7 +645,8 @@ class DecisionTree :
                const size_t minimumLeafSize,
                const double minimumGainSplit,
                const size_t maximumDepth,
-               DimensionSelectionType& dimensionSelector);
+               DimensionSelectionType& dimensionSelector,
+               const bool root = true);
 };
 
 /**
@@ -28,7 +28,7 @@ DecisionTree<FitnessFunction,
              CategoricalSplitType,
              DimensionSelectionType,
              NoRecursion>::DecisionTree(
-    MatType data,
+    const MatType& data,
     const data::DatasetInfo& datasetInfo,
     LabelsType labels,
     const size_t numClasses,
@@ -37,20 +37,23 @@ DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType dimensionSelector)
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels.
   TrueLabelsType tmpLabels(std::move(labels));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
-      weights, minimumLeafSize, minimumGainSplit, maximumDepth,
+  Train<false>(data, indices, 0, data.n_cols, datasetInfo, tmpLabels,
+      numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
 
@@ -66,7 +69,7 @@ DecisionTree<FitnessFunction,
              CategoricalSplitType,
              DimensionSelectionType,
              NoRecursion>::DecisionTree(
-    MatType data,
+    const MatType& data,
     LabelsType labels,
     const size_t numClasses,
     const size_t minimumLeafSize,
@@ -74,19 +77,22 @@ DecisionTree<FitnessFunction,
     const size_t maximumDepth,
     DimensionSelectionType dimensionSelector)
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels.
   TrueLabelsType tmpLabels(std::move(labels));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, weights,
+  Train<false>(data, indices, 0, data.n_cols, tmpLabels, numClasses, weights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
 
@@ -102,7 +108,7 @@ DecisionTree<FitnessFunction,
              CategoricalSplitType,
              DimensionSelectionType,
              NoRecursion>::DecisionTree(
-    MatType data,
+    const MatType& data,
     const data::DatasetInfo& datasetInfo,
     LabelsType labels,
     const size_t numClasses,
@@ -114,21 +120,24 @@ DecisionTree<FitnessFunction,
     const std::enable_if_t<arma::is_arma_type<
         typename std::remove_reference<WeightsType>::type>::value>*)
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the weighted Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
-      tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
+  Train<true>(data, indices, 0, data.n_cols, datasetInfo, tmpLabels,
+      numClasses, tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
 
@@ -144,7 +153,7 @@ DecisionTree<FitnessFunction,
              CategoricalSplitType,
              DimensionSelectionType,
              NoRecursion>::DecisionTree(
-    MatType data,
+    const MatType& data,
     LabelsType labels,
     const size_t numClasses,
     WeightsType weights,
@@ -155,20 +164,23 @@ DecisionTree<FitnessFunction,
     const std::enable_if_t<arma::is_arma_type<
         typename std::remove_reference<WeightsType>::type>::value>*)
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the weighted Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
+  Train<true>(data, indices, 0, data.n_cols, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
 
@@ -185,7 +197,7 @@ DecisionTree<FitnessFunction,
         DimensionSelectionType,
         NoRecursion>::DecisionTree(
     const DecisionTree& other,
-    MatType data,
+    const MatType& data,
     const data::DatasetInfo& datasetInfo,
     LabelsType labels,
     const size_t numClasses,
@@ -197,18 +209,21 @@ DecisionTree<FitnessFunction,
         NumericAuxiliarySplitInfo(other),
         CategoricalAuxiliarySplitInfo(other)
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
+
   // Pass off work to the weighted Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels, numClasses,
-              tmpWeights, minimumLeafSize, minimumGainSplit);
+  Train<true>(data, indices, 0, data.n_cols, datasetInfo, tmpLabels,
+              numClasses, tmpWeights, minimumLeafSize, minimumGainSplit);
 }
 
 //! Construct and train with weights.
@@ -224,7 +239,7 @@ DecisionTree<FitnessFunction,
         DimensionSelectionType,
         NoRecursion>::DecisionTree(
     const DecisionTree& other,
-    MatType data,
+    const MatType& data,
     LabelsType labels,
     const size_t numClasses,
     WeightsType weights,
@@ -238,20 +253,23 @@ DecisionTree<FitnessFunction,
         NumericAuxiliarySplitInfo(other),
         CategoricalAuxiliarySplitInfo(other)  // other info does need to copy
 {
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the weighted Train() method.
-  Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses, tmpWeights,
+  Train<true>(data, indices, 0, data.n_cols, tmpLabels, numClasses, tmpWeights,
       minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
 }
 
@@ -446,7 +464,7 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType data,
+    const MatType& data,
     const data::DatasetInfo& datasetInfo,
     LabelsType labels,
     const size_t numClasses,
@@ -458,19 +476,22 @@ double DecisionTree<FitnessFunction,
   // Sanity check on data.
   util::CheckSameSizes(data, labels, "DecisionTree::Train()");
 
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels.
   TrueLabelsType tmpLabels(std::move(labels));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  return Train<false>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
+  return Train<false>(data, indices, 0, data.n_cols, datasetInfo, tmpLabels,
       numClasses, weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
@@ -487,7 +508,7 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType data,
+    const MatType& data,
     LabelsType labels,
     const size_t numClasses,
     const size_t minimumLeafSize,
@@ -498,19 +519,22 @@ double DecisionTree<FitnessFunction,
   // Sanity check on data.
   util::CheckSameSizes(data, labels, "DecisionTree::Train()");
 
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels.
   TrueLabelsType tmpLabels(std::move(labels));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  return Train<false>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
+  return Train<false>(data, indices, 0, data.n_cols, tmpLabels, numClasses,
       weights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
@@ -527,7 +551,7 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType data,
+    const MatType& data,
     const data::DatasetInfo& datasetInfo,
     LabelsType labels,
     const size_t numClasses,
@@ -544,20 +568,23 @@ double DecisionTree<FitnessFunction,
   // Sanity check on data.
   util::CheckSameSizes(data, labels, "DecisionTree::Train()");
 
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
-  return Train<true>(tmpData, 0, tmpData.n_cols, datasetInfo, tmpLabels,
+  return Train<true>(data, indices, 0, data.n_cols, datasetInfo, tmpLabels,
       numClasses, tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
@@ -574,7 +601,7 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType data,
+    const MatType& data,
     LabelsType labels,
     const size_t numClasses,
     WeightsType weights,
@@ -590,20 +617,23 @@ double DecisionTree<FitnessFunction,
   // Sanity check on data.
   util::CheckSameSizes(data, labels, "DecisionTree::Train()");
 
-  using TrueMatType = typename std::decay<MatType>::type;
   using TrueLabelsType = typename std::decay<LabelsType>::type;
   using TrueWeightsType = typename std::decay<WeightsType>::type;
 
-  // Copy or move data.
-  TrueMatType tmpData(std::move(data));
+  // Copy or move the labels and weights.
   TrueLabelsType tmpLabels(std::move(labels));
   TrueWeightsType tmpWeights(std::move(weights));
 
   // Set the correct dimensionality for the dimension selector.
-  dimensionSelector.Dimensions() = tmpData.n_rows;
+  dimensionSelector.Dimensions() = data.n_rows;
+
+  // The data is not modified; instead, each node holds a contiguous range
+  // of indices of its points.
+  arma::uvec indices = arma::linspace<arma::uvec>(0, data.n_cols - 1,
+      data.n_cols);
 
   // Pass off work to the Train() method.
-  return Train<true>(tmpData, 0, tmpData.n_cols, tmpLabels, numClasses,
+  return Train<true>(data, indices, 0, data.n_cols, tmpLabels, numClasses,
       tmpWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
       dimensionSelector);
 }
@@ -620,7 +650,8 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType& data,
+    const MatType& data,
+    arma::uvec& indices,
     const size_t begin,
     const size_t count,
     const data::DatasetInfo& datasetInfo,
@@ -630,8 +661,27 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    const bool root)
 {
+  // The root of a large tree opens the parallel region that the tasks of the
+  // nodes below run in.
+  if (root && count >= ParallelTrainMinSize)
+  {
+    double gain = 0.0;
+    #pragma omp parallel
+    {
+      #pragma omp single
+      {
+        gain = Train<UseWeights>(data, indices, begin, count, datasetInfo,
+            labels, numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector, false);
+      }
+    }
+
+    return gain;
+  }
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -649,16 +699,84 @@ double DecisionTree<FitnessFunction,
   size_t bestDim = datasetInfo.Dimensionality(); // This means "no split".
   const size_t end = dimensionSelector.End();
 
-  if (maximumDepth != 1)
+  if (maximumDepth != 1 && count >= ParallelTrainMinSize)
   {
+    // Search each dimension for its best split in a separate task.  Each
+    // search is made against the gain of this node; afterwards we choose the
+    // same dimension as the serial search below would have chosen.
+    std::vector<size_t> dims;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfo(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dims.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(dims.size());
+    const double nodeGain = bestGain;
+    for (size_t j = 0; j < dims.size(); ++j)
     {
+      #pragma omp task shared(data, indices, datasetInfo, labels, weights, \
+          dims, dimGains, dimSplitInfo, numericAux, categoricalAux)
+      {
+        const size_t i = dims[j];
+        const arma::Row<typename MatType::elem_type> values =
+            NodeValues(data, indices, begin, count, i);
+        if (datasetInfo.Type(i) == data::Datatype::categorical)
+        {
+          dimGains[j] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+              nodeGain,
+              values,
+              datasetInfo.NumMappings(i),
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              minimumGainSplit,
+              dimSplitInfo[j],
+              categoricalAux[j]);
+        }
+        else if (datasetInfo.Type(i) == data::Datatype::numeric)
+        {
+          dimGains[j] = NumericSplit::template SplitIfBetter<UseWeights>(
+              nodeGain,
+              values,
+              labels.subvec(begin, begin + count - 1),
+              numClasses,
+              UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
+              minimumLeafSize,
+              minimumGainSplit,
+              dimSplitInfo[j],
+              numericAux[j]);
+        }
+      }
+    }
+    #pragma omp taskwait
+
+    const size_t bestIndex = SelectSplitDimension(dimGains, bestGain,
+        minimumGainSplit);
+    if (bestIndex != dims.size())
+    {
+      bestDim = dims[bestIndex];
+      classProbabilities = std::move(dimSplitInfo[bestIndex]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+        CategoricalAuxiliarySplitInfo::operator=(categoricalAux[bestIndex]);
+      else
+        NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+    }
+  }
+  else if (maximumDepth != 1)
+  {
+    for (size_t i = dimensionSelector.Begin(); i != end;
+         i = dimensionSelector.Next())
+    {
+      const arma::Row<typename MatType::elem_type> values =
+          NodeValues(data, indices, begin, count, i);
       double dimGain = -DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
         dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
+            values,
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
@@ -671,7 +789,7 @@ double DecisionTree<FitnessFunction,
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
         dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
-            data.cols(begin, begin + count - 1).row(i),
+            values,
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
@@ -715,14 +833,14 @@ double DecisionTree<FitnessFunction,
     {
       for (size_t j = begin; j < begin + count; ++j)
         childAssignments[j - begin] = CategoricalSplit::CalculateDirection(
-            data(bestDim, j), classProbabilities, *this);
+            data(bestDim, indices[j]), classProbabilities, *this);
     }
     else
     {
       for (size_t j = begin; j < begin + count; ++j)
       {
         childAssignments[j - begin] = NumericSplit::CalculateDirection(
-            data(bestDim, j), classProbabilities, *this);
+            data(bestDim, indices[j]), classProbabilities, *this);
       }
     }
 
@@ -738,42 +856,52 @@ double DecisionTree<FitnessFunction,
     }
 
     // Split into children.
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = childBegins[i]; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
           childAssignments.swap_cols(currentCol - begin, j - begin);
-          data.swap_cols(currentCol, j);
+          indices.swap_rows(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
           ++currentCol;
         }
       }
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, currentCol - currentChildBegin, minimumGainSplit,
-            maximumDepth - 1, dimensionSelector);
-      }
-      else
+    // Now build the children recursively.  Each child only touches its own
+    // range of the data, so large children are built in separate tasks, each
+    // with its own copy of the dimension selector.
+    children.resize(numChildren, NULL);
+    arma::vec childGains(numChildren);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (childCounts[i] >= ParallelTrainMinSize) \
+          shared(data, indices, datasetInfo, labels, weights, \
+          dimensionSelector, childBegins, childCounts, childGains)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, datasetInfo, labels, numClasses,
-            weights, minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        DimensionSelectionType childSelector(dimensionSelector);
+        DecisionTree* child = new DecisionTree();
+        childGains[i] = child->Train<UseWeights>(data, indices,
+            childBegins[i], childCounts[i], datasetInfo, labels, numClasses,
+            weights, NoRecursion ? childCounts[i] : minimumLeafSize,
+            minimumGainSplit, maximumDepth - 1, childSelector, false);
+        children[i] = child;
       }
-      children.push_back(child);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -804,7 +932,8 @@ double DecisionTree<FitnessFunction,
                     CategoricalSplitType,
                     DimensionSelectionType,
                     NoRecursion>::Train(
-    MatType& data,
+    const MatType& data,
+    arma::uvec& indices,
     const size_t begin,
     const size_t count,
     arma::Row<size_t>& labels,
@@ -813,8 +942,27 @@ double DecisionTree<FitnessFunction,
     const size_t minimumLeafSize,
     const double minimumGainSplit,
     const size_t maximumDepth,
-    DimensionSelectionType& dimensionSelector)
+    DimensionSelectionType& dimensionSelector,
+    const bool root)
 {
+  // The root of a large tree opens the parallel region that the tasks of the
+  // nodes below run in.
+  if (root && count >= ParallelTrainMinSize)
+  {
+    double gain = 0.0;
+    #pragma omp parallel
+    {
+      #pragma omp single
+      {
+        gain = Train<UseWeights>(data, indices, begin, count, labels,
+            numClasses, weights, minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector, false);
+      }
+    }
+
+    return gain;
+  }
+
   // Clear children if needed.
   for (size_t i = 0; i < children.size(); ++i)
     delete children[i];
@@ -834,14 +982,55 @@ double DecisionTree<FitnessFunction,
       UseWeights ? weights.subvec(begin, begin + count - 1) : weights);
   size_t bestDim = data.n_rows; // This means "no split".
 
-  if (maximumDepth != 1)
+  if (maximumDepth != 1 && count >= ParallelTrainMinSize)
+  {
+    // Search each dimension for its best split in a separate task, as in the
+    // overload above.
+    std::vector<size_t> dims;
+    for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
+         i = dimensionSelector.Next())
+      dims.push_back(i);
+
+    std::vector<double> dimGains(dims.size(), DBL_MAX);
+    std::vector<arma::vec> dimSplitInfo(dims.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dims.size());
+    const double nodeGain = bestGain;
+    for (size_t j = 0; j < dims.size(); ++j)
+    {
+      #pragma omp task shared(data, indices, labels, weights, dims, \
+          dimGains, dimSplitInfo, numericAux)
+      {
+        dimGains[j] = NumericSplitType<FitnessFunction>::template
+            SplitIfBetter<UseWeights>(nodeGain,
+            NodeValues(data, indices, begin, count, dims[j]),
+            labels.cols(begin, begin + count - 1),
+            numClasses,
+            UseWeights ? weights.cols(begin, begin + count - 1) : weights,
+            minimumLeafSize,
+            minimumGainSplit,
+            dimSplitInfo[j],
+            numericAux[j]);
+      }
+    }
+    #pragma omp taskwait
+
+    const size_t bestIndex = SelectSplitDimension(dimGains, bestGain,
+        minimumGainSplit);
+    if (bestIndex != dims.size())
+    {
+      bestDim = dims[bestIndex];
+      classProbabilities = std::move(dimSplitInfo[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+    }
+  }
+  else if (maximumDepth != 1)
   {
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
     {
       const double dimGain = NumericSplitType<FitnessFunction>::template
           SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+                                    NodeValues(data, indices, begin, count, i),
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
                                     UseWeights ?
@@ -881,7 +1070,7 @@ double DecisionTree<FitnessFunction,
     for (size_t j = begin; j < begin + count; ++j)
     {
       childAssignments[j - begin] = NumericSplit::CalculateDirection(
-          data(bestDim, j), classProbabilities, *this);
+          data(bestDim, indices[j]), classProbabilities, *this);
     }
 
     // Calculate counts of children in each node.
@@ -896,42 +1085,52 @@ double DecisionTree<FitnessFunction,
       bestGain = 0.0;
     }
 
+    arma::Row<size_t> childBegins(numChildren);
     size_t currentCol = begin;
     for (size_t i = 0; i < numChildren; ++i)
     {
-      size_t currentChildBegin = currentCol;
-      for (size_t j = currentChildBegin; j < begin + count; ++j)
+      childBegins[i] = currentCol;
+      for (size_t j = childBegins[i]; j < begin + count; ++j)
       {
         if (childAssignments[j - begin] == i)
         {
           childAssignments.swap_cols(currentCol - begin, j - begin);
-          data.swap_cols(currentCol, j);
+          indices.swap_rows(currentCol, j);
           labels.swap_cols(currentCol, j);
           if (UseWeights)
             weights.swap_cols(currentCol, j);
           ++currentCol;
         }
       }
+    }
 
-      // Now build the child recursively.
-      DecisionTree* child = new DecisionTree();
-      if (NoRecursion)
-      {
-        child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            currentCol - currentChildBegin, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-      }
-      else
+    // Now build the children recursively.  Each child only touches its own
+    // range of the data, so large children are built in separate tasks, each
+    // with its own copy of the dimension selector.
+    children.resize(numChildren, NULL);
+    arma::vec childGains(numChildren);
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      #pragma omp task if (childCounts[i] >= ParallelTrainMinSize) \
+          shared(data, indices, labels, weights, dimensionSelector, \
+          childBegins, childCounts, childGains)
       {
-        // During recursion entropy of child node may change.
-        double childGain = child->Train<UseWeights>(data, currentChildBegin,
-            currentCol - currentChildBegin, labels, numClasses, weights,
-            minimumLeafSize, minimumGainSplit, maximumDepth - 1,
-            dimensionSelector);
-        bestGain += double(childCounts[i]) / double(count) * (-childGain);
+        DimensionSelectionType childSelector(dimensionSelector);
+        DecisionTree* child = new DecisionTree();
+        childGains[i] = child->Train<UseWeights>(data, indices,
+            childBegins[i], childCounts[i], labels, numClasses, weights,
+            NoRecursion ? childCounts[i] : minimumLeafSize, minimumGainSplit,
+            maximumDepth - 1, childSelector, false);
+        children[i] = child;
       }
-      children.push_back(child);
+    }
+    #pragma omp taskwait
+
+    // During recursion entropy of child node may change.
+    if (!NoRecursion)
+    {
+      for (size_t i = 0; i < numChildren; ++i)
+        bestGain += double(childCounts[i]) / double(count) * (-childGains[i]);
     }
   }
   else
@@ -1168,6 +1367,67 @@ void DecisionTree<FitnessFunction,
   majorityClass = (size_t) maxIndex;
 }
 
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+size_t DecisionTree<FitnessFunction,
+                    NumericSplitType,
+                    CategoricalSplitType,
+                    DimensionSelectionType,
+                    NoRecursion>::SelectSplitDimension(
+    const std::vector<double>& dimGains,
+    double& bestGain,
+    const double minimumGainSplit)
+{
+  // Every gain was found against the gain of the node; in the serial search,
+  // each dimension after the first improvement instead has to beat the best
+  // gain found so far.
+  size_t bestIndex = dimGains.size();
+  for (size_t j = 0; j < dimGains.size(); ++j)
+  {
+    if (dimGains[j] == DBL_MAX)
+      continue;
+
+    if (bestIndex != dimGains.size() &&
+        dimGains[j] <= std::min(bestGain + minimumGainSplit, 0.0))
+      continue;
+
+    bestIndex = j;
+    bestGain = dimGains[j];
+
+    // If the gain is the best possible, no need to keep looking.
+    if (bestGain >= 0.0)
+      break;
+  }
+
+  return bestIndex;
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+template<typename MatType>
+arma::Row<typename MatType::elem_type> DecisionTree<FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType,
+    DimensionSelectionType,
+    NoRecursion>::NodeValues(const MatType& data,
+                             const arma::uvec& indices,
+                             const size_t begin,
+                             const size_t count,
+                             const size_t dimension)
+{
+  arma::Row<typename MatType::elem_type> values(count);
+  for (size_t j = 0; j < count; ++j)
+    values[j] = data(dimension, indices[begin + j]);
+
+  return values;
+}
+
 } // namespace mlpack
 
 #endif
@@ -20,6 +20,7 @@
 #include "best_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "random_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
 #include "all_dimension_select.hpp"
 
 namespace mlpack {
@@ -429,6 +430,13 @@ class DecisionTreeRegressor :
   //! Get the split dimension (only meaningful if this is a non-leaf in a
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  { return (data::Datatype) dimensionType; }
+  //! Get the information used by the split type to choose the child of a
+  //! point (only meaningful if this is a non-leaf in a trained tree).
+  const arma::vec& SplitInfo() const { return splitInfo; }
 
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
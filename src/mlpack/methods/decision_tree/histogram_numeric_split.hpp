@@ -0,0 +1,227 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split between the bins of
+ * a histogram of the dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "best_binary_numeric_split.hpp"
+
+namespace mlpack {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * divides the range of a numeric dimension into at most MaxBins equal-width
+ * bins, builds a histogram of the labels (or responses) in each bin, and then
+ * searches for the best binary split between two bins.  Unlike
+ * BestBinaryNumericSplit, the points are never sorted, so finding a split takes
+ * O(n + MaxBins * numClasses) time instead of O(n log n) time; the split found
+ * is the best split among the bin boundaries, not necessarily the best split
+ * overall.  The split value is placed halfway between the largest value of the
+ * left bin and the smallest value of the right bin.
+ *
+ * This can be used in place of BestBinaryNumericSplit in DecisionTree,
+ * DecisionTreeRegressor and RandomForest to train faster on large datasets.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  //! The maximum number of bins a dimension is divided into.
+  static constexpr size_t MaxBins = 256;
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for classification tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is used only for regression tasks.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It is used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static typename std::enable_if<
+      !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then splitInfo and aux
+   * may be modified.
+   *
+   * This overload is specialized for any fitness function that implements
+   * BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param responses Responses for each point.
+   * @param weights Weights associated with responses.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param splitInfo Stores split information on a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   * @param fitnessFunction The FitnessFunction object instance. It is used to
+   *      evaluate the gain for the split.
+   */
+  template<bool UseWeights, typename VecType, typename ResponsesType,
+           typename WeightVecType>
+  static typename std::enable_if<
+      HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+      double>::type
+  SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& splitInfo,
+      AuxiliarySplitInfo& aux,
+      FitnessFunction& fitnessFunction);
+
+  /**
+   * If a split was found, returns the number of children of the split.
+   * Otherwise returns zero. A binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& splitInfo,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return splitInfo.n_elem == 0 ? 0 : 2;
+  }
+
+  /**
+   * In the case that a split was found, given a point, calculate which child
+   * it should go to (left or right). Otherwise if there was no split, returns
+   * SIZE_MAX.
+   *
+   * @param point Point to calculate direction of.
+   * @param splitInfo Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& splitInfo,
+      const AuxiliarySplitInfo& /* aux */);
+
+ private:
+  /**
+   * Assign each point to one of at most MaxBins equal-width bins between the
+   * minimum and maximum value of the dimension.  Returns the number of bins,
+   * or 0 if all the values are the same (so no split is possible).
+   *
+   * @param data The dimension of data points to bin.
+   * @param bins Set to the bin of each point.
+   * @param binCounts Set to the number of points in each bin.
+   * @param binMins Set to the smallest value in each bin.
+   * @param binMaxs Set to the largest value in each bin.
+   */
+  template<typename VecType>
+  static size_t ComputeBins(const VecType& data,
+                            std::vector<unsigned char>& bins,
+                            arma::Col<size_t>& binCounts,
+                            arma::vec& binMins,
+                            arma::vec& binMaxs);
+
+  /**
+   * Reorder the responses (and weights) so that the responses of each bin are
+   * contiguous, in order of bins, with a counting sort.
+   */
+  template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+  static void SortByBin(
+      const std::vector<unsigned char>& bins,
+      const arma::Col<size_t>& binCounts,
+      const ResponsesType& responses,
+      const WeightVecType& weights,
+      arma::Row<typename ResponsesType::elem_type>& sortedResponses,
+      arma::Row<typename WeightVecType::elem_type>& sortedWeights);
+
+  /**
+   * Return the split value between the given bin and the next non-empty bin.
+   */
+  static double SplitValue(const size_t bin,
+                           const arma::Col<size_t>& binCounts,
+                           const arma::vec& binMins,
+                           const arma::vec& binMaxs);
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
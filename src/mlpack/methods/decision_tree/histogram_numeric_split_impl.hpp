@@ -0,0 +1,569 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split_impl.hpp
+ *
+ * Implementation of strategy that finds the best binary numeric split between
+ * the bins of a histogram.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+
+// Overload used for classification.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Next, bin the data.  If all the values are the same, we can't split in
+  // this dimension.
+  std::vector<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMins, binMaxs;
+  const size_t numBins = ComputeBins(data, bins, binCounts, binMins, binMaxs);
+  if (numBins == 0)
+    return DBL_MAX;
+
+  // Build the histogram of the classes in each bin.
+  arma::Mat<size_t> binClassCounts;
+  arma::mat binClassWeightSums;
+  arma::vec binWeights;
+  if (UseWeights)
+  {
+    binClassWeightSums.zeros(numClasses, numBins);
+    binWeights.zeros(numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+    {
+      binClassWeightSums(labels[i], bins[i]) += weights[i];
+      binWeights[bins[i]] += weights[i];
+    }
+  }
+  else
+  {
+    binClassCounts.zeros(numClasses, numBins);
+    for (size_t i = 0; i < data.n_elem; ++i)
+      ++binClassCounts(labels[i], bins[i]);
+  }
+
+  // Loop through all the boundaries between bins, choosing the best one.  Also,
+  // force a minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // Initially, all the points are on the right.
+  arma::Mat<size_t> classCounts;
+  arma::mat classWeightSums;
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    classWeightSums.zeros(numClasses, 2);
+    classWeightSums.col(1) = arma::sum(binClassWeightSums, 1);
+    totalWeight = arma::accu(binWeights);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    classCounts.zeros(numClasses, 2);
+    classCounts.col(1) = arma::sum(binClassCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftSize = 0;
+  for (size_t bin = 0; bin < numBins - 1; ++bin)
+  {
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Move the points of this bin to the left.
+    if (UseWeights)
+    {
+      classWeightSums.col(0) += binClassWeightSums.col(bin);
+      classWeightSums.col(1) -= binClassWeightSums.col(bin);
+      totalLeftWeight += binWeights[bin];
+      totalRightWeight -= binWeights[bin];
+    }
+    else
+    {
+      classCounts.col(0) += binClassCounts.col(bin);
+      classCounts.col(1) -= binClassCounts.col(bin);
+    }
+    leftSize += binCounts[bin];
+
+    if (leftSize < minimum)
+      continue;
+    if (data.n_elem - leftSize < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(classWeightSums.colptr(0),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(0),
+            numClasses, leftSize);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(classWeightSums.colptr(1),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(classCounts.colptr(1),
+            numClasses, size_t(data.n_elem - leftSize));
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftSize) * leftGain +
+          double(data.n_elem - leftSize) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?  If so, no split will be
+    // better than this, so just take this one.
+    if (gain >= 0.0)
+    {
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Overload used for regression.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    !HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Next, bin the data.  If all the values are the same, we can't split in
+  // this dimension.
+  std::vector<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMins, binMaxs;
+  const size_t numBins = ComputeBins(data, bins, binCounts, binMins, binMaxs);
+  if (numBins == 0)
+    return DBL_MAX;
+
+  // Group the responses by bin, so that the responses on each side of a bin
+  // boundary are contiguous.
+  arma::Row<RType> sortedResponses;
+  arma::Row<WType> sortedWeights;
+  SortByBin<UseWeights>(bins, binCounts, responses, weights, sortedResponses,
+      sortedWeights);
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType totalLeftWeight = 0.0;
+  WType totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = accu(sortedWeights);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Loop through all the boundaries between bins, choosing the best one.
+  size_t leftSize = 0;
+  for (size_t bin = 0; bin < numBins - 1; ++bin)
+  {
+    if (binCounts[bin] == 0)
+      continue;
+
+    if (UseWeights)
+    {
+      const WType binWeight = accu(sortedWeights.subvec(leftSize,
+          leftSize + binCounts[bin] - 1));
+      totalLeftWeight += binWeight;
+      totalRightWeight -= binWeight;
+    }
+    leftSize += binCounts[bin];
+
+    if (leftSize < minimum)
+      continue;
+    if (data.n_elem - leftSize < minimum)
+      break;
+
+    // Calculate the gain for the left and right child.
+    const double leftGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, 0, leftSize);
+    const double rightGain = fitnessFunction.template
+        Evaluate<UseWeights>(sortedResponses, sortedWeights, leftSize,
+            responses.n_elem);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftSize) * leftGain +
+          double(data.n_elem - leftSize) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?  If so, no split will be
+    // better than this, so just take this one.
+    if (gain >= 0.0)
+    {
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+// Optimized version for any fitness function that implements
+// BinaryScanInitialize(), BinaryStep() and BinaryGains() functions.
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename ResponsesType,
+         typename WeightVecType>
+typename std::enable_if<
+    HasOptimizedBinarySplitForms<FitnessFunction, UseWeights>::value,
+    double>::type
+HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& splitInfo,
+    AuxiliarySplitInfo& /* aux */,
+    FitnessFunction& fitnessFunction)
+{
+  typedef typename ResponsesType::elem_type RType;
+  typedef typename WeightVecType::elem_type WType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Next, bin the data.  If all the values are the same, we can't split in
+  // this dimension.
+  std::vector<unsigned char> bins;
+  arma::Col<size_t> binCounts;
+  arma::vec binMins, binMaxs;
+  const size_t numBins = ComputeBins(data, bins, binCounts, binMins, binMaxs);
+  if (numBins == 0)
+    return DBL_MAX;
+
+  // Group the responses by bin, so that the responses on each side of a bin
+  // boundary are contiguous.
+  arma::Row<RType> sortedResponses;
+  arma::Row<WType> sortedWeights;
+  SortByBin<UseWeights>(bins, binCounts, responses, weights, sortedResponses,
+      sortedWeights);
+
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  WType totalWeight = 0.0;
+  WType leftChildWeight = 0.0;
+  WType rightChildWeight = 0.0;
+  if (UseWeights)
+  {
+    totalWeight = accu(sortedWeights);
+    bestFoundGain *= totalWeight;
+
+    for (size_t i = 0; i < minimum - 1; ++i)
+      leftChildWeight += sortedWeights[i];
+
+    for (size_t i = minimum - 1; i < data.n_elem; ++i)
+      rightChildWeight += sortedWeights[i];
+  }
+  else
+  {
+    bestFoundGain *= data.n_elem;
+  }
+
+  // Initialize and precompute various statistics to efficiently compute gain
+  // values for all possible splits.
+  fitnessFunction.template BinaryScanInitialize<UseWeights>(sortedResponses,
+      sortedWeights, minimum);
+
+  // Loop through all the boundaries between bins, choosing the best one.  The
+  // cached statistics are stepped through every point, but the gain is only
+  // computed at the end of each bin.
+  size_t index = minimum;
+  size_t leftSize = 0;
+  for (size_t bin = 0; bin < numBins - 1; ++bin)
+  {
+    if (binCounts[bin] == 0)
+      continue;
+
+    leftSize += binCounts[bin];
+    if (leftSize < minimum)
+      continue;
+    if (data.n_elem - leftSize < minimum)
+      break;
+
+    for (; index <= leftSize; ++index)
+    {
+      if (UseWeights)
+      {
+        leftChildWeight += sortedWeights[index - 1];
+        rightChildWeight -= sortedWeights[index - 1];
+      }
+
+      // Steps through the current index and updates the cached data.
+      fitnessFunction.template BinaryStep<UseWeights>(sortedResponses,
+          sortedWeights, index - 1);
+    }
+
+    // Calculate the gain for the left and right child.
+    std::tuple<double, double> binaryGains = fitnessFunction.BinaryGains();
+    const double leftGain = std::get<0>(binaryGains);
+    const double rightGain = std::get<1>(binaryGains);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = leftChildWeight * leftGain + rightChildWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this split point.
+      gain = double(leftSize) * leftGain +
+          double(data.n_elem - leftSize) * rightGain;
+    }
+
+    // Corner case: is this the best possible split?  If so, no split will be
+    // better than this, so just take this one.
+    if (gain >= 0.0)
+    {
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      return gain;
+    }
+    if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      splitInfo.set_size(1);
+      splitInfo[0] = SplitValue(bin, binCounts, binMins, binMaxs);
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& splitInfo,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (splitInfo.n_elem == 0)
+    return SIZE_MAX;
+  else if (point <= splitInfo[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+template<typename FitnessFunction>
+template<typename VecType>
+size_t HistogramNumericSplit<FitnessFunction>::ComputeBins(
+    const VecType& data,
+    std::vector<unsigned char>& bins,
+    arma::Col<size_t>& binCounts,
+    arma::vec& binMins,
+    arma::vec& binMaxs)
+{
+  const double minValue = arma::min(data);
+  const double maxValue = arma::max(data);
+  if (minValue == maxValue)
+    return 0;
+
+  // There is no point in having more bins than points.
+  const size_t numBins = std::min(MaxBins, (size_t) data.n_elem);
+  const double scale = numBins / (maxValue - minValue);
+
+  bins.resize(data.n_elem);
+  binCounts.zeros(numBins);
+  binMins.set_size(numBins);
+  binMins.fill(DBL_MAX);
+  binMaxs.set_size(numBins);
+  binMaxs.fill(-DBL_MAX);
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    const double value = data[i];
+    // The maximum value would fall just past the last bin.
+    const size_t bin = std::min((size_t) ((value - minValue) * scale),
+        numBins - 1);
+
+    bins[i] = (unsigned char) bin;
+    ++binCounts[bin];
+    binMins[bin] = std::min(binMins[bin], value);
+    binMaxs[bin] = std::max(binMaxs[bin], value);
+  }
+
+  return numBins;
+}
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename ResponsesType, typename WeightVecType>
+void HistogramNumericSplit<FitnessFunction>::SortByBin(
+    const std::vector<unsigned char>& bins,
+    const arma::Col<size_t>& binCounts,
+    const ResponsesType& responses,
+    const WeightVecType& weights,
+    arma::Row<typename ResponsesType::elem_type>& sortedResponses,
+    arma::Row<typename WeightVecType::elem_type>& sortedWeights)
+{
+  // Compute where the points of each bin start.
+  std::vector<size_t> offsets(binCounts.n_elem, 0);
+  for (size_t bin = 1; bin < binCounts.n_elem; ++bin)
+    offsets[bin] = offsets[bin - 1] + binCounts[bin - 1];
+
+  sortedResponses.set_size(responses.n_elem);
+  if (UseWeights)
+    sortedWeights.set_size(responses.n_elem);
+
+  for (size_t i = 0; i < bins.size(); ++i)
+  {
+    const size_t position = offsets[bins[i]]++;
+    sortedResponses[position] = responses[i];
+    if (UseWeights)
+      sortedWeights[position] = weights[i];
+  }
+}
+
+template<typename FitnessFunction>
+double HistogramNumericSplit<FitnessFunction>::SplitValue(
+    const size_t bin,
+    const arma::Col<size_t>& binCounts,
+    const arma::vec& binMins,
+    const arma::vec& binMaxs)
+{
+  // There is always a non-empty bin after a bin we split at, since the right
+  // child is not empty.
+  size_t nextBin = bin + 1;
+  while (binCounts[nextBin] == 0)
+    ++nextBin;
+
+  double splitValue = (binMaxs[bin] + binMins[nextBin]) / 2.0;
+
+  // In some very extreme cases, floating-point inaccuracies can lead to the
+  // split result being the upper bound, which is problematic for later as all
+  // the child points will be sent to the left child.  If this happens, bump it
+  // down incrementally.
+  if (splitValue == binMins[nextBin])
+    splitValue = std::nexttoward(splitValue, binMaxs[bin]);
+
+  return splitValue;
+}
+
+} // namespace mlpack
+
+#endif
@@ -150,6 +150,15 @@ class DTree
    * Greedily expand the tree.  The points in the dataset will be reordered
    * during tree growth.
    *
+   * If the data is dense, the values of each dimension are sorted once before
+   * the tree is grown, and the sorted values are partitioned (keeping their
+   * order) every time a node is split, so the split search never has to sort
+   * the points of a node again; this needs memory for one value and one index
+   * per point and dimension.  This is only possible if oldFromNew holds a
+   * permutation of the indices of the points (as it does when it is
+   * initialized to 0, 1, ..., n - 1).  With OpenMP, the subtrees of large
+   * nodes are grown in parallel tasks.
+   *
    * @param data Dataset to build tree on.
    * @param oldFromNew Mappings from old points to new points.
    * @param useVolReg If true, volume regularization is used.
@@ -181,6 +190,19 @@ class DTree
    */
   double ComputeValue(const VecType& query) const;
 
+  /**
+   * Compute a piecewise constant grid that holds the density of every leaf of
+   * the tree, so that density queries do not need to traverse the tree.  The
+   * coordinates of the grid in each dimension are the split values of that
+   * dimension and the bounds of this node, so the grid gives exactly the same
+   * density as ComputeValue().  This is only practical in low dimensions; if
+   * the grid would have more than maxCells cells, an exception is thrown.
+   *
+   * @param grid Grid to store the densities in.
+   * @param maxCells Maximum number of cells of the grid.
+   */
+  void ComputeGrid(DensityGrid& grid, const size_t maxCells = 10000000) const;
+
   /**
    * Index the buckets for possible usage later; this results in every leaf in
    * the tree having a specific tag (accessible with BucketTag()).  This
@@ -335,14 +357,32 @@ class DTree
   // Utility methods.
 
   /**
-   * Find the dimension to split on.
+   * The values of each dimension of the points, sorted once before the tree is
+   * grown.  For each node, rows start to end - 1 of column d of values hold the
+   * sorted values of dimension d of the points in the node.
+   */
+  struct PresortedData
+  {
+    //! The sorted values of each dimension (one column per dimension).
+    arma::Mat<ElemType> values;
+    //! The key (entry of oldFromNew) of the point of each sorted value.
+    arma::Mat<size_t> keys;
+    //! For each key, whether the point went to the left child in the last
+    //! split of its node.
+    std::vector<char> goesLeft;
+  };
+
+  /**
+   * Find the dimension to split on.  If presorted values are given, they are
+   * used instead of sorting the points of the node in each dimension.
    */
   bool FindSplit(const MatType& data,
                  size_t& splitDim,
                  ElemType& splitValue,
                  double& leftError,
                  double& rightError,
-                 const size_t minLeafSize = 5) const;
+                 const size_t minLeafSize = 5,
+                 const PresortedData* presorted = NULL) const;
 
   /**
    * Split the data, returning the number of points left of the split.
@@ -354,6 +394,66 @@ class DTree
 
   void  FillMinMax(const StatType& mins,
                    const StatType& maxs);
+
+ private:
+  /**
+   * Greedily expand the subtree of this node; this is called by Grow().
+   * presorted may be NULL, in which case the points of each node are sorted
+   * during the split search.
+   */
+  double GrowNode(MatType& data,
+                  arma::Col<size_t>& oldFromNew,
+                  const bool useVolReg,
+                  const size_t maxLeafSize,
+                  const size_t minLeafSize,
+                  PresortedData* presorted);
+
+  /**
+   * Grow the two children of this node, the left one in a separate task if the
+   * node is large enough, and store the values of g_k(t) they return.
+   */
+  void GrowChildren(MatType& data,
+                    arma::Col<size_t>& oldFromNew,
+                    const bool useVolReg,
+                    const size_t maxLeafSize,
+                    const size_t minLeafSize,
+                    PresortedData* presorted,
+                    double& leftG,
+                    double& rightG);
+
+  /**
+   * Sort the values of each dimension of the points in this node.  Returns
+   * false (and leaves presorted empty) if oldFromNew is not a permutation of
+   * the indices of the points.
+   */
+  template<typename T = MatType>
+  bool Presort(const MatType& data,
+               const arma::Col<size_t>& oldFromNew,
+               PresortedData& presorted,
+               const std::enable_if_t<!arma::is_SpMat<T>::value>* = 0) const;
+
+  /**
+   * Sparse data is not presorted, since storing the values of every dimension
+   * would take too much memory; this returns false.
+   */
+  template<typename T = MatType>
+  bool Presort(const MatType& /* data */,
+               const arma::Col<size_t>& /* oldFromNew */,
+               PresortedData& /* presorted */,
+               const std::enable_if_t<arma::is_SpMat<T>::value>* = 0) const
+  { return false; }
+
+  /**
+   * After this node has been split with SplitData(), partition the presorted
+   * values of the node between the children, keeping them sorted.
+   */
+  void PartitionPresorted(PresortedData& presorted,
+                          const arma::Col<size_t>& oldFromNew,
+                          const size_t splitIndex) const;
+
+  //! Minimum number of points in a node for its children to be grown in
+  //! separate tasks.
+  static constexpr size_t parallelGrowMinSize = 20000;
 };
 
 } // namespace mlpack
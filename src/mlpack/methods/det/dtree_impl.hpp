@@ -17,6 +17,34 @@
 
 namespace mlpack {
 
+/**
+ * Put all the splits between the given sorted values in a vector, that can
+ * easily be iterated afterwards.  This is used by ExtractSplits() and by the
+ * split search on presorted data.
+ */
+template<typename ElemType>
+void ExtractSortedSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
+                         const ElemType* sortedVals,
+                         const size_t n,
+                         const size_t minLeafSize)
+{
+  typedef std::pair<ElemType, size_t> SplitItem;
+
+  // Ensure the minimum leaf size on both sides.
+  for (size_t i = minLeafSize - 1; i < n - minLeafSize; ++i)
+  {
+    // This makes sense for real continuous data. This kinda corrupts the data
+    // and estimation if the data is ordinal. Potentially we can fix that by
+    // taking into account ordinality later in the min/max update, but then we
+    // can end-up with a zero-volumed dimension. No good.
+    const ElemType split = (sortedVals[i] + sortedVals[i + 1]) / 2.0;
+
+    // Check if we can split here (two points are different)
+    if (split != sortedVals[i])
+      splitVec.push_back(SplitItem(split, i + 1));
+  }
+}
+
 /**
  * This one sorts and scand the given per-dimension extract and puts all splits
  * in a vector, that can easily be iterated afterwards. General implementation.
@@ -62,23 +90,12 @@ void ExtractSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
                    const size_t end,
                    const size_t minLeafSize)
 {
-  typedef std::pair<ElemType, size_t> SplitItem;
-  arma::rowvec dimVec = data(dim, arma::span(start, end - 1));
+  arma::Row<ElemType> dimVec = data(dim, arma::span(start, end - 1));
 
   // We sort these, in-place (it's a copy of the data, anyways).
   std::sort(dimVec.begin(), dimVec.end());
 
-  for (size_t i = minLeafSize - 1; i < dimVec.n_elem - minLeafSize; ++i)
-  {
-    // This makes sense for real continuous data. This kinda corrupts the data
-    // and estimation if the data is ordinal. Potentially we can fix that by
-    // taking into account ordinality later in the min/max update, but then we
-    // can end-up with a zero-volumed dimension. No good.
-    const ElemType split = (dimVec[i] + dimVec[i + 1]) / 2.0;
-
-    if (split != dimVec[i])
-      splitVec.push_back(SplitItem(split, i + 1));
-  }
+  ExtractSortedSplits(splitVec, dimVec.memptr(), dimVec.n_elem, minLeafSize);
 }
 
 // This the custom, sparse optimized implementation of the same routine.
@@ -433,7 +450,8 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
                                         ElemType& splitValue,
                                         double& leftError,
                                         double& rightError,
-                                        const size_t minLeafSize) const
+                                        const size_t minLeafSize,
+                                        const PresortedData* presorted) const
 {
   typedef std::pair<ElemType, size_t> SplitItem;
 
@@ -479,10 +497,19 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     //   dimVec = arma::sort(dimVec);
     // could be quite inefficient for sparse matrices, due to
     // copy operations (3). This one has custom implementation for dense and
-    // sparse matrices.
+    // sparse matrices.  If the values are presorted, they are already in
+    // order, and no sort is needed.
 
     std::vector<SplitItem> splitVec;
-    ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
+    if (presorted)
+    {
+      ExtractSortedSplits<ElemType>(splitVec,
+          presorted->values.colptr(dim) + start, points, minLeafSize);
+    }
+    else
+    {
+      ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
+    }
 
     // Iterate on all the splits for this dimension
     for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
@@ -579,6 +606,95 @@ size_t DTree<MatType, TagType>::SplitData(
   return left;
 }
 
+template<typename MatType, typename TagType>
+template<typename T>
+bool DTree<MatType, TagType>::Presort(
+    const MatType& data,
+    const arma::Col<size_t>& oldFromNew,
+    PresortedData& presorted,
+    const std::enable_if_t<!arma::is_SpMat<T>::value>* /* junk */) const
+{
+  // The points are tracked by their entries in oldFromNew while the tree is
+  // grown, so these must all be different.
+  std::vector<char> seen(oldFromNew.n_elem, 0);
+  for (size_t i = start; i < end; ++i)
+  {
+    if (oldFromNew[i] >= oldFromNew.n_elem || seen[oldFromNew[i]])
+      return false;
+    seen[oldFromNew[i]] = 1;
+  }
+
+  // The rows of the presorted values are indexed like the columns of the data,
+  // so that the rows start to end - 1 always belong to the node from start to
+  // end; the rows outside of this node are not used.
+  presorted.values.set_size(end, data.n_rows);
+  presorted.keys.set_size(end, data.n_rows);
+  presorted.goesLeft.resize(oldFromNew.n_elem);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t dim = 0; dim < data.n_rows; ++dim)
+  {
+    arma::Col<ElemType> dimVec(end - start);
+    for (size_t i = start; i < end; ++i)
+      dimVec[i - start] = data(dim, i);
+
+    const arma::uvec order = arma::stable_sort_index(dimVec);
+    for (size_t i = 0; i < order.n_elem; ++i)
+    {
+      presorted.values(start + i, dim) = dimVec[order[i]];
+      presorted.keys(start + i, dim) = oldFromNew[start + order[i]];
+    }
+  }
+
+  return true;
+}
+
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::PartitionPresorted(
+    PresortedData& presorted,
+    const arma::Col<size_t>& oldFromNew,
+    const size_t splitIndex) const
+{
+  // SplitData() has put the points of the left child before splitIndex; mark
+  // them, so that the presorted values can be partitioned the same way.
+  for (size_t i = start; i < end; ++i)
+    presorted.goesLeft[oldFromNew[i]] = (i < splitIndex);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t dim = 0; dim < presorted.values.n_cols; ++dim)
+  {
+    ElemType* values = presorted.values.colptr(dim);
+    size_t* keys = presorted.keys.colptr(dim);
+
+    // The values of the left child are moved forward in place (they can never
+    // overwrite a value that has not been read yet), and the values of the
+    // right child are buffered and copied after them; both stay sorted.
+    std::vector<ElemType> rightValues;
+    std::vector<size_t> rightKeys;
+    rightValues.reserve(end - splitIndex);
+    rightKeys.reserve(end - splitIndex);
+
+    size_t left = start;
+    for (size_t i = start; i < end; ++i)
+    {
+      if (presorted.goesLeft[keys[i]])
+      {
+        values[left] = values[i];
+        keys[left] = keys[i];
+        ++left;
+      }
+      else
+      {
+        rightValues.push_back(values[i]);
+        rightKeys.push_back(keys[i]);
+      }
+    }
+
+    std::copy(rightValues.begin(), rightValues.end(), values + left);
+    std::copy(rightKeys.begin(), rightKeys.end(), keys + left);
+  }
+}
+
 // Greedily expand the tree.
 template<typename MatType, typename TagType>
 double DTree<MatType, TagType>::Grow(MatType& data,
@@ -586,6 +702,49 @@ double DTree<MatType, TagType>::Grow(MatType& data,
                                      const bool useVolReg,
                                      const size_t maxLeafSize,
                                      const size_t minLeafSize)
+{
+  // Sort the values of each dimension once, if the node will be split at all;
+  // otherwise the points of each node are sorted when it is split.
+  PresortedData presorted;
+  const bool usePresorted = ((size_t) (end - start) > maxLeafSize) &&
+      Presort(data, oldFromNew, presorted);
+
+  return GrowNode(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+      usePresorted ? &presorted : NULL);
+}
+
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::GrowChildren(MatType& data,
+                                           arma::Col<size_t>& oldFromNew,
+                                           const bool useVolReg,
+                                           const size_t maxLeafSize,
+                                           const size_t minLeafSize,
+                                           PresortedData* presorted,
+                                           double& leftG,
+                                           double& rightG)
+{
+  // The children hold disjoint ranges of the data, of oldFromNew, and of the
+  // presorted values, so they can be grown at the same time.
+  #pragma omp task if ((size_t) (end - start) >= parallelGrowMinSize) \
+      shared(data, oldFromNew, leftG)
+  {
+    leftG = left->GrowNode(data, oldFromNew, useVolReg, maxLeafSize,
+        minLeafSize, presorted);
+  }
+
+  rightG = right->GrowNode(data, oldFromNew, useVolReg, maxLeafSize,
+      minLeafSize, presorted);
+
+  #pragma omp taskwait
+}
+
+template<typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowNode(MatType& data,
+                                         arma::Col<size_t>& oldFromNew,
+                                         const bool useVolReg,
+                                         const size_t maxLeafSize,
+                                         const size_t minLeafSize,
+                                         PresortedData* presorted)
 {
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
@@ -608,11 +767,14 @@ double DTree<MatType, TagType>::Grow(MatType& data,
     size_t dim;
     double splitValueTmp;
     double leftError, rightError;
-    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize))
+    if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize,
+        presorted))
     {
       // Move the data around for the children to have points in a node lie
       // contiguously (to increase efficiency during the training).
       const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew);
+      if (presorted)
+        PartitionPresorted(*presorted, oldFromNew, splitIndex);
 
       // Make max and min vals for the children.
       StatType maxValsL(maxVals);
@@ -631,10 +793,22 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      // The subtrees of large nodes are grown in parallel; the threads are
+      // started at the root.
+      if (root && (size_t) (end - start) >= parallelGrowMinSize)
+      {
+        #pragma omp parallel
+        {
+          #pragma omp single
+          GrowChildren(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+              presorted, leftG, rightG);
+        }
+      }
+      else
+      {
+        GrowChildren(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+            presorted, leftG, rightG);
+      }
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -877,6 +1051,72 @@ double DTree<MatType, TagType>::ComputeValue(const VecType& query) const
       right->ComputeValue(query);
 }
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::ComputeGrid(DensityGrid& grid,
+                                          const size_t maxCells) const
+{
+  // Collect the bounds of the node and the split values of every dimension;
+  // then every cell of the grid lies inside a single leaf.
+  std::vector<std::vector<double>> splits(maxVals.n_elem);
+  for (size_t d = 0; d < maxVals.n_elem; ++d)
+  {
+    splits[d].push_back(minVals[d]);
+    splits[d].push_back(maxVals[d]);
+  }
+
+  std::vector<const DTree*> stack(1, this);
+  while (!stack.empty())
+  {
+    const DTree* node = stack.back();
+    stack.pop_back();
+    if (node->SubtreeLeaves() == 1)
+      continue;
+
+    splits[node->SplitDim()].push_back(node->SplitValue());
+    stack.push_back(node->Left());
+    stack.push_back(node->Right());
+  }
+
+  std::vector<arma::vec> coordinates(maxVals.n_elem);
+  size_t numCells = 1;
+  for (size_t d = 0; d < maxVals.n_elem; ++d)
+  {
+    arma::vec c = arma::unique(arma::vec(splits[d]));
+    // Only keep the split values inside the bounds of this node.
+    coordinates[d] = c.elem(arma::find(c >= minVals[d] && c <= maxVals[d]));
+    if (coordinates[d].n_elem < 2)
+    {
+      std::ostringstream oss;
+      oss << "DTree::ComputeGrid(): dimension " << d << " has zero width; "
+          << "cannot compute a grid!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    const size_t cells = coordinates[d].n_elem - 1;
+    if (numCells > maxCells / cells)
+    {
+      std::ostringstream oss;
+      oss << "DTree::ComputeGrid(): the grid would have more than "
+          << maxCells << " cells!";
+      throw std::invalid_argument(oss.str());
+    }
+    numCells *= cells;
+  }
+
+  grid = DensityGrid(std::move(coordinates), false);
+
+  arma::mat centers;
+  grid.CellCenters(centers);
+  arma::vec& values = grid.Values();
+
+  #pragma omp parallel for num_threads(Parallel::Threads())
+  for (size_t i = 0; i < centers.n_cols; ++i)
+  {
+    const VecType center = ConvTo<VecType>::From(centers.col(i));
+    values[i] = ComputeValue(center);
+  }
+}
+
 // Index the buckets for possible usage later.
 template<typename MatType, typename TagType>
 TagType DTree<MatType, TagType>::TagTree(const TagType& tag, bool every)
@@ -0,0 +1,16 @@
+/**
+ * @file elastic_net.hpp
+ *
+ * Convenience include for mlpack/methods/elastic_net/elastic_net.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_ELASTIC_NET_HPP
+#define MLPACK_ELASTIC_NET_HPP
+
+#include "elastic_net/elastic_net.hpp"
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * @file methods/elastic_net/elastic_net.hpp
+ *
+ * Definition of the ElasticNet class, which fits l1+l2 regularized linear
+ * regression models with cyclic coordinate descent.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * An implementation of the elastic net, fitted with cyclic coordinate descent
+ * and covariance updates.  Let \f$ X \f$ be a matrix where each row is a point
+ * and each column is a dimension and let \f$ y \f$ be a vector of responses.
+ * The problem solved is
+ *
+ * \f[ \min_{\beta} 0.5 || X \beta - y ||_2^2 + \lambda_1 || \beta ||_1 +
+ *     0.5 \lambda_2 || \beta ||_2^2, \f]
+ *
+ * which is the same problem that LARS solves; if \f$ \lambda_2 = 0 \f$, this
+ * is the LASSO.
+ *
+ * The correlations \f$ X^T (y - X \beta) \f$ of all dimensions with the
+ * residual are kept up to date: when a coefficient changes, they are updated
+ * with the corresponding column of the Gram matrix, which is computed the
+ * first time the dimension enters the model.  So, only the columns of the
+ * Gram matrix of the dimensions that are ever nonzero are computed, and the
+ * cost of an update does not depend on the number of points.  The coordinate
+ * descent sweeps only over the active set until convergence; then, the
+ * optimality conditions of all the other dimensions are checked (in parallel,
+ * when OpenMP is available) and the violating dimensions are added to the
+ * active set.
+ *
+ * `TrainPath()` fits a sequence of models for decreasing values of
+ * \f$ \lambda_1 \f$, where each fit is warm-started from the previous one and
+ * reuses the same Gram matrix columns.
+ *
+ * For more details, see the following paper:
+ *
+ * @code
+ * @article{friedman2010regularization,
+ *   title={Regularization paths for generalized linear models via coordinate
+ *       descent},
+ *   author={Friedman, J. and Hastie, T. and Tibshirani, R.},
+ *   journal={Journal of Statistical Software},
+ *   volume={33},
+ *   number={1},
+ *   pages={1--22},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * @tparam ModelMatType Dense matrix type used to store the model.
+ */
+template<typename ModelMatType = arma::mat>
+class ElasticNet
+{
+ public:
+  typedef typename ModelMatType::elem_type ElemType;
+  typedef typename GetColType<ModelMatType>::type ModelColType;
+
+  /**
+   * Set the parameters of the model, without training it.
+   *
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param fitIntercept If true, fit an intercept in the model.
+   * @param tolerance Coordinate descent stops when no coefficient update
+   *     decreases the objective by more than this fraction of
+   *     \f$ || y ||_2^2 \f$.
+   * @param maxIterations Maximum number of coordinate descent sweeps for each
+   *     value of lambda1 (0 means no limit).
+   */
+  ElasticNet(const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const bool fitIntercept = true,
+             const double tolerance = 1e-10,
+             const size_t maxIterations = 10000);
+
+  /**
+   * Set the parameters of the model and train it on the given data.
+   *
+   * @param data Column-major input data.
+   * @param responses A vector of targets.
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param fitIntercept If true, fit an intercept in the model.
+   * @param tolerance Coordinate descent stops when no coefficient update
+   *     decreases the objective by more than this fraction of
+   *     \f$ || y ||_2^2 \f$.
+   * @param maxIterations Maximum number of coordinate descent sweeps for each
+   *     value of lambda1 (0 means no limit).
+   */
+  template<typename MatType,
+           typename ResponsesType,
+           typename = typename std::enable_if<
+               std::is_same<typename ResponsesType::elem_type, ElemType>::value
+           >::type>
+  ElasticNet(const MatType& data,
+             const ResponsesType& responses,
+             const double lambda1 = 0.0,
+             const double lambda2 = 0.0,
+             const bool fitIntercept = true,
+             const double tolerance = 1e-10,
+             const size_t maxIterations = 10000);
+
+  /**
+   * Train the model.  This is a dummy overload so that MetaInfoExtractor can
+   * properly detect that ElasticNet is a regression method.
+   */
+  template<typename MatType>
+  ElemType Train(const MatType& data, const arma::rowvec& responses);
+
+  /**
+   * Train the model on the given data.  If `WarmStart()` is true and the
+   * current model has the same dimensionality, the current coefficients are
+   * used as the starting point of coordinate descent.  Any parameter that is
+   * not specified keeps its current value.
+   *
+   * @param data Column-major input data.
+   * @param responses A vector of targets.
+   * @param lambda1 Regularization parameter for l1-norm penalty.
+   * @param lambda2 Regularization parameter for l2-norm penalty.
+   * @param fitIntercept If true, fit an intercept in the model.
+   * @return The value of the objective function of the trained model.
+   */
+  template<typename MatType,
+           typename ResponsesType,
+           typename = void, /* so MetaInfoExtractor does not get confused */
+           typename = typename std::enable_if<
+               std::is_same<typename ResponsesType::elem_type, ElemType>::value
+           >::type>
+  ElemType Train(const MatType& data,
+                 const ResponsesType& responses,
+                 const std::optional<double> lambda1 = std::nullopt,
+                 const std::optional<double> lambda2 = std::nullopt,
+                 const std::optional<bool> fitIntercept = std::nullopt);
+
+  /**
+   * Train a sequence of models on the given data, one for each of the given
+   * values of lambda1 (in the given order; decreasing values make the best
+   * use of warm starts).  Each model is warm-started from the previous one.
+   * The coefficients of each model are stored as the columns of `betaPath`,
+   * and its intercept in `interceptPath`.  After training, the model holds
+   * the last model of the path.
+   *
+   * @param data Column-major input data.
+   * @param responses A vector of targets.
+   * @param lambda1Path Values of lambda1 to fit models for.
+   * @param betaPath Matrix to store the coefficients of each model in.
+   * @param interceptPath Vector to store the intercept of each model in.
+   */
+  template<typename MatType, typename ResponsesType>
+  void TrainPath(const MatType& data,
+                 const ResponsesType& responses,
+                 const arma::Col<ElemType>& lambda1Path,
+                 ModelMatType& betaPath,
+                 arma::Row<ElemType>& interceptPath);
+
+  /**
+   * Compute the smallest value of lambda1 for which all of the coefficients
+   * are zero, for the given data.  This is the usual starting point of a
+   * regularization path.
+   *
+   * @param data Column-major input data.
+   * @param responses A vector of targets.
+   */
+  template<typename MatType, typename ResponsesType>
+  ElemType MaxLambda1(const MatType& data,
+                      const ResponsesType& responses) const;
+
+  /**
+   * Predict the response of the given point.
+   *
+   * @param point The data point to regress on.
+   * @return Predicted value for `point`.
+   */
+  template<typename VecType>
+  ElemType Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of each point in the given data matrix.
+   *
+   * @param points Column-major data points to regress on.
+   * @param predictions Vector to store the predicted responses in.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Predict(const MatType& points, ResponsesType& predictions) const;
+
+  //! Get the L1 regularization coefficient.
+  double Lambda1() const { return lambda1; }
+  //! Modify the L1 regularization coefficient.
+  double& Lambda1() { return lambda1; }
+
+  //! Get the L2 regularization coefficient.
+  double Lambda2() const { return lambda2; }
+  //! Modify the L2 regularization coefficient.
+  double& Lambda2() { return lambda2; }
+
+  //! Get whether or not to fit an intercept.
+  bool FitIntercept() const { return fitIntercept; }
+  //! Modify whether or not to fit an intercept.
+  bool& FitIntercept() { return fitIntercept; }
+
+  //! Get the relative tolerance of coordinate descent.
+  double Tolerance() const { return tolerance; }
+  //! Modify the relative tolerance of coordinate descent.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of coordinate descent sweeps.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of coordinate descent sweeps.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get whether Train() starts from the current coefficients.
+  bool WarmStart() const { return warmStart; }
+  //! Modify whether Train() starts from the current coefficients.
+  bool& WarmStart() { return warmStart; }
+
+  //! Get the coefficients of the model.
+  const ModelColType& Beta() const { return beta; }
+  //! Modify the coefficients of the model.
+  ModelColType& Beta() { return beta; }
+
+  //! Get the intercept of the model (0 if it is not fitted).
+  ElemType Intercept() const { return intercept; }
+  //! Modify the intercept of the model.
+  ElemType& Intercept() { return intercept; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Prepare the data for coordinate descent: store the (centered, if an
+   * intercept is fitted) data with one column per dimension, and compute the
+   * squared norm of each dimension and its correlation with the responses.
+   */
+  template<typename MatType, typename ResponsesType>
+  void Prepare(const MatType& data, const ResponsesType& responses);
+
+  /**
+   * Run coordinate descent for the given value of lambda1, starting from the
+   * current coefficients, and return the value of the objective function.
+   * The residual correlations must match `beta`.
+   */
+  ElemType Solve(const ElemType l1);
+
+  //! Add the given coefficient change to the residual correlations, computing
+  //! the Gram matrix column of the dimension if necessary.
+  void UpdateCorrelations(const size_t j, const ElemType delta);
+
+  //! Compute the intercept of the current coefficients.
+  ElemType ComputeIntercept() const;
+
+  //! Free the memory used during training.
+  void ClearTrainingData();
+
+  //! Regularization parameter for l1 penalty.
+  double lambda1;
+  //! Regularization parameter for l2 penalty.
+  double lambda2;
+  //! Whether or not to fit an intercept.
+  bool fitIntercept;
+  //! Relative tolerance of coordinate descent.
+  double tolerance;
+  //! Maximum number of coordinate descent sweeps.
+  size_t maxIterations;
+  //! Whether Train() starts from the current coefficients.
+  bool warmStart;
+
+  //! Coefficients of the model.
+  ModelColType beta;
+  //! Intercept of the model.
+  ElemType intercept;
+
+  //! Training data, with one column per dimension (only during training).
+  ModelMatType dataT;
+  //! Centered responses (only during training).
+  ModelColType centeredResponses;
+  //! Mean of each dimension of the data (only during training).
+  ModelColType dataMeans;
+  //! Mean of the responses (only during training).
+  ElemType responsesMean;
+  //! Squared norm of the centered responses (only during training).
+  ElemType responsesSqNorm;
+  //! Correlations of each dimension with the responses (only during
+  //! training).
+  ModelColType responsesCorrelations;
+  //! Squared norm of each dimension (only during training).
+  ModelColType sqNorms;
+  //! Correlations of each dimension with the residual (only during training).
+  ModelColType correlations;
+  //! Gram matrix columns of the dimensions that were ever nonzero (only during
+  //! training).
+  std::vector<ModelColType> gramColumns;
+  //! Dimensions in the active set, in the order they entered it (only during
+  //! training).
+  std::vector<size_t> activeSet;
+  //! Whether each dimension is in the active set (only during training).
+  std::vector<char> isActive;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "elastic_net_impl.hpp"
+
+#endif
@@ -0,0 +1,353 @@
+/**
+ * @file methods/elastic_net/elastic_net_impl.hpp
+ *
+ * Implementation of the ElasticNet class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+#define MLPACK_METHODS_ELASTIC_NET_ELASTIC_NET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "elastic_net.hpp"
+
+namespace mlpack {
+
+template<typename ModelMatType>
+ElasticNet<ModelMatType>::ElasticNet(const double lambda1,
+                                     const double lambda2,
+                                     const bool fitIntercept,
+                                     const double tolerance,
+                                     const size_t maxIterations) :
+    lambda1(lambda1),
+    lambda2(lambda2),
+    fitIntercept(fitIntercept),
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    warmStart(false),
+    intercept(0),
+    responsesMean(0),
+    responsesSqNorm(0)
+{
+  // Nothing to do.
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename>
+ElasticNet<ModelMatType>::ElasticNet(const MatType& data,
+                                     const ResponsesType& responses,
+                                     const double lambda1,
+                                     const double lambda2,
+                                     const bool fitIntercept,
+                                     const double tolerance,
+                                     const size_t maxIterations) :
+    ElasticNet(lambda1, lambda2, fitIntercept, tolerance, maxIterations)
+{
+  Train(data, responses);
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+typename ElasticNet<ModelMatType>::ElemType ElasticNet<ModelMatType>::Train(
+    const MatType& data,
+    const arma::rowvec& responses)
+{
+  return Train(data, responses, this->lambda1, this->lambda2,
+      this->fitIntercept);
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename, typename>
+typename ElasticNet<ModelMatType>::ElemType ElasticNet<ModelMatType>::Train(
+    const MatType& data,
+    const ResponsesType& responses,
+    const std::optional<double> lambda1,
+    const std::optional<double> lambda2,
+    const std::optional<bool> fitIntercept)
+{
+  if (lambda1.has_value())
+    this->lambda1 = lambda1.value();
+  if (lambda2.has_value())
+    this->lambda2 = lambda2.value();
+  if (fitIntercept.has_value())
+    this->fitIntercept = fitIntercept.value();
+
+  Prepare(data, responses);
+  const ElemType objective = Solve((ElemType) this->lambda1);
+  intercept = ComputeIntercept();
+  ClearTrainingData();
+
+  return objective;
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+void ElasticNet<ModelMatType>::TrainPath(
+    const MatType& data,
+    const ResponsesType& responses,
+    const arma::Col<ElemType>& lambda1Path,
+    ModelMatType& betaPath,
+    arma::Row<ElemType>& interceptPath)
+{
+  Prepare(data, responses);
+
+  betaPath.set_size(data.n_rows, lambda1Path.n_elem);
+  interceptPath.set_size(lambda1Path.n_elem);
+  for (size_t i = 0; i < lambda1Path.n_elem; ++i)
+  {
+    Solve(lambda1Path[i]);
+    betaPath.col(i) = beta;
+    interceptPath[i] = ComputeIntercept();
+  }
+
+  if (lambda1Path.n_elem > 0)
+  {
+    lambda1 = lambda1Path[lambda1Path.n_elem - 1];
+    intercept = interceptPath[lambda1Path.n_elem - 1];
+  }
+  else
+  {
+    intercept = ComputeIntercept();
+  }
+
+  ClearTrainingData();
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+typename ElasticNet<ModelMatType>::ElemType
+ElasticNet<ModelMatType>::MaxLambda1(const MatType& data,
+                                     const ResponsesType& responses) const
+{
+  util::CheckSameSizes(data, responses, "ElasticNet::MaxLambda1()");
+
+  // Since the centered data sums to zero over the points, it is enough to
+  // center the responses.
+  ModelColType centered = ConvTo<ModelColType>::From(responses);
+  if (fitIntercept)
+    centered -= mean(centered);
+
+  return (data.n_rows == 0) ? 0 : max(abs(data * centered));
+}
+
+template<typename ModelMatType>
+template<typename VecType>
+typename ElasticNet<ModelMatType>::ElemType ElasticNet<ModelMatType>::Predict(
+    const VecType& point) const
+{
+  return dot(beta, point) + intercept;
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+void ElasticNet<ModelMatType>::Predict(const MatType& points,
+                                       ResponsesType& predictions) const
+{
+  if (points.n_rows != beta.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "ElasticNet::Predict(): points have dimensionality "
+        << points.n_rows << ", but the model has dimensionality "
+        << beta.n_elem << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  predictions = beta.t() * points;
+  predictions += intercept;
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+void ElasticNet<ModelMatType>::Prepare(const MatType& data,
+                                       const ResponsesType& responses)
+{
+  util::CheckSameSizes(data, responses, "ElasticNet::Train()");
+
+  // Coordinate descent works on the dimensions, so store one per column.
+  dataT = trans(ConvTo<ModelMatType>::From(data));
+  centeredResponses = ConvTo<ModelColType>::From(responses);
+  if (fitIntercept)
+  {
+    dataMeans = mean(dataT, 0).t();
+    responsesMean = mean(centeredResponses);
+    dataT.each_row() -= dataMeans.t();
+    centeredResponses -= responsesMean;
+  }
+  else
+  {
+    dataMeans.zeros(data.n_rows);
+    responsesMean = 0;
+  }
+
+  responsesSqNorm = dot(centeredResponses, centeredResponses);
+  sqNorms = sum(square(dataT), 0).t();
+  responsesCorrelations = dataT.t() * centeredResponses;
+  correlations = responsesCorrelations;
+
+  gramColumns.clear();
+  gramColumns.resize(data.n_rows);
+  activeSet.clear();
+  isActive.assign(data.n_rows, 0);
+
+  // Start from the current coefficients if asked to; the dimensions that are
+  // nonzero start in the active set.
+  if (warmStart && beta.n_elem == data.n_rows)
+  {
+    for (size_t j = 0; j < beta.n_elem; ++j)
+    {
+      if (beta[j] != 0)
+      {
+        activeSet.push_back(j);
+        isActive[j] = 1;
+        UpdateCorrelations(j, beta[j]);
+      }
+    }
+  }
+  else
+  {
+    beta.zeros(data.n_rows);
+  }
+}
+
+template<typename ModelMatType>
+typename ElasticNet<ModelMatType>::ElemType ElasticNet<ModelMatType>::Solve(
+    const ElemType l1)
+{
+  const ElemType l2 = (ElemType) lambda2;
+  const ElemType threshold = (ElemType) tolerance *
+      std::max(responsesSqNorm, std::numeric_limits<ElemType>::min());
+
+  size_t iteration = 0;
+  bool converged = false;
+  while (maxIterations == 0 || iteration < maxIterations)
+  {
+    // Sweep over the active set until no coefficient changes significantly.
+    for (; maxIterations == 0 || iteration < maxIterations; ++iteration)
+    {
+      ElemType maxDecrease = 0;
+      for (size_t a = 0; a < activeSet.size(); ++a)
+      {
+        const size_t j = activeSet[a];
+        const ElemType denominator = sqNorms[j] + l2;
+        if (denominator == 0)
+          continue;
+
+        // Minimize the objective along dimension j, with soft thresholding.
+        const ElemType z = correlations[j] + sqNorms[j] * beta[j];
+        const ElemType newBeta = (z > l1) ? (z - l1) / denominator :
+            (z < -l1) ? (z + l1) / denominator : 0;
+        const ElemType delta = newBeta - beta[j];
+        if (delta == 0)
+          continue;
+
+        beta[j] = newBeta;
+        UpdateCorrelations(j, delta);
+        maxDecrease = std::max(maxDecrease, denominator * delta * delta);
+      }
+
+      if (maxDecrease <= threshold)
+      {
+        ++iteration;
+        converged = true;
+        break;
+      }
+    }
+
+    if (!converged)
+      break;
+
+    // Check the optimality conditions of the dimensions outside of the active
+    // set, whose coefficients are zero.
+    std::vector<char> violating(dataT.n_cols, 0);
+    #pragma omp parallel for
+    for (size_t j = 0; j < dataT.n_cols; ++j)
+    {
+      if (!isActive[j] && std::abs(correlations[j]) > l1)
+        violating[j] = 1;
+    }
+
+    bool added = false;
+    for (size_t j = 0; j < dataT.n_cols; ++j)
+    {
+      if (violating[j])
+      {
+        activeSet.push_back(j);
+        isActive[j] = 1;
+        added = true;
+      }
+    }
+
+    if (!added)
+      break;
+
+    // The new dimensions have to be swept over.
+    converged = false;
+  }
+
+  if (!converged)
+  {
+    Log::Warn << "ElasticNet::Train(): coordinate descent did not converge "
+        << "in " << maxIterations << " iterations for lambda1 = " << l1
+        << "." << std::endl;
+  }
+
+  // Since the correlations are X^T y - X^T X beta, the squared norm of the
+  // residual is ||y||^2 - beta^T (X^T y) - beta^T (X^T y - X^T X beta).
+  const ElemType residualSqNorm = responsesSqNorm -
+      dot(beta, responsesCorrelations) - dot(beta, correlations);
+  return 0.5 * residualSqNorm + l1 * norm(beta, 1) +
+      0.5 * l2 * dot(beta, beta);
+}
+
+template<typename ModelMatType>
+void ElasticNet<ModelMatType>::UpdateCorrelations(const size_t j,
+                                                  const ElemType delta)
+{
+  if (gramColumns[j].n_elem == 0)
+    gramColumns[j] = dataT.t() * dataT.col(j);
+
+  correlations -= delta * gramColumns[j];
+}
+
+template<typename ModelMatType>
+typename ElasticNet<ModelMatType>::ElemType
+ElasticNet<ModelMatType>::ComputeIntercept() const
+{
+  return fitIntercept ? responsesMean - dot(dataMeans, beta) : 0;
+}
+
+template<typename ModelMatType>
+void ElasticNet<ModelMatType>::ClearTrainingData()
+{
+  dataT.clear();
+  centeredResponses.clear();
+  dataMeans.clear();
+  sqNorms.clear();
+  responsesCorrelations.clear();
+  correlations.clear();
+  gramColumns.clear();
+  activeSet.clear();
+  isActive.clear();
+}
+
+template<typename ModelMatType>
+template<typename Archive>
+void ElasticNet<ModelMatType>::serialize(Archive& ar,
+                                         const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(lambda1));
+  ar(CEREAL_NVP(lambda2));
+  ar(CEREAL_NVP(fitIntercept));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(warmStart));
+  ar(CEREAL_NVP(beta));
+  ar(CEREAL_NVP(intercept));
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ *
+ * Implements a union-find data structure that can be used by several threads
+ * at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <atomic>
+
+namespace mlpack {
+
+/**
+ * A lock-free Union-Find data structure, with the same interface as UnionFind.
+ * Find() and Union() may be called by several threads at the same time.  Each
+ * component is represented by its element with the smallest index: Union()
+ * links the root with the larger index under the other root with a
+ * compare-and-swap (which is retried if another thread changed the root in the
+ * meantime), and Find() shortens the paths it follows by path halving.
+ */
+class ConcurrentUnionFind
+{
+ private:
+  std::vector<std::atomic<size_t>> parent;
+
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the component containing an element.  If other threads are
+   * calling Union() at the same time, the component may have been merged with
+   * another one by the time this returns.
+   *
+   * @param x the component to be found
+   * @return The index of the component containing x
+   */
+  size_t Find(size_t x)
+  {
+    while (true)
+    {
+      size_t p = parent[x].load(std::memory_order_acquire);
+      if (p == x)
+        return x;
+
+      // Point x to its grandparent; if this fails, another thread has already
+      // changed the parent of x, which is fine too.
+      const size_t gp = parent[p].load(std::memory_order_acquire);
+      if (gp != p)
+      {
+        parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel,
+            std::memory_order_acquire);
+      }
+      x = gp;
+    }
+  }
+
+  /**
+   * Union the components containing x and y.
+   *
+   * @param x one component
+   * @param y the other component
+   */
+  void Union(size_t x, size_t y)
+  {
+    while (true)
+    {
+      x = Find(x);
+      y = Find(y);
+      if (x == y)
+        return;
+
+      // Link the larger root under the smaller one, so that the parent of an
+      // element never has a larger index and no cycle can be formed.
+      if (x < y)
+        std::swap(x, y);
+      size_t expected = x;
+      if (parent[x].compare_exchange_strong(expected, y,
+          std::memory_order_acq_rel, std::memory_order_acquire))
+        return;
+    }
+  }
+}; // class ConcurrentUnionFind
+
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
@@ -64,17 +64,24 @@ namespace mlpack {
  * More advanced usage of the class can use different types of trees, pass in an
  * already-built tree, or compute the MST using the O(n^2) naive algorithm.
  *
+ * Each Boruvka iteration can also be run with a task-parallel dual-tree
+ * traversal; see ParallelDualTreeBoruvka.
+ *
  * @tparam DistanceType The distance metric to use.
  * @tparam MatType The type of data matrix to use.
  * @tparam TreeType Type of tree to use.  This should follow the TreeType policy
  *      API.
+ * @tparam DualTreeTraversalType The type of dual tree traversal to use for each
+ *      iteration (defaults to the tree's default traverser).
  */
 template<
     typename DistanceType = EuclideanDistance,
     typename MatType = arma::mat,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType = KDTree
+             typename TreeMatType> class TreeType = KDTree,
+    template<typename RuleType> class DualTreeTraversalType =
+        TreeType<DistanceType, DTBStat, MatType>::template DualTreeTraverser
 >
 class DualTreeBoruvka
 {
@@ -114,6 +121,10 @@ class DualTreeBoruvka
   //! The instantiated distance metric.
   DistanceType distance;
 
+  //! The core distance of each point (in the order of the tree), if the
+  //! mutual reachability distance is used; otherwise, this is empty.
+  arma::vec coreDistances;
+
   //! For sorting the edge list after the computation.
   struct SortEdgesHelper
   {
@@ -171,6 +182,21 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Compute the minimum spanning tree under the mutual reachability distance
+   * max(core(a), core(b), d(a, b)), as used by HDBSCAN.  Here core(a) is the
+   * core distance of point a, usually the distance to its k-th nearest
+   * neighbor.  The results are stored as in ComputeMST(results).
+   *
+   * If the tree was built by this object, the core distances are given in the
+   * order of the original dataset; otherwise, they must be given in the order
+   * of the points of the tree.
+   *
+   * @param results Matrix which results will be stored in.
+   * @param coreDistances Core distance of each point.
+   */
+  void ComputeMST(arma::mat& results, const arma::vec& coreDistances);
+
  private:
   /**
    * Adds a single edge to the edge list
@@ -197,8 +223,37 @@ class DualTreeBoruvka
    * The values stored in the tree must be reset on each iteration.
    */
   void Cleanup();
+
+  /**
+   * Store the largest core distance of the points of each node in its
+   * statistic.
+   */
+  void SetMaxCoreDistances(Tree* node);
 }; // class DualTreeBoruvka
 
+/**
+ * ParallelDualTreeBoruvka computes the MST like DualTreeBoruvka, but the
+ * dual-tree traversal of each iteration hands the query subtrees of large nodes
+ * to OpenMP tasks.  The tasks traverse disjoint query subtrees; the candidate
+ * edge of each component, which may be shared by several tasks, is updated
+ * under a lock, and the UnionFind structure is only read during the traversal.
+ * The total length of the MST is the same as with DualTreeBoruvka; if
+ * several edges have the same length, a different (but equally short) set of
+ * edges may be returned.
+ *
+ * @tparam TreeType The tree type to use; must provide a
+ *     ParallelDualTreeTraverser (i.e. any BinarySpaceTree variant, or any
+ *     CoverTree variant).
+ */
+template<typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+using ParallelDualTreeBoruvka = DualTreeBoruvka<DistanceType, MatType,
+    TreeType, TreeType<DistanceType, DTBStat, MatType>::template
+        ParallelDualTreeTraverser>;
+
 } // namespace mlpack
 
 #include "dtb_impl.hpp"
@@ -25,8 +25,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-DualTreeBoruvka<DistanceType, MatType, TreeType>::DualTreeBoruvka(
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::DualTreeBoruvka(
     const MatType& dataset,
     const bool naive,
     const DistanceType distance) :
@@ -51,8 +53,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-DualTreeBoruvka<DistanceType, MatType, TreeType>::DualTreeBoruvka(
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::DualTreeBoruvka(
     Tree* tree,
     const DistanceType distance) :
     tree(tree),
@@ -76,8 +80,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-DualTreeBoruvka<DistanceType, MatType, TreeType>::~DualTreeBoruvka()
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::~DualTreeBoruvka()
 {
   if (ownTree)
     delete tree;
@@ -92,15 +98,17 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::ComputeMST(
     arma::mat& results)
 {
   totalDist = 0; // Reset distance.
 
   typedef DTBRules<DistanceType, Tree> RuleType;
   RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, distance);
+                 neighborsOutComponent, distance, coreDistances);
   while (edges.size() < (data.n_cols - 1))
   {
     if (naive)
@@ -112,7 +120,7 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
     }
     else
     {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+      DualTreeTraversalType<RuleType> traverser(rules);
       traverser.Traverse(*tree, *tree);
     }
 
@@ -134,6 +142,49 @@ void DualTreeBoruvka<DistanceType, MatType, TreeType>::ComputeMST(
   Log::Info << "Total spanning tree length: " << totalDist << std::endl;
 }
 
+/**
+ * Compute the MST under the mutual reachability distance.  The core distances
+ * are stored in the order of the tree, and the largest core distance of each
+ * node is cached so that the bounds of the query nodes can account for it.
+ */
+template<
+    typename DistanceType,
+    typename MatType,
+    template<typename TreeDistanceType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::ComputeMST(
+    arma::mat& results,
+    const arma::vec& coreDistances)
+{
+  if (coreDistances.n_elem != data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "DualTreeBoruvka::ComputeMST(): " << coreDistances.n_elem
+        << " core distances were given, but the dataset has " << data.n_cols
+        << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (!naive && ownTree && TreeTraits<Tree>::RearrangesDataset)
+  {
+    this->coreDistances.set_size(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      this->coreDistances[i] = coreDistances[oldFromNew[i]];
+  }
+  else
+  {
+    this->coreDistances = coreDistances;
+  }
+
+  if (!naive)
+    SetMaxCoreDistances(tree);
+
+  ComputeMST(results);
+}
+
 /**
  * Adds a single edge to the edge list
  */
@@ -142,8 +193,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::AddEdge(
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::AddEdge(
     const size_t e1,
     const size_t e2,
     const double distance)
@@ -165,8 +218,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::AddAllEdges()
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::AddAllEdges()
 {
   for (size_t i = 0; i < data.n_cols; ++i)
   {
@@ -192,8 +247,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::EmitResults(
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::EmitResults(
     arma::mat& results)
 {
   // Sort the edges.
@@ -248,8 +305,10 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::CleanupHelper(Tree* tree)
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::CleanupHelper(Tree* tree)
 {
   // Reset the statistic information.
   tree->Stat().MaxNeighborDistance() = DBL_MAX;
@@ -288,16 +347,50 @@ template<
     typename MatType,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType>
-void DualTreeBoruvka<DistanceType, MatType, TreeType>::Cleanup()
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::Cleanup()
 {
   for (size_t i = 0; i < data.n_cols; ++i)
     neighborsDistances[i] = DBL_MAX;
 
+  // Make every point refer to its component directly, so that Find() does not
+  // modify the structure during the next traversal (which may be parallel).
+  connections.Compress();
+
   if (!naive)
     CleanupHelper(tree);
 }
 
+/**
+ * Store the largest core distance of the points held by each node.
+ */
+template<
+    typename DistanceType,
+    typename MatType,
+    template<typename TreeDistanceType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType,
+    template<typename RuleType> class DualTreeTraversalType>
+void DualTreeBoruvka<DistanceType, MatType, TreeType,
+    DualTreeTraversalType>::SetMaxCoreDistances(Tree* node)
+{
+  double maxCoreDistance = 0.0;
+  for (size_t i = 0; i < node->NumChildren(); ++i)
+  {
+    SetMaxCoreDistances(&node->Child(i));
+    maxCoreDistance = std::max(maxCoreDistance,
+        node->Child(i).Stat().MaxCoreDistance());
+  }
+
+  for (size_t i = 0; i < node->NumPoints(); ++i)
+    maxCoreDistance = std::max(maxCoreDistance,
+        coreDistances[node->Point(i)]);
+
+  node->Stat().MaxCoreDistance() = maxCoreDistance;
+}
+
 } // namespace mlpack
 
 #endif
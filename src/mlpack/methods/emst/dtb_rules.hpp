@@ -16,8 +16,32 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
+#include <memory>
+#include <mutex>
+
 namespace mlpack {
 
+/**
+ * The rules of the dual-tree traversal of each iteration of DualTreeBoruvka.
+ * For each component, the shortest edge from a point of the component to a
+ * point of another component is tracked.
+ *
+ * Copies of a DTBRules object share the candidate edges, but each copy has its
+ * own traversal info and counters, so copies can be used by different threads
+ * to traverse disjoint sets of query points (see, e.g., the
+ * ParallelDualTreeTraverser of BinarySpaceTree).  Because points of the same
+ * component may be traversed by different threads, the candidate edge of a
+ * component is only modified while one of a set of locks shared by the copies
+ * is held.  The UnionFind structure must be fully compressed (see
+ * UnionFind::Compress()) before such a traversal, so that Find() does not
+ * modify it.
+ *
+ * If core distances are given, the edges are weighted with the mutual
+ * reachability distance max(core(a), core(b), d(a, b)) instead of d(a, b).  The
+ * tree bounds are still lower bounds of these distances, and the bound of a
+ * query node also accounts for the largest core distance in the node (see
+ * DTBStat::MaxCoreDistance()).
+ */
 template<typename DistanceType, typename TreeType>
 class DTBRules
 {
@@ -27,7 +51,8 @@ class DTBRules
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
-           DistanceType& distance);
+           DistanceType& distance,
+           const arma::vec& coreDistances);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -117,11 +142,34 @@ class DTBRules
   //! The instantiated distance metric.
   DistanceType& distance;
 
+  //! The core distance of each point, if the mutual reachability distance is
+  //! used; otherwise, this is empty.
+  const arma::vec& coreDistances;
+
+  //! The number of locks that protect the candidate edges.
+  static constexpr size_t NumLocks = 256;
+
+  //! Locks of the candidate edges; the candidate edge of component i is
+  //! protected by lock i % NumLocks.  These are shared by all copies.
+  std::shared_ptr<std::vector<std::mutex>> locks;
+
   /**
    * Update the bound for the given query node.
    */
   inline double CalculateBound(TreeType& queryNode) const;
 
+  /**
+   * Get the distance of the candidate edge of the given component.  Another
+   * thread may be updating it, so it is read atomically.
+   */
+  double ComponentDistance(const size_t component) const
+  {
+    double d;
+    #pragma omp atomic read
+    d = neighborsDistances[component];
+    return d;
+  }
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases calculated.
@@ -21,7 +21,8 @@ DTBRules(const arma::mat& dataSet,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
-         DistanceType& distance)
+         DistanceType& distance,
+         const arma::vec& coreDistances)
 :
   dataSet(dataSet),
   connections(connections),
@@ -29,6 +30,8 @@ DTBRules(const arma::mat& dataSet,
   neighborsInComponent(neighborsInComponent),
   neighborsOutComponent(neighborsOutComponent),
   distance(distance),
+  coreDistances(coreDistances),
+  locks(new std::vector<std::mutex>(NumLocks)),
   baseCases(0),
   scores(0)
 {
@@ -55,19 +58,33 @@ double DTBRules<DistanceType, TreeType>::BaseCase(const size_t queryIndex,
     ++baseCases;
     double dist = distance.Evaluate(dataSet.col(queryIndex),
                                     dataSet.col(referenceIndex));
+    if (!coreDistances.is_empty())
+    {
+      dist = std::max(dist, std::max(coreDistances[queryIndex],
+          coreDistances[referenceIndex]));
+    }
 
-    if (dist < neighborsDistances[queryComponentIndex])
+    if (dist < ComponentDistance(queryComponentIndex))
     {
       Log::Assert(queryIndex != referenceIndex);
 
-      neighborsDistances[queryComponentIndex] = dist;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      // Check again while holding the lock, since another thread may have
+      // found a better edge for this component in the meantime.
+      std::lock_guard<std::mutex> lock(
+          (*locks)[queryComponentIndex % NumLocks]);
+      if (dist < neighborsDistances[queryComponentIndex])
+      {
+        #pragma omp atomic write
+        neighborsDistances[queryComponentIndex] = dist;
+        neighborsInComponent[queryComponentIndex] = queryIndex;
+        neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      }
     }
   }
 
-  if (newUpperBound < neighborsDistances[queryComponentIndex])
-    newUpperBound = neighborsDistances[queryComponentIndex];
+  const double componentDistance = ComponentDistance(queryComponentIndex);
+  if (newUpperBound < componentDistance)
+    newUpperBound = componentDistance;
 
   Log::Assert(newUpperBound >= 0.0);
 
@@ -88,11 +105,13 @@ double DTBRules<DistanceType, TreeType>::Score(const size_t queryIndex,
     return DBL_MAX;
 
   const arma::vec queryPoint = dataSet.unsafe_col(queryIndex);
-  const double distance = referenceNode.MinDistance(queryPoint);
+  double distance = referenceNode.MinDistance(queryPoint);
+  if (!coreDistances.is_empty())
+    distance = std::max(distance, coreDistances[queryIndex]);
 
   // If all the points in the reference node are farther than the candidate
   // nearest neighbor for the query's component, we prune.
-  return neighborsDistances[queryComponentIndex] < distance
+  return ComponentDistance(queryComponentIndex) < distance
       ? DBL_MAX : distance;
 }
 
@@ -103,7 +122,7 @@ double DTBRules<DistanceType, TreeType>::Rescore(const size_t queryIndex,
 {
   // We don't need to check component membership again, because it can't
   // change inside a single iteration.
-  return (oldScore > neighborsDistances[connections.Find(queryIndex)])
+  return (oldScore > ComponentDistance(connections.Find(queryIndex)))
       ? DBL_MAX : oldScore;
 }
 
@@ -152,7 +171,7 @@ inline double DTBRules<DistanceType, TreeType>::CalculateBound(
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t pointComponent = connections.Find(queryNode.Point(i));
-    const double bound = neighborsDistances[pointComponent];
+    const double bound = ComponentDistance(pointComponent);
 
     if (bound > worstPointBound)
       worstPointBound = bound;
@@ -176,8 +195,11 @@ inline double DTBRules<DistanceType, TreeType>::CalculateBound(
   const double worstBound = std::max(worstPointBound, worstChildBound);
   const double bestBound = std::min(bestPointBound, bestChildBound);
   // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.
+  // With the mutual reachability distance, the edge of a point can also be as
+  // long as its core distance.
   const double bestAdjustedBound = (bestBound == DBL_MAX) ? DBL_MAX :
-      bestBound + 2 * queryNode.FurthestDescendantDistance();
+      std::max(bestBound + 2 * queryNode.FurthestDescendantDistance(),
+               queryNode.Stat().MaxCoreDistance());
 
   // Update the relevant quantities in the node.
   queryNode.Stat().MaxNeighborDistance() = worstBound;
@@ -40,6 +40,11 @@ class DTBStat
   //! negative.
   int componentMembership;
 
+  //! The largest core distance of the points in this node, if the mutual
+  //! reachability distance is used (see DualTreeBoruvka::ComputeMST()), and 0
+  //! otherwise.
+  double maxCoreDistance;
+
  public:
   /**
    * A generic initializer.  Sets the maximum neighbor distance to its default,
@@ -49,7 +54,8 @@ class DTBStat
       maxNeighborDistance(DBL_MAX),
       minNeighborDistance(DBL_MAX),
       bound(DBL_MAX),
-      componentMembership(-1) { }
+      componentMembership(-1),
+      maxCoreDistance(0.0) { }
 
   /**
    * This is called when a node is finished initializing.  We set the maximum
@@ -65,7 +71,8 @@ class DTBStat
       bound(DBL_MAX),
       componentMembership(
           ((node.NumPoints() == 1) && (node.NumChildren() == 0)) ?
-            node.Point(0) : -1) { }
+            node.Point(0) : -1),
+      maxCoreDistance(0.0) { }
 
   //! Get the maximum neighbor distance.
   double MaxNeighborDistance() const { return maxNeighborDistance; }
@@ -86,6 +93,11 @@ class DTBStat
   int ComponentMembership() const { return componentMembership; }
   //! Modify the component membership of this node.
   int& ComponentMembership() { return componentMembership; }
+
+  //! Get the largest core distance of the points in this node.
+  double MaxCoreDistance() const { return maxCoreDistance; }
+  //! Modify the largest core distance of the points in this node.
+  double& MaxCoreDistance() { return maxCoreDistance; }
 }; // class DTBStat
 
 } // namespace mlpack
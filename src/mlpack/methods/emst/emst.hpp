@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_EMST_EMST_HPP
 
 #include "union_find.hpp"
+#include "concurrent_union_find.hpp"
 #include "edge_pair.hpp"
 #include "dtb.hpp"
 
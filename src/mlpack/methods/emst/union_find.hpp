@@ -60,12 +60,27 @@ class UnionFind
     }
     else
     {
-      // This ensures that the tree has a small depth.
-      parent[x] = Find(parent[x]);
-      return parent[x];
+      // This ensures that the tree has a small depth.  The parent is only
+      // written if it changes, so that Find() does not modify a compressed
+      // structure.
+      const size_t root = Find(parent[x]);
+      if (parent[x] != root)
+        parent[x] = root;
+      return root;
     }
   }
 
+  /**
+   * Make the parent of every element the root of its component.  After this,
+   * Find() does not modify the structure (so it can be called by several
+   * threads at once) until Union() is called.
+   */
+  void Compress()
+  {
+    for (size_t i = 0; i < parent.n_elem; ++i)
+      Find(i);
+  }
+
   /**
    * Union the components containing x and y.
    *
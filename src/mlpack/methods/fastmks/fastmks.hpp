@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_FASTMKS_FASTMKS_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 
 #include "fastmks_stat.hpp"
 
@@ -43,25 +44,44 @@ namespace mlpack {
  * tree.  FastMKS can be run on kernels that work on arbitrary objects --
  * however, this only works with cover trees and other trees that are built only
  * on points in the dataset (and not centroids of regions or anything like
- * that).
+ * that).  Single-precision data can be used with MatType = arma::fmat.
+ *
+ * Naive (brute-force) search is run in parallel over blocks of query points
+ * with OpenMP.  With the LinearKernel, the kernel values between a block of
+ * query points and a block of reference points are computed at once with a
+ * single matrix product (a BLAS GEMM call for dense data).  If the dual-tree
+ * traversal type is a ParallelDualTreeTraverser (see ParallelFastMKS),
+ * dual-tree search is also performed in parallel.  Single-tree search is not
+ * parallelized, because Score() caches kernel evaluations in the reference
+ * tree's statistics.
  *
  * @tparam KernelType Type of kernel to run FastMKS with.
  * @tparam MatType Type of data matrix (usually arma::mat).
  * @tparam TreeType Type of tree to run FastMKS with; it must satisfy the
  *     TreeType policy API.
+ * @tparam DualTreeTraversalType Type of dual-tree traversal to use.
+ * @tparam CountersType The policy that collects traversal statistics during
+ *     tree-based searches (see TraversalCounters); by default, nothing is
+ *     collected.
  */
 template<
     typename KernelType,
     typename MatType = arma::mat,
     template<typename TreeDistanceType,
              typename TreeStatType,
-             typename TreeMatType> class TreeType = StandardCoverTree
+             typename TreeMatType> class TreeType = StandardCoverTree,
+    template<typename RuleType> class DualTreeTraversalType =
+        TreeType<IPMetric<KernelType>, FastMKSStat, MatType>::template
+            DualTreeTraverser,
+    typename CountersType = NullTraversalCounters
 >
 class FastMKS
 {
  public:
   //! Convenience typedef.
   typedef TreeType<IPMetric<KernelType>, FastMKSStat, MatType> Tree;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
 
   /**
    * Create the FastMKS object with an empty reference set and default kernel.
@@ -307,11 +327,42 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  //! Get the traversal statistics of the last tree-based search.
+  const CountersType& Counters() const { return counters; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Perform brute-force search for the given query points.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum kernels to find.
+   * @param indices Matrix to store resulting indices of max-kernel search in.
+   * @param kernels Matrix to store resulting max-kernel values in.
+   * @param sameSet If true, the query set is the reference set, and points are
+   *     not returned as their own candidates.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet);
+
+  /**
+   * Cache the self-kernels of the given reference set in the metric, so that
+   * they are not recomputed while the tree is built and searched.  Nothing is
+   * cached if the tree rearranges the dataset, since the cache refers to the
+   * memory of the columns.
+   */
+  void CacheSelfKernels(const MatType& data);
+
+  //! Return the cached self-kernels of the reference set, or NULL if they are
+  //! not cached.
+  const arma::vec* ReferenceSelfKernels() const;
+
   //! The reference dataset.  We never own this; only the tree or a higher level
   //! does.
   const MatType* referenceSet;
@@ -331,12 +382,15 @@ class FastMKS
   //! kernel.
   IPMetric<KernelType> distance;
 
+  //! The traversal statistics of the last tree-based search.
+  CountersType counters;
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
   //! Compare two candidates based on the value.
   struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
+    bool operator()(const Candidate& c1, const Candidate& c2) const
     {
       return c1.first > c2.first;
     };
@@ -347,6 +401,27 @@ class FastMKS
       CandidateCmp> CandidateList;
 };
 
+/**
+ * ParallelFastMKS performs fast max-kernel search with a task-parallel
+ * dual-tree traversal (with OpenMP).  Single-tree search is not parallelized.
+ *
+ * @tparam KernelType Type of kernel to run FastMKS with.
+ * @tparam MatType Type of data matrix (usually arma::mat).
+ * @tparam TreeType The tree type to use; must provide a
+ *     ParallelDualTreeTraverser (i.e. any CoverTree variant).
+ */
+template<typename KernelType,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = StandardCoverTree>
+using ParallelFastMKS = FastMKS<
+    KernelType,
+    MatType,
+    TreeType,
+    TreeType<IPMetric<KernelType>, FastMKSStat, MatType>::template
+        ParallelDualTreeTraverser>;
+
 } // namespace mlpack
 
 // Include implementation.
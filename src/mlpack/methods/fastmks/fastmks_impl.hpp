@@ -19,14 +19,57 @@
 
 namespace mlpack {
 
+namespace details {
+
+/**
+ * Compute the p-spectrum string kernel values between every point of a block
+ * of reference points (rows) and a block of query points (columns) with one
+ * sparse matrix product.  Used by FastMKS::NaiveSearch().
+ */
+template<typename KernelType, typename MatType, typename ElemType>
+void SpectrumBlockKernels(
+    KernelType& kernel,
+    const MatType& referenceBlock,
+    const MatType& queryBlock,
+    arma::Mat<ElemType>& products,
+    const typename std::enable_if_t<
+        std::is_same<KernelType, PSpectrumStringKernel>::value>* = 0)
+{
+  arma::mat blockKernels;
+  KernelMatrix(kernel, arma::conv_to<arma::mat>::from(referenceBlock),
+      arma::conv_to<arma::mat>::from(queryBlock), blockKernels);
+  products = arma::conv_to<arma::Mat<ElemType>>::from(blockKernels);
+}
+
+/**
+ * Other kernels are not evaluated by blocks; this is never called.
+ */
+template<typename KernelType, typename MatType, typename ElemType>
+void SpectrumBlockKernels(
+    KernelType& /* kernel */,
+    const MatType& /* referenceBlock */,
+    const MatType& /* queryBlock */,
+    arma::Mat<ElemType>& /* products */,
+    const typename std::enable_if_t<
+        !std::is_same<KernelType, PSpectrumStringKernel>::value>* = 0)
+{
+  // Nothing to do.
+}
+
+} // namespace details
+
 // No data; create a model on an empty dataset.
 template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(const bool singleMode,
-                                                const bool naive) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
+    const bool singleMode,
+    const bool naive) :
     referenceSet(new MatType()),
     referenceTree(NULL),
     treeOwner(true),
@@ -43,8 +86,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
     const MatType& referenceSet,
     const bool singleMode,
     const bool naive) :
@@ -64,11 +110,15 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(const MatType& referenceSet,
-                                                KernelType& kernel,
-                                                const bool singleMode,
-                                                const bool naive) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
+    const MatType& referenceSet,
+    KernelType& kernel,
+    const bool singleMode,
+    const bool naive) :
     referenceSet(&referenceSet),
     referenceTree(NULL),
     treeOwner(true),
@@ -79,7 +129,10 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const MatType& referenceSet,
 {
   // If necessary, the reference tree should be built.  There is no query tree.
   if (!naive)
+  {
+    CacheSelfKernels(referenceSet);
     referenceTree = new Tree(referenceSet, distance);
+  }
 }
 
 // No instantiated kernel.
@@ -87,8 +140,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
     MatType&& referenceSet,
     const bool singleMode,
     const bool naive) :
@@ -111,11 +167,15 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(MatType&& referenceSet,
-                                                KernelType& kernel,
-                                                const bool singleMode,
-                                                const bool naive) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
+    MatType&& referenceSet,
+    KernelType& kernel,
+    const bool singleMode,
+    const bool naive) :
     referenceSet(naive ? new MatType(std::move(referenceSet)) : NULL),
     referenceTree(NULL),
     treeOwner(true),
@@ -137,9 +197,13 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(Tree* referenceTree,
-                                                const bool singleMode) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(
+    Tree* referenceTree,
+    const bool singleMode) :
     referenceSet(&referenceTree->Dataset()),
     referenceTree(referenceTree),
     treeOwner(false),
@@ -155,8 +219,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(const FastMKS& other) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(const FastMKS& other) :
     referenceSet(NULL),
     referenceTree(other.referenceTree ? new Tree(*other.referenceTree) : NULL),
     treeOwner(other.referenceTree != NULL),
@@ -176,8 +243,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::FastMKS(FastMKS&& other) :
     referenceSet(other.referenceSet),
     referenceTree(other.referenceTree),
     treeOwner(other.treeOwner),
@@ -199,9 +269,12 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>&
-FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType, DualTreeTraversalType, CountersType>&
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::operator=(const FastMKS& other)
 {
   if (this == &other)
     return *this;
@@ -231,15 +304,21 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  distance = other.distance;
+
+  return *this;
 }
 
 template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>&
-FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType, DualTreeTraversalType, CountersType>&
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::operator=(FastMKS&& other)
 {
   if (this != &other)
   {
@@ -266,8 +345,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-FastMKS<KernelType, MatType, TreeType>::~FastMKS()
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::~FastMKS()
 {
   // If we created the trees, we must delete them.
   if (treeOwner && referenceTree)
@@ -280,8 +362,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Train(const MatType& referenceSet)
 {
   if (setOwner)
     delete this->referenceSet;
@@ -293,6 +378,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet)
   {
     if (treeOwner && referenceTree)
       delete referenceTree;
+    CacheSelfKernels(referenceSet);
     referenceTree = new Tree(referenceSet, distance);
     treeOwner = true;
   }
@@ -302,9 +388,13 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet,
-                                                   KernelType& kernel)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Train(
+    const MatType& referenceSet,
+    KernelType& kernel)
 {
   if (setOwner)
     delete this->referenceSet;
@@ -317,6 +407,7 @@ void FastMKS<KernelType, MatType, TreeType>::Train(const MatType& referenceSet,
   {
     if (treeOwner && referenceTree)
       delete referenceTree;
+    CacheSelfKernels(referenceSet);
     referenceTree = new Tree(referenceSet, distance);
     treeOwner = true;
   }
@@ -326,8 +417,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Train(MatType&& referenceSet)
 {
   if (setOwner)
     delete this->referenceSet;
@@ -336,8 +430,13 @@ void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet)
   {
     if (treeOwner && referenceTree)
       delete referenceTree;
+    // The tree takes the memory of the dataset if it can, so that the cache
+    // only has to be rebuilt when the dataset was copied.
+    CacheSelfKernels(referenceSet);
     referenceTree = new Tree(std::move(referenceSet), distance);
-    referenceSet = referenceTree->Dataset();
+    this->referenceSet = &referenceTree->Dataset();
+    if (!distance.SelfKernelsCached(*this->referenceSet))
+      CacheSelfKernels(*this->referenceSet);
     treeOwner = true;
     setOwner = false;
   }
@@ -352,9 +451,13 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet,
-                                                   KernelType& kernel)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Train(
+    MatType&& referenceSet,
+    KernelType& kernel)
 {
   if (setOwner)
     delete this->referenceSet;
@@ -365,7 +468,13 @@ void FastMKS<KernelType, MatType, TreeType>::Train(MatType&& referenceSet,
   {
     if (treeOwner && referenceTree)
       delete referenceTree;
+    // The tree takes the memory of the dataset if it can, so that the cache
+    // only has to be rebuilt when the dataset was copied.
+    CacheSelfKernels(referenceSet);
     referenceTree = new Tree(std::move(referenceSet), distance);
+    this->referenceSet = &referenceTree->Dataset();
+    if (!distance.SelfKernelsCached(*this->referenceSet))
+      CacheSelfKernels(*this->referenceSet);
     treeOwner = true;
     setOwner = false;
   }
@@ -380,8 +489,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Train(Tree* tree)
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Train(Tree* tree)
 {
   if (naive)
     throw std::invalid_argument("cannot call FastMKS::Train() with a tree when "
@@ -405,8 +517,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Search(
     const MatType& querySet,
     const size_t k,
     arma::Mat<size_t>& indices,
@@ -436,34 +551,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = distance.Kernel().Evaluate(querySet.col(q),
-                                                       referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
-
+    NaiveSearch(querySet, k, indices, kernels, false);
     return;
   }
 
@@ -472,14 +560,16 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   {
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
-    typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, querySet, k, distance.Kernel());
+    typedef FastMKSRules<KernelType, Tree, CountersType> RuleType;
+    RuleType rules(*referenceSet, querySet, k, distance.Kernel(),
+        ReferenceSelfKernels());
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
     for (size_t i = 0; i < querySet.n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
 
+    counters = rules.Counters();
     Log::Info << rules.BaseCases() << " base cases." << std::endl;
     Log::Info << rules.Scores() << " scores." << std::endl;
 
@@ -499,8 +589,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Search(
     Tree* queryTree,
     const size_t k,
     arma::Mat<size_t>& indices,
@@ -533,13 +626,15 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   indices.set_size(k, queryTree->Dataset().n_cols);
   kernels.set_size(k, queryTree->Dataset().n_cols);
 
-  typedef FastMKSRules<KernelType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), k, distance.Kernel());
+  typedef FastMKSRules<KernelType, Tree, CountersType> RuleType;
+  RuleType rules(*referenceSet, queryTree->Dataset(), k, distance.Kernel(),
+      ReferenceSelfKernels());
 
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  DualTreeTraversalType<RuleType> traverser(rules);
 
   traverser.Traverse(*queryTree, *referenceTree);
 
+  counters = rules.Counters();
   Log::Info << rules.BaseCases() << " base cases." << std::endl;
   Log::Info << rules.Scores() << " scores." << std::endl;
 
@@ -550,8 +645,11 @@ template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void FastMKS<KernelType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::Search(
     const size_t k,
     arma::Mat<size_t>& indices,
     arma::mat& kernels)
@@ -563,37 +661,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = distance.Kernel().Evaluate(referenceSet->col(q),
-                                                       referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
-
+    NaiveSearch(*referenceSet, k, indices, kernels, true);
     return;
   }
 
@@ -602,8 +670,9 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   {
     // Create rules object (this will store the results).  This constructor
     // precalculates each self-kernel value.
-    typedef FastMKSRules<KernelType, Tree> RuleType;
-    RuleType rules(*referenceSet, *referenceSet, k, distance.Kernel());
+    typedef FastMKSRules<KernelType, Tree, CountersType> RuleType;
+    RuleType rules(*referenceSet, *referenceSet, k, distance.Kernel(),
+        ReferenceSelfKernels());
 
     typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
@@ -615,6 +684,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
 
     Log::Info << "Pruned " << numPrunes << " nodes." << std::endl;
 
+    counters = rules.Counters();
     Log::Info << rules.BaseCases() << " base cases." << std::endl;
     Log::Info << rules.Scores() << " scores." << std::endl;
 
@@ -627,14 +697,142 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   Search(referenceTree, k, indices, kernels);
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  // The query points are split into blocks that are handled by different
+  // threads.  For the linear kernel, the kernel values between a block of query
+  // points and a block of reference points are computed with a single matrix
+  // product, and for the p-spectrum string kernel with a single sparse matrix
+  // product.
+  const bool linear = std::is_same<KernelType, LinearKernel>::value;
+  const bool spectrum = std::is_same<KernelType, PSpectrumStringKernel>::value;
+  const bool blocked = linear || spectrum;
+  const size_t queryBlockSize = 64;
+  const size_t referenceBlockSize = 1024;
+  const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+      queryBlockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t queryBegin = b * queryBlockSize;
+    const size_t queryEnd = std::min(queryBegin + queryBlockSize,
+        (size_t) querySet.n_cols);
+
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues(queryEnd - queryBegin,
+        CandidateList(CandidateCmp(), std::vector<Candidate>(k, def)));
+
+    for (size_t r = 0; r < referenceSet->n_cols; r += referenceBlockSize)
+    {
+      const size_t referenceEnd = std::min(r + referenceBlockSize,
+          (size_t) referenceSet->n_cols);
+
+      // For blocked kernels, products(i, j) holds the kernel value between
+      // reference point r + i and query point queryBegin + j.
+      arma::Mat<ElemType> products;
+      if (linear)
+      {
+        products = arma::Mat<ElemType>(
+            referenceSet->cols(r, referenceEnd - 1).t() *
+            querySet.cols(queryBegin, queryEnd - 1));
+      }
+      else if (spectrum)
+      {
+        details::SpectrumBlockKernels(distance.Kernel(),
+            MatType(referenceSet->cols(r, referenceEnd - 1)),
+            MatType(querySet.cols(queryBegin, queryEnd - 1)), products);
+      }
+
+      for (size_t q = queryBegin; q < queryEnd; ++q)
+      {
+        CandidateList& pqueue = pqueues[q - queryBegin];
+        for (size_t i = r; i < referenceEnd; ++i)
+        {
+          if (sameSet && q == i)
+            continue; // Don't return the point as its own candidate.
+
+          const double eval = blocked ?
+              (double) products(i - r, q - queryBegin) :
+              distance.Kernel().Evaluate(querySet.col(q), referenceSet->col(i));
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, i);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+      }
+    }
+
+    for (size_t q = queryBegin; q < queryEnd; ++q)
+    {
+      CandidateList& pqueue = pqueues[q - queryBegin];
+      for (size_t j = 1; j <= k; ++j)
+      {
+        indices(k - j, q) = pqueue.top().second;
+        kernels(k - j, q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::CacheSelfKernels(const MatType& data)
+{
+  if (TreeTraits<Tree>::RearrangesDataset)
+    distance.ClearSelfKernels();
+  else
+    distance.CacheSelfKernels(data);
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
+const arma::vec* FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::ReferenceSelfKernels() const
+{
+  return distance.SelfKernelsCached(*referenceSet) ? &distance.SelfKernels() :
+      NULL;
+}
+
 //! Serialize the model.
 template<typename KernelType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         typename CountersType>
 template<typename Archive>
-void FastMKS<KernelType, MatType, TreeType>::serialize(
+void FastMKS<KernelType, MatType, TreeType,
+DualTreeTraversalType, CountersType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences for search.
@@ -16,6 +16,7 @@
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -25,11 +26,21 @@ namespace mlpack {
  * performing exact max-kernel search. For each point in the query dataset, it
  * keeps track of the k best candidates in the reference dataset.
  *
+ * Copies of a FastMKSRules object share the same candidate lists and cached
+ * self-kernels, but each copy has its own traversal info, base case cache, and
+ * counters.  This allows copies to be used by different threads to search for
+ * disjoint sets of query points (see the ParallelDualTreeTraverser of
+ * CoverTree).
+ *
  * @tparam KernelType Type of kernel to run FastMKS with.
  * @tparam TreeType Type of tree to run FastMKS with; it must satisfy the
  *     TreeType policy API.
+ * @tparam CountersType The policy that collects traversal statistics (see
+ *     TraversalCounters); by default, nothing is collected.
  */
-template<typename KernelType, typename TreeType>
+template<typename KernelType,
+         typename TreeType,
+         typename CountersType = NullTraversalCounters>
 class FastMKSRules
 {
  public:
@@ -41,11 +52,15 @@ class FastMKSRules
    * @param querySet Set of query data.
    * @param k Number of candidates to search for.
    * @param kernel Kernel to run FastMKS with.
+   * @param referenceSelfKernels If not NULL, the self-kernels K(r, r) of the
+   *     reference points, which are then not recomputed (nor, if the query set
+   *     is the reference set, those of the query points).
    */
   FastMKSRules(const typename TreeType::Mat& referenceSet,
                const typename TreeType::Mat& querySet,
                const size_t k,
-               KernelType& kernel);
+               KernelType& kernel,
+               const arma::vec* referenceSelfKernels = NULL);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -118,6 +133,11 @@ class FastMKSRules
   //! Modify the number of times Score() was called.
   size_t& Scores() { return scores; }
 
+  //! Get the traversal counters.
+  const CountersType& Counters() const { return counters; }
+  //! Modify the traversal counters.
+  CountersType& Counters() { return counters; }
+
   typedef typename mlpack::TraversalInfo<TreeType> TraversalInfoType;
 
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
@@ -146,16 +166,18 @@ class FastMKSRules
 
   //! Set of candidates for each point.  We use a min-heap built on a
   //! std::vector to represent the list of candidate points for each query
-  //! point.
-  std::vector<std::vector<Candidate>> candidates;
+  //! point.  This is shared between copies of the rules.
+  std::shared_ptr<std::vector<std::vector<Candidate>>> candidates;
 
   //! Number of points to search for.
   const size_t k;
 
-  //! Cached query set self-kernels (|| q || for each q).
-  arma::vec queryKernels;
-  //! Cached reference set self-kernels (|| r || for each r).
-  arma::vec referenceKernels;
+  //! Cached query set self-kernels (|| q || for each q).  This is shared
+  //! between copies of the rules.
+  std::shared_ptr<arma::vec> queryKernels;
+  //! Cached reference set self-kernels (|| r || for each r).  This is shared
+  //! between copies of the rules.
+  std::shared_ptr<arma::vec> referenceKernels;
 
   //! The instantiated kernel.
   KernelType& kernel;
@@ -170,6 +192,11 @@ class FastMKSRules
   //! Calculate the bound for a given query node.
   double CalculateBound(TreeType& queryNode) const;
 
+  //! Compute the square root of the self-kernel of each point in the given
+  //! dataset (with OpenMP, if available).
+  void SelfKernels(const typename TreeType::Mat& data,
+                   arma::vec& selfKernels) const;
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
@@ -185,6 +212,8 @@ class FastMKSRules
   size_t baseCases;
   //! For benchmarking.
   size_t scores;
+  //! The traversal counters; these are also updated by Rescore().
+  mutable CountersType counters;
 
   TraversalInfoType traversalInfo;
 };
@@ -17,15 +17,18 @@
 
 namespace mlpack {
 
-template<typename KernelType, typename TreeType>
-FastMKSRules<KernelType, TreeType>::FastMKSRules(
+template<typename KernelType, typename TreeType, typename CountersType>
+FastMKSRules<KernelType, TreeType, CountersType>::FastMKSRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
-    KernelType& kernel) :
+    KernelType& kernel,
+    const arma::vec* referenceSelfKernels) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(new std::vector<std::vector<Candidate>>()),
     k(k),
+    referenceKernels(new arma::vec(referenceSet.n_cols)),
     kernel(kernel),
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
@@ -33,16 +36,23 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     baseCases(0),
     scores(0)
 {
-  // Precompute each self-kernel.
-  queryKernels.set_size(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    queryKernels[i] = std::sqrt(kernel.Evaluate(querySet.col(i),
-                                                querySet.col(i)));
+  // Precompute each self-kernel, unless they were given.
+  if (referenceSelfKernels != NULL &&
+      referenceSelfKernels->n_elem == referenceSet.n_cols)
+    *referenceKernels = arma::sqrt(*referenceSelfKernels);
+  else
+    SelfKernels(referenceSet, *referenceKernels);
 
-  referenceKernels.set_size(referenceSet.n_cols);
-  for (size_t i = 0; i < referenceSet.n_cols; ++i)
-    referenceKernels[i] = std::sqrt(kernel.Evaluate(referenceSet.col(i),
-                                                    referenceSet.col(i)));
+  // In monochromatic search, the query self-kernels are the same.
+  if (&querySet == &referenceSet)
+  {
+    queryKernels = referenceKernels;
+  }
+  else
+  {
+    queryKernels.reset(new arma::vec(querySet.n_cols));
+    SelfKernels(querySet, *queryKernels);
+  }
 
   // Set to invalid memory, so that the first node combination does not try to
   // dereference null pointers.
@@ -57,11 +67,30 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
 
   std::vector<Candidate> pqueue(k, def);
   std::make_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
-  candidates = std::vector<std::vector<Candidate>>(querySet.n_cols, pqueue);
+  candidates->assign(querySet.n_cols, pqueue);
+
+  counters.AddQueries(querySet.n_cols);
 }
 
-template<typename KernelType, typename TreeType>
-void FastMKSRules<KernelType, TreeType>::GetResults(
+template<typename KernelType, typename TreeType, typename CountersType>
+void FastMKSRules<KernelType, TreeType, CountersType>::SelfKernels(
+    const typename TreeType::Mat& data,
+    arma::vec& selfKernels) const
+{
+  #pragma omp parallel num_threads(Parallel::Threads())
+  {
+    // The kernel may not be safe to call from several threads at once.
+    KernelType threadKernel(kernel);
+
+    #pragma omp for
+    for (size_t i = 0; i < (size_t) data.n_cols; ++i)
+      selfKernels[i] = std::sqrt(threadKernel.Evaluate(data.col(i),
+                                                       data.col(i)));
+  }
+}
+
+template<typename KernelType, typename TreeType, typename CountersType>
+void FastMKSRules<KernelType, TreeType, CountersType>::GetResults(
     arma::Mat<size_t>& indices,
     arma::mat& products)
 {
@@ -70,7 +99,7 @@ void FastMKSRules<KernelType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    std::vector<Candidate>& pqueue = candidates[i];
+    std::vector<Candidate>& pqueue = (*candidates)[i];
     std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
     for (size_t j = 0; j < k; ++j)
     {
@@ -80,9 +109,9 @@ void FastMKSRules<KernelType, TreeType>::GetResults(
   }
 }
 
-template<typename KernelType, typename TreeType>
+template<typename KernelType, typename TreeType, typename CountersType>
 inline mlpack_force_inline
-double FastMKSRules<KernelType, TreeType>::BaseCase(
+double FastMKSRules<KernelType, TreeType, CountersType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -120,12 +149,13 @@ double FastMKSRules<KernelType, TreeType>::BaseCase(
   return kernelEval;
 }
 
-template<typename KernelType, typename TreeType>
-double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
-                                                 TreeType& referenceNode)
+template<typename KernelType, typename TreeType, typename CountersType>
+double FastMKSRules<KernelType, TreeType, CountersType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   // Compare with the current best.
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
 
   // See if we can perform a parent-child prune.
   const double furthestDist = referenceNode.FurthestDescendantDistance();
@@ -154,11 +184,11 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
     else
     {
       maxKernelBound = lastKernel +
-          combinedDistBound * queryKernels[queryIndex];
+          combinedDistBound * (*queryKernels)[queryIndex];
     }
 
     if (maxKernelBound < bestKernel)
-      return DBL_MAX;
+      return counters.Score(referenceNode, DBL_MAX);
   }
 
   // Calculate the maximum possible kernel value, either by calculating the
@@ -181,7 +211,7 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
   }
   else
   {
-    arma::vec refCenter;
+    arma::Col<typename TreeType::ElemType> refCenter;
     referenceNode.Center(refCenter);
 
     kernelEval = kernel.Evaluate(querySet.col(queryIndex), refCenter);
@@ -207,17 +237,19 @@ double FastMKSRules<KernelType, TreeType>::Score(const size_t queryIndex,
   }
   else
   {
-    maxKernel = kernelEval + furthestDist * queryKernels[queryIndex];
+    maxKernel = kernelEval + furthestDist * (*queryKernels)[queryIndex];
   }
 
   // We return the inverse of the maximum kernel so that larger kernels are
   // recursed into first.
-  return (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX;
+  return counters.Score(referenceNode,
+      (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX);
 }
 
-template<typename KernelType, typename TreeType>
-double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
-                                                 TreeType& referenceNode)
+template<typename KernelType, typename TreeType, typename CountersType>
+double FastMKSRules<KernelType, TreeType, CountersType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
   // Update and get the query node's bound.
   queryNode.Stat().Bound() = CalculateBound(queryNode);
@@ -313,7 +345,7 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
     // It is not possible that this node combination can contain a point
     // combination with kernel value better than the minimum kernel value to
     // improve any of the results, so we can prune it.
-    return DBL_MAX;
+    return counters.Score(queryNode, referenceNode, DBL_MAX);
   }
 
   // We were unable to perform a parent-child or parent-parent prune, so now we
@@ -349,8 +381,8 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
   else
   {
     // Calculate the maximum possible kernel value.
-    arma::vec queryCenter;
-    arma::vec refCenter;
+    arma::Col<typename TreeType::ElemType> queryCenter;
+    arma::Col<typename TreeType::ElemType> refCenter;
     queryNode.Center(queryCenter);
     referenceNode.Center(refCenter);
 
@@ -402,28 +434,33 @@ double FastMKSRules<KernelType, TreeType>::Score(TreeType& queryNode,
 
   // We return the inverse of the maximum kernel so that larger kernels are
   // recursed into first.
-  return (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX;
+  return counters.Score(queryNode, referenceNode,
+      (maxKernel >= bestKernel) ? (1.0 / maxKernel) : DBL_MAX);
 }
 
-template<typename KernelType, typename TreeType>
-double FastMKSRules<KernelType, TreeType>::Rescore(const size_t queryIndex,
-                                                   TreeType& /*referenceNode*/,
-                                                   const double oldScore) const
+template<typename KernelType, typename TreeType, typename CountersType>
+double FastMKSRules<KernelType, TreeType, CountersType>::Rescore(
+    const size_t queryIndex,
+    TreeType& referenceNode,
+    const double oldScore) const
 {
-  const double bestKernel = candidates[queryIndex].front().first;
+  const double bestKernel = (*candidates)[queryIndex].front().first;
 
-  return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
+  return counters.Rescore(referenceNode, oldScore,
+      ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX);
 }
 
-template<typename KernelType, typename TreeType>
-double FastMKSRules<KernelType, TreeType>::Rescore(TreeType& queryNode,
-                                                   TreeType& /*referenceNode*/,
-                                                   const double oldScore) const
+template<typename KernelType, typename TreeType, typename CountersType>
+double FastMKSRules<KernelType, TreeType, CountersType>::Rescore(
+    TreeType& queryNode,
+    TreeType& referenceNode,
+    const double oldScore) const
 {
   queryNode.Stat().Bound() = CalculateBound(queryNode);
   const double bestKernel = queryNode.Stat().Bound();
 
-  return ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX;
+  return counters.Rescore(referenceNode, oldScore,
+      ((1.0 / oldScore) >= bestKernel) ? oldScore : DBL_MAX);
 }
 
 /**
@@ -433,9 +470,9 @@ double FastMKSRules<KernelType, TreeType>::Rescore(TreeType& queryNode,
  *
  * @param queryNode Query node to calculate bound for.
  */
-template<typename KernelType, typename TreeType>
-double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
-    const
+template<typename KernelType, typename TreeType, typename CountersType>
+double FastMKSRules<KernelType, TreeType, CountersType>::CalculateBound(
+    TreeType& queryNode) const
 {
   // We have four possible bounds -- just like NeighborSearchRules, but they are
   // slightly different in this context.
@@ -457,7 +494,7 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
     const size_t point = queryNode.Point(i);
-    const std::vector<Candidate>& candidatesPoints = candidates[point];
+    const std::vector<Candidate>& candidatesPoints = (*candidates)[point];
     if (candidatesPoints.front().first < worstPointKernel)
       worstPointKernel = candidatesPoints.front().first;
 
@@ -480,7 +517,7 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
     for (iter it = candidatesPoints.begin(); it != candidatesPoints.end(); ++it)
     {
       const double candidateKernel = it->first - queryDescendantDistance *
-          referenceKernels[it->second];
+          (*referenceKernels)[it->second];
       if (candidateKernel < worstPointCandidateKernel)
         worstPointCandidateKernel = candidateKernel;
     }
@@ -521,13 +558,13 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
  * @param index Index of reference point which is being inserted.
  * @param product Kernel value for given candidate.
  */
-template<typename KernelType, typename TreeType>
-inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
+template<typename KernelType, typename TreeType, typename CountersType>
+inline void FastMKSRules<KernelType, TreeType, CountersType>::InsertNeighbor(
     const size_t queryIndex,
     const size_t index,
     const double product)
 {
-  std::vector<Candidate>& pqueue = candidates[queryIndex];
+  std::vector<Candidate>& pqueue = (*candidates)[queryIndex];
   if (product > pqueue.front().first)
   {
     Candidate c = std::make_pair(product, index);
@@ -535,6 +572,7 @@ inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
     std::pop_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
     pqueue.back() = c;
     std::push_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+    counters.BoundUpdate();
   }
 }
 
@@ -61,15 +61,15 @@ class FastMKSStat
       }
       else
       {
-        selfKernel = std::sqrt(node.Distance().Kernel().Evaluate(
-            node.Dataset().col(node.Point(0)),
+        // The metric may have cached the self-kernels of the dataset.
+        selfKernel = std::sqrt(node.Distance().SelfKernel(
             node.Dataset().col(node.Point(0))));
       }
     }
     else
     {
       // Calculate the centroid.
-      arma::vec center;
+      arma::Col<typename TreeType::ElemType> center;
       node.Center(center);
 
       selfKernel = std::sqrt(node.Distance().Kernel().Evaluate(center, center));
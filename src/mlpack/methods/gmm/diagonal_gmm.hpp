@@ -278,6 +278,53 @@ class DiagonalGMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Update the DiagonalGMM in place with a new batch of observations, using one
+   * step of stepwise (online) EM.  The batch is used to compute the expected
+   * sufficient statistics of each component (its share of the points, and the
+   * first and second moments of those points), and these are blended with the
+   * statistics implied by the current model:
+   *
+   *   s_new = (1 - stepSize) s_model + stepSize s_batch.
+   *
+   * The weights, means and covariances are then recomputed from s_new, and the
+   * covariance constraint of the fitter is applied.  The model must already be
+   * initialized (for instance with Train() on a first batch).  The earlier
+   * observations are not needed, so a model can be kept up to date as new data
+   * arrives without refitting on the whole history.
+   *
+   * The step size controls how quickly old data is forgotten.  Setting it to
+   * n_batch / n_total, where n_total is the number of points seen so far
+   * (including this batch), weighs every point equally; a decaying schedule
+   * such as stepSize = (t + 2)^(-alpha) for the t'th update, with alpha in
+   * (0.5, 1], gives the usual convergence guarantee of stepwise EM; a constant
+   * step size tracks a model that changes over time.
+   *
+   * See the following paper for more details:
+   *
+   * @code
+   * @inproceedings{liang2009online,
+   *   title={Online EM for Unsupervised Models},
+   *   author={Liang, P. and Klein, D.},
+   *   booktitle={Proceedings of Human Language Technologies: The 2009 Annual
+   *       Conference of the North American Chapter of the Association for
+   *       Computational Linguistics},
+   *   pages={611--619},
+   *   year={2009}
+   * }
+   * @endcode
+   *
+   * @param observations New batch of observations.
+   * @param stepSize Weight of the new batch, in (0, 1].
+   * @param fitter Fitter whose E-step and covariance constraint are used.
+   * @return The log-likelihood of the batch under the model before the update.
+   */
+  template<typename FittingType = EMFit<KMeans<>, DiagonalConstraint,
+      DiagonalGaussianDistribution>>
+  double Update(const arma::mat& observations,
+                const double stepSize,
+                FittingType fitter = FittingType());
+
   /**
    * Classify the given observations as being from an individual component in
    * this DiagonalGMM. The resultant classifications are stored in the 'labels'
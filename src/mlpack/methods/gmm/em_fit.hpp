@@ -36,6 +36,9 @@ namespace mlpack {
  *
  * This method should create 'clusters' clusters, and return the assignment of
  * each point to a cluster.
+ *
+ * The E-step and the M-step are parallelized with OpenMP: the E-step over
+ * blocks of observations, and the M-step over the components.
  */
 template<typename InitialClusteringType = KMeans<>,
          typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
@@ -105,6 +108,34 @@ class EMFit
                 arma::vec& weights,
                 const bool useInitialModel = false);
 
+  /**
+   * Compute the sufficient statistics of the E-step for the given model, and
+   * return the log-likelihood of the model.  The observations are processed in
+   * blocks of columns in parallel, so the full matrix of responsibilities (one
+   * per point and component) is never stored.  The sums and second moments of
+   * each component are centered on the current mean of that component.  This
+   * is also used by the stepwise EM updates of GMM::Update() and
+   * DiagonalGMM::Update().
+   *
+   * @param observations Data matrix.
+   * @param dists Current distributions.
+   * @param weights Current a priori weights.
+   * @param responsibilities Set to the sum of the responsibilities of each
+   *     component.
+   * @param sums Set to the responsibility-weighted sum of (x - mean) for each
+   *     component (one per column).
+   * @param secondMoments Set to the responsibility-weighted sum of
+   *     (x - mean) (x - mean)^T for each component (one per slice); if the
+   *     distribution is diagonal, only the diagonal is stored, as a column.
+   */
+  double AccumulateStatistics(
+      const arma::mat& observations,
+      const std::vector<Distribution>& dists,
+      const arma::vec& weights,
+      arma::vec& responsibilities,
+      arma::mat& sums,
+      arma::cube& secondMoments) const;
+
   //! Get the clusterer.
   const InitialClusteringType& Clusterer() const { return clusterer; }
   //! Modify the clusterer.
@@ -176,6 +207,9 @@ class EMFit
       arma::vec& weights,
       const bool useInitialModel);
 
+  //! Number of observations processed at once by each thread.
+  static constexpr size_t emBlockSize = 1024;
+
   //! Maximum iterations of EM algorithm.
   size_t maxIterations;
   //! Tolerance for convergence of EM.
@@ -69,13 +69,18 @@ Estimate(const arma::mat& observations,
   if (!useInitialModel)
     InitialClustering(observations, dists, weights);
 
-  double l = LogLikelihood(observations, dists, weights);
+  // The E-step also computes the log-likelihood of the current model, so each
+  // iteration only needs one pass over the data.
+  arma::vec responsibilities;
+  arma::mat sums;
+  arma::cube secondMoments;
+  double l = AccumulateStatistics(observations, dists, weights,
+      responsibilities, sums, secondMoments);
 
   Log::Debug << "EMFit::Estimate(): initial clustering log-likelihood: "
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
@@ -84,56 +89,26 @@ Estimate(const arma::mat& observations,
     Log::Info << "EMFit::Estimate(): iteration " << iteration << ", "
         << "log-likelihood " << l << "." << std::endl;
 
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += std::log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // Store the sum of the probability of each state over all the observations.
-    arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      probRowSums(i) = AccuLog(condLogProb.col(i));
-    }
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
+    // Calculate the new means and covariances from the sufficient statistics.
+    // The components are independent, so this is done in parallel.
+    #pragma omp parallel for schedule(dynamic)
     for (size_t i = 0; i < dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
+      if (responsibilities[i] == 0.0)
         continue;
 
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
+      // The statistics are centered on the old mean; this is the difference
+      // between the new mean and the old mean.
+      const arma::vec delta = sums.col(i) / responsibilities[i];
+      dists[i].Mean() += delta;
 
       // If the distribution is DiagonalGaussianDistribution, calculate the
       // covariance only with diagonal components.
       if (std::is_same<Distribution, DiagonalGaussianDistribution>::value)
       {
-        arma::vec covariance = sum((tmp % tmp) %
-            (ones<arma::vec>(observations.n_rows) *
-            trans(exp(condLogProb.col(i) - probRowSums[i]))), 1);
+        arma::vec covariance = secondMoments.slice(i).col(0) /
+            responsibilities[i] - arma::square(delta);
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(covariance);
@@ -141,9 +116,8 @@ Estimate(const arma::mat& observations,
       }
       else
       {
-        arma::mat tmpB = tmp.each_row() % trans(exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
-        arma::mat covariance = tmp * trans(tmpB);
+        arma::mat covariance = secondMoments.slice(i) / responsibilities[i] -
+            delta * delta.t();
 
         // Apply covariance constraint.
         constraint.ApplyConstraint(covariance);
@@ -153,16 +127,125 @@ Estimate(const arma::mat& observations,
 
     // Calculate the new values for omega using the updated conditional
     // probabilities.
-    weights = exp(probRowSums - std::log(observations.n_cols));
+    weights = responsibilities / (double) observations.n_cols;
 
-    // Update values of l; calculate new log-likelihood.
+    // Update values of l; calculate the statistics and log-likelihood of the
+    // new model.
     lOld = l;
-    l = LogLikelihood(observations, dists, weights);
+    l = AccumulateStatistics(observations, dists, weights, responsibilities,
+        sums, secondMoments);
 
     iteration++;
   }
 }
 
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+double EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+AccumulateStatistics(const arma::mat& observations,
+                     const std::vector<Distribution>& dists,
+                     const arma::vec& weights,
+                     arma::vec& responsibilities,
+                     arma::mat& sums,
+                     arma::cube& secondMoments) const
+{
+  const bool isDiagGaussDist = std::is_same<Distribution,
+      DiagonalGaussianDistribution>::value;
+  const size_t dimensionality = observations.n_rows;
+  const size_t numBlocks = (observations.n_cols + emBlockSize - 1) /
+      emBlockSize;
+
+  responsibilities.zeros(dists.size());
+  sums.zeros(dimensionality, dists.size());
+  secondMoments.zeros(dimensionality, isDiagGaussDist ? 1 : dimensionality,
+      dists.size());
+  double logLikelihood = 0.0;
+  size_t zeroLikelihoodPoints = 0;
+
+  #pragma omp parallel
+  {
+    // Each thread accumulates the statistics of its blocks separately.
+    arma::vec localResponsibilities(dists.size(), arma::fill::zeros);
+    arma::mat localSums(dimensionality, dists.size(), arma::fill::zeros);
+    arma::cube localMoments(secondMoments.n_rows, secondMoments.n_cols,
+        dists.size(), arma::fill::zeros);
+    double localLogLikelihood = 0.0;
+    size_t localZeroLikelihoodPoints = 0;
+
+    arma::vec logProbs;
+    #pragma omp for schedule(dynamic)
+    for (size_t b = 0; b < numBlocks; ++b)
+    {
+      const size_t begin = b * emBlockSize;
+      const size_t count = std::min((size_t) emBlockSize,
+          (size_t) observations.n_cols - begin);
+      arma::mat block;
+      MakeAlias(block, observations, dimensionality, count,
+          begin * dimensionality);
+
+      // Compute the log-probability of each point under each weighted
+      // component, and normalize each column to get the responsibilities.
+      arma::mat condLogProb(dists.size(), count);
+      for (size_t i = 0; i < dists.size(); ++i)
+      {
+        dists[i].LogProbability(block, logProbs);
+        condLogProb.row(i) = logProbs.t() + std::log(weights[i]);
+      }
+
+      for (size_t j = 0; j < count; ++j)
+      {
+        // Avoid dividing by zero; if the probability for everything is 0, we
+        // don't want to make it NaN.
+        const double probSum = AccuLog(condLogProb.col(j));
+        if (probSum != -std::numeric_limits<double>::infinity())
+        {
+          condLogProb.col(j) -= probSum;
+          localLogLikelihood += probSum;
+        }
+        else
+        {
+          ++localZeroLikelihoodPoints;
+          localLogLikelihood = -std::numeric_limits<double>::infinity();
+        }
+      }
+
+      const arma::mat condProb = arma::exp(condLogProb);
+      localResponsibilities += arma::sum(condProb, 1);
+
+      // Accumulate the weighted sums and second moments of each component,
+      // centered on the current mean of the component for accuracy.
+      for (size_t i = 0; i < dists.size(); ++i)
+      {
+        const arma::mat centered = block.each_col() - dists[i].Mean();
+        const arma::rowvec probs = condProb.row(i);
+        localSums.col(i) += centered * probs.t();
+        if (isDiagGaussDist)
+          localMoments.slice(i) += arma::square(centered) * probs.t();
+        else
+          localMoments.slice(i) += (centered.each_row() % probs) * centered.t();
+      }
+    }
+
+    #pragma omp critical
+    {
+      responsibilities += localResponsibilities;
+      sums += localSums;
+      secondMoments += localMoments;
+      logLikelihood += localLogLikelihood;
+      zeroLikelihoodPoints += localZeroLikelihoodPoints;
+    }
+  }
+
+  if (zeroLikelihoodPoints > 0)
+  {
+    Log::Info << "Likelihood of " << zeroLikelihoodPoints << " points is 0!  "
+        << "They are probably outliers." << std::endl;
+  }
+
+  return logLikelihood;
+}
+
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
@@ -378,26 +461,32 @@ LogLikelihood(const arma::mat& observations,
               const arma::vec& weights) const
 {
   double logLikelihood = 0;
+  const size_t numBlocks = (observations.n_cols + emBlockSize - 1) /
+      emBlockSize;
 
-  arma::vec logPhis;
-  arma::mat logLikelihoods(dists.size(), observations.n_cols);
-
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+  #pragma omp parallel for schedule(dynamic) reduction(+:logLikelihood)
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    dists[i].LogProbability(observations, logPhis);
-    logLikelihoods.row(i) = std::log(weights(i)) + trans(logPhis);
-  }
-  // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
-  {
-    if (AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    const size_t begin = b * emBlockSize;
+    const size_t count = std::min((size_t) emBlockSize,
+        (size_t) observations.n_cols - begin);
+    arma::mat block;
+    MakeAlias(block, observations, observations.n_rows, count,
+        begin * observations.n_rows);
+
+    // It has to be LogProbability() otherwise Probability() would overflow
+    // easily.
+    arma::vec logPhis;
+    arma::mat logLikelihoods(dists.size(), count);
+    for (size_t i = 0; i < dists.size(); ++i)
     {
-      Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
-          << "outlier." << std::endl;
+      dists[i].LogProbability(block, logPhis);
+      logLikelihoods.row(i) = std::log(weights(i)) + trans(logPhis);
     }
-    logLikelihood += AccuLog(logLikelihoods.col(j));
+
+    // Now sum over every point.
+    for (size_t j = 0; j < count; ++j)
+      logLikelihood += AccuLog(logLikelihoods.col(j));
   }
 
   return logLikelihood;
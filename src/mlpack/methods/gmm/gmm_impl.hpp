@@ -86,7 +86,8 @@ inline void GMM::LogProbability(const arma::mat& observation,
   // Store log-probability value in a matrix.
   arma::mat logProb(observation.n_cols, gaussians);
 
-  // Assign value to the matrix.
+  // Assign value to the matrix; each component fills its own column.
+  #pragma omp parallel for schedule(dynamic)
   for (size_t i = 0; i < gaussians; i++)
   {
     arma::vec temp(logProb.colptr(i), observation.n_cols, false, true);
@@ -194,23 +195,22 @@ inline arma::vec GMM::Random() const
 inline void GMM::Classify(const arma::mat& observations,
                           arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
-  // We should not have to fill this with values, because each one should be
-  // overwritten.
-  labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  // Find the maximum probability component of each point, computing the
+  // probabilities of all points for one component at a time.  We have to use
+  // LogProbability() otherwise Probability() would overflow easily.
+  labels.zeros(observations.n_cols);
+  arma::vec probabilities(observations.n_cols);
+  probabilities.fill(-std::numeric_limits<double>::infinity());
+  arma::vec newProbs;
+  for (size_t j = 0; j < gaussians; ++j)
   {
-    // Find maximum probability component.
-    double probability = -std::numeric_limits<double>::infinity();
-    for (size_t j = 0; j < gaussians; ++j)
+    dists[j].LogProbability(observations, newProbs);
+    newProbs += std::log(weights[j]);
+    for (size_t i = 0; i < observations.n_cols; ++i)
     {
-      // We have to use LogProbability() otherwise Probability() would overflow
-      // easily.
-      double newProb = LogProbability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
+      if (newProbs[i] >= probabilities[i])
       {
-        probability = newProb;
+        probabilities[i] = newProbs[i];
         labels[i] = j;
       }
     }
@@ -413,6 +413,73 @@ double GMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Update the GMM with a new batch of observations, using one step of
+ * stepwise EM.
+ */
+template<typename FittingType>
+double GMM::Update(const arma::mat& observations,
+                   const double stepSize,
+                   FittingType fitter)
+{
+  if (stepSize <= 0.0 || stepSize > 1.0)
+  {
+    throw std::invalid_argument("GMM::Update(): stepSize must be in "
+        "(0, 1]!");
+  }
+
+  if (observations.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "GMM::Update(): dimensionality of observations ("
+        << observations.n_rows << ") does not match the dimensionality of the "
+        << "model (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (observations.n_cols == 0)
+    return 0.0;
+
+  // Compute the sufficient statistics of the batch, centered on the current
+  // means.
+  arma::vec responsibilities;
+  arma::mat sums;
+  arma::cube secondMoments;
+  const double logLikelihood = fitter.AccumulateStatistics(observations, dists,
+      weights, responsibilities, sums, secondMoments);
+
+  // Centered on its own means, the current model has the statistics
+  // (w_i, 0, w_i * Sigma_i) for each component i; blend these with the
+  // statistics of the batch, averaged over the points of the batch.
+  const double batchStep = stepSize / observations.n_cols;
+  const arma::vec newWeights = (1.0 - stepSize) * weights +
+      batchStep * responsibilities;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (newWeights[i] == 0.0)
+      continue;
+
+    const arma::vec delta = batchStep * sums.col(i) / newWeights[i];
+    arma::mat covariance = ((1.0 - stepSize) * weights[i] *
+        dists[i].Covariance() + batchStep * secondMoments.slice(i)) /
+        newWeights[i] - delta * delta.t();
+
+    // Apply covariance constraint.
+    fitter.Constraint().ApplyConstraint(covariance);
+    dists[i].Mean() += delta;
+    dists[i].Covariance(std::move(covariance));
+  }
+
+  weights = newWeights / arma::accu(newWeights);
+
+  Log::Info << "GMM::Update(): log-likelihood of the batch before the "
+      << "update is " << logLikelihood << "." << std::endl;
+  return logLikelihood;
+}
+
 /**
  * Serialize the object.
  */
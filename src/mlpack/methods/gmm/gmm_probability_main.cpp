@@ -72,11 +72,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
 
   arma::mat dataset = std::move(params.Get<arma::mat>("input"));
 
-  // Now calculate the probabilities.
-  arma::rowvec probabilities(dataset.n_cols);
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-    probabilities[i] = gmm->Probability(dataset.unsafe_col(i));
+  // Now calculate the probabilities of all the points at once.
+  arma::vec probabilities;
+  gmm->Probability(dataset, probabilities);
 
   // And save the result.
-  params.Get<arma::mat>("output") = std::move(probabilities);
+  params.Get<arma::mat>("output") = probabilities.t();
 }
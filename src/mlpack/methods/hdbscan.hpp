@@ -0,0 +1,16 @@
+/**
+ * @file hdbscan.hpp
+ *
+ * Convenience include for mlpack/methods/hdbscan/hdbscan.hpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_HDBSCAN_HPP
+#define MLPACK_HDBSCAN_HPP
+
+#include "hdbscan/hdbscan.hpp"
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file methods/hdbscan/hdbscan.hpp
+ *
+ * An implementation of HDBSCAN, hierarchical density-based clustering, built
+ * on the dual-tree Boruvka minimum spanning tree algorithm.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+
+namespace mlpack {
+
+/**
+ * HDBSCAN (Hierarchical DBSCAN) is a density-based clustering technique that
+ * does not need the radius parameter of DBSCAN; it is described in the
+ * following paper:
+ *
+ * @code
+ * @inproceedings{campello2013density,
+ *   title={Density-based clustering based on hierarchical density estimates},
+ *   author={Campello, R.J.G.B. and Moulavi, D. and Sander, J.},
+ *   booktitle={Pacific-Asia Conference on Knowledge Discovery and Data Mining
+ *       (PAKDD 2013)},
+ *   pages={160--172},
+ *   year={2013}
+ * }
+ * @endcode
+ *
+ * The core distance of a point is the distance to its minSamples-th nearest
+ * neighbor (counting the point itself), and the mutual reachability distance
+ * between two points a and b is max(core(a), core(b), d(a, b)).  The
+ * single-linkage hierarchy of the data under the mutual reachability distance
+ * is the hierarchy of the DBSCAN clusterings for every radius.  This
+ * implementation computes it in four steps:
+ *
+ *  - the core distances are found with one single-tree nearest neighbor search,
+ *    which is parallel with OpenMP;
+ *
+ *  - the minimum spanning tree under the mutual reachability distance is found
+ *    with ParallelDualTreeBoruvka (see DualTreeBoruvka::ComputeMST());
+ *
+ *  - the single-linkage hierarchy is built from the sorted edges of the tree
+ *    with a UnionFind structure;
+ *
+ *  - the hierarchy is condensed: splits that leave fewer than minClusterSize
+ *    points on one side are treated as points falling out of the cluster.  The
+ *    clusters of the condensed tree with the largest total stability (excess of
+ *    mass) are selected, and every point is labeled with the selected cluster
+ *    that it falls out of, or as noise.
+ *
+ * For low-dimensional data, the running time is dominated by the two tree
+ * algorithms, which scale as O(n log n); the last two steps take O(n) time
+ * after the edges are sorted.
+ *
+ * @code
+ * HDBSCAN<> h(10);
+ * arma::Row<size_t> assignments;
+ * const size_t clusters = h.Cluster(data, assignments);
+ * @endcode
+ *
+ * @tparam DistanceType The distance metric to use; this must satisfy the
+ *     triangle inequality.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat>
+class HDBSCAN
+{
+ public:
+  /**
+   * Construct the HDBSCAN object with the given parameters.
+   *
+   * @param minClusterSize Minimum number of points in a cluster (at least 2).
+   * @param minSamples Number of points (including the point itself) used for
+   *     the core distance of a point; if 0, minClusterSize is used.
+   * @param allowSingleCluster If true, the whole dataset can be returned as a
+   *     single cluster.
+   */
+  HDBSCAN(const size_t minClusterSize = 5,
+          const size_t minSamples = 0,
+          const bool allowSingleCluster = false);
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters
+   * and the cluster assignment of each point.  If assignments[i] == SIZE_MAX,
+   * the point is considered noise.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments in.
+   * @return The number of clusters.
+   */
+  size_t Cluster(const MatType& data, arma::Row<size_t>& assignments);
+
+  /**
+   * Perform HDBSCAN clustering on the data, returning the number of clusters
+   * and the cluster assignment of each point, and also store the single-linkage
+   * hierarchy under the mutual reachability distance.  The hierarchy has four
+   * rows and one column per merge, using the same format as SciPy's linkage
+   * matrices: the points have the ids 0 to n - 1, the cluster created by merge
+   * i has the id n + i, and column i holds the ids of the two merged clusters,
+   * the distance of the merge, and the number of points in the new cluster.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments in.
+   * @param hierarchy Matrix to store the single-linkage hierarchy in.
+   * @return The number of clusters.
+   */
+  size_t Cluster(const MatType& data,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& hierarchy);
+
+  /**
+   * Compute the core distance of each point in the given dataset: the distance
+   * to its minSamples-th nearest neighbor, counting the point itself.
+   *
+   * @param data Dataset to compute core distances for.
+   * @param coreDistances Vector to store the core distances in.
+   */
+  void CoreDistances(const MatType& data, arma::vec& coreDistances) const;
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinClusterSize() const { return minClusterSize; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinClusterSize() { return minClusterSize; }
+
+  //! Get the number of points used for core distances (0 means
+  //! MinClusterSize()).
+  size_t MinSamples() const { return minSamples; }
+  //! Modify the number of points used for core distances.
+  size_t& MinSamples() { return minSamples; }
+
+  //! Get whether the whole dataset can be a single cluster.
+  bool AllowSingleCluster() const { return allowSingleCluster; }
+  //! Modify whether the whole dataset can be a single cluster.
+  bool& AllowSingleCluster() { return allowSingleCluster; }
+
+ private:
+  /**
+   * Build the single-linkage hierarchy from the edges of a minimum spanning
+   * tree, sorted by distance (as returned by DualTreeBoruvka::ComputeMST()).
+   */
+  static void SingleLinkage(const arma::mat& mst, arma::mat& hierarchy);
+
+  /**
+   * Condense the given hierarchy of n points, select the clusters, and label
+   * the points.  Returns the number of clusters.
+   */
+  size_t ExtractClusters(const arma::mat& hierarchy,
+                         const size_t n,
+                         arma::Row<size_t>& assignments) const;
+
+  //! The minimum number of points in a cluster.
+  size_t minClusterSize;
+  //! The number of points used for core distances.
+  size_t minSamples;
+  //! Whether the whole dataset can be a single cluster.
+  bool allowSingleCluster;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hdbscan_impl.hpp"
+
+#endif
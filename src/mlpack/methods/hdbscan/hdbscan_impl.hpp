@@ -0,0 +1,263 @@
+/**
+ * @file methods/hdbscan/hdbscan_impl.hpp
+ *
+ * Implementation of the HDBSCAN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+
+#include "hdbscan.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+HDBSCAN<DistanceType, MatType>::HDBSCAN(const size_t minClusterSize,
+                                        const size_t minSamples,
+                                        const bool allowSingleCluster) :
+    minClusterSize(minClusterSize),
+    minSamples(minSamples),
+    allowSingleCluster(allowSingleCluster)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename MatType>
+size_t HDBSCAN<DistanceType, MatType>::Cluster(const MatType& data,
+                                               arma::Row<size_t>& assignments)
+{
+  arma::mat hierarchy;
+  return Cluster(data, assignments, hierarchy);
+}
+
+template<typename DistanceType, typename MatType>
+size_t HDBSCAN<DistanceType, MatType>::Cluster(const MatType& data,
+                                               arma::Row<size_t>& assignments,
+                                               arma::mat& hierarchy)
+{
+  if (minClusterSize < 2)
+  {
+    throw std::invalid_argument("HDBSCAN::Cluster(): the minimum cluster size "
+        "must be at least 2!");
+  }
+
+  // With fewer than two points there is nothing to merge.
+  if (data.n_cols < 2)
+  {
+    hierarchy.set_size(4, 0);
+    assignments.set_size(data.n_cols);
+    assignments.fill(SIZE_MAX);
+    return 0;
+  }
+
+  arma::vec coreDistances;
+  CoreDistances(data, coreDistances);
+
+  // The MST under the mutual reachability distance.
+  arma::mat mst;
+  ParallelDualTreeBoruvka<DistanceType, MatType> dtb(data);
+  dtb.ComputeMST(mst, coreDistances);
+
+  SingleLinkage(mst, hierarchy);
+  return ExtractClusters(hierarchy, data.n_cols, assignments);
+}
+
+template<typename DistanceType, typename MatType>
+void HDBSCAN<DistanceType, MatType>::CoreDistances(
+    const MatType& data,
+    arma::vec& coreDistances) const
+{
+  const size_t k = (minSamples == 0) ? minClusterSize : minSamples;
+  if (k > data.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HDBSCAN::CoreDistances(): the core distances need " << k
+        << " points, but the dataset has only " << data.n_cols << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The nearest point is the point itself.
+  if (k <= 1)
+  {
+    coreDistances.zeros(data.n_cols);
+    return;
+  }
+
+  // The monochromatic search does not return the point itself, so we need one
+  // neighbor less.  The single-tree search is parallel with OpenMP.
+  NeighborSearch<NearestNeighborSort, DistanceType, MatType, KDTree> knn(
+      data, SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighbors;
+  arma::Mat<typename MatType::elem_type> distances;
+  knn.Search(k - 1, neighbors, distances);
+
+  coreDistances = arma::conv_to<arma::vec>::from(distances.row(k - 2).t());
+}
+
+template<typename DistanceType, typename MatType>
+void HDBSCAN<DistanceType, MatType>::SingleLinkage(const arma::mat& mst,
+                                                   arma::mat& hierarchy)
+{
+  const size_t n = mst.n_cols + 1;
+  hierarchy.set_size(4, mst.n_cols);
+
+  // The id and size of the cluster that each component of the union-find
+  // structure represents, indexed by the root of the component.
+  UnionFind connections(n);
+  std::vector<size_t> clusterIds(n);
+  std::vector<size_t> clusterSizes(n, 1);
+  for (size_t i = 0; i < n; ++i)
+    clusterIds[i] = i;
+
+  // The edges are sorted, so every edge merges two clusters.
+  for (size_t i = 0; i < mst.n_cols; ++i)
+  {
+    const size_t a = connections.Find((size_t) mst(0, i));
+    const size_t b = connections.Find((size_t) mst(1, i));
+    const size_t size = clusterSizes[a] + clusterSizes[b];
+
+    hierarchy(0, i) = std::min(clusterIds[a], clusterIds[b]);
+    hierarchy(1, i) = std::max(clusterIds[a], clusterIds[b]);
+    hierarchy(2, i) = mst(2, i);
+    hierarchy(3, i) = size;
+
+    connections.Union(a, b);
+    const size_t root = connections.Find(a);
+    clusterIds[root] = n + i;
+    clusterSizes[root] = size;
+  }
+}
+
+template<typename DistanceType, typename MatType>
+size_t HDBSCAN<DistanceType, MatType>::ExtractClusters(
+    const arma::mat& hierarchy,
+    const size_t n,
+    arma::Row<size_t>& assignments) const
+{
+  assignments.set_size(n);
+  assignments.fill(SIZE_MAX);
+
+  // The number of points under a node of the hierarchy.
+  auto nodeSize = [&](const size_t node)
+  {
+    return (node < n) ? 1 : (size_t) hierarchy(3, node - n);
+  };
+
+  // The clusters of the condensed tree, in the order they are found, so that
+  // a parent always comes before its children.  The lambda of a merge is the
+  // inverse of its distance.
+  std::vector<size_t> parents(1, SIZE_MAX);
+  std::vector<double> births(1, 0.0);
+  std::vector<double> stabilities(1, 0.0);
+  // The cluster of the condensed tree that each point falls out of.
+  std::vector<size_t> pointClusters(n);
+
+  // Walk the hierarchy top-down; each entry holds a node of the hierarchy and
+  // the cluster of the condensed tree that it belongs to.  Every point is
+  // visited once, either when it falls out of its cluster or when its
+  // cluster splits into clusters that are too small.
+  std::vector<std::pair<size_t, size_t>> stack(1,
+      std::make_pair(2 * n - 2, size_t(0)));
+  std::vector<size_t> pointStack;
+  while (!stack.empty())
+  {
+    const size_t node = stack.back().first;
+    const size_t cluster = stack.back().second;
+    stack.pop_back();
+
+    const double distance = hierarchy(2, node - n);
+    const double lambda = (distance > 0.0) ? 1.0 / distance : DBL_MAX;
+    const size_t children[2] = { (size_t) hierarchy(0, node - n),
+                                 (size_t) hierarchy(1, node - n) };
+    const bool large[2] = { nodeSize(children[0]) >= minClusterSize,
+                            nodeSize(children[1]) >= minClusterSize };
+
+    for (size_t c = 0; c < 2; ++c)
+    {
+      if (large[c] && large[1 - c])
+      {
+        // A true split: the child becomes a new cluster, and all of its points
+        // leave the current cluster.
+        stabilities[cluster] += (lambda - births[cluster]) *
+            nodeSize(children[c]);
+        parents.push_back(cluster);
+        births.push_back(lambda);
+        stabilities.push_back(0.0);
+        stack.push_back(std::make_pair(children[c], parents.size() - 1));
+      }
+      else if (large[c])
+      {
+        // The cluster continues in this child.
+        stack.push_back(std::make_pair(children[c], cluster));
+      }
+      else
+      {
+        // The points of this child fall out of the cluster.
+        stabilities[cluster] += (lambda - births[cluster]) *
+            nodeSize(children[c]);
+        pointStack.push_back(children[c]);
+        while (!pointStack.empty())
+        {
+          const size_t descendant = pointStack.back();
+          pointStack.pop_back();
+          if (descendant < n)
+          {
+            pointClusters[descendant] = cluster;
+          }
+          else
+          {
+            pointStack.push_back((size_t) hierarchy(0, descendant - n));
+            pointStack.push_back((size_t) hierarchy(1, descendant - n));
+          }
+        }
+      }
+    }
+  }
+
+  // Select the clusters bottom-up: a cluster is kept if it is more stable than
+  // the best selection of its descendants (excess of mass).  The root is only
+  // considered if a single cluster is allowed.
+  const size_t numClusters = parents.size();
+  std::vector<char> selected(numClusters, 0);
+  std::vector<char> hasChildren(numClusters, 0);
+  std::vector<double> childStabilities(numClusters, 0.0);
+  for (size_t c = numClusters - 1; c > 0; --c)
+  {
+    if (!hasChildren[c] || stabilities[c] > childStabilities[c])
+      selected[c] = 1;
+    else
+      stabilities[c] = childStabilities[c];
+
+    childStabilities[parents[c]] += stabilities[c];
+    hasChildren[parents[c]] = 1;
+  }
+
+  if (allowSingleCluster &&
+      (!hasChildren[0] || stabilities[0] > childStabilities[0]))
+    selected[0] = 1;
+
+  // A selected cluster takes the points of all of its descendants.
+  std::vector<size_t> labels(numClusters, SIZE_MAX);
+  size_t count = 0;
+  for (size_t c = 0; c < numClusters; ++c)
+  {
+    if (c > 0 && labels[parents[c]] != SIZE_MAX)
+      labels[c] = labels[parents[c]];
+    else if (selected[c])
+      labels[c] = count++;
+  }
+
+  for (size_t i = 0; i < n; ++i)
+    assignments[i] = labels[pointClusters[i]];
+
+  return count;
+}
+
+} // namespace mlpack
+
+#endif
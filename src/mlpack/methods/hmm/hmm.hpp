@@ -291,6 +291,54 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Compute the log-likelihood of each of the given data sequences.  This gives
+   * the same results as calling LogLikelihood() on each sequence, but the
+   * sequences are processed in parallel (with OpenMP), and short sequences are
+   * grouped into blocks so that each emission distribution is evaluated once
+   * per block instead of once per sequence.  If most of the entries of the
+   * transition matrix are zero, a sparse transition matrix is used, so that
+   * transitions with zero probability are skipped.
+   *
+   * @param dataSeqs Set of data sequences to evaluate the likelihood of.
+   * @param logLikelihoods Vector in which the log-likelihood of each sequence
+   *     will be stored.
+   */
+  void LogLikelihood(const std::vector<arma::mat>& dataSeqs,
+                     arma::vec& logLikelihoods) const;
+
+  /**
+   * Compute the most probable hidden state sequence of each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are processed in
+   * parallel and in blocks, as in the batch overload of LogLikelihood().
+   *
+   * @param dataSeqs Set of data sequences.
+   * @param stateSeqs Vector in which the most probable state sequence of each
+   *     data sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of the most
+   *     probable state sequence of each data sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeqs,
+               std::vector<arma::Row<size_t>>& stateSeqs,
+               arma::vec& logLikelihoods) const;
+
+  /**
+   * Estimate the probabilities of each hidden state at each time step of each
+   * of the given data sequences, using the Forward-Backward algorithm.  The
+   * sequences are processed in parallel and in blocks, as in the batch overload
+   * of LogLikelihood().  If a sequence has zero likelihood, its state
+   * probabilities are set to zero.
+   *
+   * @param dataSeqs Set of data sequences.
+   * @param stateProbs Vector in which the probabilities of each state at each
+   *     time interval of each data sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of each data
+   *     sequence will be stored.
+   */
+  void Estimate(const std::vector<arma::mat>& dataSeqs,
+                std::vector<arma::mat>& stateProbs,
+                arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log of the scaling factor of the given emission probability
    * at time t. To calculate the log-likelihood for the whole sequence,
@@ -514,6 +562,102 @@ class HMM
    */
   void ConvertToLogSpace() const;
 
+  /**
+   * Return true if few enough entries of the transition matrix are nonzero
+   * that the batch algorithms should use a sparse transition matrix.
+   */
+  bool SparseTransition() const;
+
+  /**
+   * Compute the emission log-probabilities of each of the given data sequences,
+   * and call f(i, logProbs) for each sequence i, where logProbs has one row per
+   * state and one column per observation of the sequence.  Consecutive
+   * sequences are grouped in blocks of about emissionBlockSize observations,
+   * and the blocks are processed in parallel.
+   *
+   * @param dataSeqs Set of data sequences.
+   * @param f Function to call for each sequence.
+   */
+  template<typename SequenceFunctionType>
+  void ForEachSequence(const std::vector<arma::mat>& dataSeqs,
+                       SequenceFunctionType f) const;
+
+  /**
+   * The Forward algorithm in linear space, for the batch algorithms.  At each
+   * time step the emission probabilities are scaled by their maximum and the
+   * forward probabilities are normalized, so nothing underflows; the log of the
+   * total scaling of each time step is stored in logScales.
+   *
+   * @param transition Transition matrix (dense or sparse).
+   * @param logProbs Emission log-probabilities of the sequence.
+   * @param forwardProb Matrix in which the normalized forward probabilities
+   *     will be saved.
+   * @param logScales Vector in which the log of scaling factors will be saved.
+   * @return Log-likelihood of the sequence.
+   */
+  template<typename TransitionMatType>
+  double ScaledForward(const TransitionMatType& transition,
+                       const arma::mat& logProbs,
+                       arma::mat& forwardProb,
+                       arma::vec& logScales) const;
+
+  /**
+   * The Backward algorithm in linear space, using the scaling factors found by
+   * ScaledForward().
+   *
+   * @param transitionT Transpose of the transition matrix (dense or sparse).
+   * @param logProbs Emission log-probabilities of the sequence.
+   * @param logScales Vector of log of scaling factors.
+   * @param backwardProb Matrix in which the scaled backward probabilities will
+   *     be saved.
+   */
+  template<typename TransitionMatType>
+  void ScaledBackward(const TransitionMatType& transitionT,
+                      const arma::mat& logProbs,
+                      const arma::vec& logScales,
+                      arma::mat& backwardProb) const;
+
+  /**
+   * The Viterbi algorithm in linear space, for the batch algorithms.  The
+   * probabilities of the best paths are normalized at each time step.
+   *
+   * @param transition Transition matrix (dense or sparse).
+   * @param logProbs Emission log-probabilities of the sequence.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *     stored.
+   * @return Log-likelihood of the most probable state sequence.
+   */
+  template<typename TransitionMatType>
+  double ScaledViterbi(const TransitionMatType& transition,
+                       const arma::mat& logProbs,
+                       arma::Row<size_t>& stateSeq) const;
+
+  /**
+   * Compute next(j) = max_i transition(j, i) * prev(i) and store the maximizing
+   * i in back(j).  Columns of the transition matrix whose previous probability
+   * is zero are skipped.
+   */
+  static void MaxProduct(const arma::mat& transition,
+                         const arma::vec& prev,
+                         arma::vec& next,
+                         arma::Col<size_t>& back);
+
+  /**
+   * Compute next(j) = max_i transition(j, i) * prev(i) and store the maximizing
+   * i in back(j), visiting only the nonzero entries of the transition matrix.
+   */
+  static void MaxProduct(const arma::sp_mat& transition,
+                         const arma::vec& prev,
+                         arma::vec& next,
+                         arma::Col<size_t>& back);
+
+  //! Number of observations whose emission probabilities are computed together
+  //! by the batch algorithms.
+  static constexpr size_t emissionBlockSize = 1024;
+  //! The batch algorithms use a sparse transition matrix if less than this
+  //! fraction of its entries are nonzero.
+  static constexpr double sparseTransitionDensity = 0.25;
+
   /**
    * A proxy vriable in linear space for logInitial.
    * Should be removed in mlpack 4.0.
@@ -17,6 +17,7 @@
 // Just in case...
 #include "hmm.hpp"
 #include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 
 namespace mlpack {
 
@@ -100,10 +101,14 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  The
+  // offset of each sequence in the list of emission observations is stored, so
+  // that the sequences can be processed in parallel.
   size_t totalLength = 0;
+  std::vector<size_t> offsets(dataSeq.size());
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    offsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -118,6 +123,10 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
 
+  // Make sure the log-space parameters are up to date, so that the threads only
+  // read them.
+  ConvertToLogSpace();
+
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
   // Markov Models: Estimation and Control", pp. 36-40.
@@ -132,70 +141,95 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The expected counts of each sequence are independent, so the sequences
+    // are processed in parallel; each thread accumulates its own counts, and
+    // these are added together at the end.  This is the E-step.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec localLogInitial(logTransition.n_rows);
+      localLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat localLogTransition(logTransition.n_rows, logTransition.n_cols);
+      localLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double localLoglik = 0.0;
+
+      #pragma omp for schedule(dynamic)
+      for (size_t seq = 0; seq < dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.
+        localLoglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            localLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
+        // Save the values of log-probability to logProbs.
+        for (size_t i = 0; i < logTransition.n_rows; i++)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          LogSumExp(tmp, output);
+          // Define alias of desired column.
+          arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+          // Use advanced constructor for using logProbs directly.
+          emission[i].LogProbability(dataSeq[seq], alias);
+        }
 
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+        // Now compute the expected counts used to re-estimate the parameters
+        // in the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+        {
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = localLogTransition.unsafe_col(j);
+              LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          // Each sequence has its own range of the list.
+          const size_t sumTime = offsets[seq] + t;
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][sumTime] = std::exp(stateLogProb(j, t));
+          emissionList.col(sumTime) = dataSeq[seq].col(t);
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = std::exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+      // Add the counts of this thread to the total.
+      #pragma omp critical
+      {
+        loglik += localLoglik;
+        for (size_t i = 0; i < newLogInitial.n_elem; ++i)
+          newLogInitial[i] = LogAdd(newLogInitial[i], localLogInitial[i]);
+        for (size_t i = 0; i < newLogTransition.n_elem; ++i)
+        {
+          newLogTransition[i] = LogAdd(newLogTransition[i],
+              localLogTransition[i]);
+        }
       }
     }
 
@@ -572,6 +606,100 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Compute the log-likelihood of each of the given data sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::LogLikelihood(const std::vector<arma::mat>& dataSeqs,
+                                      arma::vec& logLikelihoods) const
+{
+  logLikelihoods.set_size(dataSeqs.size());
+
+  auto run = [&](const auto& transition)
+  {
+    ForEachSequence(dataSeqs, [&](const size_t i, const arma::mat& logProbs)
+    {
+      arma::mat forwardProb;
+      arma::vec logScales;
+      logLikelihoods[i] = ScaledForward(transition, logProbs, forwardProb,
+          logScales);
+    });
+  };
+
+  if (SparseTransition())
+    run(arma::sp_mat(transitionProxy));
+  else
+    run(transitionProxy);
+}
+
+/**
+ * Compute the most probable hidden state sequence of each of the given data
+ * sequences, using the Viterbi algorithm.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeqs,
+                                std::vector<arma::Row<size_t>>& stateSeqs,
+                                arma::vec& logLikelihoods) const
+{
+  stateSeqs.resize(dataSeqs.size());
+  logLikelihoods.set_size(dataSeqs.size());
+
+  auto run = [&](const auto& transition)
+  {
+    ForEachSequence(dataSeqs, [&](const size_t i, const arma::mat& logProbs)
+    {
+      logLikelihoods[i] = ScaledViterbi(transition, logProbs, stateSeqs[i]);
+    });
+  };
+
+  if (SparseTransition())
+    run(arma::sp_mat(transitionProxy));
+  else
+    run(transitionProxy);
+}
+
+/**
+ * Estimate the probabilities of each hidden state at each time step of each of
+ * the given data sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Estimate(const std::vector<arma::mat>& dataSeqs,
+                                 std::vector<arma::mat>& stateProbs,
+                                 arma::vec& logLikelihoods) const
+{
+  stateProbs.resize(dataSeqs.size());
+  logLikelihoods.set_size(dataSeqs.size());
+
+  auto run = [&](const auto& transition, const auto& transitionT)
+  {
+    ForEachSequence(dataSeqs, [&](const size_t i, const arma::mat& logProbs)
+    {
+      arma::mat forwardProb, backwardProb;
+      arma::vec logScales;
+      logLikelihoods[i] = ScaledForward(transition, logProbs, forwardProb,
+          logScales);
+      if (logLikelihoods[i] == -std::numeric_limits<double>::infinity())
+      {
+        stateProbs[i].zeros(logProbs.n_rows, logProbs.n_cols);
+        return;
+      }
+
+      ScaledBackward(transitionT, logProbs, logScales, backwardProb);
+      stateProbs[i] = forwardProb % backwardProb;
+    });
+  };
+
+  if (SparseTransition())
+  {
+    const arma::sp_mat transition(transitionProxy);
+    run(transition, arma::sp_mat(transition.t()));
+  }
+  else
+  {
+    run(transitionProxy, arma::mat(transitionProxy.t()));
+  }
+}
+
 /**
  * Compute the log of the scaling factor of the given emission probability
  * at time t. To calculate the log-likelihood for the whole sequence,
@@ -847,6 +975,309 @@ void HMM<Distribution>::ConvertToLogSpace() const
   }
 }
 
+/**
+ * Decide whether the batch algorithms should use a sparse transition matrix.
+ */
+template<typename Distribution>
+bool HMM<Distribution>::SparseTransition() const
+{
+  const size_t nonzeros = arma::accu(transitionProxy != 0.0);
+  return nonzeros < sparseTransitionDensity * transitionProxy.n_elem;
+}
+
+/**
+ * Compute the emission log-probabilities of blocks of data sequences in
+ * parallel, and call the given function for each sequence.
+ */
+template<typename Distribution>
+template<typename SequenceFunctionType>
+void HMM<Distribution>::ForEachSequence(
+    const std::vector<arma::mat>& dataSeqs,
+    SequenceFunctionType f) const
+{
+  // Exceptions can't be thrown from inside the parallel loop, so check the
+  // sequences first, and group consecutive sequences into blocks.
+  std::vector<size_t> blockStarts(1, 0);
+  size_t blockPoints = 0;
+  for (size_t i = 0; i < dataSeqs.size(); ++i)
+  {
+    if (dataSeqs[i].n_rows != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "HMM: dimensionality of sequence " << i << " ("
+          << dataSeqs[i].n_rows << ") does not match the dimensionality of the "
+          << "model (" << dimensionality << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    blockPoints += dataSeqs[i].n_cols;
+    if (blockPoints >= emissionBlockSize && i + 1 < dataSeqs.size())
+    {
+      blockStarts.push_back(i + 1);
+      blockPoints = 0;
+    }
+  }
+  blockStarts.push_back(dataSeqs.size());
+
+  const size_t states = transitionProxy.n_rows;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t b = 0; b < blockStarts.size() - 1; ++b)
+  {
+    const size_t begin = blockStarts[b];
+    const size_t end = blockStarts[b + 1];
+    if (begin == end)
+      continue;
+
+    size_t points = 0;
+    for (size_t i = begin; i < end; ++i)
+      points += dataSeqs[i].n_cols;
+
+    // Copy the sequences of the block next to each other, so that each
+    // emission distribution only needs to be evaluated once.  A block that
+    // holds a single (long) sequence can be used directly.
+    arma::mat joined;
+    if (end - begin > 1)
+    {
+      joined.set_size(dimensionality, points);
+      size_t offset = 0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        if (dataSeqs[i].n_cols > 0)
+        {
+          joined.cols(offset, offset + dataSeqs[i].n_cols - 1) = dataSeqs[i];
+          offset += dataSeqs[i].n_cols;
+        }
+      }
+    }
+    const arma::mat& block = (end - begin > 1) ? joined : dataSeqs[begin];
+
+    arma::mat logProbs(states, points);
+    if (points > 0)
+    {
+      arma::vec stateLogProbs;
+      for (size_t s = 0; s < states; ++s)
+      {
+        emission[s].LogProbability(block, stateLogProbs);
+        logProbs.row(s) = stateLogProbs.t();
+      }
+    }
+
+    size_t offset = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t length = dataSeqs[i].n_cols;
+      arma::mat seqLogProbs(states, 0);
+      if (length > 0)
+        MakeAlias(seqLogProbs, logProbs, states, length, offset * states);
+
+      f(i, seqLogProbs);
+      offset += length;
+    }
+  }
+}
+
+/**
+ * The Forward procedure in linear space, with scaling at each time step.
+ */
+template<typename Distribution>
+template<typename TransitionMatType>
+double HMM<Distribution>::ScaledForward(const TransitionMatType& transition,
+                                        const arma::mat& logProbs,
+                                        arma::mat& forwardProb,
+                                        arma::vec& logScales) const
+{
+  const size_t length = logProbs.n_cols;
+  forwardProb.set_size(logProbs.n_rows, length);
+  logScales.set_size(length);
+
+  double logLikelihood = 0.0;
+  for (size_t t = 0; t < length; ++t)
+  {
+    // Scale the emission probabilities by their maximum, so that they can be
+    // used in linear space.
+    const double maxLogProb = logProbs.col(t).max();
+    double scale = 0.0;
+    if (maxLogProb != -std::numeric_limits<double>::infinity())
+    {
+      const arma::vec emissionProb = arma::exp(logProbs.col(t) - maxLogProb);
+      if (t == 0)
+        forwardProb.col(t) = initialProxy % emissionProb;
+      else
+        forwardProb.col(t) = (transition * forwardProb.col(t - 1)) %
+            emissionProb;
+
+      scale = arma::accu(forwardProb.col(t));
+    }
+
+    // If no state can produce this observation, the sequence is impossible.
+    if (scale == 0.0)
+    {
+      forwardProb.cols(t, length - 1).zeros();
+      logScales.subvec(t, length - 1).fill(
+          -std::numeric_limits<double>::infinity());
+      return -std::numeric_limits<double>::infinity();
+    }
+
+    forwardProb.col(t) /= scale;
+    logScales[t] = std::log(scale) + maxLogProb;
+    logLikelihood += logScales[t];
+  }
+
+  return logLikelihood;
+}
+
+/**
+ * The Backward procedure in linear space, with the scaling factors of the
+ * Forward procedure.
+ */
+template<typename Distribution>
+template<typename TransitionMatType>
+void HMM<Distribution>::ScaledBackward(const TransitionMatType& transitionT,
+                                       const arma::mat& logProbs,
+                                       const arma::vec& logScales,
+                                       arma::mat& backwardProb) const
+{
+  const size_t length = logProbs.n_cols;
+  backwardProb.set_size(logProbs.n_rows, length);
+  if (length == 0)
+    return;
+
+  // The last element probability is 1.
+  backwardProb.col(length - 1).ones();
+  for (size_t t = length - 1; t > 0; --t)
+  {
+    // The emission probabilities are scaled the same way as in
+    // ScaledForward(), so the scaling factors cancel.
+    const double maxLogProb = logProbs.col(t).max();
+    backwardProb.col(t - 1) = (transitionT * (backwardProb.col(t) %
+        arma::exp(logProbs.col(t) - maxLogProb))) /
+        std::exp(logScales[t] - maxLogProb);
+  }
+}
+
+/**
+ * The Viterbi algorithm in linear space, with scaling at each time step.
+ */
+template<typename Distribution>
+template<typename TransitionMatType>
+double HMM<Distribution>::ScaledViterbi(const TransitionMatType& transition,
+                                        const arma::mat& logProbs,
+                                        arma::Row<size_t>& stateSeq) const
+{
+  const size_t states = logProbs.n_rows;
+  const size_t length = logProbs.n_cols;
+  stateSeq.set_size(length);
+  if (length == 0)
+    return 0.0;
+
+  // stateSeqBack(j, t) holds the best previous state for state j at time t.
+  arma::Mat<size_t> stateSeqBack(states, length);
+  arma::vec stateProb(states), nextProb(states);
+  double logLikelihood = 0.0;
+
+  for (size_t t = 0; t < length; ++t)
+  {
+    if (t == 0)
+    {
+      stateProb = initialProxy;
+    }
+    else
+    {
+      arma::Col<size_t> back = stateSeqBack.unsafe_col(t);
+      MaxProduct(transition, stateProb, nextProb, back);
+      stateProb = nextProb;
+    }
+
+    const double maxLogProb = logProbs.col(t).max();
+    if (maxLogProb == -std::numeric_limits<double>::infinity())
+    {
+      stateProb.zeros();
+      logLikelihood = -std::numeric_limits<double>::infinity();
+      continue;
+    }
+
+    stateProb %= arma::exp(logProbs.col(t) - maxLogProb);
+    const double scale = stateProb.max();
+    if (scale > 0.0)
+    {
+      stateProb /= scale;
+      logLikelihood += std::log(scale) + maxLogProb;
+    }
+    else
+    {
+      logLikelihood = -std::numeric_limits<double>::infinity();
+    }
+  }
+
+  // Backtrack to find the most probable state sequence.
+  arma::uword index;
+  stateProb.max(index);
+  stateSeq[length - 1] = index;
+  for (size_t t = length - 1; t > 0; --t)
+    stateSeq[t - 1] = stateSeqBack(stateSeq[t], t);
+
+  return logLikelihood;
+}
+
+/**
+ * One step of the Viterbi algorithm with a dense transition matrix.
+ */
+template<typename Distribution>
+void HMM<Distribution>::MaxProduct(const arma::mat& transition,
+                                   const arma::vec& prev,
+                                   arma::vec& next,
+                                   arma::Col<size_t>& back)
+{
+  next.zeros();
+  back.zeros();
+  for (size_t i = 0; i < transition.n_cols; ++i)
+  {
+    if (prev[i] == 0.0)
+      continue;
+
+    const double* col = transition.colptr(i);
+    for (size_t j = 0; j < transition.n_rows; ++j)
+    {
+      const double prob = col[j] * prev[i];
+      if (prob > next[j])
+      {
+        next[j] = prob;
+        back[j] = i;
+      }
+    }
+  }
+}
+
+/**
+ * One step of the Viterbi algorithm with a sparse transition matrix.
+ */
+template<typename Distribution>
+void HMM<Distribution>::MaxProduct(const arma::sp_mat& transition,
+                                   const arma::vec& prev,
+                                   arma::vec& next,
+                                   arma::Col<size_t>& back)
+{
+  next.zeros();
+  back.zeros();
+  for (size_t i = 0; i < transition.n_cols; ++i)
+  {
+    if (prev[i] == 0.0)
+      continue;
+
+    arma::sp_mat::const_iterator it = transition.begin_col(i);
+    for (; it != transition.end_col(i); ++it)
+    {
+      const double prob = (*it) * prev[i];
+      if (prob > next[it.row()])
+      {
+        next[it.row()] = prob;
+        back[it.row()] = i;
+      }
+    }
+  }
+}
+
 //! Serialize the HMM.
 template<typename Distribution>
 template<typename Archive>
@@ -42,7 +42,15 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("input_model") + " parameter, and evaluates the "
     "log-likelihood of a sequence of observations, given with the " +
     PRINT_PARAM_STRING("input") + " parameter.  The computed log-likelihood is"
-    " given as output.");
+    " given as output."
+    "\n\n"
+    "Many sequences can be scored at once (in parallel, if OpenMP is "
+    "available) by giving them one after another in " +
+    PRINT_PARAM_STRING("input") + " and the length of each sequence with the " +
+    PRINT_PARAM_STRING("lengths") + " parameter; this avoids loading the model "
+    "once for each sequence.  The log-likelihood of each sequence is then given"
+    " in the " + PRINT_PARAM_STRING("log_likelihoods") + " output parameter, "
+    "and " + PRINT_PARAM_STRING("log_likelihood") + " holds their sum.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -62,8 +70,11 @@ BINDING_SEE_ALSO("HMM class documentation", "@src/mlpack/methods/hmm/hmm.hpp");
 
 PARAM_MATRIX_IN_REQ("input", "File containing observations,", "i");
 PARAM_MODEL_IN_REQ(HMMModel, "input_model", "File containing HMM.", "m");
+PARAM_UCOL_IN("lengths", "Lengths of the sequences stored one after another "
+    "in the input, if more than one sequence is given.", "l");
 
 PARAM_DOUBLE_OUT("log_likelihood", "Log-likelihood of the sequence.");
+PARAM_COL_OUT("log_likelihoods", "Log-likelihood of each sequence.", "L");
 
 // Because we don't know what the type of our HMM is, we need to write a
 // function that can take arbitrary HMM types.
@@ -91,9 +102,42 @@ struct Loglik
           << hmm.Emission()[0].Dimensionality() << ")!" << endl;
     }
 
-    const double loglik = hmm.LogLikelihood(dataSeq);
+    if (!params.Has("lengths"))
+    {
+      const double loglik = hmm.LogLikelihood(dataSeq);
+
+      params.Get<double>("log_likelihood") = loglik;
+      params.Get<vec>("log_likelihoods") = vec(1).fill(loglik);
+      return;
+    }
+
+    // Split the input into its sequences, without copying them.
+    const Col<size_t>& lengths = params.Get<Col<size_t>>("lengths");
+    if (accu(lengths) != dataSeq.n_cols)
+    {
+      Log::Fatal << "The sequence lengths add up to " << accu(lengths)
+          << ", but the input contains " << dataSeq.n_cols << " observations!"
+          << endl;
+    }
+
+    vector<mat> dataSeqs;
+    dataSeqs.reserve(lengths.n_elem);
+    size_t offset = 0;
+    for (size_t i = 0; i < lengths.n_elem; ++i)
+    {
+      if (lengths[i] == 0)
+        Log::Fatal << "Sequence " << i << " has length 0!" << endl;
+
+      dataSeqs.emplace_back(dataSeq.colptr(offset), dataSeq.n_rows,
+          lengths[i], false, true);
+      offset += lengths[i];
+    }
+
+    vec logliks;
+    hmm.LogLikelihood(dataSeqs, logliks);
 
-    params.Get<double>("log_likelihood") = loglik;
+    params.Get<double>("log_likelihood") = accu(logliks);
+    params.Get<vec>("log_likelihoods") = std::move(logliks);
   }
 };
 
@@ -52,6 +52,16 @@ BINDING_LONG_DESC(
     " should contain a list of files of labels corresponding to the sequences"
     " in the file given to " + PRINT_PARAM_STRING("input_file") + "."
     "\n\n"
+    "Alternately, all of the input sequences can be stored one after another "
+    "in the single file given to " + PRINT_PARAM_STRING("input_file") +
+    ", with the length of each sequence given in the file specified by " +
+    PRINT_PARAM_STRING("lengths_file") + ".  The sequences are then read as "
+    "one matrix and used in place, without loading a separate file and "
+    "allocating a separate matrix for each sequence; this is faster and uses "
+    "less memory for large training sets made of many sequences.  If labels "
+    "are given, the file given to " + PRINT_PARAM_STRING("labels_file") +
+    " should hold the labels of all of the sequences, in the same order."
+    "\n\n"
     "The HMM is trained with the Baum-Welch algorithm if no labels are "
     "provided.  The tolerance of the Baum-Welch algorithm can be set with the "
     + PRINT_PARAM_STRING("tolerance") + "option.  By default, the transition "
@@ -77,6 +87,9 @@ PARAM_STRING_IN("type", "Type of HMM: discrete | gaussian | diag_gmm | gmm.",
 PARAM_FLAG("batch", "If true, input_file (and if passed, labels_file) are "
     "expected to contain a list of files to use as input observation sequences "
     "(and label sequences).", "b");
+PARAM_STRING_IN("lengths_file", "Optional file containing the length of each "
+    "observation sequence; if given, input_file (and if passed, labels_file) "
+    "hold all of the sequences one after another.", "L", "");
 PARAM_INT_IN("states", "Number of hidden states in HMM (necessary, unless "
     "model_file is specified).", "n", 0);
 PARAM_INT_IN("gaussians", "Number of gaussians in each GMM (necessary when type"
@@ -397,11 +410,14 @@ struct Train
           Log::Fatal << "Invalid labels; must be one-dimensional." << endl;
 
         // Verify the same number of observations as the data.
-        if (label.n_elem != trainSeq[labelSeq.size()].n_cols)
+        size_t totalLength = 0;
+        for (size_t i = 0; i < trainSeq.size(); ++i)
+          totalLength += trainSeq[i].n_cols;
+
+        if (label.n_elem != totalLength)
         {
-          Log::Fatal << "Label sequence " << labelSeq.size() << " does not have"
-              << " the same number of points as observation sequence "
-              << labelSeq.size() << "!" << endl;
+          Log::Fatal << "Labels in '" << labelsFile << "' do not have the same "
+              << "number of points as the observation sequences!" << endl;
         }
 
         // Check all of the labels.
@@ -416,7 +432,15 @@ struct Train
           }
         }
 
-        labelSeq.push_back(label.row(0));
+        // If the labels of several sequences are stored one after another,
+        // split them the same way as the observations.
+        size_t offset = 0;
+        for (size_t i = 0; i < trainSeq.size(); ++i)
+        {
+          labelSeq.push_back(label.row(0).cols(offset,
+              offset + trainSeq[i].n_cols - 1));
+          offset += trainSeq[i].n_cols;
+        }
       }
 
       // Now perform the training with labels.
@@ -472,9 +496,51 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& /* timers */)
   RequireParamValue<double>(params, "tolerance",
       [](double x) { return x >= 0; }, true, "tolerance must be non-negative");
 
-  // Load the input data.
+  if (batch && params.Has("lengths_file"))
+  {
+    Log::Fatal << "Cannot specify both " << PRINT_PARAM_STRING("batch")
+        << " and " << PRINT_PARAM_STRING("lengths_file") << "!" << endl;
+  }
+
+  // Load the input data.  If the sequences are stored one after another, they
+  // are aliases of the columns of allObservations, which must outlive them.
+  mat allObservations;
   vector<mat> trainSeq;
-  if (batch)
+  if (params.Has("lengths_file"))
+  {
+    const string lengthsFile = params.Get<string>("lengths_file");
+    data::Load(inputFile, allObservations, true);
+
+    Mat<size_t> lengths;
+    data::Load(lengthsFile, lengths, true);
+
+    if (accu(lengths) != allObservations.n_cols)
+    {
+      Log::Fatal << "The sequence lengths in '" << lengthsFile << "' add up to "
+          << accu(lengths) << ", but '" << inputFile << "' contains "
+          << allObservations.n_cols << " observations!" << endl;
+    }
+
+    // Reserve the vector first so that the aliases are never copied.
+    trainSeq.reserve(lengths.n_elem);
+    size_t offset = 0;
+    for (size_t i = 0; i < lengths.n_elem; ++i)
+    {
+      if (lengths[i] == 0)
+      {
+        Log::Fatal << "Sequence " << i << " in '" << lengthsFile << "' has "
+            << "length 0!" << endl;
+      }
+
+      trainSeq.emplace_back(allObservations.colptr(offset),
+          allObservations.n_rows, lengths[i], false, true);
+      offset += lengths[i];
+    }
+
+    Log::Info << "Split " << allObservations.n_cols << " observations into "
+        << trainSeq.size() << " training sequences." << endl;
+  }
+  else if (batch)
   {
     // The input file contains a list of files to read.
     Log::Info << "Reading list of training sequences from '" << inputFile
@@ -0,0 +1,304 @@
+/**
+ * @file methods/hnsw/hnsw_search.hpp
+ *
+ * Defines the HNSWSearch class, which performs approximate nearest neighbor
+ * search with a hierarchical navigable small world (HNSW) graph.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and robust approximate nearest neighbor search using
+ *       hierarchical navigable small world graphs},
+ *   author={Malkov, Y.A. and Yashunin, D.A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018},
+ *   publisher={IEEE}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace mlpack {
+
+/**
+ * The HNSWSearch class builds a hierarchical navigable small world graph on a
+ * reference set and uses it to compute approximate nearest neighbors of query
+ * points.
+ *
+ * Every reference point is a node of the graph, and is assigned a random level
+ * (most points have level 0, and the number of points with each higher level
+ * decreases exponentially).  On each layer up to its level, a point is linked
+ * to at most MaxNeighbors() nearby points (2 * MaxNeighbors() on layer 0),
+ * which are chosen with the neighbor selection heuristic of the paper so that
+ * the links point in different directions.  A search starts from the entry point
+ * on the highest layer, greedily moves to the closest point on each layer, and
+ * finally performs a best-first search with a candidate list of Ef() points on
+ * layer 0.  Larger values of Ef() give better results but take longer.
+ *
+ * The points are inserted into the graph in parallel with OpenMP, if it is
+ * available; each node has its own lock during construction.  Because the
+ * insertion order then depends on the scheduling of the threads, the graph
+ * built with more than one thread may differ slightly between runs.
+ *
+ * Any distance metric in mlpack can be used, such as LMetric or IPMetric; the
+ * search is only guaranteed to work well for true metrics.
+ *
+ * @code
+ * // Build the graph on a dataset and find the 10 approximate nearest
+ * // neighbors of each query, with a candidate list of 100 points.
+ * HNSWSearch<> hnsw(dataset);
+ * hnsw.Ef() = 100;
+ * hnsw.Search(queries, 10, neighbors, distances);
+ * @endcode
+ *
+ * @tparam DistanceType The distance metric to use for computation.
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat>
+class HNSWSearch
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create an HNSWSearch object without a reference set.  Be sure to call
+   * Train() before calling Search(); otherwise, an exception will be thrown
+   * when Search() is called.
+   *
+   * @param maxNeighbors Maximum number of links of each point on each layer
+   *     above 0 (points have twice as many links on layer 0).
+   * @param efConstruction Size of the candidate list used to find the
+   *     neighbors of each point during construction.
+   * @param ef Size of the candidate list used during search.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(const size_t maxNeighbors = 16,
+             const size_t efConstruction = 200,
+             const size_t ef = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Build the graph on the given reference set.  In order to avoid copying the
+   * reference set, consider passing it with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param maxNeighbors Maximum number of links of each point on each layer
+   *     above 0 (points have twice as many links on layer 0).
+   * @param efConstruction Size of the candidate list used to find the
+   *     neighbors of each point during construction.
+   * @param ef Size of the candidate list used during search.
+   * @param distance Instantiated distance metric.
+   */
+  HNSWSearch(MatType referenceSet,
+             const size_t maxNeighbors = 16,
+             const size_t efConstruction = 200,
+             const size_t ef = 50,
+             DistanceType distance = DistanceType());
+
+  /**
+   * Build the graph on the given reference set, replacing any existing graph.
+   * MaxNeighbors() and EfConstruction() are used.  In order to avoid copying
+   * the reference set, consider passing it with std::move().  A
+   * std::invalid_argument is thrown if MaxNeighbors() is less than 2 or
+   * EfConstruction() is 0.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Compute the approximate nearest neighbors of the points in the given query
+   * set and store the output in the given matrices.  The matrices will be set
+   * to the size of n columns by k rows, where n is the number of points in the
+   * query set.  The search uses a candidate list of max(Ef(), k) points.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  /**
+   * Compute the approximate nearest neighbors of every point in the reference
+   * set (not counting the point itself), and store the output in the given
+   * matrices.  The matrices will be set to the size of n columns by k rows,
+   * where n is the number of reference points.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  /**
+   * Serialize the graph.
+   *
+   * @param ar Archive to serialize to.
+   * @param version Serialization version of the class.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Get the reference set.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the maximum number of links of each point on the layers above 0.
+  size_t MaxNeighbors() const { return maxNeighbors; }
+  //! Modify the maximum number of links of each point on the layers above 0.
+  //! This takes effect the next time Train() is called.
+  size_t& MaxNeighbors() { return maxNeighbors; }
+
+  //! Get the size of the candidate list used during construction.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the size of the candidate list used during construction.  This
+  //! takes effect the next time Train() is called.
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the size of the candidate list used during search.
+  size_t Ef() const { return ef; }
+  //! Modify the size of the candidate list used during search.
+  size_t& Ef() { return ef; }
+
+  //! Get the highest layer of the graph.
+  size_t MaxLevel() const { return maxLevel; }
+  //! Get the index of the point where every search starts.
+  size_t EntryPoint() const { return entryPoint; }
+  //! Get the level of the given point.
+  size_t Level(const size_t point) const { return links[point].size() - 1; }
+  //! Get the links of the given point on the given layer.
+  const std::vector<size_t>& Links(const size_t point, const size_t level) const
+  { return links[point][level]; }
+
+  //! Get the distance metric.
+  const DistanceType& Distance() const { return distance; }
+  //! Modify the distance metric.
+  DistanceType& Distance() { return distance; }
+
+ private:
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  /**
+   * Insert the given reference point into the graph.  Other points may be
+   * inserted at the same time by other threads.
+   *
+   * @param point Index of the point to insert.
+   * @param locks Locks of the links of each point.
+   * @param entryLock Lock of the entry point and the highest layer.
+   */
+  void Insert(const size_t point,
+              std::vector<std::mutex>& locks,
+              std::mutex& entryLock);
+
+  /**
+   * Greedily move from the given point to the point closest to the query on
+   * the given layer.
+   *
+   * @param query Query point.
+   * @param level Layer to search.
+   * @param nearest Starting point; set to the closest point found.
+   * @param nearestDistance Distance to the starting point; set to the distance
+   *     to the closest point found.
+   * @param locks Locks of the links of each point (NULL if the graph is not
+   *     being modified).
+   */
+  template<typename VecType>
+  void SearchGreedy(const VecType& query,
+                    const size_t level,
+                    size_t& nearest,
+                    double& nearestDistance,
+                    std::vector<std::mutex>* locks);
+
+  /**
+   * Perform a best-first search for the ef points closest to the query on the
+   * given layer, starting from the given points.
+   *
+   * @param query Query point.
+   * @param entryPoints Points to start the search from.
+   * @param ef Size of the candidate list.
+   * @param level Layer to search.
+   * @param exclude Point that must not be returned (e.g. the point being
+   *     inserted), or the number of points if there is none.
+   * @param locks Locks of the links of each point (NULL if the graph is not
+   *     being modified).
+   * @return The points found, sorted by increasing distance.
+   */
+  template<typename VecType>
+  std::vector<Candidate> SearchLayer(const VecType& query,
+                                     const std::vector<Candidate>& entryPoints,
+                                     const size_t ef,
+                                     const size_t level,
+                                     const size_t exclude,
+                                     std::vector<std::mutex>* locks);
+
+  /**
+   * Choose at most the given number of links among the given candidates with
+   * the heuristic of the paper: a candidate is kept only if it is closer to
+   * the base point than to every candidate kept before it.
+   *
+   * @param candidates Candidates, sorted by increasing distance to the base
+   *     point.
+   * @param maxLinks Maximum number of links to keep.
+   * @param selected Set to the chosen points.
+   */
+  void SelectNeighbors(const std::vector<Candidate>& candidates,
+                       const size_t maxLinks,
+                       std::vector<size_t>& selected);
+
+  //! Get the maximum number of links of each point on the given layer.
+  size_t MaxLinks(const size_t level) const
+  { return (level == 0) ? 2 * maxNeighbors : maxNeighbors; }
+
+  //! Reference dataset.
+  MatType referenceSet;
+
+  //! Maximum number of links of each point on the layers above 0.
+  size_t maxNeighbors;
+  //! Size of the candidate list used during construction.
+  size_t efConstruction;
+  //! Size of the candidate list used during search.
+  size_t ef;
+
+  //! The point where every search starts.
+  size_t entryPoint;
+  //! The highest layer of the graph.
+  size_t maxLevel;
+  //! The links of each point; links[i][l] holds the links of point i on layer
+  //! l, and links[i].size() - 1 is the level of point i.
+  std::vector<std::vector<std::vector<size_t>>> links;
+
+  //! Instantiated distance metric.
+  DistanceType distance;
+}; // class HNSWSearch
+
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_search_impl.hpp"
+
+#endif
@@ -0,0 +1,440 @@
+/**
+ * @file methods/hnsw/hnsw_search_impl.hpp
+ *
+ * Implementation of the HNSWSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_search.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(const size_t maxNeighbors,
+                                              const size_t efConstruction,
+                                              const size_t ef,
+                                              DistanceType distance) :
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    ef(ef),
+    entryPoint(0),
+    maxLevel(0),
+    distance(std::move(distance))
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType, typename MatType>
+HNSWSearch<DistanceType, MatType>::HNSWSearch(MatType referenceSet,
+                                              const size_t maxNeighbors,
+                                              const size_t efConstruction,
+                                              const size_t ef,
+                                              DistanceType distance) :
+    maxNeighbors(maxNeighbors),
+    efConstruction(efConstruction),
+    ef(ef),
+    entryPoint(0),
+    maxLevel(0),
+    distance(std::move(distance))
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Train(MatType referenceSetIn)
+{
+  if (maxNeighbors < 2)
+  {
+    throw std::invalid_argument("HNSWSearch::Train(): the maximum number of "
+        "neighbors must be at least 2!");
+  }
+
+  if (efConstruction == 0)
+  {
+    throw std::invalid_argument("HNSWSearch::Train(): the size of the "
+        "candidate list for construction must be greater than 0!");
+  }
+
+  referenceSet = std::move(referenceSetIn);
+  const size_t n = referenceSet.n_cols;
+
+  // Draw the level of each point before the points are inserted, so that the
+  // levels do not depend on the order of insertion.
+  const double levelMult = 1.0 / std::log((double) maxNeighbors);
+  links.clear();
+  links.resize(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double u = std::max(Random(), std::numeric_limits<double>::min());
+    links[i].resize((size_t) std::floor(-std::log(u) * levelMult) + 1);
+  }
+
+  entryPoint = 0;
+  maxLevel = (n == 0) ? 0 : links[0].size() - 1;
+
+  std::vector<std::mutex> locks(n);
+  std::mutex entryLock;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 1; i < n; ++i)
+    Insert(i, locks, entryLock);
+
+  Log::Info << "Built HNSW graph on " << n << " points with " << maxLevel + 1
+      << " layers." << std::endl;
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Insert(const size_t point,
+                                               std::vector<std::mutex>& locks,
+                                               std::mutex& entryLock)
+{
+  const size_t level = links[point].size() - 1;
+
+  // If this point becomes the new entry point, no other point may start an
+  // insertion until its links are in place.
+  std::unique_lock<std::mutex> entryGuard(entryLock);
+  const size_t currentMaxLevel = maxLevel;
+  size_t nearest = entryPoint;
+  if (level <= currentMaxLevel)
+    entryGuard.unlock();
+
+  double nearestDistance = distance.Evaluate(referenceSet.col(point),
+      referenceSet.col(nearest));
+  for (size_t l = currentMaxLevel; l > level; --l)
+  {
+    SearchGreedy(referenceSet.col(point), l, nearest, nearestDistance,
+        &locks);
+  }
+
+  std::vector<Candidate> entryPoints(1,
+      std::make_pair(nearestDistance, nearest));
+  std::vector<size_t> selected;
+  for (size_t l = std::min(level, currentMaxLevel) + 1; l-- > 0; )
+  {
+    std::vector<Candidate> candidates = SearchLayer(referenceSet.col(point),
+        entryPoints, efConstruction, l, point, &locks);
+    SelectNeighbors(candidates, MaxLinks(l), selected);
+
+    {
+      std::lock_guard<std::mutex> lock(locks[point]);
+      links[point][l] = selected;
+    }
+
+    // Link the neighbors back to the new point, shrinking their links if
+    // there are too many.
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+      const size_t neighbor = selected[i];
+      std::lock_guard<std::mutex> lock(locks[neighbor]);
+      std::vector<size_t>& neighborLinks = links[neighbor][l];
+      neighborLinks.push_back(point);
+      if (neighborLinks.size() > MaxLinks(l))
+      {
+        std::vector<Candidate> neighborCandidates(neighborLinks.size());
+        for (size_t j = 0; j < neighborLinks.size(); ++j)
+        {
+          neighborCandidates[j] = std::make_pair(distance.Evaluate(
+              referenceSet.col(neighbor), referenceSet.col(neighborLinks[j])),
+              neighborLinks[j]);
+        }
+        std::sort(neighborCandidates.begin(), neighborCandidates.end());
+        SelectNeighbors(neighborCandidates, MaxLinks(l), neighborLinks);
+      }
+    }
+
+    entryPoints = std::move(candidates);
+  }
+
+  if (level > currentMaxLevel)
+  {
+    entryPoint = point;
+    maxLevel = level;
+  }
+}
+
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+void HNSWSearch<DistanceType, MatType>::SearchGreedy(
+    const VecType& query,
+    const size_t level,
+    size_t& nearest,
+    double& nearestDistance,
+    std::vector<std::mutex>* locks)
+{
+  std::vector<size_t> nodeLinks;
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    if (locks)
+    {
+      std::lock_guard<std::mutex> lock((*locks)[nearest]);
+      nodeLinks = links[nearest][level];
+    }
+    const std::vector<size_t>& currentLinks = (locks) ? nodeLinks :
+        links[nearest][level];
+
+    for (size_t i = 0; i < currentLinks.size(); ++i)
+    {
+      const double d = distance.Evaluate(query,
+          referenceSet.col(currentLinks[i]));
+      if (d < nearestDistance)
+      {
+        nearestDistance = d;
+        nearest = currentLinks[i];
+        changed = true;
+      }
+    }
+  }
+}
+
+template<typename DistanceType, typename MatType>
+template<typename VecType>
+std::vector<typename HNSWSearch<DistanceType, MatType>::Candidate>
+HNSWSearch<DistanceType, MatType>::SearchLayer(
+    const VecType& query,
+    const std::vector<Candidate>& entryPoints,
+    const size_t ef,
+    const size_t level,
+    const size_t exclude,
+    std::vector<std::mutex>* locks)
+{
+  // The closest unexpanded points are at the top of 'candidates', and the
+  // furthest of the ef points found so far is at the top of 'results'.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> candidates;
+  std::priority_queue<Candidate> results;
+  std::unordered_set<size_t> visited;
+
+  visited.insert(exclude);
+  for (size_t i = 0; i < entryPoints.size(); ++i)
+  {
+    if (!visited.insert(entryPoints[i].second).second)
+      continue;
+
+    candidates.push(entryPoints[i]);
+    results.push(entryPoints[i]);
+    if (results.size() > ef)
+      results.pop();
+  }
+
+  std::vector<size_t> nodeLinks;
+  while (!candidates.empty())
+  {
+    const Candidate c = candidates.top();
+    if (results.size() >= ef && c.first > results.top().first)
+      break;
+    candidates.pop();
+
+    if (locks)
+    {
+      std::lock_guard<std::mutex> lock((*locks)[c.second]);
+      nodeLinks = links[c.second][level];
+    }
+    const std::vector<size_t>& currentLinks = (locks) ? nodeLinks :
+        links[c.second][level];
+
+    for (size_t i = 0; i < currentLinks.size(); ++i)
+    {
+      const size_t neighbor = currentLinks[i];
+      if (!visited.insert(neighbor).second)
+        continue;
+
+      const double d = distance.Evaluate(query, referenceSet.col(neighbor));
+      if (results.size() < ef || d < results.top().first)
+      {
+        candidates.push(std::make_pair(d, neighbor));
+        results.push(std::make_pair(d, neighbor));
+        if (results.size() > ef)
+          results.pop();
+      }
+    }
+  }
+
+  std::vector<Candidate> found(results.size());
+  for (size_t i = found.size(); i > 0; --i)
+  {
+    found[i - 1] = results.top();
+    results.pop();
+  }
+
+  return found;
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::SelectNeighbors(
+    const std::vector<Candidate>& candidates,
+    const size_t maxLinks,
+    std::vector<size_t>& selected)
+{
+  // The candidates may be the links that are being replaced, so collect the
+  // chosen points separately.
+  std::vector<size_t> result;
+  for (size_t i = 0; i < candidates.size() && result.size() < maxLinks; ++i)
+  {
+    bool keep = true;
+    for (size_t j = 0; j < result.size(); ++j)
+    {
+      if (distance.Evaluate(referenceSet.col(candidates[i].second),
+          referenceSet.col(result[j])) < candidates[i].first)
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      result.push_back(candidates[i].second);
+  }
+
+  selected = std::move(result);
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("HNSWSearch::Search(): the graph has not been "
+        "built!");
+  }
+
+  util::CheckSameDimensionality(querySet, referenceSet,
+      "HNSWSearch::Search()", "query set");
+
+  if (k > referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but the reference set has " << referenceSet.n_cols
+        << " points!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  if (k == 0)
+    return;
+
+  const size_t searchEf = std::max(ef, k);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t q = 0; q < (size_t) querySet.n_cols; ++q)
+  {
+    size_t nearest = entryPoint;
+    double nearestDistance = distance.Evaluate(querySet.col(q),
+        referenceSet.col(nearest));
+    for (size_t l = maxLevel; l > 0; --l)
+      SearchGreedy(querySet.col(q), l, nearest, nearestDistance, NULL);
+
+    const std::vector<Candidate> found = SearchLayer(querySet.col(q),
+        std::vector<Candidate>(1, std::make_pair(nearestDistance, nearest)),
+        searchEf, 0, referenceSet.n_cols, NULL);
+
+    // If the graph is badly connected, fewer than k points may be found.
+    for (size_t j = 0; j < k; ++j)
+    {
+      neighbors(j, q) = (j < found.size()) ? found[j].second : size_t() - 1;
+      distances(j, q) = (j < found.size()) ? (ElemType) found[j].first :
+          std::numeric_limits<ElemType>::max();
+    }
+  }
+}
+
+template<typename DistanceType, typename MatType>
+void HNSWSearch<DistanceType, MatType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  if (referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("HNSWSearch::Search(): the graph has not been "
+        "built!");
+  }
+
+  if (k >= referenceSet.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but the reference set has " << referenceSet.n_cols
+        << " points (and each point is not its own neighbor)!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+
+  if (k == 0)
+    return;
+
+  const size_t searchEf = std::max(ef, k);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t q = 0; q < (size_t) referenceSet.n_cols; ++q)
+  {
+    // The point itself is still used to navigate the graph (it may be the
+    // entry point), but it is never returned.
+    size_t nearest = entryPoint;
+    double nearestDistance = distance.Evaluate(referenceSet.col(q),
+        referenceSet.col(nearest));
+    for (size_t l = maxLevel; l > 0; --l)
+      SearchGreedy(referenceSet.col(q), l, nearest, nearestDistance, NULL);
+
+    std::vector<Candidate> entryPoints(1,
+        std::make_pair(nearestDistance, nearest));
+    if (nearest == q)
+    {
+      // Start from the links of the point instead.
+      entryPoints.clear();
+      const std::vector<size_t>& qLinks = links[q][0];
+      for (size_t i = 0; i < qLinks.size(); ++i)
+      {
+        entryPoints.push_back(std::make_pair(distance.Evaluate(
+            referenceSet.col(q), referenceSet.col(qLinks[i])), qLinks[i]));
+      }
+    }
+
+    const std::vector<Candidate> found = SearchLayer(referenceSet.col(q),
+        entryPoints, searchEf, 0, q, NULL);
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      neighbors(j, q) = (j < found.size()) ? found[j].second : size_t() - 1;
+      distances(j, q) = (j < found.size()) ? (ElemType) found[j].first :
+          std::numeric_limits<ElemType>::max();
+    }
+  }
+}
+
+template<typename DistanceType, typename MatType>
+template<typename Archive>
+void HNSWSearch<DistanceType, MatType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(maxNeighbors));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(ef));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxLevel));
+  ar(CEREAL_NVP(links));
+  ar(CEREAL_NVP(distance));
+}
+
+} // namespace mlpack
+
+#endif
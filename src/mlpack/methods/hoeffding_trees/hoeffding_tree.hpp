@@ -54,6 +54,15 @@ namespace mlpack {
  * categorical attributes are handled.  As far as the actual splitting goes,
  * the meat of the splitting procedure will be contained in those two classes.
  *
+ * Every leaf keeps split statistics for every dimension, so the memory used by
+ * a tree that keeps growing is not bounded.  As in the VFDT paper above, the
+ * number of leaves that keep statistics can be limited with MaxActiveLeaves().
+ * Whenever a leaf splits (and after each batch of points), only the leaves
+ * with the highest promise (the number of points they have seen times their
+ * error rate) are kept active.  The others drop their statistics and only
+ * count the points that reach them, and they are reactivated with empty
+ * statistics once they become promising enough again.
+ *
  * @tparam FitnessFunction Fitness function to use.
  * @tparam NumericSplitType Technique for splitting numeric features.
  * @tparam CategoricalSplitType Technique for splitting categorical features.
@@ -359,6 +368,26 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a mini-batch of points in streaming mode, with the given labels.
+   * The tree will not be reset before training, so it must already have the
+   * dimensionality of `data`.
+   *
+   * The points are routed to the leaves of the tree in parallel, and the
+   * statistics of each dimension of each leaf are then updated in parallel
+   * with its points (in order).  Each leaf checks for a split only once, after
+   * the whole batch, if it has seen at least another `CheckInterval()` points
+   * since the last check; a leaf that splits during the batch does not pass any
+   * of the batch's points to its new children.  Apart from the time at which
+   * splits are checked, this gives the same tree as calling Train() on each
+   * point in turn.
+   *
+   * @param data Points to train on.
+   * @param labels Labels of the points to train on.
+   */
+  template<typename MatType>
+  void TrainMiniBatch(const MatType& data, const arma::Row<size_t>& labels);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -410,6 +439,17 @@ class HoeffdingTree
   //! Get the number of points seen so far.
   size_t NumSamples() const { return numSamples; }
 
+  //! Get the maximum number of leaves that keep split statistics (0 means no
+  //! limit).  Only the setting of the root of the tree is used.
+  size_t MaxActiveLeaves() const { return maxActiveLeaves; }
+  //! Modify the maximum number of leaves that keep split statistics (0 means
+  //! no limit).  The new limit is applied the next time the tree is trained.
+  size_t& MaxActiveLeaves() { return maxActiveLeaves; }
+
+  //! Get whether or not this node keeps split statistics.  All nodes are
+  //! active unless MaxActiveLeaves() is set.
+  bool Active() const { return active; }
+
   //! Get the number of classes the tree is trained on.
   size_t NumClasses() const { return numClasses; }
 
@@ -501,7 +541,35 @@ class HoeffdingTree
 
   //! Serialize the split.
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
+
+  /**
+   * Save a delta checkpoint of the tree: only the subtrees that changed since
+   * the last call to SaveDelta() or LoadDelta(), or since the tree was loaded,
+   * are saved.  Training only changes the leaves that the points reach, so the
+   * delta of a large tree is usually much smaller than the full tree; it can be
+   * saved to a memory buffer quickly and then written out by another thread,
+   * while training continues.  If the root changed (for instance, because the
+   * tree was reset), the whole tree is saved.
+   *
+   * Changes made through MajorityClass(), MajorityProbability() and
+   * MaxActiveLeaves() are not tracked.
+   *
+   * @param ar Archive to save the delta to.
+   */
+  template<typename Archive>
+  void SaveDelta(Archive& ar);
+
+  /**
+   * Apply a delta checkpoint that was saved by SaveDelta().  The tree must be
+   * in the state it had when the previous checkpoint (full or delta) was taken;
+   * a std::runtime_error is thrown if the delta does not match the structure of
+   * the tree.
+   *
+   * @param ar Archive to load the delta from.
+   */
+  template<typename Archive>
+  void LoadDelta(Archive& ar);
 
  private:
   // We need to keep some information for before we have split.
@@ -549,6 +617,40 @@ class HoeffdingTree
   //! If the split has occurred, these are the children.
   std::vector<HoeffdingTree*> children;
 
+  //! Whether or not this node keeps split statistics.
+  bool active;
+  //! The number of points seen by this leaf, including the points that were
+  //! seen while it was inactive (and are not in numSamples).
+  size_t totalSamples;
+  //! The maximum number of active leaves (0 for no limit).
+  size_t maxActiveLeaves;
+  //! Whether or not this node changed since the last delta checkpoint.
+  bool modified;
+
+  /**
+   * Train on a single point, and return whether or not a leaf split.
+   */
+  template<typename VecType>
+  bool TrainPoint(const VecType& point, const size_t label);
+
+  //! Keep only the maxActiveLeaves most promising leaves active.
+  void LimitActiveLeaves();
+
+  //! Drop the split statistics of this leaf.
+  void Deactivate();
+
+  //! Give this leaf empty split statistics again.
+  void Activate();
+
+  //! Mark every node of this subtree as unchanged since the last checkpoint.
+  void ClearModified();
+
+  /**
+   * Make every node of this subtree, which was just loaded, use the dataset
+   * information, dimension mappings and settings of the given tree.
+   */
+  void AdoptTreeInfo(const HoeffdingTree& tree);
+
   /**
    * Perform training (typically after a reset, but not necessarily).  This
    * assumes datasetInfo and dimensionMappings are set correctly.
@@ -570,6 +672,12 @@ class HoeffdingTree
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename FitnessFunction,
+                               template<typename> class NumericSplitType,
+                               template<typename> class CategoricalSplitType),
+    (mlpack::HoeffdingTree<FitnessFunction, NumericSplitType,
+        CategoricalSplitType>), (1));
+
 #include "hoeffding_tree_impl.hpp"
 
 #endif
@@ -40,7 +40,11 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    active(true),
+    totalSamples(0),
+    maxActiveLeaves(0),
+    modified(true)
 {
   // Nothing to do.
 }
@@ -78,7 +82,11 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    active(true),
+    totalSamples(0),
+    maxActiveLeaves(0),
+    modified(true)
 {
   // Do we need to generate the mappings too?
   if (ownsMappings)
@@ -131,7 +139,11 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    active(true),
+    totalSamples(0),
+    maxActiveLeaves(0),
+    modified(true)
 {
   // Do we need to generate the mappings too?
   if (ownsMappings)
@@ -189,7 +201,11 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    active(true),
+    totalSamples(0),
+    maxActiveLeaves(0),
+    modified(true)
 {
   // Reset the tree.
   ResetTree(categoricalSplitIn, numericSplitIn);
@@ -232,7 +248,11 @@ HoeffdingTree<
     majorityClass(0),
     majorityProbability(0.0),
     categoricalSplit(0),
-    numericSplit()
+    numericSplit(),
+    active(true),
+    totalSamples(0),
+    maxActiveLeaves(0),
+    modified(true)
 {
   // Reset the tree.
   ResetTree(categoricalSplitIn, numericSplitIn);
@@ -264,7 +284,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
     categoricalSplit(other.categoricalSplit),
-    numericSplit(other.numericSplit)
+    numericSplit(other.numericSplit),
+    active(other.active),
+    totalSamples(other.totalSamples),
+    maxActiveLeaves(other.maxActiveLeaves),
+    modified(other.modified)
 {
   // Copy each of the children.
   for (size_t i = 0; i < other.children.size(); ++i)
@@ -304,7 +328,11 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
     majorityClass(other.majorityClass),
     majorityProbability(other.majorityProbability),
     categoricalSplit(std::move(other.categoricalSplit)),
-    numericSplit(std::move(other.numericSplit))
+    numericSplit(std::move(other.numericSplit)),
+    active(other.active),
+    totalSamples(other.totalSamples),
+    maxActiveLeaves(other.maxActiveLeaves),
+    modified(other.modified)
 {
   // Remove pointers.
   other.dimensionMappings = nullptr;
@@ -319,6 +347,7 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>::
   other.splitDimension = 0;
   other.majorityClass = 0;
   other.majorityProbability = 0.0;
+  other.totalSamples = 0;
 }
 
 // Copy assignment operator.
@@ -349,6 +378,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     majorityProbability = other.majorityProbability;
     categoricalSplit = other.categoricalSplit;
     numericSplit = other.numericSplit;
+    active = other.active;
+    totalSamples = other.totalSamples;
+    maxActiveLeaves = other.maxActiveLeaves;
+    modified = other.modified;
 
     // Copy each of the children.
     for (size_t i = 0; i < other.children.size(); ++i)
@@ -395,6 +428,10 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     majorityProbability = other.majorityProbability;
     categoricalSplit = std::move(other.categoricalSplit);
     numericSplit = std::move(other.numericSplit);
+    active = other.active;
+    totalSamples = other.totalSamples;
+    maxActiveLeaves = other.maxActiveLeaves;
+    modified = other.modified;
 
     // Remove pointers.
     other.dimensionMappings = nullptr;
@@ -409,6 +446,7 @@ HoeffdingTree<FitnessFunction, NumericSplitType, CategoricalSplitType>&
     other.splitDimension = 0;
     other.majorityClass = 0;
     other.majorityProbability = 0.0;
+    other.totalSamples = 0;
   }
   return *this;
 }
@@ -588,9 +626,29 @@ void HoeffdingTree<
     NumericSplitType,
     CategoricalSplitType
 >::Train(const VecType& point, const size_t label)
+{
+  if (TrainPoint(point, label) && maxActiveLeaves > 0)
+    LimitActiveLeaves();
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+bool HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainPoint(const VecType& point, const size_t label)
 {
   if (splitDimension == size_t(-1))
   {
+    // An inactive leaf only counts the points that reach it.
+    ++totalSamples;
+    modified = true;
+    if (!active)
+      return false;
+
     ++numSamples;
     size_t numericIndex = 0;
     size_t categoricalIndex = 0;
@@ -602,16 +660,20 @@ void HoeffdingTree<
         numericSplits[numericIndex++].Train(point[i], label);
     }
 
-    // Grab majority class from splits.
-    if (categoricalSplits.size() > 0)
+    // Grab majority class from splits.  A leaf that was reactivated keeps its
+    // old estimate until its new statistics have seen enough points.
+    if (numSamples == totalSamples || numSamples > minSamples)
     {
-      majorityClass = categoricalSplits[0].MajorityClass();
-      majorityProbability = categoricalSplits[0].MajorityProbability();
-    }
-    else
-    {
-      majorityClass = numericSplits[0].MajorityClass();
-      majorityProbability = numericSplits[0].MajorityProbability();
+      if (categoricalSplits.size() > 0)
+      {
+        majorityClass = categoricalSplits[0].MajorityClass();
+        majorityProbability = categoricalSplits[0].MajorityProbability();
+      }
+      else
+      {
+        majorityClass = numericSplits[0].MajorityClass();
+        majorityProbability = numericSplits[0].MajorityProbability();
+      }
     }
 
     // Check for a split, if we should.
@@ -624,15 +686,140 @@ void HoeffdingTree<
         // Delete children, if we have them.
         children.clear();
         CreateChildren();
+        return true;
       }
     }
+
+    return false;
   }
   else
   {
     // Already split.  Pass the training point to the relevant child.
     size_t direction = CalculateDirection(point);
-    children[direction]->Train(point, label);
+    return children[direction]->TrainPoint(point, label);
+  }
+}
+
+//! Train on a mini-batch of points.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainMiniBatch(const MatType& data, const arma::Row<size_t>& labels)
+{
+  util::CheckSameSizes(data, labels, "HoeffdingTree::TrainMiniBatch()");
+  util::CheckSameDimensionality(data, datasetInfo->Dimensionality(),
+      "HoeffdingTree::TrainMiniBatch()");
+
+  // Find the leaf that each point goes to.  The tree does not change while we
+  // do this, so the points can be routed independently.
+  std::vector<HoeffdingTree*> pointLeaves(data.n_cols);
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    HoeffdingTree* node = this;
+    while (node->splitDimension != size_t(-1))
+      node = node->children[node->CalculateDirection(data.col(i))];
+    pointLeaves[i] = node;
+  }
+
+  // Collect the points of each leaf, keeping them in order.
+  std::unordered_map<HoeffdingTree*, size_t> leafIndices;
+  std::vector<HoeffdingTree*> leaves;
+  std::vector<std::vector<size_t>> leafPoints;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const auto it = leafIndices.find(pointLeaves[i]);
+    if (it == leafIndices.end())
+    {
+      leafIndices[pointLeaves[i]] = leaves.size();
+      leaves.push_back(pointLeaves[i]);
+      leafPoints.push_back(std::vector<size_t>(1, i));
+    }
+    else
+    {
+      leafPoints[it->second].push_back(i);
+    }
+  }
+
+  // Each split object belongs to one dimension of one leaf, so every
+  // (leaf, dimension) pair can be updated by a different thread.
+  const size_t numDimensions = data.n_rows;
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t t = 0; t < leaves.size() * numDimensions; ++t)
+  {
+    HoeffdingTree& leaf = *leaves[t / numDimensions];
+    if (!leaf.active)
+      continue;
+
+    const std::vector<size_t>& points = leafPoints[t / numDimensions];
+    const size_t d = t % numDimensions;
+    const size_t type = leaf.dimensionMappings->at(d).first;
+    const size_t index = leaf.dimensionMappings->at(d).second;
+
+    if (type == data::Datatype::categorical)
+    {
+      for (size_t j = 0; j < points.size(); ++j)
+        leaf.categoricalSplits[index].Train(data(d, points[j]),
+            labels[points[j]]);
+    }
+    else if (type == data::Datatype::numeric)
+    {
+      for (size_t j = 0; j < points.size(); ++j)
+        leaf.numericSplits[index].Train(data(d, points[j]), labels[points[j]]);
+    }
+  }
+
+  // Now update each leaf, and check for a split if it is time to.
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t l = 0; l < leaves.size(); ++l)
+  {
+    HoeffdingTree& leaf = *leaves[l];
+    leaf.totalSamples += leafPoints[l].size();
+    leaf.modified = true;
+    if (!leaf.active)
+      continue;
+
+    const size_t oldNumSamples = leaf.numSamples;
+    leaf.numSamples += leafPoints[l].size();
+
+    // Grab majority class from splits, unless the leaf was reactivated and
+    // its new statistics are still too small.
+    if (leaf.numSamples == leaf.totalSamples ||
+        leaf.numSamples > leaf.minSamples)
+    {
+      if (leaf.categoricalSplits.size() > 0)
+      {
+        leaf.majorityClass = leaf.categoricalSplits[0].MajorityClass();
+        leaf.majorityProbability =
+            leaf.categoricalSplits[0].MajorityProbability();
+      }
+      else
+      {
+        leaf.majorityClass = leaf.numericSplits[0].MajorityClass();
+        leaf.majorityProbability =
+            leaf.numericSplits[0].MajorityProbability();
+      }
+    }
+
+    if (leaf.numSamples / leaf.checkInterval !=
+        oldNumSamples / leaf.checkInterval)
+    {
+      const size_t numChildren = leaf.SplitCheck();
+      if (numChildren > 0)
+      {
+        leaf.children.clear();
+        leaf.CreateChildren();
+      }
+    }
   }
+
+  if (maxActiveLeaves > 0)
+    LimitActiveLeaves();
 }
 
 template<typename FitnessFunction,
@@ -644,8 +831,8 @@ size_t HoeffdingTree<
     CategoricalSplitType
 >::SplitCheck()
 {
-  // Do nothing if we've already split.
-  if (splitDimension != size_t(-1))
+  // Do nothing if we've already split, or if we have no statistics.
+  if (splitDimension != size_t(-1) || !active)
     return 0;
 
   // If not enough points have been seen, we cannot split.
@@ -736,6 +923,7 @@ void HoeffdingTree<
 >::SuccessProbability(const double successProbability)
 {
   this->successProbability = successProbability;
+  modified = true;
   for (size_t i = 0; i < children.size(); ++i)
     children[i]->SuccessProbability(successProbability);
 }
@@ -768,6 +956,7 @@ void HoeffdingTree<
 >::MaxSamples(const size_t maxSamples)
 {
   this->maxSamples = maxSamples;
+  modified = true;
   for (size_t i = 0; i < children.size(); ++i)
     children[i]->MaxSamples(maxSamples);
 }
@@ -1055,7 +1244,7 @@ void HoeffdingTree<
     FitnessFunction,
     NumericSplitType,
     CategoricalSplitType
->::serialize(Archive& ar, const uint32_t /* version */)
+>::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(splitDimension));
 
@@ -1089,12 +1278,27 @@ void HoeffdingTree<
   ar(CEREAL_NVP(majorityClass));
   ar(CEREAL_NVP(majorityProbability));
 
+  // Version 1 added the limit on the number of active leaves.
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(maxActiveLeaves));
+    ar(CEREAL_NVP(active));
+    ar(CEREAL_NVP(totalSamples));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    maxActiveLeaves = 0;
+    active = true;
+  }
+
   // Depending on whether or not we have split yet, we may need to save
   // different things.
   if (splitDimension == size_t(-1))
   {
     // We have not yet split.  So we have to serialize the splits.
     ar(CEREAL_NVP(numSamples));
+    if (cereal::is_loading<Archive>() && version == 0)
+      totalSamples = numSamples;
     ar(CEREAL_NVP(numClasses));
     ar(CEREAL_NVP(maxSamples));
     ar(CEREAL_NVP(successProbability));
@@ -1120,6 +1324,16 @@ void HoeffdingTree<
       categoricalSplit = typename CategoricalSplitType<FitnessFunction>::
           SplitInfo(numClasses);
       numericSplit = typename NumericSplitType<FitnessFunction>::SplitInfo();
+
+      // An inactive leaf does not keep any statistics.
+      if (!active)
+      {
+        active = true;
+        Deactivate();
+      }
+
+      // The loaded node is the base for the next delta checkpoint.
+      modified = false;
     }
 
     // There's no need to serialize if there's no information contained in the
@@ -1162,8 +1376,300 @@ void HoeffdingTree<
       numClasses = 0;
       maxSamples = 0;
       successProbability = 0.0;
+      modified = false;
+    }
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename Archive>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::SaveDelta(Archive& ar)
+{
+  // If the root changed, the whole tree has to be saved.
+  bool full = modified;
+  ar(CEREAL_NVP(full));
+  if (full)
+  {
+    ar(cereal::make_nvp("tree", *this));
+    ClearModified();
+    return;
+  }
+
+  // Find the highest nodes that changed.  A node is identified by the indices
+  // of the children that lead to it from the root, and the whole subtree is
+  // saved, since the children of a leaf that split are all new.
+  std::vector<std::vector<size_t>> paths;
+  std::vector<HoeffdingTree*> nodes;
+  std::vector<std::pair<HoeffdingTree*, std::vector<size_t>>> stack;
+  stack.push_back(std::make_pair(this, std::vector<size_t>()));
+  while (!stack.empty())
+  {
+    HoeffdingTree* node = stack.back().first;
+    std::vector<size_t> path = std::move(stack.back().second);
+    stack.pop_back();
+
+    if (node->modified)
+    {
+      paths.push_back(std::move(path));
+      nodes.push_back(node);
+      continue;
+    }
+
+    for (size_t i = 0; i < node->children.size(); ++i)
+    {
+      std::vector<size_t> childPath(path);
+      childPath.push_back(i);
+      stack.push_back(std::make_pair(node->children[i], std::move(childPath)));
+    }
+  }
+
+  ar(CEREAL_NVP(paths));
+  ar(CEREAL_VECTOR_POINTER(nodes));
+
+  for (size_t i = 0; i < nodes.size(); ++i)
+    nodes[i]->ClearModified();
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+template<typename Archive>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::LoadDelta(Archive& ar)
+{
+  bool full;
+  ar(CEREAL_NVP(full));
+  if (full)
+  {
+    ar(cereal::make_nvp("tree", *this));
+    return;
+  }
+
+  std::vector<std::vector<size_t>> paths;
+  std::vector<HoeffdingTree*> nodes;
+  ar(CEREAL_NVP(paths));
+  ar(CEREAL_VECTOR_POINTER(nodes));
+
+  // Check that every saved node exists in this tree before anything is
+  // replaced.
+  std::vector<HoeffdingTree*> parents(paths.size(), NULL);
+  bool valid = (paths.size() == nodes.size());
+  for (size_t i = 0; i < paths.size() && valid; ++i)
+  {
+    HoeffdingTree* node = this;
+    valid = !paths[i].empty();
+    for (size_t j = 0; j < paths[i].size() && valid; ++j)
+    {
+      valid = (paths[i][j] < node->children.size());
+      if (valid)
+      {
+        parents[i] = node;
+        node = node->children[paths[i][j]];
+      }
+    }
+  }
+
+  if (!valid)
+  {
+    for (size_t i = 0; i < nodes.size(); ++i)
+      delete nodes[i];
+    throw std::runtime_error("HoeffdingTree::LoadDelta(): the delta does not "
+        "match the structure of the tree!");
+  }
+
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    nodes[i]->AdoptTreeInfo(*parents[i]);
+    delete parents[i]->children[paths[i].back()];
+    parents[i]->children[paths[i].back()] = nodes[i];
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::LimitActiveLeaves()
+{
+  // Collect all the leaves of the tree.
+  std::vector<HoeffdingTree*> leaves;
+  std::vector<HoeffdingTree*> stack(1, this);
+  while (!stack.empty())
+  {
+    HoeffdingTree* node = stack.back();
+    stack.pop_back();
+    if (node->children.size() == 0)
+      leaves.push_back(node);
+    else
+      stack.insert(stack.end(), node->children.begin(), node->children.end());
+  }
+
+  // The promise of a leaf is the number of points it would classify wrongly,
+  // which is an estimate of how much accuracy would be gained by splitting it.
+  // Sort the leaves by promise; ties are broken in favor of active leaves, so
+  // that leaves are not swapped needlessly.
+  std::vector<std::pair<double, HoeffdingTree*>> promises(leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    promises[i] = std::make_pair(leaves[i]->totalSamples *
+        (1.0 - leaves[i]->majorityProbability), leaves[i]);
+  }
+
+  std::stable_sort(promises.begin(), promises.end(),
+      [](const std::pair<double, HoeffdingTree*>& a,
+         const std::pair<double, HoeffdingTree*>& b)
+      {
+        return (a.first > b.first) ||
+            (a.first == b.first && a.second->active && !b.second->active);
+      });
+
+  for (size_t i = 0; i < promises.size(); ++i)
+  {
+    if (i < maxActiveLeaves)
+      promises[i].second->Activate();
+    else
+      promises[i].second->Deactivate();
+  }
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Deactivate()
+{
+  if (!active)
+    return;
+
+  // Keep one empty split of each type, so that the parameters of the splits
+  // are not lost when the leaf is reactivated.
+  std::vector<NumericSplitType<FitnessFunction>> numericPrototype;
+  if (numericSplits.size() > 0)
+  {
+    numericPrototype.push_back(NumericSplitType<FitnessFunction>(numClasses,
+        numericSplits[0]));
+  }
+
+  std::vector<CategoricalSplitType<FitnessFunction>> categoricalPrototype;
+  if (categoricalSplits.size() > 0)
+  {
+    categoricalPrototype.push_back(CategoricalSplitType<FitnessFunction>(0,
+        numClasses, categoricalSplits[0]));
+  }
+
+  numericSplits.swap(numericPrototype);
+  categoricalSplits.swap(categoricalPrototype);
+  numSamples = 0;
+  active = false;
+  modified = true;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Activate()
+{
+  if (active)
+    return;
+
+  // Build empty splits from the prototypes, in the same order as ResetTree().
+  std::vector<NumericSplitType<FitnessFunction>> newNumericSplits;
+  std::vector<CategoricalSplitType<FitnessFunction>> newCategoricalSplits;
+  for (size_t i = 0; i < datasetInfo->Dimensionality(); ++i)
+  {
+    if (datasetInfo->Type(i) == data::Datatype::categorical)
+    {
+      newCategoricalSplits.push_back(CategoricalSplitType<FitnessFunction>(
+          datasetInfo->NumMappings(i), numClasses, categoricalSplits[0]));
+    }
+    else
+    {
+      newNumericSplits.push_back(NumericSplitType<FitnessFunction>(numClasses,
+          numericSplits[0]));
     }
   }
+
+  numericSplits.swap(newNumericSplits);
+  categoricalSplits.swap(newCategoricalSplits);
+  numSamples = 0;
+  active = true;
+  modified = true;
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::ClearModified()
+{
+  modified = false;
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->ClearModified();
+}
+
+template<
+    typename FitnessFunction,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType
+>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::AdoptTreeInfo(const HoeffdingTree& tree)
+{
+  // Each node of a loaded subtree holds its own copy of the dataset
+  // information and of the dimension mappings.
+  if (datasetInfo != tree.datasetInfo)
+    delete datasetInfo;
+  if (dimensionMappings != tree.dimensionMappings)
+    delete dimensionMappings;
+
+  datasetInfo = tree.datasetInfo;
+  ownsInfo = false;
+  dimensionMappings = tree.dimensionMappings;
+  ownsMappings = false;
+
+  // These settings are not serialized.
+  checkInterval = tree.checkInterval;
+  minSamples = tree.minSamples;
+
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->AdoptTreeInfo(tree);
 }
 
 template<
@@ -1188,7 +1694,7 @@ void HoeffdingTree<
     size_t oldMaxSamples = maxSamples;
     maxSamples = std::max(size_t(data.n_cols - 1), size_t(5));
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+      TrainPoint(data.col(i), labels[i]);
     maxSamples = oldMaxSamples;
 
     // Now, if we did split, find out which points go to which child, and
@@ -1247,12 +1753,18 @@ void HoeffdingTree<
         children[i]->Train(childData, childLabels, numClasses, true);
       }
     }
+
+    if (maxActiveLeaves > 0)
+      LimitActiveLeaves();
   }
   else
   {
     // We aren't training in batch mode; loop through the points.
     for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    {
+      if (TrainPoint(data.col(i), labels[i]) && maxActiveLeaves > 0)
+        LimitActiveLeaves();
+    }
   }
 }
 
@@ -1303,6 +1815,9 @@ void HoeffdingTree<
 
   // Reset statistics.
   numSamples = 0;
+  totalSamples = 0;
+  active = true;
+  modified = true;
   splitDimension = size_t(-1);
   majorityClass = 0;
   majorityProbability = 0.0;
@@ -196,6 +196,58 @@ class HoeffdingTreeModel
       ar(CEREAL_POINTER(infoBinaryTree));
   }
 
+  /**
+   * Save a delta checkpoint of the model, holding only the parts of the tree
+   * that changed since the last checkpoint.  See HoeffdingTree::SaveDelta().
+   */
+  template<typename Archive>
+  void SaveDelta(Archive& ar)
+  {
+    if (!giniHoeffdingTree && !giniBinaryTree && !infoHoeffdingTree &&
+        !infoBinaryTree)
+    {
+      throw std::runtime_error("HoeffdingTreeModel::SaveDelta(): the model "
+          "has not been trained!");
+    }
+
+    ar(CEREAL_NVP(type));
+    if (type == GINI_HOEFFDING)
+      giniHoeffdingTree->SaveDelta(ar);
+    else if (type == GINI_BINARY)
+      giniBinaryTree->SaveDelta(ar);
+    else if (type == INFO_HOEFFDING)
+      infoHoeffdingTree->SaveDelta(ar);
+    else if (type == INFO_BINARY)
+      infoBinaryTree->SaveDelta(ar);
+  }
+
+  /**
+   * Apply a delta checkpoint that was saved by SaveDelta() to the model, which
+   * must be in the state of the previous checkpoint.  See
+   * HoeffdingTree::LoadDelta().
+   */
+  template<typename Archive>
+  void LoadDelta(Archive& ar)
+  {
+    TreeType deltaType;
+    ar(cereal::make_nvp("type", deltaType));
+    if (deltaType != type || (!giniHoeffdingTree && !giniBinaryTree &&
+        !infoHoeffdingTree && !infoBinaryTree))
+    {
+      throw std::runtime_error("HoeffdingTreeModel::LoadDelta(): the delta "
+          "does not match the model!");
+    }
+
+    if (type == GINI_HOEFFDING)
+      giniHoeffdingTree->LoadDelta(ar);
+    else if (type == GINI_BINARY)
+      giniBinaryTree->LoadDelta(ar);
+    else if (type == INFO_HOEFFDING)
+      infoHoeffdingTree->LoadDelta(ar);
+    else if (type == INFO_BINARY)
+      infoBinaryTree->LoadDelta(ar);
+  }
+
  private:
   //! The type of tree we are using.
   TreeType type;
@@ -0,0 +1,214 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_main.cpp
+ *
+ * This file computes approximate nearest neighbors with an inverted file index
+ * and product quantization (IVF-PQ).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME ivf_pq
+
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "ivf_pq_search.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::util;
+
+// Program Name.
+BINDING_USER_NAME("K-Approximate-Nearest-Neighbor Search with IVF-PQ");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of approximate k-nearest-neighbor search with an "
+    "inverted file index and product quantization (IVF-PQ).  Given a set of "
+    "reference points and a set of query points, this will compute the k "
+    "approximate nearest neighbors of each query point in the reference set, "
+    "storing only compact codes of the reference points; models can be saved "
+    "for future use.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program will build an IVF-PQ index on a set of reference points and "
+    "use it to calculate the k approximate nearest neighbors of a set of query "
+    "points.  The reference points are clustered into " +
+    PRINT_PARAM_STRING("lists") + " coarse clusters with k-means, and the "
+    "difference between each point and its cluster's centroid is split into " +
+    PRINT_PARAM_STRING("subspaces") + " parts, each of which is quantized to "
+    "one of " + PRINT_PARAM_STRING("centroids") + " codewords.  The reference "
+    "set itself is not stored in the model, so the model is much smaller than "
+    "the reference set."
+    "\n\n"
+    "During search, the " + PRINT_PARAM_STRING("probes") + " clusters nearest "
+    "to each query point are scanned; scanning more clusters gives better "
+    "results but takes longer.  If no query set is given, the reference set is "
+    "used as the query set (and each point will usually be returned as its own "
+    "nearest neighbor).");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, the following will build an index with 100 lists on the "
+    "points in " + PRINT_DATASET("input") + ", and return 5 neighbors for each "
+    "point in " + PRINT_DATASET("queries") + ", scanning 10 lists for each "
+    "query, and store the distances in " + PRINT_DATASET("distances") + " and "
+    "the neighbors in " + PRINT_DATASET("neighbors") + ":"
+    "\n\n" +
+    PRINT_CALL("ivf_pq", "reference", "input", "query", "queries", "k", 5,
+        "lists", 100, "probes", 10, "distances", "distances", "neighbors",
+        "neighbors") +
+    "\n\n"
+    "The output is organized such that row i and column j in the neighbors "
+    "output corresponds to the index of the point in the reference set which "
+    "is the j'th nearest neighbor from the point in the query set with index "
+    "i.  Row j and column i in the distances output file corresponds to the "
+    "approximate distance between those two points.");
+
+// See also...
+BINDING_SEE_ALSO("@knn", "#knn");
+BINDING_SEE_ALSO("@lsh", "#lsh");
+BINDING_SEE_ALSO("@krann", "#krann");
+BINDING_SEE_ALSO("Product quantization for nearest neighbor search (pdf)",
+    "https://inria.hal.science/inria-00514462/document");
+BINDING_SEE_ALSO("IVFPQSearch C++ class documentation",
+    "@src/mlpack/methods/ivf_pq/ivf_pq.hpp");
+
+// Define our input parameters that this program will take.
+PARAM_MATRIX_IN("reference", "Matrix containing the reference dataset.", "r");
+PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
+PARAM_MATRIX_OUT("distances", "Matrix to output distances into.", "d");
+PARAM_UMATRIX_OUT("neighbors", "Matrix to output neighbors into.", "n");
+
+// We can load or save models.
+PARAM_MODEL_IN(IVFPQSearch<>, "input_model", "Input IVF-PQ model.", "m");
+PARAM_MODEL_OUT(IVFPQSearch<>, "output_model", "Output for trained IVF-PQ "
+    "model.", "M");
+
+PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
+PARAM_INT_IN("lists", "Number of inverted lists (coarse clusters).", "l", 100);
+PARAM_INT_IN("subspaces", "Number of subspaces each point is split into; the "
+    "dimensionality of the reference set must be divisible by this.", "S", 1);
+PARAM_INT_IN("centroids", "Number of codewords in each subspace (at most "
+    "256).", "C", 256);
+PARAM_INT_IN("probes", "Number of inverted lists to scan for each query.", "p",
+    1);
+PARAM_INT_IN("max_iterations", "Maximum number of iterations of each k-means "
+    "run.", "i", 100);
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  if (params.Get<int>("seed") != 0)
+    RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    RandomSeed((size_t) time(NULL));
+
+  RequireOnlyOnePassed(params, { "input_model", "reference" }, true);
+  RequireAtLeastOnePassed(params, { "neighbors", "distances", "output_model" },
+      false, "no results will be saved");
+
+  if (params.Has("k"))
+  {
+    RequireParamValue<int>(params, "k", [](int x) { return x > 0; }, true,
+        "k must be greater than 0");
+  }
+  RequireParamValue<int>(params, "lists", [](int x) { return x > 0; }, true,
+      "number of lists must be greater than 0");
+  RequireParamValue<int>(params, "subspaces", [](int x) { return x > 0; },
+      true, "number of subspaces must be greater than 0");
+  RequireParamValue<int>(params, "centroids",
+      [](int x) { return x > 0 && x <= 256; }, true,
+      "number of centroids must be between 1 and 256");
+  RequireParamValue<int>(params, "probes", [](int x) { return x > 0; }, true,
+      "number of probes must be greater than 0");
+  RequireParamValue<int>(params, "max_iterations", [](int x) { return x >= 0; },
+      true, "maximum number of iterations must be nonnegative");
+
+  ReportIgnoredParam(params, {{ "k", false }}, "neighbors");
+  ReportIgnoredParam(params, {{ "k", false }}, "distances");
+  ReportIgnoredParam(params, {{ "k", false }}, "probes");
+  ReportIgnoredParam(params, {{ "reference", false }}, "lists");
+  ReportIgnoredParam(params, {{ "reference", false }}, "subspaces");
+  ReportIgnoredParam(params, {{ "reference", false }}, "centroids");
+  ReportIgnoredParam(params, {{ "reference", false }}, "max_iterations");
+
+  if (params.Has("input_model") && params.Has("k") && !params.Has("query"))
+  {
+    Log::Fatal << "The reference set is not stored in an IVF-PQ model, so "
+        << PRINT_PARAM_STRING("query") << " must be passed when "
+        << PRINT_PARAM_STRING("input_model") << " is used!" << endl;
+  }
+
+  if (params.Has("input_model") && !params.Has("k"))
+  {
+    Log::Warn << PRINT_PARAM_STRING("k") << " not passed; no search will be "
+        << "performed!" << std::endl;
+  }
+
+  // This declaration is here so that the matrix doesn't go out of scope.
+  arma::mat referenceData;
+
+  IVFPQSearch<>* ivfpq;
+  if (params.Has("reference"))
+  {
+    ivfpq = new IVFPQSearch<>();
+    Log::Info << "Using reference data from "
+        << params.GetPrintable<arma::mat>("reference") << "." << endl;
+    referenceData = std::move(params.Get<arma::mat>("reference"));
+
+    timers.Start("index_building");
+    try
+    {
+      ivfpq->Train(referenceData, (size_t) params.Get<int>("lists"),
+          (size_t) params.Get<int>("subspaces"),
+          (size_t) params.Get<int>("centroids"),
+          (size_t) params.Get<int>("max_iterations"));
+    }
+    catch (std::invalid_argument& e)
+    {
+      delete ivfpq;
+      Log::Fatal << e.what() << endl;
+    }
+    timers.Stop("index_building");
+  }
+  else // We must have an input model.
+  {
+    ivfpq = params.Get<IVFPQSearch<>*>("input_model");
+  }
+
+  if (params.Has("k"))
+  {
+    const size_t k = (size_t) params.Get<int>("k");
+    const size_t probes = (size_t) params.Get<int>("probes");
+    Log::Info << "Computing " << k << " approximate nearest neighbors, scanning "
+        << probes << " lists for each query." << endl;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    timers.Start("computing_neighbors");
+    if (params.Has("query"))
+    {
+      Log::Info << "Loaded query data from "
+          << params.GetPrintable<arma::mat>("query") << "." << endl;
+      ivfpq->Search(params.Get<arma::mat>("query"), k, neighbors, distances,
+          probes);
+    }
+    else
+    {
+      ivfpq->Search(referenceData, k, neighbors, distances, probes);
+    }
+    timers.Stop("computing_neighbors");
+
+    Log::Info << "Neighbors computed." << endl;
+    params.Get<arma::mat>("distances") = std::move(distances);
+    params.Get<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+  }
+
+  params.Get<IVFPQSearch<>*>("output_model") = ivfpq;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search.hpp
+ *
+ * Defines the IVFPQSearch class, which performs approximate nearest neighbor
+ * search with an inverted file index and product quantization (IVF-PQ).  Only
+ * compact codes of the reference points are stored, not the points
+ * themselves, so very large reference sets can be searched.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{jegou2011product,
+ *   title={Product quantization for nearest neighbor search},
+ *   author={J{\'e}gou, H. and Douze, M. and Schmid, C.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={33},
+ *   number={1},
+ *   pages={117--128},
+ *   year={2011},
+ *   publisher={IEEE}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+
+namespace mlpack {
+
+/**
+ * The IVFPQSearch class builds an IVF-PQ index on a reference set and uses it
+ * to compute approximate nearest neighbors of query points, with the Euclidean
+ * distance.
+ *
+ * During training, the reference set is clustered into numLists coarse
+ * clusters with k-means; every reference point is assigned to the inverted list
+ * of its nearest coarse centroid.  The residual of each point (its difference
+ * from its coarse centroid) is split into numSubspaces subvectors of equal
+ * dimension, and each subvector is quantized to the nearest of numCentroids
+ * codewords, which are also trained with k-means on each subspace.  So each
+ * reference point is stored as numSubspaces one-byte codes.
+ *
+ * During search, the numProbes lists whose coarse centroids are nearest to the
+ * query are scanned.  For each list, a table of the squared distances between
+ * each subvector of the query's residual and every codeword of that subspace
+ * is computed once; then the approximate distance to each point of the list is
+ * the sum of numSubspaces table lookups (asymmetric distance computation).  The
+ * codes of each subspace are stored contiguously for all points of a list, so
+ * that the lookups for a block of points can be vectorized by the compiler.
+ *
+ * @code
+ * // Index a dataset with 1024 lists and 8-byte codes, then find the 10
+ * // approximate nearest neighbors of each query, scanning 16 lists per query.
+ * IVFPQSearch<> ivfpq(dataset, 1024, 8);
+ * ivfpq.Search(queries, 10, neighbors, distances, 16);
+ * @endcode
+ *
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename MatType = arma::mat>
+class IVFPQSearch
+{
+ public:
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create an untrained IVF-PQ index.  Be sure to call Train() before calling
+   * Search(); otherwise, an exception will be thrown when Search() is called.
+   */
+  IVFPQSearch();
+
+  /**
+   * Build the IVF-PQ index on the given reference set.  The reference set is
+   * not kept.  See Train() for details.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of coarse clusters (inverted lists).
+   * @param numSubspaces Number of subvectors each residual is split into; the
+   *     dimensionality of the reference set must be divisible by this.
+   * @param numCentroids Number of codewords in each subspace (at most 256).
+   * @param maxIterations Maximum number of iterations of each k-means run.
+   */
+  IVFPQSearch(const MatType& referenceSet,
+              const size_t numLists,
+              const size_t numSubspaces,
+              const size_t numCentroids = 256,
+              const size_t maxIterations = 100);
+
+  /**
+   * Build the IVF-PQ index on the given reference set, replacing any existing
+   * index.  The coarse centroids and the codewords of each subspace are
+   * trained with KMeans.  The reference set is not kept.  A
+   * std::invalid_argument is thrown if the parameters do not fit the reference
+   * set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of coarse clusters (inverted lists).
+   * @param numSubspaces Number of subvectors each residual is split into; the
+   *     dimensionality of the reference set must be divisible by this.
+   * @param numCentroids Number of codewords in each subspace (at most 256).
+   * @param maxIterations Maximum number of iterations of each k-means run.
+   */
+  void Train(const MatType& referenceSet,
+             const size_t numLists,
+             const size_t numSubspaces,
+             const size_t numCentroids = 256,
+             const size_t maxIterations = 100);
+
+  /**
+   * Compute the approximate nearest neighbors of the points in the given query
+   * set and store the output in the given matrices.  The matrices will be set
+   * to the size of n columns by k rows, where n is the number of points in the
+   * query set.  If fewer than k points are found in the scanned lists, the
+   * remaining neighbors are set to NumReferencePoints() and the remaining
+   * distances to DBL_MAX.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing the approximate distances of the neighbors
+   *     of each query point.
+   * @param numProbes Number of inverted lists to scan for each query.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              const size_t numProbes = 1) const;
+
+  /**
+   * Serialize the IVF-PQ index.
+   *
+   * @param ar Archive to serialize to.
+   * @param version Serialization version of the class.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Get the dimensionality of the indexed points.
+  size_t Dimensionality() const { return coarseCentroids.n_rows; }
+  //! Get the number of indexed points.
+  size_t NumReferencePoints() const { return listIndices.n_elem; }
+  //! Get the number of inverted lists.
+  size_t NumLists() const { return coarseCentroids.n_cols; }
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return codebooks.n_slices; }
+  //! Get the number of codewords in each subspace.
+  size_t NumCentroids() const { return codebooks.n_cols; }
+
+  //! Get the coarse centroids (one per column).
+  const arma::Mat<ElemType>& CoarseCentroids() const { return coarseCentroids; }
+  //! Get the codebooks; slice i holds the codewords of subspace i, one per
+  //! column.
+  const arma::Cube<ElemType>& Codebooks() const { return codebooks; }
+  //! Get the offsets of each inverted list in ListIndices() and Codes(); the
+  //! points of list i are from ListOffsets()[i] up to (but not including)
+  //! ListOffsets()[i + 1].
+  const arma::Col<size_t>& ListOffsets() const { return listOffsets; }
+  //! Get the original index of each point, in the order of the lists.
+  const arma::Col<uint32_t>& ListIndices() const { return listIndices; }
+  //! Get the codes of each point; row j holds the codes of the j'th point in
+  //! the order of the lists, and column i holds the codes of subspace i.
+  const arma::Mat<unsigned char>& Codes() const { return codes; }
+
+ private:
+  //! The number of points whose distances are computed together while
+  //! scanning a list.
+  static constexpr size_t BlockSize = 256;
+
+  //! Coarse centroids of the inverted lists, one per column.
+  arma::Mat<ElemType> coarseCentroids;
+
+  //! Codewords of each subspace; slice i holds the codewords of subspace i.
+  arma::Cube<ElemType> codebooks;
+
+  //! Start of each inverted list in listIndices and codes, followed by the
+  //! number of points.
+  arma::Col<size_t> listOffsets;
+
+  //! Original index of each point, in the order of the lists.
+  arma::Col<uint32_t> listIndices;
+
+  //! Codes of each point, in the order of the lists; column i holds the codes
+  //! of subspace i for every point, so a list's codes of one subspace are
+  //! contiguous.
+  arma::Mat<unsigned char> codes;
+
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Compare two candidates based on the distance.
+  struct CandidateCmp {
+    bool operator()(const Candidate& c1, const Candidate& c2)
+    {
+      return c1.first < c2.first;
+    };
+  };
+
+  //! Use a priority queue to represent the list of candidate neighbors.
+  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+      CandidateList;
+}; // class IVFPQSearch
+
+} // namespace mlpack
+
+// Include implementation.
+#include "ivf_pq_search_impl.hpp"
+
+#endif
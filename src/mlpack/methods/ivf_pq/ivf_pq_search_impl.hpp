@@ -0,0 +1,251 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search_impl.hpp
+ *
+ * Implementation of the IVFPQSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ivf_pq_search.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch()
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const MatType& referenceSet,
+                                  const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t numCentroids,
+                                  const size_t maxIterations)
+{
+  Train(referenceSet, numLists, numSubspaces, numCentroids, maxIterations);
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Train(const MatType& referenceSet,
+                                 const size_t numLists,
+                                 const size_t numSubspaces,
+                                 const size_t numCentroids,
+                                 const size_t maxIterations)
+{
+  if (numLists == 0 || numLists > referenceSet.n_cols)
+  {
+    throw std::invalid_argument("IVFPQSearch::Train(): number of lists ("
+        + std::to_string(numLists) + ") must be between 1 and the number of "
+        "reference points (" + std::to_string(referenceSet.n_cols) + ")!");
+  }
+
+  if (numSubspaces == 0 || referenceSet.n_rows % numSubspaces != 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Train(): the dimensionality of "
+        "the reference set (" + std::to_string(referenceSet.n_rows) + ") must "
+        "be divisible by the number of subspaces (" +
+        std::to_string(numSubspaces) + ")!");
+  }
+
+  if (numCentroids == 0 || numCentroids > 256 ||
+      numCentroids > referenceSet.n_cols)
+  {
+    throw std::invalid_argument("IVFPQSearch::Train(): number of centroids ("
+        + std::to_string(numCentroids) + ") must be between 1 and 256, and "
+        "must not be greater than the number of reference points!");
+  }
+
+  if (referenceSet.n_cols > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("IVFPQSearch::Train(): reference set has "
+        + std::to_string(referenceSet.n_cols) + " points, but at most "
+        + std::to_string(std::numeric_limits<uint32_t>::max()) + " points are "
+        "supported!");
+  }
+
+  typedef KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      NaiveKMeans, MatType> KMeansType;
+  KMeansType kmeans(maxIterations);
+
+  // Step I: find the coarse centroids, and assign each point to the list of
+  // its nearest centroid.
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans.Cluster(referenceSet, numLists, assignments, centroids);
+  coarseCentroids = ConvTo<arma::Mat<ElemType>>::From(centroids);
+
+  // Lay out the lists one after the other; the points of each list keep their
+  // order.
+  listOffsets.zeros(numLists + 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    listOffsets[assignments[i] + 1]++;
+  listOffsets = arma::cumsum(listOffsets);
+
+  arma::Col<size_t> positions(referenceSet.n_cols);
+  arma::Col<size_t> listEnd = listOffsets.head(numLists);
+  listIndices.set_size(referenceSet.n_cols);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+  {
+    positions[i] = listEnd[assignments[i]]++;
+    listIndices[positions[i]] = (uint32_t) i;
+  }
+
+  // Step II: quantize the residuals of each subspace separately.
+  const MatType residuals = referenceSet - coarseCentroids.cols(assignments);
+  const size_t subspaceDim = referenceSet.n_rows / numSubspaces;
+
+  codebooks.set_size(subspaceDim, numCentroids, numSubspaces);
+  codes.set_size(referenceSet.n_cols, numSubspaces);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    arma::Row<size_t> codeAssignments;
+    arma::mat codewords;
+    kmeans.Cluster(residuals.rows(s * subspaceDim, (s + 1) * subspaceDim - 1),
+        numCentroids, codeAssignments, codewords);
+    codebooks.slice(s) = ConvTo<arma::Mat<ElemType>>::From(codewords);
+
+    for (size_t i = 0; i < codeAssignments.n_elem; ++i)
+      codes(positions[i], s) = (unsigned char) codeAssignments[i];
+  }
+
+  Log::Info << "Built IVF-PQ index with " << numLists << " lists (at most "
+      << arma::max(arma::diff(listOffsets)) << " points per list) and "
+      << numSubspaces << " codes of " << numCentroids << " codewords per "
+      << "point." << std::endl;
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::mat& distances,
+                                  const size_t numProbes) const
+{
+  if (NumLists() == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the index has not "
+        "been trained!");
+  }
+
+  util::CheckSameDimensionality(querySet, coarseCentroids,
+      "IVFPQSearch::Search()", "query set");
+
+  if (k > NumReferencePoints())
+  {
+    std::ostringstream oss;
+    oss << "IVFPQSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but the index has " << NumReferencePoints()
+        << " points!" << std::endl;
+    throw std::invalid_argument(oss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  if (k == 0)
+    return;
+
+  const size_t probes = std::min(std::max(numProbes, (size_t) 1), NumLists());
+  const size_t subspaceDim = codebooks.n_rows;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t q = 0; q < (size_t) querySet.n_cols; ++q)
+  {
+    const arma::Col<ElemType> query(querySet.col(q));
+
+    // Find the lists to scan.
+    arma::Col<ElemType> coarseDistances(NumLists());
+    for (size_t l = 0; l < NumLists(); ++l)
+    {
+      coarseDistances[l] = SquaredEuclideanDistance::Evaluate(query,
+          coarseCentroids.col(l));
+    }
+    const arma::uvec order = arma::sort_index(coarseDistances);
+
+    const Candidate def = std::make_pair(DBL_MAX, NumReferencePoints());
+    std::vector<Candidate> vect(k, def);
+    CandidateList pqueue(CandidateCmp(), std::move(vect));
+
+    arma::Mat<ElemType> table(NumCentroids(), NumSubspaces());
+    ElemType blockDistances[BlockSize];
+    for (size_t p = 0; p < probes; ++p)
+    {
+      const size_t list = order[p];
+      const size_t begin = listOffsets[list];
+      const size_t end = listOffsets[list + 1];
+      if (begin == end)
+        continue;
+
+      // Compute the distance table between the residual of the query and the
+      // codewords of each subspace.
+      const arma::Col<ElemType> residual = query - coarseCentroids.col(list);
+      for (size_t s = 0; s < NumSubspaces(); ++s)
+      {
+        table.col(s) = arma::sum(arma::square(codebooks.slice(s).each_col() -
+            residual.subvec(s * subspaceDim, (s + 1) * subspaceDim - 1)),
+            0).t();
+      }
+
+      // Now scan the list, one block of points at a time.  The inner loop for
+      // each subspace only reads contiguous codes and one table column.
+      for (size_t block = begin; block < end; block += BlockSize)
+      {
+        const size_t blockCount = std::min(BlockSize, end - block);
+        std::fill(blockDistances, blockDistances + blockCount, ElemType(0));
+        for (size_t s = 0; s < NumSubspaces(); ++s)
+        {
+          const ElemType* t = table.colptr(s);
+          const unsigned char* c = codes.colptr(s) + block;
+          for (size_t b = 0; b < blockCount; ++b)
+            blockDistances[b] += t[c[b]];
+        }
+
+        for (size_t b = 0; b < blockCount; ++b)
+        {
+          const Candidate c = std::make_pair((double) blockDistances[b],
+              (size_t) listIndices[block + b]);
+          if (CandidateCmp()(c, pqueue.top()))
+          {
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+      }
+    }
+
+    for (size_t j = 1; j <= k; ++j)
+    {
+      neighbors(k - j, q) = pqueue.top().second;
+      distances(k - j, q) = (pqueue.top().first == DBL_MAX) ? DBL_MAX :
+          std::sqrt(pqueue.top().first);
+      pqueue.pop();
+    }
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void IVFPQSearch<MatType>::serialize(Archive& ar,
+                                     const uint32_t /* version */)
+{
+  // Delete existing codebooks, if necessary.
+  if (cereal::is_loading<Archive>())
+    codebooks.reset();
+
+  ar(CEREAL_NVP(coarseCentroids));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(listOffsets));
+  ar(CEREAL_NVP(listIndices));
+  ar(CEREAL_NVP(codes));
+}
+
+} // namespace mlpack
+
+#endif
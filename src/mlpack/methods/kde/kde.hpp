@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KDE_KDE_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 
 #include "kde_stat.hpp"
 
@@ -62,12 +63,24 @@ struct KDEDefaultParams
  * This implementation performs this estimation using a tree-independent
  * dual-tree algorithm. Details about this algorithm are available in KDERules.
  *
+ * Each Evaluate() method can also return a bound on the error of each
+ * estimation.  If Monte Carlo estimations are used, the bound only holds with
+ * the probability given by MCProb().  When TimeBudget() is set, the traversal
+ * stops refining the estimations once that many seconds have passed, and
+ * approximates whatever is left; the returned error bounds then show how
+ * accurate each estimation is.
+ *
+ * If the dual-tree traversal type is a ParallelDualTreeTraverser (see
+ * ParallelKDE), dual-tree evaluations are performed in parallel with OpenMP.
+ *
  * @tparam KernelType Kernel function to use for KDE calculations.
  * @tparam DistanceType Metric to use for KDE calculations.
  * @tparam MatType Type of data to use.
  * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
  * @tparam DualTreeTraversalType Type of dual-tree traversal to use.
  * @tparam SingleTreeTraversalType Type of single-tree traversal to use.
+ * @tparam CountersType The policy that collects traversal statistics during
+ *     evaluations (see TraversalCounters); by default, nothing is collected.
  */
 template<typename KernelType = GaussianKernel,
          typename DistanceType = EuclideanDistance,
@@ -80,7 +93,8 @@ template<typename KernelType = GaussianKernel,
               DualTreeTraverser,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<DistanceType, KDEStat, MatType>::template
-             SingleTreeTraverser>
+             SingleTreeTraverser,
+         typename CountersType = NullTraversalCounters>
 class KDE
 {
  public:
@@ -190,6 +204,24 @@ class KDE
    */
   void Evaluate(MatType querySet, arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query set given the data of the
+   * reference set, and compute a bound on the (normalized in the same way)
+   * absolute error of each estimation.  The error bound of an estimation is
+   * the sum of the largest possible errors of every approximation used for it;
+   * if Monte Carlo estimations are used, it only holds with the probability
+   * given by MCProb().
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   * @param errorBounds Object which will hold the error bound of each
+   *     estimation.
+   */
+  void Evaluate(MatType querySet,
+                arma::vec& estimations,
+                arma::vec& errorBounds);
+
   /**
    * Estimate density of each point in the query set given the data of an
    * already created query tree. The result is stored in an estimations vector.
@@ -209,6 +241,22 @@ class KDE
                 const std::vector<size_t>& oldFromNewQueries,
                 arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query tree, and compute a bound on
+   * the error of each estimation (see the overload taking a query set).
+   *
+   * @pre The model has to be previously trained and mode has to be dual-tree.
+   * @param queryTree Tree of query points to get the density of.
+   * @param oldFromNewQueries Mappings of query points to the tree dataset.
+   * @param estimations Object which will hold the density of each query point.
+   * @param errorBounds Object which will hold the error bound of each
+   *     estimation.
+   */
+  void Evaluate(Tree* queryTree,
+                const std::vector<size_t>& oldFromNewQueries,
+                arma::vec& estimations,
+                arma::vec& errorBounds);
+
   /**
    * Estimate density of each point in the reference set given the data of the
    * reference set. It does not compute the estimation of a point with itself.
@@ -221,6 +269,48 @@ class KDE
    */
   void Evaluate(arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the reference set, and compute a bound
+   * on the error of each estimation (see the overload taking a query set).
+   *
+   * @pre The model has to be previously trained.
+   * @param estimations Object which will hold the density of each reference
+   *                    point.
+   * @param errorBounds Object which will hold the error bound of each
+   *     estimation.
+   */
+  void Evaluate(arma::vec& estimations, arma::vec& errorBounds);
+
+  /**
+   * Compute an interpolated grid of the density estimations, so that density
+   * queries can be answered by a lookup instead of a tree traversal.  The grid
+   * covers the bounding box of the reference set, enlarged by padding in each
+   * direction; its density is 0 outside of it.  The grid starts with
+   * initialCells cells per dimension, and the number of cells per dimension
+   * is doubled until the largest difference between the grid and Evaluate()
+   * at the centers of the cells is at most tolerance times the largest
+   * estimation on the grid, or until the grid would have more than maxNodes
+   * nodes.  The largest measured difference is stored in grid.MaxError(); it
+   * does not include the error of the estimations themselves.  The grid is
+   * normalized in the same way as the estimations of Evaluate().
+   *
+   * This is only practical in low dimensions (say, up to 4).
+   *
+   * @pre The model has to be previously trained.
+   * @param grid Grid to store the estimations in.
+   * @param tolerance Largest difference allowed at the cell centers, relative
+   *     to the largest estimation.
+   * @param padding Distance by which the grid extends beyond the bounding box
+   *     of the reference set in each direction.
+   * @param initialCells Number of cells per dimension of the first grid.
+   * @param maxNodes Maximum number of nodes of the grid.
+   */
+  void ComputeGrid(DensityGrid& grid,
+                   const double tolerance = 0.01,
+                   const double padding = 0.0,
+                   const size_t initialCells = 8,
+                   const size_t maxNodes = 1000000);
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
 
@@ -297,6 +387,16 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  //! Get the time budget of each evaluation in seconds (0 means no limit).
+  double TimeBudget() const { return timeBudget; }
+
+  //! Modify the time budget of each evaluation in seconds (0 means no limit).
+  //! (0 <= newBudget).  This is not serialized.
+  void TimeBudget(const double newBudget);
+
+  //! Get the traversal statistics of the last evaluation.
+  const CountersType& Counters() const { return counters; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -348,6 +448,17 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! Time in seconds after which every evaluation stops refining its
+  //! estimations; 0 means there is no limit.
+  double timeBudget;
+
+  //! The traversal statistics of the last evaluation.
+  CountersType counters;
+
+  //! Compute the Monte Carlo alpha of every node of the given tree, so that
+  //! the rules never need to modify the reference tree during the traversal.
+  void PrepareMCAlpha(Tree& node) const;
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
@@ -356,6 +467,27 @@ class KDE
                                    arma::vec& estimations);
 };
 
+/**
+ * ParallelKDE performs kernel density estimation with a task-parallel dual-tree
+ * traversal (with OpenMP).  Single-tree evaluations are not parallelized.
+ *
+ * @tparam KernelType Kernel function to use for KDE calculations.
+ * @tparam TreeType The tree type to use; must provide a
+ *     ParallelDualTreeTraverser (i.e. any BinarySpaceTree variant, or any
+ *     CoverTree variant).
+ */
+template<typename KernelType = GaussianKernel,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+using ParallelKDE = KDE<
+    KernelType,
+    EuclideanDistance,
+    arma::mat,
+    TreeType,
+    TreeType<EuclideanDistance, KDEStat, arma::mat>::template
+        ParallelDualTreeTraverser>;
+
 } // namespace mlpack
 
 // Include implementation.
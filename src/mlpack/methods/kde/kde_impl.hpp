@@ -22,13 +22,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 KDE(const double relError,
     const double absError,
     KernelType kernel,
@@ -49,7 +51,8 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    timeBudget(0.0)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -64,13 +67,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 KDE(const KDE& other) :
     kernel(KernelType(other.kernel)),
     distance(DistanceType(other.distance)),
@@ -83,7 +88,8 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    timeBudget(other.timeBudget)
 {
   if (trained)
   {
@@ -108,13 +114,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 KDE(KDE&& other) :
     kernel(std::move(other.kernel)),
     distance(std::move(other.distance)),
@@ -129,7 +137,8 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    timeBudget(other.timeBudget)
 {
   other.kernel = std::move(KernelType());
   other.distance = std::move(DistanceType());
@@ -145,6 +154,7 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.timeBudget = 0.0;
 }
 
 template<typename KernelType,
@@ -154,19 +164,22 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>&
+    SingleTreeTraversalType,
+    CountersType>&
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 operator=(const KDE& other)
 {
   if (this != &other)
@@ -189,6 +202,7 @@ operator=(const KDE& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    timeBudget = other.timeBudget;
     if (trained)
     {
       if (ownsReferenceTree)
@@ -214,19 +228,22 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>&
+    SingleTreeTraversalType,
+    CountersType>&
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 operator=(KDE&& other)
 {
   if (this != &other)
@@ -253,6 +270,7 @@ operator=(KDE&& other)
     this->initialSampleSize = other.initialSampleSize;
     this->mcEntryCoef = other.mcEntryCoef;
     this->mcBreakCoef = other.mcBreakCoef;
+    this->timeBudget = other.timeBudget;
   }
   return *this;
 }
@@ -264,13 +282,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 KDE<KernelType,
     DistanceType,
     MatType,
     TreeType,
     DualTreeTraversalType,
-    SingleTreeTraversalType>::
+    SingleTreeTraversalType,
+    CountersType>::
 ~KDE()
 {
   if (ownsReferenceTree)
@@ -287,13 +307,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 Train(MatType referenceSet)
 {
   // Check if referenceSet is not an empty set.
@@ -323,13 +345,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 Train(Tree* referenceTree, std::vector<size_t>* oldFromNewReferences)
 {
   // Check if referenceTree dataset is not an empty set.
@@ -358,14 +382,38 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 Evaluate(MatType querySet, arma::vec& estimations)
+{
+  arma::vec errorBounds;
+  Evaluate(std::move(querySet), estimations, errorBounds);
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
+Evaluate(MatType querySet, arma::vec& estimations, arma::vec& errorBounds)
 {
   if (mode == KDE_DUAL_TREE_MODE)
   {
@@ -373,7 +421,7 @@ Evaluate(MatType querySet, arma::vec& estimations)
     Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
     try
     {
-      this->Evaluate(queryTree, oldFromNewQueries, estimations);
+      this->Evaluate(queryTree, oldFromNewQueries, estimations, errorBounds);
     }
     catch (std::exception& e)
     {
@@ -389,6 +437,7 @@ Evaluate(MatType querySet, arma::vec& estimations)
     estimations.clear();
     estimations.set_size(querySet.n_cols);
     estimations.fill(arma::fill::zeros);
+    errorBounds.zeros(querySet.n_cols);
 
     // Check whether has already been trained.
     if (!trained)
@@ -413,10 +462,14 @@ Evaluate(MatType querySet, arma::vec& estimations)
     }
 
     // Evaluate.
-    typedef KDERules<DistanceType, KernelType, Tree> RuleType;
+    if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
+      PrepareMCAlpha(*referenceTree);
+
+    typedef KDERules<DistanceType, KernelType, Tree, CountersType> RuleType;
     RuleType rules = RuleType(referenceTree->Dataset(),
                               querySet,
                               estimations,
+                              errorBounds,
                               relError,
                               absError,
                               mcProb,
@@ -426,7 +479,8 @@ Evaluate(MatType querySet, arma::vec& estimations)
                               distance,
                               kernel,
                               monteCarlo,
-                              false);
+                              false,
+                              timeBudget);
 
     // Create traverser.
     SingleTreeTraversalType<RuleType> traverser(rules);
@@ -436,7 +490,9 @@ Evaluate(MatType querySet, arma::vec& estimations)
       traverser.Traverse(i, *referenceTree);
 
     estimations /= referenceTree->Dataset().n_cols;
+    errorBounds /= referenceTree->Dataset().n_cols;
 
+    counters = rules.Counters();
     Log::Info << rules.Scores() << " node combinations were scored."
               << std::endl;
     Log::Info << rules.BaseCases() << " base cases were calculated."
@@ -451,21 +507,49 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 Evaluate(Tree* queryTree,
          const std::vector<size_t>& oldFromNewQueries,
          arma::vec& estimations)
+{
+  arma::vec errorBounds;
+  Evaluate(queryTree, oldFromNewQueries, estimations, errorBounds);
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
+Evaluate(Tree* queryTree,
+         const std::vector<size_t>& oldFromNewQueries,
+         arma::vec& estimations,
+         arma::vec& errorBounds)
 {
   // Get estimations vector ready.
   estimations.clear();
   estimations.set_size(queryTree->Dataset().n_cols);
   estimations.fill(arma::fill::zeros);
+  errorBounds.zeros(queryTree->Dataset().n_cols);
 
   // Check whether has already been trained.
   if (!trained)
@@ -503,13 +587,15 @@ Evaluate(Tree* queryTree,
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
     cleanTraverser.Traverse(0, *queryTree);
+    PrepareMCAlpha(*referenceTree);
   }
 
   // Evaluate.
-  typedef KDERules<DistanceType, KernelType, Tree> RuleType;
+  typedef KDERules<DistanceType, KernelType, Tree, CountersType> RuleType;
   RuleType rules = RuleType(referenceTree->Dataset(),
                             queryTree->Dataset(),
                             estimations,
+                            errorBounds,
                             relError,
                             absError,
                             mcProb,
@@ -519,16 +605,20 @@ Evaluate(Tree* queryTree,
                             distance,
                             kernel,
                             monteCarlo,
-                            false);
+                            false,
+                            timeBudget);
 
   // Create traverser.
   DualTreeTraversalType<RuleType> traverser(rules);
   traverser.Traverse(*queryTree, *referenceTree);
   estimations /= referenceTree->Dataset().n_cols;
+  errorBounds /= referenceTree->Dataset().n_cols;
 
   // Rearrange if necessary.
   RearrangeEstimations(oldFromNewQueries, estimations);
+  RearrangeEstimations(oldFromNewQueries, errorBounds);
 
+  counters = rules.Counters();
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
@@ -540,14 +630,38 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 Evaluate(arma::vec& estimations)
+{
+  arma::vec errorBounds;
+  Evaluate(estimations, errorBounds);
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
+Evaluate(arma::vec& estimations, arma::vec& errorBounds)
 {
   // Check whether has already been trained.
   if (!trained)
@@ -560,6 +674,7 @@ Evaluate(arma::vec& estimations)
   estimations.clear();
   estimations.set_size(referenceTree->Dataset().n_cols);
   estimations.fill(arma::fill::zeros);
+  errorBounds.zeros(referenceTree->Dataset().n_cols);
 
   // Clean accumulated alpha if Monte Carlo estimations are available.
   if (monteCarlo && std::is_same<KernelType, GaussianKernel>::value)
@@ -567,13 +682,15 @@ Evaluate(arma::vec& estimations)
     KDECleanRules<Tree> cleanRules;
     SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
     cleanTraverser.Traverse(0, *referenceTree);
+    PrepareMCAlpha(*referenceTree);
   }
 
   // Evaluate.
-  typedef KDERules<DistanceType, KernelType, Tree> RuleType;
+  typedef KDERules<DistanceType, KernelType, Tree, CountersType> RuleType;
   RuleType rules = RuleType(referenceTree->Dataset(),
                             referenceTree->Dataset(),
                             estimations,
+                            errorBounds,
                             relError,
                             absError,
                             mcProb,
@@ -583,7 +700,8 @@ Evaluate(arma::vec& estimations)
                             distance,
                             kernel,
                             monteCarlo,
-                            true);
+                            true,
+                            timeBudget);
 
   if (mode == KDE_DUAL_TREE_MODE)
   {
@@ -599,9 +717,12 @@ Evaluate(arma::vec& estimations)
   }
 
   estimations /= referenceTree->Dataset().n_cols;
+  errorBounds /= referenceTree->Dataset().n_cols;
   // Rearrange if necessary.
   RearrangeEstimations(*oldFromNewReferences, estimations);
+  RearrangeEstimations(*oldFromNewReferences, errorBounds);
 
+  counters = rules.Counters();
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
@@ -613,13 +734,114 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
+ComputeGrid(DensityGrid& grid,
+            const double tolerance,
+            const double padding,
+            const size_t initialCells,
+            const size_t maxNodes)
+{
+  if (!trained)
+  {
+    throw std::runtime_error("cannot compute KDE grid: model needs to be "
+                             "trained before evaluation");
+  }
+
+  if (tolerance < 0.0 || padding < 0.0 || initialCells == 0)
+  {
+    throw std::invalid_argument("cannot compute KDE grid: tolerance and "
+        "padding must be non-negative, and initialCells must be positive");
+  }
+
+  const MatType& referenceSet = referenceTree->Dataset();
+  const arma::vec lo = ConvTo<arma::vec>::From(arma::min(referenceSet, 1)) -
+      padding;
+  const arma::vec hi = ConvTo<arma::vec>::From(arma::max(referenceSet, 1)) +
+      padding;
+  if (arma::any(hi <= lo))
+  {
+    throw std::invalid_argument("cannot compute KDE grid: the bounding box of "
+        "the reference set has zero width in some dimension; use a positive "
+        "padding");
+  }
+
+  bool first = true;
+  for (size_t cells = initialCells; ; cells *= 2)
+  {
+    // Stop refining once the next grid would be too large (or the number of
+    // nodes would overflow).
+    size_t numNodes = 1;
+    bool tooLarge = false;
+    for (size_t d = 0; d < lo.n_elem && !tooLarge; ++d)
+    {
+      tooLarge = (numNodes > maxNodes / (cells + 1));
+      numNodes *= (cells + 1);
+    }
+
+    if (tooLarge)
+    {
+      if (first)
+      {
+        std::ostringstream oss;
+        oss << "cannot compute KDE grid: a grid with " << cells << " cells "
+            << "per dimension would have more than " << maxNodes << " nodes";
+        throw std::invalid_argument(oss.str());
+      }
+
+      Log::Warn << "KDE::ComputeGrid(): the grid has reached the maximum "
+          << "number of nodes; its measured error is " << grid.MaxError()
+          << "." << std::endl;
+      return;
+    }
+
+    std::vector<arma::vec> coordinates(lo.n_elem);
+    for (size_t d = 0; d < lo.n_elem; ++d)
+      coordinates[d] = arma::linspace<arma::vec>(lo[d], hi[d], cells + 1);
+
+    DensityGrid newGrid(std::move(coordinates), true);
+    arma::mat points;
+    newGrid.Nodes(points);
+    Evaluate(ConvTo<MatType>::From(points), newGrid.Values());
+
+    // Measure the error where it is largest for smooth densities: at the
+    // centers of the cells.
+    arma::vec exact, approximate;
+    newGrid.CellCenters(points);
+    Evaluate(ConvTo<MatType>::From(points), exact);
+    newGrid.Evaluate(points, approximate);
+    newGrid.MaxError() = arma::max(arma::abs(exact - approximate));
+
+    grid = std::move(newGrid);
+    first = false;
+    if (grid.MaxError() <= tolerance * arma::max(grid.Values()))
+      return;
+  }
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
 RelativeError(const double newError)
 {
   CheckErrorValues(newError, absError);
@@ -633,13 +855,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 AbsoluteError(const double newError)
 {
   CheckErrorValues(relError, newError);
@@ -653,13 +877,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 MCProb(const double newProb)
 {
   if (newProb < 0 || newProb >= 1)
@@ -678,13 +904,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 MCEntryCoef(const double newCoef)
 {
   if (newCoef < 1)
@@ -702,13 +930,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 MCBreakCoef(const double newCoef)
 {
   if (newCoef <= 0 || newCoef > 1)
@@ -726,14 +956,78 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
+TimeBudget(const double newBudget)
+{
+  if (newBudget < 0)
+  {
+    throw std::invalid_argument("time budget must be a value greater than or "
+                                "equal to 0");
+  }
+  timeBudget = newBudget;
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void KDE<KernelType,
+         DistanceType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType,
+         CountersType>::
+PrepareMCAlpha(Tree& node) const
+{
+  // This is the same computation that KDERules::CalculateAlpha() does when the
+  // Monte Carlo alpha of a node is out of date.
+  KDEStat& stat = node.Stat();
+  if (std::abs(stat.MCBeta() - (1 - mcProb)) > DBL_EPSILON)
+  {
+    if (node.Parent() == NULL)
+      stat.MCAlpha() = 1 - mcProb;
+    else
+      stat.MCAlpha() = node.Parent()->Stat().MCAlpha() /
+          node.Parent()->NumChildren();
+
+    stat.MCBeta() = 1 - mcProb;
+  }
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    PrepareMCAlpha(node.Child(i));
+}
+
+template<typename KernelType,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename Archive>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 serialize(Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences.
@@ -773,13 +1067,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 CheckErrorValues(const double relError, const double absError)
 {
   if (relError < 0 || relError > 1)
@@ -801,13 +1097,15 @@ template<typename KernelType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void KDE<KernelType,
          DistanceType,
          MatType,
          TreeType,
          DualTreeTraversalType,
-         SingleTreeTraversalType>::
+         SingleTreeTraversalType,
+         CountersType>::
 RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                      arma::vec& estimations)
 {
@@ -14,14 +14,37 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
+
+#include <chrono>
 
 namespace mlpack {
 
 /**
  * A dual-tree traversal Rules class for kernel density estimation.  This
  * contains the Score() and BaseCase() implementations.
+ *
+ * Copies of a KDERules object share the density estimations, the error bounds
+ * and the accumulated error tolerances of the query points, but have their own
+ * traversal information and counters, so the rules can be used with a
+ * ParallelDualTreeTraverser.
+ *
+ * For each query point, an upper bound of the error of its estimation is
+ * accumulated in the given errorBounds vector: every prune adds the largest
+ * possible error of the approximation it makes, and every Monte Carlo
+ * estimation adds the half-width of its confidence interval (so the bound only
+ * holds with the probability of the Monte Carlo estimations).  If a time budget
+ * is given and it runs out during the traversal, every node combination that is
+ * scored afterwards is pruned with an approximation, whatever the error
+ * tolerances are; the error bounds still account for these approximations.
+ *
+ * The CountersType policy collects traversal statistics (see
+ * TraversalCounters); by default, nothing is collected.
  */
-template<typename DistanceType, typename KernelType, typename TreeType>
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType = NullTraversalCounters>
 class KDERules
 {
  public:
@@ -31,6 +54,8 @@ class KDERules
    * @param referenceSet Reference set data.
    * @param querySet Query set data.
    * @param densities Vector where estimations will be written.
+   * @param errorBounds Vector where the error bound of each estimation will be
+   *     written.
    * @param relError Relative error tolerance.
    * @param absError Absolute error tolerance.
    * @param mcProb Probability of relative error compliance for Monte Carlo
@@ -44,10 +69,13 @@ class KDERules
    *                   possible.
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
+   * @param timeBudget Time in seconds after which every node combination is
+   *     pruned; 0 means there is no limit.
    */
   KDERules(const arma::mat& referenceSet,
            const arma::mat& querySet,
            arma::vec& densities,
+           arma::vec& errorBounds,
            const double relError,
            const double absError,
            const double mcProb,
@@ -57,7 +85,8 @@ class KDERules
            DistanceType& distance,
            KernelType& kernel,
            const bool monteCarlo,
-           const bool sameSet);
+           const bool sameSet,
+           const double timeBudget = 0.0);
 
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
@@ -88,9 +117,18 @@ class KDERules
 
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
 
   //! Get the number of scores.
   size_t Scores() const { return scores; }
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
+
+  //! Get the traversal counters.
+  const CountersType& Counters() const { return counters; }
+  //! Modify the traversal counters.
+  CountersType& Counters() { return counters; }
 
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
@@ -105,9 +143,20 @@ class KDERules
   double EvaluateKernel(const arma::vec& query,
                         const arma::vec& reference) const;
 
+  //! Compute the distance between the given points, and keep it so that the
+  //! base case of the same points does not compute it again.
+  double CentroidDistance(const size_t queryIndex,
+                          const size_t referenceIndex);
+
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
+  //! Return whether the time budget has run out.
+  bool TimeExpired() const
+  {
+    return hasDeadline && (std::chrono::steady_clock::now() >= deadline);
+  }
+
   //! The reference set.
   const arma::mat& referenceSet;
 
@@ -117,6 +166,9 @@ class KDERules
   //! Density values.
   arma::vec& densities;
 
+  //! Error bounds of the density values.
+  arma::vec& errorBounds;
+
   //! Absolute error tolerance.
   const double absError;
 
@@ -148,11 +200,13 @@ class KDERules
   //! Whether Monte Carlo estimations are going to be applied.
   const bool monteCarlo;
 
-  //! Accumulated not used MC alpha values for each query point.
-  arma::vec accumMCAlpha;
+  //! Accumulated not used MC alpha values for each query point.  This is
+  //! shared between copies of the rules.
+  std::shared_ptr<arma::vec> accumMCAlpha;
 
-  //! Accumulated not used error tolerance for each query point.
-  arma::vec accumError;
+  //! Accumulated not used error tolerance for each query point.  This is
+  //! shared between copies of the rules.
+  std::shared_ptr<arma::vec> accumError;
 
   //! Whether reference and query sets are the same.
   const bool sameSet;
@@ -164,12 +218,27 @@ class KDERules
   //! Absolute error tolerance available for each reference point.
   const double absErrorTol;
 
+  //! Whether there is a time budget.
+  const bool hasDeadline;
+
+  //! The time at which the time budget runs out.
+  const std::chrono::steady_clock::time_point deadline;
+
   //! The last query index.
   size_t lastQueryIndex;
 
   //! The last reference index.
   size_t lastReferenceIndex;
 
+  //! The query index of the last distance computed by Score().
+  size_t scoreQueryIndex;
+
+  //! The reference index of the last distance computed by Score().
+  size_t scoreReferenceIndex;
+
+  //! The last distance computed by Score().
+  double scoreDistance;
+
   //! Traversal information.
   TraversalInfoType traversalInfo;
 
@@ -178,6 +247,9 @@ class KDERules
 
   //! The number of scores.
   size_t scores;
+
+  //! The traversal counters.
+  CountersType counters;
 };
 
 /**
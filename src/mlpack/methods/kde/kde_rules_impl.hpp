@@ -21,11 +21,15 @@
 
 namespace mlpack {
 
-template<typename DistanceType, typename KernelType, typename TreeType>
-KDERules<DistanceType, KernelType, TreeType>::KDERules(
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+KDERules<DistanceType, KernelType, TreeType, CountersType>::KDERules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     arma::vec& densities,
+    arma::vec& errorBounds,
     const double relError,
     const double absError,
     const double mcProb,
@@ -35,10 +39,12 @@ KDERules<DistanceType, KernelType, TreeType>::KDERules(
     DistanceType& distance,
     KernelType& kernel,
     const bool monteCarlo,
-    const bool sameSet) :
+    const bool sameSet,
+    const double timeBudget) :
     referenceSet(referenceSet),
     querySet(querySet),
     densities(densities),
+    errorBounds(errorBounds),
     absError(absError),
     relError(relError),
     mcBeta(1 - mcProb),
@@ -50,23 +56,38 @@ KDERules<DistanceType, KernelType, TreeType>::KDERules(
     monteCarlo(monteCarlo),
     sameSet(sameSet),
     absErrorTol(absError / referenceSet.n_cols),
+    hasDeadline(timeBudget > 0.0),
+    deadline(std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(timeBudget))),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
+    scoreQueryIndex(querySet.n_cols),
+    scoreReferenceIndex(referenceSet.n_cols),
+    scoreDistance(0.0),
     baseCases(0),
     scores(0)
 {
   // Initialize accumError.
-  accumError = arma::vec(querySet.n_cols, arma::fill::zeros);
+  accumError = std::make_shared<arma::vec>(querySet.n_cols, arma::fill::zeros);
 
   // Initialize accumMCAlpha only if Monte Carlo estimations are available.
   if (monteCarlo && kernelIsGaussian)
-    accumMCAlpha = arma::vec(querySet.n_cols, arma::fill::zeros);
+  {
+    accumMCAlpha = std::make_shared<arma::vec>(querySet.n_cols,
+        arma::fill::zeros);
+  }
+
+  counters.AddQueries(querySet.n_cols);
 }
 
 //! The base case.
-template<typename DistanceType, typename KernelType, typename TreeType>
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
 inline mlpack_force_inline
-double KDERules<DistanceType, KernelType, TreeType>::BaseCase(
+double KDERules<DistanceType, KernelType, TreeType, CountersType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -79,14 +100,17 @@ double KDERules<DistanceType, KernelType, TreeType>::BaseCase(
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return 0.0;
 
-  // Calculations.
-  const double d = distance.Evaluate(querySet.col(queryIndex),
-                                     referenceSet.col(referenceIndex));
+  // Calculations.  For trees whose first point is the centroid, Score() may
+  // already have computed the distance.
+  const double d = (queryIndex == scoreQueryIndex &&
+      referenceIndex == scoreReferenceIndex) ? scoreDistance :
+      distance.Evaluate(querySet.col(queryIndex),
+                        referenceSet.col(referenceIndex));
   const double kernelValue = kernel.Evaluate(d);
   densities(queryIndex) += kernelValue;
 
   // Update accumulated relative error tolerance for single-tree pruning.
-  accumError(queryIndex) += 2 * relError * kernelValue;
+  (*accumError)(queryIndex) += 2 * relError * kernelValue;
 
   ++baseCases;
   lastQueryIndex = queryIndex;
@@ -96,8 +120,11 @@ double KDERules<DistanceType, KernelType, TreeType>::BaseCase(
 }
 
 //! Single-tree scoring function.
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline double KDERules<DistanceType, KernelType, TreeType, CountersType>::
 Score(const size_t queryIndex, TreeType& referenceNode)
 {
   // Auxiliary variables.
@@ -128,9 +155,21 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   else
   {
     // All Calculations are new.
-    const Range r = referenceNode.RangeDistance(queryPoint);
-    minDistance = r.Lo();
-    maxDistance = r.Hi();
+    if (TreeTraits<TreeType>::FirstPointIsCentroid)
+    {
+      // Keep the distance to the centroid for the following base case.
+      const double furthestDescDist =
+          referenceNode.FurthestDescendantDistance();
+      const double d = CentroidDistance(queryIndex, referenceNode.Point(0));
+      minDistance = std::max(d - furthestDescDist, 0.0);
+      maxDistance = d + furthestDescDist;
+    }
+    else
+    {
+      const Range r = referenceNode.RangeDistance(queryPoint);
+      minDistance = r.Lo();
+      maxDistance = r.Hi();
+    }
 
     // Check if we are a self-child.
     if (TreeTraits<TreeType>::HasSelfChildren &&
@@ -155,33 +194,40 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   // it here to prune more.
   double pointAccumErrorTol;
   if (alreadyDidRefPoint0)
-    pointAccumErrorTol = accumError(queryIndex) / (refNumDesc - 1);
+    pointAccumErrorTol = (*accumError)(queryIndex) / (refNumDesc - 1);
   else
-    pointAccumErrorTol = accumError(queryIndex) / refNumDesc;
+    pointAccumErrorTol = (*accumError)(queryIndex) / refNumDesc;
+
+  // The number of reference points that the estimation of this combination
+  // accounts for.
+  const size_t numEstimated = alreadyDidRefPoint0 ? refNumDesc - 1 :
+      refNumDesc;
 
   if (bound <= 2 * errorTolerance + pointAccumErrorTol)
   {
     // Estimate kernel value.
     const double kernelValue = (maxKernel + minKernel) / 2.0;
 
-    if (alreadyDidRefPoint0)
-      densities(queryIndex) += (refNumDesc - 1) * kernelValue;
-    else
-      densities(queryIndex) += refNumDesc * kernelValue;
+    densities(queryIndex) += numEstimated * kernelValue;
+    errorBounds(queryIndex) += numEstimated * bound / 2.0;
 
     // Don't explore this tree branch.
     score = DBL_MAX;
 
     // Subtract used error tolerance or add extra available tolerace from this
     // prune.
-    if (alreadyDidRefPoint0)
-      accumError(queryIndex) -= (refNumDesc - 1) * (bound - 2 * errorTolerance);
-    else
-      accumError(queryIndex) -= refNumDesc * (bound - 2 * errorTolerance);
+    (*accumError)(queryIndex) -= numEstimated * (bound - 2 * errorTolerance);
 
     // Store not used alpha for Monte Carlo.
     if (kernelIsGaussian && monteCarlo)
-      accumMCAlpha(queryIndex) += depthAlpha;
+      (*accumMCAlpha)(queryIndex) += depthAlpha;
+  }
+  else if (TimeExpired())
+  {
+    // There is no time left to refine the estimation, so prune anyway.
+    densities(queryIndex) += numEstimated * (maxKernel + minKernel) / 2.0;
+    errorBounds(queryIndex) += numEstimated * bound / 2.0;
+    score = DBL_MAX;
   }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
@@ -189,13 +235,14 @@ Score(const size_t queryIndex, TreeType& referenceNode)
   {
     // Monte Carlo probabilistic estimation.
     // Calculate z using accumulated alpha if possible.
-    const double alpha = depthAlpha + accumMCAlpha(queryIndex);
+    const double alpha = depthAlpha + (*accumMCAlpha)(queryIndex);
     const double z = std::abs(Quantile(alpha / 2.0));
 
     // Auxiliary variables.
     arma::vec sample;
     size_t m = initialSampleSize;
     double meanSample = 0;
+    double stddev = 0;
     bool useMonteCarloPredictions = true;
 
     // Resample as long as confidence is not high enough.
@@ -227,7 +274,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
             EvaluateKernel(queryIndex, referenceNode.Descendant(randomPoint));
       }
       meanSample = arma::mean(sample);
-      const double stddev = arma::stddev(sample);
+      stddev = arma::stddev(sample);
       const double mThreshBase =
           z * stddev * (1 + relError) / (relError * meanSample);
       const size_t mThresh = std::ceil(mThreshBase * mThreshBase);
@@ -241,16 +288,15 @@ Score(const size_t queryIndex, TreeType& referenceNode)
     if (useMonteCarloPredictions)
     {
       // Confidence is high enough so we can use Monte Carlo estimation.
-      if (alreadyDidRefPoint0)
-        densities(queryIndex) += (refNumDesc - 1) * meanSample;
-      else
-        densities(queryIndex) += refNumDesc * meanSample;
+      densities(queryIndex) += numEstimated * meanSample;
+      errorBounds(queryIndex) += numEstimated * z * stddev /
+          std::sqrt((double) sample.n_elem);
 
       // Prune.
       score = DBL_MAX;
 
       // Accumulated alpha has been used.
-      accumMCAlpha(queryIndex) = 0;
+      (*accumMCAlpha)(queryIndex) = 0;
     }
     else
     {
@@ -260,7 +306,7 @@ Score(const size_t queryIndex, TreeType& referenceNode)
       if (referenceNode.IsLeaf())
       {
         // Reclaim not used alpha since the node will be exactly computed.
-        accumMCAlpha(queryIndex) += depthAlpha;
+        (*accumMCAlpha)(queryIndex) += depthAlpha;
       }
     }
   }
@@ -271,27 +317,26 @@ Score(const size_t queryIndex, TreeType& referenceNode)
 
     // Add accumulated unused absolute error tolerance.
     if (referenceNode.IsLeaf())
-    {
-      if (alreadyDidRefPoint0)
-        accumError(queryIndex) += (refNumDesc - 1) * 2 * absErrorTol;
-      else
-        accumError(queryIndex) += refNumDesc * 2 * absErrorTol;
-    }
+      (*accumError)(queryIndex) += numEstimated * 2 * absErrorTol;
 
     // If node is going to be exactly computed, reclaim not used alpha for
     // Monte Carlo estimations.
     if (kernelIsGaussian && monteCarlo && referenceNode.IsLeaf())
-      accumMCAlpha(queryIndex) += depthAlpha;
+      (*accumMCAlpha)(queryIndex) += depthAlpha;
   }
 
   ++scores;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
-  return score;
+  return counters.Score(referenceNode, score);
 }
 
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline mlpack_force_inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
 Rescore(const size_t /* queryIndex */,
         TreeType& /* referenceNode */,
         const double oldScore) const
@@ -301,8 +346,11 @@ Rescore(const size_t /* queryIndex */,
 }
 
 //! Dual-tree scoring function.
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline double KDERules<DistanceType, KernelType, TreeType, CountersType>::
 Score(TreeType& queryNode, TreeType& referenceNode)
 {
   KDEStat& queryStat = queryNode.Stat();
@@ -345,9 +393,22 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   else
   {
     // All calculations are new.
-    const Range r = queryNode.RangeDistance(referenceNode);
-    minDistance = r.Lo();
-    maxDistance = r.Hi();
+    if (TreeTraits<TreeType>::FirstPointIsCentroid)
+    {
+      // Keep the distance between the centroids for the following base case.
+      const double d = CentroidDistance(queryNode.Point(0),
+          referenceNode.Point(0));
+      minDistance = std::max(d - queryNode.FurthestDescendantDistance() -
+          referenceNode.FurthestDescendantDistance(), 0.0);
+      maxDistance = d + queryNode.FurthestDescendantDistance() +
+          referenceNode.FurthestDescendantDistance();
+    }
+    else
+    {
+      const Range r = queryNode.RangeDistance(referenceNode);
+      minDistance = r.Lo();
+      maxDistance = r.Hi();
+    }
   }
 
   const double maxKernel = kernel.Evaluate(minDistance);
@@ -373,10 +434,10 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     // Sum up estimations.
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
     {
-      if (alreadyDidRefPoint0 && i == 0)
-        densities(queryNode.Descendant(i)) += (refNumDesc - 1) * kernelValue;
-      else
-        densities(queryNode.Descendant(i)) += refNumDesc * kernelValue;
+      const size_t numEstimated = (alreadyDidRefPoint0 && i == 0) ?
+          refNumDesc - 1 : refNumDesc;
+      densities(queryNode.Descendant(i)) += numEstimated * kernelValue;
+      errorBounds(queryNode.Descendant(i)) += numEstimated * bound / 2.0;
     }
 
     // Prune.
@@ -390,6 +451,20 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     if (kernelIsGaussian && monteCarlo)
       queryStat.AccumAlpha() += depthAlpha;
   }
+  else if (TimeExpired())
+  {
+    // There is no time left to refine the estimations, so prune anyway.
+    const double kernelValue = (maxKernel + minKernel) / 2.0;
+    for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    {
+      const size_t numEstimated = (alreadyDidRefPoint0 && i == 0) ?
+          refNumDesc - 1 : refNumDesc;
+      densities(queryNode.Descendant(i)) += numEstimated * kernelValue;
+      errorBounds(queryNode.Descendant(i)) += numEstimated * bound / 2.0;
+    }
+
+    score = DBL_MAX;
+  }
   else if (monteCarlo &&
            refNumDesc >= mcAccessCoef * initialSampleSize &&
            kernelIsGaussian)
@@ -402,6 +477,7 @@ Score(TreeType& queryNode, TreeType& referenceNode)
     // Auxiliary variables.
     arma::vec sample;
     arma::vec means = zeros(queryNode.NumDescendants());
+    arma::vec halfWidths = zeros(queryNode.NumDescendants());
     size_t m;
     double meanSample = 0;
     bool useMonteCarloPredictions = true;
@@ -453,11 +529,18 @@ Score(TreeType& queryNode, TreeType& referenceNode)
           m = 0;
       }
 
-      // Store mean for the i_th query node descendant point.
+      // Store mean for the i_th query node descendant point, and the
+      // half-width of its confidence interval.
       if (useMonteCarloPredictions)
+      {
         means(i) = meanSample;
+        halfWidths(i) = z * arma::stddev(sample) /
+            std::sqrt((double) sample.n_elem);
+      }
       else
+      {
         break;
+      }
     }
 
     if (useMonteCarloPredictions)
@@ -465,10 +548,10 @@ Score(TreeType& queryNode, TreeType& referenceNode)
       // Confidence is high enough so we can use Monte Carlo estimation.
       for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       {
-        if (alreadyDidRefPoint0 && i == 0)
-          densities(queryNode.Descendant(i)) += (refNumDesc - 1) * means(i);
-        else
-          densities(queryNode.Descendant(i)) += refNumDesc * means(i);
+        const size_t numEstimated = (alreadyDidRefPoint0 && i == 0) ?
+            refNumDesc - 1 : refNumDesc;
+        densities(queryNode.Descendant(i)) += numEstimated * means(i);
+        errorBounds(queryNode.Descendant(i)) += numEstimated * halfWidths(i);
       }
 
       // Prune.
@@ -509,12 +592,16 @@ Score(TreeType& queryNode, TreeType& referenceNode)
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
   traversalInfo.LastScore() = score;
-  return score;
+  return counters.Score(queryNode, referenceNode, score);
 }
 
 //! Dual-tree rescore.
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline mlpack_force_inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
 Rescore(TreeType& /*queryNode*/,
         TreeType& /*referenceNode*/,
         const double oldScore) const
@@ -523,8 +610,12 @@ Rescore(TreeType& /*queryNode*/,
   return oldScore;
 }
 
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline mlpack_force_inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
 EvaluateKernel(const size_t queryIndex,
                const size_t referenceIndex) const
 {
@@ -532,15 +623,38 @@ EvaluateKernel(const size_t queryIndex,
                         referenceSet.unsafe_col(referenceIndex));
 }
 
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline mlpack_force_inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
 EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
 {
   return kernel.Evaluate(distance.Evaluate(query, reference));
 }
 
-template<typename DistanceType, typename KernelType, typename TreeType>
-inline mlpack_force_inline double KDERules<DistanceType, KernelType, TreeType>::
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
+CentroidDistance(const size_t queryIndex, const size_t referenceIndex)
+{
+  scoreQueryIndex = queryIndex;
+  scoreReferenceIndex = referenceIndex;
+  scoreDistance = distance.Evaluate(querySet.col(queryIndex),
+                                    referenceSet.col(referenceIndex));
+  return scoreDistance;
+}
+
+template<typename DistanceType,
+         typename KernelType,
+         typename TreeType,
+         typename CountersType>
+inline mlpack_force_inline double
+KDERules<DistanceType, KernelType, TreeType, CountersType>::
 CalculateAlpha(TreeType* node)
 {
   KDEStat& stat = node->Stat();
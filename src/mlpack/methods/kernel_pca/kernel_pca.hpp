@@ -107,6 +107,18 @@ class KernelPCA
    */
   void Apply(arma::mat& data, const size_t newDimension);
 
+  /**
+   * Transform new points with the model computed by the last call to Apply(),
+   * without recomputing the kernel matrix.  The kernel is evaluated between
+   * the new points and the points given to Apply() (or the points selected by
+   * the Nystroem method), and the result has the same number of dimensions as
+   * the transformed data given by Apply().
+   *
+   * @param data New points.
+   * @param transformedData Matrix to output results into.
+   */
+  void Transform(const arma::mat& data, arma::mat& transformedData) const;
+
   //! Get the kernel.
   const KernelType& Kernel() const { return kernel; }
   //! Modify the kernel.
@@ -120,9 +132,15 @@ class KernelPCA
  private:
   //! The instantiated kernel.
   KernelType kernel;
+  //! The kernel rule, which holds what is needed to transform new points.
+  KernelRule kernelRule;
   //! If true, the data will be scaled (by standard deviation) when Apply() is
   //! run.
   bool centerTransformedData;
+  //! The mean of the transformed data, if it was centered.
+  arma::vec transformedDataMean;
+  //! The dimension of the transformed data given by the last call to Apply().
+  size_t newDimension;
 }; // class KernelPCA
 
 } // namespace mlpack
@@ -23,7 +23,8 @@ template <typename KernelType, typename KernelRule>
 KernelPCA<KernelType, KernelRule>::KernelPCA(const KernelType kernel,
                                  const bool centerTransformedData) :
       kernel(kernel),
-      centerTransformedData(centerTransformedData)
+      centerTransformedData(centerTransformedData),
+      newDimension(0)
 { }
 
 //! Apply Kernel Principal Component Analysis to the provided data set.
@@ -34,13 +35,14 @@ void KernelPCA<KernelType, KernelRule>::Apply(const arma::mat& data,
                                   arma::mat& eigvec,
                                   const size_t newDimension)
 {
-  KernelRule::ApplyKernelMatrix(data, transformedData, eigval,
-                                eigvec, newDimension, kernel);
+  kernelRule.Apply(data, transformedData, eigval, eigvec, newDimension,
+      kernel);
+  this->newDimension = transformedData.n_rows;
 
   // Center the transformed data, if the user asked for it.
   if (centerTransformedData)
   {
-    arma::colvec transformedDataMean = arma::mean(transformedData, 1);
+    transformedDataMean = arma::mean(transformedData, 1);
     transformedData = transformedData - (transformedDataMean *
         ones<arma::rowvec>(transformedData.n_cols));
   }
@@ -77,7 +79,34 @@ void KernelPCA<KernelType, KernelRule>::Apply(arma::mat& data,
   Apply(data, data, eigVal, coeffs, newDimension);
 
   if (newDimension < coeffs.n_rows && newDimension > 0)
+  {
     data.shed_rows(newDimension, data.n_rows - 1);
+    this->newDimension = newDimension;
+  }
+}
+
+//! Transform new points with the last model computed by Apply().
+template <typename KernelType, typename KernelRule>
+void KernelPCA<KernelType, KernelRule>::Transform(
+    const arma::mat& data,
+    arma::mat& transformedData) const
+{
+  if (newDimension == 0)
+  {
+    throw std::logic_error("KernelPCA::Transform(): Apply() must be called "
+        "first!");
+  }
+
+  kernelRule.Transform(data, transformedData, kernel);
+
+  if (centerTransformedData)
+  {
+    transformedData = transformedData - (transformedDataMean *
+        ones<arma::rowvec>(transformedData.n_cols));
+  }
+
+  if (newDimension < transformedData.n_rows)
+    transformedData.shed_rows(newDimension, transformedData.n_rows - 1);
 }
 
 } // namespace mlpack
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KERNEL_PCA_NAIVE_METHOD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 
 namespace mlpack {
 
@@ -21,6 +22,9 @@ template<typename KernelType>
 class NaiveKernelRule
 {
  public:
+  //! Create the rule; Apply() must be called before Transform().
+  NaiveKernelRule() : kernelMean(0.0) { }
+
   /**
    * Construct the exact kernel matrix.
    *
@@ -28,67 +32,114 @@ class NaiveKernelRule
    * @param transformedData Matrix to output results into.
    * @param eigval KPCA eigenvalues will be written to this vector.
    * @param eigvec KPCA eigenvectors will be written to this matrix.
-   * @param * (rank) Rank to be used for matrix approximation.
+   * @param rank Rank to be used for matrix approximation.
    * @param kernel Kernel to be used for computation.
    */
   static void ApplyKernelMatrix(const arma::mat& data,
                                 arma::mat& transformedData,
                                 arma::vec& eigval,
                                 arma::mat& eigvec,
-                                const size_t /* rank */,
+                                const size_t rank,
                                 KernelType kernel = KernelType())
-{
-  // Construct the kernel matrix.
-  arma::mat kernelMatrix;
-  // Resize the kernel matrix to the right size.
-  kernelMatrix.set_size(data.n_cols, data.n_cols);
-
-  // Note that we only need to calculate the upper triangular part of the
-  // kernel matrix, since it is symmetric. This helps minimize the number of
-  // kernel evaluations.
-  for (size_t i = 0; i < data.n_cols; ++i)
   {
-    for (size_t j = i; j < data.n_cols; ++j)
+    NaiveKernelRule rule;
+    rule.Apply(data, transformedData, eigval, eigvec, rank, kernel);
+  }
+
+  /**
+   * Construct the exact kernel matrix, and keep what is needed to transform
+   * new points with Transform().
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param * (rank) Rank to be used for matrix approximation.
+   * @param kernel Kernel to be used for computation.
+   */
+  void Apply(const arma::mat& data,
+             arma::mat& transformedData,
+             arma::vec& eigval,
+             arma::mat& eigvec,
+             const size_t /* rank */,
+             const KernelType& kernel)
+  {
+    // The kernel between new points and the data is needed to transform them.
+    // (transformedData may be the same matrix as data.)
+    referenceData = data;
+
+    // Construct the kernel matrix.
+    arma::mat kernelMatrix;
+    KernelMatrix(kernel, referenceData, kernelMatrix);
+
+    // For PCA the data has to be centered, even if the data is centered. But
+    // it is not guaranteed that the data, when mapped to the kernel space, is
+    // also centered. Since we actually never work in the feature space we
+    // cannot center the data. So, we perform a "psuedo-centering" using the
+    // kernel matrix.
+    kernelRowMean = sum(kernelMatrix, 0) / kernelMatrix.n_cols;
+    kernelMean = sum(kernelRowMean) / kernelMatrix.n_cols;
+    kernelMatrix.each_col() -= sum(kernelMatrix, 1) / kernelMatrix.n_cols;
+    kernelMatrix.each_row() -= kernelRowMean;
+    kernelMatrix += kernelMean;
+
+    // Eigendecompose the centered kernel matrix.
+    kernelMatrix = arma::symmatu(kernelMatrix);
+    if (!arma::eig_sym(eigval, eigvec, kernelMatrix))
     {
-      // Evaluate the kernel on these two points.
-      kernelMatrix(i, j) = kernel.Evaluate(data.unsafe_col(i),
-                                           data.unsafe_col(j));
+      Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
     }
+
+    // Swap the eigenvalues since they are ordered backwards (we need largest
+    // to smallest).
+    for (size_t i = 0; i < floor(eigval.n_elem / 2.0); ++i)
+      eigval.swap_rows(i, (eigval.n_elem - 1) - i);
+
+    // Flip the coefficients to produce the same effect.
+    eigvec = arma::fliplr(eigvec);
+
+    projection = eigvec;
+    projection.each_row() /= sqrt(eigval.t());
+
+    transformedData = projection.t() * kernelMatrix;
   }
 
-  // Copy to the lower triangular part of the matrix.
-  for (size_t i = 1; i < data.n_cols; ++i)
-    for (size_t j = 0; j < i; ++j)
-      kernelMatrix(i, j) = kernelMatrix(j, i);
-
-  // For PCA the data has to be centered, even if the data is centered. But it
-  // is not guaranteed that the data, when mapped to the kernel space, is also
-  // centered. Since we actually never work in the feature space we cannot
-  // center the data. So, we perform a "psuedo-centering" using the kernel
-  // matrix.
-  arma::rowvec rowMean = sum(kernelMatrix, 0) / kernelMatrix.n_cols;
-  kernelMatrix.each_col() -= sum(kernelMatrix, 1) / kernelMatrix.n_cols;
-  kernelMatrix.each_row() -= rowMean;
-  kernelMatrix += sum(rowMean) / kernelMatrix.n_cols;
-
-  // Eigendecompose the centered kernel matrix.
-  kernelMatrix = arma::symmatu(kernelMatrix);
-  if (!arma::eig_sym(eigval, eigvec, kernelMatrix))
+  /**
+   * Transform new points with the kernel matrix computed by the last call to
+   * Apply().  Applied to the data given to Apply(), this gives the same
+   * transformed data.
+   *
+   * @param data New points.
+   * @param transformedData Matrix to output results into.
+   * @param kernel Kernel to be used for computation.
+   */
+  void Transform(const arma::mat& data,
+                 arma::mat& transformedData,
+                 const KernelType& kernel) const
   {
-    Log::Fatal << "Failed to construct the kernel matrix." << std::endl;
-  }
+    arma::mat kernelMatrix;
+    KernelMatrix(kernel, referenceData, data, kernelMatrix);
 
-  // Swap the eigenvalues since they are ordered backwards (we need largest to
-  // smallest).
-  for (size_t i = 0; i < floor(eigval.n_elem / 2.0); ++i)
-    eigval.swap_rows(i, (eigval.n_elem - 1) - i);
+    // Center the kernel between the new points and the reference points with
+    // the statistics of the reference kernel matrix.
+    const arma::rowvec columnMean = sum(kernelMatrix, 0) /
+        kernelMatrix.n_rows;
+    kernelMatrix.each_col() -= kernelRowMean.t();
+    kernelMatrix.each_row() -= columnMean;
+    kernelMatrix += kernelMean;
 
-  // Flip the coefficients to produce the same effect.
-  eigvec = arma::fliplr(eigvec);
+    transformedData = projection.t() * kernelMatrix;
+  }
 
-  transformedData = eigvec.t() * kernelMatrix;
-  transformedData.each_col() /= sqrt(eigval);
-}
+ private:
+  //! The points given to Apply().
+  arma::mat referenceData;
+  //! The mean of each column of the reference kernel matrix.
+  arma::rowvec kernelRowMean;
+  //! The mean of the reference kernel matrix.
+  double kernelMean;
+  //! The eigenvectors, each divided by the square root of its eigenvalue.
+  arma::mat projection;
 };
 
 } // namespace mlpack
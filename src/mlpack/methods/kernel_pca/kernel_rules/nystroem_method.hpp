@@ -26,6 +26,9 @@ template<
 class NystroemKernelRule
 {
  public:
+  //! Create the rule; Apply() must be called before Transform().
+  NystroemKernelRule() : numPoints(0), offset(0.0) { }
+
   /**
    * Construct the kernel matrix approximation using the nystroem method.
    *
@@ -43,9 +46,37 @@ class NystroemKernelRule
                                 const size_t rank,
                                 KernelType kernel = KernelType())
   {
-    arma::mat G, v;
-    NystroemMethod<KernelType, PointSelectionPolicy> nm(data, kernel, rank);
+    NystroemKernelRule rule;
+    rule.Apply(data, transformedData, eigval, eigvec, rank, kernel);
+  }
+
+  /**
+   * Construct the kernel matrix approximation using the nystroem method, and
+   * keep what is needed to transform new points with Transform().  Only the
+   * selected points are kept, so this needs O(rank * n) memory.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Rank to be used for matrix approximation.
+   * @param kernel Kernel to be used for computation.
+   */
+  void Apply(const arma::mat& data,
+             arma::mat& transformedData,
+             arma::vec& eigval,
+             arma::mat& eigvec,
+             const size_t rank,
+             const KernelType& kernel)
+  {
+    arma::mat G;
+    KernelType nystroemKernel(kernel);
+    NystroemMethod<KernelType, PointSelectionPolicy> nm(data, nystroemKernel,
+        rank);
     nm.Apply(G);
+    landmarks = nm.Landmarks();
+    projection = nm.Projection();
+
     transformedData = G.t() * G;
 
     // Center the reconstructed approximation.
@@ -56,10 +87,13 @@ class NystroemKernelRule
     // also centered. Since we actually never work in the feature space we
     // cannot center the data. So, we perform a "psuedo-centering" using the
     // kernel matrix.
+    numPoints = G.n_rows;
+    featureMean = sum(G, 0) / G.n_rows;
     arma::colvec colMean = sum(G, 1) / G.n_rows;
-    G.each_row() -= sum(G, 0) / G.n_rows;
+    offset = sum(colMean) / G.n_rows;
+    G.each_row() -= featureMean;
     G.each_col() -= colMean;
-    G += sum(colMean) / G.n_rows;
+    G += offset;
 
     // Eigendecompose the centered kernel matrix.
     transformedData = arma::symmatu(transformedData);
@@ -75,9 +109,51 @@ class NystroemKernelRule
 
     // Flip the coefficients to produce the same effect.
     eigvec = arma::fliplr(eigvec);
+    eigenvectors = eigvec;
 
     transformedData = eigvec.t() * G.t();
   }
+
+  /**
+   * Transform new points with the approximation computed by the last call to
+   * Apply().  Applied to the data given to Apply(), this gives the same
+   * transformed data.
+   *
+   * @param data New points.
+   * @param transformedData Matrix to output results into.
+   * @param kernel Kernel to be used for computation.
+   */
+  void Transform(const arma::mat& data,
+                 arma::mat& transformedData,
+                 const KernelType& kernel) const
+  {
+    // Map the new points with the Nystroem factorization, and center them
+    // like the reference points.
+    arma::mat G;
+    KernelMatrix(kernel, data, landmarks, G);
+    G *= projection;
+
+    const arma::colvec colMean = sum(G, 1) / numPoints;
+    G.each_row() -= featureMean;
+    G.each_col() -= colMean;
+    G += offset;
+
+    transformedData = eigenvectors.t() * G.t();
+  }
+
+ private:
+  //! The points selected by the Nystroem method.
+  arma::mat landmarks;
+  //! The normalization of the kernel with the selected points.
+  arma::mat projection;
+  //! The number of points given to Apply().
+  size_t numPoints;
+  //! The mean of each feature of the reference points.
+  arma::rowvec featureMean;
+  //! The offset used for centering.
+  double offset;
+  //! The eigenvectors of the approximated kernel matrix.
+  arma::mat eigenvectors;
 };
 
 } // namespace mlpack
@@ -0,0 +1,151 @@
+/**
+ * @file methods/kernel_svm/kernel_cache.hpp
+ *
+ * A least-recently-used cache of rows of a kernel matrix, used by the SMO
+ * solver of KernelSVM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_CACHE_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <list>
+
+namespace mlpack {
+
+/**
+ * A cache of rows of the kernel matrix of a dataset.  Rows are computed when
+ * they are first requested (the entries of a row are evaluated in parallel
+ * when OpenMP is available) and kept until the memory budget is exhausted;
+ * then, the least recently used row is replaced.  The diagonal of the kernel
+ * matrix is always kept.
+ *
+ * A pointer returned by `Row()` stays valid until two other rows have been
+ * requested, so the two rows of a working pair can be used together.
+ *
+ * @tparam KernelType Kernel to evaluate.
+ * @tparam MatType Type of the dataset.
+ */
+template<typename KernelType, typename MatType>
+class KernelCache
+{
+ public:
+  //! The element type of the kernel rows.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the cache for the given dataset, which must stay valid while the
+   * cache is used.
+   *
+   * @param data Dataset whose kernel rows are cached.
+   * @param kernel Kernel to evaluate.
+   * @param cacheSize Memory budget of the cache, in megabytes.  At least two
+   *     rows are always kept.
+   */
+  KernelCache(const MatType& data,
+              KernelType& kernel,
+              const size_t cacheSize) :
+      data(data),
+      kernel(kernel),
+      hits(0),
+      misses(0)
+  {
+    const size_t rowBytes = std::max((size_t) data.n_cols, (size_t) 1) *
+        sizeof(ElemType);
+    const size_t maxRows = std::min((size_t) data.n_cols,
+        std::max((size_t) 2, cacheSize * 1024 * 1024 / rowBytes));
+
+    rows.set_size(data.n_cols, maxRows);
+    slotOf.assign(data.n_cols, size_t(-1));
+    ownerOf.assign(maxRows, size_t(-1));
+    for (size_t s = 0; s < maxRows; ++s)
+      lruSlots.push_back(s);
+    slotPositions.resize(maxRows);
+    for (auto it = lruSlots.begin(); it != lruSlots.end(); ++it)
+      slotPositions[*it] = it;
+
+    diagonal.set_size(data.n_cols);
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+      diagonal[i] = kernel.Evaluate(data.col(i), data.col(i));
+  }
+
+  /**
+   * Get row i of the kernel matrix, computing it if it is not cached.
+   *
+   * @param i Index of the row.
+   * @return Pointer to the `data.n_cols` entries of the row.
+   */
+  const ElemType* Row(const size_t i)
+  {
+    size_t slot = slotOf[i];
+    if (slot != size_t(-1))
+    {
+      ++hits;
+    }
+    else
+    {
+      ++misses;
+
+      // Reuse the least recently used slot.
+      slot = lruSlots.front();
+      if (ownerOf[slot] != size_t(-1))
+        slotOf[ownerOf[slot]] = size_t(-1);
+      ownerOf[slot] = i;
+      slotOf[i] = slot;
+
+      ElemType* row = rows.colptr(slot);
+      #pragma omp parallel for
+      for (size_t k = 0; k < data.n_cols; ++k)
+        row[k] = kernel.Evaluate(data.col(i), data.col(k));
+    }
+
+    // Mark the slot as the most recently used.
+    lruSlots.splice(lruSlots.end(), lruSlots, slotPositions[slot]);
+    return rows.colptr(slot);
+  }
+
+  //! Get entry (i, i) of the kernel matrix.
+  ElemType Diagonal(const size_t i) const { return diagonal[i]; }
+
+  //! Get the number of rows that can be cached.
+  size_t MaxRows() const { return rows.n_cols; }
+
+  //! Get the number of requests of cached rows.
+  size_t Hits() const { return hits; }
+  //! Get the number of requests of rows that had to be computed.
+  size_t Misses() const { return misses; }
+
+ private:
+  //! The dataset.
+  const MatType& data;
+  //! The kernel.
+  KernelType& kernel;
+
+  //! Storage for the cached rows, one per column.
+  arma::Mat<ElemType> rows;
+  //! The slot of each row, or -1 if it is not cached.
+  std::vector<size_t> slotOf;
+  //! The row held by each slot, or -1 if it is empty.
+  std::vector<size_t> ownerOf;
+  //! The slots, from the least to the most recently used.
+  std::list<size_t> lruSlots;
+  //! The position of each slot in lruSlots.
+  std::vector<std::list<size_t>::iterator> slotPositions;
+
+  //! The diagonal of the kernel matrix.
+  arma::Col<ElemType> diagonal;
+
+  //! Number of requests of cached rows.
+  size_t hits;
+  //! Number of requests of rows that had to be computed.
+  size_t misses;
+};
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,309 @@
+/**
+ * @file methods/kernel_svm/kernel_svm.hpp
+ *
+ * Definition of the KernelSVM class, a support vector machine with an
+ * arbitrary kernel, trained with sequential minimal optimization (SMO).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_HPP
+
+#include <mlpack/core.hpp>
+
+#include "kernel_cache.hpp"
+
+namespace mlpack {
+
+/**
+ * A C-support vector machine with an arbitrary kernel (any kernel in
+ * `mlpack/core/kernels/`, or a custom one).  Each binary problem is solved in
+ * the dual with sequential minimal optimization (SMO), using the second-order
+ * working set selection of Fan, Chen and Lin (as in LIBSVM):
+ *
+ *  - kernel rows are kept in an LRU cache of configurable size (see
+ *    `KernelCache`), and the entries of a row are computed in parallel when
+ *    OpenMP is available;
+ *  - with shrinking, the variables that are likely to stay at a bound are
+ *    periodically removed from the working set, and the gradient is
+ *    reconstructed before the optimality of the full problem is checked.
+ *
+ * More than two classes are handled with one-vs-one classifiers and voting.
+ *
+ * For datasets that are too large for an exact kernel, a rank can be given:
+ * then, the kernel is approximated with the Nystroem method on `rank`
+ * randomly selected landmark points, and a linear SVM is trained on the
+ * corresponding features with dual coordinate descent.  The cost of training
+ * is then linear in the number of points.
+ *
+ * For more details, see the following papers:
+ *
+ * @code
+ * @article{fan2005working,
+ *   title={Working set selection using second order information for training
+ *       support vector machines},
+ *   author={Fan, R.-E. and Chen, P.-H. and Lin, C.-J.},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={6},
+ *   pages={1889--1918},
+ *   year={2005}
+ * }
+ * @endcode
+ *
+ * @code
+ * @inproceedings{hsieh2008dual,
+ *   title={A dual coordinate descent method for large-scale linear SVM},
+ *   author={Hsieh, C.-J. and Chang, K.-W. and Lin, C.-J. and Keerthi, S.S.
+ *       and Sundararajan, S.},
+ *   booktitle={Proceedings of the 25th International Conference on Machine
+ *       Learning (ICML '08)},
+ *   pages={408--415},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * @tparam KernelType Kernel to use.
+ * @tparam MatType Type of the data.
+ */
+template<typename KernelType = GaussianKernel, typename MatType = arma::mat>
+class KernelSVM
+{
+ public:
+  //! The element type of the data and of the model.
+  typedef typename MatType::elem_type ElemType;
+  //! Dense matrix type of the model.
+  typedef typename GetDenseMatType<MatType>::type DenseMatType;
+  //! Dense column type of the model.
+  typedef typename GetColType<DenseMatType>::type DenseColType;
+
+  /**
+   * Create the model without training it.
+   *
+   * @param c Penalty of the margin violations (the SVM parameter C).
+   * @param kernel Kernel to use.
+   * @param tolerance Tolerance of the optimality conditions.
+   * @param maxIterations Maximum number of iterations for each binary problem
+   *     (0 means a default of max(10000000, 100 * n) for SMO, and 1000 epochs
+   *     for dual coordinate descent).
+   * @param cacheSize Size of the kernel row cache, in megabytes.
+   * @param shrinking Whether to use shrinking in SMO.
+   * @param rank Rank of the Nystroem approximation of the kernel (0 means
+   *     that the exact kernel is used).
+   */
+  KernelSVM(const double c = 1.0,
+            const KernelType& kernel = KernelType(),
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 0,
+            const size_t cacheSize = 200,
+            const bool shrinking = true,
+            const size_t rank = 0);
+
+  /**
+   * Train the model on the given data.
+   *
+   * @param data Column-major training data.
+   * @param labels Labels of the points, in the range [0, numClasses).
+   * @param numClasses Number of classes.
+   * @param c Penalty of the margin violations (the SVM parameter C).
+   * @param kernel Kernel to use.
+   * @param tolerance Tolerance of the optimality conditions.
+   * @param maxIterations Maximum number of iterations for each binary problem
+   *     (0 means a default of max(10000000, 100 * n) for SMO, and 1000 epochs
+   *     for dual coordinate descent).
+   * @param cacheSize Size of the kernel row cache, in megabytes.
+   * @param shrinking Whether to use shrinking in SMO.
+   * @param rank Rank of the Nystroem approximation of the kernel (0 means
+   *     that the exact kernel is used).
+   */
+  KernelSVM(const MatType& data,
+            const arma::Row<size_t>& labels,
+            const size_t numClasses,
+            const double c = 1.0,
+            const KernelType& kernel = KernelType(),
+            const double tolerance = 1e-3,
+            const size_t maxIterations = 0,
+            const size_t cacheSize = 200,
+            const bool shrinking = true,
+            const size_t rank = 0);
+
+  /**
+   * Train the model on the given data, with the current parameters.  Any
+   * existing model is replaced.
+   *
+   * @param data Column-major training data.
+   * @param labels Labels of the points, in the range [0, numClasses).
+   * @param numClasses Number of classes.
+   */
+  void Train(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses);
+
+  /**
+   * Train the model on the given data, setting the penalty first.
+   *
+   * @param data Column-major training data.
+   * @param labels Labels of the points, in the range [0, numClasses).
+   * @param numClasses Number of classes.
+   * @param c Penalty of the margin violations (the SVM parameter C).
+   */
+  void Train(const MatType& data,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses,
+             const double c);
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   * @return Predicted class of the point.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given points (in parallel, when OpenMP is available).
+   *
+   * @param data Column-major points to classify.
+   * @param predictions Vector to store the predicted classes in.
+   */
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Compute the decision values of the given points for each of the binary
+   * classifiers.  Classifier k separates classes i and j (i < j), in the
+   * order (0, 1), (0, 2), ..., (1, 2), ...; a positive value votes for i.
+   *
+   * @param data Column-major points.
+   * @param decisionValues Matrix to store the decision values in (one row per
+   *     classifier, one column per point).
+   */
+  void DecisionValues(const MatType& data, DenseMatType& decisionValues) const;
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the penalty of margin violations.
+  double C() const { return c; }
+  //! Modify the penalty of margin violations.
+  double& C() { return c; }
+
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Modify the kernel.
+  KernelType& Kernel() { return kernel; }
+
+  //! Get the tolerance of the optimality conditions.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance of the optimality conditions.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the maximum number of iterations for each binary problem.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of iterations for each binary problem.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the size of the kernel row cache, in megabytes.
+  size_t CacheSize() const { return cacheSize; }
+  //! Modify the size of the kernel row cache, in megabytes.
+  size_t& CacheSize() { return cacheSize; }
+
+  //! Get whether shrinking is used.
+  bool Shrinking() const { return shrinking; }
+  //! Modify whether shrinking is used.
+  bool& Shrinking() { return shrinking; }
+
+  //! Get the rank of the Nystroem approximation (0 for the exact kernel).
+  size_t Rank() const { return rank; }
+  //! Modify the rank of the Nystroem approximation (0 for the exact kernel).
+  size_t& Rank() { return rank; }
+
+  //! Get the support vectors of all the classifiers (exact kernel only).
+  const MatType& SupportVectors() const { return supportVectors; }
+
+  //! Get the intercepts of the binary classifiers.
+  const DenseColType& Biases() const { return biases; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Solve one binary problem with SMO.
+   *
+   * @param data Points of the problem.
+   * @param y Labels of the points (+1 or -1).
+   * @param alpha Vector to store the dual variables in.
+   * @return The intercept of the classifier.
+   */
+  ElemType SolveSMO(const MatType& data,
+                    const DenseColType& y,
+                    DenseColType& alpha);
+
+  /**
+   * Solve one binary problem on explicit features with dual coordinate
+   * descent.
+   *
+   * @param features Features of the points (one column per point, with a
+   *     last row of ones for the intercept).
+   * @param y Labels of the points (+1 or -1).
+   * @param weights Vector to store the weights in (the last one is the
+   *     intercept).
+   */
+  void SolveDCD(const DenseMatType& features,
+                const DenseColType& y,
+                DenseColType& weights);
+
+  /**
+   * Compute the Nystroem features of the given points, with a last row of
+   * ones.
+   */
+  void NystroemFeatures(const MatType& data, DenseMatType& features) const;
+
+  //! Penalty of the margin violations.
+  double c;
+  //! The kernel.
+  KernelType kernel;
+  //! Tolerance of the optimality conditions.
+  double tolerance;
+  //! Maximum number of iterations for each binary problem.
+  size_t maxIterations;
+  //! Size of the kernel row cache, in megabytes.
+  size_t cacheSize;
+  //! Whether shrinking is used.
+  bool shrinking;
+  //! Rank of the Nystroem approximation (0 for the exact kernel).
+  size_t rank;
+
+  //! Number of classes.
+  size_t numClasses;
+
+  //! Support vectors of all the classifiers (exact kernel only).
+  MatType supportVectors;
+  //! For each classifier, the indices of its support vectors in
+  //! supportVectors (exact kernel only).
+  std::vector<arma::uvec> supportIndices;
+  //! For each classifier, the coefficients (alpha_i y_i) of its support
+  //! vectors (exact kernel only).
+  std::vector<DenseColType> coefficients;
+  //! Intercepts of the classifiers.
+  DenseColType biases;
+
+  //! Landmark points of the Nystroem approximation.
+  MatType landmarks;
+  //! Projection from the kernel values at the landmarks to the features.
+  DenseMatType projection;
+  //! Weights of the classifiers on the Nystroem features (one column per
+  //! classifier; the intercepts are in biases).
+  DenseMatType linearWeights;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_svm_impl.hpp"
+
+#endif
@@ -0,0 +1,672 @@
+/**
+ * @file methods/kernel_svm/kernel_svm_impl.hpp
+ *
+ * Implementation of the KernelSVM class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+#define MLPACK_METHODS_KERNEL_SVM_KERNEL_SVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_svm.hpp"
+
+namespace mlpack {
+
+template<typename KernelType, typename MatType>
+KernelSVM<KernelType, MatType>::KernelSVM(const double c,
+                                          const KernelType& kernel,
+                                          const double tolerance,
+                                          const size_t maxIterations,
+                                          const size_t cacheSize,
+                                          const bool shrinking,
+                                          const size_t rank) :
+    c(c),
+    kernel(kernel),
+    tolerance(tolerance),
+    maxIterations(maxIterations),
+    cacheSize(cacheSize),
+    shrinking(shrinking),
+    rank(rank),
+    numClasses(0)
+{
+  // Nothing to do.
+}
+
+template<typename KernelType, typename MatType>
+KernelSVM<KernelType, MatType>::KernelSVM(const MatType& data,
+                                          const arma::Row<size_t>& labels,
+                                          const size_t numClasses,
+                                          const double c,
+                                          const KernelType& kernel,
+                                          const double tolerance,
+                                          const size_t maxIterations,
+                                          const size_t cacheSize,
+                                          const bool shrinking,
+                                          const size_t rank) :
+    KernelSVM(c, kernel, tolerance, maxIterations, cacheSize, shrinking, rank)
+{
+  Train(data, labels, numClasses);
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Train(const MatType& data,
+                                           const arma::Row<size_t>& labels,
+                                           const size_t numClasses,
+                                           const double c)
+{
+  this->c = c;
+  Train(data, labels, numClasses);
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Train(const MatType& data,
+                                           const arma::Row<size_t>& labels,
+                                           const size_t numClasses)
+{
+  util::CheckSameSizes(data, labels, "KernelSVM::Train()", "labels");
+
+  if (numClasses < 2)
+  {
+    throw std::invalid_argument("KernelSVM::Train(): the number of classes "
+        "must be at least 2!");
+  }
+
+  if (labels.n_elem > 0 && labels.max() >= numClasses)
+  {
+    std::ostringstream oss;
+    oss << "KernelSVM::Train(): labels must be in the range [0, "
+        << numClasses << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  this->numClasses = numClasses;
+  const size_t numPairs = numClasses * (numClasses - 1) / 2;
+  biases.set_size(numPairs);
+  supportVectors.clear();
+  supportIndices.clear();
+  coefficients.clear();
+  landmarks.clear();
+  projection.clear();
+  linearWeights.clear();
+
+  // With the Nystroem approximation, compute the features of all the points
+  // once.  As in NystroemMethod, if W is the kernel matrix of the landmarks
+  // and C the kernel values between the points and the landmarks, the kernel
+  // matrix is approximated by C W^+ C^T, so the features of the points are
+  // the columns of (W^+)^{1/2} C^T.
+  DenseMatType features;
+  if (rank > 0)
+  {
+    const size_t numLandmarks = std::min(rank, (size_t) data.n_cols);
+    const arma::uvec selected = arma::randperm(data.n_cols, numLandmarks);
+    landmarks = data.cols(selected);
+
+    DenseMatType miniKernel(numLandmarks, numLandmarks);
+    #pragma omp parallel for
+    for (size_t i = 0; i < numLandmarks; ++i)
+      for (size_t j = 0; j < numLandmarks; ++j)
+        miniKernel(i, j) = kernel.Evaluate(landmarks.col(i), landmarks.col(j));
+
+    DenseMatType u, v;
+    DenseColType s;
+    arma::svd(u, s, v, miniKernel);
+    for (size_t i = 0; i < s.n_elem; ++i)
+      s[i] = (std::abs(s[i]) <= 1e-20) ? 0 : 1 / std::sqrt(s[i]);
+    projection = u * arma::diagmat(s);
+
+    NystroemFeatures(data, features);
+    linearWeights.set_size(numLandmarks, numPairs);
+  }
+
+  // Train one classifier for each pair of classes.
+  std::vector<arma::uvec> pairSupportPoints;
+  size_t pair = 0;
+  for (size_t i = 0; i < numClasses; ++i)
+  {
+    for (size_t j = i + 1; j < numClasses; ++j, ++pair)
+    {
+      const arma::uvec indices = arma::find((labels == i) + (labels == j));
+      DenseColType y(indices.n_elem);
+      for (size_t k = 0; k < indices.n_elem; ++k)
+        y[k] = (labels[indices[k]] == i) ? 1 : -1;
+
+      if (rank > 0)
+      {
+        DenseColType weights;
+        SolveDCD(features.cols(indices), y, weights);
+        linearWeights.col(pair) = weights.head(weights.n_elem - 1);
+        biases[pair] = weights[weights.n_elem - 1];
+      }
+      else
+      {
+        DenseColType alpha;
+        biases[pair] = SolveSMO(data.cols(indices), y, alpha);
+
+        const arma::uvec support = arma::find(alpha > 0);
+        pairSupportPoints.push_back(arma::uvec(indices.elem(support)));
+        coefficients.push_back(DenseColType(alpha.elem(support) %
+            y.elem(support)));
+      }
+    }
+  }
+
+  if (rank > 0)
+    return;
+
+  // Store each support vector once, even if several classifiers use it.
+  arma::uvec isSupport(data.n_cols, arma::fill::zeros);
+  for (size_t p = 0; p < pairSupportPoints.size(); ++p)
+    isSupport.elem(pairSupportPoints[p]).ones();
+
+  const arma::uvec supportPoints = arma::find(isSupport);
+  arma::uvec supportPosition(data.n_cols);
+  for (size_t k = 0; k < supportPoints.n_elem; ++k)
+    supportPosition[supportPoints[k]] = k;
+
+  supportVectors = data.cols(supportPoints);
+  supportIndices.resize(pairSupportPoints.size());
+  for (size_t p = 0; p < pairSupportPoints.size(); ++p)
+    supportIndices[p] = supportPosition.elem(pairSupportPoints[p]);
+}
+
+template<typename KernelType, typename MatType>
+template<typename VecType>
+size_t KernelSVM<KernelType, MatType>::Classify(const VecType& point) const
+{
+  arma::Row<size_t> predictions;
+  Classify(MatType(point), predictions);
+  return predictions[0];
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::Classify(
+    const MatType& data,
+    arma::Row<size_t>& predictions) const
+{
+  DenseMatType decisionValues;
+  DecisionValues(data, decisionValues);
+
+  // Each classifier votes for one of its two classes; ties go to the class
+  // with the smallest index.
+  predictions.set_size(data.n_cols);
+  #pragma omp parallel for
+  for (size_t p = 0; p < data.n_cols; ++p)
+  {
+    arma::uvec votes(numClasses, arma::fill::zeros);
+    size_t pair = 0;
+    for (size_t i = 0; i < numClasses; ++i)
+      for (size_t j = i + 1; j < numClasses; ++j, ++pair)
+        ++votes[(decisionValues(pair, p) > 0) ? i : j];
+
+    predictions[p] = votes.index_max();
+  }
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::DecisionValues(
+    const MatType& data,
+    DenseMatType& decisionValues) const
+{
+  if (numClasses < 2)
+  {
+    throw std::logic_error("KernelSVM::DecisionValues(): the model is not "
+        "trained!");
+  }
+
+  const size_t dimensionality = (rank > 0) ? landmarks.n_rows :
+      supportVectors.n_rows;
+  if (dimensionality > 0 && data.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "KernelSVM::DecisionValues(): points have dimensionality "
+        << data.n_rows << ", but the model has dimensionality "
+        << dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (rank > 0)
+  {
+    DenseMatType features;
+    NystroemFeatures(data, features);
+    decisionValues = linearWeights.t() *
+        features.head_rows(features.n_rows - 1);
+    decisionValues.each_col() += biases;
+    return;
+  }
+
+  // The kernel is copied, since the Evaluate() function of some kernels is
+  // not const.
+  KernelType localKernel(kernel);
+  decisionValues.set_size(biases.n_elem, data.n_cols);
+  #pragma omp parallel for
+  for (size_t p = 0; p < data.n_cols; ++p)
+  {
+    DenseColType kernelValues(supportVectors.n_cols);
+    for (size_t s = 0; s < supportVectors.n_cols; ++s)
+    {
+      kernelValues[s] = localKernel.Evaluate(supportVectors.col(s),
+          data.col(p));
+    }
+
+    for (size_t k = 0; k < biases.n_elem; ++k)
+    {
+      decisionValues(k, p) = dot(coefficients[k],
+          kernelValues.elem(supportIndices[k])) + biases[k];
+    }
+  }
+}
+
+template<typename KernelType, typename MatType>
+typename KernelSVM<KernelType, MatType>::ElemType
+KernelSVM<KernelType, MatType>::SolveSMO(const MatType& data,
+                                         const DenseColType& y,
+                                         DenseColType& alpha)
+{
+  const size_t n = data.n_cols;
+  alpha.zeros(n);
+  if (n == 0)
+    return 0;
+
+  const ElemType upper = (ElemType) c;
+  const ElemType eps = (ElemType) tolerance;
+  const ElemType tau = 1e-12;
+  const size_t limit = (maxIterations == 0) ?
+      std::max((size_t) 10000000, 100 * n) : maxIterations;
+
+  KernelCache<KernelType, MatType> cache(data, kernel, cacheSize);
+
+  // The gradient of the dual objective 0.5 alpha^T Q alpha - 1^T alpha, with
+  // Q_ij = y_i y_j K_ij.
+  DenseColType gradient(n);
+  gradient.fill(-1);
+
+  // The variables that can still move: I_up can increase y_t alpha_t, and
+  // I_low can decrease it.
+  auto inUp = [&](const size_t t)
+  {
+    return (y[t] > 0) ? (alpha[t] < upper) : (alpha[t] > 0);
+  };
+  auto inLow = [&](const size_t t)
+  {
+    return (y[t] > 0) ? (alpha[t] > 0) : (alpha[t] < upper);
+  };
+
+  std::vector<size_t> active(n);
+  std::iota(active.begin(), active.end(), 0);
+
+  // Recompute the gradient of the shrunk variables, and make all variables
+  // active again.
+  auto reconstructGradient = [&]()
+  {
+    if (active.size() == n)
+      return;
+
+    std::vector<char> isActive(n, 0);
+    for (size_t a = 0; a < active.size(); ++a)
+      isActive[active[a]] = 1;
+
+    std::vector<size_t> inactive;
+    for (size_t t = 0; t < n; ++t)
+    {
+      if (!isActive[t])
+      {
+        inactive.push_back(t);
+        gradient[t] = -1;
+      }
+    }
+
+    for (size_t s = 0; s < n; ++s)
+    {
+      if (alpha[s] == 0)
+        continue;
+
+      const ElemType* row = cache.Row(s);
+      for (size_t k = 0; k < inactive.size(); ++k)
+      {
+        const size_t t = inactive[k];
+        gradient[t] += y[t] * y[s] * alpha[s] * row[t];
+      }
+    }
+
+    active.resize(n);
+    std::iota(active.begin(), active.end(), 0);
+  };
+
+  size_t counter = std::min(n, (size_t) 1000) + 1;
+  bool unshrunk = false;
+  size_t iteration = 0;
+  for (; iteration < limit; ++iteration)
+  {
+    // Periodically remove the variables that are likely to stay at a bound.
+    if (shrinking && --counter == 0)
+    {
+      counter = std::min(n, (size_t) 1000);
+
+      ElemType gMax1 = -std::numeric_limits<ElemType>::infinity();
+      ElemType gMax2 = -std::numeric_limits<ElemType>::infinity();
+      for (size_t a = 0; a < active.size(); ++a)
+      {
+        const size_t t = active[a];
+        if (inUp(t))
+          gMax1 = std::max(gMax1, -y[t] * gradient[t]);
+        if (inLow(t))
+          gMax2 = std::max(gMax2, y[t] * gradient[t]);
+      }
+
+      // Close to convergence, start again from all the variables once, in
+      // case some were shrunk too early.
+      if (!unshrunk && gMax1 + gMax2 <= 10 * eps)
+      {
+        unshrunk = true;
+        reconstructGradient();
+      }
+
+      size_t kept = 0;
+      for (size_t a = 0; a < active.size(); ++a)
+      {
+        const size_t t = active[a];
+        const ElemType g = gradient[t];
+        bool shrink = false;
+        if (alpha[t] >= upper)
+          shrink = (y[t] > 0) ? (-g > gMax1) : (-g > gMax2);
+        else if (alpha[t] <= 0)
+          shrink = (y[t] > 0) ? (g > gMax2) : (g > gMax1);
+
+        if (!shrink)
+          active[kept++] = t;
+      }
+      active.resize(kept);
+    }
+
+    // Select the working set with second-order information: i maximizes
+    // -y_i G_i over I_up, and j gives the largest decrease of the objective
+    // among the violating pairs (i, j).
+    ElemType gMax = -std::numeric_limits<ElemType>::infinity();
+    size_t i = size_t(-1);
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      const size_t t = active[a];
+      if (inUp(t) && -y[t] * gradient[t] >= gMax)
+      {
+        gMax = -y[t] * gradient[t];
+        i = t;
+      }
+    }
+
+    ElemType gMax2 = -std::numeric_limits<ElemType>::infinity();
+    ElemType objectiveMin = std::numeric_limits<ElemType>::infinity();
+    size_t j = size_t(-1);
+    const ElemType* rowI = (i == size_t(-1)) ? nullptr : cache.Row(i);
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      const size_t t = active[a];
+      if (!inLow(t))
+        continue;
+
+      const ElemType g = y[t] * gradient[t];
+      gMax2 = std::max(gMax2, g);
+      const ElemType b = gMax + g;
+      if (b > 0)
+      {
+        ElemType quadratic = cache.Diagonal(i) + cache.Diagonal(t) -
+            2 * rowI[t];
+        if (quadratic <= 0)
+          quadratic = tau;
+
+        const ElemType objective = -(b * b) / quadratic;
+        if (objective <= objectiveMin)
+        {
+          objectiveMin = objective;
+          j = t;
+        }
+      }
+    }
+
+    if (gMax + gMax2 < eps || j == size_t(-1))
+    {
+      // The active variables are optimal; check all of them before stopping.
+      // The next selection is done on all the variables, before shrinking
+      // again.
+      if (active.size() < n)
+      {
+        reconstructGradient();
+        counter = 2;
+        continue;
+      }
+
+      break;
+    }
+
+    // Solve the two-variable subproblem and clip it to the box.  rowI stays
+    // valid, since the cache holds at least two rows.
+    const ElemType* rowJ = cache.Row(j);
+    const ElemType oldAlphaI = alpha[i];
+    const ElemType oldAlphaJ = alpha[j];
+    ElemType quadratic = cache.Diagonal(i) + cache.Diagonal(j) -
+        2 * rowI[j];
+    if (quadratic <= 0)
+      quadratic = tau;
+
+    if (y[i] != y[j])
+    {
+      const ElemType delta = (-gradient[i] - gradient[j]) / quadratic;
+      const ElemType diff = alpha[i] - alpha[j];
+      alpha[i] += delta;
+      alpha[j] += delta;
+
+      if (diff > 0)
+      {
+        if (alpha[j] < 0)
+        {
+          alpha[j] = 0;
+          alpha[i] = diff;
+        }
+      }
+      else if (alpha[i] < 0)
+      {
+        alpha[i] = 0;
+        alpha[j] = -diff;
+      }
+
+      if (diff > 0)
+      {
+        if (alpha[i] > upper)
+        {
+          alpha[i] = upper;
+          alpha[j] = upper - diff;
+        }
+      }
+      else if (alpha[j] > upper)
+      {
+        alpha[j] = upper;
+        alpha[i] = upper + diff;
+      }
+    }
+    else
+    {
+      const ElemType delta = (gradient[i] - gradient[j]) / quadratic;
+      const ElemType sum = alpha[i] + alpha[j];
+      alpha[i] -= delta;
+      alpha[j] += delta;
+
+      if (sum > upper)
+      {
+        if (alpha[i] > upper)
+        {
+          alpha[i] = upper;
+          alpha[j] = sum - upper;
+        }
+        if (alpha[j] > upper)
+        {
+          alpha[j] = upper;
+          alpha[i] = sum - upper;
+        }
+      }
+      else
+      {
+        if (alpha[j] < 0)
+        {
+          alpha[j] = 0;
+          alpha[i] = sum;
+        }
+        if (alpha[i] < 0)
+        {
+          alpha[i] = 0;
+          alpha[j] = sum;
+        }
+      }
+    }
+
+    // Update the gradient of the active variables.
+    const ElemType deltaI = y[i] * (alpha[i] - oldAlphaI);
+    const ElemType deltaJ = y[j] * (alpha[j] - oldAlphaJ);
+    for (size_t a = 0; a < active.size(); ++a)
+    {
+      const size_t t = active[a];
+      gradient[t] += y[t] * (rowI[t] * deltaI + rowJ[t] * deltaJ);
+    }
+  }
+
+  if (iteration >= limit)
+  {
+    Log::Warn << "KernelSVM::Train(): SMO did not converge in " << limit
+        << " iterations." << std::endl;
+    reconstructGradient();
+  }
+
+  // The intercept is -rho, where rho is the average of y_t G_t over the free
+  // variables or, if there are none, the middle of its feasible interval.
+  ElemType ub = std::numeric_limits<ElemType>::infinity();
+  ElemType lb = -std::numeric_limits<ElemType>::infinity();
+  ElemType freeSum = 0;
+  size_t numFree = 0;
+  for (size_t t = 0; t < n; ++t)
+  {
+    const ElemType g = y[t] * gradient[t];
+    if (alpha[t] >= upper)
+    {
+      if (y[t] < 0)
+        ub = std::min(ub, g);
+      else
+        lb = std::max(lb, g);
+    }
+    else if (alpha[t] <= 0)
+    {
+      if (y[t] > 0)
+        ub = std::min(ub, g);
+      else
+        lb = std::max(lb, g);
+    }
+    else
+    {
+      ++numFree;
+      freeSum += g;
+    }
+  }
+
+  const ElemType rho = (numFree > 0) ? freeSum / numFree : (ub + lb) / 2;
+  return -rho;
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::SolveDCD(const DenseMatType& features,
+                                              const DenseColType& y,
+                                              DenseColType& weights)
+{
+  const size_t n = features.n_cols;
+  const ElemType upper = (ElemType) c;
+  const size_t limit = (maxIterations == 0) ? 1000 : maxIterations;
+
+  weights.zeros(features.n_rows);
+  DenseColType alpha(n, arma::fill::zeros);
+  const DenseColType sqNorms = sum(square(features), 0).t();
+
+  size_t epoch = 0;
+  for (; epoch < limit; ++epoch)
+  {
+    ElemType maxProjected = -std::numeric_limits<ElemType>::infinity();
+    ElemType minProjected = std::numeric_limits<ElemType>::infinity();
+
+    const arma::uvec order = arma::randperm(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+      const size_t i = order[k];
+      if (sqNorms[i] == 0)
+        continue;
+
+      const ElemType g = y[i] * dot(weights, features.col(i)) - 1;
+      const ElemType projected = (alpha[i] <= 0) ? std::min(g, ElemType(0)) :
+          (alpha[i] >= upper) ? std::max(g, ElemType(0)) : g;
+      maxProjected = std::max(maxProjected, projected);
+      minProjected = std::min(minProjected, projected);
+
+      if (projected != 0)
+      {
+        const ElemType oldAlpha = alpha[i];
+        alpha[i] = std::min(std::max(alpha[i] - g / sqNorms[i], ElemType(0)),
+            upper);
+        weights += (alpha[i] - oldAlpha) * y[i] * features.col(i);
+      }
+    }
+
+    if (maxProjected - minProjected <= (ElemType) tolerance)
+      break;
+  }
+
+  if (epoch >= limit)
+  {
+    Log::Warn << "KernelSVM::Train(): dual coordinate descent did not "
+        << "converge in " << limit << " epochs." << std::endl;
+  }
+}
+
+template<typename KernelType, typename MatType>
+void KernelSVM<KernelType, MatType>::NystroemFeatures(
+    const MatType& data,
+    DenseMatType& features) const
+{
+  // The kernel is copied, since the Evaluate() function of some kernels is
+  // not const.
+  KernelType localKernel(kernel);
+  DenseMatType kernelValues(landmarks.n_cols, data.n_cols);
+  #pragma omp parallel for
+  for (size_t p = 0; p < data.n_cols; ++p)
+  {
+    for (size_t l = 0; l < landmarks.n_cols; ++l)
+      kernelValues(l, p) = localKernel.Evaluate(landmarks.col(l), data.col(p));
+  }
+
+  features.set_size(landmarks.n_cols + 1, data.n_cols);
+  features.head_rows(landmarks.n_cols) = projection.t() * kernelValues;
+  features.row(landmarks.n_cols).ones();
+}
+
+template<typename KernelType, typename MatType>
+template<typename Archive>
+void KernelSVM<KernelType, MatType>::serialize(Archive& ar,
+                                               const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(c));
+  ar(CEREAL_NVP(kernel));
+  ar(CEREAL_NVP(tolerance));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(cacheSize));
+  ar(CEREAL_NVP(shrinking));
+  ar(CEREAL_NVP(rank));
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(supportVectors));
+  ar(CEREAL_NVP(supportIndices));
+  ar(CEREAL_NVP(coefficients));
+  ar(CEREAL_NVP(biases));
+  ar(CEREAL_NVP(landmarks));
+  ar(CEREAL_NVP(projection));
+  ar(CEREAL_NVP(linearWeights));
+}
+
+} // namespace mlpack
+
+#endif
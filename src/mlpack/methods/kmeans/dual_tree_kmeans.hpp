@@ -23,12 +23,24 @@
 
 namespace mlpack {
 
+//! Whether a tree can update its bounds in place (see
+//! BinarySpaceTree::RefitBounds()).
+HAS_MEM_FUNC(RefitBounds, HasRefitBounds);
+
 /**
  * An algorithm for an exact Lloyd iteration which simply uses dual-tree
  * nearest-neighbor search to find the nearest centroid for each point in the
  * dataset.  The conditions under which this will perform best are probably
  * limited to the case where k is close to the number of points in the dataset,
  * and the number of iterations of the k-means algorithm will be few.
+ *
+ * If the tree type can refit its bounds in place (as BinarySpaceTree can), the
+ * tree built on the centroids is kept between iterations: when no centroid has
+ * moved by more than `RefitThreshold()` times the diameter of the centroid
+ * tree, the centroids are copied into the existing tree and its bounds are
+ * refit, instead of building a new tree.  The results are the same either way;
+ * only the quality of the centroid tree changes.  The bounds of the tree built
+ * on the points are updated in parallel with OpenMP tasks.
  */
 template<
     typename DistanceType,
@@ -49,11 +61,23 @@ class DualTreeKMeans
   using NNSTreeType =
       TreeType<TreeDistanceType, DualTreeKMeansStatistic, TreeMatType>;
 
+  //! The type of the neighbor search built on the centroids.
+  typedef NeighborSearch<NearestNeighborSort, DistanceType, MatType,
+      NNSTreeType> CentroidSearchType;
+
   /**
    * Construct the DualTreeKMeans object, which will construct a tree on the
    * points.
+   *
+   * @param dataset Dataset to cluster.
+   * @param distance Instantiated distance metric.
+   * @param refitThreshold Largest centroid movement, relative to the diameter
+   *     of the centroid tree, for which the centroid tree is refit instead of
+   *     rebuilt (0 always rebuilds it).
    */
-  DualTreeKMeans(const MatType& dataset, DistanceType& distance);
+  DualTreeKMeans(const MatType& dataset,
+                 DistanceType& distance,
+                 const double refitThreshold = 0.05);
 
   /**
    * Delete the tree constructed by the DualTreeKMeans object.
@@ -77,6 +101,16 @@ class DualTreeKMeans
   //! Modify the number of distance calculations.
   size_t& DistanceCalculations() { return distanceCalculations; }
 
+  //! Get the largest relative centroid movement for which the centroid tree
+  //! is refit instead of rebuilt.
+  double RefitThreshold() const { return refitThreshold; }
+  //! Modify the largest relative centroid movement for which the centroid
+  //! tree is refit instead of rebuilt (0 always rebuilds it).
+  double& RefitThreshold() { return refitThreshold; }
+
+  //! Get the number of iterations that reused the centroid tree.
+  size_t CentroidTreeRefits() const { return centroidTreeRefits; }
+
  private:
   //! The original dataset reference.
   const MatType& datasetOrig; // Maybe not necessary.
@@ -96,8 +130,9 @@ class DualTreeKMeans
   arma::vec upperBounds;
   //! Lower bounds on second closest cluster distance for each point.
   arma::vec lowerBounds;
-  //! Indicator of whether or not the point is pruned.
-  std::vector<bool> prunedPoints;
+  //! Indicator of whether or not the point is pruned.  This is not a
+  //! std::vector<bool>, so that different points can be updated in parallel.
+  std::vector<char> prunedPoints;
 
   arma::Row<size_t> assignments;
 
@@ -109,6 +144,37 @@ class DualTreeKMeans
 
   arma::mat interclusterDistances; // Static storage for intercluster distances.
 
+  //! The neighbor search built on the centroids of the last iteration.
+  CentroidSearchType* centroidSearch;
+  //! The mapping of the centroids in the centroid tree.
+  std::vector<size_t> oldFromNewCentroids;
+  //! The largest relative centroid movement for refitting the centroid tree.
+  double refitThreshold;
+  //! The number of iterations that reused the centroid tree.
+  size_t centroidTreeRefits;
+
+  //! Subtrees with fewer descendants than this are updated by UpdateTree() in
+  //! the task of their parent.
+  static constexpr size_t UpdateTaskMinSize = 1000;
+
+  /**
+   * Copy the given centroids into the centroid tree of the last iteration and
+   * refit its bounds, if they have not moved too far.  Returns false if the
+   * tree must be rebuilt instead.
+   */
+  template<bool Refit = HasRefitBounds<Tree, void(Tree::*)()>::value>
+  bool RefitCentroidTree(const arma::mat& centroids,
+                         const typename std::enable_if_t<Refit>* = 0);
+
+  //! The tree cannot be refit: always return false.
+  template<bool Refit = HasRefitBounds<Tree, void(Tree::*)()>::value>
+  bool RefitCentroidTree(const arma::mat& centroids,
+                         const typename std::enable_if_t<!Refit>* = 0);
+
+  //! Recompute the statistics of the given centroid tree node and its
+  //! descendants.
+  void UpdateCentroidStatistics(Tree& node);
+
   //! Update the bounds in the tree before the next iteration.
   //! centroids is the current (not yet searched) centroids.
   void UpdateTree(Tree& node,
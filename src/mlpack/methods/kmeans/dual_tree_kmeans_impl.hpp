@@ -53,7 +53,8 @@ template<typename DistanceType,
                   typename TreeMatType> class TreeType>
 DualTreeKMeans<DistanceType, MatType, TreeType>::DualTreeKMeans(
     const MatType& dataset,
-    DistanceType& distance) :
+    DistanceType& distance,
+    const double refitThreshold) :
     datasetOrig(dataset),
     tree(new Tree(const_cast<MatType&>(dataset))),
     dataset(tree->Dataset()),
@@ -64,7 +65,10 @@ DualTreeKMeans<DistanceType, MatType, TreeType>::DualTreeKMeans(
     lowerBounds(dataset.n_cols),
     prunedPoints(dataset.n_cols, false), // Fill with false.
     assignments(dataset.n_cols),
-    visited(dataset.n_cols, false) // Fill with false.
+    visited(dataset.n_cols, false), // Fill with false.
+    centroidSearch(NULL),
+    refitThreshold(refitThreshold),
+    centroidTreeRefits(0)
 {
   for (size_t i = 0; i < dataset.n_cols; ++i)
   {
@@ -85,6 +89,8 @@ DualTreeKMeans<DistanceType, MatType, TreeType>::~DualTreeKMeans()
 {
   if (tree)
     delete tree;
+  if (centroidSearch)
+    delete centroidSearch;
 }
 
 // Run a single iteration.
@@ -98,17 +104,28 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
     arma::mat& newCentroids,
     arma::Col<size_t>& counts)
 {
-  // Build a tree on the centroids.  This will make a copy if necessary, which
-  // is unfortunate, but I don't see a reasonable way around it.
-  std::vector<size_t> oldFromNewCentroids;
-  Tree* centroidTree = BuildForcedLeafSizeTree<Tree>(centroids,
-      oldFromNewCentroids);
-
-  // Find the nearest neighbors of each of the clusters.  We have to make our
-  // own TreeType, which is a little bit abuse, but we know for sure the
-  // TreeStatType we have will work.
-  NeighborSearch<NearestNeighborSort, DistanceType, MatType, NNSTreeType>
-      nns(std::move(*centroidTree));
+  // Late in the clustering, the centroids barely move, so the tree of the last
+  // iteration can be reused with refit bounds.  Otherwise, build a tree on the
+  // centroids.  This will make a copy if necessary, which is unfortunate, but I
+  // don't see a reasonable way around it.
+  if (RefitCentroidTree(centroids))
+  {
+    ++centroidTreeRefits;
+  }
+  else
+  {
+    delete centroidSearch;
+    oldFromNewCentroids.clear();
+    Tree* centroidTree = BuildForcedLeafSizeTree<Tree>(centroids,
+        oldFromNewCentroids);
+
+    // Find the nearest neighbors of each of the clusters.  We have to make our
+    // own TreeType, which is a little bit abuse, but we know for sure the
+    // TreeStatType we have will work.
+    centroidSearch = new CentroidSearchType(std::move(*centroidTree));
+    delete centroidTree;
+  }
+  CentroidSearchType& nns = *centroidSearch;
 
   // Reset information in the tree, if we need to.
   if (iteration > 0)
@@ -131,7 +148,14 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
       delete interclusterDistancesTemp;
     }
 
-    UpdateTree(*tree, centroids);
+    // The subtrees of the tree are updated in parallel tasks.
+    #pragma omp parallel num_threads(Parallel::Threads())
+    {
+      #pragma omp single
+      {
+        UpdateTree(*tree, centroids);
+      }
+    }
 
     for (size_t i = 0; i < dataset.n_cols; ++i)
       visited[i] = false;
@@ -190,8 +214,6 @@ double DualTreeKMeans<DistanceType, MatType, TreeType>::Iterate(
   }
   distanceCalculations += centroids.n_cols;
 
-  delete centroidTree;
-
   ++iteration;
 
   return std::sqrt(residual);
@@ -213,6 +235,10 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
   const bool prunedLastIteration = node.Stat().StaticPruned();
   node.Stat().StaticPruned() = false;
 
+  // Distance calculations are counted locally, since other subtrees may be
+  // updated at the same time.
+  size_t calculations = 0;
+
   // Grab information from the parent, if we can.
   if (node.Parent() != NULL &&
       node.Parent()->Stat().Pruned() == centroids.n_cols &&
@@ -267,7 +293,7 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
                    node.MaxDistance(centroids.col(node.Stat().Owner())));
       adjustedUpperBound = node.Stat().UpperBound();
 
-      ++distanceCalculations;
+      ++calculations;
       if (node.Stat().UpperBound() < node.Stat().LowerBound())
         node.Stat().StaticPruned() = true;
     }
@@ -279,11 +305,23 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
 
   // Recurse into children, and if all the children (and all the points) are
   // pruned, then we can mark this as statically pruned.
+  // The children hold disjoint sets of points, so large children can be
+  // updated in separate tasks.
   bool allChildrenPruned = true;
   for (size_t i = 0; i < node.NumChildren(); ++i)
   {
-    UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
-        adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
+    #pragma omp task if (node.Child(i).NumDescendants() >= UpdateTaskMinSize) \
+        shared(node, centroids)
+    {
+      UpdateTree(node.Child(i), centroids, unadjustedUpperBound,
+          adjustedUpperBound, unadjustedLowerBound, adjustedLowerBound);
+    }
+  }
+
+  #pragma omp taskwait
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
     if (!node.Child(i).Stat().StaticPruned())
       allChildrenPruned = false;
   }
@@ -339,7 +377,7 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
         // Attempt to tighten the bound.
         upperBounds[index] = distance.Evaluate(dataset.col(index),
                                                centroids.col(owner));
-        ++distanceCalculations;
+        ++calculations;
         if (upperBounds[index] < pruningLowerBound)
         {
           prunedPoints[index] = true;
@@ -382,6 +420,9 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
     node.Stat().Pruned() = size_t(-1);
   }
 
+  #pragma omp atomic
+  distanceCalculations += calculations;
+
   if (!node.Stat().StaticPruned())
   {
     node.Stat().UpperBound() = DBL_MAX;
@@ -410,6 +451,78 @@ void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateTree(
   }
 }
 
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<bool Refit>
+bool DualTreeKMeans<DistanceType, MatType, TreeType>::RefitCentroidTree(
+    const arma::mat& centroids,
+    const typename std::enable_if_t<Refit>*)
+{
+  if (centroidSearch == NULL || refitThreshold <= 0.0)
+    return false;
+
+  Tree& centroidTree = centroidSearch->ReferenceTree();
+  MatType& treeCentroids = centroidTree.Dataset();
+  if (treeCentroids.n_cols != centroids.n_cols ||
+      treeCentroids.n_rows != centroids.n_rows)
+    return false;
+
+  // The movement is measured directly, since the centroids given to Iterate()
+  // may not be the ones it returned last time (e.g. if a cluster was empty).
+  const double maxMovement = refitThreshold * 2.0 *
+      centroidTree.FurthestDescendantDistance();
+  for (size_t i = 0; i < treeCentroids.n_cols; ++i)
+  {
+    const size_t c = TreeTraits<Tree>::RearrangesDataset ?
+        oldFromNewCentroids[i] : i;
+    ++distanceCalculations;
+    if (distance.Evaluate(treeCentroids.col(i), centroids.col(c)) >
+        maxMovement)
+      return false;
+  }
+
+  for (size_t i = 0; i < treeCentroids.n_cols; ++i)
+  {
+    treeCentroids.col(i) = centroids.col(TreeTraits<Tree>::RearrangesDataset ?
+        oldFromNewCentroids[i] : i);
+  }
+
+  centroidTree.RefitBounds();
+  UpdateCentroidStatistics(centroidTree);
+  return true;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<bool Refit>
+bool DualTreeKMeans<DistanceType, MatType, TreeType>::RefitCentroidTree(
+    const arma::mat& /* centroids */,
+    const typename std::enable_if_t<!Refit>*)
+{
+  return false;
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DualTreeKMeans<DistanceType, MatType, TreeType>::UpdateCentroidStatistics(
+    Tree& node)
+{
+  // The statistic of a node is computed from those of its children.
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    UpdateCentroidStatistics(node.Child(i));
+
+  node.Stat() = DualTreeKMeansStatistic(node);
+}
+
 template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
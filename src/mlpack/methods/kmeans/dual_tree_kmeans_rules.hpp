@@ -28,7 +28,7 @@ class DualTreeKMeansRules
                       arma::vec& upperBounds,
                       arma::vec& lowerBounds,
                       DistanceType& distance,
-                      const std::vector<bool>& prunedPoints,
+                      const std::vector<char>& prunedPoints,
                       const std::vector<size_t>& oldFromNewCentroids,
                       std::vector<bool>& visited);
 
@@ -66,7 +66,7 @@ class DualTreeKMeansRules
   arma::vec& lowerBounds;
   DistanceType& distance;
 
-  const std::vector<bool>& prunedPoints;
+  const std::vector<char>& prunedPoints;
 
   const std::vector<size_t>& oldFromNewCentroids;
 
@@ -24,7 +24,7 @@ DualTreeKMeansRules<DistanceType, TreeType>::DualTreeKMeansRules(
     arma::vec& upperBounds,
     arma::vec& lowerBounds,
     DistanceType& distance,
-    const std::vector<bool>& prunedPoints,
+    const std::vector<char>& prunedPoints,
     const std::vector<size_t>& oldFromNewCentroids,
     std::vector<bool>& visited) :
     centroids(centroids),
@@ -27,6 +27,8 @@ class ElkanKMeans
    * Run a single iteration of Elkan's algorithm, updating the given centroids
    * into the newCentroids matrix.
    *
+   * The points are processed in parallel with OpenMP, if it is available.
+   *
    * @param centroids Current cluster centroids.
    * @param newCentroids New cluster centroids.
    * @param counts Current counts, to be overwritten with new counts.
@@ -53,8 +55,18 @@ class ElkanKMeans
 
   //! Upper bounds on the distance between each point and its closest cluster.
   arma::vec upperBounds;
-  //! Lower bounds on the distance between each point and each cluster.
-  arma::mat lowerBounds;
+  //! Lower bounds on the distance between each point and each cluster.  These
+  //! are stored in single precision to halve the memory (and the memory
+  //! traffic) of this k x n matrix, and are always rounded down so that they
+  //! stay valid lower bounds.
+  arma::fmat lowerBounds;
+
+  //! Round the given distance down to the closest float.
+  static float LowerBound(const double d)
+  {
+    const float f = (float) d;
+    return (f > d) ? std::nextafter(f, -std::numeric_limits<float>::max()) : f;
+  }
 
   //! Track distance calculations.
   size_t distanceCalculations;
@@ -45,9 +45,6 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // being the closest cluster centroid.
   clusterDistances.diag().fill(DBL_MAX);
 
-  // Initially set r(x) to true.
-  std::vector<bool> mustRecalculate(dataset.n_cols, true);
-
   // If this is the first iteration, we must reset all the bounds.
   if (lowerBounds.n_rows != centroids.n_cols)
   {
@@ -78,19 +75,30 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * min(clusterDistances).t();
 
-  // Now loop over all points, and see which ones need to be updated.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Now loop over all points, and see which ones need to be updated.  Each
+  // point only touches its own bounds, so the points are handled in parallel,
+  // and each thread sums its points into its own copy of the new centroids.
+  #pragma omp parallel
   {
-    // Step 2: identify all points such that u(x) <= s(c(x)).
-    if (upperBounds(i) <= minClusterDistances(assignments[i]))
-    {
-      // No change needed.  This point must still belong to that cluster.
-      counts(assignments[i])++;
-      newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-      continue;
-    }
-    else
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    size_t localDistanceCalculations = 0;
+
+    #pragma omp for
+    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
     {
+      // Step 2: identify all points such that u(x) <= s(c(x)).
+      if (upperBounds(i) <= minClusterDistances(assignments[i]))
+      {
+        // No change needed.  This point must still belong to that cluster.
+        localCounts(assignments[i])++;
+        localCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+        continue;
+      }
+
+      // r(x) is true at the start of every iteration.
+      bool mustRecalculate = true;
       for (size_t c = 0; c < centroids.n_cols; ++c)
       {
         // Step 3: for all remaining points x and centers c such that c != c(x),
@@ -107,14 +115,14 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
         // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
         // Otherwise, d(x, c(x)) = u(x).
         double dist;
-        if (mustRecalculate[i])
+        if (mustRecalculate)
         {
-          mustRecalculate[i] = false;
+          mustRecalculate = false;
           dist = distance.Evaluate(dataset.col(i),
                                    centroids.col(assignments[i]));
-          lowerBounds(assignments[i], i) = dist;
+          lowerBounds(assignments[i], i) = LowerBound(dist);
           upperBounds(i) = dist;
-          distanceCalculations++;
+          localDistanceCalculations++;
 
           // Check if we can prune again.
           if (upperBounds(i) <= lowerBounds(c, i))
@@ -135,8 +143,8 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
           // Compute d(x, c).  If d(x, c) < d(x, c(x)) then assign c(x) = c.
           const double pointDist = distance.Evaluate(dataset.col(i),
                                                      centroids.col(c));
-          lowerBounds(c, i) = pointDist;
-          distanceCalculations++;
+          lowerBounds(c, i) = LowerBound(pointDist);
+          localDistanceCalculations++;
           if (pointDist < dist)
           {
             upperBounds(i) = pointDist;
@@ -144,13 +152,21 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
           }
         }
       }
+
+      // At this point, we know the new cluster assignment.
+      // Step 4: for each center c, let m(c) be the mean of the points assigned
+      // to c.
+      localCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+      localCounts[assignments[i]]++;
     }
 
-    // At this point, we know the new cluster assignment.
-    // Step 4: for each center c, let m(c) be the mean of the points assigned to
-    // c.
-    newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-    counts[assignments[i]]++;
+    // Combine the sums of each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+      distanceCalculations += localDistanceCalculations;
+    }
   }
 
   // Now, normalize and calculate the distance each cluster has moved.
@@ -166,13 +182,14 @@ double ElkanKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     distanceCalculations++;
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
   {
     // Step 5: for each point x and center c, assign
     //   l(x, c) = max { l(x, c) - d(c, m(c)), 0 }.
     // But it doesn't actually matter if l(x, c) is positive.
     for (size_t c = 0; c < centroids.n_cols; ++c)
-      lowerBounds(c, i) -= moveDistances(c);
+      lowerBounds(c, i) = LowerBound(lowerBounds(c, i) - moveDistances(c));
 
     // Step 6: for each point x, assign
     //   u(x) = u(x) + d(m(c(x)), c(x))
@@ -28,6 +28,8 @@ class HamerlyKMeans
    * Run a single iteration of Hamerly's algorithm, updating the given centroids
    * into the newCentroids matrix.
    *
+   * The points are processed in parallel with OpenMP, if it is available.
+   *
    * @param centroids Current cluster centroids.
    * @param newCentroids New cluster centroids.
    * @param counts Current counts, to be overwritten with new counts.
@@ -66,63 +66,87 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
     }
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Each point only touches its own bounds, so the points are handled in
+  // parallel, and each thread sums its points into its own copy of the new
+  // centroids.
+  #pragma omp parallel
   {
-    const double m = std::max(minClusterDistances(assignments[i]),
-                              lowerBounds(i));
-
-    // First bound test.
-    if (upperBounds(i) <= m)
-    {
-      ++hamerlyPruned;
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
-
-    // Tighten upper bound.
-    upperBounds(i) = distance.Evaluate(dataset.col(i),
-                                       centroids.col(assignments[i]));
-    ++distanceCalculations;
-
-    // Second bound test.
-    if (upperBounds(i) <= m)
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    size_t localDistanceCalculations = 0;
+    size_t localPruned = 0;
+
+    #pragma omp for
+    for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
     {
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
+      const double m = std::max(minClusterDistances(assignments[i]),
+                                lowerBounds(i));
 
-    // The bounds failed.  So test against all other clusters.
-    // This is Hamerly's Point-All-Ctrs() function from the paper.
-    // We have to reset the lower bound first.
-    lowerBounds(i) = DBL_MAX;
-    for (size_t c = 0; c < centroids.n_cols; ++c)
-    {
-      if (c == assignments[i])
+      // First bound test.
+      if (upperBounds(i) <= m)
+      {
+        ++localPruned;
+        localCentroids.col(assignments[i]) += dataset.col(i);
+        ++localCounts(assignments[i]);
         continue;
+      }
 
-      const double dist = distance.Evaluate(dataset.col(i), centroids.col(c));
+      // Tighten upper bound.
+      upperBounds(i) = distance.Evaluate(dataset.col(i),
+                                         centroids.col(assignments[i]));
+      ++localDistanceCalculations;
 
-      // Is this a better cluster?  At this point, upperBounds[i] = d(i, c(i)).
-      if (dist < upperBounds(i))
+      // Second bound test.
+      if (upperBounds(i) <= m)
       {
-        // lowerBounds holds the second closest cluster.
-        lowerBounds(i) = upperBounds(i);
-        upperBounds(i) = dist;
-        assignments[i] = c;
+        localCentroids.col(assignments[i]) += dataset.col(i);
+        ++localCounts(assignments[i]);
+        continue;
       }
-      else if (dist < lowerBounds(i))
+
+      // The bounds failed.  So test against all other clusters.
+      // This is Hamerly's Point-All-Ctrs() function from the paper.
+      // We have to reset the lower bound first.
+      lowerBounds(i) = DBL_MAX;
+      for (size_t c = 0; c < centroids.n_cols; ++c)
       {
-        // This is a closer second-closest cluster.
-        lowerBounds(i) = dist;
+        if (c == assignments[i])
+          continue;
+
+        const double dist = distance.Evaluate(dataset.col(i),
+            centroids.col(c));
+
+        // Is this a better cluster?  At this point, upperBounds[i] =
+        // d(i, c(i)).
+        if (dist < upperBounds(i))
+        {
+          // lowerBounds holds the second closest cluster.
+          lowerBounds(i) = upperBounds(i);
+          upperBounds(i) = dist;
+          assignments[i] = c;
+        }
+        else if (dist < lowerBounds(i))
+        {
+          // This is a closer second-closest cluster.
+          lowerBounds(i) = dist;
+        }
       }
+      localDistanceCalculations += centroids.n_cols - 1;
+
+      // Update new centroids.
+      localCentroids.col(assignments[i]) += dataset.col(i);
+      ++localCounts(assignments[i]);
     }
-    distanceCalculations += centroids.n_cols - 1;
 
-    // Update new centroids.
-    newCentroids.col(assignments[i]) += dataset.col(i);
-    ++counts(assignments[i]);
+    // Combine the sums of each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+      distanceCalculations += localDistanceCalculations;
+      hamerlyPruned += localPruned;
+    }
   }
 
   // Normalize centroids and calculate cluster movement (contains parts of
@@ -157,7 +181,8 @@ double HamerlyKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
   }
 
   // Now update bounds (lines 3-8 of Update-Bounds()).
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (size_t i = 0; i < (size_t) dataset.n_cols; ++i)
   {
     upperBounds(i) += centroidMovements(assignments[i]);
     if (assignments[i] == furthestMovingCluster)
@@ -17,6 +17,7 @@
 // Include initialization strategies.
 #include "sample_initialization.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "random_partition.hpp"
 
 // Include empty cluster policies.
@@ -29,6 +30,7 @@
 #include "dual_tree_kmeans.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 
 namespace mlpack {
@@ -21,6 +21,7 @@
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
 #include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
@@ -49,7 +50,14 @@ BINDING_LONG_DESC(
     "\n\n"
     "Optionally, the strategy to choose initial centroids can be specified.  "
     "The k-means++ algorithm can be used to choose initial centroids with "
-    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter.  The "
+    "the " + PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter, and the "
+    "k-means|| algorithm (\"Scalable k-means++\", 2012), which needs far fewer "
+    "passes over the data when the number of clusters is large, can be used "
+    "with the " + PRINT_PARAM_STRING("kmeans_parallel") + " parameter; the "
+    "number of sampling rounds is given by " + PRINT_PARAM_STRING("rounds") +
+    " and the expected number of points sampled per round (as a multiple of "
+    "the number of clusters) by " + PRINT_PARAM_STRING("oversampling") + ".  "
+    "The "
     "Bradley and Fayyad approach (\"Refining initial points for k-means "
     "clustering\", 1998) can be used to select initial points by specifying "
     "the " + PRINT_PARAM_STRING("refined_start") + " parameter.  This approach "
@@ -65,8 +73,11 @@ BINDING_LONG_DESC(
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
     "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "algorithm ('dualtree'), the dual-tree k-means algorithm using the "
+    "cover tree ('dualtree-covertree'), and mini-batch k-means ('minibatch'), "
+    "which approximates each iteration with a random sample of 1024 points and "
+    "is useful for very large datasets; when using it, " +
+    PRINT_PARAM_STRING("max_iterations") + " should be set."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -155,10 +166,16 @@ PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
     "choose initial points.", "K");
+PARAM_FLAG("kmeans_parallel", "Use the k-means|| initialization strategy to "
+    "choose initial points.", "L");
+PARAM_INT_IN("rounds", "Number of sampling rounds for k-means|| (use when "
+    "--kmeans_parallel is specified).", "R", 5);
+PARAM_DOUBLE_IN("oversampling", "Oversampling factor for k-means|| (use when "
+    "--kmeans_parallel is specified).", "O", 2.0);
 
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', "
+    "'dualtree-covertree', or 'minibatch').", "a", "naive");
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -190,7 +207,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   else
     RandomSeed((size_t) std::time(NULL));
 
-  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus" }, true,
+  RequireOnlyOnePassed(params, { "refined_start", "kmeans_plus_plus",
+      "kmeans_parallel" }, true,
       "Only one initialization strategy can be specified!", true);
 
   // Now, start building the KMeans type that we'll be using.  Start with the
@@ -214,6 +232,18 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     FindEmptyClusterPolicy<KMeansPlusPlusInitialization>(params, timers,
         KMeansPlusPlusInitialization());
   }
+  else if (params.Has("kmeans_parallel"))
+  {
+    RequireParamValue<int>(params, "rounds", [](int x) { return x > 0; },
+        true, "number of rounds must be positive");
+    RequireParamValue<double>(params, "oversampling",
+        [](double x) { return x > 0.0; }, true, "oversampling factor must be "
+        "positive");
+
+    FindEmptyClusterPolicy<KMeansParallelInitialization>(params, timers,
+        KMeansParallelInitialization(params.Get<int>("rounds"),
+        params.Get<double>("oversampling")));
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(params, timers,
@@ -260,8 +290,8 @@ void FindLloydStepType(util::Params& params,
                        const InitialPartitionPolicy& ipp)
 {
   RequireParamInSet<string>(params, "algorithm", { "elkan", "hamerly",
-      "pelleg-moore", "dualtree", "dualtree-covertree", "naive" }, true,
-      "unknown k-means algorithm");
+      "pelleg-moore", "dualtree", "dualtree-covertree", "naive", "minibatch" },
+      true, "unknown k-means algorithm");
 
   const string algorithm = params.Get<string>("algorithm");
   if (algorithm == "elkan")
@@ -294,6 +324,11 @@ void FindLloydStepType(util::Params& params,
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(params,
         timers, ipp);
   }
+  else if (algorithm == "minibatch")
+  {
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, MiniBatchKMeans>(
+        params, timers, ipp);
+  }
 }
 
 // Given the template parameters, sanitize/load input and run k-means.
@@ -0,0 +1,119 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * This file defines the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Instead of choosing the centroids one at a time like k-means++ (which needs
+ * one pass over the data per centroid), k-means|| makes a small number of
+ * rounds; in each round, every point is chosen as a candidate independently
+ * with probability proportional to its squared distance to the closest
+ * candidate so far, so that about OversamplingFactor() * k candidates are
+ * chosen per round.  Each candidate is then weighted by the number of points
+ * closest to it, and the weighted candidates are reduced to k centroids with
+ * k-means++.  The passes over the data are parallelized with OpenMP.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object, optionally specifying the
+   * number of rounds and the oversampling factor.
+   *
+   * @param rounds Number of sampling rounds.
+   * @param oversamplingFactor Expected number of candidates sampled in each
+   *     round, as a multiple of the number of clusters.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversamplingFactor = 2.0) :
+      rounds(rounds), oversamplingFactor(oversamplingFactor) { }
+
+  /**
+   * Initialize the centroids matrix with the k-means|| strategy.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor.
+  double OversamplingFactor() const { return oversamplingFactor; }
+  //! Modify the oversampling factor.
+  double& OversamplingFactor() { return oversamplingFactor; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(oversamplingFactor));
+  }
+
+ private:
+  /**
+   * Choose the given number of centroids among the given weighted candidates
+   * with k-means++, where the probability of choosing a candidate is
+   * proportional to its weight times its squared distance to the closest
+   * centroid chosen so far.
+   *
+   * @param candidates Candidate points.
+   * @param weights Weight of each candidate.
+   * @param clusters Number of centroids to choose.
+   * @param centroids Matrix to put the centroids into.
+   */
+  static void WeightedKMeansPlusPlus(const arma::mat& candidates,
+                                     const arma::vec& weights,
+                                     const size_t clusters,
+                                     arma::mat& centroids);
+
+  //! The number of sampling rounds.
+  size_t rounds;
+  //! The expected number of candidates per round, divided by k.
+  double oversamplingFactor;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
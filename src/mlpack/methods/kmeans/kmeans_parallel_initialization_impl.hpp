@@ -0,0 +1,148 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| initialization strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  const size_t n = data.n_cols;
+
+  // The indices of the points chosen as candidates; the first one is chosen
+  // fully randomly.
+  std::vector<size_t> chosen;
+  chosen.push_back(RandInt(0, n));
+
+  // The squared distance between each point and its closest candidate, and the
+  // index of that candidate.
+  arma::vec distances(n);
+  distances.fill(std::numeric_limits<double>::max());
+  arma::Col<size_t> closest(n, arma::fill::zeros);
+
+  size_t updated = 0;
+  for (size_t round = 0; round <= rounds; ++round)
+  {
+    // Update the distances with the candidates chosen in the last round.
+    const size_t numChosen = chosen.size();
+    double cost = 0.0;
+    #pragma omp parallel for reduction(+:cost)
+    for (size_t p = 0; p < n; ++p)
+    {
+      for (size_t j = updated; j < numChosen; ++j)
+      {
+        const double distance = SquaredEuclideanDistance::Evaluate(
+            data.col(p), data.col(chosen[j]));
+        if (distance < distances[p])
+        {
+          distances[p] = distance;
+          closest[p] = j;
+        }
+      }
+
+      cost += distances[p];
+    }
+    updated = numChosen;
+
+    // After the last round, only the distances are needed.
+    if (round == rounds || cost == 0.0)
+      break;
+
+    // Choose each point independently with probability proportional to its
+    // distance.  Points that are already candidates have distance 0, so they
+    // can't be chosen again.
+    const double l = oversamplingFactor * (double) clusters;
+    const arma::vec samples(n, arma::fill::randu);
+    for (size_t p = 0; p < n; ++p)
+      if (samples[p] * cost < l * distances[p])
+        chosen.push_back(p);
+  }
+
+  // Weight each candidate by the number of points closest to it.
+  arma::vec weights(chosen.size(), arma::fill::zeros);
+  for (size_t p = 0; p < n; ++p)
+    weights[closest[p]] += 1.0;
+
+  arma::mat candidates(data.n_rows, chosen.size());
+  for (size_t j = 0; j < chosen.size(); ++j)
+    candidates.col(j) = data.col(chosen[j]);
+
+  Log::Info << "KMeansParallelInitialization::Cluster(): chose "
+      << chosen.size() << " candidates." << std::endl;
+
+  if (candidates.n_cols <= clusters)
+  {
+    // There are not enough candidates (this can happen if the dataset has few
+    // distinct points), so take all of them and fill the rest randomly.
+    centroids.set_size(data.n_rows, clusters);
+    centroids.cols(0, candidates.n_cols - 1) = candidates;
+    for (size_t i = candidates.n_cols; i < clusters; ++i)
+      centroids.col(i) = data.col(RandInt(0, n));
+  }
+  else
+  {
+    WeightedKMeansPlusPlus(candidates, weights, clusters, centroids);
+  }
+}
+
+inline void KMeansParallelInitialization::WeightedKMeansPlusPlus(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids)
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Choose the first centroid with probability proportional to its weight.
+  double sampleValue = Random() * arma::accu(weights);
+  size_t position = 0;
+  double cumulative = weights[0];
+  while (cumulative < sampleValue && position < candidates.n_cols - 1)
+    cumulative += weights[++position];
+  centroids.col(0) = candidates.col(position);
+
+  arma::vec distances(candidates.n_cols);
+  distances.fill(std::numeric_limits<double>::max());
+  for (size_t i = 1; i < clusters; ++i)
+  {
+    double total = 0.0;
+    #pragma omp parallel for reduction(+:total)
+    for (size_t p = 0; p < (size_t) candidates.n_cols; ++p)
+    {
+      const double distance = SquaredEuclideanDistance::Evaluate(
+          candidates.unsafe_col(p), centroids.unsafe_col(i - 1));
+      if (distance < distances[p])
+        distances[p] = distance;
+      total += weights[p] * distances[p];
+    }
+
+    sampleValue = Random() * total;
+    position = 0;
+    cumulative = weights[0] * distances[0];
+    while (cumulative < sampleValue && position < candidates.n_cols - 1)
+    {
+      ++position;
+      cumulative += weights[position] * distances[position];
+    }
+
+    centroids.col(i) = candidates.col(position);
+  }
+}
+
+} // namespace mlpack
+
+#endif
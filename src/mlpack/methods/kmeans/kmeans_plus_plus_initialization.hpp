@@ -35,6 +35,11 @@ namespace mlpack {
  * In accordance with mlpack's InitialPartitionPolicy template type, we only
  * need to implement a constructor and a method to compute the initial
  * centroids.
+ *
+ * The distances between the points and the centroids chosen so far are
+ * updated in parallel with OpenMP.  For large numbers of clusters, the
+ * KMeansParallelInitialization (k-means||) strategy needs far fewer passes over
+ * the data.
  */
 class KMeansPlusPlusInitialization
 {
@@ -61,46 +66,34 @@ class KMeansPlusPlusInitialization
     size_t firstPoint = RandInt(0, data.n_cols);
     centroids.col(0) = data.col(firstPoint);
 
-    // Utility variable.
-    arma::vec distribution(data.n_cols);
+    // The squared distance between each point and its closest
+    // already-chosen centroid.  This is updated with each new centroid, so each
+    // point only needs to be compared with one centroid per iteration.
+    arma::vec distances(data.n_cols);
+    distances.fill(std::numeric_limits<double>::max());
 
     // Now, sample other points...
     for (size_t i = 1; i < clusters; ++i)
     {
-      // We must compute the CDF for sampling... this depends on the computation
-      // of the minimum distance between each point and its closest
-      // already-chosen centroid.
-      //
-      // This computation is ripe for speedup with trees!  I am not sure exactly
-      // how much we would need to approximate, but I think it could be done
-      // without breaking the O(log k)-competitive guarantee (I think).
-      for (size_t p = 0; p < data.n_cols; ++p)
+      // Update the distances with the last chosen centroid, in parallel.
+      double total = 0.0;
+      #pragma omp parallel for reduction(+:total)
+      for (size_t p = 0; p < (size_t) data.n_cols; ++p)
       {
-        double minDistance = std::numeric_limits<double>::max();
-        for (size_t j = 0; j < i; ++j)
-        {
-          const double distance = SquaredEuclideanDistance::Evaluate(
-              data.col(p), centroids.col(j));
-          minDistance = std::min(distance, minDistance);
-        }
-
-        distribution[p] = minDistance;
+        const double distance = SquaredEuclideanDistance::Evaluate(
+            data.col(p), centroids.unsafe_col(i - 1));
+        if (distance < distances[p])
+          distances[p] = distance;
+        total += distances[p];
       }
 
-      // Next normalize the distribution (actually technically we could avoid
-      // this).
-      distribution /= accu(distribution);
-
-      // Turn it into a CDF for convenience...
-      for (size_t j = 1; j < distribution.n_elem; ++j)
-        distribution[j] += distribution[j - 1];
+      // Sample a point with probability proportional to its distance.
+      const double sampleValue = Random() * total;
+      size_t position = 0;
+      double cumulative = distances[0];
+      while (cumulative < sampleValue && position < data.n_cols - 1)
+        cumulative += distances[++position];
 
-      // Sample a point...
-      const double sampleValue = Random();
-      const double* elem = std::lower_bound(distribution.begin(),
-          distribution.end(), sampleValue);
-      const size_t position = (size_t)
-          (elem - distribution.begin()) / sizeof(double);
       centroids.col(i) = data.col(position);
     }
   }
@@ -0,0 +1,121 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of mini-batch k-means, which approximates each Lloyd
+ * iteration with a small random sample of the dataset.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * An implementation of the mini-batch k-means algorithm of Sculley (2010),
+ * which can be used as the LloydStepType of the KMeans class.  Instead of
+ * assigning every point of the dataset in each iteration, each call to
+ * Iterate() draws a random minibatch of BatchSize() points, assigns them to
+ * their closest centroids, and moves each centroid towards the points assigned
+ * to it with a per-centroid learning rate of 1 / (number of points the
+ * centroid has been assigned so far).  Each iteration thus takes
+ * O(BatchSize() * k) time regardless of the size of the dataset, but the
+ * result is only an approximation of the result of Lloyd's algorithm.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, D.},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Because only the sampled columns of the dataset are read in each iteration,
+ * this can be used on datasets that do not fit in memory, by giving KMeans an
+ * Armadillo matrix that uses memory-mapped memory (with the advanced
+ * constructor `arma::mat(ptr, rows, cols, false, true)`); the operating system
+ * then only needs to read the pages of the sampled points.  In that case, use
+ * the KMeans::Cluster() overload that does not compute assignments, use
+ * AllowEmptyClusters (the other empty cluster policies pass over the whole
+ * dataset), and give an initial partition policy that does not pass over the
+ * whole dataset, such as SampleInitialization.
+ *
+ * The cumulative number of points assigned to each centroid is kept between
+ * iterations and returned as the counts; a centroid that has not been assigned
+ * any sampled point yet is reported as empty.  Since the centroids keep moving
+ * slightly, the maximum number of iterations of KMeans should be set.
+ *
+ * @tparam DistanceType Type of distance metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename DistanceType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and distance
+   * metric.
+   *
+   * @param dataset Dataset.
+   * @param distance Instantiated distance metric.
+   * @param batchSize Number of points to sample in each iteration.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  DistanceType& distance,
+                  const size_t batchSize = 1024);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points assigned to each cluster over all
+   *     iterations so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of points sampled in each iteration.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled in each iteration.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated distance metric.
+  DistanceType& distance;
+  //! The number of points sampled in each iteration.
+  size_t batchSize;
+
+  //! The number of points assigned to each centroid so far.
+  arma::Col<size_t> totalCounts;
+  //! The points of the current minibatch.
+  arma::Col<size_t> batch;
+  //! The closest centroid to each point of the current minibatch.
+  arma::Col<size_t> batchAssignments;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
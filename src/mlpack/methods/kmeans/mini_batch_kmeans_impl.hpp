@@ -0,0 +1,122 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of mini-batch k-means iterations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+
+template<typename DistanceType, typename MatType>
+MiniBatchKMeans<DistanceType, MatType>::MiniBatchKMeans(
+    const MatType& dataset,
+    DistanceType& distance,
+    const size_t batchSize) :
+    dataset(dataset),
+    distance(distance),
+    batchSize(batchSize),
+    distanceCalculations(0)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("MiniBatchKMeans::MiniBatchKMeans(): batch "
+        "size must be greater than 0!");
+  }
+}
+
+// Run a single iteration.
+template<typename DistanceType, typename MatType>
+double MiniBatchKMeans<DistanceType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  if (totalCounts.n_elem != centroids.n_cols)
+    totalCounts.zeros(centroids.n_cols);
+
+  // Sample the minibatch (with replacement).  This is done serially so that
+  // the results only depend on the random seed.  RandInt() is not used because
+  // the dataset may have more points than an int can hold.
+  const size_t n = dataset.n_cols;
+  const size_t numSamples = std::min(batchSize, n);
+  batch.set_size(numSamples);
+  batchAssignments.set_size(numSamples);
+  for (size_t i = 0; i < numSamples; ++i)
+    batch[i] = std::min((size_t) (Random() * (double) n), n - 1);
+
+  // Find the closest centroid to each sampled point.
+  #pragma omp parallel for
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double dist = distance.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (dist < minDistance)
+      {
+        minDistance = dist;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    batchAssignments[i] = closestCluster;
+  }
+  distanceCalculations += centroids.n_cols * numSamples;
+
+  // Moving a centroid c that has been assigned v points so far towards each new
+  // point x with the learning rate 1 / (v + 1) is the same as setting it to the
+  // mean of the v points it had and the new points, so the update is done with
+  // one sum per centroid.
+  arma::mat sums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+  arma::Col<size_t> batchCounts(centroids.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < numSamples; ++i)
+  {
+    sums.unsafe_col(batchAssignments[i]) += dataset.col(batch[i]);
+    batchCounts[batchAssignments[i]]++;
+  }
+
+  newCentroids.set_size(centroids.n_rows, centroids.n_cols);
+  for (size_t j = 0; j < centroids.n_cols; ++j)
+  {
+    if (batchCounts[j] == 0)
+    {
+      newCentroids.col(j) = centroids.col(j);
+      continue;
+    }
+
+    const double total = (double) (totalCounts[j] + batchCounts[j]);
+    newCentroids.col(j) = (((double) totalCounts[j]) * centroids.col(j) +
+        sums.col(j)) / total;
+    totalCounts[j] += batchCounts[j];
+  }
+
+  counts = totalCounts;
+
+  // Calculate cluster distortion for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(distance.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace mlpack
+
+#endif
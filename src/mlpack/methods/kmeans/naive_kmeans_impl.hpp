@@ -40,7 +40,7 @@ double NaiveKMeans<DistanceType, MatType>::Iterate(const arma::mat& centroids,
 
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  #pragma omp parallel num_threads(Parallel::Threads())
   {
     // The current state of the K-means is private for each thread
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
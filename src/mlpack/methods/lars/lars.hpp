@@ -692,12 +692,6 @@ class LARS
    */
   void Ignore(const size_t varInd);
 
-  // Compute "equiangular" direction in output space.
-  template<typename MatType, typename VecType>
-  void ComputeYHatDirection(const MatType& matX,
-                            const VecType& betaDirection,
-                            VecType& yHatDirection);
-
   // Interpolate to compute last solution vector.
   void InterpolateBeta();
 
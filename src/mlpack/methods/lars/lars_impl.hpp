@@ -483,6 +483,7 @@ LARS<ModelMatType>::Train(const MatType& matX,
   isActive.clear();
   ignoreSet.clear();
   isIgnored.clear();
+  interceptPath.clear();
   matUtriCholFactor.reset();
   selectedBeta.clear();
 
@@ -572,10 +573,8 @@ LARS<ModelMatType>::Train(const MatType& matX,
   // Set up ignores set variables. Initialized empty.
   isIgnored.resize(dataRef.n_cols, false);
 
-  // Initialize yHat and beta.
+  // Initialize beta.
   arma::Col<ElemType> beta(dataRef.n_cols, arma::fill::zeros);
-  arma::Col<ElemType> yHat(dataRef.n_rows, arma::fill::zeros);
-  arma::Col<ElemType> yHatDirection(dataRef.n_rows, arma::fill::none);
 
   bool lassocond = false;
 
@@ -606,6 +605,10 @@ LARS<ModelMatType>::Train(const MatType& matX,
     else
       interceptPath.push_back(0.0);
 
+    // The solution is the zero vector.
+    selectedLambda1 = lambda1;
+    selectedIndex = 0;
+
     return maxCorr;
   }
 
@@ -782,8 +785,14 @@ LARS<ModelMatType>::Train(const MatType& matX,
       }
     }
 
-    // compute "equiangular" direction in output space
-    ComputeYHatDirection(dataRef, betaDirection, yHatDirection);
+    // Compute the correlations of all dimensions with the "equiangular"
+    // direction in output space, X^T X_A betaDirection.  This only needs the
+    // active columns of the Gram matrix, so the data itself is not touched.
+    // (If lambda2 * I was added to the Gram matrix, only the entries of the
+    // active dimensions are affected, and those are not used.)
+    const arma::uvec activeIndices = ConvTo<arma::uvec>::From(activeSet);
+    const arma::Col<ElemType> dirCorrs = matGram->cols(activeIndices) *
+        betaDirection;
 
     ElemType gamma = maxCorr / normalization;
 
@@ -796,7 +805,7 @@ LARS<ModelMatType>::Train(const MatType& matX,
         if (isActive[ind] || isIgnored[ind])
           continue;
 
-        const ElemType dirCorr = dot(dataRef.col(ind), yHatDirection);
+        const ElemType dirCorr = dirCorrs(ind);
         const ElemType val1 = (maxCorr - corr(ind)) / (normalization - dirCorr);
         const ElemType val2 = (maxCorr + corr(ind)) / (normalization + dirCorr);
 
@@ -847,9 +856,6 @@ LARS<ModelMatType>::Train(const MatType& matX,
       }
     }
 
-    // Update the prediction.
-    yHat += gamma * yHatDirection;
-
     // Update the estimator.
     for (size_t i = 0; i < activeSet.size(); ++i)
     {
@@ -876,8 +882,14 @@ LARS<ModelMatType>::Train(const MatType& matX,
       Deactivate(changeInd);
     }
 
-    corr = vecXTy - trans(dataRef) * yHat;
-    if (elasticNet)
+    // The correlations are X^T (y - X beta) = X^T y - (X^T X) beta, and beta
+    // is only nonzero on the active set.  When the Cholesky decomposition is
+    // not used, lambda2 * I is already part of the Gram matrix for the elastic
+    // net.
+    const arma::uvec newActiveIndices = ConvTo<arma::uvec>::From(activeSet);
+    corr = vecXTy - matGram->cols(newActiveIndices) *
+        beta.elem(newActiveIndices);
+    if (elasticNet && useCholesky)
       corr -= lambda2 * beta;
 
     ElemType curLambda = 0;
@@ -1140,18 +1152,6 @@ inline void LARS<ModelMatType>::Ignore(const size_t varInd)
   ignoreSet.push_back(varInd);
 }
 
-template<typename ModelMatType>
-template<typename MatType, typename VecType>
-inline void LARS<ModelMatType>::ComputeYHatDirection(
-    const MatType& matX,
-    const VecType& betaDirection,
-    VecType& yHatDirection)
-{
-  yHatDirection.fill(0);
-  for (size_t i = 0; i < activeSet.size(); ++i)
-    yHatDirection += betaDirection(i) * matX.col(activeSet[i]);
-}
-
 template<typename ModelMatType>
 inline void LARS<ModelMatType>::InterpolateBeta()
 {
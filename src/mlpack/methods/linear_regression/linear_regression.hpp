@@ -84,10 +84,10 @@ class LinearRegression
 
   /**
    * Train the LinearRegression model on the given data. Careful! This will
-   * completely ignore and overwrite the existing model. This particular
-   * implementation does not have an incremental training algorithm.  To set the
-   * regularization parameter lambda, call Lambda() or set a different value in
-   * the constructor.
+   * completely ignore and overwrite the existing model; to add data to an
+   * existing model, use `Update()` instead.  To set the regularization
+   * parameter lambda, call Lambda() or set a different value in the
+   * constructor.
    *
    * This version of `Train()` is deprecated and will be removed in mlpack
    * 5.0.0.  Use the version of `Train()` that specifies `lambda` before
@@ -107,10 +107,10 @@ class LinearRegression
 
   /**
    * Train the LinearRegression model on the given data and instance weights.
-   * Careful!  This will completely ignore and overwrite the existing model.
-   * This particular implementation does not have an incremental training
-   * algorithm.  To set the regularization parameter lambda, call Lambda() or
-   * set a different value in the constructor.
+   * Careful!  This will completely ignore and overwrite the existing model;
+   * to add data to an existing model, use `Update()` instead.  To set the
+   * regularization parameter lambda, call Lambda() or set a different value in
+   * the constructor.
    *
    * This version of `Train()` is deprecated and will be removed in mlpack
    * 5.0.0.  Use the version of `Train()` that specifies `lambda` before
@@ -141,10 +141,10 @@ class LinearRegression
 
   /**
    * Train the LinearRegression model on the given data and weights. Careful!
-   * This will completely ignore and overwrite the existing model. This
-   * particular implementation does not have an incremental training algorithm.
-   * To set the regularization parameter lambda, call Lambda() or set a
-   * different value in the constructor.
+   * This will completely ignore and overwrite the existing model; to add data
+   * to an existing model, use `Update()` instead.  To set the regularization
+   * parameter lambda, call Lambda() or set a different value in the
+   * constructor.
    *
    * @param predictors X, the matrix of data points to train the model on.
    * @param responses y, the responses to the data points.
@@ -175,10 +175,10 @@ class LinearRegression
 
   /**
    * Train the LinearRegression model on the given data and instance weights.
-   * Careful!  This will completely ignore and overwrite the existing model.
-   * This particular implementation does not have an incremental training
-   * algorithm.  To set the regularization parameter lambda, call Lambda() or
-   * set a different value in the constructor.
+   * Careful!  This will completely ignore and overwrite the existing model;
+   * to add data to an existing model, use `Update()` instead.  To set the
+   * regularization parameter lambda, call Lambda() or set a different value in
+   * the constructor.
    *
    * @param predictors X, the matrix of data points to train the model on.
    * @param responses y, the responses to the data points.
@@ -202,6 +202,40 @@ class LinearRegression
                  const std::optional<double> lambda = std::nullopt,
                  const std::optional<bool> intercept = std::nullopt);
 
+  /**
+   * Update the model with a new batch of data, without access to the data the
+   * model was trained on before.  The sums X X^T and X y^T of the normal
+   * equations are kept from `Train()` and earlier calls to `Update()`, so the
+   * batch is added to them and the model is solved again; the result is the
+   * same as training on all the batches at once.  The data can thus be given
+   * chunk by chunk (e.g. as it is read from a file) and never be fully in
+   * memory.  With OpenMP, the sums of large batches are computed in parallel.
+   *
+   * The current values of `Lambda()` and `Intercept()` are used; the
+   * intercept setting must not change between calls.  If the model was not
+   * trained before, the first call to `Update()` trains it.
+   *
+   * @param predictors X, the matrix of new data points.
+   * @param responses y, the responses to the new data points.
+   * @return The least squares error on the new batch after the update.
+   */
+  template<typename MatType, typename ResponsesType>
+  ElemType Update(const MatType& predictors, const ResponsesType& responses);
+
+  /**
+   * Update the model with a new batch of data and instance weights, as with
+   * the unweighted `Update()`.
+   *
+   * @param predictors X, the matrix of new data points.
+   * @param responses y, the responses to the new data points.
+   * @param weights Instance weights of the new data points.
+   * @return The least squares error on the new batch after the update.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  ElemType Update(const MatType& predictors,
+                  const ResponsesType& responses,
+                  const WeightsType& weights);
+
   /**
    * Calculate y_i for a single data point.
    *
@@ -260,6 +294,46 @@ class LinearRegression
   void serialize(Archive& ar, const uint32_t version);
 
  private:
+  /**
+   * Add the normal equations of the given batch to `gram` and
+   * `responseProducts`, splitting the batch into blocks that are handled in
+   * parallel.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  void Accumulate(const MatType& predictors,
+                  const ResponsesType& responses,
+                  const WeightsType& weights);
+
+  //! Solve the accumulated normal equations for the parameters.
+  void Solve();
+
+  /**
+   * Compute the matrix and the right-hand side of the normal equations
+   * (X X^T + lambda I) B = X y^T, where X holds the predictors (with a row of
+   * ones first if an intercept is fitted), scaled by the square root of the
+   * weights if given.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  std::enable_if_t<!arma::is_SpMat<MatType>::value> NormalEquations(
+      const MatType& predictors,
+      const ResponsesType& responses,
+      const WeightsType& weights,
+      arma::Mat<ElemType>& cov,
+      arma::Col<ElemType>& rhs) const;
+
+  /**
+   * Compute the normal equations for sparse predictors.  The predictors are
+   * never converted to a dense matrix: the intercept row and column of X X^T
+   * are computed separately, so only the d x d products are dense.
+   */
+  template<typename MatType, typename ResponsesType, typename WeightsType>
+  std::enable_if_t<arma::is_SpMat<MatType>::value> NormalEquations(
+      const MatType& predictors,
+      const ResponsesType& responses,
+      const WeightsType& weights,
+      arma::Mat<ElemType>& cov,
+      arma::Col<ElemType>& rhs) const;
+
   /**
    * The calculated B.
    * Initialized and filled by constructor to hold the least squares solution.
@@ -274,12 +348,21 @@ class LinearRegression
 
   //! Indicates whether first parameter is intercept.
   bool intercept;
+
+  //! The accumulated X X^T of all the training data (without regularization).
+  arma::Mat<ElemType> gram;
+
+  //! The accumulated X y^T of all the training data.
+  arma::Col<ElemType> responseProducts;
+
+  //! Number of points in a block of the accumulation.
+  static constexpr size_t AccumulateBlockSize = 4096;
 };
 
 } // namespace mlpack
 
 CEREAL_TEMPLATE_CLASS_VERSION((typename ModelMatType),
-    (mlpack::LinearRegression<ModelMatType>), (1));
+    (mlpack::LinearRegression<ModelMatType>), (2));
 
 // Include implementation.
 #include "linear_regression_impl.hpp"
@@ -137,36 +137,58 @@ LinearRegression<ModelMatType>::Train(const MatType& predictors,
   // Sanity check on data.
   util::CheckSameSizes(predictors, responses, "LinearRegression::Train()");
 
-  const size_t nCols = predictors.n_cols;
+  // Forget the sums of any earlier training data.
+  const size_t dims = predictors.n_rows + (this->intercept ? 1 : 0);
+  gram.zeros(dims, dims);
+  responseProducts.zeros(dims);
 
-  // TODO: avoid copy if possible.
-  arma::Mat<ElemType> p = ConvTo<arma::Mat<ElemType>>::From(predictors);
-  arma::Row<ElemType> r = responses;
+  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
+  // (assuming the SVD is used to solve it)
+  Accumulate(predictors, responses, weights);
+  Solve();
+  return ComputeError(predictors, responses);
+}
 
-  // Here we add the row of ones to the predictors.
-  // The intercept is not penalized. Add an "all ones" row to design and set
-  // intercept = false to get a penalized intercept.
-  if (this->intercept)
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType>
+inline
+typename LinearRegression<ModelMatType>::ElemType
+LinearRegression<ModelMatType>::Update(const MatType& predictors,
+                                       const ResponsesType& responses)
+{
+  return Update(predictors, responses,
+      arma::Row<typename ResponsesType::elem_type>());
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+inline
+typename LinearRegression<ModelMatType>::ElemType
+LinearRegression<ModelMatType>::Update(const MatType& predictors,
+                                       const ResponsesType& responses,
+                                       const WeightsType& weights)
+{
+  util::CheckSameSizes(predictors, responses, "LinearRegression::Update()");
+
+  const size_t dims = predictors.n_rows + (this->intercept ? 1 : 0);
+  if (gram.n_elem == 0)
   {
-    p.insert_rows(0, ones<arma::Mat<ElemType>>(1, nCols));
+    gram.zeros(dims, dims);
+    responseProducts.zeros(dims);
   }
-
-  if (weights.n_elem > 0)
+  else if (gram.n_rows != dims)
   {
-    p = p * diagmat(sqrt(weights));
-    r = sqrt(weights) % responses;
+    std::ostringstream oss;
+    oss << "LinearRegression::Update(): the model was trained on "
+        << (this->intercept ? gram.n_rows - 1 : gram.n_rows) << "-dimensional "
+        << "data" << (this->intercept ? " with an intercept" : "") << ", but "
+        << "the new data has " << predictors.n_rows << " dimensions (was the "
+        << "intercept setting changed?)!";
+    throw std::invalid_argument(oss.str());
   }
 
-  // Convert to this form:
-  // a * (X X^T) = y X^T.
-  // Then we'll use Armadillo to solve it.
-  // The total runtime of this should be O(d^2 N) + O(d^3) + O(dN).
-  // (assuming the SVD is used to solve it)
-  arma::Mat<ElemType> cov = p * p.t() +
-      ((ElemType) this->lambda) *
-      arma::eye<arma::Mat<ElemType>>(p.n_rows, p.n_rows);
-
-  parameters = arma::solve(cov, p * r.t());
+  Accumulate(predictors, responses, weights);
+  Solve();
   return ComputeError(predictors, responses);
 }
 
@@ -294,6 +316,157 @@ void LinearRegression<ModelMatType>::serialize(Archive& ar,
 
   ar(CEREAL_NVP(lambda));
   ar(CEREAL_NVP(intercept));
+
+  // Older versions did not keep the sums needed by Update().
+  if (version >= 2)
+  {
+    ar(CEREAL_NVP(gram));
+    ar(CEREAL_NVP(responseProducts));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    gram.clear();
+    responseProducts.clear();
+  }
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+inline void LinearRegression<ModelMatType>::Accumulate(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const WeightsType& weights)
+{
+  typedef typename MatType::elem_type InElemType;
+  typedef typename std::conditional<arma::is_SpMat<MatType>::value,
+      arma::SpMat<InElemType>, arma::Mat<InElemType>>::type BlockType;
+  typedef arma::Row<typename ResponsesType::elem_type> ResponsesBlockType;
+  typedef arma::Row<typename WeightsType::elem_type> WeightsBlockType;
+
+  const size_t numBlocks = std::max((size_t) 1,
+      (size_t) (predictors.n_cols / AccumulateBlockSize));
+  if (numBlocks == 1)
+  {
+    arma::Mat<ElemType> blockGram;
+    arma::Col<ElemType> blockProducts;
+    NormalEquations(predictors, responses, weights, blockGram, blockProducts);
+    gram += blockGram;
+    responseProducts += blockProducts;
+    return;
+  }
+
+  // Each block gets its own normal equations, which are then summed.
+  #pragma omp parallel for
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * predictors.n_cols / numBlocks;
+    const size_t end = (b + 1) * predictors.n_cols / numBlocks;
+
+    const BlockType block = predictors.cols(begin, end - 1);
+    const ResponsesBlockType blockResponses = responses.cols(begin, end - 1);
+    const WeightsBlockType blockWeights = (weights.n_elem == 0) ?
+        WeightsBlockType() : WeightsBlockType(weights.cols(begin, end - 1));
+
+    arma::Mat<ElemType> blockGram;
+    arma::Col<ElemType> blockProducts;
+    NormalEquations(block, blockResponses, blockWeights, blockGram,
+        blockProducts);
+
+    #pragma omp critical(linear_regression_accumulate)
+    {
+      gram += blockGram;
+      responseProducts += blockProducts;
+    }
+  }
+}
+
+template<typename ModelMatType>
+inline void LinearRegression<ModelMatType>::Solve()
+{
+  arma::Mat<ElemType> cov = gram;
+  cov.diag() += (ElemType) this->lambda;
+  parameters = arma::solve(cov, responseProducts);
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+inline std::enable_if_t<!arma::is_SpMat<MatType>::value>
+LinearRegression<ModelMatType>::NormalEquations(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const WeightsType& weights,
+    arma::Mat<ElemType>& cov,
+    arma::Col<ElemType>& rhs) const
+{
+  const size_t nCols = predictors.n_cols;
+
+  // TODO: avoid copy if possible.
+  arma::Mat<ElemType> p = ConvTo<arma::Mat<ElemType>>::From(predictors);
+  arma::Row<ElemType> r = responses;
+
+  // Here we add the row of ones to the predictors.
+  // The intercept is not penalized. Add an "all ones" row to design and set
+  // intercept = false to get a penalized intercept.
+  if (this->intercept)
+  {
+    p.insert_rows(0, ones<arma::Mat<ElemType>>(1, nCols));
+  }
+
+  if (weights.n_elem > 0)
+  {
+    p = p * diagmat(sqrt(weights));
+    r = sqrt(weights) % responses;
+  }
+
+  // Convert to this form:
+  // a * (X X^T) = y X^T.
+  // Then we'll use Armadillo to solve it.
+  cov = p * p.t();
+  rhs = p * r.t();
+}
+
+template<typename ModelMatType>
+template<typename MatType, typename ResponsesType, typename WeightsType>
+inline std::enable_if_t<arma::is_SpMat<MatType>::value>
+LinearRegression<ModelMatType>::NormalEquations(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const WeightsType& weights,
+    arma::Mat<ElemType>& cov,
+    arma::Col<ElemType>& rhs) const
+{
+  typedef arma::SpMat<ElemType> SpMatType;
+
+  // The (square root of the) weight of each point; this is also the intercept
+  // row of the scaled predictors.
+  arma::Row<ElemType> w = (weights.n_elem > 0) ?
+      arma::Row<ElemType>(sqrt(arma::Row<ElemType>(weights))) :
+      arma::ones<arma::Row<ElemType>>(predictors.n_cols);
+  const arma::Row<ElemType> r = w % arma::Row<ElemType>(responses);
+
+  SpMatType p = arma::conv_to<SpMatType>::from(predictors);
+  if (weights.n_elem > 0)
+  {
+    SpMatType scale(predictors.n_cols, predictors.n_cols);
+    scale.diag() = w.t();
+    p = p * scale;
+  }
+
+  const size_t offset = this->intercept ? 1 : 0;
+  cov.set_size(p.n_rows + offset, p.n_rows + offset);
+  rhs.set_size(p.n_rows + offset);
+  cov.submat(offset, offset, cov.n_rows - 1, cov.n_cols - 1) =
+      arma::Mat<ElemType>(p * p.t());
+  rhs.subvec(offset, rhs.n_elem - 1) = p * r.t();
+
+  if (this->intercept)
+  {
+    const arma::Col<ElemType> pw = p * w.t();
+    cov(0, 0) = dot(w, w);
+    cov.submat(1, 0, cov.n_rows - 1, 0) = pw;
+    cov.submat(0, 1, 0, cov.n_cols - 1) = pw.t();
+    rhs(0) = dot(w, r);
+  }
 }
 
 } // namespace mlpack
@@ -346,6 +346,23 @@ class LinearSVM
   void Classify(const MatType& data,
                 arma::Row<size_t>& labels) const;
 
+  /**
+   * Classify the given points, stored contiguously in column-major order (like
+   * the memory of an Armadillo matrix with FeatureSize() rows), storing the
+   * predicted labels in `labels`.  This does not allocate memory and does not
+   * check its inputs, so it is suited to low-latency prediction of single
+   * points or small batches; the model must be trained.
+   *
+   * @param points Pointer to the `numPoints * FeatureSize()` elements of the
+   *     points.
+   * @param numPoints Number of points to classify.
+   * @param labels Preallocated array of `numPoints` labels to store the
+   *     predictions in.
+   */
+  void Classify(const ElemType* points,
+                const size_t numPoints,
+                size_t* labels) const noexcept;
+
   /**
    * Classify the given points, returning class scores and predicted
    * class label for each point.
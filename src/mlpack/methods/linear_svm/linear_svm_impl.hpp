@@ -255,6 +255,34 @@ void LinearSVM<ModelMatType>::Classify(
       arma::index_max(scores));
 }
 
+template<typename ModelMatType>
+void LinearSVM<ModelMatType>::Classify(const ElemType* points,
+                                       const size_t numPoints,
+                                       size_t* labels) const noexcept
+{
+  const size_t dimensionality = FeatureSize();
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const ElemType* point = points + i * dimensionality;
+    ElemType maxScore = -std::numeric_limits<ElemType>::infinity();
+    labels[i] = 0;
+    for (size_t j = 0; j < parameters.n_cols; ++j)
+    {
+      // The intercept, if any, is the last row of the parameters.
+      const ElemType* w = parameters.colptr(j);
+      ElemType score = fitIntercept ? w[dimensionality] : ElemType(0);
+      for (size_t d = 0; d < dimensionality; ++d)
+        score += w[d] * point[d];
+
+      if (score > maxScore)
+      {
+        maxScore = score;
+        labels[i] = j;
+      }
+    }
+  }
+}
+
 template<typename ModelMatType>
 void LinearSVM<ModelMatType>::Classify(
     const arma::mat& data,
@@ -225,6 +225,19 @@ class Constraints
   */
   inline void Precalculate(const LabelsType& labels);
 
+  /**
+  * Calculate the k impostors of the given points, which must all have the
+  * unique label with the given index.  If there are few points, they are
+  * compared with every differently labeled point in parallel, instead of
+  * building a tree.
+  */
+  inline void SearchImpostors(UMatType& neighbors,
+                              MatType& distances,
+                              const MatType& dataset,
+                              const VecType& norms,
+                              const size_t labelIndex,
+                              const UVecType& queries);
+
   /**
   * Re-order neighbors on the basis of increasing norm in case
   * of ties among distances.
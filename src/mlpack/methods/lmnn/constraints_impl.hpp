@@ -249,12 +249,8 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  MatType subDataset = dataset.cols(begin, begin + batchSize - 1);
   LabelsType sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
   UMatType neighbors;
   MatType distances;
 
@@ -265,19 +261,11 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   {
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-    // Perform KNN search with differently labeled points as reference
-    // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(subDataset.cols(subIndexSame), k, neighbors, distances);
-
-    // Re-order neighbors on the basis of increasing norm in case
-    // of ties among distances.
-    ReorderResults(distances, neighbors, norms);
-
-    // Re-map neighbors to their index.
-    for (size_t j = 0; j < neighbors.n_elem; ++j)
-      neighbors(j) = indexDiff[i].at(neighbors(j));
+    SearchImpostors(neighbors, distances, dataset, norms, i,
+        begin + subIndexSame);
 
     // Store impostors.
     outputMatrix.cols(begin + subIndexSame) = neighbors;
@@ -299,12 +287,8 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  MatType subDataset = dataset.cols(begin, begin + batchSize - 1);
   LabelsType sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
-
   UMatType neighbors;
   MatType distances;
 
@@ -315,19 +299,11 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   {
     // Calculate impostors.
     subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-    // Perform KNN search with differently labeled points as reference
-    // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(subDataset.cols(subIndexSame), k, neighbors, distances);
-
-    // Re-order neighbors on the basis of increasing norm in case
-    // of ties among distances.
-    ReorderResults(distances, neighbors, norms);
-
-    // Re-map neighbors to their index.
-    for (size_t j = 0; j < neighbors.n_elem; ++j)
-      neighbors(j) = indexDiff[i].at(neighbors(j));
+    SearchImpostors(neighbors, distances, dataset, norms, i,
+        begin + subIndexSame);
 
     // Store impostors.
     outputNeighbors.cols(begin + subIndexSame) = neighbors;
@@ -350,9 +326,6 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
   UMatType neighbors;
   MatType distances;
 
@@ -364,20 +337,11 @@ void Constraints<MatType, LabelsType, DistanceType>::Impostors(
     // Calculate impostors.
     subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-    // Perform KNN search with differently labeled points as reference
-    // set and same class points as query set.
-    knn.Train(dataset.cols(indexDiff[i]));
-    knn.Search(dataset.cols(points.elem(subIndexSame)),
-        k, neighbors, distances);
-
-    // Re-order neighbors on the basis of increasing norm in case
-    // of ties among distances.
-    ReorderResults(distances, neighbors, norms);
-
-    // Re-map neighbors to their index.
-    for (size_t j = 0; j < neighbors.n_elem; ++j)
-      neighbors(j) = indexDiff[i].at(neighbors(j));
+    SearchImpostors(neighbors, distances, dataset, norms, i,
+        points.elem(subIndexSame));
 
     // Store impostors.
     outputNeighbors.cols(points.elem(subIndexSame)) = neighbors;
@@ -425,6 +389,72 @@ void Constraints<MatType, LabelsType, DistanceType>::Triplets(
   }
 }
 
+// Search the impostors of some points of one class.
+template<typename MatType, typename LabelsType, typename DistanceType>
+inline void Constraints<MatType, LabelsType, DistanceType>::SearchImpostors(
+    UMatType& neighbors,
+    MatType& distances,
+    const MatType& dataset,
+    const VecType& norms,
+    const size_t labelIndex,
+    const UVecType& queries)
+{
+  const UVecType& reference = indexDiff[labelIndex];
+
+  // Building a tree on all the differently labeled points costs about
+  // O(N log N) distance evaluations, so it is only worth it when there are
+  // enough queries; otherwise, each query is compared with every reference
+  // point, in parallel.
+  const size_t bruteForceFactor = 8;
+  const size_t logReference = (size_t) std::ceil(std::log2(
+      (double) reference.n_elem + 1.0));
+  if (queries.n_elem > bruteForceFactor * logReference)
+  {
+    // Perform KNN search with differently labeled points as reference
+    // set and same class points as query set.
+    KNN knn(dataset.cols(reference));
+    knn.Search(dataset.cols(queries), k, neighbors, distances);
+  }
+  else
+  {
+    neighbors.set_size(k, queries.n_elem);
+    distances.set_size(k, queries.n_elem);
+
+    #pragma omp parallel
+    {
+      DistanceType distance;
+      std::vector<std::pair<ElemType, size_t>> candidates(reference.n_elem);
+
+      #pragma omp for schedule(dynamic)
+      for (size_t q = 0; q < (size_t) queries.n_elem; ++q)
+      {
+        for (size_t r = 0; r < (size_t) reference.n_elem; ++r)
+        {
+          candidates[r] = std::make_pair(distance.Evaluate(
+              dataset.col(queries[q]), dataset.col(reference[r])), r);
+        }
+
+        // The candidates are ordered by distance, then by index.
+        std::partial_sort(candidates.begin(), candidates.begin() + k,
+            candidates.end());
+        for (size_t j = 0; j < k; ++j)
+        {
+          distances(j, q) = candidates[j].first;
+          neighbors(j, q) = candidates[j].second;
+        }
+      }
+    }
+  }
+
+  // Re-order neighbors on the basis of increasing norm in case
+  // of ties among distances.
+  ReorderResults(distances, neighbors, norms);
+
+  // Re-map neighbors to their index.
+  for (size_t j = 0; j < neighbors.n_elem; ++j)
+    neighbors(j) = reference.at(neighbors(j));
+}
+
 template<typename MatType, typename LabelsType, typename DistanceType>
 inline void Constraints<MatType, LabelsType, DistanceType>::Precalculate(
     const LabelsType& labels)
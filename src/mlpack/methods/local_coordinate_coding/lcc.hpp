@@ -148,6 +148,17 @@ class LocalCoordinateCoding
    */
   void Encode(const MatType& data, MatType& codes);
 
+  /**
+   * Code each point via distance-weighted LARS, and store the codes in a
+   * sparse matrix.  Only the nonzero coefficients are kept, so a dense codes
+   * matrix is never formed.
+   *
+   * @param data Matrix containing points to encode.
+   * @param codes Output sparse matrix to store codes in.
+   */
+  template<typename eT>
+  void Encode(const MatType& data, arma::SpMat<eT>& codes);
+
   /**
    * Learn dictionary by solving linear system.
    *
@@ -213,6 +224,14 @@ class LocalCoordinateCoding
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Encode each point of the given data in parallel, and call
+   * `store(i, code)` with the code of each point `i`.  `store()` may be called
+   * from several threads at once.
+   */
+  template<typename StoreFunctionType>
+  void EncodePoints(const MatType& data, StoreFunctionType store);
+
   //! Number of atoms in dictionary.
   size_t atoms;
 
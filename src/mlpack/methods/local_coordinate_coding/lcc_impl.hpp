@@ -122,41 +122,63 @@ template<typename MatType>
 inline void LocalCoordinateCoding<MatType>::Encode(const MatType& data,
                                                    MatType& codes)
 {
-  MatType invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
-      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
-      * data);
-
-  MatType dictGram = trans(dictionary) * dictionary;
-  MatType dictGramTD(dictGram.n_rows, dictGram.n_cols);
-
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  EncodePoints(data, [&](const size_t i, const ColType& code)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
+    codes.col(i) = code;
+  });
+}
 
-    ColType invW = invSqDists.unsafe_col(i);
-    MatType dictPrime = dictionary * diagmat(invW);
+template<typename MatType>
+template<typename eT>
+inline void LocalCoordinateCoding<MatType>::Encode(const MatType& data,
+                                                   arma::SpMat<eT>& codes)
+{
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  // Each thread collects the (atom, point) locations and the values of the
+  // nonzero coefficients it finds; they are gathered once all points are done.
+  std::vector<std::vector<arma::uword>> locations(numThreads);
+  std::vector<std::vector<eT>> values(numThreads);
+  EncodePoints(data, [&](const size_t i, const ColType& code)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      const size_t thread = omp_get_thread_num();
+    #else
+      const size_t thread = 0;
+    #endif
 
-    MatType dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+    for (size_t j = 0; j < code.n_elem; ++j)
+    {
+      if (code[j] != 0)
+      {
+        locations[thread].push_back(j);
+        locations[thread].push_back(i);
+        values[thread].push_back((eT) code[j]);
+      }
+    }
+  });
 
-    bool useCholesky = false;
-    // Normalization and fitting and intercept are disabled.
-    const double tol = std::is_same<typename MatType::elem_type, float>::value ?
-        1e-8 : 1e-16;
-    LARS<MatType> lars(useCholesky, 0.5 * lambda, 0, tol, false, false);
+  size_t nonzeros = 0;
+  for (size_t t = 0; t < numThreads; ++t)
+    nonzeros += values[t].size();
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    ColType beta = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
-    beta = lars.Beta();
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
+  arma::umat allLocations(2, nonzeros);
+  arma::Col<eT> allValues(nonzeros);
+  size_t offset = 0;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    std::copy(locations[t].begin(), locations[t].end(),
+        allLocations.memptr() + 2 * offset);
+    std::copy(values[t].begin(), values[t].end(), allValues.memptr() + offset);
+    offset += values[t].size();
   }
+
+  codes = arma::SpMat<eT>(allLocations, allValues, atoms, data.n_cols);
 }
 
 template<typename MatType>
@@ -377,6 +399,48 @@ void LocalCoordinateCoding<MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(tolerance));
 }
 
+template<typename MatType>
+template<typename StoreFunctionType>
+inline void LocalCoordinateCoding<MatType>::EncodePoints(
+    const MatType& data,
+    StoreFunctionType store)
+{
+  const ColType atomSqNorms = trans(sum(square(dictionary)));
+  const MatType dictGram = trans(dictionary) * dictionary;
+
+  // Each point is an independent LARS problem, so the points are encoded in
+  // parallel.
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  #pragma omp parallel
+  {
+    // Each thread reuses one LARS object and its matrices for all of its
+    // points.  Normalization and fitting and intercept are disabled.
+    const bool useCholesky = false;
+    const double tol = std::is_same<typename MatType::elem_type, float>::value ?
+        1e-8 : 1e-16;
+    LARS<MatType> lars(useCholesky, 0.5 * lambda, 0, tol, false, false);
+    MatType dictPrime, dictGramTD;
+    ColType invW, code;
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      // The inverse squared distances from the point to each atom.
+      invW = 1.0 / (atomSqNorms + dot(data.col(i), data.col(i)) -
+          2 * trans(dictionary) * data.col(i));
+
+      dictPrime = dictionary * diagmat(invW);
+      dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+
+      const RowType responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, false, useCholesky, dictGramTD);
+      code = lars.Beta() % invW;
+      store(i, code);
+    }
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -334,6 +334,25 @@ class LogisticRegression
                 arma::Row<size_t>& predictions,
                 const double decisionBoundary = 0.5) const;
 
+  /**
+   * Classify the given points, stored contiguously in column-major order (like
+   * the memory of an Armadillo matrix with FeatureSize() rows), storing the
+   * predicted labels in `predictions`.  This does not allocate memory and does
+   * not check its inputs, so it is suited to low-latency prediction of single
+   * points or small batches; the model must be trained.
+   *
+   * @param points Pointer to the `numPoints * FeatureSize()` elements of the
+   *     points.
+   * @param numPoints Number of points to classify.
+   * @param predictions Preallocated array of `numPoints` labels to store the
+   *     predictions in.
+   * @param decisionBoundary Decision boundary (default 0.5).
+   */
+  void Classify(const ElemType* points,
+                const size_t numPoints,
+                size_t* predictions,
+                const double decisionBoundary = 0.5) const noexcept;
+
   /**
    * Classify the given points, storing the predicted labels for each point in
    * `labels` and the class probabilities for each point in `probabilities`.
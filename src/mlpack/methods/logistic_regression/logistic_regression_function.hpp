@@ -118,10 +118,34 @@ class LogisticRegressionFunction
    *     function gradient evaluation.
    */
   template<typename CoordinatesType, typename GradType>
-  void Gradient(const CoordinatesType& parameters,
-                const size_t begin,
-                GradType& gradient,
-                const size_t batchSize = 1) const;
+  std::enable_if_t<!arma::is_SpMat<GradType>::value> Gradient(
+      const CoordinatesType& parameters,
+      const size_t begin,
+      GradType& gradient,
+      const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * with the given parameters, for the given batch size from a given point in
+   * the dataset, as a sparse matrix.  Only the intercept and the features that
+   * are nonzero in the batch get a gradient, so that optimizers that apply
+   * sparse updates, such as `ens::ParallelSGD` (Hogwild!), only touch those
+   * parameters.  For the same reason, the L2 regularization is only applied to
+   * those features, once for each point of the batch where they are nonzero.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the starting point to use for objective function
+   *     gradient evaluation.
+   * @param gradient Sparse vector to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *     function gradient evaluation.
+   */
+  template<typename CoordinatesType, typename GradType>
+  std::enable_if_t<arma::is_SpMat<GradType>::value> Gradient(
+      const CoordinatesType& parameters,
+      const size_t begin,
+      GradType& gradient,
+      const size_t batchSize = 1) const;
 
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
@@ -167,6 +191,20 @@ class LogisticRegressionFunction
   size_t NumFeatures() const { return predictors.n_rows + 1; }
 
  private:
+  //! Call `f(row, value)` for each nonzero element of the given column of a
+  //! dense matrix.
+  template<typename eT, typename FunctionType>
+  static void ForEachNonzero(const arma::Mat<eT>& m,
+                             const size_t col,
+                             FunctionType f);
+
+  //! Call `f(row, value)` for each nonzero element of the given column of a
+  //! sparse matrix.
+  template<typename eT, typename FunctionType>
+  static void ForEachNonzero(const arma::SpMat<eT>& m,
+                             const size_t col,
+                             FunctionType f);
+
   //! The matrix of data points (predictors).  This is an alias until shuffling
   //! is done.
   MatType predictors;
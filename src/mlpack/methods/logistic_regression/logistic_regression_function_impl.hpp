@@ -137,10 +137,14 @@ LogisticRegressionFunction<MatType>::Evaluate(
       dot(parameters.tail_cols(parameters.n_elem - 1),
           parameters.tail_cols(parameters.n_elem - 1));
 
+  // The batch is an alias of the columns of the predictors (when they are
+  // dense), so it is not copied.
+  MatType batch;
+  MakeColsAlias(batch, predictors, begin, batchSize, false);
+
   // Calculate the sigmoid function values.
   const CoordinatesType sigmoid = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batch)));
 
   // Compute the objective for the given batch size from a given point.
   CoordinatesType respD = ConvTo<CoordinatesType>::From(
@@ -183,11 +187,12 @@ void LogisticRegressionFunction<MatType>::Gradient(
 //! given batch size.
 template<typename MatType>
 template<typename CoordinatesType, typename GradType>
-void LogisticRegressionFunction<MatType>::Gradient(
-                const CoordinatesType& parameters,
-                const size_t begin,
-                GradType& gradient,
-                const size_t batchSize) const
+std::enable_if_t<!arma::is_SpMat<GradType>::value>
+LogisticRegressionFunction<MatType>::Gradient(
+    const CoordinatesType& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
 {
   typedef typename CoordinatesType::elem_type ElemType;
 
@@ -201,18 +206,69 @@ void LogisticRegressionFunction<MatType>::Gradient(
   // `1.0` or similar.
   constexpr ElemType one = ((ElemType) 1);
 
-  const CoordinatesType exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
+  // The batch is an alias of the columns of the predictors (when they are
+  // dense), so it is not copied.
+  MatType batch;
+  MakeColsAlias(batch, predictors, begin, batchSize, false);
+  arma::Row<size_t> batchResponses;
+  MakeAlias(batchResponses, responses, batchSize, begin, false);
+
   // Calculating the sigmoid function values.
-  const CoordinatesType sigmoids = one / (one + exp(-exponents));
+  const CoordinatesType sigmoids = one / (one + exp(-(parameters(0, 0) +
+      parameters.tail_cols(parameters.n_elem - 1) * batch)));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = -accu(batchResponses - sigmoids);
+  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - batchResponses) *
+      batch.t() + regularization;
+}
+
+//! Evaluate the gradient of the logistic regression objective function for a
+//! given batch size, as a sparse matrix.
+template<typename MatType>
+template<typename CoordinatesType, typename GradType>
+std::enable_if_t<arma::is_SpMat<GradType>::value>
+LogisticRegressionFunction<MatType>::Gradient(
+    const CoordinatesType& parameters,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  typedef typename GradType::elem_type ElemType;
+
+  constexpr ElemType one = ((ElemType) 1);
+
+  // The columns and values of the nonzero elements of the gradient.  Each
+  // nonzero element of the batch gives one value; the values of the same
+  // feature are summed when the gradient is built.  The first value is the
+  // intercept.
+  std::vector<arma::uword> columns(1, 0);
+  std::vector<ElemType> values(1, 0);
+
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    ElemType exponent = parameters(0, 0);
+    ForEachNonzero(predictors, i, [&](const size_t row, const ElemType x)
+    {
+      exponent += parameters(0, row + 1) * x;
+    });
+
+    const ElemType error = one / (one + std::exp(-exponent)) -
+        ((ElemType) responses[i]);
+    values[0] += error;
+
+    ForEachNonzero(predictors, i, [&](const size_t row, const ElemType x)
+    {
+      columns.push_back(row + 1);
+      values.push_back(error * x +
+          lambda * parameters(0, row + 1) / predictors.n_cols);
+    });
+  }
+
+  arma::umat locations(2, columns.size(), arma::fill::zeros);
+  locations.row(1) = arma::urowvec(columns);
+  gradient = GradType(true, locations, arma::Col<ElemType>(values),
+      parameters.n_rows, parameters.n_cols);
 }
 
 /**
@@ -317,21 +373,24 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       dot(parameters.tail_cols(parameters.n_elem - 1),
           parameters.tail_cols(parameters.n_elem - 1));
 
+  // The batch is an alias of the columns of the predictors (when they are
+  // dense), so it is not copied.
+  MatType batch;
+  MakeColsAlias(batch, predictors, begin, batchSize, false);
+  arma::Row<size_t> batchResponses;
+  MakeAlias(batchResponses, responses, batchSize, begin, false);
+
   // Calculate the sigmoid function values.
   const CoordinatesType sigmoids = one / (one + exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batch)));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = -accu(batchResponses - sigmoids);
+  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - batchResponses) *
+      batch.t() + regularization;
 
   // Now compute the objective function using the sigmoids.
-  CoordinatesType respD = ConvTo<CoordinatesType>::From(
-      responses.subvec(begin, begin + batchSize - 1));
+  CoordinatesType respD = ConvTo<CoordinatesType>::From(batchResponses);
   const ElemType result = accu(log(one - respD + sigmoids %
       (two * respD - one)));
 
@@ -339,6 +398,33 @@ LogisticRegressionFunction<MatType>::EvaluateWithGradient(
   return objectiveRegularization - result;
 }
 
+template<typename MatType>
+template<typename eT, typename FunctionType>
+void LogisticRegressionFunction<MatType>::ForEachNonzero(
+    const arma::Mat<eT>& m,
+    const size_t col,
+    FunctionType f)
+{
+  const eT* colMem = m.colptr(col);
+  for (size_t row = 0; row < m.n_rows; ++row)
+  {
+    if (colMem[row] != eT(0))
+      f(row, colMem[row]);
+  }
+}
+
+template<typename MatType>
+template<typename eT, typename FunctionType>
+void LogisticRegressionFunction<MatType>::ForEachNonzero(
+    const arma::SpMat<eT>& m,
+    const size_t col,
+    FunctionType f)
+{
+  typename arma::SpMat<eT>::const_iterator it = m.begin_col(col);
+  for (; it != m.end_col(col); ++it)
+    f(it.row(), *it);
+}
+
 } // namespace mlpack
 
 #endif
@@ -205,6 +205,31 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
       (one - ((ElemType) decisionBoundary)));
 }
 
+template<typename MatType>
+void LogisticRegression<MatType>::Classify(const ElemType* points,
+                                           const size_t numPoints,
+                                           size_t* predictions,
+                                           const double decisionBoundary)
+    const noexcept
+{
+  // Used to prevent automatic casting to double.
+  constexpr ElemType one = ((ElemType) 1);
+
+  const size_t dimensionality = parameters.n_elem - 1;
+  const ElemType intercept = parameters[0];
+  const ElemType* weights = parameters.memptr() + 1;
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const ElemType* point = points + i * dimensionality;
+    ElemType z = intercept;
+    for (size_t d = 0; d < dimensionality; ++d)
+      z += weights[d] * point[d];
+
+    predictions[i] = size_t(one / (one + std::exp(-z)) +
+        (one - ((ElemType) decisionBoundary)));
+  }
+}
+
 template<typename MatType>
 void LogisticRegression<MatType>::Classify(const MatType& dataset,
                                            MatType& probabilities) const
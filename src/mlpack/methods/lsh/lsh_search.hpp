@@ -286,9 +286,18 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  //! Get the offsets of each bucket of the second hash table in
+  //! BucketContents(); the points of bucket i are the elements from
+  //! BucketOffsets()[i] up to (but not including) BucketOffsets()[i + 1].
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the indices of the points held in all buckets of the second hash
+  //! table, stored contiguously.
+  const arma::Col<uint32_t>& BucketContents() const { return bucketContents; }
+
+  //! Get the number of nonempty buckets in the second hash table.
+  size_t NumBuckets() const
+  { return (bucketOffsets.n_elem == 0) ? 0 : bucketOffsets.n_elem - 1; }
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -446,16 +455,20 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The start of each nonempty bucket of the second hash table in
+  //! bucketContents, followed by the total number of elements; should have
+  //! (< secondHashSize) + 1 elements.  This is the second hash table in
+  //! compressed sparse row format, so there is no padding in any bucket.
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The indices of the points in each bucket, one bucket after the other; each
+  //! bucket holds (<= bucketSize) elements.  Indices are stored with 32 bits to
+  //! halve the size of the table.
+  arma::Col<uint32_t> bucketContents;
 
-  //! For a particular hash value, points to the row in secondHashTable
-  //! corresponding to this value. Length secondHashSize.
+  //! For a particular hash value, points to the bucket of the second hash table
+  //! corresponding to this value, or secondHashSize if the bucket is empty.
+  //! Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
   //! The number of distance evaluations.
@@ -479,6 +492,11 @@ class LSHSearch
 
 } // namespace mlpack
 
+//! Set the serialization version of the LSHSearch class.  Version 0 stored each
+//! bucket of the second hash table in a separate vector.
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy, typename MatType),
+    (mlpack::LSHSearch<SortPolicy, MatType>), (1));
+
 // Include implementation.
 #include "lsh_search_impl.hpp"
 
@@ -82,8 +82,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
-    bucketContentSize(other.bucketContentSize),
+    bucketOffsets(other.bucketOffsets),
+    bucketContents(other.bucketContents),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -102,8 +102,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
-    bucketContentSize(std::move(other.bucketContentSize)),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketContents(std::move(other.bucketContents)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -130,8 +130,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
-  bucketContentSize = other.bucketContentSize;
+  bucketOffsets = other.bucketOffsets;
+  bucketContents = other.bucketContents;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
 
@@ -152,8 +152,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
-  bucketContentSize = std::move(other.bucketContentSize);
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketContents = std::move(other.bucketContents);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
 
@@ -178,6 +178,15 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
                                            const size_t bucketSize,
                                            const arma::cube& projection)
 {
+  // The second hash table stores point indices with 32 bits.
+  if (referenceSet.n_cols > std::numeric_limits<uint32_t>::max())
+  {
+    throw std::invalid_argument("LSHSearch::Train(): reference set has "
+        + std::to_string(referenceSet.n_cols) + " points, but at most "
+        + std::to_string(std::numeric_limits<uint32_t>::max()) + " points are "
+        "supported!");
+  }
+
   // Set new reference set.
   this->referenceSet = std::move(referenceSet);
 
@@ -309,36 +318,39 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
       { return std::min(val, effectiveBucketSize); });
 
   const size_t numRowsInTable = accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
 
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  // Each nonempty bucket gets the next row, in the order that the buckets are
+  // first encountered.
   size_t currentRow = 0;
+  for (size_t i = 0; i < secondHashVectors.n_elem; ++i)
+  {
+    const size_t hashInd = secondHashVectors[i];
+    if (bucketRowInHashTable[hashInd] == secondHashSize)
+      bucketRowInHashTable[hashInd] = currentRow++;
+  }
+
+  // Now that the size of each row is known, the rows can be laid out one after
+  // the other.
+  bucketOffsets.zeros(numRowsInTable + 1);
+  for (size_t i = 0; i < secondHashSize; ++i)
+  {
+    if (bucketRowInHashTable[i] < secondHashSize)
+      bucketOffsets[bucketRowInHashTable[i] + 1] = secondHashBinCounts[i];
+  }
+  bucketOffsets = arma::cumsum(bucketOffsets);
+  bucketContents.set_size(bucketOffsets[numRowsInTable]);
+
+  // Next we must assign each point in each table to the right bucket; each
+  // bucket is filled up to its maximum size, in the order of the points.
+  arma::Col<size_t> bucketEnd = bucketOffsets.head(numRowsInTable);
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
     for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
-      if (bucketRowInHashTable[hashInd] == secondHashSize)
-      {
-        bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
-        currentRow++;
-      }
-
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
+      // This is the bucket number.  The point ID is 'j'.
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      if (bucketEnd[row] < bucketOffsets[row + 1])
+        bucketContents[bucketEnd[row]++] = (uint32_t) j;
     } // Loop over all points in the reference set.
   } // Loop over tables.
 
@@ -775,8 +787,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       const size_t hashInd = hashMat(p, i); // find query's bucket
       const size_t tableRow = bucketRowInHashTable[hashInd];
-      if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+      if (tableRow < secondHashSize) // count bucket contents
+        maxNumPoints += bucketOffsets[tableRow + 1] - bucketOffsets[tableRow];
     }
   }
 
@@ -807,11 +819,12 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
         size_t hashInd = hashMat(p, i);
         size_t tableRow = bucketRowInHashTable[hashInd];
 
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+        if (tableRow < secondHashSize)
         {
           // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          for (size_t j = bucketOffsets[tableRow];
+               j < bucketOffsets[tableRow + 1]; ++j)
+            refPointsConsidered[bucketContents[j]]++;
         }
       }
     }
@@ -840,9 +853,10 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
 
         if (tableRow < secondHashSize)
         {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
+          // Store all points of the bucket in the candidates set.
+          for (size_t j = bucketOffsets[tableRow];
+               j < bucketOffsets[tableRow + 1]; ++j)
+            refPointsConsideredSmall(start++) = bucketContents[j];
        }
       }
     }
@@ -905,7 +919,8 @@ void LSHSearch<SortPolicy, MatType>::Search(
   // Parallelization to process more than one query at a time.
   #pragma omp parallel for \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+      schedule(dynamic) \
+      num_threads(Parallel::Threads()) \
       reduction(+:avgIndicesReturned)
   for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
   {
@@ -967,7 +982,8 @@ Search(const size_t k,
   // Parallelization to process more than one query at a time.
   #pragma omp parallel for \
       shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+      schedule(dynamic) \
+      num_threads(Parallel::Threads()) \
       reduction(+:avgIndicesReturned)
   for (size_t i = 0; i < (size_t) referenceSet.n_cols; ++i)
   {
@@ -1025,7 +1041,7 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
-                                               const uint32_t /* version */)
+                                               const uint32_t version)
 {
   ar(CEREAL_NVP(referenceSet));
   ar(CEREAL_NVP(numProj));
@@ -1041,8 +1057,31 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashSize));
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
-  ar(CEREAL_NVP(secondHashTable));
-  ar(CEREAL_NVP(bucketContentSize));
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    // Older models held each bucket in a separate vector, so convert them to
+    // the contiguous layout.
+    std::vector<arma::Col<size_t>> secondHashTable;
+    arma::Col<size_t> bucketContentSize;
+    ar(CEREAL_NVP(secondHashTable));
+    ar(CEREAL_NVP(bucketContentSize));
+
+    bucketOffsets.zeros(secondHashTable.size() + 1);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+      bucketOffsets[i + 1] = bucketOffsets[i] + bucketContentSize[i];
+
+    bucketContents.set_size(bucketOffsets[secondHashTable.size()]);
+    for (size_t i = 0; i < secondHashTable.size(); ++i)
+    {
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        bucketContents[bucketOffsets[i] + j] = (uint32_t) secondHashTable[i][j];
+    }
+  }
+  else
+  {
+    ar(CEREAL_NVP(bucketOffsets));
+    ar(CEREAL_NVP(bucketContents));
+  }
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
 }
@@ -22,6 +22,12 @@ namespace mlpack {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * All seeds are moved together: in each iteration, the range searches of every
+ * seed that is still moving are performed as one batch with a single reference
+ * tree, and the new centroids are computed in parallel with OpenMP.  A seed
+ * stops as soon as it converges or comes within the radius of a centroid that
+ * has already been found (since it would only give a duplicate of it).
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -132,8 +138,8 @@ class MeanShift
   template<bool ApplyKernel = UseKernel>
   typename std::enable_if<ApplyKernel, bool>::type
   CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<double>& distances,
+                    const arma::Col<size_t>& neighbors,
+                    const arma::vec& distances,
                     arma::colvec& centroid);
 
   /**
@@ -147,10 +153,20 @@ class MeanShift
   template<bool ApplyKernel = UseKernel>
   typename std::enable_if<!ApplyKernel, bool>::type
   CalculateCentroid(const MatType& data,
-                    const std::vector<size_t>& neighbors,
-                    const std::vector<double>&, /*unused*/
+                    const arma::Col<size_t>& neighbors,
+                    const arma::vec&, /*unused*/
                     arma::colvec& centroid);
 
+  /**
+   * Return whether the given centroid is closer than the radius to one of the
+   * given centroids (and so is a duplicate of it).
+   *
+   * @param centroid Centroid to check.
+   * @param centroids Existing centroids.
+   */
+  bool IsDuplicate(const arma::colvec& centroid,
+                   const arma::mat& centroids) const;
+
   /**
    * If distance of two centroids is less than radius, one will be removed.
    * Points with distance to current centroid less than radius will be used
@@ -134,12 +134,12 @@ template<bool ApplyKernel>
 typename std::enable_if<ApplyKernel, bool>::type
 MeanShift<UseKernel, KernelType, MatType>::
 CalculateCentroid(const MatType& data,
-                  const std::vector<size_t>& neighbors,
-                  const std::vector<double>& distances,
+                  const arma::Col<size_t>& neighbors,
+                  const arma::vec& distances,
                   arma::colvec& centroid)
 {
   double sumWeight = 0;
-  for (size_t i = 0; i < neighbors.size(); ++i)
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
   {
     if (distances[i] > 0)
     {
@@ -164,17 +164,34 @@ template<bool ApplyKernel>
 typename std::enable_if<!ApplyKernel, bool>::type
 MeanShift<UseKernel, KernelType, MatType>::
 CalculateCentroid(const MatType& data,
-                  const std::vector<size_t>& neighbors,
-                  const std::vector<double>&, /*unused*/
+                  const arma::Col<size_t>& neighbors,
+                  const arma::vec&, /*unused*/
                   arma::colvec& centroid)
 {
-  for (size_t i = 0; i < neighbors.size(); ++i)
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
     centroid += data.unsafe_col(neighbors[i]);
 
-  centroid /= neighbors.size();
+  centroid /= neighbors.n_elem;
   return true;
 }
 
+// Determine whether a centroid is within the radius of one of the given
+// centroids.
+template<bool UseKernel, typename KernelType, typename MatType>
+inline bool MeanShift<UseKernel, KernelType, MatType>::IsDuplicate(
+    const arma::colvec& centroid,
+    const arma::mat& centroids) const
+{
+  for (size_t k = 0; k < centroids.n_cols; ++k)
+  {
+    if (EuclideanDistance::Evaluate(centroid, centroids.unsafe_col(k)) <
+        radius)
+      return true;
+  }
+
+  return false;
+}
+
 /**
  * Perform Mean Shift clustering on the data set, returning a list of cluster
  * assignments and centroids.
@@ -201,63 +218,102 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
     pSeeds = &seeds;
   }
 
-  // Holds all centroids before removing duplicate ones.
-  arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  // Holds all centroids before removing duplicate ones.  The initial centroid
+  // of each seed is the seed itself.
+  arma::mat allCentroids = *pSeeds;
 
   assignments.set_size(data.n_cols);
 
+  // All range searches use the same reference tree.
   RangeSearch<> rangeSearcher(data);
   Range validRadius(0, radius);
-  std::vector<std::vector<size_t> > neighbors;
-  std::vector<std::vector<double> > distances;
-
-  // For each seed, perform mean shift algorithm.
+  // The results of the range searches are stored in compressed form: the
+  // neighbors of query point i are neighbors[offsets[i]] to
+  // neighbors[offsets[i + 1] - 1].
+  arma::Col<size_t> offsets, neighbors;
+  arma::vec distances;
+
+  // The seeds that have not converged or been removed yet.
+  std::vector<size_t> activeSeeds(pSeeds->n_cols);
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
+    activeSeeds[i] = i;
+
+  // The state of each active seed after an iteration.
+  enum SeedState { MOVED, CONVERGED, EMPTY };
+  std::vector<SeedState> states;
+
+  // All seeds are moved at the same time: each iteration performs the range
+  // searches of all active seeds in one batch, and then computes their new
+  // centroids in parallel.
+  for (size_t completedIterations = 0; !activeSeeds.empty() &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
-    {
-      // Store new centroid in this.
-      arma::colvec newCentroid = zeros<arma::colvec>(pSeeds->n_rows);
+    arma::mat querySet(pSeeds->n_rows, activeSeeds.size());
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+      querySet.col(i) = allCentroids.col(activeSeeds[i]);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+    rangeSearcher.Search(querySet, validRadius, offsets, neighbors, distances);
+
+    states.resize(activeSeeds.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+    {
+      const size_t seed = activeSeeds[i];
+      const size_t numNeighbors = offsets[i + 1] - offsets[i];
+      if (numNeighbors == 0) // There are no points in the cluster.
+      {
+        states[i] = EMPTY;
+        continue;
+      }
 
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      // Calculate new centroid.  The neighbors of the seed are used in place.
+      const arma::Col<size_t> seedNeighbors(neighbors.memptr() + offsets[i],
+          numNeighbors, false, true);
+      const arma::vec seedDistances(distances.memptr() + offsets[i],
+          numNeighbors, false, true);
+      arma::colvec newCentroid = zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, seedNeighbors, seedDistances, newCentroid))
+        newCentroid = allCentroids.unsafe_col(seed);
 
       // If the mean shift vector is small enough, it has converged.
       if (EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+          allCentroids.unsafe_col(seed)) < 1e-3 * radius)
+      {
+        states[i] = CONVERGED;
+      }
+      else
+      {
+        // Update the centroid.
+        allCentroids.col(seed) = newCentroid;
+        states[i] = MOVED;
+      }
+    }
+
+    // Add the converged centroids that are not duplicates of old ones, in
+    // order, so that the result does not depend on the number of threads.
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+    {
+      if (states[i] != CONVERGED)
+        continue;
+
+      if (!IsDuplicate(allCentroids.unsafe_col(activeSeeds[i]), centroids))
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
-
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        centroids.insert_cols(centroids.n_cols,
+            allCentroids.unsafe_col(activeSeeds[i]));
       }
+    }
 
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
+    // Seeds that have reached an existing centroid would only converge to a
+    // duplicate of it, so they are removed too.
+    size_t numActive = 0;
+    for (size_t i = 0; i < activeSeeds.size(); ++i)
+    {
+      if (states[i] == MOVED &&
+          !IsDuplicate(allCentroids.unsafe_col(activeSeeds[i]), centroids))
+        activeSeeds[numActive++] = activeSeeds[i];
     }
+    activeSeeds.resize(numActive);
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -242,18 +242,21 @@ class NaiveBayesClassifier
 
   //! Get the sample means for each class.
   const ModelMatType& Means() const { return means; }
-  //! Modify the sample means for each class.
-  ModelMatType& Means() { return means; }
+  //! Modify the sample means for each class.  The next delta checkpoint will
+  //! hold the whole model.
+  ModelMatType& Means() { modifiedAll = true; return means; }
 
   //! Get the sample variances for each class.
   const ModelMatType& Variances() const { return variances; }
-  //! Modify the sample variances for each class.
-  ModelMatType& Variances() { return variances; }
+  //! Modify the sample variances for each class.  The next delta checkpoint
+  //! will hold the whole model.
+  ModelMatType& Variances() { modifiedAll = true; return variances; }
 
   //! Get the prior probabilities for each class.
   const ModelMatType& Probabilities() const { return probabilities; }
-  //! Modify the prior probabilities for each class.
-  ModelMatType& Probabilities() { return probabilities; }
+  //! Modify the prior probabilities for each class.  The next delta checkpoint
+  //! will hold the whole model.
+  ModelMatType& Probabilities() { modifiedAll = true; return probabilities; }
 
   //! Get the number of points the model has been trained on so far.
   size_t TrainingPoints() const { return trainingPoints; }
@@ -262,7 +265,36 @@ class NaiveBayesClassifier
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
 
+  /**
+   * Save a delta checkpoint of the model: only the statistics of the classes
+   * that changed since the last call to SaveDelta() or LoadDelta(), or since
+   * the model was loaded, are saved (with the class probabilities).  Training
+   * on single points only changes the class of each point, so the delta is
+   * small; batch training and resets change every class, and then the whole
+   * model is saved.
+   *
+   * @param ar Archive to save the delta to.
+   */
+  template<typename Archive>
+  void SaveDelta(Archive& ar);
+
+  /**
+   * Apply a delta checkpoint that was saved by SaveDelta().  The model must be
+   * in the state it had when the previous checkpoint (full or delta) was taken;
+   * a std::runtime_error is thrown if the delta does not match the size of the
+   * model.
+   *
+   * @param ar Archive to load the delta from.
+   */
+  template<typename Archive>
+  void LoadDelta(Archive& ar);
+
  private:
+  //! Number of points in each block of the batch training.
+  static constexpr size_t TrainBlockSize = 4096;
+  //! Number of points in each block of the log likelihood computation.
+  static constexpr size_t LogLikelihoodBlockSize = 1024;
+
   //! Sample mean for each class.
   ModelMatType means;
   //! Sample variances for each class.
@@ -273,6 +305,14 @@ class NaiveBayesClassifier
   size_t trainingPoints;
   //! Small value to prevent log of zero.
   double epsilon;
+  //! Whether or not every class changed since the last delta checkpoint.
+  bool modifiedAll;
+  //! Whether or not each class changed since the last delta checkpoint (only
+  //! used if modifiedAll is false).
+  std::vector<bool> modifiedClasses;
+
+  //! Mark the model as unchanged since the last checkpoint.
+  void ClearModified();
 
   /**
    * Compute the unnormalized posterior log probability of given points (log
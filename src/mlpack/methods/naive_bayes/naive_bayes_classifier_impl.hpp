@@ -33,7 +33,8 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
     const bool incremental,
     const double epsilon) :
     trainingPoints(0), // Set when we call Train().
-    epsilon(epsilon)
+    epsilon(epsilon),
+    modifiedAll(true)
 {
   static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
       "NaiveBayesClassifier: element type of given data must match the element "
@@ -65,7 +66,8 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
     const size_t numClasses,
     const double epsilon) :
     trainingPoints(0),
-    epsilon(epsilon)
+    epsilon(epsilon),
+    modifiedAll(true)
 {
   // Initialize model to 0.
   probabilities.zeros(numClasses);
@@ -121,30 +123,59 @@ void NaiveBayesClassifier<ModelMatType>::Train(
     means.zeros(data.n_rows, numClasses);
     variances.zeros(data.n_rows, numClasses);
 
-    // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
-    // possible to calculate the means and variances using a faster one-pass
-    // algorithm but there are some precision and stability issues.  If this is
-    // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
-
-    // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
-    {
-      const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
-    }
-
-    // Normalize means.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] != 0.0)
-        means.col(i) /= probabilities[i];
-
-    // Calculate variances.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    // Don't use incremental algorithm.  The points are split into blocks, and
+    // the counts, means and sums of squared deviations of each class are
+    // computed for each block with a two-pass algorithm (which is more stable
+    // than a one-pass algorithm).  The statistics of the blocks are then merged
+    // in order with the pairwise update of Chan et al., so the result does not
+    // depend on the number of threads.
+    const size_t numBlocks = (data.n_cols + TrainBlockSize - 1) /
+        TrainBlockSize;
+
+    #pragma omp parallel for ordered schedule(dynamic)
+    for (size_t b = 0; b < numBlocks; ++b)
     {
-      const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
+      const size_t begin = b * TrainBlockSize;
+      const size_t end = std::min((size_t) data.n_cols, begin + TrainBlockSize);
+
+      arma::Col<ElemType> blockCounts(numClasses, arma::fill::zeros);
+      ModelMatType blockMeans(data.n_rows, numClasses, arma::fill::zeros);
+      ModelMatType blockM2(data.n_rows, numClasses, arma::fill::zeros);
+
+      for (size_t j = begin; j < end; ++j)
+      {
+        const size_t label = labels[j];
+        ++blockCounts[label];
+        blockMeans.col(label) += data.col(j);
+      }
+
+      for (size_t i = 0; i < numClasses; ++i)
+        if (blockCounts[i] != 0)
+          blockMeans.col(i) /= blockCounts[i];
+
+      for (size_t j = begin; j < end; ++j)
+      {
+        const size_t label = labels[j];
+        blockM2.col(label) += square(data.col(j) - blockMeans.col(label));
+      }
+
+      // Until normalization, probabilities holds the counts and variances
+      // holds the sums of squared deviations.
+      #pragma omp ordered
+      {
+        for (size_t i = 0; i < numClasses; ++i)
+        {
+          if (blockCounts[i] == 0)
+            continue;
+
+          const ElemType n = probabilities[i] + blockCounts[i];
+          const arma::Col<ElemType> delta = blockMeans.col(i) - means.col(i);
+          means.col(i) += delta * (blockCounts[i] / n);
+          variances.col(i) += blockM2.col(i) +
+              square(delta) * (probabilities[i] * blockCounts[i] / n);
+          probabilities[i] = n;
+        }
+      }
     }
 
     // Normalize variances.
@@ -158,6 +189,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(
 
   probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+  modifiedAll = true;
 }
 
 template<typename ModelMatType>
@@ -205,6 +237,8 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
 
   trainingPoints++;
   probabilities /= trainingPoints;
+  if (!modifiedAll)
+    modifiedClasses[label] = true;
 }
 
 template<typename ModelMatType>
@@ -217,23 +251,39 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = log(repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
-
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
-
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
+  // For a diagonal Gaussian, the log likelihood of x for class i is
+  //
+  //   log p_i - 0.5 * (d log(2 pi) + sum_k log v_ik + sum_k m_ik^2 / v_ik)
+  //     + sum_k (m_ik / v_ik) x_k - 0.5 * sum_k (1 / v_ik) x_k^2,
+  //
+  // so the log likelihoods of a block of points are given by two matrix
+  // products with the block (and with its squares) plus a constant per class.
+  // The points and the means are first centered on the average of the means,
+  // to limit the cancellation between the terms when the variances are small.
+  const arma::Col<ElemType> center = mean(means, 1);
+  const ModelMatType centeredMeans = means.each_col() - center;
+  const ModelMatType invVar = 1.0 / variances;
+  const ModelMatType weightedMeans = centeredMeans % invVar;
+  const arma::Col<ElemType> offsets = log(probabilities) - 0.5 *
+      (data.n_rows * std::log(2 * M_PI) + sum(log(variances), 0).t() +
+      sum(centeredMeans % weightedMeans, 0).t());
+
+  logLikelihoods.set_size(means.n_cols, data.n_cols);
+  const size_t numBlocks = (data.n_cols + LogLikelihoodBlockSize - 1) /
+      LogLikelihoodBlockSize;
+
+  #pragma omp parallel for
+  for (size_t b = 0; b < numBlocks; ++b)
   {
-    // This is an adaptation of phi() for the case where the covariance is a
-    // diagonal matrix.
-    ModelMatType diffs = data - repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * std::log(2 * M_PI) - 0.5 *
-        accu(log(variances.col(i))) + exponents);
+    const size_t begin = b * LogLikelihoodBlockSize;
+    const size_t end = std::min((size_t) data.n_cols,
+        begin + LogLikelihoodBlockSize);
+
+    ModelMatType block(data.cols(begin, end - 1));
+    block.each_col() -= center;
+    logLikelihoods.cols(begin, end - 1) = weightedMeans.t() * block -
+        0.5 * invVar.t() * square(block);
+    logLikelihoods.cols(begin, end - 1).each_col() += offsets;
   }
 }
 
@@ -397,6 +447,7 @@ void NaiveBayesClassifier<ModelMatType>::Reset()
   probabilities.zeros();
   variances.fill(epsilon);
   trainingPoints = 0;
+  modifiedAll = true;
 }
 
 template<typename ModelMatType>
@@ -411,6 +462,7 @@ void NaiveBayesClassifier<ModelMatType>::Reset(const size_t dimensionality,
   variances.set_size(dimensionality, numClasses);
   variances.fill(epsilon);
   trainingPoints = 0;
+  modifiedAll = true;
 }
 
 template<typename ModelMatType>
@@ -434,6 +486,101 @@ void NaiveBayesClassifier<ModelMatType>::serialize(
     ar(CEREAL_NVP(trainingPoints));
     ar(CEREAL_NVP(epsilon));
   }
+
+  // The loaded model is the base for the next delta checkpoint.
+  if (cereal::is_loading<Archive>())
+    ClearModified();
+}
+
+template<typename ModelMatType>
+template<typename Archive>
+void NaiveBayesClassifier<ModelMatType>::SaveDelta(Archive& ar)
+{
+  // If every class changed (or the model was resized), the whole model has to
+  // be saved.
+  bool full = modifiedAll || (modifiedClasses.size() != probabilities.n_elem);
+  ar(CEREAL_NVP(full));
+  if (full)
+  {
+    ar(cereal::make_nvp("model", *this));
+    ClearModified();
+    return;
+  }
+
+  std::vector<size_t> classes;
+  for (size_t i = 0; i < modifiedClasses.size(); ++i)
+    if (modifiedClasses[i])
+      classes.push_back(i);
+
+  ModelMatType classMeans(means.n_rows, classes.size());
+  ModelMatType classVariances(variances.n_rows, classes.size());
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    classMeans.col(i) = means.col(classes[i]);
+    classVariances.col(i) = variances.col(classes[i]);
+  }
+
+  // Every class probability changes with each point, so they are all saved.
+  ar(CEREAL_NVP(trainingPoints));
+  ar(CEREAL_NVP(probabilities));
+  ar(CEREAL_NVP(classes));
+  ar(CEREAL_NVP(classMeans));
+  ar(CEREAL_NVP(classVariances));
+
+  ClearModified();
+}
+
+template<typename ModelMatType>
+template<typename Archive>
+void NaiveBayesClassifier<ModelMatType>::LoadDelta(Archive& ar)
+{
+  bool full;
+  ar(CEREAL_NVP(full));
+  if (full)
+  {
+    ar(cereal::make_nvp("model", *this));
+    return;
+  }
+
+  size_t deltaTrainingPoints;
+  ModelMatType deltaProbabilities, classMeans, classVariances;
+  std::vector<size_t> classes;
+  ar(cereal::make_nvp("trainingPoints", deltaTrainingPoints));
+  ar(cereal::make_nvp("probabilities", deltaProbabilities));
+  ar(CEREAL_NVP(classes));
+  ar(CEREAL_NVP(classMeans));
+  ar(CEREAL_NVP(classVariances));
+
+  bool valid = (deltaProbabilities.n_elem == probabilities.n_elem &&
+      classMeans.n_rows == means.n_rows &&
+      classVariances.n_rows == variances.n_rows &&
+      classMeans.n_cols == classes.size() &&
+      classVariances.n_cols == classes.size());
+  for (size_t i = 0; i < classes.size() && valid; ++i)
+    valid = (classes[i] < means.n_cols);
+
+  if (!valid)
+  {
+    throw std::runtime_error("NaiveBayesClassifier::LoadDelta(): the delta "
+        "does not match the size of the model!");
+  }
+
+  trainingPoints = deltaTrainingPoints;
+  probabilities = std::move(deltaProbabilities);
+  for (size_t i = 0; i < classes.size(); ++i)
+  {
+    means.col(classes[i]) = classMeans.col(i);
+    variances.col(classes[i]) = classVariances.col(i);
+  }
+
+  ClearModified();
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::ClearModified()
+{
+  modifiedAll = false;
+  modifiedClasses.assign(probabilities.n_elem, false);
 }
 
 } // namespace mlpack
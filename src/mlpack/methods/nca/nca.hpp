@@ -169,6 +169,22 @@ class NCA
   //! Modify the distance.
   DistanceType& Distance() { return distance; }
 
+  //! Get the number of candidate neighbors of each point used in the softmax
+  //! (0 means all points are used).
+  size_t NumCandidates() const { return numCandidates; }
+  //! Modify the number of candidate neighbors of each point used in the
+  //! softmax.  For large datasets, restricting the softmax to the nearest
+  //! neighbors of each point makes each epoch O(n) instead of O(n^2); see
+  //! SoftmaxErrorFunction.
+  size_t& NumCandidates() { return numCandidates; }
+
+  //! Get whether the candidates are random points instead of nearest
+  //! neighbors.
+  bool RandomCandidates() const { return randomCandidates; }
+  //! Modify whether the candidates are random points instead of nearest
+  //! neighbors.
+  bool& RandomCandidates() { return randomCandidates; }
+
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
 
@@ -182,6 +198,10 @@ class NCA
 
   //! Distance to be used.
   DistanceType distance;
+  //! Number of candidate neighbors of each point (0 for all points).
+  size_t numCandidates;
+  //! Whether the candidates are random instead of nearest neighbors.
+  bool randomCandidates;
 };
 
 } // namespace mlpack
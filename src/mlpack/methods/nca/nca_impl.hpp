@@ -25,12 +25,18 @@ NCA<DistanceType, DeprecatedOptimizerType>::NCA(
     DistanceType distance) :
     dataset(&dataset),
     labels(&labels),
-    distance(std::move(distance))
+    distance(std::move(distance)),
+    numCandidates(0),
+    randomCandidates(false)
 { /* Nothing to do. */ }
 
 template<typename DistanceType, typename DeprecatedOptimizerType>
 NCA<DistanceType, DeprecatedOptimizerType>::NCA(DistanceType distance) :
-    distance(std::move(distance))
+    dataset(NULL),
+    labels(NULL),
+    distance(std::move(distance)),
+    numCandidates(0),
+    randomCandidates(false)
 { /* Nothing to do. */ }
 
 template<typename DistanceType, typename DeprecatedOptimizerType>
@@ -84,7 +90,7 @@ void NCA<DistanceType, DeprecatedOptimizerType>::LearnDistance(
     CallbackTypes&&... callbacks) const
 {
   SoftmaxErrorFunction<MatType, LabelsType, DistanceType> errorFunction(
-      dataset, labels, distance);
+      dataset, labels, distance, numCandidates, randomCandidates);
 
   // See if we were passed an initialized matrix.
   if ((outputMatrix.n_rows != dataset.n_rows) ||
@@ -17,6 +17,7 @@
 #include <mlpack/core/distances/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 
@@ -39,6 +40,17 @@ namespace mlpack {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * Each evaluation of p_i takes O(n) time, which makes an epoch O(n^2).  For
+ * large datasets, the sum over k can instead be restricted to a fixed set of
+ * candidate neighbors for each point: either its nearest neighbors in the
+ * original space (found with a tree, via NeighborSearch), or a random subset
+ * of the points.  Since exp(-|| A x_i - A x_k ||^2) is negligible for all but
+ * the closest points, the nearest neighbors give a good approximation, and an
+ * epoch then takes O(n c) time for c candidates.  In this mode, the stretched
+ * points are only computed for the points in the batch and their candidates,
+ * and the softmax terms are cached between Evaluate() and Gradient() calls
+ * with the same coordinates and batch.
  */
 template<typename MatType = arma::mat,
          typename LabelsType = arma::Row<size_t>,
@@ -60,10 +72,16 @@ class SoftmaxErrorFunction
    * @param dataset Matrix containing the dataset.
    * @param labels Vector of class labels for each point in the dataset.
    * @param metric Instantiated metric (optional).
+   * @param numCandidates Number of candidate neighbors for each point; if 0,
+   *     all other points are used.
+   * @param randomCandidates If true, the candidates are a random subset of the
+   *     points instead of the nearest neighbors.
    */
   SoftmaxErrorFunction(const MatType& dataset,
                        const LabelsType& labels,
-                       DistanceType metric = DistanceType());
+                       DistanceType metric = DistanceType(),
+                       const size_t numCandidates = 0,
+                       const bool randomCandidates = false);
 
   /**
    * Shuffle the dataset.
@@ -137,6 +155,10 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the candidate neighbors of each point (one column per point), if the
+  //! sums are restricted to candidates.
+  const arma::umat& Candidates() const { return candidates; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   MatType dataset;
@@ -160,6 +182,20 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! Whether the candidates are a random subset instead of nearest neighbors.
+  bool randomCandidates;
+  //! Candidate neighbors of each point; empty if all points are used.
+  arma::umat candidates;
+  //! Coordinates, first point and batch size of the cached softmax terms.
+  MatType lastCandidateCoordinates;
+  size_t lastBegin;
+  size_t lastBatchSize;
+  //! p_i for each point of the cached batch.
+  VecType candidateP;
+  //! For each candidate k of each point i of the cached batch, the weight
+  //! p_ik (p_i - 1) if k is in the class of i, and p_ik p_i otherwise.
+  MatType candidateWeights;
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
@@ -174,6 +210,19 @@ class SoftmaxErrorFunction
    * @param coordinates Coordinates matrix to use for precalculation.
    */
   void Precalculate(const MatType& coordinates);
+
+  /**
+   * Select numCandidates candidate neighbors for each point.
+   */
+  void SelectCandidates(const size_t numCandidates);
+
+  /**
+   * Compute p_i and the gradient weights of each point in the given batch,
+   * using only the candidates of each point, unless they are already cached.
+   */
+  void CandidateSoftmax(const MatType& coordinates,
+                        const size_t begin,
+                        const size_t batchSize);
 };
 
 } // namespace mlpack
@@ -24,12 +24,20 @@ template<typename MatType, typename LabelsType, typename DistanceType>
 SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::SoftmaxErrorFunction(
     const MatType& datasetIn,
     const LabelsType& labelsIn,
-    DistanceType distance) :
+    DistanceType distance,
+    const size_t numCandidates,
+    const bool randomCandidates) :
     distance(distance),
-    precalculated(false)
+    precalculated(false),
+    randomCandidates(randomCandidates),
+    lastBegin(0),
+    lastBatchSize(0)
 {
   MakeAlias(dataset, datasetIn, datasetIn.n_rows, datasetIn.n_cols, 0, false);
   MakeAlias(labels, labelsIn, labelsIn.n_elem, 0, false);
+
+  if (numCandidates > 0)
+    SelectCandidates(numCandidates);
 }
 
 //! Shuffle the dataset.
@@ -46,6 +54,10 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // The candidates refer to the old order of the points.
+  if (!candidates.is_empty())
+    SelectCandidates(candidates.n_rows);
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -54,6 +66,11 @@ typename MatType::elem_type
 SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Evaluate(
     const MatType& coordinates)
 {
+  // With candidates, the sums are not symmetric, so the separable
+  // implementation is used for all the points.
+  if (!candidates.is_empty())
+    return Evaluate(coordinates, 0, dataset.n_cols);
+
   // Calculate the denominators and numerators, if necessary.
   Precalculate(coordinates);
 
@@ -70,10 +87,14 @@ SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Evaluate(
     const size_t begin,
     const size_t batchSize)
 {
+  if (!candidates.is_empty())
+  {
+    CandidateSoftmax(coordinates, begin, batchSize);
+    return -accu(candidateP); // Negate because the optimizer is a minimizer.
+  }
+
   // Unfortunately each evaluation will take O(N) time because it requires a
   // scan over all points in the dataset.  Our objective is to compute p_i.
-  ElemType denominator = 0;
-  ElemType numerator = 0;
   ElemType result = 0;
 
   // It's quicker to do this now than one point at a time later.
@@ -82,6 +103,9 @@ SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Evaluate(
   #pragma omp parallel for reduction(+:result)
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
+    ElemType denominator = 0;
+    ElemType numerator = 0;
+
     for (size_t k = 0; k < dataset.n_cols; ++k)
     {
       // Don't consider the case where the points are the same.
@@ -118,6 +142,14 @@ template<typename MatType, typename LabelsType, typename DistanceType>
 void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Gradient(
     const MatType& coordinates, MatType& gradient)
 {
+  // With candidates, the sums are not symmetric, so the separable
+  // implementation is used for all the points.
+  if (!candidates.is_empty())
+  {
+    Gradient(coordinates, 0, gradient, dataset.n_cols);
+    return;
+  }
+
   // Calculate the denominators and numerators, if necessary.
   Precalculate(coordinates);
 
@@ -170,6 +202,36 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Gradient(
     GradType& gradient,
     const size_t batchSize)
 {
+  if (!candidates.is_empty())
+  {
+    CandidateSoftmax(coordinates, begin, batchSize);
+
+    // The gradient is -2 A sum_i sum_k w_ik x_ik x_ik^T, with the weights
+    // computed by CandidateSoftmax().
+    MatType sum(coordinates.n_cols, coordinates.n_cols, arma::fill::zeros);
+    #pragma omp parallel
+    {
+      MatType threadSum(coordinates.n_cols, coordinates.n_cols,
+          arma::fill::zeros);
+
+      #pragma omp for schedule(static)
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        const size_t i = begin + b;
+        MatType differences = dataset.cols(candidates.col(i));
+        differences.each_col() -= dataset.col(i);
+        threadSum += differences * arma::diagmat(candidateWeights.col(b)) *
+            differences.t();
+      }
+
+      #pragma omp critical
+      sum += threadSum;
+    }
+
+    gradient = -2 * coordinates * sum;
+    return;
+  }
+
   // The gradient involves two matrix terms which are eventually combined into
   // one.
   GradType firstTerm, secondTerm;
@@ -323,6 +385,122 @@ void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::SelectCandidates(
+    const size_t numCandidates)
+{
+  if (numCandidates >= dataset.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "SoftmaxErrorFunction::SoftmaxErrorFunction(): number of "
+        << "candidates (" << numCandidates << ") must be less than the number "
+        << "of points (" << dataset.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (randomCandidates)
+  {
+    candidates.set_size(numCandidates, dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      // Draw from the other n - 1 points.
+      arma::uvec sample = arma::randperm(dataset.n_cols - 1, numCandidates);
+      sample.elem(arma::find(sample >= i)) += 1;
+      candidates.col(i) = sample;
+    }
+  }
+  else
+  {
+    NeighborSearch<NearestNeighborSort, DistanceType, MatType> knn(dataset,
+        DUAL_TREE_MODE, 0, distance);
+    arma::Mat<size_t> neighbors;
+    MatType distances;
+    knn.Search(numCandidates, neighbors, distances);
+    candidates = arma::conv_to<arma::umat>::from(neighbors);
+  }
+
+  // Any cached softmax terms refer to the old candidates.
+  lastBatchSize = 0;
+}
+
+template<typename MatType, typename LabelsType, typename DistanceType>
+void SoftmaxErrorFunction<MatType, LabelsType, DistanceType>::CandidateSoftmax(
+    const MatType& coordinates,
+    const size_t begin,
+    const size_t batchSize)
+{
+  // Evaluate() and Gradient() are usually called with the same arguments.
+  if (begin == lastBegin && batchSize == lastBatchSize &&
+      arma::size(coordinates) == arma::size(lastCandidateCoordinates) &&
+      arma::all(arma::vectorise(coordinates == lastCandidateCoordinates)))
+    return;
+
+  const size_t numCandidates = candidates.n_rows;
+  candidateP.set_size(batchSize);
+  candidateWeights.set_size(numCandidates, batchSize);
+
+  // If the batch and its candidates cover most of the dataset, it is cheaper
+  // to stretch all of the points at once.
+  const bool stretchAll = (batchSize * (numCandidates + 1) >= dataset.n_cols);
+  if (stretchAll)
+    stretchedDataset = coordinates * dataset;
+
+  #pragma omp parallel for schedule(static)
+  for (size_t b = 0; b < batchSize; ++b)
+  {
+    const size_t i = begin + b;
+    const arma::uvec neighbors = candidates.col(i);
+
+    VecType point;
+    MatType stretchedCandidates;
+    if (stretchAll)
+    {
+      point = stretchedDataset.col(i);
+      stretchedCandidates = stretchedDataset.cols(neighbors);
+    }
+    else
+    {
+      point = coordinates * dataset.col(i);
+      stretchedCandidates = coordinates * dataset.cols(neighbors);
+    }
+
+    ElemType numerator = 0;
+    ElemType denominator = 0;
+    for (size_t j = 0; j < numCandidates; ++j)
+    {
+      const ElemType eval = std::exp(-distance.Evaluate(point,
+          stretchedCandidates.col(j)));
+      candidateWeights(j, b) = eval;
+      denominator += eval;
+      if (labels[i] == labels[neighbors[j]])
+        numerator += eval;
+    }
+
+    // If the denominator is zero, then all p_ik are zero and there is no
+    // contribution from this point.
+    if (denominator == 0)
+    {
+      candidateP[b] = 0;
+      candidateWeights.col(b).zeros();
+      continue;
+    }
+
+    // The weight of x_ik x_ik^T in the gradient is p_ik (p_i - 1) if k is in
+    // the class of i, and p_ik p_i otherwise.
+    const ElemType pi = numerator / denominator;
+    candidateP[b] = pi;
+    for (size_t j = 0; j < numCandidates; ++j)
+    {
+      const ElemType same = (labels[i] == labels[neighbors[j]]) ? 1 : 0;
+      candidateWeights(j, b) *= (pi - same) / denominator;
+    }
+  }
+
+  lastCandidateCoordinates = coordinates;
+  lastBegin = begin;
+  lastBatchSize = batchSize;
+}
+
 } // namespace mlpack
 
 #endif
@@ -12,5 +12,7 @@
 #define MLPACK_NEIGHBOR_SEARCH_HPP
 
 #include "neighbor_search/neighbor_search.hpp"
+#include "neighbor_search/live_neighbor_search.hpp"
+#include "neighbor_search/mahalanobis_neighbor_search.hpp"
 
 #endif
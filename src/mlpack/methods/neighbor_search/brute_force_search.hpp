@@ -0,0 +1,185 @@
+/**
+ * @file methods/neighbor_search/brute_force_search.hpp
+ *
+ * Defines the BruteForceSearch class, which computes neighbors by blocks, with
+ * matrix multiplications for the Euclidean distance.  This is used by
+ * NeighborSearch in NAIVE_MODE.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+#include <queue>
+
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+
+/**
+ * BruteForceSearch finds the k best neighbors of every query point by
+ * computing the distances to every reference point.  Instead of computing one
+ * base case at a time, it works on tiles: a block of query points against a
+ * block of reference points.  For nearest neighbor search with the (squared)
+ * Euclidean distance and dense data, each tile is computed with a single
+ * matrix multiplication (BLAS GEMM), using
+ *
+ *   || q - r ||^2 = || q ||^2 + || r ||^2 - 2 q^T r.
+ *
+ * These distances can have a large relative error for close points, so, like
+ * NeighborSearchRules::BaseCases(), they are only used to rule out the pairs
+ * that certainly cannot become candidates; the distances of the other pairs
+ * are computed exactly.  Otherwise, the distances are computed pair by pair.
+ *
+ * The top-k selection is fused with the tile loop: every pair of a tile is
+ * compared with the worst candidate of its query point right away, so the full
+ * distance matrix is never stored.  The candidates are kept exactly as
+ * NeighborSearchRules keeps them, and the reference points are visited in
+ * order, so the results (including ties) are the same as those of a
+ * pair-by-pair search.  The blocks of query points are processed in parallel
+ * with OpenMP.
+ *
+ * This is used by NeighborSearch in NAIVE_MODE.  It is most useful for
+ * high-dimensional data, where trees cannot prune, and works with
+ * single-precision (arma::fmat) data too.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam DistanceType The distance metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SortPolicy,
+         typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat>
+class BruteForceSearch
+{
+ public:
+  //! The type of element held by MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the BruteForceSearch object.
+   *
+   * @param distance Instantiated distance metric.
+   * @param queryBlockSize Number of query points in each tile.
+   * @param referenceBlockSize Number of reference points in each tile.
+   */
+  BruteForceSearch(const DistanceType& distance = DistanceType(),
+                   const size_t queryBlockSize = 256,
+                   const size_t referenceBlockSize = 2048);
+
+  /**
+   * Find the k best neighbors in the reference set of each point in the query
+   * set.  If sameSet is true, the query set must be the reference set, and a
+   * point is not returned as its own neighbor.
+   *
+   * @param querySet Set of query points.
+   * @param referenceSet Set of reference points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param sameSet Whether the query set is the reference set.
+   */
+  template<typename IndexType = size_t>
+  void Search(const MatType& querySet,
+              const MatType& referenceSet,
+              const size_t k,
+              arma::Mat<IndexType>& neighbors,
+              arma::Mat<ElemType>& distances,
+              const bool sameSet = false) const;
+
+  //! Get the number of query points in each tile.
+  size_t QueryBlockSize() const { return queryBlockSize; }
+  //! Modify the number of query points in each tile.
+  size_t& QueryBlockSize() { return queryBlockSize; }
+
+  //! Get the number of reference points in each tile.
+  size_t ReferenceBlockSize() const { return referenceBlockSize; }
+  //! Modify the number of reference points in each tile.
+  size_t& ReferenceBlockSize() { return referenceBlockSize; }
+
+ private:
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Compare two candidates based on the distance.
+  struct CandidateCmp
+  {
+    bool operator()(const Candidate& c1, const Candidate& c2) const
+    {
+      return !SortPolicy::IsBetter(c2.first, c1.first);
+    }
+  };
+
+  //! Use a priority queue to represent the list of candidate neighbors.
+  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
+      CandidateList;
+
+  //! Whether the tiles are computed with matrix multiplications.  This needs
+  //! the Euclidean distance and dense matrices, and the filter is only written
+  //! for nearest neighbor search.
+  static constexpr bool UseGEMM =
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      (std::is_same<DistanceType, LMetric<2, true>>::value ||
+       std::is_same<DistanceType, LMetric<2, false>>::value) &&
+      arma::is_Mat<MatType>::value;
+
+  /**
+   * Search the given tile with a matrix multiplication, and update the
+   * candidates of its query points.
+   */
+  template<bool UseBlock = UseGEMM>
+  void SearchTile(const MatType& querySet,
+                  const MatType& referenceSet,
+                  const size_t queryBegin,
+                  const size_t queryCount,
+                  const size_t referenceBegin,
+                  const size_t referenceCount,
+                  const arma::Row<ElemType>& queryNorms,
+                  const arma::Row<ElemType>& referenceNorms,
+                  const bool sameSet,
+                  DistanceType& tileDistance,
+                  std::vector<CandidateList>& candidates,
+                  const typename std::enable_if_t<UseBlock>* = 0) const;
+
+  /**
+   * Search the given tile one pair at a time, and update the candidates of its
+   * query points.
+   */
+  template<bool UseBlock = UseGEMM>
+  void SearchTile(const MatType& querySet,
+                  const MatType& referenceSet,
+                  const size_t queryBegin,
+                  const size_t queryCount,
+                  const size_t referenceBegin,
+                  const size_t referenceCount,
+                  const arma::Row<ElemType>& queryNorms,
+                  const arma::Row<ElemType>& referenceNorms,
+                  const bool sameSet,
+                  DistanceType& tileDistance,
+                  std::vector<CandidateList>& candidates,
+                  const typename std::enable_if_t<!UseBlock>* = 0) const;
+
+  //! Insert the given candidate if it is better than the worst one.
+  static void InsertNeighbor(CandidateList& pqueue,
+                             const size_t neighbor,
+                             const double dist);
+
+  //! The instantiated distance metric.
+  DistanceType distance;
+  //! The number of query points in each tile.
+  size_t queryBlockSize;
+  //! The number of reference points in each tile.
+  size_t referenceBlockSize;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "brute_force_search_impl.hpp"
+
+#endif
@@ -0,0 +1,217 @@
+/**
+ * @file methods/neighbor_search/brute_force_search_impl.hpp
+ *
+ * Implementation of the BruteForceSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_BRUTE_FORCE_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "brute_force_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+BruteForceSearch<SortPolicy, DistanceType, MatType>::BruteForceSearch(
+    const DistanceType& distance,
+    const size_t queryBlockSize,
+    const size_t referenceBlockSize) :
+    distance(distance),
+    queryBlockSize(queryBlockSize),
+    referenceBlockSize(referenceBlockSize)
+{
+  if (queryBlockSize == 0 || referenceBlockSize == 0)
+  {
+    throw std::invalid_argument("BruteForceSearch: block sizes must be "
+        "positive");
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<typename IndexType>
+void BruteForceSearch<SortPolicy, DistanceType, MatType>::Search(
+    const MatType& querySet,
+    const MatType& referenceSet,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const bool sameSet) const
+{
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  if (k == 0)
+    return;
+
+  // The squared norms are only needed for the matrix multiplications.
+  arma::Row<ElemType> queryNorms, referenceNorms;
+  if (UseGEMM)
+  {
+    referenceNorms = arma::sum(arma::square(referenceSet));
+    queryNorms = sameSet ? referenceNorms : arma::Row<ElemType>(
+        arma::sum(arma::square(querySet)));
+  }
+
+  // The candidates of every query point start out as k copies of the worst
+  // possible candidate, as in NeighborSearchRules.
+  const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
+      size_t() - 1);
+  const CandidateList initialList(CandidateCmp(),
+      std::vector<Candidate>(k, def));
+
+  const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+      queryBlockSize;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(Parallel::Threads())
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t queryBegin = b * queryBlockSize;
+    const size_t queryCount = std::min(queryBlockSize,
+        (size_t) querySet.n_cols - queryBegin);
+
+    // Each block has its own distance metric, since Evaluate() may not be
+    // const.
+    DistanceType tileDistance(distance);
+    std::vector<CandidateList> candidates(queryCount, initialList);
+
+    // The reference blocks are visited in order, so that the candidates are
+    // inserted in the same order as with a pair-by-pair search.
+    for (size_t referenceBegin = 0; referenceBegin < referenceSet.n_cols;
+         referenceBegin += referenceBlockSize)
+    {
+      const size_t referenceCount = std::min(referenceBlockSize,
+          (size_t) referenceSet.n_cols - referenceBegin);
+      SearchTile(querySet, referenceSet, queryBegin, queryCount,
+          referenceBegin, referenceCount, queryNorms, referenceNorms, sameSet,
+          tileDistance, candidates);
+    }
+
+    for (size_t i = 0; i < queryCount; ++i)
+    {
+      CandidateList& pqueue = candidates[i];
+      for (size_t j = 1; j <= k; ++j)
+      {
+        neighbors(k - j, queryBegin + i) = (IndexType) pqueue.top().second;
+        distances(k - j, queryBegin + i) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<bool UseBlock>
+void BruteForceSearch<SortPolicy, DistanceType, MatType>::SearchTile(
+    const MatType& querySet,
+    const MatType& referenceSet,
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount,
+    const arma::Row<ElemType>& queryNorms,
+    const arma::Row<ElemType>& referenceNorms,
+    const bool sameSet,
+    DistanceType& tileDistance,
+    std::vector<CandidateList>& candidates,
+    const typename std::enable_if_t<UseBlock>*) const
+{
+  // The points of both blocks are contiguous, so no memory is copied.
+  MatType queryBlock, referenceBlock;
+  MakeColsAlias(queryBlock, querySet, queryBegin, queryCount, false);
+  MakeColsAlias(referenceBlock, referenceSet, referenceBegin, referenceCount,
+      false);
+
+  // One column of products for each query point.
+  const MatType products = referenceBlock.t() * queryBlock;
+
+  // The squared distances computed from the matrix product can have a large
+  // relative error when the points are close together, so they are only used
+  // to rule out pairs that certainly can't be inserted as candidates (see
+  // NeighborSearchRules::BlockBaseCases()).
+  const double eps = std::numeric_limits<ElemType>::epsilon();
+  const double dotError = 2.0 * (querySet.n_rows + 2) * eps;
+
+  for (size_t i = 0; i < queryCount; ++i)
+  {
+    const size_t queryIndex = queryBegin + i;
+    const double queryNorm = queryNorms[queryIndex];
+    const ElemType* productCol = products.colptr(i);
+    CandidateList& pqueue = candidates[i];
+
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      const size_t referenceIndex = referenceBegin + j;
+      if (sameSet && (queryIndex == referenceIndex))
+        continue;
+
+      const double referenceNorm = referenceNorms[referenceIndex];
+      const double worst = pqueue.top().first;
+      const double worstSq = DistanceType::TakeRoot ? (worst * worst) : worst;
+      const double approxSq = queryNorm + referenceNorm -
+          2.0 * productCol[j];
+      const double tolerance = dotError * (queryNorm + referenceNorm) +
+          4.0 * eps * worstSq;
+      if (approxSq > worstSq + tolerance)
+        continue;
+
+      const double dist = tileDistance.Evaluate(querySet.col(queryIndex),
+          referenceSet.col(referenceIndex));
+      InsertNeighbor(pqueue, referenceIndex, dist);
+    }
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+template<bool UseBlock>
+void BruteForceSearch<SortPolicy, DistanceType, MatType>::SearchTile(
+    const MatType& querySet,
+    const MatType& referenceSet,
+    const size_t queryBegin,
+    const size_t queryCount,
+    const size_t referenceBegin,
+    const size_t referenceCount,
+    const arma::Row<ElemType>& /* queryNorms */,
+    const arma::Row<ElemType>& /* referenceNorms */,
+    const bool sameSet,
+    DistanceType& tileDistance,
+    std::vector<CandidateList>& candidates,
+    const typename std::enable_if_t<!UseBlock>*) const
+{
+  const size_t referenceEnd = referenceBegin + referenceCount;
+  for (size_t i = 0; i < queryCount; ++i)
+  {
+    const size_t queryIndex = queryBegin + i;
+    for (size_t ref = referenceBegin; ref < referenceEnd; ++ref)
+    {
+      if (sameSet && (queryIndex == ref))
+        continue;
+
+      const double dist = tileDistance.Evaluate(querySet.col(queryIndex),
+          referenceSet.col(ref));
+      InsertNeighbor(candidates[i], ref, dist);
+    }
+  }
+}
+
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void BruteForceSearch<SortPolicy, DistanceType, MatType>::InsertNeighbor(
+    CandidateList& pqueue,
+    const size_t neighbor,
+    const double dist)
+{
+  Candidate c = std::make_pair(dist, neighbor);
+
+  if (CandidateCmp()(c, pqueue.top()))
+  {
+    pqueue.pop();
+    pqueue.push(c);
+  }
+}
+
+} // namespace mlpack
+
+#endif
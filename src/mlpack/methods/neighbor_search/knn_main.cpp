@@ -44,7 +44,13 @@ BINDING_LONG_DESC(
     "points using kd-trees or cover trees (cover tree support is experimental "
     "and may be slow). You may specify a separate set of "
     "reference points and query points, or just a reference set which will be "
-    "used as both the reference and query set.");
+    "used as both the reference and query set."
+    "\n\n"
+    "The 'naive' algorithm does not use trees; it computes the distances by "
+    "blocks of points, with matrix multiplications, in parallel.  For "
+    "high-dimensional data, where trees cannot prune, it is often the fastest "
+    "choice, in particular with single precision (see " +
+    PRINT_PARAM_STRING("precision") + ").");
 
 // Example.
 BINDING_EXAMPLE(
@@ -107,6 +113,9 @@ PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
 
 PARAM_FLAG("random_basis", "Before tree-building, project the data onto a "
     "random orthogonal basis.", "R");
+PARAM_STRING_IN("precision", "Precision of the reference set and tree held by "
+    "the model: 'double' or 'float'.  Using 'float' halves the memory used by "
+    "the model.", "p", "double");
 PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
@@ -129,6 +138,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
   ReportIgnoredParam(params, {{ "input_model", true }}, "random_basis");
   ReportIgnoredParam(params, {{ "input_model", true }}, "tau");
   ReportIgnoredParam(params, {{ "input_model", true }}, "rho");
+  ReportIgnoredParam(params, {{ "input_model", true }}, "precision");
   if (params.Has("input_model") && params.Has("leaf_size"))
   {
     Log::Warn << PRINT_PARAM_STRING("leaf_size") << " will only be considered"
@@ -208,6 +218,8 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     RequireParamInSet<string>(params, "tree_type", { "kd", "cover", "r",
         "r-star", "ball", "x", "hilbert-r", "r-plus", "r-plus-plus", "spill",
         "vp", "rp", "max-rp", "ub", "oct" }, true, "unknown tree type");
+    RequireParamInSet<string>(params, "precision", { "double", "float" }, true,
+        "unknown precision");
 
     knn = new KNNModel();
 
@@ -247,6 +259,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     knn->LeafSize() = size_t(lsInt);
     knn->Tau() = tau;
     knn->Rho() = rho;
+    knn->SinglePrecision() = (params.Get<string>("precision") == "float");
 
     Log::Info << "Using reference data from "
         << params.GetPrintable<arma::mat>("reference") << "." << endl;
@@ -272,7 +285,7 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     Log::Info << "Loaded kNN model from '"
         << params.GetPrintable<KNNModel*>("input_model") << "' (trained on "
-        << knn->Dataset().n_rows << "x" << knn->Dataset().n_cols
+        << knn->Dimensionality() << "x" << knn->NumReferencePoints()
         << " dataset)." << endl;
   }
 
@@ -287,10 +300,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       Log::Info << "Using query data from "
           << params.GetPrintable<arma::mat>("query") << "." << endl;
       queryData = std::move(params.Get<arma::mat>("query"));
-      if (queryData.n_rows != knn->Dataset().n_rows)
+      if (queryData.n_rows != knn->Dimensionality())
       {
         // Clean memory if needed before crashing.
-        const size_t dimensions = knn->Dataset().n_rows;
+        const size_t dimensions = knn->Dimensionality();
         if (params.Has("reference"))
           delete knn;
         Log::Fatal << "Query has invalid dimensions(" << queryData.n_rows <<
@@ -301,10 +314,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
     // Sanity check on k value: must be greater than 0, must be less than or
     // equal to the number of reference points.  Since it is unsigned,
     // we only test the upper bound.
-    if (k > knn->Dataset().n_cols)
+    if (k > knn->NumReferencePoints())
     {
       // Clean memory if needed before crashing.
-      const size_t referencePoints = knn->Dataset().n_cols;
+      const size_t referencePoints = knn->NumReferencePoints();
       if (params.Has("reference"))
         delete knn;
       Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
@@ -314,10 +327,10 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 
     // Sanity check on k value: must not be equal to the number of reference
     // points when query data has not been provided.
-    if (!params.Has("query") && k == knn->Dataset().n_cols)
+    if (!params.Has("query") && k == knn->NumReferencePoints())
     {
       // Clean memory if needed before crashing.
-      const size_t referencePoints = knn->Dataset().n_cols;
+      const size_t referencePoints = knn->NumReferencePoints();
       if (params.Has("reference"))
         delete knn;
       Log::Fatal << "Invalid k: " << k << "; must be less than the number of "
@@ -0,0 +1,184 @@
+/**
+ * @file methods/neighbor_search/live_neighbor_search.hpp
+ *
+ * Defines the LiveNeighborSearch class, which lets any number of threads search
+ * a NeighborSearch model while another thread adds points to it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_LIVE_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_LIVE_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include "neighbor_search.hpp"
+
+#include <memory>
+#include <mutex>
+
+namespace mlpack {
+
+/**
+ * LiveNeighborSearch is an index for neighbor search that is searched and
+ * updated at the same time: any number of threads may call Search() while one
+ * thread calls Insert(), and Search() never waits for Insert() to finish.
+ *
+ * This is done with copy-on-write snapshots, in the manner of read-copy-update.
+ * A snapshot is an immutable NeighborSearch model, plus the points that were
+ * inserted since the model was built.  Search() takes a reference to the
+ * current snapshot, searches the model with the const (thread-safe) overload of
+ * NeighborSearch::Search(), and evaluates the inserted points by brute force.
+ * Insert() makes a new snapshot that shares the model of the current one, and
+ * publishes it atomically; when enough points are buffered, the new snapshot
+ * gets a new model built on all of the points.  Snapshots are reference
+ * counted, so an old snapshot (and its model) is freed as soon as the last
+ * search that uses it returns.
+ *
+ * The nodes of the tree are never modified after the tree is built, so any tree
+ * type may be used; the tree only needs to not have self-children (so the
+ * cover tree cannot be used), since searches of those trees are not
+ * thread-safe.  The points get the indices they would have in a NeighborSearch
+ * model: the points of the initial reference set come first, and inserted
+ * points follow in the order they were inserted.
+ *
+ * @code
+ * LiveNeighborSearch<> index(referenceSet);
+ *
+ * // In the thread that ingests points:
+ * index.Insert(newPoints);
+ *
+ * // In any number of serving threads, at the same time:
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * index.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam DistanceType The distance metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename DistanceType = EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+class LiveNeighborSearch
+{
+ public:
+  //! The type of the model held by each snapshot.
+  typedef NeighborSearch<SortPolicy, DistanceType, MatType, TreeType>
+      ModelType;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  static_assert(!TreeTraits<typename ModelType::Tree>::HasSelfChildren,
+      "LiveNeighborSearch cannot be used with trees that have self-children, "
+      "because they cannot be searched by many threads at once.");
+
+  /**
+   * Build the index on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param maxInsertedPoints Maximum number of inserted points that are kept
+   *     outside of the model before a new model is built; if 0, this is the
+   *     square root of the number of points (and at least 100).
+   * @param distance An optional instance of the DistanceType class.
+   */
+  LiveNeighborSearch(MatType referenceSet,
+                     const NeighborSearchMode mode = DUAL_TREE_MODE,
+                     const double epsilon = 0,
+                     const size_t maxInsertedPoints = 0,
+                     const DistanceType distance = DistanceType());
+
+  /**
+   * Add the given points to the index.  The points are visible to every search
+   * that starts after this returns.  Calls to Insert() and Rebuild() are
+   * serialized; they do not block Search().
+   *
+   * @param points Points to add.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Build a new model on all of the points, so that no inserted points are
+   * searched by brute force.  This does not block Search().
+   */
+  void Rebuild();
+
+  /**
+   * Search for the neighbors of each point in the given query set, in the
+   * latest published snapshot of the index.  This may be called from any
+   * number of threads at once, and while another thread calls Insert().
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
+  //! Get the number of points in the latest published snapshot.
+  size_t NumReferencePoints() const;
+
+  //! Get the number of points in the latest published snapshot that are not in
+  //! its model yet.
+  size_t NumInsertedPoints() const;
+
+ private:
+  //! An immutable state of the index.
+  struct Snapshot
+  {
+    //! The model, which holds the first points of the index.
+    std::shared_ptr<const ModelType> model;
+    //! The points inserted after the model was built.
+    MatType insertedPoints;
+  };
+
+  //! Return the number of inserted points that may be buffered in a snapshot
+  //! with the given number of points.
+  size_t MaxInsertedPoints(const size_t points) const;
+
+  //! Build a new model on the given points (in index order).
+  std::shared_ptr<const ModelType> BuildModel(const MatType& points) const;
+
+  //! Get the latest published snapshot.
+  std::shared_ptr<const Snapshot> Current() const;
+
+  //! Publish the given snapshot.
+  void Publish(std::shared_ptr<const Snapshot> next);
+
+  //! The latest published snapshot.  This is only accessed atomically.
+  std::shared_ptr<const Snapshot> snapshot;
+  //! All of the points of the latest published model, in index order.  This is
+  //! only used by the writer.
+  MatType modelPoints;
+  //! Serializes Insert() and Rebuild().
+  std::mutex writeMutex;
+
+  //! The search mode of the models.
+  NeighborSearchMode searchMode;
+  //! The relative approximate error of the models.
+  double epsilon;
+  //! The maximum number of inserted points (0 for the default).
+  size_t maxInsertedPoints;
+  //! The distance metric of the models.
+  DistanceType distance;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "live_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file methods/neighbor_search/live_neighbor_search_impl.hpp
+ *
+ * Implementation of the LiveNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_LIVE_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_LIVE_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "live_neighbor_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+LiveNeighborSearch(MatType referenceSet,
+                   const NeighborSearchMode mode,
+                   const double epsilon,
+                   const size_t maxInsertedPoints,
+                   const DistanceType distance) :
+    modelPoints(referenceSet),
+    searchMode(mode),
+    epsilon(epsilon),
+    maxInsertedPoints(maxInsertedPoints),
+    distance(distance)
+{
+  std::shared_ptr<Snapshot> first(new Snapshot());
+  first->model = std::make_shared<const ModelType>(std::move(referenceSet),
+      searchMode, epsilon, distance);
+  Publish(std::move(first));
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Insert(
+    const MatType& points)
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  const std::shared_ptr<const Snapshot> current = Current();
+
+  if (points.n_rows != modelPoints.n_rows && NumReferencePoints() > 0)
+  {
+    std::ostringstream oss;
+    oss << "LiveNeighborSearch::Insert(): dimensionality of points ("
+        << points.n_rows << ") does not match dimensionality of reference set ("
+        << modelPoints.n_rows << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::shared_ptr<Snapshot> next(new Snapshot());
+  if (current->insertedPoints.n_cols == 0)
+    next->insertedPoints = points;
+  else
+    next->insertedPoints = join_rows(current->insertedPoints, points);
+
+  const size_t totalPoints = modelPoints.n_cols + next->insertedPoints.n_cols;
+  if (next->insertedPoints.n_cols > MaxInsertedPoints(totalPoints))
+  {
+    // The new model is built before anything is changed, so that the index is
+    // left as it was if building it fails.
+    MatType allPoints = join_rows(modelPoints, next->insertedPoints);
+    next->model = BuildModel(allPoints);
+    next->insertedPoints.clear();
+    modelPoints = std::move(allPoints);
+  }
+  else
+  {
+    next->model = current->model;
+  }
+
+  Publish(std::move(next));
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Rebuild()
+{
+  std::lock_guard<std::mutex> lock(writeMutex);
+  const std::shared_ptr<const Snapshot> current = Current();
+  if (current->insertedPoints.n_cols == 0)
+    return;
+
+  MatType allPoints = join_rows(modelPoints, current->insertedPoints);
+  std::shared_ptr<Snapshot> next(new Snapshot());
+  next->model = BuildModel(allPoints);
+  modelPoints = std::move(allPoints);
+
+  Publish(std::move(next));
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  // Holding a reference to the snapshot keeps it alive until the search is
+  // done, even if a newer snapshot is published in the meantime.
+  const std::shared_ptr<const Snapshot> current = Current();
+  const ModelType& model = *current->model;
+  const MatType& insertedPoints = current->insertedPoints;
+  const size_t treePoints = model.NumReferencePoints();
+
+  if (k > treePoints + insertedPoints.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set ("
+        << (treePoints + insertedPoints.n_cols) << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (insertedPoints.n_cols == 0)
+  {
+    model.Search(querySet, k, neighbors, distances);
+    return;
+  }
+
+  const size_t treeK = std::min(k, treePoints);
+  arma::Mat<size_t> treeNeighbors;
+  arma::Mat<ElemType> treeDistances;
+  if (treeK > 0)
+    model.Search(querySet, treeK, treeNeighbors, treeDistances);
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Orders candidates by distance, and then by index.
+  typedef std::pair<ElemType, size_t> Candidate;
+  const auto better = [](const Candidate& a, const Candidate& b)
+  {
+    if (a.first == b.first)
+      return a.second < b.second;
+    return SortPolicy::IsBetter(a.first, b.first);
+  };
+
+  DistanceType searchDistance(model.Distance());
+
+  #pragma omp parallel for num_threads(Parallel::Threads()) schedule(static)
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    std::vector<Candidate> candidates;
+    candidates.reserve(treeK + insertedPoints.n_cols);
+
+    for (size_t j = 0; j < treeK; ++j)
+    {
+      if (treeNeighbors(j, i) >= treePoints)
+        continue; // Not enough neighbors were found.
+
+      candidates.push_back(Candidate(treeDistances(j, i),
+          treeNeighbors(j, i)));
+    }
+
+    // The inserted points are evaluated by brute force.
+    for (size_t j = 0; j < insertedPoints.n_cols; ++j)
+    {
+      candidates.push_back(Candidate(searchDistance.Evaluate(querySet.col(i),
+          insertedPoints.col(j)), treePoints + j));
+    }
+
+    const size_t found = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + found,
+        candidates.end(), better);
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < found)
+      {
+        neighbors(j, i) = candidates[j].second;
+        distances(j, i) = candidates[j].first;
+      }
+      else
+      {
+        neighbors(j, i) = size_t(-1);
+        distances(j, i) = SortPolicy::WorstDistance();
+      }
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+NumReferencePoints() const
+{
+  const std::shared_ptr<const Snapshot> current = Current();
+  return current->model->NumReferencePoints() +
+      current->insertedPoints.n_cols;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+NumInsertedPoints() const
+{
+  return Current()->insertedPoints.n_cols;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+size_t LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::
+MaxInsertedPoints(const size_t points) const
+{
+  if (maxInsertedPoints > 0)
+    return maxInsertedPoints;
+
+  // This is the same bound as the one NeighborSearch uses for its buffered
+  // updates: each inserted point costs one distance evaluation per query point.
+  return std::max((size_t) 100, (size_t) std::sqrt((double) points));
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+std::shared_ptr<const typename LiveNeighborSearch<SortPolicy, DistanceType,
+    MatType, TreeType>::ModelType>
+LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::BuildModel(
+    const MatType& points) const
+{
+  return std::make_shared<const ModelType>(MatType(points), searchMode,
+      epsilon, distance);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+std::shared_ptr<const typename LiveNeighborSearch<SortPolicy, DistanceType,
+    MatType, TreeType>::Snapshot>
+LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Current()
+    const
+{
+  return std::atomic_load(&snapshot);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void LiveNeighborSearch<SortPolicy, DistanceType, MatType, TreeType>::Publish(
+    std::shared_ptr<const Snapshot> next)
+{
+  std::atomic_store(&snapshot, std::move(next));
+}
+
+} // namespace mlpack
+
+#endif
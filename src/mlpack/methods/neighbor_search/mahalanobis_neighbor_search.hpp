@@ -0,0 +1,176 @@
+/**
+ * @file methods/neighbor_search/mahalanobis_neighbor_search.hpp
+ *
+ * Defines the MahalanobisNeighborSearch class, which performs neighbor search
+ * with the Mahalanobis distance by searching whitened data with the Euclidean
+ * distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+
+/**
+ * MahalanobisNeighborSearch finds neighbors under a MahalanobisDistance,
+ *
+ * @f[
+ * d(x, y) = \sqrt{(x - y)^T Q (x - y)},
+ * @f]
+ *
+ * without evaluating the distance for every pair.  Q is factored once as
+ * Q = L^T L (see MahalanobisDistance::Whitening()), and the reference and query
+ * points are multiplied by L; the Mahalanobis distance between two points is
+ * then the Euclidean distance between the transformed points.  The transformed
+ * data is searched by a NeighborSearch object with an LMetric, so all of the
+ * trees (including the default KDTree) and the blocked brute-force search can
+ * be used, and tree bounds prune as well as they do for Euclidean data.
+ *
+ * The transformation changes neither the indices of the points nor the
+ * distances, so the results are returned as they are.  If TakeRoot is false,
+ * the squared Mahalanobis distance is used, and the transformed data is
+ * searched with the squared Euclidean distance.
+ *
+ * @code
+ * // Q is the inverse covariance matrix.
+ * MahalanobisNeighborSearch<> knn(referenceSet,
+ *     MahalanobisDistance<>(std::move(q)));
+ *
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * knn.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam TakeRoot If false, the squared Mahalanobis distance is used.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         bool TakeRoot = true,
+         typename MatType = arma::mat,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+class MahalanobisNeighborSearch
+{
+ public:
+  //! The Mahalanobis distance that results are computed with.
+  typedef MahalanobisDistance<TakeRoot, MatType> DistanceType;
+  //! The type of the model that searches the transformed data.
+  typedef NeighborSearch<SortPolicy, LMetric<2, TakeRoot>, MatType, TreeType>
+      ModelType;
+  //! The type of element held in MatType.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the MahalanobisNeighborSearch object, and train it on the given
+   * reference set.  Q is factored here, so an exception is thrown if it is
+   * not symmetric positive semidefinite.
+   *
+   * @param referenceSet Set of reference points.
+   * @param distance Mahalanobis distance to search with.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  MahalanobisNeighborSearch(MatType referenceSet,
+                            DistanceType distance,
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0);
+
+  /**
+   * Create the MahalanobisNeighborSearch object without any reference data;
+   * Train() must be called before searching.
+   *
+   * @param distance Mahalanobis distance to search with.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  MahalanobisNeighborSearch(DistanceType distance = DistanceType(),
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0);
+
+  /**
+   * Set the reference set to the given dataset, which is transformed into
+   * whitened space (and a tree is built on it, if necessary).
+   *
+   * @param referenceSet New set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * For each point in the query set, compute the nearest neighbors in the
+   * reference set under the Mahalanobis distance.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  template<typename IndexType = size_t>
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<IndexType>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  /**
+   * For each point in the reference set, compute the nearest neighbors in the
+   * reference set (excluding the point itself) under the Mahalanobis
+   * distance.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  template<typename IndexType = size_t>
+  void Search(const size_t k,
+              arma::Mat<IndexType>& neighbors,
+              arma::Mat<ElemType>& distances);
+
+  /**
+   * Transform the given points into the whitened space that is searched.
+   *
+   * @param points Points to transform.
+   * @param whitened Matrix to store the transformed points in.
+   */
+  void Whiten(const MatType& points, MatType& whitened) const;
+
+  //! Get the Mahalanobis distance.  To change it, create a new object.
+  const DistanceType& Distance() const { return distance; }
+
+  //! Get the whitening transformation L (Q = L^T L).
+  const MatType& Whitening() const { return whitening; }
+
+  //! Get the model that searches the transformed data.
+  const ModelType& Model() const { return model; }
+  //! Modify the model that searches the transformed data.
+  ModelType& Model() { return model; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The Mahalanobis distance.
+  DistanceType distance;
+  //! The whitening transformation of the Q matrix of the distance.
+  MatType whitening;
+  //! The model that searches the whitened data.
+  ModelType model;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "mahalanobis_neighbor_search_impl.hpp"
+
+#endif
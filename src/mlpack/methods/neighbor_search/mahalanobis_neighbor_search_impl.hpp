@@ -0,0 +1,143 @@
+/**
+ * @file methods/neighbor_search/mahalanobis_neighbor_search_impl.hpp
+ *
+ * Implementation of the MahalanobisNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mahalanobis_neighbor_search.hpp"
+
+namespace mlpack {
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::
+MahalanobisNeighborSearch(MatType referenceSet,
+                          DistanceType distanceIn,
+                          const NeighborSearchMode mode,
+                          const double epsilon) :
+    distance(std::move(distanceIn)),
+    model(mode, epsilon)
+{
+  distance.Whitening(whitening);
+  Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::
+MahalanobisNeighborSearch(DistanceType distanceIn,
+                          const NeighborSearchMode mode,
+                          const double epsilon) :
+    distance(std::move(distanceIn)),
+    model(mode, epsilon)
+{
+  // The distance may not have a Q matrix yet, if it was default-constructed.
+  if (distance.Q().n_elem > 0)
+    distance.Whitening(whitening);
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::Train(
+    MatType referenceSet)
+{
+  MatType whitened;
+  Whiten(referenceSet, whitened);
+  // The original points are not needed anymore.
+  referenceSet.clear();
+  model.Train(std::move(whitened));
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename IndexType>
+void MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  MatType whitened;
+  Whiten(querySet, whitened);
+  model.Search(whitened, k, neighbors, distances);
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename IndexType>
+void MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::Search(
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  model.Search(k, neighbors, distances);
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::Whiten(
+    const MatType& points,
+    MatType& whitened) const
+{
+  if (points.n_rows != whitening.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisNeighborSearch::Whiten(): points have dimensionality "
+        << points.n_rows << ", but the Q matrix of the distance has "
+        << "dimensionality " << whitening.n_cols << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  whitened = whitening * points;
+}
+
+template<typename SortPolicy,
+         bool TakeRoot,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename Archive>
+void MahalanobisNeighborSearch<SortPolicy, TakeRoot, MatType, TreeType>::
+serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(distance));
+  ar(CEREAL_NVP(whitening));
+  ar(CEREAL_NVP(model));
+}
+
+} // namespace mlpack
+
+#endif
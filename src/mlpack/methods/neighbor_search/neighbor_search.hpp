@@ -19,6 +19,7 @@
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "sort_policies/furthest_neighbor_sort.hpp"
 #include "neighbor_search_rules.hpp"
+#include "brute_force_search.hpp"
 #include "unmap.hpp"
 
 namespace mlpack {
@@ -28,6 +29,7 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 class LeafSizeNSWrapper;
@@ -38,7 +40,8 @@ enum NeighborSearchMode
   NAIVE_MODE,
   SINGLE_TREE_MODE,
   DUAL_TREE_MODE,
-  GREEDY_SINGLE_TREE_MODE
+  GREEDY_SINGLE_TREE_MODE,
+  BEAM_SINGLE_TREE_MODE
 };
 
 /**
@@ -62,6 +65,9 @@ enum NeighborSearchMode
  *     (defaults to the tree's default traverser).
  * @tparam SingleTreeTraversalType The type of single tree traversal to use
  *     (defaults to the tree's default traverser).
+ * @tparam CountersType The policy that collects traversal statistics during
+ *     tree-based searches (see TraversalCounters); by default, nothing is
+ *     collected.
  */
 template<typename SortPolicy = NearestNeighborSort,
          typename DistanceType = EuclideanDistance,
@@ -76,7 +82,8 @@ template<typename SortPolicy = NearestNeighborSort,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<DistanceType,
                       NeighborSearchStat<SortPolicy>,
-                      MatType>::template SingleTreeTraverser>
+                      MatType>::template SingleTreeTraverser,
+         typename CountersType = NullTraversalCounters>
 class NeighborSearch
 {
  public:
@@ -205,6 +212,45 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Add the given points to the reference set.  The new points get the next
+   * indices after all of the current reference points, in order.  Instead of
+   * rebuilding the reference tree every time, the new points are held in a
+   * buffer and searched by brute force (in addition to the tree) until enough
+   * updates have accumulated, at which point the tree is rebuilt on all of the
+   * reference points (see Rebuild()).
+   *
+   * @param points New reference points.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Remove the reference point with the given index from the reference set.
+   * All reference points with larger indices are shifted down by one, just
+   * like removing a column of a matrix.  Points that are in the reference tree
+   * are only marked as removed (and skipped in the results of Search()) until
+   * the tree is rebuilt.
+   *
+   * @param index Index of reference point to remove.
+   */
+  void Remove(const size_t index);
+
+  /**
+   * Rebuild the reference tree on all of the reference points, applying every
+   * Insert() and Remove() that has not been applied to the tree yet.  This is
+   * done automatically when the number of buffered updates becomes large, but
+   * it can also be called manually at a convenient time.  The indices of the
+   * reference points do not change.
+   */
+  void Rebuild();
+
+  //! Return the number of reference points, including the points added with
+  //! Insert() and without the points removed with Remove().
+  size_t NumReferencePoints() const
+  {
+    return referenceSet->n_cols - removedPoints.size() + insertedPoints.n_cols;
+  }
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -229,6 +275,26 @@ class NeighborSearch
               arma::Mat<IndexType>& neighbors,
               arma::Mat<ElemType>& distances);
 
+  /**
+   * Search for the neighbors of each point in the given query set, like the
+   * overload above, without modifying the model: BaseCases(), Scores() and
+   * Counters() are not updated.  When the reference tree does not have
+   * self-children, this may be called from any number of threads at once
+   * (trees with self-children, like the cover tree, cache distances in the
+   * reference tree during single-tree search).
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  template<typename IndexType = size_t>
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<IndexType>& neighbors,
+              arma::Mat<ElemType>& distances) const;
+
   /**
    * Given a pre-built query tree, search for the nearest neighbors of each
    * point in the query tree, storing the output in the given matrices.  The
@@ -318,6 +384,9 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Return the traversal statistics of the last search.
+  const CountersType& Counters() const { return counters; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -328,7 +397,26 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
-  //! Access the reference dataset.
+  //! Access the number of candidate nodes kept by beam search
+  //! (BEAM_SINGLE_TREE_MODE).
+  size_t BeamWidth() const { return beamWidth; }
+  //! Modify the number of candidate nodes kept by beam search
+  //! (BEAM_SINGLE_TREE_MODE).
+  size_t& BeamWidth() { return beamWidth; }
+
+  //! Access the maximum number of leaves visited for each query point by beam
+  //! search (BEAM_SINGLE_TREE_MODE); 0 means no limit.
+  size_t MaxLeaves() const { return maxLeaves; }
+  //! Modify the maximum number of leaves visited for each query point by beam
+  //! search (BEAM_SINGLE_TREE_MODE); 0 means no limit.
+  size_t& MaxLeaves() { return maxLeaves; }
+
+  //! Access the distance metric.
+  const DistanceType& Distance() const { return distance; }
+
+  //! Access the reference dataset.  If the model was updated with Insert() or
+  //! Remove() since the reference tree was built, this does not reflect those
+  //! updates until Rebuild() is called.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
   //! Access the reference tree.
@@ -352,6 +440,10 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! The number of candidate nodes kept by beam search.
+  size_t beamWidth;
+  //! The maximum number of leaves visited for each query point by beam search.
+  size_t maxLeaves;
 
   //! Instantiation of distance metric.
   DistanceType distance;
@@ -360,14 +452,107 @@ class NeighborSearch
   size_t baseCases;
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
+  //! The traversal statistics (applicable for non-naive search).
+  CountersType counters;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! Reference points added with Insert() that are not in the reference tree
+  //! yet.
+  MatType insertedPoints;
+  //! Sorted indices of the reference points in the reference tree that were
+  //! removed with Remove().  These are indices before any removal (so, the
+  //! indices that the search on the reference tree returns).
+  std::vector<size_t> removedPoints;
+
+  //! Return the number of Insert() and Remove() updates that may be buffered
+  //! before the reference tree is rebuilt.
+  size_t MaxPendingUpdates() const;
+
+  //! Return the full reference set (with updates applied), in index order.
+  MatType UpdatedReferenceSet() const;
+
+  //! Search the reference tree (or the reference set, for naive search) for
+  //! the neighbors of the given query points, ignoring Insert() and Remove().
+  //! The base cases, scores and traversal statistics of the search are stored
+  //! in the last three parameters.
+  template<typename IndexType>
+  void SearchReferenceTree(const MatType& querySet,
+                           const size_t k,
+                           arma::Mat<IndexType>& neighbors,
+                           arma::Mat<ElemType>& distances,
+                           size_t& searchBaseCases,
+                           size_t& searchScores,
+                           CountersType& searchCounters) const;
+
+  //! Search the reference tree for the neighbors of the points in the given
+  //! query tree, ignoring Insert() and Remove().
+  template<typename IndexType>
+  void SearchReferenceTree(Tree& queryTree,
+                           const size_t k,
+                           arma::Mat<IndexType>& neighbors,
+                           arma::Mat<ElemType>& distances,
+                           bool sameSet);
+
+  //! Print the number of node combinations scored and base cases calculated
+  //! by the last tree search to Log::Info.  This is kept out of
+  //! SearchReferenceTree(), since the log is not safe to write to from
+  //! concurrent const searches.
+  void LogSearch() const;
+
+  /**
+   * Combine the results of a search on the reference tree with the points
+   * added with Insert() and removed with Remove().  The results of the tree
+   * search must hold enough neighbors that the best k remain after removing
+   * the removed points (and the query point itself, if sameSet is true).
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to return.
+   * @param treeNeighbors Neighbors found in the reference tree.
+   * @param treeDistances Distances of neighbors found in the reference tree.
+   * @param neighbors Matrix to store the neighbors in.
+   * @param distances Matrix to store the distances in.
+   * @param sameSet If true, the query points are the reference points, and a
+   *     point is not returned as its own neighbor.
+   * @param searchBaseCases Number of base cases, which is incremented by the
+   *     number of distances evaluated to inserted points.
+   */
+  template<typename IndexType>
+  void ApplyUpdates(const MatType& querySet,
+                    const size_t k,
+                    const arma::Mat<IndexType>& treeNeighbors,
+                    const arma::Mat<ElemType>& treeDistances,
+                    arma::Mat<IndexType>& neighbors,
+                    arma::Mat<ElemType>& distances,
+                    const bool sameSet,
+                    size_t& searchBaseCases) const;
+
+  /**
+   * Perform a single-tree search for every query point, splitting the query
+   * points across OpenMP threads (unless the tree has self-children, in which
+   * case the search is serial).  Each thread uses its own copy of the rules
+   * (which shares the candidate lists) and its own traverser; the base case
+   * and score counts of each thread are summed into the given rules.
+   *
+   * @param rules Rules to search with.
+   * @param querySet Set of query points.
+   * @param orderQueries If true, visit the query points in the order of the
+   *     Z-order space-filling curve, so that consecutive query points tend to
+   *     visit the same reference nodes.
+   * @param traverserArgs Arguments given to the constructor of each traverser
+   *     after the rules.
+   */
+  template<typename TraverserType, typename RuleType, typename... TraverserArgs>
+  void SingleTreeSearch(RuleType& rules,
+                        const MatType& querySet,
+                        const bool orderQueries,
+                        const TraverserArgs&... traverserArgs) const;
+
   //! The NSModel class should have access to internal members.
-  friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
-      SingleTreeTraversalType>;
+  friend class LeafSizeNSWrapper<SortPolicy, TreeType, ElemType,
+      DualTreeTraversalType, SingleTreeTraversalType>;
 }; // class NeighborSearch
 
 } // namespace mlpack
@@ -14,7 +14,9 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/address.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/beam_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
@@ -28,18 +30,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
-                                         const NeighborSearchMode mode,
-                                         const double epsilon,
-                                         const DistanceType distance) :
+SingleTreeTraversalType, CountersType>::NeighborSearch(
+    MatType referenceSetIn,
+    const NeighborSearchMode mode,
+    const double epsilon,
+    const DistanceType distance) :
     referenceTree(mode == NAIVE_MODE ? NULL :
         BuildTree<Tree>(std::move(referenceSetIn), oldFromNewReferences)),
     referenceSet(mode == NAIVE_MODE ?  new MatType(std::move(referenceSetIn)) :
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    beamWidth(8),
+    maxLeaves(0),
     distance(distance),
     baseCases(0),
     scores(0),
@@ -57,16 +63,20 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
-                                         const NeighborSearchMode mode,
-                                         const double epsilon,
-                                         const DistanceType distance) :
+SingleTreeTraversalType, CountersType>::NeighborSearch(
+    Tree referenceTree,
+    const NeighborSearchMode mode,
+    const double epsilon,
+    const DistanceType distance) :
     referenceTree(new Tree(std::move(referenceTree))),
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    beamWidth(8),
+    maxLeaves(0),
     distance(distance),
     baseCases(0),
     scores(0),
@@ -84,15 +94,19 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
-                                         const double epsilon,
-                                         const DistanceType distance) :
+SingleTreeTraversalType, CountersType>::NeighborSearch(
+    const NeighborSearchMode mode,
+    const double epsilon,
+    const DistanceType distance) :
     referenceTree(NULL),
     referenceSet(mode == NAIVE_MODE ? new MatType() : NULL), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    beamWidth(8),
+    maxLeaves(0),
     distance(distance),
     baseCases(0),
     scores(0),
@@ -118,19 +132,26 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
+SingleTreeTraversalType, CountersType>::NeighborSearch(
+    const NeighborSearch& other) :
     oldFromNewReferences(other.oldFromNewReferences),
     referenceTree(other.referenceTree ? new Tree(*other.referenceTree) : NULL),
     referenceSet(other.referenceTree ? &referenceTree->Dataset() :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    beamWidth(other.beamWidth),
+    maxLeaves(other.maxLeaves),
     distance(other.distance),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(false)
+    counters(other.counters),
+    treeNeedsReset(false),
+    insertedPoints(other.insertedPoints),
+    removedPoints(other.removedPoints)
 {
   // Nothing else to do.
 }
@@ -143,18 +164,24 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
+SingleTreeTraversalType, CountersType>::NeighborSearch(NeighborSearch&& other) :
     oldFromNewReferences(std::move(other.oldFromNewReferences)),
     referenceTree(other.referenceTree),
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    beamWidth(other.beamWidth),
+    maxLeaves(other.maxLeaves),
     distance(std::move(other.distance)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    counters(other.counters),
+    treeNeedsReset(other.treeNeedsReset),
+    insertedPoints(std::move(other.insertedPoints)),
+    removedPoints(std::move(other.removedPoints))
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -164,7 +191,10 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.epsilon = 0.0;
   other.baseCases = 0;
   other.scores = 0;
+  other.counters.Reset();
   other.treeNeedsReset = false;
+  other.insertedPoints.reset();
+  other.removedPoints.clear();
 }
 
 // Copy operator.
@@ -175,19 +205,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>&
+               SingleTreeTraversalType,
+               CountersType>&
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>::operator=(const NeighborSearch& other)
+               SingleTreeTraversalType,
+               CountersType>::operator=(const NeighborSearch& other)
 {
   if (&other == this)
     return *this; // Nothing to do.
@@ -204,10 +237,17 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  beamWidth = other.beamWidth;
+  maxLeaves = other.maxLeaves;
   distance = other.distance;
   baseCases = other.baseCases;
   scores = other.scores;
+  counters = other.counters;
   treeNeedsReset = false;
+  insertedPoints = other.insertedPoints;
+  removedPoints = other.removedPoints;
+
+  return *this;
 }
 
 // Move operator.
@@ -218,19 +258,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>&
+               SingleTreeTraversalType,
+               CountersType>&
 NeighborSearch<SortPolicy,
                DistanceType,
                MatType,
                TreeType,
                DualTreeTraversalType,
-               SingleTreeTraversalType>::operator=(NeighborSearch&& other)
+               SingleTreeTraversalType,
+               CountersType>::operator=(NeighborSearch&& other)
 {
   if (&other == this)
     return *this; // Nothing to do.
@@ -246,10 +289,15 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  beamWidth = other.beamWidth;
+  maxLeaves = other.maxLeaves;
   distance = other.distance;
   baseCases = other.baseCases;
   scores = other.scores;
+  counters = other.counters;
   treeNeedsReset = other.treeNeedsReset;
+  insertedPoints = std::move(other.insertedPoints);
+  removedPoints = std::move(other.removedPoints);
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
@@ -262,7 +310,12 @@ NeighborSearch<SortPolicy,
   other.epsilon = 0.0;
   other.baseCases = 0;
   other.scores = 0;
+  other.counters.Reset();
   other.treeNeedsReset = false;
+  other.insertedPoints.reset();
+  other.removedPoints.clear();
+
+  return *this;
 }
 
 // Clean memory.
@@ -273,9 +326,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 NeighborSearch<SortPolicy, DistanceType, MatType, TreeType, DualTreeTraversalType,
-SingleTreeTraversalType>::~NeighborSearch()
+SingleTreeTraversalType, CountersType>::~NeighborSearch()
 {
   if (referenceTree)
     delete referenceTree;
@@ -290,10 +344,16 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+Train(MatType referenceSetIn)
 {
+  // Any updates to the old reference set are now irrelevant.
+  insertedPoints.reset();
+  removedPoints.clear();
+
   // Clean up the old tree, if we built one.
   if (referenceTree)
   {
@@ -326,14 +386,19 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+Train(Tree referenceTree)
 {
   if (searchMode == NAIVE_MODE)
     throw std::invalid_argument("cannot train on given reference tree when "
         "naive search (without trees) is desired");
 
+  insertedPoints.reset();
+  removedPoints.clear();
+
   if (this->referenceTree)
   {
     oldFromNewReferences.clear();
@@ -359,15 +424,22 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+SearchReferenceTree(
     const MatType& querySet,
     const size_t k,
     arma::Mat<IndexType>& neighbors,
-    arma::Mat<ElemType>& distances)
+    arma::Mat<ElemType>& distances,
+    size_t& searchBaseCases,
+    size_t& searchScores,
+    CountersType& searchCounters) const
 {
+  MLPACK_PROFILE_SCOPE("neighbor_search");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -376,8 +448,12 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     throw std::invalid_argument(ss.str());
   }
 
-  baseCases = 0;
-  scores = 0;
+  searchBaseCases = 0;
+  searchScores = 0;
+  searchCounters.Reset();
+
+  // The rules need a modifiable distance metric.
+  DistanceType searchDistance(distance);
 
   // This will hold mappings for query points, if necessary.
   std::vector<size_t> oldFromNewQueries;
@@ -405,44 +481,32 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   neighborPtr->set_size(k, querySet.n_cols);
   distancePtr->set_size(k, querySet.n_cols);
 
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
+  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree, CountersType>
+      RuleType;
 
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance, epsilon);
-
-      // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
-
-      baseCases += querySet.n_cols * referenceSet->n_cols;
+      // The brute-force search computes the distances by blocks.
+      BruteForceSearch<SortPolicy, DistanceType, MatType> search(distance);
+      search.Search(querySet, *referenceSet, k, *neighborPtr, *distancePtr);
 
-      rules.GetResults(*neighborPtr, *distancePtr);
+      searchBaseCases += querySet.n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance, epsilon);
-
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      RuleType rules(*referenceSet, querySet, k, searchDistance, epsilon);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Now traverse for each point, in parallel.
+      SingleTreeSearch<SingleTreeTraversalType<RuleType>>(rules, querySet,
+          true);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
-
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+      searchScores += rules.Scores();
+      searchCounters.Merge(rules.Counters());
+      searchBaseCases += rules.BaseCases();
 
       rules.GetResults(*neighborPtr, *distancePtr);
       break;
@@ -453,20 +517,17 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
 
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, epsilon);
+      RuleType rules(*referenceSet, queryTree->Dataset(), k, searchDistance,
+          epsilon);
 
       // Create the traverser.
       DualTreeTraversalType<RuleType> traverser(rules);
 
       traverser.Traverse(*queryTree, *referenceTree);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
-
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+      searchScores += rules.Scores();
+      searchCounters.Merge(rules.Counters());
+      searchBaseCases += rules.BaseCases();
 
       rules.GetResults(*neighborPtr, *distancePtr);
 
@@ -476,22 +537,31 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     case GREEDY_SINGLE_TREE_MODE:
     {
       // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, distance);
+      RuleType rules(*referenceSet, querySet, k, searchDistance);
 
-      // Create the traverser.
-      GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      // Now traverse for each point, in parallel.
+      SingleTreeSearch<GreedySingleTreeTraverser<Tree, RuleType>>(rules,
+          querySet, true);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      searchScores += rules.Scores();
+      searchCounters.Merge(rules.Counters());
+      searchBaseCases += rules.BaseCases();
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+      rules.GetResults(*neighborPtr, *distancePtr);
+      break;
+    }
+    case BEAM_SINGLE_TREE_MODE:
+    {
+      // Create the helper object for the tree traversal.
+      RuleType rules(*referenceSet, querySet, k, searchDistance, epsilon);
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+      // Now traverse for each point, in parallel.
+      SingleTreeSearch<BeamSingleTreeTraverser<Tree, RuleType>>(rules,
+          querySet, true, beamWidth, maxLeaves);
+
+      searchScores += rules.Scores();
+      searchCounters.Merge(rules.Counters());
+      searchBaseCases += rules.BaseCases();
 
       rules.GetResults(*neighborPtr, *distancePtr);
       break;
@@ -556,7 +626,26 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       delete neighborPtr;
     }
   }
-} // Search()
+} // SearchReferenceTree()
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::LogSearch() const
+{
+  if (searchMode == NAIVE_MODE)
+    return;
+
+  Log::Info << scores << " node combinations were scored." << std::endl;
+  Log::Info << baseCases << " base cases were calculated." << std::endl;
+}
 
 template<typename SortPolicy,
          typename DistanceType,
@@ -565,16 +654,20 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+SearchReferenceTree(
     Tree& queryTree,
     const size_t k,
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances,
     bool sameSet)
 {
+  MLPACK_PROFILE_SCOPE("neighbor_search");
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -590,6 +683,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  counters.Reset();
 
   // Get a reference to the query set.
   const MatType& querySet = queryTree.Dataset();
@@ -604,7 +698,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   distances.set_size(k, querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
+  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree, CountersType>
+      RuleType;
   RuleType rules(*referenceSet, querySet, k, distance, epsilon, sameSet);
 
   // Create the traverser.
@@ -612,6 +707,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   traverser.Traverse(queryTree, *referenceTree);
 
   scores += rules.Scores();
+  counters.Merge(rules.Counters());
   baseCases += rules.BaseCases();
 
   Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
@@ -645,14 +741,47 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename IndexType>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Search(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Search(
     const size_t k,
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances)
 {
+  MLPACK_PROFILE_SCOPE("neighbor_search");
+
+  // If the reference set has been updated, search for the neighbors of every
+  // reference point (other than the point itself) with the bichromatic search.
+  if (insertedPoints.n_cols > 0 || !removedPoints.empty())
+  {
+    if (k >= NumReferencePoints())
+    {
+      std::stringstream ss;
+      ss << "Requested value of k (" << k << ") is greater than or equal to "
+          << "the number of points in the reference set ("
+          << NumReferencePoints() << ") and no query set has been provided.";
+      throw std::invalid_argument(ss.str());
+    }
+
+    const MatType querySet = UpdatedReferenceSet();
+    const size_t treeK = std::min(k + 1 + removedPoints.size(),
+        (size_t) referenceSet->n_cols);
+    arma::Mat<IndexType> treeNeighbors(treeK, querySet.n_cols);
+    arma::Mat<ElemType> treeDistances(treeK, querySet.n_cols);
+    if (treeK > 0)
+    {
+      SearchReferenceTree(querySet, treeK, treeNeighbors, treeDistances,
+          baseCases, scores, counters);
+    }
+
+    ApplyUpdates(querySet, k, treeNeighbors, treeDistances, neighbors,
+        distances, true, baseCases);
+    LogSearch();
+    return;
+  }
+
   if (k > referenceSet->n_cols)
   {
     std::stringstream ss;
@@ -671,6 +800,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   baseCases = 0;
   scores = 0;
+  counters.Reset();
 
   arma::Mat<IndexType>* neighborPtr = &neighbors;
   arma::Mat<ElemType>* distancePtr = &distances;
@@ -687,7 +817,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   distancePtr->set_size(k, referenceSet->n_cols);
 
   // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree> RuleType;
+  typedef NeighborSearchRules<SortPolicy, DistanceType, Tree, CountersType>
+      RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, distance, epsilon,
       true /* don't return the same point as nearest neighbor */);
 
@@ -695,24 +826,24 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   {
     case NAIVE_MODE:
     {
-      // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      // The brute-force search computes the distances by blocks; it fills the
+      // results itself.
+      BruteForceSearch<SortPolicy, DistanceType, MatType> search(distance);
+      search.Search(*referenceSet, *referenceSet, k, *neighborPtr,
+          *distancePtr, true);
 
       baseCases += referenceSet->n_cols * referenceSet->n_cols;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Now traverse for each point, in parallel.  If the tree rearranged the
+      // dataset, the points are already ordered by their position in the tree.
+      SingleTreeSearch<SingleTreeTraversalType<RuleType>>(rules,
+          *referenceSet, !TreeTraits<Tree>::RearrangesDataset);
 
       scores += rules.Scores();
+      counters.Merge(rules.Counters());
       baseCases += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
@@ -761,6 +892,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       }
 
       scores += rules.Scores();
+      counters.Merge(rules.Counters());
       baseCases += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
@@ -774,14 +906,29 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      // Now traverse for each point, in parallel.
+      SingleTreeSearch<GreedySingleTreeTraverser<Tree, RuleType>>(rules,
+          *referenceSet, !TreeTraits<Tree>::RearrangesDataset);
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      scores += rules.Scores();
+      counters.Merge(rules.Counters());
+      baseCases += rules.BaseCases();
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+          << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+          << std::endl;
+      break;
+    }
+    case BEAM_SINGLE_TREE_MODE:
+    {
+      // Now traverse for each point, in parallel.
+      SingleTreeSearch<BeamSingleTreeTraverser<Tree, RuleType>>(rules,
+          *referenceSet, !TreeTraits<Tree>::RearrangesDataset, beamWidth,
+          maxLeaves);
 
       scores += rules.Scores();
+      counters.Merge(rules.Counters());
       baseCases += rules.BaseCases();
 
       Log::Info << rules.Scores() << " node combinations were scored."
@@ -792,7 +939,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
   }
 
-  rules.GetResults(*neighborPtr, *distancePtr);
+  if (searchMode != NAIVE_MODE)
+    rules.GetResults(*neighborPtr, *distancePtr);
 
   // Do we need to map the reference indices?
   if (!oldFromNewReferences.empty() && TreeTraits<Tree>::RearrangesDataset)
@@ -817,6 +965,474 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 }
 
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+template<typename TraverserType, typename RuleType, typename... TraverserArgs>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::SingleTreeSearch(
+    RuleType& rules,
+    const MatType& querySet,
+    const bool orderQueries,
+    const TraverserArgs&... traverserArgs) const
+{
+  std::vector<size_t> queryOrder;
+  if (orderQueries && querySet.n_cols > 1)
+    AddressOrder(querySet, queryOrder);
+
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+
+  // For trees with self-children, Score() caches the last distance evaluation
+  // in the reference node's statistic, so the traversals for different query
+  // points cannot run at the same time.
+  #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+      reduction(+:totalBaseCases, totalScores)
+  {
+    // Copies of the rules share the candidate lists, and each query point is
+    // only ever visited by one thread.
+    RuleType threadRules(rules);
+    threadRules.BaseCases() = 0;
+    threadRules.Scores() = 0;
+    threadRules.Counters().Reset();
+    TraverserType traverser(threadRules, traverserArgs...);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+    {
+      const size_t queryIndex = queryOrder.empty() ? i : queryOrder[i];
+      traverser.Traverse(queryIndex, *referenceTree);
+    }
+
+    totalBaseCases += threadRules.BaseCases();
+    totalScores += threadRules.Scores();
+
+    #pragma omp critical
+    rules.Counters().Merge(threadRules.Counters());
+  }
+
+  rules.BaseCases() += totalBaseCases;
+  rules.Scores() += totalScores;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+Insert(const MatType& points)
+{
+  if (points.n_rows != referenceSet->n_rows && NumReferencePoints() > 0)
+  {
+    std::stringstream ss;
+    ss << "NeighborSearch::Insert(): dimensionality of points ("
+        << points.n_rows << ") does not match dimensionality of reference set ("
+        << referenceSet->n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (insertedPoints.n_cols == 0)
+    insertedPoints = points;
+  else
+    insertedPoints = join_rows(insertedPoints, points);
+
+  if (insertedPoints.n_cols + removedPoints.size() > MaxPendingUpdates())
+    Rebuild();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+Remove(const size_t index)
+{
+  if (index >= NumReferencePoints())
+  {
+    std::stringstream ss;
+    ss << "NeighborSearch::Remove(): index " << index << " is out of range "
+        << "(there are " << NumReferencePoints() << " reference points)";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t treePoints = referenceSet->n_cols - removedPoints.size();
+  DistanceType searchDistance(distance);
+  if (index >= treePoints)
+  {
+    // The point has not been added to the tree yet, so just remove it.
+    insertedPoints.shed_col(index - treePoints);
+  }
+  else
+  {
+    // Find the index of the point before any removals.  Every removed point
+    // before it shifts it by one.
+    size_t treeIndex = index;
+    for (size_t i = 0; i < removedPoints.size(); ++i)
+    {
+      if (removedPoints[i] <= treeIndex)
+        ++treeIndex;
+      else
+        break;
+    }
+
+    removedPoints.insert(std::lower_bound(removedPoints.begin(),
+        removedPoints.end(), treeIndex), treeIndex);
+  }
+
+  if (insertedPoints.n_cols + removedPoints.size() > MaxPendingUpdates())
+    Rebuild();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Rebuild()
+{
+  if (insertedPoints.n_cols == 0 && removedPoints.empty())
+    return;
+
+  Train(UpdatedReferenceSet());
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+size_t NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+MaxPendingUpdates() const
+{
+  // Each buffered update costs one extra distance evaluation per query point
+  // (for inserted points) or one extra neighbor in the tree search (for
+  // removed points), so the buffer is allowed to grow with the square root of
+  // the size of the reference set; this keeps both the search overhead and the
+  // amortized cost of the rebuilds small.
+  return std::max((size_t) 100,
+      (size_t) std::sqrt((double) referenceSet->n_cols));
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+MatType NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::
+UpdatedReferenceSet() const
+{
+  MatType points((referenceSet->n_cols > 0) ? referenceSet->n_rows :
+      insertedPoints.n_rows, NumReferencePoints());
+
+  // The points in the tree may have been rearranged.
+  std::vector<size_t> newFromOld;
+  if (!oldFromNewReferences.empty() && TreeTraits<Tree>::RearrangesDataset)
+  {
+    newFromOld.resize(oldFromNewReferences.size());
+    for (size_t i = 0; i < oldFromNewReferences.size(); ++i)
+      newFromOld[oldFromNewReferences[i]] = i;
+  }
+
+  size_t col = 0;
+  size_t nextRemoved = 0;
+  for (size_t i = 0; i < referenceSet->n_cols; ++i)
+  {
+    if (nextRemoved < removedPoints.size() && removedPoints[nextRemoved] == i)
+    {
+      ++nextRemoved;
+      continue;
+    }
+
+    points.col(col++) = referenceSet->col(newFromOld.empty() ? i :
+        newFromOld[i]);
+  }
+
+  if (insertedPoints.n_cols > 0)
+    points.cols(col, points.n_cols - 1) = insertedPoints;
+
+  return points;
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances)
+{
+  if (insertedPoints.n_cols == 0 && removedPoints.empty())
+  {
+    SearchReferenceTree(querySet, k, neighbors, distances, baseCases, scores,
+        counters);
+    LogSearch();
+    return;
+  }
+
+  if (k > NumReferencePoints())
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << NumReferencePoints() << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Search the tree for enough neighbors that k are left after removing the
+  // removed points.
+  const size_t treeK = std::min(k + removedPoints.size(),
+      (size_t) referenceSet->n_cols);
+  arma::Mat<IndexType> treeNeighbors(treeK, querySet.n_cols);
+  arma::Mat<ElemType> treeDistances(treeK, querySet.n_cols);
+  if (treeK > 0)
+  {
+    SearchReferenceTree(querySet, treeK, treeNeighbors, treeDistances,
+        baseCases, scores, counters);
+  }
+
+  ApplyUpdates(querySet, k, treeNeighbors, treeDistances, neighbors, distances,
+      false, baseCases);
+  LogSearch();
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances) const
+{
+  // The statistics of this search are not kept.
+  size_t searchBaseCases = 0;
+  size_t searchScores = 0;
+  CountersType searchCounters;
+
+  if (insertedPoints.n_cols == 0 && removedPoints.empty())
+  {
+    SearchReferenceTree(querySet, k, neighbors, distances, searchBaseCases,
+        searchScores, searchCounters);
+    return;
+  }
+
+  if (k > NumReferencePoints())
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << NumReferencePoints() << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t treeK = std::min(k + removedPoints.size(),
+      (size_t) referenceSet->n_cols);
+  arma::Mat<IndexType> treeNeighbors(treeK, querySet.n_cols);
+  arma::Mat<ElemType> treeDistances(treeK, querySet.n_cols);
+  if (treeK > 0)
+  {
+    SearchReferenceTree(querySet, treeK, treeNeighbors, treeDistances,
+        searchBaseCases, searchScores, searchCounters);
+  }
+
+  ApplyUpdates(querySet, k, treeNeighbors, treeDistances, neighbors, distances,
+      false, searchBaseCases);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Search(
+    Tree& queryTree,
+    const size_t k,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances,
+    bool sameSet)
+{
+  if (insertedPoints.n_cols == 0 && removedPoints.empty())
+  {
+    SearchReferenceTree(queryTree, k, neighbors, distances, sameSet);
+    return;
+  }
+
+  if (sameSet)
+  {
+    throw std::invalid_argument("cannot call NeighborSearch::Search() with "
+        "sameSet = true after Insert() or Remove(); call Search() without a "
+        "query set or call Rebuild() first");
+  }
+
+  if (k > NumReferencePoints())
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << NumReferencePoints() << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t treeK = std::min(k + removedPoints.size(),
+      (size_t) referenceSet->n_cols);
+  arma::Mat<IndexType> treeNeighbors(treeK, queryTree.Dataset().n_cols);
+  arma::Mat<ElemType> treeDistances(treeK, queryTree.Dataset().n_cols);
+  if (treeK > 0)
+  {
+    SearchReferenceTree(queryTree, treeK, treeNeighbors, treeDistances,
+        false);
+  }
+
+  ApplyUpdates(queryTree.Dataset(), k, treeNeighbors, treeDistances,
+      neighbors, distances, false, baseCases);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
+template<typename IndexType>
+void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::ApplyUpdates(
+    const MatType& querySet,
+    const size_t k,
+    const arma::Mat<IndexType>& treeNeighbors,
+    const arma::Mat<ElemType>& treeDistances,
+    arma::Mat<IndexType>& neighbors,
+    arma::Mat<ElemType>& distances,
+    const bool sameSet,
+    size_t& searchBaseCases) const
+{
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  const size_t treePoints = referenceSet->n_cols - removedPoints.size();
+
+  // Orders candidates by distance, and then by index.
+  typedef std::pair<ElemType, size_t> Candidate;
+  const auto better = [](const Candidate& a, const Candidate& b)
+  {
+    if (a.first == b.first)
+      return a.second < b.second;
+    return SortPolicy::IsBetter(a.first, b.first);
+  };
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+  {
+    std::vector<Candidate> candidates;
+    candidates.reserve(treeNeighbors.n_rows + insertedPoints.n_cols);
+
+    // Take the neighbors from the tree that have not been removed, mapping
+    // their indices to account for the removed points before them.
+    for (size_t j = 0; j < treeNeighbors.n_rows; ++j)
+    {
+      const size_t treeIndex = (size_t) treeNeighbors(j, i);
+      if (treeIndex >= referenceSet->n_cols)
+        continue; // Not enough neighbors were found.
+
+      const std::vector<size_t>::const_iterator it = std::lower_bound(
+          removedPoints.begin(), removedPoints.end(), treeIndex);
+      if (it != removedPoints.end() && *it == treeIndex)
+        continue;
+
+      const size_t index = treeIndex - (it - removedPoints.begin());
+      if (sameSet && index == i)
+        continue;
+
+      candidates.push_back(Candidate(treeDistances(j, i), index));
+    }
+
+    // Now evaluate every inserted point.
+    for (size_t j = 0; j < insertedPoints.n_cols; ++j)
+    {
+      const size_t index = treePoints + j;
+      if (sameSet && index == i)
+        continue;
+
+      candidates.push_back(Candidate(searchDistance.Evaluate(
+          querySet.col(i), insertedPoints.col(j)), index));
+    }
+
+    const size_t found = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + found,
+        candidates.end(), better);
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < found)
+      {
+        neighbors(j, i) = (IndexType) candidates[j].second;
+        distances(j, i) = candidates[j].first;
+      }
+      else
+      {
+        neighbors(j, i) = (IndexType) size_t(-1);
+        distances(j, i) = SortPolicy::WorstDistance();
+      }
+    }
+  }
+
+  searchBaseCases += querySet.n_cols * insertedPoints.n_cols;
+}
+
 //! Calculate the average relative error.
 template<typename SortPolicy,
          typename DistanceType,
@@ -825,9 +1441,10 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 double NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::EffectiveError(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::EffectiveError(
     arma::Mat<ElemType>& foundDistances,
     arma::Mat<ElemType>& realDistances)
 {
@@ -863,10 +1480,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename IndexType>
 double NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::Recall(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::Recall(
     arma::Mat<IndexType>& foundNeighbors,
     arma::Mat<IndexType>& realNeighbors)
 {
@@ -895,12 +1513,23 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename> class DualTreeTraversalType,
-         template<typename> class SingleTreeTraversalType>
+         template<typename> class SingleTreeTraversalType,
+         typename CountersType>
 template<typename Archive>
 void NeighborSearch<SortPolicy, DistanceType, MatType, TreeType,
-DualTreeTraversalType, SingleTreeTraversalType>::serialize(
+DualTreeTraversalType, SingleTreeTraversalType, CountersType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
+  // Buffered updates are applied to the tree before saving, so they don't need
+  // to be serialized.
+  if (cereal::is_saving<Archive>())
+    Rebuild();
+  else
+  {
+    insertedPoints.reset();
+    removedPoints.clear();
+  }
+
   // Serialize preferences for search.
   ar(CEREAL_NVP(searchMode));
   ar(CEREAL_NVP(treeNeedsReset));
@@ -953,6 +1582,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
   {
     baseCases = 0;
     scores = 0;
+    counters.Reset();
   }
 }
 
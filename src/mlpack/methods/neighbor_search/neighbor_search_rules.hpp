@@ -14,7 +14,11 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+#include <memory>
 #include <queue>
 
 namespace mlpack {
@@ -26,11 +30,22 @@ namespace mlpack {
  * reference dataset which have the 'best' distance according to a given sorting
  * policy.
  *
+ * Copies of a NeighborSearchRules object share the same candidate lists, but
+ * each copy has its own traversal info, base case cache, and counters.  This
+ * allows copies to be used by different threads to search for the neighbors of
+ * disjoint sets of query points (see, e.g., the ParallelDualTreeTraverser of
+ * BinarySpaceTree).
+ *
  * @tparam SortPolicy The sort policy for distances.
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CountersType The policy that collects traversal statistics (see
+ *     TraversalCounters); by default, nothing is collected.
  */
-template<typename SortPolicy, typename DistanceType, typename TreeType>
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType = NullTraversalCounters>
 class NeighborSearchRules
 {
  public:
@@ -78,6 +93,24 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between each of the given query points and each of
+   * the reference points with indices in [referenceBegin, referenceBegin +
+   * referenceCount).  The candidate lists are updated exactly as if BaseCase()
+   * had been called for every pair.  For nearest neighbor search with the
+   * Euclidean distance on dense data, the distances for the whole block are
+   * first computed with one matrix product (as ||q||^2 + ||r||^2 - 2 q^T r),
+   * and only the pairs that may enter a candidate list are evaluated exactly
+   * with the distance metric.
+   *
+   * @param queryIndices Indices of query points.
+   * @param referenceBegin Index of the first reference point.
+   * @param referenceCount Number of reference points.
+   */
+  void BaseCases(const std::vector<size_t>& queryIndices,
+                 const size_t referenceBegin,
+                 const size_t referenceCount);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -154,6 +187,11 @@ class NeighborSearchRules
   //! Modify the number of scores that have been performed.
   size_t& Scores() { return scores; }
 
+  //! Get the traversal counters.
+  const CountersType& Counters() const { return counters; }
+  //! Modify the traversal counters.
+  CountersType& Counters() { return counters; }
+
   //! Convenience typedef.
   typedef typename mlpack::TraversalInfo<TreeType> TraversalInfoType;
 
@@ -188,8 +226,9 @@ class NeighborSearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This is shared between copies
+  //! of the rules.
+  std::shared_ptr<std::vector<CandidateList>> candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -214,11 +253,37 @@ class NeighborSearchRules
   size_t baseCases;
   //! The number of scores that have been performed.
   size_t scores;
+  //! The traversal counters; these are also updated by Rescore().
+  mutable CountersType counters;
 
   //! Traversal info for the parent combination; this is updated by the
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  //! If true, BaseCases() filters the block of base cases with a matrix
+  //! product.  This is only possible for the (squared) Euclidean distance on
+  //! dense matrices, and the filter is only written for nearest neighbor
+  //! search.
+  static constexpr bool UseBlockBaseCases =
+      std::is_same<SortPolicy, NearestNeighborSort>::value &&
+      (std::is_same<DistanceType, LMetric<2, true>>::value ||
+       std::is_same<DistanceType, LMetric<2, false>>::value) &&
+      arma::is_Mat<typename TreeType::Mat>::value;
+
+  //! Compute the block of base cases for BaseCases() with a matrix product.
+  template<bool UseBlock = UseBlockBaseCases>
+  void BlockBaseCases(const std::vector<size_t>& queryIndices,
+                      const size_t referenceBegin,
+                      const size_t referenceCount,
+                      const typename std::enable_if_t<UseBlock>* = 0);
+
+  //! Compute the block of base cases for BaseCases() one at a time.
+  template<bool UseBlock = UseBlockBaseCases>
+  void BlockBaseCases(const std::vector<size_t>& queryIndices,
+                      const size_t referenceBegin,
+                      const size_t referenceCount,
+                      const typename std::enable_if_t<!UseBlock>* = 0);
+
   /**
    * Recalculate the bound for a given query node.
    */
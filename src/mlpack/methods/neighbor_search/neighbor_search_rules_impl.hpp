@@ -18,8 +18,12 @@
 
 namespace mlpack {
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::NeighborSearchRules(
     const typename TreeType::Mat& referenceSet,
     const typename TreeType::Mat& querySet,
     const size_t k,
@@ -28,6 +32,7 @@ NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
+    candidates(new std::vector<CandidateList>()),
     k(k),
     distance(distance),
     sameSet(sameSet),
@@ -53,14 +58,20 @@ NeighborSearchRules<SortPolicy, DistanceType, TreeType>::NeighborSearchRules(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidates->reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+    candidates->push_back(pqueue);
+
+  counters.AddQueries(querySet.n_cols);
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
 template<typename IndexType>
-void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::GetResults(
     arma::Mat<IndexType>& neighbors,
     arma::Mat<ElemType>& distances)
 {
@@ -69,7 +80,7 @@ void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = (IndexType) pqueue.top().second;
@@ -79,10 +90,13 @@ void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
   }
 };
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
 inline mlpack_force_inline // Must be inline so optimizations can happen.
-double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
-BaseCase(const size_t queryIndex, const size_t referenceIndex)
+double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::BaseCase(const size_t queryIndex, const size_t referenceIndex)
 {
   // If the datasets are the same, then this search is only using one dataset
   // and we should not return identical points.
@@ -107,8 +121,117 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return dist;
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::BaseCases(
+    const std::vector<size_t>& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount)
+{
+  // For very small blocks the matrix product is not worth it.
+  if (queryIndices.size() * referenceCount < 16)
+  {
+    BlockBaseCases<false>(queryIndices, referenceBegin, referenceCount);
+    return;
+  }
+
+  BlockBaseCases(queryIndices, referenceBegin, referenceCount);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+template<bool UseBlock>
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::BlockBaseCases(
+    const std::vector<size_t>& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount,
+    const typename std::enable_if_t<UseBlock>*)
+{
+  if (queryIndices.empty() || referenceCount == 0)
+    return;
+
+  typedef typename TreeType::Mat MatType;
+
+  // Gather the query points; the reference points are contiguous, so we can
+  // just use an alias.
+  MatType queryBlock(querySet.n_rows, queryIndices.size(), arma::fill::none);
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+    queryBlock.col(i) = querySet.col(queryIndices[i]);
+
+  const MatType referenceBlock(
+      const_cast<ElemType*>(referenceSet.colptr(referenceBegin)),
+      referenceSet.n_rows, referenceCount, false, true);
+
+  const arma::Row<ElemType> queryNorms = arma::sum(arma::square(queryBlock));
+  const arma::Row<ElemType> referenceNorms =
+      arma::sum(arma::square(referenceBlock));
+  const MatType products = queryBlock.t() * referenceBlock;
+
+  // The squared distances computed from the matrix product can have a large
+  // relative error when the points are close together, so they are only used
+  // to rule out pairs that certainly can't be inserted as candidates.  This
+  // bound on the error is a (loose) bound for the error of the dot products,
+  // plus the rounding error of squaring the distance of the worst candidate.
+  const double eps = std::numeric_limits<ElemType>::epsilon();
+  const double dotError = 2.0 * (querySet.n_rows + 2) * eps;
+
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+  {
+    const size_t queryIndex = queryIndices[i];
+    for (size_t j = 0; j < referenceCount; ++j)
+    {
+      const size_t referenceIndex = referenceBegin + j;
+      if (sameSet && (queryIndex == referenceIndex))
+        continue;
+
+      ++baseCases;
+
+      const double worst = (*candidates)[queryIndex].top().first;
+      const double worstSq = DistanceType::TakeRoot ? (worst * worst) : worst;
+      const double approxSq = (double) queryNorms[i] + referenceNorms[j] -
+          2.0 * products(i, j);
+      const double tolerance = dotError * (queryNorms[i] + referenceNorms[j]) +
+          4.0 * eps * worstSq;
+      if (approxSq > worstSq + tolerance)
+        continue;
+
+      const double dist = distance.Evaluate(querySet.col(queryIndex),
+          referenceSet.col(referenceIndex));
+      InsertNeighbor(queryIndex, referenceIndex, dist);
+    }
+  }
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+template<bool UseBlock>
+void NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::BlockBaseCases(
+    const std::vector<size_t>& queryIndices,
+    const size_t referenceBegin,
+    const size_t referenceCount,
+    const typename std::enable_if_t<!UseBlock>*)
+{
+  const size_t referenceEnd = referenceBegin + referenceCount;
+  for (size_t i = 0; i < queryIndices.size(); ++i)
+    for (size_t ref = referenceBegin; ref < referenceEnd; ++ref)
+      BaseCase(queryIndices[i], ref);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
@@ -143,33 +266,44 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(dist, bestDistance)) ?
-      SortPolicy::ConvertToScore(dist) : DBL_MAX;
+  return counters.Score(referenceNode,
+      (SortPolicy::IsBetter(dist, bestDistance)) ?
+      SortPolicy::ConvertToScore(dist) : DBL_MAX);
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
-GetBestChild(const size_t queryIndex, TreeType& referenceNode)
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::GetBestChild(const size_t queryIndex, TreeType& referenceNode)
 {
   ++scores;
   return SortPolicy::GetBestChild(querySet.col(queryIndex), referenceNode);
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
-GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline size_t NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::GetBestChild(const TreeType& queryNode, TreeType& referenceNode)
 {
   ++scores;
   return SortPolicy::GetBestChild(queryNode, referenceNode);
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::Rescore(
     const size_t queryIndex,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   // If we are already pruning, still prune.
@@ -179,14 +313,19 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
   const double dist = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
-  return (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX;
+  return counters.Rescore(referenceNode, oldScore,
+      (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX);
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::Score(
     TreeType& queryNode,
     TreeType& referenceNode)
 {
@@ -290,7 +429,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
       // There isn't any need to set the traversal information because no
       // descendant combinations will be visited, and those are the only
       // combinations that would depend on the traversal information.
-      return DBL_MAX;
+      return counters.Score(queryNode, referenceNode, DBL_MAX);
     }
   }
 
@@ -335,21 +474,26 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Score(
     traversalInfo.LastReferenceNode() = &referenceNode;
     traversalInfo.LastScore() = dist;
 
-    return SortPolicy::ConvertToScore(dist);
+    return counters.Score(queryNode, referenceNode,
+        SortPolicy::ConvertToScore(dist));
   }
   else
   {
     // There isn't any need to set the traversal information because no
     // descendant combinations will be visited, and those are the only
     // combinations that would depend on the traversal information.
-    return DBL_MAX;
+    return counters.Score(queryNode, referenceNode, DBL_MAX);
   }
 }
 
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::Rescore(
     TreeType& queryNode,
-    TreeType& /* referenceNode */,
+    TreeType& referenceNode,
     const double oldScore) const
 {
   if (oldScore == DBL_MAX || oldScore == 0.0)
@@ -360,14 +504,18 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::Rescore(
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
 
-  return (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX;
+  return counters.Rescore(referenceNode, oldScore,
+      (SortPolicy::IsBetter(dist, bestDistance)) ? oldScore : DBL_MAX);
 }
 
 // Calculate the bound for a given query node in its current state and update
 // it.
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
-    CalculateBound(TreeType& queryNode) const
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::CalculateBound(TreeType& queryNode) const
 {
   // This is an adapted form of the B(N_q) function in the paper
   // ``Tree-Independent Dual-Tree Algorithms'' by Curtin et. al.; the goal is to
@@ -402,7 +550,7 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double dist = candidates[queryNode.Point(i)].top().first;
+    const double dist = (*candidates)[queryNode.Point(i)].top().first;
     if (SortPolicy::IsBetter(worstDistance, dist))
       worstDistance = dist;
     if (SortPolicy::IsBetter(dist, bestPointDistance))
@@ -490,20 +638,24 @@ inline double NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
  * @param neighbor Index of reference point which is being inserted.
  * @param dist Distance from query point to reference point.
  */
-template<typename SortPolicy, typename DistanceType, typename TreeType>
-inline void NeighborSearchRules<SortPolicy, DistanceType, TreeType>::
-InsertNeighbor(
+template<typename SortPolicy,
+         typename DistanceType,
+         typename TreeType,
+         typename CountersType>
+inline void NeighborSearchRules<SortPolicy, DistanceType, TreeType,
+CountersType>::InsertNeighbor(
     const size_t queryIndex,
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
   {
     pqueue.pop();
     pqueue.push(c);
+    counters.BoundUpdate();
   }
 }
 
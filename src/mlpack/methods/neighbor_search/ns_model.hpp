@@ -25,6 +25,28 @@
 
 namespace mlpack {
 
+/**
+ * Convert the given matrix to a matrix with the given element type.  NSModel
+ * always takes and returns double-precision matrices, but the NeighborSearch
+ * object it holds may use a different element type.
+ */
+template<typename InElemType, typename OutElemType>
+inline void ConvertNSMatrix(arma::Mat<InElemType>&& in,
+                            arma::Mat<OutElemType>& out)
+{
+  out = arma::conv_to<arma::Mat<OutElemType>>::from(in);
+  in.clear();
+}
+
+/**
+ * If the element types are the same, the matrix is moved instead of copied.
+ */
+template<typename eT>
+inline void ConvertNSMatrix(arma::Mat<eT>&& in, arma::Mat<eT>& out)
+{
+  out = std::move(in);
+}
+
 /**
  * NSWrapperBase is a base wrapper class for holding all NeighborSearch types
  * supported by NSModel.  All NeighborSearch type wrappers inherit from this
@@ -45,9 +67,16 @@ class NSWrapperBase
   //! Destruct the NSWrapperBase (nothing to do).
   virtual ~NSWrapperBase() { }
 
-  //! Return a reference to the dataset.
+  //! Return a reference to the dataset.  This is only available if the
+  //! wrapped NeighborSearch object holds a double-precision dataset.
   virtual const arma::mat& Dataset() const = 0;
 
+  //! Return the dimensionality of the dataset.
+  virtual size_t Dimensionality() const = 0;
+
+  //! Return the number of points in the dataset.
+  virtual size_t NumReferencePoints() const = 0;
+
   //! Get the search mode.
   virtual NeighborSearchMode SearchMode() const = 0;
   //! Modify the search modem
@@ -84,20 +113,23 @@ class NSWrapperBase
 };
 
 /**
- * NSWrapper is a wrapper class for most NeighborSearch types.
+ * NSWrapper is a wrapper class for most NeighborSearch types.  The
+ * NeighborSearch object holds its data with the given element type (double or
+ * float); the data is converted when it is passed in or out.
  */
 template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType = double,
          template<typename RuleType> class DualTreeTraversalType =
              TreeType<EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template DualTreeTraverser,
+                      arma::Mat<ElemType>>::template DualTreeTraverser,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
+                      arma::Mat<ElemType>>::template SingleTreeTraverser>
 class NSWrapper : public NSWrapperBase
 {
  public:
@@ -117,8 +149,15 @@ class NSWrapper : public NSWrapperBase
   //! polymorphism.
   virtual NSWrapper* Clone() const { return new NSWrapper(*this); }
 
-  //! Get a reference to the reference set.
-  const arma::mat& Dataset() const { return ns.ReferenceSet(); }
+  //! Get a reference to the reference set.  This throws a
+  //! std::invalid_argument if ElemType is not double.
+  const arma::mat& Dataset() const { return DoubleDataset(ns.ReferenceSet()); }
+
+  //! Get the dimensionality of the reference set.
+  size_t Dimensionality() const { return ns.ReferenceSet().n_rows; }
+
+  //! Get the number of points in the reference set.
+  size_t NumReferencePoints() const { return ns.NumReferencePoints(); }
 
   //! Get the search mode.
   NeighborSearchMode SearchMode() const { return ns.SearchMode(); }
@@ -166,13 +205,30 @@ class NSWrapper : public NSWrapperBase
   // Convenience typedef for the neighbor search type held by this class.
   typedef NeighborSearch<SortPolicy,
                          EuclideanDistance,
-                         arma::mat,
+                         arma::Mat<ElemType>,
                          TreeType,
                          DualTreeTraversalType,
                          SingleTreeTraversalType> NSType;
 
   //! The instantiated NeighborSearch object that we are wrapping.
   NSType ns;
+
+ private:
+  //! Return the given double-precision dataset.
+  static const arma::mat& DoubleDataset(const arma::mat& dataset)
+  {
+    return dataset;
+  }
+
+  //! A dataset with a different element type can't be returned as a
+  //! double-precision dataset.
+  template<typename eT>
+  static const arma::mat& DoubleDataset(const arma::Mat<eT>& /* dataset */)
+  {
+    throw std::invalid_argument("NSModel::Dataset(): the dataset of a "
+        "single-precision model is not stored as double-precision; use "
+        "Dimensionality() and NumReferencePoints() instead");
+  }
 };
 
 /**
@@ -184,17 +240,19 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType = double,
          template<typename RuleType> class DualTreeTraversalType =
              TreeType<EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template DualTreeTraverser,
+                      arma::Mat<ElemType>>::template DualTreeTraverser,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
+                      arma::Mat<ElemType>>::template SingleTreeTraverser>
 class LeafSizeNSWrapper :
     public NSWrapper<SortPolicy,
                      TreeType,
+                     ElemType,
                      DualTreeTraversalType,
                      SingleTreeTraversalType>
 {
@@ -205,6 +263,7 @@ class LeafSizeNSWrapper :
                     const double epsilon) :
       NSWrapper<SortPolicy,
                 TreeType,
+                ElemType,
                 DualTreeTraversalType,
                 SingleTreeTraversalType>(searchMode, epsilon)
   {
@@ -248,6 +307,7 @@ class LeafSizeNSWrapper :
  protected:
   using NSWrapper<SortPolicy,
                   TreeType,
+                  ElemType,
                   DualTreeTraversalType,
                   SingleTreeTraversalType>::ns;
 };
@@ -256,17 +316,18 @@ class LeafSizeNSWrapper :
  * The SpillNSWrapper class wraps the NeighborSearch class when the spill tree
  * is used.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename ElemType = double>
 class SpillNSWrapper :
     public NSWrapper<
         SortPolicy,
         SPTree,
+        ElemType,
         SPTree<EuclideanDistance,
                NeighborSearchStat<SortPolicy>,
-               arma::mat>::template DefeatistDualTreeTraverser,
+               arma::Mat<ElemType>>::template DefeatistDualTreeTraverser,
         SPTree<EuclideanDistance,
                NeighborSearchStat<SortPolicy>,
-               arma::mat>::template DefeatistSingleTreeTraverser>
+               arma::Mat<ElemType>>::template DefeatistSingleTreeTraverser>
 {
  public:
   //! Construct the SpillNSWrapper.
@@ -275,12 +336,13 @@ class SpillNSWrapper :
       NSWrapper<
           SortPolicy,
           SPTree,
+          ElemType,
           SPTree<EuclideanDistance,
                  NeighborSearchStat<SortPolicy>,
-                 arma::mat>::template DefeatistDualTreeTraverser,
+                 arma::Mat<ElemType>>::template DefeatistDualTreeTraverser,
           SPTree<EuclideanDistance,
                  NeighborSearchStat<SortPolicy>,
-                 arma::mat>::template DefeatistSingleTreeTraverser>(
+                 arma::Mat<ElemType>>::template DefeatistSingleTreeTraverser>(
           searchMode, epsilon)
   {
     // Nothing to do.
@@ -320,12 +382,13 @@ class SpillNSWrapper :
   using NSWrapper<
       SortPolicy,
       SPTree,
+      ElemType,
       SPTree<EuclideanDistance,
              NeighborSearchStat<SortPolicy>,
-             arma::mat>::template DefeatistDualTreeTraverser,
+             arma::Mat<ElemType>>::template DefeatistDualTreeTraverser,
       SPTree<EuclideanDistance,
              NeighborSearchStat<SortPolicy>,
-             arma::mat>::template DefeatistSingleTreeTraverser>::ns;
+             arma::Mat<ElemType>>::template DefeatistSingleTreeTraverser>::ns;
 };
 
 /**
@@ -336,6 +399,12 @@ class SpillNSWrapper :
  * flexibility as the NeighborSearch class.  So if you are using it outside of
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
+ * The data given to NSModel is always double-precision, but if
+ * SinglePrecision() is set to true before BuildModel() is called, the model
+ * stores the reference set and tree with single-precision (float) elements,
+ * which halves the memory used by the model.  Distances are still returned as
+ * double-precision matrices.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  */
 template<typename SortPolicy>
@@ -375,12 +444,24 @@ class NSModel
   double tau;
   double rho;
 
+  //! If true, the reference set and tree are held with float elements.
+  bool singlePrecision;
+
   /**
    * nSearch holds an instance of the NeighborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    */
   NSWrapperBase* nSearch;
 
+  //! Create nSearch with the given element type for the current treeType.
+  template<typename ElemType>
+  void InitializeSearch(const NeighborSearchMode searchMode,
+                        const double epsilon);
+
+  //! Serialize nSearch, which holds data with the given element type.
+  template<typename ElemType, typename Archive>
+  void SerializeSearch(Archive& ar);
+
  public:
   /**
    * Initialize the NSModel with the given type and whether or not a random
@@ -425,11 +506,18 @@ class NSModel
 
   //! Serialize the neighbor search model.
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
-  //! Expose the dataset.
+  //! Expose the dataset.  This throws a std::invalid_argument if the model
+  //! holds a single-precision dataset.
   const arma::mat& Dataset() const;
 
+  //! Get the dimensionality of the dataset.
+  size_t Dimensionality() const;
+
+  //! Get the number of points in the dataset.
+  size_t NumReferencePoints() const;
+
   //! Expose SearchMode.
   NeighborSearchMode SearchMode() const;
   NeighborSearchMode& SearchMode();
@@ -458,6 +546,11 @@ class NSModel
   bool RandomBasis() const { return randomBasis; }
   bool& RandomBasis() { return randomBasis; }
 
+  //! Expose singlePrecision.  Changes take effect the next time BuildModel()
+  //! is called.
+  bool SinglePrecision() const { return singlePrecision; }
+  bool& SinglePrecision() { return singlePrecision; }
+
   //! Initialize the model type.  (This does not perform any training.)
   void InitializeModel(const NeighborSearchMode searchMode,
                        const double epsilon);
@@ -487,6 +580,9 @@ class NSModel
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename SortPolicy),
+    (mlpack::NSModel<SortPolicy>), (1));
+
 // Include implementation.
 #include "ns_model_impl.hpp"
 
@@ -26,20 +26,25 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, ElemType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Train(util::Timers& timers,
          arma::mat&& referenceSet,
          const size_t /* leafSize */,
          const double /* tau */,
          const double /* rho */)
 {
+  arma::Mat<ElemType> referenceSetIn;
+  ConvertNSMatrix(std::move(referenceSet), referenceSetIn);
+
   if (ns.SearchMode() != NAIVE_MODE)
     timers.Start("tree_building");
 
-  ns.Train(std::move(referenceSet));
+  ns.Train(std::move(referenceSetIn));
 
   if (ns.SearchMode() != NAIVE_MODE)
     timers.Stop("tree_building");
@@ -51,10 +56,12 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, ElemType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
           arma::mat&& querySet,
           const size_t k,
@@ -63,23 +70,28 @@ void NSWrapper<
           const size_t /* leafSize */,
           const double /* rho */)
 {
+  arma::Mat<ElemType> querySetIn, distancesOut;
+  ConvertNSMatrix(std::move(querySet), querySetIn);
+
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
     // We build the query tree manually, so that we can time how long it takes.
     timers.Start("tree_building");
-    typename decltype(ns)::Tree queryTree(std::move(querySet));
+    typename decltype(ns)::Tree queryTree(std::move(querySetIn));
     timers.Stop("tree_building");
 
     timers.Start("computing_neighbors");
-    ns.Search(queryTree, k, neighbors, distances);
+    ns.Search(queryTree, k, neighbors, distancesOut);
     timers.Stop("computing_neighbors");
   }
   else
   {
     timers.Start("computing_neighbors");
-    ns.Search(std::move(querySet), k, neighbors, distances);
+    ns.Search(querySetIn, k, neighbors, distancesOut);
     timers.Stop("computing_neighbors");
   }
+
+  ConvertNSMatrix(std::move(distancesOut), distances);
 }
 
 //! Perform monochromatic neighbor search (i.e. use the reference set as the
@@ -88,18 +100,24 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, ElemType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
           const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances)
 {
+  arma::Mat<ElemType> distancesOut;
+
   timers.Start("computing_neighbors");
-  ns.Search(k, neighbors, distances);
+  ns.Search(k, neighbors, distancesOut);
   timers.Stop("computing_neighbors");
+
+  ConvertNSMatrix(std::move(distancesOut), distances);
 }
 
 //! Train a model with the given parameters.  This overload uses leafSize but
@@ -108,26 +126,31 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, ElemType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Train(util::Timers& timers,
          arma::mat&& referenceSet,
          const size_t leafSize,
          const double /* tau */,
          const double /* rho */)
 {
+  arma::Mat<ElemType> referenceSetIn;
+  ConvertNSMatrix(std::move(referenceSet), referenceSetIn);
+
   if (ns.SearchMode() == NAIVE_MODE)
   {
-    ns.Train(std::move(referenceSet));
+    ns.Train(std::move(referenceSetIn));
   }
   else
   {
     // Build the tree with the specified leaf size.
     timers.Start("tree_building");
     std::vector<size_t> oldFromNewReferences;
-    typename decltype(ns)::Tree referenceTree(std::move(referenceSet),
+    typename decltype(ns)::Tree referenceTree(std::move(referenceSetIn),
         oldFromNewReferences, leafSize);
     ns.Train(std::move(referenceTree));
     ns.oldFromNewReferences = std::move(oldFromNewReferences);
@@ -141,10 +164,12 @@ template<typename SortPolicy,
          template<typename TreeDistanceType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
+         typename ElemType,
          template<typename RuleType> class DualTreeTraversalType,
          template<typename RuleType> class SingleTreeTraversalType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, ElemType, DualTreeTraversalType,
+    SingleTreeTraversalType
 >::Search(util::Timers& timers,
           arma::mat&& querySet,
           const size_t k,
@@ -153,6 +178,9 @@ void LeafSizeNSWrapper<
           const size_t leafSize,
           const double /* rho */)
 {
+  arma::Mat<ElemType> querySetIn;
+  ConvertNSMatrix(std::move(querySet), querySetIn);
+
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
     // We actually have to do the mapping of query points ourselves, since the
@@ -161,16 +189,19 @@ void LeafSizeNSWrapper<
     // query tree manually.)
     timers.Start("tree_building");
     std::vector<size_t> oldFromNewQueries;
-    typename decltype(ns)::Tree queryTree(std::move(querySet),
+    typename decltype(ns)::Tree queryTree(std::move(querySetIn),
         oldFromNewQueries, leafSize);
     timers.Stop("tree_building");
 
     arma::Mat<size_t> neighborsOut;
-    arma::mat distancesOut;
+    arma::Mat<ElemType> treeDistances;
     timers.Start("computing_neighbors");
-    ns.Search(queryTree, k, neighborsOut, distancesOut);
+    ns.Search(queryTree, k, neighborsOut, treeDistances);
     timers.Stop("computing_neighbors");
 
+    arma::mat distancesOut;
+    ConvertNSMatrix(std::move(treeDistances), distancesOut);
+
     // Unmap the query points.
     distances.set_size(distancesOut.n_rows, distancesOut.n_cols);
     neighbors.set_size(neighborsOut.n_rows, neighborsOut.n_cols);
@@ -182,22 +213,28 @@ void LeafSizeNSWrapper<
   }
   else
   {
+    arma::Mat<ElemType> distancesOut;
     timers.Start("computing_neighbors");
-    ns.Search(querySet, k, neighbors, distances);
+    ns.Search(querySetIn, k, neighbors, distancesOut);
     timers.Stop("computing_neighbors");
+
+    ConvertNSMatrix(std::move(distancesOut), distances);
   }
 }
 
 //! Train the model using the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
-                                       arma::mat&& referenceSet,
-                                       const size_t leafSize,
-                                       const double tau,
-                                       const double rho)
+template<typename SortPolicy, typename ElemType>
+void SpillNSWrapper<SortPolicy, ElemType>::Train(util::Timers& timers,
+                                                 arma::mat&& referenceSet,
+                                                 const size_t leafSize,
+                                                 const double tau,
+                                                 const double rho)
 {
+  arma::Mat<ElemType> referenceSetIn;
+  ConvertNSMatrix(std::move(referenceSet), referenceSetIn);
+
   timers.Start("tree_building");
-  typename decltype(ns)::Tree tree(std::move(referenceSet), tau, leafSize,
+  typename decltype(ns)::Tree tree(std::move(referenceSetIn), tau, leafSize,
       rho);
   timers.Stop("tree_building");
 
@@ -206,34 +243,39 @@ void SpillNSWrapper<SortPolicy>::Train(util::Timers& timers,
 
 //! Perform bichromatic search (i.e. search with a different query set) using
 //! the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Search(util::Timers& timers,
-                                        arma::mat&& querySet,
-                                        const size_t k,
-                                        arma::Mat<size_t>& neighbors,
-                                        arma::mat& distances,
-                                        const size_t leafSize,
-                                        const double rho)
+template<typename SortPolicy, typename ElemType>
+void SpillNSWrapper<SortPolicy, ElemType>::Search(util::Timers& timers,
+                                                  arma::mat&& querySet,
+                                                  const size_t k,
+                                                  arma::Mat<size_t>& neighbors,
+                                                  arma::mat& distances,
+                                                  const size_t leafSize,
+                                                  const double rho)
 {
+  arma::Mat<ElemType> querySetIn, distancesOut;
+  ConvertNSMatrix(std::move(querySet), querySetIn);
+
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
     // For Dual Tree Search on SpillTrees, the queryTree must be built with
     // non overlapping (tau = 0).
     timers.Start("tree_building");
-    typename decltype(ns)::Tree queryTree(std::move(querySet), 0 /* tau */,
+    typename decltype(ns)::Tree queryTree(std::move(querySetIn), 0 /* tau */,
         leafSize, rho);
     timers.Stop("tree_building");
 
     timers.Start("computing_neighbors");
-    ns.Search(queryTree, k, neighbors, distances);
+    ns.Search(queryTree, k, neighbors, distancesOut);
     timers.Stop("computing_neighbors");
   }
   else
   {
     timers.Start("computing_neighbors");
-    ns.Search(querySet, k, neighbors, distances);
+    ns.Search(querySetIn, k, neighbors, distancesOut);
     timers.Stop("computing_neighbors");
   }
+
+  ConvertNSMatrix(std::move(distancesOut), distances);
 }
 
 /**
@@ -247,6 +289,7 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
     leafSize(20),
     tau(0.0),
     rho(0.7),
+    singlePrecision(false),
     nSearch(NULL)
 {
   // Nothing to do.
@@ -260,6 +303,7 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    singlePrecision(other.singlePrecision),
     nSearch(other.nSearch->Clone())
 {
   // Nothing to do.
@@ -273,6 +317,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
     leafSize(other.leafSize),
     tau(other.tau),
     rho(other.rho),
+    singlePrecision(other.singlePrecision),
     nSearch(other.nSearch)
 {
   // Reset parameters of the other model.
@@ -281,6 +326,7 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.leafSize = 20;
   other.tau = 0.0;
   other.rho = 0.7;
+  other.singlePrecision = false;
   other.nSearch = NULL;
 }
 
@@ -297,6 +343,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    singlePrecision = other.singlePrecision;
     nSearch = other.nSearch->Clone();
   }
 
@@ -316,6 +363,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     leafSize = other.leafSize;
     tau = other.tau;
     rho = other.rho;
+    singlePrecision = other.singlePrecision;
     nSearch = other.nSearch;
 
     // Reset parameters of the other model.
@@ -324,6 +372,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
     other.leafSize = 20;
     other.tau = 0.0;
     other.rho = 0.7;
+    other.singlePrecision = false;
     other.nSearch = NULL;
   }
 
@@ -340,7 +389,7 @@ NSModel<SortPolicy>::~NSModel()
 //! Serialize the kNN model.
 template<typename SortPolicy>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -349,115 +398,132 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_NVP(tau));
   ar(CEREAL_NVP(rho));
 
+  // Older versions did not support single-precision models.
+  if (version > 0)
+    ar(CEREAL_NVP(singlePrecision));
+  else if (cereal::is_loading<Archive>())
+    singlePrecision = false;
+
   // This should never happen, but just in case, be clean with memory.
   if (cereal::is_loading<Archive>())
     InitializeModel(DUAL_TREE_MODE, 0.0); // Values will be overwritten.
 
+  if (singlePrecision)
+    SerializeSearch<float>(ar);
+  else
+    SerializeSearch<double>(ar);
+}
+
+//! Serialize the NeighborSearch object held in the model.
+template<typename SortPolicy>
+template<typename ElemType, typename Archive>
+void NSModel<SortPolicy>::SerializeSearch(Archive& ar)
+{
   // Avoid polymorphic serialization by explicitly serializing the correct type.
   switch (treeType)
   {
     case KD_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, KDTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, KDTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, KDTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case COVER_TREE:
       {
-        NSWrapper<SortPolicy, StandardCoverTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, StandardCoverTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, StandardCoverTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_TREE:
       {
-        NSWrapper<SortPolicy, RTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, RTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_STAR_TREE:
       {
-        NSWrapper<SortPolicy, RStarTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RStarTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, RStarTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case BALL_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, BallTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, BallTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, BallTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case X_TREE:
       {
-        NSWrapper<SortPolicy, XTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, XTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, XTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case HILBERT_R_TREE:
       {
-        NSWrapper<SortPolicy, HilbertRTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, HilbertRTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, HilbertRTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, RPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RPlusTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, RPlusTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, RPlusPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, RPlusPlusTree>&>(*nSearch);
+        typedef NSWrapper<SortPolicy, RPlusPlusTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case SPILL_TREE:
       {
-        SpillNSWrapper<SortPolicy>& typedSearch =
-            dynamic_cast<SpillNSWrapper<SortPolicy>&>(*nSearch);
+        typedef SpillNSWrapper<SortPolicy, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case VP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, VPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, VPTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, VPTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, RPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, RPTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, RPTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case MAX_RP_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, MaxRPTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, MaxRPTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, MaxRPTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case UB_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, UBTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, UBTree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, UBTree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case OCTREE:
       {
-        LeafSizeNSWrapper<SortPolicy, Octree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy, Octree>&>(*nSearch);
+        typedef LeafSizeNSWrapper<SortPolicy, Octree, ElemType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
@@ -471,6 +537,20 @@ const arma::mat& NSModel<SortPolicy>::Dataset() const
   return nSearch->Dataset();
 }
 
+//! Get the dimensionality of the dataset.
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::Dimensionality() const
+{
+  return nSearch->Dimensionality();
+}
+
+//! Get the number of points in the dataset.
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::NumReferencePoints() const
+{
+  return nSearch->NumReferencePoints();
+}
+
 //! Access the search mode.
 template<typename SortPolicy>
 NeighborSearchMode NSModel<SortPolicy>::SearchMode() const
@@ -506,55 +586,76 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
   if (nSearch)
     delete nSearch;
 
+  if (singlePrecision)
+    InitializeSearch<float>(searchMode, epsilon);
+  else
+    InitializeSearch<double>(searchMode, epsilon);
+}
+
+//! Create the NeighborSearch object with the given element type.
+template<typename SortPolicy>
+template<typename ElemType>
+void NSModel<SortPolicy>::InitializeSearch(const NeighborSearchMode searchMode,
+                                           const double epsilon)
+{
   switch (treeType)
   {
     case KD_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, KDTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, KDTree, ElemType>(
+          searchMode, epsilon);
       break;
     case COVER_TREE:
-      nSearch = new NSWrapper<SortPolicy, StandardCoverTree>(searchMode,
-          epsilon);
+      nSearch = new NSWrapper<SortPolicy, StandardCoverTree, ElemType>(
+          searchMode, epsilon);
       break;
     case R_TREE:
-      nSearch = new NSWrapper<SortPolicy, RTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, RTree, ElemType>(searchMode, epsilon);
       break;
     case R_STAR_TREE:
-      nSearch = new NSWrapper<SortPolicy, RStarTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, RStarTree, ElemType>(
+          searchMode, epsilon);
       break;
     case BALL_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, BallTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, BallTree, ElemType>(
+          searchMode, epsilon);
       break;
     case X_TREE:
-      nSearch = new NSWrapper<SortPolicy, XTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, XTree, ElemType>(searchMode, epsilon);
       break;
     case HILBERT_R_TREE:
-      nSearch = new NSWrapper<SortPolicy, HilbertRTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, HilbertRTree, ElemType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, RPlusTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, RPlusTree, ElemType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, RPlusPlusTree>(searchMode, epsilon);
+      nSearch = new NSWrapper<SortPolicy, RPlusPlusTree, ElemType>(
+          searchMode, epsilon);
       break;
     case VP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, VPTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, VPTree, ElemType>(
+          searchMode, epsilon);
       break;
     case RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, RPTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, RPTree, ElemType>(
+          searchMode, epsilon);
       break;
     case MAX_RP_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, MaxRPTree>(searchMode,
-          epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, MaxRPTree, ElemType>(
+          searchMode, epsilon);
       break;
     case SPILL_TREE:
-      nSearch = new SpillNSWrapper<SortPolicy>(searchMode, epsilon);
+      nSearch = new SpillNSWrapper<SortPolicy, ElemType>(searchMode, epsilon);
       break;
     case UB_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, UBTree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, UBTree, ElemType>(
+          searchMode, epsilon);
       break;
     case OCTREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, Octree>(searchMode, epsilon);
+      nSearch = new LeafSizeNSWrapper<SortPolicy, Octree, ElemType>(
+          searchMode, epsilon);
       break;
   }
 }
@@ -645,6 +746,10 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEAM_SINGLE_TREE_MODE:
+      Log::Info << "beam single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   nSearch->Search(timers, std::move(querySet), k, neighbors, distances,
@@ -675,6 +780,10 @@ void NSModel<SortPolicy>::Search(util::Timers& timers,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEAM_SINGLE_TREE_MODE:
+      Log::Info << "beam single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   if (Epsilon() != 0 && SearchMode() != NAIVE_MODE)
@@ -65,6 +65,47 @@ using DefeatistKNN = NeighborSearch<
  */
 typedef DefeatistKNN<SPTree> SpillKNN;
 
+/**
+ * The ParallelKNN class is the k-nearest-neighbors method using a task-parallel
+ * dual-tree traversal (with OpenMP).  It returns L2 distances (Euclidean
+ * distances) for each of the k nearest neighbors.  The results are identical
+ * to those of KNN.
+ *
+ * @tparam TreeType The tree type to use; must provide a
+ *     ParallelDualTreeTraverser (i.e. any BinarySpaceTree, CoverTree,
+ *     SpillTree, RectangleTree or Octree variant; the last two use the
+ *     parallel breadth-first traverser).
+ */
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = KDTree>
+using ParallelKNN = NeighborSearch<
+    NearestNeighborSort,
+    EuclideanDistance,
+    arma::mat,
+    TreeType,
+    TreeType<EuclideanDistance,
+        NeighborSearchStat<NearestNeighborSort>,
+        arma::mat>::template ParallelDualTreeTraverser>;
+
+/**
+ * The ParallelSpillKNN class is the k-nearest-neighbors method considering
+ * defeatist search on SPTree, like SpillKNN, but the dual-tree traversal is
+ * done by many threads at once (with OpenMP).  Single-tree searches are done in
+ * parallel by SpillKNN too.
+ */
+typedef NeighborSearch<
+    NearestNeighborSort,
+    EuclideanDistance,
+    arma::mat,
+    SPTree,
+    SPTree<EuclideanDistance,
+        NeighborSearchStat<NearestNeighborSort>,
+        arma::mat>::template DefeatistParallelDualTreeTraverser,
+    SPTree<EuclideanDistance,
+        NeighborSearchStat<NearestNeighborSort>,
+        arma::mat>::template DefeatistSingleTreeTraverser> ParallelSpillKNN;
+
 } // namespace mlpack
 
 #endif
@@ -48,6 +48,16 @@ class NystroemMethod
    */
   void Apply(arma::mat& output);
 
+  /**
+   * Map the given points with the factorization computed by the last call to
+   * Apply(), so that K(newData, newData) ~= output * output^T.  Applied to the
+   * points given to the constructor, this gives the output of Apply().
+   *
+   * @param newData Points to map.
+   * @param output Matrix to store the mapped points into (one row per point).
+   */
+  void Transform(const arma::mat& newData, arma::mat& output) const;
+
   /**
    * Construct the kernel matrix with matrix that contains the selected points.
    *
@@ -70,6 +80,12 @@ class NystroemMethod
                        arma::mat& miniKernel,
                        arma::mat& semiKernel);
 
+  //! Get the selected points, computed by the last call to Apply().
+  const arma::mat& Landmarks() const { return landmarks; }
+  //! Get the rank x rank matrix that maps the kernel between a point and the
+  //! selected points to its row of the output of Apply().
+  const arma::mat& Projection() const { return projection; }
+
  private:
   //! The reference dataset.
   const arma::mat& data;
@@ -77,6 +93,10 @@ class NystroemMethod
   KernelType& kernel;
   //! Rank used for matrix approximation.
   const size_t rank;
+  //! The selected points.
+  arma::mat landmarks;
+  //! The normalization of the semi-kernel matrix, U S^{-1/2} V^T.
+  arma::mat projection;
 };
 
 } // namespace mlpack
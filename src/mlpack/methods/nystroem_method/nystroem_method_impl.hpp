@@ -34,18 +34,13 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
-                                         selectedData->col(j));
-
-  // Construct semi-kernel matrix with interactions between selected data and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         selectedData->col(j));
+  landmarks = *selectedData;
+
+  // Assemble the mini-kernel matrix, and the semi-kernel matrix with
+  // interactions between selected data and all points.
+  KernelMatrix(kernel, landmarks, miniKernel);
+  KernelMatrix(kernel, data, landmarks, semiKernel);
+
   // Clean the memory.
   delete selectedData;
 }
@@ -56,22 +51,12 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-  {
-    for (size_t j = 0; j < rank; ++j)
-    {
-      miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
-                                         data.col(selectedPoints(j)));
-    }
-  }
+  landmarks = data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
 
-  // Construct semi-kernel matrix with interactions between selected points and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
-    for (size_t j = 0; j < rank; ++j)
-      semiKernel(i, j) = kernel.Evaluate(data.col(i),
-                                         data.col(selectedPoints(j)));
+  // Assemble the mini-kernel matrix, and the semi-kernel matrix with
+  // interactions between selected points and all points.
+  KernelMatrix(kernel, landmarks, miniKernel);
+  KernelMatrix(kernel, data, landmarks, semiKernel);
 }
 
 template<typename KernelType, typename PointSelectionPolicy>
@@ -95,7 +80,24 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::Apply(arma::mat& output)
     if (std::abs(s[i]) <= 1e-20)
       normalization(i, i) = 0.0;
 
-  output = semiKernel * U * normalization * V;
+  projection = U * normalization * V;
+  output = semiKernel * projection;
+}
+
+template<typename KernelType, typename PointSelectionPolicy>
+void NystroemMethod<KernelType, PointSelectionPolicy>::Transform(
+    const arma::mat& newData,
+    arma::mat& output) const
+{
+  if (projection.is_empty())
+  {
+    throw std::logic_error("NystroemMethod::Transform(): Apply() must be "
+        "called first!");
+  }
+
+  arma::mat semiKernel;
+  KernelMatrix(kernel, newData, landmarks, semiKernel);
+  output = semiKernel * projection;
 }
 
 } // namespace mlpack
@@ -12,5 +12,6 @@
 #define MLPACK_PCA_HPP
 
 #include "pca/pca.hpp"
+#include "pca/incremental_pca.hpp"
 
 #endif
@@ -16,5 +16,6 @@
 #include "quic_svd_method.hpp"
 #include "randomized_block_krylov_method.hpp"
 #include "randomized_svd_method.hpp"
+#include "streaming_randomized_svd_method.hpp"
 
 #endif
@@ -0,0 +1,100 @@
+/**
+ * @file methods/pca/decomposition_policies/streaming_randomized_svd_method.hpp
+ *
+ * Implementation of the single-pass streaming randomized SVD method for use in
+ * the Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_STREAMING_SVD_METHOD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_STREAMING_SVD_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/randomized_svd/streaming_randomized_svd.hpp>
+
+namespace mlpack {
+
+/**
+ * Implementation of the streaming randomized SVD policy.  The singular vectors
+ * are computed in a single pass over blocks of columns of the centered data.
+ * To compute the principal components of data that does not fit in memory,
+ * use StreamingRandomizedSVD directly, with centering.
+ */
+class StreamingRandomizedSVDPolicy
+{
+ public:
+  /**
+   * Use the streaming randomized SVD method to perform the principal
+   * components analysis (PCA).
+   *
+   * @param oversampling Number of extra dimensions of the range sketch
+   *        (Default: 10).
+   * @param blockSize Number of columns processed at once (Default: 4096).
+   */
+  StreamingRandomizedSVDPolicy(const size_t oversampling = 10,
+                               const size_t blockSize = 4096) :
+      oversampling(oversampling),
+      blockSize(blockSize)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * streaming randomized SVD.
+   *
+   * @param data Data matrix.
+   * @param centeredData Centered data matrix.
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename InMatType, typename MatType, typename VecType>
+  void Apply(const InMatType& /* data */,
+             const MatType& centeredData,
+             MatType& transformedData,
+             VecType& eigVal,
+             MatType& eigvec,
+             const size_t rank)
+  {
+    // This matrix will store the right singular vectors; we do not need them.
+    MatType v;
+
+    // The data is already centered.
+    StreamingRandomizedSVD<MatType> svd(rank, oversampling, false, blockSize);
+    svd.Apply(centeredData, eigvec, eigVal, v);
+
+    // Now we must square the singular values to get the eigenvalues.
+    // In addition we must divide by the number of points, because the
+    // covariance matrix is X * X' / (N - 1).
+    eigVal %= eigVal / (centeredData.n_cols - 1);
+
+    // Project the samples to the principals.
+    transformedData = trans(eigvec) * centeredData;
+  }
+
+  //! Get the oversampling of the range sketch.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the oversampling of the range sketch.
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get the number of columns processed at once.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns processed at once.
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Locally stored oversampling of the range sketch.
+  size_t oversampling;
+
+  //! Locally stored number of columns processed at once.
+  size_t blockSize;
+};
+
+} // namespace mlpack
+
+#endif
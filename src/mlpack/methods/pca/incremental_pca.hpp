@@ -0,0 +1,161 @@
+/**
+ * @file methods/pca/incremental_pca.hpp
+ *
+ * Defines the IncrementalPCA class, which updates a principal components
+ * analysis with each new batch of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "decomposition_policies/decomposition_policies.hpp"
+
+namespace mlpack {
+
+/**
+ * This class implements incremental principal components analysis: the mean,
+ * the principal components and the singular values are updated with each new
+ * batch of points, without storing the points seen so far.  With k components,
+ * d dimensions and a batch of m points, each update computes the SVD of the
+ * d x (k + m + 1) matrix
+ *
+ *   [ f U S, X - mu_X 1^T, sqrt(f n m / (f n + m)) (mu - mu_X) ],
+ *
+ * where U and S are the current components and singular values, mu and n the
+ * current mean and (effective) number of points, mu_X the mean of the batch,
+ * and f the forgetting factor.  With f = 1, this is the exact PCA of all of
+ * the points when k is the dimensionality; smaller values of f give more
+ * weight to recent batches, which is useful to track data that changes over
+ * time.
+ *
+ * The SVD is computed with the given PCA decomposition policy.  Since some
+ * policies center their input, the matrix is given together with its negation,
+ * which has zero mean and the same singular vectors.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @article{ross2008incremental,
+ *   title={Incremental learning for robust visual tracking},
+ *   author={Ross, D.A. and Lim, J. and Lin, R.-S. and Yang, M.-H.},
+ *   journal={International Journal of Computer Vision},
+ *   volume={77},
+ *   number={1--3},
+ *   pages={125--141},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * @tparam DecompositionPolicy Decomposition policy used for each update.
+ */
+template<typename DecompositionPolicy = ExactSVDPolicy>
+class IncrementalPCA
+{
+ public:
+  /**
+   * Create the IncrementalPCA object, without any points.
+   *
+   * @param rank Number of principal components to keep.
+   * @param forgetFactor Weight of the previous points at each update, between
+   *     0 and 1.
+   * @param decomposition Decomposition policy to use.
+   */
+  IncrementalPCA(const size_t rank = 10,
+                 const double forgetFactor = 1.0,
+                 const DecompositionPolicy& decomposition =
+                     DecompositionPolicy());
+
+  /**
+   * Update the model with the given batch of points.  All batches must have
+   * the same dimensionality.
+   *
+   * @param batch Batch of points (one column per point).
+   */
+  template<typename MatType>
+  void Update(const MatType& batch);
+
+  /**
+   * Project the given points onto the principal components.
+   *
+   * @param data Points to project.
+   * @param transformedData Matrix to store the projected points in (one row
+   *     per component).
+   */
+  template<typename MatType, typename OutMatType>
+  void Transform(const MatType& data, OutMatType& transformedData) const;
+
+  //! Forget all the points seen so far.
+  void Reset();
+
+  //! Get the mean of the points.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the principal components (one column per component).
+  const arma::mat& Components() const { return components; }
+  //! Get the singular values of the centered points.
+  const arma::vec& SingularValues() const { return singularValues; }
+  //! Get the variance along each component (the eigenvalues of the
+  //! covariance).
+  arma::vec EigenValues() const
+  {
+    return (weight > 1.0) ? arma::vec(arma::square(singularValues) /
+        (weight - 1.0)) : arma::vec(singularValues.n_elem, arma::fill::zeros);
+  }
+
+  //! Get the number of points seen so far.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the effective number of points, taking the forgetting into account.
+  double Weight() const { return weight; }
+
+  //! Get the number of principal components to keep.
+  size_t Rank() const { return rank; }
+  //! Modify the number of principal components to keep.
+  size_t& Rank() { return rank; }
+
+  //! Get the forgetting factor.
+  double ForgetFactor() const { return forgetFactor; }
+  //! Modify the forgetting factor.
+  double& ForgetFactor() { return forgetFactor; }
+
+  //! Get the decomposition policy.
+  const DecompositionPolicy& Decomposition() const { return decomposition; }
+  //! Modify the decomposition policy.
+  DecompositionPolicy& Decomposition() { return decomposition; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Number of principal components to keep.
+  size_t rank;
+  //! Weight of the previous points at each update.
+  double forgetFactor;
+  //! Decomposition method used for each update.
+  DecompositionPolicy decomposition;
+
+  //! Number of points seen so far.
+  size_t numPoints;
+  //! Effective number of points.
+  double weight;
+  //! Mean of the points.
+  arma::vec mean;
+  //! Principal components.
+  arma::mat components;
+  //! Singular values of the centered points.
+  arma::vec singularValues;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "incremental_pca_impl.hpp"
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file methods/pca/incremental_pca_impl.hpp
+ *
+ * Implementation of the IncrementalPCA class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_INCREMENTAL_PCA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "incremental_pca.hpp"
+
+namespace mlpack {
+
+template<typename DecompositionPolicy>
+IncrementalPCA<DecompositionPolicy>::IncrementalPCA(
+    const size_t rank,
+    const double forgetFactor,
+    const DecompositionPolicy& decomposition) :
+    rank(rank),
+    forgetFactor(forgetFactor),
+    decomposition(decomposition),
+    numPoints(0),
+    weight(0.0)
+{
+  if (rank == 0)
+  {
+    throw std::invalid_argument("IncrementalPCA::IncrementalPCA(): rank must "
+        "be positive!");
+  }
+
+  if (forgetFactor <= 0.0 || forgetFactor > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::IncrementalPCA(): forgetFactor (" << forgetFactor
+        << ") must be in (0, 1]!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename DecompositionPolicy>
+template<typename MatType>
+void IncrementalPCA<DecompositionPolicy>::Update(const MatType& batchIn)
+{
+  const arma::mat batch = arma::conv_to<arma::mat>::from(batchIn);
+  if (batch.n_cols == 0)
+    return;
+
+  if (numPoints > 0 && batch.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "IncrementalPCA::Update(): batch has dimensionality "
+        << batch.n_rows << ", but the model has dimensionality " << mean.n_elem
+        << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const arma::vec batchMean = arma::mean(batch, 1);
+  arma::mat stacked = batch.each_col() - batchMean;
+  if (numPoints > 0)
+  {
+    // The previous points are represented by their components, and by the
+    // shift of their mean.
+    const double oldWeight = forgetFactor * weight;
+    const double newWeight = oldWeight + batch.n_cols;
+    stacked = arma::join_rows(components *
+        arma::diagmat(forgetFactor * singularValues), stacked,
+        std::sqrt(oldWeight * batch.n_cols / newWeight) * (mean - batchMean));
+
+    mean = (oldWeight * mean + batch.n_cols * batchMean) / newWeight;
+    weight = newWeight;
+  }
+  else
+  {
+    mean = batchMean;
+    weight = batch.n_cols;
+  }
+  numPoints += batch.n_cols;
+
+  // [M, -M] has zero mean, so that it is not changed by policies that center
+  // their input, and its singular values are sqrt(2) times those of M.
+  const arma::mat symmetric = arma::join_rows(stacked, -stacked);
+  arma::mat transformed, eigvec;
+  arma::vec eigVal;
+  decomposition.Apply(symmetric, symmetric, transformed, eigVal, eigvec,
+      std::min(rank, (size_t) symmetric.n_rows));
+
+  // The policy returns the eigenvalues sigma^2 / (N - 1).
+  const size_t newRank = std::min(rank, (size_t) std::min(eigVal.n_elem,
+      eigvec.n_cols));
+  components = eigvec.head_cols(newRank);
+  singularValues = arma::sqrt(eigVal.head(newRank) *
+      ((symmetric.n_cols - 1) / 2.0));
+}
+
+template<typename DecompositionPolicy>
+template<typename MatType, typename OutMatType>
+void IncrementalPCA<DecompositionPolicy>::Transform(
+    const MatType& data,
+    OutMatType& transformedData) const
+{
+  if (numPoints == 0)
+  {
+    throw std::logic_error("IncrementalPCA::Transform(): the model has not "
+        "seen any points!");
+  }
+
+  const arma::mat centered = arma::conv_to<arma::mat>::from(data).each_col() -
+      mean;
+  transformedData = arma::conv_to<OutMatType>::from(components.t() *
+      centered);
+}
+
+template<typename DecompositionPolicy>
+void IncrementalPCA<DecompositionPolicy>::Reset()
+{
+  numPoints = 0;
+  weight = 0.0;
+  mean.reset();
+  components.reset();
+  singularValues.reset();
+}
+
+template<typename DecompositionPolicy>
+template<typename Archive>
+void IncrementalPCA<DecompositionPolicy>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(rank));
+  ar(CEREAL_NVP(forgetFactor));
+  ar(CEREAL_NVP(numPoints));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(components));
+  ar(CEREAL_NVP(singularValues));
+}
+
+} // namespace mlpack
+
+#endif
@@ -24,6 +24,22 @@ namespace mlpack {
  * network).  It converges if the supplied training dataset is linearly
  * separable.
  *
+ * During training, the points are scored in blocks with a single matrix
+ * product, and the weights are only updated for the points that are
+ * mispredicted; after an update, only the scores of the two classes whose
+ * weights changed are recomputed for the rest of the block.  So, the learning
+ * policy may only modify the weights and biases of the incorrect class and of
+ * the correct class (as SimpleWeightUpdate does).  MatType may be a sparse
+ * matrix type, such as arma::sp_mat.
+ *
+ * If Average() is set to true, an averaged perceptron is trained instead: the
+ * weights at the end of Train() are the average of the weights after each
+ * point seen during training, which generalizes much better than the final
+ * weights when the data is not linearly separable.  The average is kept with
+ * lazy (timestamped) updates, so it costs nothing for correctly classified
+ * points; this requires the update of the learning policy to be linear in the
+ * instance weight.
+ *
  * @tparam LearnPolicy Options of SimpleWeightUpdate and GradientDescent.
  * @tparam WeightInitializationPolicy Option of ZeroInitialization and
  *      RandomPerceptronInitialization.
@@ -183,6 +199,23 @@ class Perceptron
    */
   void Classify(const MatType& test, arma::Row<size_t>& predictedLabels) const;
 
+  /**
+   * Classify the given points, stored contiguously in column-major order (like
+   * the memory of an Armadillo matrix with as many rows as the weights),
+   * storing the predicted labels in `predictedLabels`.  This does not allocate
+   * memory and does not check its inputs, so it is suited to low-latency
+   * prediction of single points or small batches; the model must be trained.
+   *
+   * @param points Pointer to the `numPoints * Weights().n_rows` elements of
+   *     the points.
+   * @param numPoints Number of points to classify.
+   * @param predictedLabels Preallocated array of `numPoints` labels to store
+   *     the predictions in.
+   */
+  void Classify(const ElemType* points,
+                const size_t numPoints,
+                size_t* predictedLabels) const noexcept;
+
   /**
    * Reset the model, so that the next call to `Train()` will not be
    * incremental.
@@ -200,6 +233,11 @@ class Perceptron
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get whether Train() computes the averaged weights.
+  bool Average() const { return average; }
+  //! Modify whether Train() computes the averaged weights.
+  bool& Average() { return average; }
+
   //! Get the number of classes this perceptron has been trained for.
   size_t NumClasses() const { return weights.n_cols; }
 
@@ -229,6 +267,9 @@ class Perceptron
   //! The maximum number of iterations during training.
   size_t maxIterations;
 
+  //! Whether to train an averaged perceptron.
+  bool average;
+
   /**
    * Stores the weights for each of the input class labels.  Each column
    * corresponds to the weights for one class label, and each row corresponds to
@@ -243,6 +284,12 @@ class Perceptron
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename LearnPolicy,
+                               typename WeightInitializationPolicy,
+                               typename MatType),
+    (mlpack::Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>),
+    (1));
+
 #include "perceptron_impl.hpp"
 
 #endif
@@ -29,7 +29,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t numClasses,
     const size_t dimensionality,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    average(false)
 {
   WeightInitializationPolicy wip;
   wip.Initialize(weights, biases, dimensionality, numClasses);
@@ -55,7 +56,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    average(false)
 {
   // Start training.
   TrainInternal<false, arma::Row<typename MatType::elem_type>>(data, labels,
@@ -85,7 +87,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t maxIterations,
     const typename std::enable_if<
         arma::is_arma_type<WeightsType>::value>::type*) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    average(false)
 {
   // Start training.
   TrainInternal<true>(data, labels, numClasses, instanceWeights);
@@ -116,7 +119,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const WeightsType& instanceWeights,
     const typename std::enable_if<
         arma::is_arma_type<WeightsType>::value>::type*) :
-    maxIterations(other.maxIterations)
+    maxIterations(other.maxIterations),
+    average(other.average)
 {
   TrainInternal<true>(data, labels, numClasses, instanceWeights);
 }
@@ -224,14 +228,28 @@ void Perceptron<
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
-  bool converged = false;
-  size_t tempLabel;
-  arma::uword maxIndexRow = 0, maxIndexCol = 0;
-  arma::Mat<ElemType> tempLabelMat;
-
   LearnPolicy LP;
 
+  // For an averaged perceptron, each update is also accumulated, weighted by
+  // the number of points seen before it; the average of the weights after each
+  // point is then weights - (weightUpdates / pointsSeen).
+  arma::Mat<ElemType> weightUpdates;
+  arma::Col<ElemType> biasUpdates;
+  if (average)
+  {
+    weightUpdates.zeros(weights.n_rows, weights.n_cols);
+    biasUpdates.zeros(biases.n_elem);
+  }
+  size_t pointsSeen = 0;
+
+  // The points are scored one block at a time.
+  const size_t blockSize = std::min((size_t) data.n_cols, (size_t) 256);
+  MatType block;
+  arma::Mat<ElemType> scores;
+  arma::Row<ElemType> classScores;
+
+  size_t i = 0;
+  bool converged = false;
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -239,34 +257,62 @@ void Perceptron<
     ++i;
     converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      const size_t numPoints = std::min(blockSize,
+          (size_t) data.n_cols - begin);
+      MakeColsAlias(block, data, begin, numPoints, false);
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      scores = weights.t() * block;
+      scores.each_col() += biases;
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      for (size_t j = 0; j < numPoints; ++j, ++pointsSeen)
       {
+        // Check whether the current weights correctly classify this point.
+        const size_t predictedClass = scores.col(j).index_max();
+        const size_t correctClass = labels[begin + j];
+        if (predictedClass == correctClass)
+          continue;
+
         // Due to incorrect prediction, convergence set to false.
         converged = false;
-        tempLabel = labels(0, j);
+        const ElemType instanceWeight = HasWeights ?
+            (ElemType) instanceWeights[begin + j] : ElemType(1);
 
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
         if (HasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              (typename MatType::elem_type) instanceWeights(j));
+          LP.UpdateWeights(block.col(j), weights, biases, predictedClass,
+              correctClass, instanceWeight);
         else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+          LP.UpdateWeights(block.col(j), weights, biases, predictedClass,
+              correctClass);
+
+        if (average)
+        {
+          LP.UpdateWeights(block.col(j), weightUpdates, biasUpdates,
+              predictedClass, correctClass,
+              ElemType(pointsSeen) * instanceWeight);
+        }
+
+        // Only the scores of the two updated classes have changed.
+        if (j + 1 < numPoints)
+        {
+          for (const size_t c : { predictedClass, correctClass })
+          {
+            classScores = weights.col(c).t() *
+                block.cols(j + 1, numPoints - 1);
+            scores.submat(c, j + 1, c, numPoints - 1) = classScores +
+                biases[c];
+          }
+        }
       }
     }
   }
+
+  if (average && pointsSeen > 0)
+  {
+    weights -= weightUpdates / ElemType(pointsSeen);
+    biases -= biasUpdates / ElemType(pointsSeen);
+  }
 }
 
 /**
@@ -316,16 +362,42 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
   util::CheckSameDimensionality(test, weights.n_rows, "Perceptron::Classify()",
       "points");
 
-  arma::Col<ElemType> tempLabelMat;
-  arma::uword maxIndex = 0;
-  predictedLabels.set_size(test.n_cols);
+  // Score all the points with one matrix product.
+  arma::Mat<ElemType> scores = weights.t() * test;
+  scores.each_col() += biases;
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(scores, 0));
+}
 
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
+template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType
+>
+void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
+    const ElemType* points,
+    const size_t numPoints,
+    size_t* predictedLabels) const noexcept
+{
+  const size_t dimensionality = weights.n_rows;
+  for (size_t i = 0; i < numPoints; ++i)
   {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    const ElemType* point = points + i * dimensionality;
+    ElemType maxScore = -std::numeric_limits<ElemType>::infinity();
+    predictedLabels[i] = 0;
+    for (size_t j = 0; j < weights.n_cols; ++j)
+    {
+      const ElemType* w = weights.colptr(j);
+      ElemType score = biases[j];
+      for (size_t d = 0; d < dimensionality; ++d)
+        score += w[d] * point[d];
+
+      if (score > maxScore)
+      {
+        maxScore = score;
+        predictedLabels[i] = j;
+      }
+    }
   }
 }
 
@@ -349,13 +421,19 @@ template<typename LearnPolicy,
 template<typename Archive>
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::serialize(
     Archive& ar,
-    const uint32_t /* version */)
+    const uint32_t version)
 {
   // We just need to serialize the maximum number of iterations, the weights,
   // and the biases.
   ar(CEREAL_NVP(maxIterations));
   ar(CEREAL_NVP(weights));
   ar(CEREAL_NVP(biases));
+
+  // Older versions did not support averaging.
+  if (version > 0)
+    ar(CEREAL_NVP(average));
+  else if (cereal::is_loading<Archive>())
+    average = false;
 }
 
 } // namespace mlpack
@@ -46,7 +46,11 @@ BINDING_LONG_DESC(
     "specific dimension to analyze if there are too many dimensions. The " +
     PRINT_PARAM_STRING("population") + " parameter can be specified when the "
     "dataset should be considered as a population.  Otherwise, the dataset "
-    "will be considered as a sample.");
+    "will be considered as a sample."
+    "\n\n"
+    "All of the statistics are computed in a single parallel pass over the "
+    "data; the median is estimated with a quantile sketch, which is exact "
+    "for datasets of up to 200 points.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -82,97 +86,6 @@ PARAM_FLAG("row_major", "If specified, the program will calculate statistics "
     "across rows, not across columns.  (Remember that in mlpack, a column "
     "represents a point, so this option is generally not necessary.)", "r");
 
-/**
- * Calculates the sum of deviations to the Nth Power.
- *
- * @param input Vector that captures a dimension of a dataset.
- * @param rowMean Mean of the given vector.
- * @param n Degree of power.
- * @return sum of nth power deviations.
- */
-double SumNthPowerDeviations(const arma::rowvec& input,
-                             const double& fMean,
-                             size_t n)
-{
-  return sum(pow(input - fMean, static_cast<double>(n)));
-}
-
-/**
- * Calculates Skewness of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Skewness of the given vector.
- */
-double Skewness(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double skewness = 0;
-  const double S3 = pow(fStd, 3);
-  const double M3 = SumNthPowerDeviations(input, fMean, 3);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population skewness
-    skewness = M3 / (n * S3);
-  }
-  else
-  {
-    // Calculate sample skewness.
-    skewness = n * M3 / ((n - 1) * (n - 2) * S3);
-  }
-  return skewness;
-}
-
-/**
- * Calculates excess kurtosis of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Kurtosis of the given vector.
- */
-double Kurtosis(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double kurtosis = 0;
-  const double M4 = SumNthPowerDeviations(input, fMean, 4);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population excess kurtosis.
-    const double M2 = SumNthPowerDeviations(input, fMean, 2);
-    kurtosis = n * (M4 / pow(M2, 2)) - 3;
-  }
-  else
-  {
-    // Calculate sample excess kurtosis.
-    const double S4 = pow(fStd, 4);
-    const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
-    const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
-    const double normM = M4 / S4;
-    kurtosis = normC * normM - norm3;
-  }
-  return kurtosis;
-}
-
-/**
- * Calculates standard error of standard deviation.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @return Standard error of the stanrdard devation of the given vector.
- */
-double StandardError(const size_t size, const double& fStd)
-{
-  return fStd / sqrt(size);
-}
-
 void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
 {
   const size_t dimension = static_cast<size_t>(params.Get<int>("dimension"));
@@ -192,48 +105,44 @@ void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
       "range" << setw(width) << "skew" << setw(width) << "kurt" << setw(width) << 
       "SE" << endl;
 
-  // Lambda function to print out the results.
-  auto PrintStatResults = [&](size_t dim, bool rowMajor)
+  // All of the statistics are computed in one (parallel) pass over the data;
+  // the median is estimated with a quantile sketch.
+  DescriptiveStatistics stats;
+  if (params.Has("dimension"))
   {
-    arma::rowvec feature;
     if (rowMajor)
-      feature = ConvTo<arma::rowvec>::From(data.col(dim));
+      stats.Update(arma::mat(data.col(dimension).t()));
     else
-      feature = data.row(dim);
-
-    // f at the front of the variable names means "feature".
-    const double fMax = max(feature);
-    const double fMin = min(feature);
-    const double fMean = arma::mean(feature);
-    const double fStd = arma::stddev(feature, population);
-
-    // Print statistics of the given dimension.
-    Log::Info << setprecision(precision) << setw(width) << dim << 
-        setw(width) << arma::var(feature, population) << 
-        setw(width) << fMean << 
-        setw(width) << fStd <<
-        setw(width) << arma::median(feature) << 
-        setw(width) << fMin << 
-        setw(width) << fMax << 
-        setw(width) << (fMax - fMin) <<
-        setw(width) << Skewness(feature, fStd, fMean, population) <<
-        setw(width) << Kurtosis(feature, fStd, fMean, population) <<
-        setw(width) << StandardError(feature.n_elem, fStd) << endl;
-  };
-
-  // If the user specified dimension, describe statistics of the given
-  // dimension. If a dimension is not specified, describe all dimensions.
-  if (params.Has("dimension"))
-  {
-    PrintStatResults(dimension, rowMajor);
+      stats.Update(arma::mat(data.row(dimension)));
   }
   else
   {
-    const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
-    for (size_t i = 0; i < dimensions; ++i)
-    {
-      PrintStatResults(i, rowMajor);
-    }
+    if (rowMajor)
+      stats.Update(arma::mat(data.t()));
+    else
+      stats.Update(data);
+  }
+
+  const arma::vec variance = stats.Variance(population);
+  const arma::vec stddev = stats.Stddev(population);
+  const arma::vec median = stats.Median();
+  const arma::vec skewness = stats.Skewness(population);
+  const arma::vec kurtosis = stats.Kurtosis(population);
+  for (size_t i = 0; i < stats.Dimensionality(); ++i)
+  {
+    // Print statistics of the given dimension.
+    Log::Info << setprecision(precision) << setw(width) <<
+        (params.Has("dimension") ? dimension : i) <<
+        setw(width) << variance[i] <<
+        setw(width) << stats.Mean()[i] <<
+        setw(width) << stddev[i] <<
+        setw(width) << median[i] <<
+        setw(width) << stats.Min()[i] <<
+        setw(width) << stats.Max()[i] <<
+        setw(width) << (stats.Max()[i] - stats.Min()[i]) <<
+        setw(width) << skewness[i] <<
+        setw(width) << kurtosis[i] <<
+        setw(width) << stddev[i] / sqrt(stats.Count()) << endl;
   }
   timers.Stop("statistics");
 }
@@ -50,6 +50,16 @@ namespace mlpack {
  * // Use the Apply() method to get a factorization.
  * qSVD.Apply(data, u, v, sigma, epsilon, delta);
  * @endcode
+ *
+ * To compute approximations of the same matrix for several error tolerances,
+ * build the cosine tree once with Train(); each call to Apply() then refines
+ * the same tree, reusing the nodes that were already split.
+ *
+ * @code
+ * qSVD.Train(data, delta);
+ * qSVD.Apply(u, v, sigma, 0.1);  // A coarse approximation.
+ * qSVD.Apply(u, v, sigma, 0.01); // Only splits the nodes needed to get here.
+ * @endcode
  */
 template<typename MatType = arma::mat>
 class QUIC_SVD
@@ -81,6 +91,40 @@ class QUIC_SVD
   QUIC_SVD(const double epsilon = 0.03,
            const double delta = 0.1);
 
+  /**
+   * Copy the given QUIC_SVD object, including its cosine tree (if any).  Be
+   * careful!  The copy of the cosine tree holds a copy of the training matrix.
+   *
+   * @param other Object to copy.
+   */
+  QUIC_SVD(const QUIC_SVD& other);
+
+  /**
+   * Take ownership of the cosine tree of the given QUIC_SVD object.
+   *
+   * @param other Object to move.
+   */
+  QUIC_SVD(QUIC_SVD&& other);
+
+  /**
+   * Copy the given QUIC_SVD object, including its cosine tree (if any).
+   *
+   * @param other Object to copy.
+   */
+  QUIC_SVD& operator=(const QUIC_SVD& other);
+
+  /**
+   * Take ownership of the cosine tree of the given QUIC_SVD object.
+   *
+   * @param other Object to move.
+   */
+  QUIC_SVD& operator=(QUIC_SVD&& other);
+
+  /**
+   * Clean up the cosine tree (if any).
+   */
+  ~QUIC_SVD();
+
  /**
    * The function calls the CosineTree constructor to create a subspace basis,
    * where the original matrix's projection has minimum reconstruction error. 
@@ -101,6 +145,33 @@ class QUIC_SVD
              const double epsilon = 0.03,
              const double delta = 0.1);
 
+  /**
+   * Build a cosine tree for the given matrix without splitting it, so that
+   * Apply(u, v, sigma, epsilon) can compute the SVD for several values of
+   * epsilon while refining the same tree.  The matrix must stay valid as long
+   * as Apply() is called with this tree.
+   *
+   * @param dataset Matrix for which SVD is calculated.
+   * @param delta Cumulative probability for Monte Carlo error lower bound.
+   */
+  void Train(const MatType& dataset, const double delta = 0.1);
+
+  /**
+   * Calculate the SVD of the matrix given to Train() for the given error
+   * tolerance fraction.  The cosine tree is only split further if no earlier
+   * call reached the given tolerance; so, after a call with a small epsilon,
+   * calls with larger values of epsilon cost no more than ExtractSVD().
+   *
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param sigma Diagonal matrix of singular values.
+   * @param epsilon Error tolerance fraction for calculated subspace.
+   */
+  void Apply(MatType& u,
+             MatType& v,
+             MatType& sigma,
+             const double epsilon = 0.03);
+
   /**
    * This function uses the vector subspace created using a cosine tree to
    * calculate an approximate SVD of the original matrix.
@@ -117,6 +188,13 @@ class QUIC_SVD
  private:
   //! Subspace basis of the input dataset.
   MatType basis;
+  //! Cosine tree built by Train() (if any).
+  CosineTree<MatType>* tree;
+  //! Matrix given to Train() (if any).
+  const MatType* trainData;
+  //! Transposed copy of the matrix given to Train(), if the cosine tree was
+  //! built on it.
+  MatType* transposedData;
 };
 
 } // namespace mlpack
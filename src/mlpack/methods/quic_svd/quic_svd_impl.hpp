@@ -24,7 +24,10 @@ inline QUIC_SVD<MatType>::QUIC_SVD(
     MatType& v,
     MatType& sigma,
     const double epsilon,
-    const double delta)
+    const double delta) :
+    tree(NULL),
+    trainData(NULL),
+    transposedData(NULL)
 {
   Apply(dataset, u, v, sigma, epsilon, delta);
 }
@@ -32,11 +35,81 @@ inline QUIC_SVD<MatType>::QUIC_SVD(
 template<typename MatType>
 inline QUIC_SVD<MatType>::QUIC_SVD(
     const double /* epsilon */,
-    const double /* delta */)
+    const double /* delta */) :
+    tree(NULL),
+    trainData(NULL),
+    transposedData(NULL)
 {
   /* Nothing to do here */
 }
 
+template<typename MatType>
+inline QUIC_SVD<MatType>::QUIC_SVD(const QUIC_SVD& other) :
+    basis(other.basis),
+    tree(other.tree ? new CosineTree<MatType>(*other.tree) : NULL),
+    trainData(other.trainData),
+    transposedData(NULL) // The copy of the tree holds its own matrix.
+{
+  /* Nothing to do here */
+}
+
+template<typename MatType>
+inline QUIC_SVD<MatType>::QUIC_SVD(QUIC_SVD&& other) :
+    basis(std::move(other.basis)),
+    tree(other.tree),
+    trainData(other.trainData),
+    transposedData(other.transposedData)
+{
+  other.tree = NULL;
+  other.trainData = NULL;
+  other.transposedData = NULL;
+}
+
+template<typename MatType>
+inline QUIC_SVD<MatType>& QUIC_SVD<MatType>::operator=(const QUIC_SVD& other)
+{
+  if (this != &other)
+  {
+    delete tree;
+    delete transposedData;
+
+    basis = other.basis;
+    tree = other.tree ? new CosineTree<MatType>(*other.tree) : NULL;
+    trainData = other.trainData;
+    transposedData = NULL; // The copy of the tree holds its own matrix.
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+inline QUIC_SVD<MatType>& QUIC_SVD<MatType>::operator=(QUIC_SVD&& other)
+{
+  if (this != &other)
+  {
+    delete tree;
+    delete transposedData;
+
+    basis = std::move(other.basis);
+    tree = other.tree;
+    trainData = other.trainData;
+    transposedData = other.transposedData;
+
+    other.tree = NULL;
+    other.trainData = NULL;
+    other.transposedData = NULL;
+  }
+
+  return *this;
+}
+
+template<typename MatType>
+inline QUIC_SVD<MatType>::~QUIC_SVD()
+{
+  delete tree;
+  delete transposedData;
+}
+
 template<typename MatType>
 inline void QUIC_SVD<MatType>::Apply(
     const MatType& dataset,
@@ -65,6 +138,47 @@ inline void QUIC_SVD<MatType>::Apply(
   ExtractSVD(dataset, u, v, sigma);
 }
 
+template<typename MatType>
+inline void QUIC_SVD<MatType>::Train(const MatType& dataset, const double delta)
+{
+  delete tree;
+  delete transposedData;
+  transposedData = NULL;
+  trainData = &dataset;
+
+  // Since columns are sample in the implementation, the matrix is transposed if
+  // necessary for maximum speedup.  With epsilon = 1, the root is not split;
+  // that is left to Apply().
+  if (dataset.n_cols > dataset.n_rows)
+  {
+    tree = new CosineTree<MatType>(dataset, 1.0, delta);
+  }
+  else
+  {
+    transposedData = new MatType(dataset.t());
+    tree = new CosineTree<MatType>(*transposedData, 1.0, delta);
+  }
+}
+
+template<typename MatType>
+inline void QUIC_SVD<MatType>::Apply(MatType& u,
+                                     MatType& v,
+                                     MatType& sigma,
+                                     const double epsilon)
+{
+  if (tree == NULL)
+  {
+    throw std::runtime_error("QUIC_SVD::Apply(): no cosine tree has been "
+        "built; call Train() first");
+  }
+
+  // Refine the tree only as much as needed, and get the subspace basis.
+  tree->Refine(epsilon);
+  tree->GetFinalBasis(basis);
+
+  ExtractSVD(*trainData, u, v, sigma);
+}
+
 template<typename MatType>
 inline void QUIC_SVD<MatType>::ExtractSVD(const MatType& dataset,
                                           MatType& u,
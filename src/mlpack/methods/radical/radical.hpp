@@ -26,6 +26,12 @@ namespace mlpack {
  * The goal is to find a square unmixing matrix W such that Y = W X and
  * the rows of Y are independent components.
  *
+ * Each sweep visits every pair of dimensions once, in a round-robin schedule:
+ * the pairs of a round share no dimension, so they are independent, and they
+ * are processed in parallel with OpenMP.  Each pair draws its noise from its
+ * own random generator (seeded from RandGen()), so the results do not depend on
+ * the number of threads.
+ *
  * For more details, see the following paper:
  *
  * @code
@@ -133,6 +139,33 @@ class Radical
   //! Value of m to use for Vasicek's m-spacing estimator of entropy.
   size_t m;
 
+  /**
+   * Two-dimensional version of RADICAL, for use from several threads at once:
+   * the noise is drawn from the given generator, and the given matrices are
+   * used as scratch space.
+   */
+  double DoRadical2D(const arma::mat& matX,
+                     arma::mat& perturbedX,
+                     arma::mat& rotated,
+                     std::mt19937& generator) const;
+
+  /**
+   * Return the rotation angle of the given (perturbed) two-dimensional data
+   * which minimizes the sum of the entropies of the two rotated dimensions.
+   * The rotated dimensions are stored in the given scratch matrix.
+   */
+  double OptimalAngle(const arma::mat& perturbedX, arma::mat& rotated) const;
+
+  /**
+   * Multiply the given matrix by the Jacobi rotation of dimensions i and j with
+   * the given cosine and sine, changing only columns i and j.
+   */
+  static void Rotate(arma::mat& matrix,
+                     const size_t i,
+                     const size_t j,
+                     const double cosTheta,
+                     const double sinTheta);
+
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
   //! Internal matrix, held as member variable to prevent memory reallocations.
@@ -42,7 +42,8 @@ inline void Radical::CopyAndPerturb(arma::mat& xNew,
 
 inline double Radical::Vasicek(arma::vec& z) const
 {
-  z = sort(z);
+  // Sort in place, so that no memory is allocated.
+  std::sort(z.begin(), z.end());
 
   // Apparently slower.
   /*
@@ -63,14 +64,39 @@ inline double Radical::Vasicek(arma::vec& z) const
 }
 
 
-inline double Radical::DoRadical2D(const arma::mat& matX, 
+inline double Radical::DoRadical2D(const arma::mat& matX,
                                    util::Timers& timers)
 {
   timers.Start("radical_copy_and_perturb");
   CopyAndPerturb(perturbed, matX);
   timers.Stop("radical_copy_and_perturb");
 
-  arma::mat::fixed<2, 2> matJacobi;
+  return OptimalAngle(perturbed, candidate);
+}
+
+inline double Radical::DoRadical2D(const arma::mat& matX,
+                                   arma::mat& perturbedX,
+                                   arma::mat& rotated,
+                                   std::mt19937& generator) const
+{
+  perturbedX = repmat(matX, replicates, 1);
+  std::normal_distribution<double> noise(0.0, noiseStdDev);
+  for (size_t i = 0; i < perturbedX.n_elem; ++i)
+    perturbedX[i] += noise(generator);
+
+  return OptimalAngle(perturbedX, rotated);
+}
+
+inline double Radical::OptimalAngle(const arma::mat& perturbedX,
+                                    arma::mat& rotated) const
+{
+  const size_t n = perturbedX.n_rows;
+  rotated.set_size(n, 2);
+
+  // The rotated dimensions are written (and sorted) in place, in the columns of
+  // the rotated matrix.
+  arma::vec candidateY1(rotated.colptr(0), n, false, true);
+  arma::vec candidateY2(rotated.colptr(1), n, false, true);
 
   arma::vec values(angles);
 
@@ -80,14 +106,9 @@ inline double Radical::DoRadical2D(const arma::mat& matX,
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
-
-    candidate = perturbed * matJacobi;
-    arma::vec candidateY1 = candidate.unsafe_col(0);
-    arma::vec candidateY2 = candidate.unsafe_col(1);
+    // This is the product of the data with the Jacobi rotation by theta.
+    candidateY1 = cosTheta * perturbedX.col(0) - sinTheta * perturbedX.col(1);
+    candidateY2 = sinTheta * perturbedX.col(0) + cosTheta * perturbedX.col(1);
 
     values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
   }
@@ -97,6 +118,23 @@ inline double Radical::DoRadical2D(const arma::mat& matX,
   return (indOpt / (double) angles) * M_PI / 2.0;
 }
 
+inline void Radical::Rotate(arma::mat& matrix,
+                            const size_t i,
+                            const size_t j,
+                            const double cosTheta,
+                            const double sinTheta)
+{
+  double* colI = matrix.colptr(i);
+  double* colJ = matrix.colptr(j);
+  for (size_t r = 0; r < matrix.n_rows; ++r)
+  {
+    const double a = colI[r];
+    const double b = colJ[r];
+    colI[r] = cosTheta * a - sinTheta * b;
+    colJ[r] = sinTheta * a + cosTheta * b;
+  }
+}
+
 
 inline void Radical::DoRadical(const arma::mat& matXT,
                                arma::mat& matY,
@@ -135,42 +173,64 @@ inline void Radical::DoRadical(const arma::mat& matXT,
   timers.Start("radical_do_radical");
   matW = matWhitening;
 
-  arma::mat matYSubspace(nPoints, 2);
-
-  arma::mat matJ = arma::eye(nDims, nDims);
+  // The pairs of dimensions are scheduled with the circle method: with an even
+  // number of slots (one more than the number of dimensions, if that is odd),
+  // slot nSlots - 1 stays in place and the others rotate, so that every round
+  // holds disjoint pairs and every pair appears in exactly one round.  Pairs
+  // with the extra slot are skipped.
+  const size_t nSlots = nDims + (nDims % 2);
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::vector<std::mt19937::result_type> seeds;
 
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
 
-    for (size_t i = 0; i < nDims - 1; ++i)
+    for (size_t round = 0; round + 1 < nSlots; ++round)
     {
-      for (size_t j = i + 1; j < nDims; ++j)
+      pairs.clear();
+      for (size_t k = 0; k < nSlots / 2; ++k)
       {
-        Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j << "."
-            << std::endl;
-
-        matYSubspace.col(0) = matY.col(i);
-        matYSubspace.col(1) = matY.col(j);
-
-        const double thetaOpt = DoRadical2D(matYSubspace, timers);
-
-        const double cosThetaOpt = cos(thetaOpt);
-        const double sinThetaOpt = sin(thetaOpt);
-
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
+        const size_t a = (k == 0) ? nSlots - 1 : (round + k) % (nSlots - 1);
+        const size_t b = (round + nSlots - 1 - k) % (nSlots - 1);
+        if (a < nDims && b < nDims)
+          pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+      }
 
-        matY *= matJ;
+      // The seeds are drawn serially, so that the results do not depend on the
+      // number of threads.
+      seeds.resize(pairs.size());
+      for (size_t p = 0; p < pairs.size(); ++p)
+        seeds[p] = RandGen()();
 
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+      #pragma omp parallel num_threads(Parallel::Threads())
+      {
+        // Scratch space, reused for all the pairs of this thread.
+        arma::mat matYSubspace(nPoints, 2);
+        arma::mat threadPerturbed, threadCandidate;
+
+        #pragma omp for schedule(dynamic)
+        for (size_t p = 0; p < pairs.size(); ++p)
+        {
+          const size_t i = pairs[p].first;
+          const size_t j = pairs[p].second;
+
+          matYSubspace.col(0) = matY.col(i);
+          matYSubspace.col(1) = matY.col(j);
+
+          std::mt19937 generator(seeds[p]);
+          const double thetaOpt = DoRadical2D(matYSubspace, threadPerturbed,
+              threadCandidate, generator);
+
+          const double cosThetaOpt = cos(thetaOpt);
+          const double sinThetaOpt = sin(thetaOpt);
+
+          // Apply the Jacobi rotation of dimensions i and j to the components
+          // and to the unmixing matrix; no other pair of this round uses these
+          // columns.
+          Rotate(matY, i, j, cosThetaOpt, sinThetaOpt);
+          Rotate(matW, i, j, cosThetaOpt, sinThetaOpt);
+        }
       }
     }
   }
@@ -2,8 +2,9 @@
  * @file methods/random_forest/bootstrap.hpp
  * @author Ryan Curtin
  *
- * Implementation of the Bootstrap() function, which creates a bootstrapped
- * dataset from the given input dataset.
+ * Implementation of the BootstrapIndices() function, which draws a bootstrap
+ * sample of the points of a dataset, and the Bootstrap() function, which
+ * creates a bootstrapped dataset from the given input dataset.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -15,6 +16,31 @@
 
 namespace mlpack {
 
+/**
+ * Draw a bootstrap sample of numPoints points (that is, numPoints points
+ * sampled uniformly with replacement), as the indices of the sampled points.
+ * A point that is sampled more than once appears more than once in indices.
+ * This allows a model to be trained on the bootstrap sample without copying
+ * the dataset.
+ */
+inline void BootstrapIndices(const size_t numPoints, arma::uvec& indices)
+{
+  // Random sampling with replacement.
+  indices = randi<arma::uvec>(numPoints, arma::distr_param(0, numPoints - 1));
+}
+
+/**
+ * Draw the indices of a bootstrap sample of the given number of points from
+ * the given random stream.
+ */
+inline void BootstrapIndices(const size_t numPoints,
+                             arma::uvec& indices,
+                             RandomStream& stream)
+{
+  indices.set_size(numPoints);
+  stream.FillInt(indices, numPoints);
+}
+
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
  */
@@ -29,14 +55,8 @@ void Bootstrap(const MatType& dataset,
                LabelsType& bootstrapLabels,
                WeightsType& bootstrapWeights)
 {
-  bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
-  bootstrapLabels.set_size(labels.n_elem);
-  if (UseWeights)
-    bootstrapWeights.set_size(weights.n_elem);
-
-  // Random sampling with replacement.
-  arma::uvec indices = randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
+  arma::uvec indices;
+  BootstrapIndices(dataset.n_cols, indices);
   bootstrapDataset = dataset.cols(indices);
   bootstrapLabels = labels.cols(indices);
   if (UseWeights)
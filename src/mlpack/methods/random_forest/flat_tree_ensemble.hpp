@@ -0,0 +1,315 @@
+/**
+ * @file methods/random_forest/flat_tree_ensemble.hpp
+ *
+ * Definition of the FlatTreeEnsemble class, which stores trained decision
+ * trees, regression trees or random forests as flat arrays of nodes for fast
+ * prediction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_TREE_ENSEMBLE_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_TREE_ENSEMBLE_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include "random_forest.hpp"
+
+namespace mlpack {
+
+/**
+ * The FlatTreeEnsemble class holds a copy of a trained DecisionTree,
+ * DecisionTreeRegressor or RandomForest that is laid out for prediction
+ * instead of training.  The nodes of all the trees are stored in a handful of
+ * flat arrays (split dimension, threshold, first child), with the children of
+ * each node stored next to each other in breadth-first order, so that finding
+ * a child takes no pointer chasing and no dispatch on the split type: a point
+ * goes from a numeric node to its first child plus the result of comparing the
+ * point to the threshold, and from a categorical node to its first child plus
+ * an entry of a lookup table.
+ *
+ * When predicting many points at once, the points are handled in blocks, and
+ * all the points of a block are moved down each tree together.  The walks of
+ * the points of a block do not depend on each other, so the memory accesses of
+ * different points overlap instead of waiting on each other; blocks are
+ * handled in parallel with OpenMP.
+ *
+ * The predictions are the same as those of the model the ensemble was built
+ * from.  Numeric splits must be binary threshold splits (which is the case for
+ * BestBinaryNumericSplit, RandomBinaryNumericSplit and HistogramNumericSplit);
+ * any categorical split type is supported.  The ensemble can be serialized, so
+ * that it can be saved once and loaded by a prediction server.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses);
+ * FlatTreeEnsemble flat(rf);
+ * arma::Row<size_t> predictions;
+ * flat.Classify(testData, predictions);
+ * @endcode
+ */
+class FlatTreeEnsemble
+{
+ public:
+  /**
+   * Create an empty ensemble.  Classify() and Predict() will throw an
+   * exception until a model is loaded.
+   */
+  FlatTreeEnsemble();
+
+  /**
+   * Build a flat copy of the given trained classification tree.
+   *
+   * @param tree Trained decision tree.
+   */
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  FlatTreeEnsemble(const DecisionTree<FitnessFunction,
+                                      NumericSplitType,
+                                      CategoricalSplitType,
+                                      DimensionSelectionType,
+                                      NoRecursion>& tree);
+
+  /**
+   * Build a flat copy of the given trained regression tree.
+   *
+   * @param tree Trained regression tree.
+   */
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  FlatTreeEnsemble(const DecisionTreeRegressor<FitnessFunction,
+                                               NumericSplitType,
+                                               CategoricalSplitType,
+                                               DimensionSelectionType,
+                                               NoRecursion>& tree);
+
+  /**
+   * Build a flat copy of the given trained random forest.
+   *
+   * @param forest Trained random forest.
+   */
+  template<typename FitnessFunction,
+           typename DimensionSelectionType,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           bool UseBootstrap>
+  FlatTreeEnsemble(const RandomForest<FitnessFunction,
+                                      DimensionSelectionType,
+                                      NumericSplitType,
+                                      CategoricalSplitType,
+                                      UseBootstrap>& forest);
+
+  /**
+   * Predict the class of the given point.  The ensemble must have been built
+   * from a classification model.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and the probability of each class.
+   * The ensemble must have been built from a classification model.
+   *
+   * @param point Point to classify.
+   * @param prediction Will be set to the predicted class of the point.
+   * @param probabilities Will be set to the probability of each class.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of the given points.  The ensemble must have been
+   * built from a classification model.
+   *
+   * @param data Set of points to classify.
+   * @param predictions Will be filled with the predicted class of each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of the given points and the probabilities of each
+   * class for each point.  The ensemble must have been built from a
+   * classification model.
+   *
+   * @param data Set of points to classify.
+   * @param predictions Will be filled with the predicted class of each point.
+   * @param probabilities Will be filled with the class probabilities of each
+   *     point (one column per point).
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  /**
+   * Predict the response of the given point.  The ensemble must have been
+   * built from a regression model.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of the given points.  The ensemble must have been
+   * built from a regression model.
+   *
+   * @param data Set of points to predict.
+   * @param predictions Will be filled with the predicted response of each
+   *     point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Get the number of trees in the ensemble.
+  size_t NumTrees() const { return roots.size(); }
+  //! Get the total number of nodes (including leaves) in the ensemble.
+  size_t NumNodes() const { return dimensions.size(); }
+  //! Get whether the ensemble was built from a regression model.
+  bool Regression() const { return regression; }
+
+  /**
+   * Serialize the ensemble.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The split dimension stored for leaves.
+  static constexpr size_t LeafDimension = SIZE_MAX;
+  //! The category table offset stored for numeric nodes.
+  static constexpr size_t NumericNode = SIZE_MAX;
+  //! The number of points moved down each tree together by the batch
+  //! Classify() and Predict() functions.
+  static constexpr size_t BlockSize = 64;
+
+  /**
+   * Append the nodes of the given tree to the ensemble.
+   */
+  template<typename TreeType>
+  void AddTree(const TreeType& tree);
+
+  //! Get the split information of a non-leaf node of a classification tree.
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  static const arma::vec& SplitInfo(const DecisionTree<FitnessFunction,
+      NumericSplitType, CategoricalSplitType, DimensionSelectionType,
+      NoRecursion>& node) { return node.ClassProbabilities(); }
+
+  //! Get the split information of a non-leaf node of a regression tree.
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  static const arma::vec& SplitInfo(const DecisionTreeRegressor<
+      FitnessFunction, NumericSplitType, CategoricalSplitType,
+      DimensionSelectionType, NoRecursion>& node) { return node.SplitInfo(); }
+
+  //! Get the class probabilities of a leaf of a classification tree.
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  static arma::vec LeafValue(const DecisionTree<FitnessFunction,
+      NumericSplitType, CategoricalSplitType, DimensionSelectionType,
+      NoRecursion>& leaf) { return leaf.ClassProbabilities(); }
+
+  //! Get the prediction of a leaf of a regression tree.
+  template<typename FitnessFunction,
+           template<typename> class NumericSplitType,
+           template<typename> class CategoricalSplitType,
+           typename DimensionSelectionType,
+           bool NoRecursion>
+  static arma::vec LeafValue(const DecisionTreeRegressor<FitnessFunction,
+      NumericSplitType, CategoricalSplitType, DimensionSelectionType,
+      NoRecursion>& leaf)
+  {
+    // The prediction of a leaf does not depend on the point.
+    return arma::vec(1).fill(leaf.Predict(arma::vec()));
+  }
+
+  /**
+   * Return the index of the leaf of the given tree that the given point falls
+   * into.
+   */
+  template<typename VecType>
+  size_t FindLeaf(const size_t tree, const VecType& point) const;
+
+  /**
+   * Return the index of the child of the given node that a point with the
+   * given value in the split dimension goes to.
+   */
+  size_t NextNode(const size_t node, const double value) const
+  {
+    if (categoryOffsets[node] == NumericNode)
+      return children[node] + !(value <= thresholds[node]);
+    else
+      return children[node] + categoryChildren[categoryOffsets[node] +
+          (size_t) value];
+  }
+
+  /**
+   * Compute the average of the leaf values of all trees for the given point.
+   */
+  template<typename VecType>
+  void Outputs(const VecType& point, arma::vec& outputs) const;
+
+  /**
+   * Compute the average of the leaf values of all trees for each point (one
+   * column per point).
+   */
+  template<typename MatType>
+  void Outputs(const MatType& data, arma::mat& outputs) const;
+
+  //! Throw an exception if the ensemble cannot be used for the given task.
+  void CheckModel(const bool forRegression, const std::string& caller) const;
+
+  //! The node index of the root of each tree.
+  std::vector<size_t> roots;
+  //! The split dimension of each node, or LeafDimension for leaves.
+  std::vector<size_t> dimensions;
+  //! The threshold of each numeric node; a point goes to the second child if
+  //! its value is not less than or equal to the threshold.
+  std::vector<double> thresholds;
+  //! The index of the first child of each non-leaf node, or the offset of the
+  //! value of each leaf in leafValues.
+  std::vector<size_t> children;
+  //! For each categorical node, the offset of its lookup table in
+  //! categoryChildren; NumericNode for all other nodes.
+  std::vector<size_t> categoryOffsets;
+  //! The child (relative to the first child) of each category of each
+  //! categorical node.
+  std::vector<size_t> categoryChildren;
+  //! The values of each leaf (class probabilities or response), with the
+  //! numOutputs values of each leaf stored next to each other.
+  std::vector<double> leafValues;
+  //! The number of values of each leaf.
+  size_t numOutputs;
+  //! Whether the ensemble was built from a regression model.
+  bool regression;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_tree_ensemble_impl.hpp"
+
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file methods/random_forest/flat_tree_ensemble_impl.hpp
+ *
+ * Implementation of the FlatTreeEnsemble class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_TREE_ENSEMBLE_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_TREE_ENSEMBLE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_tree_ensemble.hpp"
+
+namespace mlpack {
+
+inline FlatTreeEnsemble::FlatTreeEnsemble() :
+    numOutputs(0),
+    regression(false)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+FlatTreeEnsemble::FlatTreeEnsemble(const DecisionTree<FitnessFunction,
+                                                      NumericSplitType,
+                                                      CategoricalSplitType,
+                                                      DimensionSelectionType,
+                                                      NoRecursion>& tree) :
+    numOutputs(tree.NumClasses()),
+    regression(false)
+{
+  AddTree(tree);
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         typename DimensionSelectionType,
+         bool NoRecursion>
+FlatTreeEnsemble::FlatTreeEnsemble(
+    const DecisionTreeRegressor<FitnessFunction,
+                                NumericSplitType,
+                                CategoricalSplitType,
+                                DimensionSelectionType,
+                                NoRecursion>& tree) :
+    numOutputs(1),
+    regression(true)
+{
+  AddTree(tree);
+}
+
+template<typename FitnessFunction,
+         typename DimensionSelectionType,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType,
+         bool UseBootstrap>
+FlatTreeEnsemble::FlatTreeEnsemble(const RandomForest<FitnessFunction,
+                                                      DimensionSelectionType,
+                                                      NumericSplitType,
+                                                      CategoricalSplitType,
+                                                      UseBootstrap>& forest) :
+    regression(false)
+{
+  if (forest.NumTrees() == 0)
+  {
+    throw std::invalid_argument("FlatTreeEnsemble::FlatTreeEnsemble(): the "
+        "random forest has no trees!");
+  }
+
+  numOutputs = forest.Tree(0).NumClasses();
+  for (size_t i = 0; i < forest.NumTrees(); ++i)
+    AddTree(forest.Tree(i));
+}
+
+template<typename VecType>
+size_t FlatTreeEnsemble::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+  return prediction;
+}
+
+template<typename VecType>
+void FlatTreeEnsemble::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  CheckModel(false, "FlatTreeEnsemble::Classify()");
+
+  Outputs(point, probabilities);
+  prediction = probabilities.index_max();
+}
+
+template<typename MatType>
+void FlatTreeEnsemble::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void FlatTreeEnsemble::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  CheckModel(false, "FlatTreeEnsemble::Classify()");
+
+  Outputs(data, probabilities);
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(probabilities, 0));
+}
+
+template<typename VecType>
+double FlatTreeEnsemble::Predict(const VecType& point) const
+{
+  CheckModel(true, "FlatTreeEnsemble::Predict()");
+
+  arma::vec output;
+  Outputs(point, output);
+  return output[0];
+}
+
+template<typename MatType>
+void FlatTreeEnsemble::Predict(const MatType& data,
+                               arma::rowvec& predictions) const
+{
+  CheckModel(true, "FlatTreeEnsemble::Predict()");
+
+  arma::mat outputs;
+  Outputs(data, outputs);
+  predictions = outputs.row(0);
+}
+
+template<typename Archive>
+void FlatTreeEnsemble::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(roots));
+  ar(CEREAL_NVP(dimensions));
+  ar(CEREAL_NVP(thresholds));
+  ar(CEREAL_NVP(children));
+  ar(CEREAL_NVP(categoryOffsets));
+  ar(CEREAL_NVP(categoryChildren));
+  ar(CEREAL_NVP(leafValues));
+  ar(CEREAL_NVP(numOutputs));
+  ar(CEREAL_NVP(regression));
+}
+
+template<typename TreeType>
+void FlatTreeEnsemble::AddTree(const TreeType& tree)
+{
+  // Lay the nodes out in breadth-first order, so that the children of each node
+  // are next to each other.  The node at index i of the queue is stored at
+  // index root + i.
+  const size_t root = dimensions.size();
+  roots.push_back(root);
+
+  std::vector<const TreeType*> queue(1, &tree);
+  for (size_t i = 0; i < queue.size(); ++i)
+  {
+    const TreeType& node = *queue[i];
+    if (node.NumChildren() == 0)
+    {
+      const arma::vec value = LeafValue(node);
+      if (value.n_elem != numOutputs)
+      {
+        throw std::invalid_argument("FlatTreeEnsemble::AddTree(): all leaves "
+            "must have the same number of classes!");
+      }
+
+      dimensions.push_back(LeafDimension);
+      thresholds.push_back(0.0);
+      children.push_back(leafValues.size());
+      categoryOffsets.push_back(NumericNode);
+      leafValues.insert(leafValues.end(), value.begin(), value.end());
+      continue;
+    }
+
+    const size_t dimension = node.SplitDimension();
+    dimensions.push_back(dimension);
+    children.push_back(root + queue.size());
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+      queue.push_back(&node.Child(c));
+
+    // We ask the node itself which child a point goes to, so that the split
+    // type does not have to be known here.
+    arma::vec point(dimension + 1, arma::fill::zeros);
+    if (node.SplitDimensionType() == data::Datatype::numeric)
+    {
+      // Make sure that this is a threshold split on the first element of the
+      // split information.
+      const double threshold = SplitInfo(node)[0];
+      point[dimension] = threshold;
+      const size_t left = node.CalculateDirection(point);
+      point[dimension] = std::nextafter(threshold, DBL_MAX);
+      const size_t right = node.CalculateDirection(point);
+      if (node.NumChildren() != 2 || left != 0 || right != 1)
+      {
+        throw std::invalid_argument("FlatTreeEnsemble::AddTree(): numeric "
+            "splits must be binary threshold splits!");
+      }
+
+      thresholds.push_back(threshold);
+      categoryOffsets.push_back(NumericNode);
+    }
+    else
+    {
+      // Store the child of each category.  Split types either have one child
+      // per category, or store something for each category in the split
+      // information.
+      const size_t numCategories = std::max(node.NumChildren(),
+          (size_t) SplitInfo(node).n_elem);
+      thresholds.push_back(0.0);
+      categoryOffsets.push_back(categoryChildren.size());
+      for (size_t c = 0; c < numCategories; ++c)
+      {
+        point[dimension] = c;
+        categoryChildren.push_back(node.CalculateDirection(point));
+      }
+    }
+  }
+}
+
+template<typename VecType>
+size_t FlatTreeEnsemble::FindLeaf(const size_t tree,
+                                  const VecType& point) const
+{
+  size_t node = roots[tree];
+  while (dimensions[node] != LeafDimension)
+    node = NextNode(node, point[dimensions[node]]);
+
+  return children[node];
+}
+
+template<typename VecType>
+void FlatTreeEnsemble::Outputs(const VecType& point, arma::vec& outputs) const
+{
+  outputs.zeros(numOutputs);
+  for (size_t t = 0; t < roots.size(); ++t)
+  {
+    const double* value = leafValues.data() + FindLeaf(t, point);
+    for (size_t k = 0; k < numOutputs; ++k)
+      outputs[k] += value[k];
+  }
+
+  outputs /= roots.size();
+}
+
+template<typename MatType>
+void FlatTreeEnsemble::Outputs(const MatType& data, arma::mat& outputs) const
+{
+  outputs.zeros(numOutputs, data.n_cols);
+
+  const size_t numBlocks = (data.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for num_threads(Parallel::Threads())
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t count = std::min(BlockSize, (size_t) data.n_cols - begin);
+
+    size_t nodes[BlockSize];
+    for (size_t t = 0; t < roots.size(); ++t)
+    {
+      for (size_t i = 0; i < count; ++i)
+        nodes[i] = roots[t];
+
+      // Take one step down the tree for every point of the block that is not
+      // yet at a leaf, until all of them are.
+      bool moved = true;
+      while (moved)
+      {
+        moved = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+          const size_t node = nodes[i];
+          if (dimensions[node] == LeafDimension)
+            continue;
+
+          nodes[i] = NextNode(node, data(dimensions[node], begin + i));
+          moved = true;
+        }
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        const double* value = leafValues.data() + children[nodes[i]];
+        for (size_t k = 0; k < numOutputs; ++k)
+          outputs(k, begin + i) += value[k];
+      }
+    }
+  }
+
+  outputs /= roots.size();
+}
+
+inline void FlatTreeEnsemble::CheckModel(const bool forRegression,
+                                         const std::string& caller) const
+{
+  if (roots.size() == 0)
+  {
+    throw std::invalid_argument(caller + ": no model loaded!");
+  }
+  else if (forRegression && !regression)
+  {
+    throw std::invalid_argument(caller + ": the ensemble was built from a "
+        "classification model!");
+  }
+  else if (!forRegression && regression)
+  {
+    throw std::invalid_argument(caller + ": the ensemble was built from a "
+        "regression model!");
+  }
+}
+
+} // namespace mlpack
+
+#endif
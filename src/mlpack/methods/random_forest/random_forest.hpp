@@ -33,6 +33,9 @@ namespace mlpack {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * As with DecisionTree, the forest can be trained on and used to classify
+ * sparse (arma::sp_mat) as well as dense data.
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
@@ -359,11 +362,70 @@ class RandomForest
   //! Get the number of trees in the forest.
   size_t NumTrees() const { return trees.size(); }
 
+  /**
+   * Get the out-of-bag error of the trees trained by the last call to Train():
+   * the fraction of the training points that were not in the bootstrap sample
+   * of at least one tree, and that are misclassified by the vote of the trees
+   * whose sample they were not in.  This is DBL_MAX if no point was left out
+   * of every sample (for instance if UseBootstrap is false).
+   */
+  double OOBError() const { return oobError; }
+
+  //! Get whether the permutation importance of each feature is computed by
+  //! Train().
+  bool ComputeImportance() const { return computeImportance; }
+  //! Modify whether the permutation importance of each feature is computed by
+  //! Train().  This requires UseBootstrap.
+  bool& ComputeImportance() { return computeImportance; }
+
+  /**
+   * Get the permutation importance of each feature, computed by the last call
+   * to Train() if ComputeImportance() was set: the decrease in out-of-bag
+   * accuracy of each tree when the values of the feature are permuted among
+   * its out-of-bag points, averaged over the trees trained by that call.
+   */
+  const arma::vec& FeatureImportance() const { return featureImportance; }
+
+  /**
+   * Add the trees of the given forest to this forest.  This can be used to
+   * train a forest on data that is spread over several machines: each machine
+   * trains some of the trees on its own shard of the data (with a different
+   * random seed), the forests are serialized and gathered, and then merged
+   * into one forest that votes with all of the trees.
+   *
+   * @code
+   * // On each machine, with a different seed.
+   * RandomSeed(machineSeed);
+   * RandomForest<> rf(localData, localLabels, numClasses, 20);
+   * data::Save("forest-" + std::to_string(machine) + ".bin", "forest", rf);
+   *
+   * // Then, on one machine.
+   * RandomForest<> forest, shardForest;
+   * for (size_t i = 0; i < numMachines; ++i)
+   * {
+   *   data::Load("forest-" + std::to_string(i) + ".bin", "forest",
+   *       shardForest);
+   *   forest.Merge(shardForest);
+   * }
+   * @endcode
+   *
+   * The average gain and the feature importances are averaged over all of the
+   * trees.  The out-of-bag error of each forest is measured on its own
+   * training data, so the out-of-bag error of the merged forest is the average
+   * of the errors of the forests, weighted by their numbers of trees; it is
+   * DBL_MAX if the error of either forest is unknown.
+   *
+   * The forests must have been trained for the same number of classes.
+   *
+   * @param other Forest to take the trees of.
+   */
+  void Merge(const RandomForest& other);
+
   /**
    * Serialize the random forest.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
   /**
@@ -401,11 +463,42 @@ class RandomForest
                DimensionSelectionType& dimensionSelector,
                const bool warmStart = false);
 
+  /**
+   * Classify the points that are not in the bootstrap sample of the given
+   * tree, add its votes to oobVotes, and, if computeImportance is set, add
+   * the decrease in accuracy of the tree when each feature is permuted to
+   * importance.  This is called in parallel for different trees.
+   *
+   * @param data Dataset the tree was trained on.
+   * @param labels Labels for the dataset.
+   * @param indices Indices of the points in the bootstrap sample of the tree.
+   * @param tree Trained tree.
+   * @param oobVotes Number of votes for each class (row) of each point
+   *     (column).
+   * @param importance Sum of the accuracy decreases of each feature.
+   * @param stream Random stream of the tree, used to permute the features.
+   */
+  template<typename MatType>
+  void OutOfBagEvaluate(const MatType& data,
+                        const arma::Row<size_t>& labels,
+                        const arma::uvec& indices,
+                        const DecisionTreeType& tree,
+                        arma::Mat<size_t>& oobVotes,
+                        arma::vec& importance,
+                        RandomStream& stream) const;
+
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
 
   //! The average gain of the forest.
   double avgGain;
+
+  //! The out-of-bag error of the trees trained by the last call to Train().
+  double oobError;
+  //! Whether or not Train() computes the permutation importance of features.
+  bool computeImportance;
+  //! The permutation importance of each feature.
+  arma::vec featureImportance;
 };
 
 /**
@@ -442,6 +535,14 @@ using ExtraTrees = RandomForest<FitnessFunction,
 
 } // namespace mlpack
 
+CEREAL_TEMPLATE_CLASS_VERSION((typename FitnessFunction,
+                               typename DimensionSelectionType,
+                               template<typename> class NumericSplitType,
+                               template<typename> class CategoricalSplitType,
+                               bool UseBootstrap),
+    (mlpack::RandomForest<FitnessFunction, DimensionSelectionType,
+        NumericSplitType, CategoricalSplitType, UseBootstrap>), (1));
+
 // Include implementation.
 #include "random_forest_impl.hpp"
 
@@ -31,7 +31,9 @@ RandomForest<
     CategoricalSplitType,
     UseBootstrap
 >::RandomForest() :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(DBL_MAX),
+    computeImportance(false)
 {
   // Nothing to do here.
 }
@@ -58,7 +60,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(DBL_MAX),
+    computeImportance(false)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
@@ -91,7 +95,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector):
-                    avgGain(0.0)
+                    avgGain(0.0),
+                    oobError(DBL_MAX),
+                    computeImportance(false)
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
@@ -123,7 +129,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(DBL_MAX),
+    computeImportance(false)
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
@@ -156,7 +164,9 @@ RandomForest<
                 const double minimumGainSplit,
                 const size_t maximumDepth,
                 DimensionSelectionType dimensionSelector) :
-    avgGain(0.0)
+    avgGain(0.0),
+    oobError(DBL_MAX),
+    computeImportance(false)
 {
   // Pass off work to the Train() method.
   Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
@@ -391,7 +401,7 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
+  #pragma omp parallel for num_threads(Parallel::Threads())
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     predictions[i] = Classify(data.col(i));
@@ -428,7 +438,7 @@ void RandomForest<
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
+  #pragma omp parallel for num_threads(Parallel::Threads())
   for (size_t i = 0; i < data.n_cols; ++i)
   {
     arma::vec probs = probabilities.unsafe_col(i);
@@ -436,6 +446,64 @@ void RandomForest<
   }
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Merge(const RandomForest& other)
+{
+  if (other.trees.empty())
+    return;
+
+  if (trees.empty())
+  {
+    *this = other;
+    return;
+  }
+
+  if (trees[0].NumClasses() != other.trees[0].NumClasses())
+  {
+    std::ostringstream oss;
+    oss << "RandomForest::Merge(): cannot merge a forest with "
+        << other.trees[0].NumClasses() << " classes into a forest with "
+        << trees[0].NumClasses() << " classes!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const double oldWeight = double(trees.size()) /
+      (trees.size() + other.trees.size());
+  const double otherWeight = 1.0 - oldWeight;
+
+  avgGain = oldWeight * avgGain + otherWeight * other.avgGain;
+  if (oobError == DBL_MAX || other.oobError == DBL_MAX)
+    oobError = DBL_MAX;
+  else
+    oobError = oldWeight * oobError + otherWeight * other.oobError;
+
+  // The importances can only be combined if both forests computed them.
+  if (featureImportance.n_elem == other.featureImportance.n_elem &&
+      !featureImportance.is_empty())
+  {
+    featureImportance = oldWeight * featureImportance +
+        otherWeight * other.featureImportance;
+  }
+  else
+  {
+    featureImportance.clear();
+  }
+
+  trees.insert(trees.end(), other.trees.begin(), other.trees.end());
+}
+
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
@@ -450,7 +518,7 @@ void RandomForest<
     NumericSplitType,
     CategoricalSplitType,
     UseBootstrap
->::serialize(Archive& ar, const uint32_t /* version */)
+>::serialize(Archive& ar, const uint32_t version)
 {
   size_t numTrees;
   if (cereal::is_loading<Archive>())
@@ -466,6 +534,20 @@ void RandomForest<
 
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
+
+  // Version 1 added the out-of-bag statistics.
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(oobError));
+    ar(CEREAL_NVP(computeImportance));
+    ar(CEREAL_NVP(featureImportance));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    oobError = DBL_MAX;
+    computeImportance = false;
+    featureImportance.clear();
+  }
 }
 
 template<
@@ -494,6 +576,10 @@ double RandomForest<
          DimensionSelectionType& dimensionSelector,
          const bool warmStart)
 {
+  util::CheckSameSizes(dataset, labels, "RandomForest::Train()");
+  if (UseWeights)
+    util::CheckSameSizes(dataset, weights, "RandomForest::Train()", "weights");
+
   // Reset the forest if we are not doing a warm-start.
   if (!warmStart)
     trees.clear();
@@ -503,89 +589,202 @@ double RandomForest<
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
+  // The votes of each tree for the points outside of its bootstrap sample, and
+  // the decrease in accuracy of each tree when each feature is permuted.
+  arma::Mat<size_t> oobVotes;
+  arma::vec importance;
+  if (UseBootstrap)
+  {
+    oobVotes.zeros(numClasses, dataset.n_cols);
+    if (computeImportance)
+      importance.zeros(dataset.n_rows);
+  }
+
+  // Every tree draws its random numbers from its own stream, so that the
+  // forest is the same no matter how many threads train it, or in which order.
+  const uint64_t seed = RandomStreamSeed();
+
   // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
+  #pragma omp parallel for reduction( + : totalGain) \
+      num_threads(Parallel::Threads())
   for (size_t i = 0; i < numTrees; ++i)
   {
-    // NOTE: this is a hacky workaround for older versions of Armadillo that did
-    // not (by default) set a different seed for each RNG.  We simply manually
-    // set the RNG seed for each individual thread.  However, if users have
-    // specifically set the RNG seed for Armadillo, this could break their code.
-    // So we hide it behind an (undocumented except for here) ifndef so that
-    // this support can be disabled if desired...
-    #undef MLPACK_ARMA_VERSION
-    #define MLPACK_ARMA_VERSION (ARMA_VERSION_MAJOR * 100000 + \
-                                 ARMA_VERSION_MINOR *    100 + \
-                                 ARMA_VERSION_PATCH)
-    #if (MLPACK_ARMA_VERSION < 1200602) // 12.6.2
-      #ifndef MLPACK_DONT_OVERWRITE_ARMA_RNG_SEEDS
-      // Note that each thread has its own differently-seeded RNG, so this will
-      // result in a different seed for each thread's Armadillo RNG.
-      arma::arma_rng::set_seed(RandGen()());
-      #endif
-    #endif
-
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
-    arma::rowvec bootstrapWeights;
+    RandomStream stream(seed, oldNumTrees + i);
+
+    // The random dimension selection of the tree uses RandGen(), so seed the
+    // thread's generator from the stream while the tree is trained.
+    const std::mt19937 threadRandGen = RandGen();
+    RandGen().seed(stream());
+
+    // Each tree is trained on indices into the dataset, so that the dataset
+    // is never copied; only the labels and weights of the sample are.
+    arma::uvec indices;
+    arma::Row<size_t> treeLabels;
+    arma::rowvec treeWeights;
     if (UseBootstrap)
     {
-      Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-          bootstrapLabels, bootstrapWeights);
+      BootstrapIndices(dataset.n_cols, indices, stream);
+      treeLabels = labels.cols(indices);
+      if (UseWeights)
+        treeWeights = weights.cols(indices);
+    }
+    else
+    {
+      indices = arma::linspace<arma::uvec>(0, dataset.n_cols - 1,
+          dataset.n_cols);
+      treeLabels = labels;
+      if (UseWeights)
+        treeWeights = weights;
     }
 
-    if (UseWeights)
+    DimensionSelectionType treeDimensionSelector(dimensionSelector);
+    treeDimensionSelector.Dimensions() = dataset.n_rows;
+
+    if (UseDatasetInfo)
     {
-      if (UseDatasetInfo)
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, weights, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector);
-      }
-      else
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, bootstrapWeights, minimumLeafSize,
-                minimumGainSplit, maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                weights, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
+      totalGain += trees[oldNumTrees + i].template Train<UseWeights>(dataset,
+          indices, 0, indices.n_elem, datasetInfo, treeLabels, numClasses,
+          treeWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
+          treeDimensionSelector);
     }
     else
     {
-      if (UseDatasetInfo)
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, datasetInfo,
-                bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-                maximumDepth, dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, datasetInfo, labels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
-      else
-      {
-        totalGain += UseBootstrap ?
-            trees[oldNumTrees + i].Train(bootstrapDataset, bootstrapLabels,
-                numClasses, minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector) :
-            trees[oldNumTrees + i].Train(dataset, labels, numClasses,
-                minimumLeafSize, minimumGainSplit, maximumDepth,
-                dimensionSelector);
-      }
+      totalGain += trees[oldNumTrees + i].template Train<UseWeights>(dataset,
+          indices, 0, indices.n_elem, treeLabels, numClasses, treeWeights,
+          minimumLeafSize, minimumGainSplit, maximumDepth,
+          treeDimensionSelector);
     }
+
+    // The tree is evaluated by the same thread that trained it, while its
+    // bootstrap sample is still at hand.
+    if (UseBootstrap)
+    {
+      OutOfBagEvaluate(dataset, labels, indices, trees[oldNumTrees + i],
+          oobVotes, importance, stream);
+    }
+
+    RandGen() = threadRandGen;
+  }
+
+  // Each point is classified by the vote of the trees it was not used to
+  // train.
+  size_t oobPoints = 0;
+  size_t oobErrors = 0;
+  for (size_t i = 0; i < oobVotes.n_cols; ++i)
+  {
+    if (arma::accu(oobVotes.col(i)) == 0)
+      continue;
+
+    ++oobPoints;
+    if (oobVotes.col(i).index_max() != labels[i])
+      ++oobErrors;
   }
+  oobError = (oobPoints == 0) ? DBL_MAX : double(oobErrors) / oobPoints;
+
+  if (UseBootstrap && computeImportance)
+    featureImportance = importance / numTrees;
+  else
+    featureImportance.clear();
 
   avgGain = totalGain / trees.size();
   return avgGain;
 }
 
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename MatType>
+void RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::OutOfBagEvaluate(const MatType& data,
+                    const arma::Row<size_t>& labels,
+                    const arma::uvec& indices,
+                    const DecisionTreeType& tree,
+                    arma::Mat<size_t>& oobVotes,
+                    arma::vec& importance,
+                    RandomStream& stream) const
+{
+  // Find the points that are not in the bootstrap sample.
+  std::vector<bool> inSample(data.n_cols, false);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    inSample[indices[i]] = true;
+
+  std::vector<arma::uword> oobIndices;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (!inSample[i])
+      oobIndices.push_back(i);
+  }
+
+  if (oobIndices.empty())
+    return;
+
+  size_t correct = 0;
+  for (size_t j = 0; j < oobIndices.size(); ++j)
+  {
+    const size_t prediction = tree.Classify(data.col(oobIndices[j]));
+    if (prediction == labels[oobIndices[j]])
+      ++correct;
+
+    #pragma omp atomic
+    oobVotes(prediction, oobIndices[j])++;
+  }
+
+  if (!computeImportance)
+    return;
+
+  // Permuting a feature that the tree does not split on changes nothing, so
+  // only the features that the tree uses need to be checked.
+  std::vector<bool> usedDimensions(data.n_rows, false);
+  std::vector<const DecisionTreeType*> stack(1, &tree);
+  while (!stack.empty())
+  {
+    const DecisionTreeType* node = stack.back();
+    stack.pop_back();
+    if (node->NumChildren() == 0)
+      continue;
+
+    usedDimensions[node->SplitDimension()] = true;
+    for (size_t c = 0; c < node->NumChildren(); ++c)
+      stack.push_back(&node->Child(c));
+  }
+
+  const arma::uvec oob(oobIndices);
+  arma::Col<typename MatType::elem_type> point;
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    if (!usedDimensions[d])
+      continue;
+
+    // Shuffle with the tree's stream (Fisher-Yates).
+    arma::uvec permutation(oob);
+    for (size_t j = permutation.n_elem - 1; j > 0; --j)
+      std::swap(permutation[j], permutation[stream.RandInt(j + 1)]);
+
+    size_t permutedCorrect = 0;
+    for (size_t j = 0; j < oob.n_elem; ++j)
+    {
+      point = data.col(oob[j]);
+      point[d] = data(d, permutation[j]);
+      if (tree.Classify(point) == labels[oob[j]])
+        ++permutedCorrect;
+    }
+
+    const double decrease = (double(correct) - double(permutedCorrect)) /
+        oob.n_elem;
+    #pragma omp atomic
+    importance[d] += decrease;
+  }
+}
+
 } // namespace mlpack
 
 #endif
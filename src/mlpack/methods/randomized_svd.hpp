@@ -12,5 +12,6 @@
 #define MLPACK_RANDOMIZED_SVD_HPP
 
 #include "randomized_svd/randomized_svd.hpp"
+#include "randomized_svd/streaming_randomized_svd.hpp"
 
 #endif
@@ -0,0 +1,184 @@
+/**
+ * @file methods/randomized_svd/streaming_randomized_svd.hpp
+ *
+ * A single-pass, sketch-based randomized SVD, for matrices that are too large
+ * to fit in memory and are read one block of columns at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Streaming randomized SVD computes an approximate truncated SVD of an m x n
+ * matrix A in a single pass over its columns, which can be given in blocks of
+ * any size with Update().  Two linear sketches are kept:
+ *
+ *  - the range sketch Y = A Omega (m x k), where the rows of the Gaussian test
+ *    matrix Omega are drawn when their columns are seen, and never stored;
+ *  - the co-range sketch W = Psi A (l x n), with a fixed Gaussian l x m matrix
+ *    Psi.
+ *
+ * Factorize() then takes Q as an orthonormal basis of Y, solves
+ * (Psi Q) C = W in the least squares sense, and computes the SVD of the small
+ * k x n matrix C, so that A ~= Q C.  The default sizes are k = rank +
+ * oversampling and l = 2k + 1.  The memory used is O((k + l) m + l n): the
+ * columns themselves are never stored.
+ *
+ * Optionally, the SVD of the centered matrix A - mu 1^T is computed, where mu
+ * is the mean of the columns; since the sketches are linear, they are corrected
+ * at the end, and centering also needs only one pass.
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @article{tropp2017practical,
+ *   title={Practical sketching algorithms for low-rank matrix approximation},
+ *   author={Tropp, J.A. and Yurtsever, A. and Udell, M. and Cevher, V.},
+ *   journal={SIAM Journal on Matrix Analysis and Applications},
+ *   volume={38},
+ *   number={4},
+ *   pages={1454--1485},
+ *   year={2017}
+ * }
+ * @endcode
+ *
+ * An example of how to use the interface is shown below:
+ *
+ * @code
+ * // Compute the 100 largest singular values and vectors of the centered data,
+ * // reading it one block of columns at a time.
+ * StreamingRandomizedSVD<> svd(100, 10, true);
+ * for (size_t i = 0; i < numBlocks; ++i)
+ * {
+ *   arma::mat block;
+ *   data::Load("block" + std::to_string(i) + ".csv", block, true);
+ *   svd.Update(block);
+ * }
+ *
+ * arma::mat u, v;
+ * arma::vec s;
+ * svd.Factorize(u, s, v);
+ * @endcode
+ *
+ * @tparam MatType Type of dense matrix to use for the sketches and the result.
+ */
+template<typename MatType = arma::mat>
+class StreamingRandomizedSVD
+{
+ public:
+  //! The type of vector used for the column sums.
+  typedef typename GetColType<MatType>::type ColType;
+
+  /**
+   * Create the object, with empty sketches.
+   *
+   * @param rank Rank of the approximation.
+   * @param oversampling Number of extra dimensions of the range sketch.
+   * @param center Whether to compute the SVD of the centered matrix.
+   * @param blockSize Number of columns per block for Apply().
+   */
+  StreamingRandomizedSVD(const size_t rank = 10,
+                         const size_t oversampling = 10,
+                         const bool center = false,
+                         const size_t blockSize = 4096);
+
+  /**
+   * Add the given columns to the sketches.  All blocks must have the same
+   * number of rows; the sketch sizes are set by the first block.
+   *
+   * @param block Columns to add (dense or sparse).
+   */
+  template<typename InMatType>
+  void Update(const InMatType& block);
+
+  /**
+   * Compute the SVD from the current sketches.  The right singular vectors
+   * have one row per column given to Update(), in order.  More columns can
+   * still be added afterwards.
+   *
+   * @param u Matrix to store the left singular vectors in.
+   * @param s Vector to store the singular values in.
+   * @param v Matrix to store the right singular vectors in.
+   */
+  template<typename VecType>
+  void Factorize(MatType& u, VecType& s, MatType& v) const;
+
+  /**
+   * Compute the SVD of the given matrix, in one pass over blocks of
+   * BlockSize() columns.  Any columns previously given to Update() are
+   * discarded.
+   *
+   * @param data Matrix to decompose.
+   * @param u Matrix to store the left singular vectors in.
+   * @param s Vector to store the singular values in.
+   * @param v Matrix to store the right singular vectors in.
+   */
+  template<typename InMatType, typename VecType>
+  void Apply(const InMatType& data, MatType& u, VecType& s, MatType& v);
+
+  //! Discard all columns given to Update().
+  void Reset();
+
+  //! Get the number of columns given to Update().
+  size_t NumColumns() const { return numColumns; }
+
+  //! Get the rank of the approximation.
+  size_t Rank() const { return rank; }
+  //! Modify the rank of the approximation.  The sketch sizes only change on
+  //! the first call to Update() after Reset().
+  size_t& Rank() { return rank; }
+
+  //! Get the oversampling of the range sketch.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the oversampling of the range sketch.  The sketch sizes only change
+  //! on the first call to Update() after Reset().
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get whether the SVD of the centered matrix is computed.
+  bool Center() const { return center; }
+  //! Modify whether the SVD of the centered matrix is computed.
+  bool& Center() { return center; }
+
+  //! Get the number of columns per block for Apply().
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns per block for Apply().
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Rank of the approximation.
+  size_t rank;
+  //! Number of extra dimensions of the range sketch.
+  size_t oversampling;
+  //! Whether the SVD of the centered matrix is computed.
+  bool center;
+  //! Number of columns per block for Apply().
+  size_t blockSize;
+
+  //! Number of columns given to Update().
+  size_t numColumns;
+  //! The range sketch Y = A Omega.
+  MatType range;
+  //! The co-range test matrix Psi.
+  MatType psi;
+  //! The co-range sketch W = Psi A, one block of columns per call to Update().
+  std::vector<MatType> coRange;
+  //! Sum of the columns given to Update().
+  ColType columnSum;
+  //! Sum of the rows of Omega, 1^T Omega, for centering.
+  MatType omegaSum;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_randomized_svd_impl.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file methods/randomized_svd/streaming_randomized_svd_impl.hpp
+ *
+ * Implementation of the StreamingRandomizedSVD class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_IMPL_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_STREAMING_RANDOMIZED_SVD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_randomized_svd.hpp"
+
+namespace mlpack {
+
+template<typename MatType>
+StreamingRandomizedSVD<MatType>::StreamingRandomizedSVD(
+    const size_t rank,
+    const size_t oversampling,
+    const bool center,
+    const size_t blockSize) :
+    rank(rank),
+    oversampling(oversampling),
+    center(center),
+    blockSize(blockSize),
+    numColumns(0)
+{
+  /* Nothing to do here */
+}
+
+template<typename MatType>
+template<typename InMatType>
+void StreamingRandomizedSVD<MatType>::Update(const InMatType& block)
+{
+  if (numColumns == 0)
+  {
+    if (rank == 0)
+    {
+      throw std::invalid_argument("StreamingRandomizedSVD::Update(): rank "
+          "must be positive!");
+    }
+
+    // The sketches cannot be larger than the dimension of the columns.
+    const size_t k = std::min(rank + oversampling, (size_t) block.n_rows);
+    const size_t l = std::min(2 * k + 1, (size_t) block.n_rows);
+    range.zeros(block.n_rows, k);
+    psi.randn(l, block.n_rows);
+    columnSum.zeros(block.n_rows);
+    omegaSum.zeros(1, k);
+    coRange.clear();
+  }
+  else if (block.n_rows != range.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "StreamingRandomizedSVD::Update(): block has " << block.n_rows
+        << " rows, but previous blocks had " << range.n_rows << " rows!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (block.n_cols == 0)
+    return;
+
+  // The rows of Omega for these columns are only needed here.
+  MatType omega;
+  omega.randn(block.n_cols, range.n_cols);
+  range += block * omega;
+  omegaSum += arma::sum(omega, 0);
+
+  coRange.push_back(psi * block);
+  columnSum += ColType(arma::sum(block, 1));
+  numColumns += block.n_cols;
+}
+
+template<typename MatType>
+template<typename VecType>
+void StreamingRandomizedSVD<MatType>::Factorize(MatType& u,
+                                                VecType& s,
+                                                MatType& v) const
+{
+  if (numColumns == 0)
+  {
+    throw std::logic_error("StreamingRandomizedSVD::Factorize(): no columns "
+        "have been given to Update()!");
+  }
+
+  // With centering, Y = (A - mu 1^T) Omega = A Omega - mu (1^T Omega), and
+  // W = Psi A - (Psi mu) 1^T.
+  MatType y = range;
+  ColType mean;
+  if (center)
+  {
+    mean = columnSum / numColumns;
+    y -= mean * omegaSum;
+  }
+
+  MatType q, r;
+  arma::qr_econ(q, r, y);
+
+  // The least squares solution of (Psi Q) C = W is computed one block of
+  // columns at a time.
+  const MatType psiQInv = arma::pinv(psi * q);
+  ColType correction;
+  if (center)
+    correction = psiQInv * (psi * mean);
+
+  MatType c(q.n_cols, numColumns);
+  size_t col = 0;
+  for (size_t b = 0; b < coRange.size(); ++b)
+  {
+    const size_t n = coRange[b].n_cols;
+    c.cols(col, col + n - 1) = psiQInv * coRange[b];
+    if (center)
+      c.cols(col, col + n - 1).each_col() -= correction;
+    col += n;
+  }
+
+  MatType uc;
+  arma::svd_econ(uc, s, v, c);
+
+  const size_t outRank = std::min(rank, (size_t) s.n_elem);
+  u = q * uc.head_cols(outRank);
+  s = s.head(outRank);
+  v = v.head_cols(outRank);
+}
+
+template<typename MatType>
+template<typename InMatType, typename VecType>
+void StreamingRandomizedSVD<MatType>::Apply(const InMatType& data,
+                                            MatType& u,
+                                            VecType& s,
+                                            MatType& v)
+{
+  if (blockSize == 0)
+  {
+    throw std::invalid_argument("StreamingRandomizedSVD::Apply(): block size "
+        "must be positive!");
+  }
+
+  Reset();
+  for (size_t i = 0; i < data.n_cols; i += blockSize)
+    Update(data.cols(i, std::min(i + blockSize, (size_t) data.n_cols) - 1));
+
+  Factorize(u, s, v);
+}
+
+template<typename MatType>
+void StreamingRandomizedSVD<MatType>::Reset()
+{
+  numColumns = 0;
+  range.reset();
+  psi.reset();
+  coRange.clear();
+  columnSum.reset();
+  omegaSum.reset();
+}
+
+} // namespace mlpack
+
+#endif
@@ -15,8 +15,11 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/distances/lmetric.hpp>
+#include <mlpack/core/tree/address.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
 #include "range_search_stat.hpp"
+#include "range_search_results.hpp"
 
 namespace mlpack {
 
@@ -35,12 +38,16 @@ class LeafSizeRSWrapper;
  * @tparam DistanceType Metric to use for range search calculations.
  * @tparam MatType Type of data to use.
  * @tparam TreeType Type of tree to use; must satisfy the TreeType policy API.
+ * @tparam CountersType The policy that collects traversal statistics during
+ *     tree-based searches (see TraversalCounters); by default, nothing is
+ *     collected.
  */
 template<typename DistanceType = EuclideanDistance,
          typename MatType = arma::mat,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType = KDTree>
+                  typename TreeMatType> class TreeType = KDTree,
+         typename CountersType = NullTraversalCounters>
 class RangeSearch
 {
  public:
@@ -271,6 +278,71 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<ElemType>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, and store the results in compressed sparse row (CSR) form: the
+   * indices and distances of the reference points in range of query point i
+   * are neighbors[j] and distances[j], for offsets[i] <= j < offsets[i + 1].
+   * The results of each query point are not sorted in any particular order.
+   *
+   * This gives the same results as the overload that returns one vector per
+   * query point, but each thread appends its results to its own buffer, so no
+   * memory is allocated per query point; this is much faster when there are
+   * many results.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Will hold the position of the first result of each query
+   *      point, and the total number of results at the end (so it has one more
+   *      element than there are query points).
+   * @param neighbors Will hold the indices of the reference points in range.
+   * @param distances Will hold the distances of the reference points in range.
+   */
+  void Search(const MatType& querySet,
+              const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, and store the results in compressed sparse row (CSR) form; see the
+   * overload above.  A point is not returned in its own range.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Will hold the position of the first result of each point,
+   *      and the total number of results at the end.
+   * @param neighbors Will hold the indices of the reference points in range.
+   * @param distances Will hold the distances of the reference points in range.
+   */
+  void Search(const RangeType<ElemType>& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances);
+
+  /**
+   * Count the reference points in the given range of each point in the query
+   * set, without storing them.  The points of reference nodes that are entirely
+   * in range are counted without computing their distances.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of reference points in range of each
+   *      query point.
+   */
+  void Count(const MatType& querySet,
+             const RangeType<ElemType>& range,
+             arma::Col<size_t>& counts);
+
+  /**
+   * Count the points in the given range of each point in the reference set,
+   * without storing them.  A point is not counted in its own range.
+   *
+   * @param range Range of distances in which to search.
+   * @param counts Will hold the number of points in range of each point.
+   */
+  void Count(const RangeType<ElemType>& range, arma::Col<size_t>& counts);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -285,6 +357,8 @@ class RangeSearch
   size_t BaseCases() const { return baseCases; }
   //! Get the number of scores during the last search.
   size_t Scores() const { return scores; }
+  //! Get the traversal statistics of the last search.
+  const CountersType& Counters() const { return counters; }
 
   //! Serialize the model.
   template<typename Archive>
@@ -320,6 +394,55 @@ class RangeSearch
   size_t baseCases;
   //! The total number of scores during the last search.
   size_t scores;
+  //! The traversal statistics of the last search.
+  CountersType counters;
+
+  /**
+   * Perform a single-tree search for every query point, splitting the query
+   * points across OpenMP threads (unless the tree has self-children, in which
+   * case the search is serial).  Each thread uses its own copy of the rules
+   * and its own traverser; the base cases and scores of every thread are
+   * added to the totals held by this object.
+   *
+   * @param rules Rules to search with.
+   * @param querySet Set of query points.
+   * @param orderQueries If true, visit the query points in the order of the
+   *     Z-order space-filling curve, so that consecutive query points tend to
+   *     visit the same reference nodes.
+   */
+  template<typename RuleType>
+  void SingleTreeSearch(RuleType& rules,
+                        const MatType& querySet,
+                        const bool orderQueries);
+
+  /**
+   * Run a search with the given results policy in the configured mode, and
+   * return the policy after the search.  The query indices that the policy sees
+   * are not always those of the query set; if they are not, queryMapping is set
+   * to the original index of each of them (otherwise it is emptied).  The
+   * reference indices must be mapped if a tree was built on the reference set
+   * and the tree rearranges the dataset.
+   *
+   * @param querySet Set of query points, or NULL to search the reference set
+   *      for itself.
+   * @param range Range of distances in which to search.
+   * @param results Results policy to search with.
+   * @param queryMapping Will hold the mapping of query indices, if needed.
+   */
+  template<typename ResultsType>
+  ResultsType SearchWithResults(const MatType* querySet,
+                                const RangeType<ElemType>& range,
+                                const ResultsType& results,
+                                std::vector<size_t>& queryMapping);
+
+  //! Group the given buffered results by query point into CSR form, mapping
+  //! their indices back to the original ones.
+  void BuffersToCSR(const RangeSearchBufferResults<ElemType>& results,
+                    const size_t numQueries,
+                    const std::vector<size_t>& queryMapping,
+                    arma::Col<size_t>& offsets,
+                    arma::Col<size_t>& neighbors,
+                    arma::Col<ElemType>& distances) const;
 
   //! For access to mappings when building models.
   friend class LeafSizeRSWrapper<TreeType>;
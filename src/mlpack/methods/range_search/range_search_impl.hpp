@@ -24,8 +24,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::RangeSearch(
     MatType referenceSet,
     const bool naive,
     const bool singleMode,
@@ -48,8 +49,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::RangeSearch(
     Tree* referenceTree,
     const bool singleMode,
     const DistanceType distance) :
@@ -69,8 +71,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::RangeSearch(
     const bool naive,
     const bool singleMode,
     const DistanceType distance) :
@@ -97,8 +100,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::RangeSearch(
     const RangeSearch& other) :
     oldFromNewReferences(other.oldFromNewReferences),
     referenceTree(other.referenceTree ? new Tree(*other.referenceTree) : NULL),
@@ -109,7 +113,8 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(
     singleMode(other.singleMode),
     distance(other.distance),
     baseCases(other.baseCases),
-    scores(other.scores)
+    scores(other.scores),
+    counters(other.counters)
 {
   // Nothing to do.
 }
@@ -118,8 +123,10 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::RangeSearch(
+    RangeSearch&& other) :
     oldFromNewReferences(std::move(other.oldFromNewReferences)),
     referenceTree(other.referenceTree),
     referenceSet(other.referenceSet),
@@ -128,7 +135,8 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
     singleMode(other.singleMode),
     distance(std::move(other.distance)),
     baseCases(other.baseCases),
-    scores(other.scores)
+    scores(other.scores),
+    counters(other.counters)
 {
   // Clear other object.
   other.referenceTree =
@@ -139,15 +147,18 @@ RangeSearch<DistanceType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
   other.singleMode = false;
   other.baseCases = 0;
   other.scores = 0;
+  other.counters.Reset();
 }
 
 template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>&
-RangeSearch<DistanceType, MatType, TreeType>::operator=(const RangeSearch& other)
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>&
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::operator=(
+    const RangeSearch& other)
 {
   if (this != &other)
   {
@@ -162,6 +173,7 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(const RangeSearch& other
     distance = other.distance;
     baseCases = other.baseCases;
     scores = other.scores;
+    counters = other.counters;
   }
   return *this;
 }
@@ -170,9 +182,11 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>&
-RangeSearch<DistanceType, MatType, TreeType>::operator=(RangeSearch&& other)
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>&
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::operator=(
+    RangeSearch&& other)
 {
   if (this != &other)
   {
@@ -192,6 +206,7 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(RangeSearch&& other)
     distance = std::move(other.distance);
     baseCases = other.baseCases;
     scores = other.scores;
+    counters = other.counters;
 
     // Clear other object.
     other.referenceTree = nullptr;
@@ -201,6 +216,7 @@ RangeSearch<DistanceType, MatType, TreeType>::operator=(RangeSearch&& other)
     other.singleMode = false;
     other.baseCases = 0;
     other.scores = 0;
+    other.counters.Reset();
   }
   return *this;
 }
@@ -209,8 +225,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-RangeSearch<DistanceType, MatType, TreeType>::~RangeSearch()
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+RangeSearch<DistanceType, MatType, TreeType, CountersType>::~RangeSearch()
 {
   if (treeOwner && referenceTree)
     delete referenceTree;
@@ -222,8 +239,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<DistanceType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Train(
     MatType referenceSet)
 {
   // Clean up the old tree, if we built one.
@@ -260,8 +278,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<DistanceType, MatType, TreeType>::Train(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Train(
   Tree* referenceTree)
 {
   if (naive)
@@ -283,8 +302,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<DistanceType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Search(
     const MatType& querySet,
     const RangeType<ElemType>& range,
     std::vector<std::vector<size_t>>& neighbors,
@@ -331,11 +351,12 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   distancePtr->resize(querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<DistanceType, Tree> RuleType;
+  typedef RangeSearchRules<DistanceType, Tree, CountersType> RuleType;
 
   // Reset counts.
   baseCases = 0;
   scores = 0;
+  counters.Reset();
 
   if (naive)
   {
@@ -351,17 +372,10 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   }
   else if (singleMode)
   {
-    // Create the traverser.
+    // Create the rules, then traverse for each point in parallel.
     RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
         distance);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    SingleTreeSearch(rules, querySet, true);
   }
   else // Dual-tree recursion.
   {
@@ -377,6 +391,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
 
     baseCases += rules.BaseCases();
     scores += rules.Scores();
+    counters.Merge(rules.Counters());
 
     // Clean up tree memory.
     delete queryTree;
@@ -453,8 +468,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<DistanceType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Search(
     Tree* queryTree,
     const RangeType<ElemType>& range,
     std::vector<std::vector<size_t>>& neighbors,
@@ -485,7 +501,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   distances.resize(querySet.n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<DistanceType, Tree> RuleType;
+  typedef RangeSearchRules<DistanceType, Tree, CountersType> RuleType;
   RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
       distances, distance);
 
@@ -496,6 +512,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
 
   baseCases = rules.BaseCases();
   scores = rules.Scores();
+  counters = rules.Counters();
 
   // Do we need to map indices?
   if (treeOwner && TreeTraits<Tree>::RearrangesDataset)
@@ -520,8 +537,9 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
-void RangeSearch<DistanceType, MatType, TreeType>::Search(
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Search(
     const RangeType<ElemType>& range,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<ElemType>>& distances)
@@ -548,7 +566,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
   distancePtr->resize(referenceSet->n_cols);
 
   // Create the helper object for the traversal.
-  typedef RangeSearchRules<DistanceType, Tree> RuleType;
+  typedef RangeSearchRules<DistanceType, Tree, CountersType> RuleType;
   RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
       *distancePtr, distance, true /* don't return the query in the results */);
 
@@ -561,18 +579,17 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
 
     baseCases = (referenceSet->n_cols * referenceSet->n_cols);
     scores = 0;
+    counters.Reset();
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+    // Traverse for each point in parallel.  If the tree rearranged the
+    // dataset, the points are already ordered by their position in the tree.
+    baseCases = 0;
+    scores = 0;
+    counters.Reset();
+    SingleTreeSearch(rules, *referenceSet,
+        !TreeTraits<Tree>::RearrangesDataset);
   }
   else // Dual-tree recursion.
   {
@@ -583,6 +600,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::Search(
 
     baseCases = rules.BaseCases();
     scores = rules.Scores();
+    counters = rules.Counters();
   }
 
   // Do we need to map the reference indices?
@@ -617,9 +635,315 @@ template<typename DistanceType,
          typename MatType,
          template<typename TreeDistanceType,
                   typename TreeStatType,
-                  typename TreeMatType> class TreeType>
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Search(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  std::vector<size_t> queryMapping;
+  RangeSearchBufferResults<ElemType> results;
+  if (referenceSet->n_cols > 0)
+  {
+    results = SearchWithResults(&querySet, range,
+        RangeSearchBufferResults<ElemType>(), queryMapping);
+  }
+
+  BuffersToCSR(results, querySet.n_cols, queryMapping, offsets, neighbors,
+      distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Search(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances)
+{
+  std::vector<size_t> queryMapping;
+  RangeSearchBufferResults<ElemType> results;
+  if (referenceSet->n_cols > 0)
+  {
+    results = SearchWithResults((const MatType*) NULL, range,
+        RangeSearchBufferResults<ElemType>(), queryMapping);
+  }
+
+  BuffersToCSR(results, referenceSet->n_cols, queryMapping, offsets, neighbors,
+      distances);
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Count(
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Count()", "query set");
+
+  arma::Col<size_t> searchCounts(querySet.n_cols, arma::fill::zeros);
+  std::vector<size_t> queryMapping;
+  if (referenceSet->n_cols > 0)
+  {
+    SearchWithResults(&querySet, range,
+        RangeSearchCountResults<ElemType>(searchCounts), queryMapping);
+  }
+
+  if (queryMapping.empty())
+  {
+    counts = std::move(searchCounts);
+  }
+  else
+  {
+    counts.set_size(searchCounts.n_elem);
+    for (size_t i = 0; i < searchCounts.n_elem; ++i)
+      counts[queryMapping[i]] = searchCounts[i];
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::Count(
+    const RangeType<ElemType>& range,
+    arma::Col<size_t>& counts)
+{
+  arma::Col<size_t> searchCounts(referenceSet->n_cols, arma::fill::zeros);
+  std::vector<size_t> queryMapping;
+  if (referenceSet->n_cols > 0)
+  {
+    SearchWithResults((const MatType*) NULL, range,
+        RangeSearchCountResults<ElemType>(searchCounts), queryMapping);
+  }
+
+  if (queryMapping.empty())
+  {
+    counts = std::move(searchCounts);
+  }
+  else
+  {
+    counts.set_size(searchCounts.n_elem);
+    for (size_t i = 0; i < searchCounts.n_elem; ++i)
+      counts[queryMapping[i]] = searchCounts[i];
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+template<typename RuleType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::
+SingleTreeSearch(
+    RuleType& rules,
+    const MatType& querySet,
+    const bool orderQueries)
+{
+  std::vector<size_t> queryOrder;
+  if (orderQueries && querySet.n_cols > 1)
+    AddressOrder(querySet, queryOrder);
+
+  size_t totalBaseCases = 0;
+  size_t totalScores = 0;
+
+  // For trees with self-children, Score() caches the last distance evaluation
+  // in the reference node's statistic, so the traversals for different query
+  // points cannot run at the same time.
+  #pragma omp parallel if (!TreeTraits<Tree>::HasSelfChildren) \
+      reduction(+:totalBaseCases, totalScores)
+  {
+    // Each query point is only ever visited by one thread; depending on the
+    // results policy, copies of the rules share the storage for the results or
+    // have their own buffers, which are merged below.
+    RuleType threadRules(rules);
+    threadRules.Counters().Reset();
+    typename Tree::template SingleTreeTraverser<RuleType>
+        traverser(threadRules);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (size_t i = 0; i < (size_t) querySet.n_cols; ++i)
+    {
+      const size_t queryIndex = queryOrder.empty() ? i : queryOrder[i];
+      traverser.Traverse(queryIndex, *referenceTree);
+    }
+
+    totalBaseCases += threadRules.BaseCases();
+    totalScores += threadRules.Scores();
+
+    // Every thread has passed the implicit barrier at the end of the loop, so
+    // no thread is still copying the rules.
+    #pragma omp critical
+    {
+      rules.Counters().Merge(threadRules.Counters());
+      rules.MergeResults(threadRules);
+    }
+  }
+
+  baseCases += totalBaseCases;
+  scores += totalScores;
+  counters.Merge(rules.Counters());
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+template<typename ResultsType>
+ResultsType RangeSearch<DistanceType, MatType, TreeType, CountersType>::
+SearchWithResults(
+    const MatType* querySet,
+    const RangeType<ElemType>& range,
+    const ResultsType& results,
+    std::vector<size_t>& queryMapping)
+{
+  typedef RangeSearchRules<DistanceType, Tree, CountersType, ResultsType>
+      RuleType;
+
+  // Reset counts.
+  baseCases = 0;
+  scores = 0;
+  counters.Reset();
+  queryMapping.clear();
+
+  // Without a query set, the reference set is searched for itself, so the
+  // query indices are those of the reference set.
+  const bool sameSet = (querySet == NULL);
+  const MatType& queries = sameSet ? *referenceSet : *querySet;
+  if (sameSet && treeOwner && TreeTraits<Tree>::RearrangesDataset)
+    queryMapping = oldFromNewReferences;
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, queries, range, results, distance, sameSet);
+
+    // The naive brute-force solution.
+    for (size_t i = 0; i < queries.n_cols; ++i)
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+        rules.BaseCase(i, j);
+
+    baseCases = (queries.n_cols * referenceSet->n_cols);
+    return std::move(rules.Results());
+  }
+  else if (singleMode)
+  {
+    // Traverse for each point in parallel.  If the tree rearranged the
+    // dataset, the points of the reference set are already ordered by their
+    // position in the tree.
+    RuleType rules(*referenceSet, queries, range, results, distance, sameSet);
+    SingleTreeSearch(rules, queries,
+        !sameSet || !TreeTraits<Tree>::RearrangesDataset);
+    return std::move(rules.Results());
+  }
+  else if (sameSet)
+  {
+    RuleType rules(*referenceSet, *referenceSet, range, results, distance,
+        true);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    counters = rules.Counters();
+    return std::move(rules.Results());
+  }
+  else
+  {
+    // Build the query tree.
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(*querySet, oldFromNewQueries);
+
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, results,
+        distance);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+    counters = rules.Counters();
+
+    delete queryTree;
+    if (TreeTraits<Tree>::RearrangesDataset)
+      queryMapping = std::move(oldFromNewQueries);
+
+    return std::move(rules.Results());
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::BuffersToCSR(
+    const RangeSearchBufferResults<ElemType>& results,
+    const size_t numQueries,
+    const std::vector<size_t>& queryMapping,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances) const
+{
+  const std::vector<size_t>& queries = results.Queries();
+  const bool mapReferences = treeOwner && TreeTraits<Tree>::RearrangesDataset;
+
+  // Count the results of each query point, and turn the counts into offsets.
+  offsets.zeros(numQueries + 1);
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    const size_t query = queryMapping.empty() ? queries[i] :
+        queryMapping[queries[i]];
+    ++offsets[query + 1];
+  }
+
+  for (size_t i = 0; i < numQueries; ++i)
+    offsets[i + 1] += offsets[i];
+
+  // Now put each result in the next free position of its query point.
+  arma::Col<size_t> next(offsets.memptr(), numQueries);
+  neighbors.set_size(queries.size());
+  distances.set_size(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    const size_t query = queryMapping.empty() ? queries[i] :
+        queryMapping[queries[i]];
+    const size_t position = next[query]++;
+    neighbors[position] = mapReferences ?
+        oldFromNewReferences[results.Neighbors()[i]] : results.Neighbors()[i];
+    distances[position] = results.Distances()[i];
+  }
+}
+
+template<typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename CountersType>
 template<typename Archive>
-void RangeSearch<DistanceType, MatType, TreeType>::serialize(
+void RangeSearch<DistanceType, MatType, TreeType, CountersType>::serialize(
     Archive& ar, const uint32_t /* version */)
 {
   // Serialize preferences for search.
@@ -631,6 +955,7 @@ void RangeSearch<DistanceType, MatType, TreeType>::serialize(
   {
     baseCases = 0;
     scores = 0;
+    counters.Reset();
   }
 
   // If we are doing naive search, we serialize the dataset.  Otherwise we
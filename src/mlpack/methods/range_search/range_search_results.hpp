@@ -0,0 +1,186 @@
+/**
+ * @file methods/range_search/range_search_results.hpp
+ *
+ * Policies that decide how RangeSearchRules store the points found in range:
+ * in one vector per query point, in a flat buffer that is turned into a
+ * compressed (CSR) structure, or as counts only.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+#define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RESULTS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A results policy is held by RangeSearchRules, and is told about every
+ * (query point, reference point) pair in range.  Copies of the rules are made
+ * for each thread in single-tree search, so copies of a policy are made too;
+ * when a thread is done, Merge() is called on the original with the copy of the
+ * thread, one thread at a time.  Each query point is only ever visited by one
+ * copy.  A policy must provide:
+ *
+ *  - static const bool StoresDistances: if false, Add() is never called, and
+ *    AddCount() is called instead, without computing the distances of points
+ *    that are known to be in range.
+ *  - void Reserve(queryIndex, n): at least n more results are coming for the
+ *    given query point.
+ *  - void Add(queryIndex, referenceIndex, distance).
+ *  - void AddCount(queryIndex, n): n more points are in range.
+ *  - void Merge(other): collect the results of a copy of this policy.
+ *
+ * RangeSearchVectorResults is the default policy, which holds references to
+ * one vector of neighbors and one vector of distances per query point.  Copies
+ * share these vectors.
+ */
+template<typename ElemType>
+class RangeSearchVectorResults
+{
+ public:
+  //! Every result is stored.
+  static const bool StoresDistances = true;
+
+  /**
+   * Store the results in the given vectors, which must have one entry per
+   * query point.
+   */
+  RangeSearchVectorResults(std::vector<std::vector<size_t>>& neighbors,
+                           std::vector<std::vector<ElemType>>& distances) :
+      neighbors(&neighbors),
+      distances(&distances)
+  { }
+
+  //! Reserve space for n more results for the given query point.
+  void Reserve(const size_t queryIndex, const size_t n)
+  {
+    const size_t oldSize = (*neighbors)[queryIndex].size();
+    (*neighbors)[queryIndex].reserve(oldSize + n);
+    (*distances)[queryIndex].reserve(oldSize + n);
+  }
+
+  //! Add the given result.
+  void Add(const size_t queryIndex,
+           const size_t referenceIndex,
+           const ElemType distance)
+  {
+    (*neighbors)[queryIndex].push_back(referenceIndex);
+    (*distances)[queryIndex].push_back(distance);
+  }
+
+  //! This is never called, since every result is stored.
+  void AddCount(const size_t /* queryIndex */, const size_t /* n */) { }
+
+  //! Nothing to do: copies share the vectors.
+  void Merge(const RangeSearchVectorResults& /* other */) { }
+
+ private:
+  //! The neighbors of each query point.
+  std::vector<std::vector<size_t>>* neighbors;
+  //! The distances of each query point.
+  std::vector<std::vector<ElemType>>* distances;
+};
+
+/**
+ * RangeSearchBufferResults appends every result to flat buffers, with no
+ * allocation per query point.  Each copy (that is, each thread) has its own
+ * buffers, which are appended to those of the original by Merge().  The buffers
+ * are in no particular order; RangeSearch groups them by query point.
+ */
+template<typename ElemType>
+class RangeSearchBufferResults
+{
+ public:
+  //! Every result is stored.
+  static const bool StoresDistances = true;
+
+  //! Nothing to do: the buffers grow as needed.
+  void Reserve(const size_t /* queryIndex */, const size_t /* n */) { }
+
+  //! Add the given result.
+  void Add(const size_t queryIndex,
+           const size_t referenceIndex,
+           const ElemType distance)
+  {
+    queries.push_back(queryIndex);
+    neighbors.push_back(referenceIndex);
+    distances.push_back(distance);
+  }
+
+  //! This is never called, since every result is stored.
+  void AddCount(const size_t /* queryIndex */, const size_t /* n */) { }
+
+  //! Append the results of the given copy to these results.
+  void Merge(const RangeSearchBufferResults& other)
+  {
+    queries.insert(queries.end(), other.queries.begin(), other.queries.end());
+    neighbors.insert(neighbors.end(), other.neighbors.begin(),
+        other.neighbors.end());
+    distances.insert(distances.end(), other.distances.begin(),
+        other.distances.end());
+  }
+
+  //! Get the query point of each result.
+  const std::vector<size_t>& Queries() const { return queries; }
+  //! Get the reference point of each result.
+  const std::vector<size_t>& Neighbors() const { return neighbors; }
+  //! Get the distance of each result.
+  const std::vector<ElemType>& Distances() const { return distances; }
+
+ private:
+  //! The query point of each result.
+  std::vector<size_t> queries;
+  //! The reference point of each result.
+  std::vector<size_t> neighbors;
+  //! The distance of each result.
+  std::vector<ElemType> distances;
+};
+
+/**
+ * RangeSearchCountResults only counts the points in range of each query point.
+ * Points in reference nodes that are entirely in range are counted without
+ * computing their distances.  Copies share the counts.
+ */
+template<typename ElemType>
+class RangeSearchCountResults
+{
+ public:
+  //! No result is stored.
+  static const bool StoresDistances = false;
+
+  //! Store the counts in the given vector, which must have one (zero) element
+  //! per query point.
+  RangeSearchCountResults(arma::Col<size_t>& counts) : counts(&counts) { }
+
+  //! Nothing to do.
+  void Reserve(const size_t /* queryIndex */, const size_t /* n */) { }
+
+  //! Count the given result.
+  void Add(const size_t queryIndex,
+           const size_t /* referenceIndex */,
+           const ElemType /* distance */)
+  {
+    ++(*counts)[queryIndex];
+  }
+
+  //! Count n more results for the given query point.
+  void AddCount(const size_t queryIndex, const size_t n)
+  {
+    (*counts)[queryIndex] += n;
+  }
+
+  //! Nothing to do: copies share the counts.
+  void Merge(const RangeSearchCountResults& /* other */) { }
+
+ private:
+  //! The number of points in range of each query point.
+  arma::Col<size_t>* counts;
+};
+
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,8 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/traversal_counters.hpp>
+#include "range_search_results.hpp"
 
 namespace mlpack {
 
@@ -22,8 +24,17 @@ namespace mlpack {
  *
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ * @tparam CountersType The policy that collects traversal statistics (see
+ *     TraversalCounters); by default, nothing is collected.
+ * @tparam ResultsType The policy that stores the results (see
+ *     range_search_results.hpp); by default, they are stored in one vector per
+ *     query point.
  */
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType = NullTraversalCounters,
+         typename ResultsType =
+             RangeSearchVectorResults<typename TreeType::Mat::elem_type>>
 class RangeSearchRules
 {
  public:
@@ -53,6 +64,24 @@ class RangeSearchRules
                    DistanceType& distance,
                    const bool sameSet = false);
 
+  /**
+   * Construct the RangeSearchRules object with the given results policy.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param results Results policy to store the results with; it is copied.
+   * @param distance Instantiated distance metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  RangeSearchRules(const MatType& referenceSet,
+                   const MatType& querySet,
+                   const RangeType<ElemType>& range,
+                   const ResultsType& results,
+                   DistanceType& distance,
+                   const bool sameSet = false);
+
   /**
    * Compute the base case between the given query point and reference point.
    *
@@ -121,6 +150,22 @@ class RangeSearchRules
   //! Get the number of scores (that is, calls to RangeDistance()).
   size_t Scores() const { return scores; }
 
+  //! Get the results policy.
+  const ResultsType& Results() const { return results; }
+  //! Modify the results policy.
+  ResultsType& Results() { return results; }
+
+  //! Collect the results of the given copy of these rules, once it is done.
+  void MergeResults(const RangeSearchRules& other)
+  {
+    results.Merge(other.results);
+  }
+
+  //! Get the traversal counters.
+  const CountersType& Counters() const { return counters; }
+  //! Modify the traversal counters.
+  CountersType& Counters() { return counters; }
+
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
   size_t MinimumBaseCases() const { return 0; }
@@ -135,11 +180,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const RangeType<ElemType>& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<ElemType> >& distances;
+  //! The policy the results are stored with.
+  ResultsType results;
 
   //! The instantiated distance metric.
   DistanceType& distance;
@@ -164,6 +206,8 @@ class RangeSearchRules
   size_t baseCases;
   //! THe number of scores.
   size_t scores;
+  //! The traversal counters.
+  CountersType counters;
 };
 
 } // namespace mlpack
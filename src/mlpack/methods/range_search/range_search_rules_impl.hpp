@@ -17,8 +17,12 @@
 
 namespace mlpack {
 
-template<typename DistanceType, typename TreeType>
-RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::
+RangeSearchRules(
     const MatType& referenceSet,
     const MatType& querySet,
     const RangeType<ElemType>& range,
@@ -26,11 +30,28 @@ RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
     std::vector<std::vector<ElemType> >& distances,
     DistanceType& distance,
     const bool sameSet) :
+    RangeSearchRules(referenceSet, querySet, range,
+        ResultsType(neighbors, distances), distance, sameSet)
+{
+  // Nothing to do.
+}
+
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::
+RangeSearchRules(
+    const MatType& referenceSet,
+    const MatType& querySet,
+    const RangeType<ElemType>& range,
+    const ResultsType& results,
+    DistanceType& distance,
+    const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    results(results),
     distance(distance),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
@@ -38,15 +59,19 @@ RangeSearchRules<DistanceType, TreeType>::RangeSearchRules(
     baseCases(0),
     scores(0)
 {
-  // Nothing to do.
+  counters.AddQueries(querySet.n_cols);
 }
 
 //! The base case.  Evaluate the distance between the two points and add to the
 //! results if necessary.
-template<typename DistanceType, typename TreeType>
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
 inline mlpack_force_inline
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::BaseCase(
+typename RangeSearchRules<DistanceType, TreeType, CountersType,
+    ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::BaseCase(
     const size_t queryIndex,
     const size_t referenceIndex)
 {
@@ -67,19 +92,21 @@ RangeSearchRules<DistanceType, TreeType>::BaseCase(
   lastReferenceIndex = referenceIndex;
 
   if (range.Contains(d))
-  {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(d);
-  }
+    results.Add(queryIndex, referenceIndex, d);
 
   return d;
 }
 
 //! Single-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
-                                                TreeType& referenceNode)
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, CountersType,
+    ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::Score(
+    const size_t queryIndex,
+    TreeType& referenceNode)
 {
   // We must get the minimum and maximum distances and store them in this
   // object.
@@ -121,25 +148,30 @@ RangeSearchRules<DistanceType, TreeType>::Score(const size_t queryIndex,
 
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
-    return DBL_MAX;
+    return counters.Score(referenceNode, DBL_MAX);
 
   // In this case, all of the points in the reference node will be part of the
   // results.
   if ((distances.Lo() >= range.Lo()) && (distances.Hi() <= range.Hi()))
   {
     AddResult(queryIndex, referenceNode);
-    return DBL_MAX; // We don't need to go any deeper.
+    // We don't need to go any deeper.
+    return counters.Score(referenceNode, DBL_MAX);
   }
 
   // Otherwise the score doesn't matter.  Recursion order is irrelevant in
   // range search.
-  return 0.0;
+  return counters.Score(referenceNode, 0.0);
 }
 
 //! Single-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, CountersType,
+    ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::Rescore(
     const size_t /* queryIndex */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -149,10 +181,15 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 }
 
 //! Dual-tree scoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
-                                                TreeType& referenceNode)
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, CountersType,
+    ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::Score(
+    TreeType& queryNode,
+    TreeType& referenceNode)
 {
   RangeType<ElemType> distances;
   if (TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -193,7 +230,7 @@ RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
 
   // If the ranges do not overlap, prune this node.
   if (!distances.Contains(range))
-    return DBL_MAX;
+    return counters.Score(queryNode, referenceNode, DBL_MAX);
 
   // In this case, all of the points in the reference node will be part of all
   // the results for each point in the query node.
@@ -201,20 +238,25 @@ RangeSearchRules<DistanceType, TreeType>::Score(TreeType& queryNode,
   {
     for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
       AddResult(queryNode.Descendant(i), referenceNode);
-    return DBL_MAX; // We don't need to go any deeper.
+    // We don't need to go any deeper.
+    return counters.Score(queryNode, referenceNode, DBL_MAX);
   }
 
   // Otherwise the score doesn't matter.  Recursion order is irrelevant in range
   // search.
   traversalInfo.LastQueryNode() = &queryNode;
   traversalInfo.LastReferenceNode() = &referenceNode;
-  return 0.0;
+  return counters.Score(queryNode, referenceNode, 0.0);
 }
 
 //! Dual-tree rescoring function.
-template<typename DistanceType, typename TreeType>
-typename RangeSearchRules<DistanceType, TreeType>::ElemType
-RangeSearchRules<DistanceType, TreeType>::Rescore(
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+typename RangeSearchRules<DistanceType, TreeType, CountersType,
+    ResultsType>::ElemType
+RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::Rescore(
     TreeType& /* queryNode */,
     TreeType& /* referenceNode */,
     const ElemType oldScore) const
@@ -225,9 +267,12 @@ RangeSearchRules<DistanceType, TreeType>::Rescore(
 
 //! Add all the points in the given node to the results for the given query
 //! point.
-template<typename DistanceType, typename TreeType>
-void RangeSearchRules<DistanceType, TreeType>::AddResult(
-    const size_t queryIndex, TreeType& referenceNode)
+template<typename DistanceType,
+         typename TreeType,
+         typename CountersType,
+         typename ResultsType>
+void RangeSearchRules<DistanceType, TreeType, CountersType, ResultsType>::
+AddResult(const size_t queryIndex, TreeType& referenceNode)
 {
   // Some types of trees calculate the base case evaluation before Score() is
   // called, so if the base case has already been calculated, then we must avoid
@@ -240,27 +285,33 @@ void RangeSearchRules<DistanceType, TreeType>::AddResult(
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Reserve space for the results.  We have to reserve and not resize,
+  // because we don't know if we will encounter the case where the datasets and
+  // points are the same (and we skip in that case).
+  results.Reserve(queryIndex, referenceNode.NumDescendants() - baseCaseMod);
 
+  // If the distances are not stored, the points only need to be counted.
+  size_t count = 0;
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
     if ((&referenceSet == &querySet) &&
         (queryIndex == referenceNode.Descendant(i)))
       continue;
 
-    const ElemType d = distance.Evaluate(querySet.unsafe_col(queryIndex),
-        referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
-
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(d);
+    if (ResultsType::StoresDistances)
+    {
+      const ElemType d = distance.Evaluate(querySet.unsafe_col(queryIndex),
+          referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
+      results.Add(queryIndex, referenceNode.Descendant(i), d);
+    }
+    else
+    {
+      ++count;
+    }
   }
+
+  if (!ResultsType::StoresDistances)
+    results.AddCount(queryIndex, count);
 }
 
 } // namespace mlpack
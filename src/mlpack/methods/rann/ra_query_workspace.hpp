@@ -0,0 +1,103 @@
+/**
+ * @file methods/rann/ra_query_workspace.hpp
+ *
+ * Defines the RAQueryWorkspace class, which holds the buffers used during a
+ * rank-approximate search so that they can be reused between searches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANN_RA_QUERY_WORKSPACE_HPP
+#define MLPACK_METHODS_RANN_RA_QUERY_WORKSPACE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * The RAQueryWorkspace holds the memory used by RASearchRules during a search:
+ * the candidate neighbor lists of each query point, the number of samples made
+ * for each query point, and the buffers that random samples of reference
+ * points are drawn into.  The buffers keep their memory from one search to the
+ * next, so when the same workspace is given to many calls of RASearch::Search()
+ * with small query sets, no memory needs to be allocated for these after the
+ * first call.
+ *
+ * A workspace can only be used by one search at a time; to run searches in
+ * parallel, give each thread its own workspace.
+ *
+ * @code
+ * RAQueryWorkspace workspace;
+ * for (size_t i = 0; i < queries.size(); ++i)
+ *   ra.Search(queries[i], k, neighbors, distances, workspace);
+ * @endcode
+ */
+class RAQueryWorkspace
+{
+ public:
+  //! Candidate represents a possible candidate neighbor (distance, index).
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Create an empty workspace.
+  RAQueryWorkspace() { }
+
+  /**
+   * Prepare the workspace for a search with the given number of query points:
+   * each candidate list is set to k copies of the given default candidate, and
+   * the number of samples made for each query point is set to 0.  Memory is
+   * only allocated if the workspace has not held that many query points or
+   * candidates before; the candidate lists of query points past numQueries are
+   * kept (but unused) so that their memory can be reused later.
+   *
+   * @param numQueries Number of query points.
+   * @param k Number of neighbors to search for.
+   * @param def Default candidate (with the worst possible distance).
+   */
+  void Reset(const size_t numQueries, const size_t k, const Candidate& def)
+  {
+    if (candidates.size() < numQueries)
+      candidates.resize(numQueries);
+    for (size_t i = 0; i < numQueries; ++i)
+      candidates[i].assign(k, def);
+
+    numSamplesMade.zeros(numQueries);
+  }
+
+  //! Get the candidate lists of each query point.
+  const std::vector<std::vector<Candidate>>& Candidates() const
+  { return candidates; }
+  //! Modify the candidate lists of each query point.  Each list is a heap
+  //! whose first element is the worst candidate.
+  std::vector<std::vector<Candidate>>& Candidates() { return candidates; }
+
+  //! Get the number of samples made for each query point.
+  const arma::Col<size_t>& NumSamplesMade() const { return numSamplesMade; }
+  //! Modify the number of samples made for each query point.
+  arma::Col<size_t>& NumSamplesMade() { return numSamplesMade; }
+
+  //! Get the buffer that samples of the points of a node are drawn into.
+  const std::vector<size_t>& Samples() const { return samples; }
+  //! Modify the buffer that samples of the points of a node are drawn into.
+  std::vector<size_t>& Samples() { return samples; }
+
+  //! Get the permutation of the reference points used for naive sampling.
+  const std::vector<size_t>& Permutation() const { return permutation; }
+  //! Modify the permutation of the reference points used for naive sampling.
+  std::vector<size_t>& Permutation() { return permutation; }
+
+ private:
+  //! The candidate lists of each query point.
+  std::vector<std::vector<Candidate>> candidates;
+  //! The number of samples made for each query point.
+  arma::Col<size_t> numSamplesMade;
+  //! The buffer that samples of the points of a node are drawn into.
+  std::vector<size_t> samples;
+  //! A permutation of the reference points, used for naive sampling.
+  std::vector<size_t> permutation;
+};
+
+} // namespace mlpack
+
+#endif
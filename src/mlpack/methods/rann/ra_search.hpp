@@ -30,6 +30,7 @@
 #include <mlpack/methods/neighbor_search/sort_policies/nearest_neighbor_sort.hpp>
 
 #include "ra_query_stat.hpp"
+#include "ra_query_workspace.hpp"
 #include "ra_util.hpp"
 
 namespace mlpack {
@@ -60,6 +61,12 @@ class LeafSizeRAWrapper;
  *
  * RASearch is currently known to not work with ball trees (#356).
  *
+ * The memory used during a search (the candidate lists and the sampling
+ * buffers) is kept in a RAQueryWorkspace between calls to Search(), so that
+ * many searches with small query sets do not allocate it again every time.
+ * Independent query sets can also be searched in parallel with the batch
+ * Search() overload, which gives each OpenMP thread its own workspace.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use.
@@ -258,6 +265,45 @@ class RASearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Compute the rank approximate nearest neighbors of each query point in the
+   * query set, like the Search() overload above, but store the candidates and
+   * samples in the given workspace.  Several threads can call this at the same
+   * time on the same RASearch object, as long as each thread has its own
+   * workspace and the settings of the object are not modified.
+   *
+   * @param querySet Set of query points (can be a single point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param workspace Workspace to use for the search.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              RAQueryWorkspace& workspace);
+
+  /**
+   * Compute the rank approximate nearest neighbors of each point of each of the
+   * given query sets.  The query sets are searched in parallel with OpenMP;
+   * each thread keeps its workspace between calls, so this is efficient for
+   * serving many small queries.  The results for querySets[i] are stored in
+   * neighbors[i] and distances[i].
+   *
+   * @param querySets Sets of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Vector of matrices storing lists of neighbors for each
+   *     query point of each query set.
+   * @param distances Vector of matrices storing distances of neighbors for each
+   *     query point of each query set.
+   */
+  void Search(const std::vector<MatType>& querySets,
+              const size_t k,
+              std::vector<arma::Mat<size_t>>& neighbors,
+              std::vector<arma::mat>& distances);
+
   /**
    * Compute the rank approximate nearest neighbors of each point in the
    * pre-built query tree and store the output in the given matrices. The
@@ -391,6 +437,11 @@ class RASearch
   //! Instantiation of distance metric.
   DistanceType distance;
 
+  //! Workspace used by Search() when none is given.
+  RAQueryWorkspace defaultWorkspace;
+  //! Workspaces of each thread, used by the batch Search().
+  std::vector<RAQueryWorkspace> threadWorkspaces;
+
   //! For access to mappings when building models.
   friend class LeafSizeRAWrapper<TreeType>;
 }; // class RASearch
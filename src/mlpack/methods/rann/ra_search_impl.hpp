@@ -223,6 +223,22 @@ Search(const MatType& querySet,
        const size_t k,
        arma::Mat<size_t>& neighbors,
        arma::mat& distances)
+{
+  Search(querySet, k, neighbors, distances, defaultWorkspace);
+}
+
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType>::
+Search(const MatType& querySet,
+       const size_t k,
+       arma::Mat<size_t>& neighbors,
+       arma::mat& distances,
+       RAQueryWorkspace& workspace)
 {
   if (k > referenceSet->n_cols)
   {
@@ -265,27 +281,27 @@ Search(const MatType& querySet,
   if (naive)
   {
     RuleType rules(*referenceSet, querySet, k, distance, tau, alpha, naive,
-        sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+        sampleAtLeaves, firstLeafExact, singleSampleLimit, false, &workspace);
 
     // Find how many samples from the reference set we need and sample uniformly
     // from the reference set without replacement.
     const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
         k, tau, alpha);
-    arma::uvec distinctSamples = arma::randperm(referenceSet->n_cols,
-        numSamples);
+    std::vector<size_t>& distinctSamples = workspace.Permutation();
+    RAUtil::PartialShuffle(referenceSet->n_cols, numSamples, distinctSamples);
 
     // Run the base case on each combination of query point and sampled
     // reference point.
     for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+      for (size_t j = 0; j < numSamples; ++j)
+        rules.BaseCase(i, distinctSamples[j]);
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
   else if (singleMode)
   {
     RuleType rules(*referenceSet, querySet, k, distance, tau, alpha, naive,
-        sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+        sampleAtLeaves, firstLeafExact, singleSampleLimit, false, &workspace);
 
     // If the reference root node is a leaf, then the sampling has already been
     // done in the RASearchRules constructor.  This happens when naive = true.
@@ -317,7 +333,8 @@ Search(const MatType& querySet,
         oldFromNewQueries);
 
     RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, tau, alpha,
-        naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+        naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false,
+        &defaultWorkspace);
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     Log::Info << "Query statistic pre-search: "
@@ -426,7 +443,8 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, DistanceType, Tree> RuleType;
   RuleType rules(*referenceSet, queryTree->Dataset(), k, distance, tau, alpha,
-      naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+      naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false,
+      &defaultWorkspace);
 
   // Create the traverser.
   typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -478,17 +496,11 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, DistanceType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, distance, tau, alpha, naive,
-      sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
+      sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */,
+      &defaultWorkspace);
 
   if (naive)
   {
-    // Find how many samples from the reference set we need and sample uniformly
-    // from the reference set without replacement.
-    const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
-        k, tau, alpha);
-    arma::uvec distinctSamples = arma::randperm(referenceSet->n_cols,
-        numSamples);
-
     // The naive brute-force solution.
     for (size_t i = 0; i < referenceSet->n_cols; ++i)
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
@@ -536,6 +548,63 @@ void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
   }
 }
 
+template<typename SortPolicy,
+         typename DistanceType,
+         typename MatType,
+         template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RASearch<SortPolicy, DistanceType, MatType, TreeType>::Search(
+    const std::vector<MatType>& querySets,
+    const size_t k,
+    std::vector<arma::Mat<size_t>>& neighbors,
+    std::vector<arma::mat>& distances)
+{
+  // Check the parameters here, because exceptions can't be thrown out of the
+  // parallel loop.
+  if (k > referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t n = (size_t) std::ceil(tau * (double) referenceSet->n_cols /
+      100.0);
+  if (n < k)
+  {
+    std::stringstream ss;
+    ss << "rank-approximation percentile " << tau << " corresponds to " << n
+        << " points, which is less than k (" << k << "); increase tau";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.resize(querySets.size());
+  distances.resize(querySets.size());
+
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+  if (threadWorkspaces.size() < numThreads)
+    threadWorkspaces.resize(numThreads);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < querySets.size(); ++i)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      RAQueryWorkspace& threadWorkspace =
+          threadWorkspaces[omp_get_thread_num()];
+    #else
+      RAQueryWorkspace& threadWorkspace = threadWorkspaces[0];
+    #endif
+
+    Search(querySets[i], k, neighbors[i], distances[i], threadWorkspace);
+  }
+}
+
 template<typename SortPolicy,
          typename DistanceType,
          typename MatType,
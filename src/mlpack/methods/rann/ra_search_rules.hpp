@@ -16,7 +16,8 @@
 
 #include <mlpack/core/tree/traversal_info.hpp>
 
-#include <queue>
+#include "ra_query_workspace.hpp"
+#include "ra_util.hpp"
 
 namespace mlpack {
 
@@ -24,6 +25,10 @@ namespace mlpack {
  * The RASearchRules class is a template helper class used by RASearch class
  * when performing rank-approximate search via random-sampling.
  *
+ * The candidate lists, the sample counts, and the sampling buffers are stored
+ * in a RAQueryWorkspace.  If one is given to the constructor, its memory is
+ * reused; otherwise, the rules object creates its own.
+ *
  * @tparam SortPolicy The sort policy for distances.
  * @tparam DistanceType The distance metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
@@ -52,6 +57,9 @@ class RASearchRules
    *     approximated by sampling.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param workspace Workspace to store the candidates and samples in (if NULL,
+   *      a new one is created).  It must not be used by another search until
+   *      GetResults() has been called.
    */
   RASearchRules(const arma::mat& referenceSet,
                 const arma::mat& querySet,
@@ -63,7 +71,8 @@ class RASearchRules
                 const bool sampleAtLeaves = false,
                 const bool firstLeafExact = false,
                 const size_t singleSampleLimit = 20,
-                const bool sameSet = false);
+                const bool sameSet = false,
+                RAQueryWorkspace* workspace = NULL);
 
   /**
    * Store the list of candidates for each query point in the given matrices.
@@ -253,22 +262,24 @@ class RASearchRules
   const arma::mat& querySet;
 
   //! Candidate represents a possible candidate neighbor (distance, index).
-  typedef std::pair<double, size_t> Candidate;
+  typedef RAQueryWorkspace::Candidate Candidate;
 
   //! Compare two candidates based on the distance.
   struct CandidateCmp {
-    bool operator()(const Candidate& c1, const Candidate& c2)
+    bool operator()(const Candidate& c1, const Candidate& c2) const
     {
       return !SortPolicy::IsBetter(c2.first, c1.first);
     };
   };
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
+  //! The workspace created by this object, if none was given.
+  std::unique_ptr<RAQueryWorkspace> ownedWorkspace;
+  //! The workspace holding the candidates and samples.
+  RAQueryWorkspace& workspace;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  Each list is a heap built on
+  //! a std::vector, with the worst candidate first.
+  std::vector<std::vector<Candidate>>& candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -289,7 +300,10 @@ class RASearchRules
   size_t numSamplesReqd;
 
   //! The number of samples made for every query.
-  arma::Col<size_t> numSamplesMade;
+  arma::Col<size_t>& numSamplesMade;
+
+  //! The buffer that samples of the points of reference nodes are drawn into.
+  std::vector<size_t>& samples;
 
   //! The sampling ratio.
   double samplingRatio;
@@ -29,14 +29,20 @@ RASearchRules(const arma::mat& referenceSet,
               const bool sampleAtLeaves,
               const bool firstLeafExact,
               const size_t singleSampleLimit,
-              const bool sameSet) :
+              const bool sameSet,
+              RAQueryWorkspace* workspaceIn) :
     referenceSet(referenceSet),
     querySet(querySet),
+    ownedWorkspace(workspaceIn ? NULL : new RAQueryWorkspace()),
+    workspace(workspaceIn ? *workspaceIn : *ownedWorkspace),
+    candidates(workspace.Candidates()),
     k(k),
     distance(distance),
     sampleAtLeaves(sampleAtLeaves),
     firstLeafExact(firstLeafExact),
     singleSampleLimit(singleSampleLimit),
+    numSamplesMade(workspace.NumSamplesMade()),
+    samples(workspace.Samples()),
     sameSet(sameSet)
 {
   // Validate tau to make sure that the rank approximation is greater than the
@@ -60,7 +66,6 @@ RASearchRules(const arma::mat& referenceSet,
   numSamplesReqd = RAUtil::MinimumSamplesReqd(n, k, tau, alpha);
 
   // Initialize some statistics to be collected during the search.
-  numSamplesMade = zeros<arma::Col<size_t>>(querySet.n_cols);
   numDistComputations = 0;
   samplingRatio = (double) numSamplesReqd / (double) n;
 
@@ -71,25 +76,20 @@ RASearchRules(const arma::mat& referenceSet,
   // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
   // The list of candidates will be updated when visiting new points with the
   // BaseCase() method.
+  // This also resets the number of samples made for each query point.
   const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
       size_t() - 1);
-
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  workspace.Reset(querySet.n_cols, k, def);
 
   if (naive) // No tree traversal; just do naive sampling here.
   {
     // Sample enough points.
-    arma::uvec distinctSamples;
+    std::vector<size_t>& permutation = workspace.Permutation();
     for (size_t i = 0; i < querySet.n_cols; ++i)
     {
-      distinctSamples = arma::randperm(n, numSamplesReqd);
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        BaseCase(i, (size_t) distinctSamples[j]);
+      RAUtil::PartialShuffle(n, numSamplesReqd, permutation);
+      for (size_t j = 0; j < numSamplesReqd; ++j)
+        BaseCase(i, permutation[j]);
     }
   }
 }
@@ -104,12 +104,13 @@ void RASearchRules<SortPolicy, DistanceType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
-    for (size_t j = 1; j <= k; ++j)
+    // Sorting the heap puts the best candidate first.
+    std::vector<Candidate>& pqueue = candidates[i];
+    std::sort_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+    for (size_t j = 0; j < k; ++j)
     {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
+      neighbors(j, i) = pqueue[j].second;
+      distances(j, i) = pqueue[j].first;
     }
   }
 };
@@ -145,7 +146,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates[queryIndex].front().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -159,7 +160,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double d = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode, baseCaseResult);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates[queryIndex].front().first;
 
   return Score(queryIndex, referenceNode, d, bestDistance);
 }
@@ -200,12 +201,12 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.
           // Hence, approximate the node by sampling enough number of points.
-          arma::uvec distinctSamples =
-              arma::randperm(referenceNode.NumDescendants(), samplesReqd);
-          for (size_t i = 0; i < distinctSamples.n_elem; ++i)
+          RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+              samplesReqd, samples);
+          for (size_t i = 0; i < samples.size(); ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+            BaseCase(queryIndex, referenceNode.Descendant(samples[i]));
 
           // Node approximated, so we can prune it.
           return DBL_MAX;
@@ -215,13 +216,13 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
           if (sampleAtLeaves) // If allowed to sample at leaves.
           {
             // Approximate node by sampling enough number of points.
-            arma::uvec distinctSamples =
-                arma::randperm(referenceNode.NumDescendants(), samplesReqd);
-            for (size_t i = 0; i < distinctSamples.n_elem; ++i)
+            RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+                samplesReqd, samples);
+            for (size_t i = 0; i < samples.size(); ++i)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
               BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[i]));
+                  referenceNode.Descendant(samples[i]));
 
             // (Leaf) node approximated, so we can prune it.
             return DBL_MAX;
@@ -269,7 +270,7 @@ Rescore(const size_t queryIndex,
     return oldScore;
 
   // Just check the score again against the distances.
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = candidates[queryIndex].front().first;
 
   // If this is better than the best distance we've seen so far,
   // maybe there will be something down this node.
@@ -302,12 +303,12 @@ Rescore(const size_t queryIndex,
       {
         // Then, samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough number of points.
-        arma::uvec distinctSamples =
-            arma::randperm(referenceNode.NumDescendants(), samplesReqd);
-        for (size_t i = 0; i < distinctSamples.n_elem; ++i)
+        RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+            samplesReqd, samples);
+        for (size_t i = 0; i < samples.size(); ++i)
           // The counting of the samples are done in the 'BaseCase' function so
           // no book-keeping is required here.
-          BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+          BaseCase(queryIndex, referenceNode.Descendant(samples[i]));
 
         // Node approximated, so we can prune it.
         return DBL_MAX;
@@ -317,12 +318,12 @@ Rescore(const size_t queryIndex,
         if (sampleAtLeaves)
         {
           // Approximate node by sampling enough points.
-          arma::uvec distinctSamples =
-              arma::randperm(referenceNode.NumDescendants(), samplesReqd);
-          for (size_t i = 0; i < distinctSamples.n_elem; ++i)
+          RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+              samplesReqd, samples);
+          for (size_t i = 0; i < samples.size(); ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[i]));
+            BaseCase(queryIndex, referenceNode.Descendant(samples[i]));
 
           // (Leaf) node approximated, so we can prune it.
           return DBL_MAX;
@@ -367,7 +368,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates[queryNode.Point(i)].front().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -406,7 +407,7 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates[queryNode.Point(i)].front().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -500,17 +501,16 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
         {
           // Then samplesReqd <= singleSampleLimit.  Hence, approximate node by
           // sampling enough number of points for every query in the query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                samplesReqd);
-            for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+            RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+                samplesReqd, samples);
+            for (size_t j = 0; j < samples.size(); ++j)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
               BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
+                  referenceNode.Descendant(samples[j]));
           }
 
           // Update the number of samples made for the queryNode and also update
@@ -530,17 +530,16 @@ inline double RASearchRules<SortPolicy, DistanceType, TreeType>::Score(
           {
             // Approximate node by sampling enough number of points for every
             // query in the query node.
-            arma::uvec distinctSamples;
             for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
             {
               const size_t queryIndex = queryNode.Descendant(i);
-              distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                  samplesReqd);
-              for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+              RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+                  samplesReqd, samples);
+              for (size_t j = 0; j < samples.size(); ++j)
                 // The counting of the samples are done in the 'BaseCase'
                 // function so no book-keeping is required here.
                 BaseCase(queryIndex,
-                    referenceNode.Descendant(distinctSamples[j]));
+                    referenceNode.Descendant(samples[j]));
             }
 
             // Update the number of samples made for the queryNode and also
@@ -620,7 +619,7 @@ Rescore(TreeType& queryNode,
 
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = candidates[queryNode.Point(i)].front().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -705,16 +704,15 @@ Rescore(TreeType& queryNode,
       {
         // then samplesReqd <= singleSampleLimit.  Hence, approximate the node
         // by sampling enough points for every query in the query node.
-        arma::uvec distinctSamples;
         for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
         {
           const size_t queryIndex = queryNode.Descendant(i);
-          distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-              samplesReqd);
-          for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+          RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+              samplesReqd, samples);
+          for (size_t j = 0; j < samples.size(); ++j)
             // The counting of the samples are done in the 'BaseCase'
             // function so no book-keeping is required here.
-            BaseCase(queryIndex, referenceNode.Descendant(distinctSamples[j]));
+            BaseCase(queryIndex, referenceNode.Descendant(samples[j]));
         }
 
         // Update the number of samples made for the query node and also update
@@ -734,17 +732,16 @@ Rescore(TreeType& queryNode,
         {
           // Approximate node by sampling enough points for every query in the
           // query node.
-          arma::uvec distinctSamples;
           for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
           {
             const size_t queryIndex = queryNode.Descendant(i);
-            distinctSamples = arma::randperm(referenceNode.NumDescendants(),
-                samplesReqd);
-            for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+            RAUtil::ObtainDistinctSamples(referenceNode.NumDescendants(),
+                samplesReqd, samples);
+            for (size_t j = 0; j < samples.size(); ++j)
               // The counting of the samples are done in BaseCase() so no
               // book-keeping is required here.
               BaseCase(queryIndex,
-                  referenceNode.Descendant(distinctSamples[j]));
+                  referenceNode.Descendant(samples[j]));
           }
 
           // Update the number of samples made for the query node and also
@@ -805,13 +802,14 @@ InsertNeighbor(
     const size_t neighbor,
     const double dist)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  std::vector<Candidate>& pqueue = candidates[queryIndex];
   Candidate c = std::make_pair(dist, neighbor);
 
-  if (CandidateCmp()(c, pqueue.top()))
+  if (CandidateCmp()(c, pqueue.front()))
   {
-    pqueue.pop();
-    pqueue.push(c);
+    std::pop_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
+    pqueue.back() = c;
+    std::push_heap(pqueue.begin(), pqueue.end(), CandidateCmp());
   }
 }
 
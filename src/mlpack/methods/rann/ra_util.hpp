@@ -47,6 +47,38 @@ class RAUtil
                                    const size_t k,
                                    const size_t m,
                                    const size_t t);
+
+  /**
+   * Draw m distinct random indices from [0, n) and store them in the given
+   * vector (in increasing order).  The memory of the vector is reused, so
+   * nothing is allocated if the vector has already held m indices.  This takes
+   * O(m^2) time in the worst case, so it is meant for small m (such as the
+   * number of samples taken from a single tree node).
+   *
+   * @param n Size of the set to sample from.
+   * @param m Number of samples to draw (must not be larger than n).
+   * @param samples Vector to store the samples in.
+   */
+  static void ObtainDistinctSamples(const size_t n,
+                                    const size_t m,
+                                    std::vector<size_t>& samples);
+
+  /**
+   * Draw m distinct random indices from [0, n), where n is the size of the
+   * given permutation vector, by shuffling the first m elements of the vector;
+   * the samples are the first m elements of the vector afterwards.  The vector
+   * must hold a permutation of [0, n) (if it does not have n elements, it is
+   * reset to the identity permutation first), and it still holds one
+   * afterwards, so it can be reused for the next draw without any allocation.
+   * This takes O(m) time.
+   *
+   * @param n Size of the set to sample from.
+   * @param m Number of samples to draw (must not be larger than n).
+   * @param permutation Permutation of [0, n) to shuffle.
+   */
+  static void PartialShuffle(const size_t n,
+                             const size_t m,
+                             std::vector<size_t>& permutation);
 };
 
 } // namespace mlpack
@@ -164,6 +164,52 @@ inline double RAUtil::SuccessProbability(const size_t n,
   } // For k > 1.
 }
 
+inline void RAUtil::ObtainDistinctSamples(const size_t n,
+                                          const size_t m,
+                                          std::vector<size_t>& samples)
+{
+  // This is Floyd's algorithm: for each j in [n - m, n), a random index in
+  // [0, j] is added, or j itself if the random index was already taken.  This
+  // gives a uniformly random subset.  The samples are kept sorted so that
+  // membership can be checked with a binary search.
+  samples.clear();
+  for (size_t j = n - m; j < n; ++j)
+  {
+    const size_t t = std::min((size_t) (Random() * (double) (j + 1)), j);
+    std::vector<size_t>::iterator it = std::lower_bound(samples.begin(),
+        samples.end(), t);
+    if (it != samples.end() && *it == t)
+    {
+      // j is larger than any sample so far.
+      samples.push_back(j);
+    }
+    else
+    {
+      samples.insert(it, t);
+    }
+  }
+}
+
+inline void RAUtil::PartialShuffle(const size_t n,
+                                   const size_t m,
+                                   std::vector<size_t>& permutation)
+{
+  if (permutation.size() != n)
+  {
+    permutation.resize(n);
+    for (size_t i = 0; i < n; ++i)
+      permutation[i] = i;
+  }
+
+  // The first m steps of a Fisher-Yates shuffle.
+  for (size_t i = 0; i < m; ++i)
+  {
+    const size_t j = i + std::min((size_t) (Random() * (double) (n - i)),
+        n - i - 1);
+    std::swap(permutation[i], permutation[j]);
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -0,0 +1,139 @@
+/**
+ * @file methods/regularized_svd/stratified_sgd.hpp
+ *
+ * A block-parallel (stratified) SGD optimizer for matrix factorization
+ * objectives, shared by RegularizedSVDFunction, BiasSVDFunction and
+ * SVDPlusPlusFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Stratified SGD (DSGD) for matrix factorization.  The users and the items are
+ * each split into B groups with about the same number of ratings, which splits
+ * the ratings into B x B blocks.  An epoch is made of B sub-epochs; in each
+ * sub-epoch, B blocks that share no user and no item are processed in
+ * parallel, so every thread updates its own user and item parameters and no
+ * locks or atomic operations are needed.  The ratings are copied once into
+ * block order, and are sorted by user inside each block, so that each thread
+ * streams through contiguous memory.
+ *
+ * Only the order of the sub-epochs is shuffled on each epoch; the ratings
+ * themselves are never reordered after construction.
+ *
+ * The function to optimize must provide the following methods:
+ *
+ * @code
+ * // Take one SGD step on the given rating, updating only the parameters of
+ * // the given user and item.
+ * void UpdateRating(arma::mat& parameters, const size_t user,
+ *                   const size_t item, const double rating,
+ *                   const double stepSize) const;
+ *
+ * // Evaluate the objective on the given batch of ratings.
+ * double Evaluate(const arma::mat& parameters, const size_t start,
+ *                 const size_t batchSize) const;
+ *
+ * size_t NumFunctions() const;
+ * @endcode
+ *
+ * For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-scale matrix factorization with distributed stochastic
+ *       gradient descent},
+ *   author={Gemulla, R. and Nijkamp, E. and Haas, P.J. and Sismanis, Y.},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining (KDD '11)},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ */
+class StratifiedSGD
+{
+ public:
+  /**
+   * Partition the given ratings into blocks.
+   *
+   * @param data Rating data in the form of a (user, item, rating) table.
+   * @param numUsers Number of users in the data.
+   * @param numItems Number of items in the data.
+   * @param numBlocks Number of user groups and item groups (0 means the number
+   *     of OpenMP threads).
+   */
+  StratifiedSGD(const arma::mat& data,
+                const size_t numUsers,
+                const size_t numItems,
+                const size_t numBlocks = 0);
+
+  /**
+   * Optimize the given function, starting from the given parameters.  Each
+   * iteration is one epoch over all of the ratings.  The optimization stops
+   * after maxIterations epochs (0 means no limit), or when the objective
+   * changes by less than the tolerance from one epoch to the next.
+   *
+   * @param function Function to optimize.
+   * @param parameters Starting point; the result is stored here.
+   * @param maxIterations Maximum number of epochs (0 means no limit).
+   * @param tolerance Tolerance on the change of the objective.
+   * @param shuffle Whether to shuffle the order of the sub-epochs.
+   * @param decayPolicy Step size policy; StepSize(epoch) is called once per
+   *     epoch.
+   * @return Objective at the last evaluation.
+   */
+  template<typename FunctionType, typename DecayPolicyType>
+  double Optimize(const FunctionType& function,
+                  arma::mat& parameters,
+                  const size_t maxIterations,
+                  const double tolerance,
+                  const bool shuffle,
+                  DecayPolicyType& decayPolicy) const;
+
+  //! Get the number of user groups and item groups.
+  size_t NumBlocks() const { return numBlocks; }
+
+  //! Get the ratings, in block order.
+  const arma::mat& BlockedData() const { return blockedData; }
+
+  //! Get the first rating of each block; block (b, c) holds the ratings of
+  //! user group b and item group c, and starts at index b * NumBlocks() + c.
+  const arma::Col<size_t>& BlockStarts() const { return blockStarts; }
+
+ private:
+  /**
+   * Assign each of the given IDs to one of numBlocks groups, so that every
+   * group has about the same number of ratings.
+   *
+   * @param ids IDs of each rating.
+   * @param numIds Number of distinct IDs.
+   * @param groups Group of each ID.
+   */
+  void Group(const arma::rowvec& ids,
+             const size_t numIds,
+             arma::Col<size_t>& groups) const;
+
+  //! Number of user groups and item groups.
+  size_t numBlocks;
+  //! The ratings, in block order.
+  arma::mat blockedData;
+  //! The first rating of each block (plus the total number of ratings).
+  arma::Col<size_t> blockStarts;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "stratified_sgd_impl.hpp"
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file methods/regularized_svd/stratified_sgd_impl.hpp
+ *
+ * Implementation of the StratifiedSGD class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stratified_sgd.hpp"
+
+namespace mlpack {
+
+inline StratifiedSGD::StratifiedSGD(const arma::mat& data,
+                                    const size_t numUsers,
+                                    const size_t numItems,
+                                    const size_t numBlocksIn) :
+    numBlocks(numBlocksIn)
+{
+  if (numBlocks == 0)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      numBlocks = omp_get_max_threads();
+    #else
+      numBlocks = 1;
+    #endif
+  }
+  numBlocks = std::max((size_t) 1,
+      std::min(numBlocks, std::min(numUsers, numItems)));
+
+  arma::Col<size_t> userGroups, itemGroups;
+  Group(data.row(0), numUsers, userGroups);
+  Group(data.row(1), numItems, itemGroups);
+
+  // Count the ratings of each block.
+  arma::Col<size_t> blocks(data.n_cols);
+  blockStarts.zeros(numBlocks * numBlocks + 1);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    blocks[i] = userGroups[(size_t) data(0, i)] * numBlocks +
+        itemGroups[(size_t) data(1, i)];
+    ++blockStarts[blocks[i] + 1];
+  }
+  for (size_t b = 1; b < blockStarts.n_elem; ++b)
+    blockStarts[b] += blockStarts[b - 1];
+
+  // Copy the ratings in block order.  Visiting them by user keeps them sorted
+  // by user inside each block.
+  const arma::uvec order = arma::stable_sort_index(data.row(0));
+  arma::Col<size_t> next = blockStarts.head(numBlocks * numBlocks);
+  blockedData.set_size(3, data.n_cols);
+  for (size_t k = 0; k < order.n_elem; ++k)
+  {
+    const size_t i = order[k];
+    blockedData.col(next[blocks[i]]++) = data.submat(0, i, 2, i);
+  }
+}
+
+inline void StratifiedSGD::Group(const arma::rowvec& ids,
+                                 const size_t numIds,
+                                 arma::Col<size_t>& groups) const
+{
+  arma::Col<size_t> counts(numIds, arma::fill::zeros);
+  for (size_t i = 0; i < ids.n_elem; ++i)
+    ++counts[(size_t) ids[i]];
+
+  // The IDs are visited in random order, so that the groups do not depend on
+  // how the IDs were assigned.
+  const arma::uvec order = arma::randperm(numIds);
+  const size_t total = std::max((size_t) ids.n_elem, (size_t) 1);
+  groups.set_size(numIds);
+  size_t seen = 0;
+  for (size_t k = 0; k < order.n_elem; ++k)
+  {
+    groups[order[k]] = std::min(numBlocks - 1, seen * numBlocks / total);
+    seen += counts[order[k]];
+  }
+}
+
+template<typename FunctionType, typename DecayPolicyType>
+double StratifiedSGD::Optimize(const FunctionType& function,
+                               arma::mat& parameters,
+                               const size_t maxIterations,
+                               const double tolerance,
+                               const bool shuffle,
+                               DecayPolicyType& decayPolicy) const
+{
+  // The objective is evaluated in parallel, in batches of ratings.
+  const size_t numFunctions = function.NumFunctions();
+  const size_t batchSize = 4096;
+  const size_t numBatches = (numFunctions + batchSize - 1) / batchSize;
+
+  // Sub-epoch s processes the blocks (b, (b + strata[s]) % numBlocks).
+  arma::Col<size_t> strata = arma::linspace<arma::Col<size_t>>(0,
+      numBlocks - 1, numBlocks);
+
+  double overallObjective = DBL_MAX;
+  double lastObjective;
+
+  // Iterate till the objective is within tolerance or the maximum number of
+  // allowed iterations is reached. If maxIterations is 0, this will iterate
+  // till convergence.
+  for (size_t i = 1; i != maxIterations; ++i)
+  {
+    lastObjective = overallObjective;
+    overallObjective = 0;
+
+    #pragma omp parallel for reduction(+:overallObjective) schedule(dynamic)
+    for (size_t b = 0; b < numBatches; ++b)
+    {
+      const size_t start = b * batchSize;
+      overallObjective += function.Evaluate(parameters, start,
+          std::min(batchSize, numFunctions - start));
+    }
+
+    Log::Info << "Stratified SGD: iteration " << i << ", objective "
+        << overallObjective << "." << std::endl;
+
+    if (std::isnan(overallObjective) || std::isinf(overallObjective))
+    {
+      Log::Warn << "Stratified SGD: converged to " << overallObjective
+          << "; terminating with failure. Try a smaller step size?"
+          << std::endl;
+      return overallObjective;
+    }
+
+    if (std::abs(lastObjective - overallObjective) < tolerance)
+    {
+      Log::Info << "Stratified SGD: minimized within tolerance " << tolerance
+          << "; terminating optimization." << std::endl;
+      return overallObjective;
+    }
+
+    const double stepSize = decayPolicy.StepSize(i);
+
+    if (shuffle)
+      std::shuffle(strata.begin(), strata.end(), RandGen());
+
+    for (size_t s = 0; s < numBlocks; ++s)
+    {
+      // The blocks of a sub-epoch share no user and no item.
+      #pragma omp parallel for schedule(dynamic, 1)
+      for (size_t b = 0; b < numBlocks; ++b)
+      {
+        const size_t block = b * numBlocks + (b + strata[s]) % numBlocks;
+        for (size_t j = blockStarts[block]; j < blockStarts[block + 1]; ++j)
+        {
+          const double* rating = blockedData.colptr(j);
+          function.UpdateRating(parameters, (size_t) rating[0],
+              (size_t) rating[1], rating[2], stepSize);
+        }
+      }
+    }
+  }
+
+  Log::Info << "Stratified SGD terminated with objective " << overallObjective
+      << "." << std::endl;
+
+  return overallObjective;
+}
+
+} // namespace mlpack
+
+#endif
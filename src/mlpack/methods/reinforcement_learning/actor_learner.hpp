@@ -0,0 +1,248 @@
+/**
+ * @file methods/reinforcement_learning/actor_learner.hpp
+ *
+ * This file is the definition of the actor/learner training loop shared by
+ * the DDPG, TD3 and SAC agents.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ACTOR_LEARNER_HPP
+#define MLPACK_METHODS_RL_ACTOR_LEARNER_HPP
+
+#include <mlpack/core.hpp>
+
+#include "training_config.hpp"
+
+namespace mlpack {
+
+/**
+ * Train an off-policy agent with decoupled actors and learner, in the style of
+ * Ape-X.  Several actors, each with its own copy of the environment and of the
+ * policy network, collect experience into the shared replay; at the same
+ * time, one learner samples batches from the replay and updates the networks.
+ * Every `publishInterval` updates, the learner publishes a snapshot of the
+ * parameters of the policy network, which the actors pick up before their
+ * next step.  The environment steps are thus not tied to the latency of the
+ * updates.
+ *
+ * With OpenMP, thread 0 is the learner and the other threads share the actors.
+ * When only one thread is available, that thread steps each actor once, then
+ * does one update, in turn.
+ *
+ * The replay is guarded by a lock, so that the actors store transitions while
+ * the learner only holds the lock to sample a batch.  As the transitions of
+ * all the actors are interleaved, the replay must not build n-step
+ * transitions when there is more than one actor.
+ *
+ * @param config Hyper-parameters for training; `StepLimit()` limits the
+ *     episodes of the actors, and the learner starts once
+ *     `ExplorationSteps()` steps have been taken.
+ * @param environment Environment to copy into each actor.
+ * @param policyNetwork The policy network updated by the learner.
+ * @param replayMethod The replay shared by the actors and the learner.
+ * @param actors Number of actors.
+ * @param steps Total number of environment steps, over all the actors.
+ * @param publishInterval Number of updates between two snapshots of the
+ *     policy network.
+ * @param act Function that selects the exploratory action of a state, called
+ *     as `act(network, state, action, actor)` with the network of the actor.
+ * @param update Function that updates the networks from a sampled batch,
+ *     called as `update(states, actions, rewards, nextStates, isTerminal,
+ *     updates)`, where `updates` counts the updates including this one.
+ * @return The average return of the episodes completed by the actors (0 if
+ *     no episode was completed).
+ */
+template<
+  typename EnvironmentType,
+  typename PolicyNetworkType,
+  typename ReplayType,
+  typename ActFunctionType,
+  typename UpdateFunctionType
+>
+double ActorLearnerTrain(const TrainingConfig& config,
+                         const EnvironmentType& environment,
+                         const PolicyNetworkType& policyNetwork,
+                         ReplayType& replayMethod,
+                         const size_t actors,
+                         const size_t steps,
+                         const size_t publishInterval,
+                         ActFunctionType act,
+                         UpdateFunctionType update)
+{
+  using StateType = typename EnvironmentType::State;
+  using ActionType = typename EnvironmentType::Action;
+
+  if (actors == 0)
+  {
+    throw std::invalid_argument("ActorLearnerTrain(): the number of actors "
+        "must be positive!");
+  }
+
+  if (publishInterval == 0)
+  {
+    throw std::invalid_argument("ActorLearnerTrain(): the publish interval "
+        "must be positive!");
+  }
+
+  if (actors > 1 && replayMethod.NSteps() > 1)
+  {
+    throw std::invalid_argument("ActorLearnerTrain(): n-step replay cannot be "
+        "shared by several actors!");
+  }
+
+  // Everything an actor needs to run its own episodes.
+  struct Actor
+  {
+    EnvironmentType environment;
+    PolicyNetworkType network;
+    size_t version;
+    StateType state;
+    size_t episodeSteps;
+    double episodeReturn;
+  };
+
+  std::vector<Actor> actorPool;
+  actorPool.reserve(actors);
+  for (size_t i = 0; i < actors; ++i)
+    actorPool.push_back({ environment, policyNetwork, 0, StateType(), 0, 0 });
+
+  // The published parameters of the policy network.
+  arma::mat snapshot = policyNetwork.Parameters();
+  std::atomic<size_t> version(0);
+
+  std::atomic<size_t> environmentSteps(0);
+  std::atomic<size_t> finishedActors(0);
+  size_t updates = 0;
+  double totalReturn = 0.0;
+  size_t episodes = 0;
+
+  // Take one step with the given actor; return false once all the steps are
+  // taken.
+  auto actorStep = [&](Actor& actor)
+  {
+    if (environmentSteps++ >= steps)
+      return false;
+
+    // Pick up the latest snapshot of the policy network.
+    if (actor.version != version.load())
+    {
+      #pragma omp critical(actor_learner_snapshot)
+      {
+        actor.network.Parameters() = snapshot;
+        actor.version = version.load();
+      }
+    }
+
+    if (actor.episodeSteps == 0)
+      actor.state = actor.environment.InitialSample();
+
+    ActionType action;
+    act(actor.network, actor.state, action, &actor - &actorPool[0]);
+
+    StateType nextState;
+    const double reward = actor.environment.Sample(actor.state, action,
+        nextState);
+    const bool isEnd = actor.environment.IsTerminal(nextState);
+
+    #pragma omp critical(actor_learner_replay)
+    replayMethod.Store(actor.state, action, reward, nextState, isEnd,
+        config.Discount());
+
+    actor.state = nextState;
+    actor.episodeReturn += reward;
+    ++actor.episodeSteps;
+    if (isEnd || (config.StepLimit() &&
+        actor.episodeSteps >= config.StepLimit()))
+    {
+      #pragma omp critical(actor_learner_return)
+      {
+        totalReturn += actor.episodeReturn;
+        ++episodes;
+      }
+      actor.episodeSteps = 0;
+      actor.episodeReturn = 0.0;
+    }
+
+    return true;
+  };
+
+  // Do one update, if enough experience has been collected.
+  auto learnerStep = [&]()
+  {
+    if (environmentSteps.load() < std::max(config.ExplorationSteps(),
+        (size_t) 1))
+    {
+      std::this_thread::yield();
+      return;
+    }
+
+    arma::mat sampledStates;
+    std::vector<ActionType> sampledActions;
+    arma::rowvec sampledRewards;
+    arma::mat sampledNextStates;
+    arma::irowvec isTerminal;
+
+    #pragma omp critical(actor_learner_replay)
+    replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, isTerminal);
+
+    update(sampledStates, sampledActions, sampledRewards, sampledNextStates,
+        isTerminal, ++updates);
+
+    if (updates % publishInterval == 0)
+    {
+      #pragma omp critical(actor_learner_snapshot)
+      snapshot = policyNetwork.Parameters();
+      ++version;
+    }
+  };
+
+  #pragma omp parallel num_threads(actors + 1)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      const size_t thread = omp_get_thread_num();
+      const size_t threads = omp_get_num_threads();
+    #else
+      const size_t thread = 0;
+      const size_t threads = 1;
+    #endif
+
+    if (threads == 1)
+    {
+      bool running = true;
+      while (running)
+      {
+        for (size_t i = 0; i < actors; ++i)
+          running = actorStep(actorPool[i]) && running;
+        if (running)
+          learnerStep();
+      }
+    }
+    else if (thread == 0)
+    {
+      while (finishedActors.load() < threads - 1)
+        learnerStep();
+    }
+    else
+    {
+      // The actors are shared round-robin by the threads other than the
+      // learner.
+      bool running = true;
+      while (running)
+      {
+        for (size_t i = thread - 1; i < actors; i += threads - 1)
+          running = actorStep(actorPool[i]) && running;
+      }
+      ++finishedActors;
+    }
+  }
+
+  return (episodes == 0) ? 0.0 : totalReturn / episodes;
+}
+
+} // namespace mlpack
+
+#endif
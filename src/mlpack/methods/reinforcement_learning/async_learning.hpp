@@ -26,6 +26,13 @@ namespace mlpack {
  * e.g. async one-step Q-learning, async one-step Sarsa,
  * async n-step Q-learning and async advantage actor-critic.
  *
+ * The workers share the learning and target networks without any lock, as in
+ * Hogwild: each worker accumulates its gradients in its own buffers, applies
+ * them directly to the shared parameters, and copies the shared parameters
+ * into its local networks; the total step count is an atomic counter, so
+ * exactly one worker syncs the target network at each sync interval.  Each
+ * worker computes its targets with its own copy of the target network.
+ *
  * For more details, see the following:
  * @code
  * @inproceedings{mnih2016asynchronous,
@@ -68,7 +68,9 @@ void AsyncLearning<
   if (learningNetwork.Parameters().n_elem != environment.InitialSample().Encode().n_elem)
     learningNetwork.Reset(environment.InitialSample().Encode().n_elem);
   NetworkType targetNetwork = learningNetwork;
-  size_t totalSteps = 0;
+  // The step counter is atomic, and the workers update the parameters of
+  // `learningNetwork` without locks (as in Hogwild).
+  std::atomic<size_t> totalSteps(0);
   PolicyType policy = this->policy;
   bool stop = false;
 
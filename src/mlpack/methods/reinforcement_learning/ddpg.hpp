@@ -19,6 +19,7 @@
 
 #include "replay/replay.hpp"
 #include "training_config.hpp"
+#include "actor_learner.hpp"
 
 namespace mlpack {
 
@@ -122,6 +123,24 @@ class DDPG
    */
   double Episode();
 
+  /**
+   * Train with decoupled actors and learner, in the style of Ape-X (see
+   * `ActorLearnerTrain()`): the given number of actors collect experience
+   * into the replay on their own threads, while the learner updates the
+   * networks continuously and publishes the parameters of the policy network
+   * to the actors every `publishInterval` updates.  The target networks are
+   * then synced every `TargetNetworkSyncInterval()` updates.
+   *
+   * @param actors Number of actors.
+   * @param steps Total number of environment steps, over all the actors.
+   * @param publishInterval Number of updates between two snapshots of the
+   *     policy network given to the actors.
+   * @return The average return of the episodes completed by the actors.
+   */
+  double TrainActorLearner(const size_t actors,
+                           const size_t steps,
+                           const size_t publishInterval = 1);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -142,6 +161,30 @@ class DDPG
 
 
  private:
+  /**
+   * Update the Q and policy networks with the given batch of experience.
+   */
+  void Update(const arma::mat& sampledStates,
+              const std::vector<ActionType>& sampledActions,
+              const arma::rowvec& sampledRewards,
+              const arma::mat& sampledNextStates,
+              const arma::irowvec& isTerminal);
+
+  /**
+   * Select an action for the given state with the given policy network.
+   *
+   * @param network Policy network to use.
+   * @param state State to act in.
+   * @param action The selected action.
+   * @param noise The noise instance for exploration.
+   * @param explore Whether to add exploration noise to the action.
+   */
+  void SelectAction(PolicyNetworkType& network,
+                    StateType& state,
+                    ActionType& action,
+                    NoiseType& noise,
+                    const bool explore);
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -182,6 +182,32 @@ void DDPG<
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
+  Update(sampledStates, sampledActions, sampledRewards, sampledNextStates,
+      isTerminal);
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename NoiseType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void DDPG<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  NoiseType,
+  UpdaterType,
+  ReplayType
+>::Update(
+    const arma::mat& sampledStates,
+    const std::vector<ActionType>& sampledActions,
+    const arma::rowvec& sampledRewards,
+    const arma::mat& sampledNextStates,
+    const arma::irowvec& isTerminal)
+{
   // Critic network update.
 
   // Use the target actor to obtain the next actions.
@@ -280,12 +306,37 @@ void DDPG<
   UpdaterType,
   ReplayType
 >::SelectAction()
+{
+  SelectAction(policyNetwork, state, action, noise, !deterministic);
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename NoiseType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void DDPG<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  NoiseType,
+  UpdaterType,
+  ReplayType
+>::SelectAction(
+    PolicyNetworkType& network,
+    StateType& state,
+    ActionType& action,
+    NoiseType& noise,
+    const bool explore)
 {
   // Get the action at current state, from policy.
   arma::colvec outputAction;
-  policyNetwork.Predict(state.Encode(), outputAction);
+  network.Predict(state.Encode(), outputAction);
 
-  if (!deterministic)
+  if (explore)
   {
     arma::colvec sample = noise.sample() * 0.1;
     sample = arma::clamp(sample, -0.25, 0.25);
@@ -350,5 +401,55 @@ double DDPG<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename NoiseType,
+  typename UpdaterType,
+  typename ReplayType
+>
+double DDPG<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  NoiseType,
+  UpdaterType,
+  ReplayType
+>::TrainActorLearner(
+    const size_t actors,
+    const size_t steps,
+    const size_t publishInterval)
+{
+  // Each actor explores with its own copy of the noise process.
+  std::vector<NoiseType> noises(actors, noise);
+
+  // While training, the learner owns `totalSteps`, which counts the updates,
+  // so that the target networks are synced every
+  // `TargetNetworkSyncInterval()` updates.
+  const size_t startSteps = totalSteps;
+  const double averageReturn = ActorLearnerTrain(config, environment,
+      policyNetwork, replayMethod, actors, steps, publishInterval,
+      [this, &noises](PolicyNetworkType& network, StateType& state,
+          ActionType& action, const size_t actor)
+      {
+        SelectAction(network, state, action, noises[actor], true);
+      },
+      [this](const arma::mat& sampledStates,
+          const std::vector<ActionType>& sampledActions,
+          const arma::rowvec& sampledRewards,
+          const arma::mat& sampledNextStates,
+          const arma::irowvec& isTerminal,
+          const size_t updates)
+      {
+        totalSteps = updates;
+        Update(sampledStates, sampledActions, sampledRewards,
+            sampledNextStates, isTerminal);
+      });
+
+  totalSteps = startSteps + steps;
+  return averageReturn;
+}
+
 } // namespace mlpack
 #endif
@@ -0,0 +1,171 @@
+/**
+ * @file methods/reinforcement_learning/environment/vector_environment.hpp
+ *
+ * This file is an implementation of a wrapper that steps several instances of
+ * an environment in lockstep.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTOR_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * A vectorized environment holds several instances of an environment, and
+ * steps all of them at once with one action each.  The encoded states of the
+ * instances are kept as the columns of a matrix, so that the actions of all
+ * the instances can be chosen with a single batched forward pass of a network
+ * (for instance with `QLearning::SelectActions()`).
+ *
+ * When an instance reaches a terminal state, it is restarted with a new
+ * initial state, so the instances always hold running episodes.  `Step()`
+ * still returns the terminal states, which are the next states of the
+ * transitions.
+ *
+ * @code
+ * VectorEnvironment<CartPole> envs(16);
+ * envs.Reset();
+ *
+ * std::vector<CartPole::Action> actions;
+ * arma::rowvec rewards;
+ * arma::urowvec terminal;
+ * arma::mat nextStates;
+ * for (size_t step = 0; step < 1000; ++step)
+ * {
+ *   agent.SelectActions(envs.States(), actions);
+ *   envs.Step(actions, rewards, terminal, nextStates);
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType The type of the environment to wrap.
+ */
+template<typename EnvironmentType>
+class VectorEnvironment
+{
+ public:
+  //! Convenient typedef for state.
+  using State = typename EnvironmentType::State;
+
+  //! Convenient typedef for action.
+  using Action = typename EnvironmentType::Action;
+
+  /**
+   * Create the given number of instances, as copies of the given environment.
+   * The instances hold no state until `Reset()` is called.
+   *
+   * @param size Number of instances.
+   * @param environment Environment to copy into each instance.
+   */
+  VectorEnvironment(const size_t size,
+                    const EnvironmentType& environment = EnvironmentType()) :
+      environments(size, environment),
+      states(size)
+  {
+    if (size == 0)
+    {
+      throw std::invalid_argument("VectorEnvironment: the number of instances "
+          "must be positive!");
+    }
+  }
+
+  /**
+   * Start a new episode in each instance.
+   *
+   * @return The initial encoded states (one column per instance).
+   */
+  const arma::mat& Reset()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      states[i] = environments[i].InitialSample();
+      if (i == 0)
+        stateMatrix.set_size(states[0].Encode().n_elem, environments.size());
+      stateMatrix.col(i) = states[i].Encode();
+    }
+
+    return stateMatrix;
+  }
+
+  /**
+   * Take one step in each instance, with the given action for each.  An
+   * instance that reaches a terminal state is restarted, so `States()` then
+   * holds its new initial state.
+   *
+   * @param actions The action of each instance.
+   * @param rewards The reward of each instance.
+   * @param terminal Whether each instance reached a terminal state.
+   * @param nextStates The encoded next state of each instance (one column per
+   *     instance), before any restart.
+   */
+  void Step(const std::vector<Action>& actions,
+            arma::rowvec& rewards,
+            arma::urowvec& terminal,
+            arma::mat& nextStates)
+  {
+    if (actions.size() != environments.size())
+    {
+      std::ostringstream oss;
+      oss << "VectorEnvironment::Step(): got " << actions.size() << " actions "
+          << "for " << environments.size() << " instances!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    if (stateMatrix.n_cols != environments.size())
+    {
+      throw std::logic_error("VectorEnvironment::Step(): Reset() must be "
+          "called before the first step!");
+    }
+
+    rewards.set_size(environments.size());
+    terminal.set_size(environments.size());
+    nextStates.set_size(stateMatrix.n_rows, environments.size());
+
+    State nextState;
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      rewards[i] = environments[i].Sample(states[i], actions[i], nextState);
+      terminal[i] = environments[i].IsTerminal(nextState);
+      nextStates.col(i) = nextState.Encode();
+
+      states[i] = terminal[i] ? environments[i].InitialSample() : nextState;
+      stateMatrix.col(i) = states[i].Encode();
+    }
+  }
+
+  //! Get the encoded current states (one column per instance).
+  const arma::mat& States() const { return stateMatrix; }
+
+  //! Get the current state of the given instance.
+  const State& InstanceState(const size_t i) const { return states[i]; }
+
+  //! Get the given instance.
+  const EnvironmentType& Environment(const size_t i) const
+  {
+    return environments[i];
+  }
+  //! Modify the given instance.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the number of instances.
+  size_t Size() const { return environments.size(); }
+
+ private:
+  //! The instances of the environment.
+  std::vector<EnvironmentType> environments;
+
+  //! The current state of each instance.
+  std::vector<State> states;
+
+  //! The encoded current states, one column per instance.
+  arma::mat stateMatrix;
+};
+
+} // namespace mlpack
+
+#endif
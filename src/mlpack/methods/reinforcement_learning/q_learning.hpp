@@ -103,6 +103,16 @@ class QLearning
    */
   void SelectAction();
 
+  /**
+   * Select an action for each of the given states with one batched forward
+   * pass of the network, for instance for the states of a
+   * `VectorEnvironment`.  The actions are chosen by the behavior policy.
+   *
+   * @param states The encoded states (one column per state).
+   * @param actions The selected action of each state.
+   */
+  void SelectActions(const arma::mat& states, std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
@@ -104,15 +104,10 @@ arma::Col<size_t> QLearning<
   ReplayType
 >::BestAction(const arma::mat& actionValues)
 {
-  // Take best possible action at a particular instance.
-  arma::Col<size_t> bestActions(actionValues.n_cols);
-  arma::rowvec maxActionValues = max(actionValues, 0);
-  for (size_t i = 0; i < actionValues.n_cols; ++i)
-  {
-    bestActions(i) = arma::as_scalar(
-        arma::find(actionValues.col(i) == maxActionValues[i], 1));
-  }
-  return bestActions;
+  // Take best possible action at a particular instance.  Ties are broken in
+  // favor of the first action.
+  return ConvTo<arma::Col<size_t>>::From(
+      arma::index_max(actionValues, 0));
 };
 
 template <
@@ -235,9 +230,15 @@ void QLearning<
 
   size_t batchSize = sampledNextStates.n_cols;
 
-  // Compute action value for next state with target network.
-  arma::mat nextActionValues;
-  targetNetwork.Predict(sampledNextStates, nextActionValues);
+  // Compute the distributions for next state with target network; their
+  // expected values are the action values, so one forward pass is enough.
+  arma::mat nextDists;
+  targetNetwork.Forward(sampledNextStates, nextDists);
+
+  arma::mat nextAtoms;
+  MakeAlias(nextAtoms, nextDists, atomSize, nextDists.n_elem / atomSize);
+  arma::mat nextActionValues = support.t() * nextAtoms;
+  nextActionValues.reshape(nextDists.n_rows / atomSize, batchSize);
 
   arma::Col<size_t> nextAction;
   if (config.DoubleQLearning())
@@ -252,32 +253,27 @@ void QLearning<
     nextAction = BestAction(nextActionValues);
   }
 
-  arma::mat nextDists, nextDist(atomSize, batchSize);
-  targetNetwork.Forward(sampledNextStates, nextDists);
+  // Project the distribution of the target of each sample onto the support:
+  // the target value of each atom is clamped to the support, and its
+  // probability is split between the two closest atoms.  This is done in a
+  // single pass, without temporary matrices.
+  const double vMin = config.VMin();
+  const double vMax = config.VMax();
+  arma::mat projDist(atomSize, batchSize, arma::fill::zeros);
   for (size_t i = 0; i < batchSize; ++i)
   {
-    nextDist.col(i) = nextDists(nextAction(i) * atomSize, i,
-        arma::size(atomSize, 1));
-  }
-
-  arma::mat tZ = (ConvTo<arma::mat>::From(config.Discount() *
-      (support * (1 - isTerminal))).each_row() + sampledRewards);
-  tZ = arma::clamp(tZ, config.VMin(), config.VMax());
-  arma::mat b = (tZ - config.VMin()) / (config.VMax() - config.VMin()) *
-      (atomSize - 1);
-  arma::mat l = arma::floor(b);
-  arma::mat u = arma::ceil(b);
-
-  arma::mat projDistUpper = nextDist % (u - b);
-  arma::mat projDistLower = nextDist % (b - l);
-
-  arma::mat projDist = zeros<arma::mat>(arma::size(nextDist));
-  for (size_t batchNo = 0; batchNo < batchSize; batchNo++)
-  {
-    for (size_t j = 0; j < atomSize; j++)
+    const double* nextDist = nextDists.colptr(i) + nextAction(i) * atomSize;
+    double* proj = projDist.colptr(i);
+    const double scale = config.Discount() * (1 - isTerminal[i]);
+    for (size_t j = 0; j < atomSize; ++j)
     {
-      projDist(l(j, batchNo), batchNo) += projDistUpper(j, batchNo);
-      projDist(u(j, batchNo), batchNo) += projDistLower(j, batchNo);
+      const double tZ = std::min(std::max(scale * support[j] +
+          sampledRewards[i], vMin), vMax);
+      const double b = (tZ - vMin) / (vMax - vMin) * (atomSize - 1);
+      const double l = std::floor(b);
+      const double u = std::ceil(b);
+      proj[(size_t) l] += nextDist[j] * (u - b);
+      proj[(size_t) u] += nextDist[j] * (b - l);
     }
   }
   arma::mat dists;
@@ -336,6 +332,33 @@ void QLearning<
   action = policy.Sample(actionValue, deterministic, config.NoisyQLearning());
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::SelectActions(const arma::mat& states, std::vector<ActionType>& actions)
+{
+  // Get the action values of all the states at once.
+  arma::mat actionValues;
+  learningNetwork.Predict(states, actionValues);
+
+  actions.resize(states.n_cols);
+  for (size_t i = 0; i < states.n_cols; ++i)
+  {
+    actions[i] = policy.Sample(actionValues.col(i), deterministic,
+        config.NoisyQLearning());
+  }
+}
+
 template <
   typename EnvironmentType,
   typename NetworkType,
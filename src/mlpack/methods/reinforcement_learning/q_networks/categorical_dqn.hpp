@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RL_CATEGORICAL_DQN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
 #include <mlpack/methods/ann/init_rules/gaussian_init.hpp>
 #include <mlpack/methods/ann/layer/layer.hpp>
@@ -125,21 +126,19 @@ class CategoricalDQN
    * @param state Input state.
    * @param actionValue Matrix to put output action values of states input.
    */
-  void Predict(const arma::mat state, arma::mat& actionValue)
+  void Predict(const arma::mat& state, arma::mat& actionValue)
   {
     arma::mat q_atoms;
     network.Predict(state, q_atoms);
-    activations.copy_size(q_atoms);
-    actionValue.set_size(q_atoms.n_rows / atomSize, q_atoms.n_cols);
-    arma::rowvec support = arma::linspace<arma::rowvec>(vMin, vMax, atomSize);
-    for (size_t i = 0; i < q_atoms.n_rows; i += atomSize)
-    {
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      arma::mat input = q_atoms.rows(i, i + atomSize - 1);
-      softMax.Forward(input, activation);
-      activations.rows(i, i + atomSize - 1) = activation;
-      actionValue.row(i/atomSize) = support * activation;
-    }
+    Distributions(q_atoms);
+
+    // The expected value of each distribution is the value of its action.
+    const arma::rowvec support = arma::linspace<arma::rowvec>(vMin, vMax,
+        atomSize);
+    arma::mat dists;
+    MakeAlias(dists, activations, atomSize, activations.n_elem / atomSize);
+    actionValue = support * dists;
+    actionValue.reshape(q_atoms.n_rows / atomSize, q_atoms.n_cols);
   }
 
   /**
@@ -148,18 +147,11 @@ class CategoricalDQN
    * @param state The input state.
    * @param dist The predicted distributions.
    */
-  void Forward(const arma::mat state, arma::mat& dist)
+  void Forward(const arma::mat& state, arma::mat& dist)
   {
     arma::mat q_atoms;
     network.Forward(state, q_atoms);
-    activations.copy_size(q_atoms);
-    for (size_t i = 0; i < q_atoms.n_rows; i += atomSize)
-    {
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      arma::mat input = q_atoms.rows(i, i + atomSize - 1);
-      softMax.Forward(input, activation);
-      activations.rows(i, i + atomSize - 1) = activation;
-    }
+    Distributions(q_atoms);
     dist = activations;
   }
 
@@ -195,19 +187,18 @@ class CategoricalDQN
    * @param lossGradients The loss gradients.
    * @param gradient The gradient.
    */
-  void Backward(const arma::mat state,
+  void Backward(const arma::mat& state,
                 arma::mat& lossGradients,
                 arma::mat& gradient)
   {
-    arma::mat activationGradients(arma::size(activations));
-    for (size_t i = 0; i < activations.n_rows; i += atomSize)
-    {
-      arma::mat activationGrad;
-      arma::mat lossGrad = lossGradients.rows(i, i + atomSize - 1);
-      arma::mat activation = activations.rows(i, i + atomSize - 1);
-      softMax.Backward({} /* unused */, activation, lossGrad, activationGrad);
-      activationGradients.rows(i, i + atomSize - 1) = activationGrad;
-    }
+    // The distributions are the columns of reshaped aliases (see
+    // Distributions()).
+    arma::mat activationGradients, lossGrad, dists;
+    MakeAlias(lossGrad, lossGradients, atomSize,
+        lossGradients.n_elem / atomSize);
+    MakeAlias(dists, activations, atomSize, activations.n_elem / atomSize);
+    softMax.Backward({} /* unused */, dists, lossGrad, activationGradients);
+    activationGradients.reshape(activations.n_rows, activations.n_cols);
     network.Backward(state, activationGradients, gradient);
   }
 
@@ -235,6 +226,21 @@ class CategoricalDQN
 
   //! Locally-stored activations from softMax.
   arma::mat activations;
+
+  /**
+   * Compute the distribution of each action from the output of the network,
+   * and store them in the activations.  Each column of the output holds the
+   * atoms of every action, one action after the other, so the distributions
+   * are the columns of an alias with atomSize rows, and can all be computed by
+   * a single softmax.
+   */
+  void Distributions(const arma::mat& q_atoms)
+  {
+    arma::mat atoms;
+    MakeAlias(atoms, q_atoms, atomSize, q_atoms.n_elem / atomSize);
+    softMax.Forward(atoms, activations);
+    activations.reshape(q_atoms.n_rows, q_atoms.n_cols);
+  }
 };
 
 } // namespace mlpack
@@ -176,7 +176,7 @@ class DuelingDQN
    * @param state Input state.
    * @param actionValue Matrix to put output action values of states input.
    */
-  void Predict(const arma::mat state, arma::mat& actionValue)
+  void Predict(const arma::mat& state, arma::mat& actionValue)
   {
     arma::mat advantage, value, networkOutput;
     completeNetwork.Predict(state, networkOutput);
@@ -191,7 +191,7 @@ class DuelingDQN
    * @param state The input state.
    * @param actionValue Matrix to put output action values of states input.
    */
-  void Forward(const arma::mat state, arma::mat& actionValue)
+  void Forward(const arma::mat& state, arma::mat& actionValue)
   {
     arma::mat advantage, value, networkOutput;
     completeNetwork.Forward(state, networkOutput);
@@ -209,7 +209,9 @@ class DuelingDQN
    * @param target The training target.
    * @param gradient The gradient.
    */
-  void Backward(const arma::mat state, arma::mat& target, arma::mat& gradient)
+  void Backward(const arma::mat& state,
+                arma::mat& target,
+                arma::mat& gradient)
   {
     arma::mat gradLoss;
     lossFunction.Backward(this->actionValues, target, gradLoss);
@@ -98,7 +98,7 @@ class SimpleDQN
    * @param state Input state.
    * @param actionValue Matrix to put output action values of states input.
    */
-  void Predict(const arma::mat state, arma::mat& actionValue)
+  void Predict(const arma::mat& state, arma::mat& actionValue)
   {
     network.Predict(state, actionValue);
   }
@@ -109,7 +109,7 @@ class SimpleDQN
    * @param state The input state.
    * @param target The predicted target.
    */
-  void Forward(const arma::mat state, arma::mat& target)
+  void Forward(const arma::mat& state, arma::mat& target)
   {
     network.Forward(state, target);
   }
@@ -146,7 +146,9 @@ class SimpleDQN
    * @param target The training target.
    * @param gradient The gradient.
    */
-  void Backward(const arma::mat state, arma::mat& target, arma::mat& gradient)
+  void Backward(const arma::mat& state,
+                arma::mat& target,
+                arma::mat& gradient)
   {
     network.Backward(state, target, gradient);
   }
@@ -0,0 +1,335 @@
+/**
+ * @file methods/reinforcement_learning/replay/compressed_replay.hpp
+ *
+ * This file is an implementation of random experience replay that stores each
+ * frame of the states once, in a compact element type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_REPLAY_COMPRESSED_REPLAY_HPP
+#define MLPACK_METHODS_RL_REPLAY_COMPRESSED_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Implementation of random experience replay for states made of stacked
+ * frames, such as image observations.  `RandomReplay` keeps a full copy of the
+ * state and of the next state of each transition, so that each frame is kept
+ * `2 * frames` times.  Instead, this replay keeps each frame once, in a ring
+ * buffer of elements of type `ElemType` (for instance `unsigned char` for
+ * pixels), and each transition only holds the index of the newest frame of its
+ * state; the newest frame of its next state is the following frame.  The
+ * stacked states are rebuilt when a batch is sampled.
+ *
+ * An encoded state must be the concatenation of `frames` frames of equal size,
+ * from the oldest to the newest, and the next state must be the state shifted
+ * by one frame, with the new frame last.  Transitions are expected in the
+ * order of the episodes: when the state of a transition is not the next state
+ * of the previous transition (at the start of an episode), all its frames are
+ * stored.  With `frames` equal to 1, any state can be stored, so the replay
+ * may also be used only to store the states with a smaller element type.
+ *
+ * Each element is stored as `value / scale` (rounded, and clamped to the range
+ * of `ElemType` for integer types), and restored as `stored * scale`; for
+ * instance, frames normalized to [0, 1] fit `unsigned char` with a scale of
+ * 1 / 255.  Only one step transitions are supported.
+ *
+ * @code
+ * // 84x84 images, stacked by 4, normalized to [0, 1].
+ * CompressedReplay<AtariEnv, unsigned char> replay(32, 1000000, 4,
+ *     1.0 / 255.0, 4 * 84 * 84);
+ * @endcode
+ *
+ * @tparam EnvironmentType Desired task.
+ * @tparam ElemType Element type in which the frames are stored.
+ */
+template<typename EnvironmentType, typename ElemType = float>
+class CompressedReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  CompressedReplay() :
+      batchSize(0),
+      capacity(0),
+      frames(1),
+      frameSize(0),
+      frameCapacity(0),
+      totalFrames(0),
+      first(0),
+      count(0),
+      scale(1.0),
+      nSteps(1)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of compressed experience replay class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param frames Number of frames stacked in a state.
+   * @param scale Scale of the stored elements.
+   * @param dimension The dimension of an encoded state.
+   */
+  CompressedReplay(const size_t batchSize,
+                   const size_t capacity,
+                   const size_t frames = 1,
+                   const double scale = 1.0,
+                   const size_t dimension = StateType::dimension) :
+      batchSize(batchSize),
+      capacity(capacity),
+      frames(frames),
+      frameSize(frames == 0 ? 0 : dimension / frames),
+      frameCapacity(capacity + frames),
+      totalFrames(0),
+      first(0),
+      count(0),
+      scale(scale),
+      nSteps(1),
+      frameData(frameSize, frameCapacity),
+      stateFrames(capacity),
+      actions(capacity),
+      rewards(capacity),
+      isTerminal(capacity)
+  {
+    if (frames == 0 || dimension % frames != 0)
+    {
+      std::ostringstream oss;
+      oss << "CompressedReplay: the state dimension (" << dimension << ") "
+          << "must be a multiple of the number of frames (" << frames << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  /**
+   * Store the given experience.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param * (discount) The discount parameter (unused: only one step
+   *     transitions are stored).
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& /* discount */)
+  {
+    const arma::colvec& encodedState = state.Encode();
+    const arma::colvec& encodedNextState = nextState.Encode();
+
+    // Store all the frames of the state, unless it is the next state of the
+    // previous transition, whose frames are the last stored ones.
+    if (!ContinuesLastTransition(encodedState))
+    {
+      for (size_t f = 0; f < frames; ++f)
+        StoreFrame(encodedState.subvec(f * frameSize, (f + 1) * frameSize - 1));
+    }
+
+    const size_t stateFrame = totalFrames - 1;
+    StoreFrame(encodedNextState.tail(frameSize));
+
+    if (count == capacity)
+    {
+      first = (first + 1) % capacity;
+      --count;
+    }
+
+    const size_t slot = (first + count) % capacity;
+    stateFrames[slot] = stateFrame;
+    actions[slot] = action;
+    rewards(slot) = reward;
+    isTerminal(slot) = isEnd;
+    ++count;
+
+    // Forget the transitions whose oldest frame was overwritten.
+    while (count > 0 && stateFrames[first] + 1 + frameCapacity <
+        totalFrames + frames)
+    {
+      first = (first + 1) % capacity;
+      --count;
+    }
+  }
+
+  /**
+   * Sample some experiences.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    arma::uvec sampledIndices = randi<arma::uvec>(
+        batchSize, arma::distr_param(0, count - 1));
+
+    sampledStates.set_size(frames * frameSize, batchSize);
+    sampledNextStates.set_size(frames * frameSize, batchSize);
+    sampledActions.resize(batchSize);
+    sampledRewards.set_size(batchSize);
+    isTerminal.set_size(batchSize);
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      const size_t slot = (first + sampledIndices[i]) % capacity;
+      const size_t stateFrame = stateFrames[slot];
+      for (size_t f = 0; f < frames; ++f)
+      {
+        sampledStates.col(i).subvec(f * frameSize, (f + 1) * frameSize - 1) =
+            LoadFrame(stateFrame + 1 + f - frames);
+        sampledNextStates.col(i).subvec(f * frameSize,
+            (f + 1) * frameSize - 1) = LoadFrame(stateFrame + 2 + f - frames);
+      }
+
+      sampledActions[i] = actions[slot];
+      sampledRewards[i] = rewards[slot];
+      isTerminal[i] = this->isTerminal[slot];
+    }
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size
+   */
+  const size_t& Size() { return count; }
+
+  /**
+   * Update the priorities of transitions and Update the gradients.
+   *
+   * @param * (target) The learned value
+   * @param * (sampledActions) Agent's sampled action
+   * @param * (nextActionValues) Agent's next action
+   * @param * (gradients) The model's gradients
+   */
+  void Update(arma::mat /* target */,
+              std::vector<ActionType> /* sampledActions */,
+              arma::mat /* nextActionValues */,
+              arma::mat& /* gradients */)
+  {
+    /* Do nothing for compressed replay. */
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return nSteps; }
+
+  //! Get the number of frames stacked in a state.
+  size_t Frames() const { return frames; }
+
+ private:
+  //! Check whether the given encoded state is made of the last stored frames.
+  bool ContinuesLastTransition(const arma::colvec& encodedState) const
+  {
+    if (count == 0 || isTerminal[(first + count - 1) % capacity])
+      return false;
+
+    for (size_t f = 0; f < frames; ++f)
+    {
+      const arma::Col<ElemType> frame = Compress(encodedState.subvec(
+          f * frameSize, (f + 1) * frameSize - 1));
+      if (arma::any(frame != frameData.col((totalFrames - frames + f) %
+          frameCapacity)))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  //! Convert the given frame to the storage type.
+  arma::Col<ElemType> Compress(const arma::colvec& frame) const
+  {
+    if (std::is_integral<ElemType>::value)
+    {
+      return arma::conv_to<arma::Col<ElemType>>::from(arma::clamp(
+          arma::round(frame / scale),
+          (double) std::numeric_limits<ElemType>::lowest(),
+          (double) std::numeric_limits<ElemType>::max()));
+    }
+
+    return arma::conv_to<arma::Col<ElemType>>::from(frame / scale);
+  }
+
+  //! Store the given frame after the last stored frame.
+  void StoreFrame(const arma::colvec& frame)
+  {
+    frameData.col(totalFrames % frameCapacity) = Compress(frame);
+    ++totalFrames;
+  }
+
+  //! Restore the frame with the given index.
+  arma::colvec LoadFrame(const size_t index) const
+  {
+    return arma::conv_to<arma::colvec>::from(frameData.col(index %
+        frameCapacity)) * scale;
+  }
+
+  //! Locally-stored number of examples of each sample.
+  size_t batchSize;
+
+  //! Locally-stored total memory limit.
+  size_t capacity;
+
+  //! Locally-stored number of frames stacked in a state.
+  size_t frames;
+
+  //! Locally-stored number of elements of a frame.
+  size_t frameSize;
+
+  //! Locally-stored number of frames kept in memory.
+  size_t frameCapacity;
+
+  //! Locally-stored number of frames stored so far.
+  size_t totalFrames;
+
+  //! Locally-stored position of the oldest transition.
+  size_t first;
+
+  //! Locally-stored number of transitions in memory.
+  size_t count;
+
+  //! Locally-stored scale of the stored elements.
+  double scale;
+
+  //! Locally-stored number of steps to look into the future.
+  size_t nSteps;
+
+  //! Locally-stored frames (one column per frame), as a ring buffer.
+  arma::Mat<ElemType> frameData;
+
+  //! Locally-stored index of the newest frame of the state of each transition.
+  std::vector<size_t> stateFrames;
+
+  //! Locally-stored previous actions.
+  std::vector<ActionType> actions;
+
+  //! Locally-stored previous rewards.
+  arma::rowvec rewards;
+
+  //! Locally-stored termination information of previous experience.
+  arma::irowvec isTerminal;
+};
+
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_RL_PRIORITIZED_REPLAY_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <deque>
 #include "sumtree.hpp"
 
 namespace mlpack {
@@ -196,14 +197,19 @@ class PrioritizedReplay
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
-    double totalSum = idxSum.Sum(0, (full ? capacity : position));
-    double sumPerRange = totalSum / batchSize;
-    for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+    // Stratified sampling: one mass is drawn uniformly from each of batchSize
+    // equal ranges of the total priority, and all the masses are searched in
+    // the tree together.
+    const double totalSum = idxSum.Sum(0, (full ? capacity : position));
+    const double sumPerRange = totalSum / batchSize;
+    arma::colvec masses = (arma::randu<arma::colvec>(batchSize) +
+        arma::regspace<arma::colvec>(0, batchSize - 1)) * sumPerRange;
+
+    arma::ucolvec idxes;
+    idxSum.FindPrefixSums(masses, idxes);
+
+    // Rounding may push the last masses past the stored transitions.
+    idxes.clamp(0, Size() - 1);
     return idxes;
   }
 
@@ -227,22 +233,21 @@ class PrioritizedReplay
     BetaAnneal();
 
     sampledStates = states.cols(sampledIndices);
+    sampledActions.resize(sampledIndices.n_rows);
     for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
+      sampledActions[t] = actions[sampledIndices[t]];
     sampledRewards = rewards.elem(sampledIndices).t();
     sampledNextStates = nextStates.cols(sampledIndices);
     isTerminal = this->isTerminal.elem(sampledIndices).t();
 
     // Calculate the weights of sampled transitions.
-
-    size_t numSample = full ? capacity : position;
-    weights = arma::rowvec(sampledIndices.n_rows);
-
+    const size_t numSample = full ? capacity : position;
+    const double totalSum = idxSum.Sum();
+    weights.set_size(sampledIndices.n_rows);
     for (size_t i = 0; i < sampledIndices.n_rows; ++i)
-    {
-      double p_sample = idxSum.Get(sampledIndices(i)) / idxSum.Sum();
-      weights(i) = std::pow(numSample * p_sample, -beta);
-    }
+      weights(i) = idxSum.Get(sampledIndices(i));
+
+    weights = arma::pow(numSample * weights / totalSum, -beta);
     weights /= weights.max();
   }
 
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <cassert>
+#include <deque>
 
 namespace mlpack {
 
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_REINFORCEMENT_LEARNING_REPLAY_REPLAY_HPP
 
 #include "random_replay.hpp"
+#include "compressed_replay.hpp"
 #include "prioritized_replay.hpp"
 #include "sumtree.hpp"
 
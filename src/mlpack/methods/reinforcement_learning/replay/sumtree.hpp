@@ -67,20 +67,40 @@ class SumTree
 
   /**
    * Update the data with batch rather loop over the indices with set method.
+   * Only the ancestors of the changed elements are recomputed, each of them
+   * once, so the cost is O(k log n) for k indices instead of O(n).
    *
    * @param indices The indices of data to be changed.
    * @param data The data that array with indices to be.
    */
   void BatchUpdate(const arma::ucolvec& indices, const arma::Col<T>& data)
   {
+    std::vector<size_t> nodes;
+    nodes.reserve(indices.n_elem);
     for (size_t i = 0; i < indices.n_rows; ++i)
     {
       element[indices[i] + capacity] = data[i];
+      if (indices[i] + capacity > 1)
+        nodes.push_back((indices[i] + capacity) / 2);
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Update the tree bottom-up, one level at a time.  The parents of each
+    // level are deduplicated, so that a node shared by several changed
+    // elements is only recomputed once.
+    while (!nodes.empty())
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      std::sort(nodes.begin(), nodes.end());
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+      for (size_t i = 0; i < nodes.size(); ++i)
+      {
+        element[nodes[i]] = element[2 * nodes[i]] + element[2 * nodes[i] + 1];
+        nodes[i] /= 2;
+      }
+
+      // The root has been reached: nodes that were already at the root are
+      // now 0.
+      nodes.erase(std::remove(nodes.begin(), nodes.end(), size_t(0)),
+          nodes.end());
     }
   }
 
@@ -89,7 +109,7 @@ class SumTree
    *
    * @param idx The array idx to get data.
    */
-  T Get(size_t idx)
+  T Get(size_t idx) const
   {
     idx += capacity;
     return element[idx];
@@ -108,7 +128,7 @@ class SumTree
               const size_t end,
               const size_t node,
               const size_t nodeStart,
-              const size_t nodeEnd)
+              const size_t nodeEnd) const
   {
     if (start == nodeStart && end == nodeEnd)
     {
@@ -139,7 +159,7 @@ class SumTree
    * @param start The starting position of subsequence.
    * @param end The end position of subsequence.
    */
-  T Sum(const size_t start, size_t end)
+  T Sum(const size_t start, size_t end) const
   {
     end -= 1;
     return SumHelper(start, end, 1, 0, capacity - 1);
@@ -148,9 +168,9 @@ class SumTree
   /**
    * Shortcut for calculating the sum of whole array.
    */
-  T Sum()
+  T Sum() const
   {
-    return Sum(0, capacity);
+    return element[1];
   }
 
   /**
@@ -159,7 +179,7 @@ class SumTree
    *
    * @param mass The upper bound of segment array sum.
    */
-  size_t FindPrefixSum(T mass)
+  size_t FindPrefixSum(T mass) const
   {
     size_t idx = 1;
     while (idx < capacity)
@@ -177,6 +197,42 @@ class SumTree
     return idx - capacity;
   }
 
+  /**
+   * Call `FindPrefixSum()` for each of the given masses.  All the searches
+   * descend the tree together, one level at a time, so that each level of the
+   * array is traversed once for the whole batch instead of once per search.
+   *
+   * @param masses The upper bounds of segment array sum.
+   * @param indices The found indices, one for each mass.
+   */
+  void FindPrefixSums(arma::Col<T> masses, arma::ucolvec& indices) const
+  {
+    indices.ones(masses.n_elem);
+    bool descending = (capacity > 1);
+    while (descending)
+    {
+      descending = false;
+      for (size_t i = 0; i < masses.n_elem; ++i)
+      {
+        const size_t idx = indices[i];
+        if (idx >= capacity)
+          continue;
+
+        if (element[2 * idx] > masses[i])
+        {
+          indices[i] = 2 * idx;
+        }
+        else
+        {
+          masses[i] -= element[2 * idx];
+          indices[i] = 2 * idx + 1;
+        }
+        descending = true;
+      }
+    }
+    indices -= capacity;
+  }
+
  private:
   //! The capacity of the data array.
   size_t capacity;
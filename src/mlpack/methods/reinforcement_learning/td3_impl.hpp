@@ -177,6 +177,30 @@ void TD3<
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
+  Update(sampledStates, sampledActions, sampledRewards, sampledNextStates,
+      isTerminal);
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void TD3<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::Update(
+    const arma::mat& sampledStates,
+    const std::vector<ActionType>& sampledActions,
+    const arma::rowvec& sampledRewards,
+    const arma::mat& sampledNextStates,
+    const arma::irowvec& isTerminal)
+{
   // Critic network update.
 
   // Use the target actor to obtain the next actions.
@@ -290,12 +314,34 @@ void TD3<
   UpdaterType,
   ReplayType
 >::SelectAction()
+{
+  SelectAction(policyNetwork, state, action, !deterministic);
+}
+
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void TD3<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::SelectAction(
+    PolicyNetworkType& network,
+    StateType& state,
+    ActionType& action,
+    const bool explore)
 {
   // Get the action at current state, from policy.
   arma::colvec outputAction;
-  policyNetwork.Predict(state.Encode(), outputAction);
+  network.Predict(state.Encode(), outputAction);
 
-  if (!deterministic)
+  if (explore)
   {
     arma::colvec noise;
     noise.randn(outputAction.n_rows) * 0.1;
@@ -359,5 +405,50 @@ double TD3<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+double TD3<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::TrainActorLearner(
+    const size_t actors,
+    const size_t steps,
+    const size_t publishInterval)
+{
+  // While training, the learner owns `totalSteps`, which counts the updates,
+  // so that the target networks are synced every
+  // `TargetNetworkSyncInterval()` updates.
+  const size_t startSteps = totalSteps;
+  const double averageReturn = ActorLearnerTrain(config, environment,
+      policyNetwork, replayMethod, actors, steps, publishInterval,
+      [this](PolicyNetworkType& network, StateType& state,
+          ActionType& action, const size_t /* actor */)
+      {
+        SelectAction(network, state, action, true);
+      },
+      [this](const arma::mat& sampledStates,
+          const std::vector<ActionType>& sampledActions,
+          const arma::rowvec& sampledRewards,
+          const arma::mat& sampledNextStates,
+          const arma::irowvec& isTerminal,
+          const size_t updates)
+      {
+        totalSteps = updates;
+        Update(sampledStates, sampledActions, sampledRewards,
+            sampledNextStates, isTerminal);
+      });
+
+  totalSteps = startSteps + steps;
+  return averageReturn;
+}
+
 } // namespace mlpack
 #endif
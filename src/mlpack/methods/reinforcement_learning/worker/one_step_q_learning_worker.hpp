@@ -60,7 +60,8 @@ class OneStepQLearningWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetSyncs(0)
   { Reset(); }
 
   /**
@@ -81,6 +82,10 @@ class OneStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      workerTargetNetwork(other.workerTargetNetwork),
+      targetSyncs(other.targetSyncs),
+      totalGradients(other.totalGradients),
+      gradients(other.gradients),
       state(other.state)
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -111,6 +116,10 @@ class OneStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      workerTargetNetwork(std::move(other.workerTargetNetwork)),
+      targetSyncs(other.targetSyncs),
+      totalGradients(std::move(other.totalGradients)),
+      gradients(std::move(other.gradients)),
       state(std::move(other.state))
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -146,6 +155,10 @@ class OneStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    workerTargetNetwork = other.workerTargetNetwork;
+    targetSyncs = other.targetSyncs;
+    totalGradients = other.totalGradients;
+    gradients = other.gradients;
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -183,6 +196,10 @@ class OneStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    workerTargetNetwork = std::move(other.workerTargetNetwork);
+    targetSyncs = other.targetSyncs;
+    totalGradients = std::move(other.totalGradients);
+    gradients = std::move(other.gradients);
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -225,8 +242,14 @@ class OneStepQLearningWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network, and the local copy of the target network.
     network = learningNetwork;
+    workerTargetNetwork = learningNetwork;
+    targetSyncs = 0;
+
+    // Allocate the gradient buffers once.
+    totalGradients.set_size(arma::size(learningNetwork.Parameters()));
+    gradients.set_size(arma::size(learningNetwork.Parameters()));
   }
 
   /**
@@ -234,7 +257,7 @@ class OneStepQLearningWorker
    *
    * @param learningNetwork The shared learning network.
    * @param targetNetwork The shared target network.
-   * @param totalSteps The shared counter for total steps.
+   * @param totalSteps The shared (atomic) counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
    *     after this step. Otherwise this is invalid.
@@ -242,7 +265,7 @@ class OneStepQLearningWorker
    */
   bool Step(NetworkType& learningNetwork,
             NetworkType& targetNetwork,
-            size_t& totalSteps,
+            std::atomic<size_t>& totalSteps,
             PolicyType& policy,
             double& totalReward)
   {
@@ -265,35 +288,33 @@ class OneStepQLearningWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        CopyParameters(learningNetwork, network);
         return true;
       }
       state = nextState;
       return false;
     }
 
-    #pragma omp atomic
-    totalSteps++;
+    // The counter is atomic, so each step gets a distinct index.
+    const size_t step = ++totalSteps;
 
     pending[pendingIndex] = std::make_tuple(state, action, reward, nextState);
     pendingIndex++;
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
-      // Initialize the gradient storage.
-      arma::mat totalGradients(learningNetwork.Parameters().n_rows,
-          learningNetwork.Parameters().n_cols, arma::fill::zeros);
+      // Reuse the gradient storage of the worker, and make sure the local
+      // target network is up to date.
+      totalGradients.zeros(arma::size(learningNetwork.Parameters()));
+      RefreshTargetNetwork(targetNetwork, step);
       for (size_t i = 0; i < pending.size(); ++i)
       {
         TransitionType &transition = pending[i];
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        workerTargetNetwork.Predict(std::get<3>(transition).Encode(),
+            actionValue);
         double targetActionValue = actionValue.max();
         if (terminal && i == pending.size() - 1)
           targetActionValue = 0;
@@ -306,7 +327,6 @@ class OneStepQLearningWorker
         actionValue[std::get<1>(transition).action] = targetActionValue;
 
         // Compute gradient.
-        arma::mat gradients;
         network.Backward(input, actionValue, gradients);
 
         // Accumulate gradients.
@@ -329,17 +349,15 @@ class OneStepQLearningWorker
       #endif
 
       // Sync the local network with the global network.
-      network = learningNetwork;
+      CopyParameters(learningNetwork, network);
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
-    }
+    // Update global target network.  Since each step has a distinct index,
+    // exactly one worker performs each sync.
+    if (step % config.TargetNetworkSyncInterval() == 0)
+      CopyParameters(learningNetwork, targetNetwork);
 
     policy.Anneal();
 
@@ -354,6 +372,32 @@ class OneStepQLearningWorker
   }
 
  private:
+  /**
+   * Copy the parameters of one network into another network of the same
+   * shape.  The parameters are copied into the existing memory of `to`, and
+   * no lock is taken: as in Hogwild, the parameters read from a shared network
+   * may be partially updated by other workers.
+   */
+  static void CopyParameters(const NetworkType& from, NetworkType& to)
+  {
+    to.Parameters() = from.Parameters();
+  }
+
+  /**
+   * Refresh the local copy of the target network, if the shared target network
+   * was synced since the last refresh.
+   */
+  void RefreshTargetNetwork(const NetworkType& targetNetwork,
+                            const size_t step)
+  {
+    const size_t syncs = step / config.TargetNetworkSyncInterval();
+    if (syncs != targetSyncs)
+    {
+      CopyParameters(targetNetwork, workerTargetNetwork);
+      targetSyncs = syncs;
+    }
+  }
+
   /**
    * Reset the worker for a new episode.
    */
@@ -395,6 +439,19 @@ class OneStepQLearningWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local copy of the target network, so that targets are computed without
+  //! any lock.
+  NetworkType workerTargetNetwork;
+
+  //! The number of syncs of the shared target network seen by the local copy.
+  size_t targetSyncs;
+
+  //! Buffer for the accumulated gradients of an update.
+  arma::mat totalGradients;
+
+  //! Buffer for the gradients of one transition.
+  arma::mat gradients;
+
   //! Current state of the agent.
   StateType state;
 };
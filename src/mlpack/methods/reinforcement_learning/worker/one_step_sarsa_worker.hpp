@@ -61,7 +61,8 @@ class OneStepSarsaWorker
       environment(environment),
       config(config),
       deterministic(deterministic),
-      pending(config.UpdateInterval())
+      pending(config.UpdateInterval()),
+      targetSyncs(0)
   { Reset(); }
 
   /**
@@ -82,6 +83,10 @@ class OneStepSarsaWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      workerTargetNetwork(other.workerTargetNetwork),
+      targetSyncs(other.targetSyncs),
+      totalGradients(other.totalGradients),
+      gradients(other.gradients),
       state(other.state),
       action(other.action)
   {
@@ -113,6 +118,10 @@ class OneStepSarsaWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      workerTargetNetwork(std::move(other.workerTargetNetwork)),
+      targetSyncs(other.targetSyncs),
+      totalGradients(std::move(other.totalGradients)),
+      gradients(std::move(other.gradients)),
       state(std::move(other.state)),
       action(std::move(other.action))
   {
@@ -149,6 +158,10 @@ class OneStepSarsaWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    workerTargetNetwork = other.workerTargetNetwork;
+    targetSyncs = other.targetSyncs;
+    totalGradients = other.totalGradients;
+    gradients = other.gradients;
     state = other.state;
     action = other.action;
 
@@ -187,6 +200,10 @@ class OneStepSarsaWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    workerTargetNetwork = std::move(other.workerTargetNetwork);
+    targetSyncs = other.targetSyncs;
+    totalGradients = std::move(other.totalGradients);
+    gradients = std::move(other.gradients);
     state = std::move(other.state);
     action = std::move(other.action);
 
@@ -230,8 +247,14 @@ class OneStepSarsaWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network, and the local copy of the target network.
     network = learningNetwork;
+    workerTargetNetwork = learningNetwork;
+    targetSyncs = 0;
+
+    // Allocate the gradient buffers once.
+    totalGradients.set_size(arma::size(learningNetwork.Parameters()));
+    gradients.set_size(arma::size(learningNetwork.Parameters()));
   }
 
   /**
@@ -239,7 +262,7 @@ class OneStepSarsaWorker
    *
    * @param learningNetwork The shared learning network.
    * @param targetNetwork The shared target network.
-   * @param totalSteps The shared counter for total steps.
+   * @param totalSteps The shared (atomic) counter for total steps.
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
    *     after this step. Otherwise this is invalid.
@@ -247,7 +270,7 @@ class OneStepSarsaWorker
    */
   bool Step(NetworkType& learningNetwork,
             NetworkType& targetNetwork,
-            size_t& totalSteps,
+            std::atomic<size_t>& totalSteps,
             PolicyType& policy,
             double& totalReward)
   {
@@ -277,7 +300,7 @@ class OneStepSarsaWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        CopyParameters(learningNetwork, network);
         return true;
       }
       state = nextState;
@@ -285,28 +308,26 @@ class OneStepSarsaWorker
       return false;
     }
 
-    #pragma omp atomic
-    totalSteps++;
+    // The counter is atomic, so each step gets a distinct index.
+    const size_t step = ++totalSteps;
 
     pending[pendingIndex++] =
         std::make_tuple(state, action, reward, nextState, nextAction);
 
     if (terminal || pendingIndex >= config.UpdateInterval())
     {
-      // Initialize the gradient storage.
-      arma::mat totalGradients(learningNetwork.Parameters().n_rows,
-          learningNetwork.Parameters().n_cols, arma::fill::zeros);
+      // Reuse the gradient storage of the worker, and make sure the local
+      // target network is up to date.
+      totalGradients.zeros(arma::size(learningNetwork.Parameters()));
+      RefreshTargetNetwork(targetNetwork, step);
       for (size_t i = 0; i < pending.size(); ++i)
       {
         TransitionType &transition = pending[i];
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        workerTargetNetwork.Predict(std::get<3>(transition).Encode(),
+            actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition).action];
@@ -319,7 +340,6 @@ class OneStepSarsaWorker
         actionValue[std::get<1>(transition).action] = targetActionValue;
 
         // Compute gradient.
-        arma::mat gradients;
         network.Backward(input, actionValue, gradients);
 
         // Accumulate gradients.
@@ -342,17 +362,15 @@ class OneStepSarsaWorker
       #endif
 
       // Sync the local network with the global network.
-      network = learningNetwork;
+      CopyParameters(learningNetwork, network);
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
-    if (totalSteps % config.TargetNetworkSyncInterval() == 0)
-    {
-      #pragma omp critical
-      { targetNetwork = learningNetwork; }
-    }
+    // Update global target network.  Since each step has a distinct index,
+    // exactly one worker performs each sync.
+    if (step % config.TargetNetworkSyncInterval() == 0)
+      CopyParameters(learningNetwork, targetNetwork);
 
     policy.Anneal();
 
@@ -368,6 +386,32 @@ class OneStepSarsaWorker
   }
 
  private:
+  /**
+   * Copy the parameters of one network into another network of the same
+   * shape.  The parameters are copied into the existing memory of `to`, and
+   * no lock is taken: as in Hogwild, the parameters read from a shared network
+   * may be partially updated by other workers.
+   */
+  static void CopyParameters(const NetworkType& from, NetworkType& to)
+  {
+    to.Parameters() = from.Parameters();
+  }
+
+  /**
+   * Refresh the local copy of the target network, if the shared target network
+   * was synced since the last refresh.
+   */
+  void RefreshTargetNetwork(const NetworkType& targetNetwork,
+                            const size_t step)
+  {
+    const size_t syncs = step / config.TargetNetworkSyncInterval();
+    if (syncs != targetSyncs)
+    {
+      CopyParameters(targetNetwork, workerTargetNetwork);
+      targetSyncs = syncs;
+    }
+  }
+
   /**
    * Reset the worker for a new episode.
    */
@@ -411,6 +455,19 @@ class OneStepSarsaWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local copy of the target network, so that targets are computed without
+  //! any lock.
+  NetworkType workerTargetNetwork;
+
+  //! The number of syncs of the shared target network seen by the local copy.
+  size_t targetSyncs;
+
+  //! Buffer for the accumulated gradients of an update.
+  arma::mat totalGradients;
+
+  //! Buffer for the gradients of one transition.
+  arma::mat gradients;
+
   //! Current state of the agent.
   StateType state;
 
@@ -0,0 +1,198 @@
+/**
+ * @file methods/softmax_regression/sampled_softmax_regression_function.hpp
+ *
+ * A sampled approximation of the softmax regression objective, for training
+ * with many classes.  Any separable mlpack optimizer (such as SGD) can be used.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SAMPLED_SOFTMAX_REGRESSION_FUNCTION_HPP
+#define MLPACK_METHODS_SOFTMAX_REGRESSION_SAMPLED_SOFTMAX_REGRESSION_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include "softmax_regression_function.hpp"
+
+namespace mlpack {
+
+/**
+ * The sampled softmax objective approximates the objective of
+ * SoftmaxRegressionFunction on a batch of points by normalizing the class
+ * probabilities over a small set of candidate classes instead of over all
+ * classes.  The candidates of a batch are the labels of the points in the
+ * batch, plus `numSampled` other classes drawn uniformly at random (without
+ * replacement).  Each sampled class stands in for `(k - t) / numSampled`
+ * classes, where `k` is the number of classes and `t` is the number of distinct
+ * labels in the batch, so its term of the normalizer is weighted by that
+ * factor; the normalizer is then an unbiased estimate of the full normalizer.
+ *
+ * The scores and the gradient of the likelihood are then computed only for the
+ * candidate classes, so evaluating a batch of n points costs O((t + numSampled)
+ * * n * d) instead of O(k * n * d), and no k x n probability matrix is formed.
+ * (The L2 regularization term still involves all of the parameters.)  If
+ * `numSampled` is at least `k - t`, every class is a candidate and the
+ * objective of SoftmaxRegressionFunction is computed exactly.
+ *
+ * The parameters have the same layout as for SoftmaxRegressionFunction, so the
+ * result can be used by SoftmaxRegression (see
+ * SoftmaxRegression::TrainSampled()).  Since a new set of classes is sampled
+ * for every call, only stochastic optimizers should be used.
+ *
+ * @code
+ * SampledSoftmaxRegressionFunction<> f(data, labels, 50000, 200);
+ * arma::mat parameters = f.GetInitialPoint();
+ * ens::StandardSGD sgd(0.01, 32);
+ * sgd.Optimize(f, parameters);
+ * @endcode
+ *
+ * @tparam MatType Type of the data matrix.
+ */
+template<typename MatType = arma::mat>
+class SampledSoftmaxRegressionFunction
+{
+ public:
+  typedef typename MatType::elem_type ElemType;
+  typedef typename GetDenseMatType<MatType>::type DenseMatType;
+  typedef typename GetDenseColType<MatType>::type DenseColType;
+
+  /**
+   * Construct the sampled softmax regression objective function with the given
+   * parameters.
+   *
+   * @param data Input training data, each column associate with one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param numSampled Number of classes to sample for each batch, in addition
+   *     to the labels of the batch.
+   * @param lambda L2-regularization constant.
+   * @param fitIntercept Intercept term flag.
+   */
+  SampledSoftmaxRegressionFunction(const MatType& data,
+                                   const arma::Row<size_t>& labels,
+                                   const size_t numClasses,
+                                   const size_t numSampled = 100,
+                                   const double lambda = 0.0001,
+                                   const bool fitIntercept = false);
+
+  /**
+   * Shuffle the dataset.
+   */
+  void Shuffle();
+
+  /**
+   * Evaluate the sampled objective function on the given batch of points.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param batchSize Number of data points to evaluate objective for.
+   */
+  ElemType Evaluate(const DenseMatType& parameters,
+                    const size_t start,
+                    const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the sampled objective function on the given batch
+   * of points.  Only the rows of the gradient of the candidate classes have a
+   * likelihood term.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Matrix to store gradient into.
+   * @param batchSize Number of data points to evaluate gradient for.
+   */
+  template<typename GradType>
+  void Gradient(const DenseMatType& parameters,
+                const size_t start,
+                GradType& gradient,
+                const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the sampled objective function and its gradient on the given
+   * batch of points, with the same set of candidate classes.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param start First index of the data points to use.
+   * @param gradient Matrix to store gradient into.
+   * @param batchSize Number of data points to evaluate for.
+   * @return The value of the sampled objective function.
+   */
+  template<typename GradType>
+  ElemType EvaluateWithGradient(const DenseMatType& parameters,
+                                const size_t start,
+                                GradType& gradient,
+                                const size_t batchSize = 1) const;
+
+  //! Return the initial point for the optimization.
+  const DenseMatType& GetInitialPoint() const { return initialPoint; }
+
+  //! Gets the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the number of classes sampled for each batch.
+  size_t NumSampled() const { return numSampled; }
+  //! Modify the number of classes sampled for each batch.
+  size_t& NumSampled() { return numSampled; }
+
+  /**
+   * Return the number of separable functions (the number of predictor points).
+   */
+  size_t NumFunctions() const { return data.n_cols; }
+
+  //! Sets the regularization parameter.
+  double& Lambda() { return lambda; }
+  //! Gets the regularization parameter.
+  double Lambda() const { return lambda; }
+
+  //! Gets the intercept flag.
+  bool FitIntercept() const { return fitIntercept; }
+
+ private:
+  /**
+   * Choose the candidate classes for the given batch: the distinct labels of
+   * the batch come first, followed by the sampled classes.  The position of
+   * the label of each point in the candidates is stored in `targets`, and the
+   * weight of the normalizer term of each candidate is stored in `weights`.
+   */
+  void SampleCandidates(const size_t start,
+                        const size_t batchSize,
+                        arma::uvec& candidates,
+                        arma::uvec& targets,
+                        DenseColType& weights) const;
+
+  /**
+   * Compute the sampled objective on the given batch, and, if `gradient` is
+   * not NULL, its gradient.
+   */
+  template<typename GradType>
+  ElemType Compute(const DenseMatType& parameters,
+                   const size_t start,
+                   const size_t batchSize,
+                   GradType* gradient) const;
+
+  //! Training data matrix.  This is an alias until the data is shuffled.
+  MatType data;
+  //! Labels of the training data.
+  arma::Row<size_t> labels;
+  //! Initial parameter point.
+  DenseMatType initialPoint;
+  //! Number of classes.
+  size_t numClasses;
+  //! Number of classes sampled for each batch.
+  size_t numSampled;
+  //! L2-regularization constant.
+  double lambda;
+  //! Intercept term flag.
+  bool fitIntercept;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "sampled_softmax_regression_function_impl.hpp"
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * @file methods/softmax_regression/sampled_softmax_regression_function_impl.hpp
+ *
+ * Implementation of the sampled softmax regression objective function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SAMPLED_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_SOFTMAX_REGRESSION_SAMPLED_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sampled_softmax_regression_function.hpp"
+
+#include <unordered_map>
+
+namespace mlpack {
+
+template<typename MatType>
+inline SampledSoftmaxRegressionFunction<MatType>::
+SampledSoftmaxRegressionFunction(
+    const MatType& dataIn,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const size_t numSampled,
+    const double lambda,
+    const bool fitIntercept) :
+    labels(labels),
+    numClasses(numClasses),
+    numSampled(numSampled),
+    lambda(lambda),
+    fitIntercept(fitIntercept)
+{
+  if (labels.n_elem != dataIn.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "SampledSoftmaxRegressionFunction: got " << dataIn.n_cols
+        << " points but " << labels.n_elem << " labels!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (labels.n_elem > 0 && labels.max() >= numClasses)
+  {
+    std::ostringstream oss;
+    oss << "SampledSoftmaxRegressionFunction: labels must be less than the "
+        << "number of classes (" << numClasses << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, 0, false);
+
+  // The parameters have the same layout as for the exact objective.
+  SoftmaxRegressionFunction<MatType>::InitializeWeights(initialPoint,
+      data.n_rows, numClasses, fitIntercept);
+}
+
+/**
+ * Shuffle the data.
+ */
+template<typename MatType>
+inline void SampledSoftmaxRegressionFunction<MatType>::Shuffle()
+{
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      data.n_cols - 1, data.n_cols));
+
+  MatType newData = data.cols(ordering);
+  ClearAlias(data);
+  data = std::move(newData);
+  labels = labels.cols(ordering);
+}
+
+template<typename MatType>
+inline typename SampledSoftmaxRegressionFunction<MatType>::ElemType
+SampledSoftmaxRegressionFunction<MatType>::Evaluate(
+    const DenseMatType& parameters,
+    const size_t start,
+    const size_t batchSize) const
+{
+  return Compute<DenseMatType>(parameters, start, batchSize, nullptr);
+}
+
+template<typename MatType>
+template<typename GradType>
+inline void SampledSoftmaxRegressionFunction<MatType>::Gradient(
+    const DenseMatType& parameters,
+    const size_t start,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  Compute(parameters, start, batchSize, &gradient);
+}
+
+template<typename MatType>
+template<typename GradType>
+inline typename SampledSoftmaxRegressionFunction<MatType>::ElemType
+SampledSoftmaxRegressionFunction<MatType>::EvaluateWithGradient(
+    const DenseMatType& parameters,
+    const size_t start,
+    GradType& gradient,
+    const size_t batchSize) const
+{
+  return Compute(parameters, start, batchSize, &gradient);
+}
+
+template<typename MatType>
+inline void SampledSoftmaxRegressionFunction<MatType>::SampleCandidates(
+    const size_t start,
+    const size_t batchSize,
+    arma::uvec& candidates,
+    arma::uvec& targets,
+    DenseColType& weights) const
+{
+  // Map each candidate class to its position in the candidates.
+  std::unordered_map<size_t, size_t> positions;
+  std::vector<size_t> chosen;
+  targets.set_size(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const auto it = positions.emplace(labels[start + i], chosen.size());
+    if (it.second)
+      chosen.push_back(labels[start + i]);
+    targets[i] = it.first->second;
+  }
+
+  const size_t numTargets = chosen.size();
+  const size_t remaining = numClasses - numTargets;
+  const size_t sampled = std::min(numSampled, remaining);
+  if (2 * sampled <= remaining)
+  {
+    // Rejection sampling needs at most two draws per class on average.
+    while (chosen.size() < numTargets + sampled)
+    {
+      const size_t c = RandInt(numClasses);
+      if (positions.emplace(c, chosen.size()).second)
+        chosen.push_back(c);
+    }
+  }
+  else
+  {
+    // Most classes are sampled, so take a random subset of the others.
+    std::vector<size_t> others;
+    others.reserve(remaining);
+    for (size_t c = 0; c < numClasses; ++c)
+      if (positions.count(c) == 0)
+        others.push_back(c);
+
+    for (size_t i = 0; i < sampled; ++i)
+    {
+      std::swap(others[i], others[i + RandInt(remaining - i)]);
+      chosen.push_back(others[i]);
+    }
+  }
+
+  candidates = arma::conv_to<arma::uvec>::from(chosen);
+  weights.ones(chosen.size());
+  if (sampled > 0)
+    weights.tail(sampled).fill(ElemType(remaining) / ElemType(sampled));
+}
+
+template<typename MatType>
+template<typename GradType>
+inline typename SampledSoftmaxRegressionFunction<MatType>::ElemType
+SampledSoftmaxRegressionFunction<MatType>::Compute(
+    const DenseMatType& parameters,
+    const size_t start,
+    const size_t batchSize,
+    GradType* gradient) const
+{
+  typedef typename GetDenseRowType<MatType>::type DenseRowType;
+
+  // The batch is an alias of the columns of the data (when it is dense), so
+  // it is not copied.
+  MatType batch;
+  MakeColsAlias(batch, data, start, batchSize, false);
+
+  arma::uvec candidates, targets;
+  DenseColType weights;
+  SampleCandidates(start, batchSize, candidates, targets, weights);
+
+  // Compute the scores of the candidate classes only.
+  const DenseMatType candidateParameters = parameters.rows(candidates);
+  DenseMatType scores;
+  if (fitIntercept)
+  {
+    scores = candidateParameters.cols(1, parameters.n_cols - 1) * batch;
+    scores.each_col() += candidateParameters.col(0);
+  }
+  else
+  {
+    scores = candidateParameters * batch;
+  }
+
+  // Subtract the largest score of each point before exponentiating, so that
+  // the normalizers do not overflow.
+  scores.each_row() -= max(scores, 0);
+  ElemType logLikelihood = 0;
+  for (size_t i = 0; i < batchSize; ++i)
+    logLikelihood += scores(targets[i], i);
+
+  scores = exp(scores);
+  scores.each_col() %= weights;
+  const DenseRowType normalizers = sum(scores, 0);
+  logLikelihood -= accu(log(normalizers));
+
+  const ElemType weightDecay = ElemType(0.5) * lambda *
+      accu(parameters % parameters);
+
+  if (gradient != nullptr)
+  {
+    // The scores become the inner term of the gradient in place.
+    scores.each_row() /= normalizers;
+    for (size_t i = 0; i < batchSize; ++i)
+      scores(targets[i], i) -= 1;
+
+    DenseMatType candidateGradient(candidates.n_elem, parameters.n_cols);
+    if (fitIntercept)
+    {
+      candidateGradient.col(0) = sum(scores, 1) / batchSize;
+      candidateGradient.cols(1, parameters.n_cols - 1) =
+          scores * batch.t() / batchSize;
+    }
+    else
+    {
+      candidateGradient = scores * batch.t() / batchSize;
+    }
+
+    *gradient = lambda * parameters;
+    gradient->rows(candidates) += candidateGradient;
+  }
+
+  return -logLikelihood / batchSize + weightDecay;
+}
+
+} // namespace mlpack
+
+#endif
@@ -13,8 +13,10 @@
 #define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
 
 #include "softmax_regression_function.hpp"
+#include "sampled_softmax_regression_function.hpp"
 
 namespace mlpack {
 
@@ -235,6 +237,44 @@ class SoftmaxRegression
                  const bool fitIntercept = true,
                  CallbackTypes&&... callbacks);
 
+  /**
+   * Train the softmax regression with the given training data with the sampled
+   * softmax objective (see SampledSoftmaxRegressionFunction): for each batch,
+   * the class probabilities are normalized over the labels of the batch and
+   * `numSampled` randomly sampled classes only.  This is much cheaper than
+   * Train() when there are many classes.  Since the objective is stochastic, a
+   * stochastic optimizer (such as ens::StandardSGD) should be used.
+   *
+   * @tparam OptimizerType Desired optimizer type.
+   * @param data Input data with each column as one example.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param numSampled Number of classes to sample for each batch.
+   * @param optimizer Desired optimizer.
+   * @param lambda L2-regularization constant.
+   * @param fitIntercept Whether or not to fit an intercept term to the model.
+   * @param callbacks Callback(s) for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return Objective value of the final point.
+   */
+  template<typename OptimizerType,
+           typename... CallbackTypes,
+           typename = typename std::enable_if<IsEnsOptimizer<
+               OptimizerType, SampledSoftmaxRegressionFunction<MatType>,
+               DenseMatType
+           >::value>::type,
+           typename = typename std::enable_if<IsEnsCallbackTypes<
+               CallbackTypes...
+           >::value>::type>
+  ElemType TrainSampled(const MatType& data,
+                        const arma::Row<size_t>& labels,
+                        const size_t numClasses,
+                        const size_t numSampled,
+                        OptimizerType& optimizer,
+                        const double lambda = 0.0001,
+                        const bool fitIntercept = true,
+                        CallbackTypes&&... callbacks);
+
   /**
    * Classify the given points, returning the predicted labels for each point.
    * The function calculates the probabilities for every class, given a data
@@ -245,6 +285,23 @@ class SoftmaxRegression
    */
   void Classify(const MatType& dataset, arma::Row<size_t>& labels) const;
 
+  /**
+   * Classify the given points, stored contiguously in column-major order (like
+   * the memory of an Armadillo matrix with FeatureSize() rows), storing the
+   * predicted labels in `labels`.  This does not allocate memory and does not
+   * check its inputs, so it is suited to low-latency prediction of single
+   * points or small batches; the model must be trained.
+   *
+   * @param points Pointer to the `numPoints * FeatureSize()` elements of the
+   *     points.
+   * @param numPoints Number of points to classify.
+   * @param labels Preallocated array of `numPoints` labels to store the
+   *     predictions in.
+   */
+  void Classify(const ElemType* points,
+                const size_t numPoints,
+                size_t* labels) const noexcept;
+
   /**
    * Classify the given point. The predicted class label is returned.
    * The function calculates the probabilites for every class, given the point.
@@ -295,6 +352,26 @@ class SoftmaxRegression
   void Classify(const MatType& dataset,
                 DenseMatType& probabilities) const;
 
+  /**
+   * Find the `k` most probable classes of each of the given points, and their
+   * scores (the inner products of the points with the weights of the classes,
+   * plus the intercepts).  The classes are found with an exact maximum inner
+   * product search (FastMKS with the linear kernel) over the class weight
+   * vectors, so not every class has to be scored for every point; this is
+   * much faster than Classify() when there are many classes.  Column `i` of
+   * `classes` holds the classes of point `i`, from the most to the least
+   * probable.
+   *
+   * @param dataset Matrix of data points to be classified.
+   * @param k Number of classes to find for each point.
+   * @param classes Matrix to store the classes of each point in.
+   * @param scores Matrix to store the scores of the classes in.
+   */
+  void TopClasses(const MatType& dataset,
+                  const size_t k,
+                  arma::Mat<size_t>& classes,
+                  arma::mat& scores) const;
+
   /**
    * Computes accuracy of the learned model given the feature data and the
    * labels associated with each data point. Predictions are made using the
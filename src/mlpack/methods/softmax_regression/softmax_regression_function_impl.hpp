@@ -165,8 +165,13 @@ inline void SoftmaxRegressionFunction<MatType>::GetProbabilitiesMatrix(
     const size_t start,
     const size_t batchSize) const
 {
-  DenseMatType hypothesis;
+  // The batch is an alias of the columns of the data (when it is dense), so
+  // it is not copied.
+  MatType batch;
+  MakeColsAlias(batch, data, start, batchSize, false);
 
+  // The probabilities are computed in place from the linear scores, without
+  // temporary matrices.
   if (fitIntercept)
   {
     // In order to add the intercept term, we should compute following matrix:
@@ -175,17 +180,16 @@ inline void SoftmaxRegressionFunction<MatType>::GetProbabilitiesMatrix(
     //
     // Since the cost of join may be high due to the copy of original data,
     // split the hypothesis computation to two components.
-    hypothesis = exp(
-        repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+    probabilities = parameters.cols(1, parameters.n_cols - 1) * batch;
+    probabilities.each_col() += parameters.col(0);
   }
   else
   {
-    hypothesis = exp(parameters * data.cols(start, start + batchSize - 1));
+    probabilities = parameters * batch;
   }
 
-  probabilities = hypothesis / repmat(sum(hypothesis, 0), numClasses, 1);
+  probabilities = exp(probabilities);
+  probabilities.each_row() /= sum(probabilities, 0);
 }
 
 /**
@@ -243,7 +247,7 @@ SoftmaxRegressionFunction<MatType>::Evaluate(
     const size_t start,
     const size_t batchSize) const
 {
-  MatType probabilities;
+  DenseMatType probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
 
   // Calculate the log likelihood and regularization terms.
@@ -307,24 +311,24 @@ inline void SoftmaxRegressionFunction<MatType>::Gradient(
   DenseMatType probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
 
-  // Calculate the parameter gradients.
+  MatType batch;
+  MakeColsAlias(batch, data, start, batchSize, false);
+
+  // Calculate the parameter gradients.  The probabilities become the inner
+  // term in place.
+  probabilities -= groundTruth.cols(start, start + batchSize - 1);
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   if (fitIntercept)
   {
-    DenseMatType inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
-    gradient.col(0) =
-        inner * ones<DenseMatType>(batchSize, 1) / batchSize +
+    gradient.col(0) = sum(probabilities, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        probabilities * batch.t() / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
+    gradient = probabilities * batch.t() / batchSize + lambda * parameters;
   }
 }
 
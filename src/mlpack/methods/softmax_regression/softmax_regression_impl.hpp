@@ -139,6 +139,36 @@ SoftmaxRegression<MatType>::Train(const MatType& data,
   return out;
 }
 
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes, typename, typename>
+typename SoftmaxRegression<MatType>::ElemType
+SoftmaxRegression<MatType>::TrainSampled(const MatType& data,
+                                         const arma::Row<size_t>& labels,
+                                         const size_t numClasses,
+                                         const size_t numSampled,
+                                         OptimizerType& optimizer,
+                                         const double lambda,
+                                         const bool fitIntercept,
+                                         CallbackTypes&&... callbacks)
+{
+  this->lambda = lambda;
+  this->fitIntercept = fitIntercept;
+  this->numClasses = numClasses;
+
+  SampledSoftmaxRegressionFunction<MatType> regressor(data, labels, numClasses,
+      numSampled, lambda, fitIntercept);
+  if (parameters.n_elem != regressor.GetInitialPoint().n_elem)
+    parameters = regressor.GetInitialPoint();
+
+  // Train the model.
+  const double out = optimizer.Optimize(regressor, parameters, callbacks...);
+
+  Log::Info << "SoftmaxRegression::TrainSampled(): final sampled objective of "
+            << "trained model is " << out << "." << std::endl;
+
+  return out;
+}
+
 template<typename MatType>
 inline void SoftmaxRegression<MatType>::Classify(const MatType& dataset,
                                                  arma::Row<size_t>& labels)
@@ -148,6 +178,35 @@ inline void SoftmaxRegression<MatType>::Classify(const MatType& dataset,
   Classify(dataset, labels, probabilities);
 }
 
+template<typename MatType>
+void SoftmaxRegression<MatType>::Classify(const ElemType* points,
+                                          const size_t numPoints,
+                                          size_t* labels) const noexcept
+{
+  // The class with the highest probability is also the class with the highest
+  // score, so the exponentials do not need to be computed.
+  const size_t dimensionality = FeatureSize();
+  const size_t offset = fitIntercept ? 1 : 0;
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const ElemType* point = points + i * dimensionality;
+    ElemType maxScore = -std::numeric_limits<ElemType>::infinity();
+    labels[i] = 0;
+    for (size_t j = 0; j < numClasses; ++j)
+    {
+      ElemType score = fitIntercept ? parameters.at(j, 0) : ElemType(0);
+      for (size_t d = 0; d < dimensionality; ++d)
+        score += parameters.at(j, d + offset) * point[d];
+
+      if (score > maxScore)
+      {
+        maxScore = score;
+        labels[i] = j;
+      }
+    }
+  }
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t SoftmaxRegression<MatType>::Classify(const VecType& point) const
@@ -231,6 +290,36 @@ inline void SoftmaxRegression<MatType>::Classify(
   Classify(dataset, labels, probabilities);
 }
 
+template<typename MatType>
+inline void SoftmaxRegression<MatType>::TopClasses(
+    const MatType& dataset,
+    const size_t k,
+    arma::Mat<size_t>& classes,
+    arma::mat& scores) const
+{
+  util::CheckSameDimensionality(dataset, FeatureSize(),
+      "SoftmaxRegression::TopClasses()");
+
+  if (k == 0 || k > numClasses)
+  {
+    std::ostringstream oss;
+    oss << "SoftmaxRegression::TopClasses(): k must be between 1 and the "
+        << "number of classes (" << numClasses << "), but it is " << k << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each class is a reference point [intercept; weights], and each query is
+  // [1; point], so that the inner products are the scores of the classes.
+  // The most probable classes are the classes with the highest scores.
+  arma::mat classWeights = ConvTo<arma::mat>::From(parameters.t());
+  arma::mat queries = ConvTo<arma::mat>::From(dataset);
+  if (fitIntercept)
+    queries.insert_rows(0, arma::ones<arma::rowvec>(queries.n_cols));
+
+  FastMKS<LinearKernel> fastmks(std::move(classWeights));
+  fastmks.Search(queries, k, classes, scores);
+}
+
 template<typename MatType>
 inline double SoftmaxRegression<MatType>::ComputeAccuracy(
     const MatType& testData,
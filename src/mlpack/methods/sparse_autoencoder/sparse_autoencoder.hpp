@@ -68,7 +68,9 @@ class SparseAutoencoder
    * optionally. Changing these parameters will have an effect on regularization
    * and sparsity of the model.
    *
-   * @tparam OptimizerType The optimizer to use.
+   * @tparam OptimizerType The optimizer to use; this may be a separable
+   *     optimizer, such as ens::SGD or ens::Adam.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @param data Input data with each column as one example.
    * @param visibleSize Size of input vector expected at the visible layer.
    * @param hiddenSize Size of input vector expected at the hidden layer.
@@ -77,8 +79,9 @@ class SparseAutoencoder
    * @param rho Sparsity parameter.
    * @param optimizer Desired optimizer.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  SparseAutoencoder(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS,
+           typename MatType = arma::mat>
+  SparseAutoencoder(const MatType& data,
                     const size_t visibleSize,
                     const size_t hiddenSize,
                     const double lambda = 0.0001,
@@ -93,6 +96,7 @@ class SparseAutoencoder
    * and sparsity of the model.
    *
    * @tparam OptimizerType The optimizer to use.
+   * @tparam MatType Type of the data (arma::mat or arma::sp_mat).
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input data with each column as one example.
    * @param visibleSize Size of input vector expected at the visible layer.
@@ -104,8 +108,10 @@ class SparseAutoencoder
    * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
    *        See https://www.ensmallen.org/docs.html#callback-documentation.
    */
-  template<typename OptimizerType, typename... CallbackTypes>
-  SparseAutoencoder(const arma::mat& data,
+  template<typename OptimizerType,
+           typename MatType,
+           typename... CallbackTypes>
+  SparseAutoencoder(const MatType& data,
                     const size_t visibleSize,
                     const size_t hiddenSize,
                     const double lambda,
@@ -119,10 +125,11 @@ class SparseAutoencoder
    * autoencoder. The function basically performs a feedforward computation
    * using the learned weights, and returns the hidden layer activations.
    *
-   * @param data Matrix of the provided data.
+   * @param data Matrix of the provided data (dense or sparse).
    * @param features The hidden layer representation of the provided data.
    */
-  void GetNewFeatures(arma::mat& data, arma::mat& features);
+  template<typename MatType>
+  void GetNewFeatures(const MatType& data, arma::mat& features);
 
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
@@ -136,6 +143,12 @@ class SparseAutoencoder
     output = (1.0 / (1 + exp(-x)));
   }
 
+  //! Gets the learned parameters.
+  const arma::mat& Parameters() const
+  {
+    return parameters;
+  }
+
   //! Sets size of the visible layer.
   void VisibleSize(const size_t visible)
   {
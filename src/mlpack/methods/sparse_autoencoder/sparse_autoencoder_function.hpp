@@ -14,6 +14,8 @@
 #define MLPACK_METHODS_SPARSE_AUTOENCODER_SPARSE_AUTOENCODER_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
 
 namespace mlpack {
 
@@ -21,8 +23,19 @@ namespace mlpack {
  * This is a class for the sparse autoencoder objective function. It can be used
  * to create learning models like self-taught learning, stacked autoencoders,
  * conditional random fields (CRFs), and so forth.
+ *
+ * The objective can be optimized in full batches (for instance with L-BFGS) or,
+ * since it is also a separable function, in mini-batches with optimizers such
+ * as SGD or Adam.  The KL divergence term depends on the average activation of
+ * the hidden units, which is then estimated on each mini-batch, so the
+ * objectives of the batches only sum to the full objective when a single batch
+ * holds all the points.
+ *
+ * @tparam MatType Type of the data matrix; this can be a dense (arma::mat) or a
+ *     sparse (arma::sp_mat) matrix.
  */
-class SparseAutoencoderFunction
+template<typename MatType = arma::mat>
+class SparseAutoencoderFunctionType
 {
  public:
   /**
@@ -36,12 +49,12 @@ class SparseAutoencoderFunction
    * @param beta KL divergence parameter.
    * @param rho Sparsity parameter.
    */
-  SparseAutoencoderFunction(const arma::mat& data,
-                            const size_t visibleSize,
-                            const size_t hiddenSize,
-                            const double lambda = 0.0001,
-                            const double beta = 3,
-                            const double rho = 0.01);
+  SparseAutoencoderFunctionType(const MatType& data,
+                                const size_t visibleSize,
+                                const size_t hiddenSize,
+                                const double lambda = 0.0001,
+                                const double beta = 3,
+                                const double rho = 0.01);
 
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
@@ -69,6 +82,41 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluate the objective function on the batchSize points starting at the
+   * given index.  The reconstruction error of the batch is averaged over all
+   * the points, and the regularization and KL divergence terms are weighted by
+   * the fraction of the points in the batch, so that the objective of a batch
+   * holding all the points is the full objective.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
+  /**
+   * Evaluate the gradient of the objective function of the batch of batchSize
+   * points starting at the given index (see the separable Evaluate()).
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize) const;
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return data.n_cols; }
+
+  //! Shuffle the points, for the separable optimizers.
+  void Shuffle();
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -145,8 +193,17 @@ class SparseAutoencoderFunction
   }
 
  private:
-  //! The matrix of data points.
-  const arma::mat& data;
+  /**
+   * Compute the activations of the hidden and output layers for the given
+   * points.
+   */
+  void Forward(const arma::mat& parameters,
+               const MatType& batch,
+               arma::mat& hiddenLayer,
+               arma::mat& outputLayer) const;
+
+  //! The matrix of data points.  This is an alias until Shuffle() is called.
+  MatType data;
   //! Initial parameter vector.
   arma::mat initialPoint;
   //! Size of the visible layer.
@@ -161,6 +218,9 @@ class SparseAutoencoderFunction
   double rho;
 };
 
+//! The sparse autoencoder objective function for dense data.
+typedef SparseAutoencoderFunctionType<arma::mat> SparseAutoencoderFunction;
+
 } // namespace mlpack
 
 // Include implementation.
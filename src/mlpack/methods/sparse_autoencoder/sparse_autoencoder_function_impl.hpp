@@ -16,20 +16,22 @@
 
 namespace mlpack {
 
-inline SparseAutoencoderFunction::SparseAutoencoderFunction(
-    const arma::mat& data,
+template<typename MatType>
+SparseAutoencoderFunctionType<MatType>::SparseAutoencoderFunctionType(
+    const MatType& dataIn,
     const size_t visibleSize,
     const size_t hiddenSize,
     const double lambda,
     const double beta,
     const double rho) :
-    data(data),
     visibleSize(visibleSize),
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
     rho(rho)
 {
+  MakeAlias(data, dataIn, dataIn.n_rows, dataIn.n_cols, 0, false);
+
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
 }
@@ -39,7 +41,8 @@ inline SparseAutoencoderFunction::SparseAutoencoderFunction(
   * [-r, r] where 'r' is decided using the sizes of the visible and hidden
   * layers. The biases b1, b2 are initialized to 0.
   */
-inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SparseAutoencoderFunctionType<MatType>::InitializeWeights()
 {
   // The module uses a matrix to store the parameters, its structure looks like:
   //          vSize   1
@@ -73,19 +76,26 @@ inline const arma::mat SparseAutoencoderFunction::InitializeWeights()
   return parameters;
 }
 
-/** Evaluates the objective function given the parameters.
-  */
-inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
-    const
+template<typename MatType>
+void SparseAutoencoderFunctionType<MatType>::Shuffle()
 {
-  // The objective function is the average squared reconstruction error of the
-  // network. w1 and b1 are the weights and biases associated with the hidden
-  // layer, whereas w2 and b2 are associated with the output layer.
-  // f(w1,w2,b1,b2) = sum((data - sigmoid(w2*sigmoid(w1data + b1) + b2))^2) / 2m
-  // 'm' is the number of training examples.
-  // The cost also takes into account the regularization and KL divergence terms
-  // to control the parameter weights and sparsity of the model respectively.
+  // ShuffleData() handles sparse data too; the labels are not used.
+  MatType newData;
+  arma::Row<size_t> labels(data.n_cols), newLabels;
+  ShuffleData(data, labels, newData, newLabels);
+
+  // The data may be an alias of the user's matrix, which must not be modified.
+  ClearAlias(data);
+  data = std::move(newData);
+}
 
+template<typename MatType>
+void SparseAutoencoderFunctionType<MatType>::Forward(
+    const arma::mat& parameters,
+    const MatType& batch,
+    arma::mat& hiddenLayer,
+    arma::mat& outputLayer) const
+{
   // Compute the limits for the parameters w1, w2, b1 and b2.
   const size_t l1 = hiddenSize;
   const size_t l2 = visibleSize;
@@ -99,23 +109,65 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
   // b1 <- parameters.submat(0, l2, l1-1, l2)
   // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
 
-  arma::mat hiddenLayer, outputLayer;
+  // Compute activations of the hidden and output layers.  The product with a
+  // sparse batch is a dense matrix.
+  arma::mat hiddenInput = parameters.submat(0, 0, l1 - 1, l2 - 1) * batch;
+  hiddenInput.each_col() += parameters.submat(0, l2, l1 - 1, l2);
+  Sigmoid(hiddenInput, hiddenLayer);
+
+  arma::mat outputInput = parameters.submat(l1, 0, l3 - 1, l2 - 1).t() *
+      hiddenLayer;
+  outputInput.each_col() += parameters.submat(l3, 0, l3, l2 - 1).t();
+  Sigmoid(outputInput, outputLayer);
+}
+
+/** Evaluates the objective function given the parameters.
+  */
+template<typename MatType>
+double SparseAutoencoderFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters) const
+{
+  return Evaluate(parameters, 0, data.n_cols);
+}
+
+/** Evaluates the objective function of a batch of points given the parameters.
+  */
+template<typename MatType>
+double SparseAutoencoderFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  // The objective function is the average squared reconstruction error of the
+  // network. w1 and b1 are the weights and biases associated with the hidden
+  // layer, whereas w2 and b2 are associated with the output layer.
+  // f(w1,w2,b1,b2) = sum((data - sigmoid(w2*sigmoid(w1data + b1) + b2))^2) / 2m
+  // 'm' is the number of training examples.
+  // The cost also takes into account the regularization and KL divergence terms
+  // to control the parameter weights and sparsity of the model respectively.
+  // For a batch, the regularization and KL divergence terms are weighted by the
+  // fraction of the points that the batch holds.
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+  const double scale = batchSize / (double) data.n_cols;
 
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
+  // A batch of all the points is the data itself; the columns of a sparse
+  // matrix would be copied otherwise.
+  const bool allPoints = (begin == 0 && batchSize == data.n_cols);
+  MatType batchCols;
+  if (!allPoints)
+    MakeColsAlias(batchCols, data, begin, batchSize, false);
+  const MatType& batch = allPoints ? data : batchCols;
 
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  arma::mat hiddenLayer, outputLayer;
+  Forward(parameters, batch, hiddenLayer, outputLayer);
 
   arma::mat rhoCap, diff;
 
   // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
+  rhoCap = sum(hiddenLayer, 1) / batchSize;
   // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
+  diff = outputLayer - batch;
 
   double wL2SquaredNorm;
 
@@ -137,15 +189,30 @@ inline double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters)
       log((1 - rho) / (1 - rhoCap)));
 
   // The cost is the sum of the terms calculated above.
-  cost = sumOfSquaresError + weightDecay + klDivergence;
+  cost = sumOfSquaresError + scale * (weightDecay + klDivergence);
 
   return cost;
 }
 
 /** Calculates and stores the gradient values given a set of parameters.
   */
-inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
-                                                arma::mat& gradient) const
+template<typename MatType>
+void SparseAutoencoderFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
+{
+  Gradient(parameters, 0, gradient, data.n_cols);
+}
+
+/** Calculates and stores the gradient values of a batch of points given a set
+  * of parameters.
+  */
+template<typename MatType>
+void SparseAutoencoderFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize) const
 {
   // Performs a feedforward pass of the neural network, and computes the
   // activations of the output layer as in the Evaluate() method. It uses the
@@ -157,32 +224,25 @@ inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   const size_t l1 = hiddenSize;
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
+  const double scale = batchSize / (double) data.n_cols;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
+  // A batch of all the points is the data itself; the columns of a sparse
+  // matrix would be copied otherwise.
+  const bool allPoints = (begin == 0 && batchSize == data.n_cols);
+  MatType batchCols;
+  if (!allPoints)
+    MakeColsAlias(batchCols, data, begin, batchSize, false);
+  const MatType& batch = allPoints ? data : batchCols;
 
   arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  Forward(parameters, batch, hiddenLayer, outputLayer);
 
   arma::mat rhoCap, diff;
 
   // Average activations of the hidden layer.
-  rhoCap = sum(hiddenLayer, 1) / data.n_cols;
+  rhoCap = sum(hiddenLayer, 1) / batchSize;
   // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
+  diff = outputLayer - batch;
 
   arma::mat klDivGrad, delOut, delHid;
 
@@ -194,20 +254,20 @@ inline void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   // includes the KL divergence term, we adjust for that in the formula below.
   klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
   delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
+  delHid = parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut;
+  delHid.each_col() += klDivGrad;
+  delHid %= hiddenLayer % (1 - hiddenLayer);
 
   gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
 
   // Compute the gradient values using the activations and the delta values. The
   // formula also accounts for the regularization terms in the objective.
-  // function.
-  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * data.t() / data.n_cols +
-      lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
+  // function.  The terms of the batch are averaged over all the points.
+  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * batch.t() / data.n_cols +
+      scale * lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
   gradient.submat(l1, 0, l3 - 1, l2 - 1) =
       (delOut * hiddenLayer.t() / data.n_cols +
-      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+      scale * lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
   gradient.submat(0, l2, l1 - 1, l2) = sum(delHid, 1) / data.n_cols;
   gradient.submat(l3, 0, l3, l2 - 1) = (sum(delOut, 1) / data.n_cols).t();
 }
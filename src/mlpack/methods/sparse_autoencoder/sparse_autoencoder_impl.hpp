@@ -17,8 +17,8 @@
 
 namespace mlpack {
 
-template<typename OptimizerType>
-SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
+template<typename OptimizerType, typename MatType>
+SparseAutoencoder::SparseAutoencoder(const MatType& data,
                                      const size_t visibleSize,
                                      const size_t hiddenSize,
                                      double lambda,
@@ -31,8 +31,8 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
     beta(beta),
     rho(rho)
 {
-  SparseAutoencoderFunction encoderFunction(data, visibleSize, hiddenSize,
-                                            lambda, beta, rho);
+  SparseAutoencoderFunctionType<MatType> encoderFunction(data, visibleSize,
+      hiddenSize, lambda, beta, rho);
 
   parameters = encoderFunction.GetInitialPoint();
 
@@ -43,8 +43,8 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
       << "trained model is " << out << "." << std::endl;
 }
 
-template<typename OptimizerType, typename... CallbackTypes>
-SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
+template<typename OptimizerType, typename MatType, typename... CallbackTypes>
+SparseAutoencoder::SparseAutoencoder(const MatType& data,
                                      const size_t visibleSize,
                                      const size_t hiddenSize,
                                      double lambda,
@@ -58,8 +58,8 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
     beta(beta),
     rho(rho)
 {
-  SparseAutoencoderFunction encoderFunction(data, visibleSize, hiddenSize,
-                                            lambda, beta, rho);
+  SparseAutoencoderFunctionType<MatType> encoderFunction(data, visibleSize,
+      hiddenSize, lambda, beta, rho);
 
   parameters = encoderFunction.GetInitialPoint();
 
@@ -71,15 +71,16 @@ SparseAutoencoder::SparseAutoencoder(const arma::mat& data,
       << "trained model is " << out << "." << std::endl;
 }
 
-inline void SparseAutoencoder::GetNewFeatures(arma::mat& data,
-                                              arma::mat& features)
+template<typename MatType>
+void SparseAutoencoder::GetNewFeatures(const MatType& data,
+                                       arma::mat& features)
 {
   const size_t l1 = hiddenSize;
   const size_t l2 = visibleSize;
 
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      features);
+  arma::mat hiddenInput = parameters.submat(0, 0, l1 - 1, l2 - 1) * data;
+  hiddenInput.each_col() += parameters.submat(0, l2, l1 - 1, l2);
+  Sigmoid(hiddenInput, features);
 }
 
 } // namespace mlpack
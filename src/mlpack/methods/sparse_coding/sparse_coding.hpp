@@ -197,6 +197,18 @@ class SparseCoding
    */
   void Encode(const MatType& data, MatType& codes);
 
+  /**
+   * Sparse code each point in the given dataset via LARS, using the current
+   * dictionary, and store the encoded data in a sparse matrix.  Only the
+   * nonzero coefficients are kept, so a dense codes matrix is never formed;
+   * this is useful when encoding many points.
+   *
+   * @param data Input data matrix to be encoded.
+   * @param codes Output sparse codes matrix.
+   */
+  template<typename eT>
+  void Encode(const MatType& data, arma::SpMat<eT>& codes);
+
   /**
    * Learn dictionary via Newton method based on Lagrange dual.
    *
@@ -262,6 +274,14 @@ class SparseCoding
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Encode each point of the given data in parallel, and call
+   * `store(i, code)` with the code of each point `i`.  `store()` may be called
+   * from several threads at once.
+   */
+  template<typename StoreFunctionType>
+  void EncodePoints(const MatType& data, StoreFunctionType store);
+
   //! Number of atoms.
   size_t atoms;
 
@@ -61,30 +61,63 @@ template<typename MatType>
 inline void SparseCoding<MatType>::Encode(const MatType& data,
                                           MatType& codes)
 {
-  // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
-  MatType matGram = trans(dictionary) * dictionary;
-
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  EncodePoints(data, [&](const size_t i, const ColType& code)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
+    codes.col(i) = code;
+  });
+}
 
-    bool useCholesky = true;
-    // Intercept fitting and data normalization is disabled.
-    LARS<MatType> lars(useCholesky, lambda1, lambda2,
-        1e-16 /* default tolerance */, false, false);
+template<typename MatType>
+template<typename eT>
+inline void SparseCoding<MatType>::Encode(const MatType& data,
+                                          arma::SpMat<eT>& codes)
+{
+  #ifdef MLPACK_USE_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+  #else
+    const size_t numThreads = 1;
+  #endif
+
+  // Each thread collects the (atom, point) locations and the values of the
+  // nonzero coefficients it finds; they are gathered once all points are done.
+  std::vector<std::vector<arma::uword>> locations(numThreads);
+  std::vector<std::vector<eT>> values(numThreads);
+  EncodePoints(data, [&](const size_t i, const ColType& code)
+  {
+    #ifdef MLPACK_USE_OPENMP
+      const size_t thread = omp_get_thread_num();
+    #else
+      const size_t thread = 0;
+    #endif
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    ColType code = codes.unsafe_col(i);
-    RowType responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, false, useCholesky, matGram);
-    code = lars.Beta();
+    for (size_t j = 0; j < code.n_elem; ++j)
+    {
+      if (code[j] != 0)
+      {
+        locations[thread].push_back(j);
+        locations[thread].push_back(i);
+        values[thread].push_back((eT) code[j]);
+      }
+    }
+  });
+
+  size_t nonzeros = 0;
+  for (size_t t = 0; t < numThreads; ++t)
+    nonzeros += values[t].size();
+
+  arma::umat allLocations(2, nonzeros);
+  arma::Col<eT> allValues(nonzeros);
+  size_t offset = 0;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    std::copy(locations[t].begin(), locations[t].end(),
+        allLocations.memptr() + 2 * offset);
+    std::copy(values[t].begin(), values[t].end(), allValues.memptr() + offset);
+    offset += values[t].size();
   }
+
+  codes = arma::SpMat<eT>(allLocations, allValues, atoms, data.n_cols);
 }
 
 // Dictionary step for optimization.
@@ -400,6 +433,37 @@ void SparseCoding<MatType>::serialize(Archive& ar, const uint32_t version)
   ar(CEREAL_NVP(newtonTolerance));
 }
 
+template<typename MatType>
+template<typename StoreFunctionType>
+inline void SparseCoding<MatType>::EncodePoints(const MatType& data,
+                                                StoreFunctionType store)
+{
+  // When using the Cholesky version of LARS, this is correct even if
+  // lambda2 > 0.
+  MatType matGram = trans(dictionary) * dictionary;
+
+  // Each point is an independent LARS problem that shares the Gram matrix of
+  // the dictionary, so the points are encoded in parallel.
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  #pragma omp parallel
+  {
+    // Each thread reuses one LARS object, and so its workspace, for all of its
+    // points.  Intercept fitting and data normalization is disabled.
+    const bool useCholesky = true;
+    LARS<MatType> lars(useCholesky, lambda1, lambda2,
+        1e-16 /* default tolerance */, false, false);
+
+    #pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const RowType responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, false, useCholesky, matGram);
+      store(i, lars.Beta());
+    }
+  }
+}
+
 } // namespace mlpack
 
 #endif
@@ -44,6 +44,10 @@ SVDPlusPlusFunction<MatType>::SVDPlusPlusFunction(
   // Unused:
   //     row(rank).subvec(numUsers + numItems, numUsers + 2 * numItems - 1)
   initialPoint.randu(rank + 1, numUsers + 2 * numItems);
+
+  // UpdateRating() reads the CSC arrays of the implicit data directly, from
+  // several threads.
+  this->implicitData.sync();
 }
 
 template<typename MatType>
@@ -285,6 +289,63 @@ void SVDPlusPlusFunction<MatType>::Gradient(const arma::mat& parameters,
   }
 }
 
+template <typename MatType>
+void SVDPlusPlusFunction<MatType>::UpdateRating(arma::mat& parameters,
+                                                const size_t user,
+                                                const size_t item,
+                                                const double rating,
+                                                const double stepSize) const
+{
+  // The biases are stored in the last row of the parameters.
+  double* userVec = parameters.colptr(user);
+  double* itemVec = parameters.colptr(numUsers + item);
+  const size_t implicitStart = numUsers + numItems;
+
+  // Iterate through each item which the user interacted with to calculate
+  // user vector.
+  arma::vec implicitVec(rank, arma::fill::zeros);
+  const arma::uword begin = implicitData.col_ptrs[user];
+  const arma::uword end = implicitData.col_ptrs[user + 1];
+  for (arma::uword k = begin; k < end; ++k)
+  {
+    implicitVec += parameters.col(implicitStart +
+        implicitData.row_indices[k]).subvec(0, rank - 1);
+  }
+  const size_t implicitCount = end - begin;
+  if (implicitCount != 0)
+    implicitVec /= std::sqrt(implicitCount);
+
+  double ratingError = rating - userVec[rank] - itemVec[rank];
+  for (size_t j = 0; j < rank; ++j)
+    ratingError -= (userVec[j] + implicitVec[j]) * itemVec[j];
+
+  // Update the item implicit vectors first, since they use the old item
+  // vector.  Blocks of ratings processed in parallel share no user and no
+  // item, but they may share implicit items: these updates are lock-free
+  // (Hogwild) and may occasionally overwrite each other.
+  for (arma::uword k = begin; k < end; ++k)
+  {
+    // Note that implicitCount != 0 if this loop is actually executed.
+    double* y = parameters.colptr(implicitStart + implicitData.row_indices[k]);
+    for (size_t j = 0; j < rank; ++j)
+    {
+      y[j] -= stepSize * 2.0 * (lambda / implicitCount * y[j] -
+          ratingError / std::sqrt(implicitCount) * itemVec[j]);
+    }
+  }
+
+  for (size_t j = 0; j < rank; ++j)
+  {
+    const double userValue = userVec[j];
+    userVec[j] -= stepSize * 2 * (lambda * userValue -
+        ratingError * itemVec[j]);
+    itemVec[j] -= stepSize * 2 * (lambda * itemVec[j] -
+        ratingError * (userValue + implicitVec[j]));
+  }
+  userVec[rank] -= stepSize * 2 * (lambda * userVec[rank] - ratingError);
+  itemVec[rank] -= stepSize * 2 * (lambda * itemVec[rank] - ratingError);
+}
+
 } // namespace mlpack
 
 // Template specialization for the SGD optimizer.
@@ -398,159 +459,22 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     mlpack::SVDPlusPlusFunction<arma::mat>& function,
     arma::mat& iterate)
 {
-  double overallObjective = DBL_MAX;
-  double lastObjective;
-
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
-  const size_t numUsers = function.NumUsers();
-  const size_t numItems = function.NumItems();
-  const double lambda = function.Lambda();
-
-  // Rank of decomposition.
-  const size_t rank = function.Rank();
-
-  // Iterate till the objective is within tolerance or the maximum number of
-  // allowed iterations is reached. If maxIterations is 0, this will iterate
-  // till convergence.
-  for (size_t i = 1; i != maxIterations; ++i)
-  {
-    // Calculate the overall objective.
-    lastObjective = overallObjective;
-    overallObjective = 0;
-
-    #pragma omp parallel for reduction(+:overallObjective)
-    for (size_t j = 0; j < (size_t) function.NumFunctions(); ++j)
-    {
-      overallObjective += function.Evaluate(iterate, j);
-    }
-
-    // Output current objective function.
-    mlpack::Log::Info << "Parallel SGD: iteration " << i << ", objective "
-        << overallObjective << "." << std::endl;
-
-    if (std::isnan(overallObjective) || std::isinf(overallObjective))
-    {
-      mlpack::Log::Warn << "Parallel SGD: converged to " << overallObjective
-          << "; terminating with failure. Try a smaller step size?"
-          << std::endl;
-      return overallObjective;
-    }
-
-    if (std::abs(lastObjective - overallObjective) < tolerance)
-    {
-      mlpack::Log::Info << "SGD: minimized within tolerance " << tolerance
-          << "; terminating optimization." << std::endl;
-      return overallObjective;
-    }
-
-    // Get the stepsize for this iteration
-    double stepSize = decayPolicy.StepSize(i);
-
-    if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::RandGen());
-
-    #pragma omp parallel
-    {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef MLPACK_USE_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
-      {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
-        {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
-        userVec += iterate.col(user).subvec(0, rank - 1);
-
-        double ratingError = rating - userBias - itemBias -
-        dot(userVec, iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
-        {
-          for (size_t i = 0; i < rank; ++i)
-          {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
-          }
-        }
-      }
-    }
-  }
-  mlpack::Log::Info << "\n Parallel SGD terminated with objective : "
-      << overallObjective << std::endl;
+  const mlpack::StratifiedSGD sgd(function.Dataset(), function.NumUsers(),
+      function.NumItems());
+  return sgd.Optimize(function, iterate, maxIterations, tolerance, shuffle,
+      decayPolicy);
+}
 
-  return overallObjective;
+template <>
+template <>
+inline double ParallelSGD<ConstantStep>::Optimize(
+    mlpack::SVDPlusPlusFunction<arma::mat>& function,
+    arma::mat& iterate)
+{
+  const mlpack::StratifiedSGD sgd(function.Dataset(), function.NumUsers(),
+      function.NumItems());
+  return sgd.Optimize(function, iterate, maxIterations, tolerance, shuffle,
+      decayPolicy);
 }
 
 } // namespace ens
@@ -91,6 +91,43 @@ class SSELoss
 
     return std::pow(ApplyL1(accu(gradients)), 2) / (accu(hessians) + lambda);
   }
+
+  /**
+   * Compute the first order gradients and the second order gradients
+   * (hessians) of the loss of each point with respect to its prediction.
+   * These are used by XGBoostRegressor to fit each new tree.
+   *
+   * @param observed The true observed values.
+   * @param predicted The prediction at the current step of boosting.
+   * @param gradients Set to the first order gradient of each point.
+   * @param hessians Set to the second order gradient of each point.
+   */
+  template<typename VecType>
+  void Gradients(const VecType& observed,
+                 const VecType& predicted,
+                 VecType& gradients,
+                 VecType& hessians) const
+  {
+    gradients = predicted - observed;
+    hessians.ones(observed.n_elem);
+  }
+
+  /**
+   * Return the mean loss of the given predictions.  This is used by
+   * XGBoostRegressor to decide when to stop training early.
+   *
+   * @param observed The true observed values.
+   * @param predicted The predicted values.
+   */
+  template<typename VecType>
+  double Loss(const VecType& observed, const VecType& predicted) const
+  {
+    if (observed.n_elem == 0)
+      return 0.0;
+
+    return 0.5 * accu(square(predicted - observed)) / observed.n_elem;
+  }
+
  private:
   //! The L1 regularization parameter.
   const double alpha;
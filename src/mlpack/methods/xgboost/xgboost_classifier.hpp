@@ -0,0 +1,269 @@
+/**
+ * @file methods/xgboost/xgboost_classifier.hpp
+ *
+ * Definition of the XGBoostClassifier class, which implements gradient boosted
+ * classification trees in the style of XGBoost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_CLASSIFIER_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_CLASSIFIER_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
+
+namespace mlpack {
+
+/**
+ * The XGBoostClassifier class implements gradient boosted classification trees
+ * with second order (Newton) boosting of the softmax cross-entropy loss, as
+ * done by XGBoost with the "multi:softprob" objective.  The model holds one
+ * score for each class, and the probabilities of the classes are the softmax
+ * of the scores.  The scores start from the log of the prior probability of
+ * each class, and each boosting round fits one regression tree for each class
+ * to the Newton steps of the cross-entropy loss with respect to the score of
+ * that class (see XGBoostRegressor for details).  The trees of the classes of
+ * a round are independent, so they are trained in parallel with OpenMP.
+ *
+ * As in XGBoostRegressor, each tree is grown with HistogramNumericSplit, each
+ * split only considers a random subset of the dimensions if subspaceDim is
+ * given, and training can stop early when the cross-entropy on a validation
+ * set stops improving.
+ */
+class XGBoostClassifier
+{
+ public:
+  //! The type of tree fit for each class in each boosting round.
+  typedef DecisionTreeRegressor<MSEGain, HistogramNumericSplit,
+      AllCategoricalSplit, MultipleRandomDimensionSelect> TreeType;
+
+  /**
+   * Construct the XGBoostClassifier without training it.  Classify() will
+   * throw an exception until Train() is called.
+   */
+  XGBoostClassifier();
+
+  /**
+   * Construct the XGBoostClassifier and train it on the given data and labels.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.  These should be in the
+   *     range [0, numClasses - 1].
+   * @param numClasses Number of classes in the dataset.
+   * @param numRounds Number of boosting rounds.
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   */
+  template<typename MatType>
+  XGBoostClassifier(const MatType& data,
+                    const arma::Row<size_t>& labels,
+                    const size_t numClasses,
+                    const size_t numRounds = 100,
+                    const double learningRate = 0.3,
+                    const size_t maximumDepth = 6,
+                    const size_t minimumLeafSize = 10,
+                    const double minimumGainSplit = 1e-7,
+                    const size_t subspaceDim = 0);
+
+  /**
+   * Train the model on the given data and labels, for the given number of
+   * boosting rounds.  This overwrites any existing model.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.  These should be in the
+   *     range [0, numClasses - 1].
+   * @param numClasses Number of classes in the dataset.
+   * @param numRounds Number of boosting rounds.
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   * @return The mean cross-entropy of the model on the training set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t subspaceDim = 0);
+
+  /**
+   * Train the model on the given data and labels, stopping early once the
+   * cross-entropy on the given validation set has not improved for
+   * earlyStoppingRounds rounds.  The model is then truncated to the number of
+   * rounds with the lowest validation cross-entropy.  This overwrites any
+   * existing model.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels for each training point.  These should be in the
+   *     range [0, numClasses - 1].
+   * @param numClasses Number of classes in the dataset.
+   * @param validationData Dataset to evaluate the loss on after each round.
+   * @param validationLabels Labels for each validation point.
+   * @param earlyStoppingRounds Number of rounds without improvement of the
+   *     validation loss after which training stops.
+   * @param numRounds Maximum number of boosting rounds.
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   * @return The best mean cross-entropy of the model on the validation set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const MatType& validationData,
+               const arma::Row<size_t>& validationLabels,
+               const size_t earlyStoppingRounds,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t subspaceDim = 0);
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to classify.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and the probability of each class.
+   *
+   * @param point Point to classify.
+   * @param prediction Will be set to the predicted class of the point.
+   * @param probabilities Will be set to the probability of each class.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of the given points.
+   *
+   * @param data Set of points to classify.
+   * @param predictions Will be filled with the predicted class of each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of the given points and the probabilities of each
+   * class for each point.
+   *
+   * @param data Set of points to classify.
+   * @param predictions Will be filled with the predicted class of each point.
+   * @param probabilities Will be filled with the class probabilities of each
+   *     point (one column per point).
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+  //! Get the number of boosting rounds in the model.
+  size_t NumRounds() const
+  { return (numClasses == 0) ? 0 : trees.size() / numClasses; }
+  //! Get the tree of the given class in the given boosting round.
+  const TreeType& Tree(const size_t round, const size_t c) const
+  { return trees[round * numClasses + c]; }
+
+  //! Get the initial score of each class.
+  const arma::vec& InitialScores() const { return initialScores; }
+  //! Get the learning rate the output of each tree is scaled by.
+  double LearningRate() const { return learningRate; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Train the model, stopping early if a validation set is given (that is, if
+   * validationData is not NULL).
+   */
+  template<typename MatType>
+  double TrainInternal(const MatType& data,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const MatType* validationData,
+                       const arma::Row<size_t>* validationLabels,
+                       const size_t earlyStoppingRounds,
+                       const size_t numRounds,
+                       const double learningRate,
+                       const size_t maximumDepth,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       const size_t subspaceDim);
+
+  /**
+   * Compute the score of each class for the given point.
+   */
+  template<typename VecType>
+  void Scores(const VecType& point, arma::vec& scores) const;
+
+  /**
+   * Add the output of the trees of the given round to the scores of each
+   * point.
+   */
+  template<typename MatType>
+  void UpdateScores(const MatType& data,
+                    const size_t round,
+                    arma::mat& scores) const;
+
+  /**
+   * Convert the scores of each point (one column per point) to class
+   * probabilities, in place.
+   */
+  static void Softmax(arma::mat& scores);
+
+  /**
+   * Return the mean cross-entropy of the given class probabilities.
+   */
+  static double CrossEntropy(const arma::mat& probabilities,
+                             const arma::Row<size_t>& labels);
+
+  //! The trees of each boosting round; the tree of class c in round r is
+  //! trees[r * numClasses + c].
+  std::vector<TreeType> trees;
+  //! The initial score of each class.
+  arma::vec initialScores;
+  //! The learning rate.
+  double learningRate;
+  //! The number of classes.
+  size_t numClasses;
+  //! The dimensionality of the training data.
+  size_t dimensionality;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_classifier_impl.hpp"
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * @file methods/xgboost/xgboost_classifier_impl.hpp
+ *
+ * Implementation of the XGBoostClassifier class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_CLASSIFIER_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_CLASSIFIER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost_classifier.hpp"
+
+namespace mlpack {
+
+inline XGBoostClassifier::XGBoostClassifier() :
+    learningRate(0.0),
+    numClasses(0),
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+XGBoostClassifier::XGBoostClassifier(const MatType& data,
+                                     const arma::Row<size_t>& labels,
+                                     const size_t numClasses,
+                                     const size_t numRounds,
+                                     const double learningRate,
+                                     const size_t maximumDepth,
+                                     const size_t minimumLeafSize,
+                                     const double minimumGainSplit,
+                                     const size_t subspaceDim)
+{
+  TrainInternal(data, labels, numClasses, (const MatType*) NULL, NULL, 0,
+      numRounds, learningRate, maximumDepth, minimumLeafSize, minimumGainSplit,
+      subspaceDim);
+}
+
+template<typename MatType>
+double XGBoostClassifier::Train(const MatType& data,
+                                const arma::Row<size_t>& labels,
+                                const size_t numClasses,
+                                const size_t numRounds,
+                                const double learningRate,
+                                const size_t maximumDepth,
+                                const size_t minimumLeafSize,
+                                const double minimumGainSplit,
+                                const size_t subspaceDim)
+{
+  return TrainInternal(data, labels, numClasses, (const MatType*) NULL, NULL,
+      0, numRounds, learningRate, maximumDepth, minimumLeafSize,
+      minimumGainSplit, subspaceDim);
+}
+
+template<typename MatType>
+double XGBoostClassifier::Train(const MatType& data,
+                                const arma::Row<size_t>& labels,
+                                const size_t numClasses,
+                                const MatType& validationData,
+                                const arma::Row<size_t>& validationLabels,
+                                const size_t earlyStoppingRounds,
+                                const size_t numRounds,
+                                const double learningRate,
+                                const size_t maximumDepth,
+                                const size_t minimumLeafSize,
+                                const double minimumGainSplit,
+                                const size_t subspaceDim)
+{
+  return TrainInternal(data, labels, numClasses, &validationData,
+      &validationLabels, earlyStoppingRounds, numRounds, learningRate,
+      maximumDepth, minimumLeafSize, minimumGainSplit, subspaceDim);
+}
+
+template<typename VecType>
+size_t XGBoostClassifier::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+  return prediction;
+}
+
+template<typename VecType>
+void XGBoostClassifier::Classify(const VecType& point,
+                                 size_t& prediction,
+                                 arma::vec& probabilities) const
+{
+  if (trees.size() == 0)
+  {
+    probabilities.clear();
+    throw std::invalid_argument("XGBoostClassifier::Classify(): no model "
+        "trained!");
+  }
+
+  util::CheckSameDimensionality(point, dimensionality,
+      "XGBoostClassifier::Classify()", "point");
+
+  Scores(point, probabilities);
+  probabilities = arma::exp(probabilities - probabilities.max());
+  probabilities /= arma::accu(probabilities);
+  prediction = probabilities.index_max();
+}
+
+template<typename MatType>
+void XGBoostClassifier::Classify(const MatType& data,
+                                 arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void XGBoostClassifier::Classify(const MatType& data,
+                                 arma::Row<size_t>& predictions,
+                                 arma::mat& probabilities) const
+{
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+    throw std::invalid_argument("XGBoostClassifier::Classify(): no model "
+        "trained!");
+  }
+
+  util::CheckSameDimensionality(data, dimensionality,
+      "XGBoostClassifier::Classify()");
+
+  probabilities.set_size(numClasses, data.n_cols);
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::vec scores;
+    Scores(data.col(i), scores);
+    probabilities.col(i) = scores;
+  }
+
+  Softmax(probabilities);
+  predictions = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(probabilities, 0));
+}
+
+template<typename Archive>
+void XGBoostClassifier::serialize(Archive& ar, const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // Allocate space if needed.
+  if (cereal::is_loading<Archive>())
+    trees.resize(numTrees);
+
+  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(initialScores));
+  ar(CEREAL_NVP(learningRate));
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(dimensionality));
+}
+
+template<typename MatType>
+double XGBoostClassifier::TrainInternal(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const MatType* validationData,
+    const arma::Row<size_t>* validationLabels,
+    const size_t earlyStoppingRounds,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t subspaceDim)
+{
+  util::CheckSameSizes(data, labels, "XGBoostClassifier::Train()");
+  if (numClasses < 2)
+  {
+    throw std::invalid_argument("XGBoostClassifier::Train(): there must be at "
+        "least two classes!");
+  }
+  if (labels.n_elem > 0 && labels.max() >= numClasses)
+  {
+    throw std::invalid_argument("XGBoostClassifier::Train(): labels must be "
+        "in the range [0, numClasses - 1]!");
+  }
+  if (numRounds == 0)
+  {
+    throw std::invalid_argument("XGBoostClassifier::Train(): number of rounds "
+        "must be positive!");
+  }
+  if (learningRate <= 0.0)
+  {
+    throw std::invalid_argument("XGBoostClassifier::Train(): learning rate "
+        "must be positive!");
+  }
+  if (subspaceDim > data.n_rows)
+  {
+    throw std::invalid_argument("XGBoostClassifier::Train(): subspace "
+        "dimensionality must not be greater than data dimensionality!");
+  }
+  if (validationData != NULL)
+  {
+    util::CheckSameSizes(*validationData, *validationLabels,
+        "XGBoostClassifier::Train()", "validation labels");
+    util::CheckSameDimensionality(*validationData, data,
+        "XGBoostClassifier::Train()", "validation data");
+    if (validationLabels->n_elem > 0 && validationLabels->max() >= numClasses)
+    {
+      throw std::invalid_argument("XGBoostClassifier::Train(): validation "
+          "labels must be in the range [0, numClasses - 1]!");
+    }
+  }
+
+  trees.clear();
+  trees.reserve(numRounds * numClasses);
+  this->learningRate = learningRate;
+  this->numClasses = numClasses;
+  dimensionality = data.n_rows;
+
+  // Start from the log of the prior probability of each class (with add-one
+  // smoothing, so that no score is infinite).
+  initialScores.ones(numClasses);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    initialScores[labels[i]] += 1.0;
+  initialScores = arma::log(initialScores /
+      (double) (labels.n_elem + numClasses));
+
+  const size_t numDimensions = (subspaceDim == 0) ? data.n_rows : subspaceDim;
+
+  arma::mat scores(numClasses, data.n_cols);
+  scores.each_col() = initialScores;
+  arma::mat probabilities;
+
+  arma::mat validationScores;
+  double bestLoss = 0.0;
+  size_t bestRounds = 0;
+  if (validationData != NULL)
+  {
+    validationScores.set_size(numClasses, validationData->n_cols);
+    validationScores.each_col() = initialScores;
+  }
+
+  for (size_t round = 0; round < numRounds; ++round)
+  {
+    probabilities = scores;
+    Softmax(probabilities);
+
+    // The gradient of the cross-entropy with respect to the score of class c
+    // is p_c - 1{y = c}, and its hessian is p_c (1 - p_c).  The tree of each
+    // class only depends on the scores before this round, so the trees of all
+    // classes can be trained at the same time.
+    trees.resize(trees.size() + numClasses);
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      const arma::rowvec p = probabilities.row(c);
+      const arma::rowvec gradients = p -
+          arma::conv_to<arma::rowvec>::from(labels == c);
+
+      // A point that is classified with certainty has a hessian of almost
+      // zero; bound it away from zero so that the Newton steps stay finite.
+      const arma::rowvec hessians = arma::clamp(p % (1.0 - p), 1e-6, 0.25);
+
+      trees[round * numClasses + c].Train(data,
+          arma::rowvec(-gradients / hessians), hessians, minimumLeafSize,
+          minimumGainSplit, maximumDepth,
+          MultipleRandomDimensionSelect(numDimensions));
+    }
+
+    UpdateScores(data, round, scores);
+
+    if (validationData != NULL)
+    {
+      UpdateScores(*validationData, round, validationScores);
+      probabilities = validationScores;
+      Softmax(probabilities);
+
+      const double validationLoss = CrossEntropy(probabilities,
+          *validationLabels);
+      Log::Debug << "XGBoostClassifier::Train(): round " << round + 1
+          << ", validation loss " << validationLoss << "." << std::endl;
+
+      if (round == 0 || validationLoss < bestLoss)
+      {
+        bestLoss = validationLoss;
+        bestRounds = round + 1;
+      }
+      else if (round + 1 - bestRounds >= earlyStoppingRounds)
+      {
+        Log::Info << "XGBoostClassifier::Train(): validation loss has not "
+            << "improved for " << earlyStoppingRounds << " rounds; stopping "
+            << "after " << bestRounds << " rounds." << std::endl;
+        break;
+      }
+    }
+  }
+
+  if (validationData != NULL)
+  {
+    trees.erase(trees.begin() + bestRounds * numClasses, trees.end());
+    return bestLoss;
+  }
+
+  probabilities = scores;
+  Softmax(probabilities);
+  return CrossEntropy(probabilities, labels);
+}
+
+template<typename VecType>
+void XGBoostClassifier::Scores(const VecType& point, arma::vec& scores) const
+{
+  scores = initialScores;
+  for (size_t i = 0; i < trees.size(); ++i)
+    scores[i % numClasses] += learningRate * trees[i].Predict(point);
+}
+
+template<typename MatType>
+void XGBoostClassifier::UpdateScores(const MatType& data,
+                                     const size_t round,
+                                     arma::mat& scores) const
+{
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t c = 0; c < numClasses; ++c)
+    {
+      scores(c, i) += learningRate *
+          trees[round * numClasses + c].Predict(data.col(i));
+    }
+  }
+}
+
+inline void XGBoostClassifier::Softmax(arma::mat& scores)
+{
+  // Subtract the largest score of each point to avoid overflow.
+  scores.each_row() -= arma::max(scores, 0);
+  scores = arma::exp(scores);
+  scores.each_row() /= arma::sum(scores, 0);
+}
+
+inline double XGBoostClassifier::CrossEntropy(
+    const arma::mat& probabilities,
+    const arma::Row<size_t>& labels)
+{
+  if (labels.n_elem == 0)
+    return 0.0;
+
+  double loss = 0.0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    loss -= std::log(std::max(probabilities(labels[i], i), 1e-15));
+
+  return loss / labels.n_elem;
+}
+
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,415 @@
+/**
+ * @file methods/xgboost/xgboost_main.cpp
+ *
+ * A program to build and evaluate gradient boosted trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#undef BINDING_NAME
+#define BINDING_NAME xgboost
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/methods/xgboost/xgboost.hpp>
+
+using namespace mlpack;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_USER_NAME("Gradient boosted trees (XGBoost)");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of gradient boosted decision trees in the style of "
+    "XGBoost, for classification and regression.  Given labeled data or data "
+    "with responses, a boosted model can be trained and saved for future use; "
+    "or, a pre-trained model can be used for prediction.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program trains and evaluates gradient boosted decision trees with "
+    "second order (Newton) boosting, as done by XGBoost.  In each boosting "
+    "round, a regression tree is fit to the gradients and hessians of the loss "
+    "of each training point, and the output of the tree, scaled by the "
+    "learning rate, is added to the model.  For classification, the softmax "
+    "cross-entropy loss is used and one tree is fit for each class in each "
+    "round; for regression, the squared error loss is used."
+    "\n\n"
+    "The training set is specified with the " + PRINT_PARAM_STRING("training") +
+    " parameter.  For classification, the labels are specified with the " +
+    PRINT_PARAM_STRING("labels") + " parameter, and should be in the range "
+    "`[0, num_classes - 1]`.  For regression, the responses are specified with "
+    "the " + PRINT_PARAM_STRING("responses") + " parameter instead.  The " +
+    PRINT_PARAM_STRING("num_rounds") + " parameter controls the number of "
+    "boosting rounds, and the " + PRINT_PARAM_STRING("learning_rate") +
+    " parameter is the shrinkage applied to the output of each tree.  The " +
+    PRINT_PARAM_STRING("maximum_depth") + ", " +
+    PRINT_PARAM_STRING("minimum_leaf_size") + " and " +
+    PRINT_PARAM_STRING("minimum_gain_split") + " parameters control the "
+    "size of each tree, and the " + PRINT_PARAM_STRING("subspace_dim") +
+    " parameter can be used to only consider a random subset of the dimensions "
+    "for each split."
+    "\n\n"
+    "If a validation set is given with the " +
+    PRINT_PARAM_STRING("validation") + " parameter (and its labels or "
+    "responses with the " + PRINT_PARAM_STRING("validation_labels") + " or " +
+    PRINT_PARAM_STRING("validation_responses") + " parameter), training stops "
+    "once the loss on the validation set has not improved for " +
+    PRINT_PARAM_STRING("early_stopping_rounds") + " rounds, and the model is "
+    "truncated to the number of rounds with the lowest validation loss."
+    "\n\n"
+    "A trained model may be saved with the " +
+    PRINT_PARAM_STRING("output_model") + " output parameter, and loaded for "
+    "predictions with the " + PRINT_PARAM_STRING("input_model") + " parameter."
+    "  Test data may be specified with the " + PRINT_PARAM_STRING("test") +
+    " parameter.  For classification, the predicted class of each test point "
+    "is saved to the " + PRINT_PARAM_STRING("predictions") + " output "
+    "parameter and the class probabilities to the " +
+    PRINT_PARAM_STRING("probabilities") + " output parameter; if " +
+    PRINT_PARAM_STRING("test_labels") + " is given, the accuracy on the test "
+    "set is printed.  For regression, the predicted responses are saved to the "
+    + PRINT_PARAM_STRING("predicted_responses") + " output parameter; if " +
+    PRINT_PARAM_STRING("test_responses") + " is given, the mean squared error "
+    "on the test set is printed.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to train a boosted classifier with 50 rounds and a maximum "
+    "depth of 4 on the dataset contained in " + PRINT_DATASET("data") +
+    " with labels " + PRINT_DATASET("labels") + ", saving the model to " +
+    PRINT_MODEL("xgb_model") + ", one could call"
+    "\n\n" +
+    PRINT_CALL("xgboost", "training", "data", "labels", "labels",
+        "num_rounds", 50, "maximum_depth", 4, "output_model", "xgb_model") +
+    "\n\n"
+    "Then, to use that model to classify points in " +
+    PRINT_DATASET("test_set") + " while saving the predictions for each point "
+    "to " + PRINT_DATASET("predictions") + ", one could call "
+    "\n\n" +
+    PRINT_CALL("xgboost", "input_model", "xgb_model", "test", "test_set",
+        "predictions", "predictions"));
+
+// See also...
+BINDING_SEE_ALSO("@decision_tree", "#decision_tree");
+BINDING_SEE_ALSO("@random_forest", "#random_forest");
+BINDING_SEE_ALSO("@adaboost", "#adaboost");
+BINDING_SEE_ALSO("Gradient boosting on Wikipedia",
+    "https://en.wikipedia.org/wiki/Gradient_boosting");
+BINDING_SEE_ALSO("XGBoost: A Scalable Tree Boosting System (pdf)",
+    "https://arxiv.org/pdf/1603.02754");
+BINDING_SEE_ALSO("XGBoostClassifier C++ class documentation",
+    "@src/mlpack/methods/xgboost/xgboost_classifier.hpp");
+BINDING_SEE_ALSO("XGBoostRegressor C++ class documentation",
+    "@src/mlpack/methods/xgboost/xgboost_regressor.hpp");
+
+PARAM_MATRIX_IN("training", "Training dataset.", "t");
+PARAM_UROW_IN("labels", "Labels for the training dataset (for "
+    "classification).", "l");
+PARAM_ROW_IN("responses", "Responses for the training dataset (for "
+    "regression).", "r");
+
+PARAM_MATRIX_IN("validation", "Validation dataset, used to stop training "
+    "early.", "v");
+PARAM_UROW_IN("validation_labels", "Labels for the validation dataset.", "V");
+PARAM_ROW_IN("validation_responses", "Responses for the validation dataset.",
+    "R");
+PARAM_INT_IN("early_stopping_rounds", "Number of rounds without improvement "
+    "of the validation loss after which training stops.", "e", 10);
+
+PARAM_MATRIX_IN("test", "Test dataset to produce predictions for.", "T");
+PARAM_UROW_IN("test_labels", "Test dataset labels, if accuracy calculation is "
+    "desired.", "L");
+PARAM_ROW_IN("test_responses", "Test dataset responses, if error calculation "
+    "is desired.", "E");
+
+PARAM_INT_IN("num_rounds", "Number of boosting rounds.", "N", 100);
+PARAM_DOUBLE_IN("learning_rate", "Shrinkage applied to the output of each "
+    "tree.", "a", 0.3);
+PARAM_INT_IN("maximum_depth", "Maximum depth of each tree (0 means no limit).",
+    "D", 6);
+PARAM_INT_IN("minimum_leaf_size", "Minimum number of points in each leaf "
+    "node.", "n", 10);
+PARAM_DOUBLE_IN("minimum_gain_split", "Minimum gain needed to make a split "
+    "when building a tree.", "g", 1e-7);
+PARAM_INT_IN("subspace_dim", "Number of random dimensions to consider for each "
+    "split.  '0' will use all dimensions.", "d", 0);
+
+PARAM_UROW_OUT("predictions", "Predicted classes for each point in the test "
+    "set.", "p");
+PARAM_MATRIX_OUT("probabilities", "Predicted class probabilities for each "
+    "point in the test set.", "P");
+PARAM_ROW_OUT("predicted_responses", "Predicted responses for each point in "
+    "the test set.", "o");
+
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+/**
+ * This is the class that we will serialize.  It holds either a boosted
+ * classifier or a boosted regressor.
+ */
+class XGBoostModel
+{
+ public:
+  // Whether the model is a regressor.
+  bool regression;
+  // The classifier, used if regression is false.
+  XGBoostClassifier classifier;
+  // The regressor, used if regression is true.
+  XGBoostRegressor<> regressor;
+
+  // Create the model.
+  XGBoostModel() : regression(false) { /* Nothing to do. */ }
+
+  // Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(regression));
+    if (regression)
+      ar(CEREAL_NVP(regressor));
+    else
+      ar(CEREAL_NVP(classifier));
+  }
+};
+
+PARAM_MODEL_IN(XGBoostModel, "input_model", "Pre-trained boosted model to use "
+    "for prediction.", "m");
+PARAM_MODEL_OUT(XGBoostModel, "output_model", "Model to save trained boosted "
+    "model to.", "M");
+
+void BINDING_FUNCTION(util::Params& params, util::Timers& timers)
+{
+  // Initialize random seed if needed.
+  if (params.Get<int>("seed") != 0)
+    RandomSeed((size_t) params.Get<int>("seed"));
+  else
+    RandomSeed((size_t) std::time(NULL));
+
+  // Check for incompatible input parameters.
+  RequireOnlyOnePassed(params, { "training", "input_model" }, true);
+  if (params.Has("training"))
+  {
+    RequireOnlyOnePassed(params, { "labels", "responses" }, true);
+  }
+  ReportIgnoredParam(params, {{ "training", false }}, "labels");
+  ReportIgnoredParam(params, {{ "training", false }}, "responses");
+
+  RequireAtLeastOnePassed(params, { "test", "output_model" }, false,
+      "the trained model will not be used or saved");
+
+  ReportIgnoredParam(params, {{ "training", false }}, "validation");
+  ReportIgnoredParam(params, {{ "validation", false }}, "validation_labels");
+  ReportIgnoredParam(params, {{ "validation", false }},
+      "validation_responses");
+  ReportIgnoredParam(params, {{ "validation", false }},
+      "early_stopping_rounds");
+  if (params.Has("training") && params.Has("validation"))
+  {
+    if (params.Has("labels"))
+    {
+      RequireAtLeastOnePassed(params, { "validation_labels" }, true, "must "
+          "pass validation labels when validation set given");
+    }
+    else
+    {
+      RequireAtLeastOnePassed(params, { "validation_responses" }, true, "must "
+          "pass validation responses when validation set given");
+    }
+  }
+
+  ReportIgnoredParam(params, {{ "training", false }}, "num_rounds");
+  ReportIgnoredParam(params, {{ "training", false }}, "learning_rate");
+  ReportIgnoredParam(params, {{ "training", false }}, "maximum_depth");
+  ReportIgnoredParam(params, {{ "training", false }}, "minimum_leaf_size");
+  ReportIgnoredParam(params, {{ "training", false }}, "minimum_gain_split");
+  ReportIgnoredParam(params, {{ "training", false }}, "subspace_dim");
+
+  ReportIgnoredParam(params, {{ "test", false }}, "test_labels");
+  ReportIgnoredParam(params, {{ "test", false }}, "test_responses");
+  ReportIgnoredParam(params, {{ "test", false }}, "predictions");
+  ReportIgnoredParam(params, {{ "test", false }}, "probabilities");
+  ReportIgnoredParam(params, {{ "test", false }}, "predicted_responses");
+
+  RequireParamValue<int>(params, "num_rounds", [](int x) { return x > 0; },
+      true, "number of boosting rounds must be positive");
+  RequireParamValue<double>(params, "learning_rate",
+      [](double x) { return x > 0.0; }, true, "learning rate must be "
+      "positive");
+  RequireParamValue<int>(params, "maximum_depth", [](int x) { return x >= 0; },
+      true, "maximum depth must not be negative");
+  RequireParamValue<int>(params, "minimum_leaf_size",
+      [](int x) { return x > 0; }, true, "minimum leaf size must be greater "
+      "than 0");
+  RequireParamValue<double>(params, "minimum_gain_split",
+      [](double x) { return x >= 0.0; }, true,
+      "minimum gain for splitting must be nonnegative");
+  RequireParamValue<int>(params, "subspace_dim", [](int x) { return x >= 0; },
+      true, "subspace dimensionality must be nonnegative");
+  RequireParamValue<int>(params, "early_stopping_rounds",
+      [](int x) { return x > 0; }, true, "number of early stopping rounds "
+      "must be positive");
+
+  XGBoostModel* model;
+  if (params.Has("input_model"))
+    model = params.Get<XGBoostModel*>("input_model");
+  else
+    model = new XGBoostModel();
+
+  if (params.Has("training"))
+  {
+    timers.Start("xgboost_training");
+
+    arma::mat data = std::move(params.Get<arma::mat>("training"));
+
+    // Make sure the subspace dimensionality is valid.
+    RequireParamValue<int>(params, "subspace_dim",
+        [data](int x) { return (size_t) x <= data.n_rows; }, true, "subspace "
+        "dimensionality must not be greater than data dimensionality");
+
+    const size_t numRounds = (size_t) params.Get<int>("num_rounds");
+    const double learningRate = params.Get<double>("learning_rate");
+    const size_t maxDepth = (size_t) params.Get<int>("maximum_depth");
+    const size_t minimumLeafSize =
+        (size_t) params.Get<int>("minimum_leaf_size");
+    const double minimumGainSplit = params.Get<double>("minimum_gain_split");
+    const size_t subspaceDim = (size_t) params.Get<int>("subspace_dim");
+    const size_t earlyStoppingRounds =
+        (size_t) params.Get<int>("early_stopping_rounds");
+
+    model->regression = params.Has("responses");
+    double loss;
+    if (model->regression)
+    {
+      arma::rowvec responses =
+          std::move(params.Get<arma::rowvec>("responses"));
+
+      Log::Info << "Training boosted regressor with up to " << numRounds
+          << " rounds..." << endl;
+      if (params.Has("validation"))
+      {
+        arma::mat validationData =
+            std::move(params.Get<arma::mat>("validation"));
+        arma::rowvec validationResponses =
+            std::move(params.Get<arma::rowvec>("validation_responses"));
+
+        loss = model->regressor.Train(data, responses, validationData,
+            validationResponses, earlyStoppingRounds, numRounds, learningRate,
+            maxDepth, minimumLeafSize, minimumGainSplit, subspaceDim);
+        Log::Info << "Trained " << model->regressor.NumTrees() << " rounds; "
+            << "best loss on validation set: " << loss << "." << endl;
+      }
+      else
+      {
+        loss = model->regressor.Train(data, responses, numRounds,
+            learningRate, maxDepth, minimumLeafSize, minimumGainSplit,
+            subspaceDim);
+        Log::Info << "Loss on training set: " << loss << "." << endl;
+      }
+    }
+    else
+    {
+      arma::Row<size_t> labels =
+          std::move(params.Get<arma::Row<size_t>>("labels"));
+      const size_t numClasses = std::max(max(labels) + 1, (size_t) 2);
+
+      Log::Info << "Training boosted classifier with up to " << numRounds
+          << " rounds..." << endl;
+      if (params.Has("validation"))
+      {
+        arma::mat validationData =
+            std::move(params.Get<arma::mat>("validation"));
+        arma::Row<size_t> validationLabels =
+            std::move(params.Get<arma::Row<size_t>>("validation_labels"));
+
+        loss = model->classifier.Train(data, labels, numClasses,
+            validationData, validationLabels, earlyStoppingRounds, numRounds,
+            learningRate, maxDepth, minimumLeafSize, minimumGainSplit,
+            subspaceDim);
+        Log::Info << "Trained " << model->classifier.NumRounds() << " rounds; "
+            << "best cross-entropy on validation set: " << loss << "." << endl;
+      }
+      else
+      {
+        loss = model->classifier.Train(data, labels, numClasses, numRounds,
+            learningRate, maxDepth, minimumLeafSize, minimumGainSplit,
+            subspaceDim);
+        Log::Info << "Cross-entropy on training set: " << loss << "." << endl;
+      }
+    }
+
+    timers.Stop("xgboost_training");
+  }
+
+  if (params.Has("test"))
+  {
+    arma::mat testData = std::move(params.Get<arma::mat>("test"));
+    timers.Start("xgboost_prediction");
+
+    if (model->regression)
+    {
+      ReportIgnoredParam(params, "test_labels", "the model is a regressor");
+
+      arma::rowvec predictions;
+      model->regressor.Predict(testData, predictions);
+
+      // Did we want to calculate the test error?
+      if (params.Has("test_responses"))
+      {
+        arma::rowvec testResponses =
+            std::move(params.Get<arma::rowvec>("test_responses"));
+        if (testResponses.n_elem != predictions.n_elem)
+        {
+          Log::Fatal << "Number of test responses (" << testResponses.n_elem
+              << ") does not match number of test points ("
+              << predictions.n_elem << ")!" << endl;
+        }
+
+        const double mse = arma::mean(arma::square(predictions -
+            testResponses));
+        Log::Info << "Mean squared error on test set: " << mse << "." << endl;
+      }
+
+      params.Get<arma::rowvec>("predicted_responses") = std::move(predictions);
+    }
+    else
+    {
+      ReportIgnoredParam(params, "test_responses", "the model is a "
+          "classifier");
+
+      arma::Row<size_t> predictions;
+      arma::mat probabilities;
+      model->classifier.Classify(testData, predictions, probabilities);
+
+      // Did we want to calculate test accuracy?
+      if (params.Has("test_labels"))
+      {
+        arma::Row<size_t> testLabels =
+            std::move(params.Get<arma::Row<size_t>>("test_labels"));
+        if (testLabels.n_elem != predictions.n_elem)
+        {
+          Log::Fatal << "Number of test labels (" << testLabels.n_elem
+              << ") does not match number of test points ("
+              << predictions.n_elem << ")!" << endl;
+        }
+
+        const size_t correct = accu(predictions == testLabels);
+        Log::Info << correct << " of " << testLabels.n_elem << " correct on "
+            << "test set (" << (double(correct) / double(testLabels.n_elem) *
+            100) << ")." << endl;
+      }
+
+      params.Get<arma::mat>("probabilities") = std::move(probabilities);
+      params.Get<arma::Row<size_t>>("predictions") = std::move(predictions);
+    }
+
+    timers.Stop("xgboost_prediction");
+  }
+
+  // Save the output model.
+  params.Get<XGBoostModel*>("output_model") = model;
+}
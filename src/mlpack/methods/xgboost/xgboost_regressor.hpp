@@ -0,0 +1,225 @@
+/**
+ * @file methods/xgboost/xgboost_regressor.hpp
+ *
+ * Definition of the XGBoostRegressor class, which implements gradient boosted
+ * regression trees in the style of XGBoost.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_REGRESSOR_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_REGRESSOR_HPP
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree_regressor.hpp>
+#include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
+#include "loss_functions/sse_loss.hpp"
+
+namespace mlpack {
+
+/**
+ * The XGBoostRegressor class implements gradient boosted regression trees with
+ * second order (Newton) boosting, as done by XGBoost:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={{XGBoost}: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * Starting from the initial prediction of the loss function, each boosting
+ * round computes the gradient g and the hessian h of the loss of each training
+ * point, and fits a regression tree to the Newton steps -g / h with weights h.
+ * With these weights the gain of a split is the XGBoost gain, and the value of
+ * each leaf is -G / H, where G and H are the sums of the gradients and hessians
+ * of the points in the leaf.  The output of the tree, scaled by the learning
+ * rate, is then added to the predictions.
+ *
+ * Each tree is grown with HistogramNumericSplit, so finding the split of a node
+ * only needs one pass over the points of each dimension.  For column
+ * subsampling, each split only considers a random subset of the dimensions.
+ * If a validation set is given, training stops once the loss on the
+ * validation set has not improved for a given number of rounds, and the model
+ * is truncated to the best number of rounds.
+ *
+ * @tparam LossFunction Loss function to minimize; it must implement
+ *     InitialPrediction(), Gradients() and Loss(), like SSELoss.
+ */
+template<typename LossFunction = SSELoss>
+class XGBoostRegressor
+{
+ public:
+  //! The type of tree fit in each boosting round.
+  typedef DecisionTreeRegressor<MSEGain, HistogramNumericSplit,
+      AllCategoricalSplit, MultipleRandomDimensionSelect> TreeType;
+
+  /**
+   * Construct the XGBoostRegressor without training it.  Predict() will throw
+   * an exception until Train() is called.
+   */
+  XGBoostRegressor();
+
+  /**
+   * Construct the XGBoostRegressor and train it on the given data and
+   * responses.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numRounds Number of boosting rounds (trees).
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   * @param loss Instantiated loss function.
+   */
+  template<typename MatType>
+  XGBoostRegressor(const MatType& data,
+                   const arma::rowvec& responses,
+                   const size_t numRounds = 100,
+                   const double learningRate = 0.3,
+                   const size_t maximumDepth = 6,
+                   const size_t minimumLeafSize = 10,
+                   const double minimumGainSplit = 1e-7,
+                   const size_t subspaceDim = 0,
+                   LossFunction loss = LossFunction());
+
+  /**
+   * Train the model on the given data and responses, for the given number of
+   * boosting rounds.  This overwrites any existing model.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param numRounds Number of boosting rounds (trees).
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   * @param loss Instantiated loss function.
+   * @return The loss of the model on the training set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::rowvec& responses,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t subspaceDim = 0,
+               LossFunction loss = LossFunction());
+
+  /**
+   * Train the model on the given data and responses, stopping early once the
+   * loss on the given validation set has not improved for earlyStoppingRounds
+   * rounds.  The model is then truncated to the number of rounds with the
+   * lowest validation loss.  This overwrites any existing model.
+   *
+   * @param data Dataset to train on.
+   * @param responses Responses for each training point.
+   * @param validationData Dataset to evaluate the loss on after each round.
+   * @param validationResponses Responses for each validation point.
+   * @param earlyStoppingRounds Number of rounds without improvement of the
+   *     validation loss after which training stops.
+   * @param numRounds Maximum number of boosting rounds (trees).
+   * @param learningRate Shrinkage applied to the output of each tree.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf node.
+   * @param minimumGainSplit Minimum gain for a node to split.
+   * @param subspaceDim Number of random dimensions to consider for each split
+   *     (0 means all dimensions).
+   * @param loss Instantiated loss function.
+   * @return The best loss of the model on the validation set.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::rowvec& responses,
+               const MatType& validationData,
+               const arma::rowvec& validationResponses,
+               const size_t earlyStoppingRounds,
+               const size_t numRounds = 100,
+               const double learningRate = 0.3,
+               const size_t maximumDepth = 6,
+               const size_t minimumLeafSize = 10,
+               const double minimumGainSplit = 1e-7,
+               const size_t subspaceDim = 0,
+               LossFunction loss = LossFunction());
+
+  /**
+   * Predict the response of the given point.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  /**
+   * Predict the responses of the given points.
+   *
+   * @param data Set of points to predict.
+   * @param predictions This will be filled with the prediction of each point.
+   */
+  template<typename MatType>
+  void Predict(const MatType& data, arma::rowvec& predictions) const;
+
+  //! Get the number of trees (boosting rounds) in the model.
+  size_t NumTrees() const { return trees.size(); }
+  //! Get the tree of the given boosting round.
+  const TreeType& Tree(const size_t i) const { return trees[i]; }
+
+  //! Get the initial prediction that the trees are added to.
+  double InitialPrediction() const { return initialPrediction; }
+  //! Get the learning rate the output of each tree is scaled by.
+  double LearningRate() const { return learningRate; }
+
+  /**
+   * Serialize the model.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Train the model, stopping early if a validation set is given (that is, if
+   * validationData is not NULL).
+   */
+  template<typename MatType>
+  double TrainInternal(const MatType& data,
+                       const arma::rowvec& responses,
+                       const MatType* validationData,
+                       const arma::rowvec* validationResponses,
+                       const size_t earlyStoppingRounds,
+                       const size_t numRounds,
+                       const double learningRate,
+                       const size_t maximumDepth,
+                       const size_t minimumLeafSize,
+                       const double minimumGainSplit,
+                       const size_t subspaceDim,
+                       LossFunction& loss);
+
+  //! The trees of each boosting round.
+  std::vector<TreeType> trees;
+  //! The initial prediction of the loss function.
+  double initialPrediction;
+  //! The learning rate.
+  double learningRate;
+  //! The dimensionality of the training data.
+  size_t dimensionality;
+};
+
+} // namespace mlpack
+
+// Include implementation.
+#include "xgboost_regressor_impl.hpp"
+
+#endif
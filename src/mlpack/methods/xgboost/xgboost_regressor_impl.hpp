@@ -0,0 +1,272 @@
+/**
+ * @file methods/xgboost/xgboost_regressor_impl.hpp
+ *
+ * Implementation of the XGBoostRegressor class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_XGBOOST_XGBOOST_REGRESSOR_IMPL_HPP
+#define MLPACK_METHODS_XGBOOST_XGBOOST_REGRESSOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "xgboost_regressor.hpp"
+
+namespace mlpack {
+
+template<typename LossFunction>
+XGBoostRegressor<LossFunction>::XGBoostRegressor() :
+    initialPrediction(0.0),
+    learningRate(0.0),
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+template<typename LossFunction>
+template<typename MatType>
+XGBoostRegressor<LossFunction>::XGBoostRegressor(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t subspaceDim,
+    LossFunction loss)
+{
+  TrainInternal(data, responses, (const MatType*) NULL, NULL, 0, numRounds,
+      learningRate, maximumDepth, minimumLeafSize, minimumGainSplit,
+      subspaceDim, loss);
+}
+
+template<typename LossFunction>
+template<typename MatType>
+double XGBoostRegressor<LossFunction>::Train(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t subspaceDim,
+    LossFunction loss)
+{
+  return TrainInternal(data, responses, (const MatType*) NULL, NULL, 0,
+      numRounds, learningRate, maximumDepth, minimumLeafSize, minimumGainSplit,
+      subspaceDim, loss);
+}
+
+template<typename LossFunction>
+template<typename MatType>
+double XGBoostRegressor<LossFunction>::Train(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const MatType& validationData,
+    const arma::rowvec& validationResponses,
+    const size_t earlyStoppingRounds,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t subspaceDim,
+    LossFunction loss)
+{
+  return TrainInternal(data, responses, &validationData, &validationResponses,
+      earlyStoppingRounds, numRounds, learningRate, maximumDepth,
+      minimumLeafSize, minimumGainSplit, subspaceDim, loss);
+}
+
+template<typename LossFunction>
+template<typename VecType>
+double XGBoostRegressor<LossFunction>::Predict(const VecType& point) const
+{
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("XGBoostRegressor::Predict(): no model "
+        "trained!");
+  }
+
+  util::CheckSameDimensionality(point, dimensionality,
+      "XGBoostRegressor::Predict()", "point");
+
+  double prediction = initialPrediction;
+  for (size_t i = 0; i < trees.size(); ++i)
+    prediction += learningRate * trees[i].Predict(point);
+
+  return prediction;
+}
+
+template<typename LossFunction>
+template<typename MatType>
+void XGBoostRegressor<LossFunction>::Predict(const MatType& data,
+                                             arma::rowvec& predictions) const
+{
+  if (trees.size() == 0)
+  {
+    predictions.clear();
+    throw std::invalid_argument("XGBoostRegressor::Predict(): no model "
+        "trained!");
+  }
+
+  util::CheckSameDimensionality(data, dimensionality,
+      "XGBoostRegressor::Predict()");
+
+  predictions.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (size_t i = 0; i < data.n_cols; ++i)
+    predictions[i] = Predict(data.col(i));
+}
+
+template<typename LossFunction>
+template<typename Archive>
+void XGBoostRegressor<LossFunction>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  size_t numTrees;
+  if (cereal::is_loading<Archive>())
+    trees.clear();
+  else
+    numTrees = trees.size();
+
+  ar(CEREAL_NVP(numTrees));
+
+  // Allocate space if needed.
+  if (cereal::is_loading<Archive>())
+    trees.resize(numTrees);
+
+  ar(CEREAL_NVP(trees));
+  ar(CEREAL_NVP(initialPrediction));
+  ar(CEREAL_NVP(learningRate));
+  ar(CEREAL_NVP(dimensionality));
+}
+
+template<typename LossFunction>
+template<typename MatType>
+double XGBoostRegressor<LossFunction>::TrainInternal(
+    const MatType& data,
+    const arma::rowvec& responses,
+    const MatType* validationData,
+    const arma::rowvec* validationResponses,
+    const size_t earlyStoppingRounds,
+    const size_t numRounds,
+    const double learningRate,
+    const size_t maximumDepth,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    const size_t subspaceDim,
+    LossFunction& loss)
+{
+  util::CheckSameSizes(data, responses, "XGBoostRegressor::Train()",
+      "responses");
+  if (numRounds == 0)
+  {
+    throw std::invalid_argument("XGBoostRegressor::Train(): number of rounds "
+        "must be positive!");
+  }
+  if (learningRate <= 0.0)
+  {
+    throw std::invalid_argument("XGBoostRegressor::Train(): learning rate "
+        "must be positive!");
+  }
+  if (subspaceDim > data.n_rows)
+  {
+    throw std::invalid_argument("XGBoostRegressor::Train(): subspace "
+        "dimensionality must not be greater than data dimensionality!");
+  }
+  if (validationData != NULL)
+  {
+    util::CheckSameSizes(*validationData, *validationResponses,
+        "XGBoostRegressor::Train()", "validation responses");
+    util::CheckSameDimensionality(*validationData, data,
+        "XGBoostRegressor::Train()", "validation data");
+  }
+
+  trees.clear();
+  trees.reserve(numRounds);
+  this->learningRate = learningRate;
+  dimensionality = data.n_rows;
+  initialPrediction = loss.InitialPrediction(responses);
+
+  const size_t numDimensions = (subspaceDim == 0) ? data.n_rows : subspaceDim;
+
+  arma::rowvec predictions(data.n_cols);
+  predictions.fill(initialPrediction);
+
+  arma::rowvec validationPredictions;
+  double bestLoss = 0.0;
+  size_t bestRounds = 0;
+  if (validationData != NULL)
+  {
+    validationPredictions.set_size(validationData->n_cols);
+    validationPredictions.fill(initialPrediction);
+  }
+
+  arma::rowvec gradients, hessians;
+  for (size_t round = 0; round < numRounds; ++round)
+  {
+    loss.Gradients(responses, predictions, gradients, hessians);
+
+    // The hessian is the weight of each point, so it must not be zero.
+    hessians = arma::clamp(hessians, 1e-16,
+        std::numeric_limits<double>::max());
+
+    // Fit the Newton step of each point, weighted by its hessian.
+    trees.emplace_back();
+    trees.back().Train(data, arma::rowvec(-gradients / hessians), hessians,
+        minimumLeafSize, minimumGainSplit, maximumDepth,
+        MultipleRandomDimensionSelect(numDimensions));
+
+    const TreeType& tree = trees.back();
+    #pragma omp parallel for
+    for (size_t i = 0; i < data.n_cols; ++i)
+      predictions[i] += learningRate * tree.Predict(data.col(i));
+
+    if (validationData != NULL)
+    {
+      #pragma omp parallel for
+      for (size_t i = 0; i < validationData->n_cols; ++i)
+      {
+        validationPredictions[i] += learningRate *
+            tree.Predict(validationData->col(i));
+      }
+
+      const double validationLoss = loss.Loss(*validationResponses,
+          validationPredictions);
+      Log::Debug << "XGBoostRegressor::Train(): round " << round + 1
+          << ", validation loss " << validationLoss << "." << std::endl;
+
+      if (round == 0 || validationLoss < bestLoss)
+      {
+        bestLoss = validationLoss;
+        bestRounds = round + 1;
+      }
+      else if (round + 1 - bestRounds >= earlyStoppingRounds)
+      {
+        Log::Info << "XGBoostRegressor::Train(): validation loss has not "
+            << "improved for " << earlyStoppingRounds << " rounds; stopping "
+            << "after " << bestRounds << " rounds." << std::endl;
+        break;
+      }
+    }
+  }
+
+  if (validationData != NULL)
+  {
+    trees.erase(trees.begin() + bestRounds, trees.end());
+    return bestLoss;
+  }
+
+  return loss.Loss(responses, predictions);
+}
+
+} // namespace mlpack
+
+#endif
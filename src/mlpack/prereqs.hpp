@@ -36,5 +36,7 @@
 
 // Include ready to use utility function to check sizes of datasets.
 #include <mlpack/core/util/size_checks.hpp>
+#include <mlpack/core/util/profiler.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 #endif
@@ -1104,3 +1104,44 @@ TEMPLATE_TEST_CASE("AdaBoostTrainOverloads", "[AdaBoostTest]", fmat, mat)
   REQUIRE(a3.WeakLearner(0).MaxIterations() == 1000);
   REQUIRE(a4.WeakLearner(0).MaxIterations() == 100);
 }
+
+/**
+ * Make sure that classifying many points at once (in several blocks) gives the
+ * same results as classifying each point by itself.
+ */
+TEMPLATE_TEST_CASE("AdaBoostBatchClassifyTest", "[AdaBoostTest]", mat, fmat)
+{
+  typedef TestType MatType;
+  typedef typename MatType::elem_type eT;
+
+  MatType inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  Mat<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+  AdaBoost<ID3DecisionStump, MatType> a(inputData, labels.row(0), numClasses,
+      50, (eT) 1e-10);
+
+  // Repeat the data so that there is more than one block of points.
+  MatType testData = repmat(inputData, 1, 10);
+
+  Row<size_t> predictions;
+  Mat<eT> probabilities;
+  a.Classify(testData, predictions, probabilities);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  for (size_t i = 0; i < testData.n_cols; i += 13)
+  {
+    size_t prediction;
+    Row<eT> pointProbabilities;
+    a.Classify(testData.col(i), prediction, pointProbabilities);
+
+    REQUIRE(prediction == predictions[i]);
+    for (size_t c = 0; c < numClasses; ++c)
+      REQUIRE(pointProbabilities[c] == Approx(probabilities(c, i)));
+  }
+}
@@ -882,4 +882,62 @@ TEST_CASE("BipolaSigmoidFunctionTest", "[ActivationFunctionsTest]")
   arma::mat inputTemp(activationData.n_elem, 1);
   double maxRelativeError = ActivationJacobianTest<BipolarSigmoidFunction>(inputTemp,-2,2);
   REQUIRE(maxRelativeError <= 1e-3);
-}
\ No newline at end of file
+}
+/**
+ * Check that a fast activation function and its derivative stay within the
+ * given absolute tolerance of the exact function, in double and single
+ * precision.
+ */
+template<typename FastFunction, typename ExactFunction>
+void CheckFastActivation(const double tolerance)
+{
+  arma::mat x = arma::linspace<arma::vec>(-30, 30, 6001);
+  arma::mat exact, exactDeriv, fast, fastDeriv;
+  ExactFunction::Fn(x, exact);
+  ExactFunction::Deriv(x, exact, exactDeriv);
+  FastFunction::Fn(x, fast);
+  FastFunction::Deriv(x, fast, fastDeriv);
+
+  // The error of GELU and Mish grows with |x|.
+  const arma::mat scale = arma::max(arma::abs(x), arma::ones(arma::size(x)));
+  REQUIRE(arma::max(arma::vectorise(arma::abs(fast - exact) / scale)) <=
+      tolerance);
+  REQUIRE(arma::max(arma::vectorise(arma::abs(fastDeriv - exactDeriv))) <=
+      10 * tolerance);
+
+  // Single precision.
+  arma::fmat xf = arma::conv_to<arma::fmat>::from(x);
+  arma::fmat fastf;
+  FastFunction::Fn(xf, fastf);
+  REQUIRE(arma::max(arma::vectorise(arma::abs(fastf - arma::conv_to<
+      arma::fmat>::from(exact)) / arma::conv_to<arma::fmat>::from(scale))) <=
+      10 * tolerance);
+
+  // Extreme values saturate instead of overflowing.
+  arma::mat extreme = { -1e4, -800.0, 800.0, 1e4 };
+  FastFunction::Fn(extreme, fast);
+  REQUIRE(fast.is_finite());
+
+  // The functions may be called in place.
+  arma::mat inPlace = x;
+  FastFunction::Fn(inPlace, inPlace);
+  FastFunction::Fn(x, fast);
+  CheckMatrices(inPlace, fast);
+}
+
+/**
+ * Test the fast approximations of the logistic, tanh, Swish, GELU and Mish
+ * functions against the exact functions.
+ */
+TEST_CASE("FastActivationFunctionsTest", "[ActivationFunctionsTest]")
+{
+  CheckFastActivation<FastLogisticFunction, LogisticFunction>(1e-6);
+  CheckFastActivation<FastTanhFunction, TanhFunction>(1e-6);
+  CheckFastActivation<FastSwishFunction, SwishFunction>(1e-6);
+  CheckFastActivation<FastGELUFunction, GELUFunction>(1e-6);
+  CheckFastActivation<FastMishFunction, MishFunction>(1e-6);
+
+  // FastExp() itself has a relative error below 2e-7.
+  for (double v = -700.0; v <= 700.0; v += 0.37)
+    REQUIRE(std::abs(FastExp(v) / std::exp(v) - 1.0) <= 2e-7);
+}
@@ -175,6 +175,14 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<ValidConvolution> >(input, filter,
       output);
 
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<ValidConvolution> >(input, filter,
       output);
@@ -212,6 +220,14 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output);
 
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
+
   // Perform the convolution trough fft.
   Convolution2DMethodTest<FFTConvolution<FullConvolution> >(input, filter,
       output);
@@ -257,6 +273,14 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution through matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution3DMethodTest<WinogradConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
@@ -306,6 +330,14 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   Convolution3DMethodTest<NaiveConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
 
+  // Perform the convolution through matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd algorithm.
+  Convolution3DMethodTest<WinogradConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   Convolution3DMethodTest<FFTConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
@@ -348,6 +380,14 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution through matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
@@ -394,6 +434,14 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   ConvolutionMethodBatchTest<NaiveConvolution<FullConvolution> >(input,
       filterCube, outputCube);
 
+  // Perform the convolution through matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
+  // Perform the convolution with the Winograd algorithm.
+  ConvolutionMethodBatchTest<WinogradConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+
   // Perform the convolution trough fft.
   ConvolutionMethodBatchTest<FFTConvolution<FullConvolution> >(input,
       filterCube, outputCube);
@@ -427,6 +475,10 @@ TEST_CASE("Stride2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 1, 1);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 1, 1);
 }
 
 TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
@@ -447,6 +499,10 @@ TEST_CASE("Stride3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 3, 1, 1);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 3, 1, 1);
 }
 
 TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
@@ -468,6 +524,10 @@ TEST_CASE("UnequalStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 3, 2, 1, 1);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 3, 2, 1, 1);
 }
 
 TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
@@ -492,6 +552,10 @@ TEST_CASE("Dilation2ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 2, 2);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 2, 2);
 }
 
 TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
@@ -517,6 +581,10 @@ TEST_CASE("Dilation3ConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 3);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 3);
 }
 
 TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
@@ -541,6 +609,10 @@ TEST_CASE("UnequalDilationConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 1, 1, 3, 2);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 1, 1, 3, 2);
 }
 
 TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
@@ -562,4 +634,79 @@ TEST_CASE("DilationAndStrideConvolutionTest", "[ConvolutionTest]")
   // Perform the naive convolution approach.
   Convolution2DMethodTest<NaiveConvolution<FullConvolution> >(input, filter,
       output, 2, 2, 2, 2);
+
+  // Perform the convolution through matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output, 2, 2, 2, 2);
+}
+
+/**
+ * Make sure that the Winograd convolution gives the same results as the naive
+ * convolution when the output size is odd, and when the filter or the stride
+ * are not supported by the Winograd algorithm.
+ */
+TEST_CASE("WinogradConvolutionTest", "[ConvolutionTest]")
+{
+  arma::mat input(9, 8, arma::fill::randu);
+  arma::mat filter(3, 3, arma::fill::randn);
+  arma::mat otherFilter(2, 4, arma::fill::randn);
+
+  arma::mat naiveOutput, output;
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, naiveOutput);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter, output);
+  CheckMatrices(output, naiveOutput);
+
+  NaiveConvolution<FullConvolution>::Convolution(input, filter, naiveOutput);
+  WinogradConvolution<FullConvolution>::Convolution(input, filter, output);
+  CheckMatrices(output, naiveOutput);
+
+  // Appending must add to the existing output.
+  arma::mat appended = naiveOutput;
+  WinogradConvolution<FullConvolution>::Convolution(input, filter, appended, 1,
+      1, 1, 1, true);
+  CheckMatrices(appended, arma::mat(2 * naiveOutput));
+
+  NaiveConvolution<ValidConvolution>::Convolution(input, otherFilter,
+      naiveOutput);
+  WinogradConvolution<ValidConvolution>::Convolution(input, otherFilter,
+      output);
+  CheckMatrices(output, naiveOutput);
+
+  NaiveConvolution<ValidConvolution>::Convolution(input, filter, naiveOutput,
+      2, 2);
+  WinogradConvolution<ValidConvolution>::Convolution(input, filter, output, 2,
+      2);
+  CheckMatrices(output, naiveOutput);
+}
+
+/**
+ * Make sure that the FFT convolution of a set of slices with one filter, which
+ * only transforms the filter once, gives the same result as the convolution of
+ * each slice.
+ */
+TEST_CASE("FFTConvolutionSharedFilterTest", "[ConvolutionTest]")
+{
+  arma::cube input(8, 6, 4, arma::fill::randu);
+  arma::mat filter(3, 3, arma::fill::randn);
+
+  arma::cube output;
+  FFTConvolution<FullConvolution>::Convolution(input, filter, output);
+  REQUIRE(output.n_slices == input.n_slices);
+
+  for (size_t i = 0; i < input.n_slices; ++i)
+  {
+    arma::mat sliceOutput;
+    FFTConvolution<FullConvolution>::Convolution(input.slice(i), filter,
+        sliceOutput);
+    CheckMatrices(output.slice(i), sliceOutput);
+  }
+
+  FFTConvolution<ValidConvolution>::Convolution(input, filter, output);
+  for (size_t i = 0; i < input.n_slices; ++i)
+  {
+    arma::mat sliceOutput;
+    FFTConvolution<ValidConvolution>::Convolution(input.slice(i), filter,
+        sliceOutput);
+    CheckMatrices(output.slice(i), sliceOutput);
+  }
 }
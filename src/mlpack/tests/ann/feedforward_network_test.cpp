@@ -982,3 +982,574 @@ TEST_CASE("RBFNetworkTest", "[FeedForwardNetworkTest]")
   // RBFN neural net with MeanSquaredError.
   TestNetwork<>(model1, dataset, labels1, dataset, labels, 10, 0.1);
 }
+
+/**
+ * Make sure that a frozen network gives the same predictions as the original
+ * network, when BatchNorm layers are folded into Linear layers and activations
+ * are run in place.
+ */
+TEST_CASE("FFNFreezeLinearTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(8);
+  BatchNorm* batchNorm = new BatchNorm(0, 0);
+  model.Add(batchNorm);
+  model.Add<ReLU>();
+  model.Add<Dropout>(0.3);
+  model.Add<Linear>(6);
+  model.Add<BatchNorm>(0, 0);
+  model.Add<Linear>(3);
+  model.Add<TanH>();
+
+  model.Reset(5);
+  model.Parameters().randn();
+  batchNorm->TrainingMean().randn();
+  batchNorm->TrainingVariance().randu();
+  batchNorm->TrainingVariance() += 0.5;
+
+  arma::mat data(5, 300, arma::fill::randn);
+  arma::mat predictions, frozenPredictions;
+  model.Predict(data, predictions);
+
+  model.Freeze();
+  REQUIRE(model.Frozen());
+  model.Predict(data, frozenPredictions, 64);
+  CheckMatrices(predictions, frozenPredictions);
+
+  // A copy of the frozen network must give the same predictions too.
+  FFN<MeanSquaredError> copy(model);
+  REQUIRE(copy.Frozen());
+  copy.Predict(data, frozenPredictions);
+  CheckMatrices(predictions, frozenPredictions);
+
+  // Modifying the parameters discards the plan.
+  model.Parameters() *= 2;
+  REQUIRE(!model.Frozen());
+}
+
+/**
+ * Make sure that a frozen convolutional network gives the same predictions as
+ * the original network, when BatchNorm layers are folded into Convolution
+ * layers.
+ */
+TEST_CASE("FFNFreezeConvolutionTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<Convolution>(3, 3, 3, 1, 1, 1, 1);
+  BatchNorm* batchNorm = new BatchNorm();
+  model.Add(batchNorm);
+  model.Add<LeakyReLU>();
+  model.Add<MaxPooling>(2, 2, 2, 2);
+  model.Add<Linear>(4);
+
+  model.InputDimensions() = std::vector<size_t>({ 8, 8, 2 });
+  model.Reset();
+  model.Parameters().randn();
+  batchNorm->TrainingMean().randn();
+  batchNorm->TrainingVariance().randu();
+  batchNorm->TrainingVariance() += 0.5;
+
+  arma::mat data(128, 20, arma::fill::randn);
+  arma::mat predictions, frozenPredictions;
+  model.Predict(data, predictions);
+
+  model.Freeze();
+  model.Predict(data, frozenPredictions, 7);
+  CheckMatrices(predictions, frozenPredictions);
+}
+
+/**
+ * Check the conversions to and from float16 and bfloat16 on values with known
+ * representations, including rounding, overflow and subnormal values.
+ */
+TEST_CASE("HalfPrecisionConversionTest", "[FeedForwardNetworkTest]")
+{
+  REQUIRE(FloatToHalf(1.0f) == 0x3C00);
+  REQUIRE(FloatToHalf(-2.0f) == 0xC000);
+  REQUIRE(FloatToHalf(65504.0f) == 0x7BFF);
+  REQUIRE(FloatToHalf(65520.0f) == 0x7C00);
+  REQUIRE(FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001);
+  REQUIRE(FloatToHalf(std::ldexp(1.0f, -26)) == 0x0000);
+  // 1 + 2^-11 is halfway between two float16 values, and rounds to even.
+  REQUIRE(FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+  REQUIRE(HalfToFloat(0x3555) == Approx(0.333251953125f).epsilon(1e-7));
+  REQUIRE(HalfToFloat(0x0001) == std::ldexp(1.0f, -24));
+
+  REQUIRE(FloatToBFloat16(1.0f) == 0x3F80);
+  REQUIRE(FloatToBFloat16(-3.0f) == 0xC040);
+  REQUIRE(BFloat16ToFloat(0x3F80) == 1.0f);
+
+  // Converting to 16 bits and back gives the rounded values.
+  arma::fmat data(10, 10, arma::fill::randn);
+  arma::Mat<arma::u16> halfData;
+  arma::fmat converted;
+  ToHalf(data, halfData, MixedPrecision::BFLOAT16);
+  FromHalf(halfData, converted, MixedPrecision::BFLOAT16);
+  MixedPrecision(MixedPrecision::BFLOAT16).Round(data);
+  REQUIRE(arma::all(arma::vectorise(data == converted)));
+}
+
+/**
+ * Train a network with float16 mixed precision, and make sure that it can
+ * still learn, and that its master weights stay in full precision.
+ */
+TEST_CASE("FFNMixedPrecisionTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  arma::mat testData;
+  if (!data::Load("thyroid_test.csv", testData))
+    FAIL("Cannot load dataset thyroid_test.csv");
+
+  arma::mat testLabels = testData.row(testData.n_rows - 1) - 1;
+  testData.shed_row(testData.n_rows - 1);
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.Precision() = MixedPrecision(MixedPrecision::FLOAT16, 1024.0, 50);
+
+  TestNetwork<>(model, trainData, trainLabels, testData, testLabels, 10, 0.1);
+
+  // The master weights are not rounded to float16.
+  arma::mat rounded = model.Parameters();
+  model.Precision().Round(rounded);
+  REQUIRE(arma::any(arma::vectorise(rounded != model.Parameters())));
+}
+
+/**
+ * Make sure that training with several replicas of the network gives the same
+ * result as training with one, since each batch is only split across them.
+ */
+TEST_CASE("FFNReplicasTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 200, arma::fill::randn);
+  arma::mat labels = arma::floor(3 * arma::randu<arma::mat>(1, 200));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.Reset(10);
+
+  // The copy starts with the same parameters.
+  FFN<NegativeLogLikelihood> parallelModel(model);
+  parallelModel.Replicas() = 3;
+
+  // 33 points per batch do not split evenly across the replicas, and the last
+  // batch of each epoch is smaller.
+  ens::StandardSGD opt(0.01, 33, 2 * data.n_cols, -1, false);
+  model.Train(data, labels, opt);
+  parallelModel.Train(data, labels, opt);
+
+  CheckMatrices(model.Parameters(), parallelModel.Parameters(), 1e-5);
+
+  arma::mat predictions, parallelPredictions;
+  model.Predict(data, predictions);
+  parallelModel.Predict(data, parallelPredictions);
+  CheckMatrices(predictions, parallelPredictions, 1e-5);
+}
+
+/**
+ * Make sure that training on a data set read chunk by chunk from files gives
+ * the same result as training on the data set in memory, when batches span
+ * two chunks.
+ */
+TEST_CASE("FFNBatchSourceTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 200, arma::fill::randn);
+  arma::mat labels = arma::floor(3 * arma::randu<arma::mat>(1, 200));
+
+  // Chunks of 70, 70 and 60 points.
+  std::vector<std::string> dataFiles, labelFiles;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const size_t end = std::min((i + 1) * 70, (size_t) data.n_cols) - 1;
+    dataFiles.push_back("ffn_chunk_data_" + std::to_string(i) + ".bin");
+    labelFiles.push_back("ffn_chunk_labels_" + std::to_string(i) + ".bin");
+    data::Save(dataFiles[i], arma::mat(data.cols(i * 70, end)), true);
+    data::Save(labelFiles[i], arma::mat(labels.cols(i * 70, end)), true);
+  }
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+  model.Reset(10);
+  FFN<NegativeLogLikelihood> streamingModel(model);
+
+  ens::StandardSGD opt(0.01, 32, 3 * data.n_cols, -1, false);
+  model.Train(data, labels, opt);
+
+  FileBatchSource<> source(dataFiles, labelFiles);
+  streamingModel.Train(source, opt);
+
+  CheckMatrices(model.Parameters(), streamingModel.Parameters());
+
+  // With shuffling, training must still visit every chunk.
+  ens::StandardSGD shuffledOpt(0.01, 32, 3 * data.n_cols, -1, true);
+  streamingModel.Train(source, shuffledOpt);
+  REQUIRE(streamingModel.Parameters().is_finite());
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    remove(dataFiles[i].c_str());
+    remove(labelFiles[i].c_str());
+  }
+}
+
+/**
+ * Make sure that an int8-quantized network gives predictions close to those
+ * of the original network, and that it can be serialized.
+ */
+TEST_CASE("FFNQuantizeTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<Convolution>(4, 3, 3, 1, 1, 1, 1);
+  model.Add<ReLU>();
+  model.Add<Linear>(16);
+  model.Add<ReLU>();
+  model.Add<Linear>(3);
+
+  model.InputDimensions() = std::vector<size_t>({ 6, 6, 2 });
+  model.Reset();
+
+  arma::mat data(72, 50, arma::fill::randn);
+  arma::mat predictions, quantizedPredictions;
+  model.Predict(data, predictions);
+
+  model.Quantize(data);
+
+  // All the weights now belong to the quantized layers.
+  REQUIRE(model.Parameters().n_elem == 0);
+
+  model.Predict(data, quantizedPredictions);
+  REQUIRE(quantizedPredictions.n_rows == predictions.n_rows);
+  REQUIRE(quantizedPredictions.n_cols == predictions.n_cols);
+  REQUIRE(arma::norm(quantizedPredictions - predictions, "fro") <
+      0.05 * arma::norm(predictions, "fro"));
+
+  FFN<MeanSquaredError> xmlModel, jsonModel, binaryModel;
+  xmlModel.Add<Linear>(10); // Layer that will get removed.
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+  CheckMatrices(quantizedPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+}
+
+/**
+ * Make sure that a pruned network keeps the largest weights of each Linear
+ * layer, computes the same outputs as the pruned dense weights, and can be
+ * serialized.
+ */
+TEST_CASE("FFNPruneTest", "[FeedForwardNetworkTest]")
+{
+  for (const bool structured : { false, true })
+  {
+    FFN<MeanSquaredError> model;
+    model.Add<Linear>(20);
+    model.Add<ReLU>();
+    model.Add<Linear>(4);
+
+    model.InputDimensions() = std::vector<size_t>({ 10 });
+    model.Reset();
+
+    const Linear* linear = dynamic_cast<const Linear*>(
+        ((const FFN<MeanSquaredError>&) model).Network()[0]);
+    REQUIRE(linear != NULL);
+    const arma::mat weight = linear->Weight();
+
+    model.Prune(0.75, structured);
+
+    // All the weights now belong to the pruned layers.
+    REQUIRE(model.Parameters().n_elem == 0);
+
+    const std::vector<Layer<arma::mat>*>& layers =
+        ((const FFN<MeanSquaredError>&) model).Network();
+    const SparseLinear* first = dynamic_cast<const SparseLinear*>(layers[0]);
+    const SparseLinear* second = dynamic_cast<const SparseLinear*>(layers[2]);
+    REQUIRE(first != NULL);
+    REQUIRE(second != NULL);
+
+    const arma::mat prunedWeight(first->Weight());
+    if (structured)
+    {
+      // Only whole output units were removed, and they are the ones with the
+      // smallest norms.
+      const arma::vec norms = arma::sqrt(arma::sum(arma::square(weight), 1));
+      const arma::uvec kept = arma::find(arma::any(prunedWeight != 0, 1));
+      REQUIRE(kept.n_elem == 5);
+      for (size_t i = 0; i < kept.n_elem; ++i)
+        CheckMatrices(prunedWeight.row(kept[i]), weight.row(kept[i]));
+
+      const arma::uvec removed = arma::find(arma::all(prunedWeight == 0, 1));
+      REQUIRE(norms.elem(removed).max() <= norms.elem(kept).min());
+    }
+    else
+    {
+      // The largest weights were kept unchanged.
+      REQUIRE(first->Weight().n_nonzero == 50);
+      const arma::uvec kept = arma::find(prunedWeight != 0);
+      const arma::uvec removed = arma::find(prunedWeight == 0);
+      CheckMatrices(prunedWeight.elem(kept), weight.elem(kept));
+      REQUIRE(arma::abs(weight.elem(removed)).max() <=
+          arma::abs(weight.elem(kept)).min());
+    }
+
+    arma::mat data(10, 30, arma::fill::randn);
+    arma::mat predictions;
+    model.Predict(data, predictions);
+
+    arma::mat hidden = arma::mat(first->Weight()) * data;
+    hidden.each_col() += first->Bias();
+    hidden.transform([](double x) { return std::max(x, 0.0); });
+    arma::mat expected = arma::mat(second->Weight()) * hidden;
+    expected.each_col() += second->Bias();
+    CheckMatrices(predictions, expected, 1e-8);
+
+    FFN<MeanSquaredError> xmlModel, jsonModel, binaryModel;
+    xmlModel.Add<Linear>(10); // Layer that will get removed.
+    SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+    arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+    xmlModel.Predict(data, xmlPredictions);
+    jsonModel.Predict(data, jsonPredictions);
+    binaryModel.Predict(data, binaryPredictions);
+    CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+        binaryPredictions);
+  }
+}
+
+/**
+ * Make sure that AsyncCheckpoint writes the parameters during training and
+ * keeps only the last checkpoints.
+ */
+TEST_CASE("FFNAsyncCheckpointTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(5, 100, arma::fill::randn);
+  arma::mat responses(3, 100, arma::fill::randn);
+
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(3);
+
+  const std::string prefix = "ffn_async_checkpoint";
+  ens::StandardSGD opt(0.01, 10, 5 * data.n_cols, -1, false);
+  {
+    AsyncCheckpoint<> checkpoint(prefix, 1, 2);
+    model.Train(data, responses, opt, checkpoint);
+    REQUIRE(checkpoint.Wait());
+
+    REQUIRE(checkpoint.Count() >= 4);
+    REQUIRE(checkpoint.Checkpoints().size() == 2);
+    REQUIRE(checkpoint.Checkpoints().back() ==
+        prefix + "_" + std::to_string(checkpoint.Count()) + ".bin");
+
+    // The older checkpoints were removed.
+    for (size_t i = 1; i + 2 <= checkpoint.Count(); ++i)
+    {
+      std::ifstream f(prefix + "_" + std::to_string(i) + ".bin");
+      REQUIRE(!f.is_open());
+    }
+
+    arma::mat loaded;
+    REQUIRE(loaded.load(checkpoint.Checkpoints().back()));
+    REQUIRE(loaded.n_elem == model.Parameters().n_elem);
+
+    for (const std::string& filename : checkpoint.Checkpoints())
+      remove(filename.c_str());
+  }
+
+  // A checkpoint can also be saved directly.
+  AsyncCheckpoint<> checkpoint(prefix, 1, 1);
+  checkpoint.Save(model.Parameters());
+  REQUIRE(checkpoint.Wait());
+  REQUIRE(checkpoint.Checkpoints().size() == 1);
+
+  arma::mat loaded;
+  REQUIRE(loaded.load(checkpoint.Checkpoints().back()));
+  CheckMatrices(loaded, model.Parameters());
+  remove(checkpoint.Checkpoints().back().c_str());
+}
+
+/**
+ * Make sure that a profiled network records each pass of each layer, and stops
+ * recording when profiling is disabled.
+ */
+TEST_CASE("FFNProfilingTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data(10, 200, arma::fill::randn);
+  arma::mat labels = arma::floor(3 * arma::randu<arma::mat>(1, 200));
+
+  FFN<NegativeLogLikelihood> model;
+  model.Add<Linear>(8);
+  model.Add<Sigmoid>();
+  model.Add<Linear>(3);
+  model.Add<LogSoftMax>();
+
+  NetworkProfiler profiler;
+  model.EnableProfiling(profiler);
+
+  ens::StandardSGD opt(0.01, 50, 2 * data.n_cols, -1, false);
+  model.Train(data, labels, opt);
+
+  std::vector<LayerProfile> layers = profiler.Layers();
+  REQUIRE(layers.size() == 4);
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    REQUIRE(layers[i].forward.calls > 0);
+    REQUIRE(layers[i].forward.calls >= layers[i].backward.calls);
+    REQUIRE(layers[i].backward.calls == layers[i].gradient.calls);
+  }
+
+  // The first layer does one multiply-add per weight and point, and writes 8
+  // elements per point.
+  REQUIRE(layers[0].forward.flops / layers[0].forward.bytes ==
+      Approx(2.0 * (10 * 8 + 8) / (8 * sizeof(double))));
+  // The sigmoid layer has no gradient.
+  REQUIRE(layers[1].gradient.flops == 0.0);
+  REQUIRE(layers[1].gradient.bytes == 0);
+
+  std::ostringstream stream;
+  profiler.Print(stream);
+  REQUIRE(stream.str().find("Layer 3 backward") != std::string::npos);
+
+  // Nothing is recorded once profiling is disabled.
+  model.DisableProfiling();
+  model.Train(data, labels, opt);
+  REQUIRE(profiler.Layers()[0].forward.calls == layers[0].forward.calls);
+}
+
+/**
+ * Make sure that several threads can predict with the same frozen network at
+ * once, each with its own workspace.
+ */
+TEST_CASE("FFNConcurrentPredictTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<Convolution>(3, 3, 3);
+  model.Add<ReLU>();
+  model.Add<Linear>(6);
+  model.Add<TanH>();
+  model.InputDimensions() = std::vector<size_t>({ 6, 6, 2 });
+  model.Reset();
+
+  arma::mat data(72, 400, arma::fill::randn);
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  // A workspace cannot be used before the network is frozen.
+  InferenceWorkspace<> workspace;
+  arma::mat workspacePredictions;
+  REQUIRE_THROWS_AS(model.Predict(data, workspacePredictions, workspace),
+      std::logic_error);
+
+  model.Freeze();
+  const FFN<MeanSquaredError>& sharedModel = model;
+
+  // Each thread predicts its own part of the data, in batches of 16.
+  const size_t numThreads = 4;
+  std::vector<InferenceWorkspace<>> workspaces(numThreads);
+  std::vector<arma::mat> threadPredictions(numThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+    {
+      const arma::mat part = data.cols(100 * t, 100 * t + 99);
+      for (size_t r = 0; r < 5; ++r)
+        sharedModel.Predict(part, threadPredictions[t], workspaces[t], 16);
+    }));
+  }
+
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+    CheckMatrices(predictions.cols(100 * t, 100 * t + 99),
+        threadPredictions[t]);
+  }
+
+  // A workspace is prepared again when the network is frozen again.
+  model.Parameters() *= 0.5;
+  model.Predict(data, predictions);
+  model.Freeze();
+  model.Predict(data, workspacePredictions, workspaces[0]);
+  CheckMatrices(predictions, workspacePredictions);
+}
+
+/**
+ * Make sure that an InferenceServer answers concurrent requests with the same
+ * results as Predict(), and groups them into micro-batches.
+ */
+TEST_CASE("FFNInferenceServerTest", "[FeedForwardNetworkTest]")
+{
+  FFN<MeanSquaredError> model;
+  model.Add<Linear>(8);
+  model.Add<ReLU>();
+  model.Add<Linear>(3);
+  model.InputDimensions() = std::vector<size_t>({ 5 });
+  model.Reset();
+
+  arma::mat data(5, 200, arma::fill::randn);
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  // The network must be frozen.
+  REQUIRE_THROWS_AS(InferenceServer<FFN<MeanSquaredError>>(model),
+      std::logic_error);
+
+  model.Freeze();
+  {
+    // Wait long enough that requests from different threads are grouped.
+    InferenceServer<FFN<MeanSquaredError>> server(model, 16, 0.01, 2);
+
+    // Points of the wrong size are rejected right away.
+    REQUIRE_THROWS_AS(server.Predict(arma::mat(4, 1, arma::fill::randu)),
+        std::invalid_argument);
+
+    // Each thread sends one point at a time; the last request of each thread
+    // holds two points.
+    const size_t numThreads = 4;
+    std::vector<std::vector<std::future<arma::mat>>> results(numThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      threads.push_back(std::thread([&, t]()
+      {
+        for (size_t i = 50 * t; i < 50 * t + 48; ++i)
+          results[t].push_back(server.Predict(data.col(i)));
+        results[t].push_back(server.Predict(data.cols(50 * t + 48,
+            50 * t + 49)));
+      }));
+    }
+
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      threads[t].join();
+      for (size_t i = 0; i < 48; ++i)
+      {
+        CheckMatrices(arma::mat(predictions.col(50 * t + i)),
+            results[t][i].get());
+      }
+      CheckMatrices(arma::mat(predictions.cols(50 * t + 48, 50 * t + 49)),
+          results[t][48].get());
+    }
+
+    server.Stop();
+    REQUIRE(server.Requests() == 4 * 49);
+    REQUIRE(server.Batches() < server.Requests());
+    REQUIRE_THROWS_AS(server.Predict(data.col(0)), std::logic_error);
+  }
+}
@@ -349,3 +349,59 @@ TEST_CASE("GradientBatchNormWithConvolutionTest", "[ANNLayerTest]")
 
   REQUIRE(gradient < 1e-1);
 }
+
+/**
+ * Jacobian test for the BatchNorm layer in training mode, with non-trivial
+ * scale and shift parameters.
+ */
+TEST_CASE("JacobianBatchNormTest", "[ANNLayerTest]")
+{
+  BatchNorm module;
+  module.Training() = true;
+  module.InputDimensions() = std::vector<size_t>({ 3, 4 });
+  module.ComputeOutputDimensions();
+  arma::mat moduleParams(module.WeightSize(), 1);
+  module.CustomInitialize(moduleParams, module.WeightSize());
+  moduleParams.randu();
+  moduleParams += 0.5;
+  module.SetWeights(moduleParams);
+
+  arma::mat input(12, 5);
+  const double error = JacobianTest(module, input);
+  REQUIRE(error <= 1e-5);
+}
+
+/**
+ * Make sure that the BatchNorm layer gives the same result in place, both in
+ * training and in testing mode.
+ */
+TEST_CASE("BatchNormInPlaceTest", "[ANNLayerTest]")
+{
+  BatchNorm module;
+  module.InputDimensions() = std::vector<size_t>({ 3, 4 });
+  module.ComputeOutputDimensions();
+  arma::mat moduleParams(module.WeightSize(), 1);
+  module.CustomInitialize(moduleParams, module.WeightSize());
+  moduleParams.randu();
+  module.SetWeights(moduleParams);
+  REQUIRE(module.ElementwiseForward());
+
+  arma::mat input(12, 7, arma::fill::randn);
+  arma::mat output(12, 7);
+
+  // Training with a copy of the layer keeps the same running statistics.
+  BatchNorm copy(module);
+  copy.SetWeights(moduleParams);
+  module.Training() = true;
+  copy.Training() = true;
+  module.Forward(input, output);
+  arma::mat inPlace(input);
+  copy.Forward(inPlace, inPlace);
+  CheckMatrices(output, inPlace, 1e-10);
+
+  module.Training() = false;
+  module.Forward(input, output);
+  inPlace = input;
+  module.Forward(inPlace, inPlace);
+  CheckMatrices(output, inPlace, 1e-10);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file tests/ann/layer/checkpoint.cpp
+ *
+ * Tests the Checkpoint layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that a Checkpoint gives the same output, delta, and gradient as a
+ * MultiLayer that holds the same layers, during training and testing.
+ */
+TEST_CASE("CheckpointMultiLayerTest", "[ANNLayerTest]")
+{
+  MultiLayer<arma::mat> multi;
+  Checkpoint checkpoint;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    multi.Add<Linear>(7);
+    multi.Add<TanH>();
+    checkpoint.Add<Linear>(7);
+    checkpoint.Add<TanH>();
+  }
+  multi.Add<Linear>(4);
+  checkpoint.Add<Linear>(4);
+
+  multi.InputDimensions() = std::vector<size_t>({ 5 });
+  multi.ComputeOutputDimensions();
+  checkpoint.InputDimensions() = std::vector<size_t>({ 5 });
+  checkpoint.ComputeOutputDimensions();
+  REQUIRE(checkpoint.WeightSize() == multi.WeightSize());
+  REQUIRE(checkpoint.OutputSize() == 4);
+
+  arma::mat parameters(multi.WeightSize(), 1, arma::fill::randn);
+  arma::mat checkpointParameters(parameters);
+  multi.SetWeights(parameters);
+  checkpoint.SetWeights(checkpointParameters);
+
+  const arma::mat input(5, 12, arma::fill::randn);
+  const arma::mat gy(4, 12, arma::fill::randn);
+
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    const bool training = (pass == 0);
+    multi.Training() = training;
+    checkpoint.Training() = training;
+
+    arma::mat output(4, 12), checkpointOutput(4, 12);
+    multi.Forward(input, output);
+    checkpoint.Forward(input, checkpointOutput);
+    CheckMatrices(output, checkpointOutput);
+
+    arma::mat delta(5, 12), checkpointDelta(5, 12);
+    multi.Backward(input, output, gy, delta);
+    checkpoint.Backward(input, checkpointOutput, gy, checkpointDelta);
+    CheckMatrices(delta, checkpointDelta);
+
+    arma::mat gradient(multi.WeightSize(), 1);
+    arma::mat checkpointGradient(multi.WeightSize(), 1);
+    multi.Gradient(input, gy, gradient);
+    checkpoint.Gradient(input, gy, checkpointGradient);
+    CheckMatrices(gradient, checkpointGradient);
+  }
+}
+
+/**
+ * Make sure that a network built of Checkpoint segments computes the same
+ * objective and gradient as the same network without them, and that it can be
+ * trained and serialized.
+ */
+TEST_CASE("CheckpointFFNTest", "[ANNLayerTest]")
+{
+  arma::mat data(10, 64, arma::fill::randn);
+  arma::mat labels(1, 64);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (arma::accu(data.col(i)) > 0.0) ? 1 : 0;
+
+  FFN<NegativeLogLikelihood> model, checkpointModel;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    Checkpoint* segment = new Checkpoint();
+    for (size_t j = 0; j < 2; ++j)
+    {
+      model.Add<Linear>(8);
+      model.Add<ReLU>();
+      segment->Add<Linear>(8);
+      segment->Add<ReLU>();
+    }
+    checkpointModel.Add(segment);
+  }
+  model.Add<Linear>(2);
+  model.Add<LogSoftMax>();
+  checkpointModel.Add<Linear>(2);
+  checkpointModel.Add<LogSoftMax>();
+
+  model.Reset(10);
+  checkpointModel.Reset(10);
+  REQUIRE(model.Parameters().n_elem == checkpointModel.Parameters().n_elem);
+  checkpointModel.Parameters() = model.Parameters();
+
+  model.ResetData(data, labels);
+  checkpointModel.ResetData(data, labels);
+
+  arma::mat gradient, checkpointGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 32);
+  const double checkpointObjective = checkpointModel.EvaluateWithGradient(
+      checkpointModel.Parameters(), 0, checkpointGradient, 32);
+  REQUIRE(checkpointObjective == Approx(objective).epsilon(1e-7));
+  CheckMatrices(gradient, checkpointGradient);
+
+  ens::StandardSGD opt(0.01, 16, 10 * data.n_cols);
+  checkpointModel.Train(data, labels, opt);
+
+  arma::mat predictions;
+  checkpointModel.Predict(data, predictions);
+  REQUIRE(predictions.n_rows == 2);
+  REQUIRE(predictions.n_cols == data.n_cols);
+
+  FFN<NegativeLogLikelihood> xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(checkpointModel, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+  CheckMatrices(predictions, xmlPredictions);
+  CheckMatrices(predictions, jsonPredictions);
+  CheckMatrices(predictions, binaryPredictions);
+}
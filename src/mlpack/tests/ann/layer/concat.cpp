@@ -225,3 +225,51 @@ TEST_CASE("GradientConcatLayerTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 1e-4);
 }
+
+/**
+ * Make sure that the Concat layer gives the same results for a batch (where
+ * the outputs of the held layers are copied) as for each point on its own
+ * (where the held layers write directly into the output).
+ */
+TEST_CASE("ConcatBatchMatchesSinglePointTest", "[ANNLayerTest]")
+{
+  Concat module;
+  module.Add<Linear>(4);
+  module.Add<Linear>(3);
+  module.Add<Linear>(5);
+  module.InputDimensions() = std::vector<size_t>({ 6 });
+  module.ComputeOutputDimensions();
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randu);
+  module.SetWeights(weights);
+
+  const size_t batchSize = 5;
+  arma::mat input(6, batchSize, arma::fill::randu);
+  arma::mat error(module.OutputSize(), batchSize, arma::fill::randu);
+
+  arma::mat output(module.OutputSize(), batchSize);
+  arma::mat delta(6, batchSize);
+  arma::mat gradient(module.WeightSize(), 1);
+  module.Forward(input, output);
+  module.Backward(input, output, error, delta);
+  module.Gradient(input, error, gradient);
+
+  arma::mat pointOutput(module.OutputSize(), 1);
+  arma::mat pointDelta(6, 1);
+  arma::mat pointGradient(module.WeightSize(), 1);
+  arma::mat gradientSum(module.WeightSize(), 1, arma::fill::zeros);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::mat pointInput = input.col(i);
+    arma::mat pointError = error.col(i);
+    module.Forward(pointInput, pointOutput);
+    module.Backward(pointInput, pointOutput, pointError, pointDelta);
+    module.Gradient(pointInput, pointError, pointGradient);
+    gradientSum += pointGradient;
+
+    CheckMatrices(pointOutput, arma::mat(output.col(i)), 1e-10);
+    CheckMatrices(pointDelta, arma::mat(delta.col(i)), 1e-10);
+  }
+
+  CheckMatrices(gradientSum, gradient, 1e-10);
+}
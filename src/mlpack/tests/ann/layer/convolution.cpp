@@ -461,3 +461,103 @@ TEST_CASE("NonSquareConvolutionTest", "[ANNLayerTest]")
   arma::mat gradientResult(module1.WeightSize(), 1);
   REQUIRE_NOTHROW(module1.Gradient(data, backwardResult, gradientResult));
 }
+
+/**
+ * Make sure that the Convolution layer gives the same results for the forward
+ * pass, backward pass and gradient with the im2col rules as with the naive
+ * rules, with padding and stride.
+ */
+TEST_CASE("Im2ColConvolutionLayerTest", "[ANNLayerTest]")
+{
+  typedef ConvolutionType<
+      Im2ColConvolution<ValidConvolution>,
+      Im2ColConvolution<FullConvolution>,
+      Im2ColConvolution<ValidConvolution>,
+      arma::mat
+  > GEMMConvolution;
+
+  // The kernel does not fit evenly into the padded input along the columns,
+  // so part of the input is not used.
+  Convolution naiveLayer(2, 3, 2, 2, 2, std::tuple<size_t, size_t>(1, 1),
+      std::tuple<size_t, size_t>(1, 0));
+  GEMMConvolution layer(2, 3, 2, 2, 2, std::tuple<size_t, size_t>(1, 1),
+      std::tuple<size_t, size_t>(1, 0));
+
+  naiveLayer.InputDimensions() = std::vector<size_t>({ 7, 6, 3 });
+  naiveLayer.ComputeOutputDimensions();
+  layer.InputDimensions() = std::vector<size_t>({ 7, 6, 3 });
+  layer.ComputeOutputDimensions();
+  REQUIRE(layer.OutputDimensions() == naiveLayer.OutputDimensions());
+  REQUIRE(layer.WeightSize() == naiveLayer.WeightSize());
+
+  arma::mat weights(layer.WeightSize(), 1, arma::fill::randn);
+  naiveLayer.SetWeights(weights);
+  layer.SetWeights(weights);
+
+  arma::mat input(7 * 6 * 3, 5, arma::fill::randu);
+  arma::mat naiveOutput(naiveLayer.OutputSize(), 5);
+  arma::mat output(layer.OutputSize(), 5);
+  naiveLayer.Forward(input, naiveOutput);
+  layer.Forward(input, output);
+  CheckMatrices(output, naiveOutput, 1e-5);
+
+  arma::mat error(layer.OutputSize(), 5, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 5);
+  arma::mat delta(input.n_rows, 5);
+  naiveLayer.Backward(input, naiveOutput, error, naiveDelta);
+  layer.Backward(input, output, error, delta);
+  CheckMatrices(delta, naiveDelta, 1e-5);
+
+  arma::mat naiveGradient(layer.WeightSize(), 1);
+  arma::mat gradient(layer.WeightSize(), 1);
+  naiveLayer.Gradient(input, error, naiveGradient);
+  layer.Gradient(input, error, gradient);
+  CheckMatrices(gradient, naiveGradient, 1e-5);
+}
+
+/**
+ * Make sure that the Convolution layer gives the same results for the forward
+ * pass, backward pass and gradient with the Winograd rules as with the naive
+ * rules.
+ */
+TEST_CASE("WinogradConvolutionLayerTest", "[ANNLayerTest]")
+{
+  typedef ConvolutionType<
+      WinogradConvolution<ValidConvolution>,
+      WinogradConvolution<FullConvolution>,
+      NaiveConvolution<ValidConvolution>,
+      arma::mat
+  > WinogradConv;
+
+  Convolution naiveLayer(4, 3, 3, 1, 1, 0, 0, "same");
+  WinogradConv layer(4, 3, 3, 1, 1, 0, 0, "same");
+
+  naiveLayer.InputDimensions() = std::vector<size_t>({ 9, 8, 2 });
+  naiveLayer.ComputeOutputDimensions();
+  layer.InputDimensions() = std::vector<size_t>({ 9, 8, 2 });
+  layer.ComputeOutputDimensions();
+
+  arma::mat weights(layer.WeightSize(), 1, arma::fill::randn);
+  naiveLayer.SetWeights(weights);
+  layer.SetWeights(weights);
+
+  arma::mat input(9 * 8 * 2, 3, arma::fill::randu);
+  arma::mat naiveOutput(naiveLayer.OutputSize(), 3);
+  arma::mat output(layer.OutputSize(), 3);
+  naiveLayer.Forward(input, naiveOutput);
+  layer.Forward(input, output);
+  CheckMatrices(output, naiveOutput, 1e-5);
+
+  arma::mat error(layer.OutputSize(), 3, arma::fill::randn);
+  arma::mat naiveDelta(input.n_rows, 3);
+  arma::mat delta(input.n_rows, 3);
+  naiveLayer.Backward(input, naiveOutput, error, naiveDelta);
+  layer.Backward(input, output, error, delta);
+  CheckMatrices(delta, naiveDelta, 1e-5);
+
+  arma::mat naiveGradient(layer.WeightSize(), 1);
+  arma::mat gradient(layer.WeightSize(), 1);
+  naiveLayer.Gradient(input, error, naiveGradient);
+  layer.Gradient(input, error, gradient);
+  CheckMatrices(gradient, naiveGradient, 1e-5);
+}
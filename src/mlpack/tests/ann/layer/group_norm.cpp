@@ -0,0 +1,102 @@
+/**
+ * @file tests/ann/layer/group_norm.cpp
+ * @author Shubham Agrawal
+ *
+ * Tests the GroupNorm layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Simple GroupNorm module test: each group of channels of each point is
+ * normalized on its own.
+ */
+TEST_CASE("SimpleGroupNormLayerTest", "[ANNLayerTest]")
+{
+  // The input has 4 channels of 2 x 3 elements, in 2 groups.
+  GroupNorm module(2, 1e-5);
+  module.InputDimensions() = std::vector<size_t>({ 2, 3, 4 });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.Channels() == 4);
+  REQUIRE(module.WeightSize() == 8);
+
+  arma::mat weights(module.WeightSize(), 1);
+  module.SetWeights(weights);
+  module.CustomInitialize(weights, weights.n_elem);
+
+  arma::mat input(24, 3, arma::fill::randn);
+  input.col(1) *= 10;
+  input.col(2) += 5;
+  arma::mat output(24, 3);
+  module.Forward(input, output);
+
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t k = 0; k < 2; ++k)
+    {
+      const arma::vec group = input.submat(12 * k, j, 12 * k + 11, j);
+      const arma::vec expected = (group - arma::mean(group)) /
+          std::sqrt(arma::var(group, 1) + 1e-5);
+      CheckMatrices(output.submat(12 * k, j, 12 * k + 11, j), expected);
+    }
+  }
+
+  // The number of channels must be a multiple of the number of groups.
+  GroupNorm badModule(3);
+  badModule.InputDimensions() = std::vector<size_t>({ 2, 3, 4 });
+  REQUIRE_THROWS_AS(badModule.ComputeOutputDimensions(), std::invalid_argument);
+}
+
+/**
+ * GroupNorm layer numerical gradient test.
+ */
+TEST_CASE("GradientGroupNormTest", "[ANNLayerTest]")
+{
+  // Add function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randn(10, 256)),
+        target(arma::zeros(1, 256))
+    {
+      model = new FFN<NegativeLogLikelihood, NguyenWidrowInitialization>();
+      model->ResetData(input, target);
+      model->Add<Identity>();
+      model->Add<Linear>(12);
+      model->Add<GroupNorm>(3);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 16);
+      model->Gradient(model->Parameters(), 0, gradient, 16);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
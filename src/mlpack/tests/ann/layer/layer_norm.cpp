@@ -118,3 +118,53 @@ TEST_CASE("LayerNormLayerParametersTest", "[ANNLayerTest]")
   REQUIRE(layer.InSize() == 5);
   REQUIRE(layer.Epsilon() == 1e-3);
 }
+
+/**
+ * Jacobian test for the LayerNorm layer, with non-trivial scale and shift
+ * parameters.
+ */
+TEST_CASE("JacobianLayerNormTest", "[ANNLayerTest]")
+{
+  LayerNorm module;
+  module.Training() = true;
+  module.InputDimensions() = std::vector<size_t>({ 7 });
+  module.ComputeOutputDimensions();
+  arma::mat moduleParams(module.WeightSize(), 1);
+  module.CustomInitialize(moduleParams, module.WeightSize());
+  moduleParams.randu();
+  moduleParams += 0.5;
+  module.SetWeights(moduleParams);
+
+  arma::mat input(7, 4);
+  const double error = JacobianTest(module, input);
+  REQUIRE(error <= 1e-5);
+}
+
+/**
+ * Make sure that the LayerNorm layer gives the same result in place.
+ */
+TEST_CASE("LayerNormInPlaceTest", "[ANNLayerTest]")
+{
+  LayerNorm module;
+  module.InputDimensions() = std::vector<size_t>({ 6 });
+  module.ComputeOutputDimensions();
+  arma::mat moduleParams(module.WeightSize(), 1);
+  module.CustomInitialize(moduleParams, module.WeightSize());
+  moduleParams.randu();
+  module.SetWeights(moduleParams);
+  REQUIRE(module.ElementwiseForward());
+
+  arma::mat input(6, 5, arma::fill::randn);
+  arma::mat output;
+  module.Forward(input, output);
+
+  arma::mat inPlace(input);
+  module.Forward(inPlace, inPlace);
+  CheckMatrices(output, inPlace, 1e-10);
+
+  // The mean and variance are still computed without the normalized input.
+  arma::mat mean = arma::mean(input, 0);
+  arma::mat variance = arma::var(input, 1, 0);
+  CheckMatrices(module.Mean(), mean, 1e-10);
+  CheckMatrices(module.Variance(), variance, 1e-10);
+}
@@ -0,0 +1,215 @@
+/**
+ * @file tests/ann/layer/lookup.cpp
+ * @author Marcus Edel
+ *
+ * Tests the Lookup layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Simple test case for the Lookup layer.
+ */
+TEST_CASE("SimpleLookupLayerTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 10;
+  const size_t embeddingSize = 4;
+
+  Lookup module(vocabSize, embeddingSize);
+  module.InputDimensions() = std::vector<size_t>({ 3 });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.OutputDimensions()[0] == embeddingSize);
+  REQUIRE(module.OutputDimensions()[1] == 3);
+  REQUIRE(module.WeightSize() == vocabSize * embeddingSize);
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randn);
+  module.SetWeights(weights);
+  const arma::mat table = arma::reshape(weights, embeddingSize, vocabSize);
+
+  // Every token is replaced by its embedding.
+  arma::mat input("0 9; 3 3; 7 0");
+  arma::mat output(3 * embeddingSize, 2);
+  module.Forward(input, output);
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t t = 0; t < input.n_rows; ++t)
+    {
+      CheckMatrices(output.submat(t * embeddingSize, j,
+          (t + 1) * embeddingSize - 1, j), table.col((size_t) input(t, j)));
+    }
+  }
+
+  // The gradient of each embedding is the sum of the errors of its tokens.
+  arma::mat error(3 * embeddingSize, 2, arma::fill::randn);
+  arma::mat gradient(module.WeightSize(), 1, arma::fill::randn);
+  module.Gradient(input, error, gradient);
+
+  arma::mat expected(embeddingSize, vocabSize, arma::fill::zeros);
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    for (size_t t = 0; t < input.n_rows; ++t)
+    {
+      expected.col((size_t) input(t, j)) += error.submat(t * embeddingSize, j,
+          (t + 1) * embeddingSize - 1, j);
+    }
+  }
+  CheckMatrices(arma::vectorise(expected), gradient);
+
+  // Tokens outside of the vocabulary are rejected.
+  arma::mat badInput("0 10; 3 3; 7 0");
+  REQUIRE_THROWS_AS(module.Forward(badInput, output), std::invalid_argument);
+}
+
+/**
+ * Make sure that the sparse update of the Lookup layer is the same as a step of
+ * SGD with the dense gradient.
+ */
+TEST_CASE("SparseLookupLayerTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 20;
+  const size_t embeddingSize = 3;
+  const double stepSize = 0.1;
+
+  Lookup sparse(vocabSize, embeddingSize, stepSize);
+  sparse.InputDimensions() = std::vector<size_t>({ 4 });
+  sparse.ComputeOutputDimensions();
+  REQUIRE(sparse.WeightSize() == 0);
+
+  arma::mat empty;
+  sparse.SetWeights(empty);
+  const arma::mat table = sparse.Parameters();
+  REQUIRE(table.n_rows == embeddingSize);
+  REQUIRE(table.n_cols == vocabSize);
+
+  Lookup dense(vocabSize, embeddingSize);
+  dense.InputDimensions() = std::vector<size_t>({ 4 });
+  dense.ComputeOutputDimensions();
+  arma::mat weights = arma::vectorise(table);
+  dense.SetWeights(weights);
+
+  arma::mat input("1 5; 5 17; 19 1; 0 5");
+  arma::mat error(4 * embeddingSize, 2, arma::fill::randn);
+
+  arma::mat denseGradient(dense.WeightSize(), 1);
+  dense.Gradient(input, error, denseGradient);
+  sparse.Gradient(input, error, empty);
+
+  CheckMatrices(arma::vectorise(sparse.Parameters()),
+      weights - stepSize * denseGradient);
+
+  // The embeddings of the tokens that were not used are untouched.
+  REQUIRE(arma::approx_equal(sparse.Parameters().col(2), table.col(2),
+      "absdiff", 0.0));
+}
+
+/**
+ * Make sure that the lazy Adam update of the Lookup layer takes a step of Adam
+ * on the touched embeddings and leaves the others (and their moments) alone.
+ */
+TEST_CASE("LazyAdamLookupLayerTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 20;
+  const size_t embeddingSize = 3;
+  const double stepSize = 0.01;
+
+  LazyAdamEmbedding module(vocabSize, embeddingSize, stepSize);
+  module.InputDimensions() = std::vector<size_t>({ 3 });
+  module.ComputeOutputDimensions();
+  REQUIRE(module.WeightSize() == 0);
+
+  arma::mat empty;
+  module.SetWeights(empty);
+  arma::mat table = module.Parameters();
+
+  Lookup dense(vocabSize, embeddingSize);
+  dense.InputDimensions() = std::vector<size_t>({ 3 });
+  dense.ComputeOutputDimensions();
+  arma::mat denseGradient(dense.WeightSize(), 1);
+
+  arma::mat m(embeddingSize, vocabSize, arma::fill::zeros);
+  arma::mat v(embeddingSize, vocabSize, arma::fill::zeros);
+  const arma::mat inputs("4 8; 4 1; 9 4");
+  for (size_t t = 1; t <= 2; ++t)
+  {
+    // Each step uses a different column of the inputs.
+    const arma::mat input = inputs.col(t - 1);
+    arma::mat error(3 * embeddingSize, 1, arma::fill::randn);
+
+    // Compute the reference update of Adam with the dense gradient, only for
+    // the columns that were touched.
+    arma::mat weights = arma::vectorise(table);
+    dense.SetWeights(weights);
+    dense.Gradient(input, error, denseGradient);
+    const arma::mat g = arma::reshape(denseGradient, embeddingSize, vocabSize);
+    const arma::uvec touched = arma::unique(
+        arma::conv_to<arma::uvec>::from(input));
+    for (size_t i = 0; i < touched.n_elem; ++i)
+    {
+      const size_t c = touched[i];
+      m.col(c) = 0.9 * m.col(c) + 0.1 * g.col(c);
+      v.col(c) = 0.999 * v.col(c) + 0.001 * arma::square(g.col(c));
+      const double step = stepSize * std::sqrt(1 - std::pow(0.999, t)) /
+          (1 - std::pow(0.9, t));
+      table.col(c) -= step * m.col(c) / (arma::sqrt(v.col(c)) + 1e-8);
+    }
+
+    module.Gradient(input, error, empty);
+    CheckMatrices(module.Parameters(), table);
+  }
+
+  REQUIRE(module.UpdateRule().Iteration() == 2);
+  CheckMatrices(module.UpdateRule().M(), m);
+  CheckMatrices(module.UpdateRule().V(), v);
+  REQUIRE(arma::accu(arma::abs(module.UpdateRule().M().col(0))) == 0.0);
+}
+
+/**
+ * Lookup layer numerical gradient test.
+ */
+TEST_CASE("GradientLookupLayerTest", "[ANNLayerTest]")
+{
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randi<arma::mat>(5, 8, arma::distr_param(0, 9))),
+        target(arma::randi<arma::mat>(1, 8, arma::distr_param(0, 1)))
+    {
+      model = new FFN<NegativeLogLikelihood, RandomInitialization>();
+      model->ResetData(input, target);
+      model->Add<Lookup>(10, 4);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 8);
+      model->Gradient(model->Parameters(), 0, gradient, 8);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, RandomInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
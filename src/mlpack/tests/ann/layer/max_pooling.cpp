@@ -112,3 +112,91 @@ TEST_CASE("MaxPoolingTestCase", "[ANNLayerTest]")
   REQUIRE(output.n_elem == 4);
   REQUIRE(output.n_cols == 1);
 }
+
+/**
+ * Compute max pooling of every image of the input directly with Armadillo,
+ * and the error of the input for the given error of the output.
+ */
+void NaiveMaxPooling(const arma::mat& input,
+                     const arma::mat& gy,
+                     const size_t rows,
+                     const size_t cols,
+                     const size_t outRows,
+                     const size_t outCols,
+                     const size_t kernelWidth,
+                     const size_t kernelHeight,
+                     const size_t strideWidth,
+                     const size_t strideHeight,
+                     arma::mat& output,
+                     arma::mat& g)
+{
+  const size_t images = input.n_elem / (rows * cols);
+  arma::cube in((double*) input.memptr(), rows, cols, images, false, true);
+  arma::cube error((double*) gy.memptr(), outRows, outCols, images, false,
+      true);
+  arma::cube out(outRows, outCols, images);
+  arma::cube gCube(rows, cols, images, arma::fill::zeros);
+  for (size_t s = 0; s < images; ++s)
+  {
+    for (size_t j = 0; j < outCols; ++j)
+    {
+      for (size_t i = 0; i < outRows; ++i)
+      {
+        const size_t rowEnd = std::min(i * strideWidth + kernelWidth, rows) - 1;
+        const size_t colEnd = std::min(j * strideHeight + kernelHeight,
+            cols) - 1;
+        const arma::mat window = in.slice(s).submat(i * strideWidth,
+            j * strideHeight, rowEnd, colEnd);
+        const size_t index = window.index_max();
+        out(i, j, s) = window[index];
+        gCube(i * strideWidth + index % window.n_rows,
+            j * strideHeight + index / window.n_rows, s) += error(i, j, s);
+      }
+    }
+  }
+
+  output = arma::vectorise(out);
+  g = arma::vectorise(gCube);
+  output.reshape(output.n_elem / input.n_cols, input.n_cols);
+  g.reshape(input.n_rows, input.n_cols);
+}
+
+/**
+ * Make sure that max pooling of a batch of multi-channel images (with windows
+ * cut short at the border) matches the direct computation, both forward and
+ * backward, and both with the 8-bit window offsets and with windows that are
+ * too large for them.
+ */
+TEST_CASE("MaxPoolingBatchTest", "[ANNLayerTest]")
+{
+  // Parameter order: rows, cols, kW, kH, sW, sH.
+  const std::vector<std::vector<size_t>> configs = {
+      { 7, 6, 3, 2, 2, 2 },
+      { 9, 8, 2, 3, 1, 2 },
+      { 20, 18, 17, 16, 2, 1 } };
+
+  for (const std::vector<size_t>& c : configs)
+  {
+    MaxPooling module(c[2], c[3], c[4], c[5], false);
+    module.InputDimensions() = std::vector<size_t>({ c[0], c[1], 3 });
+    module.ComputeOutputDimensions();
+    module.Training() = true;
+
+    const size_t outRows = module.OutputDimensions()[0];
+    const size_t outCols = module.OutputDimensions()[1];
+    arma::mat input(c[0] * c[1] * 3, 4, arma::fill::randn);
+    arma::mat output(module.OutputSize(), 4);
+    module.Forward(input, output);
+
+    arma::mat gy(arma::size(output), arma::fill::randn);
+    arma::mat g(arma::size(input));
+    module.Backward(input, output, gy, g);
+
+    arma::mat expectedOutput, expectedG;
+    NaiveMaxPooling(input, gy, c[0], c[1], outRows, outCols, c[2], c[3], c[4],
+        c[5], expectedOutput, expectedG);
+
+    CheckMatrices(output, expectedOutput);
+    CheckMatrices(g, expectedG);
+  }
+}
@@ -86,3 +86,65 @@ TEST_CASE("MeanPoolingTestCase", "[ANNLayerTest]")
   module2.Backward(input, output2, prevDelta2, delta2);
   REQUIRE(accu(delta2) == Approx(8.1).epsilon(1e-3));
 }
+
+/**
+ * Make sure that mean pooling of a batch of multi-channel images matches the
+ * direct computation with Armadillo, and that the backward pass (with both
+ * the direct method and the prefix sum method) spreads the error evenly over
+ * each window.
+ */
+TEST_CASE("MeanPoolingBatchTest", "[ANNLayerTest]")
+{
+  // Parameter order: rows, cols, kW, kH, sW, sH, floor.
+  const std::vector<std::vector<size_t>> configs = {
+      { 7, 6, 3, 2, 2, 2, 0 },
+      { 9, 8, 2, 3, 1, 2, 1 },
+      { 12, 10, 5, 4, 1, 1, 0 } };
+
+  for (const std::vector<size_t>& c : configs)
+  {
+    const size_t rows = c[0];
+    const size_t cols = c[1];
+    MeanPooling module(c[2], c[3], c[4], c[5], c[6] == 1);
+    module.InputDimensions() = std::vector<size_t>({ rows, cols, 3 });
+    module.ComputeOutputDimensions();
+
+    const size_t outRows = module.OutputDimensions()[0];
+    const size_t outCols = module.OutputDimensions()[1];
+    arma::mat input(rows * cols * 3, 4, arma::fill::randn);
+    arma::mat output(module.OutputSize(), 4);
+    module.Forward(input, output);
+
+    arma::mat gy(arma::size(output), arma::fill::randn);
+    arma::mat g(arma::size(input));
+    module.Backward(input, output, gy, g);
+
+    const size_t images = 3 * 4;
+    arma::cube in(input.memptr(), rows, cols, images, false, true);
+    arma::cube out(output.memptr(), outRows, outCols, images, false, true);
+    arma::cube error(gy.memptr(), outRows, outCols, images, false, true);
+    arma::cube expectedG(rows, cols, images, arma::fill::zeros);
+    for (size_t s = 0; s < images; ++s)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const arma::span rowSpan(i * c[4],
+              std::min(i * c[4] + c[2], rows) - 1);
+          const arma::span colSpan(j * c[5],
+              std::min(j * c[5] + c[3], cols) - 1);
+          const arma::mat window = in.slice(s)(rowSpan, colSpan);
+
+          REQUIRE(out(i, j, s) == Approx(arma::mean(arma::vectorise(window)))
+              .epsilon(1e-7).margin(1e-10));
+          expectedG.slice(s)(rowSpan, colSpan) += error(i, j, s) /
+              window.n_elem;
+        }
+      }
+    }
+
+    CheckMatrices(g, arma::reshape(arma::vectorise(expectedG), g.n_rows,
+        g.n_cols));
+  }
+}
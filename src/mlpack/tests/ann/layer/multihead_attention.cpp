@@ -231,3 +231,214 @@ TEST_CASE("GradientMultiheadAttentionTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 3e-06);
 }
+
+/**
+ * Compute multihead attention directly, for one point, with the given weights
+ * of a MultiheadAttention layer.  The query is of shape (embedDim, tgtSeqLen),
+ * and the key and value are of shape (embedDim, srcSeqLen).
+ */
+arma::mat ReferenceAttention(const arma::mat& weights,
+                             const arma::mat& query,
+                             const arma::mat& key,
+                             const arma::mat& value,
+                             const size_t numHeads,
+                             const arma::mat& attnMask,
+                             const arma::mat& keyPaddingMask)
+{
+  const size_t embedDim = query.n_rows;
+  const size_t wtSize = embedDim * embedDim;
+  const size_t headDim = embedDim / numHeads;
+
+  const arma::mat queryWt = arma::reshape(weights.rows(0, wtSize - 1),
+      embedDim, embedDim);
+  const arma::mat keyWt = arma::reshape(weights.rows(wtSize, 2 * wtSize - 1),
+      embedDim, embedDim);
+  const arma::mat valueWt = arma::reshape(weights.rows(2 * wtSize,
+      3 * wtSize - 1), embedDim, embedDim);
+  const arma::mat outWt = arma::reshape(weights.rows(3 * wtSize,
+      4 * wtSize - 1), embedDim, embedDim);
+  const arma::vec qBias = weights.rows(4 * wtSize, 4 * wtSize + embedDim - 1);
+  const arma::vec kBias = weights.rows(4 * wtSize + embedDim,
+      4 * wtSize + 2 * embedDim - 1);
+  const arma::vec vBias = weights.rows(4 * wtSize + 2 * embedDim,
+      4 * wtSize + 3 * embedDim - 1);
+  const arma::rowvec outBias = weights.rows(4 * wtSize + 3 * embedDim,
+      4 * wtSize + 4 * embedDim - 1).t();
+
+  arma::mat q = queryWt * query;
+  q.each_col() += qBias;
+  arma::mat k = keyWt * key;
+  k.each_col() += kBias;
+  arma::mat v = valueWt * value;
+  v.each_col() += vBias;
+
+  // Each query attends to every key, with a softmax over the keys.
+  arma::mat attnOut(query.n_cols, embedDim);
+  for (size_t h = 0; h < numHeads; ++h)
+  {
+    const size_t begin = h * headDim;
+    const size_t end = (h + 1) * headDim - 1;
+    arma::mat scores = q.rows(begin, end).t() * k.rows(begin, end) /
+        std::sqrt(headDim);
+    if (!attnMask.is_empty())
+      scores += attnMask;
+    if (!keyPaddingMask.is_empty())
+      scores.each_row() += keyPaddingMask;
+
+    scores.each_col() -= arma::max(scores, 1);
+    scores = arma::exp(scores);
+    scores.each_col() /= arma::sum(scores, 1);
+    attnOut.cols(begin, end) = scores * v.rows(begin, end).t();
+  }
+
+  arma::mat output = attnOut * outWt;
+  output.each_row() += outBias;
+  return output.t();
+}
+
+/**
+ * Make sure that the tiled attention gives the same output as attention that
+ * is computed directly, and that the backward pass and the gradient do not
+ * depend on the tile size.
+ */
+TEST_CASE("TiledMultiheadAttentionTest", "[ANNLayerTest]")
+{
+  const size_t tgtSeqLen = 5;
+  const size_t srcSeqLen = 7;
+  const size_t embedDim = 6;
+  const size_t numHeads = 2;
+  const size_t batchSize = 3;
+
+  arma::mat attnMask = arma::zeros(tgtSeqLen, srcSeqLen);
+  for (size_t i = 0; i < tgtSeqLen; ++i)
+  {
+    for (size_t j = i + 3; j < srcSeqLen; ++j)
+      attnMask(i, j) = std::numeric_limits<double>::lowest();
+  }
+
+  arma::mat keyPaddingMask = arma::zeros(1, srcSeqLen);
+  keyPaddingMask(1) = std::numeric_limits<double>::lowest();
+
+  const arma::mat input = arma::randn(embedDim * (tgtSeqLen + 2 * srcSeqLen),
+      batchSize);
+  const arma::mat gy = arma::randn(embedDim * tgtSeqLen, batchSize);
+  const arma::mat weights = 0.3 * arma::randn(
+      4 * (embedDim + 1) * embedDim, 1);
+
+  arma::mat deltaSingle, gradientSingle;
+  const size_t tileSizes[] = { 0, 1, 2, 3 };
+  for (const size_t tileSize : tileSizes)
+  {
+    MultiheadAttention module(tgtSeqLen, numHeads, attnMask, keyPaddingMask,
+        false, tileSize);
+    module.InputDimensions() = std::vector<size_t>({ embedDim,
+        tgtSeqLen + 2 * srcSeqLen });
+    module.ComputeOutputDimensions();
+    arma::mat moduleWeights(weights);
+    module.SetWeights(moduleWeights);
+
+    arma::mat output;
+    module.Forward(input, output);
+    REQUIRE(output.n_rows == embedDim * tgtSeqLen);
+    REQUIRE(output.n_cols == batchSize);
+
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      const arma::mat point = arma::reshape(input.col(i), embedDim,
+          tgtSeqLen + 2 * srcSeqLen);
+      const arma::mat expected = ReferenceAttention(weights,
+          point.cols(0, tgtSeqLen - 1),
+          point.cols(tgtSeqLen, tgtSeqLen + srcSeqLen - 1),
+          point.cols(tgtSeqLen + srcSeqLen, tgtSeqLen + 2 * srcSeqLen - 1),
+          numHeads, attnMask, keyPaddingMask);
+      CheckMatrices(arma::mat(arma::vectorise(expected)),
+          arma::mat(output.col(i)), 1e-5);
+    }
+
+    arma::mat delta, gradient;
+    module.Backward(input, output, gy, delta);
+    module.Gradient(input, gy, gradient);
+    if (tileSize == 0)
+    {
+      deltaSingle = delta;
+      gradientSingle = gradient;
+    }
+    else
+    {
+      CheckMatrices(delta, deltaSingle, 1e-5);
+      CheckMatrices(gradient, gradientSingle, 1e-5);
+    }
+  }
+
+  // Also check the Jacobian when every tile holds a single query and key.
+  MultiheadAttention module(tgtSeqLen, numHeads, attnMask, keyPaddingMask,
+      false, 1);
+  module.InputDimensions() = std::vector<size_t>({ embedDim,
+      tgtSeqLen + 2 * srcSeqLen });
+  module.ComputeOutputDimensions();
+  arma::mat moduleWeights(weights);
+  module.SetWeights(moduleWeights);
+
+  arma::mat jacobianInput(input.n_rows, 1);
+  REQUIRE(JacobianTest(module, jacobianInput) <= 1e-5);
+}
+
+/**
+ * Make sure that decoding with the key/value cache gives the same output as a
+ * forward pass over the whole sequence with a causal mask.
+ */
+TEST_CASE("MultiheadAttentionDecodeTest", "[ANNLayerTest]")
+{
+  const size_t seqLen = 6;
+  const size_t embedDim = 4;
+  const size_t numHeads = 2;
+  const size_t batchSize = 2;
+
+  arma::mat attnMask = arma::zeros(seqLen, seqLen);
+  for (size_t i = 0; i < seqLen; ++i)
+  {
+    for (size_t j = i + 1; j < seqLen; ++j)
+      attnMask(i, j) = -std::numeric_limits<double>::infinity();
+  }
+
+  MultiheadAttention module(seqLen, numHeads, attnMask, arma::mat(), true, 2);
+  module.InputDimensions() = std::vector<size_t>({ embedDim, seqLen });
+  module.ComputeOutputDimensions();
+  arma::mat weights = 0.3 * arma::randn(module.WeightSize(), 1);
+  module.SetWeights(weights);
+
+  const arma::mat input = arma::randn(embedDim * seqLen, batchSize);
+  arma::mat output;
+  module.Forward(input, output);
+
+  // Decode the first three positions at once, and then one at a time.
+  arma::mat decoded;
+  module.Decode(input.rows(0, 3 * embedDim - 1), decoded);
+  REQUIRE(module.CacheLength() == 3);
+  CheckMatrices(decoded, arma::mat(output.rows(0, 3 * embedDim - 1)), 1e-8);
+  for (size_t i = 3; i < seqLen; ++i)
+  {
+    module.Decode(input.rows(i * embedDim, (i + 1) * embedDim - 1), decoded);
+    CheckMatrices(decoded, arma::mat(output.rows(i * embedDim,
+        (i + 1) * embedDim - 1)), 1e-8);
+  }
+  REQUIRE(module.CacheLength() == seqLen);
+
+  // The batch size can only change after the cache is reset.
+  REQUIRE_THROWS_AS(module.Decode(input.submat(0, 0, embedDim - 1, 0),
+      decoded), std::invalid_argument);
+  module.ResetCache();
+  REQUIRE(module.CacheLength() == 0);
+  module.Decode(input.submat(0, 0, embedDim - 1, 0), decoded);
+  CheckMatrices(decoded, arma::mat(output.submat(0, 0, embedDim - 1, 0)),
+      1e-8);
+
+  // Decoding needs self-attention.
+  MultiheadAttention crossModule(seqLen, numHeads);
+  crossModule.InputDimensions() = std::vector<size_t>({ embedDim,
+      3 * seqLen });
+  crossModule.ComputeOutputDimensions();
+  arma::mat crossWeights(crossModule.WeightSize(), 1, arma::fill::randn);
+  crossModule.SetWeights(crossWeights);
+  REQUIRE_THROWS_AS(crossModule.Decode(input, decoded), std::logic_error);
+}
@@ -0,0 +1,64 @@
+/**
+ * @file tests/ann/layer/positional_encoding.cpp
+ * @author Mrityunjay Tripathi
+ *
+ * Tests the PositionalEncoding layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Simple PositionalEncoding module test.  An odd embedding dimension is used to
+ * check the last row of each position.
+ */
+TEST_CASE("SimplePositionalEncodingTest", "[ANNLayerTest]")
+{
+  const size_t embedDim = 5;
+  const size_t maxSequenceLength = 4;
+
+  PositionalEncoding module(embedDim, maxSequenceLength);
+  module.InputDimensions() = std::vector<size_t>({ embedDim,
+      maxSequenceLength });
+  module.ComputeOutputDimensions();
+
+  arma::mat encoding(embedDim, maxSequenceLength);
+  for (size_t pos = 0; pos < maxSequenceLength; ++pos)
+  {
+    for (size_t i = 0; i < embedDim; ++i)
+    {
+      const double theta = pos / std::pow(10000.0, (i - i % 2) /
+          (double) embedDim);
+      encoding(i, pos) = (i % 2 == 0) ? std::sin(theta) : std::cos(theta);
+    }
+  }
+
+  arma::mat input(embedDim * maxSequenceLength, 3, arma::fill::randn);
+  arma::mat output(input.n_rows, input.n_cols);
+  module.Forward(input, output);
+  for (size_t j = 0; j < input.n_cols; ++j)
+    CheckMatrices(output.col(j) - input.col(j), arma::vectorise(encoding));
+
+  // The encoding does not depend on the input, so the error passes through.
+  arma::mat gy(input.n_rows, input.n_cols, arma::fill::randn);
+  arma::mat g(input.n_rows, input.n_cols);
+  module.Backward(input, output, gy, g);
+  CheckMatrices(g, gy);
+
+  // The input must hold a whole sequence.
+  PositionalEncoding badModule(embedDim, maxSequenceLength);
+  badModule.InputDimensions() = std::vector<size_t>({ embedDim, 3 });
+  REQUIRE_THROWS_AS(badModule.ComputeOutputDimensions(),
+      std::invalid_argument);
+}
@@ -0,0 +1,186 @@
+/**
+ * @file tests/ann/layer/transposed_convolution.cpp
+ * @author Shikhar Jaiswal
+ * @author Marcus Edel
+ *
+ * Tests the TransposedConvolution layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann.hpp>
+
+#include "../../test_catch_tools.hpp"
+#include "../../catch.hpp"
+#include "../../serialization.hpp"
+#include "../ann_test_tools.hpp"
+
+using namespace mlpack;
+
+/**
+ * Compute the output of a transposed convolution directly, by scattering every
+ * input element into the output.
+ */
+void NaiveTransposedConvolution(const arma::cube& input,
+                                const arma::cube& weight,
+                                const arma::vec& bias,
+                                const size_t maps,
+                                const size_t strideWidth,
+                                const size_t strideHeight,
+                                const size_t padWLeft,
+                                const size_t padHTop,
+                                arma::cube& output)
+{
+  for (size_t m = 0; m < maps; ++m)
+    output.slice(m).fill(bias[m]);
+
+  for (size_t i = 0; i < input.n_slices; ++i)
+  {
+    for (size_t m = 0; m < maps; ++m)
+    {
+      for (size_t y = 0; y < input.n_cols; ++y)
+      {
+        for (size_t x = 0; x < input.n_rows; ++x)
+        {
+          for (size_t kj = 0; kj < weight.n_cols; ++kj)
+          {
+            for (size_t ki = 0; ki < weight.n_rows; ++ki)
+            {
+              const long r = (long) (x * strideWidth + ki) - (long) padWLeft;
+              const long c = (long) (y * strideHeight + kj) - (long) padHTop;
+              if (r < 0 || c < 0 || r >= (long) output.n_rows ||
+                  c >= (long) output.n_cols)
+                continue;
+
+              output(r, c, m) += weight(ki, kj, i * maps + m) * input(x, y, i);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Test the output dimensions of the TransposedConvolution layer.
+ */
+TEST_CASE("TransposedConvolutionOutputDimensionsTest", "[ANNLayerTest]")
+{
+  // Parameter order: maps, kW, kH, sW, sH, padW, padH, paddingType.
+  TransposedConvolution module1(3, 3, 3, 1, 1, 0, 0);
+  module1.InputDimensions() = std::vector<size_t>({ 5, 6, 2 });
+  module1.ComputeOutputDimensions();
+  REQUIRE(module1.OutputDimensions()[0] == 7);
+  REQUIRE(module1.OutputDimensions()[1] == 8);
+  REQUIRE(module1.OutputDimensions()[2] == 3);
+  REQUIRE(module1.WeightSize() == 3 * 3 * 3 * 2 + 3);
+
+  TransposedConvolution module2(1, 4, 3, 2, 2, 1, 1);
+  module2.InputDimensions() = std::vector<size_t>({ 5, 5 });
+  module2.ComputeOutputDimensions();
+  REQUIRE(module2.OutputDimensions()[0] == 10);
+  REQUIRE(module2.OutputDimensions()[1] == 9);
+
+  // "same" padding upsamples by exactly the stride, whether the kernel is
+  // larger or smaller than the stride.
+  TransposedConvolution module3(1, 3, 1, 2, 2, 0, 0, "same");
+  module3.InputDimensions() = std::vector<size_t>({ 4, 5 });
+  module3.ComputeOutputDimensions();
+  REQUIRE(module3.OutputDimensions()[0] == 8);
+  REQUIRE(module3.OutputDimensions()[1] == 10);
+
+  REQUIRE_THROWS_AS(TransposedConvolution(1, 3, 3, 1, 1, 0, 0, "full"),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure the TransposedConvolution layer computes the same output as the
+ * direct scattering of its input.
+ */
+TEST_CASE("TransposedConvolutionForwardTest", "[ANNLayerTest]")
+{
+  const size_t maps = 2;
+  TransposedConvolution module(maps, 3, 2, 2, 3, std::tuple<size_t, size_t>(1,
+      0), std::tuple<size_t, size_t>(0, 1));
+  module.InputDimensions() = std::vector<size_t>({ 4, 3, 3 });
+  module.ComputeOutputDimensions();
+
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randn);
+  module.SetWeights(weights);
+
+  const size_t outRows = module.OutputDimensions()[0];
+  const size_t outCols = module.OutputDimensions()[1];
+  arma::mat input(4 * 3 * 3, 2, arma::fill::randn);
+  arma::mat output(outRows * outCols * maps, 2);
+  module.Forward(input, output);
+
+  for (size_t j = 0; j < input.n_cols; ++j)
+  {
+    arma::cube inputCube(input.colptr(j), 4, 3, 3, false, true);
+    arma::cube expected(outRows, outCols, maps);
+    NaiveTransposedConvolution(inputCube, module.Weight(), module.Bias(), maps,
+        2, 3, 1, 0, expected);
+
+    CheckMatrices(arma::vectorise(expected), output.col(j));
+  }
+}
+
+/**
+ * Jacobian TransposedConvolution module test.
+ */
+TEST_CASE("JacobianTransposedConvolutionTest", "[ANNLayerTest]")
+{
+  TransposedConvolution module(2, 3, 3, 2, 2, 0, 0, "same");
+  module.InputDimensions() = std::vector<size_t>({ 3, 4, 2 });
+  module.ComputeOutputDimensions();
+  arma::mat weights(module.WeightSize(), 1, arma::fill::randn);
+  module.SetWeights(weights);
+
+  arma::mat input(3 * 4 * 2, 1);
+  double error = JacobianTest(module, input);
+  REQUIRE(error <= 1e-5);
+}
+
+/**
+ * TransposedConvolution layer numerical gradient test.
+ */
+TEST_CASE("GradientTransposedConvolutionTest", "[ANNLayerTest]")
+{
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randn(18, 2)),
+        target(arma::mat("1 0"))
+    {
+      model = new FFN<NegativeLogLikelihood, RandomInitialization>();
+      model->ResetData(input, target);
+      model->Add<TransposedConvolution>(2, 3, 3, 2, 1, 1, 0);
+      model->Add<Linear>(2);
+      model->Add<LogSoftMax>();
+
+      model->InputDimensions() = std::vector<size_t>({ 3, 3, 2 });
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 2);
+      model->Gradient(model->Parameters(), 0, gradient, 2);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood, RandomInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
@@ -29,23 +29,28 @@
 #include "layer/concat.cpp"
 #include "layer/concatenate.cpp"
 #include "layer/c_relu.cpp"
+#include "layer/checkpoint.cpp"
 #include "layer/dropout.cpp"
 #include "layer/flexible_relu.cpp"
+#include "layer/group_norm.cpp"
 #include "layer/grouped_convolution.cpp"
 #include "layer/hard_tanh.cpp"
 #include "layer/identity.cpp"
 #include "layer/linear3d.cpp"
 #include "layer/linear_no_bias.cpp"
 #include "layer/log_softmax.cpp"
+#include "layer/lookup.cpp"
 #include "layer/max_pooling.cpp"
 #include "layer/mean_pooling.cpp"
 #include "layer/nearest_interpolation.cpp"
 #include "layer/padding.cpp"
 #include "layer/parametric_relu.cpp"
+#include "layer/positional_encoding.cpp"
 #include "layer/relu6.cpp"
 #include "layer/repeat.cpp"
 #include "layer/softmax.cpp"
 #include "layer/softmin.cpp"
+#include "layer/transposed_convolution.cpp"
 #include "layer/ftswish.cpp"
 #include "layer/layer_norm.cpp"
 #include "layer/multihead_attention.cpp"
@@ -1261,3 +1261,124 @@ TEST_CASE("JacobianNegativeLogLikelihoodLayerTest", "[LossFunctionsTest]")
     REQUIRE(error <= 1e-5);
   }
 }
+
+/**
+ * Check that the softmax cross-entropy loss matches a LogSoftMax layer followed
+ * by the negative log likelihood, for the loss and the gradient.
+ */
+TEST_CASE("SoftmaxCrossEntropyLossTest", "[LossFunctionsTest]")
+{
+  const size_t numClasses = 7;
+  arma::mat input(numClasses, 20, arma::fill::randn);
+  input *= 5;
+  arma::mat target(1, input.n_cols);
+  for (size_t i = 0; i < target.n_elem; ++i)
+    target(i) = RandInt(0, numClasses);
+
+  for (const bool reduction : { true, false })
+  {
+    SoftmaxCrossEntropyLoss module(reduction);
+    LogSoftMax logSoftMax;
+    NegativeLogLikelihood nll(reduction);
+
+    arma::mat logProbabilities, nllGradient, expectedGradient, gradient;
+    logSoftMax.Forward(input, logProbabilities);
+    const double expectedLoss = nll.Forward(logProbabilities, target);
+    nll.Backward(logProbabilities, target, nllGradient);
+    logSoftMax.Backward(input, logProbabilities, nllGradient,
+        expectedGradient);
+
+    REQUIRE(module.Forward(input, target) ==
+        Approx(expectedLoss).epsilon(1e-7));
+    module.Backward(input, target, gradient);
+    CheckMatrices(gradient, expectedGradient, 1e-5);
+
+    // Shifting the scores must not change anything, even if exp() of the
+    // shifted scores would overflow.
+    arma::mat shifted = input + 1e4;
+    arma::mat shiftedGradient;
+    REQUIRE(module.Forward(shifted, target) ==
+        Approx(expectedLoss).epsilon(1e-7));
+    module.Backward(shifted, target, shiftedGradient);
+    CheckMatrices(shiftedGradient, expectedGradient, 1e-5);
+  }
+}
+
+/**
+ * Jacobian softmax cross-entropy loss test.
+ */
+TEST_CASE("JacobianSoftmaxCrossEntropyLossTest", "[LossFunctionsTest]")
+{
+  for (size_t i = 0; i < 5; ++i)
+  {
+    SoftmaxCrossEntropyLoss module;
+    const size_t inputElements = RandInt(5, 100);
+    arma::mat input;
+    RandomInitialization init(-2, 2);
+    init.Initialize(input, inputElements, 1);
+
+    arma::mat target(1, 1);
+    target(0) = RandInt(0, inputElements - 2);
+
+    double error = JacobianPerformanceTest(module, input, target);
+    REQUIRE(error <= 1e-5);
+  }
+}
+
+/**
+ * Check that the sampled softmax only uses the sampled classes and the target
+ * class of each point.
+ */
+TEST_CASE("SampledSoftmaxCrossEntropyLossTest", "[LossFunctionsTest]")
+{
+  const size_t numClasses = 1000;
+  const size_t numSampled = 20;
+  arma::mat input(numClasses, 10, arma::fill::randn);
+  arma::mat target(1, input.n_cols);
+  for (size_t i = 0; i < target.n_elem; ++i)
+    target(i) = RandInt(0, numClasses);
+
+  SoftmaxCrossEntropyLoss module(true, numSampled);
+  const double loss = module.Forward(input, target);
+
+  const arma::uvec& sampled = module.SampledClasses();
+  REQUIRE(sampled.n_elem == numSampled);
+  for (size_t j = 1; j < sampled.n_elem; ++j)
+    REQUIRE(sampled[j] > sampled[j - 1]);
+  REQUIRE(sampled[sampled.n_elem - 1] < numClasses);
+
+  arma::mat gradient;
+  module.Backward(input, target, gradient);
+  REQUIRE(gradient.n_rows == numClasses);
+  REQUIRE(gradient.n_cols == input.n_cols);
+
+  double expectedLoss = 0.0;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t t = (size_t) target(i);
+    arma::uvec classes = sampled;
+    if (!arma::any(classes == t))
+      classes = arma::join_cols(classes, arma::uvec({ (arma::uword) t }));
+
+    const arma::vec scores = input.col(i);
+    const arma::vec logits = scores.elem(classes);
+    const double lse = logits.max() +
+        std::log(arma::accu(arma::exp(logits - logits.max())));
+    expectedLoss += lse - input(t, i);
+
+    // The gradient is only nonzero for the classes in the softmax, and sums to
+    // zero.
+    arma::vec expectedGradient(numClasses, arma::fill::zeros);
+    expectedGradient.elem(classes) = arma::exp(logits - lse);
+    expectedGradient[t] -= 1.0;
+    CheckMatrices(gradient.col(i), expectedGradient, 1e-5);
+    REQUIRE(arma::accu(gradient.col(i)) == Approx(0.0).margin(1e-10));
+  }
+
+  REQUIRE(loss == Approx(expectedLoss).epsilon(1e-7));
+
+  // Without sampling, all of the classes are used again.
+  module.NumSampled() = 0;
+  module.Forward(input, target);
+  REQUIRE(module.SampledClasses().n_elem == 0);
+}
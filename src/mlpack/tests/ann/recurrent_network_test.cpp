@@ -203,6 +203,258 @@ TEST_CASE("LSTMBatchSizeTest", "[RecurrentNetworkTest]")
   BatchSizeTest<Linear>();
 }
 
+/**
+ * Make sure that the stacked gates of the LSTM layer compute the same output as
+ * the step-by-step LSTM equations.
+ */
+TEST_CASE("LSTMStackedGatesTest", "[RecurrentNetworkTest]")
+{
+  const size_t inSize = 4;
+  const size_t outSize = 3;
+  const size_t steps = 5;
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<LSTM>(outSize);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  arma::cube input(inSize, 2, steps, arma::fill::randn);
+  arma::cube output;
+  model.Predict(input, output);
+
+  // Unpack the stacked parameters: the input weights and bias of the input
+  // gate, forget gate, cell candidate and output gate, then the recurrent
+  // weights of the gates, then the input, forget and output peepholes.
+  const arma::mat& parameters = model.Parameters();
+  size_t offset = 0;
+  const arma::mat w = arma::reshape(parameters.rows(offset,
+      offset + 4 * outSize * inSize - 1), 4 * outSize, inSize);
+  offset += w.n_elem;
+  const arma::vec b = parameters.rows(offset, offset + 4 * outSize - 1);
+  offset += b.n_elem;
+  const arma::mat r = arma::reshape(parameters.rows(offset,
+      offset + 4 * outSize * outSize - 1), 4 * outSize, outSize);
+  offset += r.n_elem;
+  const arma::mat p = arma::reshape(parameters.rows(offset,
+      offset + 3 * outSize - 1), outSize, 3);
+
+  const auto sigmoid = [](const arma::mat& x) -> arma::mat
+  {
+    return 1.0 / (1.0 + arma::exp(-x));
+  };
+
+  arma::mat h(outSize, 2, arma::fill::zeros);
+  arma::mat c(outSize, 2, arma::fill::zeros);
+  for (size_t t = 0; t < steps; ++t)
+  {
+    arma::mat gates = w * input.slice(t) + r * h;
+    gates.each_col() += b;
+
+    arma::mat i = gates.rows(0, outSize - 1);
+    arma::mat f = gates.rows(outSize, 2 * outSize - 1);
+    i += c.each_col() % p.col(0);
+    f += c.each_col() % p.col(1);
+    c = sigmoid(f) % c + sigmoid(i) %
+        arma::tanh(gates.rows(2 * outSize, 3 * outSize - 1));
+    const arma::mat o = sigmoid(gates.rows(3 * outSize, 4 * outSize - 1) +
+        c.each_col() % p.col(2));
+    h = o % arma::tanh(c);
+
+    CheckMatrices(h, output.slice(t));
+  }
+}
+
+/**
+ * Make sure that the GRU layer computes the same output as the step-by-step GRU
+ * equations.
+ */
+TEST_CASE("GRUForwardTest", "[RecurrentNetworkTest]")
+{
+  const size_t inSize = 4;
+  const size_t outSize = 3;
+  const size_t steps = 5;
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<GRU>(outSize);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  arma::cube input(inSize, 2, steps, arma::fill::randn);
+  arma::cube output;
+  model.Predict(input, output);
+
+  // Unpack the parameters: the input weights and bias of the update gate, reset
+  // gate and candidate, then the recurrent weights of the two gates, then the
+  // recurrent weights of the candidate.
+  const arma::mat& parameters = model.Parameters();
+  size_t offset = 0;
+  const arma::mat w = arma::reshape(parameters.rows(offset,
+      offset + 3 * outSize * inSize - 1), 3 * outSize, inSize);
+  offset += w.n_elem;
+  const arma::vec b = parameters.rows(offset, offset + 3 * outSize - 1);
+  offset += b.n_elem;
+  const arma::mat u = arma::reshape(parameters.rows(offset,
+      offset + 2 * outSize * outSize - 1), 2 * outSize, outSize);
+  offset += u.n_elem;
+  const arma::mat uh = arma::reshape(parameters.rows(offset,
+      offset + outSize * outSize - 1), outSize, outSize);
+
+  const auto sigmoid = [](const arma::mat& x) -> arma::mat
+  {
+    return 1.0 / (1.0 + arma::exp(-x));
+  };
+
+  arma::mat h(outSize, 2, arma::fill::zeros);
+  for (size_t t = 0; t < steps; ++t)
+  {
+    arma::mat gates = w * input.slice(t);
+    gates.each_col() += b;
+
+    const arma::mat zr = sigmoid(gates.rows(0, 2 * outSize - 1) + u * h);
+    const arma::mat z = zr.rows(0, outSize - 1);
+    const arma::mat r = zr.rows(outSize, 2 * outSize - 1);
+    const arma::mat hidden = arma::tanh(gates.rows(2 * outSize,
+        3 * outSize - 1) + uh * (r % h));
+    h = (1 - z) % hidden + z % h;
+
+    CheckMatrices(h, output.slice(t));
+  }
+}
+
+/**
+ * Make sure that the FastLSTM layer computes the same output as the
+ * step-by-step LSTM equations (without peepholes).
+ */
+TEST_CASE("FastLSTMForwardTest", "[RecurrentNetworkTest]")
+{
+  const size_t inSize = 4;
+  const size_t outSize = 3;
+  const size_t steps = 5;
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<FastLSTM>(outSize);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  arma::cube input(inSize, 2, steps, arma::fill::randn);
+  arma::cube output;
+  model.Predict(input, output);
+
+  // Unpack the parameters: the input weights and bias of the input gate,
+  // output gate, forget gate and cell candidate, then their recurrent weights.
+  const arma::mat& parameters = model.Parameters();
+  size_t offset = 0;
+  const arma::mat w = arma::reshape(parameters.rows(offset,
+      offset + 4 * outSize * inSize - 1), 4 * outSize, inSize);
+  offset += w.n_elem;
+  const arma::vec b = parameters.rows(offset, offset + 4 * outSize - 1);
+  offset += b.n_elem;
+  const arma::mat u = arma::reshape(parameters.rows(offset,
+      offset + 4 * outSize * outSize - 1), 4 * outSize, outSize);
+
+  const auto sigmoid = [](const arma::mat& x) -> arma::mat
+  {
+    return 1.0 / (1.0 + arma::exp(-x));
+  };
+
+  arma::mat h(outSize, 2, arma::fill::zeros);
+  arma::mat c(outSize, 2, arma::fill::zeros);
+  for (size_t t = 0; t < steps; ++t)
+  {
+    arma::mat gates = w * input.slice(t) + u * h;
+    gates.each_col() += b;
+
+    const arma::mat i = sigmoid(gates.rows(0, outSize - 1));
+    const arma::mat o = sigmoid(gates.rows(outSize, 2 * outSize - 1));
+    const arma::mat f = sigmoid(gates.rows(2 * outSize, 3 * outSize - 1));
+    const arma::mat z = arma::tanh(gates.rows(3 * outSize, 4 * outSize - 1));
+    c = i % z + f % c;
+    h = o % arma::tanh(c);
+
+    CheckMatrices(h, output.slice(t));
+  }
+}
+
+/**
+ * Compare the gradient of a small recurrent network with full BPTT to the
+ * central differences of its objective.
+ */
+template<typename RecurrentLayerType>
+void RecurrentGradientTest()
+{
+  const size_t inSize = 3;
+  const size_t outSize = 4;
+  const size_t steps = 5;
+  const size_t points = 3;
+
+  RNN<MeanSquaredError> model(steps);
+  model.Add<RecurrentLayerType>(outSize);
+  model.Add<Linear>(2);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  arma::cube input(inSize, points, steps, arma::fill::randn);
+  arma::cube responses(2, points, steps, arma::fill::randn);
+  model.ResetData(input, responses);
+
+  arma::mat parameters = model.Parameters();
+  arma::mat gradient;
+  model.EvaluateWithGradient(parameters, 0, gradient, points);
+
+  const double perturbation = 1e-6;
+  arma::mat numericalGradient(arma::size(parameters));
+  for (size_t i = 0; i < parameters.n_elem; ++i)
+  {
+    const double original = parameters[i];
+    parameters[i] = original + perturbation;
+    const double objectiveB = model.Evaluate(parameters, 0, points);
+    parameters[i] = original - perturbation;
+    const double objectiveA = model.Evaluate(parameters, 0, points);
+    parameters[i] = original;
+
+    numericalGradient[i] = (objectiveB - objectiveA) / (2 * perturbation);
+  }
+
+  REQUIRE(arma::norm(gradient - numericalGradient) /
+      arma::norm(gradient + numericalGradient) <= 1e-5);
+}
+
+/**
+ * Check the gradient of the GRU layer.
+ */
+TEST_CASE("GRUGradientTest", "[RecurrentNetworkTest]")
+{
+  RecurrentGradientTest<GRU>();
+}
+
+/**
+ * Check the gradient of the FastLSTM layer.
+ */
+TEST_CASE("FastLSTMGradientTest", "[RecurrentNetworkTest]")
+{
+  RecurrentGradientTest<FastLSTM>();
+}
+
+/**
+ * Ensure GRUs work with larger batch sizes.
+ */
+TEST_CASE("GRUBatchSizeTest", "[RecurrentNetworkTest]")
+{
+  BatchSizeTest<GRU>();
+}
+
+/**
+ * Ensure FastLSTMs work with larger batch sizes.
+ */
+TEST_CASE("FastLSTMBatchSizeTest", "[RecurrentNetworkTest]")
+{
+  BatchSizeTest<FastLSTM>();
+}
+
 /**
  * @brief Generates noisy sine wave and outputs the data and the labels that
  *        can be used directly for training and testing with RNN.
@@ -430,3 +682,114 @@ TEST_CASE("RNNFFNTest", "[RecurrentNetworkTest]")
   // Now, the weights should be the same!
   CheckMatrices(ffn.Parameters(), rnn.Parameters());
 }
+
+/**
+ * Test that training on sequences of different lengths gives the same loss,
+ * gradient and predictions as processing each sequence on its own, with only
+ * its true length.
+ */
+TEST_CASE("RNNRaggedSequencesTest", "[RecurrentNetworkTest]")
+{
+  const size_t inSize = 3;
+  const size_t steps = 5;
+  const arma::urowvec lengths = { 2, 5, 1, 4, 2 };
+
+  // Use the sum of the errors, so that the loss of a batch is the sum of the
+  // losses of its sequences.
+  RNN<MeanSquaredError> model(steps, false, MeanSquaredError(false));
+  model.Add<LSTM>(4);
+  model.Add<Linear>(2);
+  model.Reset(inSize);
+  model.Parameters().randn();
+  model.Parameters() *= 0.5;
+
+  // The padding holds garbage, which must be ignored.
+  arma::cube input(inSize, lengths.n_elem, steps, arma::fill::randn);
+  arma::cube responses(2, lengths.n_elem, steps, arma::fill::randn);
+
+  double expectedLoss = 0.0;
+  arma::mat expectedGradient(arma::size(model.Parameters()),
+      arma::fill::zeros);
+  arma::cube expectedPredictions(2, lengths.n_elem, steps, arma::fill::zeros);
+  arma::mat parameters = model.Parameters();
+  for (size_t i = 0; i < lengths.n_elem; ++i)
+  {
+    const arma::cube sequence = input.subcube(0, i, 0, inSize - 1, i,
+        lengths[i] - 1);
+    const arma::cube sequenceResponses = responses.subcube(0, i, 0, 1, i,
+        lengths[i] - 1);
+
+    model.ResetData(sequence, sequenceResponses);
+    arma::mat gradient;
+    expectedLoss += model.EvaluateWithGradient(parameters, 0, gradient, 1);
+    expectedGradient += gradient;
+
+    arma::cube predictions;
+    model.Predict(sequence, predictions);
+    expectedPredictions.subcube(0, i, 0, 1, i, lengths[i] - 1) = predictions;
+  }
+
+  model.ResetData(input, lengths, responses);
+  arma::mat gradient;
+  const double loss = model.EvaluateWithGradient(parameters, 0, gradient,
+      lengths.n_elem);
+
+  REQUIRE(loss == Approx(expectedLoss).epsilon(1e-7));
+  REQUIRE(model.Evaluate(parameters, 0, lengths.n_elem) ==
+      Approx(expectedLoss).epsilon(1e-7));
+  CheckMatrices(gradient, expectedGradient, 1e-5);
+
+  // Shuffling only reorders sequences of the same length, so the gradient of
+  // the whole dataset does not change.
+  model.Shuffle();
+  model.EvaluateWithGradient(parameters, 0, gradient, lengths.n_elem);
+  CheckMatrices(gradient, expectedGradient, 1e-5);
+
+  arma::cube predictions;
+  model.Predict(input, lengths, predictions, 2);
+  CheckMatrices(predictions, expectedPredictions, 1e-5);
+
+  // Lengths that don't fit the data are rejected.
+  const arma::urowvec badLengths = { 2, 6, 1, 4, 2 };
+  REQUIRE_THROWS_AS(model.ResetData(input, badLengths, responses),
+      std::invalid_argument);
+}
+
+/**
+ * Test that streaming a sequence one step at a time with PredictStep() gives
+ * the same outputs as Predict() on the whole sequence.
+ */
+TEST_CASE("RNNPredictStepTest", "[RecurrentNetworkTest]")
+{
+  const size_t steps = 6;
+  const size_t points = 3;
+
+  RNN<MeanSquaredError> model;
+  model.Add<GRU>(5);
+  model.Add<Linear>(2);
+  model.Reset(4);
+  model.Parameters().randn();
+
+  arma::cube input(4, points, steps, arma::fill::randn);
+  arma::cube predictions;
+  model.Predict(input, predictions);
+
+  // Stream the sequences twice, to check that ResetState() starts over.
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    model.ResetState();
+    arma::mat output;
+    for (size_t t = 0; t < steps; ++t)
+    {
+      model.PredictStep(input.slice(t), output);
+      CheckMatrices(output, predictions.slice(t));
+    }
+
+    REQUIRE(model.StateSteps() == steps);
+  }
+
+  // The number of streamed sequences can't change without a reset.
+  arma::mat output;
+  REQUIRE_THROWS_AS(model.PredictStep(input.slice(0).cols(0, 1), output),
+      std::invalid_argument);
+}
@@ -161,6 +161,60 @@ TEST_CASE("SimpleCartPoleTest", "[RLComponentsTest]")
   REQUIRE(2 == static_cast<size_t>(CartPole::Action::size));
 }
 
+/**
+ * Step several CartPole instances in lockstep, and check that they follow the
+ * dynamics of single instances and restart at the end of their episodes.
+ */
+TEST_CASE("VectorEnvironmentCartPoleTest", "[RLComponentsTest]")
+{
+  VectorEnvironment<CartPole> envs(3, CartPole(5));
+  const arma::mat initialStates = envs.Reset();
+  REQUIRE(initialStates.n_rows == CartPole::State::dimension);
+  REQUIRE(initialStates.n_cols == 3);
+
+  // A single instance started from the same state must follow the same path.
+  CartPole single(5);
+  single.InitialSample();
+  CartPole::State state(initialStates.col(1));
+
+  std::vector<CartPole::Action> actions(3);
+  for (CartPole::Action& a : actions)
+    a.action = CartPole::Action::actions::forward;
+
+  arma::rowvec rewards;
+  arma::urowvec terminal;
+  arma::mat nextStates;
+  for (size_t step = 0; step < 5; ++step)
+  {
+    envs.Step(actions, rewards, terminal, nextStates);
+    single.Sample(state, actions[1], state);
+
+    REQUIRE(rewards.n_elem == 3);
+    CheckMatrices(nextStates.col(1), state.Encode());
+
+    // The instances may fail before the maximum number of steps.
+    for (size_t i = 0; i < 3; ++i)
+    {
+      if (!terminal[i])
+        CheckMatrices(envs.States().col(i), nextStates.col(i));
+    }
+
+    if (terminal[1])
+      break;
+  }
+
+  // The episode ended at the fifth step at the latest, and the instance was
+  // restarted.
+  REQUIRE(terminal[1] == 1);
+  REQUIRE(envs.Environment(1).StepsPerformed() == 0);
+  CheckMatrices(envs.States().col(1), envs.InstanceState(1).Encode());
+
+  // The number of actions must match the number of instances.
+  actions.resize(2);
+  REQUIRE_THROWS_AS(envs.Step(actions, rewards, terminal, nextStates),
+      std::invalid_argument);
+}
+
 /**
  * Constructs a DoublePoleCart instance and check if the main routine works as
  * it should be.
@@ -262,6 +316,65 @@ TEST_CASE("RandomReplayTest", "[RLComponentsTest]")
   }
 }
 
+/**
+ * Check that the compressed replay rebuilds the stacked states of the stored
+ * transitions, across episodes and when the memory is overwritten.
+ */
+TEST_CASE("CompressedReplayTest", "[RLComponentsTest]")
+{
+  using Env = ContinuousActionEnv<6, 1>;
+
+  // States stack two frames of three pixels, stored as bytes.
+  CompressedReplay<Env, unsigned char> replay(10, 3, 2);
+  REQUIRE_THROWS_AS(CompressedReplay<Env>(10, 3, 4), std::invalid_argument);
+
+  // Two episodes, of 4 and 2 transitions.
+  std::vector<arma::colvec> frames;
+  for (size_t i = 0; i < 10; ++i)
+    frames.push_back(arma::round(255 * arma::randu<arma::colvec>(3)));
+
+  auto stack = [&](const size_t f) { return Env::State(
+      arma::join_cols(frames[f], frames[f + 1])); };
+  std::vector<size_t> firstFrames = { 0, 1, 2, 3, 6, 7 };
+
+  Env::Action action;
+  for (size_t t = 0; t < firstFrames.size(); ++t)
+  {
+    action.action[0] = t;
+    replay.Store(stack(firstFrames[t]), action, t, stack(firstFrames[t] + 1),
+        t == 3, 0.9);
+  }
+
+  // The memory holds five frames.  The first frames of the second episode
+  // overwrite the frames of the first episode, so only the transitions of the
+  // second episode are kept.
+  REQUIRE(replay.Size() == 2);
+
+  arma::mat sampledStates;
+  std::vector<Env::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::mat sampledNextStates;
+  arma::irowvec sampledTerminal;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    replay.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+
+    REQUIRE(sampledStates.n_rows == 6);
+    REQUIRE(sampledStates.n_cols == 10);
+    for (size_t j = 0; j < sampledRewards.n_elem; ++j)
+    {
+      const size_t t = (size_t) sampledRewards[j];
+      REQUIRE(t >= 4);
+      REQUIRE(sampledActions[j].action[0] == t);
+      REQUIRE(sampledTerminal[j] == 0);
+      CheckMatrices(sampledStates.col(j), stack(firstFrames[t]).Encode());
+      CheckMatrices(sampledNextStates.col(j),
+          stack(firstFrames[t] + 1).Encode());
+    }
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
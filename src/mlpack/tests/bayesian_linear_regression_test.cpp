@@ -207,6 +207,40 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
   REQUIRE(trial <= 3);
 }
 
+// Check that the model is right for wide data, where the SVD of the data has
+// fewer singular values than dimensions.
+TEST_CASE("BayesianLinearRegressionWideDataTest",
+          "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 80, 100, 0.5);
+
+  BayesianLinearRegression<> blr(false, false, 10000, 1e-10);
+  blr.Train(matX, y);
+
+  // The solution is the ridge solution for the final hyperparameters.
+  const arma::mat gram = matX * matX.t();
+  const arma::vec ridgeOmega = arma::solve(gram + (blr.Alpha() / blr.Beta()) *
+      arma::eye<arma::mat>(100, 100), matX * y.t());
+  for (size_t i = 0; i < ridgeOmega.n_elem; ++i)
+    REQUIRE(blr.Omega()[i] == Approx(ridgeOmega[i]).margin(1e-5));
+
+  // The predictive uncertainties use the full posterior covariance, including
+  // the directions that are not spanned by the data.
+  const arma::mat covariance = arma::inv_sympd(blr.Alpha() *
+      arma::eye<arma::mat>(100, 100) + blr.Beta() * gram);
+  const arma::mat testX = arma::randn<arma::mat>(100, 10);
+  arma::rowvec predictions, stds;
+  blr.Predict(testX, predictions, stds);
+  for (size_t i = 0; i < testX.n_cols; ++i)
+  {
+    const double expected = std::sqrt(blr.Variance() +
+        arma::dot(testX.col(i), covariance * testX.col(i)));
+    REQUIRE(stds[i] == Approx(expected).epsilon(1e-6));
+  }
+}
+
 // Check that all constructor variants work.
 TEMPLATE_TEST_CASE("BayesianLinearRegressionConstructorVariantTest",
     "[BayesianLinearRegressionTest]", arma::mat)
@@ -104,3 +104,98 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * Make sure that the iteration stops early on exactly low-rank data, and when
+ * the Ritz values have converged.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDEarlyStopTest", "[BlockKrylovSVDTest]")
+{
+  // The rank of this matrix is 8, so the second block adds no new direction.
+  arma::mat data = arma::randn<arma::mat>(100, 8) *
+      arma::randn<arma::mat>(8, 300);
+
+  arma::mat U1, V1, U2, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, data);
+
+  RandomizedBlockKrylovSVD rSVD(50, 15);
+  rSVD.Apply(data, U2, s2, V2, 5);
+
+  REQUIRE(rSVD.Blocks() == 1);
+  REQUIRE(s2.n_elem == 8);
+  double error = arma::max(arma::abs(s1.subvec(0, 7) - s2));
+  REQUIRE(error == Approx(0.0).margin(1e-8));
+
+  // On noisy data, the Ritz values converge well before 50 blocks.
+  CreateNoisyLowRankMatrix(data, 200, 1000, 5, 0.5);
+  arma::svd_econ(U1, s1, V1, data);
+
+  RandomizedBlockKrylovSVD rSVD2(50, 20, 1e-10);
+  rSVD2.Apply(data, U2, s2, V2, 5);
+
+  REQUIRE(rSVD2.Blocks() < 50);
+  error = arma::max(arma::abs(s1.subvec(0, 4) - s2.subvec(0, 4)));
+  REQUIRE(error == Approx(0.0).margin(1e-6));
+}
+
+/**
+ * Make sure that sparse data gives the same singular values as the same data
+ * stored in a dense matrix.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDSparseTest", "[BlockKrylovSVDTest]")
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(300, 200, 0.05);
+  arma::mat data(sparseData);
+
+  arma::mat U1, V1, U2, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, data);
+
+  RandomizedBlockKrylovSVD rSVD(10, 20);
+  rSVD.Apply(sparseData, U2, s2, V2, 5);
+
+  double error = arma::max(arma::abs(s1.subvec(0, 4) - s2.subvec(0, 4)));
+  REQUIRE(error == Approx(0.0).margin(1e-6));
+
+  // The factorization must reconstruct the data projected onto the basis.
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+  arma::mat projected = U2 * (U2.t() * data);
+  REQUIRE(arma::norm(reconstruct - projected, "fro") ==
+      Approx(0.0).margin(1e-8));
+}
+
+/**
+ * Make sure that a Krylov basis can be extended to increase the rank.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDReuseBasisTest", "[BlockKrylovSVDTest]")
+{
+  arma::mat data;
+  CreateNoisyLowRankMatrix(data, 200, 1000, 5, 0.5);
+
+  arma::mat U1, V1, U2, V2;
+  arma::vec s1, s2;
+  arma::svd_econ(U1, s1, V1, data);
+
+  arma::mat basis;
+  RandomizedBlockKrylovSVD rSVD(2, 10);
+  rSVD.Apply(data, U2, s2, V2, 5, basis);
+  REQUIRE(basis.n_cols == 30);
+
+  // Extend the basis with larger blocks, until it spans the whole space; the
+  // last block only adds the 20 remaining directions.
+  rSVD.BlockSize() = 25;
+  rSVD.MaxIterations() = 6;
+  rSVD.Apply(data, U2, s2, V2, 15, basis);
+  REQUIRE(basis.n_cols == 200);
+  REQUIRE(rSVD.Blocks() == 7);
+
+  // The basis must still be orthonormal.
+  arma::mat identity = arma::eye<arma::mat>(basis.n_cols, basis.n_cols);
+  REQUIRE(arma::norm(basis.t() * basis - identity, "fro") ==
+      Approx(0.0).margin(1e-8));
+
+  double error = arma::max(arma::abs(s1.subvec(0, 14) - s2.subvec(0, 14)));
+  REQUIRE(error == Approx(0.0).margin(1e-8));
+}
@@ -138,10 +138,10 @@ void GetRecommendationsQueriedUser()
  */
 template<typename DecompositionPolicy,
          typename NormalizationType = NoNormalization>
-void RecommendationAccuracy(const size_t allowedFailures = 20)
+void RecommendationAccuracy(
+    const size_t allowedFailures = 20,
+    const DecompositionPolicy& decomposition = DecompositionPolicy())
 {
-  DecompositionPolicy decomposition;
-
   // Small GroupLens dataset.
   arma::mat dataset;
 
@@ -494,6 +494,110 @@ void Serialization()
   }
 }
 
+/**
+ * Make sure that GetFactorRecommendations() returns the unrated items with the
+ * highest predicted ratings, as found by scoring every item.
+ */
+template<typename DecompositionPolicy>
+void FactorRecommendations()
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  CFType<DecompositionPolicy> c(dataset, DecompositionPolicy(), 5, 5, 30);
+
+  // Use small batches, so that users are searched for in many batches.
+  const size_t numRecs = 10;
+  arma::Mat<size_t> recommendations;
+  c.GetFactorRecommendations(numRecs, recommendations, 17);
+  REQUIRE(recommendations.n_rows == numRecs);
+  REQUIRE(recommendations.n_cols == c.CleanedData().n_cols);
+
+  for (size_t user = 0; user < recommendations.n_cols; ++user)
+  {
+    arma::vec ratings;
+    c.Decomposition().GetRatingOfUser(user, ratings);
+    for (size_t item = 0; item < ratings.n_elem; ++item)
+    {
+      if (c.CleanedData()(item, user) != 0.0)
+        ratings[item] = -DBL_MAX;
+    }
+    const arma::vec best = arma::sort(ratings, "descend");
+
+    // Compare the ratings, in case of ties.
+    for (size_t i = 0; i < numRecs; ++i)
+    {
+      const size_t item = recommendations(i, user);
+      REQUIRE(item < ratings.n_elem);
+      REQUIRE(c.CleanedData()(item, user) == 0.0);
+      REQUIRE(ratings[item] == Approx(best[i]).epsilon(1e-7));
+    }
+  }
+
+  // Specific users are in the same order as given.
+  arma::Col<size_t> users = { 7, 3, 150 };
+  arma::Mat<size_t> userRecommendations;
+  c.GetFactorRecommendations(numRecs, userRecommendations, users);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    for (size_t j = 0; j < numRecs; ++j)
+    {
+      REQUIRE(c.Decomposition().GetRating(users[i], userRecommendations(j, i))
+          == Approx(c.Decomposition().GetRating(users[i],
+          recommendations(j, users[i]))).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that FoldInUsers() and FoldInItems() add least squares factors for
+ * held-out users and items.
+ */
+template<typename DecompositionPolicy,
+         typename NormalizationType = NoNormalization>
+void FoldIn()
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  // Hold out the last 10 users, and the items with the largest IDs.
+  const double itemCutoff = max(dataset.row(1)) - 20;
+  const arma::uvec trainIndices = arma::find((dataset.row(0) < 190) %
+      (dataset.row(1) < itemCutoff));
+  const arma::uvec itemIndices = arma::find((dataset.row(0) < 190) %
+      (dataset.row(1) >= itemCutoff));
+
+  CFType<DecompositionPolicy, NormalizationType> c(
+      arma::mat(dataset.cols(trainIndices)), DecompositionPolicy(), 5, 5, 30);
+  const size_t numUsers = c.CleanedData().n_cols;
+  const size_t numItems = c.CleanedData().n_rows;
+  REQUIRE(numUsers == 190);
+
+  // The new users may only rate items of the model.
+  const arma::uvec userIndices = arma::find((dataset.row(0) >= 190) %
+      (dataset.row(1) < numItems));
+
+  c.FoldInUsers(dataset.cols(userIndices), 0.1);
+  REQUIRE(c.CleanedData().n_cols == 200);
+  REQUIRE(c.Decomposition().H().n_cols == 200);
+  REQUIRE(c.CleanedData().n_nonzero == trainIndices.n_elem +
+      userIndices.n_elem);
+
+  const size_t numNewItems = (size_t) max(dataset.row(1)) + 1 - numItems;
+  c.FoldInItems(dataset.cols(itemIndices), 0.1);
+  REQUIRE(c.CleanedData().n_rows == numItems + numNewItems);
+  REQUIRE(c.Decomposition().W().n_rows == numItems + numNewItems);
+
+  // The model can be used for the new users and items.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(5, recommendations);
+  REQUIRE(recommendations.n_cols == 200);
+  const double prediction = c.Predict(195, numItems);
+  REQUIRE(std::isfinite(prediction));
+}
+
 /**
  * Make sure that correct number of recommendations are generated when query
  * set for all methods.
@@ -501,7 +605,7 @@ void Serialization()
 TEMPLATE_TEST_CASE("CFGetRecommendationsAllUsersTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   GetRecommendationsAllUsers<TestType>();
 }
@@ -513,7 +617,7 @@ TEMPLATE_TEST_CASE("CFGetRecommendationsAllUsersTest", "[CFTest]",
 TEMPLATE_TEST_CASE("CFGetRecommendationsQueriedUsersTest", "[CFTest]",
   RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
   SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-  QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+  QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   GetRecommendationsQueriedUser<TestType>();
 }
@@ -525,7 +629,7 @@ TEMPLATE_TEST_CASE("CFGetRecommendationsQueriedUsersTest", "[CFTest]",
 TEMPLATE_TEST_CASE("RecommendationAccuracyTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, QUIC_SVDPolicy,
-    BlockKrylovSVDPolicy)
+    BlockKrylovSVDPolicy, ALSPolicy)
 {
   RecommendationAccuracy<TestType>();
 }
@@ -547,7 +651,7 @@ TEMPLATE_TEST_CASE("RecommendationAccuracyTest", "[CFTest]",
 TEMPLATE_TEST_CASE("CFPredictTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   CFPredict<TestType>();
 }
@@ -558,7 +662,7 @@ TEMPLATE_TEST_CASE("CFPredictTest", "[CFTest]",
 TEMPLATE_TEST_CASE("CFBatchPredictTest", "[CFTest]",
     RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
     SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, SVDPlusPlusPolicy,
-    QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   BatchPredict<TestType>();
 }
@@ -569,7 +673,7 @@ TEMPLATE_TEST_CASE("CFBatchPredictTest", "[CFTest]",
  */
 TEMPLATE_TEST_CASE("TrainTest_1", "[CFTest]",
     RandomizedSVDPolicy, BatchSVDPolicy, NMFPolicy, SVDCompletePolicy,
-    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   TestType decomposition;
   Train(decomposition);
@@ -593,7 +697,7 @@ TEMPLATE_TEST_CASE("TrainTest_2", "[CFTest]",
 TEMPLATE_TEST_CASE("EmptyConstructorTrainTest", "[CFTest]",
   RandomizedSVDPolicy, RegSVDPolicy, BatchSVDPolicy, NMFPolicy,
   SVDCompletePolicy, SVDIncompletePolicy, BiasSVDPolicy, QUIC_SVDPolicy,
-  BlockKrylovSVDPolicy)
+  BlockKrylovSVDPolicy, ALSPolicy)
 {
   EmptyConstructorTrain<TestType>();
 }
@@ -603,11 +707,117 @@ TEMPLATE_TEST_CASE("EmptyConstructorTrainTest", "[CFTest]",
  */
 TEMPLATE_TEST_CASE("SerializationTest", "[CFTest]",
     RandomizedSVDPolicy, BatchSVDPolicy, NMFPolicy, SVDCompletePolicy,
-    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy)
+    SVDIncompletePolicy, QUIC_SVDPolicy, BlockKrylovSVDPolicy, ALSPolicy)
 {
   Serialization<TestType>();
 }
 
+/**
+ * Make sure that the recommendations found with max-inner-product search are
+ * the best unrated items, for decompositions with and without biases.
+ */
+TEMPLATE_TEST_CASE("CFFactorRecommendationsTest", "[CFTest]",
+    NMFPolicy, RegSVDPolicy, BiasSVDPolicy, SVDPlusPlusPolicy, ALSPolicy)
+{
+  FactorRecommendations<TestType>();
+}
+
+/**
+ * Make sure that new users and items can be folded into a model, for
+ * decompositions with and without biases.
+ */
+TEMPLATE_TEST_CASE("CFFoldInTest", "[CFTest]",
+    NMFPolicy, RegSVDPolicy, BiasSVDPolicy, ALSPolicy)
+{
+  FoldIn<TestType>();
+}
+
+/**
+ * Make sure that fold-in works with normalizations that keep statistics of
+ * each user or item.
+ */
+TEMPLATE_TEST_CASE("CFFoldInNormalizationTest", "[CFTest]",
+    UserMeanNormalization, ItemMeanNormalization, ZScoreNormalization,
+    CombinedNormalization<OverallMeanNormalization, UserMeanNormalization,
+        ItemMeanNormalization>)
+{
+  FoldIn<RegSVDPolicy, TestType>();
+}
+
+/**
+ * Make sure that the factors of a folded-in user solve the regularized least
+ * squares problem of its ratings.
+ */
+TEST_CASE("CFFoldInLeastSquaresTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  const arma::uvec trainIndices = arma::find(dataset.row(0) < 199);
+  const arma::uvec userIndices = arma::find(dataset.row(0) == 199);
+  CF c(arma::mat(dataset.cols(trainIndices)), NMFPolicy(), 5, 5, 30);
+  const size_t numItems = c.CleanedData().n_rows;
+
+  // Only use the ratings of items of the model.
+  arma::mat userData = dataset.cols(userIndices);
+  userData = userData.cols(arma::find(userData.row(1) < numItems));
+  c.FoldInUsers(userData, 0.1);
+
+  // The gradient W_S^T (W_S h - r) + lambda n h must be zero.
+  const arma::mat& w = c.Decomposition().W();
+  const arma::vec h = c.Decomposition().H().col(199);
+  arma::vec gradient = 0.1 * userData.n_cols * h;
+  arma::vec projection(h.n_elem, arma::fill::zeros);
+  for (size_t i = 0; i < userData.n_cols; ++i)
+  {
+    const arma::vec f = w.row((size_t) userData(1, i)).t();
+    gradient += f * (arma::dot(f, h) - userData(2, i));
+    projection += f * userData(2, i);
+  }
+  REQUIRE(arma::norm(gradient) < 1e-8 * arma::norm(projection));
+
+  // Existing users can't be folded in.
+  REQUIRE_THROWS_AS(c.FoldInUsers(userData), std::invalid_argument);
+}
+
+/**
+ * Make sure that ALS with implicit feedback and with the conjugate gradient
+ * solver gives reasonably accurate recommendations.
+ */
+TEST_CASE("ALSPolicyVariantsAccuracyTest", "[CFTest]")
+{
+  RecommendationAccuracy<ALSPolicy>(20, ALSPolicy(0.1, true, 40.0));
+  RecommendationAccuracy<ALSPolicy>(20, ALSPolicy(0.1, false, 40.0, 3));
+}
+
+/**
+ * Make sure that enough conjugate gradient iterations give the same model as
+ * exact least squares solves.
+ */
+TEST_CASE("ALSPolicyCGExactTest", "[CFTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("GroupLensSmall.csv", dataset))
+    FAIL("Cannot load test dataset GroupLensSmall.csv!");
+
+  for (const bool implicit : { false, true })
+  {
+    ALSPolicy exact(0.1, implicit), cg(0.1, implicit, 40.0, 20);
+
+    RandomSeed(42);
+    CFType<ALSPolicy> cfExact(dataset, exact, 5, 5, 10, 1e-5, true);
+    RandomSeed(42);
+    CFType<ALSPolicy> cfCG(dataset, cg, 5, 5, 10, 1e-5, true);
+
+    const arma::mat ratingsExact = cfExact.Decomposition().W() *
+        cfExact.Decomposition().H();
+    const arma::mat ratingsCG = cfCG.Decomposition().W() *
+        cfCG.Decomposition().H();
+    REQUIRE(arma::approx_equal(ratingsExact, ratingsCG, "absdiff", 1e-4));
+  }
+}
+
 /**
  * Make sure that Predict() is returning reasonable results for NMF and
  * all types of Normalization except default.
@@ -432,3 +432,54 @@ TEST_CASE("MoveConstructorAndOperatorCosineTreeTest", "[CosineTreeTest]")
     REQUIRE(v1.at(i) == v3.at(i));
   }
 }
+
+/**
+ * Refining a cosine tree for a larger epsilon than before should not split any
+ * node, and should give the basis of the earlier refinement step.
+ */
+TEST_CASE("CosineTreeRefineTest", "[CosineTreeTest]")
+{
+  arma::mat data = arma::randu(20, 200);
+
+  CosineTree<> ctree(data, 0.5, 0.1);
+  arma::mat coarseBasis;
+  ctree.GetFinalBasis(coarseBasis);
+  const size_t coarseSplits = ctree.NumSplits();
+
+  ctree.Refine(0.01);
+  arma::mat fineBasis;
+  ctree.GetFinalBasis(fineBasis);
+  const size_t fineSplits = ctree.NumSplits();
+  REQUIRE(fineSplits >= coarseSplits);
+  REQUIRE(fineBasis.n_cols >= coarseBasis.n_cols);
+
+  // Going back to the larger epsilon splits nothing.
+  ctree.Refine(0.5);
+  arma::mat replayedBasis;
+  ctree.GetFinalBasis(replayedBasis);
+  REQUIRE(ctree.NumSplits() == fineSplits);
+  REQUIRE(replayedBasis.n_cols == coarseBasis.n_cols);
+
+  // The columns may be in a different order, but they are the same vectors.
+  for (size_t i = 0; i < coarseBasis.n_cols; ++i)
+  {
+    bool found = false;
+    for (size_t j = 0; j < replayedBasis.n_cols; ++j)
+    {
+      if (arma::approx_equal(coarseBasis.col(i), replayedBasis.col(j),
+          "absdiff", 1e-12))
+        found = true;
+    }
+
+    REQUIRE(found);
+  }
+
+  // Copies and moves keep the refinement.
+  CosineTree<> copy(ctree);
+  copy.Refine(0.5);
+  REQUIRE(copy.NumSplits() == fineSplits);
+
+  CosineTree<> moved(std::move(copy));
+  moved.Refine(0.5);
+  REQUIRE(moved.NumSplits() == fineSplits);
+}
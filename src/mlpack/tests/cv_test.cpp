@@ -147,6 +147,28 @@ TEST_CASE("ConfusionMatrixTest", "[CVTest]")
   REQUIRE(output(1, 1) == 3);
 }
 
+/**
+ * Test the confusion matrix of many points, which are counted in parallel.
+ */
+TEST_CASE("ConfusionMatrixManyPointsTest", "[CVTest]")
+{
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(100000,
+      arma::distr_param(0, 2));
+  arma::Row<size_t> predictedLabels = arma::randi<arma::Row<size_t>>(100000,
+      arma::distr_param(0, 2));
+
+  arma::Mat<size_t> expected(3, 3, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    ++expected(predictedLabels[i], labels[i]);
+
+  arma::mat output;
+  data::ConfusionMatrix(predictedLabels, labels, output, 3);
+  REQUIRE(output.n_rows == 3);
+  REQUIRE(output.n_cols == 3);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(output[i] == (double) expected[i]);
+}
+
 /**
  * Test metrics for multiclass classification.
  */
@@ -198,6 +220,115 @@ TEST_CASE("MulticlassClassificationMetricsTest", "[CVTest]")
           == Approx(macroaveragedF1).epsilon(1e-7));
 }
 
+/**
+ * Test ClassificationAccumulator gives the same metrics as the classification
+ * metrics when predictions are added in batches by different accumulators.
+ */
+TEST_CASE("ClassificationAccumulatorTest", "[CVTest]")
+{
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+
+  ClassificationAccumulator first, second;
+  first.Update(predictedLabels.cols(0, 4), labels.cols(0, 4));
+  second.Update(predictedLabels.cols(5, 8), labels.cols(5, 8));
+  second.Update(predictedLabels.cols(9, 11), labels.cols(9, 11));
+  first.Merge(second);
+
+  REQUIRE(first.Count() == 12);
+  REQUIRE(first.NumClasses() == 4);
+  REQUIRE(first.Accuracy() == Approx(9.0 / 12).epsilon(1e-7));
+  REQUIRE(first.Precision<Micro>() == Approx(9.0 / 12).epsilon(1e-7));
+  REQUIRE(first.Precision<Macro>() ==
+      Approx((0.5 + 0.5 + 0.75 + 1.0) / 4).epsilon(1e-7));
+  REQUIRE(first.Recall<Macro>() ==
+      Approx((0.5 + 1.0 / 3 + 1.0 + 1.0) / 4).epsilon(1e-7));
+  double macroaveragedF1 = (2 * 0.5 * 0.5 / (0.5 + 0.5) +
+      2 * 0.5 * (1.0 / 3) / (0.5 + (1.0 / 3)) + 2 * 0.75 * 1.0 / (0.75 + 1.0) +
+      2 * 1.0 * 1.0 / (1.0 + 1.0)) / 4;
+  REQUIRE(first.F1<Macro>() == Approx(macroaveragedF1).epsilon(1e-7));
+
+  // Binary metrics, as in BinaryClassificationMetricsTest.
+  ClassificationAccumulator binary;
+  binary.Update(arma::Row<size_t>("0 0 0 0 0  1 1 1 1 1"),
+      arma::Row<size_t>("0 0 1 0 0  1 0 1 0 1"));
+  REQUIRE(binary.Precision<Binary>() == Approx(0.6).epsilon(1e-7));
+  REQUIRE(binary.Recall<Binary>() == Approx(0.75).epsilon(1e-7));
+  REQUIRE(binary.F1<Binary>() ==
+      Approx(2 * 0.6 * 0.75 / (0.6 + 0.75)).epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(binary.Update(arma::Row<size_t>("0 1"),
+      arma::Row<size_t>("0 1 1")), std::invalid_argument);
+}
+
+/**
+ * Test RegressionAccumulator gives the same metrics over batches as over all
+ * predictions at once.
+ */
+TEST_CASE("RegressionAccumulatorTest", "[CVTest]")
+{
+  arma::rowvec responses = 10.0 + arma::randn<arma::rowvec>(300);
+  arma::rowvec predictedResponses = responses +
+      0.3 * arma::randn<arma::rowvec>(300);
+
+  RegressionAccumulator first, second;
+  first.Update(predictedResponses.cols(0, 99), responses.cols(0, 99));
+  second.Update(predictedResponses.cols(100, 199), responses.cols(100, 199));
+  second.Update(predictedResponses.cols(200, 299), responses.cols(200, 299));
+  first.Merge(second);
+
+  const double squaredError = arma::accu(arma::square(responses -
+      predictedResponses));
+  const double totalSquares = arma::accu(arma::square(responses -
+      arma::mean(responses)));
+
+  REQUIRE(first.Count() == 300);
+  REQUIRE(first.MSE() == Approx(squaredError / 300).epsilon(1e-7));
+  REQUIRE(first.R2() ==
+      Approx(1.0 - squaredError / totalSquares).epsilon(1e-7));
+  REQUIRE(first.AdjustedR2(2) == Approx(1.0 - (squaredError / totalSquares) *
+      299.0 / 297.0).epsilon(1e-7));
+}
+
+/**
+ * Test BinnedROCAUCScore gives the exact ROC-AUC when no bin holds both
+ * positives and negatives, and that merged histograms give the same result.
+ */
+TEST_CASE("BinnedROCAUCScoreTest", "[CVTest]")
+{
+  arma::Row<size_t> labels("1 0 1 0 1  0 1 0 1 0");
+  arma::Row<double> scores("0.8 0.3 0.5 0.4 0.9  0.2 0.7 0.6 0 0.1");
+
+  REQUIRE(BinnedROCAUCScore<0>::Evaluate(labels, scores) ==
+      Approx(ROCAUCScore<0>::Evaluate(labels, scores)).epsilon(1e-7));
+  REQUIRE(BinnedROCAUCScore<1>::Evaluate(labels, scores) ==
+      Approx(ROCAUCScore<1>::Evaluate(labels, scores)).epsilon(1e-7));
+
+  BinnedROCAUCScore<> first, second;
+  first.Update(labels.cols(0, 4), scores.cols(0, 4));
+  second.Update(labels.cols(5, 9), scores.cols(5, 9));
+  first.Merge(second);
+  REQUIRE(first.Evaluate() == Approx(0.76).epsilon(1e-7));
+
+  // With many random scores, the binned ROC-AUC should be close to the exact
+  // one.
+  arma::Row<size_t> randomLabels = arma::randi<arma::Row<size_t>>(5000,
+      arma::distr_param(0, 1));
+  arma::Row<double> randomScores = arma::clamp(0.5 + 0.2 *
+      arma::randn<arma::Row<double>>(5000) + 0.1 *
+      arma::conv_to<arma::Row<double>>::from(randomLabels), 0.0, 1.0);
+  REQUIRE(BinnedROCAUCScore<>::Evaluate(randomLabels, randomScores) ==
+      Approx(ROCAUCScore<>::Evaluate(randomLabels, randomScores)).
+      margin(5e-3));
+
+  // Only one class.
+  REQUIRE_THROWS_AS(BinnedROCAUCScore<>::Evaluate(arma::Row<size_t>("1 1"),
+      arma::Row<double>("0.2 0.3")), std::invalid_argument);
+  REQUIRE_THROWS_AS(BinnedROCAUCScore<>(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(first.Merge(BinnedROCAUCScore<>(10)),
+      std::invalid_argument);
+}
+
 /**
  * Test the mean squared error.
  */
@@ -582,6 +713,29 @@ TEST_CASE("KFoldCVAccuracyTest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Test that k-fold cross-validation gives the same result when the folds are
+ * evaluated in parallel.
+ */
+TEST_CASE("KFoldCVParallelTest", "[CVTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::rowvec responses = arma::sum(data, 0) +
+      0.1 * arma::randn<arma::rowvec>(200);
+
+  KFoldCV<LinearRegression<>, MSE> cv(10, data, responses, false);
+  REQUIRE(cv.Parallel() == false);
+  const double serialMSE = cv.Evaluate();
+  const arma::vec serialParameters = cv.Model().Parameters();
+
+  cv.Parallel() = true;
+  const double parallelMSE = cv.Evaluate();
+
+  REQUIRE(parallelMSE == Approx(serialMSE).epsilon(1e-10));
+  REQUIRE(arma::approx_equal(cv.Model().Parameters(), serialParameters,
+      "absdiff", 1e-10));
+}
+
 /**
  * Test k-fold cross-validation with the perceptron.
  */
@@ -858,3 +1012,31 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Test the silhouette scores computed without a distance matrix match the ones
+ * computed from precomputed distances, and that the sampled silhouette score
+ * is close to the overall one.
+ */
+TEST_CASE("SilhouetteScoreSampledTest", "[CVTest]")
+{
+  arma::mat X = arma::join_rows(arma::randn(2, 100),
+      arma::join_rows(arma::randn(2, 100) + 10.0, arma::randn(2, 100) - 10.0));
+  arma::Row<size_t> labels = arma::join_rows(arma::zeros<arma::Row<size_t>>(
+      100), arma::join_rows(2 * arma::ones<arma::Row<size_t>>(100),
+      5 * arma::ones<arma::Row<size_t>>(100)));
+  EuclideanDistance metric;
+
+  arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels, metric);
+  arma::rowvec expected = SilhouetteScore::SamplesScore(
+      PairwiseDistances(X, metric), labels);
+  REQUIRE(arma::approx_equal(scores, expected, "absdiff", 1e-10));
+
+  const double overall = arma::mean(expected);
+  REQUIRE(SilhouetteScore::SampledOverall(X, labels, metric, 300) ==
+      Approx(overall).epsilon(1e-7));
+  REQUIRE(SilhouetteScore::SampledOverall(X, labels, metric, 100) ==
+      Approx(overall).margin(0.05));
+  REQUIRE_THROWS_AS(SilhouetteScore::SampledOverall(X, labels, metric, 0),
+      std::invalid_argument);
+}
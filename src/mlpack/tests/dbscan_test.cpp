@@ -364,3 +364,168 @@ TEST_CASE("NoiseConnectionTest", "[DBSCANTest]")
 
   REQUIRE(numClusters == 2);
 }
+
+/**
+ * Make sure that two clusterings are the same up to the labels of the
+ * clusters.
+ */
+void CheckSameClusters(const arma::Row<size_t>& assignments,
+                       const arma::Row<size_t>& otherAssignments,
+                       const size_t numClusters)
+{
+  REQUIRE(assignments.n_elem == otherAssignments.n_elem);
+
+  arma::Row<size_t> labelMap(numClusters);
+  labelMap.fill(SIZE_MAX);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+  {
+    if (assignments[i] == SIZE_MAX)
+    {
+      REQUIRE(otherAssignments[i] == SIZE_MAX);
+      continue;
+    }
+
+    REQUIRE(otherAssignments[i] != SIZE_MAX);
+    if (labelMap[assignments[i]] == SIZE_MAX)
+      labelMap[assignments[i]] = otherAssignments[i];
+    REQUIRE(labelMap[assignments[i]] == otherAssignments[i]);
+  }
+}
+
+/**
+ * Make sure that searching the points in batches gives the same clusters as
+ * searching all of them at once.
+ */
+TEST_CASE("BatchSizeTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 300);
+
+  GaussianDistribution g1(3), g2(3), g3(3);
+  g1.Mean() = arma::vec("0.0 0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0 8.0");
+  g3.Mean() = arma::vec("-6.0 1.0 -7.0");
+  for (size_t i = 0; i < 100; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 100; i < 200; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 200; i < 300; ++i)
+    points.col(i) = g3.Random();
+
+  DBSCAN<> d(2.0, 3);
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  // Use batch sizes that do and do not divide the number of points.
+  const size_t batchSizes[] = { 1, 32, 100, 1000 };
+  for (const size_t batchSize : batchSizes)
+  {
+    DBSCAN<> d2(2.0, 3);
+    d2.BatchSize() = batchSize;
+
+    arma::Row<size_t> batchAssignments;
+    REQUIRE(d2.Cluster(points, batchAssignments) == clusters);
+    CheckSameClusters(assignments, batchAssignments, clusters);
+  }
+}
+
+/**
+ * Make sure that the grid-based algorithm finds the same clusters as range
+ * search on the Gaussian clusters and outliers.
+ */
+TEST_CASE("GridGaussiansTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 303);
+
+  GaussianDistribution g1(3), g2(3), g3(3);
+  g1.Mean() = arma::vec("0.0 0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0 8.0");
+  g3.Mean() = arma::vec("-6.0 1.0 -7.0");
+  for (size_t i = 0; i < 100; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 100; i < 200; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 200; i < 300; ++i)
+    points.col(i) = g3.Random();
+
+  // Add 3 outliers.
+  points.col(300) = arma::vec("20.0 20.0 20.0");
+  points.col(301) = arma::vec("-100.0 0.0 3.0");
+  points.col(302) = arma::vec("0.0 -30.0 0.0");
+
+  DBSCAN<> d(2.0, 3);
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+  REQUIRE(clusters == 3);
+
+  DBSCAN<> gridDbscan(2.0, 3);
+  gridDbscan.GridMode() = true;
+  arma::Row<size_t> gridAssignments;
+  REQUIRE(gridDbscan.Cluster(points, gridAssignments) == 3);
+
+  CheckSameClusters(assignments, gridAssignments, clusters);
+  REQUIRE(gridAssignments[300] == SIZE_MAX);
+  REQUIRE(gridAssignments[301] == SIZE_MAX);
+  REQUIRE(gridAssignments[302] == SIZE_MAX);
+}
+
+/**
+ * Make sure that the grid-based algorithm finds the same core points and noise
+ * points as range search on uniform data, where many cells are involved.
+ */
+TEST_CASE("GridUniformTest", "[DBSCANTest]")
+{
+  arma::mat points(2, 3000, arma::fill::randu);
+
+  DBSCAN<> d(0.02, 5);
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  DBSCAN<> gridDbscan(0.02, 5);
+  gridDbscan.GridMode() = true;
+  arma::Row<size_t> gridAssignments;
+  REQUIRE(gridDbscan.Cluster(points, gridAssignments) == clusters);
+
+  // Border points may be assigned to any of the clusters they are close to, so
+  // only compare the noise points and the clusters of the core points.
+  RangeSearch<> rs(points);
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  rs.Search(Range(0.0, 0.02), neighbors, distances);
+
+  arma::Row<size_t> labelMap(clusters);
+  labelMap.fill(SIZE_MAX);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE((assignments[i] == SIZE_MAX) == (gridAssignments[i] == SIZE_MAX));
+
+    // The point itself is not returned by the range search.
+    if (neighbors[i].size() + 1 < 5)
+      continue;
+
+    if (labelMap[assignments[i]] == SIZE_MAX)
+      labelMap[assignments[i]] = gridAssignments[i];
+    REQUIRE(labelMap[assignments[i]] == gridAssignments[i]);
+  }
+}
+
+/**
+ * Check that noise points do not connect clusters with the grid-based algorithm
+ * or when searching in batches.
+ */
+TEST_CASE("GridNoiseConnectionTest", "[DBSCANTest]")
+{
+  arma::mat dataset({
+      // cluster 1           cluster 2            noise
+      { 0.0, 0.5,  0.5, 1.0, 3.0, 3.5,  3.5, 4.0, 2.0 },
+      { 0.0, 0.5, -0.5, 0.0, 0.0, 0.5, -0.5, 0.0, 0.0 }});
+
+  DBSCAN<> dbscan(1.1, 4);
+  dbscan.GridMode() = true;
+
+  arma::Row<size_t> labels;
+  REQUIRE(dbscan.Cluster(dataset, labels) == 2);
+
+  dbscan.GridMode() = false;
+  dbscan.BatchSize() = 2;
+  REQUIRE(dbscan.Cluster(dataset, labels) == 2);
+}
@@ -315,6 +315,55 @@ TEST_CASE("BestBinaryNumericSplitSimpleSplitTest_",
   REQUIRE(splitInfo[0] < 0.5);
 }
 
+/**
+ * Check that the HistogramNumericSplit finds the perfect split, both with a
+ * fitness function that has the optimized binary split forms (MSEGain) and
+ * with one that doesn't (MADGain).
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest_",
+    "[DecisionTreeRegressorTest]")
+{
+  arma::rowvec predictors =
+      { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 };
+  arma::rowvec responses =
+      { 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+  arma::rowvec weights(responses.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<MSEGain>::AuxiliarySplitInfo aux;
+  MSEGain f;
+  const double bestGain = f.Evaluate<false>(responses, weights);
+  const double gain = HistogramNumericSplit<MSEGain>::SplitIfBetter<false>(
+      bestGain, predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+  const double weightedGain =
+      HistogramNumericSplit<MSEGain>::SplitIfBetter<true>(bestGain,
+      predictors, responses, weights, 3, 1e-7, splitInfo, aux, f);
+
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == Approx(weightedGain).margin(1e-7));
+  REQUIRE(splitInfo.n_elem == 1);
+  REQUIRE(splitInfo[0] > 0.4);
+  REQUIRE(splitInfo[0] < 0.5);
+
+  arma::vec madSplitInfo;
+  HistogramNumericSplit<MADGain>::AuxiliarySplitInfo madAux;
+  MADGain g;
+  const double madBestGain = g.Evaluate<false>(responses, weights);
+  const double madGain = HistogramNumericSplit<MADGain>::SplitIfBetter<false>(
+      madBestGain, predictors, responses, weights, 3, 1e-7, madSplitInfo,
+      madAux, g);
+  const double madWeightedGain =
+      HistogramNumericSplit<MADGain>::SplitIfBetter<true>(madBestGain,
+      predictors, responses, weights, 3, 1e-7, madSplitInfo, madAux, g);
+
+  REQUIRE(madGain > madBestGain);
+  REQUIRE(madGain == madWeightedGain);
+  REQUIRE(madSplitInfo.n_elem == 1);
+  REQUIRE(madSplitInfo[0] > 0.4);
+  REQUIRE(madSplitInfo[0] < 0.5);
+}
+
 /**
  * Check that the BestBinaryNumericSplit won't split if not enough points are
  * given.
@@ -992,6 +1041,35 @@ TEST_CASE("NumericalBuildTest", "[DecisionTreeRegressorTest]")
   REQUIRE(rmse < 1.0);
 }
 
+/**
+ * Test that the tree builds correctly on a numerical dataset when the splits
+ * are found with histograms.
+ */
+TEST_CASE("HistogramNumericalBuildTest", "[DecisionTreeRegressorTest]")
+{
+  arma::mat X;
+  arma::rowvec Y;
+
+  if (!data::Load("lars_dependent_x.csv", X))
+    FAIL("Cannot load dataset lars_dependent_x.csv");
+  if (!data::Load("lars_dependent_y.csv", Y))
+    FAIL("Cannot load dataset lars_dependent_y.csv");
+
+  arma::mat XTrain, XTest;
+  arma::rowvec YTrain, YTest;
+  data::Split(X, Y, XTrain, XTest, YTrain, YTest, 0.3);
+
+  DecisionTreeRegressor<MSEGain, HistogramNumericSplit> tree(XTrain, YTrain,
+      5);
+
+  arma::rowvec predictions;
+  tree.Predict(XTest, predictions);
+
+  // Ensuring a decent performance.
+  const double rmse = RMSE(predictions, YTest);
+  REQUIRE(rmse < 1.0);
+}
+
 /**
  * Test that the tree builds correctly on weighted numerical dataset.
  */
@@ -369,6 +369,69 @@ TEST_CASE("BestBinaryNumericSplitNoGainTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities.n_elem == 0);
 }
 
+/**
+ * Check that the HistogramNumericSplit finds a perfect split between bins.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, splitInfo, aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, splitInfo, aux);
+
+  // Make sure that a split was made; it is perfect, so the gain should be 0.
+  REQUIRE(gain > bestGain);
+  REQUIRE(gain == weightedGain);
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  REQUIRE(splitInfo.n_elem == 1);
+  REQUIRE(splitInfo[0] > 0.4);
+  REQUIRE(splitInfo[0] < 0.5);
+
+  // Points that all have the same value can't be split.
+  arma::vec sameValues(11, arma::fill::ones);
+  arma::vec noSplitInfo;
+  REQUIRE(HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      sameValues, labels, 2, weights, 3, 1e-7, noSplitInfo, aux) == DBL_MAX);
+  REQUIRE(noSplitInfo.n_elem == 0);
+}
+
+/**
+ * Check that the HistogramNumericSplit finds a good split when there are many
+ * more points than bins.
+ */
+TEST_CASE("HistogramNumericSplitManyPointsTest", "[DecisionTreeTest]")
+{
+  arma::vec values = arma::randu<arma::vec>(10000);
+  arma::Row<size_t> labels(values.n_elem);
+  for (size_t i = 0; i < values.n_elem; ++i)
+    labels[i] = (values[i] > 0.3) ? 1 : 0;
+  arma::rowvec weights;
+
+  arma::vec splitInfo;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 10, 1e-7, splitInfo, aux);
+
+  // The split must be at the bin boundary closest to 0.3.
+  REQUIRE(gain > bestGain);
+  REQUIRE(splitInfo.n_elem == 1);
+  REQUIRE(splitInfo[0] == Approx(0.3).margin(1.0 / 256));
+}
+
 /**
  * Check that the RandomBinaryNumericSplit won't split if not enough points are
  * given.
@@ -1258,6 +1321,44 @@ TEST_CASE("SimpleGeneralizationTest", "[DecisionTreeTest]")
   REQUIRE(wdcorrect > 0.75);
 }
 
+/**
+ * Test that the decision tree generalizes reasonably when the numeric splits
+ * are found with histograms.
+ */
+TEST_CASE("HistogramSplitGeneralizationTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  REQUIRE(correct > 0.75);
+}
+
 /**
  * Test that the decision tree generalizes reasonably when built on float data.
  */
@@ -1858,3 +1959,78 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Make sure that a tree large enough to be built in parallel is the same each
+ * time it is built, and is the same with and without a DatasetInfo.
+ */
+TEST_CASE("ParallelDecisionTreeBuildTest", "[DecisionTreeTest]")
+{
+  // Three Gaussians in four dimensions, with enough points that the split
+  // search of the top nodes is done in parallel.
+  const size_t points = 3 * DecisionTree<>::ParallelTrainMinSize;
+  arma::mat dataset(4, points, arma::fill::randn);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % 3;
+    dataset.col(i) += 3.0 * labels[i];
+  }
+
+  data::DatasetInfo info(4);
+
+  DecisionTree<> d1(dataset, labels, 3, 10, 1e-7, 8);
+  DecisionTree<> d2(dataset, labels, 3, 10, 1e-7, 8);
+  DecisionTree<> d3(dataset, info, labels, 3, 10, 1e-7, 8);
+
+  arma::Row<size_t> predictions1, predictions2, predictions3;
+  d1.Classify(dataset, predictions1);
+  d2.Classify(dataset, predictions2);
+  d3.Classify(dataset, predictions3);
+
+  REQUIRE(arma::accu(predictions1 != predictions2) == 0);
+  REQUIRE(arma::accu(predictions1 != predictions3) == 0);
+
+  // The Gaussians are well separated, so the tree should be accurate.
+  const size_t correct = arma::accu(predictions1 == labels);
+  REQUIRE(double(correct) / double(points) > 0.95);
+}
+
+/**
+ * Make sure that a decision tree trained on sparse data is the same as one
+ * trained on the same data in dense form.
+ */
+TEST_CASE("SparseDecisionTreeTest", "[DecisionTreeTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 3000, 0.05);
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    if (dataset(3, i) > 0.5)
+      labels[i] = 1;
+    else if (dataset(7, i) > 0.0)
+      labels[i] = 2;
+    else
+      labels[i] = 0;
+  }
+
+  const arma::mat denseDataset(dataset);
+
+  DecisionTree<> sparseTree(dataset, labels, 3, 5);
+  DecisionTree<> denseTree(denseDataset, labels, 3, 5);
+
+  REQUIRE(sparseTree.NumChildren() == denseTree.NumChildren());
+  REQUIRE(sparseTree.SplitDimension() == denseTree.SplitDimension());
+
+  arma::Row<size_t> sparsePredictions, densePredictions;
+  arma::mat sparseProbabilities, denseProbabilities;
+  sparseTree.Classify(dataset, sparsePredictions, sparseProbabilities);
+  denseTree.Classify(denseDataset, densePredictions, denseProbabilities);
+
+  REQUIRE(arma::accu(sparsePredictions != densePredictions) == 0);
+  CheckMatrices(sparseProbabilities, denseProbabilities);
+
+  // The labels only depend on two features, so the tree should be accurate.
+  REQUIRE(arma::accu(sparsePredictions == labels) > 2900);
+}
@@ -814,3 +814,93 @@ TEST_CASE("MoveOperatorTest", "[DETTest]")
   REQUIRE(testDTree2.Right()->SplitDim() == 1);
   REQUIRE(testDTree2.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
 }
+
+// Recursively check that two trees have the same structure and splits.
+template<typename MatType>
+void CheckSameDTree(const DTree<MatType>& a, const DTree<MatType>& b)
+{
+  REQUIRE(a.Start() == b.Start());
+  REQUIRE(a.End() == b.End());
+  REQUIRE(a.SubtreeLeaves() == b.SubtreeLeaves());
+  REQUIRE((a.Left() == NULL) == (b.Left() == NULL));
+  if (a.Left() != NULL)
+  {
+    REQUIRE(a.SplitDim() == b.SplitDim());
+    REQUIRE(a.SplitValue() == b.SplitValue());
+    CheckSameDTree(*a.Left(), *b.Left());
+    CheckSameDTree(*a.Right(), *b.Right());
+  }
+}
+
+/**
+ * Make sure that growing a tree on presorted values (which is done when
+ * oldFromNew holds a permutation of the points) gives the same tree as
+ * sorting the points of each node, on a dataset large enough for the subtrees
+ * to be grown in parallel.
+ */
+TEST_CASE("DTreePresortedGrowTest", "[DETTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(3, 25000);
+  // Add some duplicate values.
+  data.row(2) = arma::round(4 * data.row(2));
+
+  arma::mat presortedData(data);
+  arma::Col<size_t> oldFromNew =
+      arma::linspace<arma::Col<size_t>>(0, data.n_cols - 1, data.n_cols);
+  DTree<arma::mat> presortedTree(presortedData);
+  const double presortedAlpha = presortedTree.Grow(presortedData, oldFromNew,
+      false, 50, 10);
+
+  // oldFromNew is not a permutation here, so the values are not presorted.
+  arma::mat sortedData(data);
+  arma::Col<size_t> noPermutation(data.n_cols, arma::fill::zeros);
+  DTree<arma::mat> sortedTree(sortedData);
+  const double sortedAlpha = sortedTree.Grow(sortedData, noPermutation, false,
+      50, 10);
+
+  REQUIRE(presortedAlpha == sortedAlpha);
+  REQUIRE(presortedTree.SubtreeLeaves() > 100);
+  CheckSameDTree(presortedTree, sortedTree);
+
+  // The points must have been moved along with their indices.
+  REQUIRE(arma::approx_equal(presortedData, sortedData, "absdiff", 0.0));
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(arma::approx_equal(presortedData.col(i), data.col(oldFromNew[i]),
+        "absdiff", 0.0));
+}
+
+/**
+ * Make sure that the grid of a DTree gives the same densities as the tree.
+ */
+TEST_CASE("DTreeComputeGridTest", "[DETTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(2, 2000);
+  arma::mat trainData(data);
+  arma::Col<size_t> oldFromNew =
+      arma::linspace<arma::Col<size_t>>(0, data.n_cols - 1, data.n_cols);
+  DTree<arma::mat> tree(trainData);
+  tree.Grow(trainData, oldFromNew, false, 20, 5);
+  REQUIRE(tree.SubtreeLeaves() > 10);
+
+  DensityGrid grid;
+  tree.ComputeGrid(grid);
+  REQUIRE(grid.Dimensionality() == 2);
+  REQUIRE(!grid.Interpolate());
+  REQUIRE(grid.MaxError() == 0.0);
+
+  // The training points include the bounds of the tree, and lie on the
+  // boundaries of the leaves; points outside of the tree have density 0.
+  arma::mat queries = arma::join_rows(data, 2 * arma::randn<arma::mat>(2,
+      2000));
+  arma::vec densities;
+  grid.Evaluate(queries, densities);
+  REQUIRE(densities.n_elem == queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    const double value = tree.ComputeValue(queries.col(i));
+    REQUIRE(densities[i] == Approx(value).epsilon(1e-12).margin(1e-15));
+    REQUIRE(grid.Evaluate(queries.col(i)) == densities[i]);
+  }
+
+  REQUIRE_THROWS_AS(tree.ComputeGrid(grid, 10), std::invalid_argument);
+}
@@ -102,6 +102,40 @@ TEST_CASE("LMetricZerosTest", "[DistanceTest]")
   REQUIRE(LMetric<5, true>::Evaluate(a, a) == 0);
 }
 
+/**
+ * Make sure that LMetric gives the same results for low-dimensional vectors,
+ * which are not evaluated with Armadillo expressions, as the definitions.
+ */
+TEST_CASE("LMetricLowDimensionalTest", "[DistanceTest]")
+{
+  for (size_t dim = 1; dim <= 5; ++dim)
+  {
+    arma::mat points(dim, 2, arma::fill::randn);
+    const arma::vec a = points.col(0);
+    const arma::rowvec b = points.col(1).t();
+    const arma::vec diff = arma::abs(points.col(0) - points.col(1));
+
+    REQUIRE(ManhattanDistance::Evaluate(a, points.col(1)) ==
+        Approx(arma::accu(diff)).epsilon(1e-10));
+    REQUIRE(SquaredEuclideanDistance::Evaluate(a, points.col(1)) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-10));
+    REQUIRE(EuclideanDistance::Evaluate(points.col(0), points.col(1)) ==
+        Approx(std::sqrt(arma::accu(arma::square(diff)))).epsilon(1e-10));
+    REQUIRE(ChebyshevDistance::Evaluate(a, points.col(1)) ==
+        Approx(diff.max()).epsilon(1e-10));
+    REQUIRE(EuclideanDistance::Evaluate(b, b) == 0.0);
+
+    // Sparse and unsigned vectors work too.
+    const arma::sp_vec sa(a), sb(arma::vec(points.col(1)));
+    REQUIRE(SquaredEuclideanDistance::Evaluate(sa, sb) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-10));
+
+    const arma::uvec ua = arma::regspace<arma::uvec>(0, dim - 1);
+    const arma::uvec ub = 2 * ua;
+    REQUIRE(ManhattanDistance::Evaluate(ua, ub) == arma::accu(ua));
+  }
+}
+
 /**
  * Simple test of Mahalanobis distance with unset covariance matrix in
  * constructor.
@@ -343,3 +377,56 @@ TEST_CASE("MahalanobisDistanceSerializationTest", "[DistanceTest]")
   // Check the covariance matrices.
   CheckMatrices(d.Q(), xmlD.Q(), jsonD.Q(), binaryD.Q());
 }
+
+/**
+ * Make sure the self-kernels cached by IPMetric give the same distances as
+ * the uncached metric, and are only used for columns of the cached dataset.
+ */
+TEST_CASE("IPMetricSelfKernelCacheTest", "[DistanceTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 50);
+  PolynomialKernel pk(2.0, 1.0);
+  IPMetric<PolynomialKernel> uncached(pk);
+  IPMetric<PolynomialKernel> cached(pk);
+
+  cached.CacheSelfKernels(dataset);
+  REQUIRE(cached.SelfKernelsCached(dataset));
+  REQUIRE(cached.SelfKernels().n_elem == dataset.n_cols);
+  REQUIRE(!uncached.SelfKernelsCached(dataset));
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(cached.SelfKernels()[i] ==
+        Approx(pk.Evaluate(dataset.col(i), dataset.col(i))).epsilon(1e-12));
+
+    for (size_t j = 0; j < dataset.n_cols; j += 7)
+    {
+      const double d = uncached.Evaluate(dataset.col(i), dataset.col(j));
+      REQUIRE(cached.Evaluate(dataset.col(i), dataset.col(j)) ==
+          Approx(d).epsilon(1e-12));
+      REQUIRE(cached.Evaluate(dataset.unsafe_col(i), dataset.unsafe_col(j)) ==
+          Approx(d).epsilon(1e-12));
+    }
+  }
+
+  // A vector outside the dataset must not use the cache.
+  arma::vec point = dataset.col(3) + 1.0;
+  REQUIRE(cached.SelfKernel(point) ==
+      Approx(pk.Evaluate(point, point)).epsilon(1e-12));
+  REQUIRE(cached.Evaluate(point, dataset.col(5)) ==
+      Approx(uncached.Evaluate(point, dataset.col(5))).epsilon(1e-12));
+
+  // Copies do not keep the cache.
+  IPMetric<PolynomialKernel> copy(cached);
+  REQUIRE(!copy.SelfKernelsCached(dataset));
+
+  cached.ClearSelfKernels();
+  REQUIRE(!cached.SelfKernelsCached(dataset));
+  REQUIRE(cached.SelfKernels().n_elem == 0);
+
+  // Sparse matrices are not cached.
+  arma::sp_mat sparse;
+  sparse.sprandu(4, 50, 0.3);
+  cached.CacheSelfKernels(sparse);
+  REQUIRE(!cached.SelfKernelsCached(sparse));
+}
@@ -447,6 +447,34 @@ TEST_CASE("GaussianMultipointMultivariateProbabilityTest", "[DistributionTest]")
   REQUIRE(phis(5) == Approx(-14.900192463287908).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the log-probabilities of a batch of points are the same as the
+ * log-probabilities of each point, in higher dimensions.
+ */
+TEST_CASE("GaussianBatchLogProbabilityTest", "[DistributionTest]")
+{
+  arma::mat a = arma::randu<arma::mat>(20, 20);
+  arma::mat cov = a * a.t() + 0.5 * arma::eye<arma::mat>(20, 20);
+  GaussianDistribution g(arma::randu<arma::vec>(20), cov);
+  DiagonalGaussianDistribution d(arma::randu<arma::vec>(20),
+      arma::randu<arma::vec>(20) + 0.5);
+
+  arma::mat points = arma::randn<arma::mat>(20, 1000);
+  arma::vec phis, diagPhis;
+  g.LogProbability(points, phis);
+  d.LogProbability(points, diagPhis);
+
+  REQUIRE(phis.n_elem == 1000);
+  REQUIRE(diagPhis.n_elem == 1000);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    REQUIRE(phis[i] ==
+        Approx(g.LogProbability(points.col(i))).epsilon(1e-7));
+    REQUIRE(diagPhis[i] ==
+        Approx(d.LogProbability(points.col(i))).epsilon(1e-7));
+  }
+}
+
 /**
  * Make sure random observations follow the probability distribution correctly.
  */
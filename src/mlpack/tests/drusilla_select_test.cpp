@@ -162,3 +162,30 @@ TEST_CASE("SparseTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_cols == 1000);
   REQUIRE(distances.n_rows == 3);
 }
+
+// Make sure that the distances returned by a search on sparse data are the
+// distances to the returned neighbors, in decreasing order.
+TEST_CASE("DrusillaSelectSparseDistancesTest", "[DrusillaSelectTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(20, 500, 0.3);
+
+  DrusillaSelect<arma::sp_mat> ds(dataset, 5, 10);
+
+  arma::mat distances;
+  arma::Mat<size_t> neighbors;
+  ds.Search(dataset, 4, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) < dataset.n_cols);
+      const double dist = EuclideanDistance::Evaluate(dataset.col(i),
+          dataset.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(dist).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j, i) <= distances(j - 1, i));
+    }
+  }
+}
@@ -0,0 +1,190 @@
+/**
+ * @file tests/elastic_net_test.cpp
+ *
+ * Tests for the ElasticNet class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/elastic_net.hpp>
+#include <mlpack/methods/lars.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+// Generate a noisy linear problem with an offset.
+void GenerateElasticNetProblem(arma::mat& X,
+                               arma::rowvec& y,
+                               const size_t nPoints,
+                               const size_t nDims)
+{
+  X = arma::randn<arma::mat>(nDims, nPoints);
+  const arma::vec beta = arma::randn<arma::vec>(nDims);
+  y = beta.t() * X + 3.0 + 0.1 * arma::randn<arma::rowvec>(nPoints);
+}
+
+// Check the optimality conditions of the elastic net problem for the given
+// model.
+void CheckElasticNetOptimality(const ElasticNet<>& en,
+                               const arma::mat& X,
+                               const arma::rowvec& y,
+                               const double lambda1,
+                               const double lambda2)
+{
+  const arma::rowvec residual = y - en.Beta().t() * X - en.Intercept();
+  REQUIRE(arma::accu(residual) == Approx(0.0).margin(1e-6));
+
+  const arma::vec gradient = X * residual.t() - lambda2 * en.Beta();
+  for (size_t j = 0; j < en.Beta().n_elem; ++j)
+  {
+    if (en.Beta()[j] == 0)
+      REQUIRE(std::abs(gradient[j]) <= lambda1 + 1e-3);
+    else if (en.Beta()[j] > 0)
+      REQUIRE(gradient[j] == Approx(lambda1).margin(1e-3));
+    else
+      REQUIRE(gradient[j] == Approx(-lambda1).margin(1e-3));
+  }
+}
+
+/**
+ * Make sure that the elastic net solutions satisfy the optimality conditions,
+ * and match the solutions of LARS.
+ */
+TEST_CASE("ElasticNetLARSTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateElasticNetProblem(X, y, 200, 20);
+
+  for (double lambda1 = 0.0; lambda1 < 50.0; lambda1 += 10.0)
+  {
+    for (double lambda2 = 0.0; lambda2 < 1.0; lambda2 += 0.5)
+    {
+      ElasticNet<> en(X, y, lambda1, lambda2, true, 1e-14);
+      CheckElasticNetOptimality(en, X, y, lambda1, lambda2);
+
+      LARS<> lars(false, lambda1, lambda2, 1e-16, true, false);
+      lars.Train(X, y);
+
+      REQUIRE(en.Intercept() == Approx(lars.Intercept()).epsilon(1e-5));
+      for (size_t j = 0; j < X.n_rows; ++j)
+        REQUIRE(en.Beta()[j] == Approx(lars.Beta()[j]).margin(1e-5));
+    }
+  }
+}
+
+/**
+ * Make sure that a regularization path gives the same models as separate
+ * training, and that it starts with an empty model at MaxLambda1().
+ */
+TEST_CASE("ElasticNetPathTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateElasticNetProblem(X, y, 300, 50);
+
+  ElasticNet<> en(0.0, 0.1, true, 1e-14);
+  const double lambdaMax = en.MaxLambda1(X, y);
+  const arma::vec lambdas = lambdaMax * arma::logspace<arma::vec>(0, -3, 20);
+
+  arma::mat betaPath;
+  arma::rowvec interceptPath;
+  en.TrainPath(X, y, lambdas, betaPath, interceptPath);
+
+  REQUIRE(betaPath.n_rows == X.n_rows);
+  REQUIRE(betaPath.n_cols == lambdas.n_elem);
+  REQUIRE(interceptPath.n_elem == lambdas.n_elem);
+  REQUIRE(arma::abs(betaPath.col(0)).max() < 1e-10);
+  REQUIRE(interceptPath[0] == Approx(arma::mean(y)).epsilon(1e-8));
+  REQUIRE(en.Lambda1() == Approx(lambdas[lambdas.n_elem - 1]));
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    ElasticNet<> single(X, y, lambdas[i], 0.1, true, 1e-14);
+    REQUIRE(interceptPath[i] ==
+        Approx(single.Intercept()).epsilon(1e-5).margin(1e-8));
+    for (size_t j = 0; j < X.n_rows; ++j)
+      REQUIRE(betaPath(j, i) == Approx(single.Beta()[j]).margin(1e-5));
+  }
+
+  // The model holds the last model of the path.
+  REQUIRE(arma::approx_equal(en.Beta(), betaPath.col(lambdas.n_elem - 1),
+      "absdiff", 1e-12));
+}
+
+/**
+ * Make sure that warm starts converge to the same model.
+ */
+TEST_CASE("ElasticNetWarmStartTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateElasticNetProblem(X, y, 200, 30);
+
+  ElasticNet<> en(X, y, 5.0, 0.2, true, 1e-14);
+  ElasticNet<> cold(X, y, 1.0, 0.2, true, 1e-14);
+
+  en.WarmStart() = true;
+  en.Train(X, y, 1.0);
+  REQUIRE(en.Intercept() == Approx(cold.Intercept()).epsilon(1e-5));
+  for (size_t j = 0; j < X.n_rows; ++j)
+    REQUIRE(en.Beta()[j] == Approx(cold.Beta()[j]).margin(1e-5));
+  CheckElasticNetOptimality(en, X, y, 1.0, 0.2);
+}
+
+/**
+ * Make sure the model can be used with KFoldCV and HyperParameterTuner.
+ */
+TEST_CASE("ElasticNetHPTTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateElasticNetProblem(X, y, 500, 10);
+
+  KFoldCV<ElasticNet<>, MSE> cv(5, X, y);
+  const double smallPenaltyMSE = cv.Evaluate(0.01, 0.0);
+  const double largePenaltyMSE = cv.Evaluate(1000.0, 0.0);
+  REQUIRE(smallPenaltyMSE < 0.05);
+  REQUIRE(smallPenaltyMSE < largePenaltyMSE);
+
+  arma::vec lambda1s("0.01 100.0 1000.0");
+  arma::vec lambda2s("0.0 100.0");
+  HyperParameterTuner<ElasticNet<>, MSE, KFoldCV> hpt(5, X, y);
+  double lambda1, lambda2;
+  std::tie(lambda1, lambda2) = hpt.Optimize(lambda1s, lambda2s);
+
+  REQUIRE(lambda1 == Approx(0.01));
+  REQUIRE(lambda2 == Approx(0.0).margin(1e-10));
+}
+
+/**
+ * Make sure that serialization works.
+ */
+TEST_CASE("ElasticNetSerializationTest", "[ElasticNetTest]")
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateElasticNetProblem(X, y, 100, 10);
+
+  ElasticNet<> en(X, y, 1.0, 0.5);
+  ElasticNet<> xmlEn, jsonEn, binaryEn;
+  SerializeObjectAll(en, xmlEn, jsonEn, binaryEn);
+
+  arma::rowvec predictions, xmlPredictions, jsonPredictions, binaryPredictions;
+  en.Predict(X, predictions);
+  xmlEn.Predict(X, xmlPredictions);
+  jsonEn.Predict(X, jsonPredictions);
+  binaryEn.Predict(X, binaryPredictions);
+
+  CheckMatrices(predictions, xmlPredictions);
+  CheckMatrices(predictions, jsonPredictions);
+  CheckMatrices(predictions, binaryPredictions);
+  REQUIRE(xmlEn.Lambda1() == Approx(1.0));
+  REQUIRE(xmlEn.Lambda2() == Approx(0.5));
+}
@@ -269,3 +269,40 @@ TEST_CASE("EMSTBallTreeTest", "[EMSTTest]")
     REQUIRE(bstResults(2, i) == Approx(ballResults(2, i)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure the parallel dual-tree traversal gives the same MST as the regular
+ * traversal, on a dataset large enough that tasks are created.
+ */
+TEST_CASE("EMSTParallelTest", "[EMSTTest]")
+{
+  arma::mat inputData = arma::randu<arma::mat>(3, 20000);
+
+  DualTreeBoruvka<> dtb(inputData);
+  ParallelDualTreeBoruvka<> parallelDtb(inputData);
+
+  arma::mat results;
+  arma::mat parallelResults;
+  dtb.ComputeMST(results);
+  parallelDtb.ComputeMST(parallelResults);
+
+  REQUIRE(parallelResults.n_cols == 19999);
+  REQUIRE(arma::accu(parallelResults.row(2)) ==
+      Approx(arma::accu(results.row(2))).epsilon(1e-7));
+
+  // The data is random, so no two edges have the same length, and the MST is
+  // unique.
+  for (size_t i = 0; i < results.n_cols; ++i)
+  {
+    REQUIRE(parallelResults(0, i) == results(0, i));
+    REQUIRE(parallelResults(1, i) == results(1, i));
+    REQUIRE(parallelResults(2, i) == Approx(results(2, i)).epsilon(1e-7));
+  }
+
+  // The parallel traversal must work with the ball tree too.
+  ParallelDualTreeBoruvka<EuclideanDistance, arma::mat, BallTree>
+      parallelBallDtb(inputData);
+  parallelBallDtb.ComputeMST(parallelResults);
+  REQUIRE(arma::accu(parallelResults.row(2)) ==
+      Approx(arma::accu(results.row(2))).epsilon(1e-7));
+}
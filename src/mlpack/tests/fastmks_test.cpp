@@ -1137,3 +1137,178 @@ TEST_CASE("CopyAssignmentTest", "[FastMKSTest]")
       REQUIRE(newKernels[i] == Approx(0.0).margin(1e-5));
   }
 }
+
+/**
+ * Make sure that the parallel dual-tree search returns the same results as
+ * naive search, both with a query set and with the reference set.
+ */
+TEST_CASE("ParallelFastMKSVsNaive", "[FastMKSTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(6, 3000);
+  arma::mat queries = arma::randn<arma::mat>(6, 2500);
+  LinearKernel lk;
+
+  FastMKS<LinearKernel> naive(data, lk, false, true);
+  ParallelFastMKS<LinearKernel> parallel(data, lk);
+
+  arma::Mat<size_t> naiveIndices, parallelIndices;
+  arma::mat naiveProducts, parallelProducts;
+  naive.Search(queries, 5, naiveIndices, naiveProducts);
+  parallel.Search(queries, 5, parallelIndices, parallelProducts);
+
+  REQUIRE(parallelIndices.n_cols == 2500);
+  for (size_t i = 0; i < parallelIndices.n_elem; ++i)
+  {
+    REQUIRE(parallelIndices[i] == naiveIndices[i]);
+    REQUIRE(parallelProducts[i] ==
+        Approx(naiveProducts[i]).epsilon(1e-7).margin(1e-10));
+  }
+
+  naive.Search(5, naiveIndices, naiveProducts);
+  parallel.Search(5, parallelIndices, parallelProducts);
+
+  REQUIRE(parallelIndices.n_cols == 3000);
+  for (size_t i = 0; i < parallelIndices.n_elem; ++i)
+  {
+    REQUIRE(parallelIndices[i] == naiveIndices[i]);
+    REQUIRE(parallelProducts[i] ==
+        Approx(naiveProducts[i]).epsilon(1e-7).margin(1e-10));
+  }
+}
+
+/**
+ * Make sure that naive search gives the right results when the number of
+ * points is not a multiple of the block sizes, both for the linear kernel
+ * (whose kernel values are computed with matrix products) and for other
+ * kernels.
+ */
+TEST_CASE("FastMKSNaiveBlockTest", "[FastMKSTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 1500);
+  arma::mat queries = arma::randu<arma::mat>(5, 130);
+
+  LinearKernel lk;
+  FastMKS<LinearKernel> naive(data, lk, false, true);
+  FastMKS<LinearKernel> single(data, lk, true);
+
+  arma::Mat<size_t> naiveIndices, singleIndices;
+  arma::mat naiveProducts, singleProducts;
+  naive.Search(queries, 7, naiveIndices, naiveProducts);
+  single.Search(queries, 7, singleIndices, singleProducts);
+
+  for (size_t i = 0; i < naiveIndices.n_elem; ++i)
+  {
+    REQUIRE(naiveIndices[i] == singleIndices[i]);
+    REQUIRE(naiveProducts[i] == Approx(singleProducts[i]).epsilon(1e-7));
+  }
+
+  // Points must not be returned as their own candidates.
+  naive.Search(7, naiveIndices, naiveProducts);
+  single.Search(7, singleIndices, singleProducts);
+
+  for (size_t i = 0; i < naiveIndices.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveIndices.n_rows; ++j)
+    {
+      REQUIRE(naiveIndices(j, i) != i);
+      REQUIRE(naiveIndices(j, i) == singleIndices(j, i));
+      REQUIRE(naiveProducts(j, i) ==
+          Approx(singleProducts(j, i)).epsilon(1e-7));
+    }
+  }
+
+  PolynomialKernel pk(2.0, 1.0);
+  FastMKS<PolynomialKernel> naivePoly(data, pk, false, true);
+  FastMKS<PolynomialKernel> treePoly(data, pk);
+
+  naivePoly.Search(queries, 7, naiveIndices, naiveProducts);
+  treePoly.Search(queries, 7, singleIndices, singleProducts);
+
+  for (size_t i = 0; i < naiveIndices.n_elem; ++i)
+  {
+    REQUIRE(naiveIndices[i] == singleIndices[i]);
+    REQUIRE(naiveProducts[i] == Approx(singleProducts[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure FastMKS works with single-precision data.
+ */
+TEST_CASE("FastMKSFloatTest", "[FastMKSTest]")
+{
+  arma::fmat data = arma::randu<arma::fmat>(5, 1000);
+  arma::fmat queries = arma::randu<arma::fmat>(5, 200);
+  LinearKernel lk;
+
+  FastMKS<LinearKernel, arma::fmat> naive(data, lk, false, true);
+  FastMKS<LinearKernel, arma::fmat> single(data, lk, true);
+  FastMKS<LinearKernel, arma::fmat> tree(data, lk);
+
+  arma::Mat<size_t> naiveIndices, singleIndices, treeIndices;
+  arma::mat naiveProducts, singleProducts, treeProducts;
+  naive.Search(queries, 5, naiveIndices, naiveProducts);
+  single.Search(queries, 5, singleIndices, singleProducts);
+  tree.Search(queries, 5, treeIndices, treeProducts);
+
+  // The kernel values must be right up to the precision of floats; because of
+  // rounding, points with nearly equal kernel values may come in a different
+  // order, so only the kernel values are compared.
+  for (size_t i = 0; i < naiveIndices.n_cols; ++i)
+  {
+    for (size_t j = 0; j < naiveIndices.n_rows; ++j)
+    {
+      const double trueKernel = arma::dot(
+          arma::conv_to<arma::vec>::from(queries.col(i)),
+          arma::conv_to<arma::vec>::from(data.col(naiveIndices(j, i))));
+      REQUIRE(naiveProducts(j, i) == Approx(trueKernel).epsilon(1e-4));
+      REQUIRE(singleProducts(j, i) ==
+          Approx(naiveProducts(j, i)).epsilon(1e-4));
+      REQUIRE(treeProducts(j, i) == Approx(naiveProducts(j, i)).epsilon(1e-4));
+    }
+  }
+}
+
+/**
+ * Make sure that the self-kernels that FastMKS caches when it is given a
+ * kernel, including when the tree takes the dataset, do not change the
+ * results.
+ */
+TEST_CASE("FastMKSCachedSelfKernelsTest", "[FastMKSTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(4, 500);
+  arma::mat querySet = arma::randu<arma::mat>(4, 100);
+  PolynomialKernel pk(3.0, 1.0);
+
+  FastMKS<PolynomialKernel> naive(referenceSet, pk, false, true);
+  FastMKS<PolynomialKernel> single(referenceSet, pk, true);
+  FastMKS<PolynomialKernel> dual;
+  arma::mat referenceCopy(referenceSet);
+  dual.Train(std::move(referenceCopy), pk);
+
+  arma::Mat<size_t> naiveIndices, singleIndices, dualIndices;
+  arma::mat naiveProducts, singleProducts, dualProducts;
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    // The first pass is bichromatic; the second is monochromatic.
+    if (pass == 0)
+    {
+      naive.Search(querySet, 5, naiveIndices, naiveProducts);
+      single.Search(querySet, 5, singleIndices, singleProducts);
+      dual.Search(querySet, 5, dualIndices, dualProducts);
+    }
+    else
+    {
+      naive.Search(5, naiveIndices, naiveProducts);
+      single.Search(5, singleIndices, singleProducts);
+      dual.Search(5, dualIndices, dualProducts);
+    }
+
+    for (size_t i = 0; i < naiveProducts.n_elem; ++i)
+    {
+      REQUIRE(singleIndices[i] == naiveIndices[i]);
+      REQUIRE(dualIndices[i] == naiveIndices[i]);
+      REQUIRE(singleProducts[i] == Approx(naiveProducts[i]).epsilon(1e-7));
+      REQUIRE(dualProducts[i] == Approx(naiveProducts[i]).epsilon(1e-7));
+    }
+  }
+}
@@ -244,6 +244,145 @@ TEST_CASE("GMMTrainEMMultipleGaussians", "[GMMTest]")
   REQUIRE(success == true);
 }
 
+/**
+ * Make sure that the blocked EM iterations give the same model as the
+ * iterations with probabilities, when every point has probability 1 and the
+ * dataset spans several blocks.
+ */
+TEST_CASE("EMFitBlockedMatchesProbabilityTest", "[GMMTest]")
+{
+  arma::mat data(3, 5000);
+  data.randn();
+  data.cols(2000, 3499).each_col() += arma::vec("5.0 5.0 -3.0");
+  data.cols(3500, 4999).each_col() += arma::vec("-4.0 3.0 100.0");
+  data.cols(3500, 4999) *= 0.5;
+
+  // Use the same initial model for both runs.
+  std::vector<GaussianDistribution> dists(3, GaussianDistribution(3));
+  dists[0].Mean() = data.col(0);
+  dists[1].Mean() = data.col(2000);
+  dists[2].Mean() = data.col(3500);
+  for (size_t i = 0; i < 3; ++i)
+    dists[i].Covariance(arma::eye<arma::mat>(3, 3));
+  arma::vec weights("0.3 0.3 0.4");
+
+  std::vector<GaussianDistribution> dists2(dists);
+  arma::vec weights2(weights);
+
+  EMFit<> em(10, 1e-10);
+  em.Estimate(data, dists, weights, true);
+  em.Estimate(data, arma::ones<arma::vec>(data.n_cols), dists2, weights2, true);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(weights[i] == Approx(weights2[i]).epsilon(1e-6));
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(dists[i].Mean()[j] == Approx(dists2[i].Mean()[j]).epsilon(1e-6));
+    for (size_t j = 0; j < 9; ++j)
+    {
+      REQUIRE(dists[i].Covariance()[j] ==
+          Approx(dists2[i].Covariance()[j]).epsilon(1e-6).margin(1e-8));
+    }
+  }
+
+  // The components must have found the three clusters.
+  REQUIRE(dists[2].Mean()[2] == Approx(50.0).epsilon(0.05));
+}
+
+/**
+ * Make sure that GMM::Update() with a step size of 1 is the same as one
+ * iteration of batch EM from the current model.
+ */
+TEST_CASE("GMMUpdateFullStepTest", "[GMMTest]")
+{
+  arma::mat data(2, 3000);
+  data.randn();
+  data.cols(1000, 2999).each_col() += arma::vec("6.0 -4.0");
+
+  GMM gmm(2, 2);
+  gmm.Component(0).Mean() = data.col(0);
+  gmm.Component(1).Mean() = data.col(1000);
+  gmm.Component(0).Covariance(arma::eye<arma::mat>(2, 2));
+  gmm.Component(1).Covariance(arma::eye<arma::mat>(2, 2));
+  gmm.Weights() = arma::vec("0.5 0.5");
+
+  GMM batch(gmm);
+  batch.Train(data, 1, true, EMFit<>(2, 1e-10));
+
+  gmm.Update(data, 1.0);
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    REQUIRE(gmm.Weights()[i] == Approx(batch.Weights()[i]).epsilon(1e-7));
+    for (size_t j = 0; j < 2; ++j)
+    {
+      REQUIRE(gmm.Component(i).Mean()[j] ==
+          Approx(batch.Component(i).Mean()[j]).epsilon(1e-7).margin(1e-10));
+    }
+    for (size_t j = 0; j < 4; ++j)
+    {
+      REQUIRE(gmm.Component(i).Covariance()[j] ==
+          Approx(batch.Component(i).Covariance()[j]).epsilon(1e-7)
+          .margin(1e-10));
+    }
+  }
+
+  // Invalid step sizes and dimensionalities must be reported.
+  REQUIRE_THROWS_AS(gmm.Update(data, 0.0), std::invalid_argument);
+  REQUIRE_THROWS_AS(gmm.Update(data, 1.5), std::invalid_argument);
+  arma::mat wrongData(3, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(gmm.Update(wrongData, 0.5), std::invalid_argument);
+}
+
+/**
+ * Train a GMM on a first batch of points, then update it with a stream of
+ * further batches, and make sure it recovers the true mixture.
+ */
+TEST_CASE("GMMUpdateStreamTest", "[GMMTest]")
+{
+  GaussianDistribution d1("0.0 0.0", "1.0 0.3; 0.3 1.0");
+  GaussianDistribution d2("8.0 3.0", "2.0 -0.5; -0.5 1.0");
+
+  // The first batch is small, so the initial model is not very accurate.
+  auto generate = [&](const size_t n)
+  {
+    arma::mat batch(2, n);
+    for (size_t i = 0; i < n; ++i)
+      batch.col(i) = (Random() < 0.3) ? d1.Random() : d2.Random();
+    return batch;
+  };
+
+  GMM gmm(2, 2);
+  gmm.Train(generate(200), 3);
+
+  size_t seen = 200;
+  for (size_t t = 0; t < 20; ++t)
+  {
+    arma::mat batch = generate(500);
+    seen += batch.n_cols;
+    gmm.Update(batch, (double) batch.n_cols / seen);
+  }
+
+  // Put the components in the order of d1 and d2.
+  const size_t first = (gmm.Component(0).Mean()[0] <
+      gmm.Component(1).Mean()[0]) ? 0 : 1;
+  const GaussianDistribution& c1 = gmm.Component(first);
+  const GaussianDistribution& c2 = gmm.Component(1 - first);
+
+  REQUIRE(gmm.Weights()[first] == Approx(0.3).margin(0.03));
+  REQUIRE(gmm.Weights()[1 - first] == Approx(0.7).margin(0.03));
+  for (size_t j = 0; j < 2; ++j)
+  {
+    REQUIRE(c1.Mean()[j] == Approx(d1.Mean()[j]).margin(0.1));
+    REQUIRE(c2.Mean()[j] == Approx(d2.Mean()[j]).margin(0.1));
+  }
+  for (size_t j = 0; j < 4; ++j)
+  {
+    REQUIRE(c1.Covariance()[j] == Approx(d1.Covariance()[j]).margin(0.15));
+    REQUIRE(c2.Covariance()[j] == Approx(d2.Covariance()[j]).margin(0.15));
+  }
+}
+
 /**
  * Train a single-gaussian mixture, but using the overload of Train() where
  * probabilities of the observation are given.
@@ -1230,3 +1369,49 @@ TEST_CASE("DiagonalGMMLoadSaveTest", "[GMMTest]")
     }
   }
 }
+
+/**
+ * Make sure that DiagonalGMM::Update() follows a stream of batches, and keeps
+ * the covariances diagonal.
+ */
+TEST_CASE("DiagonalGMMUpdateStreamTest", "[GMMTest]")
+{
+  DiagonalGaussianDistribution d1("0.0 1.0 0.0", "1.0 0.8 1.0");
+  DiagonalGaussianDistribution d2("6.0 -4.0 5.0", "3.0 1.2 1.3");
+
+  auto generate = [&](const size_t n)
+  {
+    arma::mat batch(3, n);
+    for (size_t i = 0; i < n; ++i)
+      batch.col(i) = (Random() < 0.4) ? d1.Random() : d2.Random();
+    return batch;
+  };
+
+  DiagonalGMM gmm(2, 3);
+  gmm.Train(generate(200), 3);
+
+  size_t seen = 200;
+  for (size_t t = 0; t < 20; ++t)
+  {
+    arma::mat batch = generate(500);
+    seen += batch.n_cols;
+    gmm.Update(batch, (double) batch.n_cols / seen);
+  }
+
+  const size_t first = (gmm.Component(0).Mean()[0] <
+      gmm.Component(1).Mean()[0]) ? 0 : 1;
+  const DiagonalGaussianDistribution& c1 = gmm.Component(first);
+  const DiagonalGaussianDistribution& c2 = gmm.Component(1 - first);
+
+  REQUIRE(gmm.Weights()[first] == Approx(0.4).margin(0.03));
+  REQUIRE(gmm.Weights()[1 - first] == Approx(0.6).margin(0.03));
+  for (size_t j = 0; j < 3; ++j)
+  {
+    REQUIRE(c1.Mean()[j] == Approx(d1.Mean()[j]).margin(0.1));
+    REQUIRE(c2.Mean()[j] == Approx(d2.Mean()[j]).margin(0.15));
+    REQUIRE(c1.Covariance()[j] == Approx(d1.Covariance()[j]).margin(0.15));
+    REQUIRE(c2.Covariance()[j] == Approx(d2.Covariance()[j]).margin(0.3));
+  }
+
+  REQUIRE_THROWS_AS(gmm.Update(generate(10), -0.1), std::invalid_argument);
+}
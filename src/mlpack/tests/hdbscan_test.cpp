@@ -0,0 +1,201 @@
+/**
+ * @file tests/hdbscan_test.cpp
+ *
+ * Test the HDBSCAN implementation and the mutual reachability minimum spanning
+ * tree of DualTreeBoruvka.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Make sure that the core distances match a brute-force computation.
+ */
+TEST_CASE("HDBSCANCoreDistancesTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 300, arma::fill::randu);
+
+  HDBSCAN<> h(5, 7);
+  arma::vec coreDistances;
+  h.CoreDistances(points, coreDistances);
+
+  REQUIRE(coreDistances.n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    arma::vec distances(points.n_cols);
+    for (size_t j = 0; j < points.n_cols; ++j)
+      distances[j] = EuclideanDistance::Evaluate(points.col(i), points.col(j));
+
+    // The point itself is the first of the seven points.
+    distances = arma::sort(distances);
+    REQUIRE(coreDistances[i] == Approx(distances[6]).epsilon(1e-7));
+  }
+}
+
+/**
+ * The dual-tree MST under the mutual reachability distance must have the same
+ * length as the naive one, and each edge must have its mutual reachability
+ * distance.
+ */
+TEST_CASE("DTBMutualReachabilityTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 500, arma::fill::randu);
+
+  HDBSCAN<> h(10);
+  arma::vec coreDistances;
+  h.CoreDistances(points, coreDistances);
+
+  DualTreeBoruvka<> dtb(points);
+  arma::mat results;
+  dtb.ComputeMST(results, coreDistances);
+
+  DualTreeBoruvka<> naive(points, true);
+  arma::mat naiveResults;
+  naive.ComputeMST(naiveResults, coreDistances);
+
+  REQUIRE(results.n_cols == points.n_cols - 1);
+  REQUIRE(arma::accu(results.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+
+  for (size_t i = 0; i < results.n_cols; ++i)
+  {
+    const size_t a = (size_t) results(0, i);
+    const size_t b = (size_t) results(1, i);
+    const double distance = std::max(EuclideanDistance::Evaluate(
+        points.col(a), points.col(b)), std::max(coreDistances[a],
+        coreDistances[b]));
+    REQUIRE(results(2, i) == Approx(distance).epsilon(1e-7));
+  }
+
+  // With zero core distances, the MST is the Euclidean MST.
+  DualTreeBoruvka<> emst(points);
+  arma::mat emstResults;
+  emst.ComputeMST(emstResults);
+
+  DualTreeBoruvka<> zeroCore(points);
+  arma::mat zeroCoreResults;
+  zeroCore.ComputeMST(zeroCoreResults, arma::zeros<arma::vec>(points.n_cols));
+
+  REQUIRE(arma::accu(zeroCoreResults.row(2)) ==
+      Approx(arma::accu(emstResults.row(2))).epsilon(1e-7));
+}
+
+/**
+ * Check the format of the single-linkage hierarchy.
+ */
+TEST_CASE("HDBSCANHierarchyTest", "[HDBSCANTest]")
+{
+  arma::mat points(3, 200, arma::fill::randu);
+
+  HDBSCAN<> h(5);
+  arma::Row<size_t> assignments;
+  arma::mat hierarchy;
+  h.Cluster(points, assignments, hierarchy);
+
+  REQUIRE(hierarchy.n_rows == 4);
+  REQUIRE(hierarchy.n_cols == points.n_cols - 1);
+  REQUIRE(hierarchy(3, hierarchy.n_cols - 1) == points.n_cols);
+
+  std::vector<size_t> sizes(2 * points.n_cols - 1, 1);
+  for (size_t i = 0; i < hierarchy.n_cols; ++i)
+  {
+    if (i > 0)
+      REQUIRE(hierarchy(2, i) >= hierarchy(2, i - 1));
+
+    // Each merge must use clusters that already exist.
+    REQUIRE(hierarchy(0, i) < points.n_cols + i);
+    REQUIRE(hierarchy(1, i) < points.n_cols + i);
+    sizes[points.n_cols + i] = sizes[(size_t) hierarchy(0, i)] +
+        sizes[(size_t) hierarchy(1, i)];
+    REQUIRE(hierarchy(3, i) == sizes[points.n_cols + i]);
+  }
+}
+
+/**
+ * Three well-separated blobs should be found as three clusters.
+ */
+TEST_CASE("HDBSCANThreeClustersTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 600);
+  arma::mat centers = { { 0.0, 20.0, -20.0 }, { 0.0, 20.0, 20.0 } };
+  for (size_t i = 0; i < points.n_cols; ++i)
+    points.col(i) = centers.col(i % 3) + arma::randn<arma::vec>(2);
+
+  HDBSCAN<> h(20);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 3);
+  REQUIRE(assignments.n_elem == points.n_cols);
+
+  // The points of each blob that are not noise must share a label, and the
+  // blobs must have different labels.
+  size_t labels[3] = { SIZE_MAX, SIZE_MAX, SIZE_MAX };
+  size_t noise = 0;
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (assignments[i] == SIZE_MAX)
+    {
+      ++noise;
+      continue;
+    }
+
+    REQUIRE(assignments[i] < clusters);
+    if (labels[i % 3] == SIZE_MAX)
+      labels[i % 3] = assignments[i];
+    REQUIRE(assignments[i] == labels[i % 3]);
+  }
+
+  REQUIRE(noise < 60);
+  REQUIRE(labels[0] != labels[1]);
+  REQUIRE(labels[0] != labels[2]);
+  REQUIRE(labels[1] != labels[2]);
+}
+
+/**
+ * When no split can leave two clusters of the minimum size, the whole dataset
+ * is noise, unless a single cluster is allowed.
+ */
+TEST_CASE("HDBSCANSingleClusterTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 100, arma::fill::randu);
+
+  HDBSCAN<> h(60, 5);
+  arma::Row<size_t> assignments;
+  size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 0);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+
+  h.AllowSingleCluster() = true;
+  clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 1);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == 0);
+}
+
+/**
+ * Invalid parameters should throw.
+ */
+TEST_CASE("HDBSCANInvalidParametersTest", "[HDBSCANTest]")
+{
+  arma::mat points(2, 10, arma::fill::randu);
+  arma::Row<size_t> assignments;
+
+  HDBSCAN<> h(1);
+  REQUIRE_THROWS_AS(h.Cluster(points, assignments), std::invalid_argument);
+
+  HDBSCAN<> h2(5, 20);
+  REQUIRE_THROWS_AS(h2.Cluster(points, assignments), std::invalid_argument);
+}
@@ -2105,3 +2105,123 @@ TEST_CASE("DiagonalGMMHMMLoadSaveTest", "[HMMTest]")
     }
   }
 }
+
+/**
+ * Make sure that the batch overloads of LogLikelihood(), Predict() and
+ * Estimate() give the same results as the single-sequence overloads.
+ */
+void CheckBatchMatchesSequential(const HMM<GaussianDistribution>& hmm,
+                                 const std::vector<arma::mat>& sequences)
+{
+  arma::vec logLikelihoods, viterbiLogLikelihoods, estimateLogLikelihoods;
+  std::vector<arma::Row<size_t>> stateSeqs;
+  std::vector<arma::mat> stateProbs;
+  hmm.LogLikelihood(sequences, logLikelihoods);
+  hmm.Predict(sequences, stateSeqs, viterbiLogLikelihoods);
+  hmm.Estimate(sequences, stateProbs, estimateLogLikelihoods);
+
+  REQUIRE(logLikelihoods.n_elem == sequences.size());
+  REQUIRE(stateSeqs.size() == sequences.size());
+  REQUIRE(stateProbs.size() == sequences.size());
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    const double logLikelihood = hmm.LogLikelihood(sequences[i]);
+    REQUIRE(logLikelihoods[i] == Approx(logLikelihood).epsilon(1e-8));
+    REQUIRE(estimateLogLikelihoods[i] == Approx(logLikelihood).epsilon(1e-8));
+
+    arma::Row<size_t> stateSeq;
+    const double viterbiLogLikelihood = hmm.Predict(sequences[i], stateSeq);
+    REQUIRE(viterbiLogLikelihoods[i] ==
+        Approx(viterbiLogLikelihood).epsilon(1e-8));
+    REQUIRE(arma::all(stateSeqs[i] == stateSeq));
+
+    arma::mat stateProb;
+    hmm.Estimate(sequences[i], stateProb);
+    REQUIRE(stateProbs[i].n_rows == stateProb.n_rows);
+    REQUIRE(stateProbs[i].n_cols == stateProb.n_cols);
+    for (size_t j = 0; j < stateProb.n_elem; ++j)
+      REQUIRE(stateProbs[i][j] == Approx(stateProb[j]).margin(1e-8));
+  }
+}
+
+/**
+ * Check the batch algorithms on many short sequences with a dense transition
+ * matrix.
+ */
+TEST_CASE("HMMBatchDenseTransitionTest", "[HMMTest]")
+{
+  HMM<GaussianDistribution> hmm(3, GaussianDistribution(2));
+  hmm.Initial() = arma::vec("0.5 0.3 0.2");
+  hmm.Transition() = arma::mat("0.4 0.6 0.8; 0.2 0.2 0.1; 0.4 0.2 0.1");
+  hmm.Emission()[0] = GaussianDistribution("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  hmm.Emission()[1] = GaussianDistribution("2.0 2.0", "1.0 0.5; 0.5 1.2");
+  hmm.Emission()[2] = GaussianDistribution("-2.0 1.0", "2.0 0.1; 0.1 1.0");
+
+  // Enough sequences that they are split into several blocks; include a
+  // sequence with a single observation.
+  std::vector<arma::mat> sequences(300);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate((i == 0) ? 1 : 1 + RandInt(20), sequences[i], states);
+  }
+
+  CheckBatchMatchesSequential(hmm, sequences);
+
+  // Sequences of the wrong dimensionality must be reported.
+  sequences[5] = arma::randu<arma::mat>(3, 4);
+  arma::vec logLikelihoods;
+  REQUIRE_THROWS_AS(hmm.LogLikelihood(sequences, logLikelihoods),
+      std::invalid_argument);
+}
+
+/**
+ * Check the batch algorithms with a left-to-right model, whose transition
+ * matrix is sparse.
+ */
+TEST_CASE("HMMBatchSparseTransitionTest", "[HMMTest]")
+{
+  const size_t states = 10;
+  HMM<GaussianDistribution> hmm(states, GaussianDistribution(1));
+  arma::vec initial(states, arma::fill::zeros);
+  initial[0] = 1.0;
+  arma::mat transition(states, states, arma::fill::zeros);
+  for (size_t i = 0; i < states; ++i)
+  {
+    if (i + 1 < states)
+    {
+      transition(i, i) = 0.8;
+      transition(i + 1, i) = 0.2;
+    }
+    else
+    {
+      transition(i, i) = 1.0;
+    }
+
+    hmm.Emission()[i] = GaussianDistribution(arma::vec({ (double) i }),
+        arma::mat("1.0"));
+  }
+  hmm.Initial() = initial;
+  hmm.Transition() = transition;
+
+  std::vector<arma::mat> sequences(100);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> stateSeq;
+    hmm.Generate(5 + RandInt(60), sequences[i], stateSeq);
+  }
+
+  CheckBatchMatchesSequential(hmm, sequences);
+
+  // The most probable paths must start in the first state and never use a
+  // transition with zero probability.
+  std::vector<arma::Row<size_t>> stateSeqs;
+  arma::vec logLikelihoods;
+  hmm.Predict(sequences, stateSeqs, logLikelihoods);
+  for (size_t i = 0; i < stateSeqs.size(); ++i)
+  {
+    REQUIRE(stateSeqs[i][0] == 0);
+    for (size_t t = 1; t < stateSeqs[i].n_elem; ++t)
+      REQUIRE(transition(stateSeqs[i][t], stateSeqs[i][t - 1]) > 0.0);
+  }
+}
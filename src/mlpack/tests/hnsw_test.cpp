@@ -0,0 +1,209 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Unit tests for the 'HNSWSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/hnsw.hpp>
+#include <mlpack/methods/lsh.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace mlpack;
+
+/**
+ * Make sure that the links of the graph respect the maximum number of links
+ * and the levels of the points.
+ */
+TEST_CASE("HNSWGraphStructureTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 1000);
+
+  HNSWSearch<> hnsw(referenceData, 8, 50);
+
+  REQUIRE(hnsw.ReferenceSet().n_cols == 1000);
+  REQUIRE(hnsw.MaxNeighbors() == 8);
+  REQUIRE(hnsw.Level(hnsw.EntryPoint()) == hnsw.MaxLevel());
+
+  size_t numLinks = 0;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    REQUIRE(hnsw.Level(i) <= hnsw.MaxLevel());
+    for (size_t l = 0; l <= hnsw.Level(i); ++l)
+    {
+      const std::vector<size_t>& links = hnsw.Links(i, l);
+      REQUIRE(links.size() <= ((l == 0) ? 16 : 8));
+      for (size_t j = 0; j < links.size(); ++j)
+      {
+        REQUIRE(links[j] != i);
+        REQUIRE(links[j] < 1000);
+        REQUIRE(hnsw.Level(links[j]) >= l);
+      }
+    }
+
+    numLinks += hnsw.Links(i, 0).size();
+  }
+
+  // Every point must be linked to something.
+  REQUIRE(numLinks >= 1000);
+}
+
+/**
+ * Make sure that HNSW finds almost all of the true nearest neighbors, and that
+ * the distances it returns are the true distances to its neighbors.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(10, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(10, 100);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 10, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(referenceData);
+  hnsw.Ef() = 100;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(queryData, 10, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 10);
+  REQUIRE(neighbors.n_cols == 100);
+  REQUIRE(LSHSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.9);
+
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) < referenceData.n_cols);
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+      const double trueDistance = EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(trueDistance).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that searching the reference set never returns a point as its own
+ * neighbor.
+ */
+TEST_CASE("HNSWMonochromaticTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 1000);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(5, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 1000);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      REQUIRE(neighbors(j, i) != i);
+
+  REQUIRE(LSHSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.9);
+}
+
+/**
+ * Make sure HNSW works with other distance metrics: the Manhattan distance, and
+ * the inner product metric with the linear kernel (which is the Euclidean
+ * distance).
+ */
+TEST_CASE("HNSWOtherDistancesTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(6, 50);
+
+  NeighborSearch<NearestNeighborSort, ManhattanDistance> manhattanKnn(
+      referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  manhattanKnn.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  HNSWSearch<ManhattanDistance> manhattanHnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  manhattanHnsw.Search(queryData, 5, neighbors, distances);
+
+  REQUIRE(LSHSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.9);
+
+  KNN knn(referenceData);
+  knn.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  HNSWSearch<IPMetric<LinearKernel>> ipHnsw(referenceData);
+  ipHnsw.Search(queryData, 5, neighbors, distances);
+
+  REQUIRE(LSHSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.9);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    REQUIRE(distances(0, i) == Approx(EuclideanDistance::Evaluate(
+        queryData.col(i), referenceData.col(neighbors(0, i)))).epsilon(1e-5));
+  }
+}
+
+/**
+ * Make sure HNSW works with single-precision data.
+ */
+TEST_CASE("HNSWFloatTest", "[HNSWTest]")
+{
+  arma::fmat referenceData = arma::randu<arma::fmat>(4, 500);
+
+  HNSWSearch<EuclideanDistance, arma::fmat> hnsw(referenceData);
+
+  arma::Mat<size_t> neighbors;
+  arma::fmat distances;
+  hnsw.Search(referenceData.cols(0, 9), 3, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 10);
+  // Each query is a reference point, so it must be its own nearest neighbor.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    REQUIRE(neighbors(0, i) == i);
+    REQUIRE(distances(0, i) == 0.0f);
+  }
+}
+
+/**
+ * Make sure that invalid parameters are reported.
+ */
+TEST_CASE("HNSWInvalidParametersTest", "[HNSWTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 100);
+
+  REQUIRE_THROWS_AS(HNSWSearch<>(referenceData, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(HNSWSearch<>(referenceData, 8, 0), std::invalid_argument);
+
+  HNSWSearch<> untrained;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(untrained.Search(referenceData, 3, neighbors, distances),
+      std::invalid_argument);
+
+  HNSWSearch<> hnsw(referenceData);
+  REQUIRE_THROWS_AS(hnsw.Search(referenceData, 101, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(100, neighbors, distances),
+      std::invalid_argument);
+  arma::mat wrongQueries = arma::randu<arma::mat>(4, 10);
+  REQUIRE_THROWS_AS(hnsw.Search(wrongQueries, 3, neighbors, distances),
+      std::invalid_argument);
+}
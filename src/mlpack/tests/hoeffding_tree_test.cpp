@@ -1835,3 +1835,217 @@ TEST_CASE("HoeffdingTreeCategoricalFloatDataTest", "[HoeffdingTreeTest]")
   REQUIRE(accu(batchPredictions == labels) > (labels.n_elem / 2));
   REQUIRE(accu(streamPredictions == labels) > (labels.n_elem / 2));
 }
+
+/**
+ * Make sure that training on mini-batches gives the same statistics as
+ * training on each point in turn when no split is checked, and that it can
+ * learn a simple dataset.
+ */
+TEST_CASE("HoeffdingTreeMiniBatchTest", "[HoeffdingTreeTest]")
+{
+  arma::mat dataset(4, 6000, arma::fill::randu);
+  arma::Row<size_t> labels(6000);
+  for (size_t i = 0; i < 6000; ++i)
+    labels[i] = (dataset(1, i) > 0.5) ? 1 : 0;
+
+  data::DatasetInfo info(4);
+
+  // With a check interval larger than the dataset, no split is checked, so the
+  // leaf statistics must match exactly.
+  HoeffdingTree<> streamTree(info, 2, 0.95, 0, 10000);
+  HoeffdingTree<> miniBatchTree(info, 2, 0.95, 0, 10000);
+  for (size_t i = 0; i < 6000; ++i)
+    streamTree.Train(dataset.col(i), labels[i]);
+  for (size_t i = 0; i < 6000; i += 500)
+  {
+    miniBatchTree.TrainMiniBatch(arma::mat(dataset.cols(i, i + 499)),
+        labels.subvec(i, i + 499));
+  }
+
+  REQUIRE(miniBatchTree.NumChildren() == 0);
+  REQUIRE(miniBatchTree.NumSamples() == streamTree.NumSamples());
+  REQUIRE(miniBatchTree.MajorityClass() == streamTree.MajorityClass());
+  REQUIRE(miniBatchTree.MajorityProbability() ==
+      Approx(streamTree.MajorityProbability()));
+  REQUIRE(miniBatchTree.SplitCheck() == streamTree.SplitCheck());
+  REQUIRE(miniBatchTree.SplitDimension() == streamTree.SplitDimension());
+
+  // Now train with the default check interval; the tree should split on the
+  // second dimension and classify almost every point correctly.
+  HoeffdingTree<> tree(info, 2);
+  for (size_t i = 0; i < 6000; i += 500)
+  {
+    tree.TrainMiniBatch(arma::mat(dataset.cols(i, i + 499)),
+        labels.subvec(i, i + 499));
+  }
+
+  REQUIRE(tree.NumChildren() > 0);
+  REQUIRE(tree.SplitDimension() == 1);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+  REQUIRE(arma::accu(predictions == labels) >= 5700);
+}
+
+/**
+ * Count the leaves of the given tree that keep split statistics.
+ */
+template<typename TreeType>
+size_t CountActiveLeaves(const TreeType& node, size_t& numLeaves)
+{
+  if (node.NumChildren() == 0)
+  {
+    ++numLeaves;
+    return node.Active() ? 1 : 0;
+  }
+
+  size_t activeLeaves = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    activeLeaves += CountActiveLeaves(node.Child(i), numLeaves);
+  return activeLeaves;
+}
+
+/**
+ * Make sure that a tree with a limit on the number of active leaves keeps to
+ * it, still learns, and can be serialized.
+ */
+TEST_CASE("HoeffdingTreeMaxActiveLeavesTest", "[HoeffdingTreeTest]")
+{
+  // A diagonal boundary needs many axis-aligned leaves.
+  arma::mat dataset(2, 20000, arma::fill::randu);
+  arma::Row<size_t> labels(20000);
+  for (size_t i = 0; i < 20000; ++i)
+    labels[i] = (dataset(0, i) + dataset(1, i) > 1.0) ? 1 : 0;
+
+  data::DatasetInfo info(2);
+  HoeffdingTree<> tree(info, 2);
+  tree.MaxActiveLeaves() = 3;
+  tree.Train(dataset, labels, 0, false);
+
+  size_t numLeaves = 0;
+  REQUIRE(CountActiveLeaves(tree, numLeaves) <= 3);
+  REQUIRE(numLeaves > 3);
+
+  // The tree should still have learned the boundary reasonably well.
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+  REQUIRE(arma::accu(predictions == labels) > 14000);
+
+  // Training on more points must not activate more leaves.
+  tree.Train(dataset, labels, 0, false);
+  numLeaves = 0;
+  REQUIRE(CountActiveLeaves(tree, numLeaves) <= 3);
+
+  std::ostringstream oss;
+  {
+    cereal::BinaryOutputArchive boa(oss);
+    boa(CEREAL_NVP(tree));
+  }
+
+  HoeffdingTree<> newTree;
+  std::istringstream iss(oss.str());
+  {
+    cereal::BinaryInputArchive bia(iss);
+    bia(CEREAL_NVP(newTree));
+  }
+
+  size_t newNumLeaves = 0;
+  REQUIRE(newTree.MaxActiveLeaves() == 3);
+  REQUIRE(CountActiveLeaves(newTree, newNumLeaves) ==
+      CountActiveLeaves(tree, numLeaves));
+
+  arma::Row<size_t> newPredictions;
+  newTree.Classify(dataset, newPredictions);
+  REQUIRE(arma::accu(newPredictions == predictions) == 20000);
+}
+
+/**
+ * Make sure that delta checkpoints of a tree can be applied to a copy, and
+ * that a delta after training on a few points is smaller than the tree.
+ */
+TEST_CASE("HoeffdingTreeDeltaCheckpointTest", "[HoeffdingTreeTest]")
+{
+  arma::mat dataset(2, 20000, arma::fill::randu);
+  arma::Row<size_t> labels(20000);
+  for (size_t i = 0; i < 20000; ++i)
+    labels[i] = (dataset(0, i) + dataset(1, i) > 1.0) ? 1 : 0;
+
+  data::DatasetInfo info(2);
+  HoeffdingTree<> tree(info, 2);
+  tree.Train(dataset, labels, 0, false);
+  REQUIRE(tree.NumChildren() > 0);
+
+  // The first checkpoint holds the whole tree.
+  std::ostringstream baseStream;
+  {
+    cereal::BinaryOutputArchive boa(baseStream);
+    tree.SaveDelta(boa);
+  }
+
+  HoeffdingTree<> copy;
+  {
+    std::istringstream iss(baseStream.str());
+    cereal::BinaryInputArchive bia(iss);
+    copy.LoadDelta(bia);
+  }
+
+  // Train on a few points, so that only a few leaves change.
+  arma::mat points(2, 10, arma::fill::randu);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    tree.Train(points.col(i), (points(0, i) + points(1, i) > 1.0) ? 1 : 0);
+
+  std::ostringstream deltaStream;
+  {
+    cereal::BinaryOutputArchive boa(deltaStream);
+    tree.SaveDelta(boa);
+  }
+
+  REQUIRE(deltaStream.str().size() < baseStream.str().size());
+
+  {
+    std::istringstream iss(deltaStream.str());
+    cereal::BinaryInputArchive bia(iss);
+    copy.LoadDelta(bia);
+  }
+
+  // Now train on many more points, so that leaves split, and apply another
+  // delta.
+  arma::mat newDataset(2, 20000, arma::fill::randu);
+  arma::Row<size_t> newLabels(20000);
+  for (size_t i = 0; i < 20000; ++i)
+    newLabels[i] = (newDataset(0, i) + newDataset(1, i) > 1.0) ? 1 : 0;
+  tree.Train(newDataset, newLabels, 0, false);
+
+  std::ostringstream secondDeltaStream;
+  {
+    cereal::BinaryOutputArchive boa(secondDeltaStream);
+    tree.SaveDelta(boa);
+  }
+
+  {
+    std::istringstream iss(secondDeltaStream.str());
+    cereal::BinaryInputArchive bia(iss);
+    copy.LoadDelta(bia);
+  }
+
+  REQUIRE(copy.NumDescendants() == tree.NumDescendants());
+
+  arma::Row<size_t> predictions, copyPredictions;
+  arma::rowvec probabilities, copyProbabilities;
+  tree.Classify(dataset, predictions, probabilities);
+  copy.Classify(dataset, copyPredictions, copyProbabilities);
+  REQUIRE(arma::accu(predictions == copyPredictions) == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(probabilities[i] == Approx(copyProbabilities[i]).epsilon(1e-10));
+
+  // The copy should keep training like the original tree.
+  tree.Train(dataset, labels, 0, false);
+  copy.Train(dataset, labels, 0, false);
+  REQUIRE(copy.NumDescendants() == tree.NumDescendants());
+
+  // A delta cannot be applied to a tree with a different structure.
+  HoeffdingTree<> other(info, 2);
+  std::istringstream iss(deltaStream.str());
+  cereal::BinaryInputArchive bia(iss);
+  REQUIRE_THROWS_AS(other.LoadDelta(bia), std::runtime_error);
+}
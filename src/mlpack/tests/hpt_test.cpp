@@ -169,6 +169,42 @@ TEST_CASE("CVFunctionGradientTest", "[HPTTest]")
 }
 
 
+/**
+ * Test CVFunction does not rerun cross-validation for parameters it has already
+ * evaluated, and that categorical parameters that map to the same category are
+ * treated as the same.
+ */
+TEST_CASE("CVFunctionMemoizationTest", "[HPTTest]")
+{
+  QuadraticTestFunction<LARS<>> lf(1.0, -1.5, 2.5, 3.0);
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 3);
+  datasetInfo.MapString<double>(0.5, 2);
+  datasetInfo.MapString<double>(1.5, 2);
+
+  CVFunction<decltype(lf), LARS<>, 3> cvFun(lf, datasetInfo, 0.01, 0.001);
+
+  const arma::vec parameters("0.0 -1.0 1.0");
+  const double objective = cvFun.Evaluate(parameters);
+  REQUIRE(objective == Approx(lf.Evaluate(0.0, -1.0, 1.5)).epsilon(1e-7));
+  REQUIRE(cvFun.Evaluations() == 1);
+
+  // The same point, and a category index that truncates to the same category.
+  REQUIRE(cvFun.Evaluate(parameters) == objective);
+  REQUIRE(cvFun.Evaluate(arma::vec("0.0 -1.0 1.3")) == objective);
+  REQUIRE(cvFun.Evaluations() == 1);
+
+  // The gradient needs the point itself and one increased point for each
+  // numeric parameter (the increased categorical parameter truncates to the
+  // same category); evaluating it again needs nothing new.
+  arma::mat gradient;
+  cvFun.Gradient(arma::vec("0.0 -1.0 0.0"), gradient);
+  REQUIRE(cvFun.Evaluations() == 4);
+  cvFun.Gradient(arma::vec("0.0 -1.0 0.0"), gradient);
+  REQUIRE(cvFun.Evaluations() == 4);
+}
+
 void InitProneToOverfittingData(arma::mat& xs,
                                 arma::rowvec& ys,
                                 double& validationSize)
@@ -315,6 +351,41 @@ TEST_CASE("HPTTest", "[HPTTest]")
   REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
 }
 
+/**
+ * Test HyperParameterTuner finds the same hyper-parameters when KFoldCV trains
+ * and evaluates the folds in parallel.
+ */
+TEST_CASE("HPTParallelKFoldCVTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  // The data is not shuffled, so that both tuners use the same folds.
+  HyperParameterTuner<LARS<>, MSE, KFoldCV> hpt(5, xs, ys, false);
+  double lambda1, lambda2;
+  std::tie(lambda1, lambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  HyperParameterTuner<LARS<>, MSE, KFoldCV> parallelHpt(5, xs, ys,
+      false);
+  parallelHpt.CrossValidation().Parallel() = true;
+  double parallelLambda1, parallelLambda2;
+  std::tie(parallelLambda1, parallelLambda2) = parallelHpt.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(parallelLambda1 == lambda1);
+  REQUIRE(parallelLambda2 == lambda2);
+  REQUIRE(parallelHpt.BestObjective() ==
+      Approx(hpt.BestObjective()).epsilon(1e-7));
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
@@ -152,4 +152,59 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+
+/**
+ * Make sure images of a vector are resized to the requested size.
+ */
+TEST_CASE("LoadVectorImageResizeTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> full, matrix;
+  data::ImageInfo info;
+  REQUIRE(data::Load("test_image.png", full, info, false) == true);
+
+  data::ImageInfo smallInfo(25, 20, 3);
+  std::vector<std::string> files(8, "test_image.png");
+  REQUIRE(data::Load(files, matrix, smallInfo, false) == true);
+  REQUIRE(matrix.n_rows == 25 * 20 * 3);
+  REQUIRE(matrix.n_cols == 8);
+  REQUIRE(smallInfo.Width() == 25);
+  REQUIRE(smallInfo.Height() == 20);
+
+  // All columns are decoded identically.
+  for (size_t i = 1; i < matrix.n_cols; ++i)
+    REQUIRE(arma::all(matrix.col(i) == matrix.col(0)));
+
+  // Without a requested size, the images are not changed.
+  data::ImageInfo fullInfo;
+  REQUIRE(data::Load(files, matrix, fullInfo, false) == true);
+  REQUIRE(matrix.n_rows == full.n_rows);
+  REQUIRE(arma::all(matrix.col(7) == full.col(0)));
+}
+
+/**
+ * Make sure the decoded-image cache gives the same matrix.
+ */
+TEST_CASE("LoadVectorImageCacheTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(3, "test_image.png");
+  arma::Mat<unsigned char> decoded, cached;
+  data::ImageInfo info, cachedInfo;
+  REQUIRE(data::Load(files, decoded, info, false, "images.cache") == true);
+
+  // The first load wrote the cache; the second one reads it.
+  REQUIRE(data::Load(files, cached, cachedInfo, false, "images.cache") == true);
+  REQUIRE(cachedInfo.Width() == info.Width());
+  REQUIRE(cachedInfo.Height() == info.Height());
+  REQUIRE(cachedInfo.Channels() == info.Channels());
+  REQUIRE(arma::all(arma::vectorise(cached == decoded)));
+
+  // A different list of files doesn't use the cache.
+  files.pop_back();
+  REQUIRE(data::Load(files, cached, cachedInfo, false, "images.cache") == true);
+  REQUIRE(cached.n_cols == 2);
+
+  remove("images.cache");
+  remove("images.cache.info");
+}
+
 #endif // MLPACK_HAS_STB.
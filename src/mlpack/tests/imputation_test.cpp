@@ -220,6 +220,68 @@ TEST_CASE("MedianImputationTest", "[ImputationTest]")
   REQUIRE(rowWiseInput(2, 3) == Approx(8.0).epsilon(1e-7));
 }
 
+/**
+ * Make sure MedianImputation finds the same median as arma::median(), for both
+ * odd and even numbers of valid elements.
+ */
+TEST_CASE("MedianImputationSelectionTest", "[ImputationTest]")
+{
+  for (size_t n : { 100, 101 })
+  {
+    arma::mat input(2, n + 10, arma::fill::randu);
+    // Mark some elements of the first dimension as missing.
+    for (size_t i = 0; i < 10; ++i)
+      input(0, 3 * i) = 0.0;
+
+    arma::vec valid = arma::vectorise(input.row(0));
+    valid = valid.elem(arma::find(valid != 0.0));
+    REQUIRE(valid.n_elem == n);
+    const double median = arma::median(valid);
+
+    MedianImputation<double> imputer;
+    imputer.Impute(input, 0.0, 0, true);
+
+    for (size_t i = 0; i < 10; ++i)
+      REQUIRE(input(0, 3 * i) == Approx(median).epsilon(1e-10));
+  }
+}
+
+/**
+ * Make sure the Imputer imputes every dimension that the missing value is
+ * mapped in, the same as imputing each of them separately.
+ */
+TEST_CASE("ImputerAllDimensionsTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3, 4"  << endl;
+  f << "5, 6, a, 7"  << endl;
+  f << "8, a, 10, 11" << endl;
+  f << "12, 13, a, 14" << endl;
+  f << "15, 16, 17, 18" << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+  remove("test_file.csv");
+
+  arma::mat expected(input);
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          MedianImputation<double>> imputer(info);
+  for (size_t i = 0; i < 3; ++i)
+    imputer.Impute(expected, "a", i);
+
+  imputer.Impute(input, "a");
+
+  REQUIRE(input.has_nan() == false);
+  CheckMatrices(input, expected);
+  REQUIRE(input(0, 0) == Approx(10.0).epsilon(1e-7));
+  REQUIRE(input(2, 1) == Approx(10.0).epsilon(1e-7));
+}
+
 /**
  * Make sure ListwiseDeletion method deletes the whole column (if column wise)
  * or the row (if row wise) containing value of 0.
@@ -0,0 +1,153 @@
+/**
+ * @file tests/ivf_pq_test.cpp
+ *
+ * Unit tests for the 'IVFPQSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+#include <mlpack/methods/ivf_pq.hpp>
+#include <mlpack/methods/lsh.hpp>
+#include <mlpack/methods/neighbor_search.hpp>
+
+using namespace mlpack;
+
+/**
+ * Make sure that the inverted lists hold every reference point exactly once,
+ * and that the codes and codebooks have the right sizes.
+ */
+TEST_CASE("IVFPQIndexLayoutTest", "[IVFPQTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 1000);
+
+  IVFPQSearch<> ivfpq(referenceData, 10, 3, 32);
+
+  REQUIRE(ivfpq.Dimensionality() == 6);
+  REQUIRE(ivfpq.NumReferencePoints() == 1000);
+  REQUIRE(ivfpq.NumLists() == 10);
+  REQUIRE(ivfpq.NumSubspaces() == 3);
+  REQUIRE(ivfpq.NumCentroids() == 32);
+
+  REQUIRE(ivfpq.CoarseCentroids().n_rows == 6);
+  REQUIRE(ivfpq.Codebooks().n_rows == 2);
+  REQUIRE(ivfpq.Codes().n_rows == 1000);
+  REQUIRE(ivfpq.Codes().n_cols == 3);
+  REQUIRE(arma::max(arma::vectorise(ivfpq.Codes())) < 32);
+
+  const arma::Col<size_t>& offsets = ivfpq.ListOffsets();
+  REQUIRE(offsets.n_elem == 11);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(offsets[10] == 1000);
+  for (size_t i = 0; i < 10; ++i)
+    REQUIRE(offsets[i + 1] >= offsets[i]);
+
+  arma::Col<size_t> counts(1000, arma::fill::zeros);
+  for (size_t i = 0; i < ivfpq.ListIndices().n_elem; ++i)
+    counts[ivfpq.ListIndices()[i]]++;
+  REQUIRE(arma::all(counts == 1));
+}
+
+/**
+ * Make sure that IVF-PQ finds most of the true nearest neighbors when all lists
+ * are scanned and the codes are fine enough, and that scanning only one list
+ * still returns valid neighbors.
+ */
+TEST_CASE("IVFPQRecallTest", "[IVFPQTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(4, 100);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, 5, trueNeighbors, trueDistances);
+
+  IVFPQSearch<> ivfpq(referenceData, 8, 4, 128);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivfpq.Search(queryData, 5, neighbors, distances, 8);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 100);
+  REQUIRE(LSHSearch<>::ComputeRecall(neighbors, trueNeighbors) > 0.5);
+
+  // The distances must be sorted, and close to the true distances.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      REQUIRE(neighbors(j, i) < referenceData.n_cols);
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+
+      const double trueDistance = EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)));
+      REQUIRE(std::abs(distances(j, i) - trueDistance) < 0.1);
+    }
+  }
+
+  // Scanning one list gives only points from that list.
+  ivfpq.Search(queryData, 5, neighbors, distances, 1);
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    if (neighbors[i] == referenceData.n_cols)
+      REQUIRE(distances[i] == DBL_MAX);
+    else
+      REQUIRE(distances[i] < DBL_MAX);
+  }
+}
+
+/**
+ * Make sure that invalid parameters are reported.
+ */
+TEST_CASE("IVFPQInvalidParametersTest", "[IVFPQTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(6, 100);
+
+  // The dimensionality is not divisible by the number of subspaces.
+  REQUIRE_THROWS_AS(IVFPQSearch<>(referenceData, 4, 4, 16),
+      std::invalid_argument);
+  // Too many lists or codewords.
+  REQUIRE_THROWS_AS(IVFPQSearch<>(referenceData, 101, 2, 16),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(referenceData, 4, 2, 257),
+      std::invalid_argument);
+
+  IVFPQSearch<> untrained;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(untrained.Search(referenceData, 3, neighbors, distances),
+      std::invalid_argument);
+
+  IVFPQSearch<> ivfpq(referenceData, 4, 2, 16);
+  REQUIRE_THROWS_AS(ivfpq.Search(referenceData, 101, neighbors, distances),
+      std::invalid_argument);
+  arma::mat wrongQueries = arma::randu<arma::mat>(5, 10);
+  REQUIRE_THROWS_AS(ivfpq.Search(wrongQueries, 3, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure IVF-PQ works with single-precision data.
+ */
+TEST_CASE("IVFPQFloatTest", "[IVFPQTest]")
+{
+  arma::fmat referenceData = arma::randu<arma::fmat>(4, 500);
+
+  IVFPQSearch<arma::fmat> ivfpq(referenceData, 5, 2, 64);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ivfpq.Search(referenceData.cols(0, 9), 3, neighbors, distances, 5);
+
+  REQUIRE(neighbors.n_rows == 3);
+  REQUIRE(neighbors.n_cols == 10);
+  REQUIRE(arma::all(arma::vectorise(neighbors) < 500));
+}
@@ -1229,3 +1229,185 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Test the parallel dual-tree KDE against brute force results, both with a
+ * query set and in the monochromatic case.  The query sets are large enough
+ * that tasks are created.
+ */
+TEST_CASE("ParallelKDEBruteForceTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 5000);
+  arma::mat query = arma::randu(2, 3000);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.01;
+
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  ParallelKDE<> kde(relError, 0.0, kernel);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  REQUIRE(treeEstimations.n_elem == query.n_cols);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(treeEstimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+
+  // In the monochromatic case, a point is not its own neighbor.
+  bfEstimations.zeros(reference.n_cols);
+  BruteForceKDE<GaussianKernel>(reference, reference, bfEstimations, kernel);
+  bfEstimations -= kernel.Evaluate(0.0) / reference.n_cols;
+
+  kde.Evaluate(treeEstimations);
+  REQUIRE(treeEstimations.n_elem == reference.n_cols);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+    REQUIRE(treeEstimations[i] == Approx(bfEstimations[i]).epsilon(relError));
+}
+
+/**
+ * Test the parallel dual-tree KDE with a cover tree and Monte Carlo
+ * estimations.
+ */
+TEST_CASE("ParallelCoverTreeMonteCarloKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 3000);
+  arma::mat query = arma::randu(2, 2000);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.4;
+  const double relError = 0.05;
+
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  ParallelKDE<GaussianKernel, StandardCoverTree> kde(relError, 0.0, kernel,
+      KDEMode::KDE_DUAL_TREE_MODE, EuclideanDistance(), true, 0.95, 100, 3,
+      0.8);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  // The Monte Carlo estimation has a random component so it can fail.
+  // Therefore we require a reasonable amount of results to be right.
+  size_t correctResults = 0;
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    const double resultRelativeError =
+      std::abs((bfEstimations[i] - treeEstimations[i]) / bfEstimations[i]);
+    if (resultRelativeError < relError)
+      ++correctResults;
+  }
+
+  REQUIRE(correctResults > 0.7 * query.n_cols);
+}
+
+/**
+ * Make sure that the error bounds returned by Evaluate() bound the actual
+ * errors, in single-tree and dual-tree mode.
+ */
+TEST_CASE("KDEErrorBoundsTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(3, 2000);
+  arma::mat query = arma::randu(3, 300);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double relError = 0.05;
+
+  GaussianKernel kernel(0.25);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  const KDEMode modes[] = { KDEMode::KDE_DUAL_TREE_MODE,
+                            KDEMode::KDE_SINGLE_TREE_MODE };
+  for (const KDEMode mode : modes)
+  {
+    KDE<> kde(relError, 0.0, kernel, mode);
+    kde.Train(reference);
+
+    arma::vec estimations, errorBounds;
+    kde.Evaluate(query, estimations, errorBounds);
+
+    REQUIRE(errorBounds.n_elem == query.n_cols);
+    for (size_t i = 0; i < query.n_cols; ++i)
+    {
+      REQUIRE(errorBounds[i] >= 0.0);
+      REQUIRE(std::abs(estimations[i] - bfEstimations[i]) <=
+          errorBounds[i] + 1e-10);
+    }
+  }
+}
+
+/**
+ * Make sure that when the time budget runs out immediately, the estimations
+ * are still within their error bounds, and the bounds are reported.
+ */
+TEST_CASE("KDETimeBudgetTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(3, 2000);
+  arma::mat query = arma::randu(3, 300);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+
+  GaussianKernel kernel(0.25);
+  BruteForceKDE<GaussianKernel>(reference, query, bfEstimations, kernel);
+
+  KDE<> kde(0.0, 0.0, kernel);
+  kde.Train(reference);
+
+  REQUIRE_THROWS_AS(kde.TimeBudget(-1.0), std::invalid_argument);
+
+  // Without a time budget, the estimations are exact.
+  arma::vec estimations, errorBounds;
+  kde.Evaluate(query, estimations, errorBounds);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-7));
+
+  // With a (nearly) zero time budget, the first combination of nodes is
+  // approximated.
+  kde.TimeBudget(1e-12);
+  REQUIRE(kde.TimeBudget() == 1e-12);
+  kde.Evaluate(query, estimations, errorBounds);
+
+  REQUIRE(arma::accu(errorBounds) > 0.0);
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(std::abs(estimations[i] - bfEstimations[i]) <=
+        errorBounds[i] + 1e-10);
+  }
+}
+
+/**
+ * Make sure that the grid of a KDE model approximates its estimations.
+ */
+TEST_CASE("KDEComputeGridTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 1000);
+  GaussianKernel kernel(0.2);
+  KDE<> kde(0.0, 0.0, kernel);
+
+  DensityGrid grid;
+  REQUIRE_THROWS_AS(kde.ComputeGrid(grid), std::runtime_error);
+
+  kde.Train(reference);
+  const double tolerance = 0.01;
+  kde.ComputeGrid(grid, tolerance, 0.5);
+  REQUIRE(grid.Dimensionality() == 2);
+  REQUIRE(grid.Interpolate());
+  REQUIRE(grid.MaxError() <= tolerance * arma::max(grid.Values()));
+
+  // Points inside the padded bounding box are close to the estimations, and
+  // points outside of it have density 0.
+  arma::mat query = 2.0 * arma::randu(2, 300) - 0.5;
+  arma::vec estimations, densities;
+  kde.Evaluate(query, estimations);
+  grid.Evaluate(query, densities);
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(std::abs(densities[i] - estimations[i]) <=
+        2.0 * tolerance * arma::max(grid.Values()));
+  }
+
+  arma::vec outside = { 2.0, 0.5 };
+  REQUIRE(grid.Evaluate(outside) == 0.0);
+
+  REQUIRE_THROWS_AS(kde.ComputeGrid(grid, tolerance, 0.5, 8, 10),
+      std::invalid_argument);
+}
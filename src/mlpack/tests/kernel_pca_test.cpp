@@ -142,3 +142,57 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * Transforming the points given to Apply() should give the same transformed
+ * data, and new points should be transformed like nearby points.
+ */
+TEMPLATE_TEST_CASE("KernelPCATransformTest", "[KernelPCATest]",
+    NaiveKernelRule<GaussianKernel>,
+    (NystroemKernelRule<GaussianKernel, OrderedSelection>))
+{
+  arma::mat dataset(3, 300, arma::fill::randu);
+
+  KernelPCA<GaussianKernel, TestType> p(GaussianKernel(0.5), true);
+
+  arma::mat transformedData;
+  arma::vec eigval;
+  arma::mat eigvec;
+  p.Apply(dataset, transformedData, eigval, eigvec, 20);
+
+  arma::mat output;
+  p.Transform(dataset, output);
+
+  REQUIRE(output.n_rows == transformedData.n_rows);
+  REQUIRE(output.n_cols == transformedData.n_cols);
+
+  // Only check the leading components, whose eigenvalues are not tiny.
+  const size_t checked = 3;
+  for (size_t i = 0; i < output.n_cols; ++i)
+    for (size_t j = 0; j < checked; ++j)
+      REQUIRE(output(j, i) == Approx(transformedData(j, i)).margin(1e-5));
+
+  // A slightly moved point should be transformed close to the original point.
+  arma::mat moved = dataset.cols(0, 9) + 1e-8;
+  p.Transform(moved, output);
+  for (size_t i = 0; i < output.n_cols; ++i)
+    for (size_t j = 0; j < checked; ++j)
+      REQUIRE(output(j, i) == Approx(transformedData(j, i)).margin(1e-4));
+
+  // The in-place Apply() keeps the requested dimension for Transform().
+  arma::mat reduced = dataset;
+  p.Apply(reduced, 2);
+  p.Transform(dataset, output);
+  REQUIRE(output.n_rows == 2);
+  REQUIRE(output.n_cols == dataset.n_cols);
+}
+
+/**
+ * Transform() should fail before Apply() has been called.
+ */
+TEST_CASE("KernelPCATransformWithoutApplyTest", "[KernelPCATest]")
+{
+  KernelPCA<GaussianKernel> p;
+  arma::mat data(3, 10, arma::fill::randu), output;
+  REQUIRE_THROWS_AS(p.Transform(data, output), std::logic_error);
+}
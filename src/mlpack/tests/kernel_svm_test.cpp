@@ -0,0 +1,238 @@
+/**
+ * @file tests/kernel_svm_test.cpp
+ *
+ * Tests for the KernelSVM class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kernel_svm.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+
+// Generate two concentric circles with noise; the inner circle is class 0.
+void GenerateCircles(arma::mat& data,
+                     arma::Row<size_t>& labels,
+                     const size_t nPoints)
+{
+  data.set_size(2, nPoints);
+  labels.set_size(nPoints);
+  for (size_t i = 0; i < nPoints; ++i)
+  {
+    labels[i] = i % 2;
+    const double radius = (labels[i] == 0 ? 1.0 : 3.0) + 0.2 * arma::randn();
+    const double angle = 2 * M_PI * arma::randu();
+    data(0, i) = radius * std::cos(angle);
+    data(1, i) = radius * std::sin(angle);
+  }
+}
+
+// Generate Gaussian clusters, one per class, with centers on a line.
+void GenerateClusters(arma::mat& data,
+                      arma::Row<size_t>& labels,
+                      const size_t nPoints,
+                      const size_t numClasses)
+{
+  data = arma::randn<arma::mat>(3, nPoints);
+  labels.set_size(nPoints);
+  for (size_t i = 0; i < nPoints; ++i)
+  {
+    labels[i] = i % numClasses;
+    data(0, i) += 5.0 * labels[i];
+  }
+}
+
+/**
+ * Make sure that points that are not linearly separable are classified
+ * correctly with the Gaussian kernel.
+ */
+TEST_CASE("KernelSVMGaussianCirclesTest", "[KernelSVMTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  GenerateCircles(data, labels, 400);
+  GenerateCircles(testData, testLabels, 400);
+
+  KernelSVM<> svm(data, labels, 2, 1.0, GaussianKernel(1.0));
+
+  arma::Row<size_t> predictions;
+  svm.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 390);
+  REQUIRE(svm.SupportVectors().n_cols > 0);
+  REQUIRE(svm.SupportVectors().n_cols < data.n_cols);
+  REQUIRE(svm.Classify(testData.col(0)) == predictions[0]);
+}
+
+/**
+ * Make sure that one-vs-one classification works with more than two classes.
+ */
+TEST_CASE("KernelSVMMulticlassTest", "[KernelSVMTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  GenerateClusters(data, labels, 600, 4);
+  GenerateClusters(testData, testLabels, 600, 4);
+
+  KernelSVM<> svm(data, labels, 4, 10.0, GaussianKernel(2.0));
+  REQUIRE(svm.NumClasses() == 4);
+  REQUIRE(svm.Biases().n_elem == 6);
+
+  arma::Row<size_t> predictions;
+  svm.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 550);
+
+  arma::mat decisionValues;
+  svm.DecisionValues(testData, decisionValues);
+  REQUIRE(decisionValues.n_rows == 6);
+  REQUIRE(decisionValues.n_cols == testData.n_cols);
+}
+
+/**
+ * Make sure that shrinking and the size of the kernel cache do not change the
+ * model.
+ */
+TEST_CASE("KernelSVMShrinkingCacheTest", "[KernelSVMTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GenerateCircles(data, labels, 500);
+
+  // A cache of 0 MB holds only two rows.
+  KernelSVM<> svm(data, labels, 2, 1.0, GaussianKernel(1.0), 1e-6);
+  KernelSVM<> noShrinking(data, labels, 2, 1.0, GaussianKernel(1.0), 1e-6, 0,
+      200, false);
+  KernelSVM<> smallCache(data, labels, 2, 1.0, GaussianKernel(1.0), 1e-6, 0,
+      0, true);
+
+  arma::mat values, noShrinkingValues, smallCacheValues;
+  svm.DecisionValues(data, values);
+  noShrinking.DecisionValues(data, noShrinkingValues);
+  smallCache.DecisionValues(data, smallCacheValues);
+
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    REQUIRE(noShrinkingValues[i] == Approx(values[i]).margin(1e-3));
+    REQUIRE(smallCacheValues[i] == Approx(values[i]).margin(1e-3));
+  }
+}
+
+/**
+ * Make sure that the kernel cache evicts the least recently used row.
+ */
+TEST_CASE("KernelCacheLRUTest", "[KernelSVMTest]")
+{
+  arma::mat data(3, 10, arma::fill::randu);
+  GaussianKernel kernel(0.5);
+
+  // Rows of 10 doubles fit many times in 1 MB, so the number of rows is
+  // limited by the number of points.
+  KernelCache<GaussianKernel, arma::mat> bigCache(data, kernel, 1);
+  REQUIRE(bigCache.MaxRows() == 10);
+
+  KernelCache<GaussianKernel, arma::mat> cache(data, kernel, 0);
+  REQUIRE(cache.MaxRows() == 2);
+
+  const double* row = cache.Row(3);
+  for (size_t k = 0; k < data.n_cols; ++k)
+    REQUIRE(row[k] == Approx(kernel.Evaluate(data.col(3), data.col(k))));
+  REQUIRE(cache.Diagonal(3) == Approx(1.0));
+
+  cache.Row(5);
+  cache.Row(3);
+  cache.Row(7); // Evicts row 5.
+  cache.Row(3);
+  REQUIRE(cache.Hits() == 2);
+  REQUIRE(cache.Misses() == 3);
+
+  cache.Row(5);
+  REQUIRE(cache.Misses() == 4);
+}
+
+/**
+ * Make sure that other kernels can be used.
+ */
+TEST_CASE("KernelSVMPolynomialKernelTest", "[KernelSVMTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  GenerateCircles(data, labels, 300);
+  GenerateCircles(testData, testLabels, 300);
+
+  // The circles are separable with a degree-2 polynomial.
+  KernelSVM<PolynomialKernel> svm(data, labels, 2, 1.0,
+      PolynomialKernel(2.0, 1.0));
+
+  arma::Row<size_t> predictions;
+  svm.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 290);
+}
+
+/**
+ * Make sure that the Nystroem approximation gives an accurate model.
+ */
+TEST_CASE("KernelSVMNystroemTest", "[KernelSVMTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  GenerateCircles(data, labels, 2000);
+  GenerateCircles(testData, testLabels, 500);
+
+  KernelSVM<> svm(data, labels, 2, 1.0, GaussianKernel(1.0), 1e-3, 0, 200,
+      true, 50);
+  REQUIRE(svm.SupportVectors().n_elem == 0);
+
+  arma::Row<size_t> predictions;
+  svm.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 480);
+}
+
+/**
+ * Make sure that invalid labels are rejected.
+ */
+TEST_CASE("KernelSVMInvalidLabelsTest", "[KernelSVMTest]")
+{
+  arma::mat data(2, 10, arma::fill::randu);
+  arma::Row<size_t> labels(10, arma::fill::zeros);
+  labels[3] = 2;
+
+  KernelSVM<> svm;
+  REQUIRE_THROWS_AS(svm.Train(data, labels, 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(svm.Train(data, labels, 1), std::invalid_argument);
+}
+
+/**
+ * Make sure that serialization works, for both the exact and approximate
+ * models.
+ */
+TEST_CASE("KernelSVMSerializationTest", "[KernelSVMTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GenerateClusters(data, labels, 300, 3);
+
+  for (size_t rank = 0; rank <= 20; rank += 20)
+  {
+    KernelSVM<> svm(data, labels, 3, 1.0, GaussianKernel(2.0), 1e-3, 0, 200,
+        true, rank);
+    KernelSVM<> xmlSvm, jsonSvm, binarySvm;
+    SerializeObjectAll(svm, xmlSvm, jsonSvm, binarySvm);
+
+    arma::mat values, xmlValues, jsonValues, binaryValues;
+    svm.DecisionValues(data, values);
+    xmlSvm.DecisionValues(data, xmlValues);
+    jsonSvm.DecisionValues(data, jsonValues);
+    binarySvm.DecisionValues(data, binaryValues);
+
+    CheckMatrices(values, xmlValues);
+    CheckMatrices(values, jsonValues);
+    CheckMatrices(values, binaryValues);
+    REQUIRE(xmlSvm.Rank() == rank);
+  }
+}
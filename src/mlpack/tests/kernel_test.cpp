@@ -408,6 +408,88 @@ TEST_CASE("PSpectrumStringEvaluateTest", "[KernelTest]")
   REQUIRE(p.Evaluate(b, a) == Approx(11.0).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the p-spectrum string kernel matrix, computed with a sparse
+ * product of the spectra, matches pairwise evaluations and the counts of the
+ * substrings.
+ */
+TEST_CASE("PSpectrumStringKernelMatrixTest", "[KernelTest]")
+{
+  // Two datasets of random strings over a small alphabet, so that many
+  // substrings are shared.
+  std::vector<std::vector<std::string> > datasets(2);
+  for (size_t d = 0; d < 2; ++d)
+  {
+    for (size_t i = 0; i < 40; ++i)
+    {
+      std::string str;
+      const size_t length = RandInt(0, 30);
+      for (size_t c = 0; c < length; ++c)
+        str += (char) ('a' + RandInt(0, 4));
+      datasets[d].push_back(str);
+    }
+  }
+
+  const size_t p = 3;
+  PSpectrumStringKernel kernel(datasets, p);
+
+  // Each spectrum holds one nonzero for each distinct substring.
+  REQUIRE(kernel.Spectra().size() == 2);
+  for (size_t d = 0; d < 2; ++d)
+  {
+    REQUIRE(kernel.Spectra()[d].n_cols == 40);
+    for (size_t i = 0; i < 40; ++i)
+    {
+      REQUIRE(kernel.Spectra()[d].col(i).n_nonzero ==
+          kernel.Counts()[d][i].size());
+    }
+  }
+
+  arma::mat a(2, 40), b(2, 30);
+  a.row(0).zeros();
+  a.row(1) = arma::linspace<arma::rowvec>(0, 39, 40);
+  b.row(0).ones();
+  for (size_t i = 0; i < 30; ++i)
+    b(1, i) = RandInt(0, 40);
+
+  arma::mat k, kSym;
+  KernelMatrix(kernel, a, b, k);
+  KernelMatrix(kernel, a, kSym);
+
+  REQUIRE(k.n_rows == 40);
+  REQUIRE(k.n_cols == 30);
+  REQUIRE(kSym.n_rows == 40);
+  REQUIRE(kSym.n_cols == 40);
+
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      // Compute the kernel value from the counts of the substrings.
+      const std::map<std::string, int>& aCounts =
+          kernel.Counts()[0][(size_t) a(1, i)];
+      const std::map<std::string, int>& bCounts =
+          kernel.Counts()[1][(size_t) b(1, j)];
+      double expected = 0.0;
+      for (const std::pair<const std::string, int>& c : aCounts)
+      {
+        auto it = bCounts.find(c.first);
+        if (it != bCounts.end())
+          expected += c.second * it->second;
+      }
+
+      REQUIRE(k(i, j) == Approx(expected).margin(1e-10));
+      REQUIRE(kernel.Evaluate(a.col(i), b.col(j)) ==
+          Approx(expected).margin(1e-10));
+    }
+  }
+
+  for (size_t j = 0; j < a.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kSym(i, j) == Approx(kernel.Evaluate(a.col(i), a.col(j))).
+          margin(1e-10));
+}
+
 /**
  * Cauchy Kernel test.
  */
@@ -420,3 +502,56 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Check that the kernel matrix between two sets of points, and the symmetric
+ * kernel matrix of one set of points, match pairwise evaluations.
+ */
+template<typename KernelType>
+void CheckKernelMatrix(KernelType& kernel)
+{
+  // The sizes are not multiples of the tile size.
+  arma::mat a(4, 130, arma::fill::randu);
+  arma::mat b(4, 70, arma::fill::randu);
+
+  arma::mat k, kSym;
+  KernelMatrix(kernel, a, b, k);
+  KernelMatrix(kernel, a, kSym);
+
+  REQUIRE(k.n_rows == 130);
+  REQUIRE(k.n_cols == 70);
+  REQUIRE(kSym.n_rows == 130);
+  REQUIRE(kSym.n_cols == 130);
+
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(k(i, j) == Approx(kernel.Evaluate(a.col(i), b.col(j))).
+          epsilon(1e-7).margin(1e-10));
+
+  for (size_t j = 0; j < a.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      REQUIRE(kSym(i, j) == Approx(kernel.Evaluate(a.col(i), a.col(j))).
+          epsilon(1e-7).margin(1e-10));
+}
+
+/**
+ * Kernel matrix test, for kernels evaluated with a matrix product and for
+ * kernels evaluated pairwise.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  GaussianKernel gk(0.7);
+  CheckKernelMatrix(gk);
+
+  PolynomialKernel pk(3.0, 0.5);
+  CheckKernelMatrix(pk);
+
+  LinearKernel lk;
+  CheckKernelMatrix(lk);
+
+  LaplacianKernel lpk(1.5);
+  CheckKernelMatrix(lpk);
+
+  CauchyKernel ck(2.0);
+  CheckKernelMatrix(ck);
+}
@@ -12,6 +12,7 @@
 #include <mlpack/methods/neighbor_search.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 
@@ -536,6 +537,82 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Make sure that k-means++ and k-means|| choose one initial centroid in each of
+ * several clusters that are far apart.
+ */
+TEST_CASE("KMeansSeparatedSeedingTest", "[KMeansTest]")
+{
+  // Eight tight clusters on the corners of a large cube.
+  arma::mat data(3, 4000);
+  data.randn();
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t c = i % 8;
+    data(0, i) += 100.0 * (c & 1);
+    data(1, i) += 100.0 * ((c >> 1) & 1);
+    data(2, i) += 100.0 * ((c >> 2) & 1);
+  }
+
+  for (size_t s = 0; s < 2; ++s)
+  {
+    arma::mat centroids;
+    if (s == 0)
+    {
+      KMeansPlusPlusInitialization::Cluster(data, 8, centroids);
+    }
+    else
+    {
+      KMeansParallelInitialization k(3, 2.0);
+      REQUIRE(k.Rounds() == 3);
+      REQUIRE(k.OversamplingFactor() == 2.0);
+      k.Cluster(data, 8, centroids);
+    }
+
+    REQUIRE(centroids.n_rows == 3);
+    REQUIRE(centroids.n_cols == 8);
+
+    // Each corner must have exactly one centroid.
+    arma::Col<size_t> found(8, arma::fill::zeros);
+    for (size_t j = 0; j < 8; ++j)
+    {
+      const size_t corner = (centroids(0, j) > 50.0 ? 1 : 0) +
+          (centroids(1, j) > 50.0 ? 2 : 0) + (centroids(2, j) > 50.0 ? 4 : 0);
+      found[corner]++;
+    }
+
+    for (size_t c = 0; c < 8; ++c)
+      REQUIRE(found[c] == 1);
+  }
+}
+
+/**
+ * Make sure that k-means|| can be used by KMeans, and handles a dataset with
+ * fewer distinct points than clusters.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  KMeans<EuclideanDistance, KMeansParallelInitialization> kmeans;
+
+  arma::Row<size_t> assignments;
+  kmeans.Cluster((arma::mat) trans(kMeansData), 3, assignments);
+  REQUIRE(assignments.n_elem == 30);
+  for (size_t i = 0; i < 13; ++i)
+    REQUIRE(assignments[i] == assignments[0]);
+  for (size_t i = 13; i < 20; ++i)
+    REQUIRE(assignments[i] == assignments[13]);
+  for (size_t i = 20; i < 30; ++i)
+    REQUIRE(assignments[i] == assignments[20]);
+
+  // Two distinct points, but three clusters.
+  arma::mat data(2, 20, arma::fill::zeros);
+  data.cols(10, 19).fill(1.0);
+  arma::mat centroids;
+  KMeansParallelInitialization().Cluster(data, 3, centroids);
+  REQUIRE(centroids.n_cols == 3);
+  REQUIRE(centroids.n_rows == 2);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -617,6 +694,37 @@ TEST_CASE("ElkanTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Elkan's algorithm stores its lower bounds in single precision; make sure it
+ * still gives exactly the same clusters as the naive method when the distances
+ * can't be represented exactly in single precision.
+ */
+TEST_CASE("ElkanLargeValuesTest", "[KMeansTest]")
+{
+  arma::mat dataset(5, 2000);
+  dataset.randu();
+  dataset += 1e5;
+
+  arma::mat centroids = dataset.cols(0, 19);
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, 20, assignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, RandomPartition, MaxVarianceNewCluster,
+      ElkanKMeans> elkan;
+  arma::Row<size_t> elkanAssignments;
+  arma::mat elkanCentroids(centroids);
+  elkan.Cluster(dataset, 20, elkanAssignments, elkanCentroids, false, true);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(assignments[i] == elkanAssignments[i]);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    REQUIRE(naiveCentroids[i] == Approx(elkanCentroids[i]).epsilon(1e-7));
+}
+
 TEST_CASE("HamerlyTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -750,6 +858,53 @@ TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Make sure that refitting the centroid tree of dual-tree k-means between
+ * iterations gives the same results as rebuilding it.
+ */
+TEST_CASE("DTNNCentroidTreeRefitTest", "[KMeansTest]")
+{
+  arma::mat dataset(5, 2000, arma::fill::randu);
+  const size_t k = 30;
+  arma::mat initialCentroids = dataset.cols(0, k - 1);
+
+  EuclideanDistance distance;
+  DefaultDualTreeKMeans<EuclideanDistance, arma::mat> refit(dataset, distance,
+      1e10);
+  DefaultDualTreeKMeans<EuclideanDistance, arma::mat> rebuild(dataset,
+      distance, 0.0);
+  NaiveKMeans<EuclideanDistance, arma::mat> naive(dataset, distance);
+
+  arma::mat refitCentroids(initialCentroids);
+  arma::mat rebuildCentroids(initialCentroids);
+  arma::mat naiveCentroids(initialCentroids);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::mat newRefitCentroids, newRebuildCentroids, newNaiveCentroids;
+    arma::Col<size_t> refitCounts, rebuildCounts, naiveCounts;
+    refit.Iterate(refitCentroids, newRefitCentroids, refitCounts);
+    rebuild.Iterate(rebuildCentroids, newRebuildCentroids, rebuildCounts);
+    naive.Iterate(naiveCentroids, newNaiveCentroids, naiveCounts);
+
+    CheckMatrices(refitCounts, rebuildCounts);
+    CheckMatrices(refitCounts, naiveCounts);
+    CheckMatrices(newRefitCentroids, newRebuildCentroids, 1e-7);
+    for (size_t c = 0; c < k; ++c)
+    {
+      if (naiveCounts[c] > 0)
+        CheckMatrices(newRefitCentroids.col(c), newNaiveCentroids.col(c), 1e-7);
+    }
+
+    refitCentroids = std::move(newRefitCentroids);
+    rebuildCentroids = std::move(newRebuildCentroids);
+    naiveCentroids = std::move(newNaiveCentroids);
+  }
+
+  // Every iteration after the first reused the centroid tree.
+  REQUIRE(refit.CentroidTreeRefits() == 9);
+  REQUIRE(rebuild.CentroidTreeRefits() == 0);
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -783,3 +938,65 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Make sure that a mini-batch iteration moves each centroid to the mean of the
+ * points assigned to it so far, and counts every sampled point.
+ */
+TEST_CASE("MiniBatchKMeansIterateTest", "[KMeansTest]")
+{
+  // Half of the points are at 0, and the other half are at 10.
+  arma::mat dataset(1, 1000, arma::fill::zeros);
+  dataset.cols(500, 999).fill(10.0);
+
+  arma::mat centroids("1.0 9.0");
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+
+  EuclideanDistance distance;
+  MiniBatchKMeans<EuclideanDistance, arma::mat> mb(dataset, distance, 100);
+  REQUIRE(mb.BatchSize() == 100);
+  mb.Iterate(centroids, newCentroids, counts);
+
+  REQUIRE(counts.n_elem == 2);
+  REQUIRE(counts[0] + counts[1] == 100);
+  REQUIRE(counts[0] > 0);
+  REQUIRE(counts[1] > 0);
+  REQUIRE(newCentroids(0, 0) == Approx(0.0).margin(1e-10));
+  REQUIRE(newCentroids(0, 1) == Approx(10.0).epsilon(1e-10));
+
+  // A second iteration accumulates the counts.
+  mb.Iterate(newCentroids, centroids, counts);
+  REQUIRE(counts[0] + counts[1] == 200);
+  REQUIRE(mb.DistanceCalculations() == 2 * (100 * 2 + 2));
+
+  REQUIRE_THROWS_AS(MiniBatchKMeans<EuclideanDistance, arma::mat>(dataset,
+      distance, 0), std::invalid_argument);
+}
+
+/**
+ * Make sure that mini-batch k-means finds the centers of well-separated
+ * clusters.
+ */
+TEST_CASE("MiniBatchKMeansClusterTest", "[KMeansTest]")
+{
+  arma::mat means("0.0 10.0 -10.0; 0.0 10.0 5.0");
+  arma::mat dataset(2, 3000);
+  for (size_t i = 0; i < 3000; ++i)
+    dataset.col(i) = means.col(i % 3) + 0.5 * arma::randn<arma::vec>(2);
+
+  // Start from one point of each cluster.
+  arma::mat centroids = dataset.cols(0, 2);
+
+  KMeans<EuclideanDistance, SampleInitialization, AllowEmptyClusters,
+      MiniBatchKMeans> kmeans(200);
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(dataset, 3, assignments, centroids, false, true);
+
+  for (size_t c = 0; c < 3; ++c)
+    for (size_t d = 0; d < 2; ++d)
+      REQUIRE(centroids(d, c) == Approx(means(d, c)).margin(0.2));
+
+  for (size_t i = 0; i < 3000; ++i)
+    REQUIRE(assignments[i] == i % 3);
+}
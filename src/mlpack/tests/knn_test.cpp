@@ -14,6 +14,9 @@
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
+#include <atomic>
+#include <thread>
+
 using namespace mlpack;
 
 /**
@@ -746,6 +749,36 @@ TEST_CASE("KNNSingleTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test the single-tree nearest-neighbors method with the naive method, using a
+ * separate query set large enough that it is split across threads and
+ * reordered along the space-filling curve.
+ */
+TEST_CASE("KNNSingleTreeQuerySetVsNaive", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(4, 2000);
+  arma::mat querySet = arma::randu<arma::mat>(4, 1500);
+
+  KNN knn(referenceSet, SINGLE_TREE_MODE);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+  knn.Search(querySet, 8, neighborsTree, distancesTree);
+  naive.Search(querySet, 8, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsTree.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree[i] == neighborsNaive[i]);
+    REQUIRE(distancesTree[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The counts from every thread should be collected.
+  REQUIRE(knn.BaseCases() > 0);
+  REQUIRE(knn.Scores() > 0);
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.
  *
@@ -1186,6 +1219,64 @@ TEST_CASE("KNNModelTest", "[KNNTest]")
   }
 }
 
+/**
+ * Ensure that an NSModel that holds its data in single precision gives the same
+ * results as a double-precision search, up to the precision of a float.
+ */
+TEST_CASE("KNNModelSinglePrecisionTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+  util::Timers timers;
+
+  arma::mat queryData = arma::randu<arma::mat>(10, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(10, 200);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  const KNNModel::TreeTypes treeTypes[] = { KNNModel::KD_TREE,
+      KNNModel::COVER_TREE, KNNModel::R_TREE, KNNModel::R_STAR_TREE,
+      KNNModel::BALL_TREE, KNNModel::X_TREE, KNNModel::HILBERT_R_TREE,
+      KNNModel::R_PLUS_TREE, KNNModel::R_PLUS_PLUS_TREE, KNNModel::VP_TREE,
+      KNNModel::RP_TREE, KNNModel::MAX_RP_TREE, KNNModel::UB_TREE,
+      KNNModel::OCTREE };
+
+  for (const KNNModel::TreeTypes treeType : treeTypes)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      const NeighborSearchMode mode = (j == 0) ? DUAL_TREE_MODE :
+          (j == 1) ? SINGLE_TREE_MODE : NAIVE_MODE;
+
+      KNNModel model(treeType, false);
+      model.SinglePrecision() = true;
+      model.BuildModel(timers, arma::mat(referenceData), mode);
+
+      REQUIRE(model.Dimensionality() == 10);
+      REQUIRE(model.NumReferencePoints() == 200);
+      REQUIRE_THROWS_AS(model.Dataset(), std::invalid_argument);
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      model.Search(timers, arma::mat(queryData), 3, neighbors, distances);
+
+      REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+      REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+      REQUIRE(distances.n_rows == baselineDistances.n_rows);
+      REQUIRE(distances.n_cols == baselineDistances.n_cols);
+      for (size_t k = 0; k < distances.n_elem; ++k)
+        REQUIRE(distances[k] == Approx(baselineDistances[k]).epsilon(1e-5));
+
+      // The monochromatic search should work too.
+      model.Search(timers, 3, neighbors, distances);
+      REQUIRE(neighbors.n_rows == 3);
+      REQUIRE(neighbors.n_cols == 200);
+    }
+  }
+}
+
 TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
 {
   // Ensure that we can build an NSModel<NearestNeighborSearch> and get correct
@@ -1865,3 +1956,788 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * With an unbounded beam and no limit on the number of leaves, beam search
+ * should give the same results as naive search, for trees with and without
+ * duplicated points.
+ */
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void CheckUnboundedBeamSearch()
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 200);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      beam(referenceSet, BEAM_SINGLE_TREE_MODE);
+  beam.BeamWidth() = referenceSet.n_cols;
+  beam.MaxLeaves() = 0;
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsBeam, neighborsNaive;
+  arma::mat distancesBeam, distancesNaive;
+
+  beam.Search(querySet, 5, neighborsBeam, distancesBeam);
+  naive.Search(querySet, 5, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsBeam.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsBeam[i] == neighborsNaive[i]);
+    REQUIRE(distancesBeam[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The same holds without a query set.
+  beam.Search(5, neighborsBeam, distancesBeam);
+  naive.Search(5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsBeam[i] == neighborsNaive[i]);
+    REQUIRE(distancesBeam[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+}
+
+TEST_CASE("KNNBeamSingleTreeUnboundedVsNaive", "[KNNTest]")
+{
+  CheckUnboundedBeamSearch<KDTree>();
+  CheckUnboundedBeamSearch<StandardCoverTree>();
+  CheckUnboundedBeamSearch<SPTree>();
+}
+
+/**
+ * A narrow beam with a leaf budget should return valid neighbors, with fewer
+ * base cases than exact search and a reasonable recall.
+ */
+TEST_CASE("KNNBeamSingleTreeBudget", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 5000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 500);
+
+  KNN beam(referenceSet, BEAM_SINGLE_TREE_MODE);
+  beam.BeamWidth() = 4;
+  beam.MaxLeaves() = 8;
+  KNN exact(referenceSet, SINGLE_TREE_MODE);
+
+  arma::Mat<size_t> neighborsBeam, neighborsExact;
+  arma::mat distancesBeam, distancesExact;
+
+  beam.Search(querySet, 5, neighborsBeam, distancesBeam);
+  exact.Search(querySet, 5, neighborsExact, distancesExact);
+
+  REQUIRE(accu(neighborsBeam >= referenceSet.n_cols) == 0);
+  REQUIRE(accu(distancesBeam < 0.0 || distancesBeam > std::sqrt(3.0)) == 0);
+  REQUIRE(beam.BaseCases() < exact.BaseCases());
+
+  // Each returned distance can only be worse than the exact one.
+  for (size_t i = 0; i < distancesExact.n_elem; ++i)
+    REQUIRE(distancesBeam[i] >= distancesExact[i] - 1e-10);
+
+  size_t found = 0;
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      if (arma::any(neighborsExact.col(i) == neighborsBeam(j, i)))
+        ++found;
+    }
+  }
+
+  REQUIRE(found > 0.5 * neighborsExact.n_elem);
+}
+
+/**
+ * An empty beam cannot be used.
+ */
+TEST_CASE("KNNBeamSingleTreeZeroWidth", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 100);
+
+  KNN beam(referenceSet, BEAM_SINGLE_TREE_MODE);
+  beam.BeamWidth() = 0;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  REQUIRE_THROWS_AS(beam.Search(3, neighbors, distances),
+      std::invalid_argument);
+}
+
+template<template<typename TreeDistanceType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void CheckBreadthFirstSearch()
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> Tree;
+
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 2000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 1500);
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType,
+      Tree::template BreadthFirstDualTreeTraverser> breadthFirst(referenceSet);
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType,
+      Tree::template ParallelBreadthFirstDualTreeTraverser>
+      parallel(referenceSet);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsBF, neighborsParallel, neighborsNaive;
+  arma::mat distancesBF, distancesParallel, distancesNaive;
+
+  breadthFirst.Search(querySet, 5, neighborsBF, distancesBF);
+  parallel.Search(querySet, 5, neighborsParallel, distancesParallel);
+  naive.Search(querySet, 5, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsBF.n_elem == neighborsNaive.n_elem);
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsBF[i] == neighborsNaive[i]);
+    REQUIRE(distancesBF[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The same holds without a query set.
+  parallel.Search(5, neighborsParallel, distancesParallel);
+  naive.Search(5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The base cases of every thread should be counted.
+  REQUIRE(parallel.BaseCases() > 0);
+}
+
+/**
+ * The breadth-first dual-tree traverser, serial and parallel, should give the
+ * same results as naive search for every tree type that provides it.
+ */
+TEST_CASE("KNNBreadthFirstDualTreeVsNaive", "[KNNTest]")
+{
+  CheckBreadthFirstSearch<KDTree>();
+  CheckBreadthFirstSearch<BallTree>();
+  CheckBreadthFirstSearch<StandardCoverTree>();
+  CheckBreadthFirstSearch<RTree>();
+  CheckBreadthFirstSearch<Octree>();
+}
+
+/**
+ * Make sure that the parallel dual-tree traverser gives the same results as
+ * naive search, both with and without a separate query set.
+ */
+TEST_CASE("KNNParallelDualTreeVsNaive", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 5000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 3000);
+
+  ParallelKNN<> parallelKNN(referenceSet);
+  ParallelKNN<BallTree> parallelBallKNN(referenceSet);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsParallel, neighborsBall, neighborsNaive;
+  arma::mat distancesParallel, distancesBall, distancesNaive;
+
+  parallelKNN.Search(querySet, 10, neighborsParallel, distancesParallel);
+  parallelBallKNN.Search(querySet, 10, neighborsBall, distancesBall);
+  naive.Search(querySet, 10, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  REQUIRE(neighborsBall.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+    REQUIRE(neighborsBall[i] == neighborsNaive[i]);
+    REQUIRE(distancesBall[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The base cases of every task should be counted.
+  REQUIRE(parallelKNN.BaseCases() > 0);
+
+  parallelKNN.Search(10, neighborsParallel, distancesParallel);
+  naive.Search(10, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that the parallel spill tree traversal gives the same results as
+ * naive search, and that the parallel defeatist traversal is exact when tau is
+ * larger than the distance to the k-th nearest neighbor, just like SpillKNN.
+ */
+TEST_CASE("KNNParallelSpillTreeVsNaive", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 5000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 3000);
+  const size_t k = 10;
+
+  ParallelKNN<SPTree> parallelKNN(referenceSet);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsParallel, neighborsNaive;
+  arma::mat distancesParallel, distancesNaive;
+
+  parallelKNN.Search(querySet, k, neighborsParallel, distancesParallel);
+  naive.Search(querySet, k, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The base cases of every thread should be counted.
+  REQUIRE(parallelKNN.BaseCases() > 0);
+
+  const double maxDist = distancesNaive.row(k - 1).max();
+  ParallelSpillKNN::Tree referenceTree(referenceSet, maxDist * 1.01);
+  ParallelSpillKNN spillKNN(std::move(referenceTree));
+
+  spillKNN.Search(querySet, k, neighborsParallel, distancesParallel);
+
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure the task-parallel cover tree traversal gives the same results as
+ * naive search, for both monochromatic and bichromatic search.
+ */
+TEST_CASE("KNNParallelCoverTreeVsNaive", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 5000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 3000);
+
+  ParallelKNN<StandardCoverTree> parallelKNN(referenceSet);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsParallel, neighborsNaive;
+  arma::mat distancesParallel, distancesNaive;
+
+  parallelKNN.Search(querySet, 10, neighborsParallel, distancesParallel);
+  naive.Search(querySet, 10, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+
+  // The base cases of every task should be counted.
+  REQUIRE(parallelKNN.BaseCases() > 0);
+
+  parallelKNN.Search(10, neighborsParallel, distancesParallel);
+  naive.Search(10, neighborsNaive, distancesNaive);
+
+  REQUIRE(neighborsParallel.n_elem == neighborsNaive.n_elem);
+  for (size_t i = 0; i < neighborsNaive.n_elem; ++i)
+  {
+    REQUIRE(neighborsParallel[i] == neighborsNaive[i]);
+    REQUIRE(distancesParallel[i] == Approx(distancesNaive[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that a tree whose nodes have been packed gives the same results as
+ * the original tree.
+ */
+TEST_CASE("KNNPackedTreeTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 2000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 500);
+
+  KNN::Tree tree(dataset);
+  KNN::Tree packedTree(tree);
+  packedTree.PackNodes();
+
+  KNN knn(std::move(tree));
+  KNN packedKnn(std::move(packedTree));
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    knn.SearchMode() = (i == 0) ? DUAL_TREE_MODE : SINGLE_TREE_MODE;
+    packedKnn.SearchMode() = knn.SearchMode();
+
+    arma::Mat<size_t> neighbors, packedNeighbors;
+    arma::mat distances, packedDistances;
+    knn.Search(querySet, 5, neighbors, distances);
+    packedKnn.Search(querySet, 5, packedNeighbors, packedDistances);
+
+    REQUIRE(neighbors.n_elem == packedNeighbors.n_elem);
+    for (size_t j = 0; j < neighbors.n_elem; ++j)
+    {
+      REQUIRE(neighbors[j] == packedNeighbors[j]);
+      REQUIRE(distances[j] == Approx(packedDistances[j]).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that the blocked base cases used for leaf-leaf combinations give
+ * the same results as the naive search, even with larger leaves, higher
+ * dimensionality, and duplicate points (whose distance must be exactly zero).
+ */
+TEST_CASE("KNNBlockBaseCasesTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 3000);
+  // Duplicate some points.
+  for (size_t i = 0; i < 100; ++i)
+    dataset.col(2 * i + 1) = dataset.col(2 * i);
+
+  KNN::Tree tree(dataset, 40);
+  KNN knn(std::move(tree));
+  KNN naive(knn.ReferenceSet(), NAIVE_MODE);
+
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    // Test the monochromatic and the bichromatic searches.
+    if (i == 0)
+    {
+      knn.Search(5, neighbors, distances);
+      naive.Search(5, naiveNeighbors, naiveDistances);
+    }
+    else
+    {
+      knn.Search(knn.ReferenceSet(), 5, neighbors, distances);
+      naive.Search(knn.ReferenceSet(), 5, naiveNeighbors, naiveDistances);
+    }
+
+    // With duplicate points, ties may be broken differently, so we check that
+    // the distances are the same and that each returned neighbor really is at
+    // the returned distance.
+    REQUIRE(neighbors.n_elem == naiveNeighbors.n_elem);
+    for (size_t q = 0; q < neighbors.n_cols; ++q)
+    {
+      for (size_t k = 0; k < neighbors.n_rows; ++k)
+      {
+        REQUIRE(distances(k, q) == naiveDistances(k, q));
+        REQUIRE(EuclideanDistance::Evaluate(knn.ReferenceSet().col(q),
+            knn.ReferenceSet().col(neighbors(k, q))) == distances(k, q));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that a kNN search on a tree loaded with MappedTree gives the same
+ * results as the original model.
+ */
+TEST_CASE("KNNMappedTreeTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 2000);
+  arma::mat querySet = arma::randu<arma::mat>(4, 300);
+
+  std::vector<size_t> oldFromNew;
+  KNN::Tree tree(dataset, oldFromNew);
+  MappedTree<KNN::Tree>::Save("knn_mapped_tree.bin", tree, oldFromNew);
+
+  KNN knn(dataset);
+  arma::Mat<size_t> neighbors, mappedNeighbors;
+  arma::mat distances, mappedDistances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  {
+    MappedTree<KNN::Tree> mapped("knn_mapped_tree.bin");
+    KNN mappedKnn(std::move(mapped.Tree()));
+    mappedKnn.Search(querySet, 5, mappedNeighbors, mappedDistances);
+
+    // The neighbors are indices into the tree's dataset, so they must be
+    // mapped back to the original indices.
+    REQUIRE(mappedNeighbors.n_elem == neighbors.n_elem);
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(mapped.OldFromNew()[mappedNeighbors[i]] == neighbors[i]);
+      REQUIRE(mappedDistances[i] == Approx(distances[i]).epsilon(1e-7));
+    }
+  }
+
+  remove("knn_mapped_tree.bin");
+}
+
+/**
+ * Make sure that the results of a kNN search after Insert() and Remove() are
+ * the same as the results of a model trained on the updated reference set, both
+ * before and after the model is rebuilt.
+ */
+TEST_CASE("KNNInsertRemoveTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 200);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    KNN knn(dataset, (mode == 0) ? NAIVE_MODE : (mode == 1) ? SINGLE_TREE_MODE :
+        DUAL_TREE_MODE);
+    arma::mat updated = dataset;
+
+    // Insert few enough points that no rebuild happens, then many more.
+    for (size_t round = 0; round < 2; ++round)
+    {
+      const arma::mat newPoints = arma::randu<arma::mat>(3, (round == 0) ? 30 :
+          200);
+      knn.Insert(newPoints);
+      updated = join_rows(updated, newPoints);
+
+      for (size_t i = 0; i < 20; ++i)
+      {
+        const size_t index = RandInt(updated.n_cols);
+        knn.Remove(index);
+        updated.shed_col(index);
+      }
+
+      REQUIRE(knn.NumReferencePoints() == updated.n_cols);
+
+      KNN trueKnn(updated, NAIVE_MODE);
+      arma::Mat<size_t> neighbors, trueNeighbors;
+      arma::mat distances, trueDistances;
+
+      knn.Search(querySet, 5, neighbors, distances);
+      trueKnn.Search(querySet, 5, trueNeighbors, trueDistances);
+      CheckMatrices(neighbors, trueNeighbors);
+      CheckMatrices(distances, trueDistances);
+
+      knn.Search(5, neighbors, distances);
+      trueKnn.Search(5, trueNeighbors, trueDistances);
+      CheckMatrices(neighbors, trueNeighbors);
+      CheckMatrices(distances, trueDistances);
+    }
+
+    // After a rebuild, there are no pending updates, and the results should
+    // not change.
+    knn.Rebuild();
+    REQUIRE(knn.ReferenceSet().n_cols == updated.n_cols);
+
+    KNN trueKnn(updated, NAIVE_MODE);
+    arma::Mat<size_t> neighbors, trueNeighbors;
+    arma::mat distances, trueDistances;
+    knn.Search(querySet, 5, neighbors, distances);
+    trueKnn.Search(querySet, 5, trueNeighbors, trueDistances);
+    CheckMatrices(neighbors, trueNeighbors);
+    CheckMatrices(distances, trueDistances);
+  }
+}
+
+/**
+ * Collecting traversal statistics must not change the results, and the
+ * statistics should be consistent with each other.
+ */
+TEST_CASE("KNNTraversalCountersTest", "[KNNTest]")
+{
+  arma::mat referenceSet(3, 1000, arma::fill::randu);
+  arma::mat querySet(3, 200, arma::fill::randu);
+
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      KDTree, KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat>::DualTreeTraverser, KDTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat>::SingleTreeTraverser,
+      TraversalCounters> CountingKNN;
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  for (NeighborSearchMode mode : { SINGLE_TREE_MODE, DUAL_TREE_MODE })
+  {
+    CountingKNN countingKnn(referenceSet, mode);
+    arma::Mat<size_t> countingNeighbors;
+    arma::mat countingDistances;
+    countingKnn.Search(querySet, 5, countingNeighbors, countingDistances);
+
+    CheckMatrices(neighbors, countingNeighbors);
+    CheckMatrices(distances, countingDistances);
+
+    const TraversalCounters& counters = countingKnn.Counters();
+    REQUIRE(counters.Queries() == querySet.n_cols);
+    REQUIRE(counters.Visits().size() > 1);
+    REQUIRE(counters.Visits().size() == counters.Prunes().size());
+    REQUIRE(counters.LeafPairs() > 0);
+    REQUIRE(counters.BoundUpdates() >= 5 * querySet.n_cols);
+    REQUIRE(counters.NodesPerQuery() > 0.0);
+    for (size_t d = 0; d < counters.Visits().size(); ++d)
+    {
+      REQUIRE(counters.Prunes()[d] <= counters.Visits()[d]);
+      REQUIRE(counters.PruneRate(d) >= 0.0);
+      REQUIRE(counters.PruneRate(d) <= 1.0);
+    }
+
+    // A second search starts the counts over.
+    countingKnn.Search(querySet, 5, countingNeighbors, countingDistances);
+    REQUIRE(countingKnn.Counters().Queries() == querySet.n_cols);
+  }
+}
+
+/**
+ * Make sure that LiveNeighborSearch returns the same results as a model trained
+ * on all of the points, both before and after a new model is built.
+ */
+TEST_CASE("LiveKNNInsertTest", "[KNNTest]")
+{
+  typedef LiveNeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, RStarTree> LiveKNNType;
+
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 200);
+
+  for (size_t mode = 0; mode < 2; ++mode)
+  {
+    LiveKNNType knn(dataset, (mode == 0) ? SINGLE_TREE_MODE : DUAL_TREE_MODE);
+    arma::mat updated = dataset;
+
+    // Insert few enough points that no model is built, then many more.
+    for (size_t round = 0; round < 2; ++round)
+    {
+      const arma::mat newPoints = arma::randu<arma::mat>(3, (round == 0) ? 30 :
+          200);
+      knn.Insert(newPoints);
+      updated = join_rows(updated, newPoints);
+
+      REQUIRE(knn.NumReferencePoints() == updated.n_cols);
+      REQUIRE(knn.NumInsertedPoints() == ((round == 0) ? 30 : 0));
+
+      KNN trueKnn(updated, NAIVE_MODE);
+      arma::Mat<size_t> neighbors, trueNeighbors;
+      arma::mat distances, trueDistances;
+
+      knn.Search(querySet, 5, neighbors, distances);
+      trueKnn.Search(querySet, 5, trueNeighbors, trueDistances);
+      CheckMatrices(neighbors, trueNeighbors);
+      CheckMatrices(distances, trueDistances);
+    }
+
+    REQUIRE_THROWS_AS(knn.Insert(arma::randu<arma::mat>(4, 10)),
+        std::invalid_argument);
+  }
+}
+
+/**
+ * Search a LiveNeighborSearch from several threads while another thread inserts
+ * points.  Since points are only added, every search must find neighbors that
+ * are at least as close as the neighbors in the initial reference set.
+ */
+TEST_CASE("LiveKNNConcurrentSearchTest", "[KNNTest]")
+{
+  typedef LiveNeighborSearch<NearestNeighborSort, EuclideanDistance,
+      arma::mat, RStarTree> LiveKNNType;
+
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(3, 50);
+  std::vector<arma::mat> batches;
+  for (size_t i = 0; i < 20; ++i)
+    batches.push_back(arma::randu<arma::mat>(3, 40));
+
+  KNN initialKnn(dataset, NAIVE_MODE);
+  arma::Mat<size_t> initialNeighbors;
+  arma::mat initialDistances;
+  initialKnn.Search(querySet, 3, initialNeighbors, initialDistances);
+
+  LiveKNNType knn(dataset);
+  std::atomic<bool> done(false);
+  std::atomic<size_t> failures(0);
+
+  std::thread writer([&]()
+  {
+    for (size_t i = 0; i < batches.size(); ++i)
+      knn.Insert(batches[i]);
+    done = true;
+  });
+
+  std::vector<std::thread> readers;
+  for (size_t t = 0; t < 3; ++t)
+  {
+    readers.push_back(std::thread([&]()
+    {
+      do
+      {
+        arma::Mat<size_t> neighbors;
+        arma::mat distances;
+        knn.Search(querySet, 3, neighbors, distances);
+        if (arma::any(arma::vectorise(distances >
+            initialDistances + 1e-10)) ||
+            arma::any(arma::vectorise(neighbors >= 1000 + 20 * 40)))
+          ++failures;
+      } while (!done);
+    }));
+  }
+
+  writer.join();
+  for (size_t t = 0; t < readers.size(); ++t)
+    readers[t].join();
+
+  REQUIRE(failures == 0);
+
+  arma::mat updated = dataset;
+  for (size_t i = 0; i < batches.size(); ++i)
+    updated = join_rows(updated, batches[i]);
+  REQUIRE(knn.NumReferencePoints() == updated.n_cols);
+
+  KNN trueKnn(updated, NAIVE_MODE);
+  arma::Mat<size_t> neighbors, trueNeighbors;
+  arma::mat distances, trueDistances;
+  knn.Search(querySet, 3, neighbors, distances);
+  trueKnn.Search(querySet, 3, trueNeighbors, trueDistances);
+  CheckMatrices(neighbors, trueNeighbors);
+  CheckMatrices(distances, trueDistances);
+}
+
+/**
+ * Run a pair-by-pair search with NeighborSearchRules, and check that
+ * BruteForceSearch gives exactly the same results.
+ */
+template<typename SortPolicy, typename DistanceType, typename MatType>
+void CheckBruteForceSearch(const MatType& querySet,
+                           const MatType& referenceSet,
+                           const bool sameSet)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef KDTree<DistanceType, NeighborSearchStat<SortPolicy>, MatType> Tree;
+
+  const size_t k = 7;
+  DistanceType distance;
+  NeighborSearchRules<SortPolicy, DistanceType, Tree> rules(referenceSet,
+      querySet, k, distance, 0.0, sameSet);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+    for (size_t j = 0; j < referenceSet.n_cols; ++j)
+      rules.BaseCase(i, j);
+
+  arma::Mat<size_t> trueNeighbors, neighbors;
+  arma::Mat<ElemType> trueDistances, distances;
+  rules.GetResults(trueNeighbors, trueDistances);
+
+  // Use small blocks that don't divide the number of points, so that partial
+  // tiles are tested too.
+  BruteForceSearch<SortPolicy, DistanceType, MatType> search(distance, 23, 57);
+  search.Search(querySet, referenceSet, k, neighbors, distances, sameSet);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors == trueNeighbors)));
+  REQUIRE(arma::approx_equal(distances, trueDistances, "absdiff", 0.0));
+}
+
+/**
+ * Make sure that the blocked brute-force search gives the same results as a
+ * pair-by-pair search, for high-dimensional data with duplicate points, in
+ * single and double precision, and with other sort policies and distances.
+ */
+TEST_CASE("BruteForceSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(256, 400);
+  arma::mat querySet = arma::randu<arma::mat>(256, 150);
+  // Duplicate some points, and make some query points reference points.
+  for (size_t i = 0; i < 20; ++i)
+  {
+    referenceSet.col(2 * i + 1) = referenceSet.col(2 * i);
+    querySet.col(i) = referenceSet.col(3 * i);
+  }
+
+  CheckBruteForceSearch<NearestNeighborSort, EuclideanDistance>(querySet,
+      referenceSet, false);
+  CheckBruteForceSearch<NearestNeighborSort, EuclideanDistance>(referenceSet,
+      referenceSet, true);
+  CheckBruteForceSearch<NearestNeighborSort, SquaredEuclideanDistance>(
+      querySet, referenceSet, false);
+  CheckBruteForceSearch<FurthestNeighborSort, EuclideanDistance>(querySet,
+      referenceSet, false);
+  CheckBruteForceSearch<NearestNeighborSort, ManhattanDistance>(querySet,
+      referenceSet, false);
+
+  const arma::fmat fQuerySet = arma::conv_to<arma::fmat>::from(querySet);
+  const arma::fmat fReferenceSet =
+      arma::conv_to<arma::fmat>::from(referenceSet);
+  CheckBruteForceSearch<NearestNeighborSort, EuclideanDistance>(fQuerySet,
+      fReferenceSet, false);
+  CheckBruteForceSearch<NearestNeighborSort, EuclideanDistance>(fReferenceSet,
+      fReferenceSet, true);
+
+  // NAIVE_MODE uses the blocked search, so it must agree with the trees.
+  KNN naive(referenceSet, NAIVE_MODE);
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+  naive.Search(querySet, 5, naiveNeighbors, naiveDistances);
+  knn.Search(querySet, 5, neighbors, distances);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+    REQUIRE(naiveDistances[i] == Approx(distances[i]).epsilon(1e-10));
+}
+
+/**
+ * Make sure that searching whitened data gives the same results as evaluating
+ * the Mahalanobis distance for every pair, for a positive definite and for a
+ * singular Q matrix.
+ */
+TEST_CASE("MahalanobisNeighborSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(4, 500);
+  arma::mat querySet = arma::randu<arma::mat>(4, 100);
+
+  arma::mat a = arma::randu<arma::mat>(4, 4);
+  arma::mat singular = arma::randu<arma::mat>(2, 4);
+  const arma::mat qs[] = { a.t() * a + 0.1 * arma::eye<arma::mat>(4, 4),
+                           singular.t() * singular };
+  for (const arma::mat& q : qs)
+  {
+    MahalanobisDistance<> distance(q);
+    MahalanobisNeighborSearch<> knn(referenceSet, distance);
+
+    const arma::mat l = knn.Whitening();
+    REQUIRE(arma::approx_equal(l.t() * l, q, "absdiff", 1e-10));
+
+    // Compute the true distances by brute force.
+    const size_t k = 3;
+    arma::mat trueDistances(k, querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+    {
+      arma::vec d(referenceSet.n_cols);
+      for (size_t j = 0; j < referenceSet.n_cols; ++j)
+        d[j] = distance.Evaluate(querySet.col(i), referenceSet.col(j));
+
+      const arma::uvec order = arma::sort_index(d);
+      for (size_t j = 0; j < k; ++j)
+        trueDistances(j, i) = d[order[j]];
+    }
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    knn.Search(querySet, k, neighbors, distances);
+    REQUIRE(arma::approx_equal(distances, trueDistances, "absdiff", 1e-8));
+    // Ties may be broken differently, so check that each neighbor really is
+    // at the returned distance.
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+    {
+      for (size_t j = 0; j < k; ++j)
+      {
+        REQUIRE(distance.Evaluate(querySet.col(i),
+            referenceSet.col(neighbors(j, i))) ==
+            Approx(distances(j, i)).epsilon(1e-8));
+      }
+    }
+
+    // The monochromatic search must not return the points themselves.
+    knn.Search(k, neighbors, distances);
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+      for (size_t j = 0; j < k; ++j)
+        REQUIRE(neighbors(j, i) != i);
+  }
+
+  arma::mat nonSymmetric = arma::eye<arma::mat>(4, 4);
+  nonSymmetric(0, 1) = 0.5;
+  REQUIRE_THROWS_AS(MahalanobisNeighborSearch<>(referenceSet,
+      MahalanobisDistance<>(nonSymmetric)), std::runtime_error);
+}
@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <time.h>
+#include <set>
 #include <mlpack/core.hpp>
 #include <mlpack/methods/rann.hpp>
 #include <mlpack/methods/rann/ra_model.hpp>
@@ -730,3 +731,109 @@ TEST_CASE("RAModelTest", "[KRANNTest]")
     }
   }
 }
+
+/**
+ * Make sure that the samples drawn by RAUtil are distinct and in range, and
+ * that the buffers are reused.
+ */
+TEST_CASE("RAUtilDistinctSamplesTest", "[KRANNTest]")
+{
+  std::vector<size_t> samples;
+  std::vector<size_t> permutation;
+  for (size_t trial = 0; trial < 100; ++trial)
+  {
+    const size_t n = 1 + RandInt(200);
+    const size_t m = RandInt(n + 1);
+
+    RAUtil::ObtainDistinctSamples(n, m, samples);
+    REQUIRE(samples.size() == m);
+    std::set<size_t> uniqueSamples(samples.begin(), samples.end());
+    REQUIRE(uniqueSamples.size() == m);
+    for (size_t i = 0; i < samples.size(); ++i)
+      REQUIRE(samples[i] < n);
+
+    RAUtil::PartialShuffle(n, m, permutation);
+    REQUIRE(permutation.size() == n);
+    std::set<size_t> uniquePermutation(permutation.begin(), permutation.end());
+    REQUIRE(uniquePermutation.size() == n);
+    REQUIRE(*uniquePermutation.rbegin() == n - 1);
+  }
+}
+
+/**
+ * Make sure that searches with a reused workspace and the batch search give the
+ * same guarantee as the regular naive search (see NaiveGuaranteeTest).
+ */
+TEST_CASE("KRANNWorkspaceBatchGuaranteeTest", "[KRANNTest]")
+{
+  arma::mat refData;
+  arma::mat queryData;
+
+  if (!data::Load("rann_test_r_3_900.csv", refData))
+    FAIL("Cannot load dataset rann_test_r_3_900.csv");
+  if (!data::Load("rann_test_q_3_100.csv", queryData))
+    FAIL("Cannot load dataset rann_test_q_3_100.csv");
+
+  arma::mat qrRanks;
+  if (!data::Load("rann_test_qr_ranks.csv", qrRanks, false, false))
+    FAIL("Cannot load dataset rann_test_qr_ranks.csv");
+
+  RASearch<> rsRann(refData, true, false, 1.0);
+
+  // Split the queries into batches of 10 points.
+  std::vector<arma::mat> querySets(10);
+  for (size_t b = 0; b < 10; ++b)
+    querySets[b] = queryData.cols(10 * b, 10 * b + 9);
+
+  size_t numRounds = 1000;
+  arma::Col<size_t> numSuccessRounds(queryData.n_cols);
+  numSuccessRounds.fill(0);
+  size_t expectedRankErrorUB = 10;
+
+  RAQueryWorkspace workspace;
+  std::vector<arma::Mat<size_t>> batchNeighbors;
+  std::vector<arma::mat> batchDistances;
+  for (size_t rounds = 0; rounds < numRounds; rounds++)
+  {
+    // Alternate between the batch search and single searches with one
+    // workspace.
+    if (rounds % 2 == 0)
+    {
+      rsRann.Search(querySets, 1, batchNeighbors, batchDistances);
+    }
+    else
+    {
+      batchNeighbors.resize(10);
+      batchDistances.resize(10);
+      for (size_t b = 0; b < 10; ++b)
+      {
+        rsRann.Search(querySets[b], 1, batchNeighbors[b], batchDistances[b],
+            workspace);
+      }
+    }
+
+    REQUIRE(batchNeighbors.size() == 10);
+    for (size_t b = 0; b < 10; ++b)
+    {
+      REQUIRE(batchNeighbors[b].n_rows == 1);
+      REQUIRE(batchNeighbors[b].n_cols == 10);
+      REQUIRE(batchDistances[b].n_cols == 10);
+      for (size_t i = 0; i < 10; ++i)
+        if (qrRanks(10 * b + i, batchNeighbors[b](0, i)) < expectedRankErrorUB)
+          numSuccessRounds[10 * b + i]++;
+    }
+  }
+
+  size_t threshold = floor(numRounds *
+      (0.95 - (1.96 * sqrt(0.95 * 0.05 / numRounds))));
+  size_t numQueriesFail = 0;
+  for (size_t i = 0; i < queryData.n_cols; ++i)
+    if (numSuccessRounds[i] < threshold)
+      numQueriesFail++;
+
+  REQUIRE(numQueriesFail < 6);
+
+  // An invalid k must be reported before any search is started.
+  REQUIRE_THROWS_AS(rsRann.Search(querySets, 901, batchNeighbors,
+      batchDistances), std::invalid_argument);
+}
@@ -423,3 +423,87 @@ TEST_CASE("LinearRegressionSparseTrainingTest", "[LinearRegressionTest]")
 
   REQUIRE(predictions.n_elem == 5000);
 }
+
+// Make sure that training on sparse data gives the same model as training on
+// the same data in a dense matrix, with and without weights and intercept.
+TEST_CASE("LinearRegressionSparseDenseEquivalenceTest",
+          "[LinearRegressionTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(20, 500, 0.2);
+  const arma::mat denseData(data);
+
+  arma::rowvec responses(500, arma::fill::randu);
+  arma::rowvec weights(500, arma::fill::randu);
+
+  for (const bool intercept : { true, false })
+  {
+    LinearRegression<> sparseLr(data, responses, 0.1, intercept);
+    LinearRegression<> denseLr(denseData, responses, 0.1, intercept);
+    REQUIRE(approx_equal(sparseLr.Parameters(), denseLr.Parameters(),
+        "absdiff", 1e-8));
+
+    LinearRegression<> sparseWeightedLr(data, responses, weights, 0.1,
+        intercept);
+    LinearRegression<> denseWeightedLr(denseData, responses, weights, 0.1,
+        intercept);
+    REQUIRE(approx_equal(sparseWeightedLr.Parameters(),
+        denseWeightedLr.Parameters(), "absdiff", 1e-8));
+  }
+}
+
+// Make sure that training in batches with Update() gives the same model as
+// training on all the data at once.
+TEST_CASE("LinearRegressionUpdateTest", "[LinearRegressionTest]")
+{
+  // The last batch is large enough to be accumulated in several blocks.
+  arma::mat data(5, 12000, arma::fill::randu);
+  arma::rowvec responses = arma::rowvec(5, arma::fill::randu) * data + 0.5 +
+      0.01 * arma::randn<arma::rowvec>(12000);
+  arma::rowvec weights(12000, arma::fill::randu);
+
+  LinearRegression<> lr(data, responses, weights, 0.1);
+
+  LinearRegression<> batchLr(data.cols(0, 999), responses.cols(0, 999),
+      weights.cols(0, 999), 0.1);
+  batchLr.Update(data.cols(1000, 1999), responses.cols(1000, 1999),
+      weights.cols(1000, 1999));
+  batchLr.Update(data.cols(2000, 11999), responses.cols(2000, 11999),
+      weights.cols(2000, 11999));
+
+  REQUIRE(approx_equal(lr.Parameters(), batchLr.Parameters(), "absdiff",
+      1e-8));
+
+  // A model that was never trained can start with Update().
+  LinearRegression<> updateLr;
+  updateLr.Lambda() = 0.1;
+  updateLr.Update(data.cols(0, 5999), responses.cols(0, 5999),
+      weights.cols(0, 5999));
+  updateLr.Update(data.cols(6000, 11999), responses.cols(6000, 11999),
+      weights.cols(6000, 11999));
+
+  REQUIRE(approx_equal(lr.Parameters(), updateLr.Parameters(), "absdiff",
+      1e-8));
+
+  // The dimensionality of new batches must match.
+  arma::mat wrongData(4, 100, arma::fill::randu);
+  REQUIRE_THROWS_AS(updateLr.Update(wrongData, responses.cols(0, 99)),
+      std::invalid_argument);
+}
+
+// Make sure that Update() works on sparse data.
+TEST_CASE("LinearRegressionSparseUpdateTest", "[LinearRegressionTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(20, 1000, 0.2);
+  arma::rowvec responses(1000, arma::fill::randu);
+
+  LinearRegression<> lr(data, responses);
+
+  LinearRegression<> batchLr(arma::sp_mat(data.cols(0, 499)),
+      responses.cols(0, 499));
+  batchLr.Update(arma::sp_mat(data.cols(500, 999)), responses.cols(500, 999));
+
+  REQUIRE(approx_equal(lr.Parameters(), batchLr.Parameters(), "absdiff",
+      1e-8));
+}
@@ -1467,3 +1467,35 @@ TEMPLATE_TEST_CASE("LinearSVMTrainVariantTest", "[LinearSVMTest]", arma::fmat,
   REQUIRE(lsvm16.FeatureSize() == 10);
   REQUIRE(lsvm16.NumClasses() == 2);
 }
+
+/**
+ * Make sure that classifying raw memory gives the same predictions as
+ * classifying a matrix, with and without an intercept.
+ */
+TEST_CASE("LinearSVMRawClassifyTest", "[LinearSVMTest]")
+{
+  arma::mat data(10, 300, arma::fill::randn);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 3;
+    data(labels[i], i) += 2.0;
+  }
+
+  for (const bool fitIntercept : { true, false })
+  {
+    LinearSVM<> lsvm(data, labels, 3, 0.0001, 1.0, fitIntercept);
+
+    arma::Row<size_t> predictions;
+    lsvm.Classify(data, predictions);
+
+    arma::Row<size_t> rawPredictions(data.n_cols);
+    lsvm.Classify(data.memptr(), data.n_cols, rawPredictions.memptr());
+    REQUIRE(arma::all(predictions == rawPredictions));
+
+    // Classify a single point.
+    size_t prediction;
+    lsvm.Classify(data.colptr(5), 1, &prediction);
+    REQUIRE(prediction == predictions[5]);
+  }
+}
@@ -97,6 +97,56 @@ TEMPLATE_TEST_CASE("LMNNImpostorsTest", "[LMNNTest]", float, double)
   REQUIRE(impostors(0, 5) == 2);
 }
 
+/**
+ * Impostors computed for a few points (which compares them with every other
+ * point) should match the impostors computed with a tree for all points.
+ */
+TEMPLATE_TEST_CASE("LMNNImpostorsSubsetTest", "[LMNNTest]", float, double)
+{
+  typedef TestType ElemType;
+
+  arma::Mat<ElemType> dataset(3, 500, arma::fill::randu);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = i % 3;
+
+  Constraints<arma::Mat<ElemType>, arma::Row<size_t>> constraint(dataset,
+      labels, 3);
+
+  arma::Col<ElemType> norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    norm(i) = arma::norm(dataset.col(i));
+
+  arma::umat impostors(3, dataset.n_cols);
+  arma::Mat<ElemType> distances(3, dataset.n_cols);
+  constraint.Impostors(impostors, distances, dataset, labels, norm);
+
+  // Recompute the impostors of a few points.
+  arma::uvec points = { 3, 10, 11, 250, 499, 0, 0 };
+  arma::umat subsetImpostors(impostors);
+  arma::Mat<ElemType> subsetDistances(distances);
+  subsetImpostors.cols(points.head(5)).zeros();
+  subsetDistances.cols(points.head(5)).zeros();
+  constraint.Impostors(subsetImpostors, subsetDistances, dataset, labels,
+      norm, points, 5);
+
+  for (size_t i = 0; i < 5; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(subsetImpostors(j, points[i]) == impostors(j, points[i]));
+      REQUIRE(subsetDistances(j, points[i]) ==
+          Approx(distances(j, points[i])).epsilon(1e-5));
+    }
+  }
+
+  // The same holds for a batch of points.
+  arma::umat batchImpostors(3, dataset.n_cols, arma::fill::zeros);
+  constraint.Impostors(batchImpostors, dataset, labels, norm, 100, 4);
+  REQUIRE(arma::all(arma::vectorise(batchImpostors.cols(100, 103) ==
+      impostors.cols(100, 103))));
+}
+
 //
 // Tests for the LMNNFunction
 //
@@ -201,6 +201,150 @@ TEST_CASE("LoadSparseTXTTest", "[LoadSaveTest]")
   remove("test_sparse_file.txt");
 }
 
+/**
+ * Make sure a libsvm file is loaded correctly into a sparse matrix.
+ */
+TEST_CASE("LoadLibSVMTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.libsvm", fstream::out);
+
+  f << "# A comment." << endl;
+  f << "1 1:0.5 4:2" << endl;
+  f << "-1 qid:3 2:1.5 # Another comment." << endl;
+  f << endl;
+  f << "1 6:-3" << endl;
+
+  f.close();
+
+  arma::sp_mat test;
+  arma::rowvec labels;
+
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels) == true);
+
+  REQUIRE(test.n_rows == 6);
+  REQUIRE(test.n_cols == 3);
+  REQUIRE(test.n_nonzero == 4);
+  REQUIRE(test(0, 0) == Approx(0.5));
+  REQUIRE(test(3, 0) == Approx(2.0));
+  REQUIRE(test(1, 1) == Approx(1.5));
+  REQUIRE(test(5, 2) == Approx(-3.0));
+
+  REQUIRE(labels.n_elem == 3);
+  REQUIRE(labels[0] == 1.0);
+  REQUIRE(labels[1] == -1.0);
+  REQUIRE(labels[2] == 1.0);
+
+  // A larger dimensionality can be given, but not a smaller one.
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels, false, 10) ==
+      true);
+  REQUIRE(test.n_rows == 10);
+  REQUIRE(test.n_nonzero == 4);
+
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels, false, 5) ==
+      false);
+
+  // Remove the file.
+  remove("test_file.libsvm");
+}
+
+/**
+ * Make sure malformed libsvm files are not loaded.
+ */
+TEST_CASE("LoadLibSVMInvalidTest", "[LoadSaveTest]")
+{
+  arma::sp_mat test;
+  arma::rowvec labels;
+
+  for (const std::string& line : { "1 0:1", "1 2:", "1 2", "a 1:2" })
+  {
+    fstream f;
+    f.open("test_file.libsvm", fstream::out);
+    f << line << endl;
+    f.close();
+
+    REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels) == false);
+  }
+
+  // Remove the file.
+  remove("test_file.libsvm");
+}
+
+/**
+ * Make sure SaveLibSVM() output can be loaded back.
+ */
+TEST_CASE("SaveLibSVMTest", "[LoadSaveTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(20, 50, 0.2);
+  dataset(19, 3) = 0.1;
+  arma::rowvec labels = arma::randi<arma::rowvec>(50, arma::distr_param(-1,
+      1));
+
+  REQUIRE(data::SaveLibSVM("test_file.svm", dataset, labels) == true);
+
+  arma::sp_mat loaded;
+  arma::rowvec loadedLabels;
+  REQUIRE(data::LoadLibSVM("test_file.svm", loaded, loadedLabels, false, 20)
+      == true);
+
+  // Values are written so that they read back exactly.
+  REQUIRE(loaded.n_rows == 20);
+  REQUIRE(loaded.n_cols == 50);
+  REQUIRE(arma::accu(loaded != dataset) == 0);
+  REQUIRE(arma::all(loadedLabels == labels));
+
+  // The number of labels must match the number of points.
+  REQUIRE(data::SaveLibSVM("test_file.svm", dataset,
+      arma::rowvec(49, arma::fill::ones)) == false);
+
+  remove("test_file.svm");
+}
+
+/**
+ * Make sure libsvm files can be loaded and saved with data::Load() and
+ * data::Save(), with the labels as the last row of the matrix.
+ */
+TEST_CASE("LoadSaveLibSVMAutodetectTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.svm", fstream::out);
+  f << "1 1:0.5 4:2" << endl;
+  f << "0 2:1.5" << endl;
+  f << "-1 3:-3" << endl;
+  f.close();
+
+  arma::sp_mat dataset;
+  REQUIRE(data::Load("test_file.svm", dataset) == true);
+
+  REQUIRE(dataset.n_rows == 5);
+  REQUIRE(dataset.n_cols == 3);
+  REQUIRE(dataset.n_nonzero == 6);
+  REQUIRE(dataset(0, 0) == Approx(0.5));
+  REQUIRE(dataset(3, 0) == Approx(2.0));
+  REQUIRE(dataset(1, 1) == Approx(1.5));
+  REQUIRE(dataset(2, 2) == Approx(-3.0));
+  REQUIRE(dataset(4, 0) == Approx(1.0));
+  REQUIRE(dataset(4, 1) == 0.0);
+  REQUIRE(dataset(4, 2) == Approx(-1.0));
+
+  // Dense matrices can be loaded too.
+  arma::mat denseDataset;
+  REQUIRE(data::Load("test_file.svm", denseDataset) == true);
+  REQUIRE(arma::approx_equal(denseDataset, arma::mat(dataset), "absdiff",
+      1e-10));
+
+  REQUIRE(data::Save("test_file.libsvm", dataset) == true);
+  arma::sp_mat loaded;
+  REQUIRE(data::Load("test_file.libsvm", loaded) == true);
+  REQUIRE(loaded.n_rows == 5);
+  REQUIRE(loaded.n_cols == 3);
+  REQUIRE(arma::accu(loaded != dataset) == 0);
+
+  remove("test_file.svm");
+  remove("test_file.libsvm");
+}
+
 /**
  * Make sure sparse coordinate list autodetection works.
  */
@@ -1359,6 +1503,110 @@ TEST_CASE("LoadBinaryTest", "[LoadSaveTest]")
   REQUIRE(y.inb.s == x.inb.s);
 }
 
+/**
+ * Make sure binary models saved by older versions of mlpack (without the
+ * header and checksum) can still be loaded.
+ */
+TEST_CASE("LoadLegacyBinaryTest", "[LoadSaveTest]")
+{
+  Test x(10, 12);
+  {
+    std::ofstream ofs("test.bin", std::ios::binary);
+    cereal::BinaryOutputArchive ar(ofs);
+    ar(cereal::make_nvp("x", x));
+  }
+
+  Test y(11, 14);
+
+  REQUIRE(data::Load("test.bin", "x", y, false) == true);
+
+  REQUIRE(y.x == x.x);
+  REQUIRE(y.y == x.y);
+  REQUIRE(y.ina.s == x.ina.s);
+  REQUIRE(y.inb.s == x.inb.s);
+
+  remove("test.bin");
+}
+
+/**
+ * Make sure corrupted and truncated binary models are not loaded.
+ */
+TEST_CASE("LoadCorruptBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat m(50, 50, arma::fill::randu);
+  REQUIRE(data::Save("test.bin", "m", m, false) == true);
+
+  std::string contents;
+  {
+    std::ifstream ifs("test.bin", std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(ifs),
+        std::istreambuf_iterator<char>());
+  }
+
+  arma::mat m2;
+  std::string corrupt(contents);
+  corrupt[contents.size() / 2] ^= 0x10;
+  {
+    std::ofstream ofs("test.bin", std::ios::binary);
+    ofs << corrupt;
+  }
+  REQUIRE(data::Load("test.bin", "m", m2, false) == false);
+
+  {
+    std::ofstream ofs("test.bin", std::ios::binary);
+    ofs << contents.substr(0, contents.size() - 100);
+  }
+  REQUIRE(data::Load("test.bin", "m", m2, false) == false);
+
+  remove("test.bin");
+}
+
+/**
+ * Make sure matrices, sparse matrices, and cubes (which are written to binary
+ * archives as blocks of memory) are saved and loaded correctly.
+ */
+TEST_CASE("SaveLoadBinaryArmadilloTest", "[LoadSaveTest]")
+{
+  arma::mat m(100, 80, arma::fill::randu);
+  arma::sp_mat sp;
+  sp.sprandu(100, 80, 0.1);
+  arma::cube c(10, 8, 5, arma::fill::randu);
+  arma::Row<size_t> r = arma::randi<arma::Row<size_t>>(50,
+      arma::distr_param(0, 1000));
+  arma::mat empty;
+
+  REQUIRE(data::Save("test_m.bin", "m", m, false) == true);
+  REQUIRE(data::Save("test_sp.bin", "sp", sp, false) == true);
+  REQUIRE(data::Save("test_c.bin", "c", c, false) == true);
+  REQUIRE(data::Save("test_r.bin", "r", r, false) == true);
+  REQUIRE(data::Save("test_e.bin", "e", empty, false) == true);
+
+  arma::mat m2;
+  arma::sp_mat sp2;
+  arma::cube c2;
+  arma::Row<size_t> r2;
+  arma::mat empty2(3, 3);
+
+  REQUIRE(data::Load("test_m.bin", "m", m2, false) == true);
+  REQUIRE(data::Load("test_sp.bin", "sp", sp2, false) == true);
+  REQUIRE(data::Load("test_c.bin", "c", c2, false) == true);
+  REQUIRE(data::Load("test_r.bin", "r", r2, false) == true);
+  REQUIRE(data::Load("test_e.bin", "e", empty2, false) == true);
+
+  REQUIRE(arma::approx_equal(m, m2, "absdiff", 0.0));
+  REQUIRE(sp2.n_nonzero == sp.n_nonzero);
+  REQUIRE(arma::approx_equal(arma::mat(sp), arma::mat(sp2), "absdiff", 0.0));
+  REQUIRE(arma::approx_equal(c, c2, "absdiff", 0.0));
+  REQUIRE(arma::all(r == r2));
+  REQUIRE(empty2.n_elem == 0);
+
+  remove("test_m.bin");
+  remove("test_sp.bin");
+  remove("test_c.bin");
+  remove("test_r.bin");
+  remove("test_e.bin");
+}
+
 /**
  * Make sure we can load and save.
  */
@@ -2362,6 +2610,93 @@ TEST_CASE("CategoryCaseTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * Test that sparse and dense rows of an ARFF file can be mixed, and that quoted
+ * categories with spaces are handled.
+ */
+TEST_CASE("SparseARFFTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute a numeric" << endl;
+  f << "@attribute b {'x y', z}" << endl;
+  f << "@attribute c real" << endl;
+  f << "@attribute d numeric" << endl;
+  f << "@data" << endl;
+  f << "1, 'x y', 2.5, 3" << endl;
+  f << "% comment" << endl;
+  f << "{3 -1, 1 z}" << endl;
+  f << endl;
+  f << "{}" << endl;
+  f << "4, z, 5, 6 % comment" << endl;
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.arff", dataset, info));
+
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.NumMappings(1) == 2);
+  REQUIRE(info.UnmapString(0, 1) == "x y");
+
+  REQUIRE(dataset.n_rows == 4);
+  REQUIRE(dataset.n_cols == 4);
+  arma::mat expected = { { 1.0, 0.0, 0.0, 4.0 },
+                         { 0.0, 1.0, 0.0, 1.0 },
+                         { 2.5, 0.0, 0.0, 5.0 },
+                         { 3.0, -1.0, 0.0, 6.0 } };
+  REQUIRE(arma::approx_equal(dataset, expected, "absdiff", 1e-7));
+
+  remove("test.arff");
+}
+
+/**
+ * Test that a sparse ARFF file can be loaded into a sparse matrix, and that
+ * bad indices are caught.
+ */
+TEST_CASE("SparseARFFSpMatTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "@attribute a numeric" << endl;
+  f << "@attribute b numeric" << endl;
+  f << "@attribute c numeric" << endl;
+  f << "@data" << endl;
+  f << "{2 1.5, 0 -2}" << endl;
+  f << "0, 0, 7" << endl;
+  f << "{}" << endl;
+  f.close();
+
+  arma::sp_mat dataset;
+  REQUIRE(data::Load("test.arff", dataset));
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == 3);
+  REQUIRE(dataset.n_nonzero == 3);
+  REQUIRE(dataset(0, 0) == Approx(-2.0).epsilon(1e-7));
+  REQUIRE(dataset(2, 0) == Approx(1.5).epsilon(1e-7));
+  REQUIRE(dataset(2, 1) == Approx(7.0).epsilon(1e-7));
+
+  // The same file loaded into a dense matrix should match.
+  arma::mat denseDataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.arff", denseDataset, info));
+  REQUIRE(arma::approx_equal(denseDataset, arma::mat(dataset), "absdiff",
+      1e-7));
+
+  f.open("test.arff", fstream::out);
+  f << "@attribute a numeric" << endl;
+  f << "@data" << endl;
+  f << "{1 3.0}" << endl;
+  f.close();
+
+  REQUIRE_THROWS_AS(data::LoadARFF("test.arff", dataset), std::runtime_error);
+
+  remove("test.arff");
+}
+
 /**
  * Test that a CSV with the wrong number of columns fails.
  */
@@ -2555,3 +2890,552 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure a CSV that is large enough to be split into several chunks is
+ * loaded correctly, with lines of different lengths and Windows line endings,
+ * in both orientations.
+ */
+TEST_CASE("LoadLargeCSVTest", "[LoadSaveTest]")
+{
+  // Each line has 3 to 5 columns; missing columns are filled with zeros.
+  const size_t numLines = 100000;
+  arma::mat expected(5, numLines, arma::fill::zeros);
+  fstream f;
+  f.open("test_file.csv", fstream::out | fstream::binary);
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    const size_t lineCols = 3 + (i % 3);
+    for (size_t j = 0; j < lineCols; ++j)
+    {
+      expected(j, i) = (i % 1000) + 0.25 * j;
+      f << expected(j, i) << ((j + 1 < lineCols) ? "," : "");
+    }
+    f << ((i % 2 == 0) ? "\r\n" : "\n");
+  }
+  f.close();
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.csv", test) == true);
+
+  REQUIRE(test.n_rows == 5);
+  REQUIRE(test.n_cols == numLines);
+  REQUIRE(arma::approx_equal(test, expected, "absdiff", 1e-10));
+
+  REQUIRE(data::Load("test_file.csv", test, true, false) == true);
+
+  REQUIRE(test.n_rows == numLines);
+  REQUIRE(test.n_cols == 5);
+  REQUIRE(arma::approx_equal(test, expected.t(), "absdiff", 1e-10));
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure infinities, NaNs and empty tokens in a CSV are loaded correctly,
+ * and that a token that is not a number makes the load fail.
+ */
+TEST_CASE("LoadCSVSpecialTokensTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  // The first line is numeric, so that it is not taken as a header.
+  f << "1, 2, 3" << endl;
+  f << "inf, -inf, nan" << endl;
+  f << ", , +3.5" << endl;
+  f.close();
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.csv", test) == true);
+
+  REQUIRE(test.n_rows == 3);
+  REQUIRE(test.n_cols == 3);
+  REQUIRE(test(0, 1) == std::numeric_limits<double>::infinity());
+  REQUIRE(test(1, 1) == -std::numeric_limits<double>::infinity());
+  REQUIRE(std::isnan(test(2, 1)));
+  REQUIRE(test(0, 2) == 0.0);
+  REQUIRE(test(1, 2) == 0.0);
+  REQUIRE(test(2, 2) == 3.5);
+
+  f.open("test_file.csv", fstream::out);
+  f << "1, 2, 3" << endl;
+  f << "4, x, 6" << endl;
+  f.close();
+
+  REQUIRE(data::Load("test_file.csv", test) == false);
+
+  // Remove the file.
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure a categorical CSV that is large enough to be split into several
+ * chunks gets the same mappings as if it were read sequentially: each string
+ * is mapped to the number of distinct strings seen before it.
+ */
+TEST_CASE("CategoricalLargeCSVLoadTest", "[LoadSaveTest]")
+{
+  const size_t numLines = 100000;
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < numLines; ++i)
+    f << (i % 7) << ", cat" << ((i * 31) % 101) << ", " << i << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, true) == true);
+
+  REQUIRE(dataset.n_rows == 3);
+  REQUIRE(dataset.n_cols == numLines);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::numeric);
+  REQUIRE(info.NumMappings(1) == 101);
+
+  std::map<std::string, size_t> expected;
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    const std::string category = "cat" + std::to_string((i * 31) % 101);
+    if (expected.count(category) == 0)
+    {
+      const size_t numMappings = expected.size();
+      expected[category] = numMappings;
+    }
+
+    REQUIRE(dataset(0, i) == (double) (i % 7));
+    REQUIRE(dataset(1, i) == (double) expected[category]);
+    REQUIRE(dataset(2, i) == (double) i);
+  }
+
+  remove("test.csv");
+}
+
+
+/**
+ * Make sure an Armadillo binary file saved by data::Save() can be mapped, and
+ * can still be loaded by Armadillo.
+ */
+TEST_CASE("MapArmaBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(7, 1000, arma::fill::randu);
+  REQUIRE(data::Save("test.bin", dataset, true, false) == true);
+
+  // The padded header must still be readable by Armadillo.
+  arma::mat loaded;
+  REQUIRE(loaded.load("test.bin", arma::arma_binary) == true);
+  REQUIRE(arma::approx_equal(loaded, dataset, "absdiff", 0.0));
+
+  data::MappedMatrix<double> mapped;
+  REQUIRE(data::MapMatrix("test.bin", mapped, true) == true);
+#if !defined(_WIN32)
+  REQUIRE(mapped.IsMapped() == true);
+#endif
+  REQUIRE(mapped.Matrix().n_rows == 7);
+  REQUIRE(mapped.Matrix().n_cols == 1000);
+  REQUIRE(arma::approx_equal(mapped.Matrix(), dataset, "absdiff", 0.0));
+  if (mapped.IsMapped())
+    REQUIRE_THROWS_AS(mapped.MutableMatrix(), std::logic_error);
+
+  // With copy-on-write, the matrix can be modified without changing the file.
+  data::MappedMatrix<double> writable;
+  REQUIRE(data::MapMatrix("test.bin", writable, true, true) == true);
+  writable.MutableMatrix().fill(3.0);
+  REQUIRE(arma::all(arma::vectorise(writable.Matrix()) == 3.0));
+
+  REQUIRE(data::MapMatrix("test.bin", mapped, true) == true);
+  REQUIRE(arma::approx_equal(mapped.Matrix(), dataset, "absdiff", 0.0));
+
+  // The element type has to match.
+  data::MappedMatrix<float> wrongType;
+  REQUIRE(data::MapMatrix("test.bin", wrongType) == false);
+
+  remove("test.bin");
+}
+
+/**
+ * Make sure a raw binary file can be mapped with a given number of rows.
+ */
+TEST_CASE("MapRawBinaryTest", "[LoadSaveTest]")
+{
+  arma::fmat dataset(4, 100, arma::fill::randu);
+  REQUIRE(dataset.save("test.bin", arma::raw_binary) == true);
+
+  data::MappedMatrix<float> mapped;
+  REQUIRE(data::MapMatrix("test.bin", mapped, true, false,
+      FileType::RawBinary, 4) == true);
+  REQUIRE(mapped.Matrix().n_rows == 4);
+  REQUIRE(mapped.Matrix().n_cols == 100);
+  REQUIRE(arma::approx_equal(mapped.Matrix(), dataset, "absdiff", 0.0f));
+
+  // Without a number of rows, the matrix is a single column.
+  REQUIRE(data::MapMatrix("test.bin", mapped, true, false,
+      FileType::RawBinary) == true);
+  REQUIRE(mapped.Matrix().n_rows == 400);
+  REQUIRE(mapped.Matrix().n_cols == 1);
+
+  // The number of rows must divide the number of elements.
+  REQUIRE(data::MapMatrix("test.bin", mapped, false, false,
+      FileType::RawBinary, 3) == false);
+
+  remove("test.bin");
+}
+
+
+/**
+ * Make sure a CSV file is read in chunks correctly, including after Reset(),
+ * with and without prefetching.
+ */
+TEST_CASE("ChunkedReaderCSVTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(3, 1005, arma::fill::randu);
+  REQUIRE(data::Save("test.csv", dataset) == true);
+
+  for (size_t prefetch = 0; prefetch < 2; ++prefetch)
+  {
+    data::ChunkedReader<double> reader("test.csv", 100, true,
+        FileType::AutoDetect, (prefetch == 1));
+    REQUIRE(reader.Dimensionality() == 3);
+
+    for (size_t epoch = 0; epoch < 2; ++epoch)
+    {
+      arma::mat chunk;
+      size_t points = 0;
+      while (reader.Next(chunk))
+      {
+        REQUIRE(chunk.n_rows == 3);
+        REQUIRE(chunk.n_cols == std::min((size_t) 100, 1005 - points));
+        REQUIRE(arma::approx_equal(chunk,
+            dataset.cols(points, points + chunk.n_cols - 1), "absdiff",
+            1e-5));
+        points += chunk.n_cols;
+      }
+
+      REQUIRE(points == 1005);
+      reader.Reset();
+    }
+  }
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure a CSV file with a bad token makes Next() throw.
+ */
+TEST_CASE("ChunkedReaderBadCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, 3" << endl;
+  f << "4, x, 6" << endl;
+  f.close();
+
+  data::ChunkedReader<double> reader("test.csv", 10);
+  arma::mat chunk;
+  REQUIRE_THROWS_AS(reader.Next(chunk), std::runtime_error);
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure Armadillo binary files are read in chunks correctly, in both
+ * orientations.
+ */
+TEST_CASE("ChunkedReaderArmaBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 250, arma::fill::randu);
+  for (size_t t = 0; t < 2; ++t)
+  {
+    const bool transpose = (t == 1);
+    REQUIRE(data::Save("test.bin", dataset, true, transpose) == true);
+
+    data::ChunkedReader<double> reader("test.bin", 64, transpose);
+    REQUIRE(reader.Dimensionality() == 4);
+
+    arma::mat chunk;
+    size_t points = 0;
+    while (reader.Next(chunk))
+    {
+      REQUIRE(arma::approx_equal(chunk,
+          dataset.cols(points, points + chunk.n_cols - 1), "absdiff", 0.0));
+      points += chunk.n_cols;
+    }
+    REQUIRE(points == 250);
+  }
+
+  remove("test.bin");
+}
+
+#ifdef MLPACK_HAS_ARROW
+
+/**
+ * Make sure a matrix can be saved and loaded as Arrow IPC and Parquet files, in
+ * both orientations.
+ */
+TEST_CASE("SaveLoadArrowTest", "[LoadSaveTest]")
+{
+  arma::mat data(5, 1000, arma::fill::randu);
+  const std::vector<std::string> files = { "test.arrow", "test.parquet" };
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    REQUIRE(data::Save(files[i], data) == true);
+
+    arma::mat test;
+    REQUIRE(data::Load(files[i], test) == true);
+    REQUIRE(test.n_rows == 5);
+    REQUIRE(test.n_cols == 1000);
+    REQUIRE(arma::approx_equal(test, data, "absdiff", 1e-15));
+
+    REQUIRE(data::Load(files[i], test, true, false) == true);
+    REQUIRE(test.n_rows == 1000);
+    REQUIRE(test.n_cols == 5);
+    REQUIRE(arma::approx_equal(test, data.t(), "absdiff", 1e-15));
+
+    // An integer matrix keeps its type.
+    arma::Mat<size_t> labels = arma::randi<arma::Mat<size_t>>(2, 100,
+        arma::distr_param(0, 1000));
+    REQUIRE(data::Save(files[i], labels) == true);
+
+    arma::Mat<size_t> testLabels;
+    REQUIRE(data::Load(files[i], testLabels) == true);
+    REQUIRE(arma::all(arma::vectorise(testLabels == labels)));
+
+    remove(files[i].c_str());
+  }
+}
+
+/**
+ * Make sure only the requested columns are loaded, in the requested order.
+ */
+TEST_CASE("LoadArrowColumnsTest", "[LoadSaveTest]")
+{
+  arma::mat data(4, 100, arma::fill::randu);
+  const std::vector<std::string> names = { "a", "b", "c", "d" };
+  const std::vector<std::string> files = { "test.feather", "test.parquet" };
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    REQUIRE(data::SaveArrow(files[i], data, true, true, names) == true);
+
+    arma::mat test;
+    REQUIRE(data::LoadArrow(files[i], test, true, true, { "d", "b" }) == true);
+    REQUIRE(test.n_rows == 2);
+    REQUIRE(test.n_cols == 100);
+    REQUIRE(arma::approx_equal(test.row(0), data.row(3), "absdiff", 1e-15));
+    REQUIRE(arma::approx_equal(test.row(1), data.row(1), "absdiff", 1e-15));
+
+    // An unknown column makes the load fail.
+    REQUIRE(data::LoadArrow(files[i], test, false, true, { "e" }) == false);
+
+    remove(files[i].c_str());
+  }
+}
+
+/**
+ * Make sure dictionary-encoded and plain string columns are mapped with the
+ * DatasetInfo.
+ */
+TEST_CASE("LoadArrowStringColumnsTest", "[LoadSaveTest]")
+{
+  arrow::StringDictionaryBuilder categories;
+  arrow::StringBuilder strings;
+  arrow::DoubleBuilder values;
+  const char* names[] = { "red", "green", "blue" };
+  for (size_t i = 0; i < 30; ++i)
+  {
+    REQUIRE(categories.Append(names[(i * 2) % 3]).ok());
+    REQUIRE(strings.Append(names[i % 3]).ok());
+    REQUIRE(values.Append(0.5 * i).ok());
+  }
+
+  std::shared_ptr<arrow::Array> categoryArray, stringArray, valueArray;
+  REQUIRE(categories.Finish(&categoryArray).ok());
+  REQUIRE(strings.Finish(&stringArray).ok());
+  REQUIRE(values.Finish(&valueArray).ok());
+
+  std::shared_ptr<arrow::Schema> schema = arrow::schema({
+      arrow::field("category", categoryArray->type()),
+      arrow::field("string", stringArray->type()),
+      arrow::field("value", valueArray->type()) });
+  std::shared_ptr<arrow::Table> table = arrow::Table::Make(schema,
+      { categoryArray, stringArray, valueArray });
+
+  auto output = arrow::io::FileOutputStream::Open("test.arrow");
+  REQUIRE(output.ok());
+  auto writer = arrow::ipc::MakeFileWriter(*output, schema);
+  REQUIRE(writer.ok());
+  REQUIRE((*writer)->WriteTable(*table).ok());
+  REQUIRE((*writer)->Close().ok());
+  REQUIRE((*output)->Close().ok());
+
+  arma::mat test;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.arrow", test, info, true) == true);
+  REQUIRE(test.n_rows == 3);
+  REQUIRE(test.n_cols == 30);
+  REQUIRE(info.Type(0) == Datatype::categorical);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::numeric);
+  REQUIRE(info.NumMappings(0) == 3);
+  REQUIRE(info.NumMappings(1) == 3);
+
+  for (size_t i = 0; i < 30; ++i)
+  {
+    REQUIRE(info.UnmapString(test(0, i), 0) == names[(i * 2) % 3]);
+    REQUIRE(info.UnmapString(test(1, i), 1) == names[i % 3]);
+    REQUIRE(test(2, i) == 0.5 * i);
+  }
+
+  remove("test.arrow");
+}
+
+#endif
+
+#if defined(MLPACK_HAS_ZLIB) || defined(MLPACK_HAS_ZSTD)
+
+/**
+ * Get the extensions of the compressed formats that are available.
+ */
+static std::vector<std::string> CompressionExtensions()
+{
+  std::vector<std::string> extensions;
+#ifdef MLPACK_HAS_ZLIB
+  extensions.push_back(".gz");
+#endif
+#ifdef MLPACK_HAS_ZSTD
+  extensions.push_back(".zst");
+#endif
+  return extensions;
+}
+
+/**
+ * Make sure that compressed CSV, Armadillo binary and sparse files can be saved
+ * and loaded, and that the file type is detected from the name of the file
+ * inside.
+ */
+TEST_CASE("SaveLoadCompressedTest", "[LoadSaveTest]")
+{
+  // The binary matrix is larger than one compression block.
+  arma::mat dataset(20, 500, arma::fill::randu);
+  arma::mat bigData(2000, 1000, arma::fill::randu);
+  arma::sp_mat sparseData;
+  sparseData.sprandu(50, 40, 0.1);
+  sparseData(49, 39) = 1.0;
+
+  for (const std::string& extension : CompressionExtensions())
+  {
+    REQUIRE(data::Save("test.csv" + extension, dataset) == true);
+    arma::mat loaded;
+    REQUIRE(data::Load("test.csv" + extension, loaded) == true);
+    REQUIRE(arma::approx_equal(loaded, dataset, "absdiff", 1e-5));
+
+    REQUIRE(data::Save("test.bin" + extension, bigData) == true);
+    REQUIRE(data::Load("test.bin" + extension, loaded) == true);
+    REQUIRE(arma::approx_equal(loaded, bigData, "absdiff", 0.0));
+
+    REQUIRE(data::Save("test.txt" + extension, sparseData) == true);
+    arma::sp_mat sparseLoaded;
+    REQUIRE(data::Load("test.txt" + extension, sparseLoaded) == true);
+    REQUIRE(arma::approx_equal(arma::mat(sparseLoaded), arma::mat(sparseData),
+        "absdiff", 1e-5));
+
+    // The file really is compressed: check the magic number of the format.
+    std::ifstream raw("test.csv" + extension, std::ios::binary);
+    unsigned char magic[2] = { 0, 0 };
+    raw.read((char*) magic, 2);
+    raw.close();
+    if (extension == ".gz")
+      REQUIRE((magic[0] == 0x1f && magic[1] == 0x8b));
+    else
+      REQUIRE((magic[0] == 0x28 && magic[1] == 0xb5));
+
+    remove(("test.csv" + extension).c_str());
+    remove(("test.bin" + extension).c_str());
+    remove(("test.txt" + extension).c_str());
+  }
+}
+
+/**
+ * Make sure that compressed categorical CSV and ARFF files can be loaded.
+ */
+TEST_CASE("LoadCompressedCategoricalTest", "[LoadSaveTest]")
+{
+  const std::string csv = "1,a,2\n3,b,4\n5,a,6\n";
+  const std::string arff = "@relation test\n@attribute x numeric\n"
+      "@attribute c {a, b}\n@data\n1, a\n2, b\n3, b\n";
+
+  for (const std::string& extension : CompressionExtensions())
+  {
+    const data::Compression compression = data::CompressionType(extension);
+    std::string compressed, error;
+    REQUIRE(data::Compress(csv.data(), csv.size(), compression, compressed,
+        error) == true);
+    std::ofstream("test.csv" + extension, std::ios::binary) << compressed;
+    REQUIRE(data::Compress(arff.data(), arff.size(), compression, compressed,
+        error) == true);
+    std::ofstream("test.arff" + extension, std::ios::binary) << compressed;
+
+    arma::mat loaded;
+    data::DatasetInfo info;
+    REQUIRE(data::Load("test.csv" + extension, loaded, info) == true);
+    REQUIRE(loaded.n_rows == 3);
+    REQUIRE(loaded.n_cols == 3);
+    REQUIRE(info.Type(1) == data::Datatype::categorical);
+    REQUIRE(loaded(2, 2) == 6.0);
+
+    data::DatasetInfo arffInfo;
+    REQUIRE(data::Load("test.arff" + extension, loaded, arffInfo) == true);
+    REQUIRE(loaded.n_rows == 2);
+    REQUIRE(loaded.n_cols == 3);
+    REQUIRE(arffInfo.Type(1) == data::Datatype::categorical);
+    REQUIRE(loaded(0, 2) == 3.0);
+
+    remove(("test.csv" + extension).c_str());
+    remove(("test.arff" + extension).c_str());
+  }
+}
+
+/**
+ * Make sure that models can be saved to and loaded from compressed files.
+ */
+TEST_CASE("SaveLoadCompressedModelTest", "[LoadSaveTest]")
+{
+  Test x(10, 12);
+
+  for (const std::string& extension : CompressionExtensions())
+  {
+    for (const std::string& type : { "bin", "xml", "json" })
+    {
+      const std::string filename = "test." + type + extension;
+      REQUIRE(data::Save(filename, "x", x, false) == true);
+
+      Test y(11, 14);
+      REQUIRE(data::Load(filename, "x", y, false) == true);
+
+      REQUIRE(y.x == x.x);
+      REQUIRE(y.y == x.y);
+      REQUIRE(y.ina.c == x.ina.c);
+      REQUIRE(y.inb.s == x.inb.s);
+
+      remove(filename.c_str());
+    }
+  }
+}
+
+/**
+ * Make sure that loading a corrupt compressed file fails.
+ */
+TEST_CASE("LoadInvalidCompressedTest", "[LoadSaveTest]")
+{
+  for (const std::string& extension : CompressionExtensions())
+  {
+    std::ofstream("test.csv" + extension) << "1,2,3\n4,5,6\n";
+
+    arma::mat loaded;
+    REQUIRE(data::Load("test.csv" + extension, loaded) == false);
+
+    remove(("test.csv" + extension).c_str());
+  }
+}
+
+#endif
@@ -87,6 +87,37 @@ TEMPLATE_TEST_CASE("LocalCoordinateCodingTestCodingStep",
   }
 }
 
+/**
+ * Make sure that encoding into a sparse matrix gives the same codes as
+ * encoding into a dense matrix.
+ */
+TEMPLATE_TEST_CASE("LocalCoordinateCodingTestSparseEncode",
+    "[LocalCoordinateCodingTest]", arma::mat, arma::fmat)
+{
+  typedef TestType MatType;
+  typedef typename MatType::elem_type ElemType;
+
+  mat inX; // The .arm file is saved as an arma::mat.
+  inX.load("mnist_first250_training_4s_and_9s.csv");
+  MatType X = arma::conv_to<MatType>::from(inX);
+
+  // normalize each point since these are images
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  LocalCoordinateCoding<MatType> lcc(X, 10, 0.1, 10);
+
+  MatType Z;
+  arma::SpMat<ElemType> sparseZ;
+  lcc.Encode(X, Z);
+  lcc.Encode(X, sparseZ);
+
+  REQUIRE(sparseZ.n_rows == Z.n_rows);
+  REQUIRE(sparseZ.n_cols == Z.n_cols);
+  REQUIRE(sparseZ.n_nonzero == arma::accu(Z != 0));
+  REQUIRE(arma::approx_equal(MatType(sparseZ), Z, "absdiff", 1e-5));
+}
+
 TEMPLATE_TEST_CASE("LocalCoordinateCodingTestDictionaryStep",
     "[LocalCoordinateCodingTest]", arma::mat, arma::fmat)
 {
@@ -832,6 +832,78 @@ TEST_CASE("LogisticRegressionSparseSGDTest", "[LogisticRegressionTest]")
         Approx(lrSparse.Parameters()[i]).epsilon(1e-5));
 }
 
+/**
+ * Make sure that the sparse gradient of a single point matches the dense
+ * gradient on the intercept and on the features of the point, and is zero
+ * elsewhere, for sparse and dense predictors.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradientTest",
+          "[LogisticRegressionTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(10, 50, 0.3);
+  arma::mat denseDataset(dataset);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(50,
+      arma::distr_param(0, 1));
+
+  LogisticRegressionFunction<arma::sp_mat> sparseFunction(dataset, labels,
+      0.5);
+  LogisticRegressionFunction<arma::mat> denseFunction(denseDataset, labels,
+      0.5);
+
+  arma::rowvec parameters(11, arma::fill::randu);
+  for (size_t i = 0; i < 50; ++i)
+  {
+    arma::rowvec gradient;
+    denseFunction.Gradient(parameters, i, gradient, 1);
+
+    arma::sp_mat sparseGradient, denseSparseGradient;
+    sparseFunction.Gradient(parameters, i, sparseGradient, 1);
+    denseFunction.Gradient(parameters, i, denseSparseGradient, 1);
+
+    REQUIRE(sparseGradient.n_rows == 1);
+    REQUIRE(sparseGradient.n_cols == 11);
+    for (size_t j = 0; j < 11; ++j)
+    {
+      const double expected = (j == 0 || denseDataset(j - 1, i) != 0.0) ?
+          gradient[j] : 0.0;
+      REQUIRE(sparseGradient(0, j) == Approx(expected).margin(1e-10));
+      REQUIRE(denseSparseGradient(0, j) == Approx(expected).margin(1e-10));
+    }
+  }
+}
+
+/**
+ * Train a logistic regression model on sparse data with the Hogwild! parallel
+ * SGD optimizer, and make sure it classifies the training data well.
+ */
+TEST_CASE("LogisticRegressionSparseParallelSGDTest",
+          "[LogisticRegressionTest]")
+{
+  // The labels are given by a linear model, so the data is separable.
+  arma::sp_mat dataset;
+  dataset.sprandu(50, 2000, 0.1);
+  const arma::rowvec trueWeights = arma::randn<arma::rowvec>(50);
+  const arma::rowvec scores = trueWeights * dataset;
+  const arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      scores > arma::median(scores));
+
+  #ifdef MLPACK_USE_OPENMP
+    const size_t threads = omp_get_max_threads();
+  #else
+    const size_t threads = 1;
+  #endif
+
+  ens::ParallelSGD<ens::ConstantStep> optimizer(100,
+      std::ceil((double) dataset.n_cols / threads), 1e-8, true,
+      ens::ConstantStep(0.1));
+
+  LogisticRegression<arma::sp_mat> lr(50, 0.0001);
+  lr.Train(dataset, labels, optimizer);
+
+  REQUIRE(lr.ComputeAccuracy(dataset, labels) > 90.0);
+}
+
 /**
  * Test multi-point classification (Classify()).
  */
@@ -1259,3 +1331,26 @@ TEST_CASE("LogisticRegressionResetTest", "[LogisticRegressionTest]")
   REQUIRE(
       !arma::approx_equal(lr1.Parameters(), lr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure that classifying raw memory gives the same predictions as
+ * classifying a matrix.
+ */
+TEST_CASE("LogisticRegressionRawClassifyTest", "[LogisticRegressionTest]")
+{
+  LogisticRegression<> lr;
+  lr.Parameters() = arma::randn<arma::rowvec>(11);
+
+  arma::mat data(10, 100, arma::fill::randn);
+  arma::Row<size_t> predictions;
+  lr.Classify(data, predictions, 0.3);
+
+  arma::Row<size_t> rawPredictions(100);
+  lr.Classify(data.memptr(), data.n_cols, rawPredictions.memptr(), 0.3);
+  REQUIRE(arma::all(predictions == rawPredictions));
+
+  // Classify a single point.
+  size_t prediction;
+  lr.Classify(data.colptr(7), 1, &prediction, 0.3);
+  REQUIRE(prediction == predictions[7]);
+}
@@ -628,6 +628,45 @@ TEST_CASE("MultiprobeDeterministicTest", "[LSHTest]")
       (neighbors.col(0) >= N / 4) && (neighbors.col(0) < N / 2)));
 }
 
+/**
+ * Make sure that the buckets of the second hash table are stored contiguously,
+ * hold no padding, and respect the maximum bucket size.
+ */
+TEST_CASE("LSHBucketLayoutTest", "[LSHTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 1000);
+  const size_t numTables = 5;
+  const size_t bucketSize = 20;
+
+  LSHSearch<> lsh(referenceData, 3, numTables, 0.5, 101, bucketSize);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<uint32_t>& contents = lsh.BucketContents();
+
+  REQUIRE(lsh.NumBuckets() > 0);
+  REQUIRE(lsh.NumBuckets() <= 101);
+  REQUIRE(offsets.n_elem == lsh.NumBuckets() + 1);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(offsets[lsh.NumBuckets()] == contents.n_elem);
+  REQUIRE(contents.n_elem <= numTables * referenceData.n_cols);
+
+  // Every bucket must be nonempty and hold at most bucketSize points.
+  for (size_t i = 0; i < lsh.NumBuckets(); ++i)
+  {
+    REQUIRE(offsets[i + 1] > offsets[i]);
+    REQUIRE(offsets[i + 1] - offsets[i] <= bucketSize);
+  }
+
+  // Each point can be in at most one bucket per table.
+  arma::Col<size_t> counts(referenceData.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < contents.n_elem; ++i)
+  {
+    REQUIRE(contents[i] < referenceData.n_cols);
+    counts[contents[i]]++;
+  }
+  REQUIRE(counts.max() <= numTables);
+}
+
 TEST_CASE("LSHTrainTest", "[LSHTest]")
 {
   // This is a not very good test that simply checks that the re-trained LSH
@@ -424,3 +424,71 @@ TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANRandomSelectionFlagTest",
 
   REQUIRE(accu(orderedOutput != randomOutput) > 0);
 }
+
+/**
+ * Check that the same noise points and number of clusters are found when
+ * searching in batches and with the grid-based algorithm.
+ */
+TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANBatchSizeGridTest",
+                 "[DBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("epsilon", (double) 0.4);
+
+  RUN_BINDING();
+
+  arma::Row<size_t> output;
+  output = std::move(params.Get<arma::Row<size_t>>("assignments"));
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", inputData);
+  SetInputParam("epsilon", (double) 0.4);
+  SetInputParam("batch_size", 16);
+
+  RUN_BINDING();
+
+  arma::Row<size_t> batchOutput;
+  batchOutput = std::move(params.Get<arma::Row<size_t>>("assignments"));
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", inputData);
+  SetInputParam("epsilon", (double) 0.4);
+  SetInputParam("grid", true);
+
+  RUN_BINDING();
+
+  arma::Row<size_t> gridOutput;
+  gridOutput = std::move(params.Get<arma::Row<size_t>>("assignments"));
+
+  const arma::uvec noise = arma::find(output == SIZE_MAX);
+  CheckMatrices(noise, arma::uvec(arma::find(batchOutput == SIZE_MAX)));
+  CheckMatrices(noise, arma::uvec(arma::find(gridOutput == SIZE_MAX)));
+
+  const arma::Row<size_t> clusters = arma::unique(output);
+  REQUIRE(arma::unique(batchOutput).eval().n_elem == clusters.n_elem);
+  REQUIRE(arma::unique(gridOutput).eval().n_elem == clusters.n_elem);
+}
+
+/**
+ * Make sure a negative batch size is rejected.
+ */
+TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANBatchSizeTest",
+                 "[DBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("batch_size", -1);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
@@ -52,3 +52,54 @@ TEST_CASE_METHOD(HMMLoglikTestFixture, "HMMLoglikOutputNegativeTest",
   // Since the log of a probability <= 0 ...
   REQUIRE(loglik <= 0);
 }
+
+TEST_CASE_METHOD(HMMLoglikTestFixture, "HMMLoglikLengthsTest",
+                 "[HMMLoglikMainTest][BindingTests]")
+{
+  // Load two sequences and train a discrete HMM model with them.
+  arma::mat inp1, inp2;
+  data::Load("obs1.csv", inp1);
+  data::Load("obs2.csv", inp2);
+  std::vector<arma::mat> trainSeq = {inp1, inp2};
+
+  HMMModel* h = new HMMModel(DiscreteHMM);
+  h->PerformAction<InitHMMModel, std::vector<arma::mat>>(params, &trainSeq);
+  h->PerformAction<TrainHMMModel, std::vector<arma::mat>>(params, &trainSeq);
+
+  const double loglik1 = h->DiscreteHMM()->LogLikelihood(inp1);
+  const double loglik2 = h->DiscreteHMM()->LogLikelihood(inp2);
+
+  // Score both sequences at once.
+  SetInputParam("input_model", h);
+  SetInputParam("input", arma::mat(arma::join_rows(inp1, inp2)));
+  SetInputParam("lengths", arma::Col<size_t>({ (size_t) inp1.n_cols,
+      (size_t) inp2.n_cols }));
+
+  RUN_BINDING();
+
+  const arma::vec& logliks = params.Get<arma::vec>("log_likelihoods");
+  REQUIRE(logliks.n_elem == 2);
+  REQUIRE(logliks[0] == Approx(loglik1).epsilon(1e-7));
+  REQUIRE(logliks[1] == Approx(loglik2).epsilon(1e-7));
+  REQUIRE(params.Get<double>("log_likelihood") ==
+      Approx(loglik1 + loglik2).epsilon(1e-7));
+}
+
+TEST_CASE_METHOD(HMMLoglikTestFixture, "HMMLoglikWrongLengthsTest",
+                 "[HMMLoglikMainTest][BindingTests]")
+{
+  arma::mat inp;
+  data::Load("obs1.csv", inp);
+  std::vector<arma::mat> trainSeq = {inp};
+
+  HMMModel* h = new HMMModel(DiscreteHMM);
+  h->PerformAction<InitHMMModel, std::vector<arma::mat>>(params, &trainSeq);
+  h->PerformAction<TrainHMMModel, std::vector<arma::mat>>(params, &trainSeq);
+
+  // The lengths do not add up to the number of observations.
+  SetInputParam("input_model", h);
+  SetInputParam("input", inp);
+  SetInputParam("lengths", arma::Col<size_t>({ (size_t) inp.n_cols + 1 }));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
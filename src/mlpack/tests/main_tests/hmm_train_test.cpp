@@ -409,6 +409,67 @@ TEST_CASE_METHOD(HMMTrainMainTestFixture, "HMMTrainBatchModeTest",
   REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
 }
 
+// Make sure that sequences stored one after another in a single file, with a
+// file of sequence lengths, give the same model as a list of sequence files.
+TEST_CASE_METHOD(HMMTrainMainTestFixture, "HMMTrainLengthsFileTest",
+                 "[HMMTrainMainTest][BindingTests]")
+{
+  GaussianDistribution d1("0.0 0.0", "1.0 0.0; 0.0 1.0");
+  GaussianDistribution d2("5.0 3.0", "1.0 0.2; 0.2 1.0");
+  arma::mat allObservations(2, 500);
+  for (size_t i = 0; i < 500; ++i)
+    allObservations.col(i) = (((i / 25) % 2) == 0) ? d1.Random() : d2.Random();
+
+  data::Save("hmm_train_all_obs.csv", allObservations);
+  data::Save("hmm_train_seq1.csv", arma::mat(allObservations.cols(0, 299)));
+  data::Save("hmm_train_seq2.csv", arma::mat(allObservations.cols(300, 499)));
+  data::Save("hmm_train_lengths.csv", arma::Col<size_t>("300 200"));
+  {
+    std::ofstream f("hmm_train_seq_list.txt");
+    f << "hmm_train_seq1.csv" << std::endl << "hmm_train_seq2.csv" << std::endl;
+  }
+
+  SetInputParam("input_file", std::string("hmm_train_seq_list.txt"));
+  SetInputParam("batch", true);
+  SetInputParam("type", std::string("gaussian"));
+  SetInputParam("states", 2);
+  SetInputParam("seed", 5);
+
+  RUN_BINDING();
+
+  HMMModel h1 = *(params.Get<HMMModel*>("output_model"));
+
+  ResetSettings();
+
+  SetInputParam("input_file", std::string("hmm_train_all_obs.csv"));
+  SetInputParam("lengths_file", std::string("hmm_train_lengths.csv"));
+  SetInputParam("type", std::string("gaussian"));
+  SetInputParam("states", 2);
+  SetInputParam("seed", 5);
+
+  RUN_BINDING();
+
+  HMMModel h2 = *(params.Get<HMMModel*>("output_model"));
+
+  ApproximatelyEqual(h1, h2, 1e-3);
+
+  // Lengths that don't add up to the number of observations are an error.
+  ResetSettings();
+  data::Save("hmm_train_lengths.csv", arma::Col<size_t>("300 100"));
+  SetInputParam("input_file", std::string("hmm_train_all_obs.csv"));
+  SetInputParam("lengths_file", std::string("hmm_train_lengths.csv"));
+  SetInputParam("type", std::string("gaussian"));
+  SetInputParam("states", 2);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  remove("hmm_train_all_obs.csv");
+  remove("hmm_train_seq1.csv");
+  remove("hmm_train_seq2.csv");
+  remove("hmm_train_lengths.csv");
+  remove("hmm_train_seq_list.txt");
+}
+
 TEST_CASE_METHOD(HMMTrainMainTestFixture, "HMMTrainRetrainTest1",
                  "[HMMTrainMainTest][BindingTests]")
 {
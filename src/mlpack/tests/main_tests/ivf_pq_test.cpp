@@ -0,0 +1,189 @@
+/**
+ * @file tests/main_tests/ivf_pq_test.cpp
+ *
+ * Test RUN_BINDING() of ivf_pq_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ivf_pq/ivf_pq_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(IVFPQTestFixture);
+
+/**
+ * Check that output neighbors and distances have valid dimensions.
+ */
+TEST_CASE_METHOD(IVFPQTestFixture, "IVFPQOutputDimensionTest",
+                 "[IVFPQMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(4, 100);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 5);
+  SetInputParam("subspaces", (int) 2);
+  SetInputParam("centroids", (int) 16);
+
+  RUN_BINDING();
+
+  // Check the neighbors matrix has 6 points for each of the 100 input points.
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_rows == 6);
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_cols == 100);
+
+  // Check the distances matrix has 6 points for each of the 100 input points.
+  REQUIRE(params.Get<arma::mat>("distances").n_rows == 6);
+  REQUIRE(params.Get<arma::mat>("distances").n_cols == 100);
+
+  // Check the model.
+  IVFPQSearch<>* m = params.Get<IVFPQSearch<>*>("output_model");
+  REQUIRE(m->NumLists() == 5);
+  REQUIRE(m->NumSubspaces() == 2);
+  REQUIRE(m->NumCentroids() == 16);
+  REQUIRE(m->NumReferencePoints() == 100);
+}
+
+/**
+ * Ensure that invalid parameters are rejected.
+ */
+TEST_CASE_METHOD(IVFPQTestFixture, "IVFPQParamValidityTest",
+                 "[IVFPQMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(4, 100);
+
+  // Test for the number of nearest neighbors.
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) -1);
+  SetInputParam("lists", (int) 5);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Test for the number of lists.
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // Test for the number of centroids.
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 5);
+  SetInputParam("centroids", (int) 257);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // The dimensionality must be divisible by the number of subspaces.
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 5);
+  SetInputParam("subspaces", (int) 3);
+  SetInputParam("centroids", (int) 16);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  // There can't be more lists than points.
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 101);
+  SetInputParam("centroids", (int) 16);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Make sure only one of reference data or pre-trained model is passed, and
+ * that a query set is given with a pre-trained model.
+ */
+TEST_CASE_METHOD(IVFPQTestFixture, "IVFPQModelValidityTest",
+                 "[IVFPQMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(4, 100);
+
+  SetInputParam("reference", reference);
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 5);
+  SetInputParam("centroids", (int) 16);
+
+  RUN_BINDING();
+
+  IVFPQSearch<>* m = params.Get<IVFPQSearch<>*>("output_model");
+  params.Get<IVFPQSearch<>*>("output_model") = NULL;
+
+  SetInputParam("input_model", m);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  // Keep the model (it is cleaned when the fixture is destroyed).
+  ResetSettings();
+
+  // The reference set is not in the model, so a query set is required.
+  SetInputParam("input_model", m);
+  SetInputParam("k", (int) 6);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Check that saved model can be reused again.
+ */
+TEST_CASE_METHOD(IVFPQTestFixture, "IVFPQModelReuseTest",
+                 "[IVFPQMainTest][BindingTests]")
+{
+  arma::mat reference = arma::randu<arma::mat>(4, 100);
+  arma::mat query = arma::randu<arma::mat>(4, 40);
+
+  SetInputParam("reference", std::move(reference));
+  SetInputParam("query", query);
+  SetInputParam("k", (int) 6);
+  SetInputParam("lists", (int) 5);
+  SetInputParam("probes", (int) 2);
+  SetInputParam("centroids", (int) 16);
+
+  RUN_BINDING();
+
+  arma::Mat<size_t> neighbors = params.Get<arma::Mat<size_t>>("neighbors");
+  arma::mat distances = params.Get<arma::mat>("distances");
+
+  IVFPQSearch<>* m = params.Get<IVFPQSearch<>*>("output_model");
+  params.Get<IVFPQSearch<>*>("output_model") = NULL;
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input_model", m);
+  SetInputParam("query", std::move(query));
+  SetInputParam("k", (int) 6);
+  SetInputParam("probes", (int) 2);
+
+  RUN_BINDING();
+
+  // Check that initial query outputs and final outputs using saved model are
+  // same.
+  CheckMatrices(neighbors, params.Get<arma::Mat<size_t>>("neighbors"));
+  CheckMatrices(distances, params.Get<arma::mat>("distances"));
+}
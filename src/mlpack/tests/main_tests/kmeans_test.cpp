@@ -247,6 +247,65 @@ TEST_CASE_METHOD(KmTestFixture, "KmClusteringResultSizeCheck",
   REQUIRE(processedInput.n_rows == row+1);
 }
 
+/**
+ * Make sure the mini-batch algorithm gives results of the right size.
+ */
+TEST_CASE_METHOD(KmTestFixture, "KmMiniBatchSizeCheck",
+                 "[KmeansMainTest][BindingTests]")
+{
+  int c = 3;
+
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Unable to load train dataset vc2.csv!");
+
+  size_t row = inputData.n_rows;
+  size_t col = inputData.n_cols;
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("clusters", c);
+  SetInputParam("algorithm", std::string("minibatch"));
+  SetInputParam("max_iterations", (int) 50);
+  SetInputParam("allow_empty_clusters", true);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::mat>("output").n_cols == col);
+  REQUIRE(params.Get<arma::mat>("output").n_rows == row + 1);
+  REQUIRE(params.Get<arma::mat>("centroid").n_cols == (size_t) c);
+  REQUIRE(params.Get<arma::mat>("centroid").n_rows == row);
+}
+
+/**
+ * Make sure that k-means|| can be used, and that its parameters are checked.
+ */
+TEST_CASE_METHOD(KmTestFixture, "KmParallelInitializationTest",
+                 "[KmeansMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Unable to load train dataset vc2.csv!");
+
+  SetInputParam("input", inputData);
+  SetInputParam("clusters", (int) 4);
+  SetInputParam("kmeans_parallel", true);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::mat>("output").n_cols == inputData.n_cols);
+  REQUIRE(params.Get<arma::mat>("centroid").n_cols == 4);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("input", std::move(inputData));
+  SetInputParam("clusters", (int) 4);
+  SetInputParam("kmeans_parallel", true);
+  SetInputParam("rounds", (int) 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
 /**
  * Ensuring that absence of Number of Clusters is checked.
  */
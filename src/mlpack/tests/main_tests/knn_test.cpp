@@ -132,6 +132,54 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNRefModelTest",
   REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
 }
 
+/*
+ * Check that a single-precision model gives the same results as a
+ * double-precision model, up to the precision of a float.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNSinglePrecisionTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("k", (int) 5);
+
+  RUN_BINDING();
+
+  const arma::Mat<size_t> neighbors =
+      params.Get<arma::Mat<size_t>>("neighbors");
+  const arma::mat distances = params.Get<arma::mat>("distances");
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 5);
+  SetInputParam("precision", (string) "float");
+
+  RUN_BINDING();
+
+  const arma::mat& floatDistances = params.Get<arma::mat>("distances");
+  REQUIRE(floatDistances.n_rows == distances.n_rows);
+  REQUIRE(floatDistances.n_cols == distances.n_cols);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+    REQUIRE(floatDistances[i] == Approx(distances[i]).epsilon(1e-5));
+  REQUIRE(params.Get<arma::Mat<size_t>>("neighbors").n_elem ==
+      neighbors.n_elem);
+
+  // An invalid precision should throw an exception.
+  CleanMemory();
+  ResetSettings();
+
+  referenceData.randu(3, 100);
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 5);
+  SetInputParam("precision", (string) "half");
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
 /*
  * Check that we can't pass an invalid tree type.
  */
@@ -0,0 +1,175 @@
+/**
+ * @file tests/main_tests/xgboost_test.cpp
+ *
+ * Test RUN_BINDING() of xgboost_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+#include <mlpack/methods/xgboost/xgboost_main.cpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "main_test_fixture.hpp"
+
+#include "../catch.hpp"
+#include "../test_catch_tools.hpp"
+
+using namespace mlpack;
+
+BINDING_TEST_FIXTURE(XGBoostTestFixture);
+
+/**
+ * Check that the classifier gives one prediction and one column of
+ * probabilities for each test point.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostClassificationOutputTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load train dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  const size_t testSize = testData.n_cols;
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("test", std::move(testData));
+  SetInputParam("num_rounds", (int) 10);
+
+  RUN_BINDING();
+
+  REQUIRE(params.Get<arma::Row<size_t>>("predictions").n_cols == testSize);
+  REQUIRE(params.Get<arma::mat>("probabilities").n_cols == testSize);
+  REQUIRE(params.Get<arma::mat>("probabilities").n_rows == 3);
+  REQUIRE(params.Get<XGBoostModel*>("output_model")->regression == false);
+}
+
+/**
+ * Check that the regressor gives one predicted response for each test point,
+ * and that a saved model gives the same predictions.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostRegressionModelReuseTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData = arma::randu<arma::mat>(3, 500);
+  arma::rowvec responses = inputData.row(0) - 2 * inputData.row(2);
+  arma::mat testData = arma::randu<arma::mat>(3, 100);
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(responses));
+  SetInputParam("test", testData);
+  SetInputParam("num_rounds", (int) 20);
+
+  RUN_BINDING();
+
+  arma::rowvec predictions =
+      std::move(params.Get<arma::rowvec>("predicted_responses"));
+  REQUIRE(predictions.n_elem == 100);
+
+  XGBoostModel* m = params.Get<XGBoostModel*>("output_model");
+  REQUIRE(m->regression == true);
+  REQUIRE(m->regressor.NumTrees() == 20);
+  params.Get<XGBoostModel*>("output_model") = NULL;
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("test", std::move(testData));
+  SetInputParam("input_model", m);
+
+  RUN_BINDING();
+
+  CheckMatrices(predictions,
+      params.Get<arma::rowvec>("predicted_responses"));
+}
+
+/**
+ * Check that a validation set stops training early.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostEarlyStoppingTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  // The responses are pure noise, so the validation loss will stop improving
+  // after a few rounds.
+  arma::mat inputData = arma::randu<arma::mat>(3, 500);
+  arma::rowvec responses = arma::randn<arma::rowvec>(500);
+  arma::mat validationData = arma::randu<arma::mat>(3, 200);
+  arma::rowvec validationResponses = arma::randn<arma::rowvec>(200);
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(responses));
+  SetInputParam("validation", std::move(validationData));
+  SetInputParam("validation_responses", std::move(validationResponses));
+  SetInputParam("num_rounds", (int) 300);
+  SetInputParam("early_stopping_rounds", (int) 5);
+
+  RUN_BINDING();
+
+  XGBoostModel* m = params.Get<XGBoostModel*>("output_model");
+  REQUIRE(m->regressor.NumTrees() >= 1);
+  REQUIRE(m->regressor.NumTrees() < 300);
+}
+
+/**
+ * Make sure that both labels and responses cannot be given.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostLabelsAndResponsesTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData = arma::randu<arma::mat>(3, 100);
+  arma::Row<size_t> labels(100, arma::fill::zeros);
+  labels.tail(50).fill(1);
+  arma::rowvec responses = arma::randu<arma::rowvec>(100);
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("labels", std::move(labels));
+  SetInputParam("responses", std::move(responses));
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
+
+/**
+ * Make sure that invalid parameter values are reported.
+ */
+TEST_CASE_METHOD(XGBoostTestFixture, "XGBoostInvalidParametersTest",
+                 "[XGBoostMainTest][BindingTests]")
+{
+  arma::mat inputData = arma::randu<arma::mat>(3, 100);
+  arma::rowvec responses = arma::randu<arma::rowvec>(100);
+
+  SetInputParam("training", inputData);
+  SetInputParam("responses", responses);
+  SetInputParam("num_rounds", (int) 0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training", inputData);
+  SetInputParam("responses", responses);
+  SetInputParam("learning_rate", 0.0);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+
+  CleanMemory();
+  ResetSettings();
+
+  SetInputParam("training", std::move(inputData));
+  SetInputParam("responses", std::move(responses));
+  SetInputParam("subspace_dim", (int) 4);
+
+  REQUIRE_THROWS_AS(RUN_BINDING(), std::runtime_error);
+}
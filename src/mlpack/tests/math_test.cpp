@@ -1003,3 +1003,104 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * A quantile sketch is exact while it holds all of the values, and
+ * approximates the ranks of the quantiles of a large stream; merged sketches
+ * are as accurate.
+ */
+TEST_CASE("QuantileSketchTest", "[MathTest]")
+{
+  QuantileSketch small;
+  REQUIRE_THROWS_AS(small.Quantile(0.5), std::logic_error);
+  for (size_t i = 0; i < 101; ++i)
+    small.Insert(100.0 - i);
+
+  REQUIRE(small.Count() == 101);
+  REQUIRE(small.Quantile(0.0) == 0.0);
+  REQUIRE(small.Quantile(0.5) == 50.0);
+  REQUIRE(small.Quantile(1.0) == 100.0);
+  REQUIRE_THROWS_AS(small.Quantile(1.5), std::invalid_argument);
+
+  // The values are a permutation of 0, ..., n - 1, so the rank of a value is
+  // the value itself.
+  const size_t n = 100000;
+  const arma::uvec values = arma::randperm<arma::uvec>(n);
+  QuantileSketch sketch, first, second;
+  for (size_t i = 0; i < n; ++i)
+  {
+    sketch.Insert(values[i]);
+    if (i < n / 3)
+      first.Insert(values[i]);
+    else
+      second.Insert(values[i]);
+  }
+  first.Merge(second);
+
+  REQUIRE(sketch.Count() == n);
+  REQUIRE(first.Count() == n);
+  REQUIRE(sketch.Size() < 1000);
+  REQUIRE(first.Size() < 1000);
+  for (double q = 0.1; q < 1.0; q += 0.1)
+  {
+    REQUIRE(std::abs(sketch.Quantile(q) - q * (n - 1)) < 0.02 * n);
+    REQUIRE(std::abs(first.Quantile(q) - q * (n - 1)) < 0.02 * n);
+  }
+}
+
+/**
+ * The one-pass statistics must match the statistics computed directly, and
+ * must not depend on how the points are split into chunks.
+ */
+TEST_CASE("DescriptiveStatisticsTest", "[MathTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(3, 10000);
+  data.row(1) = arma::exp(data.row(1));
+  data.row(2) += 5.0;
+
+  DescriptiveStatistics stats;
+  stats.Update(data.cols(0, 2999));
+  stats.Update(data.cols(3000, 9999));
+
+  DescriptiveStatistics other(3);
+  other.Update(data);
+
+  REQUIRE(stats.Count() == 10000);
+  REQUIRE(stats.Dimensionality() == 3);
+  CheckMatrices(stats.Mean(), arma::mean(data, 1));
+  CheckMatrices(stats.Min(), arma::min(data, 1));
+  CheckMatrices(stats.Max(), arma::max(data, 1));
+  CheckMatrices(stats.Variance(), arma::var(data, 0, 1));
+  CheckMatrices(stats.Variance(true), arma::var(data, 1, 1));
+  CheckMatrices(other.Mean(), stats.Mean());
+  CheckMatrices(other.Kurtosis(), stats.Kurtosis());
+
+  for (size_t d = 0; d < 3; ++d)
+  {
+    const arma::rowvec x = data.row(d);
+    const double n = x.n_elem;
+    const arma::rowvec centered = x - arma::mean(x);
+    const double m2 = arma::accu(arma::pow(centered, 2));
+    const double m3 = arma::accu(arma::pow(centered, 3));
+    const double m4 = arma::accu(arma::pow(centered, 4));
+
+    REQUIRE(stats.Skewness(true)[d] ==
+        Approx((m3 / n) / std::pow(m2 / n, 1.5)).epsilon(1e-7));
+    REQUIRE(stats.Kurtosis(true)[d] ==
+        Approx(n * m4 / (m2 * m2) - 3).epsilon(1e-7));
+
+    const double s = std::sqrt(m2 / (n - 1));
+    REQUIRE(stats.Skewness()[d] ==
+        Approx(n * m3 / ((n - 1) * (n - 2) * std::pow(s, 3))).epsilon(1e-7));
+
+    // The median has a small rank error.
+    const arma::rowvec sorted = arma::sort(x);
+    const double median = stats.Median()[d];
+    const size_t rank = std::lower_bound(sorted.begin(), sorted.end(),
+        median) - sorted.begin();
+    REQUIRE(std::abs((double) rank - n / 2) < 0.02 * n);
+  }
+
+  REQUIRE_THROWS_AS(stats.Update(arma::mat(2, 10, arma::fill::randu)),
+      std::invalid_argument);
+}
@@ -86,6 +86,39 @@ TEST_CASE("MeanShiftSimpleTest", "[MeanShiftTest]")
     REQUIRE(assignments(i) == thirdClass);
 }
 
+/**
+ * Make sure the same clusters are found on the 30-point dataset when every
+ * point is used as a seed, so that many seeds move to the same centroids.
+ */
+TEST_CASE("MeanShiftNoSeedsTest", "[MeanShiftTest]")
+{
+  MeanShift<> meanShift(2.0);
+
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  meanShift.Cluster((arma::mat) trans(meanShiftData), assignments, centroids,
+      true, false);
+
+  REQUIRE(centroids.n_cols == 3);
+
+  // No two centroids may be within the radius of each other.
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+    for (size_t j = i + 1; j < centroids.n_cols; ++j)
+      REQUIRE(EuclideanDistance::Evaluate(centroids.col(i),
+          centroids.col(j)) >= 2.0);
+
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments(i) == assignments(0));
+  for (size_t i = 14; i < 20; ++i)
+    REQUIRE(assignments(i) == assignments(13));
+  for (size_t i = 21; i < 30; ++i)
+    REQUIRE(assignments(i) == assignments(20));
+
+  REQUIRE(assignments(0) != assignments(13));
+  REQUIRE(assignments(0) != assignments(20));
+  REQUIRE(assignments(13) != assignments(20));
+}
+
 // Generate samples from four Gaussians, and make sure mean shift nearly
 // recovers those four centers.
 TEST_CASE("GaussianClustering", "[MeanShiftTest]")
@@ -276,3 +276,110 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * Test NMS on many random boxes: no two selected boxes may overlap by more
+ * than the threshold, and every box that is not selected must overlap a
+ * selected box with a higher confidence score by more than the threshold.
+ */
+TEST_CASE("NMSManyBoxesTest", "[MetricTest]")
+{
+  const size_t n = 2000;
+  arma::mat bbox(4, n);
+  bbox.rows(0, 1) = 100.0 * arma::randu<arma::mat>(2, n);
+  bbox.rows(2, 3) = bbox.rows(0, 1) + 1.0 + 10.0 * arma::randu<arma::mat>(2,
+      n);
+  arma::vec confidenceScores = arma::randu<arma::vec>(n);
+  const double threshold = 0.3;
+
+  arma::uvec selectedIndices;
+  NMS<true>::Evaluate(bbox, confidenceScores, selectedIndices, threshold);
+  REQUIRE(selectedIndices.n_elem > 0);
+
+  auto iou = [&](const size_t a, const size_t b)
+  {
+    const double w = std::max(std::min(bbox(2, a), bbox(2, b)) -
+        std::max(bbox(0, a), bbox(0, b)), 0.0);
+    const double h = std::max(std::min(bbox(3, a), bbox(3, b)) -
+        std::max(bbox(1, a), bbox(1, b)), 0.0);
+    const double areaA = (bbox(2, a) - bbox(0, a)) * (bbox(3, a) - bbox(1, a));
+    const double areaB = (bbox(2, b) - bbox(0, b)) * (bbox(3, b) - bbox(1, b));
+    return w * h / (areaA + areaB - w * h);
+  };
+
+  std::vector<bool> isSelected(n, false);
+  for (size_t i = 0; i < selectedIndices.n_elem; ++i)
+  {
+    isSelected[selectedIndices[i]] = true;
+    // Selected boxes are in descending order of confidence.
+    if (i > 0)
+    {
+      REQUIRE(confidenceScores[selectedIndices[i - 1]] >=
+          confidenceScores[selectedIndices[i]]);
+    }
+
+    for (size_t j = 0; j < i; ++j)
+      REQUIRE(iou(selectedIndices[i], selectedIndices[j]) <= threshold);
+  }
+
+  for (size_t b = 0; b < n; ++b)
+  {
+    if (isSelected[b])
+      continue;
+
+    bool overlaps = false;
+    for (size_t i = 0; i < selectedIndices.n_elem && !overlaps; ++i)
+    {
+      overlaps = (confidenceScores[selectedIndices[i]] >= confidenceScores[b])
+          && (iou(selectedIndices[i], b) > threshold);
+    }
+
+    REQUIRE(overlaps);
+  }
+}
+
+/**
+ * Test the BLEU score of a large corpus, whose paragraphs are processed in
+ * parallel, is the same as that of the paragraphs it repeats.
+ */
+TEST_CASE("BLEUScoreLargeCorpusTest", "[MetricTest]")
+{
+  typedef typename std::vector<std::string> WordVector;
+  std::vector<std::vector<WordVector>> referenceCorpus
+      = {{{"this", "is", "my", "house"},
+          {"this", "is", "my", "car"}},
+
+         {{"a", "cat", "is", "on", "the", "mat", "the", "mat"},
+          {"there", "is", "a", "cat", "on", "the", "mat"}}};
+
+  std::vector<WordVector> translationCorpus
+      = {{"this", "is", "my", "car"},
+         {"the", "the", "cat", "is", "on", "the", "mat"}};
+
+  BLEU<double> bleu(4);
+  bleu.Evaluate(referenceCorpus, translationCorpus, true);
+  const double score = bleu.BLEUScore();
+  const std::vector<double> precisions = bleu.Precisions();
+  // The words "the" appear at most twice in one reference, so only two of the
+  // three in the translation match.
+  REQUIRE(precisions[0] == Approx((4.0 + 6.0 + 1.0) / (11.0 + 1.0)));
+
+  std::vector<std::vector<WordVector>> largeReferenceCorpus;
+  std::vector<WordVector> largeTranslationCorpus;
+  for (size_t i = 0; i < 500; ++i)
+  {
+    largeReferenceCorpus.insert(largeReferenceCorpus.end(),
+        referenceCorpus.begin(), referenceCorpus.end());
+    largeTranslationCorpus.insert(largeTranslationCorpus.end(),
+        translationCorpus.begin(), translationCorpus.end());
+  }
+
+  // Without smoothing the precisions only depend on the ratios of the counts.
+  bleu.Evaluate(referenceCorpus, translationCorpus);
+  const double unsmoothedScore = bleu.BLEUScore();
+  bleu.Evaluate(largeReferenceCorpus, largeTranslationCorpus);
+  REQUIRE(bleu.BLEUScore() == Approx(unsmoothedScore).epsilon(1e-10));
+  REQUIRE(bleu.TranslationLength() == 500 * 11);
+  REQUIRE(bleu.ReferenceLength() == 500 * 11);
+  REQUIRE(score > 0.0);
+}
@@ -498,3 +498,128 @@ TEMPLATE_TEST_CASE("NBCModelMatTypeTest", "[NBCTest]", float, double)
   REQUIRE(nbc.Variances().n_rows == data.n_rows);
   REQUIRE(nbc.Variances().n_cols == 4);
 }
+
+/**
+ * Make sure that non-incremental training, which is done in blocks, gives the
+ * same model as a direct computation, and that the class probabilities match
+ * the Gaussian densities of the model.
+ */
+TEST_CASE("NBCBlockTrainingTest", "[NBCTest]")
+{
+  // Use enough points that there are several blocks.
+  arma::mat data(4, 10000, arma::fill::randu);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    labels[i] = (i * 7) % 3;
+    data.col(i) += 2.0 * labels[i];
+  }
+
+  NaiveBayesClassifier<> nbc(data, labels, 3, false);
+
+  for (size_t c = 0; c < 3; ++c)
+  {
+    const arma::uvec indices = arma::find(labels == c);
+    const arma::mat classData = data.cols(indices);
+    const arma::vec expectedMeans = arma::mean(classData, 1);
+    const arma::vec expectedVariances = arma::var(classData, 0, 1);
+
+    REQUIRE(nbc.Probabilities()[c] ==
+        Approx(double(indices.n_elem) / data.n_cols).epsilon(1e-10));
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      REQUIRE(nbc.Means()(d, c) == Approx(expectedMeans[d]).epsilon(1e-10));
+      REQUIRE(nbc.Variances()(d, c) ==
+          Approx(expectedVariances[d] + 1e-10).epsilon(1e-10));
+    }
+  }
+
+  arma::mat testData(4, 2000, arma::fill::randu);
+  testData *= 6.0;
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  nbc.Classify(testData, predictions, probabilities);
+
+  for (size_t i = 0; i < testData.n_cols; ++i)
+  {
+    arma::vec logLikelihoods(3);
+    for (size_t c = 0; c < 3; ++c)
+    {
+      logLikelihoods[c] = std::log(nbc.Probabilities()[c]) - 0.5 *
+          arma::accu(arma::log(2 * M_PI * nbc.Variances().col(c)) +
+          arma::square(testData.col(i) - nbc.Means().col(c)) /
+          nbc.Variances().col(c));
+    }
+
+    const arma::vec expected = arma::exp(logLikelihoods -
+        logLikelihoods.max()) / arma::accu(arma::exp(logLikelihoods -
+        logLikelihoods.max()));
+
+    REQUIRE(predictions[i] == logLikelihoods.index_max());
+    for (size_t c = 0; c < 3; ++c)
+      REQUIRE(probabilities(c, i) == Approx(expected[c]).margin(1e-8));
+  }
+}
+
+/**
+ * Make sure that delta checkpoints of the classifier can be applied to a copy,
+ * and that a delta after training on a few points is smaller than the model.
+ */
+TEST_CASE("NaiveBayesClassifierDeltaCheckpointTest", "[NBCTest]")
+{
+  arma::mat data(20, 1000, arma::fill::randu);
+  arma::Row<size_t> labels =
+      arma::randi<arma::Row<size_t>>(1000, arma::distr_param(0, 9));
+
+  NaiveBayesClassifier<> nbc(data, labels, 10, true);
+
+  // The first checkpoint holds the whole model.
+  std::ostringstream baseStream;
+  {
+    cereal::BinaryOutputArchive boa(baseStream);
+    nbc.SaveDelta(boa);
+  }
+
+  NaiveBayesClassifier<> copy;
+  {
+    std::istringstream iss(baseStream.str());
+    cereal::BinaryInputArchive bia(iss);
+    copy.LoadDelta(bia);
+  }
+
+  // Now train on a few points of two classes only.
+  arma::mat points(20, 10, arma::fill::randu);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    nbc.Train(points.col(i), (i % 2 == 0) ? 3 : 7);
+
+  std::ostringstream deltaStream;
+  {
+    cereal::BinaryOutputArchive boa(deltaStream);
+    nbc.SaveDelta(boa);
+  }
+
+  REQUIRE(deltaStream.str().size() < baseStream.str().size());
+
+  {
+    std::istringstream iss(deltaStream.str());
+    cereal::BinaryInputArchive bia(iss);
+    copy.LoadDelta(bia);
+  }
+
+  const NaiveBayesClassifier<>& constNBC = nbc;
+  const NaiveBayesClassifier<>& constCopy = copy;
+  REQUIRE(constCopy.TrainingPoints() == constNBC.TrainingPoints());
+  REQUIRE(arma::approx_equal(constCopy.Means(), constNBC.Means(), "absdiff",
+      1e-12));
+  REQUIRE(arma::approx_equal(constCopy.Variances(), constNBC.Variances(),
+      "absdiff", 1e-12));
+  REQUIRE(arma::approx_equal(constCopy.Probabilities(),
+      constNBC.Probabilities(), "absdiff", 1e-12));
+
+  // A delta cannot be applied to a model of a different size.
+  NaiveBayesClassifier<> other(20, 5);
+
+  std::istringstream iss(deltaStream.str());
+  cereal::BinaryInputArchive bia(iss);
+  REQUIRE_THROWS_AS(other.LoadDelta(bia), std::runtime_error);
+}
@@ -351,3 +351,80 @@ TEMPLATE_TEST_CASE("NCALBFGSSimpleDataset", "[NCATest]", float, double)
   // norm is close to 0.
   REQUIRE(arma::norm(finalGradient, 2) < 1e-5);
 }
+
+/**
+ * With all other points as candidates, the softmax error function restricted
+ * to candidates should give the exact objective and gradient.
+ */
+TEMPLATE_TEST_CASE("SoftmaxAllCandidates", "[NCATest]", float, double)
+{
+  typedef TestType eT;
+
+  arma::Mat<eT> data(3, 40, arma::fill::randu);
+  arma::Row<size_t> labels(40);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = i % 2;
+
+  arma::Mat<eT> coordinates(3, 3, arma::fill::randu);
+  coordinates += arma::eye<arma::Mat<eT>>(3, 3);
+
+  SoftmaxErrorFunction<arma::Mat<eT>, arma::Row<size_t>,
+      SquaredEuclideanDistance> sef(data, labels);
+  const eT tolerance = std::is_same<eT, float>::value ? 1e-3 : 1e-8;
+
+  for (size_t random = 0; random < 2; ++random)
+  {
+    SoftmaxErrorFunction<arma::Mat<eT>, arma::Row<size_t>,
+        SquaredEuclideanDistance> csef(data, labels,
+        SquaredEuclideanDistance(), 39, (random == 1));
+    REQUIRE(csef.Candidates().n_rows == 39);
+    REQUIRE(csef.Candidates().n_cols == 40);
+
+    REQUIRE(csef.Evaluate(coordinates) ==
+        Approx(sef.Evaluate(coordinates)).epsilon(tolerance));
+
+    arma::Mat<eT> gradient, candidateGradient;
+    sef.Gradient(coordinates, gradient);
+    csef.Gradient(coordinates, candidateGradient);
+    REQUIRE(arma::approx_equal(gradient, candidateGradient, "absdiff",
+        10 * tolerance));
+
+    // Check a mini-batch too.
+    REQUIRE(csef.Evaluate(coordinates, 5, 7) ==
+        Approx(sef.Evaluate(coordinates, 5, 7)).epsilon(tolerance));
+    sef.Gradient(coordinates, 5, gradient, 7);
+    csef.Gradient(coordinates, 5, candidateGradient, 7);
+    REQUIRE(arma::approx_equal(gradient, candidateGradient, "absdiff",
+        10 * tolerance));
+  }
+}
+
+/**
+ * NCA with the softmax restricted to the nearest neighbors should still solve
+ * a simple problem.
+ */
+TEST_CASE("NCACandidatesLBFGSDataset", "[NCATest]")
+{
+  // Two classes, which are only separated along the first dimension.
+  arma::mat data(2, 200, arma::fill::randu);
+  data.row(1) *= 10.0;
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 2;
+    data(0, i) += 2.0 * labels[i];
+  }
+
+  L_BFGS lbfgs;
+  lbfgs.MaxIterations() = 50;
+
+  arma::mat outputMatrix;
+  NCA nca;
+  nca.NumCandidates() = 20;
+  nca.LearnDistance(data, labels, outputMatrix, lbfgs);
+
+  // The exact objective should improve.
+  SoftmaxErrorFunction<> sef(data, labels);
+  REQUIRE(sef.Evaluate(outputMatrix) <
+      sef.Evaluate(arma::eye<arma::mat>(2, 2)));
+}
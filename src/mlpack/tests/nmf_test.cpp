@@ -13,6 +13,7 @@
 #include <mlpack/methods/nmf.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace std;
 using namespace arma;
@@ -240,6 +241,41 @@ TEST_CASE("SparseNMFALSTest", "[NMFTest]")
   REQUIRE(success == true);
 }
 
+/**
+ * Check that the divergence update rules give the same factorization for a
+ * sparse matrix as for its dense copy, since the quotient V / (W H) is only
+ * computed at the nonzero elements for sparse matrices.
+ */
+TEST_CASE("SparseNMFRandomDivTest", "[NMFTest]")
+{
+  sp_mat v;
+  v.sprandu(40, 30, 0.2);
+  // Ensure there is at least one nonzero element in every row and column.
+  for (size_t i = 0; i < 30; ++i)
+  {
+    v(i, i) += 0.01;
+    v(i + 10, i) += 0.01;
+  }
+  mat dv(v);
+  const size_t r = 5;
+
+  // Get an initialization.
+  mat iw, ih;
+  RandomAcolInitialization<>::Initialize(v, r, iw, ih);
+  GivenInitialization<> g(iw, ih);
+
+  mat w, h, dw, dh;
+  AMF<MaxIterationTermination, GivenInitialization<>,
+      NMFMultiplicativeDivergenceUpdate> nmf(MaxIterationTermination(100), g);
+  nmf.Apply(v, r, w, h);
+  nmf.Apply(dv, r, dw, dh);
+
+  REQUIRE(w.is_finite());
+  REQUIRE(h.is_finite());
+  CheckMatrices(w, dw, 1e-3);
+  CheckMatrices(h, dh, 1e-3);
+}
+
 /**
  * Check if all elements in W and H are non-negative.
  * Default Case.
@@ -193,3 +193,42 @@ TEST_CASE("GermanTest", "[NystroemMethodTest]")
     REQUIRE(avgError == Approx(0.0).margin(results[trial]));
   }
 }
+
+/**
+ * Transforming the points given to the constructor should give the output of
+ * Apply(), and for new points G_new * G^T should approximate the kernel between
+ * the new points and the data.
+ */
+TEST_CASE("NystroemTransformTest", "[NystroemMethodTest]")
+{
+  arma::mat data(5, 200, arma::fill::randu);
+  arma::mat newData(5, 20, arma::fill::randu);
+
+  // A small bandwidth keeps the mini-kernel matrix well-conditioned.
+  GaussianKernel gk(0.3);
+  NystroemMethod<GaussianKernel, OrderedSelection> nm(data, gk, 200);
+
+  arma::mat g;
+  REQUIRE_THROWS_AS(nm.Transform(newData, g), std::logic_error);
+  nm.Apply(g);
+
+  REQUIRE(nm.Landmarks().n_cols == 200);
+  REQUIRE(nm.Projection().n_rows == 200);
+  REQUIRE(nm.Projection().n_cols == 200);
+
+  arma::mat output;
+  nm.Transform(data, output);
+  REQUIRE(arma::approx_equal(output, g, "absdiff", 1e-8));
+
+  // With all of the points selected, the approximation is (almost) exact.
+  nm.Transform(newData, output);
+  const arma::mat approximation = output * g.t();
+  for (size_t i = 0; i < newData.n_cols; ++i)
+  {
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      REQUIRE(approximation(i, j) ==
+          Approx(gk.Evaluate(newData.col(i), data.col(j))).margin(1e-5));
+    }
+  }
+}
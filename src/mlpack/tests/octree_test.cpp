@@ -341,3 +341,115 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Make sure the radix sort of Morton codes is a stable sort.
+ */
+TEST_CASE("OctreeRadixSortTest", "[OctreeTest]")
+{
+  std::vector<uint64_t> codes(50000);
+  for (size_t i = 0; i < codes.size(); ++i)
+    codes[i] = ((uint64_t) RandInt(1 << 30) << 20) | RandInt(1000);
+
+  std::vector<size_t> indices(codes.size());
+  std::vector<std::pair<uint64_t, size_t>> pairs(codes.size());
+  for (size_t i = 0; i < codes.size(); ++i)
+  {
+    indices[i] = i;
+    pairs[i] = std::make_pair(codes[i], i);
+  }
+
+  details::RadixSortCodes(codes, indices, 50);
+  std::sort(pairs.begin(), pairs.end());
+
+  for (size_t i = 0; i < codes.size(); ++i)
+  {
+    REQUIRE(codes[i] == pairs[i].first);
+    REQUIRE(indices[i] == pairs[i].second);
+  }
+}
+
+/**
+ * Build an octree large enough to be built in parallel, and make sure that
+ * every node holds exactly the points of its children, that every point is in
+ * the half of its parent's cube that its child index says it is, and that the
+ * mappings are right.
+ */
+template<typename TreeType>
+void CheckOctreeCells(TreeType& node,
+                      const arma::vec& center,
+                      const double width)
+{
+  const double childWidth = width / 2.0;
+  size_t begin = node.Descendant(0);
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    TreeType& child = node.Child(i);
+    REQUIRE(child.Descendant(0) == begin);
+    begin += child.NumDescendants();
+
+    // All points of the child must be on the same side of the center.
+    arma::vec childCenter(center.n_elem);
+    const arma::vec first = node.Dataset().col(child.Descendant(0));
+    for (size_t d = 0; d < center.n_elem; ++d)
+    {
+      const bool upper = (first[d] >= center[d]);
+      childCenter[d] = upper ? center[d] + childWidth / 2.0 :
+          center[d] - childWidth / 2.0;
+      for (size_t j = 0; j < child.NumDescendants(); ++j)
+      {
+        const double x = node.Dataset()(d, child.Descendant(j));
+        REQUIRE((x >= center[d]) == upper);
+      }
+    }
+
+    CheckOctreeCells(child, childCenter, childWidth);
+  }
+
+  if (node.NumChildren() > 0)
+    REQUIRE(begin == node.Descendant(0) + node.NumDescendants());
+}
+
+TEST_CASE("OctreeParallelBuildTest", "[OctreeTest]")
+{
+  // Use coordinates that are exact in binary, so that the cells of the Morton
+  // codes are exactly the halves of the nodes.
+  arma::mat dataset = arma::floor(arma::randu<arma::mat>(3, 60000) * 1024.0);
+  dataset.col(0).zeros();
+  dataset.col(1).fill(1024.0);
+  std::vector<size_t> oldFromNew;
+
+  Octree<> t(dataset, oldFromNew, 10);
+
+  REQUIRE(t.NumDescendants() == dataset.n_cols);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    REQUIRE(arma::approx_equal(dataset.col(oldFromNew[i]),
+        t.Dataset().col(i), "absdiff", 1e-10));
+
+  arma::vec center(3);
+  center.fill(512.0);
+  CheckOctreeCells(t, center, 1024.0);
+  CheckOverlap(t);
+}
+
+/**
+ * Building an octree on many copies of the same point must terminate, with all
+ * of the points in one leaf.
+ */
+TEST_CASE("OctreeDuplicatePointsTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 100);
+  dataset.col(0).fill(0.5);
+  for (size_t i = 1; i < 100; ++i)
+  {
+    if (i < 10)
+      dataset.col(i).randu();
+    else
+      dataset.col(i) = dataset.col(0);
+  }
+
+  Octree<> t(dataset, 5);
+
+  REQUIRE(t.NumDescendants() == 100);
+  CheckOverlap(t);
+}
@@ -229,3 +229,74 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that sparse one hot encoding gives the same result as dense one hot
+ * encoding.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat input(6, 1000);
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    for (size_t j = 0; j < input.n_cols; ++j)
+    {
+      // The encoded dimensions have many categories; the others are mostly
+      // zero.
+      input(i, j) = (i % 2 == 1) ? RandInt(200) :
+          ((RandInt(4) == 0) ? Random() : 0.0);
+    }
+  }
+
+  arma::Col<size_t> indices("1 3 5");
+  arma::mat output;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, output);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == output.n_rows);
+  REQUIRE(sparseOutput.n_cols == output.n_cols);
+  REQUIRE(sparseOutput.n_nonzero == (size_t) arma::accu(output != 0));
+  CheckMatrices(output, arma::mat(sparseOutput));
+}
+
+/**
+ * Test that separate batches mapped with the same DatasetInfo are encoded the
+ * same way, even if not all categories appear in each batch.
+ */
+TEST_CASE("OneHotEncodingDatasetInfoBatchTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, hello" << endl;
+  f << "2, goodbye" << endl;
+  f << "3, coffee" << endl;
+  f << "4, hello" << endl;
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test.csv", matrix, info))
+    FAIL("Cannot load dataset test.csv");
+  remove("test.csv");
+
+  arma::mat output;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, output, info);
+  data::OneHotEncoding(matrix, sparseOutput, info);
+  REQUIRE(output.n_rows == 4);
+  REQUIRE(output.n_cols == 4);
+  CheckMatrices(output, arma::mat(sparseOutput));
+
+  // The last point only has the first category, but it must still be encoded
+  // in all three.
+  arma::mat batchOutput;
+  data::OneHotEncoding(arma::mat(matrix.col(3)), batchOutput, info);
+  REQUIRE(batchOutput.n_rows == 4);
+  CheckMatrices(batchOutput, arma::mat(output.col(3)));
+
+  // A value that is not a category of the DatasetInfo is an error.
+  matrix(1, 0) = 3;
+  REQUIRE_THROWS_AS(data::OneHotEncoding(matrix, output, info),
+      std::invalid_argument);
+}
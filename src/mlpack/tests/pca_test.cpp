@@ -198,6 +198,17 @@ TEST_CASE("ArmaComparisonRandomizedPCATest", "[PCATest]")
   ArmaComparisonPCA<RandomizedSVDPCAPolicy>();
 }
 
+/**
+ * Compare the output of our streaming randomized-SVD PCA implementation with
+ * Armadillo's.
+ */
+TEST_CASE("ArmaComparisonStreamingRandomizedPCATest", "[PCATest]")
+{
+  // Use several blocks.
+  StreamingRandomizedSVDPolicy decomposition(10, 128);
+  ArmaComparisonPCA<StreamingRandomizedSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -227,6 +238,17 @@ TEST_CASE("RandomizedPCADimensionalityReductionTest", "[PCATest]")
   PCADimensionalityReduction<RandomizedSVDPCAPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with streaming randomized-svd PCA works
+ * the same way MATLAB does (which should be correct!).
+ */
+TEST_CASE("StreamingRandomizedPCADimensionalityReductionTest", "[PCATest]")
+{
+  StreamingRandomizedSVDPolicy decomposition(10, 2);
+  PCADimensionalityReduction<StreamingRandomizedSVDPolicy>(false,
+      decomposition);
+}
+
 /**
  * Test that dimensionality reduction with QUIC-SVD PCA works the same way
  * as the Exact-SVD PCA method.
@@ -335,7 +357,8 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
  * Test PCA on a subview of a matrix with different decomposition strategies.
  */
 TEMPLATE_TEST_CASE("PCASubviewTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    StreamingRandomizedSVDPolicy)
 {
   typedef TestType DecompositionPolicy;
 
@@ -382,7 +405,8 @@ TEMPLATE_TEST_CASE("PCASubviewTest", "[PCATest]", ExactSVDPolicy,
  * Test PCA on an input expression.
  */
 TEMPLATE_TEST_CASE("PCAExpressionTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    StreamingRandomizedSVDPolicy)
 {
   typedef TestType DecompositionPolicy;
 
@@ -429,7 +453,8 @@ TEMPLATE_TEST_CASE("PCAExpressionTest", "[PCATest]", ExactSVDPolicy,
  * Test PCA on 32-bit data.
  */
 TEMPLATE_TEST_CASE("PCAFloatTest", "[PCATest]", ExactSVDPolicy,
-    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy)
+    RandomizedSVDPCAPolicy, RandomizedBlockKrylovSVDPolicy, QUICSVDPolicy,
+    StreamingRandomizedSVDPolicy)
 {
   typedef TestType DecompositionPolicy;
 
@@ -507,3 +532,109 @@ TEMPLATE_TEST_CASE("PCASparseToDenseTest", "[PCATest]", float, double)
 
   REQUIRE(denseData2.n_rows == transformedDataset2.n_rows);
 }
+
+/**
+ * Test that IncrementalPCA with all the components gives the same result as
+ * PCA on all of the points.
+ */
+TEMPLATE_TEST_CASE("IncrementalPCAFullRankTest", "[PCATest]", ExactSVDPolicy,
+    RandomizedSVDPCAPolicy)
+{
+  typedef TestType DecompositionPolicy;
+
+  // Use distinct variances in each dimension, and a nonzero mean.
+  arma::mat data = arma::diagmat(arma::linspace<arma::vec>(1, 6, 6)) *
+      arma::randn<arma::mat>(6, 1000);
+  data.each_col() += arma::linspace<arma::vec>(-3, 3, 6);
+
+  IncrementalPCA<DecompositionPolicy> ipca(6);
+  for (size_t i = 0; i < 1000; i += 100)
+    ipca.Update(data.cols(i, i + 99));
+
+  REQUIRE(ipca.NumPoints() == 1000);
+
+  arma::mat transformed, eigvec;
+  arma::vec eigVal;
+  PCA<ExactSVDPolicy> pca;
+  pca.Apply(data, transformed, eigVal, eigvec);
+
+  REQUIRE(arma::approx_equal(ipca.Mean(), arma::vec(arma::mean(data, 1)),
+      "both", 1e-8, 1e-8));
+  const arma::vec ipcaEigVal = ipca.EigenValues();
+  REQUIRE(ipcaEigVal.n_elem == 6);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    REQUIRE(ipcaEigVal[i] == Approx(eigVal[i]).epsilon(1e-5));
+
+    // The components may have opposite signs.
+    REQUIRE(std::abs(arma::dot(ipca.Components().col(i), eigvec.col(i))) ==
+        Approx(1.0).epsilon(1e-5));
+  }
+
+  // The projections match up to sign.
+  arma::mat ipcaTransformed;
+  ipca.Transform(data, ipcaTransformed);
+  REQUIRE(arma::approx_equal(arma::abs(ipcaTransformed),
+      arma::abs(transformed), "both", 1e-4, 1e-4));
+}
+
+/**
+ * Test that IncrementalPCA recovers the subspace of low-rank data exactly,
+ * and rejects batches of the wrong dimensionality.
+ */
+TEST_CASE("IncrementalPCALowRankTest", "[PCATest]")
+{
+  arma::mat basis = arma::randn<arma::mat>(20, 3);
+  arma::mat data = basis * arma::randn<arma::mat>(3, 500);
+  data.each_col() += arma::randu<arma::vec>(20);
+
+  IncrementalPCA<> ipca(3);
+  for (size_t i = 0; i < 500; i += 50)
+    ipca.Update(data.cols(i, i + 49));
+
+  REQUIRE(ipca.Components().n_rows == 20);
+  REQUIRE(ipca.Components().n_cols == 3);
+
+  // Projecting the basis onto the components must not lose anything.
+  const arma::mat projected = ipca.Components() *
+      (ipca.Components().t() * basis);
+  REQUIRE(arma::norm(projected - basis, "fro") / arma::norm(basis, "fro") ==
+      Approx(0.0).margin(1e-8));
+
+  arma::mat centered = data.each_col() - arma::mean(data, 1);
+  arma::vec s = arma::svd(centered);
+  REQUIRE(arma::approx_equal(ipca.SingularValues(), arma::vec(s.head(3)),
+      "reldiff", 1e-8));
+
+  REQUIRE_THROWS_AS(ipca.Update(arma::mat(10, 5, arma::fill::randu)),
+      std::invalid_argument);
+}
+
+/**
+ * Test that a forgetting factor makes IncrementalPCA follow data that changes
+ * over time.
+ */
+TEST_CASE("IncrementalPCAForgetFactorTest", "[PCATest]")
+{
+  IncrementalPCA<> ipca(2, 0.5);
+  for (size_t i = 0; i < 20; ++i)
+    ipca.Update(arma::randn<arma::mat>(4, 100));
+
+  // Now the data moves, and varies mostly along the last dimension.
+  arma::vec newMean("10 10 10 10");
+  for (size_t i = 0; i < 20; ++i)
+  {
+    arma::mat batch = arma::randn<arma::mat>(4, 100);
+    batch.row(3) *= 10.0;
+    batch.each_col() += newMean;
+    ipca.Update(batch);
+  }
+
+  REQUIRE(ipca.NumPoints() == 4000);
+  REQUIRE(ipca.Weight() < 250.0);
+  // The last dimension has a much larger variance.
+  for (size_t d = 0; d < 3; ++d)
+    REQUIRE(std::abs(ipca.Mean()[d] - newMean[d]) < 0.5);
+  REQUIRE(std::abs(ipca.Mean()[3] - newMean[3]) < 3.0);
+  REQUIRE(std::abs(ipca.Components()(3, 0)) > 0.99);
+}
@@ -363,3 +363,119 @@ TEST_CASE("TrainFormTest", "[PerceptronTest]")
   REQUIRE(all(predictions5 == trueLabels));
   REQUIRE(all(predictions6 == trueLabels));
 }
+
+/**
+ * Make sure that classifying raw memory gives the same predictions as
+ * classifying a matrix.
+ */
+TEST_CASE("PerceptronRawClassifyTest", "[PerceptronTest]")
+{
+  mat trainData(5, 200, fill::randn);
+  Row<size_t> labels(200);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 4;
+    trainData(labels[i], i) += 3.0;
+  }
+
+  Perceptron<> p(trainData, labels, 4);
+
+  mat testData(5, 50, fill::randn);
+  Row<size_t> predictions;
+  p.Classify(testData, predictions);
+
+  Row<size_t> rawPredictions(testData.n_cols);
+  p.Classify(testData.memptr(), testData.n_cols, rawPredictions.memptr());
+  REQUIRE(all(predictions == rawPredictions));
+
+  // Classify a single point.
+  size_t prediction;
+  p.Classify(testData.colptr(3), 1, &prediction);
+  REQUIRE(prediction == predictions[3]);
+}
+
+/**
+ * Make sure that the blocked training gives the same model as training one
+ * point at a time, with and without averaging the weights.
+ */
+TEST_CASE("PerceptronAveragedTrainingTest", "[PerceptronTest]")
+{
+  // Random labels, so that training does not converge.
+  const size_t numClasses = 3;
+  mat trainData(6, 700, fill::randn);
+  Row<size_t> labels = randi<Row<size_t>>(700, distr_param(0, 2));
+  const size_t maxIterations = 3;
+
+  // Train one point at a time, keeping the sum of the weights after each
+  // point.
+  mat weights(6, numClasses, fill::zeros), weightsSum(6, numClasses,
+      fill::zeros);
+  vec biases(numClasses, fill::zeros), biasesSum(numClasses, fill::zeros);
+  SimpleWeightUpdate update;
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    for (size_t j = 0; j < trainData.n_cols; ++j)
+    {
+      vec scores = weights.t() * trainData.col(j) + biases;
+      const size_t predictedClass = scores.index_max();
+      if (predictedClass != labels[j])
+      {
+        update.UpdateWeights(trainData.col(j), weights, biases,
+            predictedClass, labels[j]);
+      }
+
+      weightsSum += weights;
+      biasesSum += biases;
+    }
+  }
+
+  Perceptron<> p(numClasses, 6, maxIterations);
+  p.Train(trainData, labels, numClasses);
+  REQUIRE(approx_equal(p.Weights(), weights, "absdiff", 1e-8));
+  REQUIRE(approx_equal(p.Biases(), biases, "absdiff", 1e-8));
+
+  const size_t pointsSeen = maxIterations * trainData.n_cols;
+  Perceptron<> averaged(numClasses, 6, maxIterations);
+  averaged.Average() = true;
+  averaged.Train(trainData, labels, numClasses);
+  REQUIRE(approx_equal(averaged.Weights(), weightsSum / pointsSeen, "absdiff",
+      1e-8));
+  REQUIRE(approx_equal(averaged.Biases(), biasesSum / pointsSeen, "absdiff",
+      1e-8));
+}
+
+/**
+ * Make sure that training on sparse data gives the same model as training on
+ * the same data stored in a dense matrix.
+ */
+TEST_CASE("PerceptronSparseTrainingTest", "[PerceptronTest]")
+{
+  sp_mat sparseData;
+  sparseData.sprandu(50, 600, 0.1);
+  mat data(sparseData);
+  Row<size_t> labels(600);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 3;
+    sparseData(labels[i], i) += 2.0;
+    data(labels[i], i) += 2.0;
+  }
+
+  Perceptron<> p(0, 0, 20);
+  p.Average() = true;
+  p.Train(data, labels, 3);
+
+  Perceptron<SimpleWeightUpdate, ZeroInitialization, sp_mat> sparseP(0, 0,
+      20);
+  sparseP.Average() = true;
+  sparseP.Train(sparseData, labels, 3);
+
+  REQUIRE(approx_equal(p.Weights(), sparseP.Weights(), "absdiff", 1e-8));
+  REQUIRE(approx_equal(p.Biases(), sparseP.Biases(), "absdiff", 1e-8));
+
+  Row<size_t> predictions, sparsePredictions;
+  p.Classify(data, predictions);
+  sparseP.Classify(sparseData, sparsePredictions);
+  REQUIRE(all(predictions == sparsePredictions));
+  REQUIRE(accu(predictions == labels) > 500);
+}
@@ -395,3 +395,49 @@ TEST_CASE("SACForMultipleActions", "[PolicyGradientTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+//! Test that TD3 trains with decoupled actors and learner.
+TEST_CASE("TD3ActorLearner", "[PolicyGradientTest]")
+{
+  FFN<EmptyLoss, GaussianInitialization>
+      policyNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear(32));
+  policyNetwork.Add(new ReLU());
+  policyNetwork.Add(new Linear(1));
+  policyNetwork.Add(new TanH());
+
+  FFN<EmptyLoss, GaussianInitialization>
+      qNetwork(EmptyLoss(), GaussianInitialization(0, 0.1));
+  qNetwork.Add(new Linear(32));
+  qNetwork.Add(new ReLU());
+  qNetwork.Add(new Linear(1));
+
+  RandomReplay<Pendulum> replayMethod(32, 10000);
+
+  TrainingConfig config;
+  config.StepSize() = 0.001;
+  config.TargetNetworkSyncInterval() = 1;
+  config.ExplorationSteps() = 100;
+
+  TD3<Pendulum, decltype(qNetwork), decltype(policyNetwork), AdamUpdate>
+      agent(config, qNetwork, policyNetwork, replayMethod);
+  const arma::mat initialParameters = policyNetwork.Parameters();
+
+  // Three actors take 1000 steps in total, so they complete several episodes
+  // of 200 steps.
+  const double averageReturn = agent.TrainActorLearner(3, 1000, 5);
+
+  REQUIRE(agent.TotalSteps() == 1000);
+  REQUIRE(replayMethod.Size() == 1000);
+  REQUIRE(averageReturn < 0.0);
+
+  // The learner must have updated the policy network.
+  REQUIRE(arma::norm(policyNetwork.Parameters() - initialParameters) > 0.0);
+
+  // Several actors can't share an n-step replay.
+  RandomReplay<Pendulum> nStepReplay(32, 10000, 3);
+  TD3<Pendulum, decltype(qNetwork), decltype(policyNetwork), AdamUpdate>
+      nStepAgent(config, qNetwork, policyNetwork, nStepReplay);
+  REQUIRE_THROWS_AS(nStepAgent.TrainActorLearner(2, 100),
+      std::invalid_argument);
+}
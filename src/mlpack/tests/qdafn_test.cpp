@@ -140,6 +140,38 @@ TEST_CASE("QDAFNMultipleNeighbors", "[QDAFNTest]")
   }
 }
 
+/**
+ * Make sure that the returned distances are the distances to the returned
+ * neighbors, in decreasing order.
+ */
+TEST_CASE("QDAFNDistancesMatchNeighbors", "[QDAFNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(10, 500);
+  arma::mat querySet = arma::randu<arma::mat>(10, 200);
+
+  QDAFN<> qdafn(referenceSet, 10, 40);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  qdafn.Search(querySet, 5, neighbors, distances);
+
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      REQUIRE(neighbors(j, i) < referenceSet.n_cols);
+      const double dist = EuclideanDistance::Evaluate(querySet.col(i),
+          referenceSet.col(neighbors(j, i)));
+      REQUIRE(distances(j, i) == Approx(dist).epsilon(1e-7));
+      if (j > 0)
+      {
+        REQUIRE(neighbors(j, i) != neighbors(j - 1, i));
+        REQUIRE(distances(j, i) <= distances(j - 1, i));
+      }
+    }
+  }
+}
+
 /**
  * Test re-training method.
  */
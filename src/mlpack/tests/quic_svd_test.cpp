@@ -14,6 +14,7 @@
 #include <mlpack/methods/quic_svd.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 
@@ -89,3 +90,49 @@ TEST_CASE("QUICSVDSameDimensionTest", "[QUICSVDTest]")
   arma::mat u, v, sigma;
   QUIC_SVD<> quicsvd(dataset, u, v, sigma);
 }
+
+/**
+ * A trained QUIC_SVD object should give the same factorization for the same
+ * epsilon every time, and should only split its cosine tree when a smaller
+ * epsilon than before is requested.
+ */
+TEST_CASE("QUICSVDTrainedTreeReuseTest", "[QUICSVDTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    FAIL("Cannot load dataset test_data_3_1000.csv");
+
+  QUIC_SVD<> quicsvd;
+  quicsvd.Train(dataset);
+
+  arma::mat u1, v1, sigma1, u2, v2, sigma2, u3, v3, sigma3;
+  quicsvd.Apply(u1, v1, sigma1, 0.5);
+  quicsvd.Apply(u2, v2, sigma2, 1e-5);
+  quicsvd.Apply(u3, v3, sigma3, 0.5);
+
+  // The coarse basis is replayed from the same refinement steps.
+  REQUIRE(sigma1.n_cols == sigma3.n_cols);
+  CheckMatrices(sigma1, sigma3);
+  REQUIRE(sigma2.n_cols >= sigma1.n_cols);
+
+  // The finer approximation should still reconstruct the matrix.
+  const double relativeError = arma::norm(dataset - u2 * sigma2 * v2.t(),
+      "frob") / arma::norm(dataset, "frob");
+  REQUIRE(relativeError < 0.1);
+
+  // A copy holds its own tree and gives the same results.
+  QUIC_SVD<> copy(quicsvd);
+  arma::mat u4, v4, sigma4;
+  copy.Apply(u4, v4, sigma4, 0.5);
+  CheckMatrices(sigma1, sigma4);
+}
+
+/**
+ * Calling Apply() without a cosine tree should throw.
+ */
+TEST_CASE("QUICSVDApplyWithoutTrainTest", "[QUICSVDTest]")
+{
+  QUIC_SVD<> quicsvd;
+  arma::mat u, v, sigma;
+  REQUIRE_THROWS_AS(quicsvd.Apply(u, v, sigma, 0.1), std::runtime_error);
+}
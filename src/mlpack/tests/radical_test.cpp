@@ -55,3 +55,34 @@ TEST_CASE("Radical_Test_Radical3D", "[RadicalTest]")
   // Larger tolerance is sometimes needed.
   REQUIRE(valBest == Approx(valEst).epsilon(0.02));
 }
+
+/**
+ * Make sure the unmixing matrix gives the independent components, and that the
+ * results do not depend on the number of threads.
+ */
+TEST_CASE("RadicalThreadCountReproducibilityTest", "[RadicalTest]")
+{
+  mat matX;
+  if (!data::Load("data_3d_mixed.txt", matX))
+    FAIL("Cannot load dataset data_3d_mixed.txt");
+
+  Radical rad(0.175, 5, 50, 2);
+
+  mat matY, matW;
+  {
+    ParallelScope scope(1);
+    RandomSeed(42);
+    rad.DoRadical(matX, matY, matW);
+  }
+
+  mat parallelY, parallelW;
+  {
+    ParallelScope scope(4);
+    RandomSeed(42);
+    rad.DoRadical(matX, parallelY, parallelW);
+  }
+
+  REQUIRE(arma::approx_equal(matY, matW * matX, "absdiff", 1e-6));
+  REQUIRE(arma::approx_equal(parallelY, matY, "absdiff", 1e-12));
+  REQUIRE(arma::approx_equal(parallelW, matW, "absdiff", 1e-12));
+}
@@ -92,6 +92,63 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure bootstrap indices are in the dataset, and that Bootstrap() takes
+ * the same sample.
+ */
+TEST_CASE("BootstrapIndicesTest", "[RandomForestTest]")
+{
+  arma::mat dataset(1, 1000);
+  dataset.row(0) = arma::linspace<arma::rowvec>(1000, 1999, 1000);
+  arma::Row<size_t> labels(1000);
+  labels.fill(1); // Don't care about the labels.
+  arma::rowvec weights; // Unused.
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    RandomSeed(trial);
+    arma::uvec indices;
+    BootstrapIndices(dataset.n_cols, indices);
+
+    REQUIRE(indices.n_elem == 1000);
+    REQUIRE(indices.max() < 1000);
+
+    RandomSeed(trial);
+    arma::mat bootstrapDataset;
+    arma::Row<size_t> bootstrapLabels;
+    arma::rowvec bootstrapWeights;
+    Bootstrap<false>(dataset, labels, weights, bootstrapDataset,
+        bootstrapLabels, bootstrapWeights);
+
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      REQUIRE(bootstrapDataset(0, i) == dataset(0, indices[i]));
+  }
+}
+
+/**
+ * Make sure that a forest of one tree without bootstrapping, which trains
+ * directly on the dataset, is the same as a decision tree.
+ */
+TEST_CASE("RandomForestNoBootstrapDecisionTreeTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  RandomForest<GiniGain, AllDimensionSelect, BestBinaryNumericSplit,
+      AllCategoricalSplit, false> rf(dataset, labels, 3, 1, 5);
+  DecisionTree<> dt(dataset, labels, 3, 5);
+
+  arma::Row<size_t> rfPredictions, dtPredictions;
+  rf.Classify(dataset, rfPredictions);
+  dt.Classify(dataset, dtPredictions);
+
+  REQUIRE(arma::accu(rfPredictions != dtPredictions) == 0);
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -607,3 +664,305 @@ TEST_CASE("ExtraTreesAccuracyTest", "[RandomForestTest]")
 
   REQUIRE(accuracy >= 0.85);
 }
+
+/**
+ * Make sure that a flat copy of a decision tree with categorical and numeric
+ * splits gives the same predictions as the tree.
+ */
+TEST_CASE("FlatTreeEnsembleDecisionTreeTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  DecisionTree<> tree(d, di, l, 5, 10);
+  FlatTreeEnsemble flat(tree);
+
+  REQUIRE(flat.NumTrees() == 1);
+  REQUIRE(flat.Regression() == false);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  tree.Classify(d, predictions, probabilities);
+  flat.Classify(d, flatPredictions, flatProbabilities);
+
+  REQUIRE(arma::accu(predictions != flatPredictions) == 0);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  // Single points should give the same results as the batch.
+  for (size_t i = 0; i < d.n_cols; i += 37)
+    REQUIRE(flat.Classify(d.col(i)) == predictions[i]);
+}
+
+/**
+ * Make sure that a flat copy of a regression tree gives the same predictions
+ * as the tree.
+ */
+TEST_CASE("FlatTreeEnsembleRegressorTest", "[RandomForestTest]")
+{
+  arma::mat data(4, 1000, arma::fill::randu);
+  arma::rowvec responses = data.row(0) + 2.0 * arma::square(data.row(2));
+
+  DecisionTreeRegressor<> tree(data, responses, 5);
+  FlatTreeEnsemble flat(tree);
+
+  REQUIRE(flat.Regression() == true);
+
+  arma::rowvec predictions, flatPredictions;
+  tree.Predict(data, predictions);
+  flat.Predict(data, flatPredictions);
+
+  CheckMatrices(predictions, flatPredictions);
+  REQUIRE(flat.Predict(data.col(10)) == Approx(predictions[10]));
+
+  // A regression model cannot classify.
+  arma::Row<size_t> labels;
+  REQUIRE_THROWS_AS(flat.Classify(data, labels), std::invalid_argument);
+}
+
+/**
+ * Make sure that a flat copy of a random forest gives the same predictions as
+ * the forest, before and after serialization.
+ */
+TEST_CASE("FlatTreeEnsembleRandomForestTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  RandomForest<> rf(dataset, labels, 3, 20, 3);
+  FlatTreeEnsemble flat(rf);
+
+  REQUIRE(flat.NumTrees() == 20);
+
+  arma::Row<size_t> predictions, flatPredictions;
+  arma::mat probabilities, flatProbabilities;
+  rf.Classify(dataset, predictions, probabilities);
+  flat.Classify(dataset, flatPredictions, flatProbabilities);
+
+  REQUIRE(arma::accu(predictions != flatPredictions) == 0);
+  CheckMatrices(probabilities, flatProbabilities);
+
+  FlatTreeEnsemble xmlFlat, jsonFlat, binaryFlat;
+  SerializeObjectAll(flat, xmlFlat, jsonFlat, binaryFlat);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlFlat.Classify(dataset, xmlPredictions);
+  jsonFlat.Classify(dataset, jsonPredictions);
+  binaryFlat.Classify(dataset, binaryPredictions);
+
+  REQUIRE(arma::accu(predictions != xmlPredictions) == 0);
+  REQUIRE(arma::accu(predictions != jsonPredictions) == 0);
+  REQUIRE(arma::accu(predictions != binaryPredictions) == 0);
+
+  // An empty ensemble cannot predict.
+  FlatTreeEnsemble empty;
+  REQUIRE_THROWS_AS(empty.Classify(dataset, predictions),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a random forest can be trained on sparse data, and that it
+ * gives the same predictions for sparse and dense points.
+ */
+TEST_CASE("SparseRandomForestTest", "[RandomForestTest]")
+{
+  arma::sp_mat dataset;
+  dataset.sprandu(20, 3000, 0.1);
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < 3000; ++i)
+    labels[i] = (dataset(2, i) + dataset(5, i) > 0.0) ? 1 : 0;
+
+  RandomForest<> rf(dataset, labels, 2, 10, 3);
+
+  arma::Row<size_t> sparsePredictions, densePredictions;
+  rf.Classify(dataset, sparsePredictions);
+  rf.Classify(arma::mat(dataset), densePredictions);
+
+  REQUIRE(arma::accu(sparsePredictions != densePredictions) == 0);
+  REQUIRE(arma::accu(sparsePredictions == labels) > 2700);
+}
+
+/**
+ * Make sure that the out-of-bag error is computed, and that the permutation
+ * importance finds the only informative feature.
+ */
+TEST_CASE("RandomForestOOBImportanceTest", "[RandomForestTest]")
+{
+  // Only the first feature is informative; the others are noise.
+  arma::mat dataset(4, 2000, arma::fill::randu);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < 2000; ++i)
+    labels[i] = (dataset(0, i) > 0.5) ? 1 : 0;
+
+  RandomForest<> rf;
+  REQUIRE(rf.OOBError() == DBL_MAX);
+  rf.ComputeImportance() = true;
+  rf.Train(dataset, labels, 2, 20, 5);
+
+  // Almost every point is left out of some bootstrap sample, and the problem
+  // is easy.
+  REQUIRE(rf.OOBError() < 0.05);
+
+  REQUIRE(rf.FeatureImportance().n_elem == 4);
+  REQUIRE(rf.FeatureImportance().index_max() == 0);
+  REQUIRE(rf.FeatureImportance()[0] > 0.2);
+  for (size_t d = 1; d < 4; ++d)
+    REQUIRE(rf.FeatureImportance()[d] < 0.05);
+
+  // Without bootstrapping there are no out-of-bag points.
+  RandomForest<GiniGain, MultipleRandomDimensionSelect,
+      BestBinaryNumericSplit, AllCategoricalSplit, false> noBootstrap(dataset,
+      labels, 2, 5, 5);
+  REQUIRE(noBootstrap.OOBError() == DBL_MAX);
+  REQUIRE(noBootstrap.FeatureImportance().n_elem == 0);
+}
+
+/**
+ * Make sure that Parallel and ParallelScope control the number of threads, and
+ * that a random forest can be trained inside a parallel region (where it trains
+ * its trees serially).
+ */
+TEST_CASE("RandomForestParallelScopeTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  const size_t defaultThreads = Parallel::Threads();
+  REQUIRE(defaultThreads == Parallel::DefaultThreads());
+  {
+    ParallelScope scope(1);
+    REQUIRE(Parallel::Threads() == 1);
+  }
+  REQUIRE(Parallel::Threads() == defaultThreads);
+
+  #ifdef MLPACK_USE_OPENMP
+    Parallel::SetThreads(2);
+    REQUIRE(Parallel::Threads() == 2);
+    Parallel::SetThreads(0);
+    REQUIRE(Parallel::Threads() == defaultThreads);
+  #endif
+
+  size_t correct = 0;
+  #pragma omp parallel num_threads(2)
+  {
+    #pragma omp single
+    {
+      REQUIRE(Parallel::Threads() == 1);
+      RandomForest<> rf(dataset, labels, 3, 5);
+      arma::Row<size_t> predictions;
+      rf.Classify(dataset, predictions);
+      correct = arma::accu(predictions == labels);
+    }
+  }
+
+  // With leaves of size 1, the training set is (almost) memorized.
+  REQUIRE(double(correct) / labels.n_elem > 0.9);
+}
+
+/**
+ * Make sure that a random forest is the same no matter how many threads train
+ * it.
+ */
+TEST_CASE("RandomForestThreadCountReproducibilityTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  {
+    ParallelScope scope(1);
+    RandomSeed(1234);
+    RandomForest<> rf(dataset, labels, 3, 10, 5);
+    rf.Classify(dataset, predictions, probabilities);
+  }
+
+  arma::Row<size_t> parallelPredictions;
+  arma::mat parallelProbabilities;
+  {
+    ParallelScope scope(4);
+    RandomSeed(1234);
+    RandomForest<> rf(dataset, labels, 3, 10, 5);
+    rf.Classify(dataset, parallelPredictions, parallelProbabilities);
+  }
+
+  CheckMatrices(predictions, parallelPredictions);
+  CheckMatrices(probabilities, parallelProbabilities);
+}
+
+/**
+ * Forests trained on different shards of the data can be merged into one
+ * forest that votes with all of the trees, and serialized.
+ */
+TEST_CASE("RandomForestMergeTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  // Split the data into two shards.
+  const arma::uvec even = arma::regspace<arma::uvec>(0, 2, dataset.n_cols - 1);
+  const arma::uvec odd = arma::regspace<arma::uvec>(1, 2, dataset.n_cols - 1);
+  const arma::mat evenData = dataset.cols(even);
+  const arma::mat oddData = dataset.cols(odd);
+  const arma::Row<size_t> evenLabels = labels.cols(even);
+  const arma::Row<size_t> oddLabels = labels.cols(odd);
+
+  RandomSeed(1);
+  RandomForest<> evenForest(evenData, evenLabels, 3, 5, 5);
+  RandomSeed(2);
+  RandomForest<> oddForest(oddData, oddLabels, 3, 10, 5);
+
+  RandomForest<> forest;
+  forest.Merge(evenForest);
+  forest.Merge(oddForest);
+  REQUIRE(forest.NumTrees() == 15);
+
+  // The merged forest averages the probabilities of all of the trees.
+  arma::Row<size_t> predictions, evenPredictions, oddPredictions;
+  arma::mat probabilities, evenProbabilities, oddProbabilities;
+  forest.Classify(dataset, predictions, probabilities);
+  evenForest.Classify(dataset, evenPredictions, evenProbabilities);
+  oddForest.Classify(dataset, oddPredictions, oddProbabilities);
+  CheckMatrices(probabilities,
+      (5 * evenProbabilities + 10 * oddProbabilities) / 15);
+
+  const double accuracy = arma::accu(predictions == labels) /
+      (double) labels.n_elem;
+  REQUIRE(accuracy > 0.7);
+
+  REQUIRE(forest.OOBError() == Approx((5 * evenForest.OOBError() +
+      10 * oddForest.OOBError()) / 15).epsilon(1e-7));
+
+  RandomForest<> xmlForest, jsonForest, binaryForest;
+  SerializeObjectAll(forest, xmlForest, jsonForest, binaryForest);
+  REQUIRE(binaryForest.NumTrees() == 15);
+
+  arma::Row<size_t> binaryPredictions;
+  arma::mat binaryProbabilities;
+  binaryForest.Classify(dataset, binaryPredictions, binaryProbabilities);
+  CheckMatrices(predictions, binaryPredictions);
+  CheckMatrices(probabilities, binaryProbabilities);
+
+  // Forests with different numbers of classes cannot be merged.
+  arma::Row<size_t> twoClassLabels = arma::conv_to<arma::Row<size_t>>::from(
+      evenLabels > 0);
+  RandomForest<> twoClassForest(evenData, twoClassLabels, 2, 3, 5);
+  REQUIRE_THROWS_AS(forest.Merge(twoClassForest), std::invalid_argument);
+}
@@ -91,3 +91,54 @@ TEST_CASE("WeightedRandomTest", "[RandomTest]")
     }
   }
 }
+
+// Make sure RandomStream computes Philox4x32-10 (checked against the known
+// answers of the Random123 library).
+TEST_CASE("RandomStreamKnownAnswerTest", "[RandomTest]")
+{
+  uint32_t out[4];
+  RandomStream(0, 0).Blocks(0, 1, out);
+  REQUIRE(out[0] == 0x6627e8d5);
+  REQUIRE(out[1] == 0xe169c58d);
+  REQUIRE(out[2] == 0xbc57ac4c);
+  REQUIRE(out[3] == 0x9b00dbd8);
+
+  RandomStream(0x299f31d0a4093822, 0x0370734413198a2e).Blocks(
+      0x85a308d3243f6a88, 1, out);
+  REQUIRE(out[0] == 0xd16cfe09);
+  REQUIRE(out[1] == 0x94fdcceb);
+  REQUIRE(out[2] == 0x5001e420);
+  REQUIRE(out[3] == 0x24126ea1);
+}
+
+// Make sure bulk filling gives the same numbers as drawing them one at a time,
+// and that different streams give different numbers.
+TEST_CASE("RandomStreamFillTest", "[RandomTest]")
+{
+  RandomStream stream(42, 3), sameStream(42, 3), otherStream(42, 4);
+
+  arma::vec x(1001);
+  stream.Fill(x);
+  for (size_t i = 0; i < x.n_elem; ++i)
+  {
+    REQUIRE(x[i] >= 0.0);
+    REQUIRE(x[i] < 1.0);
+    REQUIRE(x[i] == sameStream.Random());
+  }
+  REQUIRE(arma::mean(x) == Approx(0.5).margin(0.05));
+
+  arma::vec y(1001);
+  otherStream.Fill(y);
+  REQUIRE(arma::accu(x == y) == 0);
+
+  arma::uvec counts(10, arma::fill::zeros);
+  arma::uvec ints(10000);
+  stream.FillInt(ints, 10);
+  for (size_t i = 0; i < ints.n_elem; ++i)
+  {
+    REQUIRE(ints[i] < 10);
+    ++counts[ints[i]];
+  }
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == Approx(1000).margin(150));
+}
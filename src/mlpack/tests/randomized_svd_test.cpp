@@ -59,3 +59,59 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The streaming randomized SVD of a low-rank matrix, given in blocks of
+ * different sizes, should match the exact SVD of the centered matrix.
+ */
+TEST_CASE("StreamingRandomizedSVDReconstructionError", "[RandomizedSVDTest]")
+{
+  // A rank 5 matrix, plus an offset that centering should remove.
+  arma::mat data = arma::randn<arma::mat>(50, 5) *
+      arma::randn<arma::mat>(5, 300);
+  data.each_col() += arma::randu<arma::vec>(50);
+
+  arma::mat centeredData = data.each_col() - arma::mean(data, 1);
+
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  StreamingRandomizedSVD<> svd(5, 10, true);
+  svd.Update(data.cols(0, 9));
+  svd.Update(data.cols(10, 149));
+  svd.Update(data.cols(150, 150));
+  svd.Update(data.cols(151, 299));
+  REQUIRE(svd.NumColumns() == 300);
+
+  arma::mat U2, V2;
+  arma::vec s2;
+  svd.Factorize(U2, s2, V2);
+
+  REQUIRE(U2.n_rows == 50);
+  REQUIRE(U2.n_cols == 5);
+  REQUIRE(s2.n_elem == 5);
+  REQUIRE(V2.n_rows == 300);
+  REQUIRE(V2.n_cols == 5);
+
+  // The singular value error should be small.
+  double error = arma::norm(s2 - s1.subvec(0, 4)) / arma::norm(s2);
+  REQUIRE(error == Approx(0.0).margin(1e-8));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(centeredData - reconstruct, "frob") /
+      arma::norm(centeredData, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-8));
+
+  // Apply() on the matrix in one block should give the same result.
+  svd.BlockSize() = 300;
+  svd.Apply(data, U2, s2, V2);
+  REQUIRE(svd.NumColumns() == 300);
+  error = arma::norm(s2 - s1.subvec(0, 4)) / arma::norm(s2);
+  REQUIRE(error == Approx(0.0).margin(1e-8));
+
+  // Blocks must all have the same number of rows.
+  REQUIRE_THROWS_AS(svd.Update(arma::mat(10, 3)), std::invalid_argument);
+}
@@ -507,6 +507,44 @@ TEST_CASE("DualTreeVsNaive1", "[RangeSearchTest]")
   }
 }
 
+/**
+ * Test the single-tree range search method with the naive method, using a
+ * separate query set large enough that it is split across threads and
+ * reordered along the space-filling curve.
+ */
+TEST_CASE("SingleTreeQuerySetVsNaive", "[RangeSearchTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 1500);
+  arma::mat querySet = arma::randu<arma::mat>(3, 1200);
+
+  RangeSearch<> rs(referenceSet, false, true);
+  RangeSearch<> naive(referenceSet, true);
+
+  vector<vector<size_t>> neighborsTree, neighborsNaive;
+  vector<vector<double>> distancesTree, distancesNaive;
+  rs.Search(querySet, Range(0.1, 0.3), neighborsTree, distancesTree);
+  naive.Search(querySet, Range(0.1, 0.3), neighborsNaive, distancesNaive);
+
+  vector<vector<pair<double, size_t>>> sortedTree, sortedNaive;
+  SortResults(neighborsTree, distancesTree, sortedTree);
+  SortResults(neighborsNaive, distancesNaive, sortedNaive);
+
+  REQUIRE(sortedTree.size() == sortedNaive.size());
+  for (size_t i = 0; i < sortedTree.size(); ++i)
+  {
+    REQUIRE(sortedTree[i].size() == sortedNaive[i].size());
+
+    for (size_t j = 0; j < sortedTree[i].size(); ++j)
+    {
+      REQUIRE(sortedTree[i][j].second == sortedNaive[i][j].second);
+      REQUIRE(sortedTree[i][j].first ==
+          Approx(sortedNaive[i][j].first).epsilon(1e-7));
+    }
+  }
+
+  REQUIRE(rs.BaseCases() > 0);
+}
+
 /**
  * Test the dual-tree range search method with the naive method.  This uses
  * only a reference dataset.
@@ -1712,3 +1750,97 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+// Check that the given CSR results and counts hold the same results as the
+// given vectors.
+void CheckCSRResults(const vector<vector<size_t>>& neighbors,
+                     const vector<vector<double>>& distances,
+                     const arma::Col<size_t>& csrOffsets,
+                     const arma::Col<size_t>& csrNeighbors,
+                     const arma::vec& csrDistances,
+                     const arma::Col<size_t>& counts)
+{
+  REQUIRE(csrOffsets.n_elem == neighbors.size() + 1);
+  REQUIRE(counts.n_elem == neighbors.size());
+  REQUIRE(csrOffsets[0] == 0);
+  REQUIRE(csrNeighbors.n_elem == csrOffsets[neighbors.size()]);
+  REQUIRE(csrDistances.n_elem == csrNeighbors.n_elem);
+
+  vector<vector<pair<double, size_t>>> sorted;
+  SortResults(neighbors, distances, sorted);
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    REQUIRE(csrOffsets[i + 1] - csrOffsets[i] == neighbors[i].size());
+    REQUIRE(counts[i] == neighbors[i].size());
+
+    vector<pair<double, size_t>> csrSorted;
+    for (size_t j = csrOffsets[i]; j < csrOffsets[i + 1]; ++j)
+      csrSorted.push_back(make_pair(csrDistances[j], csrNeighbors[j]));
+    sort(csrSorted.begin(), csrSorted.end());
+
+    for (size_t j = 0; j < csrSorted.size(); ++j)
+    {
+      REQUIRE(csrSorted[j].second == sorted[i][j].second);
+      REQUIRE(csrSorted[j].first == Approx(sorted[i][j].first).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Make sure that the CSR results and the counts are the same as the results
+ * stored in vectors, for every search mode.
+ */
+TEST_CASE("RangeSearchCSRTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 800);
+  arma::mat queryData = arma::randu<arma::mat>(3, 300);
+  const Range range(0.05, 0.25);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RangeSearch<> rs(referenceData, mode == 0, mode == 1);
+
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    arma::Col<size_t> offsets, csrNeighbors, counts;
+    arma::vec csrDistances;
+
+    // Bichromatic search.
+    rs.Search(queryData, range, neighbors, distances);
+    rs.Search(queryData, range, offsets, csrNeighbors, csrDistances);
+    rs.Count(queryData, range, counts);
+    CheckCSRResults(neighbors, distances, offsets, csrNeighbors, csrDistances,
+        counts);
+
+    // Monochromatic search.
+    rs.Search(range, neighbors, distances);
+    rs.Search(range, offsets, csrNeighbors, csrDistances);
+    rs.Count(range, counts);
+    CheckCSRResults(neighbors, distances, offsets, csrNeighbors, csrDistances,
+        counts);
+  }
+}
+
+/**
+ * Make sure that every point is counted when the range covers the whole
+ * reference set, so that whole reference nodes are counted at once.
+ */
+TEST_CASE("RangeSearchCountAllTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(2, 500);
+  arma::mat queryData = arma::randu<arma::mat>(2, 100);
+
+  RangeSearch<> rs(referenceData);
+  arma::Col<size_t> counts;
+
+  rs.Count(queryData, Range(0.0, 10.0), counts);
+  REQUIRE(counts.n_elem == 100);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 500);
+
+  // The query point itself is not counted in monochromatic search.
+  rs.Count(Range(0.0, 10.0), counts);
+  REQUIRE(counts.n_elem == 500);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 499);
+}
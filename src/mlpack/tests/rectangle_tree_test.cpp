@@ -1353,3 +1353,91 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Bulk load a tree of the given type with the given policy, make sure that it
+ * is valid and packed, and that it gives the same nearest neighbors as a naive
+ * search, both before and after more points are inserted.
+ */
+template<template<typename, typename, typename> class TreeType,
+         typename BulkLoadType>
+void CheckBulkLoadedTree()
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> Tree;
+
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  Tree tree(dataset, BulkLoadType(), 20, 6, 5, 2);
+
+  REQUIRE(tree.NumDescendants() == 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  CheckFills(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+  REQUIRE((int) tree.TreeDepth() == GetMinLevel(tree));
+
+  // 1000 points in leaves of 20 points need exactly 50 leaves; in nodes of 5
+  // children, that is three levels above the leaves.
+  REQUIRE(tree.TreeDepth() == 4);
+
+  std::vector<arma::vec*> allPoints = GetAllPointsInTree(tree);
+  REQUIRE(allPoints.size() == 1000);
+  for (size_t i = 0; i < allPoints.size(); ++i)
+    delete allPoints[i];
+
+  // The tree can still be changed after it is built.
+  const size_t numIter = 50;
+  tree.Dataset().resize(3, 1000 + numIter);
+  dataset.resize(3, 1000 + numIter);
+  dataset.cols(1000, 1000 + numIter - 1).randu();
+  tree.Dataset().cols(1000, 1000 + numIter - 1) =
+      dataset.cols(1000, 1000 + numIter - 1);
+  for (size_t i = 0; i < numIter; ++i)
+    tree.InsertPoint(1000 + i);
+
+  REQUIRE(tree.NumDescendants() == 1000 + numIter);
+  CheckContainment(tree);
+  CheckNumDescendants(tree);
+
+  arma::Mat<size_t> neighbors1, neighbors2;
+  arma::mat distances1, distances2;
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      knn1(std::move(tree));
+  knn1.Search(5, neighbors1, distances1);
+
+  KNN knn2(dataset, NAIVE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  CheckMatrices(neighbors1, neighbors2);
+  CheckMatrices(distances1, distances2);
+}
+
+// Make sure that bulk loading gives valid trees for all of the tree types that
+// support it.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  CheckBulkLoadedTree<RTree, STRBulkLoad>();
+  CheckBulkLoadedTree<RTree, HilbertBulkLoad>();
+  CheckBulkLoadedTree<RStarTree, STRBulkLoad>();
+  CheckBulkLoadedTree<RStarTree, HilbertBulkLoad>();
+  CheckBulkLoadedTree<XTree, STRBulkLoad>();
+  CheckBulkLoadedTree<XTree, HilbertBulkLoad>();
+}
+
+// Make sure that bulk loading a dataset that fits in one leaf gives one leaf.
+TEST_CASE("RectangleTreeBulkLoadLeafTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset(3, 15, arma::fill::randu);
+  typedef RTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  TreeType tree(std::move(dataset), STRBulkLoad());
+
+  REQUIRE(dataset.n_elem == 0);
+  REQUIRE(tree.IsLeaf());
+  REQUIRE(tree.Count() == 15);
+  REQUIRE(tree.NumDescendants() == 15);
+  CheckExactContainment(tree);
+}
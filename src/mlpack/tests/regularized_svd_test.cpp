@@ -246,6 +246,60 @@ TEST_CASE("RegularizedSVDFunctionOptimize", "[RegularizedSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Check that StratifiedSGD partitions the ratings into blocks, such that the
+// blocks of each sub-epoch share no user and no item.
+TEST_CASE("StratifiedSGDBlocksTest", "[RegularizedSVDTest]")
+{
+  const size_t numUsers = 60;
+  const size_t numItems = 40;
+  const size_t numRatings = 2000;
+  const size_t numBlocks = 4;
+
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  StratifiedSGD sgd(data, numUsers, numItems, numBlocks);
+  REQUIRE(sgd.NumBlocks() == numBlocks);
+
+  const arma::mat& blocked = sgd.BlockedData();
+  const arma::Col<size_t>& starts = sgd.BlockStarts();
+  REQUIRE(blocked.n_cols == numRatings);
+  REQUIRE(starts.n_elem == numBlocks * numBlocks + 1);
+  REQUIRE(starts[0] == 0);
+  REQUIRE(starts[numBlocks * numBlocks] == numRatings);
+
+  // The ratings are only reordered.
+  REQUIRE(arma::accu(blocked.row(2)) == Approx(arma::accu(data.row(2))));
+
+  // Every user belongs to one user group and every item to one item group.
+  arma::Col<size_t> userGroups(numUsers), itemGroups(numItems);
+  userGroups.fill(numBlocks);
+  itemGroups.fill(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    for (size_t c = 0; c < numBlocks; ++c)
+    {
+      const size_t block = b * numBlocks + c;
+      for (size_t j = starts[block]; j < starts[block + 1]; ++j)
+      {
+        const size_t user = blocked(0, j);
+        const size_t item = blocked(1, j);
+        if (userGroups[user] == numBlocks)
+          userGroups[user] = b;
+        if (itemGroups[item] == numBlocks)
+          itemGroups[item] = c;
+        REQUIRE(userGroups[user] == b);
+        REQUIRE(itemGroups[item] == c);
+
+        // Ratings are sorted by user inside each block.
+        if (j > starts[block])
+          REQUIRE(blocked(0, j - 1) <= blocked(0, j));
+      }
+    }
+  }
+}
+
 // The test is only compiled if the user has specified OpenMP to be
 // used.
 #ifdef MLPACK_USE_OPENMP
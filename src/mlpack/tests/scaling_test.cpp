@@ -166,3 +166,102 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Check that fitting a scaler in batches with PartialFit() gives the same
+ * result as fitting it to the whole dataset, and that scaling in place gives
+ * the same result as scaling into another matrix.
+ */
+template<typename ScalerType>
+void CheckPartialFit(ScalerType& scale, ScalerType& batchScale)
+{
+  // Use enough points that each batch is split into several blocks.
+  arma::mat points(4, 2 * ScalerStatistics::BlockSize + 1000,
+      arma::fill::randn);
+  points.row(1) *= 100.0;
+  points.row(2) += 1000.0;
+
+  scale.Fit(points);
+  batchScale.PartialFit(points.cols(0, 999));
+  batchScale.PartialFit(points.cols(1000, points.n_cols - 2));
+  batchScale.PartialFit(points.col(points.n_cols - 1));
+
+  REQUIRE(batchScale.Statistics().Count() == points.n_cols);
+
+  arma::mat output, batchOutput(points);
+  scale.Transform(points, output);
+  batchScale.Transform(batchOutput);
+  CheckMatrices(output, batchOutput, 1e-5);
+
+  batchScale.InverseTransform(batchOutput);
+  CheckMatrices(points, batchOutput, 1e-5);
+
+  // Calling Fit() again forgets the earlier batches.
+  batchScale.Fit(points);
+  REQUIRE(batchScale.Statistics().Count() == points.n_cols);
+}
+
+TEST_CASE("PartialFitTest", "[ScalingTest]")
+{
+  data::MinMaxScaler minMax, batchMinMax;
+  CheckPartialFit(minMax, batchMinMax);
+
+  data::MaxAbsScaler maxAbs, batchMaxAbs;
+  CheckPartialFit(maxAbs, batchMaxAbs);
+
+  data::StandardScaler standard, batchStandard;
+  CheckPartialFit(standard, batchStandard);
+
+  data::MeanNormalization meanNorm, batchMeanNorm;
+  CheckPartialFit(meanNorm, batchMeanNorm);
+}
+
+/**
+ * Check that the PCA and ZCA whitening scalers can be fit in batches, and that
+ * whitening in place gives the same result.
+ */
+TEST_CASE("PartialFitWhiteningTest", "[ScalingTest]")
+{
+  arma::mat points(3, ScalerStatistics::BlockSize + 500, arma::fill::randn);
+  points.row(0) += 2.0 * points.row(1);
+  points.row(2) *= 5.0;
+
+  data::PCAWhitening pca, batchPCA;
+  pca.Fit(points);
+  batchPCA.PartialFit(points.cols(0, 2999));
+  batchPCA.PartialFit(points.cols(3000, points.n_cols - 1));
+  CheckMatrices(pca.ItemMean(), batchPCA.ItemMean(), 1e-5);
+  CheckMatrices(pca.EigenValues(), batchPCA.EigenValues(), 1e-5);
+
+  arma::mat output, inPlace(points);
+  pca.Transform(points, output);
+  batchPCA.Transform(inPlace);
+  REQUIRE(arma::approx_equal(arma::abs(output), arma::abs(inPlace), "absdiff",
+      1e-5));
+
+  data::ZCAWhitening zca, batchZCA;
+  zca.Fit(points);
+  batchZCA.PartialFit(points.cols(0, 99));
+  batchZCA.PartialFit(points.cols(100, points.n_cols - 1));
+
+  inPlace = points;
+  zca.Transform(points, output);
+  batchZCA.Transform(inPlace);
+  CheckMatrices(output, inPlace, 1e-5);
+
+  // The whitened data has unit covariance.
+  const arma::mat covariance = ColumnCovariance(inPlace);
+  REQUIRE(arma::approx_equal(covariance, arma::eye<arma::mat>(3, 3), "absdiff",
+      1e-3));
+}
+
+/**
+ * Make sure batches with the wrong number of dimensions are rejected.
+ */
+TEST_CASE("PartialFitDimensionalityTest", "[ScalingTest]")
+{
+  data::StandardScaler scale;
+  scale.PartialFit(arma::mat(3, 10, arma::fill::randu));
+  REQUIRE_THROWS_AS(scale.PartialFit(arma::mat(4, 10, arma::fill::randu)),
+      std::invalid_argument);
+}
@@ -14,6 +14,7 @@
 #include "catch.hpp"
 #include "serialization.hpp"
 
+#include <mlpack/methods/hnsw.hpp>
 #include <mlpack/methods/hoeffding_trees.hpp>
 #include <mlpack/methods/perceptron.hpp>
 #include <mlpack/methods/logistic_regression.hpp>
@@ -1041,16 +1042,61 @@ TEST_CASE("LSHTest", "[SerializationTest]")
   REQUIRE(lsh.BucketSize() == jsonLsh.BucketSize());
   REQUIRE(lsh.BucketSize() == binaryLsh.BucketSize());
 
-  REQUIRE(lsh.SecondHashTable().size() ==
-      xmlLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      jsonLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      binaryLsh.SecondHashTable().size());
+  REQUIRE(lsh.NumBuckets() == xmlLsh.NumBuckets());
+  REQUIRE(lsh.NumBuckets() == jsonLsh.NumBuckets());
+  REQUIRE(lsh.NumBuckets() == binaryLsh.NumBuckets());
 
-  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
-  CheckMatrices(lsh.SecondHashTable()[i], xmlLsh.SecondHashTable()[i],
-      jsonLsh.SecondHashTable()[i], binaryLsh.SecondHashTable()[i]);
+  CheckMatrices(lsh.BucketOffsets(), xmlLsh.BucketOffsets(),
+      jsonLsh.BucketOffsets(), binaryLsh.BucketOffsets());
+  CheckMatrices(ConvTo<arma::Mat<size_t>>::From(lsh.BucketContents()),
+      ConvTo<arma::Mat<size_t>>::From(xmlLsh.BucketContents()),
+      ConvTo<arma::Mat<size_t>>::From(jsonLsh.BucketContents()),
+      ConvTo<arma::Mat<size_t>>::From(binaryLsh.BucketContents()));
+}
+
+/**
+ * Test that an HNSW graph can be serialized and deserialized, and that the
+ * deserialized graph gives the same results.
+ */
+TEST_CASE("HNSWTest", "[SerializationTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+  arma::mat queryData = arma::randu<arma::mat>(5, 20);
+
+  HNSWSearch<> hnsw(referenceData, 6, 40, 30);
+
+  HNSWSearch<> xmlHnsw;
+  arma::mat jsonData = arma::randu<arma::mat>(3, 50);
+  HNSWSearch<> jsonHnsw(jsonData);
+  HNSWSearch<> binaryHnsw(referenceData, 12);
+
+  // Now serialize.
+  SerializeObjectAll(hnsw, xmlHnsw, jsonHnsw, binaryHnsw);
+
+  CheckMatrices(hnsw.ReferenceSet(), xmlHnsw.ReferenceSet(),
+      jsonHnsw.ReferenceSet(), binaryHnsw.ReferenceSet());
+
+  REQUIRE(hnsw.MaxNeighbors() == xmlHnsw.MaxNeighbors());
+  REQUIRE(hnsw.MaxNeighbors() == jsonHnsw.MaxNeighbors());
+  REQUIRE(hnsw.MaxNeighbors() == binaryHnsw.MaxNeighbors());
+
+  REQUIRE(hnsw.Ef() == xmlHnsw.Ef());
+  REQUIRE(hnsw.Ef() == jsonHnsw.Ef());
+  REQUIRE(hnsw.Ef() == binaryHnsw.Ef());
+
+  REQUIRE(hnsw.EntryPoint() == xmlHnsw.EntryPoint());
+  REQUIRE(hnsw.EntryPoint() == jsonHnsw.EntryPoint());
+  REQUIRE(hnsw.EntryPoint() == binaryHnsw.EntryPoint());
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  hnsw.Search(queryData, 5, neighbors, distances);
+  xmlHnsw.Search(queryData, 5, xmlNeighbors, xmlDistances);
+  jsonHnsw.Search(queryData, 5, jsonNeighbors, jsonDistances);
+  binaryHnsw.Search(queryData, 5, binaryNeighbors, binaryDistances);
+
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
 }
 
 // Make sure serialization works for LARS.
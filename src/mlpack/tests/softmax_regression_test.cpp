@@ -907,3 +907,157 @@ TEST_CASE("SoftmaxRegressionResetTest", "[SoftmaxRegressionTest]")
   REQUIRE(
       !arma::approx_equal(sr1.Parameters(), sr2.Parameters(), "absdiff", 1e-5));
 }
+
+/**
+ * Make sure that classifying raw memory gives the same predictions as
+ * classifying a matrix, with and without an intercept.
+ */
+TEST_CASE("SoftmaxRegressionRawClassifyTest", "[SoftmaxRegressionTest]")
+{
+  arma::mat data(10, 300, arma::fill::randn);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 3;
+    data(labels[i], i) += 2.0;
+  }
+
+  for (const bool fitIntercept : { true, false })
+  {
+    SoftmaxRegression<> sr(data, labels, 3, 0.0001, fitIntercept);
+
+    arma::Row<size_t> predictions;
+    sr.Classify(data, predictions);
+
+    arma::Row<size_t> rawPredictions(data.n_cols);
+    sr.Classify(data.memptr(), data.n_cols, rawPredictions.memptr());
+    REQUIRE(arma::all(predictions == rawPredictions));
+
+    // Classify a single point.
+    size_t prediction;
+    sr.Classify(data.colptr(11), 1, &prediction);
+    REQUIRE(prediction == predictions[11]);
+  }
+}
+
+/**
+ * When every class is sampled, the sampled softmax objective and its gradient
+ * must be the same as the exact objective and gradient.
+ */
+TEST_CASE("SampledSoftmaxRegressionFunctionExactTest",
+          "[SoftmaxRegressionTest]")
+{
+  const size_t numClasses = 6;
+  arma::mat data(4, 200, arma::fill::randn);
+  arma::Row<size_t> labels(200);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = RandInt(numClasses);
+
+  for (const bool fitIntercept : { true, false })
+  {
+    SoftmaxRegressionFunction<> srf(data, labels, numClasses, 0.01,
+        fitIntercept);
+    SampledSoftmaxRegressionFunction<> ssrf(data, labels, numClasses,
+        numClasses, 0.01, fitIntercept);
+
+    arma::mat parameters = srf.GetInitialPoint();
+    parameters.randn();
+    REQUIRE(ssrf.Evaluate(parameters, 0, data.n_cols) ==
+        Approx(srf.Evaluate(parameters)).epsilon(1e-7));
+
+    arma::mat gradient, sampledGradient;
+    srf.Gradient(parameters, 0, gradient, data.n_cols);
+    const double objective = ssrf.EvaluateWithGradient(parameters, 0,
+        sampledGradient, data.n_cols);
+    REQUIRE(objective == Approx(srf.Evaluate(parameters)).epsilon(1e-7));
+    REQUIRE(sampledGradient.n_rows == gradient.n_rows);
+    REQUIRE(sampledGradient.n_cols == gradient.n_cols);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      REQUIRE(sampledGradient[i] == Approx(gradient[i]).margin(1e-7));
+  }
+}
+
+/**
+ * Train a model with many classes with the sampled softmax objective, and
+ * make sure it classifies well.
+ */
+TEST_CASE("SoftmaxRegressionTrainSampledTest", "[SoftmaxRegressionTest]")
+{
+  const size_t numClasses = 100;
+  const size_t points = 3000;
+  const arma::mat centers = 4.0 * arma::randn<arma::mat>(10, numClasses);
+  arma::mat data(10, points, arma::fill::randn);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    labels[i] = i % numClasses;
+    data.col(i) += centers.col(labels[i]);
+  }
+
+  SoftmaxRegression<> sr(data.n_rows, numClasses);
+  ens::StandardSGD sgd(0.01, 32, 30 * points);
+  sr.TrainSampled(data, labels, numClasses, 10, sgd, 0.0001);
+
+  REQUIRE(sr.Parameters().n_rows == numClasses);
+  REQUIRE(sr.Parameters().n_cols == data.n_rows + 1);
+  REQUIRE(sr.ComputeAccuracy(data, labels) >= 85.0);
+}
+
+/**
+ * Make sure the classes found by TopClasses() are the classes with the highest
+ * scores.
+ */
+TEST_CASE("SoftmaxRegressionTopClassesTest", "[SoftmaxRegressionTest]")
+{
+  arma::mat data(10, 300, arma::fill::randn);
+  arma::Row<size_t> labels(300);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    labels[i] = i % 8;
+    data(labels[i], i) += 2.0;
+  }
+
+  for (const bool fitIntercept : { true, false })
+  {
+    SoftmaxRegression<> sr(data, labels, 8, 0.0001, fitIntercept);
+
+    arma::Row<size_t> predictions;
+    sr.Classify(data, predictions);
+
+    arma::Mat<size_t> classes;
+    arma::mat scores;
+    sr.TopClasses(data, 3, classes, scores);
+    REQUIRE(classes.n_rows == 3);
+    REQUIRE(classes.n_cols == data.n_cols);
+    REQUIRE(arma::all(classes.row(0) == predictions));
+
+    // Compute the scores of every class directly.
+    arma::mat allScores;
+    if (fitIntercept)
+    {
+      allScores = sr.Parameters().cols(1, data.n_rows) * data;
+      allScores.each_col() += sr.Parameters().col(0);
+    }
+    else
+    {
+      allScores = sr.Parameters() * data;
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const arma::uvec order = arma::sort_index(allScores.col(i), "descend");
+      for (size_t j = 0; j < 3; ++j)
+      {
+        REQUIRE(classes(j, i) == order[j]);
+        REQUIRE(scores(j, i) == Approx(allScores(order[j], i)).epsilon(1e-7));
+      }
+    }
+  }
+
+  // There are not enough classes.
+  arma::Mat<size_t> classes;
+  arma::mat scores;
+  SoftmaxRegression<> sr(data.n_rows, 8);
+  REQUIRE_THROWS_AS(sr.TopClasses(data, 9, classes, scores),
+      std::invalid_argument);
+}
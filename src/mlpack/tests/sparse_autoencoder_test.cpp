@@ -273,3 +273,105 @@ TEST_CASE("SparseAutoencoderFunctionGradient", "[SparseAutoencoderTest]")
     }
   }
 }
+
+/**
+ * Make sure that the separable objective and gradient over all points are the
+ * same as the full objective and gradient, and that the objectives of disjoint
+ * batches add up to the full objective when the KL divergence term is ignored.
+ */
+TEST_CASE("SparseAutoencoderFunctionSeparableTest", "[SparseAutoencoderTest]")
+{
+  const size_t points = 100;
+  const size_t vSize = 10;
+  const size_t hSize = 5;
+
+  arma::mat data(vSize, points, arma::fill::randu);
+  arma::mat parameters(2 * hSize + 1, vSize + 1, arma::fill::randu);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 0.1, 3.0);
+  REQUIRE(saf.NumFunctions() == points);
+
+  arma::mat gradient, batchGradient;
+  saf.Gradient(parameters, gradient);
+  saf.Gradient(parameters, 0, batchGradient, points);
+  REQUIRE(saf.Evaluate(parameters, 0, points) ==
+      Approx(saf.Evaluate(parameters)).epsilon(1e-10));
+  CheckMatrices(gradient, batchGradient, 1e-8);
+
+  // Without the KL divergence term, each term is a sum over the points (or is
+  // scaled by the size of the batch), so the batches sum to the full objective.
+  SparseAutoencoderFunction saf2(data, vSize, hSize, 0.1, 0.0);
+  double sum = 0.0;
+  arma::mat gradientSum(arma::size(parameters), arma::fill::zeros);
+  for (size_t i = 0; i < points; i += 20)
+  {
+    sum += saf2.Evaluate(parameters, i, 20);
+    saf2.Gradient(parameters, i, batchGradient, 20);
+    gradientSum += batchGradient;
+  }
+
+  saf2.Gradient(parameters, gradient);
+  REQUIRE(sum == Approx(saf2.Evaluate(parameters)).epsilon(1e-10));
+  CheckMatrices(gradient, gradientSum, 1e-8);
+}
+
+/**
+ * Make sure that a sparse dataset gives the same objective and gradient as the
+ * same dataset stored as a dense matrix.
+ */
+TEST_CASE("SparseAutoencoderFunctionSparseDataTest", "[SparseAutoencoderTest]")
+{
+  const size_t vSize = 30;
+  const size_t hSize = 8;
+
+  arma::sp_mat sparseData;
+  sparseData.sprandu(vSize, 200, 0.1);
+  arma::mat data(sparseData);
+  arma::mat parameters(2 * hSize + 1, vSize + 1, arma::fill::randu);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 0.1, 3.0);
+  SparseAutoencoderFunctionType<arma::sp_mat> sparseSaf(sparseData, vSize,
+      hSize, 0.1, 3.0);
+
+  REQUIRE(sparseSaf.Evaluate(parameters) ==
+      Approx(saf.Evaluate(parameters)).epsilon(1e-10));
+  REQUIRE(sparseSaf.Evaluate(parameters, 50, 25) ==
+      Approx(saf.Evaluate(parameters, 50, 25)).epsilon(1e-10));
+
+  arma::mat gradient, sparseGradient;
+  saf.Gradient(parameters, gradient);
+  sparseSaf.Gradient(parameters, sparseGradient);
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  saf.Gradient(parameters, 50, gradient, 25);
+  sparseSaf.Gradient(parameters, 50, sparseGradient, 25);
+  CheckMatrices(gradient, sparseGradient, 1e-8);
+
+  // The features of the sparse data must match those of the dense data too.
+  SparseAutoencoder encoder(sparseData, vSize, hSize, 0.1, 3.0, 0.01,
+      ens::L_BFGS(5, 10));
+  arma::mat features, sparseFeatures;
+  encoder.GetNewFeatures(data, features);
+  encoder.GetNewFeatures(sparseData, sparseFeatures);
+  CheckMatrices(features, sparseFeatures, 1e-8);
+}
+
+/**
+ * Train a sparse autoencoder with a separable optimizer, and make sure that the
+ * objective decreases.
+ */
+TEST_CASE("SparseAutoencoderSeparableOptimizerTest", "[SparseAutoencoderTest]")
+{
+  const size_t vSize = 10;
+  const size_t hSize = 5;
+
+  arma::mat data(vSize, 500, arma::fill::randu);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize);
+  const double initialObjective = saf.Evaluate(saf.GetInitialPoint());
+
+  ens::Adam adam(0.01, 32, 0.9, 0.999, 1e-8, 20 * data.n_cols, 1e-8, true);
+  SparseAutoencoder encoder(data, vSize, hSize, 0.0001, 3, 0.01, adam);
+
+  REQUIRE(saf.Evaluate(encoder.Parameters()) < initialObjective);
+}
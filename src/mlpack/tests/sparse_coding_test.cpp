@@ -117,6 +117,38 @@ TEMPLATE_TEST_CASE("SparseCodingTestCodingStepElasticNet", "[SparseCodingTest]",
   }
 }
 
+/**
+ * Make sure that encoding into a sparse matrix gives the same codes as
+ * encoding into a dense matrix.
+ */
+TEMPLATE_TEST_CASE("SparseCodingTestSparseEncode", "[SparseCodingTest]",
+    arma::mat, arma::fmat)
+{
+  typedef TestType MatType;
+  typedef typename MatType::elem_type ElemType;
+
+  arma::mat inX; // The .arm file contains an arma::mat.
+  inX.load("mnist_first250_training_4s_and_9s.csv");
+  MatType X = arma::conv_to<MatType>::from(inX);
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding<MatType> sc(25, 0.1);
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+
+  MatType Z;
+  arma::SpMat<ElemType> sparseZ;
+  sc.Encode(X, Z);
+  sc.Encode(X, sparseZ);
+
+  REQUIRE(sparseZ.n_rows == Z.n_rows);
+  REQUIRE(sparseZ.n_cols == Z.n_cols);
+  REQUIRE(sparseZ.n_nonzero == arma::accu(Z != 0));
+  REQUIRE(arma::approx_equal(MatType(sparseZ), Z, "absdiff", 1e-5));
+}
+
 TEMPLATE_TEST_CASE("SparseCodingTestDictionaryStep", "[SparseCodingTest]",
     arma::mat, arma::fmat)
 {
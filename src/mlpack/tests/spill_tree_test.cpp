@@ -301,3 +301,42 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Make sure that the overlapping size decays with depth: with tauDecay = 0,
+ * only the children of the root may share points, and with tauDecay = 1 the
+ * tree is the same as the one built with a constant tau.
+ */
+TEST_CASE("SpillTreeTauDecayTest", "[SpillTreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 1000);
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  TreeType constantTree(dataset, 0.1);
+  TreeType sameTree(dataset, 0.1, 20, 0.7, 1.0);
+  TreeType decayTree(dataset, 0.1, 20, 0.7, 0.0);
+
+  REQUIRE(sameTree.NumDescendants() == constantTree.NumDescendants());
+  REQUIRE(decayTree.NumDescendants() <= constantTree.NumDescendants());
+
+  std::stack<TreeType*> nodes;
+  nodes.push(&decayTree);
+  while (!nodes.empty())
+  {
+    TreeType* node = nodes.top();
+    nodes.pop();
+
+    if (node->IsLeaf())
+      continue;
+
+    // Below the root, no point is put in both children.
+    if (node->Parent() != NULL)
+    {
+      REQUIRE(node->Left()->NumDescendants() +
+          node->Right()->NumDescendants() == node->NumDescendants());
+    }
+
+    nodes.push(node->Left());
+    nodes.push(node->Right());
+  }
+}
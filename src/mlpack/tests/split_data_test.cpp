@@ -352,6 +352,64 @@ TEST_CASE("StratifiedSplitRunTimeErrorTest", "[SplitDataTest]")
       std::runtime_error);
 }
 
+/**
+ * Check that SplitIndices() gives the indices of the columns that Split() puts
+ * in each set, for the same seed.
+ */
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 1000, fill::randu);
+
+  mat trainData, testData;
+  RandomSeed(42);
+  Split(input, trainData, testData, 0.3);
+
+  uvec trainIndices, testIndices;
+  RandomSeed(42);
+  SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+
+  REQUIRE(trainIndices.n_elem == 700);
+  REQUIRE(testIndices.n_elem == 300);
+  CheckMatrices(trainData, mat(input.cols(trainIndices)));
+  CheckMatrices(testData, mat(input.cols(testIndices)));
+
+  // Without shuffling, the indices are in order.
+  SplitIndices(input.n_cols, trainIndices, testIndices, 0.3, false);
+  REQUIRE(all(trainIndices == regspace<uvec>(0, 699)));
+  REQUIRE(all(testIndices == regspace<uvec>(700, 999)));
+}
+
+/**
+ * Check that StratifiedSplitIndices() gives the indices of the columns that
+ * StratifiedSplit() puts in each set, for the same seed.
+ */
+TEST_CASE("StratifiedSplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 480, fill::randu);
+  Row<size_t> labels(480);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = i % 3;
+
+  mat trainData, testData;
+  Row<size_t> trainLabels, testLabels;
+  RandomSeed(42);
+  StratifiedSplit(input, labels, trainData, testData, trainLabels,
+      testLabels, 0.25);
+
+  uvec trainIndices, testIndices;
+  RandomSeed(42);
+  StratifiedSplitIndices(labels, trainIndices, testIndices, 0.25);
+
+  REQUIRE(trainIndices.n_elem == 360);
+  REQUIRE(testIndices.n_elem == 120);
+  CheckMatrices(trainData, mat(input.cols(trainIndices)));
+  CheckMatrices(testData, mat(input.cols(testIndices)));
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    REQUIRE(testLabels[i] == labels[testIndices[i]]);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    REQUIRE(trainLabels[i] == labels[trainIndices[i]]);
+}
+
 /*
  * Split with input of type field<mat>.
  */
@@ -233,6 +233,97 @@ TEST_CASE("SplitByAnyOfTokenizerUnicodeTest", "[StringEncodingTest]")
     REQUIRE(tokens[i] == expectedUtf8Tokens[i]);
 }
 
+/**
+ * Test that the SplitByAnyOf tokenizer finds the same tokens whether the string
+ * is scanned for the delimiters eight bytes at a time or one character at a
+ * time.
+ */
+TEST_CASE("SplitByAnyOfDelimiterCountTest", "[StringEncodingTest]")
+{
+  const std::string alphabet = "ab ,.;:-";
+  std::string line;
+  for (size_t i = 0; i < 1000; ++i)
+    line += alphabet[RandInt(alphabet.size())];
+
+  for (const std::string delimiters : { "", " ", " ,", " ,.;", " ,.;:-" })
+  {
+    for (bool modifyMask : { false, true })
+    {
+      SplitByAnyOf tokenizer(delimiters);
+      std::string allDelimiters = delimiters;
+      if (modifyMask)
+      {
+        tokenizer.Mask()[static_cast<unsigned char>('b')] = true;
+        allDelimiters += 'b';
+      }
+
+      // Split the line naively.
+      std::vector<std::string> expected;
+      std::string current;
+      for (const char c : line)
+      {
+        if (allDelimiters.find(c) == std::string::npos)
+        {
+          current += c;
+        }
+        else if (!current.empty())
+        {
+          expected.push_back(current);
+          current.clear();
+        }
+      }
+      if (!current.empty())
+        expected.push_back(current);
+
+      std::vector<std::string_view> tokens;
+      std::string_view view(line);
+      std::string_view token = tokenizer(view);
+      while (!token.empty())
+      {
+        tokens.push_back(token);
+        token = tokenizer(view);
+      }
+
+      REQUIRE(tokens.size() == expected.size());
+      for (size_t i = 0; i < tokens.size(); ++i)
+        REQUIRE(tokens[i] == expected[i]);
+    }
+  }
+}
+
+/**
+ * Test that the tokens of the dictionary stay valid as it grows, and are copied
+ * with it, even if they are longer than the blocks they are stored in.
+ */
+TEST_CASE("StringEncodingDictionaryArenaTest", "[StringEncodingTest]")
+{
+  using DictionaryType = StringEncodingDictionary<std::string_view>;
+
+  std::vector<std::string> tokens;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    const size_t length = (i % 1000 == 0) ? DictionaryType::BlockSize + 10 :
+        1 + RandInt(20);
+    tokens.push_back(std::string(length, 'a' + (i % 26)) + to_string(i));
+  }
+
+  DictionaryType dictionary;
+  for (const std::string& token : tokens)
+    dictionary.AddToken(token);
+
+  DictionaryType copy(dictionary);
+  dictionary.Clear();
+
+  REQUIRE(dictionary.Size() == 0);
+  REQUIRE(copy.Size() == tokens.size());
+  REQUIRE(copy.Tokens().size() == tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    REQUIRE(copy.Tokens()[i] == tokens[i]);
+    REQUIRE(copy.Value(tokens[i]) == i + 1);
+  }
+}
+
 /**
  * Test the CharExtract tokenizer.
  */
@@ -300,9 +391,10 @@ TEST_CASE("StringEncodingCopyTest", "[StringEncodingTest]")
     DictionaryEncoding<SplitByAnyOf::TokenType> encoder;
     encoder.Encode(stringEncodingInput, output, tokenizer);
 
-    for (const string& token : encoder.Dictionary().Tokens())
+    for (const std::string_view token : encoder.Dictionary().Tokens())
     {
-      naiveDictionary.emplace_back(token, encoder.Dictionary().Value(token));
+      naiveDictionary.emplace_back(std::string(token),
+          encoder.Dictionary().Value(token));
     }
 
     encoderCopy = DictionaryEncoding<SplitByAnyOf::TokenType>(encoder);
@@ -336,9 +428,10 @@ TEST_CASE("StringEncodingMoveTest", "[StringEncodingTest]")
     DictionaryEncoding<SplitByAnyOf::TokenType> encoder;
     encoder.Encode(stringEncodingInput, output, tokenizer);
 
-    for (const string& token : encoder.Dictionary().Tokens())
+    for (const std::string_view token : encoder.Dictionary().Tokens())
     {
-      naiveDictionary.emplace_back(token, encoder.Dictionary().Value(token));
+      naiveDictionary.emplace_back(std::string(token),
+          encoder.Dictionary().Value(token));
     }
 
     encoderCopy = std::move(encoder);
@@ -400,8 +493,8 @@ void CheckDictionaries(
   using MapType =
       typename StringEncodingDictionary<std::string_view>::MapType;
 
-  const std::deque<std::string>& expectedTokens = expected.Tokens();
-  const std::deque<std::string>& tokens = obtained.Tokens();
+  const std::vector<std::string_view>& expectedTokens = expected.Tokens();
+  const std::vector<std::string_view>& tokens = obtained.Tokens();
   const MapType& expectedMapping = expected.Mapping();
   const MapType& mapping = obtained.Mapping();
 
@@ -1427,3 +1520,126 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Check that encoding into a sparse matrix, and into a dense matrix (which are
+ * both done in parallel), gives the same result as encoding into a vector,
+ * with the given encoder type.
+ */
+template<typename EncoderType, typename TokenizerType>
+void CheckCountEncodings(const vector<string>& input,
+                         const TokenizerType& tokenizer,
+                         const EncoderType& encoder)
+{
+  EncoderType vectorEncoder(encoder), sparseEncoder(encoder),
+      denseEncoder(encoder);
+  vector<vector<double>> vectorOutput;
+  arma::sp_mat sparseOutput;
+  arma::mat denseOutput;
+
+  vectorEncoder.Encode(input, vectorOutput, tokenizer);
+  sparseEncoder.Encode(input, sparseOutput, tokenizer);
+  denseEncoder.Encode(input, denseOutput, tokenizer);
+
+  REQUIRE(sparseOutput.n_rows == vectorEncoder.Dictionary().Size());
+  REQUIRE(sparseOutput.n_cols == input.size());
+  REQUIRE(sparseEncoder.Dictionary().Size() ==
+      vectorEncoder.Dictionary().Size());
+
+  arma::mat expected(vectorEncoder.Dictionary().Size(), input.size(),
+      arma::fill::zeros);
+  for (size_t i = 0; i < vectorOutput.size(); ++i)
+    for (size_t j = 0; j < vectorOutput[i].size(); ++j)
+      expected(j, i) = vectorOutput[i][j];
+
+  CheckMatrices(arma::mat(sparseOutput), expected, 1e-8);
+  CheckMatrices(denseOutput, expected, 1e-8);
+}
+
+/**
+ * Test that the bag of words and tf-idf encodings into sparse and dense
+ * matrices match the encoding into a vector, on a corpus large enough to be
+ * split between threads.
+ */
+TEST_CASE("ParallelCountEncodingTest", "[StringEncodingTest]")
+{
+  vector<string> input;
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    const size_t numWords = RandInt(0, 20);
+    string line;
+    for (size_t j = 0; j < numWords; ++j)
+    {
+      line += "w" + to_string(RandInt(0, (j % 3 == 0) ? 20 : 2000)) +
+          ((j % 2 == 0) ? " " : ", ");
+    }
+    input.push_back(line);
+  }
+  input.insert(input.end(), stringEncodingInput.begin(),
+      stringEncodingInput.end());
+
+  SplitByAnyOf tokenizer(" ,.");
+  CheckCountEncodings(input, tokenizer,
+      BagOfWordsEncoding<SplitByAnyOf::TokenType>());
+  CheckCountEncodings(input, CharExtract(), BagOfWordsEncoding<int>());
+
+  const TfIdfEncodingPolicy::TfTypes tfTypes[] = {
+      TfIdfEncodingPolicy::TfTypes::BINARY,
+      TfIdfEncodingPolicy::TfTypes::RAW_COUNT,
+      TfIdfEncodingPolicy::TfTypes::TERM_FREQUENCY,
+      TfIdfEncodingPolicy::TfTypes::SUBLINEAR_TF };
+  for (const TfIdfEncodingPolicy::TfTypes tfType : tfTypes)
+  {
+    CheckCountEncodings(input, tokenizer,
+        TfIdfEncoding<SplitByAnyOf::TokenType>(tfType, true));
+    CheckCountEncodings(input, tokenizer,
+        TfIdfEncoding<SplitByAnyOf::TokenType>(tfType, false));
+  }
+}
+
+/**
+ * Test the bag of words encoding with feature hashing instead of a dictionary.
+ */
+TEST_CASE("FeatureHashingEncodingTest", "[StringEncodingTest]")
+{
+  using EncoderType = HashingBagOfWordsEncoding<SplitByAnyOf::TokenType>;
+
+  EncoderType encoder;
+  encoder.Dictionary().NumFeatures() = 16;
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::sp_mat output;
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  REQUIRE(output.n_rows == 16);
+  REQUIRE(output.n_cols == stringEncodingInput.size());
+
+  // Count the tokens of each line by hand.
+  arma::mat expected(16, stringEncodingInput.size(), arma::fill::zeros);
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    std::string_view strView(stringEncodingInput[i]);
+    std::string_view token = tokenizer(strView);
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      const size_t label = encoder.Dictionary().Value(token);
+      REQUIRE(label >= 1);
+      REQUIRE(label <= 16);
+      expected(label - 1, i) += 1;
+      token = tokenizer(strView);
+    }
+  }
+
+  CheckMatrices(arma::mat(output), expected);
+
+  // The labels do not depend on the tokens seen before.
+  EncoderType otherEncoder;
+  otherEncoder.Dictionary().NumFeatures() = 16;
+  REQUIRE(otherEncoder.Dictionary().Value("machine") ==
+      encoder.Dictionary().Value("machine"));
+
+  // The tf-idf encoding with feature hashing matches the vector encoding.
+  HashingTfIdfEncoding<SplitByAnyOf::TokenType> tfIdfEncoder;
+  tfIdfEncoder.Dictionary().NumFeatures() = 16;
+  CheckCountEncodings(stringEncodingInput, tokenizer, tfIdfEncoder);
+}
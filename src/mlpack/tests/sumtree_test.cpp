@@ -87,3 +87,49 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   CHECK(sumtree.FindPrefixSum(2.8) <= 3);
   CHECK(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Test that a partial batched update gives the same tree as setting each
+ * element, on a capacity that is not a power of two.
+ */
+TEST_CASE("PartialBatchUpdate", "[SumTreeTest]")
+{
+  SumTree<double> batched(37), single(37);
+  arma::colvec initial(37, arma::fill::randu);
+  for (size_t i = 0; i < 37; ++i)
+  {
+    batched.Set(i, initial[i]);
+    single.Set(i, initial[i]);
+  }
+
+  arma::ucolvec indices = { 3, 17, 17, 36, 0, 21 };
+  arma::colvec data = { 0.5, 2.0, 1.5, 0.25, 3.0, 0.0 };
+  batched.BatchUpdate(indices, data);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    single.Set(indices[i], data[i]);
+
+  REQUIRE(batched.Sum() == Approx(single.Sum()).epsilon(1e-10));
+  for (size_t i = 0; i < 37; ++i)
+    REQUIRE(batched.Get(i) == Approx(single.Get(i)).epsilon(1e-10));
+}
+
+/**
+ * Test that the batched prefix sum search finds the same indices as the
+ * single search.
+ */
+TEST_CASE("FindPrefixSums", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(64);
+  for (size_t i = 0; i < 64; ++i)
+    sumtree.Set(i, arma::randu());
+
+  arma::colvec masses(100, arma::fill::randu);
+  masses *= sumtree.Sum();
+
+  arma::ucolvec indices;
+  sumtree.FindPrefixSums(masses, indices);
+
+  REQUIRE(indices.n_elem == masses.n_elem);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+    REQUIRE(indices[i] == sumtree.FindPrefixSum(masses[i]));
+}
@@ -56,3 +56,64 @@ TEST_CASE("AMFMaxIterationTerminationTest", "[TerminationPolicyTest]")
 
   REQUIRE(nmf.TerminationPolicy().Iteration() == 10);
 }
+
+/**
+ * Make sure that the sampled residue matches the RMSE at the sampled entries
+ * when every entry is sampled many times, and that AMF terminates before the
+ * iteration limit on a low-rank matrix.
+ */
+TEST_CASE("SampledResidueTerminationTest", "[TerminationPolicyTest]")
+{
+  mat w = randu<mat>(20, 3);
+  mat h = randu<mat>(3, 30);
+  mat v = w * h;
+
+  // The residue of the exact factorization is 0.
+  SampledResidueTermination<mat> srt(1e-5, 100, 2000);
+  srt.Initialize(v);
+  REQUIRE(srt.IsConverged(w, h) == false);
+  REQUIRE(srt.Index() == Approx(0.0).margin(1e-10));
+
+  // Perturb the factorization; with enough samples, the estimate is close to
+  // the RMSE over the whole matrix.
+  mat w2 = w + 0.1 * randn<mat>(20, 3);
+  srt.IsConverged(w2, h);
+  const double rmse = std::sqrt(accu(square(v - w2 * h)) / v.n_elem);
+  REQUIRE(srt.Index() == Approx(rmse).epsilon(0.2));
+
+  SampledResidueTermination<mat> srt2(1e-5, 1000, 500);
+  AMF<SampledResidueTermination<mat>,
+      RandomAMFInitialization,
+      NMFALSUpdate> nmf(srt2);
+  mat wOut, hOut;
+  nmf.Apply(v, 3, wOut, hOut);
+
+  REQUIRE(nmf.TerminationPolicy().Iteration() < 1000);
+  REQUIRE(nmf.TerminationPolicy().Index() < 0.1);
+}
+
+/**
+ * Make sure that only the nonzero entries of a sparse matrix are sampled.
+ */
+TEST_CASE("SampledResidueTerminationSparseTest", "[TerminationPolicyTest]")
+{
+  sp_mat v;
+  v.sprandu(100, 80, 0.05);
+
+  mat w(100, 4, fill::zeros);
+  mat h(4, 80, fill::zeros);
+
+  // With W * H = 0, the error at every sampled entry is the value of V, so the
+  // residue is the RMS of the sampled nonzero values.
+  SampledResidueTermination<sp_mat> srt(1e-5, 100, 400);
+  srt.Initialize(v);
+  srt.IsConverged(w, h);
+
+  const double minValue = arma::min(arma::nonzeros(v));
+  REQUIRE(srt.Index() >= minValue);
+  REQUIRE(srt.Index() <= arma::max(arma::nonzeros(v)));
+
+  // The same entries are used again, so an unchanged factorization converges.
+  REQUIRE(srt.IsConverged(w, h) == true);
+  REQUIRE(srt.Iteration() == 2);
+}
@@ -143,3 +143,56 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Make sure that nested profiler scopes form a call tree and are counted
+ * correctly.
+ */
+TEST_CASE("ProfilerCallTreeTest", "[TimerTest]")
+{
+  util::Profiler profiler;
+  const size_t outer = profiler.Register("outer");
+  const size_t inner = profiler.Register("inner");
+  REQUIRE(profiler.Register("outer") == outer);
+  REQUIRE(profiler.Name(inner) == "inner");
+  REQUIRE_THROWS_AS(profiler.Name(5), std::invalid_argument);
+
+  // Nothing is recorded while the profiler is disabled.
+  {
+    util::ProfileScope scope(outer, profiler);
+  }
+
+  profiler.Enabled() = true;
+  profiler.RecordEvents() = true;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    util::ProfileScope outerScope(outer, profiler);
+    for (size_t j = 0; j < 2; ++j)
+      util::ProfileScope innerScope(inner, profiler);
+  }
+
+  std::ostringstream json;
+  profiler.WriteJSON(json);
+  const std::string s = json.str();
+  const size_t outerPos = s.find("\"name\": \"outer\"");
+  const size_t innerPos = s.find("\"name\": \"inner\"");
+  REQUIRE(outerPos != std::string::npos);
+  REQUIRE(innerPos != std::string::npos);
+  REQUIRE(innerPos > outerPos);
+  REQUIRE(s.find("\"count\": 3", outerPos) < innerPos);
+  REQUIRE(s.find("\"count\": 6", innerPos) != std::string::npos);
+
+  // Every scope was recorded for the trace.
+  std::ostringstream trace;
+  profiler.WriteChromeTrace(trace);
+  size_t events = 0;
+  for (size_t pos = trace.str().find("\"ph\": \"X\""); pos != std::string::npos;
+       pos = trace.str().find("\"ph\": \"X\"", pos + 1))
+    ++events;
+  REQUIRE(events == 9);
+
+  profiler.Reset();
+  std::ostringstream empty;
+  profiler.WriteJSON(empty);
+  REQUIRE(empty.str().find("outer") == std::string::npos);
+}
@@ -1030,6 +1030,134 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Check the MinDistance() functions of HRectBound that stop early against the
+ * exact ones, for random bounds in enough dimensions that the bound is checked
+ * several times.
+ */
+template<typename DistanceType, typename ElemType>
+void CheckBoundedMinDistance()
+{
+  typedef HRectBound<DistanceType, ElemType> BoundType;
+  typedef arma::Col<ElemType> VecType;
+
+  for (size_t trial = 0; trial < 100; ++trial)
+  {
+    const VecType lo = arma::randu<VecType>(30);
+    const VecType hi = lo + arma::randu<VecType>(30);
+    BoundType b(30), c(30);
+    b |= arma::Mat<ElemType>(join_rows(lo, hi));
+    c |= arma::Mat<ElemType>(4 * arma::randu<arma::Mat<ElemType>>(30, 2));
+    const VecType point = 4 * arma::randu<VecType>(30);
+
+    const ElemType pointDistance = b.MinDistance(point);
+    const ElemType boundDistance = b.MinDistance(c);
+
+    // Without a useful bound, the exact distance is returned.
+    REQUIRE(b.MinDistance(point, std::numeric_limits<ElemType>::max()) ==
+        Approx(pointDistance).epsilon(1e-5));
+    REQUIRE(b.MinDistance(c, std::numeric_limits<ElemType>::max()) ==
+        Approx(boundDistance).epsilon(1e-5));
+
+    // Otherwise, the result is exact if it is below the bound, and at least the
+    // bound if not.
+    const ElemType bound = (ElemType) (2 * arma::randu());
+    const ElemType boundedPoint = b.MinDistance(point, bound);
+    const ElemType boundedBound = b.MinDistance(c, bound);
+    if (pointDistance < bound)
+      REQUIRE(boundedPoint == Approx(pointDistance).epsilon(1e-5));
+    else
+      REQUIRE(boundedPoint >= bound);
+
+    if (boundDistance < bound)
+      REQUIRE(boundedBound == Approx(boundDistance).epsilon(1e-5));
+    else
+      REQUIRE(boundedBound >= bound);
+
+    REQUIRE(boundedPoint <= pointDistance * (1 + 1e-5));
+    REQUIRE(boundedBound <= boundDistance * (1 + 1e-5));
+  }
+}
+
+TEST_CASE("HRectBoundBoundedMinDistance", "[TreeTest]")
+{
+  CheckBoundedMinDistance<EuclideanDistance, double>();
+  CheckBoundedMinDistance<EuclideanDistance, float>();
+  CheckBoundedMinDistance<SquaredEuclideanDistance, double>();
+  CheckBoundedMinDistance<ManhattanDistance, double>();
+  CheckBoundedMinDistance<LMetric<3, true>, float>();
+}
+
+/**
+ * Make sure that the distance functions of low-dimensional bounds (whose loops
+ * have a fixed length and whose ranges are stored in the bound) match the
+ * definitions, and that such bounds can be copied and moved to and from bounds
+ * with more dimensions.
+ */
+TEST_CASE("HRectBoundLowDimensionalTest", "[TreeTest]")
+{
+  for (size_t dim = 1; dim <= 5; ++dim)
+  {
+    HRectBound<EuclideanDistance> a(dim), b(dim);
+    a |= arma::mat(dim, 5, arma::fill::randu);
+    b |= arma::mat(dim, 5, arma::fill::randu) + 0.5;
+    const arma::vec point(dim, arma::fill::randn);
+
+    double pointMin = 0.0, pointMax = 0.0, boundMin = 0.0, boundMax = 0.0;
+    for (size_t d = 0; d < dim; ++d)
+    {
+      const double pMin = std::max(std::max(a[d].Lo() - point[d],
+          point[d] - a[d].Hi()), 0.0);
+      const double pMax = std::max(std::abs(point[d] - a[d].Lo()),
+          std::abs(a[d].Hi() - point[d]));
+      const double bMin = std::max(std::max(b[d].Lo() - a[d].Hi(),
+          a[d].Lo() - b[d].Hi()), 0.0);
+      const double bMax = std::max(b[d].Hi() - a[d].Lo(),
+          a[d].Hi() - b[d].Lo());
+      pointMin += pMin * pMin;
+      pointMax += pMax * pMax;
+      boundMin += bMin * bMin;
+      boundMax += bMax * bMax;
+    }
+
+    REQUIRE(a.MinDistance(point) ==
+        Approx(std::sqrt(pointMin)).margin(1e-10));
+    REQUIRE(a.MinDistance(point, DBL_MAX) ==
+        Approx(std::sqrt(pointMin)).margin(1e-10));
+    REQUIRE(a.MaxDistance(point) ==
+        Approx(std::sqrt(pointMax)).margin(1e-10));
+    REQUIRE(a.RangeDistance(point).Lo() ==
+        Approx(std::sqrt(pointMin)).margin(1e-10));
+    REQUIRE(a.RangeDistance(point).Hi() ==
+        Approx(std::sqrt(pointMax)).margin(1e-10));
+
+    REQUIRE(a.MinDistance(b) == Approx(std::sqrt(boundMin)).margin(1e-10));
+    REQUIRE(a.MinDistance(b, DBL_MAX) ==
+        Approx(std::sqrt(boundMin)).margin(1e-10));
+    REQUIRE(a.MaxDistance(b) == Approx(std::sqrt(boundMax)).margin(1e-10));
+    REQUIRE(a.RangeDistance(b).Lo() ==
+        Approx(std::sqrt(boundMin)).margin(1e-10));
+    REQUIRE(a.RangeDistance(b).Hi() ==
+        Approx(std::sqrt(boundMax)).margin(1e-10));
+
+    // Copy and move the bound into bounds of another dimensionality.
+    HRectBound<EuclideanDistance> c(6 - dim), d(6 - dim);
+    c = a;
+    d = std::move(b);
+    HRectBound<EuclideanDistance> e(std::move(c));
+    REQUIRE(c.Dim() == 0);
+    REQUIRE(d.Dim() == dim);
+    REQUIRE(e.Dim() == dim);
+    for (size_t i = 0; i < dim; ++i)
+    {
+      REQUIRE(e[i].Lo() == a[i].Lo());
+      REQUIRE(e[i].Hi() == a[i].Hi());
+    }
+    REQUIRE(e.MinDistance(point) == a.MinDistance(point));
+    REQUIRE(d.MinDistance(a) == Approx(std::sqrt(boundMin)).margin(1e-10));
+  }
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -1353,6 +1481,321 @@ TEST_CASE("KdTreeTest", "[TreeTest]")
   TreeType root(dataset);
 }
 
+// Check that two binary space trees have exactly the same structure.
+template<typename TreeType>
+void CheckSameStructure(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Begin() == b.Begin());
+  REQUIRE(a.Count() == b.Count());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  REQUIRE(a.ParentDistance() == Approx(b.ParentDistance()).epsilon(1e-10));
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+    CheckSameStructure(a.Child(i), b.Child(i));
+}
+
+/**
+ * Build a kd-tree large enough that its subtrees are built in parallel, and
+ * make sure that it is valid and identical to the tree built by one thread.
+ */
+TEST_CASE("ParallelKdTreeBuildTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 100000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew);
+  const arma::mat& treeset = root.Dataset();
+
+  REQUIRE(root.Count() == dataset.n_cols);
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    for (size_t j = 0; j < dataset.n_rows; ++j)
+      REQUIRE(treeset(j, i) == dataset(j, oldFromNew[i]));
+
+  REQUIRE(CheckPointBounds(root));
+
+  #ifdef MLPACK_USE_OPENMP
+  const int numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> serialOldFromNew;
+  TreeType serialRoot(dataset, serialOldFromNew);
+
+  #ifdef MLPACK_USE_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    REQUIRE(oldFromNew[i] == serialOldFromNew[i]);
+  CheckSameStructure(root, serialRoot);
+}
+
+/**
+ * Make sure that the nodes of a kd-tree are allocated from the node pool of the
+ * root, and that copies, moves, and assignments of the tree handle the pool
+ * correctly.
+ */
+TEST_CASE("KdTreeNodePoolTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 2000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  TreeType root(dataset, oldFromNew, 5);
+  REQUIRE(root.HasNodePool());
+  REQUIRE(!root.IsPacked());
+  REQUIRE(!root.Left()->HasNodePool());
+  REQUIRE(CheckPointBounds(root));
+
+  // The tree must be the same as the one built from the same data without a
+  // pool, which is what a copy is.
+  TreeType copiedRoot(root);
+  REQUIRE(!copiedRoot.HasNodePool());
+  CheckSameStructure(root, copiedRoot);
+
+  TreeType movedRoot(std::move(root));
+  REQUIRE(movedRoot.HasNodePool());
+  REQUIRE(!root.HasNodePool());
+  REQUIRE(movedRoot.Left()->Parent() == &movedRoot);
+  CheckSameStructure(copiedRoot, movedRoot);
+
+  // Assigning over a pooled tree frees the old pool.
+  movedRoot = TreeType(arma::mat(3, 500, arma::fill::randu), 5);
+  REQUIRE(movedRoot.HasNodePool());
+  REQUIRE(CheckPointBounds(movedRoot));
+  copiedRoot = movedRoot;
+  REQUIRE(!copiedRoot.HasNodePool());
+  CheckSameStructure(copiedRoot, movedRoot);
+
+  // A tree that is only a leaf does not need a pool.
+  TreeType leafRoot(dataset, 5000);
+  REQUIRE(leafRoot.IsLeaf());
+  REQUIRE(!leafRoot.HasNodePool());
+}
+
+/**
+ * Make sure that packing the nodes of a kd-tree into an arena does not change
+ * the tree, and that all of the descendants end up in one block of memory.
+ */
+TEST_CASE("PackedKdTreeTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 2000, arma::fill::randu);
+  TreeType root(dataset, 5);
+
+  for (size_t layout = 0; layout < 2; ++layout)
+  {
+    TreeType packedRoot(root);
+    REQUIRE(!packedRoot.IsPacked());
+    packedRoot.PackNodes(layout == 1);
+    REQUIRE(packedRoot.IsPacked());
+
+    CheckSameStructure(root, packedRoot);
+    REQUIRE(CheckPointBounds(packedRoot));
+
+    // Collect the addresses of every descendant node.
+    std::vector<const TreeType*> nodes;
+    std::stack<const TreeType*> stack;
+    stack.push(packedRoot.Left());
+    stack.push(packedRoot.Right());
+    while (!stack.empty())
+    {
+      const TreeType* node = stack.top();
+      stack.pop();
+
+      nodes.push_back(node);
+      REQUIRE(node->Dataset().memptr() == packedRoot.Dataset().memptr());
+      if (!node->IsLeaf())
+      {
+        REQUIRE(node->Left()->Parent() == node);
+        REQUIRE(node->Right()->Parent() == node);
+        stack.push(node->Left());
+        stack.push(node->Right());
+      }
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    for (size_t i = 1; i < nodes.size(); ++i)
+      REQUIRE(nodes[i] == nodes[0] + i);
+
+    // The parent of the children of the root must be the root.
+    REQUIRE(packedRoot.Left()->Parent() == &packedRoot);
+    REQUIRE(packedRoot.Right()->Parent() == &packedRoot);
+
+    // A copy of a packed tree is a regular tree; a moved tree stays packed.
+    TreeType copiedRoot(packedRoot);
+    REQUIRE(!copiedRoot.IsPacked());
+    CheckSameStructure(root, copiedRoot);
+
+    TreeType movedRoot(std::move(packedRoot));
+    REQUIRE(movedRoot.IsPacked());
+    REQUIRE(movedRoot.Left()->Parent() == &movedRoot);
+    CheckSameStructure(root, movedRoot);
+
+    // Packing a tree twice is fine too.
+    movedRoot.PackNodes(layout == 0);
+    CheckSameStructure(root, movedRoot);
+  }
+
+  // Only the root can be packed.
+  REQUIRE_THROWS_AS(root.Left()->PackNodes(), std::invalid_argument);
+}
+
+/**
+ * Map the given tree file with MappedTree, and make sure it holds the same tree
+ * as the given one.
+ */
+template<typename TreeType>
+void CheckSameMappedTree(const TreeType& root,
+                         const std::vector<size_t>& oldFromNew,
+                         const std::string& filename)
+{
+  {
+    MappedTree<TreeType> mapped(filename);
+    const TreeType& mappedRoot = mapped.Tree();
+
+    CheckSameStructure(root, mappedRoot);
+    REQUIRE(mappedRoot.IsPacked());
+    REQUIRE(arma::approx_equal(mappedRoot.Dataset(), root.Dataset(), "absdiff",
+        0.0));
+    REQUIRE(mapped.OldFromNew().size() == oldFromNew.size());
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+      REQUIRE(mapped.OldFromNew()[i] == oldFromNew[i]);
+
+    // Compare the bounds and cached distances of every node.
+    std::stack<std::pair<const TreeType*, const TreeType*>> stack;
+    stack.push(std::make_pair(&root, &mappedRoot));
+    while (!stack.empty())
+    {
+      const TreeType* node = stack.top().first;
+      const TreeType* mappedNode = stack.top().second;
+      stack.pop();
+
+      REQUIRE(node->Bound().Dim() == mappedNode->Bound().Dim());
+      for (size_t d = 0; d < node->Bound().Dim(); ++d)
+      {
+        REQUIRE(node->Bound()[d].Lo() == mappedNode->Bound()[d].Lo());
+        REQUIRE(node->Bound()[d].Hi() == mappedNode->Bound()[d].Hi());
+      }
+      REQUIRE(node->FurthestDescendantDistance() ==
+          mappedNode->FurthestDescendantDistance());
+      REQUIRE(node->MinimumBoundDistance() ==
+          mappedNode->MinimumBoundDistance());
+      REQUIRE(&mappedNode->Dataset() == &mappedRoot.Dataset());
+
+      if (!node->IsLeaf())
+      {
+        REQUIRE(mappedNode->Left()->Parent() == mappedNode);
+        REQUIRE(mappedNode->Right()->Parent() == mappedNode);
+        stack.push(std::make_pair(node->Left(), mappedNode->Left()));
+        stack.push(std::make_pair(node->Right(), mappedNode->Right()));
+      }
+    }
+  }
+
+  remove(filename.c_str());
+}
+
+/**
+ * Save a tree with MappedTree, map it again, and make sure it is the same.
+ */
+template<typename TreeType>
+void CheckMappedTree(const TreeType& root,
+                     const std::vector<size_t>& oldFromNew)
+{
+  MappedTree<TreeType>::Save("mapped_tree.bin", root, oldFromNew);
+  CheckSameMappedTree(root, oldFromNew, "mapped_tree.bin");
+}
+
+TEST_CASE("MappedKdTreeTest", "[TreeTest]")
+{
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> root(dataset,
+      oldFromNew);
+
+  CheckMappedTree(root, oldFromNew);
+  CheckMappedTree(root, std::vector<size_t>());
+}
+
+TEST_CASE("MappedBallTreeTest", "[TreeTest]")
+{
+  arma::fmat dataset(5, 1000, arma::fill::randu);
+  std::vector<size_t> oldFromNew;
+  BallTree<EuclideanDistance, EmptyStatistic, arma::fmat> root(dataset,
+      oldFromNew);
+
+  CheckMappedTree(root, oldFromNew);
+}
+
+/**
+ * Build trees out of core from raw dataset files, and make sure they are the
+ * same as the trees built in memory.
+ */
+TEST_CASE("MappedTreeBuildTest", "[TreeTest]")
+{
+  arma::mat dataset(5, 2000, arma::fill::randu);
+  dataset.save("mapped_tree_data.bin", arma::raw_binary);
+
+  std::vector<size_t> oldFromNew;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> root(dataset,
+      oldFromNew, 15);
+  MappedTree<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>>::Build(
+      "mapped_tree_data.bin", 5, "mapped_tree.bin", 15);
+  CheckSameMappedTree(root, oldFromNew, "mapped_tree.bin");
+
+  arma::fmat fdataset(4, 1500, arma::fill::randu);
+  fdataset.save("mapped_tree_data.bin", arma::raw_binary);
+
+  std::vector<size_t> ballOldFromNew;
+  BallTree<EuclideanDistance, EmptyStatistic, arma::fmat> ballRoot(fdataset,
+      ballOldFromNew);
+  MappedTree<BallTree<EuclideanDistance, EmptyStatistic, arma::fmat>>::Build(
+      "mapped_tree_data.bin", 4, "mapped_tree.bin");
+  CheckSameMappedTree(ballRoot, ballOldFromNew, "mapped_tree.bin");
+
+  // The size of the dataset file must be a multiple of the size of a point.
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  REQUIRE_THROWS_AS(MappedTree<TreeType>::Build("mapped_tree_data.bin", 7,
+      "mapped_tree.bin"), std::invalid_argument);
+  REQUIRE_THROWS_AS(MappedTree<TreeType>::Build("mapped_tree_data_none.bin",
+      5, "mapped_tree.bin"), std::runtime_error);
+
+  remove("mapped_tree_data.bin");
+}
+
+/**
+ * Make sure that files that are not valid trees of the right type are not
+ * accepted.
+ */
+TEST_CASE("MappedTreeInvalidFileTest", "[TreeTest]")
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  REQUIRE_THROWS_AS(MappedTree<TreeType>("nonexistent_tree.bin"),
+      std::runtime_error);
+
+  std::ofstream out("mapped_tree.bin", std::ios::binary);
+  out << "this is not a tree";
+  out.close();
+  REQUIRE_THROWS_AS(MappedTree<TreeType>("mapped_tree.bin"),
+      std::runtime_error);
+
+  // A tree of a different element type.
+  arma::fmat dataset(3, 100, arma::fill::randu);
+  KDTree<EuclideanDistance, EmptyStatistic, arma::fmat> floatTree(dataset);
+  MappedTree<KDTree<EuclideanDistance, EmptyStatistic, arma::fmat>>::Save(
+      "mapped_tree.bin", floatTree);
+  REQUIRE_THROWS_AS(MappedTree<TreeType>("mapped_tree.bin"),
+      std::runtime_error);
+
+  remove("mapped_tree.bin");
+}
+
 TEST_CASE("MaxRPTreeTest", "[TreeTest]")
 {
   typedef MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
@@ -1920,6 +2363,30 @@ TEST_CASE("CoverTreeConstructionTest", "[TreeTest]")
   // implementation.
 }
 
+/**
+ * Build a cover tree on enough points that the distance computations near the
+ * root are done in parallel, and make sure it's still valid.
+ */
+TEST_CASE("LargeCoverTreeConstructionTest", "[TreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(5, 20000);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  arma::vec counts;
+  counts.zeros(20000);
+  RecurseTreeCountLeaves(tree, counts);
+
+  for (size_t i = 0; i < 20000; ++i)
+    REQUIRE(counts[i] == 1);
+
+  CheckSelfChild<TreeType>(tree);
+  CheckCovering<TreeType, LMetric<2, true> >(tree);
+}
+
 /**
  * Create a cover tree on sparse data and make sure it's accurate.
  */
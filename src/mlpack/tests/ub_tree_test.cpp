@@ -40,6 +40,39 @@ TEST_CASE("AddressTest", "[UBTreeTest]")
   }
 }
 
+/**
+ * Make sure that AddressOrder() returns a permutation of the points that is
+ * sorted by address.
+ */
+TEST_CASE("AddressOrderTest", "[UBTreeTest]")
+{
+  typedef uint64_t AddressElemType;
+  arma::mat dataset(5, 1000, arma::fill::randu);
+  dataset -= 0.5;
+
+  std::vector<size_t> order;
+  AddressOrder(dataset, order);
+
+  REQUIRE(order.size() == dataset.n_cols);
+
+  // Every point must appear exactly once.
+  std::vector<size_t> sortedOrder(order);
+  std::sort(sortedOrder.begin(), sortedOrder.end());
+  for (size_t i = 0; i < sortedOrder.size(); ++i)
+    REQUIRE(sortedOrder[i] == i);
+
+  // The addresses must be non-decreasing.
+  arma::Col<AddressElemType> lastAddress(dataset.n_rows);
+  arma::Col<AddressElemType> address(dataset.n_rows);
+  PointToAddress(lastAddress, dataset.col(order[0]));
+  for (size_t i = 1; i < order.size(); ++i)
+  {
+    PointToAddress(address, dataset.col(order[i]));
+    REQUIRE(CompareAddresses(lastAddress, address) <= 0);
+    lastAddress = address;
+  }
+}
+
 template<typename TreeType>
 void CheckSplit(const TreeType& tree)
 {
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 #include "catch.hpp"
 
 using namespace mlpack;
@@ -45,3 +46,67 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+TEST_CASE("TestCompress", "[UnionFindTest]")
+{
+  static const size_t testSize = 10;
+  UnionFind testUnionFind(testSize);
+
+  testUnionFind.Union(0, 1);
+  testUnionFind.Union(2, 3);
+  testUnionFind.Union(0, 2);
+  testUnionFind.Union(7, 8);
+
+  arma::Col<size_t> components(testSize);
+  for (size_t i = 0; i < testSize; ++i)
+    components[i] = testUnionFind.Find(i);
+
+  // Compressing must not change any component.
+  testUnionFind.Compress();
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == components[i]);
+
+  REQUIRE(testUnionFind.Find(0) == testUnionFind.Find(3));
+  REQUIRE(testUnionFind.Find(7) == testUnionFind.Find(8));
+  REQUIRE(testUnionFind.Find(0) != testUnionFind.Find(7));
+}
+
+TEST_CASE("TestConcurrentUnion", "[UnionFindTest]")
+{
+  static const size_t testSize = 10;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == i);
+
+  testUnionFind.Union(0, 1);
+  testUnionFind.Union(2, 3);
+  testUnionFind.Union(0, 2);
+  testUnionFind.Union(5, 0);
+  testUnionFind.Union(9, 8);
+
+  // Each component is represented by its smallest element.
+  REQUIRE(testUnionFind.Find(3) == 0);
+  REQUIRE(testUnionFind.Find(5) == 0);
+  REQUIRE(testUnionFind.Find(9) == 8);
+  REQUIRE(testUnionFind.Find(4) == 4);
+}
+
+TEST_CASE("TestConcurrentUnionParallel", "[UnionFindTest]")
+{
+  // Union every element with its neighbor in many threads at once, in an
+  // order that differs between threads; in the end there must be two
+  // components (the even and the odd elements).
+  static const size_t testSize = 10000;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (size_t i = 0; i < testSize - 2; ++i)
+  {
+    const size_t j = (i * 7919) % (testSize - 2);
+    testUnionFind.Union(j + 2, j);
+  }
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == i % 2);
+}
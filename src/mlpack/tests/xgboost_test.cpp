@@ -10,10 +10,11 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core.hpp>
-#include <mlpack/methods/xgboost/loss_functions/sse_loss.hpp>
+#include <mlpack/methods/xgboost.hpp>
 
 #include "catch.hpp"
 #include "serialization.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 
@@ -63,3 +64,255 @@ TEST_CASE("SSEGainTest", "[XGBTest]")
   SSELoss Loss;
   REQUIRE(Loss.Evaluate<false>(input, weights) == gain);
 }
+
+/**
+ * Test that the gradients, hessians and loss of SSE Loss are computed
+ * correctly.
+ */
+TEST_CASE("SSEGradientsTest", "[XGBTest]")
+{
+  arma::rowvec observed = { 1.0, 3.0, 2.0, -1.0 };
+  arma::rowvec predicted = { 0.5, 3.5, 2.0, 1.0 };
+
+  SSELoss loss;
+  arma::rowvec gradients, hessians;
+  loss.Gradients(observed, predicted, gradients, hessians);
+
+  REQUIRE(gradients.n_elem == 4);
+  REQUIRE(hessians.n_elem == 4);
+  REQUIRE(gradients[0] == Approx(-0.5));
+  REQUIRE(gradients[1] == Approx(0.5));
+  REQUIRE(gradients[2] == Approx(0.0).margin(1e-10));
+  REQUIRE(gradients[3] == Approx(2.0));
+  REQUIRE(arma::all(hessians == 1.0));
+
+  // 0.5 * (0.25 + 0.25 + 0 + 4) / 4.
+  REQUIRE(loss.Loss(observed, predicted) == Approx(0.5625));
+}
+
+/**
+ * Make sure that the boosted regressor fits a smooth nonlinear function much
+ * better than the initial prediction, and that boosting more rounds fits the
+ * training set better.
+ */
+TEST_CASE("XGBoostRegressorFitTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 2000);
+  arma::rowvec responses = arma::sin(2 * M_PI * data.row(0)) +
+      arma::square(data.row(1));
+  arma::mat testData = arma::randu<arma::mat>(3, 500);
+  arma::rowvec testResponses = arma::sin(2 * M_PI * testData.row(0)) +
+      arma::square(testData.row(1));
+
+  XGBoostRegressor<> shortModel(data, responses, 5);
+  XGBoostRegressor<> model(data, responses, 100);
+
+  REQUIRE(shortModel.NumTrees() == 5);
+  REQUIRE(model.NumTrees() == 100);
+  REQUIRE(model.InitialPrediction() == Approx(arma::mean(responses)));
+
+  arma::rowvec shortPredictions, predictions;
+  shortModel.Predict(data, shortPredictions);
+  model.Predict(data, predictions);
+  const double shortTrainMSE = arma::mean(arma::square(shortPredictions -
+      responses));
+  const double trainMSE = arma::mean(arma::square(predictions - responses));
+  REQUIRE(trainMSE < shortTrainMSE);
+
+  model.Predict(testData, predictions);
+  REQUIRE(predictions.n_elem == testData.n_cols);
+  const double baselineMSE = arma::mean(arma::square(testResponses -
+      arma::mean(responses)));
+  const double testMSE = arma::mean(arma::square(predictions - testResponses));
+  REQUIRE(testMSE < 0.05 * baselineMSE);
+
+  // Predicting one point at a time must give the same results.
+  for (size_t i = 0; i < testData.n_cols; ++i)
+    REQUIRE(model.Predict(testData.col(i)) == Approx(predictions[i]));
+}
+
+/**
+ * Make sure that column subsampling still gives a reasonable model.
+ */
+TEST_CASE("XGBoostRegressorSubspaceTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(4, 1000);
+  arma::rowvec responses = 2 * data.row(0) - data.row(2);
+
+  XGBoostRegressor<> model(data, responses, 100, 0.3, 4, 10, 1e-7, 2);
+
+  arma::rowvec predictions;
+  model.Predict(data, predictions);
+  const double baselineMSE = arma::mean(arma::square(responses -
+      arma::mean(responses)));
+  const double mse = arma::mean(arma::square(predictions - responses));
+  REQUIRE(mse < 0.05 * baselineMSE);
+}
+
+/**
+ * Make sure that training stops early when the responses are pure noise, and
+ * that the model is truncated to the round with the best validation loss.
+ */
+TEST_CASE("XGBoostRegressorEarlyStoppingTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 1000);
+  arma::rowvec responses = arma::randn<arma::rowvec>(1000);
+  arma::mat validationData = arma::randu<arma::mat>(3, 500);
+  arma::rowvec validationResponses = arma::randn<arma::rowvec>(500);
+
+  XGBoostRegressor<> model;
+  const double bestLoss = model.Train(data, responses, validationData,
+      validationResponses, 5, 500);
+
+  REQUIRE(model.NumTrees() >= 1);
+  REQUIRE(model.NumTrees() < 500);
+
+  arma::rowvec predictions;
+  model.Predict(validationData, predictions);
+  REQUIRE(SSELoss().Loss(validationResponses, predictions) ==
+      Approx(bestLoss).epsilon(1e-7));
+}
+
+/**
+ * Make sure that the boosted classifier classifies the vc2 dataset reasonably
+ * well, and that its probabilities agree with its predictions.
+ */
+TEST_CASE("XGBoostClassifierVC2Test", "[XGBTest]")
+{
+  arma::mat dataset, testDataset;
+  arma::Row<size_t> labels, testLabels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  XGBoostClassifier model(dataset, labels, 3, 50, 0.3, 4, 5);
+
+  REQUIRE(model.NumClasses() == 3);
+  REQUIRE(model.NumRounds() == 50);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  model.Classify(testDataset, predictions, probabilities);
+
+  REQUIRE(predictions.n_elem == testDataset.n_cols);
+  REQUIRE(probabilities.n_rows == 3);
+  REQUIRE(probabilities.n_cols == testDataset.n_cols);
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= size_t(0.7 * testDataset.n_cols));
+
+  for (size_t i = 0; i < testDataset.n_cols; ++i)
+  {
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0));
+    REQUIRE(predictions[i] == probabilities.col(i).index_max());
+
+    size_t prediction;
+    arma::vec pointProbabilities;
+    model.Classify(testDataset.col(i), prediction, pointProbabilities);
+    REQUIRE(prediction == predictions[i]);
+    for (size_t c = 0; c < 3; ++c)
+      REQUIRE(pointProbabilities[c] == Approx(probabilities(c, i)));
+  }
+}
+
+/**
+ * Make sure that the classifier stops early on noise labels.
+ */
+TEST_CASE("XGBoostClassifierEarlyStoppingTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 1000);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(1000,
+      arma::distr_param(0, 1));
+  arma::mat validationData = arma::randu<arma::mat>(3, 500);
+  arma::Row<size_t> validationLabels = arma::randi<arma::Row<size_t>>(500,
+      arma::distr_param(0, 1));
+
+  XGBoostClassifier model;
+  model.Train(data, labels, 2, validationData, validationLabels, 5, 500);
+
+  REQUIRE(model.NumRounds() >= 1);
+  REQUIRE(model.NumRounds() < 500);
+}
+
+/**
+ * Make sure that serialized boosted models give the same predictions.
+ */
+TEST_CASE("XGBoostSerializationTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 500);
+  arma::rowvec responses = data.row(0) + 2 * data.row(1);
+  arma::Row<size_t> labels = arma::conv_to<arma::Row<size_t>>::from(
+      data.row(0) > 0.5);
+
+  XGBoostRegressor<> regressor(data, responses, 20);
+  XGBoostRegressor<> xmlRegressor, jsonRegressor, binaryRegressor;
+  binaryRegressor.Train(data, responses, 3);
+  SerializeObjectAll(regressor, xmlRegressor, jsonRegressor, binaryRegressor);
+
+  arma::rowvec predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions;
+  regressor.Predict(data, predictions);
+  xmlRegressor.Predict(data, xmlPredictions);
+  jsonRegressor.Predict(data, jsonPredictions);
+  binaryRegressor.Predict(data, binaryPredictions);
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+
+  XGBoostClassifier classifier(data, labels, 2, 20);
+  XGBoostClassifier xmlClassifier, jsonClassifier, binaryClassifier;
+  binaryClassifier.Train(data, labels, 2, 3);
+  SerializeObjectAll(classifier, xmlClassifier, jsonClassifier,
+      binaryClassifier);
+
+  arma::Row<size_t> classes, xmlClasses, jsonClasses, binaryClasses;
+  arma::mat probabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities;
+  classifier.Classify(data, classes, probabilities);
+  xmlClassifier.Classify(data, xmlClasses, xmlProbabilities);
+  jsonClassifier.Classify(data, jsonClasses, jsonProbabilities);
+  binaryClassifier.Classify(data, binaryClasses, binaryProbabilities);
+  CheckMatrices(classes, xmlClasses, jsonClasses, binaryClasses);
+  CheckMatrices(probabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+}
+
+/**
+ * Make sure that invalid parameters are reported.
+ */
+TEST_CASE("XGBoostInvalidParametersTest", "[XGBTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 100);
+  arma::rowvec responses = arma::randu<arma::rowvec>(100);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(100,
+      arma::distr_param(0, 2));
+
+  XGBoostRegressor<> regressor;
+  arma::rowvec predictions;
+  REQUIRE_THROWS_AS(regressor.Predict(data, predictions),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(regressor.Train(data, arma::rowvec(50)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(regressor.Train(data, responses, 0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(regressor.Train(data, responses, 10, 0.0),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(regressor.Train(data, responses, 10, 0.3, 6, 10, 1e-7, 4),
+      std::invalid_argument);
+
+  regressor.Train(data, responses, 10);
+  REQUIRE_THROWS_AS(regressor.Predict(arma::mat(4, 10, arma::fill::randu),
+      predictions), std::invalid_argument);
+
+  XGBoostClassifier classifier;
+  arma::Row<size_t> classes;
+  REQUIRE_THROWS_AS(classifier.Classify(data, classes), std::invalid_argument);
+  REQUIRE_THROWS_AS(classifier.Train(data, labels, 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(classifier.Train(data, labels, 1), std::invalid_argument);
+  REQUIRE_THROWS_AS(classifier.Train(data,
+      arma::Row<size_t>(labels.head(50)), 3), std::invalid_argument);
+}